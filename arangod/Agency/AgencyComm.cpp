@@ -1326,7 +1326,7 @@ void AgencyComm::updateEndpoints(arangodb::velocypack::Slice const& current) {
 
 AgencyCommResult AgencyComm::sendWithFailover(
     arangodb::rest::RequestType method, double const timeout,
-    std::string const& initialUrl, VPackSlice inBody) {
+    std::string const& initialUrl, VPackSlice inBody, double requestTimeout) {
 
   std::string endpoint;
   std::unique_ptr<GeneralClientConnection> connection =
@@ -1350,7 +1350,7 @@ AgencyCommResult AgencyComm::sendWithFailover(
   std::chrono::duration<double> waitInterval (.0); // seconds
   auto started = std::chrono::steady_clock::now();
   auto timeOut = started + std::chrono::duration<double>(timeout);
-  double conTimeout = 1.0;
+  double conTimeout = requestTimeout;
 
   int tries = 0;
 
@@ -691,8 +691,11 @@ class AgencyComm {
 
   bool ensureStructureInitialized();
 
+  /// the timeout of a single request starts at requestTimeout and doubles
+  /// after every timeout, up to 16 seconds
   AgencyCommResult sendWithFailover(arangodb::rest::RequestType, double,
-                                    std::string const&, VPackSlice);
+                                    std::string const&, VPackSlice,
+                                    double requestTimeout = 1.0);
 
  private:
   bool lock(std::string const&, double, double,
@@ -50,6 +50,25 @@ std::string const pubApiPrefix("/_api/agency/");
 std::string const privApiPrefix("/_api/agency_priv/");
 std::string const NO_LEADER("");
 
+// Snapshots larger than this are sent to followers in several chunks
+static size_t const snapshotChunkSize = 16 * 1024 * 1024;
+
+// Collect the largest subtrees of node, which fit into a snapshot chunk,
+// with their paths. Leaves larger than a chunk get a chunk of their own.
+static void snapshotParts(
+  VPackSlice const& node, std::string const& path,
+  std::vector<std::pair<std::string, VPackSlice>>& parts) {
+  if (node.isObject() && node.length() > 0 &&
+      node.byteSize() > snapshotChunkSize) {
+    for (auto const& child : VPackObjectIterator(node)) {
+      std::string key = child.key.copyString();
+      snapshotParts(child.value, path.empty() ? key : path + "/" + key, parts);
+    }
+  } else {
+    parts.emplace_back(path, node);
+  }
+}
+
 /// Agent configuration
 Agent::Agent(config_t const& config)
   : Thread("Agent"),
@@ -298,6 +317,7 @@ void Agent::reportIn(std::string const& peerId, index_t index, size_t toLog) {
     if (index > _confirmed[peerId]) {  // progress this follower?
       _confirmed[peerId] = index;
       if (toLog > 0) { // We want to reset the wait time only if a package callback
+        _chunksAcked.erase(peerId);
         LOG_TOPIC(DEBUG, Logger::AGENCY) << "Got call back of " << toLog << " logs, resetting _earliestPackage to now for id " << peerId;
         _earliestPackage[peerId] = steady_clock::now();
       }
@@ -324,6 +344,11 @@ void Agent::reportFailed(std::string const& slaveId, size_t toLog, bool sent) {
       << "Resetting _earliestPackage to now for id " << slaveId;
     _earliestPackage[slaveId] = steady_clock::now() + seconds(1);
     _confirmed[slaveId] = 0;
+    if (sent) {
+      // The follower refused, it might have lost the chunks of a snapshot
+      // it has acknowledged. Otherwise we continue with the next chunk.
+      _chunksAcked.erase(slaveId);
+    }
   } else {
     // answer to sendAppendEntries to empty request, when follower's highest
     // log index is 0. This is necessary so that a possibly restarted agent
@@ -337,6 +362,18 @@ void Agent::reportFailed(std::string const& slaveId, size_t toLog, bool sent) {
   }
 }
 
+/// Report a snapshot chunk received by a follower from AgentCallback
+void Agent::reportChunk(std::string const& peerId, index_t snapshotIndex,
+                        size_t chunk) {
+  MUTEX_LOCKER(tiLocker, _tiLock);
+  _lastAcked[peerId] = steady_clock::now();
+  _chunksAcked[peerId] = std::make_pair(snapshotIndex, chunk);
+  LOG_TOPIC(DEBUG, Logger::AGENCY) << "Got call back of snapshot chunk "
+    << chunk << ", resetting _earliestPackage to now for id " << peerId;
+  _earliestPackage[peerId] = steady_clock::now();
+  wakeupMainLoop();
+}
+
 /// Followers' append entries
 priv_rpc_ret_t Agent::recvAppendEntriesRPC(
   term_t term, std::string const& leaderId, index_t prevIndex, term_t prevTerm,
@@ -361,7 +398,9 @@ priv_rpc_ret_t Agent::recvAppendEntriesRPC(
   }
 
   size_t nqs = payload.length();
-  if(nqs > 0 && !payload[0].get("readDB").isNone()) {
+  bool snapshotChunk = nqs == 1 && payload[0].isObject() &&
+                       payload[0].hasKey("readDBChunk");
+  if(snapshotChunk || (nqs > 0 && !payload[0].get("readDB").isNone())) {
     // We have received a compacted state.
     // Whatever we got in our own state is meaningless now. It is a new world.
     // checkLeader just does plausibility as if it were an empty request
@@ -376,6 +415,12 @@ priv_rpc_ret_t Agent::recvAppendEntriesRPC(
     return priv_rpc_ret_t(false,t);
   }
 
+  // A chunk of a large snapshot, which is kept until the last chunk arrives
+  // together with the log entries:
+  if (snapshotChunk) {
+    return priv_rpc_ret_t(_state.receiveSnapshotChunk(payload[0]), t);
+  }
+
   // Empty appendEntries:
   // We answer with success if and only if our highest index is greater 0.
   // Else we want to indicate to the leader that we are behind and need data:
@@ -569,6 +614,29 @@ void Agent::sendAppendEntriesRPC() {
         }
       }
 
+      // A snapshot larger than one chunk is sent in chunks before its last
+      // chunk goes along with the log entries. Every chunk has its own
+      // appendEntriesRPC, which must not time out:
+      if (needSnapshot) {
+        buildSnapshotChunks(snapshot, snapshotIndex, snapshotTerm);
+        size_t chunk = 0;
+        {
+          MUTEX_LOCKER(tiLocker, _tiLock);
+          auto it = _chunksAcked.find(followerId);
+          if (it != _chunksAcked.end() && it->second.first == snapshotIndex) {
+            chunk = it->second.second;
+          }
+        }
+        if (chunk + 1 < _snapshotChunks.chunks.size()) {
+          if (challengeLeadership()) {
+            resign();
+            return;
+          }
+          sendSnapshotChunk(followerId, t, commitIndex, chunk);
+          continue;
+        }
+      }
+
       // RPC path
       std::stringstream path;
       index_t prevLogIndex = unconfirmed.front().index;
@@ -590,9 +658,20 @@ void Agent::sendAppendEntriesRPC() {
 
       if (needSnapshot) {
         { VPackObjectBuilder guard(&builder);
-          builder.add(VPackValue("readDB"));
-          { VPackArrayBuilder guard2(&builder);
-            snapshot.dumpToBuilder(builder);
+          size_t chunks = _snapshotChunks.chunks.size();
+          if (chunks > 1) {
+            // The last chunk of the tree and all of the other tables
+            VPackSlice dump = _snapshotChunks.dump.slice();
+            builder.add(VPackValue("readDB"));
+            { VPackArrayBuilder guard2(&builder);
+              builder.add(_snapshotChunks.chunks.back().slice());
+              for (size_t i = 1; i < dump.length(); ++i) {
+                builder.add(dump.at(i));
+              }
+            }
+            builder.add("chunks", VPackValue(chunks));
+          } else {
+            builder.add("readDB", _snapshotChunks.dump.slice());
           }
           builder.add("term", VPackValue(snapshotTerm));
           builder.add("index", VPackValue(snapshotIndex));
@@ -668,6 +747,95 @@ void Agent::sendAppendEntriesRPC() {
 }
 
 
+/// Split a snapshot into chunks, main thread only
+void Agent::buildSnapshotChunks(
+  Store const& snapshot, index_t index, term_t term) {
+
+  if (!_snapshotChunks.chunks.empty() && _snapshotChunks.index == index &&
+      _snapshotChunks.term == term) {
+    return;
+  }
+
+  _snapshotChunks.index = index;
+  _snapshotChunks.term = term;
+  _snapshotChunks.dump.clear();
+  { VPackArrayBuilder guard(&_snapshotChunks.dump);
+    snapshot.dumpToBuilder(_snapshotChunks.dump); }
+  _snapshotChunks.chunks.clear();
+
+  std::vector<std::pair<std::string, VPackSlice>> parts;
+  snapshotParts(_snapshotChunks.dump.slice().at(0), std::string(), parts);
+
+  size_t size = 0;
+  _snapshotChunks.chunks.emplace_back();
+  _snapshotChunks.chunks.back().openObject();
+  for (auto const& part : parts) {
+    size_t partSize = part.first.size() + part.second.byteSize();
+    if (size > 0 && size + partSize > snapshotChunkSize) {
+      _snapshotChunks.chunks.back().close();
+      _snapshotChunks.chunks.emplace_back();
+      _snapshotChunks.chunks.back().openObject();
+      size = 0;
+    }
+    _snapshotChunks.chunks.back().add(part.first, part.second);
+    size += partSize;
+  }
+  _snapshotChunks.chunks.back().close();
+
+  LOG_TOPIC(DEBUG, Logger::AGENCY)
+    << "Split snapshot at index " << index << " into "
+    << _snapshotChunks.chunks.size() << " chunks";
+}
+
+
+/// Send one chunk of a large snapshot
+void Agent::sendSnapshotChunk(std::string const& followerId, term_t t,
+                              index_t commitIndex, size_t chunk) {
+  auto cc = ClusterComm::instance();
+  if (cc == nullptr) {
+    // nullptr only happens during controlled shutdown
+    return;
+  }
+
+  std::stringstream path;
+  path << "/_api/agency_priv/appendEntries?term=" << t << "&leaderId="
+       << id() << "&prevLogIndex=" << _snapshotChunks.index
+       << "&prevLogTerm=" << _snapshotChunks.term
+       << "&leaderCommit=" << commitIndex
+       << "&senderTimeStamp=" << std::llround(steadyClockToDouble() * 1000);
+
+  Builder builder;
+  { VPackArrayBuilder a(&builder);
+    { VPackObjectBuilder o(&builder);
+      builder.add("readDBChunk", _snapshotChunks.chunks.at(chunk).slice());
+      builder.add("chunk", VPackValue(chunk));
+      builder.add("term", VPackValue(_snapshotChunks.term));
+      builder.add("index", VPackValue(_snapshotChunks.index)); } }
+
+  // As for log entries, wait for the answer before sending more
+  {
+    MUTEX_LOCKER(tiLocker, _tiLock);
+    _earliestPackage[followerId] = steady_clock::now() + std::chrono::seconds(30);
+  }
+
+  std::unordered_map<std::string, std::string> headerFields;
+  cc->asyncRequest(
+    "1", 1, _config.poolAt(followerId),
+    arangodb::rest::RequestType::POST, path.str(),
+    std::make_shared<std::string>(builder.toJson()), headerFields,
+    std::make_shared<AgentCallback>(
+      this, followerId, _snapshotChunks.index, 1, chunk + 1),
+    150.0, true);
+
+  _lastSent[followerId] = steady_clock::now();
+
+  LOG_TOPIC(DEBUG, Logger::AGENCY)
+    << "Sending snapshot chunk " << chunk + 1 << " of "
+    << _snapshotChunks.chunks.size() << " at index " << _snapshotChunks.index
+    << " to follower " << followerId;
+}
+
+
 void Agent::resign(term_t otherTerm) {
   LOG_TOPIC(DEBUG, Logger::AGENCY) << "Resigning in term "
     << _constituent.term() << " because of peer's term " << otherTerm;
@@ -1225,6 +1393,65 @@ read_ret_t Agent::read(query_t const& query) {
 }
 
 
+/// Committed log entries after index for the agency caches of other servers
+query_t Agent::poll(index_t index, double timeout) {
+
+  // Log entries in one answer, more are fetched by the next poll
+  static index_t const maxPollEntries = 1000;
+
+  auto startTime = steady_clock::now();
+  {
+    CONDITION_LOCKER(guard, _waitForCV);
+    while (_commitIndex <= index && !isStopping()) {
+      duration<double> d = steady_clock::now() - startTime;
+      if (d.count() >= timeout) {
+        break;
+      }
+      _waitForCV.wait(static_cast<uint64_t>(1.0e6 * (timeout - d.count())));
+    }
+  }
+
+  auto result = std::make_shared<Builder>();
+  READ_LOCKER(oLocker, _outputLock);
+  index_t commitIndex = _commitIndex;
+
+  std::vector<log_t> entries;
+  if (index > 0 && commitIndex > index) {
+    entries = _state.get(index + 1, std::min(commitIndex, index + maxPollEntries));
+  }
+
+  { VPackObjectBuilder b(result.get());
+    if (index == 0 || (commitIndex > index &&
+                       (entries.empty() || entries.front().index != index + 1))) {
+      // Entries compacted away (or the first poll), send everything
+      Builder query;
+      { VPackArrayBuilder a(&query);
+        query.add(VPackValue("/"));
+        query.add(VPackValue("/.agency")); }
+      result->add("commitIndex", VPackValue(commitIndex));
+      result->add(VPackValue("readDB"));
+      _readDB.read(query.slice(), *result);
+    } else {
+      index_t last = index;
+      result->add(VPackValue("log"));
+      { VPackArrayBuilder a(result.get());
+        for (auto const& entry : entries) {
+          if (entry.index > commitIndex) {
+            break;
+          }
+          VPackObjectBuilder e(result.get());
+          result->add("index", VPackValue(entry.index));
+          result->add("query", VPackSlice(entry.entry->data()));
+          last = entry.index;
+        }
+      }
+      result->add("commitIndex", VPackValue(last));
+    }
+  }
+
+  return result;
+}
+
 /// Send out append entries to followers regularly or on event
 void Agent::run() {
   // Only run in case we are in multi-host mode
@@ -118,6 +118,12 @@ class Agent final : public arangodb::Thread,
   /// @brief Inquire success of logs given clientIds
   write_ret_t inquire(query_t const&);
 
+  /// @brief Long poll for the agency caches of other servers: waits up to
+  ///        timeout seconds for log entries committed after index and
+  ///        returns them, or the complete readDB, if they are compacted
+  ///        away or index is 0
+  query_t poll(index_t index, double timeout);
+
   /// @brief Attempt read/write transaction
   trans_ret_t transact(query_t const&) override;
 
@@ -144,6 +150,15 @@ class Agent final : public arangodb::Thread,
   ///        also used as heartbeat ($5.2).
   void sendAppendEntriesRPC();
 
+  /// @brief Split the snapshot into chunks for followers, unless we have
+  ///        done so already for this snapshot index
+  void buildSnapshotChunks(Store const& snapshot, index_t index, term_t term);
+
+  /// @brief Send one of the chunks of a large snapshot, but not the last,
+  ///        which goes along with the log entries
+  void sendSnapshotChunk(std::string const& followerId, term_t t,
+                         index_t commitIndex, size_t chunk);
+
   /// @brief check whether _confirmed indexes have been advance so that we
   /// can advance _commitIndex and apply things to readDB.
   void advanceCommitIndex();
@@ -180,6 +195,10 @@ class Agent final : public arangodb::Thread,
   /// @brief Report a failed append entry call from AgentCallback
   void reportFailed(std::string const& slaveId, size_t toLog, bool sent = false);
 
+  /// @brief Report a received snapshot chunk from AgentCallback
+  void reportChunk(std::string const& peerId, index_t snapshotIndex,
+                   size_t chunk);
+
   /// @brief Wait for slaves to confirm appended entries
   AgentInterface::raft_commit_t waitFor(index_t last_entry, double timeout = 10.0) override;
 
@@ -367,7 +386,25 @@ class Agent final : public arangodb::Thread,
   /// appendEntriesRPC to that follower.
   std::unordered_map<std::string, SteadyTimePoint> _lastSent;
 
-  /// The following three members are protected by _tiLock:
+  /// @brief The last compaction snapshot, which was needed by a follower,
+  /// split into chunks of subtrees by their paths. A snapshot larger than
+  /// one chunk is sent in several appendEntriesRPC, such that none of them
+  /// runs into a timeout.
+  struct SnapshotChunks {
+    SnapshotChunks() : index(0), term(0) {}
+    index_t index;
+    term_t term;
+    Builder dump;                // [tree, ttl, observers, observed]
+    std::vector<Builder> chunks;  // objects of path -> subtree
+  };
+  SnapshotChunks _snapshotChunks;
+
+  /// The following four members are protected by _tiLock:
+
+  /// @brief stores for each follower, which is receiving a snapshot in
+  /// chunks, the index of that snapshot and the number of chunks it has
+  /// acknowledged
+  std::unordered_map<std::string, std::pair<index_t, size_t>> _chunksAcked;
 
   /// @brief stores for each follower the highest index log it has reported as
   /// locally logged.
@@ -382,7 +419,7 @@ class Agent final : public arangodb::Thread,
   std::unordered_map<std::string, SteadyTimePoint> _earliestPackage;
 
   // @brief Lock for the above time data about other agents. This
-  // protects _confirmed, _lastAcked and _earliestPackage:
+  // protects _chunksAcked, _confirmed, _lastAcked and _earliestPackage:
   mutable arangodb::Mutex _tiLock;
 
   /// @brief RAFT consistency lock:
@@ -29,12 +29,12 @@ using namespace arangodb::consensus;
 using namespace arangodb::velocypack;
 
 AgentCallback::AgentCallback() :
-  _agent(nullptr), _last(0), _toLog(0), _startTime(0.0) {}
+  _agent(nullptr), _last(0), _toLog(0), _chunk(0), _startTime(0.0) {}
 
 AgentCallback::AgentCallback(Agent* agent, std::string const& slaveID,
-                             index_t last, size_t toLog)
+                             index_t last, size_t toLog, size_t chunk)
   : _agent(agent), _last(last), _slaveID(slaveID), _toLog(toLog),
-    _startTime(TRI_microtime())  {}
+    _chunk(chunk), _startTime(TRI_microtime())  {}
 
 void AgentCallback::shutdown() { _agent = nullptr; }
 
@@ -79,7 +79,11 @@ bool AgentCallback::operator()(arangodb::ClusterCommResult* res) {
           
         LOG_TOPIC(DEBUG, Logger::AGENCY) << "AgentCallback: "
           << body->slice().toJson();
-        _agent->reportIn(_slaveID, _last, _toLog);
+        if (_chunk > 0) {
+          _agent->reportChunk(_slaveID, _last, _chunk);
+        } else {
+          _agent->reportIn(_slaveID, _last, _toLog);
+        }
       }
     }
     LOG_TOPIC(DEBUG, Logger::AGENCY)
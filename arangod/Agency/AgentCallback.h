@@ -36,7 +36,10 @@ class AgentCallback : public arangodb::ClusterCommCallback {
  public:
   AgentCallback();
 
-  AgentCallback(Agent*, std::string const&, index_t, size_t);
+  /// @brief chunk is 0 for appendEntriesRPC with log entries, or the number
+  /// (counting from 1) of the snapshot chunk sent, in which case last is the
+  /// index of the snapshot
+  AgentCallback(Agent*, std::string const&, index_t, size_t, size_t chunk = 0);
 
   virtual bool operator()(arangodb::ClusterCommResult*) override final;
 
@@ -47,6 +50,7 @@ class AgentCallback : public arangodb::ClusterCommCallback {
   index_t _last;
   std::string _slaveID;
   size_t _toLog;
+  size_t _chunk;
   double _startTime;
 
 };
@@ -76,7 +76,6 @@ Node::Node(std::string const& name)
     : _nodeName(name),
       _parent(nullptr),
       _store(nullptr),
-      _vecBufDirty(true),
       _isArray(false) {}
 
 
@@ -85,7 +84,6 @@ Node::Node(std::string const& name, Node* parent)
     : _nodeName(name),
       _parent(parent),
       _store(nullptr),
-      _vecBufDirty(true),
       _isArray(false) {}
 
 
@@ -94,7 +92,6 @@ Node::Node(std::string const& name, Store* store)
     : _nodeName(name),
       _parent(nullptr),
       _store(store),
-      _vecBufDirty(true),
       _isArray(false) {}
 
 /// @brief Default dtor
@@ -103,15 +100,9 @@ Node::~Node() {}
 
 /// @brief Get slice to value buffer
 Slice Node::slice() const {
-  // Some array
-  if (_isArray) {
-    rebuildVecBuf();
-    return Slice(_vecBuf.data());
-  }
-
-  // Some value
-  if (!_value.empty()) {
-    return Slice(_value.front().data());
+  // Some value or array
+  if (_value != nullptr) {
+    return Slice(reinterpret_cast<uint8_t const*>(_value->data()));
   }
 
   // Empty object
@@ -119,22 +110,6 @@ Slice Node::slice() const {
 }
 
 
-/// @brief Optimisation, which avoids recreating of Builder for output if
-/// changes have not happened since last call
-void Node::rebuildVecBuf() const {
-  if (_vecBufDirty) {  // Dirty vector buffer
-    Builder tmp;
-    { VPackArrayBuilder t(&tmp);
-      for (auto const& i : _value) {
-        tmp.add(Slice(i.data()));
-      }
-    }
-    _vecBuf = *tmp.steal();
-    _vecBufDirty = false;
-  }
-}
-
-
 /// @brief Get name of this node
 std::string const& Node::name() const { return _nodeName; }
 
@@ -164,8 +139,6 @@ Node::Node(Node&& other)
       _children(std::move(other._children)),
       _ttl(std::move(other._ttl)),
       _value(std::move(other._value)),
-      _vecBuf(std::move(other._vecBuf)),
-      _vecBufDirty(std::move(other._vecBufDirty)),
       _isArray(std::move(other._isArray)) {
   // The _children map has been moved here, therefore we must
   // correct the _parent entry of all direct children:
@@ -181,8 +154,6 @@ Node::Node(Node const& other)
       _store(nullptr),
       _ttl(other._ttl),
       _value(other._value),
-      _vecBuf(other._vecBuf),
-      _vecBufDirty(other._vecBufDirty),
       _isArray(other._isArray) {
   for (auto const& p : other._children) {
     auto copy = std::make_shared<Node>(*p.second);
@@ -199,21 +170,10 @@ Node::Node(Node const& other)
 Node& Node::operator=(VPackSlice const& slice) {
   removeTimeToLive();
   _children.clear();
-  _value.clear();
-  if (slice.isArray()) {
-    _isArray = true;
-    _value.resize(slice.length());
-    for (size_t i = 0; i < slice.length(); ++i) {
-      _value.at(i).append(
-        reinterpret_cast<char const*>(slice[i].begin()), slice[i].byteSize());
-    }
-  } else {
-    _isArray = false;
-    _value.resize(1);
-    _value.front().append(
-      reinterpret_cast<char const*>(slice.begin()), slice.byteSize());
-  }
-  _vecBufDirty = true;
+  // never modify the buffer in place, copies of this node share it
+  _isArray = slice.isArray();
+  _value = std::make_shared<std::string const>(
+    reinterpret_cast<char const*>(slice.begin()), slice.byteSize());
   return *this;
 }
 
@@ -231,8 +191,6 @@ Node& Node::operator=(Node&& rhs) {
     child.second->_parent = this;
   }
   _value = std::move(rhs._value);
-  _vecBuf = std::move(rhs._vecBuf);
-  _vecBufDirty = std::move(rhs._vecBufDirty);
   _isArray = std::move(rhs._isArray);
   _ttl = std::move(rhs._ttl);
   return *this;
@@ -253,8 +211,6 @@ Node& Node::operator=(Node const& rhs) {
     _children.insert(std::make_pair(p.first, copy));
   }
   _value = rhs._value;
-  _vecBuf = rhs._vecBuf;
-  _vecBufDirty = rhs._vecBufDirty;
   _isArray = rhs._isArray;
   _ttl = rhs._ttl;
   return *this;
@@ -301,7 +257,7 @@ bool Node::removeChild(std::string const& key) {
 
 /// @brief Node type
 /// The check is if we are an array or a value. => LEAF. NODE else
-NodeType Node::type() const { return (_isArray || _value.size()) ? LEAF : NODE; }
+NodeType Node::type() const { return (_isArray || _value != nullptr) ? LEAF : NODE; }
 
 
 /// @brief lh-value at path vector
@@ -312,9 +268,7 @@ Node& Node::operator()(std::vector<std::string> const& pv) {
     // 1. Remove any values, 2. add new child
     if (_children.find(key) == _children.end()) {
       _isArray = false;
-      if (!_value.empty()) {
-        _value.clear();
-      }
+      _value.reset();
       _children[key] = std::make_shared<Node>(key, this);
     }
     auto pvc(pv);
@@ -704,7 +658,7 @@ bool Node::applieOp(VPackSlice const& slice) {
   if (oper == "delete") {
     if (_parent == nullptr) {  // root node
       _children.clear();
-      _value.clear();
+      _value.reset();
       return true;
     } else {
       return _parent->removeChild(_nodeName);
@@ -727,10 +681,10 @@ bool Node::applieOp(VPackSlice const& slice) {
     return handle<OBSERVE>(slice);
   } else if (oper == "unobserve") {  // "op":"unobserve"
     handle<UNOBSERVE>(slice);
-    if (_children.empty() && _value.empty()) {
+    if (_children.empty() && _value == nullptr) {
       if (_parent == nullptr) {  // root node
         _children.clear();
-        _value.clear();
+        _value.reset();
         return true;
       } else {
         return _parent->removeChild(_nodeName);
@@ -1063,24 +1017,21 @@ std::pair<std::string, bool> Node::hasAsString (
 } // hasAsString
 
 
-std::pair<Node::Children, bool> Node::hasAsChildren (
+std::pair<Node::Children const&, bool> Node::hasAsChildren (
   std::string const & url) const {
-  std::pair<Children, bool> ret_pair;
-
-  ret_pair.second=false;
+  static Children const noChildren;
 
   // retrieve node, throws if does not exist
   try {
     Node const & target(operator()(url));
-    ret_pair.first=target.children();
-    ret_pair.second = true;
+    return std::pair<Children const&, bool>(target.children(), true);
   } catch (...) {
-    // do nothing, ret_pair second already false
+    // do nothing, return no children
     LOG_TOPIC(DEBUG, Logger::SUPERVISION)
       << "hasAsChildren had exception processing " << url;
   } // catch
 
-  return ret_pair;
+  return std::pair<Children const&, bool>(noChildren, false);
 } // hasAsChildren
 
 
@@ -1160,15 +1111,12 @@ Slice Node::getArray() const {
   if (!_isArray) {
     throw StoreException("Not an array type");
   }
-  rebuildVecBuf();
-  return Slice(_vecBuf.data());
+  return slice();
 }
 
 void Node::clear() {
   _children.clear();
   _ttl = std::chrono::system_clock::time_point();
-  _value.clear();
-  _vecBuf.clear();
-  _vecBufDirty = true;
+  _value.reset();
   _isArray = false;
 }
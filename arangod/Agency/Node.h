@@ -76,8 +76,8 @@ class Store;
 /// Any leaf either represents an array or an element (_isArray variable).
 /// Nodes are are always constructed as element and can become an array through
 /// assignment operator.
-/// toBuilder(Builder&) will create a _vecBuf, when needed as a means to
-/// optimisation by avoiding to build it before necessary.
+/// The value of a leaf is kept as one immutable velocypack buffer, which is
+/// shared by all copies of the node and replaced on every change.
 class Node {
  public:
   /// @brief Slash-segmented path
@@ -256,9 +256,9 @@ class Node {
   /// @return  second is true if url exists, first populated if second true
   std::pair<std::string, bool> hasAsString(std::string const &) const;
 
-  /// @brief accessor to Node's _children
+  /// @brief accessor to Node's _children, without copying them
   /// @return  second is true if url exists, first populated if second true
-  std::pair<Children, bool> hasAsChildren(std::string const &) const;
+  std::pair<Children const&, bool> hasAsChildren(std::string const &) const;
 
   /// @brief accessor to Node then write to builder
   /// @return  second is true if url exists, first is ignored
@@ -320,16 +320,12 @@ protected:
   /// @brief Remove time to live entry
   virtual bool removeTimeToLive();
 
-  void rebuildVecBuf() const;
-
   std::string _nodeName;  ///< @brief my name
   Node* _parent;           ///< @brief parent
   Store* _store;           ///< @brief Store
   Children _children;      ///< @brief child nodes
   TimePoint _ttl;          ///< @brief my expiry
-  std::vector<Buffer<uint8_t>> _value; ///< @brief my value
-  mutable Buffer<uint8_t> _vecBuf;
-  mutable bool _vecBufDirty;
+  std::shared_ptr<std::string const> _value; ///< @brief my value, shared
   bool _isArray;
 };
 
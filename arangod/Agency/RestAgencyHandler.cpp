@@ -511,6 +511,34 @@ RestStatus RestAgencyHandler::handleRead() {
   return reportMethodNotAllowed();
 }
 
+RestStatus RestAgencyHandler::handlePoll() {
+  if (_request->requestType() != rest::RequestType::GET) {
+    return reportMethodNotAllowed();
+  }
+
+  uint64_t index = _request->parsedValue("index", uint64_t(0));
+  double timeout = _request->parsedValue("timeout", 1.0);
+  if (timeout < 0.0) {
+    timeout = 0.0;
+  } else if (timeout > 60.0) {
+    timeout = 60.0;
+  }
+
+  if (_agent->size() > 1 && _agent->leaderID() == NO_LEADER) {
+    return reportMessage(rest::ResponseCode::SERVICE_UNAVAILABLE, "No leader");
+  }
+
+  // Only the leader knows, what is committed
+  if (_agent->leaderID() != _agent->id()) {
+    redirectRequest(_agent->leaderID());
+    return RestStatus::DONE;
+  }
+
+  query_t result = _agent->poll(index, timeout);
+  generateResult(rest::ResponseCode::OK, result->slice());
+  return RestStatus::DONE;
+}
+
 RestStatus RestAgencyHandler::handleConfig() {
 
   // Update endpoint of peer
@@ -578,6 +606,8 @@ RestStatus RestAgencyHandler::execute() {
         return handleRead();
       } else if (suffixes[0] == "inquire") {
         return handleInquire();
+      } else if (suffixes[0] == "poll") {
+        return handlePoll();
       } else if (suffixes[0] == "transient") {
         return handleTransient();
       } else if (suffixes[0] == "transact") {
@@ -57,6 +57,7 @@ class RestAgencyHandler : public RestBaseHandler {
   RestStatus handleState();
   RestStatus handleTransient();
   RestStatus handleInquire();
+  RestStatus handlePoll();
 
   void redirectRequest(std::string const& leaderId);
   consensus::Agent* _agent;
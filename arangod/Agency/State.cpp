@@ -62,6 +62,7 @@ State::State()
     : _agent(nullptr),
       _vocbase(nullptr),
       _ready(false),
+      _snapshotChunksIndex(0),
       _collectionsChecked(false),
       _collectionsLoaded(false),
       _nextCompactionAfter(0),
@@ -80,6 +81,12 @@ inline static std::string timestamp() {
     std::string(mbstr) : std::string();
 }
 
+inline static buffer_t entryBuffer(VPackSlice const& slice) {
+  auto buf = std::make_shared<Buffer<uint8_t>>();
+  buf->append((char const*)slice.begin(), slice.byteSize());
+  return buf;
+}
+
 inline static std::string stringify(index_t index) {
   std::ostringstream i_str;
   i_str << std::setw(20) << std::setfill('0') << index;
@@ -96,19 +103,66 @@ bool State::persist(index_t index, term_t term,
 
   Builder body;
   {
-    VPackObjectBuilder b(&body);
-    body.add("_key", Value(stringify(index)));
-    body.add("term", Value(term));
-    body.add("request", entry);
-    body.add("clientId", Value(clientId));
-    body.add("timestamp", Value(timestamp()));
+    VPackArrayBuilder b(&body);
+    logDocument(body, index, term, entry, clientId);
   }
 
+  bool ok = persistDocuments(body.slice());
+
+  LOG_TOPIC(TRACE, Logger::AGENCY) << "persist done index=" << index
+    << " term=" << term << " entry: " << entry.toJson() << " ok:" << ok;
+
+  return ok;
+}
+
+/// Persist consecutive entries in one transaction
+bool State::persist(std::vector<log_t> const& entries) const {
+
+  TRI_ASSERT(!entries.empty());
+  LOG_TOPIC(TRACE, Logger::AGENCY) << "persist indexes "
+    << entries.front().index << " to " << entries.back().index;
+
+  Builder body;
+  {
+    VPackArrayBuilder b(&body);
+    for (auto const& entry : entries) {
+      logDocument(body, entry.index, entry.term,
+                  VPackSlice(entry.entry->data()), entry.clientId);
+    }
+  }
+
+  bool ok = persistDocuments(body.slice());
+
+  LOG_TOPIC(TRACE, Logger::AGENCY) << "persist done indexes "
+    << entries.front().index << " to " << entries.back().index
+    << " ok:" << ok;
+
+  return ok;
+}
+
+/// Document of a log entry in the log collection
+void State::logDocument(Builder& body, index_t index, term_t term,
+                        velocypack::Slice const& entry,
+                        std::string const& clientId) {
+  VPackObjectBuilder b(&body);
+  body.add("_key", Value(stringify(index)));
+  body.add("term", Value(term));
+  body.add("request", entry);
+  body.add("clientId", Value(clientId));
+  body.add("timestamp", Value(timestamp()));
+}
+
+/// Insert an array of log documents in one transaction
+bool State::persistDocuments(velocypack::Slice const& documents) const {
+
+  TRI_ASSERT(documents.isArray());
   TRI_ASSERT(_vocbase != nullptr);
   auto ctx = std::make_shared<transaction::StandaloneContext>(*_vocbase);
   SingleCollectionTransaction trx(ctx, "log", AccessMode::Type::WRITE);
 
-  trx.addHint(transaction::Hints::Hint::SINGLE_OPERATION);
+  if (documents.length() == 1) {
+    trx.addHint(transaction::Hints::Hint::SINGLE_OPERATION);
+  }
 
   Result res = trx.begin();
 
@@ -119,17 +173,22 @@ bool State::persist(index_t index, term_t term,
   OperationResult result;
 
   try {
-    result = trx.insert("log", body.slice(), _options);
+    result = trx.insert("log", documents, _options);
   } catch (std::exception const& e) {
     LOG_TOPIC(ERR, Logger::AGENCY)
-      << "Failed to persist log entry:" << e.what();
+      << "Failed to persist log entries:" << e.what();
     return false;
   }
 
-  res = trx.finish(result.result);
+  if (result.ok() && !result.countErrorCodes.empty()) {
+    // a single document failed, none of them must be logged
+    int code = result.countErrorCodes.begin()->first;
+    LOG_TOPIC(ERR, Logger::AGENCY)
+      << "Failed to persist log entries: " << TRI_errno_string(code);
+    result.result.reset(code);
+  }
 
-  LOG_TOPIC(TRACE, Logger::AGENCY) << "persist done index=" << index
-    << " term=" << term << " entry: " << entry.toJson() << " ok:" << res.ok();
+  res = trx.finish(result.result);
 
   return res.ok();
 }
@@ -156,7 +215,12 @@ std::vector<index_t> State::logLeaderMulti(
   MUTEX_LOCKER(mutexLocker, _logLock); 
   
   TRI_ASSERT(!_log.empty()); // log must never be empty
-  
+
+  // all applicable transactions of the chunk go to disk in one go
+  std::vector<log_t> entries;
+  entries.reserve(applicable.size());
+  index_t next = _log.back().index + 1;
+
   for (auto const& i : VPackArrayIterator(slice)) {
 
     if (!i.isArray()) {
@@ -168,11 +232,16 @@ std::vector<index_t> State::logLeaderMulti(
     
     if (applicable[j]) {
       std::string clientId((i.length() == 3) ? i[2].copyString() : "");
-      idx[j] = logNonBlocking(_log.back().index + 1, i[0], term, clientId, true);
+      entries.emplace_back(next, term, entryBuffer(i[0]), clientId);
+      idx[j] = next++;
     }
     ++j;
   }
 
+  if (!entries.empty()) {
+    logNonBlocking(entries, true);
+  }
+
   return idx;
   
 }
@@ -190,13 +259,19 @@ index_t State::logNonBlocking(
   index_t idx, velocypack::Slice const& slice, term_t term,
   std::string const& clientId, bool leading) {
 
+  std::vector<log_t> entries;
+  entries.emplace_back(idx, term, entryBuffer(slice), clientId);
+  return logNonBlocking(entries, leading);
+}
+
+
+/// Log consecutive transactions, persisted in one transaction
+index_t State::logNonBlocking(std::vector<log_t> const& entries, bool leading) {
+
   _logLock.assertLockedByCurrentThread();
+  TRI_ASSERT(!entries.empty());
 
-  auto buf = std::make_shared<Buffer<uint8_t>>();
-  
-  buf->append((char const*)slice.begin(), slice.byteSize());
-  
-  if (!persist(idx, term, slice, clientId)) {         // log to disk or die
+  if (!persist(entries)) {         // log to disk or die
     if (leading) {
       LOG_TOPIC(FATAL, Logger::AGENCY)
         << "RAFT leader fails to persist log entries!";
@@ -209,7 +284,7 @@ index_t State::logNonBlocking(
   }
 
   try {
-    _log.push_back(log_t(idx, term, buf, clientId));  // log to RAM or die
+    _log.insert(_log.end(), entries.begin(), entries.end());  // log to RAM or die
   } catch (std::bad_alloc const&) {
     if (leading) {
       LOG_TOPIC(FATAL, Logger::AGENCY)
@@ -224,8 +299,10 @@ index_t State::logNonBlocking(
 
   if (leading) {
     try {
-      _clientIdLookupTable.emplace(            // keep track of client or die
-        std::pair<std::string, index_t>(clientId, idx));
+      for (auto const& entry : entries) {
+        _clientIdLookupTable.emplace(            // keep track of client or die
+          std::pair<std::string, index_t>(entry.clientId, entry.index));
+      }
     } catch (...) {
       LOG_TOPIC(FATAL, Logger::AGENCY)
         << "RAFT leader fails to expand client lookup table!";
@@ -295,7 +372,21 @@ index_t State::logFollower(query_t const& transactions) {
       // Now we must completely erase our log and compaction snapshots and
       // start from the snapshot
       Store snapshot(_agent, "snapshot");
-      snapshot = slices[0].get("readDB");
+      VPackSlice chunks = slices[0].get("chunks");
+      if (chunks.isNumber() && chunks.getNumber<size_t>() > 1) {
+        if (_snapshotChunksIndex != snapshotIndex ||
+            _snapshotChunks.size() + 1 != chunks.getNumber<size_t>()) {
+          LOG_TOPIC(WARN, Logger::AGENCY)
+            << "Missing chunks of received log snapshot at index "
+            << snapshotIndex << ", have " << _snapshotChunks.size()
+            << " of " << chunks.getNumber<size_t>();
+          return _log.back().index;
+        }
+        snapshot = assembleSnapshot(slices[0].get("readDB")).slice();
+        _snapshotChunks.clear();
+      } else {
+        snapshot = slices[0].get("readDB");
+      }
       if (!storeLogFromSnapshot(snapshot, snapshotIndex, snapshotTerm)) {
         LOG_TOPIC(FATAL, Logger::AGENCY)
           << "Could not restore received log snapshot.";
@@ -313,22 +404,79 @@ index_t State::logFollower(query_t const& transactions) {
     VPackSlice slices = transactions->slice();
     TRI_ASSERT(slices.isArray());
     size_t nqs = slices.length();
-    std::string clientId;
 
+    // the whole package goes to disk in one transaction
+    std::vector<log_t> entries;
+    entries.reserve(nqs - ndups);
     for (size_t i = ndups; i < nqs; ++i) {
-
       VPackSlice const& slice = slices[i];
-      // first to disk
-      if (logNonBlocking(
-            slice.get("index").getUInt(), slice.get("query"),
-            slice.get("term").getUInt(), slice.get("clientId").copyString())==0) {
-        break;
-      }
+      entries.emplace_back(
+        slice.get("index").getUInt(), slice.get("term").getUInt(),
+        entryBuffer(slice.get("query")), slice.get("clientId").copyString());
     }
+    logNonBlocking(entries);
   }
   return _log.back().index;   // never empty
 }
 
+/// Keep a chunk of a large snapshot (follower)
+bool State::receiveSnapshotChunk(VPackSlice const& chunk) {
+
+  VPackSlice tree = chunk.get("readDBChunk");
+  if (!tree.isObject() || !chunk.get("chunk").isNumber() ||
+      !chunk.get("index").isNumber()) {
+    LOG_TOPIC(DEBUG, Logger::AGENCY)
+      << "Received malformed snapshot chunk. Discarding!";
+    return false;
+  }
+  index_t index = chunk.get("index").getNumber<index_t>();
+  size_t number = chunk.get("chunk").getNumber<size_t>();
+
+  MUTEX_LOCKER(logLock, _logLock);
+
+  if (number == 0) {
+    _snapshotChunks.clear();
+    _snapshotChunksIndex = index;
+  } else if (index != _snapshotChunksIndex ||
+             number != _snapshotChunks.size()) {
+    LOG_TOPIC(DEBUG, Logger::AGENCY)
+      << "Received snapshot chunk " << number << " at index " << index
+      << ", but expected chunk " << _snapshotChunks.size() << " at index "
+      << _snapshotChunksIndex;
+    return false;
+  }
+
+  _snapshotChunks.emplace_back();
+  _snapshotChunks.back().add(tree);
+  return true;
+}
+
+/// Snapshot from the chunks received before and the last chunk readDB,
+/// which holds its part of the tree and the other tables. Guarded by caller.
+Builder State::assembleSnapshot(VPackSlice const& readDB) const {
+
+  _logLock.assertLockedByCurrentThread();
+
+  // The chunks are objects of disjoint paths and their subtrees
+  Builder snapshot;
+  { VPackArrayBuilder a(&snapshot);
+    { VPackObjectBuilder o(&snapshot);
+      for (auto const& chunk : _snapshotChunks) {
+        for (auto const& part : VPackObjectIterator(chunk.slice())) {
+          snapshot.add(part.key.copyString(), part.value);
+        }
+      }
+      for (auto const& part : VPackObjectIterator(readDB.at(0))) {
+        snapshot.add(part.key.copyString(), part.value);
+      }
+    }
+    for (size_t i = 1; i < readDB.length(); ++i) {
+      snapshot.add(readDB.at(i));
+    }
+  }
+  return snapshot;
+}
+
 size_t State::removeConflicts(query_t const& transactions,  bool gotSnapshot) { 
   // Under _logLock MUTEX from _log, which is the only place calling this.
   // Note that this will ignore a possible snapshot in the first position!
@@ -73,6 +73,10 @@ class State {
     
   /// @brief Log entries (followers)
   arangodb::consensus::index_t logFollower(query_t const&);
+
+  /// @brief Keep a chunk of a large snapshot sent by the leader (followers),
+  /// its last chunk comes with the log entries to logFollower
+  bool receiveSnapshotChunk(velocypack::Slice const& chunk);
   
   /// @brief Find entry at index with term
   bool find(index_t index, term_t term);
@@ -197,15 +201,35 @@ class State {
                               arangodb::consensus::index_t index,
                               arangodb::consensus::term_t term);
 
+  /// @brief Snapshot from the received chunks and the last one. Must be
+  /// guarded by caller.
+  velocypack::Builder assembleSnapshot(velocypack::Slice const& readDB) const;
+
   /// @brief Log single log entry. Must be guarded by caller.
   index_t logNonBlocking(
     index_t idx, velocypack::Slice const& slice, term_t term,
     std::string const& clientId = std::string(), bool leading = false);
+
+  /// @brief Log consecutive log entries, which are persisted in one
+  /// transaction. Must be guarded by caller.
+  index_t logNonBlocking(std::vector<log_t> const& entries,
+                         bool leading = false);
   
   /// @brief Save currentTerm, votedFor, log entries
   bool persist(index_t, term_t, arangodb::velocypack::Slice const&,
                std::string const&) const;
 
+  /// @brief Save consecutive log entries in one transaction
+  bool persist(std::vector<log_t> const& entries) const;
+
+  /// @brief Insert an array of log documents in one transaction
+  bool persistDocuments(arangodb::velocypack::Slice const& documents) const;
+
+  /// @brief Add the document of a log entry to body
+  static void logDocument(arangodb::velocypack::Builder& body, index_t index,
+                          term_t term, arangodb::velocypack::Slice const& entry,
+                          std::string const& clientId);
+
   bool saveCompacted();
 
   /// @brief Load collection from persistent store
@@ -248,6 +272,11 @@ class State {
   */
   mutable arangodb::Mutex _logLock; 
   std::deque<log_t> _log;           /**< @brief  State entries */
+
+  /// @brief Chunks of a snapshot received so far and the snapshot's index,
+  /// protected by _logLock
+  std::vector<velocypack::Builder> _snapshotChunks;
+  index_t _snapshotChunksIndex;
         // Invariant: This has at least one entry at all times!
   bool _collectionsChecked;         /**< @brief Collections checked */
   bool _collectionsLoaded;
@@ -544,25 +544,28 @@ bool Store::read(VPackSlice const& query, Builder& ret) const {
   auto cut = std::remove_if(query_strs.begin(), query_strs.end(), Empty());
   query_strs.erase(cut, query_strs.end());
 
-  // Create response tree
+  // Create response tree. The copy shares the values with the store,
+  // so only the tree itself is copied while the store is frozen.
   Node copy("copy");
-  MUTEX_LOCKER(storeLocker, _storeLock); // Freeze KV-Store for read
-  for (auto const path : query_strs) {
-    std::vector<std::string> pv = split(path, '/');
-    size_t e = _node.exists(pv).size();
-    if (e == pv.size()) {  // existing
-      copy(pv) = _node(pv);
-    } else {  // non-existing
-      for (size_t i = 0; i < pv.size() - e + 1; ++i) {
-        pv.pop_back();
-      }
-      if (copy(pv).type() == LEAF && copy(pv).slice().isNone()) {
-        copy(pv) = arangodb::basics::VelocyPackHelper::EmptyObjectValue();
+  {
+    MUTEX_LOCKER(storeLocker, _storeLock); // Freeze KV-Store for read
+    for (auto const path : query_strs) {
+      std::vector<std::string> pv = split(path, '/');
+      size_t e = _node.exists(pv).size();
+      if (e == pv.size()) {  // existing
+        copy(pv) = _node(pv);
+      } else {  // non-existing
+        for (size_t i = 0; i < pv.size() - e + 1; ++i) {
+          pv.pop_back();
+        }
+        if (copy(pv).type() == LEAF && copy(pv).slice().isNone()) {
+          copy(pv) = arangodb::basics::VelocyPackHelper::EmptyObjectValue();
+        }
       }
     }
   }
 
-  // Into result builder
+  // Into result builder, without blocking writers
   copy.toBuilder(ret, showHidden);
 
   return success;
@@ -153,6 +153,7 @@ Supervision::Supervision()
   _agent(nullptr),
   _snapshot("Supervision"),
   _transient("Transient"),
+  _snapshotIndex(0),
   _frequency(1.),
   _gracePeriod(5.),
   _okThreshold(1.5),
@@ -565,9 +566,16 @@ bool Supervision::updateSnapshot() {
     return false;
   }
 
+  // Copying the whole agency is expensive in large clusters. Skip it if
+  // nothing was committed since the last copy. The index is taken before
+  // the copy, so a commit in between only causes another copy next time.
+  index_t const commitIndex = _agent->lastCommitted();
+  bool const unchanged = (_snapshotIndex != 0 && commitIndex == _snapshotIndex);
+
   _agent->executeLockedRead([&]() {
-      if (_agent->readDB().has(_agencyPrefix)) {
+      if (!unchanged && _agent->readDB().has(_agencyPrefix)) {
         _snapshot = _agent->readDB().get(_agencyPrefix);
+        _snapshotIndex = commitIndex;
       }
       if (_agent->transient().has(_agencyPrefix)) {
         _transient = _agent->transient().get(_agencyPrefix);
@@ -643,6 +651,7 @@ void Supervision::run() {
       if (_agent->readDB().has(supervisionNode)) {
         try {
           _snapshot = _agent->readDB().get(supervisionNode);
+          _snapshotIndex = 0;
           if (_snapshot.children().size() > 0) {
             done = true;
           }
@@ -824,6 +833,26 @@ void Supervision::enforceReplication() {
   _lock.assertLockedByCurrentThread();
   auto const& plannedDBs = _snapshot.hasAsChildren(planColPrefix).first;
 
+  // Shards with an addFollower, removeFollower or moveShard job in ToDo,
+  // collected once instead of scanning ToDo for every shard
+  std::unordered_set<std::string> scheduled;
+  for (auto const& pair : _snapshot.hasAsChildren(toDoPrefix).first) {
+    auto const& job = pair.second;
+    auto tmp_type = job->hasAsString("type");
+    if (tmp_type.first == "addFollower"
+        || tmp_type.first == "removeFollower"
+        || tmp_type.first == "moveShard") {
+      auto tmp_shard = job->hasAsString("shard");
+      if (tmp_shard.second) {
+        scheduled.emplace(tmp_shard.first);
+      }
+    }
+  }
+
+  // Number of available servers, only needed for satellite collections
+  size_t available = 0;
+  bool availableKnown = false;
+
   for (const auto& db_ : plannedDBs) { // Planned databases
     auto const& db = *(db_.second);
     for (const auto& col_ : db.children()) { // Planned collections
@@ -840,8 +869,11 @@ void Supervision::enforceReplication() {
 
       // mop: satellites => distribute to every server
       if (replicationFactor == 0) {
-        auto available = Job::availableServers(_snapshot);
-        replicationFactor = available.size();
+        if (!availableKnown) {
+          available = Job::availableServers(_snapshot).size();
+          availableKnown = true;
+        }
+        replicationFactor = available;
       }
 
       bool clone = col.has("distributeShardsLike");
@@ -854,22 +886,12 @@ void Supervision::enforceReplication() {
           if (actualReplicationFactor != replicationFactor) {
             // Check that there is not yet an addFollower or removeFollower
             // or moveShard job in ToDo for this shard:
-            auto const& todo = _snapshot.hasAsChildren(toDoPrefix).first;
             bool found = false;
-            for (auto const& pair : todo) {
-              auto const& job = pair.second;
-              auto tmp_type = job->hasAsString("type");
-              auto tmp_shard = job->hasAsString("shard");
-              if ((tmp_type.first == "addFollower"
-                   || tmp_type.first == "removeFollower"
-                   || tmp_type.first == "moveShard")
-                  && tmp_shard.first == shard_.first) {
-                found = true;
-                LOG_TOPIC(DEBUG, Logger::SUPERVISION) << "already found "
-                  "addFollower or removeFollower job in ToDo, not scheduling "
-                  "again for shard " << shard_.first;
-                break;
-              }
+            if (scheduled.find(shard_.first) != scheduled.end()) {
+              found = true;
+              LOG_TOPIC(DEBUG, Logger::SUPERVISION) << "already found "
+                "addFollower or removeFollower job in ToDo, not scheduling "
+                "again for shard " << shard_.first;
             }
             // Check that shard is not locked:
             if (_snapshot.has(blockedShardsPrefix + shard_.first)) {
@@ -182,6 +182,7 @@ class Supervision : public arangodb::CriticalThread {
   Agent* _agent; /**< @brief My agent */
   Node _snapshot;
   Node _transient;
+  index_t _snapshotIndex; // commit index of _snapshot, 0 if not a full copy
 
   arangodb::basics::ConditionVariable _cv; /**< @brief Control if thread
                                               should run */
@@ -36,8 +36,9 @@ using namespace arangodb::aql;
 using VelocyPackHelper = arangodb::basics::VelocyPackHelper;
 
 /// @brief create the block
-AqlItemBlock::AqlItemBlock(ResourceMonitor* resourceMonitor, size_t nrItems, RegisterId nrRegs)
-    : _nrItems(nrItems), _nrRegs(nrRegs), _resourceMonitor(resourceMonitor) {
+AqlItemBlock::AqlItemBlock(ResourceMonitor* resourceMonitor, size_t nrItems, RegisterId nrRegs,
+                           ItemBlockLayout layout)
+    : _nrItems(nrItems), _nrRegs(nrRegs), _layout(layout), _resourceMonitor(resourceMonitor) {
   TRI_ASSERT(resourceMonitor != nullptr);
   TRI_ASSERT(nrItems > 0);  // empty AqlItemBlocks are not allowed!
 
@@ -59,7 +60,8 @@ AqlItemBlock::AqlItemBlock(ResourceMonitor* resourceMonitor, size_t nrItems, Reg
 
 /// @brief create the block from VelocyPack, note that this can throw
 AqlItemBlock::AqlItemBlock(ResourceMonitor* resourceMonitor, VPackSlice const slice)
-    : _nrItems(0), _nrRegs(0), _resourceMonitor(resourceMonitor) {
+    : _nrItems(0), _nrRegs(0), _layout(ItemBlockLayout::ROW_MAJOR),
+      _resourceMonitor(resourceMonitor) {
   TRI_ASSERT(resourceMonitor != nullptr);
 
   int64_t nrItems = VelocyPackHelper::getNumericValue<int64_t>(slice, "nrItems", 0);
@@ -174,21 +176,15 @@ void AqlItemBlock::destroy() {
 
   for (auto& it : _data) {
     if (it.requiresDestruction()) {
-      try {  // can find() really throw???
-        auto it2 = _valueCount.find(it);
-        if (it2 != _valueCount.end()) {  // if we know it, we are still responsible
-          TRI_ASSERT((*it2).second > 0);
-
-          if (--((*it2).second) == 0) {
-            decreaseMemoryUsage(it.memoryUsage());
-            it.destroy();
-            try {
-              _valueCount.erase(it2);
-            } catch (...) {
-            }
-          }
+      uint32_t* count = _valueCount.find(it);
+      if (count != nullptr) {  // if we know it, we are still responsible
+        TRI_ASSERT(*count > 0);
+
+        if (--(*count) == 0) {
+          decreaseMemoryUsage(it.memoryUsage());
+          _valueCount.erase(it);
+          it.destroy();
         }
-      } catch (...) {
       }
       // Note that if we do not know it the thing it has been stolen from us!
     } else {
@@ -217,12 +213,23 @@ void AqlItemBlock::shrink(size_t nrItems) {
 
   decreaseMemoryUsage(sizeof(AqlValue) * (_nrItems - nrItems) * _nrRegs);
 
+  if (_layout == ItemBlockLayout::COLUMN_MAJOR) {
+    // the first column is already in place. all following columns must
+    // be moved towards the front, as the column stride changes
+    for (RegisterId col = 1; col < _nrRegs; ++col) {
+      for (size_t row = 0; row < nrItems; ++row) {
+        _data[col * nrItems + row] = _data[col * _nrItems + row];
+      }
+    }
+  }
+
   // adjust the size of the block
   _nrItems = nrItems;
   _data.resize(_nrItems * _nrRegs);
 }
 
-void AqlItemBlock::rescale(size_t nrItems, RegisterId nrRegs) {
+void AqlItemBlock::rescale(size_t nrItems, RegisterId nrRegs,
+                           ItemBlockLayout layout) {
   TRI_ASSERT(_valueCount.empty());
   TRI_ASSERT(nrRegs <= ExecutionNode::MaxRegisterId);
 
@@ -251,6 +258,7 @@ void AqlItemBlock::rescale(size_t nrItems, RegisterId nrRegs) {
   TRI_ASSERT(_data.size() >= targetSize);
   _nrItems = nrItems;
   _nrRegs = nrRegs;
+  _layout = layout;
 }
 
 /// @brief clears out some columns (registers), this deletes the values if
@@ -258,28 +266,37 @@ void AqlItemBlock::rescale(size_t nrItems, RegisterId nrRegs) {
 void AqlItemBlock::clearRegisters(
     std::unordered_set<RegisterId> const& toClear) {
 
-  for (size_t i = 0; i < _nrItems; i++) {
-    for (auto const& reg : toClear) {
-      AqlValue& a(_data[_nrRegs * i + reg]);
-
-      if (a.requiresDestruction()) {
-        auto it = _valueCount.find(a);
+  auto clearValue = [this](AqlValue& a) {
+    if (a.requiresDestruction()) {
+      uint32_t* count = _valueCount.find(a);
 
-        if (it != _valueCount.end()) {
-          TRI_ASSERT((*it).second > 0);
+      if (count != nullptr) {
+        TRI_ASSERT(*count > 0);
 
-          if (--((*it).second) == 0) {
-            decreaseMemoryUsage(a.memoryUsage());
-            a.destroy();
-            try {
-              _valueCount.erase(it);
-              continue;  // no need for an extra a.erase() here
-            } catch (...) {
-            }
-          }
+        if (--(*count) == 0) {
+          decreaseMemoryUsage(a.memoryUsage());
+          _valueCount.erase(a);
+          a.destroy();
+          return;  // no need for an extra a.erase() here
         }
       }
-      a.erase();
+    }
+    a.erase();
+  };
+
+  if (_layout == ItemBlockLayout::COLUMN_MAJOR) {
+    // walk each cleared column sequentially
+    for (auto const& reg : toClear) {
+      for (size_t i = 0; i < _nrItems; i++) {
+        clearValue(_data[getAddress(i, reg)]);
+      }
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < _nrItems; i++) {
+    for (auto const& reg : toClear) {
+      clearValue(_data[getAddress(i, reg)]);
     }
   }
 }
@@ -291,11 +308,11 @@ AqlItemBlock* AqlItemBlock::slice(size_t from, size_t to) const {
   std::unordered_set<AqlValue> cache;
   cache.reserve((to - from) * _nrRegs / 4 + 1);
 
-  auto res = std::make_unique<AqlItemBlock>(_resourceMonitor, to - from, _nrRegs);
+  auto res = std::make_unique<AqlItemBlock>(_resourceMonitor, to - from, _nrRegs, _layout);
 
   for (size_t row = from; row < to; row++) {
     for (RegisterId col = 0; col < _nrRegs; col++) {
-      AqlValue const& a(_data[row * _nrRegs + col]);
+      AqlValue const& a(_data[getAddress(row, col)]);
 
       if (!a.isEmpty()) {
         if (a.requiresDestruction()) {
@@ -327,35 +344,45 @@ AqlItemBlock* AqlItemBlock::slice(size_t from, size_t to) const {
 /// @brief slice/clone, this does a deep copy of all entries
 AqlItemBlock* AqlItemBlock::slice(
     size_t row, std::unordered_set<RegisterId> const& registers) const {
+  return slice(row, row + 1, registers);
+}
+
+/// @brief slice/clone, this does a deep copy of the specified registers
+AqlItemBlock* AqlItemBlock::slice(
+    size_t from, size_t to, std::unordered_set<RegisterId> const& registers) const {
+  TRI_ASSERT(from < to && to <= _nrItems);
+
   std::unordered_set<AqlValue> cache;
 
-  auto res = std::make_unique<AqlItemBlock>(_resourceMonitor, 1, _nrRegs);
+  auto res = std::make_unique<AqlItemBlock>(_resourceMonitor, to - from, _nrRegs, _layout);
 
-  for (RegisterId col = 0; col < _nrRegs; col++) {
-    if (registers.find(col) == registers.end()) {
-      continue;
-    }
+  for (size_t row = from; row < to; row++) {
+    for (RegisterId col = 0; col < _nrRegs; col++) {
+      if (registers.find(col) == registers.end()) {
+        continue;
+      }
 
-    AqlValue const& a(_data[row * _nrRegs + col]);
+      AqlValue const& a(_data[getAddress(row, col)]);
 
-    if (!a.isEmpty()) {
-      if (a.requiresDestruction()) {
-        auto it = cache.find(a);
+      if (!a.isEmpty()) {
+        if (a.requiresDestruction()) {
+          auto it = cache.find(a);
 
-        if (it == cache.end()) {
-          AqlValue b = a.clone();
-          try {
-            res->setValue(0, col, b);
-          } catch (...) {
-            b.destroy();
-            throw;
+          if (it == cache.end()) {
+            AqlValue b = a.clone();
+            try {
+              res->setValue(row - from, col, b);
+            } catch (...) {
+              b.destroy();
+              throw;
+            }
+            cache.emplace(b);
+          } else {
+            res->setValue(row - from, col, (*it));
           }
-          cache.emplace(b);
         } else {
-          res->setValue(0, col, (*it));
+          res->setValue(row - from, col, a);
         }
-      } else {
-        res->setValue(0, col, a);
       }
     }
   }
@@ -372,11 +399,11 @@ AqlItemBlock* AqlItemBlock::slice(std::vector<size_t> const& chosen, size_t from
   std::unordered_set<AqlValue> cache;
   cache.reserve((to - from) * _nrRegs / 4 + 1);
 
-  auto res = std::make_unique<AqlItemBlock>(_resourceMonitor, to - from, _nrRegs);
+  auto res = std::make_unique<AqlItemBlock>(_resourceMonitor, to - from, _nrRegs, _layout);
 
   for (size_t row = from; row < to; row++) {
     for (RegisterId col = 0; col < _nrRegs; col++) {
-      AqlValue const& a(_data[chosen[row] * _nrRegs + col]);
+      AqlValue const& a(_data[getAddress(chosen[row], col)]);
 
       if (!a.isEmpty()) {
         if (a.requiresDestruction()) {
@@ -414,11 +441,11 @@ AqlItemBlock* AqlItemBlock::steal(std::vector<size_t> const& chosen, size_t from
                                   size_t to) {
   TRI_ASSERT(from < to && to <= chosen.size());
 
-  auto res = std::make_unique<AqlItemBlock>(_resourceMonitor, to - from, _nrRegs);
+  auto res = std::make_unique<AqlItemBlock>(_resourceMonitor, to - from, _nrRegs, _layout);
 
   for (size_t row = from; row < to; row++) {
     for (RegisterId col = 0; col < _nrRegs; col++) {
-      AqlValue& a(_data[chosen[row] * _nrRegs + col]);
+      AqlValue& a(_data[getAddress(chosen[row], col)]);
 
       if (!a.isEmpty()) {
         steal(a);
@@ -462,7 +489,8 @@ AqlItemBlock* AqlItemBlock::concatenate(ResourceMonitor* resourceMonitor,
   TRI_ASSERT(totalSize > 0);
   TRI_ASSERT(nrRegs > 0);
 
-  auto res = std::make_unique<AqlItemBlock>(resourceMonitor, totalSize, nrRegs);
+  auto res = std::make_unique<AqlItemBlock>(resourceMonitor, totalSize, nrRegs,
+                                            blocks[0]->layout());
 
   size_t pos = 0;
   for (auto& it : blocks) {
@@ -545,7 +573,7 @@ void AqlItemBlock::toVelocyPack(transaction::Methods* trx,
   size_t pos = 2;  // write position in raw
   for (RegisterId column = 0; column < _nrRegs; column++) {
     for (size_t i = 0; i < _nrItems; i++) {
-      AqlValue const& a(_data[i * _nrRegs + column]);
+      AqlValue const& a(_data[getAddress(i, column)]);
       if (a.isEmpty()) {
         emptyCount++;
       } else {
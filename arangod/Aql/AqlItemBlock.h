@@ -26,6 +26,7 @@
 
 #include "Basics/Common.h"
 #include "Aql/AqlValue.h"
+#include "Aql/AqlValueCounter.h"
 #include "Aql/Range.h"
 #include "Aql/ResourceUsage.h"
 #include "Aql/types.h"
@@ -46,6 +47,11 @@ class BlockCollector;
 // <getDocumentCollections>. There is no access to an entire item, only
 // access to particular registers of an item (via getValue).
 //
+// The values are stored either row-major (all registers of an item are
+// adjacent, the default) or column-major (all items of a register are
+// adjacent). The layout is fixed for the lifetime of a block and is not
+// visible through the accessors.
+//
 // An AqlItemBlock is responsible to explicitly destroy all the
 // <AqlValue>s it contains at destruction time. It is however allowed
 // that multiple of the <AqlValue>s in it are pointing to identical
@@ -64,7 +70,8 @@ class AqlItemBlock {
   AqlItemBlock& operator=(AqlItemBlock const&) = delete;
 
   /// @brief create the block
-  AqlItemBlock(ResourceMonitor*, size_t nrItems, RegisterId nrRegs);
+  AqlItemBlock(ResourceMonitor*, size_t nrItems, RegisterId nrRegs,
+               ItemBlockLayout layout = ItemBlockLayout::ROW_MAJOR);
 
   AqlItemBlock(ResourceMonitor*, arangodb::velocypack::Slice const);
 
@@ -85,36 +92,44 @@ class AqlItemBlock {
     _resourceMonitor->decreaseMemoryUsage(value);
   }
 
+  /// @brief position of a register value in _data
+  inline size_t getAddress(size_t index, RegisterId varNr) const {
+    if (_layout == ItemBlockLayout::ROW_MAJOR) {
+      return index * _nrRegs + varNr;
+    }
+    return varNr * _nrItems + index;
+  }
+
  public:
   /// @brief getValue, get the value of a register
   AqlValue getValue(size_t index, RegisterId varNr) const {
-    TRI_ASSERT(_data.capacity() > index * _nrRegs + varNr);
-    return _data[index * _nrRegs + varNr];
+    TRI_ASSERT(_data.capacity() > getAddress(index, varNr));
+    return _data[getAddress(index, varNr)];
   }
 
   /// @brief getValue, get the value of a register by reference
   inline AqlValue const& getValueReference(size_t index, RegisterId varNr) const {
-    TRI_ASSERT(_data.size() > index * _nrRegs + varNr);
-    return _data[index * _nrRegs + varNr];
+    TRI_ASSERT(_data.size() > getAddress(index, varNr));
+    return _data[getAddress(index, varNr)];
   }
 
   /// @brief setValue, set the current value of a register
   void setValue(size_t index, RegisterId varNr, AqlValue const& value) {
-    TRI_ASSERT(_data.capacity() > index * _nrRegs + varNr);
-    TRI_ASSERT(_data[index * _nrRegs + varNr].isEmpty());
+    TRI_ASSERT(_data.capacity() > getAddress(index, varNr));
+    TRI_ASSERT(_data[getAddress(index, varNr)].isEmpty());
 
     size_t mem = 0;
 
     // First update the reference count, if this fails, the value is empty
     if (value.requiresDestruction()) {
-      if (++_valueCount[value] == 1) {
+      if (_valueCount.increment(value) == 1) {
         mem = value.memoryUsage();
         increaseMemoryUsage(mem);
       }
     }
 
     try {
-      _data[index * _nrRegs + varNr] = value;
+      _data[getAddress(index, varNr)] = value;
     } catch (...) {
       decreaseMemoryUsage(mem);
       throw;
@@ -125,24 +140,24 @@ class AqlItemBlock {
   /// it in place
   template <typename... Args>
   void emplaceValue(size_t index, RegisterId varNr, Args&&... args) {
-    TRI_ASSERT(_data.capacity() > index * _nrRegs + varNr);
-    TRI_ASSERT(_data[index * _nrRegs + varNr].isEmpty());
+    TRI_ASSERT(_data.capacity() > getAddress(index, varNr));
+    TRI_ASSERT(_data[getAddress(index, varNr)].isEmpty());
 
-    void* p = &_data[index * _nrRegs + varNr];
+    void* p = &_data[getAddress(index, varNr)];
     // construct the AqlValue in place
     AqlValue* value;
     try {
       value = new (p) AqlValue(std::forward<Args>(args)...);
     } catch (...) {
       // clean up the cell
-      _data[index * _nrRegs + varNr].erase();
+      _data[getAddress(index, varNr)].erase();
       throw;
     }
 
     try {
       // Now update the reference count, if this fails, we'll roll it back
       if (value->requiresDestruction()) {
-        if (++_valueCount[*value] == 1) {
+        if (_valueCount.increment(*value) == 1) {
           increaseMemoryUsage(value->memoryUsage());
         }
       }
@@ -150,7 +165,7 @@ class AqlItemBlock {
       // invoke dtor
       value->~AqlValue();
 
-      _data[index * _nrRegs + varNr].destroy();
+      _data[getAddress(index, varNr)].destroy();
       throw;
     }
   }
@@ -160,21 +175,16 @@ class AqlItemBlock {
   /// use with caution only in special situations when it can be ensured that
   /// no one else will be pointing to the same value
   void destroyValue(size_t index, RegisterId varNr) {
-    auto& element = _data[index * _nrRegs + varNr];
+    auto& element = _data[getAddress(index, varNr)];
 
     if (element.requiresDestruction()) {
-      auto it = _valueCount.find(element);
-
-      if (it != _valueCount.end()) {
-        if (--(it->second) == 0) {
-          decreaseMemoryUsage(element.memoryUsage());
-          try {
-            _valueCount.erase(it);
-            element.destroy();
-            return;  // no need for an extra element.erase() in this case
-          } catch (...) {
-          }
-        }
+      uint32_t* count = _valueCount.find(element);
+
+      if (count != nullptr && --(*count) == 0) {
+        decreaseMemoryUsage(element.memoryUsage());
+        _valueCount.erase(element);
+        element.destroy();
+        return;  // no need for an extra element.erase() in this case
       }
     }
 
@@ -184,19 +194,14 @@ class AqlItemBlock {
   /// @brief eraseValue, erase the current value of a register not freeing it
   /// this is used if the value is stolen and later released from elsewhere
   void eraseValue(size_t index, RegisterId varNr) {
-    auto& element = _data[index * _nrRegs + varNr];
+    auto& element = _data[getAddress(index, varNr)];
 
     if (element.requiresDestruction()) {
-      auto it = _valueCount.find(element);
-
-      if (it != _valueCount.end()) {
-        if (--(it->second) == 0) {
-          decreaseMemoryUsage(element.memoryUsage());
-          try {
-            _valueCount.erase(it);
-          } catch (...) {
-          }
-        }
+      uint32_t* count = _valueCount.find(element);
+
+      if (count != nullptr && --(*count) == 0) {
+        decreaseMemoryUsage(element.memoryUsage());
+        _valueCount.erase(element);
       }
     }
 
@@ -212,11 +217,11 @@ class AqlItemBlock {
       }
     }
 
-    for (auto const& it : _valueCount) {
-      if (it.second > 0) {
-        decreaseMemoryUsage(it.first.memoryUsage());
+    _valueCount.forEach([this](AqlValue const& value, uint32_t count) {
+      if (count > 0) {
+        decreaseMemoryUsage(value.memoryUsage());
       }
-    }
+    });
     _valueCount.clear();
   }
 
@@ -227,7 +232,8 @@ class AqlItemBlock {
       // nothing to do
       return;
     }
-    TRI_ASSERT(_data.size() > currentRow * _nrRegs + curRegs);
+    TRI_ASSERT(currentRow < _nrItems);
+    TRI_ASSERT(curRegs <= _nrRegs);
 
     copyValuesFromRow(currentRow, curRegs, 0);
   }
@@ -236,12 +242,14 @@ class AqlItemBlock {
     TRI_ASSERT(currentRow != fromRow);
 
     for (RegisterId i = 0; i < curRegs; i++) {
-      if (_data[currentRow * _nrRegs + i].isEmpty()) {
+      AqlValue& target = _data[getAddress(currentRow, i)];
+      if (target.isEmpty()) {
+        AqlValue const& source = _data[getAddress(fromRow, i)];
         // First update the reference count, if this fails, the value is empty
-        if (_data[fromRow * _nrRegs + i].requiresDestruction()) {
-          ++_valueCount[_data[fromRow * _nrRegs + i]];
+        if (source.requiresDestruction()) {
+          _valueCount.increment(source);
         }
-        _data[currentRow * _nrRegs + i] = _data[fromRow * _nrRegs + i];
+        target = source;
       }
     }
   }
@@ -249,12 +257,7 @@ class AqlItemBlock {
   /// @brief valueCount
   /// this is used if the value is stolen and later released from elsewhere
   uint32_t valueCount(AqlValue const& v) const {
-    auto it = _valueCount.find(v);
-
-    if (it == _valueCount.end()) {
-      return 0;
-    }
-    return it->second;
+    return _valueCount.count(v);
   }
 
   /// @brief steal, steal an AqlValue from an AqlItemBlock, it will never free
@@ -274,17 +277,33 @@ class AqlItemBlock {
 
   /// @brief getter for _nrItems
   inline size_t size() const { return _nrItems; }
+
+  /// @brief number of bytes the rows and the values the block owns take
+  size_t memoryUsage() const {
+    size_t usage = sizeof(AqlValue) * _nrItems * _nrRegs;
+    _valueCount.forEach([&usage](AqlValue const& value, uint32_t) {
+      usage += value.memoryUsage();
+    });
+    return usage;
+  }
   
   inline size_t capacity() const { return _data.size(); }
 
+  /// @brief number of values the block has allocated room for. this can be
+  /// more than capacity() after the block was shrunk or rescaled
+  inline size_t allocatedCapacity() const { return _data.capacity(); }
+
+  /// @brief getter for the memory layout of the block
+  inline ItemBlockLayout layout() const { return _layout; }
+
   /// @brief shrink the block to the specified number of rows
   /// the superfluous rows are cleaned
   void shrink(size_t nrItems);
 
-  /// @brief rescales the block to the specified dimensions
+  /// @brief rescales the block to the specified dimensions and layout
   /// note that the block should be empty before rescaling to prevent
   /// losses of still managed AqlValues 
-  void rescale(size_t nrItems, RegisterId nrRegs);
+  void rescale(size_t nrItems, RegisterId nrRegs, ItemBlockLayout layout);
 
   /// @brief clears out some columns (registers), this deletes the values if
   /// necessary, using the reference count.
@@ -297,6 +316,11 @@ class AqlItemBlock {
   /// specified registers from the current block
   AqlItemBlock* slice(size_t row, std::unordered_set<RegisterId> const&) const;
 
+  /// @brief create an AqlItemBlock with the rows [from, to), with copies of
+  /// the specified registers from the current block
+  AqlItemBlock* slice(size_t from, size_t to,
+                      std::unordered_set<RegisterId> const&) const;
+
   /// @brief slice/clone chosen rows for a subset, this does a deep copy
   /// of all entries
   AqlItemBlock* slice(std::vector<size_t> const& chosen, size_t from,
@@ -328,12 +352,13 @@ class AqlItemBlock {
   std::vector<AqlValue> _data;
 
   /// @brief _valueCount, since we have to allow for identical AqlValues
-  /// in an AqlItemBlock, this map keeps track over which AqlValues we
+  /// in an AqlItemBlock, this table keeps track over which AqlValues we
   /// have in this AqlItemBlock and how often.
-  /// setValue above puts values in the map and increases the count if they
+  /// setValue above puts values in the table and increases the count if they
   /// are already there, eraseValue decreases the count. One can ask the
-  /// count with valueCount.
-  std::unordered_map<AqlValue, uint32_t> _valueCount;
+  /// count with valueCount. The table keeps its memory when the block is
+  /// recycled by the AqlItemBlockManager.
+  AqlValueCounter _valueCount;
 
   /// @brief _nrItems, number of rows
   size_t _nrItems;
@@ -341,6 +366,9 @@ class AqlItemBlock {
   /// @brief _nrRegs, number of columns
   RegisterId _nrRegs;
 
+  /// @brief _layout, whether values are stored row- or column-major
+  ItemBlockLayout _layout;
+
   /// @brief resources manager for this item block
   ResourceMonitor* _resourceMonitor;
 };
@@ -27,8 +27,9 @@
 using namespace arangodb::aql;
 
 /// @brief create the manager
-AqlItemBlockManager::AqlItemBlockManager(ResourceMonitor* resourceMonitor) 
-    : _resourceMonitor(resourceMonitor) {}
+AqlItemBlockManager::AqlItemBlockManager(ResourceMonitor* resourceMonitor,
+                                         ItemBlockLayout layout) 
+    : _resourceMonitor(resourceMonitor), _layout(layout) {}
 
 /// @brief destroy the manager
 AqlItemBlockManager::~AqlItemBlockManager() { }
@@ -42,31 +43,31 @@ AqlItemBlock* AqlItemBlockManager::requestBlock(size_t nrItems,
   AqlItemBlock* block = nullptr;
   size_t i = Bucket::getId(targetSize);
 
-  int tries = 0;
-  while (tries++ < 2) {
-    TRI_ASSERT(i < NumBuckets);
-    if (!_buckets[i].empty()) {
-      block = _buckets[i].pop();
-      TRI_ASSERT(block != nullptr);
-      block->eraseAll();
-      block->rescale(nrItems, nrRegs);
-      // LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "returned cached AqlItemBlock with dimensions " << block->size() << " x " << block->getNrRegs();
-      break;
-    }
-    // try next (bigger) bucket
-    if (++i >= NumBuckets) {
-      break;
-    }
+  // returned blocks are sorted into the buckets by the number of values
+  // they have allocated. the target bucket may contain blocks that are too
+  // small, so only take a block from it that fits. all blocks in the next
+  // (bigger) bucket fit anyway
+  TRI_ASSERT(i < NumBuckets);
+  if (!_buckets[i].empty()) {
+    block = _buckets[i].popFitting(targetSize);
+  }
+  if (block == nullptr && ++i < NumBuckets && !_buckets[i].empty()) {
+    block = _buckets[i].pop();
   }
 
-  if (block == nullptr) {
-    block = new AqlItemBlock(_resourceMonitor, nrItems, nrRegs);
+  if (block != nullptr) {
+    block->eraseAll();
+    block->rescale(nrItems, nrRegs, _layout);
+    // LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "returned cached AqlItemBlock with dimensions " << block->size() << " x " << block->getNrRegs();
+  } else {
+    block = new AqlItemBlock(_resourceMonitor, nrItems, nrRegs, _layout);
     // LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "created AqlItemBlock with dimensions " << block->size() << " x " << block->getNrRegs();
   }
  
   TRI_ASSERT(block != nullptr);
   TRI_ASSERT(block->size() == nrItems);   
   TRI_ASSERT(block->getNrRegs() == nrRegs);
+  TRI_ASSERT(block->layout() == _layout);
   TRI_ASSERT(block->capacity() >= targetSize);
   return block;
 }
@@ -77,8 +78,9 @@ void AqlItemBlockManager::returnBlock(AqlItemBlock*& block) {
 
   // LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "returning AqlItemBlock of dimensions " << block->size() << " x " << block->getNrRegs();
   
-  size_t const targetSize = block->size() * block->getNrRegs();
-  size_t const i = Bucket::getId(targetSize);
+  // file the block by the room it has allocated, not by its current
+  // dimensions, so that a shrunk block can be reused at its full size
+  size_t const i = Bucket::getId(block->allocatedCapacity());
   TRI_ASSERT(i < NumBuckets);
 
   if (!_buckets[i].full()) {
@@ -97,19 +99,8 @@ void AqlItemBlockManager::returnBlock(AqlItemBlock*& block) {
 void AqlItemBlockManager::returnBlock(std::unique_ptr<AqlItemBlock> block) {
   TRI_ASSERT(block != nullptr);
 
-  // LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "returning AqlItemBlock of dimensions " << block->size() << " x " << block->getNrRegs();
-  
-  size_t const targetSize = block->size() * block->getNrRegs();
-  size_t const i = Bucket::getId(targetSize);
-  TRI_ASSERT(i < NumBuckets);
-
-  if (!_buckets[i].full()) {
-    // recycle the block
-    block->destroy();
-    // store block in bucket (this will not fail)
-    _buckets[i].push(block.release());
-  }
-  block.reset();
+  AqlItemBlock* b = block.release();
+  returnBlock(b);
 }
 
 
@@ -125,3 +116,23 @@ AqlItemBlockManager::Bucket::~Bucket() {
     delete blocks[i];
   }
 }
+
+/// @brief pop a block that has already allocated room for at least
+/// targetSize values
+AqlItemBlock* AqlItemBlockManager::Bucket::popFitting(size_t targetSize) {
+  size_t i = NumBlocks;
+  while (i--) {
+    if (blocks[i] != nullptr && blocks[i]->allocatedCapacity() >= targetSize) {
+      AqlItemBlock* result = blocks[i];
+      // keep the occupied slots contiguous, as push() and empty() expect
+      size_t last = i;
+      while (last + 1 < NumBlocks && blocks[last + 1] != nullptr) {
+        ++last;
+      }
+      blocks[i] = blocks[last];
+      blocks[last] = nullptr;
+      return result;
+    }
+  }
+  return nullptr;
+}
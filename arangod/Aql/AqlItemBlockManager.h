@@ -37,8 +37,10 @@ struct ResourceMonitor;
 
 class AqlItemBlockManager {
  public:
-  /// @brief create the manager
-  explicit AqlItemBlockManager(ResourceMonitor*);
+  /// @brief create the manager. all blocks handed out by the manager
+  /// will use the specified memory layout
+  explicit AqlItemBlockManager(ResourceMonitor*,
+                               ItemBlockLayout layout = ItemBlockLayout::ROW_MAJOR);
 
   /// @brief destroy the manager
   ~AqlItemBlockManager();
@@ -55,13 +57,17 @@ class AqlItemBlockManager {
 
   ResourceMonitor* resourceMonitor() const { return _resourceMonitor; }
 
+  ItemBlockLayout layout() const { return _layout; }
+
  private:
   ResourceMonitor* _resourceMonitor;
+
+  ItemBlockLayout const _layout;
     
   static constexpr size_t NumBuckets = 12;
 
   struct Bucket {
-    static constexpr size_t NumBlocks = 4;
+    static constexpr size_t NumBlocks = 8;
 
     Bucket();
     ~Bucket(); 
@@ -89,6 +95,11 @@ class AqlItemBlockManager {
       return nullptr;
     }
 
+    /// @brief pop a block that has already allocated room for at least
+    /// targetSize values, so that rescaling it will not allocate. returns
+    /// a nullptr if there is no such block in the bucket
+    AqlItemBlock* popFitting(size_t targetSize);
+
     void push(AqlItemBlock* block) {
       TRI_ASSERT(!full());
       for (size_t i = 0; i < NumBlocks; ++i) {
@@ -975,7 +975,9 @@ void AqlValue::destroy() noexcept {
       return;
     }
     case VPACK_MANAGED_SLICE: {
-      delete[] _data.slice;
+      // allocated with the byte size of the slice
+      basics::ThreadCachingAllocator::deallocate(
+          _data.slice, VPackSlice(_data.slice).byteSize());
       break;
     }
     case VPACK_MANAGED_BUFFER: {
@@ -29,6 +29,7 @@
 #include "Aql/Range.h"
 #include "Aql/types.h"
 #include "Basics/ConditionalDeleter.h"
+#include "Basics/ThreadCachingAllocator.h"
 #include "Basics/VelocyPackHelper.h"
 
 #include <velocypack/Buffer.h>
@@ -308,14 +309,16 @@ struct AqlValue final {
     } else if (length <= 126) {
       // short string... cannot store inline, but we don't need to
       // create a full-featured Builder object here
-      _data.slice = new uint8_t[length + 1];
+      _data.slice = static_cast<uint8_t*>(
+          basics::ThreadCachingAllocator::allocate(length + 1));
       _data.slice[0] = static_cast<uint8_t>(0x40U + length);
       memcpy(&_data.slice[1], value, length);
       setType(AqlValueType::VPACK_MANAGED_SLICE);
     } else {
       // long string
       // create a big enough uint8_t buffer
-      _data.slice = new uint8_t[length + 9];
+      _data.slice = static_cast<uint8_t*>(
+          basics::ThreadCachingAllocator::allocate(length + 9));
       _data.slice[0] = static_cast<uint8_t>(0xbfU);
       uint64_t v = length;
       for (uint64_t i = 0; i < 8; ++i) {
@@ -606,7 +609,8 @@ struct AqlValue final {
       setType(AqlValueType::VPACK_INLINE);
     } else {
       // Use managed slice
-      _data.slice = new uint8_t[length];
+      _data.slice = static_cast<uint8_t*>(
+          basics::ThreadCachingAllocator::allocate(length));
       memcpy(&_data.slice[0], slice.begin(), length);
       setType(AqlValueType::VPACK_MANAGED_SLICE);
     }
@@ -0,0 +1,194 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_AQL_VALUE_COUNTER_H
+#define ARANGOD_AQL_AQL_VALUE_COUNTER_H 1
+
+#include "Basics/Common.h"
+#include "Aql/AqlValue.h"
+
+namespace arangodb {
+namespace aql {
+
+/// @brief reference counts of the AqlValues in an AqlItemBlock. this is a
+/// flat hash table with open addressing and linear probing, so all counts
+/// live in a single allocation. the allocation is kept when the table is
+/// cleared, so that a recycled AqlItemBlock does not allocate again. only
+/// values that require destruction may be counted, so empty AqlValues can
+/// mark free slots
+class AqlValueCounter {
+ public:
+  AqlValueCounter() : _size(0), _mask(0) {}
+
+  AqlValueCounter(AqlValueCounter const&) = delete;
+  AqlValueCounter& operator=(AqlValueCounter const&) = delete;
+
+  /// @brief whether or not the table contains no values
+  bool empty() const noexcept { return _size == 0; }
+
+  /// @brief number of different values in the table
+  size_t size() const noexcept { return _size; }
+
+  /// @brief increase the count of a value, and return the new count
+  uint32_t increment(AqlValue const& value) {
+    TRI_ASSERT(!value.isEmpty());
+    if ((_size + 1) * 4 > _slots.size() * 3) {
+      grow();
+    }
+    size_t i = bucket(value);
+    while (!_slots[i].value.isEmpty()) {
+      if (equal(_slots[i].value, value)) {
+        return ++_slots[i].count;
+      }
+      i = (i + 1) & _mask;
+    }
+    _slots[i].value = value;
+    _slots[i].count = 1;
+    ++_size;
+    return 1;
+  }
+
+  /// @brief return a pointer to the count of a value, or a nullptr if the
+  /// value is not in the table
+  uint32_t* find(AqlValue const& value) noexcept {
+    if (_size == 0) {
+      return nullptr;
+    }
+    size_t i = bucket(value);
+    while (!_slots[i].value.isEmpty()) {
+      if (equal(_slots[i].value, value)) {
+        return &_slots[i].count;
+      }
+      i = (i + 1) & _mask;
+    }
+    return nullptr;
+  }
+
+  /// @brief return the count of a value, 0 if it is not in the table
+  uint32_t count(AqlValue const& value) const noexcept {
+    uint32_t const* result = const_cast<AqlValueCounter*>(this)->find(value);
+    return result == nullptr ? 0 : *result;
+  }
+
+  /// @brief remove a value from the table, returns whether it was contained
+  bool erase(AqlValue const& value) noexcept {
+    if (_size == 0) {
+      return false;
+    }
+    size_t i = bucket(value);
+    while (!equal(_slots[i].value, value)) {
+      if (_slots[i].value.isEmpty()) {
+        return false;
+      }
+      i = (i + 1) & _mask;
+    }
+
+    // move following entries of the same probe sequence into the gap, so
+    // that no tombstones are needed
+    size_t j = i;
+    while (true) {
+      j = (j + 1) & _mask;
+      if (_slots[j].value.isEmpty()) {
+        break;
+      }
+      size_t const k = bucket(_slots[j].value);
+      // the entry at j may only move to i if its home bucket k does not lie
+      // cyclically in (i, j]
+      if ((i <= j) ? (i < k && k <= j) : (i < k || k <= j)) {
+        continue;
+      }
+      _slots[i] = _slots[j];
+      i = j;
+    }
+    _slots[i].value.erase();
+    _slots[i].count = 0;
+    --_size;
+    return true;
+  }
+
+  /// @brief call the callback for all values and their counts
+  template <typename F>
+  void forEach(F const& callback) const {
+    if (_size == 0) {
+      return;
+    }
+    for (auto const& it : _slots) {
+      if (!it.value.isEmpty()) {
+        callback(it.value, it.count);
+      }
+    }
+  }
+
+  /// @brief remove all values, but keep the memory
+  void clear() noexcept {
+    if (_size == 0) {
+      return;
+    }
+    for (auto& it : _slots) {
+      it.value.erase();
+      it.count = 0;
+    }
+    _size = 0;
+  }
+
+ private:
+  struct Slot {
+    AqlValue value;
+    uint32_t count = 0;
+  };
+
+  static bool equal(AqlValue const& lhs, AqlValue const& rhs) noexcept {
+    return std::equal_to<AqlValue>()(lhs, rhs);
+  }
+
+  /// @brief home bucket of a value. pointers have their low bits unset, so
+  /// the hash is mixed before it is reduced to the table size
+  size_t bucket(AqlValue const& value) const noexcept {
+    uint64_t const h = static_cast<uint64_t>(std::hash<AqlValue>()(value));
+    return static_cast<size_t>((h * 0x9E3779B97F4A7C15ULL) >> 32) & _mask;
+  }
+
+  /// @brief double the number of slots and reinsert all values
+  void grow() {
+    size_t const n = _slots.empty() ? 16 : _slots.size() * 2;
+    std::vector<Slot> old(n);
+    old.swap(_slots);
+    _mask = n - 1;
+    for (auto const& it : old) {
+      if (!it.value.isEmpty()) {
+        size_t i = bucket(it.value);
+        while (!_slots[i].value.isEmpty()) {
+          i = (i + 1) & _mask;
+        }
+        _slots[i] = it;
+      }
+    }
+  }
+
+ private:
+  std::vector<Slot> _slots;
+  size_t _size;
+  size_t _mask;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
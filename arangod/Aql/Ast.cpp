@@ -49,6 +49,59 @@ using namespace arangodb::aql;
 
 namespace {
 auto doNothingVisitor = [](AstNode const*) {};
+
+/// @brief collect the names of the regular bind parameters used below node.
+/// names used in positions that do not permit runtime evaluation go into
+/// unsafe, all others into safe
+void collectBindParameters(AstNode const* node, bool isSafe,
+                           std::unordered_set<std::string>& safe,
+                           std::unordered_set<std::string>& unsafe) {
+  if (node == nullptr) {
+    return;
+  }
+
+  size_t const n = node->numMembers();
+
+  switch (node->type) {
+    case NODE_TYPE_ROOT:
+    case NODE_TYPE_SUBQUERY: {
+      // a list of statements
+      for (size_t i = 0; i < n; ++i) {
+        AstNode const* statement = node->getMemberUnchecked(i);
+        // the expressions of FILTER and RETURN are evaluated at runtime
+        // anyway. all other statements may require constant values, e.g.
+        // LIMIT or OPTIONS, or propagate values via variables
+        bool const statementIsSafe = (statement->type == NODE_TYPE_FILTER ||
+                                      statement->type == NODE_TYPE_RETURN);
+        for (size_t j = 0; j < statement->numMembers(); ++j) {
+          collectBindParameters(statement->getMemberUnchecked(j), statementIsSafe,
+                                safe, unsafe);
+        }
+      }
+      return;
+    }
+    case NODE_TYPE_PARAMETER: {
+      std::string name = node->getString();
+      if (!name.empty() && name[0] != '@') {
+        (isSafe ? safe : unsafe).emplace(std::move(name));
+      }
+      return;
+    }
+    case NODE_TYPE_BOUND_ATTRIBUTE_ACCESS: {
+      // the attribute name must be known when building the plan
+      TRI_ASSERT(n == 2);
+      collectBindParameters(node->getMember(0), isSafe, safe, unsafe);
+      collectBindParameters(node->getMember(1), false, safe, unsafe);
+      return;
+    }
+    default: {
+      for (size_t i = 0; i < n; ++i) {
+        collectBindParameters(node->getMemberUnchecked(i), isSafe, safe, unsafe);
+      }
+      return;
+    }
+  }
+}
 }
 
 /// @brief initialize a singleton no-op node instance
@@ -1468,10 +1521,25 @@ AstNode* Ast::createNodeNaryOperator(AstNodeType type, AstNode const* child) {
   return node;
 }
 
+/// @brief determine the regular bind parameters that are used in FILTER
+/// and RETURN expressions only
+std::unordered_set<std::string> Ast::deferrableBindParameters() const {
+  std::unordered_set<std::string> safe;
+  std::unordered_set<std::string> unsafe;
+
+  collectBindParameters(_root, false, safe, unsafe);
+
+  for (auto const& it : unsafe) {
+    safe.erase(it);
+  }
+  return safe;
+}
+
 /// @brief injects bind parameters into the AST
 void Ast::injectBindParameters(
     BindParameters& parameters,
-    arangodb::CollectionNameResolver const& resolver
+    arangodb::CollectionNameResolver const& resolver,
+    std::unordered_set<std::string> const* deferred
 ) {
   auto& p = parameters.get();
 
@@ -1497,6 +1565,12 @@ void Ast::injectBindParameters(
       // mark the bind parameter as being used
       (*it).second.second = true;
 
+      if (deferred != nullptr && deferred->find(param) != deferred->end()) {
+        // the node stays, and the value is read when the expression is
+        // executed
+        return node;
+      }
+
       auto& value = (*it).second.first;
 
       TRI_ASSERT(!param.empty());
@@ -3678,17 +3752,8 @@ std::pair<std::string, bool> Ast::normalizeFunctionName(char const* name, size_t
 AstNode* Ast::createNode(AstNodeType type) {
   TRI_ASSERT(_query != nullptr);
 
-  auto node = new AstNode(type);
-
-  try {
-    // register the node so it gets freed automatically later
-    _query->addNode(node);
-  } catch (...) {
-    delete node;
-    throw;
-  }
-
-  return node;
+  // the node is freed automatically when the query is destroyed
+  return _query->createNode(type);
 }
 
 // -----------------------------------------------------------------------------
@@ -400,10 +400,17 @@ class Ast {
   /// @brief create an AST n-ary operator
   AstNode* createNodeNaryOperator(AstNodeType, AstNode const*);
 
-  /// @brief injects bind parameters into the AST
+  /// @brief determine the regular bind parameters that are used in FILTER
+  /// and RETURN expressions only. these don't need to be injected as
+  /// constant values, but can be evaluated at runtime
+  std::unordered_set<std::string> deferrableBindParameters() const;
+
+  /// @brief injects bind parameters into the AST. parameters contained in
+  /// deferred are left in the AST and evaluated at runtime
   void injectBindParameters(
     BindParameters& parameters,
-    arangodb::CollectionNameResolver const& resolver
+    arangodb::CollectionNameResolver const& resolver,
+    std::unordered_set<std::string> const* deferred = nullptr
   );
 
   /// @brief replace variables
@@ -1485,7 +1485,7 @@ bool AstNode::isSimple() const {
 
   if (type == NODE_TYPE_REFERENCE || type == NODE_TYPE_VALUE ||
       type == NODE_TYPE_VARIABLE || type == NODE_TYPE_NOP ||
-      type == NODE_TYPE_QUANTIFIER) {
+      type == NODE_TYPE_QUANTIFIER || type == NODE_TYPE_PARAMETER) {
     setFlag(DETERMINED_SIMPLE, VALUE_SIMPLE);
     return true;
   }
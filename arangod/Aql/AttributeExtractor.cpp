@@ -0,0 +1,173 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "AttributeExtractor.h"
+
+#include "Aql/AqlItemBlock.h"
+#include "Transaction/Methods.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+/// @brief number of misses more than hits after which the cached position
+/// of an attribute is not checked anymore
+constexpr uint32_t maxExcessMisses = 32;
+}
+
+AttributeExtractor::AttributeExtractor() {}
+
+AttributeExtractor::~AttributeExtractor() { clearOwned(); }
+
+/// @brief add a column for an attribute path of the values in a register
+/// and return its position. an empty path extracts the values themselves
+size_t AttributeExtractor::addColumn(RegisterId reg,
+                                     std::vector<std::string> const& path) {
+  for (size_t i = 0; i < _columns.size(); ++i) {
+    if (_columns[i].reg == reg && _columns[i].path == path) {
+      return i;
+    }
+  }
+
+  _columns.emplace_back(
+      Column{reg, path, std::vector<Position>(path.size(), Position{0, 0, 0})});
+  return _columns.size() - 1;
+}
+
+/// @brief remove all columns
+void AttributeExtractor::clearColumns() {
+  _columns.clear();
+  _values.clear();
+  clearOwned();
+}
+
+/// @brief extract all columns for all rows of the block
+void AttributeExtractor::extract(transaction::Methods* trx,
+                                 AqlItemBlock const* block) {
+  clearOwned();
+
+  size_t const n = block->size();
+  size_t const numColumns = _columns.size();
+  _values.resize(n * numColumns);
+
+  size_t pos = 0;
+  for (size_t row = 0; row < n; ++row) {
+    for (auto& column : _columns) {
+      _values[pos++] = extractColumn(
+          trx, column, block->getValueReference(row, column.reg));
+    }
+  }
+}
+
+/// @brief extract the value of a column from a value of its register
+VPackSlice AttributeExtractor::extractColumn(transaction::Methods* trx,
+                                             Column& column,
+                                             AqlValue const& value) {
+  if (value.isRange() || value.isDocvec()) {
+    if (!column.path.empty()) {
+      // arrays do not have attributes
+      return VPackSlice::nullSlice();
+    }
+    bool hasCopied = false;
+    AqlValue materialized = value.materialize(trx, hasCopied, false);
+    if (hasCopied) {
+      try {
+        _owned.emplace_back(materialized);
+      } catch (...) {
+        materialized.destroy();
+        throw;
+      }
+    }
+    return materialized.slice();
+  }
+
+  VPackSlice s = value.slice();
+  if (s.isNone()) {
+    return VPackSlice::nullSlice();
+  }
+
+  size_t const n = column.path.size();
+  for (size_t i = 0; i < n; ++i) {
+    if (!s.isObject()) {
+      return VPackSlice::nullSlice();
+    }
+    VPackSlice found = lookup(s, column.path[i], column.positions[i]);
+    if (found.isCustom()) {
+      if (i + 1 < n) {
+        // the _id value is a string, which has no attributes
+        return VPackSlice::nullSlice();
+      }
+      // _id needs special treatment
+      AqlValue id(trx->extractIdString(s));
+      try {
+        _owned.emplace_back(id);
+      } catch (...) {
+        id.destroy();
+        throw;
+      }
+      return id.slice();
+    }
+    if (found.isNone()) {
+      return VPackSlice::nullSlice();
+    }
+    s = found;
+  }
+  return s;
+}
+
+/// @brief look up an attribute in an object, checking the cached
+/// position first
+VPackSlice AttributeExtractor::lookup(VPackSlice object, std::string const& name,
+                                      Position& position) {
+  uint8_t const head = object.head();
+
+  // only objects with an index table can access their n-th member directly
+  if (head < 0x0b || head > 0x12 ||
+      position.misses > position.hits + ::maxExcessMisses) {
+    return object.get(name);
+  }
+
+  VPackValueLength const n = object.length();
+  if (position.index < n && object.keyAt(position.index).isEqualString(name)) {
+    ++position.hits;
+    return object.valueAt(position.index);
+  }
+
+  ++position.misses;
+
+  // learn the position of the attribute for the next rows
+  for (VPackValueLength i = 0; i < n; ++i) {
+    if (object.keyAt(i).isEqualString(name)) {
+      position.index = i;
+      return object.valueAt(i);
+    }
+  }
+  return VPackSlice::noneSlice();
+}
+
+/// @brief destroy the values created during the last extraction
+void AttributeExtractor::clearOwned() noexcept {
+  for (auto& it : _owned) {
+    it.destroy();
+  }
+  _owned.clear();
+}
@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_ATTRIBUTE_EXTRACTOR_H
+#define ARANGOD_AQL_ATTRIBUTE_EXTRACTOR_H 1
+
+#include "Basics/Common.h"
+#include "Aql/AqlValue.h"
+#include "Aql/types.h"
+
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+namespace transaction {
+class Methods;
+}
+
+namespace aql {
+class AqlItemBlock;
+
+/// @brief extracts a fixed set of attribute paths from the values of a whole
+/// AqlItemBlock in one pass, into one column per path. as documents of a
+/// collection mostly share the same shape, the position of each attribute
+/// inside its object is remembered and checked first for the next row,
+/// which avoids searching the object's index table
+class AttributeExtractor {
+ public:
+  AttributeExtractor(AttributeExtractor const&) = delete;
+  AttributeExtractor& operator=(AttributeExtractor const&) = delete;
+
+  AttributeExtractor();
+  ~AttributeExtractor();
+
+  /// @brief add a column for an attribute path of the values in a register
+  /// and return its position. an empty path extracts the values themselves
+  size_t addColumn(RegisterId reg, std::vector<std::string> const& path);
+
+  /// @brief remove all columns
+  void clearColumns();
+
+  /// @brief number of columns
+  size_t numColumns() const { return _columns.size(); }
+
+  /// @brief extract all columns for all rows of the block. the extracted
+  /// values stay valid until the next call or until the block is modified
+  void extract(transaction::Methods* trx, AqlItemBlock const* block);
+
+  /// @brief the extracted value of a column in a row. attributes that do not
+  /// exist are returned as null
+  arangodb::velocypack::Slice value(size_t row, size_t column) const {
+    TRI_ASSERT(row * _columns.size() + column < _values.size());
+    return _values[row * _columns.size() + column];
+  }
+
+ private:
+  /// @brief cached position of an attribute inside its object
+  struct Position {
+    arangodb::velocypack::ValueLength index;
+    uint32_t hits;
+    uint32_t misses;
+  };
+
+  struct Column {
+    RegisterId reg;
+    std::vector<std::string> path;
+    /// @brief cached positions, one per attribute of the path
+    std::vector<Position> positions;
+  };
+
+  /// @brief extract the value of a column from a value of its register
+  arangodb::velocypack::Slice extractColumn(transaction::Methods* trx,
+                                            Column& column,
+                                            AqlValue const& value);
+
+  /// @brief look up an attribute in an object, checking the cached position
+  /// first
+  static arangodb::velocypack::Slice lookup(arangodb::velocypack::Slice object,
+                                            std::string const& name,
+                                            Position& position);
+
+  /// @brief destroy the values created during the last extraction
+  void clearOwned() noexcept;
+
+ private:
+  std::vector<Column> _columns;
+
+  /// @brief the extracted values, row by row
+  std::vector<arangodb::velocypack::Slice> _values;
+
+  /// @brief values created during the extraction, e.g. _id strings
+  std::vector<AqlValue> _owned;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
@@ -30,7 +30,7 @@
 using namespace arangodb::aql;
 
 SingletonBlock::SingletonBlock(ExecutionEngine* engine, SingletonNode const* ep)
-    : ExecutionBlock(engine, ep) {
+    : ExecutionBlock(engine, ep), _batchedInput(false), _inputPos(0) {
   auto en = ExecutionNode::castTo<SingletonNode const*>(getPlanNode());
   auto const& registerPlan = en->getRegisterPlan()->varInfo;
   std::unordered_set<Variable const*> const& varsUsedLater = en->getVarsUsedLater();
@@ -52,8 +52,14 @@ std::pair<ExecutionState, arangodb::Result> SingletonBlock::initializeCursor(
   // Create a deep copy of the register values given to us:
   if (items != nullptr) {
     // build a whitelist with all the registers that we will copy from above
-    _inputRegisterValues.reset(items->slice(pos, _whitelist));
+    if (_batchedInput) {
+      TRI_ASSERT(pos == 0);
+      _inputRegisterValues.reset(items->slice(pos, items->size(), _whitelist));
+    } else {
+      _inputRegisterValues.reset(items->slice(pos, _whitelist));
+    }
   }
+  _inputPos = 0;
 
   // This could be omitted if ExecutionBlock::initializeCursor() was called
   // here.
@@ -81,6 +87,10 @@ std::pair<ExecutionState, arangodb::Result> SingletonBlock::getOrSkipSome(
     return {ExecutionState::DONE, TRI_ERROR_NO_ERROR};
   }
 
+  if (_batchedInput) {
+    return getOrSkipSomeBatched(atMost, skipping, result, skipped);
+  }
+
   if (!skipping) {
     result = requestBlock(1, getNrOutputRegisters());
 
@@ -134,6 +144,66 @@ std::pair<ExecutionState, arangodb::Result> SingletonBlock::getOrSkipSome(
   DEBUG_END_BLOCK();  
 }
 
+/// @brief make initializeCursor take all rows of the input block
+void SingletonBlock::enableBatchedInput(RegisterId tagRegister) {
+  _batchedInput = true;
+  _whitelist.emplace(tagRegister);
+}
+
+/// @brief produce the rows of all input rows, in batched mode
+std::pair<ExecutionState, arangodb::Result> SingletonBlock::getOrSkipSomeBatched(
+    size_t atMost, bool skipping, AqlItemBlock*& result, size_t& skipped) {
+  DEBUG_BEGIN_BLOCK();
+  TRI_ASSERT(_batchedInput);
+
+  size_t const n = (_inputRegisterValues == nullptr) ? 0 : _inputRegisterValues->size();
+  size_t const toSend = (std::min)(atMost, n - _inputPos);
+
+  if (toSend > 0 && !skipping) {
+    result = requestBlock(toSend, getNrOutputRegisters());
+
+    try {
+      for (size_t row = 0; row < toSend; ++row) {
+        for (auto const& reg : _whitelist) {
+          if (reg >= _inputRegisterValues->getNrRegs()) {
+            continue;
+          }
+
+          AqlValue a = _inputRegisterValues->getValue(_inputPos + row, reg);
+          if (a.isEmpty()) {
+            continue;
+          }
+          _inputRegisterValues->steal(a);
+
+          try {
+            result->setValue(row, reg, a);
+          } catch (...) {
+            a.destroy();
+            throw;
+          }
+          _inputRegisterValues->eraseValue(_inputPos + row, reg);
+        }
+      }
+    } catch (...) {
+      delete result;
+      result = nullptr;
+      throw;
+    }
+  }
+
+  _inputPos += toSend;
+  skipped += toSend;
+
+  if (_inputPos == n) {
+    _done = true;
+    _inputRegisterValues.reset();
+  }
+  return {getHasMoreState(), TRI_ERROR_NO_ERROR};
+
+  // cppcheck-suppress style
+  DEBUG_END_BLOCK();
+}
+
 FilterBlock::FilterBlock(ExecutionEngine* engine, FilterNode const* en)
     : ExecutionBlock(engine, en), 
       _inReg(ExecutionNode::MaxRegisterId),
@@ -221,7 +291,7 @@ std::pair<ExecutionState, arangodb::Result> FilterBlock::getOrSkipSome(
 
   while (_inflight < atMost) {
     if (_buffer.empty()) {
-      auto upstreamRes = getBlock(DefaultBatchSize());
+      auto upstreamRes = getBlock(upstreamBatchSize());
       if (upstreamRes.first == ExecutionState::WAITING) {
         // We have not modified result or skipped up to now.
         // Make sure the caller does not have to retain it.
@@ -48,14 +48,30 @@ class SingletonBlock final : public ExecutionBlock {
     return Type::SINGLETON;
   }
 
+  /// @brief make initializeCursor take all rows of the input block instead
+  /// of only the row at the given position, and produce one output row for
+  /// each of them. the values in tagRegister are copied as well, so that the
+  /// caller can map the results back to the input rows
+  void enableBatchedInput(RegisterId tagRegister);
+
  private:
   std::pair<ExecutionState, arangodb::Result> getOrSkipSome(size_t atMost, bool skipping,
                                                             AqlItemBlock*& result, size_t& skipped) override;
 
+  /// @brief produce the rows of all input rows, in batched mode
+  std::pair<ExecutionState, arangodb::Result> getOrSkipSomeBatched(size_t atMost, bool skipping,
+                                                                   AqlItemBlock*& result, size_t& skipped);
+
   /// @brief _inputRegisterValues
   std::unique_ptr<AqlItemBlock> _inputRegisterValues;
 
   std::unordered_set<RegisterId> _whitelist;
+
+  /// @brief whether or not all rows of the input block are used
+  bool _batchedInput;
+
+  /// @brief next row of _inputRegisterValues to produce in batched mode
+  size_t _inputPos;
 };
 
 class FilterBlock final : public ExecutionBlock {
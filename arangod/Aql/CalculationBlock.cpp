@@ -106,6 +106,13 @@ void CalculationBlock::executeExpression(AqlItemBlock* result) {
                                  ->_conditionVariable != nullptr);
   TRI_ASSERT(!hasCondition); // currently not implemented
 
+  if (!hasCondition && _expression->canExecuteBlock(_trx)) {
+    // the expression extracts its operands for the whole block at once
+    _expression->executeBlock(_trx, result, _inVars, _inRegs, _outReg);
+    throwIfKilled();  // check if we were aborted
+    return;
+  }
+
   size_t const n = result->size();
 
   for (size_t i = 0; i < n; i++) {
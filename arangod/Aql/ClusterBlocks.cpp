@@ -33,6 +33,7 @@
 #include "Aql/Query.h"
 #include "Aql/WakeupQueryCallback.h"
 #include "Basics/Exceptions.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/StringBuffer.h"
 #include "Basics/StringUtils.h"
@@ -215,6 +216,221 @@ class MinElementSorting final : public SortingStrategy, public OurLessThan {
   std::vector<ValueType> const* _blockPos;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @class LoserTreeSorting
+/// @brief "LoserTree" sorting strategy. the sort keys of the head row of each
+/// dependency are extracted only once, and a tournament tree of the losers
+/// is maintained, so finding the next row takes O(log n) comparisons for n
+/// dependencies
+////////////////////////////////////////////////////////////////////////////////
+class LoserTreeSorting final : public SortingStrategy {
+ public:
+  LoserTreeSorting(
+      arangodb::transaction::Methods* trx,
+      std::vector<std::deque<AqlItemBlock*>>& gatherBlockBuffer,
+      std::vector<SortRegister>& sortRegisters) noexcept
+    : _trx(trx),
+      _gatherBlockBuffer(gatherBlockBuffer),
+      _sortRegisters(sortRegisters),
+      _blockPos(nullptr),
+      _hasWinner(false) {
+  }
+
+  ~LoserTreeSorting() {
+    clearKeys();
+  }
+
+  virtual ValueType nextValue() override {
+    TRI_ASSERT(_blockPos);
+    TRI_ASSERT(!_tree.empty());
+
+    if (_hasWinner) {
+      // the previous winner has been advanced to its next row in the
+      // meantime, so it has to play its way up the tree again
+      size_t const winner = _tree[0];
+      extractKeys(winner);
+      replay(winner);
+    }
+    _hasWinner = true;
+
+    return (*_blockPos)[_tree[0]];
+  }
+
+  virtual void prepare(std::vector<ValueType>& blockPos) override {
+    TRI_ASSERT(!blockPos.empty());
+
+    // buffers may have been refilled since the last call, so the tree is
+    // always rebuilt. this is O(n) once per batch
+    _blockPos = &blockPos;
+    clearKeys();
+    _keys.resize(blockPos.size() * _sortRegisters.size());
+    _exhausted.resize(blockPos.size());
+
+    for (size_t i = 0; i < blockPos.size(); ++i) {
+      extractKeys(i);
+    }
+    build();
+    _hasWinner = false;
+  }
+
+  virtual void reset() noexcept override {
+    clearKeys();
+    _keys.clear();
+    _exhausted.clear();
+    _tree.clear();
+    _blockPos = nullptr;
+    _hasWinner = false;
+  }
+
+ private:
+  /// @brief a sort key of a head row. attribute paths are resolved during
+  /// extraction, so the value may be owned by the key
+  struct SortKey {
+    AqlValue value;
+    bool mustDestroy = false;
+  };
+
+  /// @brief free all sort keys owned by us
+  void clearKeys() noexcept {
+    for (auto& key : _keys) {
+      if (key.mustDestroy) {
+        key.value.destroy();
+        key.mustDestroy = false;
+      }
+      key.value = AqlValue();
+    }
+  }
+
+  /// @brief extract the sort keys of the head row of dependency i
+  void extractKeys(size_t i) {
+    auto const& blocks = _gatherBlockBuffer[i];
+    size_t const nrKeys = _sortRegisters.size();
+    SortKey* keys = _keys.data() + i * nrKeys;
+
+    for (size_t r = 0; r < nrKeys; ++r) {
+      if (keys[r].mustDestroy) {
+        keys[r].value.destroy();
+        keys[r].mustDestroy = false;
+      }
+      keys[r].value = AqlValue();
+    }
+
+    // nothing in the buffer is maximum!
+    _exhausted[i] = blocks.empty();
+    if (blocks.empty()) {
+      return;
+    }
+
+    size_t const row = (*_blockPos)[i].second;
+    for (size_t r = 0; r < nrKeys; ++r) {
+      auto const& reg = _sortRegisters[r];
+      AqlValue const& value = blocks.front()->getValueReference(row, reg.reg);
+
+      if (reg.attributePath.empty()) {
+        // no copy, the row stays valid while it is the head of its buffer
+        keys[r].value = value;
+      } else {
+        keys[r].value = value.get(_trx, reg.attributePath, keys[r].mustDestroy, false);
+      }
+    }
+  }
+
+  /// @brief compare the head rows of dependencies a and b in sort order
+  int compare(size_t a, size_t b) const {
+    if (_exhausted[a] || _exhausted[b]) {
+      return static_cast<int>(_exhausted[a]) - static_cast<int>(_exhausted[b]);
+    }
+
+    size_t const nrKeys = _sortRegisters.size();
+    SortKey const* lhs = _keys.data() + a * nrKeys;
+    SortKey const* rhs = _keys.data() + b * nrKeys;
+
+    for (size_t r = 0; r < nrKeys; ++r) {
+      auto const& reg = _sortRegisters[r];
+      int cmp;
+
+#ifdef USE_IRESEARCH
+      if (reg.attributePath.empty()) {
+        TRI_ASSERT(reg.comparator);
+        cmp = (*reg.comparator)(reg.scorer.get(), _trx, lhs[r].value, rhs[r].value);
+      } else {
+        cmp = AqlValue::Compare(_trx, lhs[r].value, rhs[r].value, true);
+      }
+#else
+      cmp = AqlValue::Compare(_trx, lhs[r].value, rhs[r].value, true);
+#endif
+
+      if (cmp != 0) {
+        return reg.asc ? cmp : -cmp;
+      }
+    }
+
+    return 0;
+  }
+
+  /// @brief whether or not dependency a wins against dependency b. ties
+  /// are won by the lower dependency index
+  bool beats(size_t a, size_t b) const {
+    int const cmp = compare(a, b);
+    return cmp < 0 || (cmp == 0 && a < b);
+  }
+
+  /// @brief build the tree from scratch. leaves are at positions
+  /// n..2n-1, _tree[1..n-1] holds the loser of each match and _tree[0]
+  /// the overall winner
+  void build() {
+    size_t const n = _blockPos->size();
+    std::vector<size_t> winners(2 * n);
+    _tree.resize(n);
+
+    for (size_t i = 0; i < n; ++i) {
+      winners[n + i] = i;
+    }
+    for (size_t node = n - 1; node > 0; --node) {
+      size_t const left = winners[2 * node];
+      size_t const right = winners[2 * node + 1];
+      if (beats(right, left)) {
+        winners[node] = right;
+        _tree[node] = left;
+      } else {
+        winners[node] = left;
+        _tree[node] = right;
+      }
+    }
+    _tree[0] = (n == 1 ? 0 : winners[1]);
+  }
+
+  /// @brief replay the matches on the path from the leaf of dependency i
+  /// to the root
+  void replay(size_t i) {
+    size_t const n = _tree.size();
+    size_t winner = i;
+    for (size_t node = (n + i) / 2; node > 0; node /= 2) {
+      if (beats(_tree[node], winner)) {
+        std::swap(_tree[node], winner);
+      }
+    }
+    _tree[0] = winner;
+  }
+
+  arangodb::transaction::Methods* _trx;
+  std::vector<std::deque<AqlItemBlock*>>& _gatherBlockBuffer;
+  std::vector<SortRegister>& _sortRegisters;
+  std::vector<ValueType> const* _blockPos;
+
+  /// @brief sort keys of the head rows, _sortRegisters.size() per dependency
+  std::vector<SortKey> _keys;
+
+  /// @brief whether or not the buffer of a dependency is empty
+  std::vector<bool> _exhausted;
+
+  /// @brief the tree of losers, see build()
+  std::vector<size_t> _tree;
+
+  /// @brief whether or not _tree[0] has been handed out by nextValue()
+  bool _hasWinner;
+}; // LoserTreeSorting
+
 }
 
 BlockWithClients::BlockWithClients(ExecutionEngine* engine,
@@ -798,7 +1014,81 @@ std::string DistributeBlock::createKey(VPackSlice) const {
 }
 #endif
 
-arangodb::Result RemoteBlock::handleCommErrors(ClusterCommResult* res) const {
+namespace {
+/// @brief callback for the prefetch requests of a RemoteBlock. the response
+/// is stored in the shared prefetch state, and the query is only woken up
+/// if it is actually waiting for the response
+struct PrefetchCallback final : public WakeupQueryCallback {
+  PrefetchCallback(RemoteBlock* block, Query* query,
+                   std::shared_ptr<RemoteBlock::PrefetchState> state)
+      : WakeupQueryCallback(block, query), _state(std::move(state)) {}
+
+  bool operator()(ClusterCommResult* result) override {
+    if (_state->deliver(result)) {
+      return wakeupQuery();
+    }
+    return true;
+  }
+
+ private:
+  std::shared_ptr<RemoteBlock::PrefetchState> _state;
+};
+}
+
+void RemoteBlock::PrefetchState::begin() {
+  MUTEX_LOCKER(guard, mutex);
+  TRI_ASSERT(!inFlight && !arrived);
+  inFlight = true;
+}
+
+void RemoteBlock::PrefetchState::cancel() {
+  MUTEX_LOCKER(guard, mutex);
+  inFlight = false;
+}
+
+bool RemoteBlock::PrefetchState::deliver(ClusterCommResult* result) {
+  MUTEX_LOCKER(guard, mutex);
+  TRI_ASSERT(inFlight);
+  inFlight = false;
+  if (orphaned) {
+    // the block is gone, nobody is interested in the response anymore
+    return false;
+  }
+  error = RemoteBlock::handleCommErrors(result);
+  if (error.ok()) {
+    response = result->result;
+  }
+  arrived = true;
+  bool const wakeup = waiting;
+  waiting = false;
+  return wakeup;
+}
+
+RemoteBlock::PrefetchState::Status RemoteBlock::PrefetchState::take(
+    std::shared_ptr<httpclient::SimpleHttpResult>& response,
+    arangodb::Result& error) {
+  MUTEX_LOCKER(guard, mutex);
+  if (inFlight) {
+    waiting = true;
+    return Status::IN_FLIGHT;
+  }
+  if (!arrived) {
+    return Status::NONE;
+  }
+  arrived = false;
+  response = std::move(this->response);
+  error = this->error;
+  this->response.reset();
+  this->error.reset();
+  return Status::ARRIVED;
+}
+
+void RemoteBlock::PrefetchState::orphan() {
+  MUTEX_LOCKER(guard, mutex);
+  orphaned = true;
+}
+
+arangodb::Result RemoteBlock::handleCommErrors(ClusterCommResult* res) {
   DEBUG_BEGIN_BLOCK();
   if (res->status == CL_COMM_TIMEOUT ||
       res->status == CL_COMM_BACKEND_UNAVAILABLE) {
@@ -874,6 +1164,7 @@ std::shared_ptr<VPackBuilder> RemoteBlock::stealResultBody() {
   }
   // We have an open result still.
   // Result is the response which is an object containing the ErrorCode
+  _engine->_stats.counters.bytesReceived += _lastResponse->getBody().length();
   std::shared_ptr<VPackBuilder> responseBodyBuilder = _lastResponse->getBodyVelocyPack();
   _lastResponse.reset();
   return responseBodyBuilder;
@@ -893,7 +1184,14 @@ RemoteBlock::RemoteBlock(ExecutionEngine* engine, RemoteNode const* en,
       _isResponsibleForInitializeCursor(
           en->isResponsibleForInitializeCursor()),
       _lastResponse(nullptr),
-      _lastError(TRI_ERROR_NO_ERROR) {
+      _lastError(TRI_ERROR_NO_ERROR),
+      // only coordinators fetch ahead. they merge the results of many shards
+      _prefetch(ownName.empty() &&
+                engine->getQuery()->queryOptions().remotePrefetch),
+      _prefetchState(std::make_shared<PrefetchState>()),
+      _hasPrefetched(false),
+      _prefetched(nullptr),
+      _prefetchedState(ExecutionState::HASMORE) {
   TRI_ASSERT(!queryId.empty());
   TRI_ASSERT(
       (arangodb::ServerState::instance()->isCoordinator() && ownName.empty()) ||
@@ -901,9 +1199,16 @@ RemoteBlock::RemoteBlock(ExecutionEngine* engine, RemoteNode const* en,
        !ownName.empty()));
 }
 
+RemoteBlock::~RemoteBlock() {
+  // a prefetch request may still be in flight. its callback must not touch
+  // this block anymore
+  _prefetchState->orphan();
+}
+
 Result RemoteBlock::sendAsyncRequest(
     arangodb::rest::RequestType type, std::string const& urlPart,
-    std::shared_ptr<std::string const> body) {
+    std::shared_ptr<std::string const> body,
+    std::shared_ptr<ClusterCommCallback> callback) {
   DEBUG_BEGIN_BLOCK();
   auto cc = ClusterComm::instance();
   if (cc == nullptr) {
@@ -924,9 +1229,10 @@ Result RemoteBlock::sendAsyncRequest(
     urlPart + _queryId;
 
   ++_engine->_stats.requests;
-  std::shared_ptr<ClusterCommCallback> callback =
-      std::make_shared<WakeupQueryCallback>(dynamic_cast<ExecutionBlock*>(this),
-                                            _engine->getQuery());
+  if (callback == nullptr) {
+    callback = std::make_shared<WakeupQueryCallback>(dynamic_cast<ExecutionBlock*>(this),
+                                                     _engine->getQuery());
+  }
 
   // TODO Returns OperationID do we need it in any way?
   cc->asyncRequest(clientTransactionId, coordTransactionId, _server, type,
@@ -971,12 +1277,128 @@ std::unique_ptr<ClusterCommResult> RemoteBlock::sendRequest(
   DEBUG_END_BLOCK();
 }
 
+/// @brief send the getSome request for the next batch ahead of consumption
+void RemoteBlock::startPrefetch(size_t atMost) {
+  if (!_prefetch) {
+    return;
+  }
+
+  TRI_ASSERT(!_hasPrefetched);
+  TRI_ASSERT(_lastResponse == nullptr);
+
+  // do not buffer more results if the query is already using half of the
+  // memory it is allowed to use
+  ResourceMonitor const* monitor = _engine->getQuery()->resourceMonitor();
+  if (monitor->maxResources.memoryUsage > 0 &&
+      monitor->currentResources.memoryUsage > monitor->maxResources.memoryUsage / 2) {
+    return;
+  }
+
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("atMost", VPackValue(atMost));
+  builder.close();
+
+  auto bodyString = std::make_shared<std::string const>(builder.slice().toJson());
+
+  _prefetchState->begin();
+
+  auto callback = std::make_shared<PrefetchCallback>(this, _engine->getQuery(), _prefetchState);
+  auto res = sendAsyncRequest(rest::RequestType::PUT, "/_api/aql/getSome/",
+                              bodyString, callback);
+  if (!res.ok()) {
+    // no harm done. the next getSome will send the request itself and
+    // report the error
+    _prefetchState->cancel();
+  }
+}
+
+/// @brief pick up the response of a prefetch request
+ExecutionState RemoteBlock::collectPrefetch(bool discard) {
+  std::shared_ptr<httpclient::SimpleHttpResult> response;
+  Result error;
+
+  auto status = _prefetchState->take(response, error);
+  if (status == PrefetchState::Status::IN_FLIGHT) {
+    return ExecutionState::WAITING;
+  }
+  if (status == PrefetchState::Status::NONE && (!discard || !_hasPrefetched)) {
+    // nothing prefetched
+    return ExecutionState::DONE;
+  }
+
+  if (discard) {
+    _hasPrefetched = false;
+    _prefetched.reset();
+    return ExecutionState::DONE;
+  }
+
+  if (error.fail()) {
+    THROW_ARANGO_EXCEPTION(error);
+  }
+
+  TRI_ASSERT(response != nullptr);
+  TRI_ASSERT(!_hasPrefetched);
+
+  std::shared_ptr<VPackBuilder> responseBodyBuilder = response->getBodyVelocyPack();
+  VPackSlice responseBody = responseBodyBuilder->slice();
+
+  _prefetchedState = ExecutionState::HASMORE;
+  if (VelocyPackHelper::getBooleanValue(responseBody, "done", true)) {
+    _prefetchedState = ExecutionState::DONE;
+  }
+  if (responseBody.hasKey("data")) {
+    _prefetched = std::make_unique<AqlItemBlock>(
+        _engine->getQuery()->resourceMonitor(), responseBody);
+  } else {
+    _prefetchedState = ExecutionState::DONE;
+  }
+  _hasPrefetched = true;
+
+  return ExecutionState::DONE;
+}
+
+/// @brief hand out up to atMost rows of the prefetched response
+std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> RemoteBlock::getSomePrefetched(size_t atMost) {
+  TRI_ASSERT(_hasPrefetched);
+
+  if (_prefetched == nullptr) {
+    _hasPrefetched = false;
+    return {_prefetchedState, nullptr};
+  }
+
+  std::unique_ptr<AqlItemBlock> result;
+  ExecutionState state = ExecutionState::HASMORE;
+
+  if (_prefetched->size() <= atMost) {
+    result = std::move(_prefetched);
+    state = _prefetchedState;
+    _hasPrefetched = false;
+  } else {
+    // the prefetch was made for a larger batch
+    size_t const n = _prefetched->size();
+    result.reset(_prefetched->slice(0, atMost));
+    _prefetched.reset(_prefetched->slice(atMost, n));
+  }
+
+  if (!_hasPrefetched && state == ExecutionState::HASMORE) {
+    startPrefetch(atMost);
+  }
+
+  return {state, std::move(result)};
+}
+
 /// @brief initializeCursor, could be called multiple times
 std::pair<ExecutionState, Result> RemoteBlock::initializeCursor(
     AqlItemBlock* items, size_t pos) {
   DEBUG_BEGIN_BLOCK();
   // For every call we simply forward via HTTP
 
+  if (_prefetch && collectPrefetch(true) == ExecutionState::WAITING) {
+    // results fetched ahead are stale after the cursor is reset
+    return {ExecutionState::WAITING, TRI_ERROR_NO_ERROR};
+  }
+
   if (!_isResponsibleForInitializeCursor) {
     // do nothing...
     return {ExecutionState::DONE, TRI_ERROR_NO_ERROR};
@@ -1049,6 +1471,12 @@ bool RemoteBlock::handleAsyncResult(ClusterCommResult* result) {
 std::pair<ExecutionState, Result> RemoteBlock::shutdown(int errorCode) {
   DEBUG_BEGIN_BLOCK();
 
+  if (_prefetch && collectPrefetch(true) == ExecutionState::WAITING) {
+    // the remote side must not get a shutdown while it still works on our
+    // prefetch request
+    return {ExecutionState::WAITING, TRI_ERROR_NO_ERROR};
+  }
+
   /* We need to handle this here in ASYNC case
     if (isShutdown && errorNum == TRI_ERROR_QUERY_NOT_FOUND) {
       // this error may happen on shutdown and is thus tolerated
@@ -1132,6 +1560,18 @@ std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> RemoteBlock::getSome(si
   
   traceGetSomeBegin(atMost);
 
+  if (_prefetch) {
+    if (collectPrefetch(false) == ExecutionState::WAITING) {
+      traceGetSomeEnd(nullptr, ExecutionState::WAITING);
+      return {ExecutionState::WAITING, nullptr};
+    }
+    if (_hasPrefetched) {
+      auto r = getSomePrefetched(atMost);
+      traceGetSomeEnd(r.second.get(), r.first);
+      return r;
+    }
+  }
+
   if (_lastError.fail()) {
     TRI_ASSERT(_lastResponse == nullptr);
     Result res = _lastError;
@@ -1159,6 +1599,10 @@ std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> RemoteBlock::getSome(si
     if (responseBody.hasKey("data")) {
       auto r = std::make_unique<AqlItemBlock>(
           _engine->getQuery()->resourceMonitor(), responseBody);
+      if (state == ExecutionState::HASMORE) {
+        // request the next batch while our caller works on this one
+        startPrefetch(atMost);
+      }
       traceGetSomeEnd(r.get(), state);
       return {state, std::move(r)};
     }
@@ -1190,6 +1634,28 @@ std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> RemoteBlock::getSome(si
 std::pair<ExecutionState, size_t> RemoteBlock::skipSome(size_t atMost) {
   DEBUG_BEGIN_BLOCK();
 
+  if (_prefetch) {
+    if (collectPrefetch(false) == ExecutionState::WAITING) {
+      return {ExecutionState::WAITING, 0};
+    }
+    if (_hasPrefetched) {
+      // skip over the rows fetched ahead. no new prefetch is started here,
+      // the remote side is better at skipping
+      if (_prefetched == nullptr) {
+        _hasPrefetched = false;
+        return {_prefetchedState, 0};
+      }
+      size_t const n = _prefetched->size();
+      if (n <= atMost) {
+        _prefetched.reset();
+        _hasPrefetched = false;
+        return {_prefetchedState, n};
+      }
+      _prefetched.reset(_prefetched->slice(atMost, n));
+      return {ExecutionState::HASMORE, atMost};
+    }
+  }
+
   if (_lastError.fail()) {
     TRI_ASSERT(_lastResponse == nullptr);
     Result res = _lastError;
@@ -1344,27 +1810,41 @@ std::pair<ExecutionState, size_t> UnsortingGatherBlock::skipSome(size_t atMost)
 // -----------------------------------------------------------------------------
 
 
-SortingGatherBlock::SortingGatherBlock(
-    ExecutionEngine& engine,
-    GatherNode const& en)
-  : ExecutionBlock(&engine, &en) {
-  TRI_ASSERT(!en.elements().empty());
-
-  switch (en.sortMode()) {
+/// @brief creates the strategy for the given sort mode
+std::unique_ptr<SortingStrategy> SortingStrategy::create(
+    GatherNode::SortMode mode,
+    arangodb::transaction::Methods* trx,
+    std::vector<std::deque<AqlItemBlock*>>& gatherBlockBuffer,
+    std::vector<SortRegister>& sortRegisters) {
+  switch (mode) {
     case GatherNode::SortMode::Heap:
-      _strategy = std::make_unique<HeapSorting>(
-        _trx, _gatherBlockBuffer, _sortRegisters
+      return std::make_unique<HeapSorting>(
+        trx, gatherBlockBuffer, sortRegisters
       );
-      break;
     case GatherNode::SortMode::MinElement:
-      _strategy = std::make_unique<MinElementSorting>(
-        _trx, _gatherBlockBuffer, _sortRegisters
+      return std::make_unique<MinElementSorting>(
+        trx, gatherBlockBuffer, sortRegisters
+      );
+    case GatherNode::SortMode::LoserTree:
+      return std::make_unique<LoserTreeSorting>(
+        trx, gatherBlockBuffer, sortRegisters
       );
-      break;
     default:
       TRI_ASSERT(false);
       break;
   }
+  return nullptr;
+}
+
+SortingGatherBlock::SortingGatherBlock(
+    ExecutionEngine& engine,
+    GatherNode const& en)
+  : ExecutionBlock(&engine, &en) {
+  TRI_ASSERT(!en.elements().empty());
+
+  _strategy = SortingStrategy::create(
+    en.sortMode(), _trx, _gatherBlockBuffer, _sortRegisters
+  );
   TRI_ASSERT(_strategy);
 
   // We know that planRegisters has been run, so
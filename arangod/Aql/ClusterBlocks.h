@@ -29,6 +29,7 @@
 #include "Aql/ExecutionBlock.h"
 #include "Aql/ExecutionNode.h"
 #include "Aql/SortRegister.h"
+#include "Basics/Mutex.h"
 #include "Rest/GeneralRequest.h"
 
 #include <velocypack/Builder.h>
@@ -43,6 +44,7 @@ namespace transaction {
 class Methods;
 }
 
+struct ClusterCommCallback;
 struct ClusterCommResult;
 
 namespace aql {
@@ -231,6 +233,8 @@ class RemoteBlock final : public ExecutionBlock {
               std::string const& server, std::string const& ownName,
               std::string const& queryId);
 
+  ~RemoteBlock();
+
   /// @brief timeout
   static double const defaultTimeOut;
 
@@ -253,13 +257,42 @@ class RemoteBlock final : public ExecutionBlock {
     return Type::REMOTE;
   }
 
- private:
-  /// @brief internal method to send a request
-  /// TODO:Deprecated!
-  std::unique_ptr<arangodb::ClusterCommResult> sendRequest(
-      rest::RequestType type, std::string const& urlPart,
-      std::string const& body) const;
-
+  /// @brief state of a prefetch request, shared between the block and the
+  /// callback of the request, which may outlive the block
+  struct PrefetchState {
+    /// @brief what take() found
+    enum class Status { NONE, IN_FLIGHT, ARRIVED };
+
+    /// @brief a request is about to be sent
+    void begin();
+
+    /// @brief the request could not be sent
+    void cancel();
+
+    /// @brief store the response of the request. returns true if the query
+    /// waits for the response and has to be woken up
+    bool deliver(ClusterCommResult* result);
+
+    /// @brief move the response into response and error if it has arrived.
+    /// if the request is still in flight, the query is marked as waiting
+    Status take(std::shared_ptr<httpclient::SimpleHttpResult>& response,
+                arangodb::Result& error);
+
+    /// @brief the block is destroyed, responses are thrown away from now on
+    void orphan();
+
+    arangodb::Mutex mutex;
+    /// @brief a request has been sent, but its response has not arrived yet
+    bool inFlight = false;
+    /// @brief the query is suspended until the response arrives
+    bool waiting = false;
+    /// @brief the response has arrived, but has not been picked up yet
+    bool arrived = false;
+    /// @brief the block has been destroyed
+    bool orphaned = false;
+    std::shared_ptr<httpclient::SimpleHttpResult> response;
+    arangodb::Result error;
+  };
 
   /**
    * @brief Handle communication errors in Async case.
@@ -269,12 +302,34 @@ class RemoteBlock final : public ExecutionBlock {
    * @return A wrapped Result Object, that is either ok() or contains
    *         the error information to be thrown in get/skip some.
    */
-  arangodb::Result handleCommErrors(ClusterCommResult* result) const;
+  static arangodb::Result handleCommErrors(ClusterCommResult* result);
+
+ private:
+  /// @brief internal method to send a request
+  /// TODO:Deprecated!
+  std::unique_ptr<arangodb::ClusterCommResult> sendRequest(
+      rest::RequestType type, std::string const& urlPart,
+      std::string const& body) const;
+
 
   /// @brief internal method to send a request. Will register a callback to be reactivated
+  /// if none is given
   arangodb::Result sendAsyncRequest(
       rest::RequestType type, std::string const& urlPart,
-      std::shared_ptr<std::string const> body);
+      std::shared_ptr<std::string const> body,
+      std::shared_ptr<ClusterCommCallback> callback = nullptr);
+
+  /// @brief send the getSome request for the next batch ahead of consumption,
+  /// if prefetching is enabled and memory usage permits
+  void startPrefetch(size_t atMost);
+
+  /// @brief pick up the response of a prefetch request. returns WAITING if
+  /// the response has not arrived yet. if discard is true, the response is
+  /// thrown away, otherwise it is kept in _prefetched
+  ExecutionState collectPrefetch(bool discard);
+
+  /// @brief hand out up to atMost rows of the prefetched response
+  std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> getSomePrefetched(size_t atMost);
 
   std::shared_ptr<velocypack::Builder> stealResultBody();
 
@@ -298,6 +353,22 @@ class RemoteBlock final : public ExecutionBlock {
 
   /// @brief the last remote response Result object, may contain an error.
   arangodb::Result _lastError;
+
+  /// @brief whether or not the next batch is requested ahead of consumption
+  bool const _prefetch;
+
+  /// @brief the state of the prefetch request
+  std::shared_ptr<PrefetchState> _prefetchState;
+
+  /// @brief whether or not a prefetched response is available
+  bool _hasPrefetched;
+
+  /// @brief the rows of the prefetched response that have not been handed
+  /// out yet, may be a nullptr if the response did not contain any rows
+  std::unique_ptr<AqlItemBlock> _prefetched;
+
+  /// @brief the state of the remote side after the prefetched response
+  ExecutionState _prefetchedState;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -341,6 +412,15 @@ struct SortingStrategy {
 
   virtual ~SortingStrategy() = default;
 
+  /// @brief creates the strategy for the given sort mode, which merges the
+  /// rows of the buffers in the order of the sort registers
+  static std::unique_ptr<SortingStrategy> create(
+    GatherNode::SortMode mode,
+    arangodb::transaction::Methods* trx,
+    std::vector<std::deque<AqlItemBlock*>>& gatherBlockBuffer,
+    std::vector<SortRegister>& sortRegisters
+  );
+
   /// @brief returns next value
   virtual ValueType nextValue() = 0;
 
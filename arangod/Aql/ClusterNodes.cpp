@@ -42,6 +42,7 @@ namespace {
 arangodb::velocypack::StringRef const SortModeUnset("unset");
 arangodb::velocypack::StringRef const SortModeMinElement("minelement");
 arangodb::velocypack::StringRef const SortModeHeap("heap");
+arangodb::velocypack::StringRef const SortModeLoserTree("losertree");
 
 bool toSortMode(
     arangodb::velocypack::StringRef const& str,
@@ -50,7 +51,8 @@ bool toSortMode(
   // std::map ~25-30% faster than std::unordered_map for small number of elements
   static std::map<arangodb::velocypack::StringRef, GatherNode::SortMode> const NameToValue {
     { SortModeMinElement, GatherNode::SortMode::MinElement},
-    { SortModeHeap, GatherNode::SortMode::Heap}
+    { SortModeHeap, GatherNode::SortMode::Heap},
+    { SortModeLoserTree, GatherNode::SortMode::LoserTree}
   };
 
   auto const it = NameToValue.find(str);
@@ -70,6 +72,8 @@ arangodb::velocypack::StringRef toString(GatherNode::SortMode mode) noexcept {
       return SortModeMinElement;
     case GatherNode::SortMode::Heap:
       return SortModeHeap;
+    case GatherNode::SortMode::LoserTree:
+      return SortModeLoserTree;
     default:
       TRI_ASSERT(false);
       return {};
@@ -302,7 +302,8 @@ class GatherNode final : public ExecutionNode {
  public:
   enum class SortMode : uint32_t {
     MinElement,
-    Heap
+    Heap,
+    LoserTree
   };
 
   /// @brief inspect dependencies starting from a specified 'node'
@@ -318,7 +319,7 @@ class GatherNode final : public ExecutionNode {
       size_t shardsRequiredForHeapMerge = 5
   ) noexcept {
     return numberOfShards >= shardsRequiredForHeapMerge
-      ? SortMode::Heap
+      ? SortMode::LoserTree
       : SortMode::MinElement;
   }
 
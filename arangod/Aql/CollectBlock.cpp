@@ -26,10 +26,15 @@
 #include "Aql/AqlValue.h"
 #include "Aql/AqlItemBlock.h"
 #include "Aql/ExecutionEngine.h"
+#include "Aql/Query.h"
+#include "Aql/ResourceUsage.h"
 #include "Basics/Exceptions.h"
 #include "Basics/VelocyPackHelper.h"
 #include "VocBase/vocbase.h"
 
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
 using namespace arangodb;
 using namespace arangodb::aql;
 
@@ -387,7 +392,7 @@ std::pair<ExecutionState, Result> SortedCollectBlock::getOrSkipSome(
       }
     }
 
-    BufferState bufferState = getBlockIfNeeded(DefaultBatchSize());
+    BufferState bufferState = getBlockIfNeeded(upstreamBatchSize());
     if (bufferState == BufferState::WAITING) {
       TRI_ASSERT(skipped == 0);
       TRI_ASSERT(result == nullptr);
@@ -567,8 +572,9 @@ HashedCollectBlock::HashedCollectBlock(ExecutionEngine* engine,
       _aggregateRegisters(),
       _collectRegister(ExecutionNode::MaxRegisterId),
       _lastBlock(nullptr),
-      _allGroups(1024, AqlValueGroupHash(_trx, en->_groupVariables.size()),
-                 AqlValueGroupEqual(_trx)) {
+      _spillThreshold(engine->getQuery()->queryOptions().collectSpillThreshold),
+      _aggregatorsPerGroup(0),
+      _inputDone(false) {
   for (auto const& p : en->_groupVariables) {
     // We know that planRegisters() has been run, so
     // getPlanNode()->_registerPlan is set up
@@ -619,6 +625,16 @@ HashedCollectBlock::HashedCollectBlock(ExecutionEngine* engine,
   }
 
   TRI_ASSERT(!_groupRegisters.empty());
+
+  if (en->_aggregateVariables.empty()) {
+    // no aggregate registers. this means we'll only count the number of items
+    _aggregatorsPerGroup = en->_count ? 1 : 0;
+  } else {
+    _aggregatorsPerGroup = _aggregateRegisters.size();
+  }
+
+  _rowGroupValues.resize(_groupRegisters.size());
+  _rowAggregateValues.resize(_aggregateRegisters.size());
 }
 
 std::pair<ExecutionState, Result> HashedCollectBlock::getOrSkipSome(
@@ -634,10 +650,35 @@ std::pair<ExecutionState, Result> HashedCollectBlock::getOrSkipSome(
     return {ExecutionState::DONE, TRI_ERROR_NO_ERROR};
   }
 
+  if (_inputDone) {
+    // all input was consumed, but some groups did not fit into memory.
+    // aggregate the next spilled partition and return its groups
+    TRI_ASSERT(!_partitions.empty());
+    TRI_ASSERT(numGroups() == 0);
+
+    Partition partition = std::move(_partitions.back());
+    _partitions.pop_back();
+
+    partition.file->finish();
+    while (partition.file->next()) {
+      try {
+        loadRow(partition.file->current());
+        processRow(partition.depth + 1);
+      } catch (...) {
+        releaseRow();
+        throw;
+      }
+      releaseRow();
+    }
+    partition.file.reset();
+    finishSpilling(partition.depth + 1);
+
+    return produceResult(skipping, result, skipped_);
+  }
+
   enum class GetNextRowState { NONE, SUCCESS, WAITING };
 
   RegisterId const nrInRegs = getNrInputRegisters();
-  RegisterId const nrOutRegs = getNrOutputRegisters();
 
   // get the next row from the current block. fetches a new block if necessary.
   auto getNextRow =
@@ -648,7 +689,7 @@ std::pair<ExecutionState, Result> HashedCollectBlock::getOrSkipSome(
       ExecutionState state;
       bool blockAppended;
       std::tie(state, blockAppended) =
-          ExecutionBlock::getBlock(DefaultBatchSize());
+          ExecutionBlock::getBlock(upstreamBatchSize());
       if (state == ExecutionState::WAITING) {
         TRI_ASSERT(!blockAppended);
         return std::make_tuple(GetNextRowState::WAITING, nullptr, 0);
@@ -676,224 +717,385 @@ std::pair<ExecutionState, Result> HashedCollectBlock::getOrSkipSome(
     return std::make_tuple(GetNextRowState::SUCCESS, cur, pos);
   };
 
-  auto* en = ExecutionNode::castTo<CollectNode const*>(_exeNode);
-
-  // if no group exists for the current row yet, this builds a new group.
-  auto buildNewGroup = [this, en](
-      const AqlItemBlock* cur, size_t const pos,
-      const size_t n) -> std::pair<std::unique_ptr<AggregateValuesType>,
-                                   std::vector<AqlValue>> {
-    std::vector<AqlValue> group;
-    group.reserve(n);
+  while (true) {
+    TRI_IF_FAILURE("HashedCollectBlock::getOrSkipSomeOuter") {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+    }
+    GetNextRowState state;
+    AqlItemBlock* cur = nullptr;
+    size_t pos = 0;
+    std::tie(state, cur, pos) = getNextRow();
+    if (state == GetNextRowState::NONE) {
+      // no more rows
+      break;
+    } else if (state == GetNextRowState::WAITING) {
+      // continue later
+      return {ExecutionState::WAITING, TRI_ERROR_NO_ERROR};
+    }
+    TRI_ASSERT(state == GetNextRowState::SUCCESS);
 
-    // copy the group values before they get invalidated
-    for (size_t i = 0; i < n; ++i) {
-      group.emplace_back(
-          cur->getValueReference(pos, _groupRegisters[i].second).clone());
+    TRI_IF_FAILURE("HashedCollectBlock::getOrSkipSome") {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
     }
 
-    auto aggregateValues = std::make_unique<AggregateValuesType>();
+    if (_lastBlock != nullptr && _lastBlock != cur) {
+      // return lastBlock just before forgetting it
+      returnBlock(_lastBlock);
+    }
 
-    if (en->_aggregateVariables.empty()) {
-      // no aggregate registers. this means we'll only count the number of items
-      if (en->_count) {
-        aggregateValues->emplace_back(Aggregator::fromTypeString(_trx, "LENGTH"));
-      }
-    } else {
-      // we do have aggregate registers. create them as empty AqlValues
-      aggregateValues->reserve(_aggregateRegisters.size());
+    _lastBlock = cur;
 
-      // initialize aggregators
-      for (auto const& r : en->_aggregateVariables) {
-        aggregateValues->emplace_back(
-            Aggregator::fromTypeString(_trx, r.second.second));
-      }
-    }
+    loadRow(cur, pos);
+    processRow(0);
+  }
 
-    return std::make_pair(std::move(aggregateValues), group);
-  };
+  _inputDone = true;
 
-  // finds the group matching the current row, or emplaces it. in either case,
-  // it returns an iterator to the group matching the current row in _allGroups.
-  // additionally, .second is true iff a new group was emplaced.
-  auto findOrEmplaceGroup = [this, &buildNewGroup](
-      AqlItemBlock const* cur,
-      size_t const pos) -> std::pair<decltype(_allGroups)::iterator, bool> {
-    std::vector<AqlValue> groupValues;
-    size_t const n = _groupRegisters.size();
-    groupValues.reserve(n);
+  // _lastBlock is null iff the input didn't contain a single row
+  if (_lastBlock == nullptr) {
+    _done = true;
+    return {ExecutionState::DONE, TRI_ERROR_NO_ERROR};
+  }
 
-    // for hashing simply re-use the aggregate registers, without cloning
-    // their contents
-    for (size_t i = 0; i < n; ++i) {
-      groupValues.emplace_back(
-          cur->getValueReference(pos, _groupRegisters[i].second));
-    }
+  try {
+    finishSpilling(0);
 
-    auto it = _allGroups.find(groupValues);
+    // keep a copy of the first input row, so that the groups of spilled
+    // partitions can inherit the same registers later
+    _inheritBlock.reset(_lastBlock->slice(0, 1));
+  } catch (...) {
+    returnBlock(_lastBlock);
+    throw;
+  }
+  returnBlock(_lastBlock);
 
-    if (it != _allGroups.end()) {
-      // group already exists
-      return {it, false};
-    }
+  return produceResult(skipping, result, skipped_);
+}
 
-    // must create new group
-    std::unique_ptr<AggregateValuesType> aggregateValues;
-    std::vector<AqlValue> group;
-    std::tie(aggregateValues, group) = buildNewGroup(cur, pos, n);
+/// @brief loads the group and aggregate values of an input row, without
+/// copying them
+void HashedCollectBlock::loadRow(AqlItemBlock const* cur, size_t pos) {
+  size_t i = 0;
+  for (auto const& r : _groupRegisters) {
+    _rowGroupValues[i++] = cur->getValueReference(pos, r.second);
+  }
+  i = 0;
+  for (auto const& r : _aggregateRegisters) {
+    _rowAggregateValues[i++] = getValueForRegister(cur, pos, r.second);
+  }
+}
 
-    // note: aggregateValues may be a nullptr!
-    auto emplaceResult = _allGroups.emplace(group, std::move(aggregateValues));
-    // emplace must not fail
-    TRI_ASSERT(emplaceResult.second);
+/// @brief loads the group and aggregate values of a spilled row. the row
+/// is only valid until the next row is read, and the file is gone before
+/// the groups are returned, so the values are copied. they have to be
+/// released with releaseRow()
+void HashedCollectBlock::loadRow(VPackSlice row) {
+  TRI_ASSERT(row.isArray());
+  TRI_ASSERT(row.length() == _rowGroupValues.size() + _rowAggregateValues.size());
 
-    return {emplaceResult.first, true};
-  };
+  for (auto& v : _rowGroupValues) {
+    v = AqlValue();
+  }
+  for (auto& v : _rowAggregateValues) {
+    v = AqlValue();
+  }
 
-  auto buildResult = [this, en, nrInRegs,
-                      nrOutRegs](AqlItemBlock const* src) -> AqlItemBlock* {
+  VPackArrayIterator it(row);
+  for (auto& v : _rowGroupValues) {
+    v = AqlValue(AqlValueHintCopy(it.value().begin()));
+    it.next();
+  }
+  for (auto& v : _rowAggregateValues) {
+    VPackSlice s = it.value();
+    if (!s.isIllegal()) {
+      v = AqlValue(AqlValueHintCopy(s.begin()));
+    }
+    it.next();
+  }
+}
 
-    std::unique_ptr<AqlItemBlock> result(
-        requestBlock(_allGroups.size(), nrOutRegs));
+/// @brief frees the values copied by loadRow(VPackSlice)
+void HashedCollectBlock::releaseRow() {
+  for (auto& v : _rowGroupValues) {
+    v.destroy();
+  }
+  for (auto& v : _rowAggregateValues) {
+    v.destroy();
+  }
+}
 
-    if (src != nullptr) {
-      inheritRegisters(src, result.get(), 0);
+/// @brief adds the current row to its group, or writes it to a partition if
+/// there is no group for it yet and no new groups may be created
+void HashedCollectBlock::processRow(size_t depth) {
+  uint64_t const hash = hashRow();
+  size_t group = findGroup(hash);
+
+  if (group == NoGroup) {
+    if (_spillThreshold > 0 && numGroups() >= _spillThreshold &&
+        depth < MaxPartitionDepth) {
+      spillRow(hash, depth);
+      return;
     }
+    group = emplaceGroup(hash);
+  }
 
-    TRI_ASSERT(!en->_count || _collectRegister != ExecutionNode::MaxRegisterId);
+  reduceAggregates(group);
+}
 
-    size_t row = 0;
-    for (auto& it : _allGroups) {
-      auto& keys = it.first;
-      TRI_ASSERT(it.second != nullptr);
+uint64_t HashedCollectBlock::hashRow() const {
+  uint64_t hash = 0x12345678;
 
-      TRI_ASSERT(keys.size() == _groupRegisters.size());
-      size_t i = 0;
-      for (auto& key : keys) {
-        result->setValue(row, _groupRegisters[i++].first, key);
-        const_cast<AqlValue*>(&key)
-            ->erase();  // to prevent double-freeing later
-      }
+  for (auto const& it : _rowGroupValues) {
+    // we must use the slow hash function here, because a value may have
+    // different representations in case its an array/object/number
+    // (calls normalizedHash() internally)
+    hash = it.hash(_trx, hash);
+  }
 
-      if (!en->_count) {
-        TRI_ASSERT(it.second->size() == _aggregateRegisters.size());
-        size_t j = 0;
-        for (auto const& r : *(it.second)) {
-          result->setValue(row, _aggregateRegisters[j++].first,
-                           r->stealValue());
+  return hash;
+}
+
+/// @brief the index of the group matching the current row, or NoGroup
+size_t HashedCollectBlock::findGroup(uint64_t hash) const {
+  if (_slots.empty()) {
+    return NoGroup;
+  }
+
+  size_t const n = _rowGroupValues.size();
+  size_t const mask = _slots.size() - 1;
+  size_t slot = static_cast<size_t>(hash) & mask;
+
+  while (true) {
+    uint32_t entry = _slots[slot];
+    if (entry == 0) {
+      return NoGroup;
+    }
+    size_t const group = entry - 1;
+
+    if (_groupHashes[group] == hash) {
+      AqlValue const* values = _groupValues.data() + group * n;
+      bool equal = true;
+      for (size_t i = 0; i < n; ++i) {
+        if (AqlValue::Compare(_trx, values[i], _rowGroupValues[i], false) != 0) {
+          equal = false;
+          break;
         }
-      } else {
-        // set group count in result register
-        TRI_ASSERT(!it.second->empty());
-        result->setValue(row, _collectRegister,
-                         it.second->back()->stealValue());
       }
-
-      if (row > 0) {
-        // re-use already copied AQLValues for remaining registers
-        result->copyValuesFromFirstRow(row, nrInRegs);
+      if (equal) {
+        return group;
       }
-
-      ++row;
     }
 
-    return result.release();
-  };
+    slot = (slot + 1) & mask;
+  }
+}
+
+/// @brief creates a new group for the current row and returns its index
+size_t HashedCollectBlock::emplaceGroup(uint64_t hash) {
+  if ((numGroups() + 1) * 2 > _slots.size()) {
+    // keep the load factor below 0.5
+    growTable();
+  }
+
+  auto* en = ExecutionNode::castTo<CollectNode const*>(_exeNode);
+  size_t const group = numGroups();
+  size_t const valuesBefore = _groupValues.size();
+  size_t const aggregatorsBefore = _aggregators.size();
 
-  // "adds" the current row to its group's aggregates.
-  auto reduceAggregates = [this, en](decltype(_allGroups)::iterator groupIt,
-                                     AqlItemBlock const* cur,
-                                     size_t const pos) {
-    AggregateValuesType* aggregateValues = groupIt->second.get();
+  try {
+    // copy the group values before they get invalidated
+    for (auto const& it : _rowGroupValues) {
+      AqlValue a = it.clone();
+      AqlValueGuard guard(a, true);
+      _groupValues.emplace_back(a);
+      guard.steal();
+    }
 
     if (en->_aggregateVariables.empty()) {
-      // no aggregate registers. simply increase the counter
       if (en->_count) {
-        // TODO get rid of this special case if possible
-        TRI_ASSERT(!aggregateValues->empty());
-        aggregateValues->back()->reduce(AqlValue());
+        _aggregators.emplace_back(Aggregator::fromTypeString(_trx, "LENGTH"));
       }
     } else {
-      // apply the aggregators for the group
-      TRI_ASSERT(aggregateValues->size() == _aggregateRegisters.size());
-      size_t j = 0;
-      for (auto const& r : _aggregateRegisters) {
-        (*aggregateValues)[j]->reduce(getValueForRegister(cur, pos, r.second));
-        ++j;
+      for (auto const& r : en->_aggregateVariables) {
+        _aggregators.emplace_back(
+            Aggregator::fromTypeString(_trx, r.second.second));
       }
     }
-  };
 
-  while (true) {
-    TRI_IF_FAILURE("HashedCollectBlock::getOrSkipSomeOuter") {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+    _groupHashes.emplace_back(hash);
+  } catch (...) {
+    // roll back the partially created group
+    while (_groupValues.size() > valuesBefore) {
+      _groupValues.back().destroy();
+      _groupValues.pop_back();
     }
-    GetNextRowState state;
-    AqlItemBlock* cur = nullptr;
-    size_t pos = 0;
-    std::tie(state, cur, pos) = getNextRow();
-    if (state == GetNextRowState::NONE) {
-      // no more rows
-      break;
-    } else if (state == GetNextRowState::WAITING) {
-      // continue later
-      return {ExecutionState::WAITING, TRI_ERROR_NO_ERROR};
-    }
-    TRI_ASSERT(state == GetNextRowState::SUCCESS);
+    _aggregators.resize(aggregatorsBefore);
+    throw;
+  }
 
-    TRI_IF_FAILURE("HashedCollectBlock::getOrSkipSome") {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  TRI_ASSERT(_aggregators.size() == numGroups() * _aggregatorsPerGroup);
+
+  size_t const mask = _slots.size() - 1;
+  size_t slot = static_cast<size_t>(hash) & mask;
+  while (_slots[slot] != 0) {
+    slot = (slot + 1) & mask;
+  }
+  _slots[slot] = static_cast<uint32_t>(group + 1);
+
+  return group;
+}
+
+/// @brief doubles the number of slots and reinserts all groups
+void HashedCollectBlock::growTable() {
+  size_t const size = (std::max)(static_cast<size_t>(1024), _slots.size() * 2);
+  _slots.assign(size, 0);
+
+  size_t const mask = size - 1;
+  size_t const n = numGroups();
+  for (size_t group = 0; group < n; ++group) {
+    size_t slot = static_cast<size_t>(_groupHashes[group]) & mask;
+    while (_slots[slot] != 0) {
+      slot = (slot + 1) & mask;
     }
+    _slots[slot] = static_cast<uint32_t>(group + 1);
+  }
+}
 
-    if (_lastBlock != nullptr && _lastBlock != cur) {
-      // return lastBlock just before forgetting it
-      returnBlock(_lastBlock);
+/// @brief "adds" the current row to its group's aggregates
+void HashedCollectBlock::reduceAggregates(size_t group) {
+  auto* en = ExecutionNode::castTo<CollectNode const*>(_exeNode);
+  auto it = _aggregators.begin() + group * _aggregatorsPerGroup;
+
+  if (en->_aggregateVariables.empty()) {
+    // no aggregate registers. simply increase the counter
+    if (en->_count) {
+      (*it)->reduce(AqlValue());
     }
+  } else {
+    // apply the aggregators for the group
+    for (auto const& value : _rowAggregateValues) {
+      (*it)->reduce(value);
+      ++it;
+    }
+  }
+}
 
-    _lastBlock = cur;
+/// @brief writes the current row to the partition selected by the hash.
+/// each level of partitioning uses a different part of the hash, so that
+/// rows of a partition are distributed again when it gets spilled itself
+void HashedCollectBlock::spillRow(uint64_t hash, size_t depth) {
+  TRI_IF_FAILURE("HashedCollectBlock::spillRow") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
 
-    // NOLINTNEXTLINE(hicpp-use-auto,modernize-use-auto)
-    decltype(_allGroups)::iterator currentGroupIt;
-    bool newGroup;
-    std::tie(currentGroupIt, newGroup) = findOrEmplaceGroup(cur, pos);
+  size_t const partition = static_cast<size_t>(
+      (hash >> (64 - PartitionBits * (depth + 1))) & (NumPartitions - 1));
 
-    if (newGroup) {
-      ++_skipped;
+  if (_spilling[partition] == nullptr) {
+    _spilling[partition].reset(new SpillFile());
+  }
+
+  _spillBuilder.clear();
+  _spillBuilder.openArray();
+  for (auto const& it : _rowGroupValues) {
+    it.toVelocyPack(_trx, _spillBuilder, false);
+  }
+  for (auto const& it : _rowAggregateValues) {
+    if (it.isEmpty()) {
+      _spillBuilder.add(VPackValue(VPackValueType::Illegal));
+    } else {
+      it.toVelocyPack(_trx, _spillBuilder, false);
     }
+  }
+  _spillBuilder.close();
 
-    reduceAggregates(currentGroupIt, cur, pos);
+  _spilling[partition]->append(_spillBuilder.slice());
+}
+
+/// @brief moves the partitions written at the specified depth to the list
+/// of partitions that still need to be aggregated
+void HashedCollectBlock::finishSpilling(size_t depth) {
+  for (auto& it : _spilling) {
+    if (it != nullptr) {
+      _partitions.emplace_back(Partition{std::move(it), depth});
+      it.reset();
+    }
   }
+}
 
-  // _lastBlock is null iff the input didn't contain a single row
-  if (_lastBlock != nullptr) {
-    try {
-      result = buildResult(_lastBlock);
-      skipped_ = _skipped;
-      returnBlock(_lastBlock);
-    } catch(...) {
-      returnBlock(_lastBlock);
-      throw;
+/// @brief builds the result block for all groups currently in memory and
+/// clears them afterwards
+std::pair<ExecutionState, Result> HashedCollectBlock::produceResult(
+    bool skipping, AqlItemBlock*& result, size_t& skipped) {
+  auto* en = ExecutionNode::castTo<CollectNode const*>(_exeNode);
+  RegisterId const nrInRegs = _inheritBlock->getNrRegs();
+  size_t const n = numGroups();
+
+  if (n > 0 && !skipping) {
+    std::unique_ptr<AqlItemBlock> res(
+        requestBlock(n, getNrOutputRegisters()));
+
+    inheritRegisters(_inheritBlock.get(), res.get(), 0);
+
+    TRI_ASSERT(!en->_count || _collectRegister != ExecutionNode::MaxRegisterId);
+
+    size_t const nrGroupRegs = _groupRegisters.size();
+    for (size_t row = 0; row < n; ++row) {
+      AqlValue* keys = _groupValues.data() + row * nrGroupRegs;
+      for (size_t i = 0; i < nrGroupRegs; ++i) {
+        res->setValue(row, _groupRegisters[i].first, keys[i]);
+        keys[i].erase();  // to prevent double-freeing later
+      }
+
+      auto aggregators = _aggregators.begin() + row * _aggregatorsPerGroup;
+      if (!en->_count) {
+        for (auto const& r : _aggregateRegisters) {
+          res->setValue(row, r.first, (*aggregators)->stealValue());
+          ++aggregators;
+        }
+      } else {
+        // set group count in result register
+        TRI_ASSERT(_aggregatorsPerGroup > 0);
+        res->setValue(row, _collectRegister,
+                      aggregators[_aggregatorsPerGroup - 1]->stealValue());
+      }
+
+      if (row > 0) {
+        // re-use already copied AQLValues for remaining registers
+        res->copyValuesFromFirstRow(row, nrInRegs);
+      }
     }
+
+    result = res.release();
   }
 
-  _done = true;
+  skipped = n;
+  clearGroups();
 
-  return {ExecutionState::DONE, TRI_ERROR_NO_ERROR};
+  if (_partitions.empty()) {
+    _inheritBlock.reset();
+    _done = true;
+    return {ExecutionState::DONE, TRI_ERROR_NO_ERROR};
+  }
+  return {ExecutionState::HASMORE, TRI_ERROR_NO_ERROR};
 }
 
 HashedCollectBlock::~HashedCollectBlock() {
-  // Generally, _allGroups should be empty when the block is destroyed - except
-  // when an exception is thrown during getOrSkipSome, in which case the
+  // Generally, there should be no groups left when the block is destroyed -
+  // except when an exception is thrown during getOrSkipSome, in which case the
   // AqlValue ownership hasn't been transferred.
-  _destroyAllGroupsAqlValues();
+  clearGroups();
 }
 
-void HashedCollectBlock::_destroyAllGroupsAqlValues() {
-  for (auto& it : _allGroups) {
-    for (auto& it2 : it.first) {
-      const_cast<AqlValue*>(&it2)->destroy();
-    }
+/// @brief destroys all groups currently in memory
+void HashedCollectBlock::clearGroups() {
+  for (auto& it : _groupValues) {
+    it.destroy();
   }
+  _groupValues.clear();
+  _groupHashes.clear();
+  _aggregators.clear();
+  _slots.clear();
 }
 
 std::pair<ExecutionState, Result>
@@ -908,8 +1110,13 @@ HashedCollectBlock::initializeCursor(AqlItemBlock *items, size_t pos) {
   }
 
   _lastBlock = nullptr;
-  _destroyAllGroupsAqlValues();
-  _allGroups.clear();
+  clearGroups();
+  for (auto& it : _spilling) {
+    it.reset();
+  }
+  _partitions.clear();
+  _inheritBlock.reset();
+  _inputDone = false;
 
   return {state, result};
 
@@ -919,6 +1126,13 @@ DistinctCollectBlock::DistinctCollectBlock(ExecutionEngine* engine,
                                            CollectNode const* en)
     : ExecutionBlock(engine, en),
       _groupRegisters(),
+      _spillThreshold(engine->getQuery()->queryOptions().collectSpillThreshold),
+      _hashOnly(engine->getQuery()->queryOptions().distinctHashOnly),
+      _numValues(0),
+      _memoryUsage(0),
+      _memoryFull(false),
+      _readingDepth(0),
+      _inputDone(false),
       _res(nullptr) {
   for (auto const& p : en->_groupVariables) {
     // We know that planRegisters() has been run, so
@@ -935,9 +1149,8 @@ DistinctCollectBlock::DistinctCollectBlock(ExecutionEngine* engine,
   }
 
   TRI_ASSERT(!_groupRegisters.empty());
-      
-  _seen = std::make_unique<std::unordered_set<std::vector<AqlValue>, AqlValueGroupHash, AqlValueGroupEqual>>(
-    1024, AqlValueGroupHash(transaction(), _groupRegisters.size()), AqlValueGroupEqual(transaction()));
+
+  _rowGroupValues.resize(_groupRegisters.size());
 }
 
 DistinctCollectBlock::~DistinctCollectBlock() {
@@ -959,6 +1172,13 @@ std::pair<ExecutionState, arangodb::Result> DistinctCollectBlock::initializeCurs
   _pos = 0;
   _res = nullptr;
   clearValues();
+  for (auto& it : _spilling) {
+    it.reset();
+  }
+  _partitions.clear();
+  _reading.reset();
+  _inheritBlock.reset();
+  _inputDone = false;
   DEBUG_END_BLOCK();
 
   return res;
@@ -967,15 +1187,17 @@ std::pair<ExecutionState, arangodb::Result> DistinctCollectBlock::initializeCurs
   DEBUG_END_BLOCK();
 }
 
+/// @brief forgets all values in memory and gives their memory back
 void DistinctCollectBlock::clearValues() {
-  if (_seen) {
-    for (auto& it : *_seen) {
-      for (auto& it2 : it) {
-        const_cast<AqlValue*>(&it2)->destroy();
-      }
-    }
-    _seen->clear(); 
+  std::vector<Slot>().swap(_slots);
+  std::string().swap(_arena);
+  std::vector<size_t>().swap(_offsets);
+  _numValues = 0;
+  if (_memoryUsage > 0) {
+    _engine->getQuery()->resourceMonitor()->decreaseMemoryUsage(_memoryUsage);
+    _memoryUsage = 0;
   }
+  _memoryFull = false;
 }
 
 std::pair<ExecutionState, Result> DistinctCollectBlock::getOrSkipSome(
@@ -1004,34 +1226,32 @@ std::pair<ExecutionState, Result> DistinctCollectBlock::getOrSkipSome(
     _skipped = 0;
   };
 
+  // spilled partitions still produce values after the input is done
+  auto const state = [this]() {
+    if (!_done && _inputDone && (_reading != nullptr || !_partitions.empty())) {
+      return ExecutionState::HASMORE;
+    }
+    return getHasMoreState();
+  };
+
   if (_done) {
     return {ExecutionState::DONE, TRI_ERROR_NO_ERROR};
   }
 
-  std::vector<AqlValue> groupValues;
-  groupValues.reserve(_groupRegisters.size());
-
-  {
+  if (!_inputDone) {
     // We need a valid cur ptr for inheritRegisters.
     BufferState bufferState = getBlockIfNeeded(atMost);
 
     if (bufferState == BufferState::WAITING) {
       return {ExecutionState::WAITING, TRI_ERROR_NO_ERROR};
     }
-    if (bufferState == BufferState::NO_MORE_BLOCKS) {
-      assignReturnValues();
-      return {getHasMoreState(), TRI_ERROR_NO_ERROR};
-    }
-
-    TRI_ASSERT(bufferState == BufferState::HAS_BLOCKS ||
-               bufferState == BufferState::HAS_NEW_BLOCK);
-    TRI_ASSERT(!_buffer.empty());
-
-    AqlItemBlock *cur = _buffer.front();
-    TRI_ASSERT(cur != nullptr);
 
     // On the very first call, get a result block and inherit registers.
-    if (!skipping && _res == nullptr) {
+    if (bufferState != BufferState::NO_MORE_BLOCKS && !skipping &&
+        _res == nullptr) {
+      TRI_ASSERT(!_buffer.empty());
+      AqlItemBlock* cur = _buffer.front();
+      TRI_ASSERT(cur != nullptr);
       TRI_ASSERT(_skipped == 0);
       _res.reset(requestBlock(atMost, getNrOutputRegisters()));
 
@@ -1040,13 +1260,18 @@ std::pair<ExecutionState, Result> DistinctCollectBlock::getOrSkipSome(
     }
   }
 
-  while (!_done && _skipped < atMost) {
+  while (!_inputDone && _skipped < atMost) {
     BufferState bufferState = getBlockIfNeeded(atMost);
 
     if (bufferState == BufferState::WAITING) {
       return {ExecutionState::WAITING, TRI_ERROR_NO_ERROR};
     }
     if (bufferState == BufferState::NO_MORE_BLOCKS) {
+      // the values in memory are not needed anymore, the spilled ones
+      // are distinct from them
+      _inputDone = true;
+      finishSpilling(0);
+      clearValues();
       break;
     }
 
@@ -1059,43 +1284,302 @@ std::pair<ExecutionState, Result> DistinctCollectBlock::getOrSkipSome(
     }
 
     throwIfKilled();  // check if we were aborted
-   
-    groupValues.clear(); 
+
     // for hashing simply re-use the aggregate registers, without cloning
     // their contents
-    for (auto &it : _groupRegisters) {
-      groupValues.emplace_back(
-          cur->getValueReference(_pos, it.second));
+    loadRow(cur, _pos);
+    RowState const rowState = processRow(0);
+
+    if (rowState == RowState::NEW && !skipping) {
+      size_t i = 0;
+      for (auto& it : _groupRegisters) {
+        _res->setValue(_skipped, it.first, _rowGroupValues[i].clone());
+        ++i;
+      }
+    } else if (rowState == RowState::SPILLED && _inheritBlock == nullptr) {
+      // keep a copy of the input row, so that the values of spilled
+      // partitions can inherit the same registers later
+      _inheritBlock.reset(cur->slice(_pos, _pos + 1));
     }
 
-    // now check if we already know this group
-    auto foundIt = _seen->find(groupValues);
+    AqlItemBlock *removedBlock =
+        advanceCursor(1, rowState == RowState::NEW ? 1 : 0);
+    returnBlockUnlessNull(removedBlock);
+  }
 
-    bool newGroup = foundIt == _seen->end();
+  while (_inputDone && _skipped < atMost) {
+    if (_reading == nullptr) {
+      if (!nextPartition()) {
+        _done = true;
+        break;
+      }
+    }
 
-    if (newGroup) {
-      if (!skipping) {
-        size_t i = 0;
-        for (auto& it : _groupRegisters) {
-          _res->setValue(_skipped, it.first, groupValues[i].clone());
-          ++i;
+    throwIfKilled();  // check if we were aborted
+
+    if (!_reading->next()) {
+      _reading.reset();
+      finishSpilling(_readingDepth);
+      continue;
+    }
+
+    try {
+      loadRow(_reading->current());
+      if (processRow(_readingDepth) == RowState::NEW) {
+        if (!skipping) {
+          if (_res == nullptr) {
+            TRI_ASSERT(_inheritBlock != nullptr);
+            _res.reset(requestBlock(atMost, getNrOutputRegisters()));
+            inheritRegisters(_inheritBlock.get(), _res.get(), 0);
+          }
+          size_t i = 0;
+          for (auto& it : _groupRegisters) {
+            _res->setValue(_skipped, it.first, _rowGroupValues[i].clone());
+            ++i;
+          }
+        }
+        ++_skipped;
+      }
+    } catch (...) {
+      releaseRow();
+      throw;
+    }
+    releaseRow();
+  }
+
+  assignReturnValues();
+  return {state(), TRI_ERROR_NO_ERROR};
+}
+
+/// @brief loads the group values of an input row, without copying them
+void DistinctCollectBlock::loadRow(AqlItemBlock const* cur, size_t pos) {
+  size_t i = 0;
+  for (auto const& r : _groupRegisters) {
+    _rowGroupValues[i++] = cur->getValueReference(pos, r.second);
+  }
+}
+
+/// @brief loads the group values of a spilled row. the row is only valid
+/// until the next row is read, and the values are returned after the file
+/// is gone, so they are copied. they have to be released with releaseRow()
+void DistinctCollectBlock::loadRow(VPackSlice row) {
+  TRI_ASSERT(row.isArray());
+  TRI_ASSERT(row.length() == _rowGroupValues.size());
+
+  for (auto& v : _rowGroupValues) {
+    v = AqlValue();
+  }
+
+  VPackArrayIterator it(row);
+  for (auto& v : _rowGroupValues) {
+    v = AqlValue(AqlValueHintCopy(it.value().begin()));
+    it.next();
+  }
+}
+
+/// @brief frees the values copied by loadRow(VPackSlice)
+void DistinctCollectBlock::releaseRow() {
+  for (auto& v : _rowGroupValues) {
+    v.destroy();
+  }
+}
+
+/// @brief remembers the values of the current row, unless they were seen
+/// before. values that do not fit into memory are written to a partition
+DistinctCollectBlock::RowState DistinctCollectBlock::processRow(size_t depth) {
+  // we must use the slow hash function here, because a value may have
+  // different representations in case its an array/object/number
+  // (calls normalizedHash() internally)
+  uint64_t hash = 0x12345678;
+  for (auto const& it : _rowGroupValues) {
+    hash = it.hash(_trx, hash);
+  }
+
+  uint64_t payload = 0;
+  if (_hashOnly) {
+    // the other half of the 128-bit hash, with a different seed
+    payload = 0x9e3779b97f4a7c15ULL;
+    for (auto const& it : _rowGroupValues) {
+      payload = it.hash(_trx, payload);
+    }
+    if (payload == 0) {
+      payload = 1;
+    }
+  }
+
+  if (!_slots.empty()) {
+    size_t const mask = _slots.size() - 1;
+    size_t slot = static_cast<size_t>(hash) & mask;
+
+    while (_slots[slot].payload != 0) {
+      Slot const& s = _slots[slot];
+      if (s.hash == hash &&
+          (_hashOnly ? s.payload == payload : equalsRow(s.payload - 1))) {
+        return RowState::DUPLICATE;
+      }
+      slot = (slot + 1) & mask;
+    }
+  }
+
+  bool const mayFail = depth < MaxPartitionDepth;
+  if (mayFail && (_memoryFull || (_spillThreshold > 0 &&
+                                  _numValues >= _spillThreshold))) {
+    spillRow(hash, depth);
+    return RowState::SPILLED;
+  }
+  if (!insertRow(Slot{hash, payload}, mayFail)) {
+    spillRow(hash, depth);
+    return RowState::SPILLED;
+  }
+  return RowState::NEW;
+}
+
+/// @brief whether the index-th value in the arena equals the current row
+bool DistinctCollectBlock::equalsRow(uint64_t index) const {
+  TRI_ASSERT(index < _offsets.size());
+  VPackSlice stored(reinterpret_cast<uint8_t const*>(
+      _arena.data() + _offsets[static_cast<size_t>(index)]));
+
+  size_t i = 0;
+  for (auto const& it : VPackArrayIterator(stored)) {
+    if (AqlValue::Compare(_trx, AqlValue(it.begin()), _rowGroupValues[i],
+                          false) != 0) {
+      return false;
+    }
+    ++i;
+  }
+  return true;
+}
+
+/// @brief adds the current row to the values in memory. returns false if
+/// this would exceed the memory limit of the query and mayFail is set
+bool DistinctCollectBlock::insertRow(Slot const& slot, bool mayFail) {
+  if ((_numValues + 1) * 4 > _slots.size() * 3) {
+    // keep the load factor below 0.75
+    size_t const size =
+        (std::max)(static_cast<size_t>(1024), _slots.size() * 2);
+    if (!reserveMemory((size - _slots.size()) * sizeof(Slot), mayFail)) {
+      return false;
+    }
+
+    std::vector<Slot> slots(size, Slot{0, 0});
+    size_t const mask = size - 1;
+    for (auto const& it : _slots) {
+      if (it.payload != 0) {
+        size_t pos = static_cast<size_t>(it.hash) & mask;
+        while (slots[pos].payload != 0) {
+          pos = (pos + 1) & mask;
         }
+        slots[pos] = it;
       }
-      // transfer ownership 
-      std::vector<AqlValue> copy;
-      copy.reserve(groupValues.size());
-      for (auto const& it : groupValues) {
-        copy.emplace_back(it.clone());
+    }
+    _slots.swap(slots);
+  }
+
+  Slot entry = slot;
+  if (!_hashOnly) {
+    // the values themselves go to the arena, for comparisons
+    _builder.clear();
+    _builder.openArray();
+    for (auto const& it : _rowGroupValues) {
+      it.toVelocyPack(_trx, _builder, false);
+    }
+    _builder.close();
+
+    size_t const length = _builder.slice().byteSize();
+    if (!reserveMemory(length + sizeof(size_t), mayFail)) {
+      return false;
+    }
+    _offsets.emplace_back(_arena.size());
+    _arena.append(_builder.slice().startAs<char>(), length);
+    entry.payload = _offsets.size();
+  }
+
+  size_t const mask = _slots.size() - 1;
+  size_t pos = static_cast<size_t>(entry.hash) & mask;
+  while (_slots[pos].payload != 0) {
+    pos = (pos + 1) & mask;
+  }
+  _slots[pos] = entry;
+  ++_numValues;
+
+  return true;
+}
+
+/// @brief registers memory with the ResourceMonitor of the query. if
+/// mayFail is set, hitting the memory limit returns false instead of
+/// throwing, and all further values are spilled
+bool DistinctCollectBlock::reserveMemory(size_t value, bool mayFail) {
+  ResourceMonitor* monitor = _engine->getQuery()->resourceMonitor();
+  if (!mayFail) {
+    monitor->increaseMemoryUsage(value);
+  } else {
+    try {
+      monitor->increaseMemoryUsage(value);
+    } catch (basics::Exception const& ex) {
+      if (ex.code() != TRI_ERROR_RESOURCE_LIMIT) {
+        throw;
       }
-      _seen->emplace(std::move(copy));
+      _memoryFull = true;
+      return false;
     }
+  }
+  _memoryUsage += value;
+  return true;
+}
 
-    AqlItemBlock *removedBlock = advanceCursor(1, newGroup ? 1 : 0);
-    returnBlockUnlessNull(removedBlock);
+/// @brief writes the current row to the partition selected by the hash,
+/// using a different part of the hash on each level of partitioning
+void DistinctCollectBlock::spillRow(uint64_t hash, size_t depth) {
+  TRI_IF_FAILURE("DistinctCollectBlock::spillRow") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
   }
 
-  assignReturnValues();
-  return {getHasMoreState(), TRI_ERROR_NO_ERROR};
+  size_t const partition = static_cast<size_t>(
+      (hash >> (64 - PartitionBits * (depth + 1))) & (NumPartitions - 1));
+
+  if (_spilling[partition] == nullptr) {
+    _spilling[partition].reset(new SpillFile());
+  }
+
+  _builder.clear();
+  _builder.openArray();
+  for (auto const& it : _rowGroupValues) {
+    it.toVelocyPack(_trx, _builder, false);
+  }
+  _builder.close();
+
+  _spilling[partition]->append(_builder.slice());
+}
+
+/// @brief moves the partitions written at the specified depth to the list
+/// of partitions that still need to be made unique
+void DistinctCollectBlock::finishSpilling(size_t depth) {
+  for (auto& it : _spilling) {
+    if (it != nullptr) {
+      _partitions.emplace_back(Partition{std::move(it), depth});
+      it.reset();
+    }
+  }
+}
+
+/// @brief starts reading the next spilled partition. its values are
+/// disjoint from all values seen before, so the memory is cleared first
+bool DistinctCollectBlock::nextPartition() {
+  TRI_ASSERT(_reading == nullptr);
+  if (_partitions.empty()) {
+    return false;
+  }
+
+  clearValues();
+
+  Partition partition = std::move(_partitions.back());
+  _partitions.pop_back();
+
+  _reading = std::move(partition.file);
+  _readingDepth = partition.depth + 1;
+  _reading->finish();
+  return true;
 }
 
 CountCollectBlock::CountCollectBlock(ExecutionEngine* engine,
@@ -1139,9 +1623,29 @@ std::pair<ExecutionState, Result> CountCollectBlock::getOrSkipSome(size_t atMost
     return {ExecutionState::DONE, TRI_ERROR_NO_ERROR};
   }
   
+  // index and collection scans can skip their rows without producing
+  // them: index entries are not resolved to documents, and a full scan
+  // takes the number of documents of the collection. other blocks may
+  // have side effects on the rows they produce
+  ExecutionBlock::Type const upstreamType = _dependencies[0]->getType();
+  if (upstreamType == Type::INDEX ||
+      upstreamType == Type::ENUMERATE_COLLECTION) {
+    while (!_done) {
+      auto upstreamRes = _dependencies[0]->skipSome(1000 * DefaultBatchSize());
+      if (upstreamRes.first == ExecutionState::WAITING) {
+        return {ExecutionState::WAITING, TRI_ERROR_NO_ERROR};
+      }
+      _count += upstreamRes.second;
+      if (upstreamRes.first == ExecutionState::DONE) {
+        _done = true;
+      }
+      throwIfKilled();  // check if we were aborted
+    }
+  }
+
   while (!_done) {  
     if (_buffer.empty()) {
-      auto upstreamRes = ExecutionBlock::getBlock(DefaultBatchSize());
+      auto upstreamRes = ExecutionBlock::getBlock(upstreamBatchSize());
       if (upstreamRes.first == ExecutionState::WAITING) {
         return {ExecutionState::WAITING, TRI_ERROR_NO_ERROR};
       }
@@ -32,10 +32,13 @@
 #include "Aql/CollectNode.h"
 #include "Aql/ExecutionBlock.h"
 #include "Aql/ExecutionNode.h"
+#include "Aql/SpillFile.h"
 #include "Basics/Result.h"
 
 #include <velocypack/Builder.h>
 
+#include <array>
+
 namespace arangodb {
 namespace transaction {
 class Methods;
@@ -154,10 +157,47 @@ class HashedCollectBlock final : public ExecutionBlock {
                                                      size_t pos) override;
 
  private:
+  /// @brief marker for a group that does not exist
+  static constexpr size_t NoGroup = SIZE_MAX;
+
+  /// @brief number of bits of the hash used for each level of partitioning
+  static constexpr size_t PartitionBits = 4;
+
+  /// @brief number of partitions that rows of groups which do not fit into
+  /// memory are distributed to
+  static constexpr size_t NumPartitions = 1 << PartitionBits;
+
+  /// @brief maximum partitioning depth, limited by the number of hash bits
+  static constexpr size_t MaxPartitionDepth = 64 / PartitionBits - 1;
+
+  /// @brief input rows spilled to disk, which still need to be aggregated
+  struct Partition {
+    std::unique_ptr<SpillFile> file;
+    size_t depth;
+  };
+
   std::pair<ExecutionState, Result> getOrSkipSome(size_t atMost, bool skipping,
                                                   AqlItemBlock*& result,
                                                   size_t& skipped) override;
 
+  size_t numGroups() const { return _groupHashes.size(); }
+
+  void loadRow(AqlItemBlock const* cur, size_t pos);
+  void loadRow(arangodb::velocypack::Slice row);
+  void releaseRow();
+  void processRow(size_t depth);
+  uint64_t hashRow() const;
+  size_t findGroup(uint64_t hash) const;
+  size_t emplaceGroup(uint64_t hash);
+  void growTable();
+  void reduceAggregates(size_t group);
+  void spillRow(uint64_t hash, size_t depth);
+  void finishSpilling(size_t depth);
+  std::pair<ExecutionState, Result> produceResult(bool skipping,
+                                                  AqlItemBlock*& result,
+                                                  size_t& skipped);
+  void clearGroups();
+
  private:
   /// @brief pairs, consisting of out register and in register
   std::vector<std::pair<RegisterId, RegisterId>> _groupRegisters;
@@ -174,13 +214,50 @@ class HashedCollectBlock final : public ExecutionBlock {
   /// @brief the last input block
   AqlItemBlock* _lastBlock;
 
-  /// @brief hashmap of all encountered groups
-  std::unordered_map<std::vector<AqlValue>,
-                     std::unique_ptr<AggregateValuesType>, AqlValueGroupHash,
-                     AqlValueGroupEqual>
-      _allGroups;
+  /// @brief maximum number of groups kept in memory. rows of further groups
+  /// are spilled to disk and aggregated later. 0 = never spill
+  size_t const _spillThreshold;
+
+  /// @brief number of aggregators per group
+  size_t _aggregatorsPerGroup;
+
+  /// @brief open-addressing hash table over all groups in memory. a slot
+  /// contains the index of a group + 1, or 0 if it is unused. the number of
+  /// slots is always a power of two
+  std::vector<uint32_t> _slots;
 
-  void _destroyAllGroupsAqlValues();
+  /// @brief hash values of all groups, indexed by group
+  std::vector<uint64_t> _groupHashes;
+
+  /// @brief group values of all groups, stored consecutively with one
+  /// value per group register
+  std::vector<AqlValue> _groupValues;
+
+  /// @brief aggregators of all groups, stored consecutively with
+  /// _aggregatorsPerGroup aggregators per group
+  std::vector<std::unique_ptr<Aggregator>> _aggregators;
+
+  /// @brief group values of the row currently processed (not owned)
+  std::vector<AqlValue> _rowGroupValues;
+
+  /// @brief aggregate input values of the row currently processed (not owned)
+  std::vector<AqlValue> _rowAggregateValues;
+
+  /// @brief partitions currently being written
+  std::array<std::unique_ptr<SpillFile>, NumPartitions> _spilling;
+
+  /// @brief partitions waiting to be aggregated
+  std::vector<Partition> _partitions;
+
+  /// @brief copy of the first input row, used for inheriting registers
+  /// into the results of all partitions
+  std::unique_ptr<AqlItemBlock> _inheritBlock;
+
+  /// @brief builder for spilled rows
+  arangodb::velocypack::Builder _spillBuilder;
+
+  /// @brief whether all input rows have been consumed
+  bool _inputDone;
 };
 
 class DistinctCollectBlock final : public ExecutionBlock {
@@ -196,17 +273,105 @@ class DistinctCollectBlock final : public ExecutionBlock {
   std::pair<ExecutionState, Result> initializeCursor(AqlItemBlock* items, size_t pos) override;
 
  private:
+  /// @brief number of bits of the hash used for each level of partitioning
+  static constexpr size_t PartitionBits = 4;
+
+  /// @brief number of partitions that values which do not fit into memory
+  /// are distributed to
+  static constexpr size_t NumPartitions = 1 << PartitionBits;
+
+  /// @brief maximum partitioning depth, limited by the number of hash bits
+  static constexpr size_t MaxPartitionDepth = 64 / PartitionBits - 1;
+
+  /// @brief a slot of the hash table. in hash-only mode, payload is the
+  /// second half of the 128-bit hash, otherwise the index of the value in
+  /// the arena + 1. a payload of 0 marks an unused slot
+  struct Slot {
+    uint64_t hash;
+    uint64_t payload;
+  };
+
+  /// @brief what became of a row
+  enum class RowState { DUPLICATE, NEW, SPILLED };
+
+  /// @brief input rows spilled to disk, which still need to be made unique
+  struct Partition {
+    std::unique_ptr<SpillFile> file;
+    size_t depth;
+  };
+
   std::pair<ExecutionState, Result> getOrSkipSome(size_t atMost, bool skipping,
                                                   AqlItemBlock*& result,
                                                   size_t& skipped) override;
 
+  void loadRow(AqlItemBlock const* cur, size_t pos);
+  void loadRow(arangodb::velocypack::Slice row);
+  void releaseRow();
+  RowState processRow(size_t depth);
+  bool equalsRow(uint64_t index) const;
+  bool insertRow(Slot const& slot, bool mayFail);
+  bool reserveMemory(size_t value, bool mayFail);
+  void spillRow(uint64_t hash, size_t depth);
+  void finishSpilling(size_t depth);
+  bool nextPartition();
   void clearValues();
 
  private:
   /// @brief pairs, consisting of out register and in register
   std::vector<std::pair<RegisterId, RegisterId>> _groupRegisters;
-  
-  std::unique_ptr<std::unordered_set<std::vector<AqlValue>, AqlValueGroupHash, AqlValueGroupEqual>> _seen;
+
+  /// @brief maximum number of values kept in memory. further values are
+  /// spilled to disk and made unique later. 0 = never spill
+  size_t const _spillThreshold;
+
+  /// @brief whether only the hashes of the values are remembered
+  bool const _hashOnly;
+
+  /// @brief open-addressing hash table over all values in memory. the
+  /// number of slots is always a power of two
+  std::vector<Slot> _slots;
+
+  /// @brief number of used slots
+  size_t _numValues;
+
+  /// @brief the values in memory as VelocyPack arrays of the group values,
+  /// stored consecutively. empty in hash-only mode
+  std::string _arena;
+
+  /// @brief offsets of the values in _arena
+  std::vector<size_t> _offsets;
+
+  /// @brief memory registered with the query's ResourceMonitor
+  size_t _memoryUsage;
+
+  /// @brief whether the memory limit of the query was hit, all further
+  /// values are spilled
+  bool _memoryFull;
+
+  /// @brief group values of the row currently processed. they are owned
+  /// only if the row was read from a partition
+  std::vector<AqlValue> _rowGroupValues;
+
+  /// @brief partitions currently being written
+  std::array<std::unique_ptr<SpillFile>, NumPartitions> _spilling;
+
+  /// @brief partitions waiting to be made unique
+  std::vector<Partition> _partitions;
+
+  /// @brief the partition currently read, and its depth
+  std::unique_ptr<SpillFile> _reading;
+  size_t _readingDepth;
+
+  /// @brief copy of the first input row, used for inheriting registers
+  /// into the results of all partitions
+  std::unique_ptr<AqlItemBlock> _inheritBlock;
+
+  /// @brief builder for spilled rows and the arena
+  arangodb::velocypack::Builder _builder;
+
+  /// @brief whether all input rows have been consumed
+  bool _inputDone;
+
   std::unique_ptr<AqlItemBlock> _res;
 };
 
@@ -212,6 +212,7 @@ struct UserVarFinder final : public WalkerWorker<ExecutionNode> {
       depth = 0;
     } else if (en->getType() == ExecutionNode::ENUMERATE_COLLECTION ||
                en->getType() == ExecutionNode::INDEX ||
+               en->getType() == ExecutionNode::HASH_JOIN ||
                en->getType() == ExecutionNode::ENUMERATE_LIST ||
                en->getType() == ExecutionNode::TRAVERSAL ||
                en->getType() == ExecutionNode::SHORTEST_PATH ||
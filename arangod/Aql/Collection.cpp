@@ -30,6 +30,7 @@
 #include "Basics/StringUtils.h"
 #include "Basics/Exceptions.h"
 #include "Cluster/ClusterInfo.h"
+#include "Cluster/ClusterMethods.h"
 #include "Cluster/ServerState.h"
 #include "Transaction/Methods.h"
 #include "VocBase/LogicalCollection.h"
@@ -68,6 +69,23 @@ TRI_voc_cid_t Collection::id() const {
 
 /// @brief count the number of documents in the collection
 size_t Collection::count(transaction::Methods* trx) const {
+  if (_numberDocuments == UNINITIALIZED &&
+      ServerState::instance()->isCoordinator() && !getCollection()->isSmart()) {
+    // the count is only used for estimates, a recent one from the
+    // coordinator's cache is good enough
+    std::vector<std::pair<std::string, uint64_t>> counts;
+    int res = arangodb::countOnCoordinator(_vocbase->name(), _name, *trx,
+                                           counts, true);
+    if (res != TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION(res);
+    }
+    uint64_t total = 0;
+    for (auto const& it : counts) {
+      total += it.second;
+    }
+    _numberDocuments = static_cast<int64_t>(total);
+  }
+
   if (_numberDocuments == UNINITIALIZED) {
     OperationResult res = trx->count(_name, false);
     if (res.fail()) {
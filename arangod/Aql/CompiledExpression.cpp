@@ -0,0 +1,348 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "CompiledExpression.h"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/ExpressionContext.h"
+#include "Aql/Variable.h"
+#include "Basics/Exceptions.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Transaction/Context.h"
+#include "Transaction/Methods.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+/// @brief evaluate a comparison operator for two values
+bool compare(AstNodeType comparison, VPackSlice left, VPackSlice right,
+             VPackOptions const* options) {
+  // for equality and non-equality we can use a binary comparison
+  bool const compareUtf8 = (comparison != NODE_TYPE_OPERATOR_BINARY_EQ &&
+                            comparison != NODE_TYPE_OPERATOR_BINARY_NE);
+
+  int const compareResult =
+      basics::VelocyPackHelper::compare(left, right, compareUtf8, options);
+
+  switch (comparison) {
+    case NODE_TYPE_OPERATOR_BINARY_EQ:
+      return (compareResult == 0);
+    case NODE_TYPE_OPERATOR_BINARY_NE:
+      return (compareResult != 0);
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+      return (compareResult < 0);
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+      return (compareResult <= 0);
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+      return (compareResult > 0);
+    case NODE_TYPE_OPERATOR_BINARY_GE:
+      return (compareResult >= 0);
+    default:
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                     "invalid comparison in compiled expression");
+  }
+}
+}
+
+CompiledExpression::CompiledExpression() {}
+
+/// @brief compile the expression rooted at the node. returns a nullptr if
+/// the expression cannot be compiled
+std::unique_ptr<CompiledExpression> CompiledExpression::compile(
+    AstNode const* node) {
+  auto compiled = std::make_unique<CompiledExpression>();
+
+  compiled->_constantsBuilder.openArray();
+  if (!compiled->compileNode(node)) {
+    return nullptr;
+  }
+  compiled->_constantsBuilder.close();
+
+  for (auto const& it : VPackArrayIterator(compiled->_constantsBuilder.slice())) {
+    compiled->_constants.emplace_back(it);
+  }
+
+  return compiled;
+}
+
+/// @brief compile a boolean node, returns false if not possible
+bool CompiledExpression::compileNode(AstNode const* node) {
+  switch (node->type) {
+    case NODE_TYPE_OPERATOR_BINARY_EQ:
+    case NODE_TYPE_OPERATOR_BINARY_NE:
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+    case NODE_TYPE_OPERATOR_BINARY_GE: {
+      TRI_ASSERT(node->numMembers() == 2);
+      size_t lhs;
+      size_t rhs;
+      if (!compileOperand(node->getMemberUnchecked(0), lhs) ||
+          !compileOperand(node->getMemberUnchecked(1), rhs)) {
+        return false;
+      }
+      emit(OpCode::COMPARE, node->type, lhs, rhs);
+      return true;
+    }
+
+    case NODE_TYPE_OPERATOR_UNARY_NOT: {
+      TRI_ASSERT(node->numMembers() == 1);
+      if (!compileNode(node->getMemberUnchecked(0))) {
+        return false;
+      }
+      emit(OpCode::NOT);
+      return true;
+    }
+
+    case NODE_TYPE_OPERATOR_BINARY_AND:
+    case NODE_TYPE_OPERATOR_NARY_AND:
+    case NODE_TYPE_OPERATOR_BINARY_OR:
+    case NODE_TYPE_OPERATOR_NARY_OR: {
+      size_t const n = node->numMembers();
+      if (n == 0) {
+        return false;
+      }
+      bool const isAnd = (node->type == NODE_TYPE_OPERATOR_BINARY_AND ||
+                          node->type == NODE_TYPE_OPERATOR_NARY_AND);
+
+      // all members produce booleans, so the result of the operator is the
+      // value of the member that decided it
+      std::vector<size_t> jumps;
+      for (size_t i = 0; i < n; ++i) {
+        if (!compileNode(node->getMemberUnchecked(i))) {
+          return false;
+        }
+        if (i + 1 < n) {
+          jumps.emplace_back(emit(isAnd ? OpCode::JUMP_IF_FALSE : OpCode::JUMP_IF_TRUE));
+        }
+      }
+      for (auto const& it : jumps) {
+        _program[it].target = _program.size();
+      }
+      return true;
+    }
+
+    default: {
+      return false;
+    }
+  }
+}
+
+/// @brief compile an operand of a comparison, returns false if not possible
+bool CompiledExpression::compileOperand(AstNode const* node, size_t& position) {
+  position = _operands.size();
+
+  if (node->isConstant()) {
+    size_t constant = 0;
+    for (auto const& it : _operands) {
+      if (it.variable == nullptr) {
+        ++constant;
+      }
+    }
+    node->toVelocyPackValue(_constantsBuilder);
+    _operands.emplace_back(Operand{nullptr, {}, constant});
+    return true;
+  }
+
+  std::vector<std::string> path;
+  while (node->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+    TRI_ASSERT(node->numMembers() == 1);
+    path.insert(path.begin(), node->getString());
+    node = node->getMemberUnchecked(0);
+  }
+
+  if (node->type != NODE_TYPE_REFERENCE) {
+    return false;
+  }
+
+  auto v = static_cast<Variable const*>(node->getData());
+  _operands.emplace_back(Operand{v, std::move(path), 0});
+  return true;
+}
+
+/// @brief emit an instruction and return its position
+size_t CompiledExpression::emit(OpCode opCode, AstNodeType comparison,
+                                size_t lhs, size_t rhs) {
+  _program.emplace_back(Instruction{opCode, comparison, lhs, rhs, 0});
+  return _program.size() - 1;
+}
+
+/// @brief resolve an operand against the current row
+VPackSlice CompiledExpression::resolve(Operand const& operand,
+                                       transaction::Methods* trx,
+                                       ExpressionContext* ctx,
+                                       AqlValueMaterializer& materializer,
+                                       AqlValue& id) const {
+  if (operand.variable == nullptr) {
+    return _constants[operand.constant];
+  }
+
+  bool mustDestroy;
+  AqlValue value = ctx->getVariableValue(operand.variable, false, mustDestroy);
+  VPackSlice s = materializer.slice(value, false);
+
+  if (mustDestroy) {
+    if (materializer.hasCopied) {
+      value.destroy();
+    } else {
+      // the materializer refers to the value itself, so it takes it over
+      materializer.hasCopied = true;
+    }
+  }
+
+  size_t const n = operand.path.size();
+  for (size_t i = 0; i < n; ++i) {
+    if (!s.isObject()) {
+      return VPackSlice::nullSlice();
+    }
+    VPackSlice found = s.get(operand.path[i]);
+    if (found.isCustom()) {
+      if (i + 1 < n) {
+        // the _id value is a string, which has no attributes
+        return VPackSlice::nullSlice();
+      }
+      // _id needs special treatment
+      id = AqlValue(trx->extractIdString(s));
+      return id.slice();
+    }
+    if (found.isNone()) {
+      return VPackSlice::nullSlice();
+    }
+    s = found;
+  }
+  return s;
+}
+
+/// @brief run the program, using the callback to evaluate comparisons
+template <typename F>
+bool CompiledExpression::run(F const& compare) const {
+  bool result = false;
+  size_t pc = 0;
+  size_t const n = _program.size();
+
+  while (pc < n) {
+    Instruction const& instruction = _program[pc];
+
+    switch (instruction.opCode) {
+      case OpCode::COMPARE: {
+        result = compare(instruction);
+        ++pc;
+        break;
+      }
+
+      case OpCode::NOT: {
+        result = !result;
+        ++pc;
+        break;
+      }
+
+      case OpCode::JUMP_IF_FALSE: {
+        pc = result ? pc + 1 : instruction.target;
+        break;
+      }
+
+      case OpCode::JUMP_IF_TRUE: {
+        pc = result ? instruction.target : pc + 1;
+        break;
+      }
+    }
+  }
+
+  return result;
+}
+
+/// @brief execute the program, the result is always a boolean
+AqlValue CompiledExpression::execute(transaction::Methods* trx,
+                                     ExpressionContext* ctx) const {
+  VPackOptions const* options = trx->transactionContextPtr()->getVPackOptions();
+
+  bool const result = run([&](Instruction const& instruction) -> bool {
+    AqlValueMaterializer leftMaterializer(trx);
+    AqlValueMaterializer rightMaterializer(trx);
+    AqlValue leftId;
+    AqlValueGuard leftGuard(leftId, true);
+    AqlValue rightId;
+    AqlValueGuard rightGuard(rightId, true);
+
+    VPackSlice left = resolve(_operands[instruction.lhs], trx, ctx,
+                              leftMaterializer, leftId);
+    VPackSlice right = resolve(_operands[instruction.rhs], trx, ctx,
+                               rightMaterializer, rightId);
+
+    return ::compare(instruction.comparison, left, right, options);
+  });
+
+  return AqlValue(AqlValueHintBool(result));
+}
+
+/// @brief prepare the columns of the extractor for the registers
+void CompiledExpression::prepareColumns(
+    std::vector<Variable const*> const& vars,
+    std::vector<RegisterId> const& regs) {
+  TRI_ASSERT(vars.size() == regs.size());
+
+  if (regs == _extractorRegs && _columns.size() == _operands.size()) {
+    return;
+  }
+
+  _extractor.clearColumns();
+  _columns.clear();
+
+  for (auto const& operand : _operands) {
+    size_t column = 0;
+    if (operand.variable != nullptr) {
+      auto it = std::find(vars.begin(), vars.end(), operand.variable);
+      if (it == vars.end()) {
+        THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                       "variable not found");
+      }
+      column = _extractor.addColumn(regs[it - vars.begin()], operand.path);
+    }
+    _columns.emplace_back(column);
+  }
+  _extractorRegs = regs;
+}
+
+/// @brief execute the program for all rows of a block and write the
+/// results into the output register
+void CompiledExpression::executeBlock(transaction::Methods* trx,
+                                      AqlItemBlock* block,
+                                      std::vector<Variable const*> const& vars,
+                                      std::vector<RegisterId> const& regs,
+                                      RegisterId outReg) {
+  VPackOptions const* options = trx->transactionContextPtr()->getVPackOptions();
+
+  prepareColumns(vars, regs);
+  _extractor.extract(trx, block);
+
+  size_t const n = block->size();
+  for (size_t row = 0; row < n; ++row) {
+    bool const result = run([&](Instruction const& instruction) -> bool {
+      return ::compare(instruction.comparison,
+                       operandValue(instruction.lhs, row),
+                       operandValue(instruction.rhs, row), options);
+    });
+    block->emplaceValue(row, outReg, AqlValueHintBool(result));
+  }
+}
@@ -0,0 +1,160 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_COMPILED_EXPRESSION_H
+#define ARANGOD_AQL_COMPILED_EXPRESSION_H 1
+
+#include "Basics/Common.h"
+#include "Aql/AqlValue.h"
+#include "Aql/AstNode.h"
+#include "Aql/AttributeExtractor.h"
+#include "Aql/types.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+namespace transaction {
+class Methods;
+}
+
+namespace aql {
+class AqlItemBlock;
+class ExpressionContext;
+struct Variable;
+
+/// @brief a boolean expression flattened into a linear program. supported
+/// are comparisons (==, !=, <, <=, >, >=) between constants, variables and
+/// attributes of variables, combined with &&, || and !. as all parts of
+/// such an expression produce booleans, the program only needs a single
+/// boolean accumulator and short-circuits && and || via jumps, so that it
+/// can be evaluated in a loop without recursion and without intermediate
+/// AqlValues. for whole blocks, the values of all operands are extracted
+/// column-wise before the program runs for each row
+class CompiledExpression {
+ public:
+  CompiledExpression(CompiledExpression const&) = delete;
+  CompiledExpression& operator=(CompiledExpression const&) = delete;
+
+  CompiledExpression();
+  ~CompiledExpression() = default;
+
+  /// @brief compile the expression rooted at the node. returns a nullptr if
+  /// the expression cannot be compiled
+  static std::unique_ptr<CompiledExpression> compile(AstNode const* node);
+
+  /// @brief execute the program, the result is always a boolean
+  AqlValue execute(transaction::Methods* trx, ExpressionContext* ctx) const;
+
+  /// @brief execute the program for all rows of a block and write the
+  /// results into the output register. vars and regs map the variables of
+  /// the expression to the registers of the block
+  void executeBlock(transaction::Methods* trx, AqlItemBlock* block,
+                    std::vector<Variable const*> const& vars,
+                    std::vector<RegisterId> const& regs, RegisterId outReg);
+
+ private:
+  /// @brief an operand of a comparison
+  struct Operand {
+    /// @brief the variable, nullptr for constants
+    Variable const* variable;
+    /// @brief the accessed attribute path below the variable, may be empty
+    std::vector<std::string> path;
+    /// @brief position of the constant value in _constants
+    size_t constant;
+  };
+
+  enum class OpCode : uint8_t {
+    COMPARE,
+    NOT,
+    JUMP_IF_FALSE,
+    JUMP_IF_TRUE
+  };
+
+  struct Instruction {
+    OpCode opCode;
+    /// @brief comparison operator, for COMPARE
+    AstNodeType comparison;
+    /// @brief operand positions, for COMPARE
+    size_t lhs;
+    size_t rhs;
+    /// @brief jump target, for JUMP_IF_FALSE and JUMP_IF_TRUE
+    size_t target;
+  };
+
+  /// @brief compile a boolean node, returns false if not possible
+  bool compileNode(AstNode const* node);
+
+  /// @brief compile an operand of a comparison, returns false if not possible
+  bool compileOperand(AstNode const* node, size_t& position);
+
+  /// @brief emit an instruction and return its position
+  size_t emit(OpCode opCode, AstNodeType comparison = NODE_TYPE_ROOT,
+              size_t lhs = 0, size_t rhs = 0);
+
+  /// @brief prepare the columns of the extractor for the registers
+  void prepareColumns(std::vector<Variable const*> const& vars,
+                      std::vector<RegisterId> const& regs);
+
+  /// @brief run the program, using the callback to evaluate comparisons
+  template <typename F>
+  bool run(F const& compare) const;
+
+  /// @brief the value of an operand in a row of the extracted block
+  arangodb::velocypack::Slice operandValue(size_t operand, size_t row) const {
+    if (_operands[operand].variable == nullptr) {
+      return _constants[_operands[operand].constant];
+    }
+    return _extractor.value(row, _columns[operand]);
+  }
+
+  /// @brief resolve an operand against the current row
+  arangodb::velocypack::Slice resolve(Operand const& operand,
+                                      transaction::Methods* trx,
+                                      ExpressionContext* ctx,
+                                      AqlValueMaterializer& materializer,
+                                      AqlValue& id) const;
+
+ private:
+  std::vector<Instruction> _program;
+
+  std::vector<Operand> _operands;
+
+  /// @brief the values of all constant operands, as an array
+  arangodb::velocypack::Builder _constantsBuilder;
+
+  /// @brief the values of all constant operands, pointing into
+  /// _constantsBuilder
+  std::vector<arangodb::velocypack::Slice> _constants;
+
+  /// @brief extractor for the operands of whole blocks
+  AttributeExtractor _extractor;
+
+  /// @brief the registers the extractor columns were prepared for
+  std::vector<RegisterId> _extractorRegs;
+
+  /// @brief extractor column of each operand, unused for constants
+  std::vector<size_t> _columns;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
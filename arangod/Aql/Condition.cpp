@@ -111,6 +111,34 @@ struct PermutationState {
   size_t const n;
 };
 
+/// @brief maximum number of indexes whose results are intersected with the
+/// results of the index used for a condition
+constexpr size_t maxIntersectionIndexes = 2;
+
+/// @brief maximum number of documents an intersection index may produce, as
+/// all of them are held in memory
+constexpr size_t maxIntersectionItems = 1000000;
+
+/// @brief whether or not a part of a condition can be looked up in an
+/// intersection index. this requires a comparison of the variable's
+/// attributes with constant values only, as the values of the intersection
+/// conditions are not recalculated for each input row
+bool isIntersectable(arangodb::aql::AstNode const* node,
+                     arangodb::aql::Variable const* reference) {
+  if (!node->isComparisonOperator() || node->numMembers() != 2 ||
+      !node->isDeterministic()) {
+    return false;
+  }
+  if (!node->getMemberUnchecked(0)->isConstant() &&
+      !node->getMemberUnchecked(1)->isConstant()) {
+    return false;
+  }
+
+  std::unordered_set<arangodb::aql::Variable const*> variables;
+  arangodb::aql::Ast::getReferencedVariables(node, variables);
+  return (variables.size() == 1 && *variables.begin() == reference);
+}
+
 } //namespace
 
 //        |         | a == y | a != y | a <  y | a <= y | a >= y | a > y
@@ -486,6 +514,108 @@ std::pair<bool, bool> Condition::findIndexes(
       usedIndexes, _isSorted);
 }
 
+/// @brief locate further indexes for the members of a single AND condition
+/// which are not covered by the index found for it. the results of these
+/// indexes can be intersected with the results of the index. returns an
+/// n-ary OR with one n-ary AND per intersection index, or a nullptr
+AstNode* Condition::findIntersectionIndexes(
+    EnumerateCollectionNode const* node, std::vector<AstNode*> const& members,
+    std::vector<transaction::Methods::IndexHandle> const& usedIndexes,
+    std::vector<transaction::Methods::IndexHandle>& intersectionIndexes) {
+  TRI_ASSERT(intersectionIndexes.empty());
+
+  if (_root == nullptr || _root->numMembers() != 1 || usedIndexes.size() != 1) {
+    // the results of ORs are already combined from multiple indexes
+    return nullptr;
+  }
+
+  Variable const* reference = node->outVariable();
+  std::string const& collectionName = node->collection()->name();
+  transaction::Methods* trx = _ast->query()->trx();
+  size_t const itemsInCollection = node->collection()->count(trx);
+
+  if (itemsInCollection == 0) {
+    return nullptr;
+  }
+
+  AstNode const* used = _root->getMemberUnchecked(0);
+  size_t estimatedItems;
+  double estimatedCost;
+  if (!trx->supportsFilterCondition(usedIndexes[0], used, reference,
+                                    itemsInCollection, estimatedItems,
+                                    estimatedCost)) {
+    return nullptr;
+  }
+
+  // number of documents that need to be fetched and filtered
+  double documents = static_cast<double>(estimatedItems);
+
+  std::vector<AstNode*> rest;
+  for (auto const& it : members) {
+    bool covered = false;
+    for (size_t i = 0; i < used->numMembers(); ++i) {
+      if (used->getMemberUnchecked(i) == it) {
+        covered = true;
+        break;
+      }
+    }
+    if (!covered && ::isIntersectable(it, reference)) {
+      rest.emplace_back(it);
+    }
+  }
+
+  std::unordered_set<arangodb::Index const*> seen{usedIndexes[0].getIndex().get()};
+  AstNode* result = nullptr;
+
+  while (!rest.empty() && intersectionIndexes.size() < ::maxIntersectionIndexes) {
+    AstNode* candidate = _ast->createNodeNaryOperator(NODE_TYPE_OPERATOR_NARY_AND);
+    for (auto const& it : rest) {
+      candidate->addMember(it);
+    }
+
+    // this will specialize the candidate condition for the index
+    transaction::Methods::IndexHandle handle;
+    if (!trx->getBestIndexHandleForFilterCondition(
+            collectionName, candidate, reference, itemsInCollection, handle) ||
+        seen.find(handle.getIndex().get()) != seen.end() ||
+        !trx->supportsFilterCondition(handle, candidate, reference,
+                                      itemsInCollection, estimatedItems,
+                                      estimatedCost)) {
+      break;
+    }
+
+    double const remaining =
+        documents * static_cast<double>(estimatedItems) /
+        static_cast<double>(itemsInCollection);
+
+    // the intersection index is read completely and its results are sorted.
+    // this must be clearly cheaper than fetching and filtering the documents
+    // it rules out
+    if (estimatedItems > ::maxIntersectionItems ||
+        estimatedCost + static_cast<double>(estimatedItems) >=
+            0.5 * (documents - remaining)) {
+      break;
+    }
+
+    for (size_t i = 0; i < candidate->numMembers(); ++i) {
+      auto it = std::find(rest.begin(), rest.end(), candidate->getMemberUnchecked(i));
+      if (it != rest.end()) {
+        rest.erase(it);
+      }
+    }
+
+    if (result == nullptr) {
+      result = _ast->createNodeNaryOperator(NODE_TYPE_OPERATOR_NARY_OR);
+    }
+    result->addMember(candidate);
+    intersectionIndexes.emplace_back(handle);
+    seen.emplace(handle.getIndex().get());
+    documents = remaining;
+  }
+
+  return result;
+}
+
 /// @brief get the attributes for a sub-condition that are const
 /// (i.e. compared with equality)
 std::vector<std::vector<arangodb::basics::AttributeName>>
@@ -243,6 +243,15 @@ class Condition {
                                     std::vector<transaction::Methods::IndexHandle>&,
                                     SortCondition const*);
 
+  /// @brief locate further indexes for the members of a single AND condition
+  /// which are not covered by the index found for it. the results of these
+  /// indexes can be intersected with the results of the index. returns an
+  /// n-ary OR with one n-ary AND per intersection index, or a nullptr
+  AstNode* findIntersectionIndexes(EnumerateCollectionNode const*,
+                                   std::vector<AstNode*> const&,
+                                   std::vector<transaction::Methods::IndexHandle> const&,
+                                   std::vector<transaction::Methods::IndexHandle>&);
+
   /// @brief get the attributes for a sub-condition that are const
   /// (i.e. compared with equality)
   std::vector<std::vector<arangodb::basics::AttributeName>> getConstAttributes (Variable const*, bool);
@@ -122,6 +122,16 @@ bool ConditionFinder::before(ExecutionNode* en) {
         break;
       }
 
+      // the members of a single AND condition, before the condition is
+      // specialized for the index that is found for it
+      std::vector<AstNode*> members;
+      if (condition->root() != nullptr && condition->root()->numMembers() == 1) {
+        auto andNode = condition->root()->getMemberUnchecked(0);
+        for (size_t i = 0; i < andNode->numMembers(); ++i) {
+          members.emplace_back(andNode->getMemberUnchecked(i));
+        }
+      }
+
       std::vector<transaction::Methods::IndexHandle> usedIndexes;
       auto canUseIndex =
           condition->findIndexes(node, usedIndexes, sortCondition.get());
@@ -142,13 +152,25 @@ bool ConditionFinder::before(ExecutionNode* en) {
 
         TRI_ASSERT(!usedIndexes.empty());
 
+        // look for indexes for the remaining parts of the condition, whose
+        // results can be intersected with the results of the index
+        std::vector<transaction::Methods::IndexHandle> intersectionIndexes;
+        AstNode* intersectionCondition = nullptr;
+        if (canUseIndex.first && members.size() > 1) {
+          intersectionCondition = condition->findIntersectionIndexes(
+              node, members, usedIndexes, intersectionIndexes);
+        }
+
         // We either can find indexes for everything or findIndexes
         // will clear out usedIndexes
         IndexIteratorOptions opts;
         opts.ascending = !descending;
-        std::unique_ptr<ExecutionNode> newNode(new IndexNode(
+        std::unique_ptr<IndexNode> newNode(new IndexNode(
             _plan, _plan->nextId(), node->collection(),
             node->outVariable(), usedIndexes, std::move(condition), opts));
+        if (intersectionCondition != nullptr) {
+          newNode->setIntersection(intersectionIndexes, intersectionCondition);
+        }
         TRI_IF_FAILURE("ConditionFinder::insertIndexNode") {
           THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
         }
@@ -33,6 +33,7 @@
 #include "Aql/Query.h"
 #include "Aql/QueryRegistry.h"
 #include "Basics/Result.h"
+#include "Basics/ScopeGuard.h"
 #include "Cluster/ClusterComm.h"
 #include "Cluster/ServerState.h"
 #include "Cluster/TraverserEngineRegistry.h"
@@ -74,6 +75,28 @@ Result ExtractRemoteAndShard(VPackSlice keySlice, size_t& remoteId, std::string&
   return {TRI_ERROR_NO_ERROR};
 }
 
+Collection* collectionOfNode(ExecutionNode const* node) {
+  Collection const* col = nullptr;
+  switch (node->getType()) {
+    case ExecutionNode::ENUMERATE_COLLECTION:
+      col = ExecutionNode::castTo<EnumerateCollectionNode const*>(node)->collection();
+      break;
+    case ExecutionNode::INDEX:
+      col = ExecutionNode::castTo<IndexNode const*>(node)->collection();
+      break;
+    case ExecutionNode::INSERT:
+    case ExecutionNode::UPDATE:
+    case ExecutionNode::REMOVE:
+    case ExecutionNode::REPLACE:
+    case ExecutionNode::UPSERT:
+      col = ExecutionNode::castTo<ModificationNode const*>(node)->collection();
+      break;
+    default:
+      break;
+  }
+  return const_cast<Collection*>(col);
+}
+
 ScatterNode* findFirstScatter(ExecutionNode const& root) {
   ExecutionNode* node = root.getFirstDependency();
 
@@ -300,6 +323,29 @@ void EngineInfoContainerDBServer::EngineInfo::serializeSnippet(
 
   _collection->setCurrentShard(id);
 
+  // a query moved to a single server entirely (optimize-cluster-single-shard)
+  // has one snippet accessing several collections of one shard each. they
+  // are translated to their shards as well
+  std::vector<Collection*> otherCollections;
+  auto resetGuard = scopeGuard([this, &otherCollections]() {
+    _collection->resetCurrentShard();
+    for (auto* col : otherCollections) {
+      col->resetCurrentShard();
+    }
+  });
+
+  for (auto const* node : _nodes) {
+    Collection* col = collectionOfNode(node);
+    if (col != nullptr && col != _collection && col->numberOfShards() == 1 &&
+        std::find(otherCollections.begin(), otherCollections.end(), col) ==
+            otherCollections.end()) {
+      auto shards = col->shardIds();
+      TRI_ASSERT(shards->size() == 1);
+      col->setCurrentShard(shards->front());
+      otherCollections.emplace_back(col);
+    }
+  }
+
   ExecutionPlan plan(query.ast());
   ExecutionNode* previous = nullptr;
 
@@ -340,7 +386,6 @@ void EngineInfoContainerDBServer::EngineInfo::serializeSnippet(
   plan.setVarUsageComputed();
   const unsigned flags = ExecutionNode::SERIALIZE_DETAILS;
   plan.root()->toVelocyPack(infoBuilder, flags, /*keepTopLevelOpen*/false);
-  _collection->resetCurrentShard();
 }
 
 void EngineInfoContainerDBServer::CollectionInfo::mergeShards(std::shared_ptr<std::vector<ShardID>> const& shards) {
@@ -46,8 +46,13 @@ EnumerateCollectionBlock::EnumerateCollectionBlock(
       _cursor(
           _trx->indexScan(_collection->name(),
                           (ep->_random ? transaction::Methods::CursorType::ANY
-                                       : transaction::Methods::CursorType::ALL))),
-      _inflight(0) {
+                           : ep->_fullScan
+                               ? transaction::Methods::CursorType::SCAN
+                               : transaction::Methods::CursorType::ALL))),
+      _inflight(0),
+      _skipByCount(!ep->_random &&
+                   !ServerState::instance()->isCoordinator()),
+      _cursorFresh(true) {
   TRI_ASSERT(_cursor->ok());
 
   buildCallback();
@@ -102,6 +107,7 @@ std::pair<ExecutionState, arangodb::Result> EnumerateCollectionBlock::initialize
 
   DEBUG_BEGIN_BLOCK();
   _cursor->reset();
+  _cursorFresh = true;
   DEBUG_END_BLOCK();
 
   return res;
@@ -135,7 +141,7 @@ EnumerateCollectionBlock::getSome(size_t atMost) {
   std::unique_ptr<AqlItemBlock> res;
 
   do {
-    size_t toFetch = (std::min)(DefaultBatchSize(), atMost);
+    size_t toFetch = (std::min)(upstreamBatchSize(), atMost);
     BufferState bufferState = getBlockIfNeeded(toFetch);
     if (bufferState == BufferState::WAITING) {
       return {ExecutionState::WAITING, nullptr};
@@ -170,6 +176,7 @@ EnumerateCollectionBlock::getSome(size_t atMost) {
       }
 
       bool cursorHasMore;
+      _cursorFresh = false;
       if (produceResult()) {
         // properly build up results by fetching the actual documents
         // using nextDocument()
@@ -198,6 +205,7 @@ EnumerateCollectionBlock::getSome(size_t atMost) {
       // we have exhausted this cursor
       // re-initialize fetching of documents
       _cursor->reset();
+      _cursorFresh = true;
       AqlItemBlock* removedBlock = advanceCursor(1, 0);
       returnBlockUnlessNull(removedBlock);
     }
@@ -232,9 +240,12 @@ std::pair<ExecutionState, size_t> EnumerateCollectionBlock::skipSome(size_t atMo
 
   TRI_ASSERT(_cursor != nullptr);
 
+  // documents counted from the collection instead of scanned
+  size_t counted = 0;
+
   while (_inflight < atMost) {
     if (_buffer.empty()) {
-      size_t toFetch = (std::min)(DefaultBatchSize(), atMost - _inflight);
+      size_t toFetch = (std::min)(upstreamBatchSize(), atMost - _inflight);
       auto upstreamRes = getBlock(toFetch);
       if (upstreamRes.first == ExecutionState::WAITING) {
         return {ExecutionState::WAITING, 0};
@@ -248,22 +259,36 @@ std::pair<ExecutionState, size_t> EnumerateCollectionBlock::skipSome(size_t atMo
       }
       _pos = 0;  // this is in the first block
       _cursor->reset();
+      _cursorFresh = true;
     }
 
     // if we get here, then _buffer.front() exists
     AqlItemBlock* cur = _buffer.front();
     uint64_t skippedHere = 0;
+    bool rowDone = false;
+
+    if (_skipByCount && _cursorFresh) {
+      // the whole collection for this row, without touching a document
+      uint64_t const n = _collection->getCollection()->numberDocuments(_trx);
+      if (n <= atMost - _inflight) {
+        skippedHere = n;
+        counted += static_cast<size_t>(n);
+        rowDone = true;
+      }
+    }
 
-    if (_cursor->hasMore()) {
+    if (!rowDone && _cursor->hasMore()) {
+      _cursorFresh = false;
       _cursor->skip(atMost - _inflight, skippedHere);
     }
 
     _inflight += skippedHere;
 
-    if (_inflight < atMost) {
-      TRI_ASSERT(!_cursor->hasMore());
+    if (rowDone || _inflight < atMost) {
+      TRI_ASSERT(rowDone || !_cursor->hasMore());
       // not skipped enough re-initialize fetching of documents
       _cursor->reset();
+      _cursorFresh = true;
       if (++_pos >= cur->size()) {
         _buffer.pop_front();  // does not throw
         returnBlock(cur);
@@ -272,7 +297,7 @@ std::pair<ExecutionState, size_t> EnumerateCollectionBlock::skipSome(size_t atMo
     }
   }
 
-  _engine->_stats.scannedFull += static_cast<int64_t>(_inflight);
+  _engine->_stats.scannedFull += static_cast<int64_t>(_inflight - counted);
   size_t skipped = _inflight;
   _inflight = 0;
   return {getHasMoreState(), skipped};
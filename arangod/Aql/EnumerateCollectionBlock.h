@@ -69,6 +69,13 @@ class EnumerateCollectionBlock final : public ExecutionBlock, public DocumentPro
   /// @brief Persistent counter of elements that are in flight during WAITING
   ///        has to be resetted as soon as we return with DONE/HASMORE
   size_t _inflight;
+
+  /// @brief whether skipSome may take the number of documents of the
+  ///        collection instead of skipping them with the cursor
+  bool const _skipByCount;
+
+  /// @brief whether the cursor was reset and not used since
+  bool _cursorFresh;
 };
 
 }  // namespace arangodb::aql
@@ -90,6 +90,8 @@ std::unordered_map<std::string, arangodb::aql::ExecutionBlock::Type> const Names
   { "UpsertBlock",                 arangodb::aql::ExecutionBlock::Type::UPSERT},
   { "ScatterBlock",                arangodb::aql::ExecutionBlock::Type::SCATTER},
   { "DistributeBlock",             arangodb::aql::ExecutionBlock::Type::DISTRIBUTE},
+  { "HashJoinBlock",               arangodb::aql::ExecutionBlock::Type::HASH_JOIN},
+  { "MaterializeBlock",            arangodb::aql::ExecutionBlock::Type::MATERIALIZE},
 #ifdef USE_IRESEARCH
   { "IResearchViewBlock",          arangodb::aql::ExecutionBlock::Type::IRESEARCH_VIEW},
   { "IResearchViewOrderedBlock",   arangodb::aql::ExecutionBlock::Type::IRESEARCH_VIEW_ORDERED},
@@ -128,10 +130,26 @@ ExecutionBlock::ExecutionBlock(ExecutionEngine* engine, ExecutionNode const* ep)
       _done(false),
       _profile(engine->getQuery()->queryOptions().profile),
       _getSomeBegin(0),
+      _scannedIndexBegin(0),
+      _scannedFullBegin(0),
       _upstreamState(ExecutionState::HASMORE),
       _skipped(0),
-      _collector(&engine->_itemBlockManager) {
+      _collector(&engine->_itemBlockManager),
+      _batchSize(DefaultBatchSize()),
+      _batchBytes(engine->getQuery()->queryOptions().batchBytes),
+      _minBatchSize(engine->getQuery()->queryOptions().minBatchSize),
+      _maxBatchSize(engine->getQuery()->queryOptions().maxBatchSize),
+      _rowsProduced(0),
+      _bytesProduced(0) {
   TRI_ASSERT(_trx != nullptr);
+
+  if (ep != nullptr && ep->getType() == ExecutionNode::REMOTE) {
+    // we fetch results from another server
+    sendsToRemote();
+  }
+  if (_batchBytes > 0) {
+    _batchSize = (std::max)(_minBatchSize, (std::min)(_batchSize, _maxBatchSize));
+  }
 }
 
 ExecutionBlock::~ExecutionBlock() {
@@ -255,6 +273,12 @@ std::pair<ExecutionState, Result> ExecutionBlock::shutdown(int errorCode) {
 void ExecutionBlock::traceGetSomeBegin(size_t atMost) {
   if (_profile >= PROFILE_LEVEL_BLOCKS) {
     _getSomeBegin = TRI_microtime();
+    // our dependencies report into a fresh set of totals, ours are restored
+    // and extended when getSome ends
+    _profileCaller = _engine->_profileDependencies;
+    _engine->_profileDependencies = ProfileTotals();
+    _scannedIndexBegin = _engine->_stats.scannedIndex;
+    _scannedFullBegin = _engine->_stats.scannedFull;
     if (_profile >= PROFILE_LEVEL_TRACE_1) {
       auto node = getPlanNode();
       LOG_TOPIC(INFO, Logger::QUERIES)
@@ -266,15 +290,53 @@ void ExecutionBlock::traceGetSomeBegin(size_t atMost) {
 }
 
 // Trace the end of a getSome call, potentially with result
-void ExecutionBlock::traceGetSomeEnd(AqlItemBlock const* result, ExecutionState state) const {
+void ExecutionBlock::sendsToRemote() {
+  _maxBatchSize = (std::max)(_maxBatchSize,
+                             _engine->getQuery()->queryOptions().maxRemoteBatchSize);
+}
+
+void ExecutionBlock::adaptBatchSize(AqlItemBlock const& result) {
+  _rowsProduced += result.size();
+  _bytesProduced += result.memoryUsage();
+  if (_rowsProduced == 0) {
+    return;
+  }
+
+  size_t const bytesPerRow = (std::max)(static_cast<size_t>(1), _bytesProduced / _rowsProduced);
+  _batchSize = (std::max)(_minBatchSize, (std::min)(_batchBytes / bytesPerRow, _maxBatchSize));
+}
+
+void ExecutionBlock::traceGetSomeEnd(AqlItemBlock const* result, ExecutionState state) {
   TRI_ASSERT(result != nullptr || state != ExecutionState::HASMORE);
+  if (result != nullptr && _batchBytes > 0) {
+    adaptBatchSize(*result);
+  }
   if (_profile >= PROFILE_LEVEL_BLOCKS) {
     ExecutionNode const* en = getPlanNode();
+    ProfileTotals const& dependencies = _engine->_profileDependencies;
+    int64_t const scannedIndex = _engine->_stats.scannedIndex - _scannedIndexBegin;
+    int64_t const scannedFull = _engine->_stats.scannedFull - _scannedFullBegin;
+
     ExecutionStats::Node stats;
     stats.calls = 1;
     stats.items = result != nullptr ? result->size() : 0;
+    stats.itemsIn = dependencies.items;
     stats.runtime = TRI_microtime() - _getSomeBegin;
+    stats.selfRuntime = (std::max)(0.0, stats.runtime - dependencies.runtime);
+    stats.scannedIndex = scannedIndex - dependencies.scannedIndex;
+    stats.scannedFull = scannedFull - dependencies.scannedFull;
+    stats.peakMemory =
+        _engine->getQuery()->resourceMonitor()->currentResources.memoryUsage;
     stats.type = getType();
+
+    // report our inclusive totals to our caller. documents scanned are
+    // counted by the whole query, so all of them count for the caller
+    _profileCaller.items += stats.items;
+    _profileCaller.runtime += stats.runtime;
+    _profileCaller.scannedIndex += scannedIndex;
+    _profileCaller.scannedFull += scannedFull;
+    _engine->_profileDependencies = _profileCaller;
+
     auto it = _engine->_stats.nodes.find(en->id());
     if (it != _engine->_stats.nodes.end()) {
       it->second += stats;
@@ -111,6 +111,8 @@ class ExecutionBlock {
     UPSERT,
     SCATTER,
     DISTRIBUTE,
+    HASH_JOIN,
+    MATERIALIZE,
 #ifdef USE_IRESEARCH
     IRESEARCH_VIEW,
     IRESEARCH_VIEW_ORDERED,
@@ -127,10 +129,28 @@ class ExecutionBlock {
   static std::string typeToString(Type type);
   static Type typeFromString(std::string const& type);
 
+  /// @brief totals of profiled getSome calls, used to tell the figures of a
+  /// block from those of its dependencies
+  struct ProfileTotals {
+    size_t items = 0;
+    double runtime = 0;
+    int64_t scannedIndex = 0;
+    int64_t scannedFull = 0;
+  };
+
  public:
   /// @brief batch size value
   static constexpr inline size_t DefaultBatchSize() { return 1000; }
 
+  /// @brief number of rows to request from this block in one go. adapts to
+  /// the width of the rows the block produced so far, so that a batch takes
+  /// about QueryOptions::batchBytes
+  size_t batchSize() const { return _batchSize; }
+
+  /// @brief the block sends its results to another server, which allows
+  /// larger batches to save round trips
+  void sendsToRemote();
+
   /// @brief returns the register id for a variable id
   /// will return ExecutionNode::MaxRegisterId for an unknown variable
   RegisterId getRegister(VariableId id) const;
@@ -185,7 +205,7 @@ class ExecutionBlock {
       size_t atMost);
 
   void traceGetSomeBegin(size_t atMost);
-  void traceGetSomeEnd(AqlItemBlock const*, ExecutionState state) const;
+  void traceGetSomeEnd(AqlItemBlock const*, ExecutionState state);
  
   /// @brief skipSome, skips some more items, semantic is as follows: not
   /// more than atMost items may be skipped. The method tries to
@@ -231,6 +251,12 @@ class ExecutionBlock {
   void inheritRegisters(AqlItemBlock const* src, AqlItemBlock* dst, size_t,
                         size_t);
 
+  /// @brief number of rows to request from the first dependency in one go
+  size_t upstreamBatchSize() const {
+    return _dependencies.empty() ? DefaultBatchSize()
+                                 : _dependencies[0]->batchSize();
+  }
+
   /// @brief the following is internal to pull one more block and append it to
   /// our _buffer deque. Returns true if a new block was appended and false if
   /// the dependent node is exhausted.
@@ -328,6 +354,14 @@ class ExecutionBlock {
   /// @brief getSome begin point in time
   double _getSomeBegin;
 
+  /// @brief the dependency totals of our caller, saved while our own
+  /// dependencies are profiled
+  ProfileTotals _profileCaller;
+
+  /// @brief documents scanned by the whole query when getSome began
+  int64_t _scannedIndexBegin;
+  int64_t _scannedFullBegin;
+
   /// @brief the execution state of the dependency
   ///        used to determine HASMORE or DONE better
   ExecutionState _upstreamState;
@@ -343,7 +377,19 @@ class ExecutionBlock {
   /// be a member variable due to possible WAITING interruptions.
   aql::BlockCollector _collector;
 
+ private:
+  /// @brief adapts the batch size to the width of the rows in a result
+  void adaptBatchSize(AqlItemBlock const& result);
+
+  /// @brief the current batch size and its limits, see QueryOptions
+  size_t _batchSize;
+  size_t const _batchBytes;
+  size_t const _minBatchSize;
+  size_t _maxBatchSize;
 
+  /// @brief rows and bytes of the results produced so far
+  size_t _rowsProduced;
+  size_t _bytesProduced;
 };
 
 }  // namespace arangodb::aql
@@ -173,7 +173,10 @@ Result ExecutionEngine::createBlocks(
 /// @brief create the engine
 ExecutionEngine::ExecutionEngine(Query* query)
     : _stats(),
-      _itemBlockManager(query->resourceMonitor()),
+      _itemBlockManager(query->resourceMonitor(),
+                        query->queryOptions().columnarBlocks
+                            ? ItemBlockLayout::COLUMN_MAJOR
+                            : ItemBlockLayout::ROW_MAJOR),
       _blocks(),
       _root(nullptr),
       _query(query),
@@ -452,6 +455,7 @@ struct CoordinatorInstanciator final : public WalkerWorker<ExecutionNode> {
 };
 
 std::pair<ExecutionState, Result> ExecutionEngine::initializeCursor(AqlItemBlock* items, size_t pos) {
+  QueryCounters::Scope counters(&_stats.counters);
   auto res = _root->initializeCursor(items, pos);
   if (res.first == ExecutionState::WAITING) {
     return res;
@@ -461,6 +465,7 @@ std::pair<ExecutionState, Result> ExecutionEngine::initializeCursor(AqlItemBlock
 }
 
 std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> ExecutionEngine::getSome(size_t atMost) {
+  QueryCounters::Scope counters(&_stats.counters);
   if (!_initializeCursorCalled) {
     auto res = initializeCursor(nullptr, 0);
     if (res.first == ExecutionState::WAITING) {
@@ -471,6 +476,7 @@ std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> ExecutionEngine::getSom
 }
 
 std::pair<ExecutionState, size_t> ExecutionEngine::skipSome(size_t atMost) {
+  QueryCounters::Scope counters(&_stats.counters);
   if (!_initializeCursorCalled) {
     auto res = initializeCursor(nullptr, 0);
     if (res.first == ExecutionState::WAITING) {
@@ -502,6 +508,7 @@ std::pair<ExecutionState, Result> ExecutionEngine::shutdown(int errorCode) {
   ExecutionState state = ExecutionState::DONE;
   Result res;
   if (_root != nullptr && !_wasShutdown) {
+    QueryCounters::Scope counters(&_stats.counters);
     std::tie(state, res) = _root->shutdown(errorCode);
     if (state == ExecutionState::WAITING) {
       return {state, res};
@@ -589,6 +596,11 @@ ExecutionEngine* ExecutionEngine::instantiateFromPlan(
         dynamic_cast<ReturnBlock*>(root)->returnInheritedResults());
     }
 
+    if (isDBServer) {
+      // the results of the root block are sent to the coordinator
+      root->sendsToRemote();
+    }
+
     engine->_root = root;
 
     return engine;
@@ -107,6 +107,11 @@ class ExecutionEngine {
   /// note that the statistics are modification by execution blocks
   ExecutionStats _stats;
 
+  /// @brief totals of the getSome calls that the dependencies of the block
+  /// currently being profiled have made so far. used to tell the time and
+  /// the documents of a block from those of its dependencies
+  ExecutionBlock::ProfileTotals _profileDependencies;
+
   /// @brief memory recycler for AqlItemBlocks
   AqlItemBlockManager _itemBlockManager;
 
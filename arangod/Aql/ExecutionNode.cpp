@@ -35,6 +35,8 @@
 #include "Aql/EnumerateCollectionBlock.h"
 #include "Aql/EnumerateListBlock.h"
 #include "Aql/Function.h"
+#include "Aql/HashJoinNode.h"
+#include "Aql/MaterializeNode.h"
 #include "Aql/IndexNode.h"
 #include "Aql/ModificationNodes.h"
 #include "Aql/NodeFinder.h"
@@ -88,6 +90,8 @@ std::unordered_map<int, std::string const> const typeNames{
 #ifdef USE_IRESEARCH
     {static_cast<int>(ExecutionNode::ENUMERATE_IRESEARCH_VIEW), "EnumerateViewNode"},
 #endif
+    {static_cast<int>(ExecutionNode::HASH_JOIN), "HashJoinNode"},
+    {static_cast<int>(ExecutionNode::MATERIALIZE), "MaterializeNode"},
 };
 
 } // namespace
@@ -293,6 +297,10 @@ ExecutionNode* ExecutionNode::fromVPackFactory(
     case ENUMERATE_IRESEARCH_VIEW:
       return new iresearch::IResearchViewNode(*plan, slice);
 #endif
+    case HASH_JOIN:
+      return new HashJoinNode(plan, slice);
+    case MATERIALIZE:
+      return new MaterializeNode(plan, slice);
     default: {
       // should not reach this point
       TRI_ASSERT(false);
@@ -608,7 +616,7 @@ ExecutionNode const* ExecutionNode::getLoop() const {
     auto type = node->getType();
 
     if (type == ENUMERATE_COLLECTION || type == INDEX || type == TRAVERSAL ||
-        type == ENUMERATE_LIST || type == SHORTEST_PATH
+        type == ENUMERATE_LIST || type == SHORTEST_PATH || type == HASH_JOIN
 #ifdef USE_IRESEARCH
         || type == ENUMERATE_IRESEARCH_VIEW
 #endif
@@ -874,6 +882,29 @@ void ExecutionNode::RegisterPlan::after(ExecutionNode* en) {
     }
 
     case ExecutionNode::INDEX: {
+      auto ep = ExecutionNode::castTo<IndexNode const*>(en);
+      TRI_ASSERT(ep != nullptr);
+      // with late materialization, the document ids get a register, too
+      RegisterId const nrOut = (ep->docIdVariable() != nullptr) ? 2 : 1;
+
+      depth++;
+      nrRegsHere.emplace_back(nrOut);
+      // create a copy of the last value here
+      // this is requried because back returns a reference and emplace/push_back
+      // may invalidate all references
+      RegisterId registerId = nrOut + nrRegs.back();
+      nrRegs.emplace_back(registerId);
+
+      varInfo.emplace(ep->outVariable()->id, VarInfo(depth, totalNrRegs));
+      totalNrRegs++;
+      if (ep->docIdVariable() != nullptr) {
+        varInfo.emplace(ep->docIdVariable()->id, VarInfo(depth, totalNrRegs));
+        totalNrRegs++;
+      }
+      break;
+    }
+
+    case ExecutionNode::HASH_JOIN: {
       depth++;
       nrRegsHere.emplace_back(1);
       // create a copy of the last value here
@@ -882,7 +913,7 @@ void ExecutionNode::RegisterPlan::after(ExecutionNode* en) {
       RegisterId registerId = 1 + nrRegs.back();
       nrRegs.emplace_back(registerId);
 
-      auto ep = ExecutionNode::castTo<IndexNode const*>(en);
+      auto ep = ExecutionNode::castTo<HashJoinNode const*>(en);
       TRI_ASSERT(ep != nullptr);
       varInfo.emplace(ep->outVariable()->id, VarInfo(depth, totalNrRegs));
       totalNrRegs++;
@@ -970,6 +1001,11 @@ void ExecutionNode::RegisterPlan::after(ExecutionNode* en) {
       break;
     }
 
+    case ExecutionNode::MATERIALIZE: {
+      // materialization replaces the values of an existing register in place
+      break;
+    }
+
     case ExecutionNode::RETURN: {
       // return is special. it produces a result but is the last step in the
       // pipeline
@@ -1318,7 +1354,8 @@ EnumerateCollectionNode::EnumerateCollectionNode(
     : ExecutionNode(plan, base),
       DocumentProducingNode(plan, base),
       CollectionAccessingNode(plan, base),
-      _random(base.get("random").getBoolean()) {
+      _random(base.get("random").getBoolean()),
+      _fullScan(VelocyPackHelper::getBooleanValue(base, "fullScan", false)) {
 }
 
 /// @brief toVelocyPack, for EnumerateCollectionNode
@@ -1327,6 +1364,7 @@ void EnumerateCollectionNode::toVelocyPackHelper(VPackBuilder& builder, unsigned
   ExecutionNode::toVelocyPackHelperGeneric(builder, flags);
 
   builder.add("random", VPackValue(_random));
+  builder.add("fullScan", VPackValue(_fullScan));
 
   // add outvariable and projection
   DocumentProducingNode::toVelocyPack(builder);
@@ -1359,6 +1397,7 @@ ExecutionNode* EnumerateCollectionNode::clone(ExecutionPlan* plan,
   auto c = std::make_unique<EnumerateCollectionNode>(plan, _id, _collection, outVariable, _random);
 
   c->projections(_projections);
+  c->_fullScan = _fullScan;
 
   return cloneHelper(std::move(c), withDependencies, withProperties);
 }
@@ -1695,6 +1734,8 @@ bool SubqueryNode::mayAccessCollections() {
 #endif
       ExecutionNode::ENUMERATE_COLLECTION,
       ExecutionNode::INDEX,
+      ExecutionNode::HASH_JOIN,
+      ExecutionNode::MATERIALIZE,
       ExecutionNode::INSERT,
       ExecutionNode::UPDATE,
       ExecutionNode::REPLACE,
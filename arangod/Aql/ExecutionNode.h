@@ -146,8 +146,10 @@ class ExecutionNode {
     INDEX = 23,
     SHORTEST_PATH = 24,
 #ifdef USE_IRESEARCH
-    ENUMERATE_IRESEARCH_VIEW,
+    ENUMERATE_IRESEARCH_VIEW = 25,
 #endif
+    HASH_JOIN = 26,
+    MATERIALIZE = 27,
     MAX_NODE_TYPE_VALUE
   };
 
@@ -679,7 +681,8 @@ class EnumerateCollectionNode : public ExecutionNode, public DocumentProducingNo
       : ExecutionNode(plan, id),
         DocumentProducingNode(outVariable),
         CollectionAccessingNode(collection),
-        _random(random) {
+        _random(random),
+        _fullScan(false) {
   }
 
   EnumerateCollectionNode(ExecutionPlan* plan,
@@ -718,9 +721,19 @@ class EnumerateCollectionNode : public ExecutionNode, public DocumentProducingNo
   /// @brief enable random iteration of documents in collection
   void setRandom() { _random = true; }
 
+  /// @brief whether or not the entire collection is read exactly once
+  bool isFullScan() const { return _fullScan; }
+
+  /// @brief mark the node as reading the entire collection exactly once,
+  /// so that the storage engine can read ahead and bypass its caches
+  void setFullScan() { _fullScan = true; }
+
  private:
   /// @brief whether or not we want random iteration
   bool _random;
+
+  /// @brief whether or not the entire collection is read exactly once
+  bool _fullScan;
 };
 
 /// @brief class EnumerateListNode
@@ -841,6 +854,9 @@ class LimitNode : public ExecutionNode {
   /// @brief tell the node to fully count what it will limit
   void setFullCount() { _fullCount = true; }
 
+  /// @brief whether or not the node fully counts what it will limit
+  bool fullCount() const { return _fullCount; }
+
   /// @brief return the offset value
   size_t offset() const { return _offset; }
 
@@ -201,6 +201,25 @@ std::unique_ptr<graph::BaseOptions> createShortestPathOptions(
               std::string(value->getStringValue(), value->getStringLength());
         } else if (name == "defaultWeight" && value->isNumericValue()) {
           options->defaultWeight = value->getDoubleValue();
+        } else if (name == "numberOfPaths" && value->isNumericValue()) {
+          int64_t const paths = value->getIntValue();
+          if (paths < 1) {
+            THROW_ARANGO_EXCEPTION_MESSAGE(
+                TRI_ERROR_BAD_PARAMETER,
+                "numberOfPaths must be a positive number");
+          }
+          options->numberOfPaths = static_cast<size_t>(paths);
+        } else if (name == "heuristicAttribute" && value->isStringValue()) {
+          options->heuristicAttribute =
+              std::string(value->getStringValue(), value->getStringLength());
+        } else if (name == "heuristicFactor" && value->isNumericValue()) {
+          double const factor = value->getDoubleValue();
+          if (factor < 0) {
+            THROW_ARANGO_EXCEPTION_MESSAGE(
+                TRI_ERROR_BAD_PARAMETER,
+                "heuristicFactor must not be negative");
+          }
+          options->heuristicFactor = factor;
         }
       }
     }
@@ -2339,7 +2358,8 @@ bool ExecutionPlan::isDeadSimple() const {
         nodeType == ExecutionNode::ENUMERATE_LIST ||
         nodeType == ExecutionNode::TRAVERSAL ||
         nodeType == ExecutionNode::SHORTEST_PATH ||
-        nodeType == ExecutionNode::INDEX) {
+        nodeType == ExecutionNode::INDEX ||
+        nodeType == ExecutionNode::HASH_JOIN) {
       // these node types are not simple
       return false;
     }
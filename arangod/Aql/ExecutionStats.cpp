@@ -24,6 +24,7 @@
 #include "ExecutionStats.h"
 #include "Basics/Exceptions.h"
 #include "Basics/StringUtils.h"
+#include "Basics/VelocyPackHelper.h"
 
 #include <velocypack/Builder.h>
 #include <velocypack/Iterator.h>
@@ -41,6 +42,7 @@ void ExecutionStats::toVelocyPack(VPackBuilder& builder, bool reportFullCount) c
   builder.add("scannedIndex", VPackValue(scannedIndex));
   builder.add("filtered", VPackValue(filtered));
   builder.add("httpRequests", VPackValue(requests));
+  counters.toVelocyPack(builder);
   if (reportFullCount) {
     // fullCount is optional
     builder.add("fullCount", VPackValue(fullCount > count ? fullCount : count));
@@ -58,7 +60,12 @@ void ExecutionStats::toVelocyPack(VPackBuilder& builder, bool reportFullCount) c
       builder.add("id", VPackValue(pair.first));
       builder.add("calls", VPackValue(pair.second.calls));
       builder.add("items", VPackValue(pair.second.items));
+      builder.add("itemsIn", VPackValue(pair.second.itemsIn));
       builder.add("runtime", VPackValue(pair.second.runtime));
+      builder.add("selfRuntime", VPackValue(pair.second.selfRuntime));
+      builder.add("scannedIndex", VPackValue(pair.second.scannedIndex));
+      builder.add("scannedFull", VPackValue(pair.second.scannedFull));
+      builder.add("peakMemory", VPackValue(pair.second.peakMemory));
       builder.add("blockType",
                   VPackValue(ExecutionBlock::typeToString(pair.second.type)));
       builder.close();
@@ -85,6 +92,7 @@ void ExecutionStats::add(ExecutionStats const& summand) {
     fullCount += summand.fullCount;
   }
   count += summand.count;
+  counters.add(summand.counters);
   // intentionally no modification of executionTime
   
   for(auto const& pair : summand.nodes) {
@@ -124,6 +132,7 @@ ExecutionStats::ExecutionStats(VPackSlice const& slice)
   if (slice.hasKey("httpRequests")) {
     requests = slice.get("httpRequests").getNumber<int64_t>();
   }
+  counters.fromVelocyPack(slice);
   
   // note: fullCount is an optional attribute!
   if (slice.hasKey("fullCount")) {
@@ -140,6 +149,18 @@ ExecutionStats::ExecutionStats(VPackSlice const& slice)
       node.calls = val.get("calls").getNumber<size_t>();
       node.items = val.get("items").getNumber<size_t>();
       node.runtime = val.get("runtime").getNumber<double>();
+      // the detailed figures are optional, as servers of older versions do
+      // not send them
+      node.itemsIn = basics::VelocyPackHelper::getNumericValue<size_t>(
+          val, "itemsIn", 0);
+      node.selfRuntime = basics::VelocyPackHelper::getNumericValue<double>(
+          val, "selfRuntime", 0.0);
+      node.scannedIndex = basics::VelocyPackHelper::getNumericValue<int64_t>(
+          val, "scannedIndex", 0);
+      node.scannedFull = basics::VelocyPackHelper::getNumericValue<int64_t>(
+          val, "scannedFull", 0);
+      node.peakMemory = basics::VelocyPackHelper::getNumericValue<size_t>(
+          val, "peakMemory", 0);
       node.type =
           ExecutionBlock::typeFromString(val.get("blockType").copyString());
       nodes.emplace(nid, node);
@@ -26,6 +26,7 @@
 
 #include "Basics/Common.h"
 #include "ExecutionBlock.h"
+#include "QueryCounters.h"
 
 #include <velocypack/Builder.h>
 #include <velocypack/Slice.h>
@@ -45,15 +46,34 @@ struct ExecutionStats {
   /// @brief statistics per ExecutionNode
   struct Node {
     size_t calls = 0;
+    /// @brief number of rows returned by the node
     size_t items = 0;
+    /// @brief number of rows the node got from its dependencies
+    size_t itemsIn = 0;
+    /// @brief wall time of the node's getSome calls, including the time spent
+    /// in its dependencies
     double runtime = 0;
+    /// @brief wall time of the node's getSome calls, excluding the time spent
+    /// in its dependencies
+    double selfRuntime = 0;
+    /// @brief documents the node itself looked up from indexes or scanned
+    int64_t scannedIndex = 0;
+    int64_t scannedFull = 0;
+    /// @brief highest memory usage of the query observed when one of the
+    /// node's getSome calls returned
+    size_t peakMemory = 0;
     ExecutionBlock::Type type = ExecutionBlock::Type::_UNDEFINED;
     ExecutionStats::Node& operator+=(ExecutionStats::Node const& other) {
       // both operands should be the same block type
       TRI_ASSERT(type == other.type);
       calls += other.calls;
       items += other.items;
+      itemsIn += other.itemsIn;
       runtime += other.runtime;
+      selfRuntime += other.selfRuntime;
+      scannedIndex += other.scannedIndex;
+      scannedFull += other.scannedFull;
+      peakMemory = (std::max)(peakMemory, other.peakMemory);
       return *this;
     }
   };
@@ -81,6 +101,7 @@ struct ExecutionStats {
     fullCount = 0;
     count = 0;
     executionTime = 0.0;
+    counters.clear();
   }
 
   /// @brief number of successfully executed write operations
@@ -110,6 +131,9 @@ struct ExecutionStats {
   /// @brief query execution time (wall-clock time). value will be set from 
   /// the outside
   double executionTime;
+
+  /// @brief storage, cache and network costs
+  QueryCounters counters;
   
   ///  @brief statistics per ExecutionNodes
   std::map<size_t, ExecutionStats::Node> nodes;
@@ -26,12 +26,14 @@
 #include "Aql/AqlValue.h"
 #include "Aql/Ast.h"
 #include "Aql/AttributeAccessor.h"
+#include "Aql/CompiledExpression.h"
 #include "Aql/ExecutionNode.h"
 #include "Aql/ExecutionPlan.h"
 #include "Aql/ExpressionContext.h"
 #include "Aql/BaseExpressionContext.h"
 #include "Aql/Function.h"
 #include "Aql/Functions.h"
+#include "Aql/InListLookup.h"
 #include "Aql/Quantifier.h"
 #include "Aql/Query.h"
 #include "Aql/V8Executor.h"
@@ -146,6 +148,16 @@ AqlValue Expression::execute(transaction::Methods* trx, ExpressionContext* ctx,
       return _accessor->getDynamic(trx, ctx, mustDestroy);
     }
 
+    case COMPILED: {
+      TRI_ASSERT(_compiled != nullptr);
+      if (!_variables.empty()) {
+        // temporary variables are only known to the regular execution
+        return executeSimpleExpression(_node, trx, mustDestroy, true);
+      }
+      mustDestroy = false;
+      return _compiled->execute(trx, ctx);
+    }
+
     case UNPROCESSED: {
       // fall-through to exception
     }
@@ -155,6 +167,34 @@ AqlValue Expression::execute(transaction::Methods* trx, ExpressionContext* ctx,
                                  "invalid expression type");
 }
 
+/// @brief whether or not the expression can be executed for all rows of
+/// a block at once
+bool Expression::canExecuteBlock(transaction::Methods* trx) {
+  buildExpression(trx);
+
+  // temporary variables are only known to the regular execution
+  if (!_variables.empty()) {
+    return false;
+  }
+  return (_type == COMPILED ||
+          (_type == SIMPLE && _node->type == NODE_TYPE_FCALL_USER));
+}
+
+/// @brief execute the expression for all rows of a block
+void Expression::executeBlock(transaction::Methods* trx, AqlItemBlock* block,
+                              std::vector<Variable const*> const& vars,
+                              std::vector<RegisterId> const& regs,
+                              RegisterId outReg) {
+  if (_type == SIMPLE) {
+    TRI_ASSERT(_node->type == NODE_TYPE_FCALL_USER);
+    executeBlockFCallUser(trx, block, vars, regs, outReg);
+    return;
+  }
+
+  TRI_ASSERT(_type == COMPILED && _compiled != nullptr);
+  _compiled->executeBlock(trx, block, vars, regs, outReg);
+}
+
 /// @brief replace variables in the expression with other variables
 void Expression::replaceVariables(
     std::unordered_map<VariableId, Variable const*> const& replacements) {
@@ -194,6 +234,9 @@ void Expression::replaceAttributeAccess(Variable const* variable,
 
 /// @brief free the internal data structures
 void Expression::freeInternals() noexcept {
+  // the lists of IN operators may have changed
+  _inListLookups.clear();
+
   switch (_type) {
     case JSON:
       delete[] _data;
@@ -207,6 +250,14 @@ void Expression::freeInternals() noexcept {
       break;
     }
 
+    case COMPILED: {
+      delete _compiled;
+      _compiled = nullptr;
+      // the program must be compiled again from the (possibly modified) node
+      _type = UNPROCESSED;
+      break;
+    }
+
     case SIMPLE:
     case UNPROCESSED: {
       // nothing to do
@@ -217,7 +268,8 @@ void Expression::freeInternals() noexcept {
 
 /// @brief reset internal attributes after variables in the expression were changed
 void Expression::invalidateAfterReplacements() {
-  if (_type == ATTRIBUTE_SYSTEM || _type == ATTRIBUTE_DYNAMIC || _type == SIMPLE) {
+  if (_type == ATTRIBUTE_SYSTEM || _type == ATTRIBUTE_DYNAMIC || _type == SIMPLE ||
+      _type == COMPILED) {
     freeInternals();
     // must even set back the expression type so the expression will be analyzed
     // again
@@ -253,6 +305,26 @@ bool Expression::findInArray(AqlValue const& left, AqlValue const& right,
 
   size_t const n = right.length();
 
+  if (n >= AstNode::SortNumberThreshold && !right.isRange() &&
+      (node->type == NODE_TYPE_OPERATOR_BINARY_IN ||
+       node->type == NODE_TYPE_OPERATOR_BINARY_NIN) &&
+      node->getMember(1)->isConstant() &&
+      (left.isNumber() || left.isString() || left.isBoolean() ||
+       left.isNull(false))) {
+    // constant list, e.g. from a bind parameter. build a hash set over it
+    // once, instead of searching the list for every row
+    auto it = _inListLookups.find(node);
+    if (it == _inListLookups.end()) {
+      it = _inListLookups
+               .emplace(node, std::make_unique<InListLookup>(right.slice()))
+               .first;
+    }
+    VPackSlice const value = left.slice();
+    if ((*it).second->canLookup(value)) {
+      return (*it).second->contains(value);
+    }
+  }
+
   if (n >= AstNode::SortNumberThreshold &&
       (node->getMember(1)->isSorted() ||
       ((node->type == NODE_TYPE_OPERATOR_BINARY_IN ||
@@ -347,6 +419,12 @@ void Expression::initSimpleExpression() {
   _type = SIMPLE;
 
   if (_node->type != NODE_TYPE_ATTRIBUTE_ACCESS) {
+    // optimization for boolean combinations of comparisons
+    auto compiled = CompiledExpression::compile(_node);
+    if (compiled != nullptr) {
+      _compiled = compiled.release();
+      _type = COMPILED;
+    }
     return;
   }
 
@@ -371,7 +449,9 @@ void Expression::initSimpleExpression() {
     // a collection enumeration/index enumeration
     auto setter = _plan->getVarSetBy(v->id);
     if (setter != nullptr &&
-        (setter->getType() == ExecutionNode::INDEX || setter->getType() == ExecutionNode::ENUMERATE_COLLECTION)) {
+        (setter->getType() == ExecutionNode::INDEX ||
+         setter->getType() == ExecutionNode::ENUMERATE_COLLECTION ||
+         setter->getType() == ExecutionNode::HASH_JOIN)) {
       // it is
       dataIsFromCollection = true;
     }
@@ -438,6 +518,8 @@ AqlValue Expression::executeSimpleExpression(
       return executeSimpleExpressionValue(node, trx, mustDestroy);
     case NODE_TYPE_REFERENCE:
       return executeSimpleExpressionReference(node, trx, mustDestroy, doCopy);
+    case NODE_TYPE_PARAMETER:
+      return executeSimpleExpressionParameter(node, trx, mustDestroy);
     case NODE_TYPE_FCALL:
       return executeSimpleExpressionFCall(node, trx, mustDestroy);
     case NODE_TYPE_FCALL_USER:
@@ -813,6 +895,30 @@ AqlValue Expression::executeSimpleExpressionReference(
   return _expressionContext->getVariableValue(v, doCopy, mustDestroy);
 }
 
+/// @brief execute an expression of type SIMPLE with PARAMETER. bind
+/// parameters are only left in the AST for plans that go into the plan
+/// cache, so their values are read from the current query
+AqlValue Expression::executeSimpleExpressionParameter(
+    AstNode const* node, transaction::Methods*, bool& mustDestroy) {
+
+  mustDestroy = false;
+  auto parameters = _ast->query()->bindParameters();
+
+  VPackSlice value;
+  if (parameters != nullptr && parameters->slice().isObject()) {
+    value = parameters->slice().get(node->getString());
+  }
+
+  if (value.isNone()) {
+    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_BIND_PARAMETER_MISSING,
+                                  node->getString().c_str());
+  }
+
+  // copy the slice we found
+  mustDestroy = true;
+  return AqlValue(value);
+}
+
 /// @brief execute an expression of type SIMPLE with RANGE
 AqlValue Expression::executeSimpleExpressionRange(
     AstNode const* node, transaction::Methods* trx, bool& mustDestroy) {
@@ -1028,6 +1134,126 @@ AqlValue Expression::executeSimpleExpressionFCallJS(
   }
 }
 
+/// @brief execute a call to a user-defined function for all rows of a
+/// block. the parameters of all rows go into V8 at once, and a small JavaScript
+/// loop calls the function for each of them, so the block does not pay for
+/// entering V8 and looking up the function once per row
+void Expression::executeBlockFCallUser(transaction::Methods* trx,
+                                       AqlItemBlock* block,
+                                       std::vector<Variable const*> const& vars,
+                                       std::vector<RegisterId> const& regs,
+                                       RegisterId outReg) {
+  static char const* const BatchCall =
+      "(function (call, name, rows) {\n"
+      "  var n = rows.length;\n"
+      "  var results = new Array(n);\n"
+      "  for (var i = 0; i < n; ++i) {\n"
+      "    results[i] = call(name, rows[i]);\n"
+      "  }\n"
+      "  return results;\n"
+      "})";
+
+  auto member = _node->getMemberUnchecked(0);
+  TRI_ASSERT(member->type == NODE_TYPE_ARRAY);
+  size_t const n = member->numMembers();
+  size_t const nrRows = block->size();
+
+  ISOLATE;
+  TRI_ASSERT(isolate != nullptr);
+  TRI_V8_CURRENT_GLOBALS_AND_SCOPE;
+  _ast->query()->prepareV8Context();
+
+  auto old = v8g->_query;
+  v8g->_query = static_cast<void*>(_ast->query());
+  TRI_DEFER(v8g->_query = old);
+
+  v8::Handle<v8::Array> rows =
+      v8::Array::New(isolate, static_cast<int>(nrRows));
+
+  for (size_t row = 0; row < nrRows; ++row) {
+    BaseExpressionContext ctx(row, block, vars, regs);
+    _expressionContext = &ctx;
+
+    v8::Handle<v8::Array> params = v8::Array::New(isolate, static_cast<int>(n));
+
+    for (size_t i = 0; i < n; ++i) {
+      auto arg = member->getMemberUnchecked(i);
+
+      bool localMustDestroy;
+      AqlValue a = executeSimpleExpression(arg, trx, localMustDestroy, false);
+      AqlValueGuard guard(a, localMustDestroy);
+
+      params->Set(static_cast<uint32_t>(i), a.toV8(isolate, trx));
+    }
+
+    rows->Set(static_cast<uint32_t>(row), params);
+  }
+  _expressionContext = nullptr;
+
+  auto current = isolate->GetCurrentContext()->Global();
+
+  v8::Handle<v8::Value> module = current->Get(TRI_V8_ASCII_STRING(isolate, "_AQL"));
+  if (module.IsEmpty() || !module->IsObject()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "unable to find global _AQL module");
+  }
+
+  v8::Handle<v8::Value> function = v8::Handle<v8::Object>::Cast(module)->Get(TRI_V8_ASCII_STRING(isolate, "FCALL_USER"));
+  if (function.IsEmpty() || !function->IsFunction()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "unable to find AQL function 'FCALL_USER'");
+  }
+
+  v8::TryCatch tryCatch;
+
+  // V8's compilation cache keeps the loop compiled between blocks
+  v8::Handle<v8::Script> script = v8::Script::Compile(
+      TRI_V8_ASCII_STRING(isolate, BatchCall),
+      TRI_V8_ASCII_STRING(isolate, "FCALL_USER_BATCH"));
+  v8::Handle<v8::Value> batch;
+  if (!script.IsEmpty()) {
+    batch = script->Run();
+  }
+  if (batch.IsEmpty() || !batch->IsFunction()) {
+    V8Executor::HandleV8Error(tryCatch, batch, nullptr, false);
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "unable to compile batched call of user-defined function");
+  }
+
+  v8::Handle<v8::Value> args[] = {
+    function, TRI_V8_STD_STRING(isolate, _node->getString()), rows
+  };
+  v8::Handle<v8::Value> result =
+      v8::Handle<v8::Function>::Cast(batch)->Call(current, 3, args);
+
+  V8Executor::HandleV8Error(tryCatch, result, nullptr, false);
+
+  if (result.IsEmpty() || !result->IsArray()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "invalid result of batched call of user-defined function");
+  }
+
+  v8::Handle<v8::Array> results = v8::Handle<v8::Array>::Cast(result);
+  transaction::BuilderLeaser builder(trx);
+
+  for (size_t row = 0; row < nrRows; ++row) {
+    v8::Handle<v8::Value> value = results->Get(static_cast<uint32_t>(row));
+
+    if (value.IsEmpty() || value->IsUndefined()) {
+      block->emplaceValue(row, outReg, AqlValueHintNull());
+      continue;
+    }
+
+    builder->clear();
+    int res = TRI_V8ToVPack(isolate, *builder.get(), value, false);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION(res);
+    }
+
+    AqlValue a(builder.get());
+    AqlValueGuard guard(a, true);
+    block->setValue(row, outReg, a);
+    guard.steal();
+  }
+}
+
 /// @brief execute an expression of type SIMPLE with NOT
 AqlValue Expression::executeSimpleExpressionNot(
     AstNode const* node, transaction::Methods* trx, bool& mustDestroy) {
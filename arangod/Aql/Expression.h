@@ -49,14 +49,16 @@ class AqlItemBlock;
 struct AqlValue;
 class Ast;
 class AttributeAccessor;
+class CompiledExpression;
 class ExecutionPlan;
 class ExpressionContext;
+class InListLookup;
 class Query;
 
 /// @brief AqlExpression, used in execution plans and execution blocks
 class Expression {
  public:
-  enum ExpressionType : uint32_t { UNPROCESSED, JSON, SIMPLE, ATTRIBUTE_SYSTEM, ATTRIBUTE_DYNAMIC };
+  enum ExpressionType : uint32_t { UNPROCESSED, JSON, SIMPLE, ATTRIBUTE_SYSTEM, ATTRIBUTE_DYNAMIC, COMPILED };
 
   Expression(Expression const&) = delete;
   Expression& operator=(Expression const&) = delete;
@@ -133,6 +135,17 @@ class Expression {
   AqlValue execute(transaction::Methods* trx, ExpressionContext* ctx,
                    bool& mustDestroy);
 
+  /// @brief whether or not the expression can be executed for all rows of
+  /// a block at once
+  bool canExecuteBlock(transaction::Methods* trx);
+
+  /// @brief execute the expression for all rows of a block and write the
+  /// results into the output register. vars and regs map the variables of
+  /// the expression to the registers of the block
+  void executeBlock(transaction::Methods* trx, AqlItemBlock* block,
+                    std::vector<Variable const*> const& vars,
+                    std::vector<RegisterId> const& regs, RegisterId outReg);
+
   /// @brief check whether this is a JSON expression
   inline bool isJson() {
     if (_type == UNPROCESSED) {
@@ -155,6 +168,8 @@ class Expression {
       case ATTRIBUTE_SYSTEM:
       case ATTRIBUTE_DYNAMIC:
         return "attribute";
+      case COMPILED:
+        return "compiled";
       case UNPROCESSED: {
       }
     }
@@ -273,6 +288,11 @@ class Expression {
                                             bool& mustDestroy,
                                             bool);
 
+  /// @brief execute an expression of type SIMPLE with PARAMETER
+  AqlValue executeSimpleExpressionParameter(AstNode const*,
+                                            transaction::Methods*,
+                                            bool& mustDestroy);
+
   /// @brief execute an expression of type SIMPLE with FCALL, dispatcher
   AqlValue executeSimpleExpressionFCall(AstNode const*,
                                         transaction::Methods*,
@@ -287,6 +307,13 @@ class Expression {
                                           transaction::Methods*,
                                           bool& mustDestroy);
 
+  /// @brief execute a call to a user-defined function for all rows of a
+  /// block, with one call into V8
+  void executeBlockFCallUser(transaction::Methods* trx, AqlItemBlock* block,
+                             std::vector<Variable const*> const& vars,
+                             std::vector<RegisterId> const& regs,
+                             RegisterId outReg);
+
   /// @brief execute an expression of type SIMPLE with RANGE
   AqlValue executeSimpleExpressionRange(AstNode const*,
                                         transaction::Methods*,
@@ -364,6 +391,7 @@ class Expression {
   union {
     uint8_t* _data;
     AttributeAccessor* _accessor;
+    CompiledExpression* _compiled;
   };
 
   /// @brief type of expression
@@ -389,6 +417,11 @@ class Expression {
   /// @brief variables only temporarily valid during execution
   std::unordered_map<Variable const*, arangodb::velocypack::Slice> _variables;
 
+  /// @brief hash sets for IN and NOT IN operators with long constant lists,
+  /// built when the operator is first executed
+  mutable std::unordered_map<AstNode const*, std::unique_ptr<InListLookup>>
+      _inListLookups;
+
   ExpressionContext* _expressionContext;
 };
 
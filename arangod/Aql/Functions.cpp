@@ -45,6 +45,7 @@
 #include "Geo/GeoParams.h"
 #include "Geo/GeoUtils.h"
 #include "Geo/GeoJson.h"
+#include "Geo/ShapeCache.h"
 #include "Geo/ShapeContainer.h"
 #include "Indexes/Index.h"
 #include "Logger/Logger.h"
@@ -2587,6 +2588,18 @@ AqlValue Functions::Like(arangodb::aql::Query* query, transaction::Methods* trx,
   AqlValue regex = ExtractFunctionParameterValue(parameters, 1);
   ::appendAsString(trx, adapter, regex);
 
+  // literal patterns do without ICU. the matcher is owned by the query!
+  LiteralMatcher const* literal = query->regexCache()->buildLiteralLikeMatcher(
+      buffer->c_str(), buffer->length(), caseInsensitive);
+  if (literal != nullptr) {
+    buffer->clear();
+    AqlValue value = ExtractFunctionParameterValue(parameters, 0);
+    ::appendAsString(trx, adapter, value);
+
+    return AqlValue(AqlValueHintBool(
+        literal->matches(buffer->c_str(), buffer->length())));
+  }
+
   // the matcher is owned by the query!
   ::RegexMatcher* matcher = query->regexCache()->buildLikeMatcher(
       buffer->c_str(), buffer->length(), caseInsensitive);
@@ -2761,6 +2774,18 @@ AqlValue Functions::RegexTest(arangodb::aql::Query* query,
   AqlValue regex = ExtractFunctionParameterValue(parameters, 1);
   ::appendAsString(trx, adapter, regex);
 
+  // literal patterns do without ICU. the matcher is owned by the query!
+  LiteralMatcher const* literal = query->regexCache()->buildLiteralRegexMatcher(
+      buffer->c_str(), buffer->length(), caseInsensitive);
+  if (literal != nullptr) {
+    buffer->clear();
+    AqlValue value = ExtractFunctionParameterValue(parameters, 0);
+    ::appendAsString(trx, adapter, value);
+
+    return AqlValue(AqlValueHintBool(
+        literal->matches(buffer->c_str(), buffer->length())));
+  }
+
   // the matcher is owned by the query!
   ::RegexMatcher* matcher = query->regexCache()->buildRegexMatcher(
       buffer->c_str(), buffer->length(), caseInsensitive);
@@ -4653,7 +4678,8 @@ static AqlValue GeoContainsIntersect(arangodb::aql::Query* query,
 
   AqlValueMaterializer mat1(trx);
   geo::ShapeContainer outer, inner;
-  Result res = geo::geojson::parseRegion(mat1.slice(p1, true), outer);
+  // the first argument is mostly the same shape for all documents
+  Result res = geo::ShapeCache::instance().parseRegion(mat1.slice(p1, true), outer);
   if (res.fail()) {
     ::registerWarning(query, func, res);
     return AqlValue(AqlValueHintNull());
@@ -0,0 +1,349 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "HashJoinBlock.h"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/AqlValue.h"
+#include "Aql/Collection.h"
+#include "Aql/ExecutionEngine.h"
+#include "Aql/Query.h"
+#include "Basics/Exceptions.h"
+#include "StorageEngine/EngineSelectorFeature.h"
+#include "StorageEngine/StorageEngine.h"
+#include "Transaction/Methods.h"
+#include "Utils/OperationCursor.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+/// @brief join partners of input rows without a matching document
+std::vector<VPackSlice> const noMatches;
+
+/// @brief upper bound for the memory a document takes in the hash table
+/// besides its own data: its slice in the list of documents and in the
+/// list of join partners, and a table entry of its own if its join value
+/// is unique
+size_t const documentOverhead = 2 * sizeof(VPackSlice) +
+    sizeof(std::pair<VPackSlice const, std::vector<VPackSlice>>) + 2 * sizeof(void*);
+}
+
+HashJoinBlock::HashJoinBlock(ExecutionEngine* engine, HashJoinNode const* ep)
+    : ExecutionBlock(engine, ep),
+      DocumentProducingBlock(ep, _trx),
+      _collection(ep->collection()),
+      _inRegister(ExecutionNode::MaxRegisterId),
+      _attribute(ep->attribute()),
+      _tableBuilt(false),
+      _memoryLimit(engine->getQuery()->queryOptions().hashJoinMemoryLimit),
+      _memoryUsage(0),
+      _nestedLoop(false),
+      _scanning(false),
+      _matches(nullptr),
+      _matchPos(0) {
+  auto it = ep->getRegisterPlan()->varInfo.find(ep->inVariable()->id);
+
+  if (it == ep->getRegisterPlan()->varInfo.end()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "variable not found");
+  }
+
+  _inRegister = (*it).second.registerId;
+  TRI_ASSERT(_inRegister < ExecutionNode::MaxRegisterId);
+
+  buildCallback();
+}
+
+HashJoinBlock::~HashJoinBlock() {
+  releaseMemory();
+}
+
+std::pair<ExecutionState, arangodb::Result> HashJoinBlock::initializeCursor(
+    AqlItemBlock* items, size_t pos) {
+  DEBUG_BEGIN_BLOCK();
+  auto res = ExecutionBlock::initializeCursor(items, pos);
+
+  if (res.first == ExecutionState::WAITING ||
+      !res.second.ok()) {
+    // If we need to wait or get an error we return as is.
+    return res;
+  }
+
+  // the hash table does not depend on the input, so it is kept
+  _matches = nullptr;
+  _matchPos = 0;
+  _scanning = false;
+
+  return res;
+
+  // cppcheck-suppress style
+  DEBUG_END_BLOCK();
+}
+
+/// @brief read all documents of the collection into the hash table
+void HashJoinBlock::buildTable() {
+  TRI_ASSERT(!_tableBuilt);
+  TRI_ASSERT(_table.empty());
+
+  std::unique_ptr<OperationCursor> cursor(
+      _trx->indexScan(_collection->name(), transaction::Methods::CursorType::SCAN));
+  TRI_ASSERT(cursor->ok());
+
+  // with raw document pointers, the documents stay valid for the lifetime
+  // of the query. otherwise, we have to keep our own copies
+  bool const copy = !EngineSelectorFeature::ENGINE->useRawDocumentPointers();
+
+  std::vector<VPackSlice> documents;
+  if (copy) {
+    _documents.clear();
+    _documents.openArray();
+  }
+
+  size_t scanned = 0;
+  bool hasMore = true;
+  while (hasMore) {
+    size_t usage = 0;
+    hasMore = cursor->nextDocument([&](LocalDocumentId const&, VPackSlice slice) {
+      ++scanned;
+      usage += ::documentOverhead;
+      if (copy) {
+        usage += slice.byteSize();
+        _documents.add(slice);
+      } else {
+        documents.emplace_back(slice);
+      }
+    }, DefaultBatchSize());
+
+    increaseMemoryUsage(usage);
+    if (_memoryLimit > 0 && _memoryUsage > _memoryLimit) {
+      // the table is too large. join by scanning the collection for every
+      // input row instead
+      _engine->_stats.scannedFull += static_cast<int64_t>(scanned);
+      _documents = VPackBuilder();
+      releaseMemory();
+      _nestedLoop = true;
+      _tableBuilt = true;
+      return;
+    }
+    throwIfKilled();  // check if we were aborted
+  }
+
+  if (copy) {
+    _documents.close();
+    documents.reserve(_documents.slice().length());
+    for (auto const& it : VPackArrayIterator(_documents.slice())) {
+      documents.emplace_back(it);
+    }
+  }
+
+  _table.reserve(documents.size());
+  for (auto const& it : documents) {
+    _table[joinValue(it)].emplace_back(it);
+  }
+
+  _engine->_stats.scannedFull += static_cast<int64_t>(scanned);
+  _tableBuilt = true;
+}
+
+/// @brief the join value of a document, null if it has no such attribute
+VPackSlice HashJoinBlock::joinValue(VPackSlice document) const {
+  VPackSlice value = document.get(_attribute);
+  if (value.isNone()) {
+    // a non-existing attribute is null in AQL
+    return VPackSlice::nullSlice();
+  }
+  return value;
+}
+
+/// @brief look up the join partners of the current input row
+std::vector<VPackSlice> const* HashJoinBlock::lookup(AqlItemBlock const* cur) {
+  AqlValue const& value = cur->getValueReference(_pos, _inRegister);
+
+  AqlValueMaterializer materializer(_trx);
+  VPackSlice key = materializer.slice(value, true);
+
+  auto it = _table.find(key);
+
+  if (it == _table.end()) {
+    return &::noMatches;
+  }
+  return &(*it).second;
+}
+
+/// @brief join the current input row by scanning the collection
+bool HashJoinBlock::scan(AqlItemBlock* cur, size_t atMost, bool skipping,
+                         std::unique_ptr<AqlItemBlock>& res, size_t& skipped) {
+  if (!_scanning) {
+    if (_cursor == nullptr) {
+      _cursor = _trx->indexScan(_collection->name(),
+                                transaction::Methods::CursorType::ALL);
+      TRI_ASSERT(_cursor->ok());
+    } else {
+      _cursor->reset();
+    }
+
+    AqlValueMaterializer materializer(_trx);
+    _value.clear();
+    _value.add(materializer.slice(cur->getValueReference(_pos, _inRegister), true));
+    _scanning = true;
+  }
+
+  VPackSlice const value = _value.slice();
+  basics::VelocyPackHelper::VPackEqual const equal;
+  RegisterId const nrInRegs = getNrInputRegisters();
+  size_t const fromRow = skipped;
+  size_t row = fromRow;
+
+  bool hasMore = true;
+  while (hasMore && skipped < atMost) {
+    size_t scanned = 0;
+    // each scanned document produces at most one row, so the batch never
+    // produces more rows than requested
+    hasMore = _cursor->nextDocument([&](LocalDocumentId const&, VPackSlice slice) {
+      ++scanned;
+      if (!equal(joinValue(slice), value)) {
+        return;
+      }
+      if (!skipping) {
+        if (res == nullptr) {
+          res.reset(requestBlock(atMost, getNrOutputRegisters()));
+        }
+        if (row == fromRow) {
+          inheritRegisters(cur, res.get(), _pos, fromRow);
+        }
+        _documentProducer(res.get(), slice, nrInRegs, row, fromRow);
+      }
+      ++skipped;
+    }, atMost - skipped);
+
+    _engine->_stats.scannedFull += static_cast<int64_t>(scanned);
+    throwIfKilled();  // check if we were aborted
+  }
+
+  if (!hasMore) {
+    _scanning = false;
+  }
+  return !hasMore;
+}
+
+/// @brief account memory of the hash table with the query
+void HashJoinBlock::increaseMemoryUsage(size_t value) {
+  _engine->getQuery()->resourceMonitor()->increaseMemoryUsage(value);
+  _memoryUsage += value;
+}
+
+/// @brief release all memory accounted for the hash table
+void HashJoinBlock::releaseMemory() {
+  if (_memoryUsage > 0) {
+    _engine->getQuery()->resourceMonitor()->decreaseMemoryUsage(_memoryUsage);
+    _memoryUsage = 0;
+  }
+}
+
+std::pair<ExecutionState, arangodb::Result> HashJoinBlock::getOrSkipSome(
+    size_t atMost, bool skipping, AqlItemBlock*& result, size_t& skipped) {
+  DEBUG_BEGIN_BLOCK();
+  TRI_ASSERT(result == nullptr && skipped == 0);
+
+  if (_done) {
+    return {ExecutionState::DONE, TRI_ERROR_NO_ERROR};
+  }
+
+  RegisterId const nrInRegs = getNrInputRegisters();
+  std::unique_ptr<AqlItemBlock> res;
+
+  while (skipped < atMost) {
+    BufferState bufferState = getBlockIfNeeded(upstreamBatchSize());
+    if (bufferState == BufferState::WAITING) {
+      if (skipped == 0) {
+        return {ExecutionState::WAITING, TRI_ERROR_NO_ERROR};
+      }
+      // return what we have so far
+      break;
+    }
+    if (bufferState == BufferState::NO_MORE_BLOCKS) {
+      break;
+    }
+
+    // if we make it here, then _buffer.front() exists
+    AqlItemBlock* cur = _buffer.front();
+    TRI_ASSERT(cur != nullptr);
+
+    if (!_tableBuilt) {
+      // the collection is only read once there is an input row to join
+      buildTable();
+    }
+
+    if (_nestedLoop) {
+      if (scan(cur, atMost, skipping, res, skipped)) {
+        // all join partners of this input row done
+        AqlItemBlock* removedBlock = advanceCursor(1, 0);
+        returnBlockUnlessNull(removedBlock);
+      }
+      continue;
+    }
+
+    if (_matches == nullptr) {
+      _matches = lookup(cur);
+      _matchPos = 0;
+    }
+
+    size_t const toSend = (std::min)(atMost - skipped, _matches->size() - _matchPos);
+
+    if (toSend > 0 && !skipping) {
+      if (res == nullptr) {
+        res.reset(requestBlock(atMost, getNrOutputRegisters()));
+      }
+
+      size_t const fromRow = skipped;
+      size_t row = fromRow;
+      inheritRegisters(cur, res.get(), _pos, fromRow);
+
+      for (size_t i = 0; i < toSend; ++i) {
+        _documentProducer(res.get(), (*_matches)[_matchPos + i], nrInRegs, row, fromRow);
+      }
+      TRI_ASSERT(row == fromRow + toSend);
+    }
+
+    _matchPos += toSend;
+    skipped += toSend;
+
+    if (_matchPos == _matches->size()) {
+      // all join partners of this input row done
+      _matches = nullptr;
+      _matchPos = 0;
+      AqlItemBlock* removedBlock = advanceCursor(1, 0);
+      returnBlockUnlessNull(removedBlock);
+    }
+  }
+
+  if (res != nullptr && skipped < atMost) {
+    res->shrink(skipped);
+  }
+
+  result = res.release();
+  return {getHasMoreState(), TRI_ERROR_NO_ERROR};
+
+  // cppcheck-suppress style
+  DEBUG_END_BLOCK();
+}
@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_HASH_JOIN_BLOCK_H
+#define ARANGOD_AQL_HASH_JOIN_BLOCK_H 1
+
+#include "Aql/DocumentProducingBlock.h"
+#include "Aql/ExecutionBlock.h"
+#include "Aql/HashJoinNode.h"
+#include "Basics/VelocyPackHelper.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+class OperationCursor;
+
+namespace aql {
+class AqlItemBlock;
+struct Collection;
+class ExecutionEngine;
+
+class HashJoinBlock final : public ExecutionBlock, public DocumentProducingBlock {
+ public:
+  HashJoinBlock(ExecutionEngine* engine, HashJoinNode const* ep);
+
+  ~HashJoinBlock();
+
+  Type getType() const override final {
+    return Type::HASH_JOIN;
+  }
+
+  /// @brief initializeCursor
+  std::pair<ExecutionState, Result> initializeCursor(AqlItemBlock* items, size_t pos) override;
+
+ private:
+  std::pair<ExecutionState, Result> getOrSkipSome(size_t atMost, bool skipping,
+                                                  AqlItemBlock*& result,
+                                                  size_t& skipped) override;
+
+  /// @brief read all documents of the collection into the hash table. if
+  /// the table would use more than the memory limit, it is dropped and the
+  /// join falls back to a nested loop
+  void buildTable();
+
+  /// @brief the join value of a document, null if it has no such attribute
+  arangodb::velocypack::Slice joinValue(arangodb::velocypack::Slice document) const;
+
+  /// @brief look up the join partners of the current input row
+  std::vector<arangodb::velocypack::Slice> const* lookup(AqlItemBlock const* cur);
+
+  /// @brief join the current input row by scanning the collection, producing
+  /// at most atMost - skipped rows. returns true when the scan for the input
+  /// row is complete
+  bool scan(AqlItemBlock* cur, size_t atMost, bool skipping,
+            std::unique_ptr<AqlItemBlock>& res, size_t& skipped);
+
+  /// @brief account memory of the hash table with the query
+  void increaseMemoryUsage(size_t value);
+
+  /// @brief release all memory accounted for the hash table
+  void releaseMemory();
+
+ private:
+  typedef std::unordered_map<arangodb::velocypack::Slice,
+                             std::vector<arangodb::velocypack::Slice>,
+                             basics::VelocyPackHelper::VPackHash,
+                             basics::VelocyPackHelper::VPackEqual> HashTable;
+
+  /// @brief collection
+  Collection const* _collection;
+
+  /// @brief register of the join value of the outer side
+  RegisterId _inRegister;
+
+  /// @brief the attribute path of the documents that is joined on
+  std::vector<std::string> const _attribute;
+
+  /// @brief copies of all documents, if the storage engine does not hand
+  /// out stable document pointers
+  arangodb::velocypack::Builder _documents;
+
+  /// @brief documents by join attribute value
+  HashTable _table;
+
+  /// @brief whether or not the hash table has been built already
+  bool _tableBuilt;
+
+  /// @brief maximum memory usage of the hash table, 0 = no limit
+  size_t const _memoryLimit;
+
+  /// @brief memory accounted for the hash table with the query
+  size_t _memoryUsage;
+
+  /// @brief whether the table exceeded the memory limit, so that the
+  /// collection is scanned for every input row
+  bool _nestedLoop;
+
+  /// @brief the scan for the current input row in the nested loop
+  std::unique_ptr<OperationCursor> _cursor;
+
+  /// @brief the join value of the current input row in the nested loop
+  arangodb::velocypack::Builder _value;
+
+  /// @brief whether the scan for the current input row has started
+  bool _scanning;
+
+  /// @brief join partners of the current input row, nullptr if the input
+  /// row has not been looked up yet
+  std::vector<arangodb::velocypack::Slice> const* _matches;
+
+  /// @brief position in _matches
+  size_t _matchPos;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "HashJoinNode.h"
+#include "Aql/Ast.h"
+#include "Aql/Collection.h"
+#include "Aql/ExecutionPlan.h"
+#include "Aql/HashJoinBlock.h"
+#include "Aql/Query.h"
+#include "Aql/Variable.h"
+#include "Basics/Exceptions.h"
+#include "Transaction/Methods.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+HashJoinNode::HashJoinNode(ExecutionPlan* plan, size_t id,
+                           aql::Collection const* collection,
+                           Variable const* outVariable,
+                           Variable const* inVariable,
+                           std::vector<std::string> const& attribute)
+    : ExecutionNode(plan, id),
+      DocumentProducingNode(outVariable),
+      CollectionAccessingNode(collection),
+      _inVariable(inVariable),
+      _attribute(attribute) {
+  TRI_ASSERT(_inVariable != nullptr);
+  TRI_ASSERT(!_attribute.empty());
+}
+
+HashJoinNode::HashJoinNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& base)
+    : ExecutionNode(plan, base),
+      DocumentProducingNode(plan, base),
+      CollectionAccessingNode(plan, base),
+      _inVariable(Variable::varFromVPack(plan->getAst(), base, "inVariable")) {
+  VPackSlice attribute = base.get("attribute");
+
+  if (!attribute.isArray() || attribute.length() == 0) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER, "\"attribute\" attribute should be a non-empty array");
+  }
+
+  for (auto const& it : VPackArrayIterator(attribute)) {
+    _attribute.emplace_back(it.copyString());
+  }
+}
+
+/// @brief toVelocyPack, for HashJoinNode
+void HashJoinNode::toVelocyPackHelper(VPackBuilder& builder, unsigned flags) const {
+  // call base class method
+  ExecutionNode::toVelocyPackHelperGeneric(builder, flags);
+
+  // add outvariable and projections
+  DocumentProducingNode::toVelocyPack(builder);
+
+  // add collection information
+  CollectionAccessingNode::toVelocyPack(builder);
+
+  builder.add(VPackValue("inVariable"));
+  _inVariable->toVelocyPack(builder);
+
+  builder.add(VPackValue("attribute"));
+  {
+    VPackArrayBuilder guard(&builder);
+    for (auto const& it : _attribute) {
+      builder.add(VPackValue(it));
+    }
+  }
+
+  // And close it:
+  builder.close();
+}
+
+/// @brief creates corresponding ExecutionBlock
+std::unique_ptr<ExecutionBlock> HashJoinNode::createBlock(
+    ExecutionEngine& engine,
+    std::unordered_map<ExecutionNode*, ExecutionBlock*> const&
+) const {
+  return std::make_unique<HashJoinBlock>(&engine, this);
+}
+
+/// @brief clone ExecutionNode recursively
+ExecutionNode* HashJoinNode::clone(ExecutionPlan* plan, bool withDependencies,
+                                   bool withProperties) const {
+  auto outVariable = _outVariable;
+  auto inVariable = _inVariable;
+
+  if (withProperties) {
+    outVariable = plan->getAst()->variables()->createVariable(outVariable);
+    inVariable = plan->getAst()->variables()->createVariable(inVariable);
+  }
+
+  auto c = std::make_unique<HashJoinNode>(plan, _id, _collection, outVariable,
+                                          inVariable, _attribute);
+
+  c->projections(_projections);
+
+  return cloneHelper(std::move(c), withDependencies, withProperties);
+}
+
+/// @brief the cost of a hash join node is the cost of reading the
+/// collection once plus one lookup per incoming row
+double HashJoinNode::estimateCost(size_t& nrItems) const {
+  size_t incoming;
+  TRI_ASSERT(!_dependencies.empty());
+  double depCost = _dependencies.at(0)->getCost(incoming);
+  transaction::Methods* trx = _plan->getAst()->query()->trx();
+  if (trx->status() != transaction::Status::RUNNING) {
+    nrItems = 0;
+    return 0.0;
+  }
+  size_t count = _collection->count(trx);
+  // without further knowledge, we assume that each incoming row has one
+  // join partner
+  nrItems = incoming;
+  return depCost + count + incoming + 1.0;
+}
@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_HASH_JOIN_NODE_H
+#define ARANGOD_AQL_HASH_JOIN_NODE_H 1
+
+#include "Basics/Common.h"
+#include "Aql/CollectionAccessingNode.h"
+#include "Aql/DocumentProducingNode.h"
+#include "Aql/ExecutionNode.h"
+#include "Aql/types.h"
+
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+namespace aql {
+struct Collection;
+class ExecutionBlock;
+class ExecutionEngine;
+class ExecutionPlan;
+struct Variable;
+
+/// @brief class HashJoinNode
+/// replaces an inner EnumerateCollectionNode that is joined to the outer
+/// loop(s) by an equality condition. the node reads the collection only once,
+/// builds a hash table keyed by the join attribute of the documents and then
+/// looks up the join value of each incoming row in it
+class HashJoinNode : public ExecutionNode, public DocumentProducingNode, public CollectionAccessingNode {
+  friend class ExecutionBlock;
+  friend class HashJoinBlock;
+
+ public:
+  HashJoinNode(ExecutionPlan* plan, size_t id,
+               aql::Collection const* collection, Variable const* outVariable,
+               Variable const* inVariable, std::vector<std::string> const& attribute);
+
+  HashJoinNode(ExecutionPlan*, arangodb::velocypack::Slice const& base);
+
+  /// @brief return the type of the node
+  NodeType getType() const override final { return HASH_JOIN; }
+
+  /// @brief export to VelocyPack
+  void toVelocyPackHelper(arangodb::velocypack::Builder&,
+                          unsigned flags) const override final;
+
+  /// @brief creates corresponding ExecutionBlock
+  std::unique_ptr<ExecutionBlock> createBlock(
+    ExecutionEngine& engine,
+    std::unordered_map<ExecutionNode*, ExecutionBlock*> const&
+  ) const override;
+
+  /// @brief clone ExecutionNode recursively
+  ExecutionNode* clone(ExecutionPlan* plan, bool withDependencies,
+                       bool withProperties) const override final;
+
+  /// @brief getVariablesSetHere
+  std::vector<Variable const*> getVariablesSetHere() const override final {
+    return std::vector<Variable const*>{_outVariable};
+  }
+
+  /// @brief getVariablesUsedHere, returning a vector
+  std::vector<Variable const*> getVariablesUsedHere() const override final {
+    return std::vector<Variable const*>{_inVariable};
+  }
+
+  /// @brief getVariablesUsedHere, modifying the set in-place
+  void getVariablesUsedHere(
+      std::unordered_set<Variable const*>& vars) const override final {
+    vars.emplace(_inVariable);
+  }
+
+  /// @brief the cost of a hash join node is the cost of reading the
+  /// collection once plus one lookup per incoming row
+  double estimateCost(size_t&) const override final;
+
+  /// @brief the variable holding the join value of the outer side
+  Variable const* inVariable() const { return _inVariable; }
+
+  /// @brief the attribute path of the documents that is joined on
+  std::vector<std::string> const& attribute() const { return _attribute; }
+
+ private:
+  /// @brief the variable holding the join value of the outer side
+  Variable const* _inVariable;
+
+  /// @brief the attribute path of the documents that is joined on
+  std::vector<std::string> _attribute;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
@@ -0,0 +1,70 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "InListLookup.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb::aql;
+
+namespace {
+/// @brief whether or not the string consists of printable ASCII characters
+/// only. for these, binary comparison and ICU collation agree on equality
+bool isPrintableAscii(VPackSlice value) {
+  TRI_ASSERT(value.isString());
+  VPackValueLength length;
+  char const* p = value.getString(length);
+  for (VPackValueLength i = 0; i < length; ++i) {
+    unsigned char const c = static_cast<unsigned char>(p[i]);
+    if (c < 0x20 || c > 0x7e) {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+/// @brief build the set from the members of the array
+InListLookup::InListLookup(VPackSlice values) : _stringsComparable(true) {
+  TRI_ASSERT(values.isArray());
+  _data.add(values);
+
+  VPackSlice const list = _data.slice();
+  _values.reserve(static_cast<size_t>(list.length()));
+  for (auto const& it : VPackArrayIterator(list)) {
+    if (it.isString() && !::isPrintableAscii(it)) {
+      _stringsComparable = false;
+    }
+    _values.emplace(it);
+  }
+}
+
+/// @brief whether or not the set can tell if the value is in the list
+bool InListLookup::canLookup(VPackSlice value) const {
+  if (value.isNumber() || value.isBoolean() || value.isNull()) {
+    return true;
+  }
+  if (value.isString()) {
+    return _stringsComparable && ::isPrintableAscii(value);
+  }
+  // arrays and objects may contain strings, search the list for them
+  return false;
+}
@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_IN_LIST_LOOKUP_H
+#define ARANGOD_AQL_IN_LIST_LOOKUP_H 1
+
+#include "Basics/Common.h"
+#include "Basics/VelocyPackHelper.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+namespace aql {
+
+/// @brief hash set over the members of a constant array, used to evaluate
+/// IN and NOT IN against long constant lists (e.g. bind parameters) without
+/// searching the array for every row.
+/// AQL compares strings with ICU collation, under which some different byte
+/// sequences compare equal (e.g. strings that differ only in ignorable
+/// control characters). the set compares binary, so string values can only
+/// be looked up if they and all strings in the list consist of printable
+/// ASCII characters, for which both comparisons agree
+class InListLookup {
+ public:
+  InListLookup(InListLookup const&) = delete;
+  InListLookup& operator=(InListLookup const&) = delete;
+
+  /// @brief build the set from the members of the array
+  explicit InListLookup(arangodb::velocypack::Slice values);
+
+  /// @brief whether or not the set can tell if the value is in the list.
+  /// if not, the list must be searched as usual
+  bool canLookup(arangodb::velocypack::Slice value) const;
+
+  /// @brief whether or not the value is in the list. must only be called
+  /// if canLookup() returns true for the value
+  bool contains(arangodb::velocypack::Slice value) const {
+    return _values.find(value) != _values.end();
+  }
+
+ private:
+  /// @brief a copy of the list, the set points into it
+  arangodb::velocypack::Builder _data;
+
+  std::unordered_set<arangodb::velocypack::Slice,
+                     arangodb::basics::VelocyPackHelper::VPackHash,
+                     arangodb::basics::VelocyPackHelper::VPackEqual>
+      _values;
+
+  /// @brief whether or not all strings in the list are printable ASCII
+  bool _stringsComparable;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
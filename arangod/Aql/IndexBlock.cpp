@@ -78,11 +78,21 @@ IndexBlock::IndexBlock(ExecutionEngine* engine, IndexNode const* en)
       _hasMultipleExpansions(false),
       _returned(0),
       _copyFromRow(0),
+      _docIdRegister(ExecutionNode::MaxRegisterId),
       _resultInFlight(nullptr) {
   _mmdr.reset(new ManagedDocumentResult);
 
   TRI_ASSERT(!_indexes.empty());
 
+  if (en->docIdVariable() != nullptr) {
+    auto it = en->getRegisterPlan()->varInfo.find(en->docIdVariable()->id);
+    if (it == en->getRegisterPlan()->varInfo.end()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "variable not found");
+    }
+    _docIdRegister = (*it).second.registerId;
+    TRI_ASSERT(_docIdRegister < ExecutionNode::MaxRegisterId);
+  }
+
   if (_condition != nullptr) {
     // fix const attribute accesses, e.g. { "a": 1 }.a
     for (size_t i = 0; i < _condition->numMembers(); ++i) {
@@ -493,6 +503,22 @@ bool IndexBlock::skipIndex(size_t atMost) {
       THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
     }
 
+    if (_indexes.size() > 1 || _hasMultipleExpansions) {
+      // a document may be found more than once, count it only once like
+      // getSome returns it only once
+      _cursor->next([this](LocalDocumentId const& token) {
+        if (!_isLastIndex) {
+          if (!_alreadyReturned.emplace(token.id()).second) {
+            return;
+          }
+        } else if (_alreadyReturned.find(token.id()) != _alreadyReturned.end()) {
+          return;
+        }
+        ++_returned;
+      }, atMost - _returned);
+      return true;
+    }
+
     uint64_t returned = static_cast<uint64_t>(_returned);
     _cursor->skip(atMost - returned, returned);
     _returned = static_cast<size_t>(returned);
@@ -646,12 +672,14 @@ std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> IndexBlock::getSome(
       }
 
       _documentProducer(_resultInFlight.get(), slice, nrInRegs, _returned, _copyFromRow);
+      storeDocumentId(token);
     };
   } else {
     // No uniqueness checks
-    callback = [this,nrInRegs](LocalDocumentId const&, VPackSlice slice) {
+    callback = [this,nrInRegs](LocalDocumentId const& token, VPackSlice slice) {
       TRI_ASSERT(_resultInFlight != nullptr);
       _documentProducer(_resultInFlight.get(), slice, nrInRegs, _returned, _copyFromRow);
+      storeDocumentId(token);
     };
   }
 
@@ -662,7 +690,7 @@ std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> IndexBlock::getSome(
         break;
       }
 
-      size_t toFetch = (std::min)(DefaultBatchSize(), atMost);
+      size_t toFetch = (std::min)(upstreamBatchSize(), atMost);
       ExecutionState state;
       bool blockAppended;
       std::tie(state, blockAppended) = ExecutionBlock::getBlock(toFetch);
@@ -692,7 +720,7 @@ std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> IndexBlock::getSome(
         ExecutionState state;
         bool blockAppended;
         std::tie(state, blockAppended) =
-            ExecutionBlock::getBlock(DefaultBatchSize());
+            ExecutionBlock::getBlock(upstreamBatchSize());
         if (state == ExecutionState::WAITING) {
           TRI_ASSERT(!blockAppended);
           traceGetSomeEnd(_resultInFlight.get(), ExecutionState::WAITING);
@@ -777,7 +805,7 @@ std::pair<ExecutionState, size_t> IndexBlock::skipSome(size_t atMost) {
 
   while (_returned < atMost) {
     if (_buffer.empty()) {
-      size_t toFetch = (std::min)(DefaultBatchSize(), atMost);
+      size_t toFetch = (std::min)(upstreamBatchSize(), atMost);
       ExecutionState state;
       bool blockAppended;
       std::tie(state, blockAppended) = ExecutionBlock::getBlock(toFetch);
@@ -802,7 +830,7 @@ std::pair<ExecutionState, size_t> IndexBlock::skipSome(size_t atMost) {
       if (_buffer.empty()) {
         ExecutionState state;
         bool blockAppended;
-        std::tie(state, blockAppended) = ExecutionBlock::getBlock(DefaultBatchSize());
+        std::tie(state, blockAppended) = ExecutionBlock::getBlock(upstreamBatchSize());
         if (state == ExecutionState::WAITING) {
           TRI_ASSERT(!blockAppended);
           return {ExecutionState::WAITING, 0};
@@ -840,6 +868,18 @@ void IndexBlock::cleanupNonConstExpressions() {
   _nonConstExpressions.clear();
 }
 
+/// @brief write the id of the document just produced into the document id
+/// register, if late materialization is used
+void IndexBlock::storeDocumentId(LocalDocumentId const& token) {
+  if (_docIdRegister == ExecutionNode::MaxRegisterId) {
+    return;
+  }
+  // the document producer has already advanced _returned
+  TRI_ASSERT(_returned > 0);
+  _resultInFlight->emplaceValue(_returned - 1, _docIdRegister,
+                                AqlValueHintUInt(token.id()));
+}
+
 /// @brief order a cursor for the index at the specified position
 arangodb::OperationCursor* IndexBlock::orderCursor(size_t currentIndex) {
   AstNode const* conditionNode = nullptr;
@@ -858,9 +898,26 @@ arangodb::OperationCursor* IndexBlock::orderCursor(size_t currentIndex) {
   if (!_nonConstExpressions.empty() || _cursors[currentIndex] == nullptr) {
     // yet no cursor for index, so create it
     IndexNode const* node = ExecutionNode::castTo<IndexNode const*>(getPlanNode());
-    _cursors[currentIndex].reset(_trx->indexScanForCondition(
-        _indexes[currentIndex], conditionNode, node->outVariable(), _mmdr.get(),
-        node->_options));
+    auto const& intersectionIndexes = node->getIntersectionIndexes();
+    if (intersectionIndexes.empty()) {
+      _cursors[currentIndex].reset(_trx->indexScanForCondition(
+          _indexes[currentIndex], conditionNode, node->outVariable(),
+          _mmdr.get(), node->_options));
+    } else {
+      // the results of the index are intersected with the results of the
+      // other indexes
+      TRI_ASSERT(_indexes.size() == 1);
+      std::vector<transaction::Methods::IndexHandle> indexes{_indexes[currentIndex]};
+      std::vector<AstNode const*> conditions{conditionNode};
+      AstNode const* intersectionCondition = node->intersectionCondition();
+      for (size_t i = 0; i < intersectionIndexes.size(); ++i) {
+        indexes.emplace_back(intersectionIndexes[i]);
+        conditions.emplace_back(intersectionCondition->getMember(i));
+      }
+      _cursors[currentIndex].reset(_trx->indexScanForIntersection(
+          indexes, conditions, node->outVariable(), _mmdr.get(),
+          node->_options));
+    }
   } else {
     // cursor for index already exists, reset and reuse it
     _cursors[currentIndex]->reset();
@@ -100,6 +100,10 @@ class IndexBlock final : public ExecutionBlock, public DocumentProducingBlock {
   /// @brief frees the memory for all non-constant expressions
   void cleanupNonConstExpressions();
 
+  /// @brief write the id of the document just produced into the document id
+  /// register, if late materialization is used
+  void storeDocumentId(LocalDocumentId const& token);
+
   /// @brief order a cursor for the index at the specified position
   OperationCursor* orderCursor(size_t currentIndex);
 
@@ -168,6 +172,10 @@ class IndexBlock final : public ExecutionBlock, public DocumentProducingBlock {
   ///        Needs to be 0 after we return a result.
   size_t _copyFromRow;
 
+  /// @brief register the document ids are written to for late materialization,
+  /// MaxRegisterId if the full documents are produced right away
+  RegisterId _docIdRegister;
+
   /// @brief Capture of all results that are produced before the last WAITING call.
   ///        Needs to be nullptr after it got returned.
   std::unique_ptr<AqlItemBlock> _resultInFlight;
@@ -23,6 +23,7 @@
 
 #include "IndexNode.h"
 #include "Aql/Ast.h"
+#include "Aql/AstNode.h"
 #include "Aql/Collection.h"
 #include "Aql/Condition.h"
 #include "Aql/ExecutionPlan.h"
@@ -49,8 +50,10 @@ IndexNode::IndexNode(ExecutionPlan* plan, size_t id,
         CollectionAccessingNode(collection),
         _indexes(indexes),
         _condition(std::move(condition)),
+        _intersectionCondition(nullptr),
         _needsGatherNodeSort(false),
-        _options(opts) {
+        _options(opts),
+        _docIdVariable(nullptr) {
   TRI_ASSERT(_condition != nullptr);
 
   initIndexCoversProjections();
@@ -62,8 +65,10 @@ IndexNode::IndexNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& bas
       DocumentProducingNode(plan, base),
       CollectionAccessingNode(plan, base),
       _indexes(),
+      _intersectionCondition(nullptr),
       _needsGatherNodeSort(basics::VelocyPackHelper::readBooleanValue(base, "needsGatherNodeSort", false)),
-      _options() {
+      _options(),
+      _docIdVariable(Variable::varFromVPack(plan->getAst(), base, "docIdVariable", true)) {
 
   _options.sorted = basics::VelocyPackHelper::readBooleanValue(base, "sorted", true);
   _options.ascending = basics::VelocyPackHelper::readBooleanValue(base, "ascending", false);
@@ -100,6 +105,20 @@ IndexNode::IndexNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& bas
 
   TRI_ASSERT(_condition != nullptr);
 
+  VPackSlice intersectionIndexes = base.get("intersectionIndexes");
+  if (intersectionIndexes.isArray() && intersectionIndexes.length() > 0) {
+    VPackSlice intersectionCondition = base.get("intersectionCondition");
+    if (!intersectionCondition.isObject()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER, "\"intersectionCondition\" attribute should be an object");
+    }
+    for (VPackSlice it : VPackArrayIterator(intersectionIndexes)) {
+      std::string iid  = it.get("id").copyString();
+      _intersectionIndexes.emplace_back(trx->getIndexByIdentifier(_collection->name(), iid));
+    }
+    // note: the AST is responsible for freeing the AstNode later!
+    _intersectionCondition = new AstNode(plan->getAst(), intersectionCondition);
+  }
+
   initIndexCoversProjections();
 }
 
@@ -125,7 +144,7 @@ void IndexNode::initIndexCoversProjections() {
   // note that we made sure that if we have multiple index instances, they
   // are actually all of the same index
 
-  auto const& fields = idx->fields();
+  auto const& fields = idx->coveredFields();
 
   if (!idx->hasCoveringIterator()) {
     // index does not have a covering index iterator
@@ -162,6 +181,19 @@ void IndexNode::initIndexCoversProjections() {
   _coveringIndexAttributePositions = std::move(coveringAttributePositions);
 }
 
+/// @brief intersect the results of the node's single index with the results
+/// of further indexes for other parts of the filter condition
+void IndexNode::setIntersection(
+    std::vector<transaction::Methods::IndexHandle> const& indexes,
+    AstNode* condition) {
+  TRI_ASSERT(_indexes.size() == 1);
+  TRI_ASSERT(indexes.empty() ||
+             (condition != nullptr && condition->numMembers() == indexes.size()));
+
+  _intersectionIndexes = indexes;
+  _intersectionCondition = indexes.empty() ? nullptr : condition;
+}
+
 /// @brief toVelocyPack, for IndexNode
 void IndexNode::toVelocyPackHelper(VPackBuilder& builder, unsigned flags) const {
   // call base class method
@@ -186,6 +218,17 @@ void IndexNode::toVelocyPackHelper(VPackBuilder& builder, unsigned flags) const
   }
   builder.add(VPackValue("condition"));
   _condition->toVelocyPack(builder, flags);
+  if (!_intersectionIndexes.empty()) {
+    builder.add(VPackValue("intersectionIndexes"));
+    {
+      VPackArrayBuilder guard(&builder);
+      for (auto& index : _intersectionIndexes) {
+        index.toVelocyPack(builder, false);
+      }
+    }
+    builder.add(VPackValue("intersectionCondition"));
+    _intersectionCondition->toVelocyPack(builder, flags != 0);
+  }
   // IndexIteratorOptions
   builder.add("sorted", VPackValue(_options.sorted));
   builder.add("ascending", VPackValue(_options.ascending));
@@ -194,6 +237,11 @@ void IndexNode::toVelocyPackHelper(VPackBuilder& builder, unsigned flags) const
   builder.add("fullRange", VPackValue(_options.fullRange));
   builder.add("limit", VPackValue(_options.limit));
 
+  if (_docIdVariable != nullptr) {
+    builder.add(VPackValue("docIdVariable"));
+    _docIdVariable->toVelocyPack(builder);
+  }
+
   // And close it:
   builder.close();
 }
@@ -209,9 +257,13 @@ std::unique_ptr<ExecutionBlock> IndexNode::createBlock(
 ExecutionNode* IndexNode::clone(ExecutionPlan* plan, bool withDependencies,
                                 bool withProperties) const {
   auto outVariable = _outVariable;
+  auto docIdVariable = _docIdVariable;
 
   if (withProperties) {
     outVariable = plan->getAst()->variables()->createVariable(outVariable);
+    if (docIdVariable != nullptr) {
+      docIdVariable = plan->getAst()->variables()->createVariable(docIdVariable);
+    }
   }
 
   auto c = std::make_unique<IndexNode>(plan, _id,  _collection, outVariable,
@@ -219,6 +271,11 @@ ExecutionNode* IndexNode::clone(ExecutionPlan* plan, bool withDependencies,
 
   c->projections(_projections);
   c->needsGatherNodeSort(_needsGatherNodeSort);
+  c->setDocIdVariable(docIdVariable);
+  if (!_intersectionIndexes.empty()) {
+    c->setIntersection(_intersectionIndexes,
+                       _intersectionCondition->clone(plan->getAst()));
+  }
   c->initIndexCoversProjections();
 
   return cloneHelper(std::move(c), withDependencies, withProperties);
@@ -262,6 +319,25 @@ double IndexNode::estimateCost(size_t& nrItems) const {
     }
   }
 
+  // each intersection index is read completely, and lets only a share of
+  // the documents pass
+  for (size_t i = 0; i < _intersectionIndexes.size(); ++i) {
+    double estimatedCost = 0.0;
+    size_t estimatedItems = 0;
+
+    if (itemsInCollection > 0 &&
+        trx->supportsFilterCondition(_intersectionIndexes[i],
+                                     _intersectionCondition->getMember(i),
+                                     _outVariable, itemsInCollection,
+                                     estimatedItems, estimatedCost)) {
+      totalItems = static_cast<size_t>(
+          static_cast<double>(totalItems) *
+          (std::min)(1.0, static_cast<double>(estimatedItems) /
+                              static_cast<double>(itemsInCollection)));
+      totalCost += estimatedCost;
+    }
+  }
+
   nrItems = incoming * totalItems;
   return dependencyCost + incoming * totalCost;
 }
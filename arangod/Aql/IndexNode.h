@@ -41,6 +41,7 @@
 namespace arangodb {
 
 namespace aql {
+struct AstNode;
 struct Collection;
 class Condition;
 class ExecutionBlock;
@@ -97,6 +98,9 @@ class IndexNode : public ExecutionNode, public DocumentProducingNode, public Col
 
   /// @brief getVariablesSetHere
   std::vector<Variable const*> getVariablesSetHere() const override final {
+    if (_docIdVariable != nullptr) {
+      return std::vector<Variable const*>{_outVariable, _docIdVariable};
+    }
     return std::vector<Variable const*>{_outVariable};
   }
 
@@ -113,10 +117,32 @@ class IndexNode : public ExecutionNode, public DocumentProducingNode, public Col
   /// @brief getIndexes, hand out the indexes used
   std::vector<transaction::Methods::IndexHandle> const& getIndexes() const { return _indexes; }
 
+  /// @brief the additional indexes whose results are intersected with the
+  /// results of the node's single index
+  std::vector<transaction::Methods::IndexHandle> const& getIntersectionIndexes() const {
+    return _intersectionIndexes;
+  }
+
+  /// @brief the conditions of the intersection indexes, an n-ary OR with one
+  /// n-ary AND per intersection index. nullptr if there are none
+  AstNode const* intersectionCondition() const { return _intersectionCondition; }
+
+  /// @brief intersect the results of the node's single index with the results
+  /// of further indexes for other parts of the filter condition
+  void setIntersection(std::vector<transaction::Methods::IndexHandle> const& indexes,
+                       AstNode* condition);
+
   /// @brief called to build up the matching positions of the index values for
   /// the projection attributes (if any)
   void initIndexCoversProjections();
 
+  /// @brief the variable the ids of the found documents are written to for
+  /// late materialization, nullptr if the node produces documents as usual
+  Variable const* docIdVariable() const { return _docIdVariable; }
+
+  /// @brief turn on late materialization
+  void setDocIdVariable(Variable const* value) { _docIdVariable = value; }
+
  private:
   /// @brief the index
   std::vector<transaction::Methods::IndexHandle> _indexes;
@@ -124,11 +150,22 @@ class IndexNode : public ExecutionNode, public DocumentProducingNode, public Col
   /// @brief the index(es) condition
   std::unique_ptr<Condition> _condition;
 
+  /// @brief the additional indexes whose results are intersected with the
+  /// results of the index
+  std::vector<transaction::Methods::IndexHandle> _intersectionIndexes;
+
+  /// @brief the conditions of the intersection indexes
+  AstNode* _intersectionCondition;
+
   /// @brief the index sort order - this is the same order for all indexes
   bool _needsGatherNodeSort;
 
   /// @brief the index iterator options - same for all indexes
   IndexIteratorOptions _options;
+
+  /// @brief output variable for the document ids, if late materialization
+  /// is used
+  Variable const* _docIdVariable;
 };
 
 }  // namespace arangodb::aql
@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "MaterializeBlock.h"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/AqlValue.h"
+#include "Aql/Collection.h"
+#include "Aql/ExecutionEngine.h"
+#include "Basics/Exceptions.h"
+#include "StorageEngine/EngineSelectorFeature.h"
+#include "StorageEngine/StorageEngine.h"
+#include "VocBase/LocalDocumentId.h"
+#include "VocBase/LogicalCollection.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+MaterializeBlock::MaterializeBlock(ExecutionEngine* engine, MaterializeNode const* ep)
+    : ExecutionBlock(engine, ep),
+      _collection(ep->collection()),
+      _docIdRegister(ExecutionNode::MaxRegisterId),
+      _outRegister(ExecutionNode::MaxRegisterId),
+      _useRawDocumentPointers(EngineSelectorFeature::ENGINE->useRawDocumentPointers()) {
+  auto const& varInfo = ep->getRegisterPlan()->varInfo;
+
+  auto it = varInfo.find(ep->docIdVariable()->id);
+  if (it == varInfo.end()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "variable not found");
+  }
+  _docIdRegister = (*it).second.registerId;
+  TRI_ASSERT(_docIdRegister < ExecutionNode::MaxRegisterId);
+
+  it = varInfo.find(ep->outVariable()->id);
+  if (it == varInfo.end()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "variable not found");
+  }
+  _outRegister = (*it).second.registerId;
+  TRI_ASSERT(_outRegister < ExecutionNode::MaxRegisterId);
+}
+
+/// @brief replace the values in the out register with the full documents
+void MaterializeBlock::materialize(AqlItemBlock* result) {
+  TRI_ASSERT(result != nullptr);
+
+  auto logical = _collection->getCollection();
+  size_t const n = result->size();
+
+  for (size_t i = 0; i < n; ++i) {
+    throwIfKilled();  // check if we were aborted
+
+    AqlValue const& id = result->getValueReference(i, _docIdRegister);
+    LocalDocumentId const token(static_cast<LocalDocumentId::BaseType>(id.toInt64(_trx)));
+
+    bool found = logical->readDocumentWithCallback(_trx, token, [&](LocalDocumentId const&, VPackSlice slice) {
+      // the out register only holds the projected attributes so far
+      result->destroyValue(i, _outRegister);
+      if (_useRawDocumentPointers) {
+        result->emplaceValue(i, _outRegister, AqlValueHintDocumentNoCopy(slice.begin()));
+      } else {
+        result->emplaceValue(i, _outRegister, AqlValueHintCopy(slice.begin()));
+      }
+    });
+
+    if (!found) {
+      // the document was produced by the index in the same transaction,
+      // so it must still be there
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND,
+                                     "could not materialize document");
+    }
+  }
+}
+
+std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>>
+MaterializeBlock::getSome(size_t atMost) {
+  DEBUG_BEGIN_BLOCK();
+  traceGetSomeBegin(atMost);
+
+  if (_done) {
+    return {ExecutionState::DONE, nullptr};
+  }
+
+  auto res = ExecutionBlock::getSomeWithoutRegisterClearout(atMost);
+  if (res.first == ExecutionState::WAITING) {
+    return res;
+  }
+  if (res.second == nullptr) {
+    TRI_ASSERT(res.first == ExecutionState::DONE);
+    traceGetSomeEnd(nullptr, res.first);
+    return res;
+  }
+
+  materialize(res.second.get());
+  // Clear out registers no longer needed later:
+  clearRegisters(res.second.get());
+  traceGetSomeEnd(res.second.get(), res.first);
+  return res;
+
+  // cppcheck-suppress *
+  DEBUG_END_BLOCK();
+}
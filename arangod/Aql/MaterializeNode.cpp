@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "MaterializeNode.h"
+#include "Aql/Ast.h"
+#include "Aql/Collection.h"
+#include "Aql/ExecutionPlan.h"
+#include "Aql/MaterializeBlock.h"
+#include "Aql/Variable.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+MaterializeNode::MaterializeNode(ExecutionPlan* plan, size_t id,
+                                 aql::Collection const* collection,
+                                 Variable const* docIdVariable,
+                                 Variable const* outVariable)
+    : ExecutionNode(plan, id),
+      CollectionAccessingNode(collection),
+      _docIdVariable(docIdVariable),
+      _outVariable(outVariable) {
+  TRI_ASSERT(_docIdVariable != nullptr);
+  TRI_ASSERT(_outVariable != nullptr);
+}
+
+MaterializeNode::MaterializeNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& base)
+    : ExecutionNode(plan, base),
+      CollectionAccessingNode(plan, base),
+      _docIdVariable(Variable::varFromVPack(plan->getAst(), base, "docIdVariable")),
+      _outVariable(Variable::varFromVPack(plan->getAst(), base, "outVariable")) {}
+
+/// @brief toVelocyPack, for MaterializeNode
+void MaterializeNode::toVelocyPackHelper(VPackBuilder& builder, unsigned flags) const {
+  // call base class method
+  ExecutionNode::toVelocyPackHelperGeneric(builder, flags);
+
+  // add collection information
+  CollectionAccessingNode::toVelocyPack(builder);
+
+  builder.add(VPackValue("docIdVariable"));
+  _docIdVariable->toVelocyPack(builder);
+  builder.add(VPackValue("outVariable"));
+  _outVariable->toVelocyPack(builder);
+
+  // And close it:
+  builder.close();
+}
+
+/// @brief creates corresponding ExecutionBlock
+std::unique_ptr<ExecutionBlock> MaterializeNode::createBlock(
+    ExecutionEngine& engine,
+    std::unordered_map<ExecutionNode*, ExecutionBlock*> const&
+) const {
+  return std::make_unique<MaterializeBlock>(&engine, this);
+}
+
+/// @brief clone ExecutionNode recursively
+ExecutionNode* MaterializeNode::clone(ExecutionPlan* plan, bool withDependencies,
+                                      bool withProperties) const {
+  auto docIdVariable = _docIdVariable;
+  auto outVariable = _outVariable;
+
+  if (withProperties) {
+    docIdVariable = plan->getAst()->variables()->createVariable(docIdVariable);
+    outVariable = plan->getAst()->variables()->createVariable(outVariable);
+  }
+
+  auto c = std::make_unique<MaterializeNode>(plan, _id, _collection,
+                                             docIdVariable, outVariable);
+
+  return cloneHelper(std::move(c), withDependencies, withProperties);
+}
+
+/// @brief the cost of a materialize node is one document lookup per
+/// incoming row
+double MaterializeNode::estimateCost(size_t& nrItems) const {
+  size_t incoming;
+  TRI_ASSERT(!_dependencies.empty());
+  double depCost = _dependencies.at(0)->getCost(incoming);
+  nrItems = incoming;
+  return depCost + incoming;
+}
@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef ARANGOD_AQL_MATERIALIZE_NODE_H
+#define ARANGOD_AQL_MATERIALIZE_NODE_H 1
+
+#include "Basics/Common.h"
+#include "Aql/CollectionAccessingNode.h"
+#include "Aql/ExecutionNode.h"
+#include "Aql/types.h"
+
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+namespace aql {
+struct Collection;
+class ExecutionBlock;
+class ExecutionEngine;
+class ExecutionPlan;
+struct Variable;
+
+/// @brief class MaterializeNode
+/// fetches the full documents for document ids produced by an IndexNode in
+/// late materialization mode. the documents replace the (projected) values of
+/// the IndexNode's out variable in place, so that all nodes following this
+/// node get to see the full documents
+class MaterializeNode : public ExecutionNode, public CollectionAccessingNode {
+  friend class ExecutionBlock;
+  friend class MaterializeBlock;
+
+ public:
+  MaterializeNode(ExecutionPlan* plan, size_t id,
+                  aql::Collection const* collection,
+                  Variable const* docIdVariable, Variable const* outVariable);
+
+  MaterializeNode(ExecutionPlan*, arangodb::velocypack::Slice const& base);
+
+  /// @brief return the type of the node
+  NodeType getType() const override final { return MATERIALIZE; }
+
+  /// @brief export to VelocyPack
+  void toVelocyPackHelper(arangodb::velocypack::Builder&,
+                          unsigned flags) const override final;
+
+  /// @brief creates corresponding ExecutionBlock
+  std::unique_ptr<ExecutionBlock> createBlock(
+    ExecutionEngine& engine,
+    std::unordered_map<ExecutionNode*, ExecutionBlock*> const&
+  ) const override;
+
+  /// @brief clone ExecutionNode recursively
+  ExecutionNode* clone(ExecutionPlan* plan, bool withDependencies,
+                       bool withProperties) const override final;
+
+  /// @brief getVariablesUsedHere, returning a vector
+  std::vector<Variable const*> getVariablesUsedHere() const override final {
+    return std::vector<Variable const*>{_docIdVariable, _outVariable};
+  }
+
+  /// @brief getVariablesUsedHere, modifying the set in-place
+  void getVariablesUsedHere(
+      std::unordered_set<Variable const*>& vars) const override final {
+    vars.emplace(_docIdVariable);
+    vars.emplace(_outVariable);
+  }
+
+  /// @brief the cost of a materialize node is one document lookup per
+  /// incoming row
+  double estimateCost(size_t&) const override final;
+
+  /// @brief the variable holding the document ids
+  Variable const* docIdVariable() const { return _docIdVariable; }
+
+  /// @brief the variable whose values are replaced with the full documents
+  Variable const* outVariable() const { return _outVariable; }
+
+ private:
+  /// @brief the variable holding the document ids
+  Variable const* _docIdVariable;
+
+  /// @brief the variable whose values are replaced with the full documents
+  Variable const* _outVariable;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
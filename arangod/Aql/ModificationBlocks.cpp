@@ -84,6 +84,47 @@ size_t ModificationBlock::countBlocksRows() const {
   return count;
 }
 
+/// @brief merge adjacent input blocks into blocks of up to atMost rows
+void ModificationBlock::coalesceBlocks(size_t atMost) {
+  if (_blocks.size() <= 1) {
+    return;
+  }
+
+  std::vector<std::unique_ptr<AqlItemBlock>> coalesced;
+  std::vector<AqlItemBlock*> group;
+
+  size_t i = 0;
+  while (i < _blocks.size()) {
+    // find the range of blocks that fits into a single block
+    size_t end = i;
+    size_t rows = 0;
+    while (end < _blocks.size() &&
+           (end == i || rows + _blocks[end]->size() <= atMost)) {
+      rows += _blocks[end]->size();
+      ++end;
+    }
+
+    if (end - i == 1) {
+      coalesced.emplace_back(std::move(_blocks[i]));
+    } else {
+      group.clear();
+      for (size_t j = i; j < end; ++j) {
+        group.emplace_back(_blocks[j].get());
+      }
+      coalesced.emplace_back(AqlItemBlock::concatenate(
+          _engine->_itemBlockManager.resourceMonitor(), group));
+      // the values are now owned by the concatenated block
+      for (size_t j = i; j < end; ++j) {
+        AqlItemBlock* block = _blocks[j].release();
+        returnBlock(block);
+      }
+    }
+    i = end;
+  }
+
+  _blocks = std::move(coalesced);
+}
+
 ExecutionState ModificationBlock::getHasMoreState() {
   // In these blocks everything from upstream
   // is entirely processed in one go.
@@ -129,25 +170,37 @@ ModificationBlock::getSome(size_t atMost) {
     }
 
     // now apply the modifications for the complete input
+    coalesceBlocks(atMost);
     replyBlocks = work();
     _blocks.clear();
   } else {
     // read input in chunks, and process it in chunks
-    // this reduces the amount of memory used for storing the input
+    // this reduces the amount of memory used for storing the input.
+    // upstream may hand out smaller blocks than requested, so we collect
+    // up to atMost rows before applying the modifications in one go
     while (_upstreamState == ExecutionState::HASMORE) {
-      auto upstreamRes = ExecutionBlock::getSomeWithoutRegisterClearout(atMost);
-      if (upstreamRes.first == ExecutionState::WAITING) {
-        traceGetSomeEnd(nullptr, ExecutionState::WAITING);
-        return upstreamRes;
-      }
+      size_t const buffered = countBlocksRows();
+      if (buffered < atMost) {
+        auto upstreamRes = ExecutionBlock::getSomeWithoutRegisterClearout(atMost - buffered);
+        if (upstreamRes.first == ExecutionState::WAITING) {
+          // the buffered blocks are kept for the next call
+          traceGetSomeEnd(nullptr, ExecutionState::WAITING);
+          return upstreamRes;
+        }
 
-      _upstreamState = upstreamRes.first;
+        _upstreamState = upstreamRes.first;
 
-      if (upstreamRes.second != nullptr) {
-        _blocks.emplace_back(std::move(upstreamRes.second));
-        TRI_IF_FAILURE("ModificationBlock::getSome") {
-          THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+        if (upstreamRes.second != nullptr) {
+          _blocks.emplace_back(std::move(upstreamRes.second));
+          TRI_IF_FAILURE("ModificationBlock::getSome") {
+            THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+          }
         }
+      }
+
+      if (!_blocks.empty() &&
+          (countBlocksRows() >= atMost || _upstreamState == ExecutionState::DONE)) {
+        coalesceBlocks(atMost);
         replyBlocks = work();
         _blocks.clear();
         if (replyBlocks != nullptr) {
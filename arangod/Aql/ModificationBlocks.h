@@ -68,6 +68,11 @@ class ModificationBlock : public ExecutionBlock {
   /// @brief determine the number of rows in a vector of blocks
   size_t countBlocksRows() const;
 
+  /// @brief merge adjacent input blocks into blocks of up to atMost rows, so
+  /// that work() can hand each of them to the transaction in a single
+  /// multi-document operation
+  void coalesceBlocks(size_t atMost);
+
   /// @brief Returns the success return start of this block.
   ///        Can either be HASMORE or DONE.
   ///        Guarantee is that if DONE is returned every subsequent call
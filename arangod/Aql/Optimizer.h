@@ -170,6 +170,10 @@ class Optimizer {
 
   void disableRule(int rule);
 
+  bool isDisabledRule(int rule) const {
+    return _disabledIds.find(rule) != _disabledIds.end();
+  }
+
   /// @brief getBest, ownership of the plan remains with the optimizer
   ExecutionPlan* getBest() {
     if (_plans.empty()) {
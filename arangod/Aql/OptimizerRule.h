@@ -150,6 +150,10 @@ struct OptimizerRule {
     // replace FULLTEXT with index
     applyFulltextIndexRule_pass6,
 
+    // create plans in which a sorted COLLECT is fed by a sorted index
+    // instead of a SORT
+    useIndexForCollectRule_pass6,
+
     useIndexesRule_pass6,
 
     // try to remove filters covered by index ranges
@@ -163,6 +167,10 @@ struct OptimizerRule {
     // sort values used in IN comparisons of remaining filters
     sortInValuesRule_pass6,
 
+    // replace full collection scans in inner loops that are joined by
+    // an equality condition with a hash join
+    hashJoinRule_pass6,
+
     // merge filters into graph traversals
     optimizeTraversalsRule_pass6,
     // remove redundant filters statements
@@ -187,6 +195,13 @@ struct OptimizerRule {
     /// Pass 9: patch update statements
     patchUpdateStatementsRule_pass9,
 
+    /// Pass 9: only keep the top rows in SORT nodes that are followed by
+    /// a LIMIT
+    sortLimitRule_pass9,
+
+    /// Pass 9: mark collection scans that read the entire collection once
+    fullCollectionScanRule_pass9,
+
     /// "Pass 10": final transformations for the cluster
 
     // optimize queries in the cluster so that the entire query
@@ -240,6 +255,10 @@ struct OptimizerRule {
     // simplify an EnumerationCollectionNode that fetches an
     // entire document to a projection of this document
     reduceExtractionToProjectionRule_pass10,
+
+    // fetch only document ids and covered attributes from an index for
+    // SORT/LIMIT and materialize the documents after the LIMIT
+    lateDocumentMaterializationRule_pass10,
   };
 
   std::string name;
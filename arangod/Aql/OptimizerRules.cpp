@@ -33,6 +33,7 @@
 #include "Aql/ExecutionNode.h"
 #include "Aql/ExecutionPlan.h"
 #include "Aql/Function.h"
+#include "Aql/HashJoinNode.h"
 #include "Aql/IndexNode.h"
 #include "Aql/ModificationNodes.h"
 #include "Aql/Optimizer.h"
@@ -53,6 +54,8 @@
 #include "GeoIndex/Index.h"
 #include "Graph/TraverserOptions.h"
 #include "Indexes/Index.h"
+#include "StorageEngine/EngineSelectorFeature.h"
+#include "StorageEngine/StorageEngine.h"
 #include "Transaction/Methods.h"
 #include "VocBase/Methods/Collections.h"
 
@@ -1178,6 +1181,7 @@ void arangodb::aql::moveCalculationsDownRule(
         shouldMove = true;
       } else if (currentType == EN::INDEX ||
                  currentType == EN::ENUMERATE_COLLECTION ||
+                 currentType == EN::HASH_JOIN ||
                  currentType == EN::ENUMERATE_LIST ||
                  currentType == EN::TRAVERSAL ||
                  currentType == EN::SHORTEST_PATH ||
@@ -2389,6 +2393,74 @@ void arangodb::aql::useIndexForSortRule(Optimizer* opt,
   opt->addPlan(std::move(plan), rule, modified);
 }
 
+/// @brief try to feed a sorted COLLECT directly from a sorted index, so the
+/// SortNode in front of the COLLECT becomes unnecessary. if the collection
+/// scan is followed by a FILTER, use-indexes may later pick a different index
+/// for the FILTER, so that use-index-for-sort cannot remove the SortNode
+/// anymore. so for these cases an additional plan is created that uses the
+/// index for the order of the COLLECT, and the cheaper of both plans wins
+void arangodb::aql::useIndexForCollectRule(Optimizer* opt,
+                                           std::unique_ptr<ExecutionPlan> plan,
+                                           OptimizerRule const* rule) {
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::COLLECT, true);
+
+  // ids of the COLLECT nodes that may be fed by an index
+  std::vector<size_t> candidates;
+
+  for (auto const& n : nodes) {
+    auto collectNode = ExecutionNode::castTo<CollectNode*>(n);
+
+    if (collectNode->aggregationMethod() !=
+            CollectOptions::CollectMethod::SORTED ||
+        collectNode->groupVariables().empty()) {
+      continue;
+    }
+
+    auto dep = collectNode->getFirstDependency();
+    if (dep == nullptr || dep->getType() != EN::SORT) {
+      continue;
+    }
+
+    bool hasFilter = false;
+    ExecutionNode* current = dep->getFirstDependency();
+    while (current != nullptr && (current->getType() == EN::CALCULATION ||
+                                  current->getType() == EN::FILTER)) {
+      if (current->getType() == EN::FILTER) {
+        hasFilter = true;
+      }
+      current = current->getFirstDependency();
+    }
+
+    if (hasFilter && current != nullptr &&
+        current->getType() == EN::ENUMERATE_COLLECTION &&
+        !current->isInInnerLoop()) {
+      // without a FILTER, use-index-for-sort will find the same plan
+      candidates.emplace_back(collectNode->id());
+    }
+  }
+
+  for (auto const& id : candidates) {
+    std::unique_ptr<ExecutionPlan> newPlan(plan->clone());
+
+    auto collectNode = newPlan->getNodeById(id);
+    TRI_ASSERT(collectNode != nullptr);
+    auto sortNode = collectNode->getFirstDependency();
+    TRI_ASSERT(sortNode != nullptr && sortNode->getType() == EN::SORT);
+
+    SortToIndexNode finder(newPlan.get());
+    sortNode->walk(finder);
+
+    if (collectNode->getFirstDependency()->getType() != EN::SORT) {
+      // the index delivers the documents in the order of the COLLECT
+      opt->addPlan(std::move(newPlan), rule, true);
+    }
+  }
+
+  opt->addPlan(std::move(plan), rule, false);
+}
+
 /// @brief try to remove filters which are covered by indexes
 void arangodb::aql::removeFiltersCoveredByIndexRule(
     Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
@@ -2660,56 +2732,78 @@ void arangodb::aql::optimizeClusterSingleShardRule(Optimizer* opt,
                                                    std::unique_ptr<ExecutionPlan> plan,
                                                    OptimizerRule const* rule) {
   TRI_ASSERT(arangodb::ServerState::instance()->isCoordinator());
-  bool wasModified = false;
-  bool done = false;
+
+  // all plans get here in the same round of the optimizer. the first one
+  // decides for all of them, because the rule turns off the other cluster
+  // rules, which the remaining plans would need
+  bool const decided = opt->isDisabledRule(OptimizerRule::scatterInClusterRule_pass10);
 
   std::unordered_set<std::string> responsibleServers;
   auto collections = plan->getAst()->query()->collections();
+  bool qualifies = !collections->empty();
 
   for (auto const& it : *(collections->collections())) {
     Collection* c = it.second;
     TRI_ASSERT(c != nullptr);
 
-    if (c->numberOfShards() != 1) {
-      // more than one shard for this collection
-      done = true;
+    if (c->numberOfShards() != 1 || c->responsibleServers(responsibleServers) != 1) {
+      // more than one shard or more than one responsible server for this collection
+      qualifies = false;
       break;
     }
+  }
 
-    size_t n = c->responsibleServers(responsibleServers);
+  if (qualifies && responsibleServers.size() != 1) {
+    // the collections are not all on the same server. with one shard each,
+    // this is the case unless they use distributeShardsLike
+    qualifies = false;
+  }
 
-    if (n != 1) {
-      // more than one responsible server for this collection
-      done = true;
-      break;
+  if (qualifies) {
+    // the snippet for the DB server is a plain chain of nodes, without
+    // subqueries, graph operations or views, which need the coordinator
+    SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+    SmallVector<ExecutionNode*> nodes{a};
+    plan->findNodesOfType(nodes, {EN::SUBQUERY, EN::TRAVERSAL, EN::SHORTEST_PATH, EN::HASH_JOIN
+#ifdef USE_IRESEARCH
+                                  , EN::ENUMERATE_IRESEARCH_VIEW
+#endif
+                                 }, true);
+    qualifies = nodes.empty();
+
+    if (qualifies) {
+      // calculations must not call V8 or access collections by name
+      nodes.clear();
+      plan->findNodesOfType(nodes, EN::CALCULATION, true);
+      for (auto const& n : nodes) {
+        if (!ExecutionNode::castTo<CalculationNode const*>(n)->expression()->canRunOnDBServer()) {
+          qualifies = false;
+          break;
+        }
+      }
+    }
+
+    if (qualifies) {
+      nodes.clear();
+      plan->findNodesOfType(nodes, {EN::ENUMERATE_COLLECTION, EN::INDEX, EN::INSERT,
+                                    EN::UPDATE, EN::REPLACE, EN::REMOVE, EN::UPSERT}, true);
+      qualifies = !nodes.empty();
     }
   }
 
-  if (done || responsibleServers.size() != 1) {
-    opt->addPlan(std::move(plan), rule, wasModified);
+  if (!qualifies) {
+    if (decided) {
+      // another plan of this query was moved to the DB server already. this
+      // one cannot be, and the rules to distribute it are turned off, so drop it
+      return;
+    }
+    // don't look at the other plans
+    opt->disableRule(OptimizerRule::optimizeClusterSingleShardRule_pass10);
+    opt->addPlan(std::move(plan), rule, false);
     return;
   }
 
-  // we only found a single responsible server, and all collections involved
-  // have exactly one shard
-  // that means we can move the entire query onto that server
-
-
-  // TODO: handle Traversals and ShortestPaths here!
-  // TODO: properly handle subqueries here
-  SmallVector<ExecutionNode*>::allocator_type::arena_type s;
-  SmallVector<ExecutionNode*> nodes{s};
-  // std::vector<ExecutionNode::NodeType> types = {ExecutionNode::TRAVERSAL, ExecutionNode::SHORTEST_PATH, ExecutionNode::SUBQUERY};
-  std::vector<ExecutionNode::NodeType> types = {ExecutionNode::SHORTEST_PATH, ExecutionNode::SUBQUERY};
-  plan->findNodesOfType(nodes, types, true);
-
-  bool hasIncompatibleNodes = !nodes.empty();
-
-  nodes.clear();
-  types = {ExecutionNode::INDEX, ExecutionNode::ENUMERATE_COLLECTION, ExecutionNode::TRAVERSAL};
-  plan->findNodesOfType(nodes, types, false);
-
-  if (!nodes.empty() && !hasIncompatibleNodes) {
+  if (!decided) {
     // turn off all other cluster optimization rules now as they are superfluous
     opt->disableRule(OptimizerRule::optimizeClusterJoinsRule_pass10);
     opt->disableRule(OptimizerRule::distributeInClusterRule_pass10);
@@ -2721,38 +2815,37 @@ void arangodb::aql::optimizeClusterSingleShardRule(Optimizer* opt,
     opt->disableRule(OptimizerRule::removeSatelliteJoinsRule_pass10);
 #endif
     opt->disableRule(OptimizerRule::undistributeRemoveAfterEnumCollRule_pass10);
+    opt->disableRule(OptimizerRule::collectInClusterRule_pass10);
+    opt->disableRule(OptimizerRule::restrictToSingleShardRule_pass10);
+  }
 
-    // get first collection from query
-    Collection const* c = getCollection(nodes[0]);
-    TRI_ASSERT(c != nullptr);
+  // we only found a single responsible server, and all collections involved
+  // have exactly one shard. that means we can move the entire query onto
+  // that server, and the coordinator only receives the final result
+  auto& vocbase = plan->getAst()->query()->vocbase();
+  ExecutionNode* rootNode = plan->root();
 
-    auto& vocbase = plan->getAst()->query()->vocbase();
-    ExecutionNode* rootNode = plan->root();
+  ExecutionNode* remoteNode = new RemoteNode(
+    plan.get(), plan->nextId(), &vocbase, "", "", ""
+  );
+  plan->registerNode(remoteNode);
 
-    // insert a remote node
-    ExecutionNode* remoteNode = new RemoteNode(
-      plan.get(), plan->nextId(), &vocbase, "", "", ""
-    );
+  auto* gatherNode = new GatherNode(
+    plan.get(), plan->nextId(), GatherNode::evaluateSortMode(1)
+  );
+  plan->registerNode(gatherNode);
 
-    plan->registerNode(remoteNode);
+  if (rootNode->getType() == EN::RETURN) {
+    // the RETURN stays on the coordinator, it provides the result register
+    plan->insertDependency(rootNode, remoteNode);
+    plan->insertDependency(rootNode, gatherNode);
+  } else {
     remoteNode->addDependency(rootNode);
-
-    // insert a gather node
-    auto const sortMode = GatherNode::evaluateSortMode(
-      c->numberOfShards()
-    );
-
-    auto* gatherNode = new GatherNode(
-      plan.get(), plan->nextId(), sortMode
-    );
-
-    plan->registerNode(gatherNode);
     gatherNode->addDependency(remoteNode);
     plan->root(gatherNode, true);
-    wasModified = true;
   }
 
-  opt->addPlan(std::move(plan), rule, wasModified);
+  opt->addPlan(std::move(plan), rule, true);
 }
 
 void arangodb::aql::optimizeClusterJoinsRule(Optimizer* opt,
@@ -3405,6 +3498,72 @@ void arangodb::aql::distributeInClusterRule(Optimizer* opt,
   opt->addPlan(std::move(plan), rule, wasModified);
 }
 
+/// @brief check whether the group variables of a COLLECT include all shard
+/// keys of the single collection that is read in the DB server snippet starting
+/// at <node>. if so, every group is produced by exactly one shard, and the
+/// COLLECT can be executed on the DB servers in its entirety
+static bool collectGroupsByShardKeys(ExecutionPlan const* plan,
+                                     CollectNode const* collectNode,
+                                     ExecutionNode const* node) {
+  aql::Collection const* collection = nullptr;
+  Variable const* outVariable = nullptr;
+
+  while (node != nullptr) {
+    auto const type = node->getType();
+    if (type == EN::REMOTE || type == EN::SCATTER ||
+        type == EN::DISTRIBUTE || type == EN::SINGLETON) {
+      // end of snippet
+      break;
+    }
+    if (type == EN::ENUMERATE_COLLECTION || type == EN::INDEX) {
+      if (collection != nullptr) {
+        // more than one collection in the snippet
+        return false;
+      }
+      collection = dynamic_cast<CollectionAccessingNode const*>(node)->collection();
+      outVariable = getVariable(node);
+    } else if (type != EN::CALCULATION && type != EN::FILTER &&
+               type != EN::SORT) {
+      // we do not know whether other node types keep the data shard-local
+      return false;
+    }
+    node = node->getFirstDependency();
+  }
+
+  if (collection == nullptr || collection->isSmart()) {
+    return false;
+  }
+
+  std::unordered_set<std::string> toFind;
+  for (auto const& it : collection->shardKeys()) {
+    if (it.find('.') != std::string::npos) {
+      // shard key containing a "." (sub-attribute). this is not yet supported
+      return false;
+    }
+    toFind.emplace(it);
+  }
+
+  for (auto const& it : collectNode->groupVariables()) {
+    auto setter = plan->getVarSetBy(it.second->id);
+    if (setter == nullptr || setter->getType() != EN::CALCULATION) {
+      continue;
+    }
+    auto* expr = ExecutionNode::castTo<CalculationNode const*>(setter)->expression();
+    AstNode const* n = (expr == nullptr) ? nullptr : expr->node();
+    if (n == nullptr || n->type != NODE_TYPE_ATTRIBUTE_ACCESS) {
+      continue;
+    }
+    AstNode const* ref = n->getMember(0);
+    if (ref->type != NODE_TYPE_REFERENCE ||
+        static_cast<Variable const*>(ref->getData()) != outVariable) {
+      continue;
+    }
+    toFind.erase(n->getString());
+  }
+
+  return toFind.empty();
+}
+
 void arangodb::aql::collectInClusterRule(Optimizer* opt,
                                          std::unique_ptr<ExecutionPlan> plan,
                                          OptimizerRule const* rule) {
@@ -3496,7 +3655,26 @@ void arangodb::aql::collectInClusterRule(Optimizer* opt,
 
           bool removeGatherNodeSort = false;
 
-          if (collectNode->aggregationMethod() == CollectOptions::CollectMethod::COUNT) {
+          if (target == current &&
+              collectGroupsByShardKeys(plan.get(), collectNode, previous)) {
+            // all shard keys are part of the grouping, so no group can span
+            // multiple shards. move the entire COLLECT to the DB server(s)
+            // and only gather its results on the coordinator
+            plan->unlinkNode(collectNode);
+            collectNode->addDependency(previous);
+            target->replaceDependency(previous, collectNode);
+
+            if (gatherNode != nullptr) {
+              SortElementVector& elements = gatherNode->elements();
+              elements.clear();
+              if (collectNode->aggregationMethod() == CollectOptions::CollectMethod::SORTED) {
+                // keep the output sorted by merging the sorted per-shard results
+                for (auto const& it : collectNode->groupVariables()) {
+                  elements.emplace_back(it.first, true);
+                }
+              }
+            }
+          } else if (collectNode->aggregationMethod() == CollectOptions::CollectMethod::COUNT) {
             // clone a COLLECT WITH COUNT operation from the coordinator to the DB server(s), and
             // leave an aggregate COLLECT node on the coordinator for total aggregation
 
@@ -5085,7 +5263,7 @@ void arangodb::aql::patchUpdateStatementsRule(
       auto const type = dep->getType();
 
       if (type == EN::ENUMERATE_LIST || type == EN::INDEX ||
-          type == EN::SUBQUERY) {
+          type == EN::HASH_JOIN || type == EN::SUBQUERY) {
         // not suitable
         modified = false;
         break;
@@ -5133,6 +5311,230 @@ void arangodb::aql::patchUpdateStatementsRule(
   opt->addPlan(std::move(plan), rule, modified);
 }
 
+/// @brief make SORT nodes that are followed by a LIMIT only keep the
+/// top offset + count rows instead of sorting all their input
+void arangodb::aql::sortLimitRule(Optimizer* opt,
+                                  std::unique_ptr<ExecutionPlan> plan,
+                                  OptimizerRule const* rule) {
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::SORT, true);
+
+  bool modified = false;
+
+  for (auto const& n : nodes) {
+    auto sortNode = ExecutionNode::castTo<SortNode*>(n);
+
+    if (sortNode->limit() > 0) {
+      // already limited
+      continue;
+    }
+
+    // skip over nodes that produce exactly one output row per input row
+    auto current = n->getFirstParent();
+    while (current != nullptr && current->getType() == EN::CALCULATION) {
+      current = current->getFirstParent();
+    }
+
+    if (current == nullptr || current->getType() != EN::LIMIT) {
+      continue;
+    }
+
+    auto limitNode = ExecutionNode::castTo<LimitNode const*>(current);
+
+    if (limitNode->fullCount() || limitNode->limit() == 0) {
+      // we need to see all rows for counting
+      continue;
+    }
+
+    size_t const offset = limitNode->offset();
+    size_t const count = limitNode->limit();
+    if (offset > std::numeric_limits<size_t>::max() - count) {
+      // would overflow
+      continue;
+    }
+
+    sortNode->setLimit(offset + count);
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+/// @brief mark collection scans that read the entire collection exactly once,
+/// so that the storage engine reads ahead and bypasses its caches. scans in
+/// loops or subqueries are repeated, and scans that are followed by a LIMIT
+/// may stop early, so these keep using the caches
+void arangodb::aql::fullCollectionScanRule(Optimizer* opt,
+                                           std::unique_ptr<ExecutionPlan> plan,
+                                           OptimizerRule const* rule) {
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  // do not enter subqueries
+  plan->findNodesOfType(nodes, EN::ENUMERATE_COLLECTION, false);
+
+  bool modified = false;
+
+  for (auto const& n : nodes) {
+    auto node = ExecutionNode::castTo<EnumerateCollectionNode*>(n);
+
+    if (!node->isDeterministic() || node->isInInnerLoop()) {
+      // random iteration, or the scan is repeated
+      continue;
+    }
+
+    // a LIMIT can stop the scan early, unless a node in between needs to
+    // see all of its input first
+    bool full = true;
+    auto current = n->getFirstParent();
+    while (current != nullptr) {
+      auto type = current->getType();
+      if (type == EN::SORT || type == EN::COLLECT) {
+        break;
+      }
+      if (type == EN::LIMIT &&
+          !ExecutionNode::castTo<LimitNode const*>(current)->fullCount()) {
+        full = false;
+        break;
+      }
+      current = current->getFirstParent();
+    }
+
+    if (full) {
+      node->setFullScan();
+      modified = true;
+    }
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+/// @brief replace full collection scans in inner loops that are joined to the
+/// outer loop(s) by an equality condition with a hash join, which reads the
+/// collection only once
+void arangodb::aql::hashJoinRule(Optimizer* opt,
+                                 std::unique_ptr<ExecutionPlan> plan,
+                                 OptimizerRule const* rule) {
+  if (arangodb::ServerState::instance()->isCoordinator()) {
+    // hash joins are not yet supported in the cluster
+    opt->addPlan(std::move(plan), rule, false);
+    return;
+  }
+
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::ENUMERATE_COLLECTION, true);
+
+  bool modified = false;
+
+  for (auto const& n : nodes) {
+    auto en = ExecutionNode::castTo<EnumerateCollectionNode*>(n);
+
+    if (!en->isDeterministic() || !en->isInInnerLoop()) {
+      // random iteration, or nothing to join
+      continue;
+    }
+
+    size_t incoming = 0;
+    en->getFirstDependency()->getCost(incoming);
+    if (incoming < 2) {
+      // the collection is read at most once anyway
+      continue;
+    }
+
+    Variable const* outVariable = en->outVariable();
+    AstNode const* probe = nullptr;
+    std::vector<std::string> attribute;
+
+    // variables that are not yet available before the enumeration
+    std::unordered_set<Variable const*> setAfter{outVariable};
+    std::unordered_set<Variable const*> referenced;
+    std::pair<Variable const*, std::vector<arangodb::basics::AttributeName>> access;
+
+    // look for FILTER doc.attr == expr in the nodes following the enumeration
+    auto current = n->getFirstParent();
+    while (probe == nullptr && current != nullptr &&
+           (current->getType() == EN::CALCULATION || current->getType() == EN::FILTER)) {
+      if (current->getType() == EN::FILTER) {
+        auto inVariable = ExecutionNode::castTo<FilterNode const*>(current)->getVariablesUsedHere()[0];
+        auto setter = plan->getVarSetBy(inVariable->id);
+
+        if (setter != nullptr && setter->getType() == EN::CALCULATION &&
+            setAfter.find(inVariable) != setAfter.end()) {
+          auto expr = ExecutionNode::castTo<CalculationNode const*>(setter)->expression();
+          AstNode const* node = (expr == nullptr) ? nullptr : expr->node();
+
+          if (node != nullptr && node->type == NODE_TYPE_OPERATOR_BINARY_EQ) {
+            for (size_t i = 0; i < 2 && probe == nullptr; ++i) {
+              AstNode const* lhs = node->getMember(i);
+              AstNode const* rhs = node->getMember(1 - i);
+
+              if (!lhs->isAttributeAccessForVariable(access, false) ||
+                  access.first != outVariable ||
+                  access.second.front().name == StaticStrings::IdString) {
+                continue;
+              }
+
+              bool const expands = std::any_of(access.second.begin(), access.second.end(),
+                  [](arangodb::basics::AttributeName const& name) { return name.shouldExpand; });
+
+              if (expands || !rhs->isDeterministic()) {
+                continue;
+              }
+
+              referenced.clear();
+              Ast::getReferencedVariables(rhs, referenced);
+
+              bool const usesLaterVariable = std::any_of(referenced.begin(), referenced.end(),
+                  [&setAfter](Variable const* v) { return setAfter.find(v) != setAfter.end(); });
+
+              if (usesLaterVariable) {
+                continue;
+              }
+
+              probe = rhs;
+              attribute.clear();
+              for (auto const& it : access.second) {
+                attribute.emplace_back(it.name);
+              }
+            }
+          }
+        }
+      } else {
+        for (auto const& it : current->getVariablesSetHere()) {
+          setAfter.emplace(it);
+        }
+      }
+
+      current = current->getFirstParent();
+    }
+
+    if (probe == nullptr) {
+      continue;
+    }
+
+    // calculate the join value of the outer side before the join. the FILTER
+    // stays in place, so the join condition is still checked with AQL semantics
+    auto ast = plan->getAst();
+    Variable* probeVariable = ast->variables()->createTemporaryVariable();
+    auto expr = std::make_unique<Expression>(plan.get(), ast, probe->clone(ast));
+    ExecutionNode* calculationNode =
+        new CalculationNode(plan.get(), plan->nextId(), expr.get(), probeVariable);
+    expr.release();
+    plan->registerNode(calculationNode);
+
+    ExecutionNode* joinNode = new HashJoinNode(plan.get(), plan->nextId(),
+        en->collection(), outVariable, probeVariable, attribute);
+    plan->registerNode(joinNode);
+
+    plan->replaceNode(en, joinNode);
+    plan->insertDependency(joinNode, calculationNode);
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
 /// @brief optimizes away unused traversal output variables and
 /// merges filter nodes into graph traversal nodes
 void arangodb::aql::optimizeTraversalsRule(Optimizer* opt,
@@ -6433,3 +6835,128 @@ void arangodb::aql::optimizeSubqueriesRule(Optimizer* opt,
 
   opt->addPlan(std::move(plan), rule, modified);
 }
+
+/// @brief simplify an EnumerateCollectionNode or IndexNode that fetches an
+/// entire document to a projection of this document
+void arangodb::aql::reduceExtractionToProjectionRule(
+    Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
+    OptimizerRule const* rule) {
+  // projections are limited (arbitrarily) to a few attributes, as every
+  // projected attribute is looked up and copied on its own. documents that
+  // are sent to the coordinator are serialized anyway, so projections with
+  // more attributes still pay off for them
+  size_t const maxProjections = 5;
+  size_t const maxRemoteProjections = 32;
+
+  // engines that hand out pointers to their documents would only copy the
+  // projected attributes, without any documents to serialize
+  bool const useRawDocumentPointers =
+      EngineSelectorFeature::ENGINE->useRawDocumentPointers();
+
+  // These are all the nodes where we start traversing (including all
+  // subqueries)
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+
+  std::vector<ExecutionNode::NodeType> const types = {
+      ExecutionNode::ENUMERATE_COLLECTION, ExecutionNode::INDEX};
+  plan->findNodesOfType(nodes, types, true);
+
+  bool modified = false;
+  std::unordered_set<Variable const*> vars;
+  std::unordered_set<std::string> attributes;
+
+  for (auto const& n : nodes) {
+    bool stop = false;
+    bool optimize = false;
+    // whether the documents are sent to the coordinator, before some of
+    // their attributes are used
+    bool seenRemote = false;
+    bool remote = false;
+    attributes.clear();
+    DocumentProducingNode* e = dynamic_cast<DocumentProducingNode*>(n);
+    if (e == nullptr) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(
+          TRI_ERROR_INTERNAL, "cannot convert node to DocumentProducingNode");
+    }
+    Variable const* v = e->outVariable();
+
+    ExecutionNode* current = n->getFirstParent();
+    while (current != nullptr) {
+      if (current->getType() == EN::CALCULATION) {
+        Expression* exp = ExecutionNode::castTo<CalculationNode*>(current)->expression();
+
+        if (exp != nullptr && exp->node() != nullptr) {
+          AstNode const* node = exp->node();
+          vars.clear();
+          current->getVariablesUsedHere(vars);
+
+          if (vars.find(v) != vars.end()) {
+            if (!Ast::getReferencedAttributes(node, v, attributes)) {
+              stop = true;
+              break;
+            }
+            optimize = true;
+            remote |= seenRemote;
+          }
+        }
+      } else if (current->getType() == EN::GATHER) {
+        // compare sort attributes of GatherNode
+        auto gn = ExecutionNode::castTo<GatherNode*>(current);
+        for (auto const& it : gn->elements()) {
+          if (it.var == v) {
+            if (it.attributePath.empty()) {
+              // sort of GatherNode refers to the entire document, not to an
+              // attribute of the document
+              stop = true;
+              break;
+            }
+            // insert 0th level of attribute name into the set of attributes
+            // that we need for our projection
+            attributes.emplace(it.attributePath[0]);
+            remote |= seenRemote;
+          }
+        }
+      } else if (current->getType() == EN::REMOTE) {
+        seenRemote = true;
+      } else {
+        vars.clear();
+        current->getVariablesUsedHere(vars);
+
+        if (vars.find(v) != vars.end()) {
+          // original variable is still used here
+          stop = true;
+          break;
+        }
+      }
+
+      if (stop) {
+        break;
+      }
+
+      current = current->getFirstParent();
+    }
+
+    if (!optimize || stop || attributes.empty() ||
+        (useRawDocumentPointers && !remote) ||
+        attributes.size() > (remote ? maxRemoteProjections : maxProjections)) {
+      continue;
+    }
+
+    std::vector<std::string> r;
+    for (auto& it : attributes) {
+      r.emplace_back(std::move(it));
+    }
+    // store projections in DocumentProducingNode
+    e->projections(std::move(r));
+
+    if (n->getType() == ExecutionNode::INDEX) {
+      // need to update _indexCoversProjections value in an IndexNode
+      ExecutionNode::castTo<IndexNode*>(n)->initIndexCoversProjections();
+    }
+
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
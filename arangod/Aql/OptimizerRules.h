@@ -106,6 +106,10 @@ void useIndexesRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule co
 /// @brief try to use the index for sorting
 void useIndexForSortRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
 
+/// @brief try to feed a sorted COLLECT from a sorted index instead of a SORT
+void useIndexForCollectRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
+                            OptimizerRule const*);
+
 /// @brief try to remove filters which are covered by indexes
 void removeFiltersCoveredByIndexRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
                                      OptimizerRule const*);
@@ -211,6 +215,21 @@ void removeDataModificationOutVariablesRule(Optimizer*, std::unique_ptr<Executio
 void patchUpdateStatementsRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
                                OptimizerRule const*);
 
+/// @brief make SORT nodes that are followed by a LIMIT only keep the
+/// top offset + count rows instead of sorting all their input
+void sortLimitRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
+                   OptimizerRule const*);
+
+/// @brief mark collection scans that read the entire collection exactly once,
+/// so that the storage engine reads ahead and bypasses its caches
+void fullCollectionScanRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
+                            OptimizerRule const*);
+
+/// @brief replace full collection scans in inner loops that are joined to the
+/// outer loop(s) by an equality condition with a hash join
+void hashJoinRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
+                  OptimizerRule const*);
+
 /// @brief optimizes away unused traversal output variables and
 /// merges filter nodes into graph traversal nodes
 void optimizeTraversalsRule(Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
@@ -241,6 +260,10 @@ void optimizeSubqueriesRule(Optimizer*, std::unique_ptr<ExecutionPlan>, Optimize
 /// @brief replace legacy JS functions in the plan.
 void replaceNearWithinFulltext(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
 
+/// @brief simplify an EnumerateCollectionNode or IndexNode that fetches an
+/// entire document to a projection of this document
+void reduceExtractionToProjectionRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
+
 
 }  // namespace aql
 }  // namespace arangodb
@@ -215,6 +215,10 @@ void OptimizerRulesFeature::addRules() {
   registerRule("remove-redundant-or", removeRedundantOrRule,
                OptimizerRule::removeRedundantOrRule_pass6, DoesNotCreateAdditionalPlans, CanBeDisabled);
 
+  // try to feed sorted COLLECTs by the order of an index
+  registerRule("use-index-for-collect", useIndexForCollectRule,
+               OptimizerRule::useIndexForCollectRule_pass6, CreatesAdditionalPlans, CanBeDisabled);
+
   // try to find a filter after an enumerate collection and find indexes
   registerRule("use-indexes", useIndexesRule, OptimizerRule::useIndexesRule_pass6, DoesNotCreateAdditionalPlans, CanBeDisabled);
 
@@ -232,6 +236,11 @@ void OptimizerRulesFeature::addRules() {
   registerRule("sort-in-values", sortInValuesRule, OptimizerRule::sortInValuesRule_pass6,
                DoesNotCreateAdditionalPlans, CanBeDisabled);
 
+  // use hash joins for equality joins with collections that lack a suitable
+  // index (note: must come after use-indexes)
+  registerRule("hash-join", hashJoinRule, OptimizerRule::hashJoinRule_pass6,
+               DoesNotCreateAdditionalPlans, CanBeDisabled);
+
   // remove calculations that are never necessary
   registerRule("remove-unnecessary-calculations-2",
                removeUnnecessaryCalculationsRule,
@@ -245,6 +254,14 @@ void OptimizerRulesFeature::addRules() {
   registerRule("patch-update-statements", patchUpdateStatementsRule,
                OptimizerRule::patchUpdateStatementsRule_pass9, DoesNotCreateAdditionalPlans, CanBeDisabled);
 
+  // make SORT nodes followed by a LIMIT only keep the top rows
+  registerRule("sort-limit", sortLimitRule,
+               OptimizerRule::sortLimitRule_pass9, DoesNotCreateAdditionalPlans, CanBeDisabled);
+
+  // let scans of entire collections read ahead without filling caches
+  registerRule("full-collection-scan", fullCollectionScanRule,
+               OptimizerRule::fullCollectionScanRule_pass9, DoesNotCreateAdditionalPlans, CanBeDisabled);
+
   registerRule("replace-function-with-index", replaceNearWithinFulltext,
                OptimizerRule::replaceNearWithinFulltext, DoesNotCreateAdditionalPlans, CanNotBeDisabled);
 #ifdef USE_IRESEARCH
@@ -267,10 +284,10 @@ void OptimizerRulesFeature::addRules() {
                                       OptimizerRule::applyGeoIndexRule_pass6, DoesNotCreateAdditionalPlans, CanBeDisabled);
 
   if (arangodb::ServerState::instance()->isCoordinator()) {
-#if 0
     registerRule("optimize-cluster-single-shard", optimizeClusterSingleShardRule,
                  OptimizerRule::optimizeClusterSingleShardRule_pass10, DoesNotCreateAdditionalPlans, CanBeDisabled);
 
+#if 0
     registerRule("optimize-cluster-joins", optimizeClusterJoinsRule,
                  OptimizerRule::optimizeClusterJoinsRule_pass10, DoesNotCreateAdditionalPlans, CanBeDisabled);
 #endif
@@ -323,6 +340,12 @@ void OptimizerRulesFeature::addRules() {
                  OptimizerRule::restrictToSingleShardRule_pass10, DoesNotCreateAdditionalPlans, CanBeDisabled);
   }
 
+  // simplify an EnumerateCollectionNode or IndexNode that fetches an entire
+  // document to a projection of this document
+  registerRule("reduce-extraction-to-projection", reduceExtractionToProjectionRule,
+               OptimizerRule::reduceExtractionToProjectionRule_pass10,
+               DoesNotCreateAdditionalPlans, CanBeDisabled);
+
   // finally add the storage-engine specific rules
   addStorageEngineRules();
 }
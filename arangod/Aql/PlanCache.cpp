@@ -28,9 +28,12 @@
 #include "Aql/QueryString.h"
 #include "Basics/ReadLocker.h"
 #include "Basics/WriteLocker.h"
+#include "Basics/fasthash.h"
 #include "VocBase/vocbase.h"
 
 #include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
 
 using namespace arangodb::aql;
 
@@ -38,44 +41,79 @@ using namespace arangodb::aql;
 static arangodb::aql::PlanCache Instance;
 
 /// @brief create the plan cache
-PlanCache::PlanCache() : _lock(), _plans() {}
+PlanCache::PlanCache()
+    : _lock(),
+      _plans(),
+      _numEntries(0),
+      _maxEntries(128),
+      _epoch(0),
+      _hits(0),
+      _misses(0),
+      _stores(0),
+      _evictions(0),
+      _invalidations(0) {}
 
 /// @brief destroy the plan cache
 PlanCache::~PlanCache() {}
 
 /// @brief lookup a plan in the cache
 std::shared_ptr<PlanCacheEntry> PlanCache::lookup(TRI_vocbase_t* vocbase,
-                                                  uint64_t queryHash, 
-                                                  QueryString const& queryString) {
-  READ_LOCKER(readLocker, _lock);
+                                                  uint64_t queryHash,
+                                                  QueryString const& queryString,
+                                                  VPackSlice bindParameters) {
+  std::shared_ptr<PlanCacheEntry> entry;
 
-  auto it = _plans.find(vocbase);
+  {
+    READ_LOCKER(readLocker, _lock);
 
-  if (it == _plans.end()) {
-    // no entry found for the requested database
-    return std::shared_ptr<PlanCacheEntry>();
+    auto it = _plans.find(vocbase);
+
+    if (it != _plans.end()) {
+      auto it2 = (*it).second.find(queryHash);
+
+      if (it2 != (*it).second.end()) {
+        entry = (*it2).second;
+      }
+    }
   }
 
-  auto it2 = (*it).second.find(queryHash);
-  
-  if (it2 == (*it).second.end()) {
-    // plan not found in cache
+  if (entry == nullptr ||
+      entry->queryString.size() != queryString.size() ||
+      memcmp(entry->queryString.data(), queryString.data(), queryString.size()) != 0 ||
+      entry->valuesHash != hashValues(entry->valueParameters, bindParameters)) {
+    // plan not found in cache, hash collision, or the plan was built for
+    // other values of the parameters it depends on
+    ++_misses;
     return std::shared_ptr<PlanCacheEntry>();
   }
 
   // plan found in cache
-  return (*it2).second;
+  ++_hits;
+  return entry;
 }
 
 /// @brief store a plan in the cache
 void PlanCache::store(
     TRI_vocbase_t* vocbase, uint64_t hash, QueryString const& queryString,
-    ExecutionPlan const* plan) {
- 
-  auto entry = std::make_unique<PlanCacheEntry>(queryString.extract(SIZE_MAX), plan->toVelocyPack(plan->getAst(), true)); 
+    std::vector<std::string>&& valueParameters, VPackSlice bindParameters,
+    ExecutionPlan const* plan, uint64_t epoch) {
+  if (maxEntries() == 0) {
+    return;
+  }
+
+  uint64_t const valuesHash = hashValues(valueParameters, bindParameters);
+  auto entry = std::make_shared<PlanCacheEntry>(
+      queryString.extract(SIZE_MAX), std::move(valueParameters), valuesHash,
+      plan->toVelocyPack(plan->getAst(), true));
 
   WRITE_LOCKER(writeLocker, _lock);
 
+  if (epoch != _epoch.load(std::memory_order_relaxed)) {
+    // some DDL operation happened while the plan was built, so it may be
+    // outdated already
+    return;
+  }
+
   auto it = _plans.find(vocbase);
 
   if (it == _plans.end()) {
@@ -83,17 +121,108 @@ void PlanCache::store(
     it = _plans.emplace(vocbase, std::unordered_map<uint64_t, std::shared_ptr<PlanCacheEntry>>()).first;
   }
 
-  // store cache entry
-  (*it).second.emplace(hash, std::move(entry));
+  auto it2 = (*it).second.find(hash);
+
+  if (it2 != (*it).second.end()) {
+    // replace the plan built for other parameter values
+    (*it2).second = std::move(entry);
+  } else {
+    evict(maxEntries() - 1);
+    (*it).second.emplace(hash, std::move(entry));
+    _order.emplace_back(vocbase, hash);
+    ++_numEntries;
+  }
+  ++_stores;
 }
 
 /// @brief invalidate all queries for a particular database
 void PlanCache::invalidate(TRI_vocbase_t* vocbase) {
   WRITE_LOCKER(writeLocker, _lock);
 
-  _plans.erase(vocbase);
+  _epoch.fetch_add(1, std::memory_order_release);
+
+  auto it = _plans.find(vocbase);
+
+  if (it != _plans.end()) {
+    TRI_ASSERT(_numEntries >= (*it).second.size());
+    _numEntries -= (*it).second.size();
+    _plans.erase(it);
+    ++_invalidations;
+
+    _order.erase(std::remove_if(_order.begin(), _order.end(),
+                                [vocbase](std::pair<TRI_vocbase_t*, uint64_t> const& key) {
+                                  return key.first == vocbase;
+                                }),
+                 _order.end());
+  }
+}
+
+/// @brief set the maximum number of plans in the cache
+void PlanCache::maxEntries(size_t value) {
+  WRITE_LOCKER(writeLocker, _lock);
+
+  _maxEntries.store(value, std::memory_order_relaxed);
+
+  evict(value);
+}
+
+/// @brief add the properties and figures of the cache to an open object
+void PlanCache::toVelocyPack(VPackBuilder& builder) const {
+  size_t numEntries;
+  {
+    READ_LOCKER(readLocker, _lock);
+    numEntries = _numEntries;
+  }
+
+  TRI_ASSERT(builder.isOpenObject());
+  builder.add("maxEntries", VPackValue(maxEntries()));
+  builder.add("entries", VPackValue(numEntries));
+  builder.add("hits", VPackValue(_hits.load()));
+  builder.add("misses", VPackValue(_misses.load()));
+  builder.add("stores", VPackValue(_stores.load()));
+  builder.add("evictions", VPackValue(_evictions.load()));
+  builder.add("invalidations", VPackValue(_invalidations.load()));
+}
+
+/// @brief hash the values of the given bind parameters
+uint64_t PlanCache::hashValues(std::vector<std::string> const& names,
+                               VPackSlice bindParameters) {
+  uint64_t hash = 0x0123456789abcdef;
+
+  for (auto const& name : names) {
+    VPackSlice value;
+    if (bindParameters.isObject()) {
+      value = bindParameters.get(name);
+    }
+    hash = fasthash64(name.data(), name.size(), hash);
+    hash = value.isNone() ? fasthash64_uint64(0xdeadbeef, hash) : value.normalizedHash(hash);
+  }
+
+  return hash;
+}
+
+/// @brief remove the oldest plans until at most maxEntries are left. the
+/// write lock must be held
+void PlanCache::evict(size_t maxEntries) {
+  while (_numEntries > maxEntries && !_order.empty()) {
+    auto key = _order.front();
+    _order.pop_front();
+
+    auto it = _plans.find(key.first);
+    if (it == _plans.end()) {
+      // removed by an invalidation already
+      continue;
+    }
+    if ((*it).second.erase(key.second) == 0) {
+      continue;
+    }
+    if ((*it).second.empty()) {
+      _plans.erase(it);
+    }
+    --_numEntries;
+    ++_evictions;
+  }
 }
 
 /// @brief get the plan cache instance
 PlanCache* PlanCache::instance() { return &Instance; }
-
@@ -32,6 +32,7 @@ struct TRI_vocbase_t;
 namespace arangodb {
 namespace velocypack {
 class Builder;
+class Slice;
 }
 
 namespace aql {
@@ -40,11 +41,21 @@ class QueryString;
 class VariableGenerator;
 
 struct PlanCacheEntry {
-  PlanCacheEntry(std::string&& queryString, 
+  PlanCacheEntry(std::string&& queryString,
+                 std::vector<std::string>&& valueParameters,
+                 uint64_t valuesHash,
                  std::shared_ptr<arangodb::velocypack::Builder>&& builder)
-      : queryString(std::move(queryString)), builder(std::move(builder)) {}
+      : queryString(std::move(queryString)),
+        valueParameters(std::move(valueParameters)),
+        valuesHash(valuesHash),
+        builder(std::move(builder)) {}
 
   std::string queryString;
+  /// @brief bind parameters whose values were injected into the plan. all
+  /// other bind parameters are evaluated at runtime
+  std::vector<std::string> const valueParameters;
+  /// @brief hash of the values of valueParameters the plan was built for
+  uint64_t const valuesHash;
   std::shared_ptr<arangodb::velocypack::Builder> builder;
 };
 
@@ -60,24 +71,72 @@ class PlanCache {
   ~PlanCache();
 
  public:
-  /// @brief lookup a plan in the cache
-  std::shared_ptr<PlanCacheEntry> lookup(TRI_vocbase_t*, uint64_t, QueryString const&);
-
-  /// @brief store a plan in the cache
-  void store(TRI_vocbase_t*, uint64_t, QueryString const&, ExecutionPlan const*);
+  /// @brief lookup a plan in the cache. the key must not depend on the
+  /// values of the bind parameters, only on their names
+  std::shared_ptr<PlanCacheEntry> lookup(TRI_vocbase_t*, uint64_t, QueryString const&,
+                                         arangodb::velocypack::Slice bindParameters);
+
+  /// @brief store a plan in the cache. the plan is not stored if the cache
+  /// has been invalidated after the given epoch
+  void store(TRI_vocbase_t*, uint64_t, QueryString const&,
+             std::vector<std::string>&& valueParameters,
+             arangodb::velocypack::Slice bindParameters,
+             ExecutionPlan const*, uint64_t epoch);
 
   /// @brief invalidate all plans for a particular database
   void invalidate(TRI_vocbase_t*);
 
+  /// @brief the current invalidation epoch. must be fetched before a plan
+  /// is built that will be stored
+  uint64_t epoch() const { return _epoch.load(std::memory_order_acquire); }
+
+  /// @brief maximum number of plans in the cache, 0 disables the cache
+  size_t maxEntries() const { return _maxEntries.load(std::memory_order_relaxed); }
+
+  /// @brief set the maximum number of plans in the cache
+  void maxEntries(size_t value);
+
+  /// @brief add the properties and figures of the cache to an open object
+  void toVelocyPack(arangodb::velocypack::Builder&) const;
+
+  /// @brief hash the values of the given bind parameters
+  static uint64_t hashValues(std::vector<std::string> const& names,
+                             arangodb::velocypack::Slice bindParameters);
+
   /// @brief get the pointer to the global plan cache
   static PlanCache* instance();
 
+ private:
+  /// @brief remove the oldest plans until at most maxEntries are left. the
+  /// write lock must be held
+  void evict(size_t maxEntries);
+
  private:
   /// @brief read-write lock for the cache
-  arangodb::basics::ReadWriteLock _lock;
+  mutable arangodb::basics::ReadWriteLock _lock;
 
   /// @brief cached query plans, organized per database
   std::unordered_map<TRI_vocbase_t*, std::unordered_map<uint64_t, std::shared_ptr<PlanCacheEntry>>> _plans;
+
+  /// @brief keys in insertion order, for eviction. may contain keys of
+  /// plans that have been invalidated already
+  std::deque<std::pair<TRI_vocbase_t*, uint64_t>> _order;
+
+  /// @brief number of plans in _plans
+  size_t _numEntries;
+
+  /// @brief maximum number of plans
+  std::atomic<size_t> _maxEntries;
+
+  /// @brief incremented on each invalidation
+  std::atomic<uint64_t> _epoch;
+
+  /// @brief figures
+  std::atomic<uint64_t> _hits;
+  std::atomic<uint64_t> _misses;
+  std::atomic<uint64_t> _stores;
+  std::atomic<uint64_t> _evictions;
+  std::atomic<uint64_t> _invalidations;
 };
 }
 }
@@ -34,6 +34,8 @@
 #include "Aql/QueryCache.h"
 #include "Aql/QueryList.h"
 #include "Aql/QueryProfile.h"
+#include "Aql/SnippetPrefetch.h"
+#include "Aql/SnippetResultCache.h"
 #include "Basics/Exceptions.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/fasthash.h"
@@ -56,9 +58,6 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 
-#ifndef USE_PLAN_CACHE
-#undef USE_PLAN_CACHE
-#endif
 
 using namespace arangodb;
 using namespace arangodb::aql;
@@ -67,6 +66,8 @@ namespace {
 static std::atomic<TRI_voc_tick_t> NextQueryId(1);
 }
 
+std::atomic<uint64_t> ResourceMonitor::GlobalMemoryUsage(0);
+
 /// @brief creates a query
 Query::Query(
     bool contextOwnedByExterior,
@@ -94,6 +95,7 @@ Query::Query(
       _contextOwnedByExterior(contextOwnedByExterior),
       _killed(false),
       _isModificationQuery(false),
+      _usePlanCache(false),
       _preparedV8Context(false),
       _hasHandler(false),
       _executionPhase(ExecutionPhase::INITIALIZE) {
@@ -180,6 +182,7 @@ Query::Query(
       _contextOwnedByExterior(contextOwnedByExterior),
       _killed(false),
       _isModificationQuery(false),
+      _usePlanCache(false),
       _preparedV8Context(false),
       _hasHandler(false),
       _executionPhase(ExecutionPhase::INITIALIZE) {
@@ -220,6 +223,9 @@ Query::~Query() {
       << "Query::~Query queryString: "
       << " this: " << (uintptr_t) this;
   }
+  // a job computing the next batch of a snippet must be done before the
+  // engine goes away
+  _snippetPrefetch.reset();
   cleanupPlanAndEngineSync(TRI_ERROR_INTERNAL);
 
   exitContext();
@@ -243,8 +249,8 @@ Query* Query::clone(QueryPart part, bool withPlan) {
       std::make_unique<Query>(false, _vocbase, _queryString,
                               std::shared_ptr<VPackBuilder>(), _options, part);
 
-  clone->_resourceMonitor = _resourceMonitor;
   clone->_resourceMonitor.clear();
+  clone->_resourceMonitor.maxResources = _resourceMonitor.maxResources;
 
   if (_isModificationQuery) {
     clone->setIsModificationQuery();
@@ -347,69 +353,48 @@ void Query::prepare(QueryRegistry* registry, uint64_t queryHash) {
   init();
   enterState(QueryExecutionState::ValueType::PARSING);
 
-  std::unique_ptr<ExecutionPlan> plan;
-
-#if USE_PLAN_CACHE
-  if (!_queryString.empty() &&
-      queryHash != DontCache &&
-      _part == PART_MAIN) {
-    // LOG_TOPIC(INFO, Logger::FIXME) << "trying to find query in execution plan cache: '" << _queryString << "', hash: " << queryHash;
-
-    // store & lookup velocypack plans!!
-    std::shared_ptr<PlanCacheEntry> planCacheEntry = PlanCache::instance()->lookup(_vocbase, queryHash, queryString);
-    if (planCacheEntry != nullptr) {
-      // LOG_TOPIC(INFO, Logger::FIXME) << "query found in execution plan cache: '" << _queryString << "'";
-
-      TRI_ASSERT(_trx == nullptr);
-      TRI_ASSERT(_collections.empty());
+  // the costs of locking the collections and of setting up the engines,
+  // there are no engine stats yet to count them in
+  QueryCounters counters;
+  QueryCounters::Scope countersScope(&counters);
 
-      // create the transaction object, but do not start it yet
-      _trx = AqlTransaction::create(
-              createTransactionContext(), _collections.collections(),
-              _queryOptions.transactionOptions,
-              _part == PART_MAIN);
-
-      VPackBuilder* builder = planCacheEntry->builder.get();
-      VPackSlice slice = builder->slice();
-      ExecutionPlan::getCollectionsFromVelocyPack(_ast.get(), slice);
-      _ast->variables()->fromVelocyPack(slice);
-
-      enterState(QueryExecutionState::ValueType::LOADING_COLLECTIONS);
+  std::unique_ptr<ExecutionPlan> plan;
 
-      int res = trx->addCollections(*_collections.collections());
+  _usePlanCache = (queryHash != DontCache && canUsePlanCache());
 
-      if (res == TRI_ERROR_NO_ERROR) {
-        res = _trx->begin();
-      }
-
-      if (res != TRI_ERROR_NO_ERROR) {
-        THROW_ARANGO_EXCEPTION_MESSAGE(res, buildErrorMessage(res));
-      }
+  uint64_t planCacheKey = 0;
+  uint64_t planCacheEpoch = 0;
+  VPackSlice bindParameters = VPackSlice::noneSlice();
+  if (_bindParameters.builder() != nullptr) {
+    bindParameters = _bindParameters.builder()->slice();
+  }
 
-      enterState(QueryExecutionState::ValueType::PLAN_INSTANTIATION);
+  if (_usePlanCache) {
+    planCacheKey = calculatePlanCacheKey();
+    // fetch the epoch before building the plan, so that we don't store it
+    // if a DDL operation happens in between
+    planCacheEpoch = PlanCache::instance()->epoch();
 
-      plan.reset(ExecutionPlan::instantiateFromVelocyPack(_ast.get(), slice));
+    std::shared_ptr<PlanCacheEntry> planCacheEntry =
+        PlanCache::instance()->lookup(&_vocbase, planCacheKey, _queryString, bindParameters);
 
-      TRI_ASSERT(plan != nullptr);
+    if (planCacheEntry != nullptr) {
+      plan.reset(preparePlan(planCacheEntry.get()));
     }
   }
-#endif
 
   if (plan == nullptr) {
-    plan.reset(preparePlan());
+    plan.reset(preparePlan(nullptr));
 
     TRI_ASSERT(plan != nullptr);
 
-#if USE_PLAN_CACHE
-    if (!_queryString.empty() &&
-        queryHash != DontCache &&
-        _part == PART_MAIN &&
+    if (_usePlanCache &&
         _warnings.empty() &&
         _ast->root()->isCacheable()) {
-      // LOG_TOPIC(INFO, Logger::FIXME) << "storing query in execution plan cache '" << _queryString << "', hash: " << queryHash;
-      PlanCache::instance()->store(_vocbase, queryHash, _queryString, plan.get());
+      PlanCache::instance()->store(&_vocbase, planCacheKey, _queryString,
+                                   std::move(_planCacheValueParameters),
+                                   bindParameters, plan.get(), planCacheEpoch);
     }
-#endif
   }
 
   TRI_ASSERT(plan != nullptr);
@@ -433,14 +418,18 @@ void Query::prepare(QueryRegistry* registry, uint64_t queryHash) {
     engine.release();
   }
 
+  countersScope.stop();
+  _engine->_stats.counters.add(counters);
+
   _plan = std::move(plan);
 }
 
 /// @brief prepare an AQL query, this is a preparation for execute, but
 /// execute calls it internally. The purpose of this separate method is
 /// to be able to only prepare a query from VelocyPack and then store it in the
-/// QueryRegistry.
-ExecutionPlan* Query::preparePlan() {
+/// QueryRegistry. if cached is set, the plan is instantiated from the plan
+/// cache entry instead of parsing and optimizing the query string
+ExecutionPlan* Query::preparePlan(PlanCacheEntry const* cached) {
   LOG_TOPIC(DEBUG, Logger::QUERIES) << TRI_microtime() - _startTime << " "
                                     << "Query::prepare"
                                     << " this: " << (uintptr_t) this;
@@ -454,12 +443,30 @@ ExecutionPlan* Query::preparePlan() {
     );
   }
 
-  if (!_queryString.empty()) {
+  bool const fromQueryString = (!_queryString.empty() && cached == nullptr);
+
+  if (fromQueryString) {
     Parser parser(this);
 
     parser.parse(false);
     // put in bind parameters
-    parser.ast()->injectBindParameters(_bindParameters, ctx->resolver());
+    if (_usePlanCache) {
+      // bind parameters that are only used in FILTER and RETURN expressions
+      // are evaluated at runtime, so the plan does not depend on their values
+      std::unordered_set<std::string> deferred = parser.ast()->deferrableBindParameters();
+
+      _planCacheValueParameters.clear();
+      for (auto const& it : _bindParameters.get()) {
+        if (deferred.find(it.first) == deferred.end()) {
+          _planCacheValueParameters.emplace_back(it.first);
+        }
+      }
+      std::sort(_planCacheValueParameters.begin(), _planCacheValueParameters.end());
+
+      parser.ast()->injectBindParameters(_bindParameters, ctx->resolver(), &deferred);
+    } else {
+      parser.ast()->injectBindParameters(_bindParameters, ctx->resolver());
+    }
   }
 
   TRI_ASSERT(_trx == nullptr);
@@ -485,7 +492,7 @@ ExecutionPlan* Query::preparePlan() {
 
   // As soon as we start to instantiate the plan we have to clean it
   // up before killing the unique_ptr
-  if (!_queryString.empty()) {
+  if (fromQueryString) {
     // we have an AST
     // optimize the ast
     enterState(QueryExecutionState::ValueType::AST_OPTIMIZATION);
@@ -516,10 +523,17 @@ ExecutionPlan* Query::preparePlan() {
                     _queryOptions.inspectSimplePlans, false);
     // Now plan and all derived plans belong to the optimizer
     plan.reset(opt.stealBest());  // Now we own the best one again
-  } else {  // no queryString, we are instantiating from _queryBuilder
-    VPackSlice const querySlice = _queryBuilder->slice();
+  } else {
+    // no queryString, we are instantiating from _queryBuilder or from the
+    // plan cache
+    VPackSlice const querySlice =
+        (cached != nullptr ? cached->builder->slice() : _queryBuilder->slice());
     ExecutionPlan::getCollectionsFromVelocyPack(_ast.get(), querySlice);
 
+    if (cached != nullptr && querySlice.get("isModificationQuery").isTrue()) {
+      _isModificationQuery = true;
+    }
+
     _ast->variables()->fromVelocyPack(querySlice);
     // creating the plan may have produced some collections
     // we need to add them to the transaction now (otherwise the query will
@@ -539,7 +553,7 @@ ExecutionPlan* Query::preparePlan() {
     enterState(QueryExecutionState::ValueType::PLAN_INSTANTIATION);
 
     // we have an execution plan in VelocyPack format
-    plan.reset(ExecutionPlan::instantiateFromVelocyPack(_ast.get(), _queryBuilder->slice()));
+    plan.reset(ExecutionPlan::instantiateFromVelocyPack(_ast.get(), querySlice));
     if (plan == nullptr) {
       // oops
       THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "could not create plan from vpack");
@@ -643,7 +657,7 @@ ExecutionState Query::execute(QueryRegistry* registry, QueryResult& queryResult)
         // In case of WAITING we return, this function is repeatable!
         // In case of HASMORE we loop
         while (true) {
-          auto res = _engine->getSome(ExecutionBlock::DefaultBatchSize());
+          auto res = _engine->getSome(_engine->root()->batchSize());
           if (res.first == ExecutionState::WAITING) {
             return res.first;
           }
@@ -833,12 +847,12 @@ ExecutionState Query::executeV8(v8::Isolate* isolate, QueryRegistry* registry, Q
         uint32_t j = 0;
         ExecutionState state = ExecutionState::HASMORE;
         while (state != ExecutionState::DONE) {
-          auto res = _engine->getSome(ExecutionBlock::DefaultBatchSize());
+          auto res = _engine->getSome(_engine->root()->batchSize());
           state = res.first;
           // TODO MAX: We need to let the thread sleep here instead of while loop
           while (state == ExecutionState::WAITING) {
             tempWaitForAsyncResponse();
-            res = _engine->getSome(ExecutionBlock::DefaultBatchSize());
+            res = _engine->getSome(_engine->root()->batchSize());
             state = res.first;
           }
           value.swap(res.second);
@@ -878,12 +892,12 @@ ExecutionState Query::executeV8(v8::Isolate* isolate, QueryRegistry* registry, Q
         uint32_t j = 0;
         ExecutionState state = ExecutionState::HASMORE;
         while (state != ExecutionState::DONE) {
-          auto res = _engine->getSome(ExecutionBlock::DefaultBatchSize());
+          auto res = _engine->getSome(_engine->root()->batchSize());
           state = res.first;
           // TODO MAX: We need to let the thread sleep here instead of while loop
           while (state == ExecutionState::WAITING) {
             tempWaitForAsyncResponse();
-            res = _engine->getSome(ExecutionBlock::DefaultBatchSize());
+            res = _engine->getSome(_engine->root()->batchSize());
             state = res.first;
           }
           value.swap(res.second);
@@ -1323,6 +1337,63 @@ uint64_t Query::hash() {
   return hash ^ _bindParameters.hash();
 }
 
+/// @brief calculate the key of the query in the plan cache. in contrast to
+/// hash(), only the names of the bind parameters are included, but not their
+/// values
+uint64_t Query::calculatePlanCacheKey() {
+  TRI_ASSERT(!_queryString.empty());
+
+  uint64_t hash = _queryString.hash();
+
+  // options that influence the plan
+  hash = fasthash64_uint64(_queryOptions.fullCount ? 1 : 0, hash);
+  hash = fasthash64_uint64(_queryOptions.maxNumberOfPlans, hash);
+  hash = fasthash64_uint64(_queryOptions.inspectSimplePlans ? 1 : 0, hash);
+
+  VPackSlice options = basics::VelocyPackHelper::EmptyObjectValue();
+
+  if (_options != nullptr && _options->slice().isObject()) {
+    options = _options->slice().get("optimizer");
+  }
+  hash ^= options.hash();
+
+  std::vector<std::string> names;
+  for (auto const& it : _bindParameters.get()) {
+    names.emplace_back(it.first);
+  }
+  std::sort(names.begin(), names.end());
+
+  for (auto const& name : names) {
+    hash = fasthash64(name.data(), name.size(), hash);
+  }
+
+  return hash;
+}
+
+/// @brief whether or not the plan cache can be used for the query
+bool Query::canUsePlanCache() const {
+  if (!_queryOptions.usePlanCache ||
+      _queryString.empty() ||
+      _part != PART_MAIN ||
+      PlanCache::instance()->maxEntries() == 0) {
+    return false;
+  }
+
+  // plans on coordinators are distributed to the DB servers, which do not
+  // know about bind parameters
+  return !arangodb::ServerState::instance()->isRunningInCluster();
+}
+
+/// @brief set the result cache of a DB server snippet
+void Query::setSnippetCache(std::unique_ptr<SnippetResultCache>&& cache) {
+  _snippetCache = std::move(cache);
+}
+
+/// @brief set the prefetcher of a DB server snippet
+void Query::setSnippetPrefetch(std::unique_ptr<SnippetPrefetch>&& prefetch) {
+  _snippetPrefetch = std::move(prefetch);
+}
+
 /// @brief whether or not the query cache can be used for the query
 bool Query::canUseQueryCache() const {
   if (_queryString.size() < 8) {
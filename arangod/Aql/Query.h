@@ -63,9 +63,12 @@ struct AstNode;
 class Ast;
 class ExecutionEngine;
 class ExecutionPlan;
+struct PlanCacheEntry;
 class Query;
 struct QueryProfile;
 class QueryRegistry;
+class SnippetPrefetch;
+class SnippetResultCache;
 
 /// @brief query part
 enum QueryPart { PART_MAIN, PART_DEPENDENT };
@@ -174,6 +177,9 @@ class Query {
   /// @brief add a node to the list of nodes
   void addNode(AstNode* node) { _resources.addNode(node); }
 
+  /// @brief create a node in the query's node arena
+  AstNode* createNode(AstNodeType type) { return _resources.createNode(type); }
+
   /// @brief register a string
   /// the string is freed when the query is destroyed
   char* registerString(char const* p, size_t length) { return _resources.registerString(p, length); }
@@ -199,6 +205,9 @@ class Query {
   /// @brief register a warning
   virtual void registerWarning(int, char const* = nullptr);
 
+  /// @brief whether or not warnings were registered for the query
+  bool hasWarnings() const { return !_warnings.empty(); }
+
   void prepare(QueryRegistry*, uint64_t queryHash);
 
   /// @brief execute an AQL query
@@ -246,6 +255,20 @@ class Query {
   /// @brief mark a query as modification query
   void setIsModificationQuery() { _isModificationQuery = true; }
 
+  /// @brief the result cache of a DB server snippet, nullptr if the result
+  /// of the snippet is not cached
+  SnippetResultCache* snippetCache() const { return _snippetCache.get(); }
+
+  /// @brief set the result cache of a DB server snippet
+  void setSnippetCache(std::unique_ptr<SnippetResultCache>&& cache);
+
+  /// @brief the prefetcher of a DB server snippet, nullptr if the snippet
+  /// does not compute its results ahead
+  SnippetPrefetch* snippetPrefetch() const { return _snippetPrefetch.get(); }
+
+  /// @brief set the prefetcher of a DB server snippet
+  void setSnippetPrefetch(std::unique_ptr<SnippetPrefetch>&& prefetch);
+
   /// @brief prepare a V8 context for execution for this expression
   /// this needs to be called once before executing any V8 function in this
   /// expression
@@ -337,7 +360,7 @@ class Query {
   /// execute calls it internally. The purpose of this separate method is
   /// to be able to only prepare a query from VelocyPack and then store it in the
   /// QueryRegistry.
-  ExecutionPlan* preparePlan();
+  ExecutionPlan* preparePlan(PlanCacheEntry const* cached);
 
   void setExecutionTime();
 
@@ -347,6 +370,12 @@ class Query {
   /// @brief calculate a hash value for the query and bind parameters
   uint64_t hash();
 
+  /// @brief calculate the key of the query in the plan cache
+  uint64_t calculatePlanCacheKey();
+
+  /// @brief whether or not the plan cache can be used for the query
+  bool canUsePlanCache() const;
+
   /// @brief whether or not the query cache can be used for the query
   bool canUseQueryCache() const;
 
@@ -455,6 +484,20 @@ class Query {
   /// @brief whether or not the query is a data modification query
   bool _isModificationQuery;
 
+  /// @brief whether or not the plan of the query is looked up in and stored
+  /// in the plan cache
+  bool _usePlanCache;
+
+  /// @brief names of the bind parameters whose values were injected into
+  /// the plan, set when the plan is built for the plan cache
+  std::vector<std::string> _planCacheValueParameters;
+
+  /// @brief result cache of a DB server snippet
+  std::unique_ptr<SnippetResultCache> _snippetCache;
+
+  /// @brief computes the next batch of a DB server snippet ahead
+  std::unique_ptr<SnippetPrefetch> _snippetPrefetch;
+
   /// @brief whether or not the preparation routine for V8 contexts was run
   /// once for this expression
   /// it needs to be run once before any V8-based function is called
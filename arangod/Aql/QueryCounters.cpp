@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "QueryCounters.h"
+#include "Basics/VelocyPackHelper.h"
+
+#include <rocksdb/perf_context.h>
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb::aql;
+
+thread_local QueryCounters* QueryCounters::_current = nullptr;
+
+QueryCounters::Scope::Scope(QueryCounters* counters)
+    : _counters(_current == nullptr ? counters : nullptr),
+      _blockReads(0),
+      _blockReadBytes(0),
+      _blockCacheHits(0),
+      _bloomHits(0) {
+  if (_counters == nullptr) {
+    return;
+  }
+  // RocksDB counts into its perf context of the thread anyway, with the
+  // default perf level
+  rocksdb::PerfContext const* perf = rocksdb::get_perf_context();
+  _blockReads = perf->block_read_count;
+  _blockReadBytes = perf->block_read_byte;
+  _blockCacheHits = perf->block_cache_hit_count;
+  _bloomHits = perf->bloom_memtable_hit_count + perf->bloom_sst_hit_count;
+  _current = _counters;
+}
+
+void QueryCounters::Scope::stop() {
+  if (_counters == nullptr) {
+    return;
+  }
+  rocksdb::PerfContext const* perf = rocksdb::get_perf_context();
+  _counters->blockReads += perf->block_read_count - _blockReads;
+  _counters->blockReadBytes += perf->block_read_byte - _blockReadBytes;
+  _counters->blockCacheHits += perf->block_cache_hit_count - _blockCacheHits;
+  _counters->bloomHits +=
+      perf->bloom_memtable_hit_count + perf->bloom_sst_hit_count - _bloomHits;
+  _current = nullptr;
+  _counters = nullptr;
+}
+
+void QueryCounters::add(QueryCounters const& other) {
+  blockReads += other.blockReads;
+  blockReadBytes += other.blockReadBytes;
+  blockCacheHits += other.blockCacheHits;
+  bloomHits += other.bloomHits;
+  documentCacheHits += other.documentCacheHits;
+  documentCacheMisses += other.documentCacheMisses;
+  edgeCacheHits += other.edgeCacheHits;
+  edgeCacheMisses += other.edgeCacheMisses;
+  bytesSent += other.bytesSent;
+  bytesReceived += other.bytesReceived;
+  lockWaitTime += other.lockWaitTime;
+}
+
+void QueryCounters::toVelocyPack(VPackBuilder& builder) const {
+  TRI_ASSERT(builder.isOpenObject());
+  builder.add("blockReads", VPackValue(blockReads));
+  builder.add("blockReadBytes", VPackValue(blockReadBytes));
+  builder.add("blockCacheHits", VPackValue(blockCacheHits));
+  builder.add("bloomHits", VPackValue(bloomHits));
+  builder.add("documentCacheHits", VPackValue(documentCacheHits));
+  builder.add("documentCacheMisses", VPackValue(documentCacheMisses));
+  builder.add("edgeCacheHits", VPackValue(edgeCacheHits));
+  builder.add("edgeCacheMisses", VPackValue(edgeCacheMisses));
+  builder.add("bytesSent", VPackValue(bytesSent));
+  builder.add("bytesReceived", VPackValue(bytesReceived));
+  builder.add("lockWaitTime", VPackValue(lockWaitTime));
+}
+
+void QueryCounters::fromVelocyPack(VPackSlice const& slice) {
+  using basics::VelocyPackHelper;
+  blockReads =
+      VelocyPackHelper::getNumericValue<uint64_t>(slice, "blockReads", 0);
+  blockReadBytes =
+      VelocyPackHelper::getNumericValue<uint64_t>(slice, "blockReadBytes", 0);
+  blockCacheHits =
+      VelocyPackHelper::getNumericValue<uint64_t>(slice, "blockCacheHits", 0);
+  bloomHits =
+      VelocyPackHelper::getNumericValue<uint64_t>(slice, "bloomHits", 0);
+  documentCacheHits = VelocyPackHelper::getNumericValue<uint64_t>(
+      slice, "documentCacheHits", 0);
+  documentCacheMisses = VelocyPackHelper::getNumericValue<uint64_t>(
+      slice, "documentCacheMisses", 0);
+  edgeCacheHits =
+      VelocyPackHelper::getNumericValue<uint64_t>(slice, "edgeCacheHits", 0);
+  edgeCacheMisses =
+      VelocyPackHelper::getNumericValue<uint64_t>(slice, "edgeCacheMisses", 0);
+  bytesSent =
+      VelocyPackHelper::getNumericValue<uint64_t>(slice, "bytesSent", 0);
+  bytesReceived =
+      VelocyPackHelper::getNumericValue<uint64_t>(slice, "bytesReceived", 0);
+  lockWaitTime =
+      VelocyPackHelper::getNumericValue<double>(slice, "lockWaitTime", 0.0);
+}
@@ -0,0 +1,135 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_QUERY_COUNTERS_H
+#define ARANGOD_AQL_QUERY_COUNTERS_H 1
+
+#include "Basics/Common.h"
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+class Slice;
+}
+namespace aql {
+
+/// @brief storage, cache and network costs of a query, part of its
+/// ExecutionStats. a thread that works on a query counts into them while it
+/// is in a Scope, code outside of queries counts nothing
+struct QueryCounters {
+  /// @brief counts into the counters of the current thread while it lives,
+  /// unless an outer scope already does
+  class Scope {
+   public:
+    Scope(Scope const&) = delete;
+    Scope& operator=(Scope const&) = delete;
+
+    explicit Scope(QueryCounters* counters);
+    ~Scope() { stop(); }
+
+    /// @brief stops counting before the scope ends
+    void stop();
+
+   private:
+    QueryCounters* _counters;
+    // the RocksDB perf context of the thread at the start of the scope
+    uint64_t _blockReads;
+    uint64_t _blockReadBytes;
+    uint64_t _blockCacheHits;
+    uint64_t _bloomHits;
+  };
+
+  /// @brief the counters of the current thread, nullptr outside of a scope
+  static QueryCounters* current() { return _current; }
+
+  static void documentCacheLookup(bool found) {
+    QueryCounters* c = _current;
+    if (c != nullptr) {
+      found ? ++c->documentCacheHits : ++c->documentCacheMisses;
+    }
+  }
+
+  static void edgeCacheLookup(bool found) {
+    QueryCounters* c = _current;
+    if (c != nullptr) {
+      found ? ++c->edgeCacheHits : ++c->edgeCacheMisses;
+    }
+  }
+
+  static void sent(size_t bytes) {
+    QueryCounters* c = _current;
+    if (c != nullptr) {
+      c->bytesSent += bytes;
+    }
+  }
+
+  static void received(size_t bytes) {
+    QueryCounters* c = _current;
+    if (c != nullptr) {
+      c->bytesReceived += bytes;
+    }
+  }
+
+  static void lockWait(double seconds) {
+    QueryCounters* c = _current;
+    if (c != nullptr) {
+      c->lockWaitTime += seconds;
+    }
+  }
+
+  void add(QueryCounters const& other);
+
+  void clear() { *this = QueryCounters(); }
+
+  /// @brief adds the counters to an open object
+  void toVelocyPack(velocypack::Builder&) const;
+
+  /// @brief reads the counters from an object, they are optional, as
+  /// servers of older versions do not send them
+  void fromVelocyPack(velocypack::Slice const&);
+
+  /// @brief blocks RocksDB read from the files, their bytes, and blocks
+  /// found in its block cache
+  uint64_t blockReads = 0;
+  uint64_t blockReadBytes = 0;
+  uint64_t blockCacheHits = 0;
+
+  /// @brief lookups that a bloom filter of a memtable or file let through
+  uint64_t bloomHits = 0;
+
+  uint64_t documentCacheHits = 0;
+  uint64_t documentCacheMisses = 0;
+  uint64_t edgeCacheHits = 0;
+  uint64_t edgeCacheMisses = 0;
+
+  /// @brief bodies of the cluster-internal requests and responses
+  uint64_t bytesSent = 0;
+  uint64_t bytesReceived = 0;
+
+  /// @brief seconds spent waiting for collection locks
+  double lockWaitTime = 0.0;
+
+ private:
+  static thread_local QueryCounters* _current;
+};
+}
+}
+
+#endif
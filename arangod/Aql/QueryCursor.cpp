@@ -28,10 +28,16 @@
 #include "Aql/ExecutionEngine.h"
 #include "Aql/Query.h"
 #include "Aql/QueryRegistry.h"
+#include "Basics/ConditionLocker.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Cluster/ServerState.h"
 #include "Logger/Logger.h"
 #include "RestServer/QueryRegistryFeature.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "Transaction/Context.h"
 #include "Transaction/Methods.h"
+#include "Utils/ExecContext.h"
 #include "VocBase/vocbase.h"
 
 #include <velocypack/Builder.h>
@@ -185,9 +191,36 @@ QueryStreamCursor::QueryStreamCursor(
       _exportCount = (std::min)(limit.getInt(), _exportCount);
     }
   }
+
+  // coordinators wait for the DB servers with async requests, a job
+  // blocking a scheduler thread for them could starve the responses
+  if (basics::VelocyPackHelper::getBooleanValue(_query->optionsSlice(),
+                                                "prefetch", false) &&
+      SchedulerFeature::SCHEDULER != nullptr &&
+      !ServerState::instance()->isCoordinator()) {
+    _prefetch = std::make_shared<Prefetch>();
+    ExecContext const* exec = ExecContext::CURRENT;
+    if (exec != nullptr && !exec->isInternal()) {
+      _prefetch->execContext.reset(
+          ExecContext::create(exec->user(), vocbase.name()));
+    }
+  }
 }
 
 QueryStreamCursor::~QueryStreamCursor() {
+  if (_prefetch != nullptr) {
+    // a queued job will not touch the cursor anymore, a running one
+    // must finish before the query goes away
+    CONDITION_LOCKER(guard, _prefetch->condition);
+    _prefetch->cancelled = true;
+    while (_prefetch->running) {
+      guard.wait();
+    }
+    if (_prefetch->value != nullptr && _query != nullptr) {
+      _query->engine()->_itemBlockManager.returnBlock(
+          std::move(_prefetch->value));
+    }
+  }
   if (_query) { // cursor is canceled or timed-out
     // Query destructor will  cleanup plan and abort transaction
     _query.reset();
@@ -211,15 +244,26 @@ std::pair<ExecutionState, Result> QueryStreamCursor::dump(VPackBuilder& builder,
     // this is the RegisterId our results can be found in
     std::unique_ptr<AqlItemBlock> value;
 
-    std::tie(state, value) = engine->getSome(batchSize());
-    if (state == ExecutionState::WAITING) {
-      return {state, TRI_ERROR_NO_ERROR};
+    Result res;
+    if (takePrefetched(state, value, res)) {
+      if (res.fail()) {
+        this->deleted();
+        return {ExecutionState::DONE, res};
+      }
+    } else {
+      std::tie(state, value) = engine->getSome(batchSize());
+      if (state == ExecutionState::WAITING) {
+        return {state, TRI_ERROR_NO_ERROR};
+      }
     }
 
-    Result res = writeResult(builder, state, value);
+    res = writeResult(builder, state, value);
     if (!res.ok()) {
       return {ExecutionState::DONE, res};
     }
+    if (state == ExecutionState::HASMORE) {
+      schedulePrefetch();
+    }
     return {state, res};
   } catch (arangodb::basics::Exception const& ex) {
     this->deleted();
@@ -261,6 +305,13 @@ Result QueryStreamCursor::dumpSync(VPackBuilder& builder) {
 
     std::unique_ptr<AqlItemBlock> value;
 
+    Result res;
+    if (takePrefetched(state, value, res)) {
+      if (res.fail()) {
+        this->deleted();
+        return res;
+      }
+    }
 
     while (state == ExecutionState::WAITING) {
       std::tie(state, value) = engine->getSome(batchSize());
@@ -269,7 +320,11 @@ Result QueryStreamCursor::dumpSync(VPackBuilder& builder) {
       }
     }
 
-    return writeResult(builder, state, value);
+    res = writeResult(builder, state, value);
+    if (res.ok() && state == ExecutionState::HASMORE) {
+      schedulePrefetch();
+    }
+    return res;
   } catch (arangodb::basics::Exception const& ex) {
     this->deleted();
     return Result(ex.code(),
@@ -376,6 +431,99 @@ Result QueryStreamCursor::writeResult(VPackBuilder& builder, ExecutionState stat
   return TRI_ERROR_NO_ERROR;
 }
 
+void QueryStreamCursor::schedulePrefetch() {
+  if (_prefetch == nullptr || _query == nullptr) {
+    return;
+  }
+  auto prefetch = _prefetch;
+  {
+    CONDITION_LOCKER(guard, prefetch->condition);
+    TRI_ASSERT(!prefetch->running && !prefetch->done);
+    prefetch->queued = true;
+  }
+
+  auto job = [this, prefetch]() {
+    {
+      CONDITION_LOCKER(guard, prefetch->condition);
+      if (prefetch->cancelled || !prefetch->queued) {
+        // the cursor is gone, or the next dump took over
+        return;
+      }
+      prefetch->queued = false;
+      prefetch->running = true;
+    }
+
+    ExecutionState state = ExecutionState::WAITING;
+    std::unique_ptr<AqlItemBlock> value;
+    Result res;
+    try {
+      ExecContextScope scope(prefetch->execContext != nullptr
+                                 ? prefetch->execContext.get()
+                                 : ExecContext::superuser());
+      _query->setContinueCallback([this]() { _query->tempSignalAsyncResponse(); });
+      aql::ExecutionEngine* engine = _query->engine();
+      TRI_ASSERT(engine != nullptr);
+      while (state == ExecutionState::WAITING) {
+        std::tie(state, value) = engine->getSome(batchSize());
+        if (state == ExecutionState::WAITING) {
+          _query->tempWaitForAsyncResponse();
+        }
+      }
+    } catch (arangodb::basics::Exception const& ex) {
+      res.reset(ex.code(),
+                "AQL: " + ex.message() +
+                    QueryExecutionState::toStringWithPrefix(_query->state()));
+    } catch (std::bad_alloc const&) {
+      res.reset(TRI_ERROR_OUT_OF_MEMORY);
+    } catch (std::exception const& ex) {
+      res.reset(TRI_ERROR_INTERNAL, ex.what());
+    } catch (...) {
+      res.reset(TRI_ERROR_INTERNAL);
+    }
+
+    CONDITION_LOCKER(guard, prefetch->condition);
+    prefetch->state = res.ok() ? state : ExecutionState::DONE;
+    prefetch->value = std::move(value);
+    prefetch->result = std::move(res);
+    prefetch->running = false;
+    prefetch->done = true;
+    guard.broadcast();
+  };
+
+  if (!SchedulerFeature::SCHEDULER->queue(
+          PriorityRequestLane(RequestLane::CLIENT_AQL), job)) {
+    // queue is full, the next dump computes the batch itself
+    CONDITION_LOCKER(guard, prefetch->condition);
+    prefetch->queued = false;
+  }
+}
+
+bool QueryStreamCursor::takePrefetched(ExecutionState& state,
+                                       std::unique_ptr<AqlItemBlock>& value,
+                                       Result& result) {
+  if (_prefetch == nullptr) {
+    return false;
+  }
+  CONDITION_LOCKER(guard, _prefetch->condition);
+  if (_prefetch->queued) {
+    // the scheduler did not get to the job yet. we don't wait for it, all
+    // threads might be busy with requests like this one
+    _prefetch->queued = false;
+    return false;
+  }
+  while (_prefetch->running) {
+    guard.wait();
+  }
+  if (!_prefetch->done) {
+    return false;
+  }
+  _prefetch->done = false;
+  state = _prefetch->state;
+  value = std::move(_prefetch->value);
+  result = std::move(_prefetch->result);
+  _prefetch->result.reset();
+  return true;
+}
 
 std::shared_ptr<transaction::Context> QueryStreamCursor::context() const {
   return _query->trx()->transactionContext();
@@ -25,16 +25,19 @@
 #ifndef ARANGOD_AQL_QUERY_CURSOR_H
 #define ARANGOD_AQL_QUERY_CURSOR_H 1
 
+#include "Aql/ExecutionState.h"
 #include "Aql/QueryResult.h"
 #include "Basics/Common.h"
+#include "Basics/ConditionVariable.h"
 #include "Utils/Cursor.h"
 #include "VocBase/vocbase.h"
 
 namespace arangodb {
+class ExecContext;
+
 namespace aql {
 
 class AqlItemBlock;
-enum class ExecutionState;
 class Query;
 
 /// Cursor managing an entire query result in-memory
@@ -105,13 +108,45 @@ class QueryStreamCursor final : public arangodb::Cursor {
   std::shared_ptr<transaction::Context> context() const override final;
 
  private:
+  /// @brief the next batch, computed on a scheduler thread while the client
+  /// processes the current one. shared by the cursor and the job, the job
+  /// only touches the cursor if it was not cancelled
+  struct Prefetch {
+    Prefetch()
+        : queued(false),
+          running(false),
+          cancelled(false),
+          done(false),
+          state(ExecutionState::DONE) {}
+
+    basics::ConditionVariable condition;
+    bool queued;     // job posted, but not started
+    bool running;    // job computes the batch
+    bool cancelled;  // cursor is gone
+    bool done;       // batch (or error) available
+    ExecutionState state;
+    std::unique_ptr<AqlItemBlock> value;
+    Result result;
+    // the user of the query, jobs run without a request
+    std::shared_ptr<ExecContext> execContext;
+  };
 
   Result writeResult(velocypack::Builder& builder, ExecutionState state, std::unique_ptr<AqlItemBlock>& value);
 
+  /// @brief posts a job computing the next batch
+  void schedulePrefetch();
+
+  /// @brief takes the prefetched batch, waits for the job if it is running.
+  /// returns false if there is none, a job that did not start yet is taken
+  /// over by the caller
+  bool takePrefetched(ExecutionState& state,
+                      std::unique_ptr<AqlItemBlock>& value, Result& result);
+
  private:
   DatabaseGuard _guard;
   int64_t _exportCount;  // used by RocksDBRestExportHandler
   std::unique_ptr<aql::Query> _query;
+  std::shared_ptr<Prefetch> _prefetch;  // nullptr if not enabled
 };
 
 }  // aql
@@ -35,6 +35,13 @@ using namespace arangodb::aql;
   
 QueryOptions::QueryOptions() :
       memoryLimit(0),
+      sortSpillThreshold(0),
+      collectSpillThreshold(0),
+      hashJoinMemoryLimit(0),
+      batchBytes(16 * 1024 * 1024),
+      minBatchSize(10),
+      maxBatchSize(1000),
+      maxRemoteBatchSize(10000),
       maxNumberOfPlans(0),
       maxWarningCount(10),
       literalSizeThreshold(-1),
@@ -48,7 +55,12 @@ QueryOptions::QueryOptions() :
       fullCount(false),
       count(false),
       verboseErrors(false),
-      inspectSimplePlans(true) {
+      inspectSimplePlans(true),
+      columnarBlocks(false),
+      remotePrefetch(true),
+      snippetPrefetch(true),
+      usePlanCache(false),
+      distinctHashOnly(false) {
 
   // now set some default values from server configuration options
   QueryRegistryFeature* q = application_features::ApplicationServer::getFeature<QueryRegistryFeature>("QueryRegistry");
@@ -60,9 +72,18 @@ QueryOptions::QueryOptions() :
     memoryLimit = globalLimit;
   }
 
+  // use global sort spill threshold
+  sortSpillThreshold = static_cast<size_t>(q->sortSpillThreshold());
+  collectSpillThreshold = static_cast<size_t>(q->collectSpillThreshold());
+  hashJoinMemoryLimit = static_cast<size_t>(q->hashJoinMemoryLimit());
+
   // use global "failOnWarning" value
   failOnWarning = q->failOnWarning();
 
+  // use global remote prefetch setting
+  remotePrefetch = q->remotePrefetch();
+  snippetPrefetch = q->snippetPrefetch();
+
   // "cache" only defaults to true if query cache is turned on
   auto queryCacheMode = QueryCache::instance()->mode();
   cache = (queryCacheMode == CACHE_ALWAYS_ON);
@@ -83,6 +104,43 @@ void QueryOptions::fromVelocyPack(VPackSlice const& slice) {
       memoryLimit = v;
     }
   }
+  value = slice.get("sortSpillThreshold"); 
+  if (value.isNumber()) {
+    sortSpillThreshold = value.getNumber<size_t>();
+  }
+  value = slice.get("collectSpillThreshold"); 
+  if (value.isNumber()) {
+    collectSpillThreshold = value.getNumber<size_t>();
+  }
+  value = slice.get("hashJoinMemoryLimit"); 
+  if (value.isNumber()) {
+    hashJoinMemoryLimit = value.getNumber<size_t>();
+  }
+  value = slice.get("batchBytes"); 
+  if (value.isNumber()) {
+    batchBytes = value.getNumber<size_t>();
+  }
+  value = slice.get("minBatchSize"); 
+  if (value.isNumber()) {
+    size_t v = value.getNumber<size_t>();
+    if (v > 0) {
+      minBatchSize = v;
+    }
+  }
+  value = slice.get("maxBatchSize"); 
+  if (value.isNumber()) {
+    size_t v = value.getNumber<size_t>();
+    if (v > 0) {
+      maxBatchSize = v;
+    }
+  }
+  value = slice.get("maxRemoteBatchSize"); 
+  if (value.isNumber()) {
+    size_t v = value.getNumber<size_t>();
+    if (v > 0) {
+      maxRemoteBatchSize = v;
+    }
+  }
   value = slice.get("maxNumberOfPlans"); 
   if (value.isNumber()) {
     maxNumberOfPlans = value.getNumber<size_t>();
@@ -143,6 +201,26 @@ void QueryOptions::fromVelocyPack(VPackSlice const& slice) {
   if (value.isBool()) {
     verboseErrors = value.getBool();
   }
+  value = slice.get("columnarBlocks"); 
+  if (value.isBool()) {
+    columnarBlocks = value.getBool();
+  }
+  value = slice.get("remotePrefetch");
+  if (value.isBool()) {
+    remotePrefetch = value.getBool();
+  }
+  value = slice.get("snippetPrefetch");
+  if (value.isBool()) {
+    snippetPrefetch = value.getBool();
+  }
+  value = slice.get("usePlanCache");
+  if (value.isBool()) {
+    usePlanCache = value.getBool();
+  }
+  value = slice.get("distinctHashOnly");
+  if (value.isBool()) {
+    distinctHashOnly = value.getBool();
+  }
 
   VPackSlice optimizer = slice.get("optimizer");
   if (optimizer.isObject()) {
@@ -193,6 +271,13 @@ void QueryOptions::toVelocyPack(VPackBuilder& builder, bool disableOptimizerRule
   builder.openObject();
 
   builder.add("memoryLimit", VPackValue(memoryLimit));
+  builder.add("sortSpillThreshold", VPackValue(sortSpillThreshold));
+  builder.add("collectSpillThreshold", VPackValue(collectSpillThreshold));
+  builder.add("hashJoinMemoryLimit", VPackValue(hashJoinMemoryLimit));
+  builder.add("batchBytes", VPackValue(batchBytes));
+  builder.add("minBatchSize", VPackValue(minBatchSize));
+  builder.add("maxBatchSize", VPackValue(maxBatchSize));
+  builder.add("maxRemoteBatchSize", VPackValue(maxRemoteBatchSize));
   builder.add("maxNumberOfPlans", VPackValue(maxNumberOfPlans));
   builder.add("maxWarningCount", VPackValue(maxWarningCount));
   builder.add("literalSizeThreshold", VPackValue(literalSizeThreshold));
@@ -206,6 +291,11 @@ void QueryOptions::toVelocyPack(VPackBuilder& builder, bool disableOptimizerRule
   builder.add("fullCount", VPackValue(fullCount));
   builder.add("count", VPackValue(count));
   builder.add("verboseErrors", VPackValue(verboseErrors));
+  builder.add("columnarBlocks", VPackValue(columnarBlocks));
+  builder.add("remotePrefetch", VPackValue(remotePrefetch));
+  builder.add("snippetPrefetch", VPackValue(snippetPrefetch));
+  builder.add("usePlanCache", VPackValue(usePlanCache));
+  builder.add("distinctHashOnly", VPackValue(distinctHashOnly));
   
   builder.add("optimizer", VPackValue(VPackValueType::Object));
   builder.add("inspectSimplePlans", VPackValue(inspectSimplePlans));
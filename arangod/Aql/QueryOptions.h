@@ -55,6 +55,22 @@ struct QueryOptions {
   void toVelocyPack(arangodb::velocypack::Builder&, bool disableOptimizerRules) const;
 
   size_t memoryLimit;
+  /// number of rows a SORT buffers before spilling to disk, 0 = never
+  size_t sortSpillThreshold;
+  /// number of groups a hash COLLECT keeps in memory before spilling, 0 = never
+  size_t collectSpillThreshold;
+  /// number of bytes the hash table of a hash join may use before the join
+  /// reads the collection once per input row instead, 0 = no limit
+  size_t hashJoinMemoryLimit;
+  /// number of bytes a batch of rows should take, the number of rows per
+  /// batch adapts to the width of the rows a block produces. 0 = always
+  /// batches of ExecutionBlock::DefaultBatchSize() rows
+  size_t batchBytes;
+  /// smallest and largest number of rows per batch
+  size_t minBatchSize;
+  size_t maxBatchSize;
+  /// largest number of rows per batch that is sent between servers
+  size_t maxRemoteBatchSize;
   size_t maxNumberOfPlans;
   size_t maxWarningCount;
   int64_t literalSizeThreshold;
@@ -70,6 +86,20 @@ struct QueryOptions {
   bool count;
   bool verboseErrors;
   bool inspectSimplePlans;
+  /// store AqlItemBlock values column-major instead of row-major
+  bool columnarBlocks;
+  /// keep one getSome request per remote dependency in flight ahead of
+  /// consumption
+  bool remotePrefetch;
+  /// let DB server snippets compute their next batch on a scheduler thread
+  /// while the coordinator processes the current one
+  bool snippetPrefetch;
+  /// look up the plan in the plan cache and store it there, with bind
+  /// parameters evaluated at runtime where possible
+  bool usePlanCache;
+  /// let DISTINCT remember only 128-bit hashes of the values it has seen,
+  /// without comparing the values themselves
+  bool distinctHashOnly;
   std::vector<std::string> optimizerRules;
   std::unordered_set<std::string> shardIds;
 #ifdef USE_ENTERPRISE
@@ -37,6 +37,7 @@ static char const* EmptyString = "";
 
 QueryResources::QueryResources(ResourceMonitor* resourceMonitor)
     : _resourceMonitor(resourceMonitor),
+      _nodesInLastBlock(NodesPerBlock),
       _stringsLength(0),
       _shortStringStorage(_resourceMonitor, 1024) {}
 
@@ -55,6 +56,20 @@ QueryResources::~QueryResources() {
   }
 
   _resourceMonitor->decreaseMemoryUsage(_nodes.size() * sizeof(AstNode) + _nodes.capacity() * sizeof(AstNode*));
+
+  // destroy the nodes in the node arena. all blocks but the last are full
+  for (size_t i = 0; i < _nodeBlocks.size(); ++i) {
+    AstNode* nodes = reinterpret_cast<AstNode*>(_nodeBlocks[i]);
+    size_t const n =
+        (i + 1 == _nodeBlocks.size()) ? _nodesInLastBlock : NodesPerBlock;
+    for (size_t j = 0; j < n; ++j) {
+      nodes[j].~AstNode();
+    }
+    delete[] _nodeBlocks[i];
+  }
+
+  _resourceMonitor->decreaseMemoryUsage(_nodeBlocks.size() * NodesPerBlock * sizeof(AstNode) +
+                                        _nodeBlocks.capacity() * sizeof(char*));
 }
 
 void QueryResources::steal() {
@@ -92,6 +107,47 @@ void QueryResources::addNode(AstNode* node) {
   _nodes.emplace_back(node);
 }
 
+/// @brief create a node of the specified type. the node is placed in the
+/// query's node arena, so that creating the thousands of nodes of a large
+/// query does not take a heap allocation for each of them
+AstNode* QueryResources::createNode(AstNodeType type) {
+  if (_nodesInLastBlock == NodesPerBlock) {
+    // the last block is full, allocate another one
+    if (_nodeBlocks.size() == _nodeBlocks.capacity()) {
+      size_t const capacity = _nodeBlocks.empty() ? 8 : _nodeBlocks.capacity() * 2;
+      _resourceMonitor->increaseMemoryUsage((capacity - _nodeBlocks.capacity()) * sizeof(char*));
+      try {
+        _nodeBlocks.reserve(capacity);
+      } catch (...) {
+        // revert change in memory increase
+        _resourceMonitor->decreaseMemoryUsage((capacity - _nodeBlocks.capacity()) * sizeof(char*));
+        throw;
+      }
+    }
+
+    _resourceMonitor->increaseMemoryUsage(NodesPerBlock * sizeof(AstNode));
+    char* block;
+    try {
+      // operator new[] returns memory aligned suitably for any type
+      block = new char[NodesPerBlock * sizeof(AstNode)];
+    } catch (...) {
+      _resourceMonitor->decreaseMemoryUsage(NodesPerBlock * sizeof(AstNode));
+      throw;
+    }
+    // will not fail, as we have reserved space
+    _nodeBlocks.emplace_back(block);
+    _nodesInLastBlock = 0;
+  }
+
+  TRI_ASSERT(!_nodeBlocks.empty());
+  TRI_ASSERT(_nodesInLastBlock < NodesPerBlock);
+
+  AstNode* node = new (reinterpret_cast<AstNode*>(_nodeBlocks.back()) + _nodesInLastBlock) AstNode(type);
+  // only count the node once it has been constructed successfully
+  ++_nodesInLastBlock;
+  return node;
+}
+
 /// @brief register a string
 /// the string is freed when the query is destroyed
 char* QueryResources::registerString(char const* p, size_t length) {
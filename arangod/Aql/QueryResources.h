@@ -25,12 +25,12 @@
 #define ARANGOD_AQL_QUERY_RESOURCES_H 1
 
 #include "Basics/Common.h"
+#include "Aql/AstNode.h"
 #include "Aql/ShortStringStorage.h"
 
 namespace arangodb {
 namespace aql {
 
-struct AstNode;
 struct ResourceMonitor;
 
 class QueryResources {
@@ -46,6 +46,10 @@ class QueryResources {
    
   /// @brief add a node to the list of nodes
   void addNode(AstNode*);
+
+  /// @brief create a node of the specified type. the node is placed in the
+  /// query's node arena and is destroyed when the query is destroyed
+  AstNode* createNode(AstNodeType type);
   
   /// @brief register a string
   /// the string is freed when the query is destroyed
@@ -70,6 +74,16 @@ class QueryResources {
   /// @brief all nodes created in the AST - will be used for freeing them later
   std::vector<AstNode*> _nodes;
 
+  /// @brief blocks of the node arena, each with room for NodesPerBlock nodes.
+  /// all blocks but the last one are full
+  std::vector<char*> _nodeBlocks;
+
+  /// @brief number of nodes constructed in the last block of the node arena
+  size_t _nodesInLastBlock;
+
+  /// @brief number of nodes in each block of the node arena
+  static constexpr size_t NodesPerBlock = 128;
+
   /// @brief strings created in the query - used for easy memory deallocation
   std::vector<char*> _strings;
   
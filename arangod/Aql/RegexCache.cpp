@@ -29,8 +29,86 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <cstring>
+
 using namespace arangodb::aql;
 
+bool LiteralMatcher::matches(char const* ptr, size_t length) const {
+  size_t const n = _literal.size();
+
+  switch (_type) {
+    case Type::EXACT:
+      return length == n && memcmp(ptr, _literal.data(), n) == 0;
+    case Type::PREFIX:
+      return length >= n && memcmp(ptr, _literal.data(), n) == 0 &&
+             (!_likeWildcards || !hasLineTerminator(ptr + n, length - n));
+    case Type::SUFFIX:
+      return length >= n && memcmp(ptr + length - n, _literal.data(), n) == 0 &&
+             (!_likeWildcards || !hasLineTerminator(ptr, length - n));
+    case Type::INFIX:
+      // the literal itself has no line terminators, so with LIKE wildcards
+      // the whole text must not have any
+      return (!_likeWildcards || !hasLineTerminator(ptr, length)) &&
+             contains(ptr, length, _literal);
+    case Type::NONE:
+      break;
+  }
+
+  TRI_ASSERT(false);
+  return false;
+}
+
+/// @brief the wildcards of a LIKE pattern are (.|[\r\n]), and ICU's dot
+/// does not match the other line terminators U+000B, U+000C, U+0085,
+/// U+2028 and U+2029
+bool LiteralMatcher::hasLineTerminator(char const* ptr, size_t length) {
+  auto p = reinterpret_cast<unsigned char const*>(ptr);
+  auto const e = p + length;
+
+  while (p < e) {
+    unsigned char const c = *p++;
+    if (c < 0x0b || (c > 0x0c && c < 0xc2)) {
+      continue;
+    }
+    if (c == 0x0b || c == 0x0c) {
+      return true;
+    }
+    if (c == 0xc2 && p < e && *p == 0x85) {
+      return true;
+    }
+    if (c == 0xe2 && e - p >= 2 && p[0] == 0x80 &&
+        (p[1] == 0xa8 || p[1] == 0xa9)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool LiteralMatcher::contains(char const* ptr, size_t length,
+                              std::string const& literal) {
+  size_t const n = literal.size();
+  if (n == 0) {
+    return true;
+  }
+
+  char const first = literal[0];
+  char const* p = ptr;
+  char const* const last = ptr + length;
+
+  while (static_cast<size_t>(last - p) >= n) {
+    // let memchr find the candidates
+    p = static_cast<char const*>(memchr(p, first, (last - p) - n + 1));
+    if (p == nullptr) {
+      return false;
+    }
+    if (memcmp(p + 1, literal.data() + 1, n - 1) == 0) {
+      return true;
+    }
+    ++p;
+  }
+  return false;
+}
+
 RegexCache::~RegexCache() {
   clear();
 }
@@ -38,6 +116,11 @@ RegexCache::~RegexCache() {
 void RegexCache::clear() noexcept {
   clear(_regexCache);
   clear(_likeCache);
+  try {
+    _literalRegexCache.clear();
+    _literalLikeCache.clear();
+  } catch (...) {
+  }
 }
 
 icu::RegexMatcher* RegexCache::buildRegexMatcher(char const* ptr, size_t length, bool caseInsensitive) {
@@ -52,6 +135,40 @@ icu::RegexMatcher* RegexCache::buildLikeMatcher(char const* ptr, size_t length,
   return fromCache(_temp, _likeCache);
 }
 
+/// @brief the characters escaped by buildLikePattern
+static bool isRegexSpecial(char c) {
+  return (c == '?' || c == '+' || c == '[' || c == '(' || c == ')' ||
+          c == '{' || c == '}' || c == '^' || c == '$' || c == '|' ||
+          c == '\\' || c == '.' || c == '*');
+}
+
+LiteralMatcher const* RegexCache::buildLiteralLikeMatcher(char const* ptr, size_t length, bool caseInsensitive) {
+  if (caseInsensitive) {
+    // case folding is left to ICU
+    return nullptr;
+  }
+
+  _temp.assign(ptr, length);
+  auto it = _literalLikeCache.find(_temp);
+  if (it == _literalLikeCache.end()) {
+    it = _literalLikeCache.emplace(_temp, buildLiteralLike(ptr, length)).first;
+  }
+  return (*it).second.isLiteral() ? &(*it).second : nullptr;
+}
+
+LiteralMatcher const* RegexCache::buildLiteralRegexMatcher(char const* ptr, size_t length, bool caseInsensitive) {
+  if (caseInsensitive) {
+    return nullptr;
+  }
+
+  _temp.assign(ptr, length);
+  auto it = _literalRegexCache.find(_temp);
+  if (it == _literalRegexCache.end()) {
+    it = _literalRegexCache.emplace(_temp, buildLiteralRegex(ptr, length)).first;
+  }
+  return (*it).second.isLiteral() ? &(*it).second : nullptr;
+}
+
 static void escapeRegexParams(std::string &out, const char* ptr, size_t length) {
   for (size_t i = 0; i < length; ++i) {
     char const c = ptr[i];
@@ -125,7 +242,7 @@ icu::RegexMatcher* RegexCache::fromCache(std::string const& pattern,
 
   try {
     // insert into cache, no matter if pattern is valid or not
-    cache.emplace(_temp, matcher);
+    cache.emplace(pattern, matcher);
     return matcher;
   } catch (...) {
     delete matcher;
@@ -210,3 +327,97 @@ void RegexCache::buildLikePattern(std::string& out,
   // always anchor the pattern
   out.push_back('$');
 }
+
+/// @brief the literal matcher for a LIKE pattern, if it has no _ and
+/// % wildcards only at its ends. escape sequences are decoded like in
+/// buildLikePattern
+LiteralMatcher RegexCache::buildLiteralLike(char const* ptr, size_t length) {
+  std::string literal;
+  literal.reserve(length);
+
+  bool leading = false;
+  bool trailing = false;
+  bool escaped = false;
+
+  for (size_t i = 0; i < length; ++i) {
+    char const c = ptr[i];
+
+    if (c == '\\') {
+      if (escaped) {
+        literal.push_back('\\');
+      }
+      escaped = !escaped;
+      continue;
+    }
+
+    if (!escaped && c == '_') {
+      // wildcard character
+      return LiteralMatcher();
+    }
+    if (!escaped && c == '%') {
+      if (literal.empty() && !trailing) {
+        leading = true;
+      } else {
+        trailing = true;
+      }
+    } else {
+      if (trailing) {
+        // a wildcard in the middle of the pattern
+        return LiteralMatcher();
+      }
+      if (escaped && c != '%' && c != '_' && !isRegexSpecial(c)) {
+        // a backslash followed by no special character
+        literal.push_back('\\');
+      }
+      literal.push_back(c);
+    }
+    escaped = false;
+  }
+
+  if (leading && literal.empty()) {
+    // the pattern consists of wildcards only
+    trailing = true;
+  }
+
+  if ((leading || trailing) &&
+      LiteralMatcher::hasLineTerminator(literal.data(), literal.size())) {
+    return LiteralMatcher();
+  }
+
+  LiteralMatcher::Type type;
+  if (leading && trailing) {
+    type = literal.empty() ? LiteralMatcher::Type::PREFIX : LiteralMatcher::Type::INFIX;
+  } else if (leading) {
+    type = LiteralMatcher::Type::SUFFIX;
+  } else if (trailing) {
+    type = LiteralMatcher::Type::PREFIX;
+  } else {
+    type = LiteralMatcher::Type::EXACT;
+  }
+  return LiteralMatcher(type, std::move(literal), true);
+}
+
+/// @brief the literal matcher for a REGEX_TEST pattern without special
+/// characters, optionally anchored at the start
+LiteralMatcher RegexCache::buildLiteralRegex(char const* ptr, size_t length) {
+  bool anchored = false;
+  if (length > 0 && ptr[0] == '^') {
+    anchored = true;
+    ++ptr;
+    --length;
+  }
+
+  if (length == 0) {
+    return LiteralMatcher();
+  }
+
+  for (size_t i = 0; i < length; ++i) {
+    char const c = ptr[i];
+    if (c == ']' || isRegexSpecial(c)) {
+      return LiteralMatcher();
+    }
+  }
+
+  return LiteralMatcher(anchored ? LiteralMatcher::Type::PREFIX : LiteralMatcher::Type::INFIX,
+                        std::string(ptr, length), false);
+}
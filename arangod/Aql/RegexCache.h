@@ -37,6 +37,43 @@ class Methods;
 
 namespace aql {
 
+/// @brief matcher for LIKE and REGEX_TEST patterns that are a literal
+/// string with wildcards or anchors only at their ends. these are matched
+/// with memcmp and memchr instead of ICU, with the same results
+class LiteralMatcher {
+ public:
+  enum class Type {
+    NONE,    // the pattern needs the ICU matcher
+    EXACT,   // LIKE 'abc'
+    PREFIX,  // LIKE 'abc%', REGEX_TEST '^abc'
+    SUFFIX,  // LIKE '%abc'
+    INFIX    // LIKE '%abc%', REGEX_TEST 'abc'
+  };
+
+  LiteralMatcher() : _type(Type::NONE), _likeWildcards(false) {}
+  LiteralMatcher(Type type, std::string&& literal, bool likeWildcards)
+      : _type(type), _literal(std::move(literal)), _likeWildcards(likeWildcards) {}
+
+  bool isLiteral() const { return _type != Type::NONE; }
+
+  bool matches(char const* ptr, size_t length) const;
+
+  /// @brief whether the text contains a character that the wildcards of
+  /// a LIKE pattern do not match
+  static bool hasLineTerminator(char const* ptr, size_t length);
+
+ private:
+
+  static bool contains(char const* ptr, size_t length, std::string const& literal);
+
+ private:
+  Type _type;
+  std::string _literal;
+  /// @brief whether the characters outside of the literal are matched by
+  /// LIKE wildcards, and not just skipped by an unanchored regex
+  bool _likeWildcards;
+};
+
 class RegexCache {
  public:
   RegexCache(RegexCache const&) = delete;
@@ -50,6 +87,13 @@ class RegexCache {
   icu::RegexMatcher* buildRegexMatcher(char const* ptr, size_t length, bool caseInsensitive);
   icu::RegexMatcher* buildLikeMatcher(char const* ptr, size_t length, bool caseInsensitive);
   icu::RegexMatcher* buildSplitMatcher(AqlValue splitExpression, arangodb::transaction::Methods* trx, bool& isEmptyExpression);
+
+  /// @brief returns the literal matcher for a LIKE pattern, or nullptr if
+  /// the pattern needs the ICU matcher
+  LiteralMatcher const* buildLiteralLikeMatcher(char const* ptr, size_t length, bool caseInsensitive);
+  /// @brief returns the literal matcher for a REGEX_TEST pattern, or nullptr
+  /// if the pattern needs the ICU matcher
+  LiteralMatcher const* buildLiteralRegexMatcher(char const* ptr, size_t length, bool caseInsensitive);
  
  private: 
   /// @brief clear the specified cache
@@ -62,11 +106,18 @@ class RegexCache {
   static void buildRegexPattern(std::string& out, char const* ptr, size_t length, bool caseInsensitive);
   static void buildLikePattern(std::string& out, char const* ptr, size_t length, bool caseInsensitive);
 
+  static LiteralMatcher buildLiteralLike(char const* ptr, size_t length);
+  static LiteralMatcher buildLiteralRegex(char const* ptr, size_t length);
+
  private:
   /// @brief cache for compiled regexes (REGEX function)
   std::unordered_map<std::string, icu::RegexMatcher*> _regexCache;
   /// @brief cache for compiled regexes (LIKE function)
   std::unordered_map<std::string, icu::RegexMatcher*> _likeCache;
+  /// @brief cache for the literal matchers of case-sensitive patterns, also
+  /// for the patterns that turned out to need the ICU matcher
+  std::unordered_map<std::string, LiteralMatcher> _literalRegexCache;
+  std::unordered_map<std::string, LiteralMatcher> _literalLikeCache;
   /// @brief a reusable string object for pattern generation
   std::string _temp;
 };
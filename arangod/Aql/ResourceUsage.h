@@ -42,6 +42,15 @@ struct ResourceUsage {
 struct ResourceMonitor {
   ResourceMonitor() : currentResources(), maxResources() {}
   explicit ResourceMonitor(ResourceUsage const& maxResources) : currentResources(), maxResources(maxResources) {}
+  ~ResourceMonitor() { clear(); }
+
+  ResourceMonitor(ResourceMonitor const&) = delete;
+  ResourceMonitor& operator=(ResourceMonitor const&) = delete;
+
+  /// @brief the memory usage of all queries of the server
+  static uint64_t globalMemoryUsage() noexcept {
+    return GlobalMemoryUsage.load(std::memory_order_relaxed);
+  }
  
   void setMemoryLimit(size_t value) {
     maxResources.memoryUsage = value;
@@ -53,19 +62,26 @@ struct ResourceMonitor {
       THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_RESOURCE_LIMIT, "query would use more memory than allowed");
     }
     currentResources.memoryUsage += value;
+    GlobalMemoryUsage.fetch_add(value, std::memory_order_relaxed);
   }
   
   inline void decreaseMemoryUsage(size_t value) noexcept {
     TRI_ASSERT(currentResources.memoryUsage >= value);
     currentResources.memoryUsage -= value;
+    GlobalMemoryUsage.fetch_sub(value, std::memory_order_relaxed);
   }
 
   void clear() {
+    GlobalMemoryUsage.fetch_sub(currentResources.memoryUsage,
+                                std::memory_order_relaxed);
     currentResources.clear();
   }
 
   ResourceUsage currentResources;
   ResourceUsage maxResources;
+
+ private:
+  static std::atomic<uint64_t> GlobalMemoryUsage;
 };
 
 }
@@ -33,6 +33,8 @@
 #include "Aql/ExecutionEngine.h"
 #include "Aql/Query.h"
 #include "Aql/QueryRegistry.h"
+#include "Aql/SnippetPrefetch.h"
+#include "Aql/SnippetResultCache.h"
 #include "Basics/Exceptions.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/StringUtils.h"
@@ -224,8 +226,13 @@ void RestAqlHandler::setupClusterQuery() {
   VPackBuilder answerBuilder;
   answerBuilder.openObject();
   bool needToLock = true;
+  // all snippets and traverser engines of this request share the context
+  bool const sharedTransaction =
+      snippetsSlice.length() > 1 ||
+      (traverserSlice.isArray() && traverserSlice.length() > 0);
   bool res = registerSnippets(snippetsSlice, collectionBuilder.slice(), variablesSlice,
-                              options, ctx, ttl, needToLock, answerBuilder);
+                              options, ctx, ttl, sharedTransaction, needToLock,
+                              answerBuilder);
   if (!res) {
     // TODO we need to trigger cleanup here??
     // Registering the snippets failed.
@@ -254,6 +261,7 @@ bool RestAqlHandler::registerSnippets(
     std::shared_ptr<VPackBuilder> options,
     std::shared_ptr<transaction::Context> const& ctx,
     double const ttl,
+    bool const sharedTransaction,
     bool& needToLock,
     VPackBuilder& answerBuilder
     ) {
@@ -294,6 +302,9 @@ bool RestAqlHandler::registerSnippets(
     bool prepared = false;
     try {
       query->prepare(_queryRegistry, 0);
+      query->setSnippetCache(SnippetResultCache::create(
+          query.get(), it.value.get("nodes"), variablesSlice, collectionSlice));
+      query->setSnippetPrefetch(SnippetPrefetch::create(query.get(), sharedTransaction));
       prepared = true;
     } catch (std::exception const& ex) {
       LOG_TOPIC(ERR, arangodb::Logger::AQL)
@@ -672,6 +683,24 @@ bool RestAqlHandler::findQuery(std::string const& idString, Query*& query) {
 // handle for useQuery
 RestStatus RestAqlHandler::handleUseQuery(std::string const& operation, Query* query,
                                           VPackSlice const querySlice) {
+  // a batch computed ahead must be taken before the engine is used again,
+  // and before the job's continue callback is replaced
+  SnippetPrefetch* prefetch = query->snippetPrefetch();
+  ExecutionState prefetchedState = ExecutionState::DONE;
+  std::unique_ptr<AqlItemBlock> prefetched;
+  Result prefetchResult;
+  bool const hasPrefetched =
+      prefetch != nullptr &&
+      prefetch->take(prefetchedState, prefetched, prefetchResult);
+  if (prefetched != nullptr && operation != "getSome" &&
+      operation != "skipSome") {
+    // the rows of the current execution are not needed anymore
+    query->engine()->_itemBlockManager.returnBlock(std::move(prefetched));
+  }
+  // the next batch is computed ahead only after the response was written,
+  // the job and the handler must not use the query at the same time
+  size_t prefetchAtMost = 0;
+
   auto self = shared_from_this();
   query->setContinueHandler([this, self]() {
     continueHandlerExecution();
@@ -703,7 +732,11 @@ RestStatus RestAqlHandler::handleUseQuery(std::string const& operation, Query* q
       VPackObjectBuilder guard(&answerBuilder);
       if (operation == "lock") {
         // Mark current thread as potentially blocking:
-        int res = query->trx()->lockCollections();
+        int res;
+        {
+          QueryCounters::Scope counters(&query->engine()->_stats.counters);
+          res = query->trx()->lockCollections();
+        }
         // let exceptions propagate from here
 
         answerBuilder.add(StaticStrings::Error, VPackValue(res != TRI_ERROR_NO_ERROR));
@@ -713,10 +746,39 @@ RestStatus RestAqlHandler::handleUseQuery(std::string const& operation, Query* q
             querySlice, "atMost", ExecutionBlock::DefaultBatchSize());
         std::unique_ptr<AqlItemBlock> items;
         ExecutionState state;
-        if (shardId.empty()) {
-          std::tie(state, items) = query->engine()->getSome(atMost);
-          if (state == ExecutionState::WAITING) {
-            return RestStatus::WAITING;
+        SnippetResultCache* cache = query->snippetCache();
+        bool cached = false;
+        if (shardId.empty() && hasPrefetched) {
+          if (prefetchResult.fail()) {
+            THROW_ARANGO_EXCEPTION(prefetchResult);
+          }
+          state = prefetchedState;
+          items = std::move(prefetched);
+          if (items != nullptr && items->size() > atMost) {
+            // the coordinator asks for fewer rows than were computed ahead
+            std::unique_ptr<AqlItemBlock> rest(items->slice(atMost, items->size()));
+            std::unique_ptr<AqlItemBlock> first(items->slice(0, atMost));
+            query->engine()->_itemBlockManager.returnBlock(std::move(items));
+            items = std::move(first);
+            prefetch->putBack(state, std::move(rest));
+            state = ExecutionState::HASMORE;
+          } else if (state == ExecutionState::HASMORE) {
+            prefetchAtMost = atMost;
+          }
+        } else if (shardId.empty()) {
+          cached = (cache != nullptr && cache->getSome(query, atMost, answerBuilder));
+          if (!cached) {
+            std::tie(state, items) = query->engine()->getSome(atMost);
+            if (state == ExecutionState::WAITING) {
+              return RestStatus::WAITING;
+            }
+            if (cache != nullptr) {
+              cache->collect(query, items.get(), state == ExecutionState::DONE,
+                             query->hasWarnings());
+            }
+            if (prefetch != nullptr && state == ExecutionState::HASMORE) {
+              prefetchAtMost = atMost;
+            }
           }
         } else {
           auto block = dynamic_cast<BlockWithClients*>(query->engine()->root());
@@ -725,30 +787,51 @@ RestStatus RestAqlHandler::handleUseQuery(std::string const& operation, Query* q
             THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
                                            "unexpected node type");
           }
+          QueryCounters::Scope counters(&query->engine()->_stats.counters);
           std::tie(state, items) = block->getSomeForShard(atMost, shardId);
           if (state == ExecutionState::WAITING) {
             return RestStatus::WAITING;
           }
         }
-        // Used in 3.4.0 onwards.
-        answerBuilder.add("done", VPackValue(state == ExecutionState::DONE));
-        if (items.get() == nullptr) {
-          // Backwards Compatibility
-          answerBuilder.add("exhausted", VPackValue(true));
-          answerBuilder.add(StaticStrings::Error, VPackValue(false));
-        } else {
-          items->toVelocyPack(query->trx(), answerBuilder);
+        if (!cached) {
+          // Used in 3.4.0 onwards.
+          answerBuilder.add("done", VPackValue(state == ExecutionState::DONE));
+          if (items.get() == nullptr) {
+            // Backwards Compatibility
+            answerBuilder.add("exhausted", VPackValue(true));
+            answerBuilder.add(StaticStrings::Error, VPackValue(false));
+          } else {
+            items->toVelocyPack(query->trx(), answerBuilder);
+          }
         }
       } else if (operation == "skipSome") {
         auto atMost = VelocyPackHelper::getNumericValue<size_t>(
             querySlice, "atMost", ExecutionBlock::DefaultBatchSize());
         size_t skipped;
-        if (shardId.empty()) {
-          auto tmpRes = query->engine()->skipSome(atMost);
-          if (tmpRes.first == ExecutionState::WAITING) {
-            return RestStatus::WAITING;
+        SnippetResultCache* cache = query->snippetCache();
+        if (shardId.empty() && hasPrefetched) {
+          if (prefetchResult.fail()) {
+            THROW_ARANGO_EXCEPTION(prefetchResult);
+          }
+          // skip the rows computed ahead
+          skipped = 0;
+          if (prefetched != nullptr) {
+            skipped = (std::min)(atMost, prefetched->size());
+            if (skipped < prefetched->size()) {
+              prefetch->putBack(prefetchedState,
+                                std::unique_ptr<AqlItemBlock>(prefetched->slice(
+                                    skipped, prefetched->size())));
+            }
+            query->engine()->_itemBlockManager.returnBlock(std::move(prefetched));
+          }
+        } else if (shardId.empty()) {
+          if (cache == nullptr || !cache->skipSome(query, atMost, skipped)) {
+            auto tmpRes = query->engine()->skipSome(atMost);
+            if (tmpRes.first == ExecutionState::WAITING) {
+              return RestStatus::WAITING;
+            }
+            skipped = tmpRes.second;
           }
-          skipped = tmpRes.second;
         } else {
           auto block = dynamic_cast<BlockWithClients*>(query->engine()->root());
           if (block->getPlanNode()->getType() != ExecutionNode::SCATTER &&
@@ -757,6 +840,7 @@ RestStatus RestAqlHandler::handleUseQuery(std::string const& operation, Query* q
                                             "unexpected node type");
           }
 
+          QueryCounters::Scope counters(&query->engine()->_stats.counters);
           auto tmpRes = block->skipSomeForShard(atMost, shardId);
           if (tmpRes.first == ExecutionState::WAITING) {
             return RestStatus::WAITING;
@@ -774,7 +858,9 @@ RestStatus RestAqlHandler::handleUseQuery(std::string const& operation, Query* q
             VelocyPackHelper::getNumericValue<size_t>(querySlice, "pos", 0);
         std::unique_ptr<AqlItemBlock> items;
         Result res;
-        if (VelocyPackHelper::getBooleanValue(querySlice, "exhausted", true)) {
+        bool const exhausted =
+            VelocyPackHelper::getBooleanValue(querySlice, "exhausted", true);
+        if (exhausted) {
           auto tmpRes = query->engine()->initializeCursor(nullptr, 0);
           if (tmpRes.first == ExecutionState::WAITING) {
             return RestStatus::WAITING;
@@ -789,6 +875,9 @@ RestStatus RestAqlHandler::handleUseQuery(std::string const& operation, Query* q
           }
           res = tmpRes.second;
         }
+        if (query->snippetCache() != nullptr) {
+          query->snippetCache()->initializeCursor(!exhausted);
+        }
         answerBuilder.add(StaticStrings::Error, VPackValue(res.fail()));
         answerBuilder.add(StaticStrings::Code, VPackValue(res.errorNumber()));
       } else if (operation == "shutdown") {
@@ -824,6 +913,10 @@ RestStatus RestAqlHandler::handleUseQuery(std::string const& operation, Query* q
     } // here, answerBuilder is closed
 
     sendResponse(rest::ResponseCode::OK, answerBuilder.slice(), transactionContext.get());
+
+    if (prefetchAtMost > 0) {
+      prefetch->schedule(prefetchAtMost);
+    }
   } catch (arangodb::basics::Exception const& ex) {
     generateError(GeneralResponse::responseCode(ex.code()), ex.code(), ex.message());
   } catch (std::exception const& ex) {
@@ -109,6 +109,7 @@ class RestAqlHandler : public RestVocbaseBaseHandler {
                         std::shared_ptr<arangodb::velocypack::Builder> options,
                         std::shared_ptr<transaction::Context> const& ctx,
                         double const ttl,
+                        bool const sharedTransaction,
                         bool& needToLock,
                         arangodb::velocypack::Builder& answer);
 
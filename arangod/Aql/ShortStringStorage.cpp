@@ -29,16 +29,16 @@ using namespace arangodb::aql;
 
 /// @brief create a short string storage instance
 ShortStringStorage::ShortStringStorage(ResourceMonitor* resourceMonitor, size_t blockSize)
-    : _resourceMonitor(resourceMonitor), _blocks(), _blockSize(blockSize), _current(nullptr), _end(nullptr) {
+    : _resourceMonitor(resourceMonitor), _blocks(), _blockSize(blockSize), _allocated(0), _current(nullptr), _end(nullptr) {
   TRI_ASSERT(blockSize >= 64);
 }
 
 /// @brief destroy a short string storage instance
 ShortStringStorage::~ShortStringStorage() {
   for (auto& it : _blocks) {
-    _resourceMonitor->decreaseMemoryUsage(_blockSize);
     delete[] it;
   }
+  _resourceMonitor->decreaseMemoryUsage(_allocated);
 }
 
 /// @brief register a short string
@@ -78,6 +78,10 @@ void ShortStringStorage::allocateBlock() {
     }
     _current = buffer;
     _end = _current + _blockSize;
+    _allocated += _blockSize;
+    // queries with many strings (e.g. large IN lists) get bigger blocks, so
+    // that the number of allocations grows only logarithmically
+    _blockSize = (std::min)(_blockSize * 2, (std::max)(_blockSize, maxBlockSize()));
   } catch (...) {
     delete[] buffer;
     throw;
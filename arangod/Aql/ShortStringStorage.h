@@ -50,14 +50,21 @@ class ShortStringStorage {
   /// @brief maximum length of strings in short string storage
   static constexpr size_t maxStringLength() { return 127; }
 
+  /// @brief maximum size of a block. blocks start with the size passed to
+  /// the constructor and double in size up to this limit
+  static constexpr size_t maxBlockSize() { return 64 * 1024; }
+
  private:
   ResourceMonitor* _resourceMonitor;
 
   /// @brief already allocated string blocks
   std::vector<char*> _blocks;
 
-  /// @brief size of each block
-  size_t const _blockSize;
+  /// @brief size of the next block to allocate
+  size_t _blockSize;
+
+  /// @brief total size of all allocated blocks
+  size_t _allocated;
 
   /// @brief offset into current block
   char* _current;
@@ -29,6 +29,7 @@
 #include "Cluster/ClusterComm.h"
 #include "Graph/AttributeWeightShortestPathFinder.h"
 #include "Graph/ConstantWeightShortestPathFinder.h"
+#include "Graph/KShortestPathsFinder.h"
 #include "Graph/ShortestPathFinder.h"
 #include "Graph/ShortestPathResult.h"
 #include "Transaction/Methods.h"
@@ -55,6 +56,8 @@ ShortestPathBlock::ShortestPathBlock(ExecutionEngine* engine,
       _posInPath(0),
       _pathLength(0),
       _path(nullptr),
+      _kPathsFinder(nullptr),
+      _pathsOfInput(0),
       _startReg(ExecutionNode::MaxRegisterId),
       _useStartRegister(false),
       _targetReg(ExecutionNode::MaxRegisterId),
@@ -90,7 +93,13 @@ ShortestPathBlock::ShortestPathBlock(ExecutionEngine* engine,
   }
   _path = std::make_unique<arangodb::graph::ShortestPathResult>();
 
-  if (_opts->useWeight()) {
+  if (_opts->numberOfPaths > 1) {
+    // the paths are enumerated in order of their weight, for both weighted
+    // and unweighted edges
+    auto finder = std::make_unique<arangodb::graph::KShortestPathsFinder>(_opts);
+    _kPathsFinder = finder.get();
+    _finder = std::move(finder);
+  } else if (_opts->useWeight()) {
     _finder.reset(
         new arangodb::graph::AttributeWeightShortestPathFinder(_opts));
   } else {
@@ -131,6 +140,7 @@ std::pair<ExecutionState, arangodb::Result> ShortestPathBlock::initializeCursor(
   }
   _posInPath = 0;
   _pathLength = 0;
+  _pathsOfInput = 0;
   _usedConstant = false;
 
   return res;
@@ -271,17 +281,37 @@ bool ShortestPathBlock::nextPath(AqlItemBlock const* items) {
   VPackSlice end = _opts->getEnd();
   TRI_ASSERT(_finder != nullptr);
 
-  bool hasPath =
-      _finder->shortestPath(start, end, *_path, [this]() { throwIfKilled(); });
+  bool hasPath;
+  if (_kPathsFinder != nullptr) {
+    _kPathsFinder->startKShortestPathsTraversal(start, end);
+    hasPath = _kPathsFinder->getNextPath(*_path, [this]() { throwIfKilled(); });
+  } else {
+    hasPath =
+        _finder->shortestPath(start, end, *_path, [this]() { throwIfKilled(); });
+  }
 
   if (hasPath) {
     _posInPath = 0;
     _pathLength = _path->length();
+    _pathsOfInput = 1;
   }
 
   return hasPath;
 }
 
+bool ShortestPathBlock::nextPathOfInput() {
+  if (_kPathsFinder == nullptr || _pathsOfInput >= _opts->numberOfPaths) {
+    return false;
+  }
+  if (!_kPathsFinder->getNextPath(*_path, [this]() { throwIfKilled(); })) {
+    return false;
+  }
+  _posInPath = 0;
+  _pathLength = _path->length();
+  ++_pathsOfInput;
+  return true;
+}
+
 std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>>
 ShortestPathBlock::getSome(size_t atMost) {
   DEBUG_BEGIN_BLOCK();
@@ -296,7 +326,7 @@ ShortestPathBlock::getSome(size_t atMost) {
     }
 
     if (_buffer.empty()) {
-      size_t toFetch = (std::min)(DefaultBatchSize(), atMost);
+      size_t toFetch = (std::min)(upstreamBatchSize(), atMost);
       ExecutionState state;
       bool blockAppended;
       std::tie(state, blockAppended) = ExecutionBlock::getBlock(toFetch);
@@ -358,7 +388,7 @@ ShortestPathBlock::getSome(size_t atMost) {
       ++_posInPath;
     }
 
-    if (_posInPath >= _pathLength) {
+    if (_posInPath >= _pathLength && !nextPathOfInput()) {
       // Advance read position for next call
       if (++_pos >= cur->size()) {
         _buffer.pop_front();  // does not throw
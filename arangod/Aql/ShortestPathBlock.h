@@ -32,6 +32,7 @@ namespace arangodb {
 class ManagedDocumentResult;
 
 namespace graph {
+class KShortestPathsFinder;
 class ShortestPathFinder;
 class ShortestPathResult;
 }
@@ -67,6 +68,10 @@ class ShortestPathBlock final : public ExecutionBlock {
   /// @brief Compute the next shortest path
   bool nextPath(AqlItemBlock const*);
 
+  /// @brief Compute the next of several paths requested for the current
+  /// input row. returns false if there are no more paths for it
+  bool nextPathOfInput();
+
   /// @brief Checks if we output the vertex
   bool usesVertexOutput() { return _vertexVar != nullptr; }
 
@@ -102,6 +107,13 @@ class ShortestPathBlock final : public ExecutionBlock {
   /// @brief the shortest path finder.
   std::unique_ptr<arangodb::graph::ShortestPathFinder> _finder;
 
+  /// @brief the finder used if more than one path is requested per input
+  /// row. points into _finder
+  arangodb::graph::KShortestPathsFinder* _kPathsFinder;
+
+  /// @brief number of paths returned for the current input row
+  size_t _pathsOfInput;
+
   /// @brief The information to get the starting point, when a register id is
   /// used
   arangodb::aql::RegisterId _startReg;
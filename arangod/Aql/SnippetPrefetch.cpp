@@ -0,0 +1,201 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "SnippetPrefetch.h"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/ExecutionEngine.h"
+#include "Aql/Query.h"
+#include "Basics/ConditionLocker.h"
+#include "Cluster/ServerState.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
+#include "StorageEngine/TransactionState.h"
+#include "Transaction/Methods.h"
+#include "Utils/ExecContext.h"
+#include "VocBase/vocbase.h"
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+SnippetPrefetch::SnippetPrefetch(Query* query)
+    : _query(query), _state(std::make_shared<State>()) {
+  ExecContext const* exec = ExecContext::CURRENT;
+  if (exec != nullptr && !exec->isInternal()) {
+    _state->execContext.reset(
+        ExecContext::create(exec->user(), query->vocbase().name()));
+  }
+}
+
+SnippetPrefetch::~SnippetPrefetch() {
+  // a queued job will not touch the query anymore, a running one must
+  // finish before the query goes away
+  CONDITION_LOCKER(guard, _state->condition);
+  _state->cancelled = true;
+  while (_state->running) {
+    guard.wait();
+  }
+  if (_state->value != nullptr && _query->engine() != nullptr) {
+    _query->engine()->_itemBlockManager.returnBlock(std::move(_state->value));
+  }
+}
+
+std::unique_ptr<SnippetPrefetch> SnippetPrefetch::create(Query* query,
+                                                         bool sharedTransaction) {
+  if (!query->queryOptions().snippetPrefetch ||
+      SchedulerFeature::SCHEDULER == nullptr ||
+      !ServerState::instance()->isDBServer() ||
+      query->snippetCache() != nullptr) {
+    return nullptr;
+  }
+  // the snippets and traverser engines of a server share one transaction,
+  // and its context and collection cache are not synchronized. the job
+  // would use them while requests for the other snippets do, so only a
+  // snippet that is alone on its server computes ahead
+  if (sharedTransaction) {
+    return nullptr;
+  }
+  TRI_ASSERT(query->trx() != nullptr);
+  if (!query->trx()->state()->isReadOnlyTransaction()) {
+    return nullptr;
+  }
+  return std::make_unique<SnippetPrefetch>(query);
+}
+
+void SnippetPrefetch::schedule(size_t atMost) {
+  // do not buffer more results if the query is already using half of the
+  // memory it is allowed to use
+  ResourceMonitor const* monitor = _query->resourceMonitor();
+  if (monitor->maxResources.memoryUsage > 0 &&
+      monitor->currentResources.memoryUsage > monitor->maxResources.memoryUsage / 2) {
+    return;
+  }
+
+  std::shared_ptr<State> state = _state;
+  {
+    CONDITION_LOCKER(guard, state->condition);
+    TRI_ASSERT(!state->running && !state->done);
+    state->queued = true;
+  }
+
+  Query* query = _query;
+  auto job = [query, state, atMost]() {
+    {
+      CONDITION_LOCKER(guard, state->condition);
+      if (state->cancelled || !state->queued) {
+        // the query is gone, or the next request took over
+        return;
+      }
+      state->queued = false;
+      state->running = true;
+    }
+
+    ExecutionState executionState = ExecutionState::WAITING;
+    std::unique_ptr<AqlItemBlock> value;
+    Result res;
+    try {
+      ExecContextScope scope(state->execContext != nullptr
+                                 ? state->execContext.get()
+                                 : ExecContext::superuser());
+      // nobody needs to be woken up, the next request continues the snippet
+      query->setContinueCallback([]() {});
+      ExecutionEngine* engine = query->engine();
+      TRI_ASSERT(engine != nullptr);
+      std::tie(executionState, value) = engine->getSome(atMost);
+    } catch (arangodb::basics::Exception const& ex) {
+      res.reset(ex.code(), ex.message());
+    } catch (std::bad_alloc const&) {
+      res.reset(TRI_ERROR_OUT_OF_MEMORY);
+    } catch (std::exception const& ex) {
+      res.reset(TRI_ERROR_INTERNAL, ex.what());
+    } catch (...) {
+      res.reset(TRI_ERROR_INTERNAL);
+    }
+
+    CONDITION_LOCKER(guard, state->condition);
+    state->running = false;
+    if (res.ok() && executionState == ExecutionState::WAITING) {
+      // the snippet waits for a remote response. blocking the scheduler
+      // thread until it arrives could starve the threads that deliver it,
+      // so the next request continues the snippet itself
+      TRI_ASSERT(value == nullptr);
+    } else {
+      state->state = res.ok() ? executionState : ExecutionState::DONE;
+      state->value = std::move(value);
+      state->result = std::move(res);
+      state->done = true;
+    }
+    guard.broadcast();
+  };
+
+  if (!post(std::move(job))) {
+    // queue is full, the next request computes the batch itself
+    CONDITION_LOCKER(guard, state->condition);
+    state->queued = false;
+  }
+}
+
+bool SnippetPrefetch::post(std::function<void()> job) {
+  return SchedulerFeature::SCHEDULER->queue(RequestPriority::LOW, std::move(job));
+}
+
+bool SnippetPrefetch::take(ExecutionState& state,
+                           std::unique_ptr<AqlItemBlock>& value,
+                           Result& result) {
+  CONDITION_LOCKER(guard, _state->condition);
+  if (_state->queued) {
+    // the scheduler did not get to the job yet. we don't wait for it, all
+    // threads might be busy with requests like this one
+    _state->queued = false;
+    return false;
+  }
+  while (_state->running) {
+    guard.wait();
+  }
+  if (!_state->done) {
+    return false;
+  }
+  _state->done = false;
+  state = _state->state;
+  value = std::move(_state->value);
+  result = std::move(_state->result);
+  _state->result.reset();
+  return true;
+}
+
+void SnippetPrefetch::putBack(ExecutionState state,
+                              std::unique_ptr<AqlItemBlock>&& value) {
+  CONDITION_LOCKER(guard, _state->condition);
+  TRI_ASSERT(!_state->queued && !_state->running && !_state->done);
+  _state->state = state;
+  _state->value = std::move(value);
+  _state->result.reset();
+  _state->done = true;
+}
+
+void SnippetPrefetch::discard() {
+  ExecutionState state;
+  std::unique_ptr<AqlItemBlock> value;
+  Result result;
+  if (take(state, value, result) && value != nullptr) {
+    _query->engine()->_itemBlockManager.returnBlock(std::move(value));
+  }
+}
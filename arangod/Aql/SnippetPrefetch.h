@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_SNIPPET_PREFETCH_H
+#define ARANGOD_AQL_SNIPPET_PREFETCH_H 1
+
+#include "Basics/Common.h"
+#include "Aql/ExecutionState.h"
+#include "Basics/ConditionVariable.h"
+#include "Basics/Result.h"
+
+namespace arangodb {
+class ExecContext;
+
+namespace aql {
+class AqlItemBlock;
+class Query;
+
+/// @brief computes the next batch of a query snippet on a DB server on a
+/// scheduler thread, while the coordinator still processes the current one.
+/// only a snippet that has the transaction of its server to itself does
+/// this. the snippet is not open in the query registry while the job runs,
+/// so every request for the snippet must take (or discard) the prefetched
+/// batch before using the snippet's engine
+class SnippetPrefetch {
+ public:
+  SnippetPrefetch(SnippetPrefetch const&) = delete;
+  SnippetPrefetch& operator=(SnippetPrefetch const&) = delete;
+
+  explicit SnippetPrefetch(Query* query);
+
+  /// @brief waits for a running job, the query must not go away before
+  virtual ~SnippetPrefetch();
+
+  /// @brief create the prefetcher for a snippet, returns a nullptr if the
+  /// snippet should not compute its results ahead. sharedTransaction is
+  /// set if other snippets or traverser engines of the server use the
+  /// snippet's transaction as well
+  static std::unique_ptr<SnippetPrefetch> create(Query* query,
+                                                 bool sharedTransaction);
+
+  /// @brief posts a job computing the next batch of at most atMost rows
+  void schedule(size_t atMost);
+
+  /// @brief takes the prefetched batch, waits for the job if it is running.
+  /// returns false if there is none, a job that did not start yet is taken
+  /// over by the caller
+  bool take(ExecutionState& state, std::unique_ptr<AqlItemBlock>& value,
+            Result& result);
+
+  /// @brief hands back the rows of a taken batch that the caller did not
+  /// use, they are returned by the next take
+  void putBack(ExecutionState state, std::unique_ptr<AqlItemBlock>&& value);
+
+  /// @brief drops a prefetched batch, before the snippet's cursor is
+  /// initialized again or the snippet is shut down
+  void discard();
+
+ protected:
+  /// @brief runs the job on a scheduler thread, returns false if the
+  /// scheduler does not take it
+  virtual bool post(std::function<void()> job);
+
+ private:
+  /// @brief shared by the prefetcher and the job, the job only touches the
+  /// query if it was not cancelled
+  struct State {
+    State()
+        : queued(false),
+          running(false),
+          cancelled(false),
+          done(false),
+          state(ExecutionState::DONE) {}
+
+    basics::ConditionVariable condition;
+    bool queued;     // job posted, but not started
+    bool running;    // job computes the batch
+    bool cancelled;  // query is gone
+    bool done;       // batch (or error) available, not set if the
+                     // snippet had to wait for a remote response
+    ExecutionState state;
+    std::unique_ptr<AqlItemBlock> value;
+    Result result;
+    // the user of the snippet, jobs run without a request
+    std::shared_ptr<ExecContext> execContext;
+  };
+
+ private:
+  Query* _query;
+  std::shared_ptr<State> _state;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
@@ -0,0 +1,298 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "SnippetResultCache.h"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/ExecutionNode.h"
+#include "Aql/ExecutionPlan.h"
+#include "Aql/Query.h"
+#include "Aql/QueryCache.h"
+#include "Basics/Exceptions.h"
+#include "Basics/SmallVector.h"
+#include "Basics/StaticStrings.h"
+#include "Basics/VelocyPackHelper.h"
+#include "StorageEngine/TransactionState.h"
+#include "Transaction/Context.h"
+#include "Transaction/Methods.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+/// @brief node types that prevent caching the result of a snippet. they
+/// either depend on other servers, modify data or read data that is not
+/// covered by the invalidation of the snippet's shards
+std::vector<ExecutionNode::NodeType> const uncacheableNodeTypes{
+    ExecutionNode::REMOTE,     ExecutionNode::SCATTER,
+    ExecutionNode::GATHER,     ExecutionNode::DISTRIBUTE,
+    ExecutionNode::INSERT,     ExecutionNode::REMOVE,
+    ExecutionNode::REPLACE,    ExecutionNode::UPDATE,
+    ExecutionNode::UPSERT,     ExecutionNode::TRAVERSAL,
+    ExecutionNode::SHORTEST_PATH,
+#ifdef USE_IRESEARCH
+    ExecutionNode::ENUMERATE_IRESEARCH_VIEW,
+#endif
+};
+
+/// @brief node types that may be non-deterministic
+std::vector<ExecutionNode::NodeType> const checkedNodeTypes{
+    ExecutionNode::ENUMERATE_COLLECTION, ExecutionNode::CALCULATION,
+    ExecutionNode::SUBQUERY};
+
+/// @brief whether or not the result of the snippet's plan can be cached
+bool isCacheable(ExecutionPlan* plan) {
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+
+  plan->findNodesOfType(nodes, ::uncacheableNodeTypes, true);
+  if (!nodes.empty()) {
+    return false;
+  }
+
+  plan->findNodesOfType(nodes, ::checkedNodeTypes, true);
+  for (auto const& it : nodes) {
+    if (!it->isDeterministic()) {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+SnippetResultCache::SnippetResultCache(std::string&& key)
+    : _key(std::move(key)),
+      _hash(_key.hash()),
+      _usable(true),
+      _looked(false),
+      _blockPos(0),
+      _rowPos(0) {}
+
+SnippetResultCache::~SnippetResultCache() {}
+
+/// @brief create the cache for a snippet, returns a nullptr if the result
+/// of the snippet cannot be cached
+std::unique_ptr<SnippetResultCache> SnippetResultCache::create(
+    Query* query, VPackSlice nodes, VPackSlice variables,
+    VPackSlice collections) {
+  auto queryCacheMode = QueryCache::instance()->mode();
+
+  if (queryCacheMode == CACHE_ALWAYS_OFF || !query->queryOptions().cache) {
+    return nullptr;
+  }
+
+  // the coordinator collects the fullCount value from the statistics of the
+  // snippets, which are not produced for results served from the cache
+  if (query->queryOptions().fullCount) {
+    return nullptr;
+  }
+
+  // a snippet of a query that writes may see its own uncommitted writes
+  for (auto const& it : VPackArrayIterator(collections)) {
+    if (!it.get("type").isEqualString("READ")) {
+      return nullptr;
+    }
+  }
+
+  if (query->plan() == nullptr || !::isCacheable(query->plan())) {
+    return nullptr;
+  }
+
+  // the plan contains the names of the shards and the values of all bind
+  // parameters
+  std::string key("snippet:");
+  key.append(nodes.toJson());
+  key.append(variables.toJson());
+
+  return std::make_unique<SnippetResultCache>(std::move(key));
+}
+
+/// @brief the snippet's cursor was initialized. the result can only be
+/// served from or stored in the cache if there is no input
+void SnippetResultCache::initializeCursor(bool hasInput) {
+  _usable = !hasInput;
+  _looked = false;
+  _result.reset();
+  _blockPos = 0;
+  _rowPos = 0;
+  _collected.reset();
+}
+
+/// @brief look up the result in the cache, upon first usage after a
+/// cursor initialization
+void SnippetResultCache::lookup(Query* query) {
+  TRI_ASSERT(_usable && !_looked);
+  _looked = true;
+
+  auto cacheEntry =
+      QueryCache::instance()->lookup(&query->vocbase(), _hash, _key);
+  QueryCacheResultEntryGuard guard(cacheEntry);
+
+  if (cacheEntry != nullptr) {
+    TRI_ASSERT(cacheEntry->_queryResult != nullptr);
+    _result = cacheEntry->_queryResult;
+    return;
+  }
+
+  // not found, so collect the result of this execution
+  _collected = std::make_shared<VPackBuilder>();
+  _collected->openArray();
+}
+
+/// @brief stop collecting the result of the current execution
+void SnippetResultCache::abandon() {
+  _collected.reset();
+}
+
+/// @brief try to answer a getSome request from the cache. returns true
+/// if the response was added to the builder
+bool SnippetResultCache::getSome(Query* query, size_t atMost,
+                                 VPackBuilder& answer) {
+  if (!_usable) {
+    return false;
+  }
+  if (!_looked) {
+    lookup(query);
+  }
+  if (_result == nullptr) {
+    return false;
+  }
+
+  VPackSlice blocks = _result->slice();
+  size_t const n = static_cast<size_t>(blocks.length());
+
+  if (_blockPos >= n) {
+    answer.add("done", VPackValue(true));
+    answer.add("exhausted", VPackValue(true));
+    answer.add(StaticStrings::Error, VPackValue(false));
+    return true;
+  }
+
+  VPackSlice block = blocks.at(_blockPos);
+  size_t const nrItems =
+      basics::VelocyPackHelper::getNumericValue<size_t>(block, "nrItems", 0);
+
+  if (_rowPos == 0 && atMost >= nrItems) {
+    // hand out the serialized block as is
+    for (auto const& it : VPackObjectIterator(block)) {
+      answer.add(it.key.copyString(), it.value);
+    }
+    ++_blockPos;
+  } else {
+    // only part of the block was requested
+    size_t const toSend = (std::min)(atMost, nrItems - _rowPos);
+    AqlItemBlock items(query->resourceMonitor(), block);
+    std::unique_ptr<AqlItemBlock> part(items.slice(_rowPos, _rowPos + toSend));
+    part->toVelocyPack(query->trx(), answer);
+    _rowPos += toSend;
+    if (_rowPos == nrItems) {
+      ++_blockPos;
+      _rowPos = 0;
+    }
+  }
+
+  answer.add("done", VPackValue(_blockPos >= n));
+  return true;
+}
+
+/// @brief try to answer a skipSome request from the cache. returns true
+/// if the request was served from the cache
+bool SnippetResultCache::skipSome(Query* query, size_t atMost,
+                                  size_t& skipped) {
+  if (!_usable) {
+    return false;
+  }
+  if (!_looked) {
+    lookup(query);
+  }
+  if (_result == nullptr) {
+    // the skipped rows are not part of the result
+    abandon();
+    return false;
+  }
+
+  VPackSlice blocks = _result->slice();
+  size_t const n = static_cast<size_t>(blocks.length());
+
+  skipped = 0;
+  while (skipped < atMost && _blockPos < n) {
+    size_t const nrItems = basics::VelocyPackHelper::getNumericValue<size_t>(
+        blocks.at(_blockPos), "nrItems", 0);
+    size_t const toSkip = (std::min)(atMost - skipped, nrItems - _rowPos);
+    skipped += toSkip;
+    _rowPos += toSkip;
+    if (_rowPos == nrItems) {
+      ++_blockPos;
+      _rowPos = 0;
+    }
+  }
+  return true;
+}
+
+/// @brief add a result block produced by the snippet itself. once the
+/// snippet is done, the collected result is stored in the cache
+void SnippetResultCache::collect(Query* query, AqlItemBlock const* items,
+                                 bool done, bool hasWarnings) {
+  if (_collected == nullptr) {
+    return;
+  }
+
+  transaction::Methods* trx = query->trx();
+
+  if (items != nullptr) {
+    VPackBuilder serialized;
+    {
+      VPackObjectBuilder guard(&serialized);
+      items->toVelocyPack(trx, serialized);
+    }
+    // the cached result must not contain pointers into the storage engine
+    // or custom types that depend on the transaction
+    basics::VelocyPackHelper::sanitizeNonClientTypes(
+        serialized.slice(), VPackSlice::noneSlice(), *_collected,
+        trx->transactionContextPtr()->getVPackOptions(), true, true);
+
+    if (_collected->size() > MaxResultSize) {
+      abandon();
+      return;
+    }
+  }
+
+  if (!done) {
+    return;
+  }
+
+  _collected->close();
+
+  if (!hasWarnings) {
+    auto result = QueryCache::instance()->store(
+        &query->vocbase(), _hash, _key, _collected,
+        trx->state()->collectionNames());
+
+    if (result == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+  }
+  _collected.reset();
+}
@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_SNIPPET_RESULT_CACHE_H
+#define ARANGOD_AQL_SNIPPET_RESULT_CACHE_H 1
+
+#include "Basics/Common.h"
+#include "Aql/QueryString.h"
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+class Slice;
+}
+
+namespace aql {
+class AqlItemBlock;
+class Query;
+
+/// @brief result cache for a query snippet executed on a DB server.
+/// the complete result of a snippet is kept in the query cache, under a key
+/// built from the snippet's plan (which contains the shard names and the
+/// already injected bind parameter values). the entry is registered for all
+/// shards of the snippet's transaction, so that any write to one of the
+/// shards invalidates it, just like collection writes do on a single server
+class SnippetResultCache {
+ public:
+  SnippetResultCache(SnippetResultCache const&) = delete;
+  SnippetResultCache& operator=(SnippetResultCache const&) = delete;
+
+  explicit SnippetResultCache(std::string&& key);
+  ~SnippetResultCache();
+
+  /// @brief create the cache for a snippet, returns a nullptr if the result
+  /// of the snippet cannot be cached
+  static std::unique_ptr<SnippetResultCache> create(
+      Query* query, arangodb::velocypack::Slice nodes,
+      arangodb::velocypack::Slice variables,
+      arangodb::velocypack::Slice collections);
+
+  /// @brief the snippet's cursor was initialized. the result can only be
+  /// served from or stored in the cache if there is no input
+  void initializeCursor(bool hasInput);
+
+  /// @brief try to answer a getSome request from the cache. returns true
+  /// if the response was added to the builder
+  bool getSome(Query* query, size_t atMost,
+               arangodb::velocypack::Builder& answer);
+
+  /// @brief try to answer a skipSome request from the cache. returns true
+  /// if the request was served from the cache
+  bool skipSome(Query* query, size_t atMost, size_t& skipped);
+
+  /// @brief add a result block produced by the snippet itself. once the
+  /// snippet is done, the collected result is stored in the cache
+  void collect(Query* query, AqlItemBlock const* items, bool done,
+               bool hasWarnings);
+
+ private:
+  /// @brief look up the result in the cache, upon first usage after a
+  /// cursor initialization
+  void lookup(Query* query);
+
+  /// @brief stop collecting the result of the current execution
+  void abandon();
+
+ private:
+  /// @brief maximum size of a collected snippet result. bigger results are
+  /// not cached
+  static constexpr size_t MaxResultSize = 16 * 1024 * 1024;
+
+  /// @brief cache key, the snippet's plan
+  QueryString _key;
+
+  /// @brief hash value of the cache key
+  uint64_t const _hash;
+
+  /// @brief whether or not the current execution may use the cache
+  bool _usable;
+
+  /// @brief whether or not the cache was looked up for the current execution
+  bool _looked;
+
+  /// @brief cached result, an array of serialized AqlItemBlocks
+  std::shared_ptr<arangodb::velocypack::Builder> _result;
+
+  /// @brief position of the next block to serve from _result
+  size_t _blockPos;
+
+  /// @brief position of the next row to serve inside the current block
+  size_t _rowPos;
+
+  /// @brief result being collected in the current execution, nullptr if
+  /// nothing is collected
+  std::shared_ptr<arangodb::velocypack::Builder> _collected;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
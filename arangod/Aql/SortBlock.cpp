@@ -25,36 +25,130 @@
 #include "Aql/AqlItemBlock.h"
 #include "Aql/ExecutionEngine.h"
 #include "Basics/Exceptions.h"
+#include "Basics/Utf8Helper.h"
 #include "VocBase/vocbase.h"
 
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
 using namespace arangodb::aql;
 
 namespace {
 
+/// @brief minimal number of rows for which the sort keys of strings are
+/// built before sorting. a key costs about as much as one comparison with
+/// the collator, and every row takes part in log(n) comparisons
+size_t const MinRowsForSortKeys = 32;
+
+/// @brief collation sort key of a string value in a sort register
+struct SortKey {
+  std::string key;
+  // length of the original string, which breaks ties of equal keys
+  size_t length = 0;
+  bool valid = false;
+};
+
+/// @brief sort keys of the string values in the buffer. the key of register
+/// r of row i of block b is keys[(offsets[b] + i) * nrSortRegisters + r]
+struct SortKeys {
+  std::vector<size_t> offsets;
+  std::vector<SortKey> keys;
+};
+
+/// @brief compares two sort keys like AqlValue::Compare compares the strings
+int compareSortKeys(SortKey const& lhs, SortKey const& rhs) {
+  size_t const n = (std::min)(lhs.key.size(), rhs.key.size());
+  int res = memcmp(lhs.key.data(), rhs.key.data(), n);
+  if (res != 0) {
+    return (res < 0 ? -1 : 1);
+  }
+  if (lhs.key.size() != rhs.key.size()) {
+    return (lhs.key.size() < rhs.key.size() ? -1 : 1);
+  }
+  // strings equal for the collator, the shorter one goes first
+  if (lhs.length != rhs.length) {
+    return (lhs.length < rhs.length ? -1 : 1);
+  }
+  return 0;
+}
+
+/// @brief builds the sort keys of the string values of the sort registers.
+/// registers with a scorer have their own comparison and get no keys
+void buildSortKeys(std::deque<AqlItemBlock*> const& buffer,
+                   std::vector<SortRegister> const& sortRegisters,
+                   size_t rows, SortKeys& result) {
+  size_t const nrSortRegs = sortRegisters.size();
+  result.offsets.reserve(buffer.size());
+  result.keys.resize(rows * nrSortRegs);
+
+  size_t offset = 0;
+  for (auto const& block : buffer) {
+    result.offsets.emplace_back(offset);
+    size_t const n = block->size();
+
+    for (size_t r = 0; r < nrSortRegs; ++r) {
+      auto const& reg = sortRegisters[r];
+#ifdef USE_IRESEARCH
+      if (reg.scorer) {
+        continue;
+      }
+#endif
+      for (size_t i = 0; i < n; ++i) {
+        AqlValue const& value = block->getValueReference(i, reg.reg);
+        if (!value.isString()) {
+          continue;
+        }
+        VPackValueLength length;
+        char const* p = value.slice().getString(length);
+        SortKey& key = result.keys[(offset + i) * nrSortRegs + r];
+        key.length = static_cast<size_t>(length);
+        key.valid = arangodb::basics::Utf8Helper::DefaultUtf8Helper.appendSortKey(
+            p, static_cast<size_t>(length), key.key);
+      }
+    }
+    offset += n;
+  }
+}
+
 /// @brief OurLessThan
 class OurLessThan {
  public:
   OurLessThan(
       arangodb::transaction::Methods* trx,
       std::deque<AqlItemBlock*>& buffer,
-      std::vector<SortRegister>& sortRegisters) noexcept
+      std::vector<SortRegister>& sortRegisters,
+      SortKeys const* keys = nullptr) noexcept
     : _trx(trx),
       _buffer(buffer),
-      _sortRegisters(sortRegisters) {
+      _sortRegisters(sortRegisters),
+      _keys(keys) {
   }
 
   bool operator()(std::pair<uint32_t, uint32_t> const& a,
                   std::pair<uint32_t, uint32_t> const& b) const {
-    for (auto const& reg : _sortRegisters) {
-      auto const& lhs = _buffer[a.first]->getValueReference(a.second, reg.reg);
-      auto const& rhs = _buffer[b.first]->getValueReference(b.second, reg.reg);
+    size_t const nrSortRegs = _sortRegisters.size();
+
+    for (size_t r = 0; r < nrSortRegs; ++r) {
+      auto const& reg = _sortRegisters[r];
+      int cmp;
+
+      SortKey const* lhsKey = key(a, r);
+      SortKey const* rhsKey = (lhsKey == nullptr ? nullptr : key(b, r));
+
+      if (rhsKey != nullptr) {
+        cmp = compareSortKeys(*lhsKey, *rhsKey);
+      } else {
+        auto const& lhs = _buffer[a.first]->getValueReference(a.second, reg.reg);
+        auto const& rhs = _buffer[b.first]->getValueReference(b.second, reg.reg);
 
 #ifdef USE_IRESEARCH
-      TRI_ASSERT(reg.comparator);
-      int const cmp = (*reg.comparator)(reg.scorer.get(), _trx, lhs, rhs);
+        TRI_ASSERT(reg.comparator);
+        cmp = (*reg.comparator)(reg.scorer.get(), _trx, lhs, rhs);
 #else
-      int const cmp = AqlValue::Compare(_trx, lhs, rhs, true);
+        cmp = AqlValue::Compare(_trx, lhs, rhs, true);
 #endif
+      }
 
       if (cmp < 0) {
         return reg.asc;
@@ -66,18 +160,103 @@ class OurLessThan {
     return false;
   }
 
+ private:
+  SortKey const* key(std::pair<uint32_t, uint32_t> const& row,
+                     size_t r) const {
+    if (_keys == nullptr) {
+      return nullptr;
+    }
+    SortKey const& k =
+        _keys->keys[(_keys->offsets[row.first] + row.second) *
+                        _sortRegisters.size() + r];
+    return (k.valid ? &k : nullptr);
+  }
+
  private:
   arangodb::transaction::Methods* _trx;
   std::deque<AqlItemBlock*>& _buffer;
   std::vector<SortRegister>& _sortRegisters;
+  SortKeys const* _keys;
 }; // OurLessThan
 
+/// @brief comparator that breaks ties by input position, so that the
+/// non-stable partial sort yields the same order as a stable sort
+class OurStableLessThan {
+ public:
+  explicit OurStableLessThan(OurLessThan const& lessThan) noexcept
+    : _lessThan(lessThan) {}
+
+  bool operator()(std::pair<uint32_t, uint32_t> const& a,
+                  std::pair<uint32_t, uint32_t> const& b) const {
+    if (_lessThan(a, b)) {
+      return true;
+    }
+    if (_lessThan(b, a)) {
+      return false;
+    }
+    return a < b;
+  }
+
+ private:
+  OurLessThan const& _lessThan;
+}; // OurStableLessThan
+
+/// @brief compares the current rows of two spilled runs. returns true if
+/// the row of run a must be produced after the row of run b, so that
+/// the heap functions put the next output row at the front. ties are
+/// broken by run index, which keeps the original input order
+class OurRunGreaterThan {
+ public:
+  OurRunGreaterThan(
+      arangodb::transaction::Methods* trx,
+      std::vector<std::unique_ptr<SpillFile>> const& runs,
+      std::vector<SortRegister>& sortRegisters) noexcept
+    : _trx(trx),
+      _runs(runs),
+      _sortRegisters(sortRegisters) {
+  }
+
+  bool operator()(size_t a, size_t b) const {
+    VPackSlice lhsRow = _runs[a]->current();
+    VPackSlice rhsRow = _runs[b]->current();
+
+    for (auto const& reg : _sortRegisters) {
+      // non-owning values pointing into the run buffers
+      AqlValue const lhs(lhsRow.at(reg.reg).begin());
+      AqlValue const rhs(rhsRow.at(reg.reg).begin());
+
+#ifdef USE_IRESEARCH
+      TRI_ASSERT(reg.comparator);
+      int const cmp = (*reg.comparator)(reg.scorer.get(), _trx, lhs, rhs);
+#else
+      int const cmp = AqlValue::Compare(_trx, lhs, rhs, true);
+#endif
+
+      if (cmp < 0) {
+        return !reg.asc;
+      } else if (cmp > 0) {
+        return reg.asc;
+      }
+    }
+
+    return a > b;
+  }
+
+ private:
+  arangodb::transaction::Methods* _trx;
+  std::vector<std::unique_ptr<SpillFile>> const& _runs;
+  std::vector<SortRegister>& _sortRegisters;
+}; // OurRunGreaterThan
+
 }
 
 SortBlock::SortBlock(ExecutionEngine* engine, SortNode const* en)
   : ExecutionBlock(engine, en),
     _stable(en->_stable),
-    _mustFetchAll(true) {
+    _mustFetchAll(true),
+    _limit(en->_limit),
+    _spillThreshold(engine->getQuery()->queryOptions().sortSpillThreshold),
+    _spilledNrRegs(0) {
   TRI_ASSERT(en && en->plan() && en->getRegisterPlan());
   SortRegister::fill(
     *en->plan(),
@@ -102,6 +281,8 @@ std::pair<ExecutionState, arangodb::Result> SortBlock::initializeCursor(
 
   _mustFetchAll = !_done;
   _pos = 0;
+  _runs.clear();
+  _mergeHeap.clear();
 
   return res; 
 
@@ -119,30 +300,55 @@ std::pair<ExecutionState, arangodb::Result> SortBlock::getOrSkipSome(
     ExecutionState res = ExecutionState::HASMORE;
     // suck all blocks into _buffer
     while (res != ExecutionState::DONE) {
-      res = getBlock(DefaultBatchSize()).first;
+      res = getBlock(upstreamBatchSize()).first;
       if (res == ExecutionState::WAITING) {
         return {res, TRI_ERROR_NO_ERROR};
       }
+      if (_limit > 0 && res != ExecutionState::DONE &&
+          bufferedRows() >= _limit + (std::max)(_limit, DefaultBatchSize())) {
+        // only keep the top rows seen so far, so memory usage stays
+        // proportional to the limit and not to the input size
+        doSorting(_limit);
+      } else if (_limit == 0 && _spillThreshold > 0 &&
+                 res != ExecutionState::DONE && bufferedRows() >= _spillThreshold) {
+        // buffer is too big to keep in memory. write it out as a sorted
+        // run and merge all runs later
+        spillBuffer();
+      }
     }
 
     _mustFetchAll = false;
-    if (!_buffer.empty()) {
-      doSorting();
+    if (!_runs.empty()) {
+      if (!_buffer.empty()) {
+        spillBuffer();
+      }
+      startMerging();
+    } else if (!_buffer.empty()) {
+      doSorting(_limit);
     }
   }
 
+  if (!_runs.empty()) {
+    return getOrSkipSomeFromRuns(atMost, skipping, result, skipped);
+  }
+
   return ExecutionBlock::getOrSkipSome(atMost, skipping, result, skipped);
   // cppcheck-suppress style
   DEBUG_END_BLOCK();
 }
 
-void SortBlock::doSorting() {
-  DEBUG_BEGIN_BLOCK();  
-
+size_t SortBlock::bufferedRows() const {
   size_t sum = 0;
   for (auto const& block : _buffer) {
     sum += block->size();
   }
+  return sum;
+}
+
+void SortBlock::doSorting(size_t limit) {
+  DEBUG_BEGIN_BLOCK();  
+
+  size_t sum = bufferedRows();
 
   TRI_IF_FAILURE("SortBlock::doSorting") {
     THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
@@ -166,11 +372,30 @@ void SortBlock::doSorting() {
     ++count;
   }
 
+  // with enough rows, the collator runs once per string instead of once
+  // per comparison
+  SortKeys keys;
+  if (sum >= MinRowsForSortKeys) {
+    buildSortKeys(_buffer, _sortRegisters, sum, keys);
+  }
+
   // comparison function
-  OurLessThan ourLessThan(_trx, _buffer, _sortRegisters);
+  OurLessThan ourLessThan(_trx, _buffer, _sortRegisters,
+                          keys.keys.empty() ? nullptr : &keys);
 
   // sort coords
-  if (_stable) {
+  if (limit > 0 && limit < sum) {
+    // we only need the first rows of the result
+    if (_stable) {
+      std::partial_sort(coords.begin(), coords.begin() + limit, coords.end(),
+                        OurStableLessThan(ourLessThan));
+    } else {
+      std::partial_sort(coords.begin(), coords.begin() + limit, coords.end(),
+                        ourLessThan);
+    }
+    coords.resize(limit);
+    sum = limit;
+  } else if (_stable) {
     std::stable_sort(coords.begin(), coords.end(), ourLessThan);
   } else {
     std::sort(coords.begin(), coords.end(), ourLessThan);
@@ -190,7 +415,7 @@ void SortBlock::doSorting() {
     // install the rearranged values from _buffer into newbuffer
 
     while (count < sum) {
-      size_t sizeNext = (std::min)(sum - count, DefaultBatchSize());
+      size_t sizeNext = (std::min)(sum - count, batchSize());
       AqlItemBlock* next = requestBlock(sizeNext, nrRegs);
 
       try {
@@ -303,3 +528,127 @@ void SortBlock::doSorting() {
   }
   DEBUG_END_BLOCK();  
 }
+
+void SortBlock::spillBuffer() {
+  DEBUG_BEGIN_BLOCK();
+  TRI_ASSERT(!_buffer.empty());
+
+  TRI_IF_FAILURE("SortBlock::spillBuffer") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+
+  doSorting(0);
+
+  auto run = std::make_unique<SpillFile>();
+  RegisterId const nrRegs = _buffer.front()->getNrRegs();
+  TRI_ASSERT(_spilledNrRegs == 0 || _spilledNrRegs == nrRegs);
+  _spilledNrRegs = nrRegs;
+
+  VPackBuilder row;
+
+  for (auto const& block : _buffer) {
+    size_t const n = block->size();
+    for (size_t i = 0; i < n; ++i) {
+      row.clear();
+      row.openArray();
+      for (RegisterId j = 0; j < nrRegs; ++j) {
+        AqlValue const& a = block->getValueReference(i, j);
+        if (a.isEmpty()) {
+          // empty registers are stored as illegal values
+          row.add(VPackValue(VPackValueType::Illegal));
+        } else {
+          a.toVelocyPack(_trx, row, false);
+        }
+      }
+      row.close();
+      run->append(row.slice());
+    }
+  }
+
+  run->finish();
+  _runs.emplace_back(std::move(run));
+
+  for (auto& x : _buffer) {
+    returnBlock(x);
+  }
+  _buffer.clear();
+  _pos = 0;
+
+  DEBUG_END_BLOCK();
+}
+
+void SortBlock::startMerging() {
+  _mergeHeap.clear();
+  _mergeHeap.reserve(_runs.size());
+
+  for (size_t i = 0; i < _runs.size(); ++i) {
+    if (_runs[i]->next()) {
+      _mergeHeap.emplace_back(i);
+    }
+  }
+
+  std::make_heap(_mergeHeap.begin(), _mergeHeap.end(),
+                 OurRunGreaterThan(_trx, _runs, _sortRegisters));
+}
+
+std::pair<ExecutionState, arangodb::Result> SortBlock::getOrSkipSomeFromRuns(
+    size_t atMost, bool skipping, AqlItemBlock*& result, size_t& skipped) {
+  DEBUG_BEGIN_BLOCK();
+  TRI_ASSERT(result == nullptr && skipped == 0);
+
+  OurRunGreaterThan ourRunGreaterThan(_trx, _runs, _sortRegisters);
+
+  std::unique_ptr<AqlItemBlock> res;
+  if (!skipping && !_mergeHeap.empty()) {
+    res.reset(requestBlock(atMost, _spilledNrRegs));
+  }
+
+  size_t count = 0;
+  while (count < atMost && !_mergeHeap.empty()) {
+    size_t const run = _mergeHeap.front();
+
+    if (!skipping) {
+      RegisterId j = 0;
+      for (auto const& value : VPackArrayIterator(_runs[run]->current())) {
+        if (!value.isIllegal()) {
+          res->emplaceValue(count, j, value);
+        }
+        ++j;
+      }
+      TRI_ASSERT(j == _spilledNrRegs);
+    }
+    ++count;
+
+    std::pop_heap(_mergeHeap.begin(), _mergeHeap.end(), ourRunGreaterThan);
+    if (_runs[run]->next()) {
+      std::push_heap(_mergeHeap.begin(), _mergeHeap.end(), ourRunGreaterThan);
+    } else {
+      _mergeHeap.pop_back();
+    }
+  }
+
+  if (_mergeHeap.empty()) {
+    // all runs consumed, remove the temporary files
+    _runs.clear();
+    _done = true;
+  }
+
+  if (res != nullptr) {
+    if (count == 0) {
+      AqlItemBlock* unused = res.release();
+      returnBlock(unused);
+    } else {
+      if (count < atMost) {
+        res->shrink(count);
+      }
+      result = res.release();
+    }
+  }
+
+  skipped = count;
+
+  return {_done ? ExecutionState::DONE : ExecutionState::HASMORE, TRI_ERROR_NO_ERROR};
+
+  // cppcheck-suppress style
+  DEBUG_END_BLOCK();
+}
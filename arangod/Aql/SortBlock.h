@@ -28,6 +28,7 @@
 #include "Aql/ExecutionBlock.h"
 #include "Aql/SortNode.h"
 #include "Aql/SortRegister.h"
+#include "Aql/SpillFile.h"
 
 namespace arangodb {
 namespace aql {
@@ -53,9 +54,23 @@ class SortBlock final : public ExecutionBlock {
       size_t atMost, bool skipping, AqlItemBlock*&,
       size_t& skipped) override final;
 
-  /// @brief dosorting
+  /// @brief dosorting. if limit is non-zero, only the first limit rows
+  /// of the sorted result are kept
  private:
-  void doSorting();
+  void doSorting(size_t limit);
+
+  /// @brief number of rows currently held in _buffer
+  size_t bufferedRows() const;
+
+  /// @brief sort the rows in _buffer and write them to a new run on disk
+  void spillBuffer();
+
+  /// @brief position all runs on their first row and build the merge heap
+  void startMerging();
+
+  /// @brief produce or skip rows by merging the spilled runs
+  std::pair<ExecutionState, Result> getOrSkipSomeFromRuns(
+      size_t atMost, bool skipping, AqlItemBlock*&, size_t& skipped);
 
   /// @brief pairs, consisting of variable and sort direction
   /// (true = ascending | false = descending)
@@ -65,6 +80,24 @@ class SortBlock final : public ExecutionBlock {
   bool _stable;
 
   bool _mustFetchAll;
+
+  /// @brief maximum number of rows to produce, 0 = unlimited. if set,
+  /// the buffer is periodically reduced to the top rows while fetching
+  size_t const _limit;
+
+  /// @brief number of buffered rows after which the buffer is sorted and
+  /// spilled to disk, 0 = never spill
+  size_t const _spillThreshold;
+
+  /// @brief sorted runs spilled to disk
+  std::vector<std::unique_ptr<SpillFile>> _runs;
+
+  /// @brief heap of indexes into _runs, ordered by the current row of each
+  /// run. the run with the next output row is at the front
+  std::vector<size_t> _mergeHeap;
+
+  /// @brief number of registers of the spilled rows
+  RegisterId _spilledNrRegs;
 };
 
 }  // namespace arangodb::aql
@@ -27,13 +27,15 @@
 #include "Aql/SortBlock.h"
 #include "Aql/WalkerWorker.h"
 #include "Basics/StringBuffer.h"
+#include "Basics/VelocyPackHelper.h"
 
 using namespace arangodb::basics;
 using namespace arangodb::aql;
 
 SortNode::SortNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& base,
                    SortElementVector const& elements, bool stable)
-    : ExecutionNode(plan, base), _reinsertInCluster(true),  _elements(elements), _stable(stable){}
+    : ExecutionNode(plan, base), _reinsertInCluster(true),  _elements(elements), _stable(stable),
+      _limit(arangodb::basics::VelocyPackHelper::getNumericValue<size_t>(base, "limit", 0)) {}
 
 /// @brief toVelocyPack, for SortNode
 void SortNode::toVelocyPackHelper(VPackBuilder& nodes, unsigned flags) const {
@@ -57,6 +59,7 @@ void SortNode::toVelocyPackHelper(VPackBuilder& nodes, unsigned flags) const {
     }
   }
   nodes.add("stable", VPackValue(_stable));
+  nodes.add("limit", VPackValue(_limit));
 
   // And close it:
   nodes.close();
@@ -204,5 +207,11 @@ double SortNode::estimateCost(size_t& nrItems) const {
   if (nrItems <= 3.0) {
     return depCost + nrItems;
   }
+  if (_limit > 0 && _limit < nrItems) {
+    // we only need to keep the top rows around
+    double cost = depCost + nrItems * std::log2(static_cast<double>((std::max)(_limit, static_cast<size_t>(2))));
+    nrItems = _limit;
+    return cost;
+  }
   return depCost + nrItems * std::log2(static_cast<double>(nrItems));
 }
@@ -53,7 +53,7 @@ class SortNode : public ExecutionNode {
  public:
   SortNode(ExecutionPlan* plan, size_t id, SortElementVector const& elements,
            bool stable)
-      : ExecutionNode(plan, id), _reinsertInCluster(true), _elements(elements), _stable(stable) {}
+      : ExecutionNode(plan, id), _reinsertInCluster(true), _elements(elements), _stable(stable), _limit(0) {}
 
   SortNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& base,
            SortElementVector const& elements, bool stable);
@@ -64,6 +64,13 @@ class SortNode : public ExecutionNode {
   /// @brief whether or not the sort is stable
   inline bool isStable() const { return _stable; }
 
+  /// @brief maximum number of rows the sort needs to produce, 0 = unlimited.
+  /// this is set by the optimizer if the sort is followed by a LIMIT
+  inline size_t limit() const { return _limit; }
+
+  /// @brief set the maximum number of rows the sort needs to produce
+  void setLimit(size_t limit) { _limit = limit; }
+
   /// @brief export to VelocyPack
   void toVelocyPackHelper(arangodb::velocypack::Builder&,
                           unsigned flags) const override final;
@@ -77,11 +84,10 @@ class SortNode : public ExecutionNode {
   /// @brief clone ExecutionNode recursively
   ExecutionNode* clone(ExecutionPlan* plan, bool withDependencies,
                        bool withProperties) const override final {
-    return cloneHelper(
-      std::make_unique<SortNode>(plan, _id, _elements, _stable),
-      withDependencies,
-      withProperties
-    );
+    auto c = std::make_unique<SortNode>(plan, _id, _elements, _stable);
+    c->setLimit(_limit);
+
+    return cloneHelper(std::move(c), withDependencies, withProperties);
   }
 
   /// @brief estimateCost
@@ -136,6 +142,10 @@ class SortNode : public ExecutionNode {
 
   /// whether or not the sort is stable
   bool _stable;
+
+  /// @brief maximum number of rows to produce (offset + count of a
+  /// following LIMIT), 0 = unlimited
+  size_t _limit;
 };
 
 }  // namespace arangodb::aql
@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "SpillFile.h"
+#include "Basics/Exceptions.h"
+#include "Basics/files.h"
+#include "Logger/Logger.h"
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+/// @brief buffered amount of data before writing to or reading from disk
+constexpr size_t bufferSize = 4 * 1024 * 1024;
+}
+
+SpillFile::SpillFile() 
+    : _fd(-1), _current(0), _pos(0), _rows(0), _reading(false) {
+  long systemError;
+  std::string errorMessage;
+  int res = TRI_GetTempName("aql", _filename, true, systemError, errorMessage);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(res, std::string("cannot create temporary file for query: ") + errorMessage);
+  }
+
+  _fd = TRI_OPEN(_filename.c_str(), O_RDWR | O_TRUNC | TRI_O_CLOEXEC);
+
+  if (_fd < 0) {
+    TRI_UnlinkFile(_filename.c_str());
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_WRITE_FILE, std::string("cannot open temporary file '") + _filename + "'");
+  }
+
+  _buffer.reserve(bufferSize);
+}
+
+SpillFile::~SpillFile() {
+  if (_fd >= 0) {
+    TRI_CLOSE(_fd);
+  }
+  if (!_filename.empty()) {
+    int res = TRI_UnlinkFile(_filename.c_str());
+    if (res != TRI_ERROR_NO_ERROR) {
+      LOG_TOPIC(WARN, Logger::QUERIES) << "unable to remove temporary query file '" << _filename << "'";
+    }
+  }
+}
+
+/// @brief append a row to the file. rows are stored prefixed with their
+/// length, so they can be read back without inspecting the VelocyPack
+void SpillFile::append(arangodb::velocypack::Slice row) {
+  TRI_ASSERT(!_reading);
+
+  uint32_t const length = static_cast<uint32_t>(row.byteSize());
+  _buffer.append(reinterpret_cast<char const*>(&length), sizeof(length));
+  _buffer.append(row.startAs<char>(), length);
+  ++_rows;
+
+  if (_buffer.size() >= bufferSize) {
+    flush();
+  }
+}
+
+void SpillFile::finish() {
+  TRI_ASSERT(!_reading);
+
+  flush();
+
+  if (TRI_LSEEK(_fd, 0, SEEK_SET) != 0) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_READ_FILE, std::string("cannot rewind temporary file '") + _filename + "'");
+  }
+
+  _reading = true;
+  _pos = 0;
+  _current = 0;
+}
+
+bool SpillFile::next() {
+  TRI_ASSERT(_reading);
+
+  if (!fill(sizeof(uint32_t))) {
+    return false;
+  }
+
+  uint32_t length;
+  memcpy(&length, _buffer.data() + _pos, sizeof(length));
+
+  if (!fill(sizeof(uint32_t) + length)) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_READ_FILE, std::string("unexpected end of temporary file '") + _filename + "'");
+  }
+
+  _current = _pos + sizeof(uint32_t);
+  _pos = _current + length;
+  return true;
+}
+
+void SpillFile::flush() {
+  if (_buffer.empty()) {
+    return;
+  }
+
+  if (!TRI_WritePointer(_fd, _buffer.data(), _buffer.size())) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_WRITE_FILE, std::string("cannot write to temporary file '") + _filename + "'");
+  }
+  _buffer.clear();
+}
+
+/// @brief make sure that at least the specified number of bytes is
+/// available at the read position. returns false on end of file
+bool SpillFile::fill(size_t required) {
+  if (_buffer.size() - _pos >= required) {
+    return true;
+  }
+
+  // move remaining data to the front of the buffer
+  _buffer.erase(0, _pos);
+  _current = 0;
+  _pos = 0;
+
+  while (_buffer.size() < required) {
+    size_t const offset = _buffer.size();
+    size_t const toRead = (std::max)(bufferSize, required - offset);
+    _buffer.resize(offset + toRead);
+
+    ssize_t n = TRI_READ(_fd, &_buffer[offset], static_cast<TRI_read_t>(toRead));
+
+    if (n < 0) {
+      _buffer.resize(offset);
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_READ_FILE, std::string("cannot read from temporary file '") + _filename + "'");
+    }
+
+    _buffer.resize(offset + static_cast<size_t>(n));
+
+    if (n == 0) {
+      // end of file
+      return false;
+    }
+  }
+
+  return true;
+}
@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_SPILL_FILE_H
+#define ARANGOD_AQL_SPILL_FILE_H 1
+
+#include "Basics/Common.h"
+
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+namespace aql {
+
+/// @brief a temporary file holding a sequence of VelocyPack rows, used
+/// by blocks that spill intermediate results to disk (e.g. sorted runs in
+/// SortBlock or group partitions in HashedCollectBlock). rows are appended
+/// first, and after finish() has been called they can be read back in
+/// order. the file is removed when the object is destroyed
+class SpillFile {
+ public:
+  SpillFile(SpillFile const&) = delete;
+  SpillFile& operator=(SpillFile const&) = delete;
+
+  /// @brief create a new, empty file in the temp directory. throws if the
+  /// file cannot be created
+  SpillFile();
+
+  ~SpillFile();
+
+  /// @brief append a row to the file. may only be called before finish()
+  void append(arangodb::velocypack::Slice row);
+
+  /// @brief flush all pending data and prepare the file for reading
+  void finish();
+
+  /// @brief advance to the next row. returns false if the file is exhausted
+  bool next();
+
+  /// @brief the current row. only valid after next() returned true
+  arangodb::velocypack::Slice current() const {
+    return arangodb::velocypack::Slice(
+        reinterpret_cast<uint8_t const*>(_buffer.data() + _current));
+  }
+
+  /// @brief number of rows written to the file
+  size_t size() const { return _rows; }
+
+  /// @brief name of the underlying file
+  std::string const& filename() const { return _filename; }
+
+ private:
+  void flush();
+  bool fill(size_t required);
+
+ private:
+  std::string _filename;
+  int _fd;
+  std::string _buffer;
+  size_t _current;
+  size_t _pos;
+  size_t _rows;
+  bool _reading;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
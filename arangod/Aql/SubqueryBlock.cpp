@@ -23,6 +23,7 @@
 
 #include "SubqueryBlock.h"
 #include "Aql/AqlItemBlock.h"
+#include "Aql/BasicBlocks.h"
 #include "Aql/ExecutionEngine.h"
 #include "Aql/Query.h"
 #include "Basics/Exceptions.h"
@@ -38,6 +39,9 @@ SubqueryBlock::SubqueryBlock(ExecutionEngine* engine, SubqueryNode const* en,
       _subquery(subquery),
       _subqueryIsConst(const_cast<SubqueryNode*>(en)->isConst()),
       _subqueryReturnsData(_subquery->getPlanNode()->getType() == ExecutionNode::RETURN),
+      _subqueryIsBatched(!_subqueryIsConst && _subqueryReturnsData && canRunBatched(en)),
+      _batchedSetup(false),
+      _returnReg(ExecutionNode::MaxRegisterId),
       _result(nullptr),
       _subqueryResults(nullptr),
       _subqueryPos(0),
@@ -162,6 +166,188 @@ ExecutionState SubqueryBlock::getSomeNonConstSubquery(size_t atMost) {
   return ExecutionState::DONE;
 }
 
+/// @brief whether or not the subquery can be run for all rows of an
+/// input block at once
+bool SubqueryBlock::canRunBatched(SubqueryNode const* en) {
+  ExecutionNode const* current = en->getSubquery();
+  TRI_ASSERT(current != nullptr);
+
+  if (current->getType() != ExecutionNode::RETURN) {
+    return false;
+  }
+  current = current->getFirstDependency();
+
+  while (current != nullptr) {
+    switch (current->getType()) {
+      case ExecutionNode::SINGLETON:
+        return true;
+      case ExecutionNode::CALCULATION:
+      case ExecutionNode::FILTER:
+      case ExecutionNode::ENUMERATE_COLLECTION:
+      case ExecutionNode::ENUMERATE_LIST:
+      case ExecutionNode::INDEX:
+      case ExecutionNode::HASH_JOIN:
+      case ExecutionNode::SUBQUERY:
+        // these nodes handle each input row on its own and keep the order
+        // of the input rows
+        break;
+      default:
+        // e.g. SORT, LIMIT and COLLECT work on all their input rows at once,
+        // and would mix up the results of different input rows
+        return false;
+    }
+    current = current->getFirstDependency();
+  }
+
+  return false;
+}
+
+ExecutionState SubqueryBlock::getSomeBatchedSubquery() {
+  if (_result->size() == 0) {
+    // NOTHING to loop
+    return ExecutionState::DONE;
+  }
+
+  if (!_batchedSetup) {
+    // the return block must hand out the full rows, so that we can see
+    // which input row each result belongs to
+    _returnReg = static_cast<ReturnBlock*>(_subquery)->returnInheritedResults();
+
+    ExecutionBlock* singleton = _subquery;
+    while (!singleton->getDependencies().empty()) {
+      singleton = singleton->getDependencies()[0];
+    }
+    TRI_ASSERT(singleton->getType() == Type::SINGLETON);
+    // input rows are tagged with their position in our output register,
+    // which the subquery does not use itself
+    static_cast<SingletonBlock*>(singleton)->enableBatchedInput(_outReg);
+    _batchedSetup = true;
+  }
+
+  if (!_subqueryInitialized) {
+    if (_result->getValueReference(0, _outReg).isEmpty()) {
+      for (size_t i = 0; i < _result->size(); ++i) {
+        _result->emplaceValue(i, _outReg, AqlValueHintUInt(static_cast<uint64_t>(i)));
+      }
+    }
+    auto state = initSubquery(0);
+    if (state == ExecutionState::WAITING) {
+      TRI_ASSERT(!_subqueryInitialized);
+      return state;
+    }
+    TRI_ASSERT(state == ExecutionState::DONE);
+  }
+  if (!_subqueryCompleted) {
+    auto state = executeSubquery();
+    if (state == ExecutionState::WAITING) {
+      // If this assert is violated we will not end up in executeSubQuery again.
+      TRI_ASSERT(!_subqueryCompleted);
+      // We need to wait
+      return state;
+    }
+    // Subquery does not allow to HASMORE!
+    TRI_ASSERT(state == ExecutionState::DONE);
+  }
+
+  TRI_ASSERT(_subqueryCompleted);
+  TRI_ASSERT(_subqueryResults != nullptr);
+
+  TRI_IF_FAILURE("SubqueryBlock::getSome") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+  distributeBatchedResults();
+  throwIfKilled();
+
+  // We are done for this _result. Fetch next _result from upstream
+  // to determine if we are DONE or HASMORE
+  return ExecutionState::DONE;
+}
+
+/// @brief hand the results of a batched subquery run over to the rows
+/// of _result they belong to
+void SubqueryBlock::distributeBatchedResults() {
+  size_t const n = _result->size();
+
+  // count the results per input row
+  std::vector<size_t> counts(n, 0);
+  for (auto const& block : *_subqueryResults) {
+    for (size_t j = 0; j < block->size(); ++j) {
+      size_t const row = static_cast<size_t>(block->getValueReference(j, _outReg).toInt64(_trx));
+      TRI_ASSERT(row < n);
+      ++counts[row];
+    }
+  }
+
+  std::vector<std::unique_ptr<std::vector<std::unique_ptr<AqlItemBlock>>>> results;
+  results.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    results.emplace_back(std::make_unique<std::vector<std::unique_ptr<AqlItemBlock>>>());
+    if (counts[i] > 0) {
+      results.back()->emplace_back(requestBlock(counts[i], 1));
+    }
+    counts[i] = 0;
+  }
+
+  // move the return values over. the subquery keeps the order of the input
+  // rows, so the results of each row stay in order.
+  // a value may show up in several rows. it can only be stolen once, and
+  // must be copied for the results of all other input rows
+  std::unordered_map<AqlValue, AqlItemBlock*> stolen;
+
+  for (auto const& block : *_subqueryResults) {
+    for (size_t j = 0; j < block->size(); ++j) {
+      size_t const row = static_cast<size_t>(block->getValueReference(j, _outReg).toInt64(_trx));
+      AqlValue a = block->getValueReference(j, _returnReg);
+
+      if (!a.isEmpty()) {
+        AqlItemBlock* target = (*results[row])[0].get();
+        if (a.requiresDestruction()) {
+          auto it = stolen.find(a);
+          if (it == stolen.end()) {
+            block->steal(a);
+            try {
+              target->setValue(counts[row], 0, a);
+            } catch (...) {
+              a.destroy();
+              throw;
+            }
+            stolen.emplace(a, target);
+          } else if ((*it).second == target) {
+            // the target block keeps track of values used multiple times
+            target->setValue(counts[row], 0, a);
+          } else {
+            AqlValue b = a.clone();
+            try {
+              target->setValue(counts[row], 0, b);
+            } catch (...) {
+              b.destroy();
+              throw;
+            }
+          }
+          block->eraseValue(j, _returnReg);
+        } else {
+          target->setValue(counts[row], 0, a);
+        }
+      }
+      ++counts[row];
+    }
+  }
+
+  for (auto& block : *_subqueryResults) {
+    AqlItemBlock* b = block.release();
+    returnBlock(b);
+  }
+  _subqueryResults.reset();
+
+  for (size_t i = 0; i < n; ++i) {
+    // replace the tag with the result of the row
+    _result->eraseValue(i, _outReg);
+    _result->emplaceValue(i, _outReg, results[i].get());
+    // Responsibility is handed over
+    results[i].release();
+  }
+}
+
 /// @brief getSome
 std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> SubqueryBlock::getSome(size_t atMost) {
   DEBUG_BEGIN_BLOCK();
@@ -187,6 +373,8 @@ std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> SubqueryBlock::getSome(
   ExecutionState state;
   if (_subqueryIsConst) {
     state = getSomeConstSubquery(atMost);
+  } else if (_subqueryIsBatched) {
+    state = getSomeBatchedSubquery();
   } else {
     state = getSomeNonConstSubquery(atMost);
   }
@@ -260,7 +448,7 @@ ExecutionState SubqueryBlock::executeSubquery() {
 
   TRI_ASSERT(_subqueryResults != nullptr);
   do {
-    auto res = _subquery->getSome(DefaultBatchSize());
+    auto res = _subquery->getSome(_subquery->batchSize());
     if (res.first == ExecutionState::WAITING) {
       TRI_ASSERT(res.second == nullptr);
       return res.first;
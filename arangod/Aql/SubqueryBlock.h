@@ -74,6 +74,20 @@ class SubqueryBlock final : public ExecutionBlock {
   /// is repeatable in case of WAITING
   ExecutionState getSomeNonConstSubquery(size_t atMost);
 
+  /// @brief run the subquery once for all rows of _result
+  /// is repeatable in case of WAITING
+  ExecutionState getSomeBatchedSubquery();
+
+  /// @brief hand the results of a batched subquery run over to the rows
+  /// of _result they belong to
+  void distributeBatchedResults();
+
+  /// @brief whether or not the subquery can be run for all rows of an
+  /// input block at once. this is the case if each node in the subquery
+  /// produces its rows for one input row independently of all other input
+  /// rows
+  static bool canRunBatched(SubqueryNode const* en);
+
  private:
 
   /// @brief output register
@@ -89,6 +103,15 @@ class SubqueryBlock final : public ExecutionBlock {
   /// @brief whether the subquery returns data
   bool const _subqueryReturnsData;
 
+  /// @brief whether the subquery is run for all rows of an input block at once
+  bool const _subqueryIsBatched;
+
+  /// @brief whether the subquery blocks have been set up for batched mode
+  bool _batchedSetup;
+
+  /// @brief register the subquery returns its data in, in batched mode
+  RegisterId _returnReg;
+
   /// @brief a unique_ptr to hold temporary results if thread gets suspended
   ///        guaranteed to be cleared out after a DONE/HASMORE of get/skip-some
   std::unique_ptr<AqlItemBlock> _result;
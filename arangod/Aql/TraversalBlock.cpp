@@ -373,7 +373,7 @@ TraversalBlock::getSome(size_t atMost) {
   RegisterId const nrInRegs = getNrInputRegisters();
 
   while (!_done && _skipped < atMost) {
-    size_t toFetch = (std::min)(DefaultBatchSize(), atMost);
+    size_t toFetch = (std::min)(upstreamBatchSize(), atMost);
     BufferState bufferState = getBlockIfNeeded(toFetch);
 
     if (bufferState == BufferState::WAITING) {
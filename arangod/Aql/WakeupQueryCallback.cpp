@@ -38,6 +38,14 @@ bool WakeupQueryCallback::operator()(ClusterCommResult* result) {
   // TODO Validate that _initiator and _query have not been deleted (ttl)
   // TODO Handle exceptions
   bool res = _initiator->handleAsyncResult(result);
+  if (!wakeupQuery()) {
+    return false;
+  }
+  return res;
+}
+
+bool WakeupQueryCallback::wakeupQuery() {
+  TRI_ASSERT(_query != nullptr);
   if (_query->hasHandler()) {
     auto scheduler = SchedulerFeature::SCHEDULER;
     TRI_ASSERT(scheduler != nullptr);
@@ -49,5 +57,5 @@ bool WakeupQueryCallback::operator()(ClusterCommResult* result) {
   } else {
     _query->continueAfterPause();
   }
-  return res;
+  return true;
 }
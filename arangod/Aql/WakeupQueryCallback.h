@@ -38,6 +38,11 @@ struct WakeupQueryCallback : public ClusterCommCallback {
 
   bool operator()(ClusterCommResult*) override;
 
+  protected:
+    /// @brief continue the execution of the query. returns false if the
+    /// server is shutting down
+    bool wakeupQuery();
+
   private:
     ExecutionBlock* _initiator;
     Query* _query;
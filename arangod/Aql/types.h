@@ -38,6 +38,15 @@ typedef unsigned int RegisterId;
 /// @brief type of a query id
 typedef uint64_t QueryId;
 
+/// @brief memory layout of the values in an AqlItemBlock
+enum class ItemBlockLayout : uint8_t {
+  /// @brief all registers of a row are stored adjacent to each other
+  ROW_MAJOR = 0,
+  /// @brief all rows of a register are stored adjacent to each other.
+  /// this favors blocks that process a single register for many rows
+  COLUMN_MAJOR = 1
+};
+
 //Map RemoteID->ServerID->[SnippetId]
 typedef std::unordered_map<size_t, std::unordered_map<std::string, std::vector<std::string>>> MapRemoteToSnippet;
 }
@@ -45,11 +45,14 @@ const uint64_t Cache::minSize = 16384;
 const uint64_t Cache::minLogSize = 14;
 
 uint64_t Cache::_findStatsCapacity = 16384;
+uint64_t Cache::_admissionSketchWidth = 8192;
+uint64_t Cache::_ghostCapacity = 4096;
 
 Cache::ConstructionGuard::ConstructionGuard() {}
 
 Cache::Cache(ConstructionGuard guard, Manager* manager, uint64_t id, Metadata&& metadata,
              std::shared_ptr<Table> table, bool enableWindowedStats,
+             bool enableAdmissionFilter,
              std::function<Table::BucketClearer(Metadata*)> bucketClearer,
              size_t slotsPerBucket)
     : _taskLock(),
@@ -58,6 +61,10 @@ Cache::Cache(ConstructionGuard guard, Manager* manager, uint64_t id, Metadata&&
       _findStats(nullptr),
       _findHits(),
       _findMisses(),
+      _admissionSketch(nullptr),
+      _ghosts(new std::vector<uint32_t>(_ghostCapacity, 0)),
+      _ghostHits(0),
+      _lockWaitTime(0),
       _manager(manager),
       _id(id),
       _metadata(std::move(metadata)),
@@ -69,6 +76,9 @@ Cache::Cache(ConstructionGuard guard, Manager* manager, uint64_t id, Metadata&&
       _insertEvictions(),
       _migrateRequestTime(std::chrono::steady_clock::now()),
       _resizeRequestTime(std::chrono::steady_clock::now()) {
+  for (auto& counter : _events) {
+    counter.store(0, std::memory_order_relaxed);
+  }
   _table->setTypeSpecifics(_bucketClearer, _slotsPerBucket);
   _table->enable();
   if (_enableWindowedStats) {
@@ -79,6 +89,14 @@ Cache::Cache(ConstructionGuard guard, Manager* manager, uint64_t id, Metadata&&
       _enableWindowedStats = false;
     }
   }
+  if (enableAdmissionFilter) {
+    try {
+      _admissionSketch.reset(new FrequencySketch(_admissionSketchWidth));
+    } catch (std::bad_alloc const&) {
+      // without the filter, every new entry is admitted as before
+      _admissionSketch.reset(nullptr);
+    }
+  }
 }
 
 uint64_t Cache::size() const {
@@ -275,6 +293,79 @@ uint32_t Cache::hashKey(void const* key, size_t keySize) const {
                     fasthash32(key, keySize, 0xdeadbeefUL));
 }
 
+void Cache::recordAccess(uint32_t hash) {
+  if (_admissionSketch) {
+    _admissionSketch->record(hash);
+  }
+}
+
+bool Cache::admit(uint32_t hash, CachedValue const* victim) const {
+  TRI_ASSERT(victim != nullptr);
+  if (!_admissionSketch) {
+    return true;
+  }
+  return _admissionSketch->admit(hash,
+                                 hashKey(victim->key(), victim->keySize()));
+}
+
+void Cache::recordEviction(CachedValue const* value) {
+  TRI_ASSERT(value != nullptr);
+  // like the stat buffers, this is lossy under concurrent access
+  uint32_t hash = hashKey(value->key(), value->keySize());
+  (*_ghosts)[hash & (_ghostCapacity - 1)] = hash;
+}
+
+void Cache::recordMiss(uint32_t hash) {
+  uint32_t& ghost = (*_ghosts)[hash & (_ghostCapacity - 1)];
+  if (ghost == hash) {
+    // hashes are never 0, so this clears the slot
+    ghost = 0;
+    _ghostHits.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+Cache::Statistics Cache::statistics() const {
+  auto event = [this](Event e) -> uint64_t {
+    return _events[static_cast<size_t>(e)].load(std::memory_order_relaxed);
+  };
+
+  Statistics stats;
+  // only every 8th find is recorded, see recordStat
+  stats.hits = 8 * static_cast<uint64_t>(
+                       _findHits.value(std::memory_order_relaxed));
+  stats.misses = 8 * static_cast<uint64_t>(
+                         _findMisses.value(std::memory_order_relaxed));
+  stats.lookups = stats.hits + stats.misses;
+  stats.insertsRejectedBusy = event(Event::insertRejectedBusy);
+  stats.insertsRejectedAdmission = event(Event::insertRejectedAdmission);
+  stats.insertsRejectedBlacklist = event(Event::insertRejectedBlacklist);
+  stats.insertsRejectedLimit = event(Event::insertRejectedLimit);
+  stats.evictionsInsert = event(Event::evictionInsert);
+  stats.evictionsFreeMemory = event(Event::evictionFreeMemory);
+  stats.evictionsMigration = event(Event::evictionMigration);
+  stats.migrations = event(Event::migration);
+  stats.resizes = event(Event::resize);
+  stats.lockWaits = event(Event::lockWait);
+  stats.lockWaitTime = _lockWaitTime.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void Cache::recordEvent(Event event) {
+  _events[static_cast<size_t>(event)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void Cache::recordLockWait(std::chrono::steady_clock::time_point start) {
+  auto waited = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  recordEvent(Event::lockWait);
+  _lockWaitTime.fetch_add(static_cast<uint64_t>(waited.count()),
+                          std::memory_order_relaxed);
+}
+
+uint64_t Cache::collectGhostHits() {
+  return _ghostHits.exchange(0, std::memory_order_relaxed);
+}
+
 void Cache::recordStat(Stat stat) {
   if ((basics::SharedPRNG::rand() & static_cast<unsigned long>(7)) != 0) {
     return;
@@ -461,6 +552,7 @@ bool Cache::migrate(std::shared_ptr<Table> newTable) {
   _metadata.changeTable(_table->memoryUsage());
   _metadata.toggleMigrating();
   _metadata.writeUnlock();
+  recordEvent(Event::migration);
 
   return true;
 }
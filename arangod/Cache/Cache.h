@@ -32,14 +32,20 @@
 #include "Cache/Common.h"
 #include "Cache/Finding.h"
 #include "Cache/FrequencyBuffer.h"
+#include "Cache/FrequencySketch.h"
 #include "Cache/Manager.h"
 #include "Cache/ManagerTasks.h"
 #include "Cache/Metadata.h"
 #include "Cache/Table.h"
 
 #include <stdint.h>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <list>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace arangodb {
 namespace cache {
@@ -71,9 +77,43 @@ class Cache : public std::enable_shared_from_this<Cache> {
   static const uint64_t minSize;
   static const uint64_t minLogSize;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Counters describing the work done by a cache since its creation.
+  ///
+  /// Lookups, hits and misses are extrapolated from the sampled find
+  /// statistics, all other counters are exact.
+  //////////////////////////////////////////////////////////////////////////////
+  struct Statistics {
+    uint64_t lookups;
+    uint64_t hits;
+    uint64_t misses;
+    // inserts rejected because the bucket was locked, or full without a
+    // freeable entry
+    uint64_t insertsRejectedBusy;
+    // inserts rejected by the admission filter
+    uint64_t insertsRejectedAdmission;
+    // inserts rejected because the key was blacklisted
+    uint64_t insertsRejectedBlacklist;
+    // inserts rejected because the cache was at its memory limit
+    uint64_t insertsRejectedLimit;
+    // entries replaced by inserts into full buckets
+    uint64_t evictionsInsert;
+    // entries freed to shrink the memory usage
+    uint64_t evictionsFreeMemory;
+    // entries dropped while migrating to a new table
+    uint64_t evictionsMigration;
+    uint64_t migrations;
+    uint64_t resizes;
+    // bucket lock acquisitions which did not succeed immediately, and the
+    // total time spent on them in microseconds
+    uint64_t lockWaits;
+    uint64_t lockWaitTime;
+  };
+
  public:
   Cache(ConstructionGuard guard, Manager* manager, uint64_t id, Metadata&& metadata,
         std::shared_ptr<Table> table, bool enableWindowedStats,
+        bool enableAdmissionFilter,
         std::function<Table::BucketClearer(Metadata*)> bucketClearer,
         size_t slotsPerBucket);
   virtual ~Cache() = default;
@@ -84,6 +124,15 @@ class Cache : public std::enable_shared_from_this<Cache> {
   virtual Result remove(void const* key, uint32_t keySize) = 0;
   virtual Result blacklist(void const* key, uint32_t keySize) = 0;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Returns the keys of up to limit recently used entries.
+  ///
+  /// The entries of each bucket are ordered by recency, so this takes the most
+  /// recently used ones from buckets spread over the whole table. Buckets which
+  /// are busy are skipped.
+  //////////////////////////////////////////////////////////////////////////////
+  virtual std::vector<std::string> hottestKeys(size_t limit) = 0;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Returns the ID for this cache.
   //////////////////////////////////////////////////////////////////////////////
@@ -124,6 +173,11 @@ class Cache : public std::enable_shared_from_this<Cache> {
   //////////////////////////////////////////////////////////////////////////////
   std::pair<double, double> hitRates();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Returns the counters of this cache.
+  //////////////////////////////////////////////////////////////////////////////
+  Statistics statistics() const;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Check whether the cache is currently in the process of resizing.
   //////////////////////////////////////////////////////////////////////////////
@@ -146,11 +200,35 @@ class Cache : public std::enable_shared_from_this<Cache> {
     return _shutdown;
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Returns the number of ghost hits since the last call, that is the
+  /// number of misses for keys which had been evicted shortly before.
+  ///
+  /// These are the hits the cache would have gained with a bit more memory,
+  /// so the manager uses them when rebalancing memory between caches.
+  //////////////////////////////////////////////////////////////////////////////
+  uint64_t collectGhostHits();
+
  protected:
   static constexpr uint64_t triesFast = 200;
   static constexpr uint64_t triesSlow = 10000;
   static constexpr uint64_t triesGuarantee = UINT64_MAX;
 
+  // events counted for statistics()
+  enum class Event : size_t {
+    insertRejectedBusy = 0,
+    insertRejectedAdmission,
+    insertRejectedBlacklist,
+    insertRejectedLimit,
+    evictionInsert,
+    evictionFreeMemory,
+    evictionMigration,
+    migration,
+    resize,
+    lockWait,
+    numEvents
+  };
+
  protected:
   basics::ReadWriteSpinLock _taskLock;
 
@@ -162,6 +240,19 @@ class Cache : public std::enable_shared_from_this<Cache> {
   mutable basics::SharedCounter<64> _findHits;
   mutable basics::SharedCounter<64> _findMisses;
 
+  // frequency-based admission of new entries into full buckets
+  static uint64_t _admissionSketchWidth;
+  std::unique_ptr<FrequencySketch> _admissionSketch;
+
+  // hashes of recently evicted keys, overwritten by later evictions
+  static uint64_t _ghostCapacity;
+  std::unique_ptr<std::vector<uint32_t>> _ghosts;
+  std::atomic<uint64_t> _ghostHits;
+
+  std::array<std::atomic<uint64_t>, static_cast<size_t>(Event::numEvents)>
+      _events;
+  std::atomic<uint64_t> _lockWaitTime;
+
   // allow communication with manager
   Manager* _manager;
   uint64_t _id;
@@ -204,6 +295,12 @@ class Cache : public std::enable_shared_from_this<Cache> {
 
   uint32_t hashKey(void const* key, size_t keySize) const;
   void recordStat(Stat stat);
+  void recordAccess(uint32_t hash);
+  bool admit(uint32_t hash, CachedValue const* victim) const;
+  void recordEviction(CachedValue const* value);
+  void recordMiss(uint32_t hash);
+  void recordEvent(Event event);
+  void recordLockWait(std::chrono::steady_clock::time_point start);
 
   bool reportInsert(bool hadEviction);
 
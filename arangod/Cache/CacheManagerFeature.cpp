@@ -57,7 +57,11 @@ CacheManagerFeature::CacheManagerFeature(
       _cacheSize((TRI_PhysicalMemory >= (static_cast<uint64_t>(4) << 30))
                   ? static_cast<uint64_t>((TRI_PhysicalMemory - (static_cast<uint64_t>(2) << 30)) * 0.3)
                   : (256 << 20)),
-      _rebalancingInterval(static_cast<uint64_t>(2 * 1000 * 1000)) {
+      _rebalancingInterval(static_cast<uint64_t>(2 * 1000 * 1000)),
+      _admissionFilter(false),
+      _persistHotKeys(false),
+      _hotKeysPerCache(10000),
+      _hotKeysReloadRate(10000) {
   setOptional(true);
   startsAfter("Scheduler");
 }
@@ -74,6 +78,26 @@ void CacheManagerFeature::collectOptions(
   options->addOption("--cache.rebalancing-interval",
                      "microseconds between rebalancing attempts",
                      new UInt64Parameter(&_rebalancingInterval));
+
+  options->addOption("--cache.admission-filter",
+                     "only replace cached entries with new ones that were "
+                     "accessed more often recently",
+                     new BooleanParameter(&_admissionFilter));
+
+  options->addOption("--cache.persist-hot-keys",
+                     "write the keys of the most recently used cache entries "
+                     "on shutdown, and load them into the caches again in "
+                     "the background after the next start",
+                     new BooleanParameter(&_persistHotKeys));
+
+  options->addOption("--cache.hot-keys-per-cache",
+                     "maximum number of keys written per cache",
+                     new UInt64Parameter(&_hotKeysPerCache));
+
+  options->addOption("--cache.hot-keys-reload-rate",
+                     "maximum number of keys per second loaded into the "
+                     "caches after a start (0 = unlimited)",
+                     new UInt64Parameter(&_hotKeysReloadRate));
 }
 
 void CacheManagerFeature::validateOptions(
@@ -99,7 +123,7 @@ void CacheManagerFeature::start() {
     scheduler->post(fn);
     return true;
   };
-  _manager.reset(new Manager(postFn, _cacheSize));
+  _manager.reset(new Manager(postFn, _cacheSize, true, _admissionFilter));
   MANAGER = _manager.get();
   _rebalancer.reset(
       new CacheRebalancerThread(_manager.get(), _rebalancingInterval));
@@ -48,6 +48,17 @@ class CacheManagerFeature final
   void stop() override final;
   void unprepare() override final;
 
+  /// @brief whether or not the keys of the hottest cache entries are written
+  /// on shutdown and loaded again after the next start
+  bool persistHotKeys() const { return _persistHotKeys; }
+
+  /// @brief maximum number of keys written per cache
+  uint64_t hotKeysPerCache() const { return _hotKeysPerCache; }
+
+  /// @brief maximum number of keys per second looked up after a start
+  /// (0 = unlimited)
+  uint64_t hotKeysReloadRate() const { return _hotKeysReloadRate; }
+
  private:
   static const uint64_t minRebalancingInterval;
 
@@ -55,6 +66,10 @@ class CacheManagerFeature final
   std::unique_ptr<CacheRebalancerThread> _rebalancer;
   uint64_t _cacheSize;
   uint64_t _rebalancingInterval;
+  bool _admissionFilter;
+  bool _persistHotKeys;
+  uint64_t _hotKeysPerCache;
+  uint64_t _hotKeysReloadRate;
 };
 }
 
@@ -22,22 +22,24 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "Cache/CachedValue.h"
+#include "Basics/ThreadCachingAllocator.h"
 
 #include <stdint.h>
 #include <cstring>
 
 using namespace arangodb::cache;
+using arangodb::basics::ThreadCachingAllocator;
 
 const size_t CachedValue::_headerAllocSize = sizeof(CachedValue) +
                                        CachedValue::_padding;
 
 CachedValue* CachedValue::copy() const {
-  uint8_t* buf = new uint8_t[size()];
+  uint8_t* buf = static_cast<uint8_t*>(ThreadCachingAllocator::allocate(size()));
   CachedValue* value = nullptr;
   try {
     value = new (buf + offset()) CachedValue(*this);
   } catch (...) {
-    delete[] buf;
+    ThreadCachingAllocator::deallocate(buf, size());
     return nullptr;
   }
 
@@ -51,7 +53,8 @@ CachedValue* CachedValue::construct(void const* k, size_t kSize,
     return nullptr;
   }
 
-  uint8_t* buf = new uint8_t[_headerAllocSize + kSize + vSize];
+  size_t const size = _headerAllocSize + kSize + vSize;
+  uint8_t* buf = static_cast<uint8_t*>(ThreadCachingAllocator::allocate(size));
   CachedValue* cv = nullptr;
   try {
     uint8_t* aligned = reinterpret_cast<uint8_t*>(
@@ -60,7 +63,7 @@ CachedValue* CachedValue::construct(void const* k, size_t kSize,
     size_t offset = buf - aligned;
     cv = new (aligned) CachedValue(offset, k, kSize, v, vSize);
   } catch (...) {
-    delete[] buf;
+    ThreadCachingAllocator::deallocate(buf, size);
     return nullptr;
   }
 
@@ -70,8 +73,10 @@ CachedValue* CachedValue::construct(void const* k, size_t kSize,
 void CachedValue::operator delete(void* ptr) {
   CachedValue* cv = reinterpret_cast<CachedValue*>(ptr);
   size_t offset = cv->offset();
+  size_t size = cv->size();
   cv->~CachedValue();
-  delete[] (reinterpret_cast<uint8_t*>(ptr) - offset);
+  ThreadCachingAllocator::deallocate(reinterpret_cast<uint8_t*>(ptr) - offset,
+                                     size);
 }
 
 CachedValue::CachedValue(size_t off, void const* k, size_t kSize,
@@ -35,9 +35,9 @@ namespace cache {
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief This is the beginning of a cache data entry.
 ///
-/// It will be allocated using new uint8_t[] with the correct size for header,
-/// key and value. The key and value reside directly behind the header entries
-/// contained in this struct. The reference count is used to lend CachedValues
+/// It will be allocated using the ThreadCachingAllocator with the correct size
+/// for header, key and value. The key and value reside directly behind the
+/// header entries contained in this struct. The reference count is used to lend CachedValues
 /// to clients.
 ////////////////////////////////////////////////////////////////////////////////
 struct CachedValue {
@@ -28,6 +28,12 @@
 
 #include <stdint.h>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 namespace arangodb {
 namespace cache {
 
@@ -46,6 +52,44 @@ enum CacheType { Plain, Transactional };
 ////////////////////////////////////////////////////////////////////////////////
 enum class Stat : uint8_t { findHit = 1, findMiss = 2 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Returns a bitmask of the slots holding the given hash, with bit i
+/// set for slot i.
+///
+/// Compares four hashes at once where SSE2 or NEON is available, so that a
+/// lookup only branches on and dereferences the slots with a matching hash.
+////////////////////////////////////////////////////////////////////////////////
+template <size_t slots>
+inline uint32_t matchingSlots(uint32_t const* hashes, uint32_t hash) {
+  static_assert(slots <= 32, "Expected at most 32 slots per bucket.");
+  uint32_t result = 0;
+  size_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+  __m128i const needle = _mm_set1_epi32(static_cast<int>(hash));
+  for (; i + 4 <= slots; i += 4) {
+    __m128i const block =
+        _mm_loadu_si128(reinterpret_cast<__m128i const*>(hashes + i));
+    int const bits =
+        _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(block, needle)));
+    result |= static_cast<uint32_t>(bits) << i;
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  uint32x4_t const needle = vdupq_n_u32(hash);
+  uint32_t const weights[4] = {1, 2, 4, 8};
+  uint32x4_t const lanes = vld1q_u32(weights);
+  for (; i + 4 <= slots; i += 4) {
+    uint32x4_t const equal = vceqq_u32(vld1q_u32(hashes + i), needle);
+    result |= vaddvq_u32(vandq_u32(equal, lanes)) << i;
+  }
+#endif
+  for (; i < slots; i++) {
+    if (hashes[i] == hash) {
+      result |= static_cast<uint32_t>(1) << i;
+    }
+  }
+  return result;
+}
+
 };  // end namespace cache
 };  // end namespace arangodb
 
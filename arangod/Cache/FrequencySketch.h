@@ -0,0 +1,164 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2018 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_CACHE_FREQUENCY_SKETCH_H
+#define ARANGODB_CACHE_FREQUENCY_SKETCH_H
+
+#include "Basics/Common.h"
+
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace arangodb {
+namespace cache {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Lockless count-min sketch to estimate recent access frequencies.
+///
+/// Used as an admission filter in front of a cache: a new entry only replaces
+/// the eviction candidate of a full bucket if it was accessed more often
+/// recently. Each hash increments one small saturating counter in each of a few
+/// rows, and its estimate is the minimum of these counters. After a number of
+/// records proportional to the width, all counters are halved, so the sketch
+/// only reflects a recent window of accesses. Like FrequencyBuffer, concurrent
+/// updates may occasionally be lost, which only makes the estimates a bit less
+/// precise.
+////////////////////////////////////////////////////////////////////////////////
+class FrequencySketch {
+ public:
+  static constexpr size_t depth = 4;
+  static constexpr uint8_t maxCount = 15;
+  static constexpr uint64_t sampleFactor = 10;
+
+ private:
+  size_t _width;
+  size_t _mask;
+  uint64_t _sampleSize;
+  std::unique_ptr<std::vector<uint8_t>> _counters;
+  std::atomic<uint64_t> _additions;
+
+ public:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Initialize with the given number of counters per row.
+  //////////////////////////////////////////////////////////////////////////////
+  explicit FrequencySketch(size_t width)
+      : _width(0), _mask(0), _sampleSize(0), _counters(nullptr), _additions(0) {
+    size_t i = 0;
+    for (; (static_cast<size_t>(1) << i) < width; i++) {
+    }
+    _width = (static_cast<size_t>(1) << i);
+    _mask = _width - 1;
+    _sampleSize = sampleFactor * _width;
+    _counters.reset(new std::vector<uint8_t>(depth * _width, 0));
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Reports the hidden allocation size (not captured by sizeof).
+  //////////////////////////////////////////////////////////////////////////////
+  static size_t allocationSize(size_t width) {
+    return sizeof(std::vector<uint8_t>) + (depth * width * sizeof(uint8_t));
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Reports the memory usage in bytes.
+  //////////////////////////////////////////////////////////////////////////////
+  size_t memoryUsage() const {
+    return ((depth * _width * sizeof(uint8_t)) + sizeof(FrequencySketch) +
+            sizeof(std::vector<uint8_t>));
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Record an access for the given hash.
+  ///
+  /// Only the counters holding the current minimum are incremented, which
+  /// keeps collisions from inflating the estimates more than necessary.
+  //////////////////////////////////////////////////////////////////////////////
+  void record(uint32_t hash) {
+    std::vector<uint8_t>& counters = *_counters;
+    uint8_t current = estimate(hash);
+    if (current < maxCount) {
+      for (size_t row = 0; row < depth; row++) {
+        size_t i = index(hash, row);
+        if (counters[i] == current) {
+          counters[i] = current + 1;
+        }
+      }
+    }
+
+    if (_additions.fetch_add(1, std::memory_order_relaxed) + 1 == _sampleSize) {
+      age();
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Estimate the number of recent accesses for the given hash.
+  //////////////////////////////////////////////////////////////////////////////
+  uint8_t estimate(uint32_t hash) const {
+    std::vector<uint8_t> const& counters = *_counters;
+    uint8_t result = maxCount;
+    for (size_t row = 0; row < depth; row++) {
+      result = (std::min)(result, counters[index(hash, row)]);
+    }
+    return result;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Whether an entry with the candidate hash should replace the one
+  /// with the victim hash. Ties favor the resident entry.
+  //////////////////////////////////////////////////////////////////////////////
+  bool admit(uint32_t candidate, uint32_t victim) const {
+    return estimate(candidate) > estimate(victim);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Reset all counters.
+  //////////////////////////////////////////////////////////////////////////////
+  void clear() {
+    std::fill(_counters->begin(), _counters->end(), static_cast<uint8_t>(0));
+    _additions.store(0, std::memory_order_relaxed);
+  }
+
+ private:
+  size_t index(uint32_t hash, size_t row) const {
+    // derive an independent position per row from the single cache hash
+    static constexpr uint32_t seeds[depth] = {0x97cb3127UL, 0xc3a5c85cUL,
+                                              0x13198a2eUL, 0x9e3779b9UL};
+    uint32_t h = (hash ^ seeds[row]) * 0x85ebca6bUL;
+    h ^= h >> 16;
+    return (row * _width) + (h & _mask);
+  }
+
+  void age() {
+    // halve all counters, so that old accesses gradually lose their weight
+    for (auto& counter : *_counters) {
+      counter >>= 1;
+    }
+    _additions.fetch_sub(_sampleSize / 2, std::memory_order_relaxed);
+  }
+};
+
+};  // end namespace cache
+};  // end namespace arangodb
+
+#endif
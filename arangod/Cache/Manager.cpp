@@ -43,6 +43,7 @@
 #include <memory>
 #include <set>
 #include <stack>
+#include <unordered_map>
 #include <utility>
 
 using namespace arangodb::cache;
@@ -50,13 +51,13 @@ using namespace arangodb::cache;
 const uint64_t Manager::minSize = 1024 * 1024;
 const uint64_t Manager::minCacheAllocation =
     Cache::minSize + Table::allocationSize(Table::minLogSize) +
-    std::max(PlainCache::allocationSize(true),
-             TransactionalCache::allocationSize(true)) +
+    std::max(PlainCache::allocationSize(true, true),
+             TransactionalCache::allocationSize(true, true)) +
     Manager::cacheRecordOverhead;
 const std::chrono::milliseconds Manager::rebalancingGracePeriod(10);
 
 Manager::Manager(PostFn schedulerPost, uint64_t globalLimit,
-                 bool enableWindowedStats)
+                 bool enableWindowedStats, bool enableAdmissionFilter)
     : _lock(),
       _shutdown(false),
       _shuttingDown(false),
@@ -69,6 +70,7 @@ Manager::Manager(PostFn schedulerPost, uint64_t globalLimit,
       _findStats(nullptr),
       _findHits(),
       _findMisses(),
+      _enableAdmissionFilter(enableAdmissionFilter),
       _caches(),
       _nextCacheId(1),
       _globalSoftLimit(globalLimit),
@@ -124,10 +126,12 @@ std::shared_ptr<Cache> Manager::createCache(CacheType type,
     uint64_t fixedSize = 0;
     switch (type) {
       case CacheType::Plain:
-        fixedSize = PlainCache::allocationSize(enableWindowedStats);
+        fixedSize = PlainCache::allocationSize(enableWindowedStats,
+                                               _enableAdmissionFilter);
         break;
       case CacheType::Transactional:
-        fixedSize = TransactionalCache::allocationSize(enableWindowedStats);
+        fixedSize = TransactionalCache::allocationSize(enableWindowedStats,
+                                                       _enableAdmissionFilter);
         break;
       default:
         break;
@@ -139,11 +143,12 @@ std::shared_ptr<Cache> Manager::createCache(CacheType type,
     switch (type) {
       case CacheType::Plain:
         result = PlainCache::create(this, id, std::move(metadata), table,
-                                    enableWindowedStats);
+                                    enableWindowedStats, _enableAdmissionFilter);
         break;
       case CacheType::Transactional:
         result = TransactionalCache::create(this, id, std::move(metadata), table,
-                                            enableWindowedStats);
+                                            enableWindowedStats,
+                                            _enableAdmissionFilter);
         break;
       default:
         break;
@@ -633,6 +638,7 @@ void Manager::resizeCache(Manager::TaskEnvironment environment,
   TRI_ASSERT(_lock.isWriteLocked());
   Metadata* metadata = cache->metadata();
   TRI_ASSERT(metadata->isWriteLocked());
+  cache->recordEvent(Cache::Event::resize);
 
   if (metadata->usage <= newLimit) {
     uint64_t oldLimit = metadata->hardUsageLimit;
@@ -786,6 +792,20 @@ std::shared_ptr<Manager::PriorityList> Manager::priorityList() {
   }
   totalAccesses = std::max(static_cast<uint64_t>(1), totalAccesses);
 
+  // count the ghost hits of each cache since the last calculation. these
+  // estimate how many more hits a cache would get with more memory, so a
+  // share of the weight follows them
+  std::unordered_map<uint64_t, uint64_t> ghostHits;
+  uint64_t totalGhostHits = 0;
+  for (auto it = _caches.begin(); it != _caches.end(); it++) {
+    uint64_t hits = it->second->collectGhostHits();
+    if (hits > 0) {
+      ghostHits.emplace(it->first, hits);
+      totalGhostHits += hits;
+    }
+  }
+  double ghostFrac = (totalGhostHits > 0) ? Manager::ghostHitShare : 0.0;
+
   double allocFrac = 0.8 * std::min(1.0, static_cast<double>(_globalAllocation) / static_cast<double>(_globalHighwaterMark));
   // calculate global data usage
   for (auto it = _caches.begin(); it != _caches.end(); it++) {
@@ -793,19 +813,29 @@ std::shared_ptr<Manager::PriorityList> Manager::priorityList() {
   }
   globalUsage = std::max(globalUsage, static_cast<uint64_t>(1)); // avoid div-by-zero
 
+  double accessNormalizer = ((1.0 - allocFrac) * (1.0 - ghostFrac) * remainingWeight) / static_cast<double>(totalAccesses);
+  double usageNormalizer =  (allocFrac * remainingWeight) / static_cast<double>(globalUsage);
+  double ghostNormalizer = ((1.0 - allocFrac) * ghostFrac * remainingWeight) /
+                           static_cast<double>(std::max(static_cast<uint64_t>(1), totalGhostHits));
+  auto ghostWeight = [&ghostHits, ghostNormalizer](uint64_t id) -> double {
+    auto found = ghostHits.find(id);
+    if (found == ghostHits.end()) {
+      return 0.0;
+    }
+    return static_cast<double>(found->second) * ghostNormalizer;
+  };
+
   // gather all unaccessed caches at beginning of list
   for (auto it = _caches.begin(); it != _caches.end(); it++) {
     std::shared_ptr<Cache>& cache = it->second;
     auto found = accessed.find(cache->id());
     if (found == accessed.end()) {
-      double weight = baseWeight + (cache->usage() / globalUsage) * allocFrac;
+      double weight = baseWeight + (cache->usage() / globalUsage) * allocFrac +
+                      ghostWeight(cache->id());
       list->emplace_back(cache, weight);
     }
   }
 
-  double accessNormalizer = ((1.0 - allocFrac) * remainingWeight) / static_cast<double>(totalAccesses);
-  double usageNormalizer =  (allocFrac * remainingWeight) / static_cast<double>(globalUsage);
-
   // gather all accessed caches in order
   for (auto s : stats) {
     auto it = accessed.find(s.first);
@@ -814,9 +844,13 @@ std::shared_ptr<Manager::PriorityList> Manager::priorityList() {
       double accessWeight = static_cast<double>(s.second) * accessNormalizer;
       double usageWeight = static_cast<double>(cache->usage()) * usageNormalizer;
 
+      double ghostHitWeight = ghostWeight(s.first);
+
       TRI_ASSERT(accessWeight >= 0.0);
       TRI_ASSERT(usageWeight >= 0.0);
-      list->emplace_back(cache, (baseWeight + accessWeight + usageWeight));
+      TRI_ASSERT(ghostHitWeight >= 0.0);
+      list->emplace_back(cache, (baseWeight + accessWeight + usageWeight +
+                                 ghostHitWeight));
     }
   }
 
@@ -85,9 +85,13 @@ class Manager {
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Initialize the manager with a scheduler post method and global
   /// usage limit.
+  ///
+  /// If enableAdmissionFilter is true, all caches created by the manager keep
+  /// a frequency sketch of recent accesses, and a new entry only replaces the
+  /// eviction candidate of a full bucket if it was accessed more often.
   //////////////////////////////////////////////////////////////////////////////
   Manager(PostFn schedulerPost, uint64_t globalLimit,
-          bool enableWindowedStats = true);
+          bool enableWindowedStats = true, bool enableAdmissionFilter = false);
   ~Manager();
 
   //////////////////////////////////////////////////////////////////////////////
@@ -191,6 +195,9 @@ class Manager {
   basics::SharedCounter<64> _findHits;
   basics::SharedCounter<64> _findMisses;
 
+  // admission filter setting for new caches
+  bool _enableAdmissionFilter;
+
   // registry to keep track of registered caches
   std::map<uint64_t, std::shared_ptr<Cache>> _caches;
   uint64_t _nextCacheId;
@@ -244,6 +251,8 @@ class Manager {
 
  private:  // used internally and by tasks
   static constexpr double highwaterMultiplier = 0.8;
+  // share of the access-based weight which follows ghost hits instead
+  static constexpr double ghostHitShare = 0.5;
   static const uint64_t minCacheAllocation;
   static const std::chrono::milliseconds rebalancingGracePeriod;
 
@@ -68,11 +68,10 @@ CachedValue* PlainBucket::find(uint32_t hash, void const* key, size_t keySize,
   TRI_ASSERT(isLocked());
   CachedValue* result = nullptr;
 
-  for (size_t i = 0; i < slotsData; i++) {
-    if (_cachedHashes[i] == 0) {
-      break;
-    }
-    if (_cachedHashes[i] == hash && _cachedData[i]->sameKey(key, keySize)) {
+  // empty slots have hash 0, which never matches
+  uint32_t matches = matchingSlots<slotsData>(_cachedHashes, hash);
+  for (size_t i = 0; matches != 0; i++, matches >>= 1) {
+    if ((matches & 1) != 0 && _cachedData[i]->sameKey(key, keySize)) {
       result = _cachedData[i];
       if (moveToFront) {
         moveSlot(i, true);
@@ -44,6 +44,7 @@ Finding PlainCache::find(void const* key, uint32_t keySize) {
   TRI_ASSERT(key != nullptr);
   Finding result;
   uint32_t hash = hashKey(key, keySize);
+  recordAccess(hash);
 
   Result status;
   PlainBucket* bucket;
@@ -59,6 +60,7 @@ Finding PlainCache::find(void const* key, uint32_t keySize) {
     recordStat(Stat::findHit);
   } else {
     recordStat(Stat::findMiss);
+    recordMiss(hash);
     status.reset(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND);
     result.reportError(status);
   }
@@ -76,6 +78,9 @@ Result PlainCache::insert(CachedValue* value) {
   Table* source;
   std::tie(status, bucket, source) = getBucket(hash, Cache::triesFast);
   if (status.fail()) {
+    if (status.errorNumber() == TRI_ERROR_LOCK_TIMEOUT) {
+      recordEvent(Event::insertRejectedBusy);
+    }
     return status;
   }
 
@@ -86,9 +91,16 @@ Result PlainCache::insert(CachedValue* value) {
 
   if (candidate == nullptr && bucket->isFull()) {
     candidate = bucket->evictionCandidate();
+    // nothing to evict, or the new entry is not accessed more often than
+    // the one it would replace
     if (candidate == nullptr) {
       allowed = false;
       status.reset(TRI_ERROR_ARANGO_BUSY);
+      recordEvent(Event::insertRejectedBusy);
+    } else if (!admit(hash, candidate)) {
+      allowed = false;
+      status.reset(TRI_ERROR_ARANGO_BUSY);
+      recordEvent(Event::insertRejectedAdmission);
     }
   }
 
@@ -107,6 +119,8 @@ Result PlainCache::insert(CachedValue* value) {
         bucket->evict(candidate, true);
         if (!candidate->sameKey(value->key(), value->keySize())) {
           eviction = true;
+          recordEviction(candidate);
+          recordEvent(Event::evictionInsert);
         }
         freeValue(candidate);
       }
@@ -118,6 +132,7 @@ Result PlainCache::insert(CachedValue* value) {
     } else {
       requestGrow();  // let function do the hard work
       status.reset(TRI_ERROR_RESOURCE_LIMIT);
+      recordEvent(Event::insertRejectedLimit);
     }
   }
 
@@ -168,24 +183,79 @@ Result PlainCache::blacklist(void const* key, uint32_t keySize) {
   return {TRI_ERROR_NOT_IMPLEMENTED};
 }
 
-uint64_t PlainCache::allocationSize(bool enableWindowedStats) {
+std::vector<std::string> PlainCache::hottestKeys(size_t limit) {
+  std::vector<std::string> keys;
+  Table* table = _table;
+  if (isShutdown() || table == nullptr || limit == 0) {
+    return keys;
+  }
+
+  uint64_t const buckets = table->size();
+  uint32_t const shift = 32 - table->logSize();
+  // visit evenly spaced buckets if there are more buckets than keys wanted,
+  // otherwise take the same number of entries from every bucket
+  uint64_t const step = (std::max)(static_cast<uint64_t>(1), buckets / limit);
+  size_t const perBucket = static_cast<size_t>((std::min)(
+      static_cast<uint64_t>(PlainBucket::slotsData), (limit + buckets - 1) / buckets));
+  keys.reserve(limit);
+
+  for (uint64_t i = 0; i < buckets && keys.size() < limit; i += step) {
+    Result status;
+    PlainBucket* bucket;
+    Table* source;
+    std::tie(status, bucket, source) =
+        getBucket(static_cast<uint32_t>(i << shift), Cache::triesFast, false);
+    if (status.fail()) {
+      if (status.errorNumber() == TRI_ERROR_SHUTTING_DOWN) {
+        break;
+      }
+      continue;
+    }
+
+    size_t taken = 0;
+    for (size_t j = 0; j < PlainBucket::slotsData && taken < perBucket &&
+                       keys.size() < limit;
+         j++) {
+      CachedValue const* value = bucket->_cachedData[j];
+      if (value != nullptr) {
+        keys.emplace_back(reinterpret_cast<char const*>(value->key()),
+                          value->keySize());
+        ++taken;
+      }
+    }
+    bucket->unlock();
+  }
+
+  return keys;
+}
+
+uint64_t PlainCache::allocationSize(bool enableWindowedStats,
+                                    bool enableAdmissionFilter) {
   return sizeof(PlainCache) +
          (enableWindowedStats ? (sizeof(StatBuffer) +
                                  StatBuffer::allocationSize(_findStatsCapacity))
-                              : 0);
+                              : 0) +
+         sizeof(std::vector<uint32_t>) + (_ghostCapacity * sizeof(uint32_t)) +
+         (enableAdmissionFilter
+              ? (sizeof(FrequencySketch) +
+                 FrequencySketch::allocationSize(_admissionSketchWidth))
+              : 0);
 }
 
 std::shared_ptr<Cache> PlainCache::create(Manager* manager, uint64_t id, Metadata&& metadata,
                                           std::shared_ptr<Table> table,
-                                          bool enableWindowedStats) {
+                                          bool enableWindowedStats,
+                                          bool enableAdmissionFilter) {
   return std::make_shared<PlainCache>(Cache::ConstructionGuard(), manager, id,
-                                      std::move(metadata), table, enableWindowedStats);
+                                      std::move(metadata), table, enableWindowedStats,
+                                      enableAdmissionFilter);
 }
 
 PlainCache::PlainCache(Cache::ConstructionGuard guard, Manager* manager, uint64_t id,
                        Metadata&& metadata, std::shared_ptr<Table> table,
-                       bool enableWindowedStats)
+                       bool enableWindowedStats, bool enableAdmissionFilter)
     : Cache(guard, manager, id, std::move(metadata), table, enableWindowedStats,
+            enableAdmissionFilter,
             PlainCache::bucketClearer, PlainBucket::slotsData) {}
 
 PlainCache::~PlainCache() {
@@ -215,6 +285,8 @@ uint64_t PlainCache::freeMemoryFrom(uint32_t hash) {
   if (candidate != nullptr) {
     reclaimed = candidate->size();
     bucket->evict(candidate);
+    recordEviction(candidate);
+    recordEvent(Event::evictionFreeMemory);
     freeValue(candidate);
     maybeMigrate = source->slotEmptied();
   }
@@ -258,6 +330,7 @@ void PlainCache::migrateBucket(void* sourcePtr,
           uint64_t size = candidate->size();
           freeValue(candidate);
           reclaimMemory(size);
+          recordEvent(Event::evictionMigration);
           newTable->slotEmptied();
         } else {
           haveSpace = false;
@@ -270,6 +343,7 @@ void PlainCache::migrateBucket(void* sourcePtr,
         uint64_t size = value->size();
         freeValue(value);
         reclaimMemory(size);
+        recordEvent(Event::evictionMigration);
       }
 
       source->_cachedHashes[k] = 0;
@@ -306,7 +380,13 @@ std::tuple<Result, PlainBucket*, Table*> PlainCache::getBucket(
   }
 
 
-  auto pair = table->fetchAndLockBucket(hash, maxTries);
+  // only measure the time if the lock is not available right away
+  auto pair = table->fetchAndLockBucket(hash, 1);
+  if (pair.first == nullptr && maxTries > 1) {
+    auto start = std::chrono::steady_clock::now();
+    pair = table->fetchAndLockBucket(hash, maxTries - 1);
+    recordLockWait(start);
+  }
   bucket = reinterpret_cast<PlainBucket*>(pair.first);
   source = pair.second;
   bool ok = (bucket != nullptr);
@@ -55,7 +55,7 @@ class PlainCache final : public Cache {
  public:
   PlainCache(Cache::ConstructionGuard guard, Manager* manager, uint64_t id,
              Metadata&& metadata, std::shared_ptr<Table> table,
-             bool enableWindowedStats);
+             bool enableWindowedStats, bool enableAdmissionFilter);
   ~PlainCache();
 
   PlainCache() = delete;
@@ -97,6 +97,8 @@ class PlainCache final : public Cache {
   //////////////////////////////////////////////////////////////////////////////
   Result blacklist(void const* key, uint32_t keySize) override;
 
+  std::vector<std::string> hottestKeys(size_t limit) override;
+
  private:
   // friend class manager and tasks
   friend class FreeMemoryTask;
@@ -104,10 +106,12 @@ class PlainCache final : public Cache {
   friend class MigrateTask;
 
  private:
-  static uint64_t allocationSize(bool enableWindowedStats);
+  static uint64_t allocationSize(bool enableWindowedStats,
+                                 bool enableAdmissionFilter);
   static std::shared_ptr<Cache> create(Manager* manager, uint64_t id, Metadata&& metadata,
                                        std::shared_ptr<Table> table,
-                                       bool enableWindowedStats);
+                                       bool enableWindowedStats,
+                                       bool enableAdmissionFilter);
 
   virtual uint64_t freeMemoryFrom(uint32_t hash) override;
   virtual void migrateBucket(void* sourcePtr,
@@ -23,14 +23,67 @@
 
 #include "Cache/Table.h"
 #include "Basics/Common.h"
+#include "Basics/FileUtils.h"
 #include "Cache/Common.h"
 
 #include <stdint.h>
 #include <memory>
 #include <stdexcept>
 
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 using namespace arangodb::cache;
 
+namespace {
+
+#ifdef __linux__
+/// @brief number of NUMA nodes of the machine, determined once
+size_t numaNodes() {
+  static size_t const nodes = []() -> size_t {
+    size_t n = 0;
+    while (n < 64 && arangodb::basics::FileUtils::isDirectory(
+                         "/sys/devices/system/node/node" + std::to_string(n))) {
+      ++n;
+    }
+    return n;
+  }();
+  return nodes;
+}
+#endif
+
+/// @brief spread the pages of a new table evenly over all NUMA nodes.
+/// otherwise all of them end up on the node of the thread which initializes
+/// the buckets, and every lookup from the other sockets is a remote access.
+/// a bucket is found by its hash, so lookups cannot prefer local memory
+/// anyway. this only affects pages which were not touched yet, and is a
+/// no-op on machines with a single node
+void interleaveMemory(void* ptr, size_t size) {
+#ifdef __linux__
+  size_t nodes = numaNodes();
+  if (nodes <= 1) {
+    return;
+  }
+  uintptr_t const pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  uintptr_t start = (reinterpret_cast<uintptr_t>(ptr) + pageSize - 1) &
+                    ~(pageSize - 1);
+  uintptr_t end = (reinterpret_cast<uintptr_t>(ptr) + size) & ~(pageSize - 1);
+  if (end <= start) {
+    return;
+  }
+  unsigned long mask =
+      (nodes >= 64) ? ~0UL : ((static_cast<unsigned long>(1) << nodes) - 1);
+  // MPOL_INTERLEAVE, without pulling in libnuma
+  int const mode = 3;
+  // failures are harmless, the memory is then placed as before
+  syscall(SYS_mbind, start, end - start, mode, &mask, sizeof(mask) * 8, 0);
+#endif
+}
+
+}  // namespace
+
 const uint32_t Table::minLogSize = 8;
 const uint32_t Table::maxLogSize = 32;
 
@@ -100,6 +153,7 @@ Table::Table(uint32_t logSize)
       _bucketClearer(defaultClearer),
       _slotsTotal(_size),
       _slotsUsed(static_cast<uint64_t>(0)) {
+  interleaveMemory(_buffer.get(), (_size * BUCKET_SIZE) + Table::padding);
   for (size_t i = 0; i < _size; i++) {
     // use placement new in order to properly initialize the bucket
     new (_buckets + i) GenericBucket();
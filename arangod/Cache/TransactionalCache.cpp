@@ -45,6 +45,7 @@ Finding TransactionalCache::find(void const* key, uint32_t keySize) {
   TRI_ASSERT(key != nullptr);
   Finding result;
   uint32_t hash = hashKey(key, keySize);
+  recordAccess(hash);
 
   Result status;
   TransactionalBucket* bucket;
@@ -60,6 +61,7 @@ Finding TransactionalCache::find(void const* key, uint32_t keySize) {
     recordStat(Stat::findHit);
   } else {
     recordStat(Stat::findMiss);
+    recordMiss(hash);
     status.reset(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND);
     result.reportError(status);
   }
@@ -78,6 +80,9 @@ Result TransactionalCache::insert(CachedValue* value) {
   Table* source;
   std::tie(status, bucket, source) = getBucket(hash, Cache::triesFast);
   if (status.fail()) {
+    if (status.errorNumber() == TRI_ERROR_LOCK_TIMEOUT) {
+      recordEvent(Event::insertRejectedBusy);
+    }
     return status;
   }
 
@@ -89,9 +94,16 @@ Result TransactionalCache::insert(CachedValue* value) {
 
     if (candidate == nullptr && bucket->isFull()) {
       candidate = bucket->evictionCandidate();
+      // nothing to evict, or the new entry is not accessed more often than
+      // the one it would replace
       if (candidate == nullptr) {
         allowed = false;
         status.reset(TRI_ERROR_ARANGO_BUSY);
+        recordEvent(Event::insertRejectedBusy);
+      } else if (!admit(hash, candidate)) {
+        allowed = false;
+        status.reset(TRI_ERROR_ARANGO_BUSY);
+        recordEvent(Event::insertRejectedAdmission);
       }
     }
 
@@ -110,6 +122,8 @@ Result TransactionalCache::insert(CachedValue* value) {
           bucket->evict(candidate, true);
           if (!candidate->sameKey(value->key(), value->keySize())) {
             eviction = true;
+            recordEviction(candidate);
+            recordEvent(Event::evictionInsert);
           }
           freeValue(candidate);
         }
@@ -121,10 +135,12 @@ Result TransactionalCache::insert(CachedValue* value) {
       } else {
         requestGrow();  // let function do the hard work
         status.reset(TRI_ERROR_RESOURCE_LIMIT);
+        recordEvent(Event::insertRejectedLimit);
       }
     }
   } else {
     status.reset(TRI_ERROR_ARANGO_CONFLICT);
+    recordEvent(Event::insertRejectedBlacklist);
   }
 
   bucket->unlock();
@@ -204,28 +220,84 @@ Result TransactionalCache::blacklist(void const* key, uint32_t keySize) {
   return status;
 }
 
-uint64_t TransactionalCache::allocationSize(bool enableWindowedStats) {
+std::vector<std::string> TransactionalCache::hottestKeys(size_t limit) {
+  std::vector<std::string> keys;
+  Table* table = _table;
+  if (isShutdown() || table == nullptr || limit == 0) {
+    return keys;
+  }
+
+  uint64_t const buckets = table->size();
+  uint32_t const shift = 32 - table->logSize();
+  // visit evenly spaced buckets if there are more buckets than keys wanted,
+  // otherwise take the same number of entries from every bucket
+  uint64_t const step = (std::max)(static_cast<uint64_t>(1), buckets / limit);
+  size_t const perBucket = static_cast<size_t>((std::min)(
+      static_cast<uint64_t>(TransactionalBucket::slotsData), (limit + buckets - 1) / buckets));
+  keys.reserve(limit);
+
+  for (uint64_t i = 0; i < buckets && keys.size() < limit; i += step) {
+    Result status;
+    TransactionalBucket* bucket;
+    Table* source;
+    std::tie(status, bucket, source) =
+        getBucket(static_cast<uint32_t>(i << shift), Cache::triesFast, false);
+    if (status.fail()) {
+      if (status.errorNumber() == TRI_ERROR_SHUTTING_DOWN) {
+        break;
+      }
+      continue;
+    }
+
+    size_t taken = 0;
+    for (size_t j = 0; j < TransactionalBucket::slotsData && taken < perBucket &&
+                       keys.size() < limit;
+         j++) {
+      CachedValue const* value = bucket->_cachedData[j];
+      if (value != nullptr) {
+        keys.emplace_back(reinterpret_cast<char const*>(value->key()),
+                          value->keySize());
+        ++taken;
+      }
+    }
+    bucket->unlock();
+  }
+
+  return keys;
+}
+
+uint64_t TransactionalCache::allocationSize(bool enableWindowedStats,
+                                            bool enableAdmissionFilter) {
   return sizeof(TransactionalCache) +
          (enableWindowedStats ? (sizeof(StatBuffer) +
                                  StatBuffer::allocationSize(_findStatsCapacity))
-                              : 0);
+                              : 0) +
+         sizeof(std::vector<uint32_t>) + (_ghostCapacity * sizeof(uint32_t)) +
+         (enableAdmissionFilter
+              ? (sizeof(FrequencySketch) +
+                 FrequencySketch::allocationSize(_admissionSketchWidth))
+              : 0);
 }
 
 std::shared_ptr<Cache> TransactionalCache::create(Manager* manager,
                                                   uint64_t id,
                                                   Metadata&& metadata,
                                                   std::shared_ptr<Table> table,
-                                                  bool enableWindowedStats) {
+                                                  bool enableWindowedStats,
+                                                  bool enableAdmissionFilter) {
   return std::make_shared<TransactionalCache>(Cache::ConstructionGuard(),
                                               manager, id, std::move(metadata), table,
-                                              enableWindowedStats);
+                                              enableWindowedStats,
+                                              enableAdmissionFilter);
 }
 
 TransactionalCache::TransactionalCache(Cache::ConstructionGuard guard,
                                        Manager* manager, uint64_t id, Metadata&& metadata,
                                        std::shared_ptr<Table> table,
-                                       bool enableWindowedStats)
+                                       bool enableWindowedStats,
+                                       bool enableAdmissionFilter)
     : Cache(guard, manager, id, std::move(metadata), table, enableWindowedStats,
+            enableAdmissionFilter,
             TransactionalCache::bucketClearer, TransactionalBucket::slotsData) {
 }
 
@@ -256,6 +328,8 @@ uint64_t TransactionalCache::freeMemoryFrom(uint32_t hash) {
   if (candidate != nullptr) {
     reclaimed = candidate->size();
     bucket->evict(candidate);
+    recordEviction(candidate);
+    recordEvent(Event::evictionFreeMemory);
     freeValue(candidate);
     maybeMigrate = source->slotEmptied();
   }
@@ -315,6 +389,7 @@ void TransactionalCache::migrateBucket(void* sourcePtr,
           uint64_t size = candidate->size();
           freeValue(candidate);
           reclaimMemory(size);
+          recordEvent(Event::evictionMigration);
           newTable->slotEmptied();
         }
         source->_blacklistHashes[j] = 0;
@@ -335,6 +410,7 @@ void TransactionalCache::migrateBucket(void* sourcePtr,
         uint64_t size = value->size();
         freeValue(value);
         reclaimMemory(size);
+        recordEvent(Event::evictionMigration);
       } else {
         bool haveSpace = true;
         if (targetBucket->isFull()) {
@@ -344,6 +420,7 @@ void TransactionalCache::migrateBucket(void* sourcePtr,
             uint64_t size = candidate->size();
             freeValue(candidate);
             reclaimMemory(size);
+            recordEvent(Event::evictionMigration);
             newTable->slotEmptied();
           } else {
             haveSpace = false;
@@ -356,6 +433,7 @@ void TransactionalCache::migrateBucket(void* sourcePtr,
           uint64_t size = value->size();
           freeValue(value);
           reclaimMemory(size);
+          recordEvent(Event::evictionMigration);
         }
       }
 
@@ -394,7 +472,13 @@ TransactionalCache::getBucket(uint32_t hash, uint64_t maxTries,
   }
 
   uint64_t term = _manager->_transactions.term();
-  auto pair = table->fetchAndLockBucket(hash, maxTries);
+  // only measure the time if the lock is not available right away
+  auto pair = table->fetchAndLockBucket(hash, 1);
+  if (pair.first == nullptr && maxTries > 1) {
+    auto start = std::chrono::steady_clock::now();
+    pair = table->fetchAndLockBucket(hash, maxTries - 1);
+    recordLockWait(start);
+  }
   bucket = reinterpret_cast<TransactionalBucket*>(pair.first);
   source = pair.second;
   bool ok = (bucket != nullptr);
@@ -0,0 +1,249 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "AgencyCache.h"
+
+#include "Basics/ConditionLocker.h"
+#include "Basics/MutexLocker.h"
+#include "Basics/StringUtils.h"
+#include "Logger/Logger.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+AgencyCache::AgencyCache(double pollTimeout)
+    : CriticalThread("AgencyCache"),
+      _pollTimeout(pollTimeout),
+      _readDB(std::make_shared<consensus::Store>(nullptr, "cache")),
+      _index(0) {}
+
+AgencyCache::~AgencyCache() { shutdown(); }
+
+void AgencyCache::beginShutdown() {
+  CONDITION_LOCKER(guard, _cv);
+  Thread::beginShutdown();
+  guard.signal();
+}
+
+consensus::index_t AgencyCache::index() const {
+  MUTEX_LOCKER(locker, _lock);
+  return _index;
+}
+
+bool AgencyCache::inSync() const {
+  MUTEX_LOCKER(locker, _lock);
+  // an answer comes at least every poll timeout
+  return _index > 0 &&
+         std::chrono::steady_clock::now() - _lastAnswer <
+             std::chrono::duration<double>(_pollTimeout + 2.0);
+}
+
+AgencyCommResult AgencyCache::read(std::vector<std::string> const& paths) const {
+  std::shared_ptr<consensus::Store> readDB;
+  if (inSync()) {
+    MUTEX_LOCKER(locker, _lock);
+    readDB = _readDB;
+  }
+  if (readDB == nullptr) {
+    return AgencyCommResult(503, "agency cache is not in sync");
+  }
+
+  VPackBuilder query;
+  {
+    VPackArrayBuilder guard(&query);
+    for (auto const& path : paths) {
+      query.add(VPackValue(path));
+    }
+  }
+
+  auto result = std::make_shared<VPackBuilder>();
+  {
+    VPackArrayBuilder guard(result.get());
+    readDB->read(query.slice(), *result);
+  }
+
+  AgencyCommResult ret(200, "OK");
+  ret._connected = true;
+  ret._sent = true;
+  ret.setVPack(result);
+  return ret;
+}
+
+void AgencyCache::registerCallback(uint32_t id, std::string const& key,
+                                   Callback cb) {
+  MUTEX_LOCKER(locker, _lock);
+  _callbacks[id] = std::make_pair(normalize(key), std::move(cb));
+}
+
+void AgencyCache::unregisterCallback(uint32_t id) {
+  MUTEX_LOCKER(locker, _lock);
+  _callbacks.erase(id);
+}
+
+std::vector<AgencyCache::Callback> AgencyCache::apply(VPackSlice answer) {
+  std::vector<Callback> toCall;
+
+  if (!answer.isObject() || !answer.get("commitIndex").isNumber()) {
+    LOG_TOPIC(WARN, Logger::CLUSTER)
+        << "invalid answer to agency poll: " << answer.toJson();
+    return toCall;
+  }
+  consensus::index_t index =
+      answer.get("commitIndex").getNumber<consensus::index_t>();
+
+  VPackSlice readDB = answer.get("readDB");
+  if (readDB.isObject()) {
+    // the log was compacted, or this is the first poll. there are no time
+    // to live or observer tables to take over
+    VPackBuilder dump;
+    {
+      VPackArrayBuilder guard(&dump);
+      dump.add(readDB);
+      { VPackObjectBuilder ttl(&dump); }
+      { VPackArrayBuilder observers(&dump); }
+      { VPackArrayBuilder observed(&dump); }
+    }
+    auto store = std::make_shared<consensus::Store>(nullptr, "cache");
+    *store = dump.slice();
+
+    MUTEX_LOCKER(locker, _lock);
+    _readDB = store;
+    _index = index;
+    _lastAnswer = std::chrono::steady_clock::now();
+    for (auto const& it : _callbacks) {
+      toCall.push_back(it.second.second);
+    }
+    return toCall;
+  }
+
+  VPackSlice log = answer.get("log");
+  if (!log.isArray()) {
+    LOG_TOPIC(WARN, Logger::CLUSTER)
+        << "invalid answer to agency poll: " << answer.toJson();
+    return toCall;
+  }
+
+  VPackBuilder queries;
+  std::vector<std::string> touched;
+  {
+    VPackArrayBuilder guard(&queries);
+    for (auto const& entry : VPackArrayIterator(log)) {
+      VPackSlice query = entry.get("query");
+      if (!query.isObject()) {
+        continue;
+      }
+      queries.add(query);
+      for (auto const& operation : VPackObjectIterator(query)) {
+        touched.push_back(normalize(operation.key.copyString()));
+      }
+    }
+  }
+
+  MUTEX_LOCKER(locker, _lock);
+  if (queries.slice().length() > 0) {
+    // only this thread changes the store, readers only need its own lock
+    _readDB->applyLogEntries(queries, index, 0, false);
+  }
+  _index = index;
+  _lastAnswer = std::chrono::steady_clock::now();
+  for (auto const& it : _callbacks) {
+    for (auto const& path : touched) {
+      if (affects(path, it.second.first)) {
+        toCall.push_back(it.second.second);
+        break;
+      }
+    }
+  }
+  return toCall;
+}
+
+void AgencyCache::run() {
+  AgencyComm comm;
+
+  while (!isStopping()) {
+    std::string const url = "/_api/agency/poll?index=" +
+                            std::to_string(index()) + "&timeout=" +
+                            std::to_string(_pollTimeout);
+
+    AgencyCommResult result = comm.sendWithFailover(
+        rest::RequestType::GET, _pollTimeout + 10.0, url,
+        VPackSlice::noneSlice(), _pollTimeout + 5.0);
+
+    if (isStopping()) {
+      break;
+    }
+
+    std::vector<Callback> toCall;
+    if (result.successful()) {
+      try {
+        auto answer = VPackParser::fromJson(result.bodyRef());
+        toCall = apply(answer->slice());
+      } catch (std::exception const& ex) {
+        LOG_TOPIC(WARN, Logger::CLUSTER)
+            << "invalid answer to agency poll: " << ex.what();
+      }
+    } else {
+      LOG_TOPIC(DEBUG, Logger::CLUSTER)
+          << "agency poll failed: " << result.errorMessage();
+      CONDITION_LOCKER(guard, _cv);
+      if (!isStopping()) {
+        guard.wait(1000000);
+      }
+      continue;
+    }
+
+    // outside of the lock, a callback reads from the cache
+    for (auto const& cb : toCall) {
+      try {
+        cb();
+      } catch (std::exception const& ex) {
+        LOG_TOPIC(WARN, Logger::CLUSTER)
+            << "agency cache callback failed: " << ex.what();
+      }
+    }
+  }
+}
+
+std::string AgencyCache::normalize(std::string const& key) {
+  std::string result = "/";
+  for (auto const& part : basics::StringUtils::split(key, '/')) {
+    if (!part.empty()) {
+      if (result.size() > 1) {
+        result.push_back('/');
+      }
+      result.append(part);
+    }
+  }
+  return result;
+}
+
+bool AgencyCache::affects(std::string const& path, std::string const& key) {
+  if (path == "/" || key == "/" || path == key) {
+    return true;
+  }
+  // a change below the key, or above it
+  std::string const& shorter = path.size() < key.size() ? path : key;
+  std::string const& longer = path.size() < key.size() ? key : path;
+  return longer.compare(0, shorter.size(), shorter) == 0 &&
+         longer[shorter.size()] == '/';
+}
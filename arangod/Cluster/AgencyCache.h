@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_CLUSTER_AGENCY_CACHE_H
+#define ARANGOD_CLUSTER_AGENCY_CACHE_H 1
+
+#include "Agency/AgencyComm.h"
+#include "Agency/Store.h"
+#include "Basics/ConditionVariable.h"
+#include "Basics/Mutex.h"
+#include "Cluster/CriticalThread.h"
+
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+
+/// @brief local copy of the agency's readDB on coordinators and DB servers.
+/// one thread keeps it up to date with long polls for the log entries that
+/// the agency has committed, in the order of their raft indexes. reads from
+/// the cache need no round trip to the agency, and callbacks on keys are
+/// called in process when a log entry touches their key
+class AgencyCache final : public CriticalThread {
+ public:
+  typedef std::function<void()> Callback;
+
+  AgencyCache(AgencyCache const&) = delete;
+  AgencyCache& operator=(AgencyCache const&) = delete;
+
+  /// @brief pollTimeout is the time in seconds the agency waits for new
+  /// log entries before it answers a poll
+  explicit AgencyCache(double pollTimeout);
+
+  ~AgencyCache();
+
+  void beginShutdown() override;
+
+  /// @brief raft index up to which the cache has applied the log
+  consensus::index_t index() const;
+
+  /// @brief whether the cache got an answer from the agency recently,
+  /// otherwise it may be arbitrarily behind
+  bool inSync() const;
+
+  /// @brief reads the paths, which include the agency prefix, like one read
+  /// transaction of AgencyComm would. fails with 503 while the cache is not
+  /// in sync with the agency
+  AgencyCommResult read(std::vector<std::string> const& paths) const;
+
+  /// @brief calls cb, whenever a committed log entry touches key, one of its
+  /// parents or children, and after the cache was replaced by a complete
+  /// readDB. key includes the agency prefix
+  void registerCallback(uint32_t id, std::string const& key, Callback cb);
+
+  void unregisterCallback(uint32_t id);
+
+  /// @brief applies the answer of the agency to a poll, returns the
+  /// callbacks to call. public for the tests
+  std::vector<Callback> apply(velocypack::Slice answer);
+
+ protected:
+  void run() override;
+
+ private:
+  static std::string normalize(std::string const& key);
+
+  /// @brief whether a change of path affects a callback on key
+  static bool affects(std::string const& path, std::string const& key);
+
+ private:
+  double const _pollTimeout;
+
+  /// @brief guards _readDB, _index, _lastAnswer and _callbacks. the store
+  /// has its own lock for reads and log entries, a complete readDB from the
+  /// agency replaces it
+  mutable Mutex _lock;
+  std::shared_ptr<consensus::Store> _readDB;
+  consensus::index_t _index;
+  std::chrono::steady_clock::time_point _lastAnswer;
+  std::unordered_map<uint32_t, std::pair<std::string, Callback>> _callbacks;
+
+  /// @brief to wait between failed polls
+  basics::ConditionVariable _cv;
+};
+
+}  // namespace arangodb
+
+#endif
@@ -32,6 +32,7 @@
 
 #include "Basics/ConditionLocker.h"
 #include "Basics/MutexLocker.h"
+#include "Cluster/AgencyCache.h"
 #include "Logger/Logger.h"
 
 using namespace arangodb;
@@ -39,7 +40,8 @@ using namespace arangodb;
 AgencyCallback::AgencyCallback(AgencyComm& agency, std::string const& key,
                                std::function<bool(VPackSlice const&)> const& cb,
                                bool needsValue, bool needsInitialValue)
-    : key(key), _agency(agency), _cb(cb), _needsValue(needsValue) {
+    : key(key), _agency(agency), _cache(nullptr), _cb(cb),
+      _needsValue(needsValue) {
   if (_needsValue && needsInitialValue) {
     refetchAndUpdate(true, false);
   }
@@ -57,7 +59,10 @@ void AgencyCallback::refetchAndUpdate(bool needToAcquireMutex, bool forceCheck)
     return;
   }
 
-  AgencyCommResult result = _agency.getValues(key);
+  AgencyCommResult result =
+      (_cache != nullptr && _cache->inSync())
+          ? _cache->read(std::vector<std::string>({AgencyCommManager::path(key)}))
+          : _agency.getValues(key);
 
   if (!result.successful()) {
     LOG_TOPIC(ERR, arangodb::Logger::FIXME) << "Callback getValues to agency was not successful: "
@@ -36,6 +36,7 @@
 #include "Basics/Mutex.h"
 
 namespace arangodb {
+class AgencyCache;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// class AgencyCallback
@@ -116,6 +117,13 @@ public:
   //////////////////////////////////////////////////////////////////////////////
 
   void executeByCallbackOrTimeout(double);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief refetch the value from the agency cache, as long as it is in
+  /// sync with the agency, set by the registry before registration
+  //////////////////////////////////////////////////////////////////////////////
+
+  void setCache(AgencyCache* cache) { _cache = cache; }
   
   //////////////////////////////////////////////////////////////////////////////
   /// @brief private members
@@ -123,6 +131,7 @@ public:
 
 private:
   AgencyComm& _agency;
+  AgencyCache* _cache;
   std::function<bool(VPackSlice const&)> const _cb;
   std::shared_ptr<VPackBuilder> _lastData;
   bool const _needsValue;
@@ -31,6 +31,7 @@
 #include "Basics/Exceptions.h"
 #include "Basics/ReadLocker.h"
 #include "Basics/WriteLocker.h"
+#include "Cluster/AgencyCache.h"
 #include "Cluster/ServerState.h"
 #include "Endpoint/Endpoint.h"
 #include "Logger/Logger.h"
@@ -40,7 +41,8 @@ using namespace arangodb;
 
 AgencyCallbackRegistry::AgencyCallbackRegistry(std::string const& callbackBasePath)
   : _agency(),
-  _callbackBasePath(callbackBasePath) {
+  _callbackBasePath(callbackBasePath),
+  _cache(nullptr) {
 }
 
 AgencyCallbackRegistry::~AgencyCallbackRegistry() {
@@ -58,6 +60,20 @@ bool AgencyCallbackRegistry::registerCallback(std::shared_ptr<AgencyCallback> cb
     }
   }
 
+  if (_cache != nullptr) {
+    // called in process, whenever the cache applies a change of the key
+    std::weak_ptr<AgencyCallback> weak(cb);
+    cb->setCache(_cache);
+    _cache->registerCallback(
+        rand, AgencyCommManager::path(cb->key), [weak]() {
+          auto callback = weak.lock();
+          if (callback != nullptr) {
+            callback->refetchAndUpdate(true, false);
+          }
+        });
+    return true;
+  }
+
   bool ok = false;
   try {
     ok = _agency.registerCallback(cb->key, getEndpointUrl(rand)).successful();
@@ -92,7 +108,11 @@ bool AgencyCallbackRegistry::unregisterCallback(std::shared_ptr<AgencyCallback>
 
   for (auto const& it: _endpoints) {
     if (it.second.get() == cb.get()) {
-      _agency.unregisterCallback(cb->key, getEndpointUrl(it.first));
+      if (_cache != nullptr) {
+        _cache->unregisterCallback(it.first);
+      } else {
+        _agency.unregisterCallback(cb->key, getEndpointUrl(it.first));
+      }
       _endpoints.erase(it.first);
       return true;
     }
@@ -28,6 +28,7 @@
 #include "Basics/ReadWriteLock.h"
 
 namespace arangodb {
+class AgencyCache;
 
 class AgencyCallbackRegistry {
 public:
@@ -56,6 +57,14 @@ public:
   //////////////////////////////////////////////////////////////////////////////
   std::shared_ptr<AgencyCallback> getCallback(uint32_t);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief let the agency cache call the callbacks registered from now on,
+  /// instead of the agency's observers. set once before any registration
+  //////////////////////////////////////////////////////////////////////////////
+  void setCache(AgencyCache* cache) { _cache = cache; }
+
+  AgencyCache* cache() const { return _cache; }
+
 private:
   std::string getEndpointUrl(uint32_t);
 
@@ -65,6 +74,8 @@ private:
 
   std::string const _callbackBasePath;
 
+  AgencyCache* _cache;
+
   std::unordered_map<uint32_t, std::shared_ptr<AgencyCallback>> _endpoints;
 };
 
@@ -25,9 +25,12 @@
 
 #include "Agency/AgencyFeature.h"
 #include "Agency/Agent.h"
+#include "Aql/QueryCounters.h"
 #include "Basics/ConditionLocker.h"
 #include "Basics/HybridLogicalClock.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/StringUtils.h"
+#include "Cluster/ClusterFeature.h"
 #include "Cluster/ClusterInfo.h"
 #include "Cluster/ServerState.h"
 #include "GeneralServer/AuthenticationFeature.h"
@@ -36,6 +39,7 @@
 #include "Scheduler/SchedulerFeature.h"
 #include "SimpleHttpClient/ConnectionManager.h"
 #include "SimpleHttpClient/SimpleHttpCommunicatorResult.h"
+#include "Statistics/RequestTracer.h"
 #include "Transaction/Methods.h"
 #include "VocBase/ticks.h"
 
@@ -230,7 +234,8 @@ ClusterComm::ClusterComm()
     : _backgroundThread(nullptr),
       _logConnectionErrors(false),
       _authenticationEnabled(false),
-      _jwtAuthorization("") {
+      _jwtAuthorization(""),
+      _coalesceReads(false) {
   AuthenticationFeature* af = AuthenticationFeature::instance();
   TRI_ASSERT(af != nullptr);
   if (af->isActive()) {
@@ -241,6 +246,14 @@ ClusterComm::ClusterComm()
   }
 
   _communicator = std::make_shared<communicator::Communicator>();
+
+  auto cluster =
+      application_features::ApplicationServer::getFeature<ClusterFeature>(
+          "Cluster");
+  _communicator->setMultiplexing(cluster->requestMultiplexing());
+  _communicator->setMaxConnectionsPerHost(
+      static_cast<size_t>(cluster->maxConnectionsPerHost()));
+  _coalesceReads = cluster->coalesceReads();
 }
 
 /// @brief Unit test constructor
@@ -248,7 +261,8 @@ ClusterComm::ClusterComm(bool ignored)
     : _backgroundThread(nullptr),
       _logConnectionErrors(false),
       _authenticationEnabled(false),
-      _jwtAuthorization("") {
+      _jwtAuthorization(""),
+      _coalesceReads(false) {
 
   //_communicator = std::make_shared<communicator::Communicator>();
 
@@ -480,6 +494,28 @@ OperationID ClusterComm::asyncRequest(
 
   TRI_ASSERT(request != nullptr);
   CONDITION_LOCKER(locker, somethingReceived);
+
+  // a GET which is identical to one in flight does not go over the network,
+  // it is answered with a copy of the response of the other one. we still
+  // hold the lock on somethingReceived here, so the answer cannot arrive
+  // before the operation is registered in responses
+  if (_coalesceReads && reqtype == arangodb::rest::RequestType::GET &&
+      prepared.second != nullptr) {
+    std::string key = coalescingKey(result->endpoint, path, body.get(), headerFields);
+
+    MUTEX_LOCKER(guard, _coalescedRequestsLock);
+    auto it = _coalescedRequests.find(key);
+    if (it != _coalescedRequests.end()) {
+      it->second.emplace_back(callbacks);
+      auto ticketId = communicator::Communicator::nextTicketId();
+      result->operationID = ticketId;
+      responses.emplace(ticketId, AsyncResponse{TRI_microtime(), result});
+      return ticketId;
+    }
+    _coalescedRequests.emplace(key, std::vector<communicator::Callbacks>());
+    callbacks = coalescingCallbacks(key, callbacks);
+  }
+
   auto ticketId = _communicator->addRequest(createCommunicatorDestination(result->endpoint, path),
                std::move(request), callbacks, opt);
 
@@ -565,6 +601,9 @@ std::unique_ptr<ClusterCommResult> ClusterComm::syncRequest(
   while (!wasSignaled) {
     cv.wait(100000);
   }
+  if (result->result != nullptr) {
+    aql::QueryCounters::received(result->result->getBody().length());
+  }
   return result;
 }
 
@@ -713,6 +752,9 @@ ClusterCommResult const ClusterComm::wait(
 
   } while(!status_ready && match_good);
 
+  if (status_ready && return_result.result != nullptr) {
+    aql::QueryCounters::received(return_result.result->getBody().length());
+  }
   return return_result;
 }
 
@@ -1175,6 +1217,12 @@ std::pair<ClusterCommResult*, HttpRequest*> ClusterComm::prepareRequest(std::str
   headersCopy[StaticStrings::HLCHeader] =
     arangodb::basics::HybridLogicalClock::encodeTimeStamp(timeStamp);
 
+  // requests on behalf of a traced request are part of its trace
+  std::string const& traceId = RequestTracer::currentTraceId();
+  if (!traceId.empty()) {
+    headersCopy.emplace(StaticStrings::TraceIdHeader, traceId);
+  }
+
   auto state = ServerState::instance();
 
   if (state->isCoordinator() || state->isDBServer()) {
@@ -1198,17 +1246,98 @@ std::pair<ClusterCommResult*, HttpRequest*> ClusterComm::prepareRequest(std::str
 #endif
 #endif
 
-  
+  // callers may send VelocyPack bodies, the header is sent as it is
+  ContentType contentType = ContentType::JSON;
+  auto it = headersCopy.find(StaticStrings::ContentTypeHeader);
+  if (it != headersCopy.end() && it->second == StaticStrings::MimeTypeVPack) {
+    contentType = ContentType::VPACK;
+  }
+
   if (body == nullptr) {
-    request = HttpRequest::createHttpRequest(ContentType::JSON, "", 0, headersCopy);
+    request = HttpRequest::createHttpRequest(contentType, "", 0, headersCopy);
   } else {
-    request = HttpRequest::createHttpRequest(ContentType::JSON, body->data(), body->size(), headersCopy);
+    request = HttpRequest::createHttpRequest(contentType, body->data(), body->size(), headersCopy);
+    aql::QueryCounters::sent(body->size());
   }
   request->setRequestType(reqtype);
 
   return std::make_pair(result.release(), request);
 }
 
+std::string ClusterComm::coalescingKey(
+    std::string const& endpoint, std::string const& path,
+    std::string const* body,
+    std::unordered_map<std::string, std::string> const& headerFields) {
+  // the headers of the caller are part of the key, so that for example the
+  // reads of different transactions are never coalesced. the order of the
+  // headers in the map is arbitrary
+  std::vector<std::pair<std::string, std::string>> headers(
+      headerFields.begin(), headerFields.end());
+  std::sort(headers.begin(), headers.end());
+
+  std::string key;
+  key.reserve(endpoint.size() + path.size() + 64);
+  key.append(endpoint).push_back('\n');
+  key.append(path).push_back('\n');
+  for (auto const& it : headers) {
+    key.append(it.first).push_back(':');
+    key.append(it.second).push_back('\n');
+  }
+  if (body != nullptr) {
+    key.push_back('\n');
+    key.append(*body);
+  }
+  return key;
+}
+
+communicator::Callbacks ClusterComm::coalescingCallbacks(
+    std::string const& key, communicator::Callbacks const& callbacks) {
+  // takes the joined requests, no request can join anymore afterwards
+  auto takeJoined = [this, key]() {
+    std::vector<communicator::Callbacks> joined;
+    MUTEX_LOCKER(guard, _coalescedRequestsLock);
+    auto it = _coalescedRequests.find(key);
+    TRI_ASSERT(it != _coalescedRequests.end());
+    if (it != _coalescedRequests.end()) {
+      joined.swap(it->second);
+      _coalescedRequests.erase(it);
+    }
+    return joined;
+  };
+
+  // every request gets a response of its own
+  auto copyResponse = [](GeneralResponse* response) {
+    std::unique_ptr<GeneralResponse> copy;
+    HttpResponse* original = dynamic_cast<HttpResponse*>(response);
+    if (original != nullptr) {
+      auto httpResponse = std::make_unique<HttpResponse>(original->responseCode());
+      auto headers = original->headers();
+      httpResponse->setHeaders(std::move(headers));
+      httpResponse->body().appendText(original->body().c_str(),
+                                      original->body().length());
+      copy = std::move(httpResponse);
+    }
+    return copy;
+  };
+
+  auto onSuccess = callbacks._onSuccess;
+  auto onError = callbacks._onError;
+
+  return communicator::Callbacks(
+      [takeJoined, copyResponse, onSuccess](std::unique_ptr<GeneralResponse> response) {
+        for (auto const& it : takeJoined()) {
+          it._onSuccess(copyResponse(response.get()));
+        }
+        onSuccess(std::move(response));
+      },
+      [takeJoined, copyResponse, onError](int errorCode, std::unique_ptr<GeneralResponse> response) {
+        for (auto const& it : takeJoined()) {
+          it._onError(errorCode, copyResponse(response.get()));
+        }
+        onError(errorCode, std::move(response));
+      });
+}
+
 void ClusterComm::addAuthorization(std::unordered_map<std::string, std::string>* headers) {
   if (_authenticationEnabled &&
       headers->find(StaticStrings::Authorization) == headers->end()) {
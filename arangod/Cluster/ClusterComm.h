@@ -28,6 +28,7 @@
 
 #include "Agency/AgencyComm.h"
 #include "Basics/ConditionVariable.h"
+#include "Basics/Mutex.h"
 #include "Basics/ReadWriteLock.h"
 #include "Basics/Thread.h"
 #include "Cluster/ClusterInfo.h"
@@ -610,6 +611,23 @@ class ClusterComm {
       std::string const* body,
       std::unordered_map<std::string, std::string> const& headerFields);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the key under which identical reads are coalesced
+  //////////////////////////////////////////////////////////////////////////////
+
+  static std::string coalescingKey(
+      std::string const& endpoint, std::string const& path,
+      std::string const* body,
+      std::unordered_map<std::string, std::string> const& headerFields);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief callbacks of a coalesced request, which also answer the
+  /// requests that joined it
+  //////////////////////////////////////////////////////////////////////////////
+
+  communicator::Callbacks coalescingCallbacks(
+      std::string const& key, communicator::Callbacks const& callbacks);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief the pointer to the singleton instance
   //////////////////////////////////////////////////////////////////////////////
@@ -718,6 +736,17 @@ class ClusterComm {
   bool _authenticationEnabled;
   std::string _jwtAuthorization;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief GET requests in flight, which later identical requests join
+  /// instead of being sent themselves. maps the coalescing key to the
+  /// callbacks of the joined requests
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool _coalesceReads;
+  arangodb::Mutex _coalescedRequestsLock;
+  std::unordered_map<std::string, std::vector<communicator::Callbacks>>
+      _coalescedRequests;
+
 };
 
 ////////////////////////////////////////////////////////////////////////////////
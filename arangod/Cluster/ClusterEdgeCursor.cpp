@@ -23,6 +23,8 @@
 
 #include "ClusterEdgeCursor.h"
 
+#include "ApplicationFeatures/ApplicationServer.h"
+#include "Cluster/ClusterFeature.h"
 #include "Cluster/ClusterMethods.h"
 #include "Cluster/ClusterTraverser.h"
 #include "Graph/ClusterTraverserCache.h"
@@ -37,6 +39,15 @@ using namespace arangodb;
 using namespace arangodb::graph;
 using namespace arangodb::traverser;
 
+/// @brief number of depths the DBServers may continue a traversal on
+/// their own
+static size_t traversalLocalDepth() {
+  static size_t const depth = static_cast<size_t>(
+      application_features::ApplicationServer::getFeature<ClusterFeature>(
+          "Cluster")->traversalLocalDepth());
+  return depth;
+}
+
 // Traverser variant
 ClusterEdgeCursor::ClusterEdgeCursor(StringRef vertexId, uint64_t depth,
                                      graph::BaseOptions* opts)
@@ -45,6 +56,16 @@ ClusterEdgeCursor::ClusterEdgeCursor(StringRef vertexId, uint64_t depth,
       _opts(opts),
       _cache(static_cast<ClusterTraverserCache*>(opts->cache())) {
   TRI_ASSERT(_cache != nullptr);
+
+  auto& localEdges = _cache->localEdges();
+  auto local = localEdges.find(
+      ClusterTraverserCache::localEdgesKey(vertexId, depth));
+  if (local != localEdges.end()) {
+    // a DBServer has already expanded this vertex on its own
+    _edgeList = local->second;
+    return;
+  }
+
   auto trx = _opts->trx();
   transaction::BuilderLeaser leased(trx);
   transaction::BuilderLeaser b(trx);
@@ -61,7 +82,9 @@ ClusterEdgeCursor::ClusterEdgeCursor(StringRef vertexId, uint64_t depth,
     _cache->datalake(),
     *(leased.get()),
     _cache->filteredDocuments(),
-    _cache->insertedDocuments()
+    _cache->insertedDocuments(),
+    traversalLocalDepth(),
+    localEdges
   );
 }
 
@@ -27,6 +27,7 @@
 #include "Basics/FileUtils.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/files.h"
+#include "Cluster/AgencyCache.h"
 #include "Cluster/ClusterComm.h"
 #include "Cluster/ClusterInfo.h"
 #include "Cluster/HeartbeatThread.h"
@@ -35,6 +36,7 @@
 #include "Logger/Logger.h"
 #include "ProgramOptions/ProgramOptions.h"
 #include "ProgramOptions/Section.h"
+#include "Rest/PayloadCompression.h"
 #include "RestServer/DatabaseFeature.h"
 #include "Scheduler/Scheduler.h"
 #include "Scheduler/SchedulerFeature.h"
@@ -140,6 +142,42 @@ void ClusterFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
   options->addHiddenOption("--cluster.index-create-timeout",
                      "amount of time (in seconds) the coordinator will wait for an index to be created before giving up",
                      new DoubleParameter(&_indexCreationTimeout));
+
+  options->addOption("--cluster.request-multiplexing",
+                     "send requests to other servers of the cluster via HTTP/2, multiplexed over one connection per server (all servers must support HTTP/2)",
+                     new BooleanParameter(&_requestMultiplexing));
+
+  options->addOption("--cluster.max-connections-per-host",
+                     "maximum number of connections to each other server of the cluster, further requests wait for a free connection (0 = unlimited)",
+                     new UInt64Parameter(&_maxConnectionsPerHost));
+
+  options->addOption("--cluster.compression-threshold",
+                     "compress request and response bodies of at least this size (in bytes) exchanged with other servers of the cluster which support it (0 = no compression)",
+                     new UInt64Parameter(&rest::PayloadCompression::THRESHOLD));
+
+  options->addHiddenOption("--cluster.coalesce-reads",
+                     "let identical GET requests to the same server which are in flight at the same time share one request and its response. a read may then see the state from when the earlier request was sent",
+                     new BooleanParameter(&_coalesceReads));
+
+  options->addOption("--cluster.document-batch-window",
+                     "time (in microseconds) a coordinator waits to send concurrent single-document inserts, updates and replaces for the same shard together in one request (0 = no batching)",
+                     new UInt64Parameter(&_documentBatchWindow));
+
+  options->addOption("--cluster.document-batch-size",
+                     "maximum number of documents in such a batch",
+                     new UInt64Parameter(&_documentBatchSize));
+
+  options->addOption("--cluster.traversal-local-depth",
+                     "number of depths a DB server continues a traversal on its own, as long as the edges of the reached vertices are on its shards (0 = ask the DB servers for every vertex)",
+                     new UInt64Parameter(&_traversalLocalDepth));
+
+  options->addOption("--cluster.count-cache-ttl",
+                     "time (in seconds) a coordinator keeps the document counts and figures of a collection, which it uses for query optimization and reports as figures (0 = ask the DB servers on every call)",
+                     new DoubleParameter(&_countCacheTtl));
+
+  options->addOption("--cluster.agency-cache",
+                     "keep a copy of the agency on coordinators and DB servers, which follows the agency's log with long polls, and serve heartbeat reads and agency callbacks from it",
+                     new BooleanParameter(&_agencyCache));
 }
 
 void ClusterFeature::validateOptions(std::shared_ptr<ProgramOptions> options) {
@@ -443,6 +481,20 @@ void ClusterFeature::start() {
               << "default value '" << _heartbeatInterval << " ms'";
   }
 
+  if (_agencyCache &&
+      (role == ServerState::ROLE_COORDINATOR ||
+       role == ServerState::ROLE_PRIMARY)) {
+    // the agency answers a poll after at most a second, with a thread of
+    // its own blocked meanwhile
+    _agencyCacheThread.reset(new AgencyCache(1.0));
+    if (!_agencyCacheThread->start()) {
+      LOG_TOPIC(FATAL, arangodb::Logger::CLUSTER)
+          << "agency cache thread could not be started";
+      FATAL_ERROR_EXIT();
+    }
+    _agencyCallbackRegistry->setCache(_agencyCacheThread.get());
+  }
+
   startHeartbeatThread(_agencyCallbackRegistry.get(), _heartbeatInterval, 5, endpoints);
 
   while (true) {
@@ -494,6 +546,14 @@ void ClusterFeature::stop() {
       }
     }
   }
+
+  if (_agencyCacheThread != nullptr) {
+    // stays around for the callbacks, which unregister until unprepare
+    _agencyCacheThread->beginShutdown();
+    while (_agencyCacheThread->isRunning()) {
+      std::this_thread::sleep_for(std::chrono::microseconds(100000));
+    }
+  }
 }
 
 
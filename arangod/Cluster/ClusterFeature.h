@@ -30,6 +30,7 @@
 #include "Cluster/ServerState.h"
 
 namespace arangodb {
+class AgencyCache;
 class AgencyCallbackRegistry;
 class HeartbeatThread;
 
@@ -68,6 +69,14 @@ protected:
   uint32_t _systemReplicationFactor = 2;
   bool _createWaitsForSyncReplication = true;
   double _indexCreationTimeout = 3600.0;
+  bool _requestMultiplexing = false;
+  uint64_t _maxConnectionsPerHost = 0;
+  bool _coalesceReads = false;
+  uint64_t _documentBatchWindow = 0;
+  uint64_t _documentBatchSize = 1000;
+  uint64_t _traversalLocalDepth = 2;
+  double _countCacheTtl = 1.0;
+  bool _agencyCache = false;
 
  private:
   void reportRole(ServerState::RoleEnum);
@@ -89,6 +98,13 @@ protected:
   bool createWaitsForSyncReplication() const { return _createWaitsForSyncReplication; };
   double indexCreationTimeout() const { return _indexCreationTimeout; }
   uint32_t systemReplicationFactor() { return _systemReplicationFactor; };
+  bool requestMultiplexing() const { return _requestMultiplexing; }
+  uint64_t maxConnectionsPerHost() const { return _maxConnectionsPerHost; }
+  bool coalesceReads() const { return _coalesceReads; }
+  uint64_t documentBatchWindow() const { return _documentBatchWindow; }
+  uint64_t documentBatchSize() const { return _documentBatchSize; }
+  uint64_t traversalLocalDepth() const { return _traversalLocalDepth; }
+  double countCacheTtl() const { return _countCacheTtl; }
 
   void stop() override final;
 
@@ -99,6 +115,7 @@ protected:
   std::shared_ptr<HeartbeatThread> _heartbeatThread;
   uint64_t _heartbeatInterval;
   std::unique_ptr<AgencyCallbackRegistry> _agencyCallbackRegistry;
+  std::unique_ptr<AgencyCache> _agencyCacheThread;
   ServerState::RoleEnum _requestedRole;
 };
 }
@@ -369,6 +369,23 @@ void ClusterInfo::loadClusterId() {
 //
 static std::string const prefixPlan = "Plan";
 
+/// @brief the entry of a previously loaded Plan or Current, none if there
+/// is no such entry
+static VPackSlice previousEntry(std::shared_ptr<VPackBuilder> const& previous,
+                                std::vector<std::string> const& path) {
+  if (previous == nullptr || !previous->slice().isObject()) {
+    return VPackSlice::noneSlice();
+  }
+  return previous->slice().get(path);
+}
+
+/// @brief whether an agency entry is unchanged. the agency serializes its
+/// nodes in a fixed order, so an unchanged entry has the same bytes
+static bool unchanged(VPackSlice const& entry, VPackSlice const& previous) {
+  return !previous.isNone() && entry.byteSize() == previous.byteSize() &&
+         memcmp(entry.start(), previous.start(), entry.byteSize()) == 0;
+}
+
 void ClusterInfo::loadPlan() {
   DatabaseFeature* databaseFeature =
       application_features::ApplicationServer::getFeature<DatabaseFeature>(
@@ -493,6 +510,8 @@ void ClusterInfo::loadPlan() {
             continue;
           }
 
+          auto oldViews = _plannedViews.find(databaseName);
+
           for (auto const& viewPairSlice :
                VPackObjectIterator(viewsSlice)) {
             VPackSlice const& viewSlice = viewPairSlice.value;
@@ -503,6 +522,20 @@ void ClusterInfo::loadPlan() {
             std::string const viewId =
                 viewPairSlice.key.copyString();
 
+            // an unchanged view is taken over from the previous plan
+            if (oldViews != _plannedViews.end()) {
+              auto old = oldViews->second.find(viewId);
+              if (old != oldViews->second.end() && old->second != nullptr &&
+                  &old->second->vocbase() == vocbase &&
+                  unchanged(viewSlice,
+                            previousEntry(_plan, {"Views", databaseName, viewId}))) {
+                auto& views = _newPlannedViews[databaseName];
+                views[viewId] = old->second;
+                views[old->second->name()] = old->second;
+                continue;
+              }
+            }
+
             try {
               auto preCommit = [this, viewId, databaseName](std::shared_ptr<LogicalView> const& view)->bool {
                 auto& views = _newPlannedViews[databaseName];
@@ -615,6 +648,28 @@ void ClusterInfo::loadPlan() {
       //  },...
       // }}
 
+      // collections which are unchanged since the previous plan are taken
+      // over from it, together with their shards. only the changed ones
+      // are rebuilt
+      size_t numCollections = 0;
+      size_t numRebuilt = 0;
+      auto takeOverShards = [&](std::string const& collectionId) {
+        auto shards = _shards.find(collectionId);
+        if (shards != _shards.end()) {
+          newShards.emplace(collectionId, shards->second);
+          for (auto const& shardId : *shards->second) {
+            auto servers = _shardServers.find(shardId);
+            if (servers != _shardServers.end()) {
+              newShardServers.emplace(shardId, servers->second);
+            }
+          }
+        }
+        auto shardKeys = _shardKeys.find(collectionId);
+        if (shardKeys != _shardKeys.end()) {
+          newShardKeys.emplace(collectionId, shardKeys->second);
+        }
+      };
+
       databasesSlice = planSlice.get("Collections"); //format above
       if (databasesSlice.isObject()) {
         bool isCoordinator = ServerState::instance()->isCoordinator();
@@ -634,6 +689,26 @@ void ClusterInfo::loadPlan() {
             continue;
           }
 
+          auto oldCollections = _plannedCollections.find(databaseName);
+          VPackSlice const oldCollectionsSlice =
+              previousEntry(_plan, {"Collections", databaseName});
+
+          // none of the collections of the database has changed
+          if (oldCollections != _plannedCollections.end() &&
+              !oldCollections->second.empty() &&
+              oldCollections->second.begin()->second != nullptr &&
+              &oldCollections->second.begin()->second->vocbase() == vocbase &&
+              unchanged(collectionsSlice, oldCollectionsSlice)) {
+            for (auto const& collectionPairSlice :
+                 VPackObjectIterator(collectionsSlice)) {
+              takeOverShards(collectionPairSlice.key.copyString());
+              ++numCollections;
+            }
+            newCollections.emplace(databaseName, oldCollections->second);
+            swapCollections = true;
+            continue;
+          }
+
           for (auto const& collectionPairSlice :
                VPackObjectIterator(collectionsSlice)) {
             VPackSlice const& collectionSlice = collectionPairSlice.value;
@@ -643,11 +718,32 @@ void ClusterInfo::loadPlan() {
 
             std::string const collectionId =
                 collectionPairSlice.key.copyString();
+            ++numCollections;
+
+            if (oldCollections != _plannedCollections.end() &&
+                oldCollectionsSlice.isObject()) {
+              auto old = oldCollections->second.find(collectionId);
+              if (old != oldCollections->second.end() &&
+                  old->second != nullptr &&
+                  &old->second->vocbase() == vocbase &&
+                  unchanged(collectionSlice,
+                            oldCollectionsSlice.get(collectionId))) {
+                // register with name as well as with id:
+                databaseCollections.emplace(old->second->name(), old->second);
+                databaseCollections.emplace(collectionId, old->second);
+                takeOverShards(collectionId);
+                continue;
+              }
+            }
+            ++numRebuilt;
 
             decltype(vocbase->lookupCollection(collectionId)->clusterIndexEstimates()) selectivity;
             double selectivityTTL = 0;
-            if (isCoordinator) {
-              auto collection = _plannedCollections[databaseName][collectionId];
+            if (isCoordinator && oldCollections != _plannedCollections.end()) {
+              auto it = oldCollections->second.find(collectionId);
+              auto collection = (it != oldCollections->second.end())
+                                    ? it->second
+                                    : std::shared_ptr<LogicalCollection>();
               if(collection){
                 selectivity = collection->clusterIndexEstimates(/*do not update*/ true);
                 selectivityTTL = collection->clusterIndexEstimatesTTL();
@@ -755,6 +851,10 @@ void ClusterInfo::loadPlan() {
         }
       }
 
+      LOG_TOPIC(DEBUG, Logger::CLUSTER)
+          << "loadPlan: rebuilt " << numRebuilt << " of " << numCollections
+          << " collections for plan version " << newPlanVersion;
+
       WRITE_LOCKER(writeLocker, _planProt.lock);
       _plan = planBuilder;
       _planVersion = newPlanVersion;
@@ -860,16 +960,45 @@ void ClusterInfo::loadCurrent() {
         swapDatabases = true;
       }
 
+      // as in loadPlan, the collections which are unchanged since the
+      // previous Current are taken over from it, together with their shards
+      auto takeOverShards = [&](VPackSlice const& shardsSlice) {
+        for (auto const& shardSlice : VPackObjectIterator(shardsSlice)) {
+          std::string const shardID = shardSlice.key.copyString();
+          auto servers = _shardIds.find(shardID);
+          if (servers != _shardIds.end()) {
+            newShardIds.emplace(shardID, servers->second);
+          }
+        }
+      };
+
       databasesSlice = currentSlice.get("Collections");
       if (databasesSlice.isObject()) {
         for (auto const& databaseSlice : VPackObjectIterator(databasesSlice)) {
           std::string const databaseName = databaseSlice.key.copyString();
 
+          auto oldCollections = _currentCollections.find(databaseName);
+          VPackSlice const oldCollectionsSlice =
+              previousEntry(_current, {"Collections", databaseName});
+
           DatabaseCollectionsCurrent databaseCollections;
           for (auto const& collectionSlice :
                VPackObjectIterator(databaseSlice.value)) {
             std::string const collectionName = collectionSlice.key.copyString();
 
+            if (oldCollections != _currentCollections.end() &&
+                oldCollectionsSlice.isObject()) {
+              auto old = oldCollections->second.find(collectionName);
+              if (old != oldCollections->second.end() &&
+                  collectionSlice.value.isObject() &&
+                  unchanged(collectionSlice.value,
+                            oldCollectionsSlice.get(collectionName))) {
+                databaseCollections.emplace(collectionName, old->second);
+                takeOverShards(collectionSlice.value);
+                continue;
+              }
+            }
+
             auto collectionDataCurrent =
                 std::make_shared<CollectionInfoCurrent>(newCurrentVersion);
             for (auto const& shardSlice :
@@ -33,7 +33,7 @@
 
 #include "Agency/AgencyComm.h"
 #include "Basics/Mutex.h"
-#include "Basics/ReadWriteLock.h"
+#include "Basics/ReadMostlyLock.h"
 #include "Basics/Result.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/VelocyPackHelper.h"
@@ -671,7 +671,7 @@ class ClusterInfo {
     Mutex mutex;
     std::atomic<uint64_t> wantedVersion;
     std::atomic<uint64_t> doneVersion;
-    arangodb::basics::ReadWriteLock lock;
+    arangodb::basics::ReadMostlyLock lock;
 
     ProtectionData() : isValid(false), wantedVersion(0), doneVersion(0) {}
   };
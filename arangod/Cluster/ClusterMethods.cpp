@@ -29,8 +29,13 @@
 #include "Basics/StringUtils.h"
 #include "Basics/tri-strings.h"
 #include "Basics/VelocyPackHelper.h"
+#include "ApplicationFeatures/ApplicationServer.h"
 #include "Cluster/ClusterComm.h"
+#include "Cluster/ClusterFeature.h"
 #include "Cluster/ClusterInfo.h"
+#include "Cluster/DocumentBatcher.h"
+#include "Cluster/ShardStatisticsCache.h"
+#include "Graph/ClusterTraverserCache.h"
 #include "Graph/Traverser.h"
 #include "Indexes/Index.h"
 #include "Utils/CollectionNameResolver.h"
@@ -177,6 +182,79 @@ static int handleGeneralCommErrors(ClusterCommResult const* res) {
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief sends a batch of single-document operations to a shard
+////////////////////////////////////////////////////////////////////////////////
+
+static int sendDocumentBatch(rest::RequestType type, std::string const& shard,
+                             std::string const& url, std::string const& body,
+                             rest::ResponseCode& responseCode,
+                             std::shared_ptr<VPackBuilder>& answer) {
+  auto cc = ClusterComm::instance();
+  if (cc == nullptr) {
+    // nullptr should only happen during controlled shutdown
+    return TRI_ERROR_SHUTTING_DOWN;
+  }
+
+  std::vector<ClusterCommRequest> requests;
+  requests.emplace_back("shard:" + shard, type, url,
+                        std::make_shared<std::string>(body));
+
+  size_t nrDone = 0;
+  cc->performRequests(requests, CL_DEFAULT_TIMEOUT, nrDone,
+                      Logger::COMMUNICATION, true);
+
+  auto const& res = requests[0].result;
+  int commError = handleGeneralCommErrors(&res);
+  if (commError != TRI_ERROR_NO_ERROR) {
+    return commError;
+  }
+
+  responseCode = res.answer_code;
+  TRI_ASSERT(res.answer != nullptr);
+  answer = res.answer->toVelocyPackBuilderPtrNoUniquenessChecks();
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the batcher for single-document operations on this coordinator,
+/// nullptr if batching is turned off
+////////////////////////////////////////////////////////////////////////////////
+
+static DocumentBatcher* documentBatcher() {
+  static std::unique_ptr<DocumentBatcher> batcher = []() {
+    auto cluster = application_features::ApplicationServer::getFeature<
+        ClusterFeature>("Cluster");
+    std::unique_ptr<DocumentBatcher> result;
+    if (cluster->documentBatchWindow() > 0) {
+      result = std::make_unique<DocumentBatcher>(
+          cluster->documentBatchWindow(),
+          static_cast<size_t>(cluster->documentBatchSize()),
+          &sendDocumentBatch);
+    }
+    return result;
+  }();
+  return batcher.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the counts and figures of collections on this coordinator,
+/// nullptr if they are not cached
+////////////////////////////////////////////////////////////////////////////////
+
+static ShardStatisticsCache* statisticsCache() {
+  static std::unique_ptr<ShardStatisticsCache> cache = []() {
+    auto cluster = application_features::ApplicationServer::getFeature<
+        ClusterFeature>("Cluster");
+    std::unique_ptr<ShardStatisticsCache> result;
+    if (cluster->countCacheTtl() > 0.0) {
+      result = std::make_unique<ShardStatisticsCache>(cluster->countCacheTtl());
+    }
+    return result;
+  }();
+  return cache.get();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief extracts a numeric value from an hierarchical VelocyPack
 ////////////////////////////////////////////////////////////////////////////////
@@ -842,7 +920,8 @@ int warmupOnCoordinator(std::string const& dbname,
 ////////////////////////////////////////////////////////////////////////////////
 
 int figuresOnCoordinator(std::string const& dbname, std::string const& collname,
-                         std::shared_ptr<arangodb::velocypack::Builder>& result) {
+                         std::shared_ptr<arangodb::velocypack::Builder>& result,
+                         bool allowCached) {
   // Set a few variables needed for our work:
   ClusterInfo* ci = ClusterInfo::instance();
   auto cc = ClusterComm::instance();
@@ -860,6 +939,16 @@ int figuresOnCoordinator(std::string const& dbname, std::string const& collname,
   }
   TRI_ASSERT(collinfo != nullptr);
 
+  ShardStatisticsCache* cache = allowCached ? statisticsCache() : nullptr;
+  std::string const cacheKey = dbname + "/" + std::to_string(collinfo->id());
+  if (cache != nullptr) {
+    std::shared_ptr<VPackBuilder const> cached;
+    if (cache->figures(cacheKey, cached)) {
+      result = std::make_shared<VPackBuilder>(*cached);
+      return TRI_ERROR_NO_ERROR;
+    }
+  }
+
   // If we get here, the sharding attributes are not only _key, therefore
   // we have to contact everybody:
   auto shards = collinfo->shardIds();
@@ -901,6 +990,10 @@ int figuresOnCoordinator(std::string const& dbname, std::string const& collname,
     return TRI_ERROR_INTERNAL;
   }
 
+  if (cache != nullptr) {
+    cache->storeFigures(cacheKey, std::make_shared<VPackBuilder const>(*result));
+  }
+
   return TRI_ERROR_NO_ERROR;  // the cluster operation was OK, however,
                               // the DBserver could have reported an error.
 }
@@ -911,7 +1004,8 @@ int figuresOnCoordinator(std::string const& dbname, std::string const& collname,
 
 int countOnCoordinator(std::string const& dbname, std::string const& cname,
                        transaction::Methods const& trx,
-                       std::vector<std::pair<std::string, uint64_t>>& result) {
+                       std::vector<std::pair<std::string, uint64_t>>& result,
+                       bool allowCached) {
   // Set a few variables needed for our work:
   ClusterInfo* ci = ClusterInfo::instance();
   auto cc = ClusterComm::instance();
@@ -931,6 +1025,12 @@ int countOnCoordinator(std::string const& dbname, std::string const& cname,
   }
   TRI_ASSERT(collinfo != nullptr);
 
+  ShardStatisticsCache* cache = allowCached ? statisticsCache() : nullptr;
+  std::string const cacheKey = dbname + "/" + std::to_string(collinfo->id());
+  if (cache != nullptr && cache->counts(cacheKey, result)) {
+    return TRI_ERROR_NO_ERROR;
+  }
+
   auto shards = collinfo->shardIds();
   std::vector<ClusterCommRequest> requests;
   auto body = std::make_shared<std::string>();
@@ -965,6 +1065,10 @@ int countOnCoordinator(std::string const& dbname, std::string const& cname,
     }
   }
 
+  if (cache != nullptr) {
+    cache->storeCounts(cacheKey, result);
+  }
+
   return TRI_ERROR_NO_ERROR;
 }
 
@@ -1161,6 +1265,30 @@ Result createDocumentOnCoordinator(
 
   VPackBuilder reqBuilder;
 
+  DocumentBatcher* batcher = documentBatcher();
+  if (!useMultiple && batcher != nullptr) {
+    // concurrent single-document inserts into the same shard are sent as
+    // one request for an array of documents
+    TRI_ASSERT(shardMap.size() == 1);
+    auto const& it = *shardMap.begin();
+    if (!trx.isLockedShard(it.first)) {
+      TRI_ASSERT(it.second.size() == 1);
+      auto const& idx = it.second.front();
+      VPackSlice document = slice;
+      if (!idx.second.empty()) {
+        reqBuilder.openObject();
+        reqBuilder.add(StaticStrings::KeyString, VPackValue(idx.second));
+        TRI_SanitizeObject(slice, reqBuilder);
+        reqBuilder.close();
+        document = reqBuilder.slice();
+      }
+      return batcher->execute(
+          arangodb::rest::RequestType::POST, it.first,
+          baseUrl + StringUtils::urlEncode(it.first) + optsUrlPart, document,
+          responseCode, resultBody);
+    }
+  }
+
   // Now prepare the requests:
   std::vector<ClusterCommRequest> requests;
   std::shared_ptr<std::string> body;
@@ -1881,7 +2009,9 @@ int fetchEdgesFromEngines(
     std::vector<std::shared_ptr<VPackBuilder>>& datalake,
     VPackBuilder& builder,
     size_t& filtered,
-    size_t& read) {
+    size_t& read,
+    size_t lookahead,
+    std::unordered_map<std::string, std::vector<VPackSlice>>& localEdges) {
   auto cc = ClusterComm::instance();
   if (cc == nullptr) {
     // nullptr happens only during controlled shutdown
@@ -1897,6 +2027,9 @@ int fetchEdgesFromEngines(
   builder.openObject();
   builder.add("depth", VPackValue(depth));
   builder.add("keys", vertexId);
+  if (lookahead > 0) {
+    builder.add("lookahead", VPackValue(lookahead));
+  }
   builder.close();
 
   std::string const url =
@@ -1934,23 +2067,46 @@ int fetchEdgesFromEngines(
         resSlice, "filtered", 0);
     read += arangodb::basics::VelocyPackHelper::getNumericValue<size_t>(
         resSlice, "readIndex", 0);
-    VPackSlice edges = resSlice.get("edges");
-    for (auto const& e : VPackArrayIterator(edges)) {
-      VPackSlice id = e.get(StaticStrings::IdString);
-      if (!id.isString()) {
-        // invalid id type
-        LOG_TOPIC(ERR, Logger::FIXME) << "got invalid edge id type: " << id.typeName();
-        continue;
+    auto addEdges = [&](VPackSlice edges, std::vector<VPackSlice>& list) {
+      for (auto const& e : VPackArrayIterator(edges)) {
+        VPackSlice id = e.get(StaticStrings::IdString);
+        if (!id.isString()) {
+          // invalid id type
+          LOG_TOPIC(ERR, Logger::FIXME) << "got invalid edge id type: " << id.typeName();
+          continue;
+        }
+        StringRef idRef(id);
+        auto resE = cache.find(idRef);
+        if (resE == cache.end()) {
+          // This edge is not yet cached.
+          allCached = false;
+          cache.emplace(idRef, e);
+          list.emplace_back(e);
+        } else {
+          list.emplace_back(resE->second);
+        }
       }
-      StringRef idRef(id);
-      auto resE = cache.find(idRef);
-      if (resE == cache.end()) {
-        // This edge is not yet cached.
-        allCached = false;
-        cache.emplace(idRef, e);
-        result.emplace_back(e);
-      } else {
-        result.emplace_back(resE->second);
+    };
+    addEdges(resSlice.get("edges"), result);
+
+    // The vertices the DBServer has expanded on its own. All their
+    // edges are on this DBServer.
+    VPackSlice local = resSlice.get("local");
+    if (local.isArray()) {
+      for (auto const& entry : VPackArrayIterator(local)) {
+        VPackSlice vertex = entry.get("vertex");
+        VPackSlice edges = entry.get("edges");
+        if (!vertex.isString() || !edges.isArray()) {
+          continue;
+        }
+        std::string key = graph::ClusterTraverserCache::localEdgesKey(
+            StringRef(vertex),
+            arangodb::basics::VelocyPackHelper::getNumericValue<uint64_t>(
+                entry, "depth", 0));
+        auto it = localEdges.emplace(std::move(key), std::vector<VPackSlice>());
+        if (it.second) {
+          addEdges(edges, it.first->second);
+        }
       }
     }
     if (!allCached) {
@@ -1960,10 +2116,113 @@ int fetchEdgesFromEngines(
   return TRI_ERROR_NO_ERROR;
 }
 
+/// @brief builds the requests to fetch the given vertices from the
+///        TraverserEngines. A vertex of a collection sharded by _key
+///        is only requested from the engine on the leader of its shard,
+///        all other vertices are requested from all engines.
+
+static void buildVertexRequests(
+    std::string const& dbname,
+    std::unordered_map<ServerID, traverser::TraverserEngineID> const* engines,
+    std::unordered_set<StringRef> const& vertexIds, VPackBuilder& builder,
+    std::vector<ClusterCommRequest>& requests) {
+  ClusterInfo* ci = ClusterInfo::instance();
+
+  // collection name => collection, nullptr if the shard of
+  // its vertices cannot be deduced from the _id
+  std::unordered_map<std::string, std::shared_ptr<LogicalCollection>> collections;
+  std::unordered_map<ServerID, std::vector<StringRef>> routed;
+  std::vector<StringRef> unrouted;
+  VPackBuilder idBuilder;
+
+  for (auto const& v : vertexIds) {
+    size_t pos = v.find('/');
+    if (pos == std::string::npos || pos + 1 == v.size()) {
+      unrouted.emplace_back(v);
+      continue;
+    }
+    std::string const collectionName = v.substr(0, pos).toString();
+    auto it = collections.find(collectionName);
+    if (it == collections.end()) {
+      std::shared_ptr<LogicalCollection> collection;
+      try {
+        collection = ci->getCollection(dbname, collectionName);
+      } catch (...) {
+        // not a collection we know, let the engines report it
+      }
+      if (collection != nullptr &&
+          (collection->isSmart() || collection->isSatellite() ||
+           !collection->usesDefaultShardKeys())) {
+        collection.reset();
+      }
+      it = collections.emplace(collectionName, std::move(collection)).first;
+    }
+
+    ShardID shardID;
+    bool usesDefaultShardingAttributes;
+    std::shared_ptr<std::vector<ServerID>> servers;
+    if (it->second != nullptr) {
+      // the shard is computed from the _key part of the _id
+      idBuilder.clear();
+      idBuilder.add(VPackValuePair(v.data(), v.length(), VPackValueType::String));
+      if (ci->getResponsibleShard(it->second.get(), idBuilder.slice(), false,
+                                  shardID, usesDefaultShardingAttributes) ==
+              TRI_ERROR_NO_ERROR &&
+          usesDefaultShardingAttributes) {
+        servers = ci->getResponsibleServer(shardID);
+      }
+    }
+    if (servers != nullptr && !servers->empty() &&
+        engines->find(servers->front()) != engines->end()) {
+      routed[servers->front()].emplace_back(v);
+    } else {
+      unrouted.emplace_back(v);
+    }
+  }
+
+  std::string const url =
+      "/_db/" + StringUtils::urlEncode(dbname) + "/_internal/traverser/vertex/";
+
+  std::shared_ptr<std::string const> unroutedBody;
+  for (auto const& engine : *engines) {
+    auto it = routed.find(engine.first);
+    if (it == routed.end() && unrouted.empty()) {
+      // nothing to fetch from this server
+      continue;
+    }
+    std::shared_ptr<std::string const> body;
+    if (it == routed.end() && unroutedBody != nullptr) {
+      body = unroutedBody;
+    } else {
+      builder.clear();
+      builder.openObject();
+      builder.add(VPackValue("keys"));
+      builder.openArray();
+      if (it != routed.end()) {
+        for (auto const& v : it->second) {
+          builder.add(VPackValuePair(v.data(), v.length(), VPackValueType::String));
+        }
+      }
+      for (auto const& v : unrouted) {
+        builder.add(VPackValuePair(v.data(), v.length(), VPackValueType::String));
+      }
+      builder.close(); // 'keys' Array
+      builder.close(); // base object
+      body = std::make_shared<std::string const>(builder.toJson());
+      if (it == routed.end()) {
+        unroutedBody = body;
+      }
+    }
+    requests.emplace_back("server:" + engine.first, RequestType::PUT,
+                          url + StringUtils::itoa(engine.second), body);
+  }
+}
+
 /// @brief fetch vertices from TraverserEngines
-///        Contacts all TraverserEngines placed
+///        Contacts the TraverserEngines placed
 ///        on the DBServers for the given list
-///        of vertex _id's.
+///        of vertex _id's, if possible only the
+///        ones responsible for the vertices.
 ///        If any server responds with a document
 ///        it will be inserted into the result.
 ///        If no server responds with a document
@@ -1981,30 +2240,8 @@ void fetchVerticesFromEngines(
     // nullptr happens only during controlled shutdown
     return;
   }
-  // TODO map id => ServerID if possible
-  // And go fast-path
-
-  // slow path, sharding not deducable from _id
-  builder.clear();
-  builder.openObject();
-  builder.add(VPackValue("keys"));
-  builder.openArray();
-  for (auto const& v : vertexIds) {
-    //TRI_ASSERT(v.isString());
-    builder.add(VPackValuePair(v.data(), v.length(), VPackValueType::String));
-  }
-  builder.close(); // 'keys' Array
-  builder.close(); // base object
-
-  std::string const url =
-      "/_db/" + StringUtils::urlEncode(dbname) + "/_internal/traverser/vertex/";
-
   std::vector<ClusterCommRequest> requests;
-  auto body = std::make_shared<std::string>(builder.toJson());
-  for (auto const& engine : *engines) {
-    requests.emplace_back("server:" + engine.first, RequestType::PUT,
-                          url + StringUtils::itoa(engine.second), body);
-  }
+  buildVertexRequests(dbname, engines, vertexIds, builder, requests);
 
   // Perform the requests
   size_t nrDone = 0;
@@ -2065,9 +2302,10 @@ void fetchVerticesFromEngines(
 }
 
 /// @brief fetch vertices from TraverserEngines
-///        Contacts all TraverserEngines placed
+///        Contacts the TraverserEngines placed
 ///        on the DBServers for the given list
-///        of vertex _id's.
+///        of vertex _id's, if possible only the
+///        ones responsible for the vertices.
 ///        If any server responds with a document
 ///        it will be inserted into the result.
 ///        If no server responds with a document
@@ -2086,30 +2324,8 @@ void fetchVerticesFromEngines(
     // nullptr happens only during controlled shutdown
     return;
   }
-  // TODO map id => ServerID if possible
-  // And go fast-path
-
-  // slow path, sharding not deducable from _id
-  builder.clear();
-  builder.openObject();
-  builder.add(VPackValue("keys"));
-  builder.openArray();
-  for (auto const& v : vertexIds) {
-    //TRI_ASSERT(v.isString());
-    builder.add(VPackValuePair(v.data(), v.length(), VPackValueType::String));
-  }
-  builder.close(); // 'keys' Array
-  builder.close(); // base object
-
-  std::string const url =
-      "/_db/" + StringUtils::urlEncode(dbname) + "/_internal/traverser/vertex/";
-
   std::vector<ClusterCommRequest> requests;
-  auto body = std::make_shared<std::string>(builder.toJson());
-  for (auto const& engine : *engines) {
-    requests.emplace_back("server:" + engine.first, RequestType::PUT,
-                          url + StringUtils::itoa(engine.second), body);
-  }
+  buildVertexRequests(dbname, engines, vertexIds, builder, requests);
 
   // Perform the requests
   size_t nrDone = 0;
@@ -2395,6 +2611,21 @@ int modifyDocumentOnCoordinator(
     optsUrlPart += "&returnOld=true";
   }
 
+  DocumentBatcher* batcher = documentBatcher();
+  if (canUseFastPath && !useMultiple && batcher != nullptr &&
+      !trx.isLockedShard(shardMap.begin()->first)) {
+    // concurrent single-document operations on the same shard are sent as
+    // one request for an array of documents
+    TRI_ASSERT(shardMap.size() == 1);
+    if (!slice.get(StaticStrings::KeyString).isString()) {
+      return TRI_ERROR_ARANGO_DOCUMENT_KEY_BAD;
+    }
+    ShardID const& shard = shardMap.begin()->first;
+    return batcher->execute(
+        reqType, shard, baseUrl + StringUtils::urlEncode(shard) + optsUrlPart,
+        slice, responseCode, resultBody);
+  }
+
   if (canUseFastPath) {
     // All shard keys are known in all documents.
     // Contact all shards directly with the correct information.
@@ -76,19 +76,23 @@ int warmupOnCoordinator(std::string const& dbname,
                         std::string const& cid);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief returns figures for a sharded collection
+/// @brief returns figures for a sharded collection. with allowCached, the
+/// figures may be up to --cluster.count-cache-ttl seconds old
 ////////////////////////////////////////////////////////////////////////////////
 
 int figuresOnCoordinator(std::string const& dbname, std::string const& collname,
-                         std::shared_ptr<arangodb::velocypack::Builder>&);
+                         std::shared_ptr<arangodb::velocypack::Builder>&,
+                         bool allowCached = false);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief counts number of documents in a coordinator, by shard
+/// @brief counts number of documents in a coordinator, by shard. with
+/// allowCached, the counts may be up to --cluster.count-cache-ttl seconds old
 ////////////////////////////////////////////////////////////////////////////////
 
 int countOnCoordinator(std::string const& dbname, std::string const& collname,
                        transaction::Methods const& trx,
-                       std::vector<std::pair<std::string, uint64_t>>& result);
+                       std::vector<std::pair<std::string, uint64_t>>& result,
+                       bool allowCached = false);
   
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief gets the selectivity estimates from DBservers
@@ -144,6 +148,10 @@ int getDocumentOnCoordinator(
 ///        point to content inside of this lake
 ///        only and do not run out of scope unless
 ///        the lake is cleared.
+///        With a lookahead the DBServers continue
+///        the traversal on their own for vertices
+///        whose edges are all on their shards, and
+///        these edges are put into localEdges.
 ///        TraversalVariant
 
 int fetchEdgesFromEngines(
@@ -153,7 +161,9 @@ int fetchEdgesFromEngines(
     std::unordered_map<StringRef, arangodb::velocypack::Slice>&,
     std::vector<arangodb::velocypack::Slice>&,
     std::vector<std::shared_ptr<arangodb::velocypack::Builder>>&,
-    arangodb::velocypack::Builder&, size_t&, size_t&);
+    arangodb::velocypack::Builder&, size_t&, size_t&, size_t lookahead,
+    std::unordered_map<std::string, std::vector<arangodb::velocypack::Slice>>&
+        localEdges);
 
 /// @brief fetch edges from TraverserEngines
 ///        Contacts all TraverserEngines placed
@@ -178,9 +188,10 @@ int fetchEdgesFromEngines(
     arangodb::velocypack::Builder& builder, size_t& read);
 
 /// @brief fetch vertices from TraverserEngines
-///        Contacts all TraverserEngines placed
+///        Contacts the TraverserEngines placed
 ///        on the DBServers for the given list
-///        of vertex _id's.
+///        of vertex _id's, if possible only the
+///        ones responsible for the vertices.
 ///        If any server responds with a document
 ///        it will be inserted into the result.
 ///        If no server responds with a document
@@ -194,9 +205,10 @@ void fetchVerticesFromEngines(
     arangodb::velocypack::Builder&);
 
 /// @brief fetch vertices from TraverserEngines
-///        Contacts all TraverserEngines placed
+///        Contacts the TraverserEngines placed
 ///        on the DBServers for the given list
-///        of vertex _id's.
+///        of vertex _id's, if possible only the
+///        ones responsible for the vertices.
 ///        If any server responds with a document
 ///        it will be inserted into the result.
 ///        If no server responds with a document
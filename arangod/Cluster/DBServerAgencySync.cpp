@@ -24,8 +24,10 @@
 #include "DBServerAgencySync.h"
 
 #include "Basics/MutexLocker.h"
+#include "Basics/VelocyPackHelper.h"
 #include "Cluster/ClusterInfo.h"
 #include "Cluster/HeartbeatThread.h"
+#include "Cluster/ServerState.h"
 #include "Logger/Logger.h"
 #include "RestServer/DatabaseFeature.h"
 #include "Utils/DatabaseGuard.h"
@@ -36,10 +38,67 @@
 #include "V8Server/V8DealerFeature.h"
 #include "VocBase/vocbase.h"
 
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
 using namespace arangodb;
 using namespace arangodb::application_features;
 using namespace arangodb::rest;
 
+namespace {
+/// @brief handlePlanChange runs at least this often, even if nothing changed
+/// for the server, as a safety net for changes of the local state
+double const maxSkipTime = 60.0;
+
+bool containsServer(VPackSlice servers, std::string const& serverId) {
+  if (servers.isArray()) {
+    for (auto const& it : VPackArrayIterator(servers)) {
+      if (it.isString() && it.isEqualString(serverId)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool isLeader(VPackSlice servers, std::string const& serverId) {
+  return servers.isArray() && servers.length() > 0 &&
+         servers.at(0).isString() && servers.at(0).isEqualString(serverId);
+}
+
+bool hasError(VPackSlice entry) {
+  return entry.isObject() && entry.get("error").isTrue();
+}
+
+/// @brief whether the leader reports all planned indexes of a shard
+bool hasIndexes(VPackSlice planned, VPackSlice reported) {
+  if (!planned.isArray()) {
+    return true;
+  }
+  if (!reported.isArray()) {
+    return planned.length() == 0;
+  }
+  for (auto const& index : VPackArrayIterator(planned)) {
+    VPackSlice id = index.isObject() ? index.get("id") : VPackSlice();
+    if (!id.isString()) {
+      continue;
+    }
+    bool found = false;
+    for (auto const& other : VPackArrayIterator(reported)) {
+      if (other.isObject() && other.get("id").isString() &&
+          other.get("id").isEqualString(id.copyString())) {
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
 DBServerAgencySync::DBServerAgencySync(HeartbeatThread* heartbeat)
     : _heartbeat(heartbeat) {}
 
@@ -52,6 +111,141 @@ void DBServerAgencySync::work() {
   _heartbeat->dispatchedJobResult(result);
 }
 
+bool DBServerAgencySync::localState(VPackSlice plan, VPackSlice current,
+                                    std::string const& serverId,
+                                    VPackBuilder& out) {
+  bool converged = true;
+
+  VPackSlice currentDatabases =
+      current.isObject() ? current.get("Databases") : VPackSlice();
+  VPackSlice currentCollections =
+      current.isObject() ? current.get("Collections") : VPackSlice();
+
+  VPackObjectBuilder guard(&out);
+
+  // every DB server has all databases
+  VPackSlice databases = plan.get("Databases");
+  if (databases.isObject()) {
+    out.add("Databases", databases);
+    for (auto const& db : VPackObjectIterator(databases)) {
+      VPackSlice reported =
+          currentDatabases.isObject()
+              ? currentDatabases.get(std::vector<std::string>(
+                    {db.key.copyString(), serverId}))
+              : VPackSlice();
+      if (!reported.isObject() || hasError(reported)) {
+        converged = false;
+      }
+    }
+  }
+  VPackSlice views = plan.get("Views");
+  if (views.isObject()) {
+    out.add("Views", views);
+  }
+
+  // databases, collections and shards of the server
+  std::unordered_set<std::string> planned;
+
+  out.add(VPackValue("Collections"));
+  {
+    VPackObjectBuilder collectionsGuard(&out);
+    VPackSlice collections = plan.get("Collections");
+    if (collections.isObject()) {
+      for (auto const& db : VPackObjectIterator(collections)) {
+        if (!db.value.isObject()) {
+          continue;
+        }
+        std::string const dbName = db.key.copyString();
+        for (auto const& col : VPackObjectIterator(db.value)) {
+          VPackSlice shards =
+              col.value.isObject() ? col.value.get("shards") : VPackSlice();
+          if (!shards.isObject()) {
+            continue;
+          }
+          bool relevant = false;
+          for (auto const& shard : VPackObjectIterator(shards)) {
+            if (containsServer(shard.value, serverId)) {
+              relevant = true;
+              break;
+            }
+          }
+          if (!relevant) {
+            continue;
+          }
+
+          std::string const colName = col.key.copyString();
+          VPackSlice reportedCol =
+              currentCollections.isObject()
+                  ? currentCollections.get(
+                        std::vector<std::string>({dbName, colName}))
+                  : VPackSlice();
+
+          out.add(VPackValue(dbName + "/" + colName));
+          VPackObjectBuilder colGuard(&out);
+          for (auto const& it : VPackObjectIterator(col.value)) {
+            if (!it.key.isEqualString("shards")) {
+              out.add(it.key.copyString(), it.value);
+            }
+          }
+          out.add(VPackValue("shards"));
+          {
+            VPackObjectBuilder shardsGuard(&out);
+            for (auto const& shard : VPackObjectIterator(shards)) {
+              if (!containsServer(shard.value, serverId)) {
+                continue;
+              }
+              std::string const shardName = shard.key.copyString();
+              planned.emplace(dbName + "/" + colName + "/" + shardName);
+
+              VPackSlice reported = reportedCol.isObject()
+                                        ? reportedCol.get(shardName)
+                                        : VPackSlice();
+              out.add(VPackValue(shardName));
+              VPackObjectBuilder shardGuard(&out);
+              out.add("planned", shard.value);
+              if (reported.isNone()) {
+                converged = false;
+                continue;
+              }
+              out.add("current", reported);
+              if (!reported.isObject() || hasError(reported) ||
+                  !containsServer(reported.get("servers"), serverId) ||
+                  !hasIndexes(col.value.get("indexes"), reported.get("indexes"))) {
+                converged = false;
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // shards that the server still reports as their leader, but which are
+  // not planned for it anymore
+  if (currentCollections.isObject()) {
+    for (auto const& db : VPackObjectIterator(currentCollections)) {
+      if (!db.value.isObject()) {
+        continue;
+      }
+      for (auto const& col : VPackObjectIterator(db.value)) {
+        if (!col.value.isObject()) {
+          continue;
+        }
+        for (auto const& shard : VPackObjectIterator(col.value)) {
+          if (shard.value.isObject() &&
+              isLeader(shard.value.get("servers"), serverId) &&
+              planned.find(db.key.copyString() + "/" + col.key.copyString() +
+                           "/" + shard.key.copyString()) == planned.end()) {
+            converged = false;
+          }
+        }
+      }
+    }
+  }
+
+  return converged;
+}
+
 DBServerAgencySyncResult DBServerAgencySync::execute() {
   // default to system database
 
@@ -70,9 +264,39 @@ DBServerAgencySyncResult DBServerAgencySync::execute() {
   auto clusterInfo = ClusterInfo::instance();
   auto plan = clusterInfo->getPlan();
   auto current = clusterInfo->getCurrent();
-  DatabaseGuard guard(*vocbase);
   double startTime = TRI_microtime();
-  V8Context* context = V8DealerFeature::DEALER->enterContext(vocbase, true, V8DealerFeature::ANY_CONTEXT_OR_PRIORITY);
+
+  // handlePlanChange compares the whole plan with the local state, which
+  // takes long in big clusters. it is skipped, if the plan and current
+  // changed only for other servers, and there is nothing left to do
+  // for this one
+  VPackBuilder state;
+  bool converged = false;
+  if (plan != nullptr && plan->slice().isObject() && current != nullptr) {
+    converged = localState(plan->slice(), current->slice(),
+                           ServerState::instance()->getId(), state);
+  }
+  // the state is built in the order of the agency's nodes, so an
+  // unchanged state has the same bytes
+  DBServerLocalState& last = _heartbeat->localState();
+  if (converged && startTime - last.time < ::maxSkipTime &&
+      !last.state.isEmpty() &&
+      state.slice().byteSize() == last.state.slice().byteSize() &&
+      memcmp(state.slice().start(), last.state.slice().start(),
+             state.slice().byteSize()) == 0) {
+    LOG_TOPIC(DEBUG, Logger::HEARTBEAT)
+        << "DBServerAgencySync::execute nothing changed for this server";
+    result.success = true;
+    result.planVersion = basics::VelocyPackHelper::getNumericValue<uint64_t>(
+        plan->slice(), "Version", 0);
+    result.currentVersion = basics::VelocyPackHelper::getNumericValue<uint64_t>(
+        current->slice(), "Version", 0);
+    return result;
+  }
+
+  DatabaseGuard guard(*vocbase);
+  V8Context* context = V8DealerFeature::DEALER->enterContext(vocbase, true, V8DealerFeature::ANY_CONTEXT_OR_PRIORITY,
+                                                              RequestLane::CLUSTER_V8);
 
   if (context == nullptr) {
     LOG_TOPIC(WARN, arangodb::Logger::HEARTBEAT) << "DBServerAgencySync::execute: no V8 context";
@@ -114,12 +338,9 @@ DBServerAgencySyncResult DBServerAgencySync::execute() {
     v8::Handle<v8::Function> func =
       v8::Handle<v8::Function>::Cast(handlePlanChange);
     v8::Handle<v8::Value> args[2];
-    // Keep the shared_ptr to the builder while we run TRI_VPackToV8 on the
-    // slice(), just to be on the safe side:
-    auto builder = clusterInfo->getPlan();
-    args[0] = TRI_VPackToV8(isolate, builder->slice());
-    builder = clusterInfo->getCurrent();
-    args[1] = TRI_VPackToV8(isolate, builder->slice());
+    // the same Plan and Current that the local state was built from
+    args[0] = TRI_VPackToV8(isolate, plan->slice());
+    args[1] = TRI_VPackToV8(isolate, current->slice());
     
     v8::Handle<v8::Value> res =
       func->Call(isolate->GetCurrentContext()->Global(), 2, args);
@@ -151,7 +372,7 @@ DBServerAgencySyncResult DBServerAgencySync::execute() {
             result.currentVersion =
               static_cast<uint64_t>(value->ToInteger()->Value());
           }
-        } else if (value->IsBoolean() && strcmp(*str, "success")) {
+        } else if (value->IsBoolean() && strcmp(*str, "success") == 0) {
           result.success = TRI_ObjectToBoolean(value);
         }
       }
@@ -162,6 +383,10 @@ DBServerAgencySyncResult DBServerAgencySync::execute() {
     }
     LOG_TOPIC(DEBUG, Logger::HEARTBEAT)
       << "DBServerAgencySync::execute back from JS";
+    if (result.success && !state.isEmpty()) {
+      last.state = std::move(state);
+      last.time = startTime;
+    }
     // invalidate our local cache, even if an error occurred
     clusterInfo->flush();
   } catch (...) {
@@ -26,9 +26,21 @@
 
 #include "Basics/Common.h"
 
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
 namespace arangodb {
 class HeartbeatThread;
 
+/// @brief the parts of Plan and Current that concern this DB server, as the
+/// last successful handlePlanChange saw them
+struct DBServerLocalState {
+  DBServerLocalState() : time(0.0) {}
+
+  velocypack::Builder state;
+  double time;
+};
+
 struct DBServerAgencySyncResult {
   bool success;
   uint64_t planVersion;
@@ -53,6 +65,15 @@ class DBServerAgencySync {
  public:
   void work();
 
+  /// @brief builds the parts of Plan and Current that concern the server:
+  /// the databases and views, and the planned collections with a shard on
+  /// the server, with only these shards and their entries in Current.
+  /// returns whether Current reflects the plan for the server, i.e. there
+  /// is nothing left to do for handlePlanChange. public for the tests
+  static bool localState(velocypack::Slice plan, velocypack::Slice current,
+                         std::string const& serverId,
+                         velocypack::Builder& out);
+
  private:
   DBServerAgencySyncResult execute();
 
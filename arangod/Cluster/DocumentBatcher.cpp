@@ -0,0 +1,188 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "DocumentBatcher.h"
+
+#include "Basics/ConditionLocker.h"
+#include "Basics/Exceptions.h"
+#include "Basics/MutexLocker.h"
+#include "Basics/StaticStrings.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Rest/GeneralResponse.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+DocumentBatcher::DocumentBatcher(uint64_t window, size_t maxDocuments,
+                                 Sender sender)
+    : _window(window),
+      _maxDocuments(maxDocuments == 0 ? 1 : maxDocuments),
+      _sender(std::move(sender)),
+      _batches(0),
+      _documents(0) {}
+
+DocumentBatcher::~DocumentBatcher() { TRI_ASSERT(_open.empty()); }
+
+int DocumentBatcher::execute(rest::RequestType type, std::string const& shard,
+                             std::string const& url, VPackSlice document,
+                             rest::ResponseCode& responseCode,
+                             std::shared_ptr<VPackBuilder>& resultBody) {
+  std::string const key =
+      std::to_string(static_cast<int>(type)) + " " + url;
+
+  std::shared_ptr<Batch> batch;
+  size_t index;
+  bool full = false;
+  {
+    MUTEX_LOCKER(locker, _lock);
+    auto it = _open.find(key);
+    if (it == _open.end()) {
+      batch = std::make_shared<Batch>();
+      batch->documents.openArray();
+      _open.emplace(key, batch);
+    } else {
+      batch = it->second;
+    }
+    batch->documents.add(document);
+    index = batch->count++;
+    if (batch->count >= _maxDocuments) {
+      // no more documents for this one, the next operation starts a new batch
+      _open.erase(key);
+      full = true;
+    }
+  }
+
+  if (index == 0) {
+    // we are the first, wait for the others and send the batch
+    {
+      CONDITION_LOCKER(guard, batch->condition);
+      auto const deadline = std::chrono::steady_clock::now() +
+                            std::chrono::microseconds(_window);
+      while (!batch->full && !full) {
+        auto const now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+          break;
+        }
+        guard.wait(std::chrono::duration_cast<std::chrono::microseconds>(
+            deadline - now));
+      }
+    }
+    {
+      MUTEX_LOCKER(locker, _lock);
+      auto it = _open.find(key);
+      if (it != _open.end() && it->second == batch) {
+        _open.erase(it);
+      }
+      batch->documents.close();
+    }
+
+    send(type, shard, url, *batch);
+  } else {
+    CONDITION_LOCKER(guard, batch->condition);
+    if (full) {
+      batch->full = true;
+      guard.signal();
+    }
+    while (!batch->done) {
+      guard.wait();
+    }
+  }
+
+  if (batch->error != TRI_ERROR_NO_ERROR) {
+    return batch->error;
+  }
+  demultiplex(*batch, index, responseCode, resultBody);
+  return TRI_ERROR_NO_ERROR;
+}
+
+void DocumentBatcher::send(rest::RequestType type, std::string const& shard,
+                           std::string const& url, Batch& batch) {
+  int error = TRI_ERROR_NO_ERROR;
+  rest::ResponseCode responseCode = rest::ResponseCode::SERVER_ERROR;
+  std::shared_ptr<VPackBuilder> answer;
+
+  try {
+    error = _sender(type, shard, url, batch.documents.slice().toJson(),
+                    responseCode, answer);
+  } catch (basics::Exception const& ex) {
+    error = ex.code();
+  } catch (std::bad_alloc const&) {
+    error = TRI_ERROR_OUT_OF_MEMORY;
+  } catch (...) {
+    error = TRI_ERROR_INTERNAL;
+  }
+  if (error == TRI_ERROR_NO_ERROR && answer == nullptr) {
+    error = TRI_ERROR_INTERNAL;
+  }
+
+  _batches.fetch_add(1, std::memory_order_relaxed);
+  _documents.fetch_add(batch.count, std::memory_order_relaxed);
+
+  CONDITION_LOCKER(guard, batch.condition);
+  batch.error = error;
+  batch.responseCode = responseCode;
+  batch.answer = std::move(answer);
+  batch.done = true;
+  guard.broadcast();
+}
+
+void DocumentBatcher::demultiplex(Batch const& batch, size_t index,
+                                  rest::ResponseCode& responseCode,
+                                  std::shared_ptr<VPackBuilder>& resultBody) {
+  // every operation gets its own builder, the callers steal them
+  resultBody = std::make_shared<VPackBuilder>();
+
+  VPackSlice answer = batch.answer->slice();
+  if (!answer.isArray()) {
+    // the whole request failed, e.g. because the shard is gone
+    responseCode = batch.responseCode;
+    resultBody->add(answer);
+    return;
+  }
+
+  if (index >= answer.length()) {
+    responseCode = rest::ResponseCode::SERVER_ERROR;
+    resultBody->openObject();
+    resultBody->add(StaticStrings::Error, VPackValue(true));
+    resultBody->add(StaticStrings::ErrorNum, VPackValue(TRI_ERROR_INTERNAL));
+    resultBody->add(StaticStrings::ErrorMessage,
+                    VPackValue("invalid response for batched document operation"));
+    resultBody->close();
+    return;
+  }
+
+  VPackSlice result = answer.at(index);
+  if (result.isObject() && result.get(StaticStrings::Error).isTrue()) {
+    int errorNum = basics::VelocyPackHelper::getNumericValue<int>(
+        result, StaticStrings::ErrorNum.c_str(), TRI_ERROR_INTERNAL);
+    if (errorNum == TRI_ERROR_NO_ERROR) {
+      errorNum = TRI_ERROR_INTERNAL;
+    }
+    // the document handler reports revision conflicts of single documents
+    // as failed preconditions
+    responseCode = (errorNum == TRI_ERROR_ARANGO_CONFLICT)
+                       ? rest::ResponseCode::PRECONDITION_FAILED
+                       : GeneralResponse::responseCode(errorNum);
+  } else {
+    responseCode = batch.responseCode;
+  }
+  resultBody->add(result);
+}
@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_CLUSTER_DOCUMENT_BATCHER_H
+#define ARANGOD_CLUSTER_DOCUMENT_BATCHER_H 1
+
+#include "Basics/Common.h"
+#include "Basics/ConditionVariable.h"
+#include "Basics/Mutex.h"
+#include "Rest/CommonDefines.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+
+/// @brief collects the single-document inserts, updates and replaces of
+/// concurrent requests on a coordinator, which go to the same shard with
+/// the same options, into one request for an array of documents. the first
+/// operation of a batch waits for the batching window, or until the batch
+/// is full, then sends the batch and hands every operation its part of the
+/// result
+class DocumentBatcher {
+ public:
+  /// @brief sends the documents (a JSON array) with the given method and
+  /// url to the shard. returns a communication error, or sets the response
+  /// code and body of the DB server
+  typedef std::function<int(rest::RequestType, std::string const& shard,
+                            std::string const& url, std::string const& body,
+                            rest::ResponseCode& responseCode,
+                            std::shared_ptr<velocypack::Builder>& answer)>
+      Sender;
+
+  DocumentBatcher(DocumentBatcher const&) = delete;
+  DocumentBatcher& operator=(DocumentBatcher const&) = delete;
+
+  /// @brief window is the time in microseconds the first operation of a
+  /// batch waits for more
+  DocumentBatcher(uint64_t window, size_t maxDocuments, Sender sender);
+
+  ~DocumentBatcher();
+
+  /// @brief executes the operation for one document as part of a batch.
+  /// the url is the one for arrays of documents, including the shard and
+  /// the options. returns a communication error of the batch, or sets the
+  /// response code and body as the DB server would have responded to the
+  /// single-document operation
+  int execute(rest::RequestType type, std::string const& shard,
+              std::string const& url, velocypack::Slice document,
+              rest::ResponseCode& responseCode,
+              std::shared_ptr<velocypack::Builder>& resultBody);
+
+  uint64_t window() const { return _window; }
+
+  /// @brief number of batches sent and documents contained in them
+  uint64_t batches() const { return _batches.load(); }
+  uint64_t documents() const { return _documents.load(); }
+
+ private:
+  struct Batch {
+    Batch() : count(0), full(false), done(false), error(0),
+              responseCode(rest::ResponseCode::SERVER_ERROR) {}
+
+    // protected by _lock
+    velocypack::Builder documents;
+    size_t count;
+
+    // protected by the condition variable
+    basics::ConditionVariable condition;
+    bool full;
+    bool done;
+    int error;
+    rest::ResponseCode responseCode;
+    std::shared_ptr<velocypack::Builder> answer;
+  };
+
+  /// @brief sends the batch, as the first of its operations
+  void send(rest::RequestType type, std::string const& shard,
+            std::string const& url, Batch& batch);
+
+  /// @brief the result of the index-th document of a batch
+  static void demultiplex(Batch const& batch, size_t index,
+                          rest::ResponseCode& responseCode,
+                          std::shared_ptr<velocypack::Builder>& resultBody);
+
+ private:
+  uint64_t const _window;
+  size_t const _maxDocuments;
+  Sender const _sender;
+
+  Mutex _lock;
+  // the batches still accepting documents, by method and url
+  std::unordered_map<std::string, std::shared_ptr<Batch>> _open;
+
+  std::atomic<uint64_t> _batches;
+  std::atomic<uint64_t> _documents;
+};
+
+}  // namespace arangodb
+
+#endif
@@ -25,9 +25,15 @@
 #include "FollowerInfo.h"
 
 #include "ApplicationFeatures/ApplicationServer.h"
+#include "Basics/ConditionLocker.h"
+#include "Basics/Exceptions.h"
 #include "Cluster/ServerState.h"
 #include "VocBase/LogicalCollection.h"
 
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
 using namespace arangodb;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -291,3 +297,80 @@ void FollowerInfo::clear() {
   auto v = std::make_shared<std::vector<ServerID>>();
   _followers = v;  // will cast to std::vector<ServerID> const
 }
+
+/// @brief a write waiting for the replication of its documents
+struct FollowerInfo::PendingReplication {
+  PendingReplication(VPackSlice documents, size_t count)
+      : documents(documents), count(count), done(false) {}
+
+  VPackSlice const documents;
+  size_t const count;
+  Result result;
+  bool done;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief replicate documents together with those of concurrent writes
+////////////////////////////////////////////////////////////////////////////////
+
+Result FollowerInfo::replicateGrouped(
+    std::string const& key, VPackSlice documents, size_t count,
+    std::function<Result(std::string const&, size_t)> const& send) {
+  PendingReplication self(documents, count);
+
+  CONDITION_LOCKER(guard, _groupCondition);
+  ReplicationGroup& group = _replicationGroups[key];
+  group.queue.emplace_back(&self);
+
+  while (!self.done) {
+    if (group.inFlight) {
+      guard.wait();
+      continue;
+    }
+
+    // send the documents of all queued writes, including our own
+    std::vector<PendingReplication*> batch;
+    batch.swap(group.queue);
+    group.inFlight = true;
+    guard.unlock();
+
+    Result res;
+    try {
+      VPackBuilder payload;
+      size_t total = 0;
+      payload.openArray();
+      for (auto const* pending : batch) {
+        if (pending->documents.isArray()) {
+          for (VPackSlice doc : VPackArrayIterator(pending->documents)) {
+            payload.add(doc);
+          }
+        } else {
+          payload.add(pending->documents);
+        }
+        total += pending->count;
+      }
+      payload.close();
+      res = send(payload.slice().toJson(), total);
+    } catch (basics::Exception const& ex) {
+      res.reset(ex.code(), ex.what());
+    } catch (std::exception const& ex) {
+      res.reset(TRI_ERROR_INTERNAL, ex.what());
+    } catch (...) {
+      res.reset(TRI_ERROR_INTERNAL);
+    }
+
+    guard.lock();
+    group.inFlight = false;
+    for (auto* pending : batch) {
+      pending->result = res;
+      pending->done = true;
+    }
+    if (group.queue.empty()) {
+      // all writes of the group have their result
+      _replicationGroups.erase(key);
+    }
+    guard.broadcast();
+  }
+
+  return self.result;
+}
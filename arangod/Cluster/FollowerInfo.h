@@ -26,6 +26,10 @@
 #define ARANGOD_CLUSTER_FOLLOWER_INFO_H 1
 
 #include "ClusterInfo.h"
+#include "Basics/ConditionVariable.h"
+#include "Basics/Result.h"
+
+#include <velocypack/Slice.h>
 
 namespace arangodb {
 
@@ -34,11 +38,22 @@ namespace arangodb {
 ////////////////////////////////////////////////////////////////////////////////
 
 class FollowerInfo {
+  struct PendingReplication;
+
+  /// @brief writes that replicate along the same path to the same followers
+  struct ReplicationGroup {
+    ReplicationGroup() : inFlight(false) {}
+    bool inFlight;
+    std::vector<PendingReplication*> queue;
+  };
+
   std::shared_ptr<std::vector<ServerID> const> _followers;
   mutable Mutex                                _mutex;
   arangodb::LogicalCollection*                 _docColl;
   std::string                                  _theLeader;
      // if the latter is empty, the we are leading
+  basics::ConditionVariable                    _groupCondition;
+  std::unordered_map<std::string, ReplicationGroup> _replicationGroups;
 
  public:
 
@@ -76,6 +91,20 @@ class FollowerInfo {
 
   void clear();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief replicate the documents of a write to the followers together
+  /// with the documents of concurrent writes with the same key, which
+  /// identifies the request path and the followers. if no request of the
+  /// group is in flight, the documents are sent right away, otherwise they
+  /// are sent together with the documents of all writes that arrive until
+  /// it returns. send gets the JSON array of the documents and their
+  /// number, and its result is returned to every write of the request
+  //////////////////////////////////////////////////////////////////////////////
+
+  Result replicateGrouped(
+      std::string const& key, velocypack::Slice documents, size_t count,
+      std::function<Result(std::string const&, size_t)> const& send);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief set leadership
   //////////////////////////////////////////////////////////////////////////////
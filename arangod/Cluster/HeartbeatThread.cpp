@@ -32,6 +32,8 @@
 #include "Basics/MutexLocker.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/tri-strings.h"
+#include "Cluster/AgencyCache.h"
+#include "Cluster/AgencyCallbackRegistry.h"
 #include "Cluster/ClusterComm.h"
 #include "Cluster/ClusterInfo.h"
 #include "Cluster/DBServerAgencySync.h"
@@ -328,7 +330,7 @@ void HeartbeatThread::runDBServer() {
               AgencyCommManager::path("Current/Version"),
               "/.agency"}));
 
-        AgencyCommResult result = _agency.sendTransactionWithFailover(trx, 1.0);
+        AgencyCommResult result = readAgency(trx, 1.0);
         if (!result.successful()) {
           LOG_TOPIC(WARN, Logger::HEARTBEAT)
               << "Heartbeat: Could not read from agency!";
@@ -744,7 +746,7 @@ void HeartbeatThread::runCoordinator() {
            AgencyCommManager::path("Shutdown"),
            AgencyCommManager::path("Sync/UserVersion"),
            AgencyCommManager::path("Target/FailedServers"), "/.agency"}));
-      AgencyCommResult result = _agency.sendTransactionWithFailover(trx, timeout);
+      AgencyCommResult result = readAgency(trx, timeout);
 
       if (!result.successful()) {
         LOG_TOPIC(WARN, Logger::HEARTBEAT)
@@ -1223,6 +1225,15 @@ void HeartbeatThread::updateAgentPool(VPackSlice const& agentPool) {
   }
 }
 
+AgencyCommResult HeartbeatThread::readAgency(AgencyReadTransaction const& trx,
+                                             double timeout) {
+  AgencyCache* cache = _agencyCallbackRegistry->cache();
+  if (cache != nullptr && cache->inSync()) {
+    return cache->read(trx.keys);
+  }
+  return _agency.sendTransactionWithFailover(trx, timeout);
+}
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief record the death of a thread, adding std::chrono::system_clock::now().
   ///        This is a static function because HeartbeatThread might not have
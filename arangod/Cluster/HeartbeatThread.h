@@ -81,6 +81,9 @@ class HeartbeatThread : public CriticalThread,
 
   void dispatchedJobResult(DBServerAgencySyncResult);
 
+  /// @brief only used by the sync job, of which one runs at a time
+  DBServerLocalState& localState() { return _localState; }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief whether or not the thread has run at least once.
   /// this is used on the coordinator only
@@ -176,6 +179,14 @@ class HeartbeatThread : public CriticalThread,
 
   void updateServerMode(arangodb::velocypack::Slice const& readOnlySlice);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief reads the keys of the transaction from the agency cache while it
+  /// is in sync with the agency, otherwise from the agency
+  //////////////////////////////////////////////////////////////////////////////
+
+  AgencyCommResult readAgency(AgencyReadTransaction const& trx,
+                              double timeout);
+
  private:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief AgencyCallbackRegistry
@@ -293,6 +304,9 @@ class HeartbeatThread : public CriticalThread,
 
   // when was the javascript sync routine last run?
   double _lastSyncTime;
+
+  // what the last successful sync routine saw
+  DBServerLocalState _localState;
 };
 }
 
@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "ShardStatisticsCache.h"
+
+#include "Basics/MutexLocker.h"
+#include "Basics/system-functions.h"
+
+using namespace arangodb;
+
+ShardStatisticsCache::ShardStatisticsCache(double ttl)
+    : _ttl(ttl), _nextPrune(0.0) {}
+
+bool ShardStatisticsCache::counts(std::string const& key, Counts& result) {
+  MUTEX_LOCKER(guard, _lock);
+  auto it = _entries.find(key);
+  return it != _entries.end() && lookup(it->second.counts, result);
+}
+
+void ShardStatisticsCache::storeCounts(std::string const& key,
+                                       Counts const& counts) {
+  MUTEX_LOCKER(guard, _lock);
+  double const now = TRI_microtime();
+  prune(now);
+  store(_entries[key].counts, counts, now);
+}
+
+bool ShardStatisticsCache::figures(
+    std::string const& key,
+    std::shared_ptr<velocypack::Builder const>& result) {
+  MUTEX_LOCKER(guard, _lock);
+  auto it = _entries.find(key);
+  return it != _entries.end() && lookup(it->second.figures, result);
+}
+
+void ShardStatisticsCache::storeFigures(
+    std::string const& key,
+    std::shared_ptr<velocypack::Builder const> const& figures) {
+  MUTEX_LOCKER(guard, _lock);
+  double const now = TRI_microtime();
+  prune(now);
+  store(_entries[key].figures, figures, now);
+}
+
+size_t ShardStatisticsCache::size() {
+  MUTEX_LOCKER(guard, _lock);
+  return _entries.size();
+}
+
+template <typename T>
+bool ShardStatisticsCache::lookup(Value<T>& value, T& result) const {
+  if (!value.valid) {
+    // everybody fetches the value until there is one
+    return false;
+  }
+  double const now = TRI_microtime();
+  if (value.expires < now) {
+    // this caller fetches a new value, the others get the old one until
+    // it is stored
+    value.expires = now + _ttl;
+    return false;
+  }
+  result = value.value;
+  return true;
+}
+
+template <typename T>
+void ShardStatisticsCache::store(Value<T>& value, T const& result,
+                                 double now) const {
+  value.value = result;
+  value.expires = now + _ttl;
+  value.valid = true;
+}
+
+template <typename T>
+bool ShardStatisticsCache::isStale(Value<T> const& value, double now) const {
+  // a value in use gets a new expiry time when its refresh is started
+  return !value.valid || value.expires + _ttl < now;
+}
+
+void ShardStatisticsCache::prune(double now) {
+  if (_nextPrune > now) {
+    return;
+  }
+  _nextPrune = now + _ttl;
+
+  for (auto it = _entries.begin(); it != _entries.end(); /* no hoisting */) {
+    if (isStale((*it).second.counts, now) && isStale((*it).second.figures, now)) {
+      it = _entries.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
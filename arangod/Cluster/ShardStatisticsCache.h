@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef ARANGOD_CLUSTER_SHARD_STATISTICS_CACHE_H
+#define ARANGOD_CLUSTER_SHARD_STATISTICS_CACHE_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Mutex.h"
+
+#include <velocypack/Builder.h>
+
+namespace arangodb {
+
+/// @brief the counts and figures of cluster collections on a coordinator,
+/// for callers which can live with values of a bounded age instead of
+/// asking every shard leader on each call. a value expires ttl seconds
+/// after it was stored. the first caller which finds it expired is told to
+/// fetch a new one, while the others keep getting the old value. so a
+/// value is at most twice the ttl old, if that caller fails. values which
+/// nobody looked at for a ttl after they expired are removed, so that
+/// dropped collections do not stay in the cache
+class ShardStatisticsCache {
+ public:
+  typedef std::vector<std::pair<std::string, uint64_t>> Counts;
+
+  ShardStatisticsCache(ShardStatisticsCache const&) = delete;
+  ShardStatisticsCache& operator=(ShardStatisticsCache const&) = delete;
+
+  /// @brief ttl is in seconds
+  explicit ShardStatisticsCache(double ttl);
+
+  double ttl() const { return _ttl; }
+
+  /// @brief the counts of a collection's shards, by shard. returns false if
+  /// the caller has to count, and store the result
+  bool counts(std::string const& key, Counts& result);
+
+  void storeCounts(std::string const& key, Counts const& counts);
+
+  /// @brief the figures of a collection, summed up over its shards. returns
+  /// false if the caller has to fetch them, and store the result
+  bool figures(std::string const& key,
+               std::shared_ptr<velocypack::Builder const>& result);
+
+  void storeFigures(std::string const& key,
+                    std::shared_ptr<velocypack::Builder const> const& figures);
+
+  /// @brief the number of collections in the cache
+  size_t size();
+
+ private:
+  template <typename T>
+  struct Value {
+    Value() : expires(0.0), valid(false) {}
+
+    T value;
+    double expires;
+    bool valid;
+  };
+
+  struct Entry {
+    Value<Counts> counts;
+    Value<std::shared_ptr<velocypack::Builder const>> figures;
+  };
+
+  template <typename T>
+  bool lookup(Value<T>& value, T& result) const;
+
+  template <typename T>
+  void store(Value<T>& value, T const& result, double now) const;
+
+  template <typename T>
+  bool isStale(Value<T> const& value, double now) const;
+
+  /// @brief remove the entries whose values are all stale, at most once
+  /// per ttl
+  void prune(double now);
+
+ private:
+  double const _ttl;
+
+  Mutex _lock;
+  std::unordered_map<std::string, Entry> _entries;
+  double _nextPrune;
+};
+
+}  // namespace arangodb
+
+#endif
@@ -28,12 +28,16 @@
 #include "Aql/QueryString.h"
 #include "Basics/Exceptions.h"
 #include "Basics/Result.h"
+#include "Cluster/ClusterInfo.h"
 #include "Graph/EdgeCursor.h"
 #include "Graph/ShortestPathOptions.h"
 #include "Graph/TraverserCache.h"
 #include "Graph/TraverserOptions.h"
+#include "Indexes/Index.h"
 #include "Transaction/Context.h"
+#include "Transaction/Helpers.h"
 #include "Utils/CollectionNameResolver.h"
+#include "VocBase/LogicalCollection.h"
 #include "VocBase/ManagedDocumentResult.h"
 
 #include <velocypack/Iterator.h>
@@ -52,6 +56,10 @@ static const std::string TYPE = "type";
 static const std::string VARIABLES = "variables";
 static const std::string VERTICES = "vertices";
 
+// maximum number of vertices a TraverserEngine expands on its own
+// while answering one request
+static size_t const MaxLocalVertices = 1000;
+
 #ifndef USE_ENTERPRISE
 /*static*/ std::unique_ptr<BaseEngine> BaseEngine::BuildEngine(
     TRI_vocbase_t& vocbase,
@@ -283,58 +291,36 @@ BaseTraverserEngine::BaseTraverserEngine(
 BaseTraverserEngine::~BaseTraverserEngine() {}
 
 void BaseTraverserEngine::getEdges(VPackSlice vertex, size_t depth,
-                                   VPackBuilder& builder) {
+                                   size_t lookahead, VPackBuilder& builder) {
   // We just hope someone has locked the shards properly. We have no clue...
   // Thanks locking
   TRI_ASSERT(vertex.isString() || vertex.isArray());
   ManagedDocumentResult mmdr;
+  // the vertices on the other side of the edges, if we continue locally
+  std::vector<std::string> reached;
+  std::vector<std::string>* next = (lookahead > 0) ? &reached : nullptr;
   builder.openObject();
   builder.add(VPackValue("edges"));
   builder.openArray();
   if (vertex.isArray()) {
     for (VPackSlice v : VPackArrayIterator(vertex)) {
       TRI_ASSERT(v.isString());
-      // result.clear();
-      StringRef vertexId(v);
-      std::unique_ptr<arangodb::graph::EdgeCursor> edgeCursor(
-          _opts->nextCursor(&mmdr, vertexId, depth));
-
-      edgeCursor->readAll([&](EdgeDocumentToken&& eid,
-                              VPackSlice edge, size_t cursorId) {
-        if (edge.isString()) {
-          edge = _opts->cache()->lookupToken(eid);
-        }
-        if (edge.isNull()) {
-          return;
-        }
-        if (_opts->evaluateEdgeExpression(edge, StringRef(v), depth,
-                                          cursorId)) {
-          builder.add(edge);
-        }
-      });
+      addEdges(StringRef(v), depth, mmdr, builder, next);
       // Result now contains all valid edges, probably multiples.
     }
   } else if (vertex.isString()) {
-    std::unique_ptr<arangodb::graph::EdgeCursor> edgeCursor(
-        _opts->nextCursor(&mmdr, StringRef(vertex), depth));
-    edgeCursor->readAll([&](EdgeDocumentToken&& eid,
-                            VPackSlice edge, size_t cursorId) {
-      if (edge.isString()) {
-        edge = _opts->cache()->lookupToken(eid);
-      }
-      if (edge.isNull()) {
-        return;
-      }
-      if (_opts->evaluateEdgeExpression(edge, StringRef(vertex), depth,
-                                        cursorId)) {
-        builder.add(edge);
-      }
-    });
+    addEdges(StringRef(vertex), depth, mmdr, builder, next);
     // Result now contains all valid edges, probably multiples.
   } else {
     THROW_ARANGO_EXCEPTION(TRI_ERROR_BAD_PARAMETER);
   }
   builder.close();
+  if (!reached.empty()) {
+    builder.add(VPackValue("local"));
+    builder.openArray();
+    expandLocally(std::move(reached), depth + 1, lookahead, mmdr, builder);
+    builder.close();
+  }
   builder.add("readIndex",
               VPackValue(_opts->cache()->getAndResetInsertedDocuments()));
   builder.add("filtered",
@@ -342,6 +328,123 @@ void BaseTraverserEngine::getEdges(VPackSlice vertex, size_t depth,
   builder.close();
 }
 
+void BaseTraverserEngine::addEdges(StringRef vertexId, size_t depth,
+                                   ManagedDocumentResult& mmdr,
+                                   VPackBuilder& builder,
+                                   std::vector<std::string>* reached) {
+  std::unique_ptr<arangodb::graph::EdgeCursor> edgeCursor(
+      _opts->nextCursor(&mmdr, vertexId, depth));
+  edgeCursor->readAll([&](EdgeDocumentToken&& eid,
+                          VPackSlice edge, size_t cursorId) {
+    if (edge.isString()) {
+      edge = _opts->cache()->lookupToken(eid);
+    }
+    if (edge.isNull()) {
+      return;
+    }
+    if (_opts->evaluateEdgeExpression(edge, vertexId, depth, cursorId)) {
+      builder.add(edge);
+      if (reached != nullptr) {
+        StringRef from(transaction::helpers::extractFromFromDocument(edge));
+        if (from == vertexId) {
+          reached->emplace_back(
+              transaction::helpers::extractToFromDocument(edge).copyString());
+        } else {
+          reached->emplace_back(from.toString());
+        }
+      }
+    }
+  });
+}
+
+void BaseTraverserEngine::expandLocally(std::vector<std::string> reached,
+                                        size_t depth, size_t lookahead,
+                                        ManagedDocumentResult& mmdr,
+                                        VPackBuilder& builder) {
+  size_t expanded = 0;
+  for (size_t level = 0; level < lookahead && depth < _opts->maxDepth;
+       ++level, ++depth) {
+    std::vector<std::string> next;
+    std::unordered_set<std::string> done;
+    bool const last = (level + 1 == lookahead);
+    for (auto const& v : reached) {
+      if (expanded >= MaxLocalVertices) {
+        return;
+      }
+      StringRef vertexId(v);
+      if (!done.emplace(v).second || !edgesAreLocal(vertexId, depth)) {
+        // the coordinator has to ask all DB servers for this one
+        continue;
+      }
+      ++expanded;
+      builder.openObject();
+      builder.add("vertex", VPackValue(v));
+      builder.add("depth", VPackValue(depth));
+      builder.add(VPackValue("edges"));
+      builder.openArray();
+      addEdges(vertexId, depth, mmdr, builder, last ? nullptr : &next);
+      builder.close();
+      builder.close();
+    }
+    if (next.empty()) {
+      return;
+    }
+    reached = std::move(next);
+  }
+}
+
+bool BaseTraverserEngine::edgesAreLocal(StringRef vertexId, size_t depth) {
+  auto const& infos = _opts->lookupInfos(depth);
+  if (infos.empty()) {
+    return false;
+  }
+  ClusterInfo* ci = ClusterInfo::instance();
+  for (auto const& info : infos) {
+    // the edges are only all local if the edge collection is sharded by
+    // the attribute the lookup uses, and the vertex' shard is one of ours
+    if (!info.conditionNeedUpdate || info.idxHandles.empty()) {
+      return false;
+    }
+    aql::AstNode const* dirCmp =
+        info.indexCondition->getMember(info.conditionMemberToUpdate);
+    if (dirCmp->type != aql::NODE_TYPE_OPERATOR_BINARY_EQ ||
+        dirCmp->numMembers() != 2 ||
+        dirCmp->getMember(0)->type != aql::NODE_TYPE_ATTRIBUTE_ACCESS) {
+      return false;
+    }
+    std::string const attribute = dirCmp->getMember(0)->getString();
+    LogicalCollection* shard = info.idxHandles[0].getIndex()->collection();
+    if (shard->isSmart() || shard->shardKeys().size() != 1 ||
+        shard->shardKeys()[0] != attribute) {
+      return false;
+    }
+
+    VPackBuilder edge;
+    edge.openObject();
+    edge.add(attribute, VPackValuePair(vertexId.data(), vertexId.length(),
+                                       VPackValueType::String));
+    edge.close();
+    ShardID responsible;
+    bool usesDefaultShardingAttributes;
+    if (ci->getResponsibleShard(shard, edge.slice(), false, responsible,
+                                usesDefaultShardingAttributes) !=
+        TRI_ERROR_NO_ERROR) {
+      return false;
+    }
+    bool found = false;
+    for (auto const& handle : info.idxHandles) {
+      if (handle.getIndex()->collection()->name() == responsible) {
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void BaseTraverserEngine::getVertexData(VPackSlice vertex, size_t depth,
                                         VPackBuilder& builder) {
   // We just hope someone has locked the shards properly. We have no clue...
@@ -31,7 +31,9 @@ struct TRI_vocbase_t;
 
 namespace arangodb {
 
+class ManagedDocumentResult;
 class Result;
+class StringRef;
 
 namespace transaction {
 class Methods;
@@ -124,7 +126,10 @@ class BaseTraverserEngine : public BaseEngine {
 
   virtual ~BaseTraverserEngine();
 
-  void getEdges(arangodb::velocypack::Slice, size_t,
+  /// @brief the edges of the vertices at the given depth. with a lookahead,
+  /// the edges of the vertices reached over them are added for up to
+  /// lookahead more depths, as long as all their edges are on our shards
+  void getEdges(arangodb::velocypack::Slice, size_t depth, size_t lookahead,
                 arangodb::velocypack::Builder&);
 
   void getVertexData(arangodb::velocypack::Slice, size_t,
@@ -138,6 +143,19 @@ class BaseTraverserEngine : public BaseEngine {
 
   EngineType getType() const override { return TRAVERSER; }
 
+ private:
+  void addEdges(StringRef vertexId, size_t depth, ManagedDocumentResult&,
+                arangodb::velocypack::Builder&,
+                std::vector<std::string>* reached);
+
+  void expandLocally(std::vector<std::string> reached, size_t depth,
+                     size_t lookahead, ManagedDocumentResult&,
+                     arangodb::velocypack::Builder&);
+
+  /// @brief whether all edges of the vertex at the given depth are
+  /// on the shards of this engine
+  bool edgesAreLocal(StringRef vertexId, size_t depth);
+
  protected:
   std::unique_ptr<traverser::TraverserOptions> _opts;
 };
@@ -168,6 +168,9 @@ Result ClusterCollection::updateProperties(VPackSlice const& slice,
     bool def = Helper::readBooleanValue(_info.slice(), "cacheEnabled", false);
     merge.add("cacheEnabled",
               VPackValue(Helper::readBooleanValue(slice, "cacheEnabled", def)));
+    def = Helper::readBooleanValue(_info.slice(), "compressDocuments", false);
+    merge.add("compressDocuments",
+              VPackValue(Helper::readBooleanValue(slice, "compressDocuments", def)));
 
   } else {
     TRI_ASSERT(false);
@@ -215,6 +218,8 @@ void ClusterCollection::getPropertiesVPack(velocypack::Builder& result) const {
   } else if (_engineType == ClusterEngineType::RocksDBEngine) {
     result.add("cacheEnabled", VPackValue(Helper::readBooleanValue(
                                    _info.slice(), "cacheEnabled", false)));
+    result.add("compressDocuments", VPackValue(Helper::readBooleanValue(
+                                        _info.slice(), "compressDocuments", false)));
 
   } else {
     TRI_ASSERT(false);
@@ -230,7 +235,7 @@ std::shared_ptr<VPackBuilder> ClusterCollection::figures() {
 
   int res =
       figuresOnCoordinator(_logicalCollection->vocbase().name(),
-                           std::to_string(_logicalCollection->id()), builder);
+                           std::to_string(_logicalCollection->id()), builder, true);
   if (res != TRI_ERROR_NO_ERROR) {
     THROW_ARANGO_EXCEPTION(res);
   }
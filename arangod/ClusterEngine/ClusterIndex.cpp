@@ -48,6 +48,11 @@ std::vector<std::vector<arangodb::basics::AttributeName>> const
     PrimaryIndexAttributes{{arangodb::basics::AttributeName("_id", false)},
                            {arangodb::basics::AttributeName("_key", false)}};
 
+// The RocksDB edge index covers the opposite vertex as well
+std::vector<std::vector<arangodb::basics::AttributeName>> const
+    EdgeIndexAttributes{{arangodb::basics::AttributeName("_from", false)},
+                        {arangodb::basics::AttributeName("_to", false)}};
+
 };
 
 ClusterIndex::ClusterIndex(TRI_idx_iid_t id, LogicalCollection* collection,
@@ -188,6 +193,15 @@ bool ClusterIndex::hasCoveringIterator() const {
 }
 
 
+std::vector<std::vector<arangodb::basics::AttributeName>> const&
+ClusterIndex::coveredFields() const {
+  if (_engineType == ClusterEngineType::RocksDBEngine &&
+      _indexType == Index::TRI_IDX_TYPE_EDGE_INDEX) {
+    return ::EdgeIndexAttributes;
+  }
+  return fields();
+}
+
 bool ClusterIndex::matchesDefinition(VPackSlice const& info) const {
   // TODO implement faster version of this
   return Index::Compare(_info.slice(), info);
@@ -243,6 +257,7 @@ bool ClusterIndex::supportsFilterCondition(
       }
       break;
     }
+    case TRI_IDX_TYPE_TTL_INDEX:
     case TRI_IDX_TYPE_PERSISTENT_INDEX: {
       // same for both engines
       return PersistentIndexAttributeMatcher::supportsFilterCondition(this, node, reference, itemsInIndex,
@@ -299,6 +314,7 @@ bool ClusterIndex::supportsSortCondition(
       }
       break;
     }
+    case TRI_IDX_TYPE_TTL_INDEX:
     case TRI_IDX_TYPE_PERSISTENT_INDEX: {
       // same for both indexes
       return PersistentIndexAttributeMatcher::supportsSortCondition(this, sortCondition, reference, itemsInIndex,
@@ -354,6 +370,7 @@ aql::AstNode* ClusterIndex::specializeCondition(
       }
       break;
     }
+    case TRI_IDX_TYPE_TTL_INDEX:
     case TRI_IDX_TYPE_PERSISTENT_INDEX: {
       return PersistentIndexAttributeMatcher::specializeCondition(this, node, reference);
     }
@@ -76,6 +76,10 @@ class ClusterIndex : public Index {
 
   bool hasCoveringIterator() const override;
 
+  /// @brief the covered fields of the index on the DB servers
+  std::vector<std::vector<arangodb::basics::AttributeName>> const&
+  coveredFields() const override;
+
   /// @brief Checks if this index is identical to the given definition
   bool matchesDefinition(arangodb::velocypack::Slice const&) const override;
 
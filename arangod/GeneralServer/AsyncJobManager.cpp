@@ -25,6 +25,7 @@
 
 #include "Basics/ReadLocker.h"
 #include "Basics/WriteLocker.h"
+#include "Basics/files.h"
 #include "Basics/voc-errors.h"
 #include "GeneralServer/RestHandler.h"
 #include "Logger/Logger.h"
@@ -39,7 +40,8 @@ AsyncJobResult::AsyncJobResult()
       _response(nullptr),
       _stamp(0.0),
       _status(JOB_UNDEFINED),
-      _handler(nullptr) {}
+      _handler(nullptr),
+      _memoryUsage(0) {}
 
 AsyncJobResult::AsyncJobResult(IdType jobId, Status status,
                                RestHandler* handler)
@@ -47,12 +49,13 @@ AsyncJobResult::AsyncJobResult(IdType jobId, Status status,
       _response(nullptr),
       _stamp(TRI_microtime()),
       _status(status),
-      _handler(handler) {}
+      _handler(handler),
+      _memoryUsage(0) {}
 
 AsyncJobResult::~AsyncJobResult() {}
 
-AsyncJobManager::AsyncJobManager()
-    : _lock(), _jobs() {}
+AsyncJobManager::AsyncJobManager(uint64_t memoryLimit)
+    : _lock(), _jobs(), _memoryLimit(memoryLimit), _memoryUsage(0) {}
 
 AsyncJobManager::~AsyncJobManager() {
   // remove all results that haven't been fetched
@@ -66,29 +69,51 @@ AsyncJobManager::~AsyncJobManager() {
 GeneralResponse* AsyncJobManager::getJobResult(AsyncJobResult::IdType jobId,
                                                AsyncJobResult::Status& status,
                                                bool removeFromList) {
-  WRITE_LOCKER(writeLocker, _lock);
+  std::unique_ptr<GeneralResponse> response;
+  std::string spillFile;
 
-  auto it = _jobs.find(jobId);
+  {
+    WRITE_LOCKER(writeLocker, _lock);
 
-  if (it == _jobs.end()) {
-    status = AsyncJobResult::JOB_UNDEFINED;
-    return nullptr;
-  }
+    auto it = _jobs.find(jobId);
 
-  GeneralResponse* response = (*it).second._response;
-  status = (*it).second._status;
+    if (it == _jobs.end()) {
+      status = AsyncJobResult::JOB_UNDEFINED;
+      return nullptr;
+    }
+
+    status = (*it).second._status;
+
+    if (status == AsyncJobResult::JOB_PENDING) {
+      return nullptr;
+    }
 
-  if (status == AsyncJobResult::JOB_PENDING) {
-    return nullptr;
+    if (!removeFromList) {
+      return nullptr;
+    }
+
+    // remove the job from the list, the response is handed out
+    response.reset((*it).second._response);
+    spillFile = std::move((*it).second._spillFile);
+    (*it).second._response = nullptr;
+    removeJob(it);
   }
 
-  if (!removeFromList) {
-    return nullptr;
+  if (!spillFile.empty()) {
+    // read back the payload outside of the lock
+    if (response != nullptr) {
+      try {
+        response->restorePayload(spillFile);
+      } catch (std::exception const& ex) {
+        LOG_TOPIC(WARN, Logger::FIXME)
+            << "cannot read result of async job " << jobId << ": " << ex.what();
+        response->reset(rest::ResponseCode::SERVER_ERROR);
+      }
+    }
+    TRI_UnlinkFile(spillFile.c_str());
   }
 
-  // remove the job from the list
-  _jobs.erase(it);
-  return response;
+  return response.release();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -104,14 +129,8 @@ bool AsyncJobManager::deleteJobResult(AsyncJobResult::IdType jobId) {
     return false;
   }
 
-  GeneralResponse* response = (*it).second._response;
-
-  if (response != nullptr) {
-    delete response;
-  }
-
   // remove the job from the list
-  _jobs.erase(it);
+  removeJob(it);
   return true;
 }
 
@@ -122,40 +141,23 @@ bool AsyncJobManager::deleteJobResult(AsyncJobResult::IdType jobId) {
 void AsyncJobManager::deleteJobs() {
   WRITE_LOCKER(writeLocker, _lock);
 
-  auto it = _jobs.begin();
-
-  while (it != _jobs.end()) {
-    GeneralResponse* response = (*it).second._response;
-
-    if (response != nullptr) {
-      delete response;
-    }
-
-    ++it;
+  while (!_jobs.empty()) {
+    removeJob(_jobs.begin());
   }
-
-  _jobs.clear();
 }
 
 void AsyncJobManager::deleteExpiredJobResults(double stamp) {
   WRITE_LOCKER(writeLocker, _lock);
 
-  auto it = _jobs.begin();
-
-  while (it != _jobs.end()) {
-    AsyncJobResult ajr = (*it).second;
-
-    if (ajr._stamp < stamp) {
-      GeneralResponse* response = ajr._response;
-
-      if (response != nullptr) {
-        delete response;
-      }
-
-      _jobs.erase(it++);
-    } else {
-      ++it;
+  // the oldest jobs come first
+  while (!_expiries.empty() && (*_expiries.begin()).first < stamp) {
+    auto it = _jobs.find((*_expiries.begin()).second);
+    TRI_ASSERT(it != _jobs.end());
+    if (it == _jobs.end()) {
+      _expiries.erase(_expiries.begin());
+      continue;
     }
+    removeJob(it);
   }
 }
 
@@ -204,7 +206,9 @@ Result AsyncJobManager::clearAllJobs() {
                std::to_string(it.first) + ") in handler " + handler->name());
     }
   }
-  _jobs.clear();
+  while (!_jobs.empty()) {
+    removeJob(_jobs.begin());
+  }
   
   return rv;
 }
@@ -264,7 +268,13 @@ void AsyncJobManager::initAsyncJob(RestHandler* handler) {
 
   WRITE_LOCKER(writeLocker, _lock);
 
-  _jobs.emplace(jobId, ajr);
+  auto expiry = _expiries.emplace(ajr._stamp, jobId).first;
+  try {
+    _jobs.emplace(jobId, ajr);
+  } catch (...) {
+    _expiries.erase(expiry);
+    throw;
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -275,16 +285,80 @@ void AsyncJobManager::finishAsyncJob(RestHandler* handler) {
   AsyncJobResult::IdType jobId = handler->handlerId();
   std::unique_ptr<GeneralResponse> response = handler->stealResponse();
 
+  size_t memoryUsage =
+      response == nullptr ? 0 : response->payloadMemoryUsage();
+  std::string spillFile;
+
+  if (_memoryLimit > 0 && memoryUsage > 0 &&
+      _memoryUsage.load() + memoryUsage > _memoryLimit) {
+    // the payload is written to disk outside of the lock
+    spillFile = spillPayload(*response);
+    if (!spillFile.empty()) {
+      memoryUsage = 0;
+    }
+  }
+
   {
     WRITE_LOCKER(writeLocker, _lock);
     auto it = _jobs.find(jobId);
 
-    if (it == _jobs.end()) {
-      return; // job is already canceled
+    if (it != _jobs.end()) {
+      double const stamp = TRI_microtime();
+      if (stamp != it->second._stamp) {
+        _expiries.emplace(stamp, jobId);
+        _expiries.erase(std::make_pair(it->second._stamp, jobId));
+      }
+
+      it->second._response = response.release();
+      it->second._status = AsyncJobResult::JOB_DONE;
+      it->second._stamp = stamp;
+      it->second._memoryUsage = memoryUsage;
+      it->second._spillFile = std::move(spillFile);
+      _memoryUsage += memoryUsage;
+      return;
     }
+  }
+
+  // job is already canceled
+  if (!spillFile.empty()) {
+    TRI_UnlinkFile(spillFile.c_str());
+  }
+}
+
+void AsyncJobManager::removeJob(JobList::iterator it) {
+  AsyncJobResult& ajr = (*it).second;
 
-    it->second._response = response.release();
-    it->second._status = AsyncJobResult::JOB_DONE;
-    it->second._stamp = TRI_microtime();
+  delete ajr._response;
+  if (!ajr._spillFile.empty()) {
+    TRI_UnlinkFile(ajr._spillFile.c_str());
   }
+  _memoryUsage -= ajr._memoryUsage;
+  _expiries.erase(std::make_pair(ajr._stamp, (*it).first));
+  _jobs.erase(it);
+}
+
+std::string AsyncJobManager::spillPayload(GeneralResponse& response) {
+  std::string filename;
+  long systemError;
+  std::string errorMessage;
+
+  if (TRI_GetTempName("jobs", filename, true, systemError, errorMessage) !=
+      TRI_ERROR_NO_ERROR) {
+    LOG_TOPIC(WARN, Logger::FIXME)
+        << "cannot create temporary file for async job result: "
+        << errorMessage;
+    return "";
+  }
+
+  try {
+    response.spillPayload(filename);
+  } catch (std::exception const& ex) {
+    LOG_TOPIC(WARN, Logger::FIXME)
+        << "cannot write async job result to '" << filename
+        << "': " << ex.what();
+    TRI_UnlinkFile(filename.c_str());
+    return "";
+  }
+
+  return filename;
 }
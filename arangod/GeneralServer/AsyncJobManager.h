@@ -28,6 +28,9 @@
 #include "Basics/Result.h"
 #include "Basics/ReadWriteLock.h"
 
+#include <atomic>
+#include <set>
+
 namespace arangodb {
 class GeneralResponse;
 
@@ -56,13 +59,21 @@ struct AsyncJobResult {
   double _stamp;
   Status _status;
   RestHandler* _handler;
+
+  /// @brief number of bytes the payload of the response takes in memory
+  size_t _memoryUsage;
+
+  /// @brief file with the payload of the response, if it was spilled
+  std::string _spillFile;
 };
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   AsyncJobManager
 // -----------------------------------------------------------------------------
 
-/// @brief Manages responses which will be fetched later by clients.
+/// @brief Manages responses which will be fetched later by clients. the
+/// payloads of responses beyond a memory limit are written to temporary
+/// files, and read back when the response is fetched
 class AsyncJobManager {
   AsyncJobManager(AsyncJobManager const&) = delete;
   AsyncJobManager& operator=(AsyncJobManager const&) = delete;
@@ -71,7 +82,9 @@ class AsyncJobManager {
   typedef std::unordered_map<AsyncJobResult::IdType, AsyncJobResult> JobList;
 
  public:
-  AsyncJobManager();
+  /// @brief memoryLimit is the number of bytes the payloads of the stored
+  /// responses may take in memory, 0 means unlimited
+  explicit AsyncJobManager(uint64_t memoryLimit = 0);
   ~AsyncJobManager();
 
  public:
@@ -94,9 +107,29 @@ class AsyncJobManager {
   void initAsyncJob(RestHandler*);
   void finishAsyncJob(RestHandler*);
 
+  /// @brief number of bytes the payloads of the stored responses take in
+  /// memory
+  uint64_t memoryUsage() const { return _memoryUsage.load(); }
+
+ private:
+  /// @brief removes a job and frees its response. the caller must hold the
+  /// write lock
+  void removeJob(JobList::iterator it);
+
+  /// @brief writes the payload of a response to a temporary file. returns
+  /// the name of the file, or an empty string if the payload stays in memory
+  static std::string spillPayload(GeneralResponse& response);
+
  private:
   basics::ReadWriteLock _lock;
   JobList _jobs;
+
+  /// @brief the jobs ordered by their stamps, so that expired jobs can be
+  /// removed without looking at the others
+  std::set<std::pair<double, AsyncJobResult::IdType>> _expiries;
+
+  uint64_t const _memoryLimit;
+  std::atomic<uint64_t> _memoryUsage;
 };
 }
 }
@@ -29,6 +29,7 @@
 #include "Basics/Locking.h"
 #include "Basics/MutexLocker.h"
 #include "Basics/StaticStrings.h"
+#include "Basics/tri-strings.h"
 #include "Cluster/ServerState.h"
 #include "GeneralServer/AsyncJobManager.h"
 #include "GeneralServer/AuthenticationFeature.h"
@@ -39,6 +40,8 @@
 #include "Logger/Logger.h"
 #include "Meta/conversion.h"
 #include "Replication/ReplicationFeature.h"
+#include "Rest/HttpRequest.h"
+#include "Rest/PayloadCompression.h"
 #include "RestServer/DatabaseFeature.h"
 #include "RestServer/VocbaseContext.h"
 #include "Scheduler/JobGuard.h"
@@ -286,10 +289,14 @@ void GeneralCommTask::executeRequest(
     return;
   }
 
-  // forward to correct server if necessary
-  bool forwarded = handler->forwardRequest();
-  if (forwarded) {
-    addResponse(*handler->response(), handler->stealStatistics());
+  RequestStatistics::SET_HANDLER(statistics(messageId), handler->name(),
+                                 handler->lane());
+
+  // forward to correct server if necessary. the handler is suspended until
+  // the other coordinator answers, so it must not run in this thread
+  if (handler->needsForwarding()) {
+    handler->setStatistics(stealStatistics(messageId));
+    handleRequestSync(std::move(handler));
     return;
   }
 
@@ -412,6 +419,71 @@ void GeneralCommTask::addErrorResponse(rest::ResponseCode code,
   addErrorResponse(code, respType, messageId, errorNum, TRI_errno_string(errorNum));
 }
 
+/// @brief checks the authorization header of an HTTP request
+rest::ResponseCode GeneralCommTask::handleAuthHeader(
+    HttpRequest* request) const {
+  if (!_auth->isActive()) {
+    request->setAuthenticated(true);
+    return rest::ResponseCode::OK;
+  }
+
+  bool found;
+  std::string const& authStr = request->header(StaticStrings::Authorization, found);
+  if (!found) {
+    events::CredentialsMissing(request);
+    return rest::ResponseCode::UNAUTHORIZED;
+  }
+
+  size_t methodPos = authStr.find_first_of(' ');
+  if (methodPos != std::string::npos) {
+    // skip over authentication method
+    char const* auth = authStr.c_str() + methodPos;
+    while (*auth == ' ') {
+      ++auth;
+    }
+
+    LOG_TOPIC(DEBUG, arangodb::Logger::REQUESTS) << "\"authorization-header\",\"" << (void*)this << "\",\""
+        << authStr << "\"";
+    try {
+      // note that these methods may throw in case of an error
+      AuthenticationMethod authMethod = AuthenticationMethod::NONE;
+      if (TRI_CaseEqualString(authStr.c_str(), "basic ", 6)) {
+        authMethod = AuthenticationMethod::BASIC;
+      } else if (TRI_CaseEqualString(authStr.c_str(), "bearer ", 7)) {
+        authMethod = AuthenticationMethod::JWT;
+      }
+
+      if (authMethod != AuthenticationMethod::NONE) {
+        request->setAuthenticationMethod(authMethod);
+        TRI_ASSERT(_auth->isActive());
+        auto entry = _auth->tokenCache()->checkAuthentication(authMethod, auth);
+        request->setAuthenticated(entry.authenticated());
+        request->setUser(std::move(entry._username));
+
+        if (request->authenticated()) {
+          events::Authenticated(request, authMethod);
+          return rest::ResponseCode::OK;
+        }
+        events::CredentialsBad(request, authMethod);
+        return rest::ResponseCode::UNAUTHORIZED;
+      }
+
+      // intentionally falls through
+    } catch (arangodb::basics::Exception const& ex) {
+      // translate error
+      if (ex.code() == TRI_ERROR_USER_NOT_FOUND) {
+        return rest::ResponseCode::UNAUTHORIZED;
+      }
+      return GeneralResponse::responseCode(ex.what());
+    } catch (...) {
+      return rest::ResponseCode::SERVER_ERROR;
+    }
+  }
+
+  events::UnknownAuthenticationMethod(request);
+  return rest::ResponseCode::UNAUTHORIZED;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   private methods
 // -----------------------------------------------------------------------------
@@ -423,13 +495,61 @@ bool GeneralCommTask::handleRequestSync(std::shared_ptr<RestHandler> handler) {
   auto const lane = handler->lane();
   auto self = shared_from_this();
 
-  bool ok = SchedulerFeature::SCHEDULER->queue(PriorityRequestLane(lane), [self, this, handler]() {
-    handleRequestDirectly(basics::ConditionalLocking::DoLock,
-                          std::move(handler));
-  });
-
   uint64_t messageId = handler->messageId();
 
+  // drop requests nobody waits for anymore, and those of lanes that are
+  // at their limit
+  RequestAdmission* admission = GeneralServerFeature::ADMISSION;
+  double const deadline = RequestAdmission::deadline(*handler->request());
+  std::shared_ptr<RequestAdmission::Ticket> ticket;
+
+  if (admission != nullptr) {
+    if (deadline > 0.0 && TRI_microtime() >= deadline) {
+      admission->expired(lane);
+      addDeadlineResponse(handler);
+      return false;
+    }
+
+    ticket = admission->admit(lane);
+
+    if (ticket == nullptr) {
+      addErrorResponse(rest::ResponseCode::SERVICE_UNAVAILABLE,
+                       handler->request()->contentTypeResponse(), messageId,
+                       TRI_ERROR_QUEUE_FULL,
+                       std::string("request lane '") + NameRequestLane(lane) +
+                           "' is at its limit");
+      return false;
+    }
+  }
+
+  double const queued = TRI_microtime();
+  RequestStatistics::SET_QUEUE_START(
+      handler->statistics(),
+      SchedulerFeature::SCHEDULER->queueStatistics()._queued);
+
+  bool ok = SchedulerFeature::SCHEDULER->queue(
+      PriorityRequestLane(lane),
+      [self, this, handler, lane, deadline, queued, admission, ticket]() {
+        RequestStatistics::SET_QUEUE_END(handler->statistics());
+
+        if (admission != nullptr) {
+          // the deadline may have passed while the request was queued
+          double const now = TRI_microtime();
+          admission->addQueueTime(lane, now - queued);
+
+          if (deadline > 0.0 && now >= deadline) {
+            admission->expired(lane);
+            _peer->post([self, this, handler]() {
+              addDeadlineResponse(handler);
+            });
+            return;
+          }
+        }
+
+        handleRequestDirectly(basics::ConditionalLocking::DoLock,
+                              std::move(handler), std::move(ticket));
+      });
+
   if (!ok) {
     addErrorResponse(rest::ResponseCode::SERVICE_UNAVAILABLE,
                      handler->request()->contentTypeResponse(), messageId,
@@ -441,11 +561,19 @@ bool GeneralCommTask::handleRequestSync(std::shared_ptr<RestHandler> handler) {
 
 // Just run the handler, could have been called in a different thread
 void GeneralCommTask::handleRequestDirectly(
-    bool doLock, std::shared_ptr<RestHandler> handler) {
+    bool doLock, std::shared_ptr<RestHandler> handler,
+    std::shared_ptr<RequestAdmission::Ticket> ticket) {
   TRI_ASSERT(doLock || _peer->runningInThisThread());
 
   auto self = shared_from_this();
-  handler->runHandler([self, this, doLock](rest::RestHandler* handler) {
+  handler->runHandler([self, this, doLock,
+                       ticket](rest::RestHandler* handler) mutable {
+    // the request does not count for its lane anymore
+    ticket.reset();
+
+    // still in the thread of the handler, not in the I/O thread
+    compressResponse(*handler);
+
     RequestStatistics* stat = handler->stealStatistics();
     // TODO we could reduce all of this to strand::dispatch ?
     if (doLock || !_peer->runningInThisThread()) {
@@ -461,6 +589,61 @@ void GeneralCommTask::handleRequestDirectly(
   });
 }
 
+/// @brief compresses the body of an HTTP response if the client accepts
+/// it, see PayloadCompression
+void GeneralCommTask::compressResponse(RestHandler& handler) {
+  if (!PayloadCompression::enabled()) {
+    return;
+  }
+
+  // only HTTP has content codings
+  HttpRequest const* request =
+      dynamic_cast<HttpRequest const*>(handler.request());
+  if (request == nullptr) {
+    return;
+  }
+
+  bool found;
+  std::string const& accept =
+      request->header(StaticStrings::AcceptEncoding, found);
+  if (!found || !PayloadCompression::accepted(accept)) {
+    return;
+  }
+
+  HttpResponse* response = dynamic_cast<HttpResponse*>(handler.response());
+  if (response == nullptr) {
+    return;
+  }
+
+  // tell the client that it may send compressed request bodies (RFC 7694)
+  response->setHeaderNC(StaticStrings::AcceptEncoding,
+                        PayloadCompression::ENCODING);
+
+  if (response->headers().find(StaticStrings::ContentEncoding) !=
+      response->headers().end()) {
+    // already encoded by the handler
+    return;
+  }
+
+  basics::StringBuffer& body = response->body();
+  std::string compressed;
+  if (PayloadCompression::compress(body.c_str(), body.length(), compressed)) {
+    body.clear();
+    body.appendText(compressed);
+    response->setHeaderNC(StaticStrings::ContentEncoding,
+                          PayloadCompression::ENCODING);
+  }
+}
+
+/// @brief respond to a request whose deadline passed
+void GeneralCommTask::addDeadlineResponse(
+    std::shared_ptr<RestHandler> const& handler) {
+  addErrorResponse(rest::ResponseCode::REQUEST_TIMEOUT,
+                   handler->request()->contentTypeResponse(),
+                   handler->messageId(), TRI_ERROR_REQUEST_CANCELED,
+                   "request deadline exceeded");
+}
+
 // handle a request which came in with the x-arango-async header
 bool GeneralCommTask::handleRequestAsync(std::shared_ptr<RestHandler> handler,
                                          uint64_t* jobId) {
@@ -32,11 +32,13 @@
 #include "Basics/Mutex.h"
 #include "Basics/MutexLocker.h"
 #include "Basics/StringBuffer.h"
+#include "GeneralServer/RequestAdmission.h"
 #include "Scheduler/Socket.h"
 
 namespace arangodb {
 class AuthenticationFeature;
 class GeneralRequest;
+class HttpRequest;
 class GeneralResponse;
 
 namespace rest {
@@ -135,6 +137,9 @@ class GeneralCommTask : public SocketTask {
                         uint64_t messageId, int errorNum, std::string const&);
   void addErrorResponse(rest::ResponseCode, rest::ContentType,
                         uint64_t messageId, int errorNum);
+
+  /// @brief checks the authorization header of an HTTP request
+  rest::ResponseCode handleAuthHeader(HttpRequest* request) const;
   
  protected:
   GeneralServer* const _server;
@@ -155,7 +160,11 @@ class GeneralCommTask : public SocketTask {
 
  private:
   bool handleRequestSync(std::shared_ptr<RestHandler>);
-  void handleRequestDirectly(bool doLock, std::shared_ptr<RestHandler>);
+  void compressResponse(RestHandler&);
+  void handleRequestDirectly(
+      bool doLock, std::shared_ptr<RestHandler>,
+      std::shared_ptr<RequestAdmission::Ticket> ticket = nullptr);
+  void addDeadlineResponse(std::shared_ptr<RestHandler> const&);
   bool handleRequestAsync(std::shared_ptr<RestHandler>,
                           uint64_t* jobId = nullptr);
 };
@@ -40,9 +40,10 @@ using namespace arangodb::rest;
 
 GeneralListenTask::GeneralListenTask(Scheduler* scheduler, GeneralServer* server,
                                      Endpoint* endpoint,
-                                     ProtocolType connectionType)
+                                     ProtocolType connectionType,
+                                     size_t ioContext)
     : Task(scheduler, "GeneralListenTask"),
-      ListenTask(scheduler, endpoint),
+      ListenTask(scheduler, endpoint, ioContext),
       _server(server),
       _connectionType(connectionType) {
   _keepAliveTimeout = GeneralServerFeature::keepAliveTimeout();
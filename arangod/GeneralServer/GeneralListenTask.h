@@ -43,7 +43,7 @@ class GeneralListenTask final : public ListenTask {
 
  public:
   GeneralListenTask(Scheduler*, GeneralServer*, Endpoint*,
-                    ProtocolType connectionType);
+                    ProtocolType connectionType, size_t ioContext);
 
  protected:
   void handleConnected(std::unique_ptr<Socket>,
@@ -93,13 +93,23 @@ bool GeneralServer::openEndpoint(Endpoint* endpoint) {
     protocolType = ProtocolType::HTTP;
   }
 
-  std::unique_ptr<ListenTask> task;
-  task.reset(new GeneralListenTask(SchedulerFeature::SCHEDULER, this, endpoint,
-                                   protocolType));
-  if (!task->start()) {
-    return false;
+  // with separate I/O contexts, every context gets its own acceptor for
+  // TCP endpoints, and its connections stay in this context
+  Scheduler* scheduler = SchedulerFeature::SCHEDULER;
+  size_t n = 1;
+  if (endpoint->domainType() != Endpoint::DomainType::UNIX) {
+    n = (std::max)(n, scheduler->numIoContexts());
   }
 
-  _listenTasks.emplace_back(std::move(task));
+  for (size_t i = 0; i < n; ++i) {
+    std::unique_ptr<ListenTask> task;
+    task.reset(
+        new GeneralListenTask(scheduler, this, endpoint, protocolType, i));
+    if (!task->start()) {
+      return false;
+    }
+
+    _listenTasks.emplace_back(std::move(task));
+  }
   return true;
 }
@@ -37,15 +37,18 @@
 #include "Cluster/TraverserEngineRegistry.h"
 #include "GeneralServer/AuthenticationFeature.h"
 #include "GeneralServer/GeneralServer.h"
+#include "GeneralServer/RequestAdmission.h"
 #include "GeneralServer/RestHandlerFactory.h"
 #include "InternalRestHandler/InternalRestTraverserHandler.h"
 #include "ProgramOptions/Parameters.h"
 #include "ProgramOptions/ProgramOptions.h"
 #include "ProgramOptions/Section.h"
 #include "RestHandler/RestAdminLogHandler.h"
+#include "RestHandler/RestAdminMemoryHandler.h"
 #include "RestHandler/RestAdminRoutingHandler.h"
 #include "RestHandler/RestAdminServerHandler.h"
 #include "RestHandler/RestAdminStatisticsHandler.h"
+#include "RestHandler/RestAdminTracesHandler.h"
 #include "RestHandler/RestAqlFunctionsHandler.h"
 #include "RestHandler/RestAqlUserFunctionsHandler.h"
 #include "RestHandler/RestAuthHandler.h"
@@ -94,6 +97,7 @@ using namespace arangodb::options;
 
 rest::RestHandlerFactory* GeneralServerFeature::HANDLER_FACTORY = nullptr;
 rest::AsyncJobManager* GeneralServerFeature::JOB_MANAGER = nullptr;
+rest::RequestAdmission* GeneralServerFeature::ADMISSION = nullptr;
 GeneralServerFeature* GeneralServerFeature::GENERAL_SERVER = nullptr;
 
 GeneralServerFeature::GeneralServerFeature(
@@ -101,6 +105,7 @@ GeneralServerFeature::GeneralServerFeature(
     : ApplicationFeature(server, "GeneralServer"),
       _allowMethodOverride(false),
       _proxyCheck(true) {
+  _laneLimitValues.fill(0);
   setOptional(true);
   startsAfter("Agency");
   startsAfter("Authentication");
@@ -146,6 +151,19 @@ void GeneralServerFeature::collectOptions(
       "trusted origin URLs for CORS requests with credentials",
       new VectorParameter<StringParameter>(&_accessControlAllowOrigins));
 
+  options->addOption(
+      "--http.lane-limit",
+      "maximum number of queued and running requests of a request lane, "
+      "e.g. client-slow=16. further requests of the lane are rejected",
+      new VectorParameter<StringParameter>(&_laneLimits));
+
+  options->addOption(
+      "--http.async-job-memory-limit",
+      "maximum number of bytes the results of async jobs may take in "
+      "memory, further results are written to temporary files (0 = "
+      "unlimited)",
+      new UInt64Parameter(&_asyncJobMemoryLimit));
+
   options->addSection("frontend", "Frontend options");
 
   options->addOption("--frontend.proxy-request-check",
@@ -186,6 +204,15 @@ void GeneralServerFeature::validateOptions(std::shared_ptr<ProgramOptions>) {
                        }),
         _accessControlAllowOrigins.end());
   }
+
+  for (auto const& it : _laneLimits) {
+    if (!RequestAdmission::parseLimit(it, _laneLimitValues)) {
+      LOG_TOPIC(FATAL, arangodb::Logger::FIXME)
+          << "invalid value '" << it << "' for --http.lane-limit, expecting "
+          << "<lane>=<number>";
+      FATAL_ERROR_EXIT();
+    }
+  }
 }
 
 void GeneralServerFeature::prepare() {
@@ -194,10 +221,14 @@ void GeneralServerFeature::prepare() {
 }
 
 void GeneralServerFeature::start() {
-  _jobManager.reset(new AsyncJobManager);
+  _jobManager.reset(new AsyncJobManager(_asyncJobMemoryLimit));
 
   JOB_MANAGER = _jobManager.get();
 
+  _admission.reset(new RequestAdmission(_laneLimitValues));
+
+  ADMISSION = _admission.get();
+
   _handlerFactory.reset(new RestHandlerFactory());
 
   HANDLER_FACTORY = _handlerFactory.get();
@@ -230,6 +261,7 @@ void GeneralServerFeature::unprepare() {
 
   GENERAL_SERVER = nullptr;
   JOB_MANAGER = nullptr;
+  ADMISSION = nullptr;
   HANDLER_FACTORY = nullptr;
 }
 
@@ -510,6 +542,14 @@ void GeneralServerFeature::defineHandlers() {
   _handlerFactory->addHandler(
     "/_admin/statistics-description",
     RestHandlerCreator<arangodb::RestAdminStatisticsHandler>::createNoData);
+  
+  _handlerFactory->addHandler(
+    "/_admin/traces",
+    RestHandlerCreator<arangodb::RestAdminTracesHandler>::createNoData);
+
+  _handlerFactory->addPrefixHandler(
+    "/_admin/memory",
+    RestHandlerCreator<arangodb::RestAdminMemoryHandler>::createNoData);
 
   if (cluster->isEnabled()) {
     _handlerFactory->addPrefixHandler(
@@ -24,6 +24,9 @@
 #define APPLICATION_FEATURES_GENERAL_SERVER_FEATURE_H 1
 
 #include "ApplicationFeatures/ApplicationFeature.h"
+#include "GeneralServer/RequestLane.h"
+
+#include <array>
 
 namespace arangodb {
 
@@ -37,6 +40,7 @@ class TraverserEngineRegistry;
 
 namespace rest {
 class AsyncJobManager;
+class RequestAdmission;
 class RestHandlerFactory;
 class GeneralServer;
 }
@@ -48,6 +52,7 @@ class GeneralServerFeature final
  public:
   static rest::RestHandlerFactory* HANDLER_FACTORY;
   static rest::AsyncJobManager* JOB_MANAGER;
+  static rest::RequestAdmission* ADMISSION;
 
  public:
   static double keepAliveTimeout() {
@@ -106,6 +111,9 @@ class GeneralServerFeature final
   bool _proxyCheck;
   std::vector<std::string> _trustedProxies;
   std::vector<std::string> _accessControlAllowOrigins;
+  std::vector<std::string> _laneLimits;
+  std::array<uint64_t, NumberRequestLanes> _laneLimitValues;
+  uint64_t _asyncJobMemoryLimit = 1024 * 1024 * 1024;
 
  public:
   bool proxyCheck() const { return _proxyCheck; }
@@ -118,6 +126,7 @@ class GeneralServerFeature final
  private:
   std::unique_ptr<rest::RestHandlerFactory> _handlerFactory;
   std::unique_ptr<rest::AsyncJobManager> _jobManager;
+  std::unique_ptr<rest::RequestAdmission> _admission;
   std::unique_ptr<std::pair<aql::QueryRegistry*, traverser::TraverserEngineRegistry*>> _combinedRegistries;
   std::vector<rest::GeneralServer*> _servers;
 };
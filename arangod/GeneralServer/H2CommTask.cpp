@@ -0,0 +1,1058 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "H2CommTask.h"
+
+#include "Basics/StaticStrings.h"
+#include "Basics/StringBuffer.h"
+#include "Basics/StringUtils.h"
+#include "GeneralServer/GeneralServerFeature.h"
+#include "GeneralServer/HttpCommTask.h"
+#include "Logger/Logger.h"
+#include "Rest/HttpRequest.h"
+#include "Rest/PayloadCompression.h"
+#include "Statistics/ConnectionStatistics.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::basics;
+using namespace arangodb::rest;
+
+size_t const H2CommTask::MaxConcurrentStreams = 100;
+uint32_t const H2CommTask::ReceiveWindowSize = 16 * 1024 * 1024;  // 16 MB
+
+namespace {
+char const Preface[] = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+size_t const PrefaceLength = 24;
+
+size_t const FrameHeaderLength = 9;
+// we never announce a larger SETTINGS_MAX_FRAME_SIZE than the default
+size_t const MaxReceiveFrameSize = 16384;
+int64_t const MaxWindowSize = 0x7fffffff;
+uint32_t const DefaultWindowSize = 65535;
+
+// frame types
+uint8_t const FrameData = 0x0;
+uint8_t const FrameHeaders = 0x1;
+uint8_t const FramePriority = 0x2;
+uint8_t const FrameResetStream = 0x3;
+uint8_t const FrameSettings = 0x4;
+uint8_t const FramePushPromise = 0x5;
+uint8_t const FramePing = 0x6;
+uint8_t const FrameGoAway = 0x7;
+uint8_t const FrameWindowUpdate = 0x8;
+uint8_t const FrameContinuation = 0x9;
+
+// frame flags
+uint8_t const FlagEndStream = 0x1;
+uint8_t const FlagAck = 0x1;
+uint8_t const FlagEndHeaders = 0x4;
+uint8_t const FlagPadded = 0x8;
+uint8_t const FlagPriority = 0x20;
+
+// error codes
+uint32_t const NoError = 0x0;
+uint32_t const ProtocolError = 0x1;
+uint32_t const FlowControlError = 0x3;
+uint32_t const StreamClosed = 0x5;
+uint32_t const FrameSizeError = 0x6;
+uint32_t const RefusedStream = 0x7;
+uint32_t const CompressionError = 0x9;
+
+// settings
+uint16_t const SettingsEnablePush = 0x2;
+uint16_t const SettingsMaxConcurrentStreams = 0x3;
+uint16_t const SettingsInitialWindowSize = 0x4;
+uint16_t const SettingsMaxFrameSize = 0x5;
+uint16_t const SettingsMaxHeaderListSize = 0x6;
+
+uint32_t readUInt32(char const* p) {
+  uint8_t const* b = reinterpret_cast<uint8_t const*>(p);
+  return (uint32_t(b[0]) << 24) | (uint32_t(b[1]) << 16) |
+         (uint32_t(b[2]) << 8) | uint32_t(b[3]);
+}
+
+void writeUInt32(char* p, uint32_t value) {
+  p[0] = static_cast<char>((value >> 24) & 0xff);
+  p[1] = static_cast<char>((value >> 16) & 0xff);
+  p[2] = static_cast<char>((value >> 8) & 0xff);
+  p[3] = static_cast<char>(value & 0xff);
+}
+
+void appendFrameHeader(StringBuffer& buffer, size_t length, uint8_t type,
+                       uint8_t flags, uint32_t streamId) {
+  char header[FrameHeaderLength];
+  header[0] = static_cast<char>((length >> 16) & 0xff);
+  header[1] = static_cast<char>((length >> 8) & 0xff);
+  header[2] = static_cast<char>(length & 0xff);
+  header[3] = static_cast<char>(type);
+  header[4] = static_cast<char>(flags);
+  writeUInt32(header + 5, streamId & 0x7fffffff);
+  buffer.appendText(header, FrameHeaderLength);
+}
+
+void appendSetting(std::string& payload, uint16_t id, uint32_t value) {
+  char setting[6];
+  setting[0] = static_cast<char>((id >> 8) & 0xff);
+  setting[1] = static_cast<char>(id & 0xff);
+  writeUInt32(setting + 2, value);
+  payload.append(setting, 6);
+}
+
+// removes the padding of a DATA or HEADERS frame
+bool stripPadding(uint8_t flags, char const*& payload, size_t& length) {
+  if ((flags & FlagPadded) == 0) {
+    return true;
+  }
+  if (length < 1) {
+    return false;
+  }
+  size_t const padding = static_cast<uint8_t>(payload[0]);
+  ++payload;
+  --length;
+  if (padding > length) {
+    return false;
+  }
+  length -= padding;
+  return true;
+}
+
+// header fields of HTTP/1.x connections, which must not be sent in HTTP/2
+bool isConnectionHeader(std::string const& name) {
+  return name == "connection" || name == "keep-alive" ||
+         name == "proxy-connection" || name == "transfer-encoding" ||
+         name == "upgrade";
+}
+
+// the request is rebuilt as HTTP/1.1 header, so that CR, LF and NUL would
+// allow to smuggle header fields
+bool isValidField(std::string const& value) {
+  return value.find_first_of(std::string("\r\n\0", 3)) == std::string::npos;
+}
+
+char const* contentTypeValue(ContentType type) {
+  switch (type) {
+    case ContentType::UNSET:
+    case ContentType::JSON:
+      return "application/json; charset=utf-8";
+    case ContentType::VPACK:
+      return "application/x-velocypack";
+    case ContentType::TEXT:
+      return "text/plain; charset=utf-8";
+    case ContentType::HTML:
+      return "text/html; charset=utf-8";
+    case ContentType::DUMP:
+      return "application/x-arango-dump; charset=utf-8";
+    case ContentType::CUSTOM:
+      // the header is in the response headers already
+      break;
+  }
+  return nullptr;
+}
+}  // namespace
+
+H2CommTask::H2CommTask(Scheduler* scheduler, GeneralServer* server,
+                       std::unique_ptr<Socket> socket, ConnectionInfo&& info,
+                       double timeout, bool skipSocketInit)
+    : Task(scheduler, "H2CommTask"),
+      GeneralCommTask(scheduler, server, std::move(socket), std::move(info),
+                      timeout, skipSocketInit),
+      _readPosition(0),
+      _prefaceReceived(false),
+      _goAwayReceived(false),
+      _allowMethodOverride(GeneralServerFeature::allowMethodOverride()),
+      _lastStreamId(0),
+      _headerStreamId(0),
+      _headerEndStream(false),
+      _sendWindow(DefaultWindowSize),
+      _initialSendWindow(DefaultWindowSize),
+      _maxSendFrameSize(MaxReceiveFrameSize),
+      _receiveConsumed(0) {
+  _protocol = "http";
+
+  ConnectionStatistics::SET_HTTP(_connectionStatistics);
+}
+
+H2CommTask::~H2CommTask() {
+  for (auto& it : _streams) {
+    if (it.second.statistics != nullptr) {
+      it.second.statistics->release();
+    }
+  }
+}
+
+// reads the next frame from the read buffer
+// caller must hold the _lock
+bool H2CommTask::processRead(double startTime) {
+  TRI_ASSERT(_peer->runningInThisThread());
+
+  cancelKeepAlive();
+  TRI_ASSERT(_readBuffer.c_str() != nullptr);
+
+  char const* start = _readBuffer.c_str() + _readPosition;
+  size_t const available = _readBuffer.length() - _readPosition;
+
+  if (!_prefaceReceived) {
+    if (available < PrefaceLength) {
+      return false;
+    }
+    if (memcmp(start, Preface, PrefaceLength) != 0) {
+      LOG_TOPIC(DEBUG, Logger::COMMUNICATION)
+          << "invalid HTTP/2 connection preface";
+      _closeRequested = true;
+      return false;
+    }
+    _readPosition += PrefaceLength;
+    _prefaceReceived = true;
+    sendSettings();
+    return true;
+  }
+
+  if (available < FrameHeaderLength) {
+    return false;
+  }
+
+  uint8_t const* header = reinterpret_cast<uint8_t const*>(start);
+  size_t const length = (size_t(header[0]) << 16) | (size_t(header[1]) << 8) |
+                        size_t(header[2]);
+
+  if (length > MaxReceiveFrameSize) {
+    return connectionError(FrameSizeError, "frame too large");
+  }
+  if (available < FrameHeaderLength + length) {
+    return false;
+  }
+
+  uint8_t const type = header[3];
+  uint8_t const flags = header[4];
+  uint32_t const streamId = readUInt32(start + 5) & 0x7fffffff;
+
+  // the payload stays valid, the buffer is only compacted after reading
+  _readPosition += FrameHeaderLength + length;
+  return processFrame(type, flags, streamId, start + FrameHeaderLength, length,
+                      startTime);
+}
+
+void H2CommTask::compactify() {
+  if (_readPosition == 0) {
+    return;
+  }
+
+  if (_readPosition == _readBuffer.length()) {
+    _readBuffer.reset();
+  } else {
+    // at most a part of the next frame
+    _readBuffer.erase_front(_readPosition);
+  }
+  _readPosition = 0;
+}
+
+bool H2CommTask::processFrame(uint8_t type, uint8_t flags, uint32_t streamId,
+                              char const* payload, size_t length,
+                              double startTime) {
+  // a header block must not be interrupted by other frames
+  if (_headerStreamId != 0 && type != FrameContinuation) {
+    return connectionError(ProtocolError, "expected CONTINUATION frame");
+  }
+
+  switch (type) {
+    case FrameData:
+      return processData(flags, streamId, payload, length);
+
+    case FrameHeaders:
+      return processHeaders(flags, streamId, payload, length, startTime);
+
+    case FramePriority:
+      // priorities are ignored, all streams are served round robin
+      if (streamId == 0) {
+        return connectionError(ProtocolError, "PRIORITY on stream 0");
+      }
+      if (length != 5) {
+        sendResetStream(streamId, FrameSizeError);
+        finishStream(streamId);
+      }
+      return true;
+
+    case FrameResetStream:
+      if (streamId == 0 || streamId > _lastStreamId) {
+        return connectionError(ProtocolError, "RST_STREAM on idle stream");
+      }
+      if (length != 4) {
+        return connectionError(FrameSizeError, "invalid RST_STREAM frame");
+      }
+      finishStream(streamId);
+      return true;
+
+    case FrameSettings:
+      return processSettings(flags, streamId, payload, length);
+
+    case FramePushPromise:
+      return connectionError(ProtocolError, "PUSH_PROMISE from client");
+
+    case FramePing:
+      if (streamId != 0) {
+        return connectionError(ProtocolError, "PING on stream");
+      }
+      if (length != 8) {
+        return connectionError(FrameSizeError, "invalid PING frame");
+      }
+      if ((flags & FlagAck) == 0) {
+        sendFrame(FramePing, FlagAck, 0, payload, length);
+      }
+      return true;
+
+    case FrameGoAway:
+      if (streamId != 0) {
+        return connectionError(ProtocolError, "GOAWAY on stream");
+      }
+      LOG_TOPIC(DEBUG, Logger::COMMUNICATION)
+          << "HTTP/2 client closes the connection";
+      // the running streams are completed
+      _goAwayReceived = true;
+      closeIfIdle();
+      return !_closeRequested;
+
+    case FrameWindowUpdate:
+      return processWindowUpdate(streamId, payload, length);
+
+    case FrameContinuation:
+      if (_headerStreamId == 0 || streamId != _headerStreamId) {
+        return connectionError(ProtocolError, "unexpected CONTINUATION frame");
+      }
+      if (_headerBlock.size() + length > HttpCommTask::MaximalHeaderSize) {
+        return connectionError(CompressionError, "header block too large");
+      }
+      _headerBlock.append(payload, length);
+      if (flags & FlagEndHeaders) {
+        return processHeaderBlock(startTime);
+      }
+      return true;
+
+    default:
+      // unknown frame types must be ignored
+      return true;
+  }
+}
+
+bool H2CommTask::processHeaders(uint8_t flags, uint32_t streamId,
+                                char const* payload, size_t length,
+                                double startTime) {
+  if (streamId == 0) {
+    return connectionError(ProtocolError, "HEADERS on stream 0");
+  }
+  if (!stripPadding(flags, payload, length)) {
+    return connectionError(ProtocolError, "invalid padding");
+  }
+  if (flags & FlagPriority) {
+    if (length < 5) {
+      return connectionError(FrameSizeError, "invalid HEADERS frame");
+    }
+    payload += 5;
+    length -= 5;
+  }
+
+  _headerBlock.assign(payload, length);
+  _headerStreamId = streamId;
+  _headerEndStream = (flags & FlagEndStream) != 0;
+
+  if (flags & FlagEndHeaders) {
+    return processHeaderBlock(startTime);
+  }
+  return true;
+}
+
+bool H2CommTask::processHeaderBlock(double startTime) {
+  uint32_t const streamId = _headerStreamId;
+  bool const endStream = _headerEndStream;
+  _headerStreamId = 0;
+
+  // the block must be decoded even if the stream is refused, to keep the
+  // dynamic table of the decoder in sync with the client
+  HpackDecoder::HeaderList headers;
+  bool const valid = _decoder.decode(
+      reinterpret_cast<uint8_t const*>(_headerBlock.data()),
+      _headerBlock.size(), HttpCommTask::MaximalHeaderSize, headers);
+  _headerBlock.clear();
+
+  if (!valid) {
+    return connectionError(CompressionError, "invalid header block");
+  }
+
+  auto it = _streams.find(streamId);
+
+  if (it != _streams.end()) {
+    // trailers, they are ignored but must end the request
+    Stream& stream = it->second;
+    if (!endStream || stream.endStream) {
+      sendResetStream(streamId, ProtocolError);
+      finishStream(streamId);
+      return true;
+    }
+    stream.endStream = true;
+    if (!stream.executing) {
+      processRequest(streamId, stream);
+    }
+    return true;
+  }
+
+  if ((streamId & 1) == 0 || streamId <= _lastStreamId) {
+    return connectionError(ProtocolError, "invalid stream id");
+  }
+  _lastStreamId = streamId;
+
+  if (_goAwayReceived || _streams.size() >= MaxConcurrentStreams) {
+    sendResetStream(streamId, RefusedStream);
+    return true;
+  }
+
+  Stream& stream =
+      _streams.emplace(streamId, Stream(_initialSendWindow)).first->second;
+  stream.headers = std::move(headers);
+  stream.endStream = endStream;
+
+  RequestStatistics* stat = acquireStatistics(streamId);
+  RequestStatistics::SET_READ_START(stat, startTime);
+
+  if (endStream) {
+    processRequest(streamId, stream);
+  }
+  return true;
+}
+
+bool H2CommTask::processData(uint8_t flags, uint32_t streamId,
+                             char const* payload, size_t length) {
+  if (streamId == 0 || streamId > _lastStreamId) {
+    return connectionError(ProtocolError, "DATA on idle stream");
+  }
+
+  // flow control counts the complete frame, including the padding
+  uint32_t const consumed = static_cast<uint32_t>(length);
+  _receiveConsumed += consumed;
+  if (_receiveConsumed >= ReceiveWindowSize / 2) {
+    sendWindowUpdate(0, _receiveConsumed);
+    _receiveConsumed = 0;
+  }
+
+  if (!stripPadding(flags, payload, length)) {
+    return connectionError(ProtocolError, "invalid padding");
+  }
+
+  auto it = _streams.find(streamId);
+
+  if (it == _streams.end()) {
+    // the stream was reset or answered already
+    return true;
+  }
+
+  Stream& stream = it->second;
+
+  if (stream.endStream) {
+    sendResetStream(streamId, StreamClosed);
+    finishStream(streamId);
+    return true;
+  }
+
+  if (stream.body.size() + length > HttpCommTask::MaximalBodySize) {
+    LOG_TOPIC(WARN, Logger::REQUESTS)
+        << "maximal body size is " << HttpCommTask::MaximalBodySize
+        << ", request body size is at least " << stream.body.size() + length;
+
+    // the response resets the incomplete stream
+    addSimpleResponse(rest::ResponseCode::REQUEST_ENTITY_TOO_LARGE,
+                      rest::ContentType::UNSET, streamId,
+                      VPackBuffer<uint8_t>());
+    return true;
+  }
+
+  stream.body.append(payload, length);
+
+  if (flags & FlagEndStream) {
+    stream.endStream = true;
+    processRequest(streamId, stream);
+    return true;
+  }
+
+  stream.receiveConsumed += consumed;
+  if (stream.receiveConsumed >= ReceiveWindowSize / 2) {
+    sendWindowUpdate(streamId, stream.receiveConsumed);
+    stream.receiveConsumed = 0;
+  }
+  return true;
+}
+
+bool H2CommTask::processSettings(uint8_t flags, uint32_t streamId,
+                                 char const* payload, size_t length) {
+  if (streamId != 0) {
+    return connectionError(ProtocolError, "SETTINGS on stream");
+  }
+
+  if (flags & FlagAck) {
+    if (length != 0) {
+      return connectionError(FrameSizeError, "invalid SETTINGS frame");
+    }
+    return true;
+  }
+
+  if (length % 6 != 0) {
+    return connectionError(FrameSizeError, "invalid SETTINGS frame");
+  }
+
+  for (size_t i = 0; i < length; i += 6) {
+    uint16_t const id = static_cast<uint16_t>(
+        (uint16_t(static_cast<uint8_t>(payload[i])) << 8) |
+        static_cast<uint8_t>(payload[i + 1]));
+    uint32_t const value = readUInt32(payload + i + 2);
+
+    switch (id) {
+      case SettingsEnablePush:
+        if (value > 1) {
+          return connectionError(ProtocolError, "invalid SETTINGS_ENABLE_PUSH");
+        }
+        break;
+
+      case SettingsInitialWindowSize: {
+        if (value > MaxWindowSize) {
+          return connectionError(FlowControlError,
+                                 "invalid SETTINGS_INITIAL_WINDOW_SIZE");
+        }
+        // the change applies to the windows of all open streams
+        int64_t const delta = static_cast<int64_t>(value) - _initialSendWindow;
+        for (auto& it : _streams) {
+          Stream& stream = it.second;
+          stream.sendWindow += delta;
+          if (stream.sendWindow > MaxWindowSize) {
+            return connectionError(FlowControlError, "stream window too large");
+          }
+          if (stream.response != nullptr && !stream.queued &&
+              stream.sendWindow > 0) {
+            stream.queued = true;
+            _sendQueue.push_back(it.first);
+          }
+        }
+        _initialSendWindow = value;
+        break;
+      }
+
+      case SettingsMaxFrameSize:
+        if (value < MaxReceiveFrameSize || value > 0xffffff) {
+          return connectionError(ProtocolError,
+                                 "invalid SETTINGS_MAX_FRAME_SIZE");
+        }
+        _maxSendFrameSize = value;
+        break;
+
+      default:
+        // the header table of the client is never used, we do not index
+        break;
+    }
+  }
+
+  sendFrame(FrameSettings, FlagAck, 0, nullptr, 0);
+  flushData();
+  return true;
+}
+
+bool H2CommTask::processWindowUpdate(uint32_t streamId, char const* payload,
+                                     size_t length) {
+  if (length != 4) {
+    return connectionError(FrameSizeError, "invalid WINDOW_UPDATE frame");
+  }
+
+  uint32_t const increment = readUInt32(payload) & 0x7fffffff;
+
+  if (streamId == 0) {
+    if (increment == 0) {
+      return connectionError(ProtocolError, "invalid window increment");
+    }
+    _sendWindow += increment;
+    if (_sendWindow > MaxWindowSize) {
+      return connectionError(FlowControlError, "connection window too large");
+    }
+  } else {
+    auto it = _streams.find(streamId);
+
+    if (it == _streams.end()) {
+      return true;
+    }
+
+    Stream& stream = it->second;
+
+    if (increment == 0 || stream.sendWindow + increment > MaxWindowSize) {
+      sendResetStream(streamId,
+                      increment == 0 ? ProtocolError : FlowControlError);
+      finishStream(streamId);
+      return true;
+    }
+
+    stream.sendWindow += increment;
+    if (stream.response != nullptr && !stream.queued &&
+        stream.sendWindow > 0) {
+      stream.queued = true;
+      _sendQueue.push_back(streamId);
+    }
+  }
+
+  flushData();
+  return true;
+}
+
+void H2CommTask::processRequest(uint32_t streamId, Stream& stream) {
+  TRI_ASSERT(_peer->runningInThisThread());
+
+  stream.executing = true;
+  RequestStatistics::SET_READ_END(statistics(streamId));
+
+  // the request is handed to the HTTP/1.1 header parser, so that it is
+  // treated exactly like a request of an HttpCommTask
+  std::string method;
+  std::string path;
+  std::string authority;
+  std::string header;
+  bool valid = true;
+
+  for (auto const& it : stream.headers) {
+    std::string const& name = it.first;
+    std::string const& value = it.second;
+
+    if (!isValidField(name) || !isValidField(value)) {
+      valid = false;
+      break;
+    }
+
+    if (!name.empty() && name[0] == ':') {
+      if (name == ":method") {
+        method = value;
+      } else if (name == ":path") {
+        path = value;
+      } else if (name == ":authority") {
+        authority = value;
+      } else if (name != ":scheme") {
+        valid = false;
+        break;
+      }
+      continue;
+    }
+
+    if (name == StaticStrings::ContentLength) {
+      // taken from the received body
+      continue;
+    }
+
+    header.append(name).append(": ").append(value).append("\r\n");
+  }
+
+  HpackDecoder::HeaderList().swap(stream.headers);
+
+  if (!valid || method.empty() || path.empty() ||
+      method.find(' ') != std::string::npos ||
+      path.find(' ') != std::string::npos) {
+    addSimpleResponse(rest::ResponseCode::BAD, rest::ContentType::UNSET,
+                      streamId, VPackBuffer<uint8_t>());
+    return;
+  }
+
+  std::string text;
+  text.reserve(method.size() + path.size() + authority.size() +
+               header.size() + 64);
+  text.append(method).append(" ").append(path).append(" HTTP/1.1\r\n");
+  if (!authority.empty()) {
+    text.append("host: ").append(authority).append("\r\n");
+  }
+  text.append(header);
+  if (!stream.body.empty()) {
+    text.append("content-length: ")
+        .append(std::to_string(stream.body.size()))
+        .append("\r\n");
+  }
+  text.append("\r\n");
+
+  std::unique_ptr<HttpRequest> request(new HttpRequest(
+      _connectionInfo, text.c_str(), text.size(), _allowMethodOverride));
+  request->setClientTaskId(_taskId);
+  request->setMessageId(streamId);
+  request->setProtocol(_protocol);
+
+  if (!stream.body.empty()) {
+    if (request->header(StaticStrings::ContentEncoding) ==
+        PayloadCompression::ENCODING) {
+      std::string uncompressed;
+      if (!PayloadCompression::uncompress(stream.body.c_str(),
+                                          stream.body.size(), uncompressed)) {
+        addSimpleResponse(rest::ResponseCode::BAD, rest::ContentType::UNSET,
+                          streamId, VPackBuffer<uint8_t>());
+        return;
+      }
+      stream.body.swap(uncompressed);
+    }
+    request->setBody(stream.body.c_str(), stream.body.size());
+    std::string().swap(stream.body);
+  }
+
+  stream.headRequest = request->requestType() == rest::RequestType::HEAD;
+
+  LOG_TOPIC(DEBUG, Logger::REQUESTS)
+      << "\"h2-request-begin\",\"" << (void*)this << "\"," << streamId
+      << ",\"" << _connectionInfo.clientAddress << "\",\""
+      << HttpRequest::translateMethod(request->requestType()) << "\",\""
+      << request->fullUrl() << "\"";
+
+  // the stream must not be used from here on, the response may already be
+  // sent and the stream gone when prepareExecution returns
+
+  // first scrape the auth headers and try to determine and authenticate the user
+  rest::ResponseCode authResult = handleAuthHeader(request.get());
+
+  // authenticated
+  if (authResult != rest::ResponseCode::SERVER_ERROR) {
+    // prepare execution will send an error message
+    RequestFlow cont = prepareExecution(*request.get());
+    if (cont == RequestFlow::Continue) {
+      auto resp = std::make_unique<HttpResponse>(
+          rest::ResponseCode::SERVER_ERROR, leaseStringBuffer(1024));
+      resp->setMessageId(streamId);
+      resp->setContentType(request->contentTypeResponse());
+      resp->setContentTypeRequested(request->contentTypeResponse());
+
+      executeRequest(std::move(request), std::move(resp));
+    }
+  } else {
+    std::string realm = "Bearer token_type=\"JWT\", realm=\"ArangoDB\"";
+    HttpResponse resp(rest::ResponseCode::UNAUTHORIZED, leaseStringBuffer(0));
+    resp.setMessageId(streamId);
+    resp.setHeaderNC(StaticStrings::WwwAuthenticate, std::move(realm));
+    addResponse(resp, stealStatistics(streamId));
+  }
+}
+
+std::unique_ptr<GeneralResponse> H2CommTask::createResponse(
+    rest::ResponseCode responseCode, uint64_t messageId) {
+  std::unique_ptr<HttpResponse> response(
+      new HttpResponse(responseCode, leaseStringBuffer(0)));
+  response->setMessageId(messageId);
+  return std::unique_ptr<GeneralResponse>(std::move(response));
+}
+
+/// @brief send error response including response body
+void H2CommTask::addSimpleResponse(rest::ResponseCode code,
+                                   rest::ContentType respType,
+                                   uint64_t messageId,
+                                   velocypack::Buffer<uint8_t>&& buffer) {
+  try {
+    HttpResponse resp(code, leaseStringBuffer(buffer.size()));
+    resp.setMessageId(messageId);
+    resp.setContentType(respType);
+    if (!buffer.empty()) {
+      resp.setPayload(std::move(buffer), true, VPackOptions::Defaults);
+    }
+    addResponse(resp, stealStatistics(messageId));
+  } catch (std::exception const& ex) {
+    LOG_TOPIC(WARN, Logger::COMMUNICATION)
+        << "addSimpleResponse received an exception, closing connection:"
+        << ex.what();
+    _closeRequested = true;
+  } catch (...) {
+    LOG_TOPIC(WARN, Logger::COMMUNICATION)
+        << "addSimpleResponse received an exception, closing connection";
+    _closeRequested = true;
+  }
+}
+
+void H2CommTask::addResponse(GeneralResponse& baseResponse,
+                             RequestStatistics* stat) {
+  TRI_ASSERT(_peer->runningInThisThread());
+
+#ifdef ARANGODB_ENABLE_MAINTAINER_MODE
+  HttpResponse& response = dynamic_cast<HttpResponse&>(baseResponse);
+#else
+  HttpResponse& response = static_cast<HttpResponse&>(baseResponse);
+#endif
+
+  finishExecution(baseResponse);
+  resetKeepAlive();
+
+  uint32_t const streamId = static_cast<uint32_t>(response.messageId());
+  auto it = _streams.find(streamId);
+
+  if (it == _streams.end() || it->second.response != nullptr) {
+    // the client has reset the stream in the meantime
+    if (stat != nullptr) {
+      stat->release();
+    }
+    return;
+  }
+
+  Stream& stream = it->second;
+
+  response.setHeaderNCIfNotSet(StaticStrings::XContentTypeOptions,
+                               StaticStrings::NoSniff);
+
+  size_t const responseBodyLength = response.bodySize();
+
+  if (stream.headRequest) {
+    // HEAD must not return a body
+    response.headResponse(responseBodyLength);
+  }
+
+  bool const hasBody = !stream.headRequest && responseBodyLength > 0;
+
+  // header block
+  StringBuffer block(256, false);
+  HpackEncoder::addStatus(block, static_cast<int>(response.responseCode()));
+
+  bool seenServerHeader = false;
+  for (auto const& it : response.headers()) {
+    std::string const name = StringUtils::tolower(it.first);
+    if (name == StaticStrings::ContentLength || isConnectionHeader(name)) {
+      continue;
+    }
+    if (name == StaticStrings::Server) {
+      seenServerHeader = true;
+    }
+    HpackEncoder::add(block, name, it.second);
+  }
+
+  if (!seenServerHeader && !HttpResponse::HIDE_PRODUCT_HEADER) {
+    HpackEncoder::add(block, StaticStrings::Server, "ArangoDB");
+  }
+
+  char const* contentType = contentTypeValue(response._contentType);
+  if (contentType != nullptr) {
+    HpackEncoder::add(block, StaticStrings::ContentTypeHeader, contentType);
+  }
+
+  for (auto const& cookie : response._cookies) {
+    HpackEncoder::add(block, "set-cookie", cookie);
+  }
+
+  HpackEncoder::add(block, StaticStrings::ContentLength,
+                    std::to_string(responseBodyLength));
+
+  // HEADERS frame, followed by CONTINUATION frames for large blocks
+  StringBuffer* frames = leaseStringBuffer(
+      block.length() +
+      FrameHeaderLength * (1 + block.length() / _maxSendFrameSize));
+  size_t offset = 0;
+
+  do {
+    size_t const n = (std::min)(block.length() - offset, _maxSendFrameSize);
+    uint8_t flags = (offset + n == block.length()) ? FlagEndHeaders : 0;
+    if (offset == 0 && !hasBody) {
+      flags |= FlagEndStream;
+    }
+    appendFrameHeader(*frames, n, offset == 0 ? FrameHeaders : FrameContinuation,
+                      flags, streamId);
+    frames->appendText(block.c_str() + offset, n);
+    offset += n;
+  } while (offset < block.length());
+
+  double const totalTime = RequestStatistics::ELAPSED_SINCE_READ_START(stat);
+
+  LOG_TOPIC(INFO, Logger::REQUESTS)
+      << "\"h2-request-end\",\"" << (void*)this << "\"," << streamId << ",\""
+      << _connectionInfo.clientAddress << "\","
+      << static_cast<int>(response.responseCode()) << ","
+      << responseBodyLength << "," << Logger::FIXED(totalTime, 6);
+
+  if (hasBody) {
+    addWriteBuffer(WriteBuffer(frames, nullptr));
+
+    // the body is sent in DATA frames as the windows allow
+    stream.response = response.stealBody();
+    stream.responseOffset = 0;
+    stream.statistics = stat;
+    if (!stream.queued) {
+      stream.queued = true;
+      _sendQueue.push_back(streamId);
+    }
+    flushData();
+    return;
+  }
+
+  addWriteBuffer(WriteBuffer(frames, stat));
+
+  if (!stream.endStream) {
+    // the request body is not needed anymore
+    sendResetStream(streamId, NoError);
+  }
+  finishStream(streamId);
+
+  std::unique_ptr<basics::StringBuffer> body = response.stealBody();
+  if (body != nullptr) {
+    returnStringBuffer(body.release());  // takes care of deleting
+  }
+}
+
+void H2CommTask::flushData() {
+  // each stream sends at most a few frames per turn, so that the
+  // connection window is shared between the streams
+  size_t const quantum = 4 * _maxSendFrameSize;
+
+  while (!_sendQueue.empty() && _sendWindow > 0) {
+    uint32_t const streamId = _sendQueue.front();
+    _sendQueue.pop_front();
+
+    auto it = _streams.find(streamId);
+
+    if (it == _streams.end() || it->second.response == nullptr) {
+      continue;
+    }
+
+    Stream& stream = it->second;
+    stream.queued = false;
+
+    size_t const total = stream.response->length();
+    // a stream window can become negative by a SETTINGS frame
+    int64_t const window = (std::min)(_sendWindow, stream.sendWindow);
+    size_t const available = window > 0 ? static_cast<size_t>(window) : 0;
+    size_t const turn =
+        (std::min)((std::min)(total - stream.responseOffset, available),
+                   quantum);
+
+    if (turn > 0) {
+      StringBuffer* frames = leaseStringBuffer(
+          turn + FrameHeaderLength * (1 + turn / _maxSendFrameSize));
+      size_t const end = stream.responseOffset + turn;
+
+      while (stream.responseOffset < end) {
+        size_t const n =
+            (std::min)(end - stream.responseOffset, _maxSendFrameSize);
+        bool const last = stream.responseOffset + n == total;
+        appendFrameHeader(*frames, n, FrameData, last ? FlagEndStream : 0,
+                          streamId);
+        frames->appendText(stream.response->c_str() + stream.responseOffset,
+                           n);
+        stream.responseOffset += n;
+      }
+
+      _sendWindow -= turn;
+      stream.sendWindow -= turn;
+
+      if (stream.responseOffset == total) {
+        RequestStatistics* stat = stream.statistics;
+        stream.statistics = nullptr;
+        addWriteBuffer(WriteBuffer(frames, stat));
+
+        if (!stream.endStream) {
+          sendResetStream(streamId, NoError);
+        }
+        finishStream(streamId);
+        continue;
+      }
+
+      addWriteBuffer(WriteBuffer(frames, nullptr));
+    }
+
+    // otherwise the stream waits for a WINDOW_UPDATE
+    if (stream.sendWindow > 0) {
+      stream.queued = true;
+      _sendQueue.push_back(streamId);
+    }
+  }
+}
+
+void H2CommTask::finishStream(uint32_t streamId) {
+  auto it = _streams.find(streamId);
+
+  if (it != _streams.end()) {
+    releaseStream(streamId, it->second);
+    _streams.erase(it);
+  }
+
+  closeIfIdle();
+}
+
+void H2CommTask::releaseStream(uint32_t streamId, Stream& stream) {
+  if (stream.statistics != nullptr) {
+    stream.statistics->release();
+    stream.statistics = nullptr;
+  }
+
+  if (!stream.executing) {
+    // the statistics are still registered for the stream
+    RequestStatistics* stat = stealStatistics(streamId);
+    if (stat != nullptr) {
+      stat->release();
+    }
+  }
+
+  if (stream.response != nullptr) {
+    returnStringBuffer(stream.response.release());
+  }
+}
+
+void H2CommTask::closeIfIdle() {
+  if (!_goAwayReceived || !_streams.empty()) {
+    return;
+  }
+
+  // the connection is closed once the pending frames are written
+  _closeRequested = true;
+}
+
+void H2CommTask::sendFrame(uint8_t type, uint8_t flags, uint32_t streamId,
+                           char const* payload, size_t length,
+                           RequestStatistics* stat) {
+  StringBuffer* buffer = leaseStringBuffer(FrameHeaderLength + length);
+  appendFrameHeader(*buffer, length, type, flags, streamId);
+  if (length > 0) {
+    buffer->appendText(payload, length);
+  }
+  addWriteBuffer(WriteBuffer(buffer, stat));
+}
+
+void H2CommTask::sendSettings() {
+  std::string payload;
+  appendSetting(payload, SettingsMaxConcurrentStreams,
+                static_cast<uint32_t>(MaxConcurrentStreams));
+  appendSetting(payload, SettingsInitialWindowSize, ReceiveWindowSize);
+  appendSetting(payload, SettingsMaxHeaderListSize,
+                static_cast<uint32_t>(HttpCommTask::MaximalHeaderSize));
+  sendFrame(FrameSettings, 0, 0, payload.data(), payload.size());
+
+  // the connection window starts with the default size
+  sendWindowUpdate(0, ReceiveWindowSize - DefaultWindowSize);
+}
+
+void H2CommTask::sendWindowUpdate(uint32_t streamId, uint32_t increment) {
+  char payload[4];
+  writeUInt32(payload, increment & 0x7fffffff);
+  sendFrame(FrameWindowUpdate, 0, streamId, payload, sizeof(payload));
+}
+
+void H2CommTask::sendResetStream(uint32_t streamId, uint32_t error) {
+  char payload[4];
+  writeUInt32(payload, error);
+  sendFrame(FrameResetStream, 0, streamId, payload, sizeof(payload));
+}
+
+bool H2CommTask::connectionError(uint32_t error, char const* message) {
+  LOG_TOPIC(DEBUG, Logger::COMMUNICATION)
+      << "HTTP/2 connection error: " << message;
+
+  char payload[8];
+  writeUInt32(payload, _lastStreamId);
+  writeUInt32(payload + 4, error);
+  sendFrame(FrameGoAway, 0, 0, payload, sizeof(payload));
+
+  // close the connection once the GOAWAY is sent
+  _closeRequested = true;
+  return false;
+}
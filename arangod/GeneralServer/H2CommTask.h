@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_GENERAL_SERVER_H2_COMM_TASK_H
+#define ARANGOD_GENERAL_SERVER_H2_COMM_TASK_H 1
+
+#include "Basics/Common.h"
+#include "GeneralServer/GeneralCommTask.h"
+#include "GeneralServer/Hpack.h"
+#include "Rest/HttpResponse.h"
+
+#include <deque>
+
+namespace arangodb {
+class HttpRequest;
+
+namespace rest {
+
+/// @brief HTTP/2 connection (RFC 7540). the client starts the connection
+/// with the HTTP/2 preface on an HTTP endpoint (prior knowledge, h2c). the
+/// requests of the streams are executed concurrently, using the stream id
+/// as message id, and their responses are sent as soon as they are ready,
+/// within the flow control windows of the client
+class H2CommTask final : public GeneralCommTask {
+ public:
+  static size_t const MaxConcurrentStreams;
+  static uint32_t const ReceiveWindowSize;
+
+ public:
+  H2CommTask(Scheduler*, GeneralServer*, std::unique_ptr<Socket> socket,
+             ConnectionInfo&&, double timeout, bool skipSocketInit = false);
+
+  ~H2CommTask();
+
+  arangodb::Endpoint::TransportType transportType() override {
+    return arangodb::Endpoint::TransportType::HTTP;
+  }
+
+ private:
+  bool processRead(double startTime) override;
+  void compactify() override;
+
+  std::unique_ptr<GeneralResponse> createResponse(
+      rest::ResponseCode, uint64_t messageId) override final;
+
+  void addResponse(GeneralResponse& response,
+                   RequestStatistics* stat) override;
+
+  /// @brief send error response including response body
+  void addSimpleResponse(rest::ResponseCode, rest::ContentType,
+                         uint64_t messageId,
+                         velocypack::Buffer<uint8_t>&&) override;
+
+  // streams are multiplexed, a handler must not block the connection
+  bool allowDirectHandling() const override final { return false; }
+
+ private:
+  struct Stream {
+    explicit Stream(int64_t window)
+        : sendWindow(window),
+          receiveConsumed(0),
+          endStream(false),
+          executing(false),
+          headRequest(false),
+          queued(false),
+          responseOffset(0),
+          statistics(nullptr) {}
+
+    HpackDecoder::HeaderList headers;
+    std::string body;
+    int64_t sendWindow;
+    uint32_t receiveConsumed;  // received bytes not yet granted again
+    bool endStream;            // the client has sent the complete request
+    bool executing;            // the request was handed to a handler
+    bool headRequest;
+    bool queued;               // in _sendQueue
+
+    // the body of the response, as far as it was not sent yet
+    std::unique_ptr<basics::StringBuffer> response;
+    size_t responseOffset;
+    RequestStatistics* statistics;
+  };
+
+  bool processFrame(uint8_t type, uint8_t flags, uint32_t streamId,
+                    char const* payload, size_t length, double startTime);
+  bool processHeaders(uint8_t flags, uint32_t streamId, char const* payload,
+                      size_t length, double startTime);
+  bool processHeaderBlock(double startTime);
+  bool processData(uint8_t flags, uint32_t streamId, char const* payload,
+                   size_t length);
+  bool processSettings(uint8_t flags, uint32_t streamId, char const* payload,
+                       size_t length);
+  bool processWindowUpdate(uint32_t streamId, char const* payload,
+                           size_t length);
+
+  void processRequest(uint32_t streamId, Stream& stream);
+
+  void sendFrame(uint8_t type, uint8_t flags, uint32_t streamId,
+                 char const* payload, size_t length,
+                 RequestStatistics* stat = nullptr);
+  void sendSettings();
+  void sendWindowUpdate(uint32_t streamId, uint32_t increment);
+  void sendResetStream(uint32_t streamId, uint32_t error);
+  bool connectionError(uint32_t error, char const* message);
+
+  // sends pending response data as far as the flow control windows allow
+  void flushData();
+  void finishStream(uint32_t streamId);
+  void releaseStream(uint32_t streamId, Stream& stream);
+  // closes the connection after a GOAWAY when all streams are done
+  void closeIfIdle();
+
+ private:
+  HpackDecoder _decoder;
+  std::unordered_map<uint32_t, Stream> _streams;
+  // streams having response data to send
+  std::deque<uint32_t> _sendQueue;
+
+  size_t _readPosition;
+  bool _prefaceReceived;
+  bool _goAwayReceived;
+  bool const _allowMethodOverride;
+  uint32_t _lastStreamId;
+
+  // the header block currently received in HEADERS and CONTINUATION frames
+  std::string _headerBlock;
+  uint32_t _headerStreamId;  // 0 if no header block is pending
+  bool _headerEndStream;
+
+  int64_t _sendWindow;         // connection send window
+  int64_t _initialSendWindow;  // SETTINGS_INITIAL_WINDOW_SIZE of the client
+  size_t _maxSendFrameSize;    // SETTINGS_MAX_FRAME_SIZE of the client
+  uint32_t _receiveConsumed;   // connection bytes not yet granted again
+};
+}  // namespace rest
+}  // namespace arangodb
+
+#endif
@@ -0,0 +1,484 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "Hpack.h"
+
+#include "Basics/StringBuffer.h"
+
+#include <array>
+
+using namespace arangodb;
+using namespace arangodb::basics;
+using namespace arangodb::rest;
+
+namespace {
+
+struct StaticField {
+  char const* name;
+  char const* value;
+};
+
+// the static table of RFC 7541, appendix A. its indexes start at 1
+StaticField const StaticTable[] = {
+    {":authority", ""},
+    {":method", "GET"},
+    {":method", "POST"},
+    {":path", "/"},
+    {":path", "/index.html"},
+    {":scheme", "http"},
+    {":scheme", "https"},
+    {":status", "200"},
+    {":status", "204"},
+    {":status", "206"},
+    {":status", "304"},
+    {":status", "400"},
+    {":status", "404"},
+    {":status", "500"},
+    {"accept-charset", ""},
+    {"accept-encoding", "gzip, deflate"},
+    {"accept-language", ""},
+    {"accept-ranges", ""},
+    {"accept", ""},
+    {"access-control-allow-origin", ""},
+    {"age", ""},
+    {"allow", ""},
+    {"authorization", ""},
+    {"cache-control", ""},
+    {"content-disposition", ""},
+    {"content-encoding", ""},
+    {"content-language", ""},
+    {"content-length", ""},
+    {"content-location", ""},
+    {"content-range", ""},
+    {"content-type", ""},
+    {"cookie", ""},
+    {"date", ""},
+    {"etag", ""},
+    {"expect", ""},
+    {"expires", ""},
+    {"from", ""},
+    {"host", ""},
+    {"if-match", ""},
+    {"if-modified-since", ""},
+    {"if-none-match", ""},
+    {"if-range", ""},
+    {"if-unmodified-since", ""},
+    {"last-modified", ""},
+    {"link", ""},
+    {"location", ""},
+    {"max-forwards", ""},
+    {"proxy-authenticate", ""},
+    {"proxy-authorization", ""},
+    {"range", ""},
+    {"referer", ""},
+    {"refresh", ""},
+    {"retry-after", ""},
+    {"server", ""},
+    {"set-cookie", ""},
+    {"strict-transport-security", ""},
+    {"transfer-encoding", ""},
+    {"user-agent", ""},
+    {"vary", ""},
+    {"via", ""},
+    {"www-authenticate", ""},
+};
+
+size_t const StaticTableSize = sizeof(StaticTable) / sizeof(StaticTable[0]);
+
+// the overhead of an entry in the dynamic table, RFC 7541, section 4.1
+size_t const EntryOverhead = 32;
+
+struct HuffmanCode {
+  uint32_t code;
+  uint8_t bits;
+};
+
+// the Huffman code of RFC 7541, appendix B. entry 256 is EOS
+HuffmanCode const HuffmanCodes[257] = {
+    {0x1ff8, 13}, {0x7fffd8, 23}, {0xfffffe2, 28}, {0xfffffe3, 28},
+    {0xfffffe4, 28}, {0xfffffe5, 28}, {0xfffffe6, 28}, {0xfffffe7, 28},
+    {0xfffffe8, 28}, {0xffffea, 24}, {0x3ffffffc, 30}, {0xfffffe9, 28},
+    {0xfffffea, 28}, {0x3ffffffd, 30}, {0xfffffeb, 28}, {0xfffffec, 28},
+    {0xfffffed, 28}, {0xfffffee, 28}, {0xfffffef, 28}, {0xffffff0, 28},
+    {0xffffff1, 28}, {0xffffff2, 28}, {0x3ffffffe, 30}, {0xffffff3, 28},
+    {0xffffff4, 28}, {0xffffff5, 28}, {0xffffff6, 28}, {0xffffff7, 28},
+    {0xffffff8, 28}, {0xffffff9, 28}, {0xffffffa, 28}, {0xffffffb, 28},
+    {0x14, 6}, {0x3f8, 10}, {0x3f9, 10}, {0xffa, 12},
+    {0x1ff9, 13}, {0x15, 6}, {0xf8, 8}, {0x7fa, 11},
+    {0x3fa, 10}, {0x3fb, 10}, {0xf9, 8}, {0x7fb, 11},
+    {0xfa, 8}, {0x16, 6}, {0x17, 6}, {0x18, 6},
+    {0x0, 5}, {0x1, 5}, {0x2, 5}, {0x19, 6},
+    {0x1a, 6}, {0x1b, 6}, {0x1c, 6}, {0x1d, 6},
+    {0x1e, 6}, {0x1f, 6}, {0x5c, 7}, {0xfb, 8},
+    {0x7ffc, 15}, {0x20, 6}, {0xffb, 12}, {0x3fc, 10},
+    {0x1ffa, 13}, {0x21, 6}, {0x5d, 7}, {0x5e, 7},
+    {0x5f, 7}, {0x60, 7}, {0x61, 7}, {0x62, 7},
+    {0x63, 7}, {0x64, 7}, {0x65, 7}, {0x66, 7},
+    {0x67, 7}, {0x68, 7}, {0x69, 7}, {0x6a, 7},
+    {0x6b, 7}, {0x6c, 7}, {0x6d, 7}, {0x6e, 7},
+    {0x6f, 7}, {0x70, 7}, {0x71, 7}, {0x72, 7},
+    {0xfc, 8}, {0x73, 7}, {0xfd, 8}, {0x1ffb, 13},
+    {0x7fff0, 19}, {0x1ffc, 13}, {0x3ffc, 14}, {0x22, 6},
+    {0x7ffd, 15}, {0x3, 5}, {0x23, 6}, {0x4, 5},
+    {0x24, 6}, {0x5, 5}, {0x25, 6}, {0x26, 6},
+    {0x27, 6}, {0x6, 5}, {0x74, 7}, {0x75, 7},
+    {0x28, 6}, {0x29, 6}, {0x2a, 6}, {0x7, 5},
+    {0x2b, 6}, {0x76, 7}, {0x2c, 6}, {0x8, 5},
+    {0x9, 5}, {0x2d, 6}, {0x77, 7}, {0x78, 7},
+    {0x79, 7}, {0x7a, 7}, {0x7b, 7}, {0x7ffe, 15},
+    {0x7fc, 11}, {0x3ffd, 14}, {0x1ffd, 13}, {0xffffffc, 28},
+    {0xfffe6, 20}, {0x3fffd2, 22}, {0xfffe7, 20}, {0xfffe8, 20},
+    {0x3fffd3, 22}, {0x3fffd4, 22}, {0x3fffd5, 22}, {0x7fffd9, 23},
+    {0x3fffd6, 22}, {0x7fffda, 23}, {0x7fffdb, 23}, {0x7fffdc, 23},
+    {0x7fffdd, 23}, {0x7fffde, 23}, {0xffffeb, 24}, {0x7fffdf, 23},
+    {0xffffec, 24}, {0xffffed, 24}, {0x3fffd7, 22}, {0x7fffe0, 23},
+    {0xffffee, 24}, {0x7fffe1, 23}, {0x7fffe2, 23}, {0x7fffe3, 23},
+    {0x7fffe4, 23}, {0x1fffdc, 21}, {0x3fffd8, 22}, {0x7fffe5, 23},
+    {0x3fffd9, 22}, {0x7fffe6, 23}, {0x7fffe7, 23}, {0xffffef, 24},
+    {0x3fffda, 22}, {0x1fffdd, 21}, {0xfffe9, 20}, {0x3fffdb, 22},
+    {0x3fffdc, 22}, {0x7fffe8, 23}, {0x7fffe9, 23}, {0x1fffde, 21},
+    {0x7fffea, 23}, {0x3fffdd, 22}, {0x3fffde, 22}, {0xfffff0, 24},
+    {0x1fffdf, 21}, {0x3fffdf, 22}, {0x7fffeb, 23}, {0x7fffec, 23},
+    {0x1fffe0, 21}, {0x1fffe1, 21}, {0x3fffe0, 22}, {0x1fffe2, 21},
+    {0x7fffed, 23}, {0x3fffe1, 22}, {0x7fffee, 23}, {0x7fffef, 23},
+    {0xfffea, 20}, {0x3fffe2, 22}, {0x3fffe3, 22}, {0x3fffe4, 22},
+    {0x7ffff0, 23}, {0x3fffe5, 22}, {0x3fffe6, 22}, {0x7ffff1, 23},
+    {0x3ffffe0, 26}, {0x3ffffe1, 26}, {0xfffeb, 20}, {0x7fff1, 19},
+    {0x3fffe7, 22}, {0x7ffff2, 23}, {0x3fffe8, 22}, {0x1ffffec, 25},
+    {0x3ffffe2, 26}, {0x3ffffe3, 26}, {0x3ffffe4, 26}, {0x7ffffde, 27},
+    {0x7ffffdf, 27}, {0x3ffffe5, 26}, {0xfffff1, 24}, {0x1ffffed, 25},
+    {0x7fff2, 19}, {0x1fffe3, 21}, {0x3ffffe6, 26}, {0x7ffffe0, 27},
+    {0x7ffffe1, 27}, {0x3ffffe7, 26}, {0x7ffffe2, 27}, {0xfffff2, 24},
+    {0x1fffe4, 21}, {0x1fffe5, 21}, {0x3ffffe8, 26}, {0x3ffffe9, 26},
+    {0xffffffd, 28}, {0x7ffffe3, 27}, {0x7ffffe4, 27}, {0x7ffffe5, 27},
+    {0xfffec, 20}, {0xfffff3, 24}, {0xfffed, 20}, {0x1fffe6, 21},
+    {0x3fffe9, 22}, {0x1fffe7, 21}, {0x1fffe8, 21}, {0x7ffff3, 23},
+    {0x3fffea, 22}, {0x3fffeb, 22}, {0x1ffffee, 25}, {0x1ffffef, 25},
+    {0xfffff4, 24}, {0xfffff5, 24}, {0x3ffffea, 26}, {0x7ffff4, 23},
+    {0x3ffffeb, 26}, {0x7ffffe6, 27}, {0x3ffffec, 26}, {0x3ffffed, 26},
+    {0x7ffffe7, 27}, {0x7ffffe8, 27}, {0x7ffffe9, 27}, {0x7ffffea, 27},
+    {0x7ffffeb, 27}, {0xffffffe, 28}, {0x7ffffec, 27}, {0x7ffffed, 27},
+    {0x7ffffee, 27}, {0x7ffffef, 27}, {0x7fffff0, 27}, {0x3ffffee, 26},
+    {0x3fffffff, 30},
+};
+
+// binary tree for decoding the Huffman code bit by bit. a positive child
+// is the index of the next node, a negative child is a leaf holding the
+// symbol -(child + 1)
+struct HuffmanTree {
+  std::vector<std::array<int32_t, 2>> nodes;
+
+  HuffmanTree() {
+    nodes.push_back({{0, 0}});
+    for (int32_t symbol = 0; symbol < 257; ++symbol) {
+      uint32_t const code = HuffmanCodes[symbol].code;
+      size_t node = 0;
+      for (int i = HuffmanCodes[symbol].bits - 1; i >= 0; --i) {
+        int const bit = (code >> i) & 1;
+        if (i == 0) {
+          nodes[node][bit] = -(symbol + 1);
+        } else {
+          if (nodes[node][bit] == 0) {
+            int32_t const next = static_cast<int32_t>(nodes.size());
+            nodes.push_back({{0, 0}});
+            nodes[node][bit] = next;
+          }
+          node = static_cast<size_t>(nodes[node][bit]);
+        }
+      }
+    }
+  }
+};
+
+HuffmanTree const& huffmanTree() {
+  static HuffmanTree const tree;
+  return tree;
+}
+
+bool decodeInteger(uint8_t const*& p, uint8_t const* end, unsigned prefixBits,
+                   uint64_t& value) {
+  if (p >= end) {
+    return false;
+  }
+  uint64_t const max = (static_cast<uint64_t>(1) << prefixBits) - 1;
+  value = *p & max;
+  ++p;
+  if (value < max) {
+    return true;
+  }
+
+  unsigned shift = 0;
+  while (p < end) {
+    uint8_t const b = *p++;
+    if (shift > 56) {
+      return false;
+    }
+    value += static_cast<uint64_t>(b & 0x7f) << shift;
+    shift += 7;
+    if ((b & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool decodeString(uint8_t const*& p, uint8_t const* end, std::string& result) {
+  if (p >= end) {
+    return false;
+  }
+  bool const huffman = (*p & 0x80) != 0;
+  uint64_t length;
+  if (!decodeInteger(p, end, 7, length) ||
+      length > static_cast<uint64_t>(end - p)) {
+    return false;
+  }
+  if (huffman) {
+    if (!HpackDecoder::decodeHuffman(p, static_cast<size_t>(length), result)) {
+      return false;
+    }
+  } else {
+    result.assign(reinterpret_cast<char const*>(p), static_cast<size_t>(length));
+  }
+  p += length;
+  return true;
+}
+
+void encodeInteger(StringBuffer& buffer, uint64_t value, unsigned prefixBits,
+                   uint8_t flags) {
+  uint64_t const max = (static_cast<uint64_t>(1) << prefixBits) - 1;
+  if (value < max) {
+    buffer.appendChar(static_cast<char>(flags | value));
+    return;
+  }
+  buffer.appendChar(static_cast<char>(flags | max));
+  value -= max;
+  while (value >= 128) {
+    buffer.appendChar(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  buffer.appendChar(static_cast<char>(value));
+}
+
+void encodeString(StringBuffer& buffer, std::string const& value) {
+  encodeInteger(buffer, value.size(), 7, 0x00);
+  buffer.appendText(value);
+}
+
+}  // namespace
+
+HpackDecoder::HpackDecoder(size_t maxTableSize)
+    : _tableSize(0),
+      _maxTableSize(maxTableSize),
+      _currentMaxTableSize(maxTableSize) {}
+
+bool HpackDecoder::decode(uint8_t const* data, size_t length,
+                          size_t maxListSize, HeaderList& headers) {
+  uint8_t const* p = data;
+  uint8_t const* end = data + length;
+  size_t listSize = 0;
+  bool first = true;
+
+  while (p < end) {
+    uint8_t const b = *p;
+    std::string name;
+    std::string value;
+    uint64_t index;
+
+    if (b & 0x80) {
+      // indexed header field
+      if (!decodeInteger(p, end, 7, index) || index == 0 ||
+          !field(index, name, &value)) {
+        return false;
+      }
+    } else if ((b & 0xe0) == 0x20) {
+      // dynamic table size update, only allowed at the start of a block
+      if (!first || !decodeInteger(p, end, 5, index) ||
+          index > _maxTableSize) {
+        return false;
+      }
+      _currentMaxTableSize = static_cast<size_t>(index);
+      evict(_currentMaxTableSize);
+      continue;
+    } else {
+      // literal header field, with incremental indexing (01), without
+      // indexing (0000) or never indexed (0001)
+      bool const indexing = (b & 0x40) != 0;
+      if (!decodeInteger(p, end, indexing ? 6 : 4, index)) {
+        return false;
+      }
+      if (index == 0) {
+        if (!decodeString(p, end, name)) {
+          return false;
+        }
+      } else if (!field(index, name, nullptr)) {
+        return false;
+      }
+      if (!decodeString(p, end, value)) {
+        return false;
+      }
+      if (indexing) {
+        insert(name, value);
+      }
+    }
+
+    first = false;
+    listSize += name.size() + value.size() + EntryOverhead;
+    if (listSize > maxListSize) {
+      return false;
+    }
+    headers.emplace_back(std::move(name), std::move(value));
+  }
+
+  return true;
+}
+
+bool HpackDecoder::decodeHuffman(uint8_t const* data, size_t length,
+                                 std::string& result) {
+  auto const& nodes = huffmanTree().nodes;
+
+  result.clear();
+  result.reserve(length + length / 2);
+
+  size_t node = 0;
+  unsigned depth = 0;   // number of bits since the last symbol
+  bool ones = true;     // whether all of these bits are set
+  for (size_t i = 0; i < length; ++i) {
+    uint8_t const b = data[i];
+    for (int shift = 7; shift >= 0; --shift) {
+      int const bit = (b >> shift) & 1;
+      int32_t const next = nodes[node][bit];
+      if (next < 0) {
+        int32_t const symbol = -(next + 1);
+        if (symbol == 256) {
+          // EOS must not appear in a string
+          return false;
+        }
+        result.push_back(static_cast<char>(symbol));
+        node = 0;
+        depth = 0;
+        ones = true;
+      } else if (next == 0) {
+        return false;
+      } else {
+        node = static_cast<size_t>(next);
+        ++depth;
+        ones = ones && (bit == 1);
+      }
+    }
+  }
+
+  // the padding is a prefix of EOS, i.e. less than 8 bits, all set
+  return depth < 8 && ones;
+}
+
+bool HpackDecoder::field(uint64_t index, std::string& name,
+                         std::string* value) const {
+  TRI_ASSERT(index > 0);
+  if (index <= StaticTableSize) {
+    StaticField const& f = StaticTable[index - 1];
+    name = f.name;
+    if (value != nullptr) {
+      *value = f.value;
+    }
+    return true;
+  }
+
+  index -= StaticTableSize + 1;
+  if (index >= _table.size()) {
+    return false;
+  }
+  auto const& entry = _table[static_cast<size_t>(index)];
+  name = entry.first;
+  if (value != nullptr) {
+    *value = entry.second;
+  }
+  return true;
+}
+
+void HpackDecoder::insert(std::string const& name, std::string const& value) {
+  size_t const size = name.size() + value.size() + EntryOverhead;
+  if (size > _currentMaxTableSize) {
+    // an entry larger than the table empties it
+    _table.clear();
+    _tableSize = 0;
+    return;
+  }
+  evict(_currentMaxTableSize - size);
+  _table.emplace_front(name, value);
+  _tableSize += size;
+}
+
+void HpackDecoder::evict(size_t maxSize) {
+  while (_tableSize > maxSize && !_table.empty()) {
+    auto const& entry = _table.back();
+    _tableSize -= entry.first.size() + entry.second.size() + EntryOverhead;
+    _table.pop_back();
+  }
+}
+
+void HpackEncoder::addStatus(StringBuffer& buffer, int code) {
+  // indexes of the static table entries for :status
+  switch (code) {
+    case 200:
+      buffer.appendChar(static_cast<char>(0x80 | 8));
+      return;
+    case 204:
+      buffer.appendChar(static_cast<char>(0x80 | 9));
+      return;
+    case 206:
+      buffer.appendChar(static_cast<char>(0x80 | 10));
+      return;
+    case 304:
+      buffer.appendChar(static_cast<char>(0x80 | 11));
+      return;
+    case 400:
+      buffer.appendChar(static_cast<char>(0x80 | 12));
+      return;
+    case 404:
+      buffer.appendChar(static_cast<char>(0x80 | 13));
+      return;
+    case 500:
+      buffer.appendChar(static_cast<char>(0x80 | 14));
+      return;
+    default:
+      encodeInteger(buffer, 8, 4, 0x00);
+      encodeString(buffer, std::to_string(code));
+  }
+}
+
+void HpackEncoder::add(StringBuffer& buffer, std::string const& name,
+                       std::string const& value) {
+  size_t index = 0;
+  for (size_t i = 0; i < StaticTableSize; ++i) {
+    if (name == StaticTable[i].name) {
+      index = i + 1;
+      break;
+    }
+  }
+
+  if (index > 0) {
+    encodeInteger(buffer, index, 4, 0x00);
+  } else {
+    buffer.appendChar(0x00);
+    encodeString(buffer, name);
+  }
+  encodeString(buffer, value);
+}
@@ -0,0 +1,87 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_GENERAL_SERVER_HPACK_H
+#define ARANGOD_GENERAL_SERVER_HPACK_H 1
+
+#include "Basics/Common.h"
+
+#include <deque>
+
+namespace arangodb {
+namespace basics {
+class StringBuffer;
+}
+
+namespace rest {
+
+/// @brief decoder for the HPACK header compression of HTTP/2 (RFC 7541).
+/// a connection has one decoder, which must see all header blocks of the
+/// connection in order, because they share its dynamic table
+class HpackDecoder {
+ public:
+  typedef std::vector<std::pair<std::string, std::string>> HeaderList;
+
+  HpackDecoder(HpackDecoder const&) = delete;
+  HpackDecoder& operator=(HpackDecoder const&) = delete;
+
+  /// @brief maxTableSize is the SETTINGS_HEADER_TABLE_SIZE announced to
+  /// the peer
+  explicit HpackDecoder(size_t maxTableSize = 4096);
+
+  /// @brief decodes a complete header block and appends its fields to
+  /// headers. returns false on a compression error, or if the decoded
+  /// fields exceed maxListSize bytes. the connection must be closed then
+  bool decode(uint8_t const* data, size_t length, size_t maxListSize,
+              HeaderList& headers);
+
+  /// @brief decodes a Huffman encoded string
+  static bool decodeHuffman(uint8_t const* data, size_t length,
+                            std::string& result);
+
+ private:
+  bool field(uint64_t index, std::string& name, std::string* value) const;
+  void insert(std::string const& name, std::string const& value);
+  void evict(size_t maxSize);
+
+ private:
+  std::deque<std::pair<std::string, std::string>> _table;
+  size_t _tableSize;
+  size_t _maxTableSize;
+  size_t _currentMaxTableSize;
+};
+
+/// @brief encoder for HPACK header blocks. all fields are encoded as
+/// literals without indexing, referring to the static table for names, so
+/// that the encoder needs no state and the peer's table stays empty
+class HpackEncoder {
+ public:
+  /// @brief appends the :status pseudo header field
+  static void addStatus(basics::StringBuffer& buffer, int code);
+
+  /// @brief appends a header field, the name must be lower case
+  static void add(basics::StringBuffer& buffer, std::string const& name,
+                  std::string const& value);
+};
+
+}  // namespace rest
+}  // namespace arangodb
+
+#endif
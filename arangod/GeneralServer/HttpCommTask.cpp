@@ -24,16 +24,17 @@
 
 #include "HttpCommTask.h"
 
-#include "Basics/tri-strings.h"
 #include "Cluster/ServerState.h"
 #include "GeneralServer/AuthenticationFeature.h"
 #include "GeneralServer/GeneralServer.h"
 #include "GeneralServer/GeneralServerFeature.h"
+#include "GeneralServer/H2CommTask.h"
 #include "GeneralServer/RestHandler.h"
 #include "GeneralServer/RestHandlerFactory.h"
 #include "GeneralServer/VstCommTask.h"
 #include "Meta/conversion.h"
 #include "Rest/HttpRequest.h"
+#include "Rest/PayloadCompression.h"
 #include "Statistics/ConnectionStatistics.h"
 #include "Utils/Events.h"
 
@@ -145,25 +146,28 @@ void HttpCommTask::addResponse(GeneralResponse& baseResponse,
     response.headResponse(responseBodyLength);
   }
 
-  // reserve a buffer with some spare capacity
-  WriteBuffer buffer(leaseStringBuffer(responseBodyLength + 220), stat);
+  // reserve a buffer for the header only
+  WriteBuffer buffer(leaseStringBuffer(220), stat);
 
   // write header
   response.writeHeader(buffer._buffer);
+  buffer._buffer->ensureNullTerminated();
 
-  // write body
-  if (_requestType != rest::RequestType::HEAD) {
-    buffer._buffer->appendText(response.body());
+  // the body is sent from its own buffer, behind the header
+  if (_requestType != rest::RequestType::HEAD && responseBodyLength > 0) {
+    buffer._body = response.stealBody().release();
   }
 
-  buffer._buffer->ensureNullTerminated();
-
   if (!buffer._buffer->empty()) {
     LOG_TOPIC(TRACE, Logger::REQUESTS)
         << "\"http-request-response\",\"" << (void*)this << "\",\"" << _fullUrl
         << "\",\""
         << StringUtils::escapeUnicode(
-               std::string(buffer._buffer->c_str(), buffer._buffer->length()))
+               std::string(buffer._buffer->c_str(), buffer._buffer->length()) +
+               (buffer._body == nullptr
+                    ? std::string()
+                    : std::string(buffer._body->c_str(),
+                                  buffer._body->length())))
         << "\"";
   }
 
@@ -196,7 +200,9 @@ void HttpCommTask::addResponse(GeneralResponse& baseResponse,
       << "\"," << Logger::FIXED(totalTime, 6);
 
   std::unique_ptr<basics::StringBuffer> body = response.stealBody();
-  returnStringBuffer(body.release()); // takes care of deleting
+  if (body != nullptr) {
+    returnStringBuffer(body.release()); // takes care of deleting
+  }
 }
 
 // reads data from the socket
@@ -292,6 +298,25 @@ bool HttpCommTask::processRead(double startTime) {
       return false;
     }
 
+    if (_readBuffer.length() >= 18 &&
+        std::memcmp(_readBuffer.c_str(), "PRI * HTTP/2.0\r\n\r\n", 18) == 0) {
+      LOG_TOPIC(TRACE, Logger::COMMUNICATION) << "switching from HTTP to HTTP/2";
+
+      // mark task as abandoned, no more reads will happen on _peer
+      if (!abandon()) {
+        THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "task is already abandoned");
+      }
+
+      // the HTTP/2 task checks the complete connection preface itself
+      std::shared_ptr<GeneralCommTask> commTask = std::make_shared<H2CommTask>(
+          _scheduler, _server, std::move(_peer), std::move(_connectionInfo),
+          GeneralServerFeature::keepAliveTimeout(), /*skipSocketInit*/ true);
+      commTask->addToReadBuffer(_readBuffer.c_str(), _readBuffer.length());
+      commTask->processAll();
+      commTask->start();
+      return false;
+    }
+
     // header is complete
     if (ptr < end) {
       _readPosition = ptr - _readBuffer.c_str() + 4;
@@ -498,6 +523,16 @@ bool HttpCommTask::processRead(double startTime) {
         }
         _incompleteRequest->setBody(uncompressed.c_str(), uncompressed.size());
         handled = true;
+      } else if (encoding == PayloadCompression::ENCODING) {
+        std::string uncompressed;
+        if (!PayloadCompression::uncompress(_readBuffer.c_str() + _bodyPosition,
+                                            _bodyLength, uncompressed)) {
+          addErrorResponse(rest::ResponseCode::BAD, _incompleteRequest->contentTypeResponse(), 1,
+                           TRI_ERROR_BAD_PARAMETER, "snappy decoding error");
+          return false;
+        }
+        _incompleteRequest->setBody(uncompressed.c_str(), uncompressed.size());
+        handled = true;
       }
     }
 
@@ -759,66 +794,3 @@ void HttpCommTask::resetState() {
   _newRequest = true;
   _readRequestBody = false;
 }
-
-ResponseCode HttpCommTask::handleAuthHeader(HttpRequest* request) const {
-  if (!_auth->isActive()) {
-    request->setAuthenticated(true);
-    return rest::ResponseCode::OK;
-  }
-
-  bool found;
-  std::string const& authStr = request->header(StaticStrings::Authorization, found);
-  if (!found) {
-    events::CredentialsMissing(request);
-    return rest::ResponseCode::UNAUTHORIZED;
-  }
-
-  size_t methodPos = authStr.find_first_of(' ');
-  if (methodPos != std::string::npos) {
-    // skip over authentication method
-    char const* auth = authStr.c_str() + methodPos;
-    while (*auth == ' ') {
-      ++auth;
-    }
-
-    LOG_TOPIC(DEBUG, arangodb::Logger::REQUESTS) << "\"authorization-header\",\"" << (void*)this << "\",\""
-        << authStr << "\"";
-    try {
-      // note that these methods may throw in case of an error
-      AuthenticationMethod authMethod = AuthenticationMethod::NONE;
-      if (TRI_CaseEqualString(authStr.c_str(), "basic ", 6)) {
-        authMethod = AuthenticationMethod::BASIC;
-      } else if (TRI_CaseEqualString(authStr.c_str(), "bearer ", 7)) {
-        authMethod = AuthenticationMethod::JWT;
-      }
-
-      if (authMethod != AuthenticationMethod::NONE) {
-        request->setAuthenticationMethod(authMethod);
-        TRI_ASSERT(_auth->isActive());
-        auto entry = _auth->tokenCache()->checkAuthentication(authMethod, auth);
-        request->setAuthenticated(entry.authenticated());
-        request->setUser(std::move(entry._username));
-
-        if (request->authenticated()) {
-          events::Authenticated(request, authMethod);
-          return rest::ResponseCode::OK;
-        }
-        events::CredentialsBad(request, authMethod);
-        return rest::ResponseCode::UNAUTHORIZED;
-      }
-
-      // intentionally falls through
-    } catch (arangodb::basics::Exception const& ex) {
-      // translate error
-      if (ex.code() == TRI_ERROR_USER_NOT_FOUND) {
-        return rest::ResponseCode::UNAUTHORIZED;
-      }
-      return GeneralResponse::responseCode(ex.what());
-    } catch (...) {
-      return rest::ResponseCode::SERVER_ERROR;
-    }
-  }
-
-  events::UnknownAuthenticationMethod(request);
-  return rest::ResponseCode::UNAUTHORIZED;
-}
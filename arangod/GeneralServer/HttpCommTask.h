@@ -51,7 +51,6 @@ class HttpCommTask final : public GeneralCommTask {
 
   std::string authenticationRealm() const;
   ResponseCode authenticateRequest(HttpRequest*);
-  ResponseCode handleAuthHeader(HttpRequest* request) const;
   
   
  private:
@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RequestAdmission.h"
+
+#include "Basics/MutexLocker.h"
+#include "Basics/StaticStrings.h"
+#include "Basics/StringUtils.h"
+#include "Rest/GeneralRequest.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::basics;
+using namespace arangodb::rest;
+
+RequestAdmission::Ticket::~Ticket() { _admission->release(_lane); }
+
+RequestAdmission::RequestAdmission(
+    std::array<uint64_t, NumberRequestLanes> const& limits) {
+  // the same cuts as for the request time distributions of the statistics
+  StatisticsVector cuts;
+  cuts << (0.01) << (0.05) << (0.1) << (0.2) << (0.5) << (1.0);
+
+  for (size_t i = 0; i < NumberRequestLanes; ++i) {
+    _lanes[i].limit = limits[i];
+    _lanes[i].queueTime = StatisticsDistribution(cuts);
+  }
+}
+
+bool RequestAdmission::parseLimit(
+    std::string const& value,
+    std::array<uint64_t, NumberRequestLanes>& limits) {
+  size_t const pos = value.find('=');
+  if (pos == std::string::npos || pos == 0 || pos + 1 == value.size()) {
+    return false;
+  }
+
+  std::string const name = StringUtils::trim(value.substr(0, pos));
+  std::string const number = StringUtils::trim(value.substr(pos + 1));
+  if (number.find_first_not_of("0123456789") != std::string::npos) {
+    return false;
+  }
+
+  for (size_t i = 0; i < NumberRequestLanes; ++i) {
+    if (name == NameRequestLane(static_cast<RequestLane>(i))) {
+      limits[i] = StringUtils::uint64(number);
+      return true;
+    }
+  }
+  return false;
+}
+
+double RequestAdmission::deadline(GeneralRequest const& request) {
+  bool found;
+  std::string const& value = request.header(StaticStrings::Deadline, found);
+  if (!found || value.empty()) {
+    return 0.0;
+  }
+  double const result = StringUtils::doubleDecimal(value);
+  return result > 0.0 ? result : 0.0;
+}
+
+std::shared_ptr<RequestAdmission::Ticket> RequestAdmission::admit(
+    RequestLane lane) {
+  Lane& l = _lanes[static_cast<size_t>(lane)];
+
+  uint64_t const current = l.current.fetch_add(1, std::memory_order_relaxed);
+  if (l.limit > 0 && current >= l.limit) {
+    l.current.fetch_sub(1, std::memory_order_relaxed);
+    l.rejected.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  l.admitted.fetch_add(1, std::memory_order_relaxed);
+  try {
+    return std::make_shared<Ticket>(this, lane);
+  } catch (...) {
+    l.current.fetch_sub(1, std::memory_order_relaxed);
+    throw;
+  }
+}
+
+void RequestAdmission::release(RequestLane lane) noexcept {
+  Lane& l = _lanes[static_cast<size_t>(lane)];
+  TRI_ASSERT(l.current.load() > 0);
+  l.current.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void RequestAdmission::expired(RequestLane lane) {
+  _lanes[static_cast<size_t>(lane)].expired.fetch_add(
+      1, std::memory_order_relaxed);
+}
+
+void RequestAdmission::addQueueTime(RequestLane lane, double seconds) {
+  MUTEX_LOCKER(locker, _queueTimeLock);
+  _lanes[static_cast<size_t>(lane)].queueTime.addFigure(seconds);
+}
+
+void RequestAdmission::toVelocyPack(VPackBuilder& builder) const {
+  builder.openObject();
+  for (size_t i = 0; i < NumberRequestLanes; ++i) {
+    Lane const& l = _lanes[i];
+
+    builder.add(VPackValue(NameRequestLane(static_cast<RequestLane>(i))));
+    builder.openObject();
+    builder.add("limit", VPackValue(l.limit));
+    builder.add("current", VPackValue(l.current.load()));
+    builder.add("admitted", VPackValue(l.admitted.load()));
+    builder.add("rejected", VPackValue(l.rejected.load()));
+    builder.add("expired", VPackValue(l.expired.load()));
+
+    builder.add(VPackValue("queueTime"));
+    builder.openObject();
+    {
+      MUTEX_LOCKER(locker, _queueTimeLock);
+      builder.add("sum", VPackValue(l.queueTime._total));
+      builder.add("count", VPackValue(l.queueTime._count));
+      builder.add("cuts", VPackValue(VPackValueType::Array));
+      for (auto const& cut : l.queueTime._cuts) {
+        builder.add(VPackValue(cut));
+      }
+      builder.close();
+      builder.add("counts", VPackValue(VPackValueType::Array));
+      for (auto const& count : l.queueTime._counts) {
+        builder.add(VPackValue(count));
+      }
+      builder.close();
+    }
+    builder.close();  // queueTime
+
+    builder.close();
+  }
+  builder.close();
+}
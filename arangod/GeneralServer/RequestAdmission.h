@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_GENERAL_SERVER_REQUEST_ADMISSION_H
+#define ARANGOD_GENERAL_SERVER_REQUEST_ADMISSION_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Mutex.h"
+#include "GeneralServer/RequestLane.h"
+#include "Statistics/figures.h"
+
+#include <array>
+
+namespace arangodb {
+class GeneralRequest;
+
+namespace velocypack {
+class Builder;
+}
+
+namespace rest {
+
+/// @brief admission control for the requests of the request lanes. a lane
+/// can have a limit for the number of its requests that are queued or
+/// running at the same time, further requests of the lane are rejected.
+/// a request can carry a deadline in the x-arango-deadline header, as
+/// seconds since the epoch. a request whose deadline passed is dropped
+/// before it is queued, and again before it is run
+class RequestAdmission {
+ public:
+  /// @brief holds a place in a lane until it is destroyed
+  class Ticket {
+   public:
+    Ticket(Ticket const&) = delete;
+    Ticket& operator=(Ticket const&) = delete;
+
+    Ticket(RequestAdmission* admission, RequestLane lane)
+        : _admission(admission), _lane(lane) {}
+    ~Ticket();
+
+   private:
+    RequestAdmission* _admission;
+    RequestLane const _lane;
+  };
+
+  RequestAdmission(RequestAdmission const&) = delete;
+  RequestAdmission& operator=(RequestAdmission const&) = delete;
+
+  /// @brief limits[lane] is the maximum number of requests of the lane,
+  /// 0 means unlimited
+  explicit RequestAdmission(
+      std::array<uint64_t, NumberRequestLanes> const& limits);
+
+  /// @brief parse a lane limit of the form <lane>=<number>
+  static bool parseLimit(std::string const& value,
+                         std::array<uint64_t, NumberRequestLanes>& limits);
+
+  /// @brief the deadline of the request, 0.0 if it has none
+  static double deadline(GeneralRequest const& request);
+
+  /// @brief take a place in the lane, nullptr if the lane is at its limit
+  std::shared_ptr<Ticket> admit(RequestLane lane);
+
+  /// @brief a request of the lane was dropped because of its deadline
+  void expired(RequestLane lane);
+
+  /// @brief a request of the lane waited this long before it was run
+  void addQueueTime(RequestLane lane, double seconds);
+
+  /// @brief the limits, counters and queue times of all lanes
+  void toVelocyPack(velocypack::Builder& builder) const;
+
+ private:
+  void release(RequestLane lane) noexcept;
+
+  struct Lane {
+    uint64_t limit = 0;
+    std::atomic<uint64_t> current{0};
+    std::atomic<uint64_t> admitted{0};
+    std::atomic<uint64_t> rejected{0};
+    std::atomic<uint64_t> expired{0};
+    basics::StatisticsDistribution queueTime;
+  };
+
+  std::array<Lane, NumberRequestLanes> _lanes;
+
+  /// @brief protects the queue time distributions
+  mutable Mutex _queueTimeLock;
+};
+
+}  // namespace rest
+}  // namespace arangodb
+
+#endif
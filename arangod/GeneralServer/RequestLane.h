@@ -40,6 +40,9 @@ enum class RequestLane {
   TASK_V8
 };
 
+// number of request lanes
+constexpr size_t NumberRequestLanes = static_cast<size_t>(RequestLane::TASK_V8) + 1;
+
 enum class RequestPriority : size_t { HIGH = 1, LOW = 2 };
 
 inline RequestPriority PriorityRequestLane(RequestLane lane) {
@@ -69,6 +72,34 @@ inline RequestPriority PriorityRequestLane(RequestLane lane) {
   }
   return RequestPriority::LOW;
 }
+
+inline char const* NameRequestLane(RequestLane lane) {
+  switch (lane) {
+    case RequestLane::CLIENT_FAST:
+      return "client-fast";
+    case RequestLane::CLIENT_AQL:
+      return "client-aql";
+    case RequestLane::CLIENT_V8:
+      return "client-v8";
+    case RequestLane::CLIENT_SLOW:
+      return "client-slow";
+    case RequestLane::AGENCY_INTERNAL:
+      return "agency-internal";
+    case RequestLane::AGENCY_CLUSTER:
+      return "agency-cluster";
+    case RequestLane::CLUSTER_INTERNAL:
+      return "cluster-internal";
+    case RequestLane::CLUSTER_V8:
+      return "cluster-v8";
+    case RequestLane::CLUSTER_ADMIN:
+      return "cluster-admin";
+    case RequestLane::SERVER_REPLICATION:
+      return "server-replication";
+    case RequestLane::TASK_V8:
+      return "task-v8";
+  }
+  return "unknown";
+}
 }
 
 #endif
@@ -25,15 +25,19 @@
 
 #include <velocypack/Exception.h>
 
+#include "Basics/StaticStrings.h"
 #include "Basics/StringUtils.h"
 #include "Cluster/ClusterComm.h"
 #include "Cluster/ClusterInfo.h"
 #include "Cluster/ClusterMethods.h"
+#include "Cluster/ServerState.h"
 #include "GeneralServer/AuthenticationFeature.h"
 #include "GeneralServer/GeneralCommTask.h"
 #include "Logger/Logger.h"
 #include "Rest/GeneralRequest.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "Statistics/RequestStatistics.h"
+#include "Statistics/RequestTracer.h"
 #include "Utils/ExecContext.h"
 
 #include <iostream>
@@ -49,6 +53,22 @@ std::atomic_uint_fast64_t NEXT_HANDLER_ID(
 
 thread_local RestHandler const* RestHandler::CURRENT_HANDLER = nullptr;
 
+/// @brief continues the handler with the answer of its request
+struct RestHandler::WakeupCallback final : public ClusterCommCallback {
+  explicit WakeupCallback(std::shared_ptr<RestHandler> handler)
+      : _handler(std::move(handler)) {}
+
+  bool operator()(ClusterCommResult* result) override {
+    // called while ClusterComm holds its queue lock, hand the result over
+    // to a scheduler thread
+    _handler->wakeupHandler(std::make_shared<ClusterCommResult>(*result));
+    return true;
+  }
+
+ private:
+  std::shared_ptr<RestHandler> _handler;
+};
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                      constructors and destructors
 // -----------------------------------------------------------------------------
@@ -96,19 +116,7 @@ void RestHandler::setStatistics(RequestStatistics* stat) {
   }
 }
 
-bool RestHandler::forwardRequest() {
-  // TODO refactor into a more general/customizable method
-  //
-  // The below is mostly copied and only lightly modified from
-  // RestReplicationHandler::handleTrampolineCoordinator; however, that method
-  // needs some more specific checks regarding headers and param values, so we
-  // can't just reuse this method there. Maybe we just need to implement some
-  // virtual methods to handle param/header filtering?
-
-  // TODO verify that vst -> http -> vst conversion works correctly
-
-  // TODO verify that async requests work correctly
-
+bool RestHandler::needsForwarding() {
   uint32_t shortId = forwardingTarget();
   if (shortId == 0) {
     // no need to actually forward
@@ -122,6 +130,55 @@ bool RestHandler::forwardRequest() {
     return false;
   }
 
+  _forwardTarget = std::move(serverId);
+  return true;
+}
+
+std::shared_ptr<ClusterCommCallback> RestHandler::wakeupCallback() {
+  return std::make_shared<WakeupCallback>(shared_from_this());
+}
+
+/// @brief the answer of an asynchronous request arrived, continue the
+/// handler on a scheduler thread
+void RestHandler::wakeupHandler(std::shared_ptr<ClusterCommResult> result) {
+  auto self = shared_from_this();
+  auto wakeup = [self, this, result]() {
+    {
+      // waits until the handler has paused, if the answer was faster
+      MUTEX_LOCKER(locker, _executionMutex);
+      TRI_ASSERT(_state == HandlerState::PAUSED);
+      _asyncResult = result;
+    }
+    runHandlerStateMachine();
+  };
+
+  auto scheduler = SchedulerFeature::SCHEDULER;
+  TRI_ASSERT(scheduler != nullptr);
+
+  // the handler already holds a place in its lane, so it must not be
+  // rejected because the queue is full
+  if (!scheduler->queue(PriorityRequestLane(lane()), wakeup)) {
+    scheduler->post(wakeup);
+  }
+}
+
+/// @brief sends the request to the coordinator in _forwardTarget. returns
+/// false if an error response was generated instead
+bool RestHandler::sendForwardedRequest() {
+  // TODO refactor into a more general/customizable method
+  //
+  // The below is mostly copied and only lightly modified from
+  // RestReplicationHandler::handleTrampolineCoordinator; however, that method
+  // needs some more specific checks regarding headers and param values, so we
+  // can't just reuse this method there. Maybe we just need to implement some
+  // virtual methods to handle param/header filtering?
+
+  // TODO verify that vst -> http -> vst conversion works correctly
+
+  // TODO verify that async requests work correctly
+
+  std::string const& serverId = _forwardTarget;
+
   LOG_TOPIC(DEBUG, Logger::REQUESTS) << "forwarding request " << _request->messageId() << " to " << serverId;
 
   bool useVst = false;
@@ -174,45 +231,55 @@ bool RestHandler::forwardRequest() {
     // nullptr happens only during controlled shutdown
     generateError(rest::ResponseCode::SERVICE_UNAVAILABLE,
                   TRI_ERROR_SHUTTING_DOWN, "shutting down server");
-    return true;
+    return false;
   }
 
-  std::unique_ptr<ClusterCommResult> res;
+  std::shared_ptr<std::string const> body;
   if (!useVst) {
     HttpRequest* httpRequest = dynamic_cast<HttpRequest*>(_request.get());
     if (httpRequest == nullptr) {
       THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
                                      "invalid request type");
     }
-
-    // Send a synchronous request to that shard using ClusterComm:
-    res = cc->syncRequest("", TRI_NewTickServer(), "server:" + serverId,
-                          _request->requestType(),
-                          "/_db/" + StringUtils::urlEncode(dbname) +
-                              _request->requestPath() + params,
-                          httpRequest->body(), headers, 300.0);
+    body = std::make_shared<std::string const>(httpRequest->body());
   } else {
     // do we need to handle multiple payloads here? - TODO
     // here we switch from vst to http
-    res = cc->syncRequest("", TRI_NewTickServer(), "server:" + serverId,
-                          _request->requestType(),
-                          "/_db/" + StringUtils::urlEncode(dbname) +
-                              _request->requestPath() + params,
-                          _request->payload().toJson(), headers, 300.0);
+    body = std::make_shared<std::string const>(_request->payload().toJson());
   }
 
+  // the handler is suspended instead of waiting for the answer
+  cc->asyncRequest("", TRI_NewTickServer(), "server:" + serverId,
+                   _request->requestType(),
+                   "/_db/" + StringUtils::urlEncode(dbname) +
+                       _request->requestPath() + params,
+                   body, headers, wakeupCallback(), 300.0, true);
+  return true;
+}
+
+/// @brief builds the response from the answer of the forwarded request
+void RestHandler::handleForwardedResponse() {
+  TRI_ASSERT(_asyncResult != nullptr);
+  std::shared_ptr<ClusterCommResult> res = std::move(_asyncResult);
+
+  bool useVst = false;
+  if (_request->transportType() == Endpoint::TransportType::VST) {
+    useVst = true;
+  }
+  std::string const& serverId = _forwardTarget;
+
   if (res->status == CL_COMM_TIMEOUT) {
     // No reply, we give up:
     generateError(rest::ResponseCode::BAD, TRI_ERROR_CLUSTER_TIMEOUT,
                   "timeout within cluster");
-    return true;
+    return;
   }
 
   if (res->status == CL_COMM_BACKEND_UNAVAILABLE) {
     // there is no result
     generateError(rest::ResponseCode::BAD, TRI_ERROR_CLUSTER_CONNECTION_LOST,
                   "lost connection within cluster");
-    return true;
+    return;
   }
 
   if (res->status == CL_COMM_ERROR) {
@@ -249,7 +316,6 @@ bool RestHandler::forwardRequest() {
     _response->setHeader(it.first, it.second);
   }
   _response->setHeader(StaticStrings::RequestServedBy, serverId);
-  return true;
 }
 
 void RestHandler::runHandlerStateMachine() {
@@ -259,6 +325,15 @@ void RestHandler::runHandlerStateMachine() {
   while (true) {
     switch (_state) {
       case HandlerState::PREPARE:
+        if (!_forwardTarget.empty()) {
+          forwardEngine(false);
+          if (_state == HandlerState::PAUSED) {
+            LOG_TOPIC(DEBUG, Logger::COMMUNICATION)
+                << "Pausing rest handler execution";
+            return;  // continued with the answer of the other server
+          }
+          break;
+        }
         prepareEngine();
         break;
 
@@ -273,6 +348,10 @@ void RestHandler::runHandlerStateMachine() {
       }
 
       case HandlerState::CONTINUED: {
+        if (!_forwardTarget.empty()) {
+          forwardEngine(true);
+          break;
+        }
         executeEngine(true);
         if (_state == HandlerState::PAUSED) {
           shutdownExecute(false);
@@ -358,14 +437,48 @@ void RestHandler::continueHandlerExecution() {
 }
 
 void RestHandler::shutdownEngine() {
-  RestHandler::CURRENT_HANDLER = this;
+  // a forwarded request was never prepared for execution
+  if (_forwardTarget.empty()) {
+    RestHandler::CURRENT_HANDLER = this;
 
-  // shutdownExecute is noexcept
-  shutdownExecute(true);
-  
-  RestHandler::CURRENT_HANDLER = nullptr;
+    // shutdownExecute is noexcept
+    shutdownExecute(true);
+
+    RestHandler::CURRENT_HANDLER = nullptr;
+  }
   _state = HandlerState::DONE;
 }
+
+void RestHandler::forwardEngine(bool isContinue) {
+  if (!isContinue) {
+    // set end immediately so we do not get negative statistics
+    RequestStatistics::SET_REQUEST_START_END(_statistics);
+  }
+
+  try {
+    if (isContinue) {
+      handleForwardedResponse();
+    } else if (sendForwardedRequest()) {
+      _state = HandlerState::PAUSED;
+      return;
+    }
+    _state = HandlerState::FINALIZE;
+    return;
+  } catch (Exception const& ex) {
+    RequestStatistics::SET_EXECUTE_ERROR(_statistics);
+    handleError(ex);
+  } catch (std::exception const& ex) {
+    RequestStatistics::SET_EXECUTE_ERROR(_statistics);
+    Exception err(TRI_ERROR_INTERNAL, ex.what(), __FILE__, __LINE__);
+    handleError(err);
+  } catch (...) {
+    RequestStatistics::SET_EXECUTE_ERROR(_statistics);
+    Exception err(TRI_ERROR_INTERNAL, __FILE__, __LINE__);
+    handleError(err);
+  }
+
+  _state = HandlerState::FAILED;
+}
   /* TODO REMOVE ME!
   int res = TRI_ERROR_NO_ERROR;
 
@@ -408,6 +521,19 @@ void RestHandler::executeEngine(bool isContinue) {
   ExecContext* exec = static_cast<ExecContext*>(_request->requestContext());
   ExecContextScope scope(exec);
 
+  if (!isContinue) {
+    // DB servers only trace the requests of traced requests
+    bool found;
+    std::string const& traceId =
+        _request->header(StaticStrings::TraceIdHeader, found);
+    if (found) {
+      _traceId = traceId;
+    } else if (!ServerState::instance()->isDBServer()) {
+      _traceId = RequestTracer::sample();
+    }
+  }
+  RequestTracer::Scope trace(_traceId, name());
+
   RestHandler::CURRENT_HANDLER = this;
 
   try {
@@ -435,6 +561,11 @@ void RestHandler::executeEngine(bool isContinue) {
       handleError(err);
     }
 
+    if (!_traceId.empty() && _response != nullptr) {
+      // tells the client which traces to pull
+      _response->setHeaderNC(StaticStrings::TraceIdHeader, _traceId);
+    }
+
     _state = HandlerState::FINALIZE;
     return;
   } catch (Exception const& ex) {
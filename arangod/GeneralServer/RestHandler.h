@@ -33,6 +33,8 @@
 namespace arangodb {
 class GeneralRequest;
 class RequestStatistics;
+struct ClusterCommCallback;
+struct ClusterCommResult;
 
 enum class RestStatus { DONE, WAITING, FAIL};
 
@@ -79,8 +81,10 @@ class RestHandler : public std::enable_shared_from_this<RestHandler> {
   /// Execute the rest handler state machine
   void continueHandlerExecution();
 
-  /// @brief forwards the request to the appropriate server
-  bool forwardRequest();
+  /// @brief determines whether the request must be forwarded to another
+  /// coordinator. a forwarded request is not executed when the handler
+  /// runs, but sent to the other coordinator, and its answer is returned
+  bool needsForwarding();
 
  public:
   // rest handler name for debugging and logging
@@ -124,7 +128,25 @@ class RestHandler : public std::enable_shared_from_this<RestHandler> {
   // generates an error
   void generateError(arangodb::Result const&);
 
+  /// @brief returns a ClusterComm callback which resumes the handler when
+  /// the answer of an asynchronous request arrives. the handler sends the
+  /// request with this callback and returns RestStatus::WAITING, instead of
+  /// blocking a scheduler thread in syncRequest. continueExecute() is then
+  /// called on a scheduler thread, and finds the answer in asyncResult()
+  std::shared_ptr<ClusterCommCallback> wakeupCallback();
+
+  /// @brief the answer of the last asynchronous request, see wakeupCallback
+  std::shared_ptr<ClusterCommResult> const& asyncResult() const {
+    return _asyncResult;
+  }
+
  private:
+  struct WakeupCallback;
+
+  void wakeupHandler(std::shared_ptr<ClusterCommResult> result);
+
+  bool sendForwardedRequest();
+  void handleForwardedResponse();
 
   enum class HandlerState { PREPARE, EXECUTE, PAUSED, CONTINUED, FINALIZE, DONE, FAILED };
 
@@ -136,6 +158,10 @@ class RestHandler : public std::enable_shared_from_this<RestHandler> {
   ///        If isContinue == true it will call continueExecute()
   ///        otherwise execute() will be called
   void executeEngine(bool isContinue);
+  /// @brief Forwards the request or, if isContinue == true, processes the
+  ///        answer of the other coordinator
+  ///        May set the state to PAUSED, FINALIZE or FAILED
+  void forwardEngine(bool isContinue);
   void shutdownEngine();
 
  protected:
@@ -152,6 +178,13 @@ class RestHandler : public std::enable_shared_from_this<RestHandler> {
   HandlerState _state;
   std::function<void(rest::RestHandler*)> _callback;
 
+  // the coordinator the request is forwarded to, empty if it is executed
+  std::string _forwardTarget;
+  std::shared_ptr<ClusterCommResult> _asyncResult;
+
+  // the trace id of a traced request, empty otherwise
+  std::string _traceId;
+
   mutable Mutex _executionMutex;
 };
 
@@ -149,8 +149,8 @@ void VstCommTask::addResponse(GeneralResponse& baseResponse,
     slices.push_back(response_message._header);
   }
 
-  // set some sensible maxchunk size and compression
-  auto buffers = createChunkForNetwork(slices, mid, _maxChunkSize,
+  // all chunks of the message are written with one buffer
+  auto buffer = createChunksForNetwork(slices, mid, _maxChunkSize,
                                        _protocolVersion);
   double const totalTime = RequestStatistics::ELAPSED_SINCE_READ_START(stat);
 
@@ -163,24 +163,7 @@ void VstCommTask::addResponse(GeneralResponse& baseResponse,
         << _connectionInfo.clientAddress << "\"," << stat->timingsCsv();
   }
 
-  if (buffers.empty()) {
-    if (stat != nullptr) {
-      stat->release();
-    }
-  } else {
-    size_t n = buffers.size() - 1;
-    size_t c = 0;
-
-    for (auto&& buffer : buffers) {
-      if (c == n) {
-        addWriteBuffer(WriteBuffer(buffer.release(), stat));
-      } else {
-        addWriteBuffer(WriteBuffer(buffer.release(), nullptr));
-      }
-
-      ++c;
-    }
-  }
+  addWriteBuffer(WriteBuffer(buffer.release(), stat));
   
   // and give some request information
   LOG_TOPIC(INFO, Logger::REQUESTS)
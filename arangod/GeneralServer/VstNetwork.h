@@ -33,6 +33,7 @@
 #include <velocypack/Validator.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <algorithm>
 #include <memory>
 #include <stdexcept>
 
@@ -54,13 +55,32 @@ inline constexpr std::size_t chunkHeaderLength(bool sendTotalLen) {
 
 // Send Message Created from Slices
 
-// working version of single chunk message creation
-inline std::unique_ptr<basics::StringBuffer> createChunkForNetworkDetail(
-    std::vector<VPackSlice> const& slices, bool isFirstChunk, uint32_t chunk,
-    uint64_t id, ProtocolVersion protocolVersion,
-    uint64_t totalMessageLength) {
-  using basics::StringBuffer;
+// appends the bytes [begin, end) of the concatenated data of the slices
+inline void appendSlicesRange(basics::StringBuffer* buffer,
+                              std::vector<VPackSlice> const& slices,
+                              std::size_t begin, std::size_t end) {
+  std::size_t offset = 0;
+  for (auto const& slice : slices) {
+    std::size_t const length = slice.byteSize();
+    if (offset + length > begin && offset < end) {
+      std::size_t const from = (std::max)(begin, offset) - offset;
+      std::size_t const to = (std::min)(end, offset + length) - offset;
+      buffer->appendText(slice.startAs<char>() + from, to - from);
+    }
+    offset += length;
+    if (offset >= end) {
+      break;
+    }
+  }
+}
 
+// appends a single chunk carrying the bytes [begin, end) of the message
+inline void appendChunkForNetwork(basics::StringBuffer* buffer,
+                                  std::vector<VPackSlice> const& slices,
+                                  std::size_t begin, std::size_t end,
+                                  bool isFirstChunk, uint32_t chunk,
+                                  uint64_t id, ProtocolVersion protocolVersion,
+                                  uint64_t totalMessageLength) {
   bool sendTotalLen = protocolVersion != ProtocolVersion::VST_1_0 ||
                       (isFirstChunk && chunk > 1);
   // if we speak VST_1_0 and have more than one chunk and the chunk
@@ -73,93 +93,58 @@ inline std::unique_ptr<basics::StringBuffer> createChunkForNetworkDetail(
   chunk <<= 1;
   chunk |= isFirstChunk ? 0x1 : 0x0;
 
-  // get the length of VPack data
-  uint32_t dataLength = 0;
-  for (auto& slice : slices) {
-    // TODO: is a 32bit value sufficient for all Slices here?
-    dataLength += static_cast<uint32_t>(slice.byteSize());
-  }
-
   // calculate length of current chunk
-  uint32_t chunkLength =
-      dataLength + static_cast<uint32_t>(chunkHeaderLength(sendTotalLen));
-
-  auto buffer =
-      std::make_unique<StringBuffer>(chunkLength, false);
+  uint32_t chunkLength = static_cast<uint32_t>(end - begin) +
+                         static_cast<uint32_t>(chunkHeaderLength(sendTotalLen));
 
   LOG_TOPIC(TRACE, Logger::COMMUNICATION) << "chunkLength: " << chunkLength;
-  appendLittleEndian(buffer.get(), chunkLength);
-  appendLittleEndian(buffer.get(), chunk);
-  appendLittleEndian(buffer.get(), id);
+  appendLittleEndian(buffer, chunkLength);
+  appendLittleEndian(buffer, chunk);
+  appendLittleEndian(buffer, id);
 
   if (sendTotalLen) {
-    appendLittleEndian(buffer.get(), totalMessageLength);
-  }
-
-  // append data in slices
-  for (auto const& slice : slices) {
-    try{
-      LOG_TOPIC(TRACE, Logger::COMMUNICATION) << slice.toJson() << " , " << slice.byteSize();
-    } catch(...){}
-    buffer->appendText(slice.startAs<char>(), slice.byteSize());
+    appendLittleEndian(buffer, totalMessageLength);
   }
 
-  return buffer;
+  appendSlicesRange(buffer, slices, begin, end);
 }
 
-// helper functions for sending chunks when given a string buffer as input
-// working version of single chunk message creation
-inline std::unique_ptr<basics::StringBuffer> createChunkForNetworkDetail(
-    char const* data, std::size_t begin, std::size_t end, bool isFirstChunk,
-    uint32_t chunk, uint64_t id, ProtocolVersion protocolVersion,
-    uint64_t totalMessageLength) {
-  using basics::StringBuffer;
-
-  bool sendTotalLen = protocolVersion != ProtocolVersion::VST_1_0 ||
-                      (isFirstChunk && chunk > 1);
-  // if we speak VST_1_0 and have more than one chunk and the chunk
-  // is the first then we are sending the first in a series. if this
-  // condition is true we also send extra 8 bytes for the messageLength
-  // (length of all VPackData). In later versions we always send the
-  // total length.
-
-  // build chunkX -- see VelocyStream Documentaion
-  chunk <<= 1;
-  chunk |= isFirstChunk ? 0x1 : 0x0;
-
-  // get the length of VPack data
-  uint32_t dataLength = static_cast<uint32_t>(end - begin);
-
-  // calculate length of current chunk
-  uint32_t chunkLength =
-      dataLength + static_cast<uint32_t>(chunkHeaderLength(sendTotalLen));
+// this function will be called by client code. returns all chunks of
+// the message in a single buffer, so that they can be sent with one write.
+// the data is copied from the slices directly into the chunks
+inline std::unique_ptr<basics::StringBuffer> createChunksForNetwork(
+    std::vector<VPackSlice> const& slices, uint64_t messageid,
+    std::size_t maxChunkBytes, ProtocolVersion protocolVersion) {
+  /// variables used in this function
+  std::size_t payloadLength = 0;
 
-  auto buffer =
-      std::make_unique<StringBuffer>(chunkLength, false);
+  // find out the uncompressed payload length
+  for (auto const& slice : slices) {
+    try {
+      LOG_TOPIC(TRACE, Logger::COMMUNICATION) << slice.toJson() << " , "
+                                              << slice.byteSize();
+    } catch (...) {
+    }
+    payloadLength += slice.byteSize();
+  }
 
-  appendLittleEndian(buffer.get(), chunkLength);
-  appendLittleEndian(buffer.get(), chunk);
-  appendLittleEndian(buffer.get(), id);
+  bool sendTotalLen = protocolVersion != ProtocolVersion::VST_1_0;
+  size_t chl = chunkHeaderLength(sendTotalLen);
 
-  if (sendTotalLen) {
-    appendLittleEndian(buffer.get(), totalMessageLength);
+  if (payloadLength < maxChunkBytes - chl) {
+    // one chunk uncompressed
+    auto buffer =
+        std::make_unique<basics::StringBuffer>(chl + payloadLength, false);
+    appendChunkForNetwork(buffer.get(), slices, 0, payloadLength, true, 1,
+                          messageid, protocolVersion, chl + payloadLength);
+    return buffer;
   }
 
-  buffer->appendText(data + begin, dataLength);
+  // here we enter the domain of multichunck
+  LOG_TOPIC(DEBUG, Logger::COMMUNICATION)
+      << "VstCommTask: sending multichunk message";
 
-  return buffer;
-}
-
-// this function will be called when we send multiple compressed
-// or uncompressed chunks
-inline void send_many(
-    std::vector<std::unique_ptr<basics::StringBuffer>>& resultVecRef,
-    uint64_t id, std::size_t maxChunkBytes,
-    std::unique_ptr<basics::StringBuffer> completeMessage,
-    std::size_t uncompressedCompleteMessageLength,
-    ProtocolVersion protocolVersion) {
-  uint64_t totalLen = completeMessage->length();
-  std::size_t offsetBegin = 0;
+  uint64_t totalLen = payloadLength;
   std::size_t offsetEnd = maxChunkBytes - chunkHeaderLength(true);
   // maximum number of bytes for follow up chunks
   std::size_t maxBytes = maxChunkBytes - chunkHeaderLength(false);
@@ -177,84 +162,29 @@ inline void send_many(
     }
   }
 
+  auto buffer = std::make_unique<basics::StringBuffer>(
+      payloadLength + numberOfChunks * chunkHeaderLength(true), false);
+
   // send first
-  resultVecRef.push_back(
-      createChunkForNetworkDetail(completeMessage->c_str(), offsetBegin,
-                                  offsetEnd, true, numberOfChunks, id,
-                                  protocolVersion, totalLen));
+  appendChunkForNetwork(buffer.get(), slices, 0, offsetEnd, true,
+                        numberOfChunks, messageid, protocolVersion, totalLen);
 
   std::uint32_t chunkNumber = 0;
   while (offsetEnd + maxBytes <= totalLen) {
     // send middle
-    offsetBegin = offsetEnd;
+    std::size_t offsetBegin = offsetEnd;
     offsetEnd += maxBytes;
     chunkNumber++;
-    resultVecRef.push_back(createChunkForNetworkDetail(
-        completeMessage->c_str(), offsetBegin, offsetEnd, false, chunkNumber,
-        id, protocolVersion, totalLen));
+    appendChunkForNetwork(buffer.get(), slices, offsetBegin, offsetEnd, false,
+                          chunkNumber, messageid, protocolVersion, totalLen);
   }
 
   if (offsetEnd < totalLen) {
-    resultVecRef.push_back(createChunkForNetworkDetail(
-        completeMessage->c_str(), offsetEnd, totalLen, false, ++chunkNumber,
-        id, protocolVersion, totalLen));
+    appendChunkForNetwork(buffer.get(), slices, offsetEnd, totalLen, false,
+                          ++chunkNumber, messageid, protocolVersion, totalLen);
   }
 
-  return;
-}
-
-// this function will be called by client code
-inline std::vector<std::unique_ptr<basics::StringBuffer>> createChunkForNetwork(
-    std::vector<VPackSlice> const& slices, uint64_t messageid,
-    std::size_t maxChunkBytes, ProtocolVersion protocolVersion) {
-  /// variables used in this function
-  std::size_t payloadLength = 0;
-
-  std::vector<std::unique_ptr<basics::StringBuffer>> rv;
-
-  // find out the uncompressed payload length
-  for (auto const& slice : slices) {
-    payloadLength += slice.byteSize();
-  }
-
-  bool sendTotalLen = protocolVersion != ProtocolVersion::VST_1_0;
-  size_t chl = chunkHeaderLength(sendTotalLen);
-
-  if (payloadLength < maxChunkBytes - chl) {
-    // one chunk uncompressed
-    rv.push_back(createChunkForNetworkDetail(slices, true, 1, messageid,
-                 protocolVersion, chl + payloadLength));
-    return rv;
-  } else {
-    // here we enter the domain of multichunck
-    LOG_TOPIC(DEBUG, Logger::COMMUNICATION)
-        << "VstCommTask: sending multichunk message";
-
-    // TODO: test if we have smaller slices that fit into chunks
-
-    LOG_TOPIC(DEBUG, Logger::COMMUNICATION)
-        << "VstCommTask: there are slices that do not fit into a single "
-           "totalMessageLength or compression is enabled";
-    // we have big slices that do not fit into single chunks
-    // now we will build one big buffer and split it into pieces
-
-    // reserve buffer
-    auto vstPayload = std::make_unique<basics::StringBuffer>(
-        payloadLength, false);
-
-    // fill buffer
-    for (auto const& slice : slices) {
-      try{
-        LOG_TOPIC(TRACE, Logger::COMMUNICATION) << slice.toJson() << " , " << slice.byteSize();
-      } catch(...){}
-      vstPayload->appendText(slice.startAs<char>(), slice.byteSize());
-    }
-
-    // create chunks
-    send_many(rv, messageid, maxChunkBytes, std::move(vstPayload),
-              payloadLength, protocolVersion);
-  }
-  return rv;
+  return buffer;
 }
 
 }
@@ -37,6 +37,7 @@
 #include "Geo/GeoJson.h"
 #include "Geo/GeoParams.h"
 #include "Geo/GeoUtils.h"
+#include "Geo/ShapeCache.h"
 #include "Geo/ShapeContainer.h"
 
 namespace arangodb {
@@ -233,7 +234,7 @@ void Index::handleNode(aql::AstNode const* node, aql::Variable const* ref,
       // arrays can't occur only handle real GeoJSON
       VPackBuilder bb;
       geoJson->toVelocyPackValue(bb);
-      Result res = geo::geojson::parseRegion(bb.slice(), qp.filterShape);
+      Result res = geo::ShapeCache::instance().parseRegion(bb.slice(), qp.filterShape);
       if (res.fail()) {
         THROW_ARANGO_EXCEPTION(res);
       }
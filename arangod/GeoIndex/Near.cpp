@@ -63,6 +63,19 @@ NearUtils<CMP>::NearUtils(geo::QueryParams&& qp) noexcept
   TRI_ASSERT(!isAscending() || _params.ascending);
   TRI_ASSERT(!isDescending() || !_params.ascending);
 
+  if (isFilterContains() && _params.filterShape.isAreaType()) {
+    // only candidates on the boundary of the shape need the exact test
+    try {
+      S2RegionCoverer::Options opts = _params.cover.regionCovererOpts();
+      opts.set_max_cells(kMaxInteriorCoverCells);
+      S2RegionCoverer coverer(opts);
+      _interior = coverer.GetInteriorCovering(*_params.filterShape.region());
+    } catch (...) {
+      // not fatal, test every candidate exactly
+      _interior = S2CellUnion();
+    }
+  }
+
   /*LOG_TOPIC(ERR, Logger::FIXME)
       << "--------------------------------------------------------";
   LOG_TOPIC(INFO, Logger::FIXME) << "[Near] origin target: "
@@ -271,16 +284,19 @@ void NearUtils<CMP>::reportFound(LocalDocumentId lid,
   }
 
   // possibly expensive point rejection, but saves parsing of document
+  bool contained = false;
   if (isFilterContains()) {
     TRI_ASSERT(!_params.filterShape.empty());
-    if (!_params.filterShape.contains(center)) {
+    contained = !_interior.empty() && _interior.Contains(center);
+    if (!contained && !_params.filterShape.contains(center)) {
       _rejection++;
       return;
     }
   }
   _found++;
   _statsFoundLastInterval++;  // we have to estimate scan bounds
-  _buffer.emplace(lid, angle);
+  // only for points the centroid is the whole document
+  _buffer.emplace(lid, angle, contained && _params.pointsOnly);
 }
 
 /// called after current intervals were scanned
@@ -296,6 +312,27 @@ void NearUtils<CMP>::didScanIntervals() {
 template <typename CMP>
 void NearUtils<CMP>::estimateDelta() {
   S1ChordAngle minBound = S1ChordAngle::Radians(S2::kMaxDiag.GetValue(S2::kMaxCellLevel - 3));
+  if (isAscending() && _params.limit > 0 && _found > 0 &&
+      _found < _params.limit) {
+    // the area of a cap is proportional to the squared chord length, use the
+    // density observed so far to size the next ring so that it probably
+    // contains the remaining results of the LIMIT, with some headroom
+    double scanned = _outerAngle.length2() - _minAngle.length2();
+    double fac = static_cast<double>(_params.limit) * 1.25 /
+                 static_cast<double>(_found);
+    if (scanned > 0.0 && fac > 1.0) {
+      // never grow faster than the fallback below would for an empty ring
+      fac = std::min(fac, 16.0);
+      S1ChordAngle target = S1ChordAngle::FromLength2(
+          std::min(_minAngle.length2() + scanned * fac, 4.0));
+      if (target > _outerAngle) {
+        _deltaAngle = std::max(target - _outerAngle, minBound);
+        _statsFoundLastInterval = 0;
+        return;
+      }
+    }
+  }
+
   if (_statsFoundLastInterval <= 64) {
     _deltaAngle = S1ChordAngle::FromLength2(_deltaAngle.length2() * 4);
   } else if (_statsFoundLastInterval <= 256) {
@@ -29,6 +29,7 @@
 
 #include <s2/s2cap.h>
 #include <s2/s2cell_id.h>
+#include <s2/s2cell_union.h>
 #include <s2/s2region.h>
 #include <s2/s2region_coverer.h>
 
@@ -45,12 +46,15 @@ namespace geo_index {
 
 /// result of a geospatial index query. distance may or may not be set
 struct Document {
-  Document(LocalDocumentId d, S1ChordAngle angle)
-      : token(d), distAngle(angle) {}
+  Document(LocalDocumentId d, S1ChordAngle angle, bool contained = false)
+      : token(d), distAngle(angle), contained(contained) {}
   /// @brief LocalDocumentId
   LocalDocumentId token;
   /// @brief distance from centroids on the unit sphere
   S1ChordAngle distAngle;
+  /// @brief document is a point in the interior of the CONTAINS filter
+  /// shape, the exact test of the document can be skipped
+  bool contained;
 };
 
 struct DocumentsAscending {
@@ -80,6 +84,8 @@ class NearUtils {
   static constexpr bool isDescending() {
     return std::is_same<CMP, DocumentsDescending>::value;
   }
+  /// @brief max number of cells in the interior covering of a filter shape
+  static constexpr int kMaxInteriorCoverCells = 64;
 
  public:
   /// @brief Type of documents buffer
@@ -211,6 +217,10 @@ class NearUtils {
   // deduplication filter
   std::unordered_set<uint64_t> _seenDocs;
 
+  /// Cells in the interior of a CONTAINS filter shape, points in them
+  /// need no exact containment test
+  S2CellUnion _interior;
+
   /// Track the already scanned region
   std::vector<S2CellId> _scannedCells;
   /// Coverer instance to use
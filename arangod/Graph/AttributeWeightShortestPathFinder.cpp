@@ -25,6 +25,8 @@
 
 #include "Basics/Exceptions.h"
 #include "Basics/StringRef.h"
+#include "Cluster/ServerState.h"
+#include "Geo/GeoParams.h"
 #include "Graph/EdgeCursor.h"
 #include "Graph/EdgeDocumentToken.h"
 #include "Graph/ShortestPathOptions.h"
@@ -36,9 +38,25 @@
 #include <velocypack/Slice.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <cmath>
+
 using namespace arangodb;
 using namespace arangodb::graph;
 
+namespace {
+/// @brief great circle distance in meters
+double distance(double lat1, double lon1, double lat2, double lon2) {
+  double const toRadians = M_PI / 180.0;
+  double const dLat = (lat2 - lat1) * toRadians;
+  double const dLon = (lon2 - lon1) * toRadians;
+  double const a = std::sin(dLat / 2) * std::sin(dLat / 2) +
+                   std::cos(lat1 * toRadians) * std::cos(lat2 * toRadians) *
+                       std::sin(dLon / 2) * std::sin(dLon / 2);
+  return 2.0 * geo::kEarthRadiusInMeters *
+         std::atan2(std::sqrt(a), std::sqrt(1.0 - a));
+}
+}  // namespace
+
 AttributeWeightShortestPathFinder::Step::Step(
     arangodb::StringRef const& vert, arangodb::StringRef const& pred,
     double weig, EdgeDocumentToken&& edge)
@@ -142,8 +160,12 @@ bool AttributeWeightShortestPathFinder::Searcher::oneStep() {
 
   std::vector<Step*> neighbors;
   _pathFinder->expandVertex(_isBackward, v, neighbors);
+  if (_pathFinder->_useHeuristic) {
+    _pathFinder->fetchCoordinates(neighbors);
+  }
   for (Step* neighbor : neighbors) {
-    insertNeighbor(neighbor, s->weight() + neighbor->weight());
+    insertNeighbor(neighbor, s->weight() + _pathFinder->reducedWeight(
+                                               _isBackward, v, neighbor));
   }
   lookupPeer(v, s->weight());
 
@@ -163,6 +185,9 @@ AttributeWeightShortestPathFinder::AttributeWeightShortestPathFinder(
       _resultCode(TRI_ERROR_NO_ERROR),
       _intermediateSet(false),
       _intermediate(),
+      _useHeuristic(false),
+      _startCoordinates{0, 0, false},
+      _targetCoordinates{0, 0, false},
       _mmdr(new ManagedDocumentResult{}),
       _options(options) {}
 
@@ -182,6 +207,15 @@ bool AttributeWeightShortestPathFinder::shortestPath(
   StringRef start = _options->cache()->persistString(StringRef(st));
   StringRef target = _options->cache()->persistString(StringRef(ta));
 
+  // A* needs the positions of both ends, otherwise this is a Dijkstra
+  _useHeuristic = false;
+  if (_options->useHeuristic()) {
+    _options->fetchVerticesCoordinator(std::deque<StringRef>({start, target}));
+    _startCoordinates = coordinates(start);
+    _targetCoordinates = coordinates(target);
+    _useHeuristic = _startCoordinates.valid && _targetCoordinates.valid;
+  }
+
   // Forward with initialization:
   arangodb::StringRef emptyVertex;
   ThreadInfo forward;
@@ -253,6 +287,80 @@ bool AttributeWeightShortestPathFinder::shortestPath(
   return true;
 }
 
+AttributeWeightShortestPathFinder::Coordinates const&
+AttributeWeightShortestPathFinder::coordinates(StringRef const& vertex) {
+  auto it = _coordinates.find(vertex);
+  if (it != _coordinates.end()) {
+    return it->second;
+  }
+  Coordinates c{0, 0, false};
+  aql::AqlValue document = _options->cache()->fetchVertexAqlResult(vertex);
+  VPackSlice position =
+      document.slice().isObject()
+          ? document.slice().get(_options->heuristicAttribute)
+          : VPackSlice::noneSlice();
+  if (position.isArray() && position.length() == 2 &&
+      position.at(0).isNumber() && position.at(1).isNumber()) {
+    c.latitude = position.at(0).getNumber<double>();
+    c.longitude = position.at(1).getNumber<double>();
+    c.valid = true;
+  }
+  document.destroy();
+  return _coordinates.emplace(vertex, c).first->second;
+}
+
+void AttributeWeightShortestPathFinder::fetchCoordinates(
+    std::vector<Step*> const& neighbors) {
+  if (!ServerState::instance()->isCoordinator()) {
+    // the documents are local, they are read one by one
+    return;
+  }
+  std::deque<StringRef> fetch;
+  for (Step const* neighbor : neighbors) {
+    if (_coordinates.find(neighbor->_vertex) == _coordinates.end()) {
+      fetch.emplace_back(neighbor->_vertex);
+    }
+  }
+  if (!fetch.empty()) {
+    _options->fetchVerticesCoordinator(fetch);
+  }
+}
+
+double AttributeWeightShortestPathFinder::potential(StringRef const& vertex) {
+  Coordinates const& c = coordinates(vertex);
+  if (!c.valid) {
+    // without coordinates the lower bound is 0, the search is correct as
+    // long as the heuristic stays consistent along the edges
+    return 0.0;
+  }
+  double const toTarget =
+      _options->heuristicFactor *
+      distance(c.latitude, c.longitude, _targetCoordinates.latitude,
+               _targetCoordinates.longitude);
+  if (!_options->bidirectional) {
+    return toTarget;
+  }
+  double const fromStart =
+      _options->heuristicFactor *
+      distance(_startCoordinates.latitude, _startCoordinates.longitude,
+               c.latitude, c.longitude);
+  return (toTarget - fromStart) / 2.0;
+}
+
+double AttributeWeightShortestPathFinder::reducedWeight(
+    bool isBackward, StringRef const& vertex, Step const* neighbor) {
+  if (!_useHeuristic) {
+    return neighbor->weight();
+  }
+  double difference = potential(neighbor->_vertex) - potential(vertex);
+  if (isBackward) {
+    difference = -difference;
+  }
+  // a consistent heuristic keeps the reduced weights non-negative, up to
+  // rounding
+  return (std::max)(0.0, neighbor->weight() + difference);
+}
+
 void AttributeWeightShortestPathFinder::inserter(
     std::unordered_map<StringRef, size_t>& candidates,
     std::vector<Step*>& result, StringRef const& s, StringRef const& t,
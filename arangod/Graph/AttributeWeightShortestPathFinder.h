@@ -282,6 +282,54 @@ class AttributeWeightShortestPathFinder : public ShortestPathFinder {
   bool _intermediateSet;
   arangodb::StringRef _intermediate;
 
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief position of a vertex for the A* heuristic, valid is false if the
+  /// vertex has no coordinates
+  //////////////////////////////////////////////////////////////////////////////
+
+  struct Coordinates {
+    double latitude;
+    double longitude;
+    bool valid;
+  };
+
+  Coordinates const& coordinates(arangodb::StringRef const& vertex);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief fetch the new neighbors from the DB servers in one go, before
+  /// their coordinates are needed
+  //////////////////////////////////////////////////////////////////////////////
+
+  void fetchCoordinates(std::vector<Step*> const& neighbors);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief potential of a vertex for the forward search, the backward search
+  /// uses its negation. with both searches it is the average of the lower
+  /// bounds to the target and from the start, so that both searches work on
+  /// the same reduced edge weights
+  //////////////////////////////////////////////////////////////////////////////
+
+  double potential(arangodb::StringRef const& vertex);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief weight of the edge to the neighbor, reduced by the potentials.
+  /// without a heuristic, this is the weight of the edge
+  //////////////////////////////////////////////////////////////////////////////
+
+  double reducedWeight(bool isBackward, arangodb::StringRef const& vertex,
+                       Step const* neighbor);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether the current search uses the A* heuristic, and the
+  /// positions of its start and target vertex
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool _useHeuristic;
+  Coordinates _startCoordinates;
+  Coordinates _targetCoordinates;
+  std::unordered_map<arangodb::StringRef, Coordinates> _coordinates;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Reusable ManagedDocumentResult that temporarily takes
   ///        responsibility for one document.
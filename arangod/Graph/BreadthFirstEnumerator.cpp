@@ -28,6 +28,9 @@
 #include "Graph/TraverserCache.h"
 #include "Graph/Traverser.h"
 #include "Graph/TraverserOptions.h"
+#include "Transaction/Helpers.h"
+
+#include <numeric>
 
 #include <velocypack/Slice.h>
 #include <velocypack/velocypack-aliases.h>
@@ -58,7 +61,9 @@ BreadthFirstEnumerator::BreadthFirstEnumerator(Traverser* traverser,
       _schreierIndex(1),
       _lastReturned(0),
       _currentDepth(0),
-      _toSearchPos(0) {
+      _toSearchPos(0),
+      _prefetchBegin(0),
+      _prefetchEnd(0) {
   _schreier.reserve(32);
   StringRef startVId = _opts->cache()->persistString(StringRef(startVertex));
 
@@ -108,6 +113,8 @@ bool BreadthFirstEnumerator::next() {
       _toSearch.clear();
       _toSearchPos = 0;
       _toSearch.swap(_nextDepth);
+      _prefetchBegin = 0;
+      _prefetchEnd = 0;
       _currentDepth++;
       TRI_ASSERT(_toSearchPos < _toSearch.size());
       TRI_ASSERT(_nextDepth.empty());
@@ -117,54 +124,42 @@ bool BreadthFirstEnumerator::next() {
     // If not it should have bailed out before.
     TRI_ASSERT(_toSearchPos < _toSearch.size());
 
-    _tmpEdges.clear();
+    if (_toSearchPos >= _prefetchEnd) {
+      prefetchEdges();
+    }
+    TRI_ASSERT(_toSearchPos >= _prefetchBegin && _toSearchPos < _prefetchEnd);
+
+    auto& edges = _prefetched[_toSearchPos - _prefetchBegin];
     auto const nextIdx = _toSearch[_toSearchPos++].sourceIdx;
     auto const nextVertex = _schreier[nextIdx]->vertex;
     StringRef vId;
 
-    std::unique_ptr<EdgeCursor> cursor(
-        _opts->nextCursor(_traverser->mmdr(), nextVertex, _currentDepth));
-    if (cursor != nullptr) {
-      bool shouldReturnPath = _currentDepth + 1 >= _opts->minDepth;
-      bool didInsert = false;
-
-      auto callback = [&](graph::EdgeDocumentToken&& eid,
-                          VPackSlice e, size_t cursorIdx) -> void {
-        
-        if (_opts->hasEdgeFilter(_currentDepth, cursorIdx)) {
-          VPackSlice edge = e;
-          if (edge.isString()) {
-            edge = _opts->cache()->lookupToken(eid);
-          }
-          if (!_traverser->edgeMatchesConditions(edge, nextVertex, _currentDepth,
-                                                 cursorIdx)) {
-            return;
-          }
-        }
+    bool shouldReturnPath = _currentDepth + 1 >= _opts->minDepth;
+    bool didInsert = false;
 
-        if (_traverser->getSingleVertex(e, nextVertex, _currentDepth + 1, vId)) {
-          _schreier.emplace_back(
-              std::make_unique<PathStep>(nextIdx, std::move(eid), vId));
-          if (_currentDepth < _opts->maxDepth - 1) {
-            _nextDepth.emplace_back(NextStep(_schreierIndex));
-          }
-          _schreierIndex++;
-          didInsert = true;
+    for (auto& it : edges) {
+      VPackSlice other(_prefetchedVertices.start() + it.vertexOffset);
+      if (_traverser->getSingleVertex(other, nextVertex, _currentDepth + 1, vId)) {
+        _schreier.emplace_back(
+            std::make_unique<PathStep>(nextIdx, std::move(it.edge), vId));
+        if (_currentDepth < _opts->maxDepth - 1) {
+          _nextDepth.emplace_back(NextStep(_schreierIndex));
         }
-      };
-
-      cursor->readAll(callback);
-
-      if (!shouldReturnPath) {
-        _lastReturned = _schreierIndex;
-        didInsert = false;
-      }
-      if (didInsert) {
-        // We exit the loop here.
-        // _schreierIndex is moved forward
-        break;
+        _schreierIndex++;
+        didInsert = true;
       }
     }
+    edges.clear();
+
+    if (!shouldReturnPath) {
+      _lastReturned = _schreierIndex;
+      didInsert = false;
+    }
+    if (didInsert) {
+      // We exit the loop here.
+      // _schreierIndex is moved forward
+      break;
+    }
     // Nothing found for this vertex.
     // _toSearchPos is increased so
     // we are not stuck in an endless loop
@@ -175,6 +170,66 @@ bool BreadthFirstEnumerator::next() {
   return true;
 }
 
+void BreadthFirstEnumerator::prefetchEdges() {
+  TRI_ASSERT(_toSearchPos < _toSearch.size());
+  _prefetchBegin = _toSearchPos;
+  _prefetchEnd = (std::min)(_toSearch.size(), _toSearchPos + PrefetchBatchSize);
+  size_t const n = _prefetchEnd - _prefetchBegin;
+
+  _prefetched.resize(n);
+  for (auto& it : _prefetched) {
+    it.clear();
+  }
+  _prefetchedVertices.clear();
+
+  std::vector<size_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  if (n > 1) {
+    std::sort(order.begin(), order.end(), [this](size_t lhs, size_t rhs) {
+      return _schreier[_toSearch[_prefetchBegin + lhs].sourceIdx]->vertex.compare(
+                 _schreier[_toSearch[_prefetchBegin + rhs].sourceIdx]->vertex) < 0;
+    });
+  }
+
+  for (size_t const i : order) {
+    StringRef const vertex = _schreier[_toSearch[_prefetchBegin + i].sourceIdx]->vertex;
+    std::unique_ptr<EdgeCursor> cursor(
+        _opts->nextCursor(_traverser->mmdr(), vertex, _currentDepth));
+    if (cursor == nullptr) {
+      continue;
+    }
+    auto& edges = _prefetched[i];
+
+    auto callback = [&](graph::EdgeDocumentToken&& eid,
+                        VPackSlice e, size_t cursorIdx) -> void {
+      if (_opts->hasEdgeFilter(_currentDepth, cursorIdx)) {
+        VPackSlice edge = e;
+        if (edge.isString()) {
+          edge = _opts->cache()->lookupToken(eid);
+        }
+        if (!_traverser->edgeMatchesConditions(edge, vertex, _currentDepth,
+                                               cursorIdx)) {
+          return;
+        }
+      }
+
+      // only keep the id of the connected vertex, the edge document may
+      // not stay valid until the edge is processed
+      VPackSlice other = e;
+      if (!other.isString()) {
+        other = transaction::helpers::extractFromFromDocument(e);
+        if (other.compareString(vertex.data(), vertex.length()) == 0) {
+          other = transaction::helpers::extractToFromDocument(e);
+        }
+      }
+      edges.emplace_back(std::move(eid), _prefetchedVertices.size());
+      _prefetchedVertices.add(other);
+    };
+
+    cursor->readAll(callback);
+  }
+}
+
 arangodb::aql::AqlValue BreadthFirstEnumerator::lastVertexToAqlValue() {
   TRI_ASSERT(_lastReturned < _schreier.size());
   return _traverser->fetchVertexData(_schreier[_lastReturned]->vertex);
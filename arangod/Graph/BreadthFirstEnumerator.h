@@ -27,6 +27,8 @@
 #include "Basics/Common.h"
 #include "Graph/PathEnumerator.h"
 
+#include <velocypack/Builder.h>
+
 namespace arangodb {
 
 namespace traverser {
@@ -74,6 +76,26 @@ class BreadthFirstEnumerator final
     explicit NextStep(size_t sourceIdx) : sourceIdx(sourceIdx) {}
   };
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief An edge read ahead for a vertex of the current depth, together
+  ///        with the offset of the connected vertex id in _prefetchedVertices
+  //////////////////////////////////////////////////////////////////////////////
+
+  struct PrefetchedEdge {
+    graph::EdgeDocumentToken edge;
+    size_t vertexOffset;
+
+    PrefetchedEdge(graph::EdgeDocumentToken&& edge, size_t vertexOffset)
+        : edge(std::move(edge)), vertexOffset(vertexOffset) {}
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Maximum number of vertices of one depth whose edges are read
+  ///        ahead together
+  //////////////////////////////////////////////////////////////////////////////
+
+  static constexpr size_t PrefetchBatchSize = 1000;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief schreier vector to store the visited vertices
   //////////////////////////////////////////////////////////////////////////////
@@ -104,12 +126,6 @@ class BreadthFirstEnumerator final
 
   std::vector<NextStep> _toSearch;
 
-  //////////////////////////////////////////////////////////////////////////////
-  /// @brief Vector storing the position at current search depth
-  //////////////////////////////////////////////////////////////////////////////
-
-  std::unordered_set<arangodb::velocypack::Slice> _tmpEdges;
-
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Marker for the search depth. Used to abort searching.
   //////////////////////////////////////////////////////////////////////////////
@@ -123,6 +139,23 @@ class BreadthFirstEnumerator final
 
   size_t _toSearchPos;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Edges read ahead for the vertices in _toSearch between
+  ///        _prefetchBegin and _prefetchEnd, by their position in _toSearch
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<std::vector<PrefetchedEdge>> _prefetched;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Ids of the vertices connected by the prefetched edges
+  //////////////////////////////////////////////////////////////////////////////
+
+  arangodb::velocypack::Builder _prefetchedVertices;
+
+  size_t _prefetchBegin;
+
+  size_t _prefetchEnd;
+
  public:
   BreadthFirstEnumerator(arangodb::traverser::Traverser* traverser,
                          arangodb::velocypack::Slice startVertex,
@@ -158,6 +191,15 @@ class BreadthFirstEnumerator final
   //////////////////////////////////////////////////////////////////////////////
 
   void computeEnumeratedPath(size_t index);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Read the edges of the next batch of vertices in _toSearch.
+  ///        The vertices are looked up in the order of their ids, so that
+  ///        the edge index is scanned front to back instead of seeking back
+  ///        and forth, but the edges are kept in the order of _toSearch.
+  //////////////////////////////////////////////////////////////////////////////
+
+  void prefetchEdges();
 };
 }
 }
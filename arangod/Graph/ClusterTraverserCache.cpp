@@ -92,3 +92,11 @@ void ClusterTraverserCache::insertVertexIntoResult(StringRef id,
     result.add(it->second);
   }
 }
+
+std::string ClusterTraverserCache::localEdgesKey(StringRef vertexId,
+                                                 uint64_t depth) {
+  std::string key = std::to_string(depth);
+  key.push_back(':');
+  key.append(vertexId.data(), vertexId.length());
+  return key;
+}
@@ -98,6 +98,15 @@ class ClusterTraverserCache : public TraverserCache {
   size_t& filteredDocuments() {
     return _filteredDocuments;
   }
+
+  /// Edges of vertices the DBServers have expanded on their own,
+  /// by depth and _id of the vertex (see localEdgesKey)
+  std::unordered_map<std::string, std::vector<arangodb::velocypack::Slice>>&
+  localEdges() {
+    return _localEdges;
+  }
+
+  static std::string localEdgesKey(StringRef vertexId, uint64_t depth);
   
  private:
 
@@ -105,6 +114,10 @@ class ClusterTraverserCache : public TraverserCache {
   std::unordered_map<StringRef, arangodb::velocypack::Slice> _cache;
   /// @brief dump for our edge and vertex documents
   std::vector<std::shared_ptr<arangodb::velocypack::Builder>> _datalake;
+  /// @brief edges of vertices expanded by the DBServers, pointing
+  /// into our data dump
+  std::unordered_map<std::string, std::vector<arangodb::velocypack::Slice>>
+      _localEdges;
   std::unordered_map<ServerID, traverser::TraverserEngineID> const* _engines;
 };
 
@@ -0,0 +1,299 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "KShortestPathsFinder.h"
+
+#include "Graph/EdgeCursor.h"
+#include "Graph/ShortestPathOptions.h"
+#include "Graph/ShortestPathResult.h"
+#include "Graph/TraverserCache.h"
+#include "Transaction/Helpers.h"
+#include "VocBase/ManagedDocumentResult.h"
+
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::graph;
+
+/// @brief whether or not the first length vertices equal those of other
+bool KShortestPathsFinder::Path::sharesPrefix(Path const& other,
+                                              size_t length) const {
+  if (vertices.size() < length || other.vertices.size() < length) {
+    return false;
+  }
+  for (size_t i = 0; i < length; ++i) {
+    if (vertices[i] != other.vertices[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+KShortestPathsFinder::KShortestPathsFinder(ShortestPathOptions* options)
+    : _options(options), _mmdr(new ManagedDocumentResult{}), _done(true) {}
+
+KShortestPathsFinder::~KShortestPathsFinder() {}
+
+/// @brief find only the shortest path between start and target
+bool KShortestPathsFinder::shortestPath(VPackSlice const& start,
+                                        VPackSlice const& target,
+                                        ShortestPathResult& result,
+                                        std::function<void()> const& callback) {
+  startKShortestPathsTraversal(start, target);
+  return getNextPath(result, callback);
+}
+
+/// @brief start enumerating the paths between start and target
+void KShortestPathsFinder::startKShortestPathsTraversal(VPackSlice const& start,
+                                                        VPackSlice const& target) {
+  TRI_ASSERT(start.isString());
+  TRI_ASSERT(target.isString());
+  _start = _options->cache()->persistString(StringRef(start));
+  _target = _options->cache()->persistString(StringRef(target));
+  _paths.clear();
+  _candidates.clear();
+  _neighbors.clear();
+  _done = false;
+}
+
+/// @brief return the next path, with a weight not lower than that of the
+/// paths returned before
+bool KShortestPathsFinder::getNextPath(ShortestPathResult& result,
+                                       std::function<void()> const& callback) {
+  result.clear();
+  if (_done) {
+    return false;
+  }
+
+  if (_paths.empty()) {
+    Path path;
+    if (!computeShortestPath(_start, {}, {}, path, callback)) {
+      _done = true;
+      return false;
+    }
+    _paths.emplace_back(std::move(path));
+  } else if (!computeNextPath(callback)) {
+    _done = true;
+    return false;
+  }
+
+  fillResult(_paths.back(), result);
+  return true;
+}
+
+/// @brief compute the next path from the spur paths of the last path
+bool KShortestPathsFinder::computeNextPath(std::function<void()> const& callback) {
+  TRI_ASSERT(!_paths.empty());
+  Path const& last = _paths.back();
+
+  std::unordered_set<StringRef> excludedVertices;
+  std::unordered_map<StringRef, std::unordered_set<StringRef>> excludedEdges;
+
+  // every vertex of the last path but the target can be the spur vertex,
+  // where a new path branches off from the last one
+  for (size_t i = 0; i + 1 < last.vertices.size(); ++i) {
+    StringRef const spur = last.vertices[i];
+
+    // the new path must not take an edge from the spur vertex that a path
+    // with the same root took before
+    excludedEdges.clear();
+    for (auto const& path : _paths) {
+      if (path.sharesPrefix(last, i + 1) && path.vertices.size() > i + 1) {
+        excludedEdges[spur].emplace(path.vertices[i + 1]);
+      }
+    }
+
+    Path spurPath;
+    if (computeShortestPath(spur, excludedVertices, excludedEdges, spurPath,
+                            callback)) {
+      Path candidate;
+      candidate.vertices.assign(last.vertices.begin(), last.vertices.begin() + i);
+      candidate.weights.assign(last.weights.begin(), last.weights.begin() + i);
+      for (size_t j = 0; j < i; ++j) {
+        candidate.edges.emplace_back(last.edges[j]);
+      }
+      double const rootWeight = last.weights[i];
+      for (size_t j = 0; j < spurPath.vertices.size(); ++j) {
+        candidate.vertices.emplace_back(spurPath.vertices[j]);
+        candidate.weights.emplace_back(rootWeight + spurPath.weights[j]);
+      }
+      for (auto const& edge : spurPath.edges) {
+        candidate.edges.emplace_back(edge);
+      }
+
+      bool known = false;
+      for (auto const& path : _candidates) {
+        if (path.vertices.size() == candidate.vertices.size() &&
+            path.sharesPrefix(candidate, candidate.vertices.size())) {
+          known = true;
+          break;
+        }
+      }
+      if (!known) {
+        _candidates.emplace_back(std::move(candidate));
+      }
+    }
+
+    // the root of the next spur path includes this vertex, so the spur
+    // path must not visit it again
+    excludedVertices.emplace(spur);
+  }
+
+  if (_candidates.empty()) {
+    return false;
+  }
+
+  auto best = _candidates.begin();
+  for (auto it = _candidates.begin(); it != _candidates.end(); ++it) {
+    if ((*it).weight() < (*best).weight()) {
+      best = it;
+    }
+  }
+  _paths.emplace_back(std::move(*best));
+  _candidates.erase(best);
+  return true;
+}
+
+/// @brief find the shortest path from start to the target, avoiding the
+/// excluded vertices and edges. this is Dijkstra's algorithm, which the
+/// priority queue shared with the other finders supports
+bool KShortestPathsFinder::computeShortestPath(
+    StringRef const& start, std::unordered_set<StringRef> const& excludedVertices,
+    std::unordered_map<StringRef, std::unordered_set<StringRef>> const& excludedEdges,
+    Path& result, std::function<void()> const& callback) {
+  PQueue queue;
+  queue.insert(start, new Step(start, StringRef(), 0.0, EdgeDocumentToken()));
+
+  StringRef vertex;
+  Step* step = nullptr;
+  while (queue.popMinimal(vertex, step, true)) {
+    callback();
+    step->_done = true;
+
+    if (vertex == _target) {
+      // walk back along the predecessors
+      std::vector<Step const*> steps;
+      for (Step const* s = step; s != nullptr;
+           s = s->_predecessor.empty() ? nullptr : queue.find(s->_predecessor)) {
+        steps.emplace_back(s);
+      }
+      for (auto it = steps.rbegin(); it != steps.rend(); ++it) {
+        result.vertices.emplace_back((*it)->_vertex);
+        result.weights.emplace_back((*it)->weight());
+        if (it != steps.rbegin()) {
+          result.edges.emplace_back((*it)->_edge);
+        }
+      }
+      return true;
+    }
+
+    double const weight = step->weight();
+    auto excluded = excludedEdges.find(vertex);
+
+    for (auto const& neighbor : neighbors(vertex)) {
+      if (excludedVertices.find(neighbor.vertex) != excludedVertices.end() ||
+          (excluded != excludedEdges.end() &&
+           excluded->second.find(neighbor.vertex) != excluded->second.end())) {
+        continue;
+      }
+
+      double const newWeight = weight + neighbor.weight;
+      Step* other = queue.find(neighbor.vertex);
+      if (other == nullptr) {
+        auto s = std::make_unique<Step>(neighbor.vertex, vertex, newWeight,
+                                        neighbor.edge);
+        queue.insert(neighbor.vertex, s.get());
+        s.release();
+      } else if (!other->_done && newWeight < other->weight()) {
+        other->_predecessor = vertex;
+        other->_edge = EdgeDocumentToken(neighbor.edge);
+        queue.lowerWeight(neighbor.vertex, newWeight);
+      }
+    }
+  }
+
+  return false;
+}
+
+/// @brief the neighbors of a vertex. they are read once and then cached
+std::vector<KShortestPathsFinder::Neighbor> const& KShortestPathsFinder::neighbors(
+    StringRef const& vertex) {
+  auto it = _neighbors.find(vertex);
+  if (it != _neighbors.end()) {
+    return it->second;
+  }
+
+  std::vector<Neighbor> result;
+  std::unordered_map<StringRef, size_t> positions;
+
+  auto add = [&](StringRef const& other, EdgeDocumentToken&& edge,
+                 double weight) {
+    auto pos = positions.find(other);
+    if (pos == positions.end()) {
+      positions.emplace(other, result.size());
+      result.emplace_back(Neighbor{other, std::move(edge), weight});
+    } else if (weight < result[pos->second].weight) {
+      result[pos->second].edge = std::move(edge);
+      result[pos->second].weight = weight;
+    }
+  };
+
+  std::unique_ptr<EdgeCursor> cursor(_options->nextCursor(_mmdr.get(), vertex));
+  auto callback = [&](EdgeDocumentToken&& eid, VPackSlice edge,
+                      size_t /*cursorIdx*/) -> void {
+    if (edge.isString()) {
+      // the cursor only delivers the id of the other vertex
+      if (edge.compareString(vertex.data(), vertex.length()) != 0) {
+        double weight = 1.0;
+        if (_options->useWeight()) {
+          weight = _options->weightEdge(_options->cache()->lookupToken(eid));
+        }
+        add(_options->cache()->persistString(StringRef(edge)), std::move(eid),
+            weight);
+      }
+    } else {
+      StringRef other(transaction::helpers::extractFromFromDocument(edge));
+      if (other == vertex) {
+        other = StringRef(transaction::helpers::extractToFromDocument(edge));
+      }
+      if (other != vertex) {
+        double const weight =
+            _options->useWeight() ? _options->weightEdge(edge) : 1.0;
+        add(_options->cache()->persistString(other), std::move(eid), weight);
+      }
+    }
+  };
+  cursor->readAll(callback);
+
+  return _neighbors.emplace(vertex, std::move(result)).first->second;
+}
+
+/// @brief copy a path into the result
+void KShortestPathsFinder::fillResult(Path const& path,
+                                      ShortestPathResult& result) {
+  for (auto const& it : path.vertices) {
+    result._vertices.emplace_back(it);
+  }
+  for (auto const& it : path.edges) {
+    result._edges.emplace_back(it);
+  }
+  _options->fetchVerticesCoordinator(result._vertices);
+}
@@ -0,0 +1,164 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_GRAPH_K_SHORTEST_PATHS_FINDER_H
+#define ARANGODB_GRAPH_K_SHORTEST_PATHS_FINDER_H 1
+
+#include "Basics/Common.h"
+#include "Basics/StringRef.h"
+#include "Graph/EdgeDocumentToken.h"
+#include "Graph/ShortestPathFinder.h"
+#include "Graph/ShortestPathPriorityQueue.h"
+
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+
+class ManagedDocumentResult;
+
+namespace graph {
+
+struct ShortestPathOptions;
+
+/// @brief enumerates the shortest paths between two vertices in order of
+/// their weight, using Yen's algorithm. the first path is a plain shortest
+/// path. every following path branches off one of the paths found before,
+/// at a spur vertex, with the edges those paths take from there and their
+/// earlier vertices excluded from the search. paths never visit a vertex
+/// twice.
+/// the edges of every vertex are read only once per start and target pair,
+/// and are kept for all following searches, so that finding K paths reads
+/// the part of the graph around the paths only once
+class KShortestPathsFinder : public ShortestPathFinder {
+ private:
+  /// @brief an edge to a neighbor of a vertex. of several edges between the
+  /// same two vertices, only the one with the lowest weight is kept
+  struct Neighbor {
+    arangodb::StringRef vertex;
+    EdgeDocumentToken edge;
+    double weight;
+  };
+
+  /// @brief a path found, with the weight from the start up to each vertex
+  struct Path {
+    std::vector<arangodb::StringRef> vertices;
+    std::vector<EdgeDocumentToken> edges;
+    std::vector<double> weights;
+
+    double weight() const { return weights.back(); }
+
+    /// @brief whether or not the first length vertices equal those of other
+    bool sharesPrefix(Path const& other, size_t length) const;
+  };
+
+  /// @brief a vertex in the priority queue of a search
+  struct Step {
+    arangodb::StringRef _vertex;
+    arangodb::StringRef _predecessor;
+    EdgeDocumentToken _edge;
+    double _weight;
+    bool _done;
+
+    Step(arangodb::StringRef const& vertex,
+         arangodb::StringRef const& predecessor, double weight,
+         EdgeDocumentToken const& edge)
+        : _vertex(vertex),
+          _predecessor(predecessor),
+          _edge(edge),
+          _weight(weight),
+          _done(false) {}
+
+    double weight() const { return _weight; }
+    void setWeight(double weight) { _weight = weight; }
+    arangodb::StringRef const& getKey() const { return _vertex; }
+  };
+
+  typedef ShortestPathPriorityQueue<arangodb::StringRef, Step, double> PQueue;
+
+ public:
+  KShortestPathsFinder(KShortestPathsFinder const&) = delete;
+  KShortestPathsFinder& operator=(KShortestPathsFinder const&) = delete;
+
+  explicit KShortestPathsFinder(ShortestPathOptions* options);
+
+  ~KShortestPathsFinder();
+
+  /// @brief find only the shortest path between start and target
+  bool shortestPath(arangodb::velocypack::Slice const& start,
+                    arangodb::velocypack::Slice const& target,
+                    arangodb::graph::ShortestPathResult& result,
+                    std::function<void()> const& callback) override;
+
+  /// @brief start enumerating the paths between start and target. both
+  /// must be vertex id strings
+  void startKShortestPathsTraversal(arangodb::velocypack::Slice const& start,
+                                    arangodb::velocypack::Slice const& target);
+
+  /// @brief return the next path, with a weight not lower than that of the
+  /// paths returned before. returns false if there are no more paths
+  bool getNextPath(arangodb::graph::ShortestPathResult& result,
+                   std::function<void()> const& callback);
+
+ private:
+  /// @brief find the shortest path from start to the target, avoiding the
+  /// excluded vertices and edges. returns false if there is none
+  bool computeShortestPath(
+      arangodb::StringRef const& start,
+      std::unordered_set<arangodb::StringRef> const& excludedVertices,
+      std::unordered_map<arangodb::StringRef, std::unordered_set<arangodb::StringRef>> const&
+          excludedEdges,
+      Path& result, std::function<void()> const& callback);
+
+  /// @brief compute the next path from the spur paths of the last path
+  bool computeNextPath(std::function<void()> const& callback);
+
+  /// @brief the neighbors of a vertex. they are read once and then cached
+  std::vector<Neighbor> const& neighbors(arangodb::StringRef const& vertex);
+
+  /// @brief copy a path into the result
+  void fillResult(Path const& path, arangodb::graph::ShortestPathResult& result);
+
+ private:
+  ShortestPathOptions* _options;
+
+  /// @brief reusable ManagedDocumentResult for the edge cursors
+  std::unique_ptr<ManagedDocumentResult> _mmdr;
+
+  arangodb::StringRef _start;
+  arangodb::StringRef _target;
+
+  /// @brief the paths returned so far, in order
+  std::vector<Path> _paths;
+
+  /// @brief paths found but not yet returned
+  std::vector<Path> _candidates;
+
+  /// @brief the neighbors of all vertices expanded for the current start
+  /// and target
+  std::unordered_map<arangodb::StringRef, std::vector<Neighbor>> _neighbors;
+
+  /// @brief whether or not all paths have been returned
+  bool _done;
+};
+
+}  // namespace graph
+}  // namespace arangodb
+
+#endif
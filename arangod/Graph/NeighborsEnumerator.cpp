@@ -37,11 +37,12 @@ NeighborsEnumerator::NeighborsEnumerator(Traverser* traverser,
                                          VPackSlice const& startVertex,
                                          TraverserOptions* opts)
     : PathEnumerator(traverser, startVertex.copyString(), opts),
+      _position(0),
       _searchDepth(0) {
-  StringRef vId = _traverser->traverserCache()->persistString(StringRef(startVertex));
-  _allFound.insert(vId);
-  _currentDepth.insert(vId);
-  _iterator = _currentDepth.begin();
+  auto cache = _traverser->traverserCache();
+  uint32_t const id = cache->persistId(StringRef(startVertex));
+  _allFound.insert(id);
+  _currentDepth.emplace_back(cache->persistedString(id));
 }
 
 bool NeighborsEnumerator::next() {
@@ -52,7 +53,8 @@ bool NeighborsEnumerator::next() {
     }
   }
 
-  if (_iterator == _currentDepth.end() || ++_iterator == _currentDepth.end()) {
+  if (_position >= _currentDepth.size() ||
+      ++_position >= _currentDepth.size()) {
     do {
       // This depth is done. Get next
       if (_opts->maxDepth == _searchDepth) {
@@ -62,6 +64,14 @@ bool NeighborsEnumerator::next() {
 
       _lastDepth.swap(_currentDepth);
       _currentDepth.clear();
+
+      // expand the vertices in the order of their ids, so that the lookups
+      // in the edge index move forward instead of seeking back and forth
+      std::sort(_lastDepth.begin(), _lastDepth.end(),
+                [](StringRef const& lhs, StringRef const& rhs) {
+                  return lhs.compare(rhs) < 0;
+                });
+
       for (auto const& nextVertex : _lastDepth) {
         auto callback = [&](EdgeDocumentToken&& eid,
                             VPackSlice other, size_t cursorId) {
@@ -79,9 +89,9 @@ bool NeighborsEnumerator::next() {
           }
 
           // Counting should be done in readAll
-          StringRef v;
+          uint32_t id;
           if (other.isString()) {
-            v = _opts->cache()->persistString(StringRef(other));
+            id = _opts->cache()->persistId(StringRef(other));
           } else {
             TRI_ASSERT(other.isObject());
             VPackSlice tmp = transaction::helpers::extractFromFromDocument(other);
@@ -89,13 +99,14 @@ bool NeighborsEnumerator::next() {
               tmp = transaction::helpers::extractToFromDocument(other);
             }
             TRI_ASSERT(tmp.isString());
-            v = _opts->cache()->persistString(StringRef(tmp));
+            id = _opts->cache()->persistId(StringRef(tmp));
           }
 
-          if (_allFound.find(v) == _allFound.end()) {
+          if (!_allFound.contains(id)) {
+            StringRef v = _opts->cache()->persistedString(id);
             if (_traverser->vertexMatchesConditions(v, _searchDepth + 1)) {
-              _currentDepth.emplace(v);
-              _allFound.emplace(v);
+              _currentDepth.emplace_back(v);
+              _allFound.insert(id);
             }
           } else {
             _opts->cache()->increaseFilterCounter();
@@ -112,15 +123,15 @@ bool NeighborsEnumerator::next() {
       }
       ++_searchDepth;
     } while (_searchDepth < _opts->minDepth);
-    _iterator = _currentDepth.begin();
+    _position = 0;
   }
-  TRI_ASSERT(_iterator != _currentDepth.end());
+  TRI_ASSERT(_position < _currentDepth.size());
   return true;
 }
 
 arangodb::aql::AqlValue NeighborsEnumerator::lastVertexToAqlValue() {
-  TRI_ASSERT(_iterator != _currentDepth.end());
-  return _traverser->fetchVertexData(*_iterator);
+  TRI_ASSERT(_position < _currentDepth.size());
+  return _traverser->fetchVertexData(_currentDepth[_position]);
 }
 
 arangodb::aql::AqlValue NeighborsEnumerator::lastEdgeToAqlValue() {
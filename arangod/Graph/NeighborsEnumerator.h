@@ -26,6 +26,7 @@
 
 #include "Basics/Common.h"
 #include "Graph/PathEnumerator.h"
+#include "Graph/VertexIdSet.h"
 
 #include <velocypack/Slice.h>
 
@@ -34,10 +35,18 @@ namespace graph {
 // @brief Enumerator optimized for neighbors. Does not allow edge access
 
 class NeighborsEnumerator final : public arangodb::traverser::PathEnumerator {
-  std::unordered_set<arangodb::StringRef> _allFound;
-  std::unordered_set<arangodb::StringRef> _currentDepth;
-  std::unordered_set<arangodb::StringRef> _lastDepth;
-  std::unordered_set<arangodb::StringRef>::iterator _iterator;
+  /// @brief all vertices found so far
+  VertexIdSet _allFound;
+
+  /// @brief vertices found in the current depth. vertices are only added
+  /// when they are not yet in _allFound, so they are unique
+  std::vector<arangodb::StringRef> _currentDepth;
+
+  /// @brief vertices of the last depth, in the order they are expanded in
+  std::vector<arangodb::StringRef> _lastDepth;
+
+  /// @brief position of the last returned vertex in _currentDepth
+  size_t _position;
 
   uint64_t _searchDepth;
  
@@ -125,7 +125,9 @@ bool DepthFirstEnumerator::next() {
               // found the vertex earlier
               break;
             }
-            if (it == e) {
+            // all vertices on the path are persisted in the cache, which
+            // keeps every id only once, so comparing the pointers suffices
+            if (it.data() == e.data()) {
               foundOnce = true;
             }
           }
@@ -44,8 +44,10 @@ ShortestPathOptions::ShortestPathOptions(aql::Query* query)
       direction("outbound"),
       weightAttribute(""),
       defaultWeight(1),
+      heuristicFactor(1),
       bidirectional(true),
-      multiThreaded(true) {}
+      multiThreaded(true),
+      numberOfPaths(1) {}
 
 ShortestPathOptions::ShortestPathOptions(aql::Query* query,
                                          VPackSlice const& info)
@@ -53,8 +55,10 @@ ShortestPathOptions::ShortestPathOptions(aql::Query* query,
       direction("outbound"),
       weightAttribute(""),
       defaultWeight(1),
+      heuristicFactor(1),
       bidirectional(true),
-      multiThreaded(true) {
+      multiThreaded(true),
+      numberOfPaths(1) {
   TRI_ASSERT(info.isObject());
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
   VPackSlice type = info.get("type");
@@ -65,6 +69,12 @@ ShortestPathOptions::ShortestPathOptions(aql::Query* query,
       VelocyPackHelper::getStringValue(info, "weightAttribute", "");
   defaultWeight =
       VelocyPackHelper::getNumericValue<double>(info, "defaultWeight", 1);
+  numberOfPaths =
+      VelocyPackHelper::getNumericValue<size_t>(info, "numberOfPaths", 1);
+  heuristicAttribute =
+      VelocyPackHelper::getStringValue(info, "heuristicAttribute", "");
+  heuristicFactor =
+      VelocyPackHelper::getNumericValue<double>(info, "heuristicFactor", 1);
 }
 
 ShortestPathOptions::ShortestPathOptions(aql::Query* query, VPackSlice info,
@@ -73,8 +83,10 @@ ShortestPathOptions::ShortestPathOptions(aql::Query* query, VPackSlice info,
       direction("outbound"),
       weightAttribute(""),
       defaultWeight(1),
+      heuristicFactor(1),
       bidirectional(true),
-      multiThreaded(true) {
+      multiThreaded(true),
+      numberOfPaths(1) {
   TRI_ASSERT(info.isObject());
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
   VPackSlice type = info.get("type");
@@ -85,6 +97,8 @@ ShortestPathOptions::ShortestPathOptions(aql::Query* query, VPackSlice info,
       VelocyPackHelper::getStringValue(info, "weightAttribute", "");
   defaultWeight =
       VelocyPackHelper::getNumericValue<double>(info, "defaultWeight", 1);
+  numberOfPaths =
+      VelocyPackHelper::getNumericValue<size_t>(info, "numberOfPaths", 1);
 
   VPackSlice read = info.get("reverseLookupInfos");
   if (!read.isArray()) {
@@ -138,10 +152,17 @@ VPackSlice ShortestPathOptions::getEnd() const { return endBuilder.slice(); }
 
 bool ShortestPathOptions::useWeight() const { return !weightAttribute.empty(); }
 
+bool ShortestPathOptions::useHeuristic() const {
+  return useWeight() && !heuristicAttribute.empty() && heuristicFactor > 0;
+}
+
 void ShortestPathOptions::toVelocyPack(VPackBuilder& builder) const {
   VPackObjectBuilder guard(&builder);
   builder.add("weightAttribute", VPackValue(weightAttribute));
   builder.add("defaultWeight", VPackValue(defaultWeight));
+  builder.add("numberOfPaths", VPackValue(numberOfPaths));
+  builder.add("heuristicAttribute", VPackValue(heuristicAttribute));
+  builder.add("heuristicFactor", VPackValue(heuristicFactor));
   builder.add("type", VPackValue("shortestPath"));
 }
 
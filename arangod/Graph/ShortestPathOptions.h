@@ -45,8 +45,17 @@ struct ShortestPathOptions final : public BaseOptions {
   std::string direction;
   std::string weightAttribute;
   double defaultWeight;
+  /// @brief vertex attribute with [latitude, longitude] for the A* search
+  /// of weighted shortest paths, empty for a Dijkstra search
+  std::string heuristicAttribute;
+  /// @brief lower bound of the weight per meter of distance between two
+  /// vertices. larger values than the true bound may miss the shortest path
+  double heuristicFactor;
   bool bidirectional;
   bool multiThreaded;
+  /// @brief number of paths to return per start and target vertex, in
+  /// order of their weight
+  size_t numberOfPaths;
   std::string end;
   arangodb::velocypack::Builder startBuilder;
   arangodb::velocypack::Builder endBuilder;
@@ -75,6 +84,9 @@ struct ShortestPathOptions final : public BaseOptions {
   /// @brief  Test if we have to use a weight attribute
   bool useWeight() const;
 
+  /// @brief  Test if the weighted search is guided by vertex positions
+  bool useHeuristic() const;
+
   /// @brief Build a velocypack for cloning in the plan.
   void toVelocyPack(arangodb::velocypack::Builder&) const override;
 
@@ -49,11 +49,13 @@ namespace graph {
 
 class AttributeWeightShortestPathFinder;
 class ConstantWeightShortestPathFinder;
+class KShortestPathsFinder;
 class TraverserCache;
 
 class ShortestPathResult {
   friend class arangodb::graph::AttributeWeightShortestPathFinder;
   friend class arangodb::graph::ConstantWeightShortestPathFinder;
+  friend class arangodb::graph::KShortestPathsFinder;
 
  public:
   //////////////////////////////////////////////////////////////////////////////
@@ -99,13 +99,24 @@ void SingleServerEdgeCursor::getDocAndRunCallback(OperationCursor* cursor, Callb
     }
 #endif
     _opts->cache()->increaseCounter();
-    if (_internalCursorMapping != nullptr) {
-      TRI_ASSERT(_currentCursor < _internalCursorMapping->size());
-      callback(std::move(etkn), edgeDoc, _internalCursorMapping->at(_currentCursor));
-    } else {
-      callback(std::move(etkn), edgeDoc, _currentCursor);
-    }
+    callback(std::move(etkn), edgeDoc, cursorId());
+  }
+}
+
+void SingleServerEdgeCursor::getExtraAndRunCallback(OperationCursor* cursor,
+                                                    Callback callback) {
+  TRI_ASSERT(_cachePos < _extraCache.slice().length());
+  VPackSlice edge = _extraCache.slice().at(_cachePos);
+  EdgeDocumentToken etkn(cursor->collection()->id(), _cache[_cachePos++]);
+  callback(std::move(etkn), edge, cursorId());
+}
+
+size_t SingleServerEdgeCursor::cursorId() const {
+  if (_internalCursorMapping != nullptr) {
+    TRI_ASSERT(_currentCursor < _internalCursorMapping->size());
+    return _internalCursorMapping->at(_currentCursor);
   }
+  return _currentCursor;
 }
 
 bool SingleServerEdgeCursor::advanceCursor(OperationCursor*& cursor, std::vector<OperationCursor*>& cursorSet) {
@@ -138,7 +149,11 @@ bool SingleServerEdgeCursor::next(std::function<void(EdgeDocumentToken&&, VPackS
   if (_cachePos < _cache.size()) {
     //get the collection
     auto cur = _cursors[_currentCursor][_currentSubCursor];
-    getDocAndRunCallback(cur, callback);
+    if (cur->hasExtra()) {
+      getExtraAndRunCallback(cur, callback);
+    } else {
+      getDocAndRunCallback(cur, callback);
+    }
     return true;
   }
 
@@ -158,7 +173,11 @@ bool SingleServerEdgeCursor::next(std::function<void(EdgeDocumentToken&&, VPackS
       }
     } else {
       if (cursor->hasExtra()) {
-        bool operationSuccessfull = false;
+        // fetch a batch of edges at once instead of one per call. the
+        // edges are only valid during the callback, so they are copied
+        _cache.clear();
+        _extraCache.clear();
+        _extraCache.openArray();
         auto extraCB = [&](LocalDocumentId const& token, VPackSlice edge){
           if (token.isSet()) {
 #ifdef USE_ENTERPRISE
@@ -167,20 +186,13 @@ bool SingleServerEdgeCursor::next(std::function<void(EdgeDocumentToken&&, VPackS
               return;
             }
 #endif
-            operationSuccessfull = true;
-            auto etkn = EdgeDocumentToken(cursor->collection()->id(), token);
-            if (_internalCursorMapping != nullptr) {
-              TRI_ASSERT(_currentCursor < _internalCursorMapping->size());
-              callback(std::move(etkn), edge, _internalCursorMapping->at(_currentCursor));
-            } else {
-              callback(std::move(etkn), edge, _currentCursor);
-            }
+            _cache.emplace_back(token);
+            _extraCache.add(edge);
           }
         };
-        cursor->nextWithExtra(extraCB,1);
-        if (operationSuccessfull) {
-          return true;
-        }
+        bool tmp = cursor->nextWithExtra(extraCB, 1000);
+        TRI_ASSERT(tmp == cursor->hasMore());
+        _extraCache.close();
       } else {
         _cache.clear();
         auto cb = [&](LocalDocumentId const& token) {
@@ -196,7 +208,11 @@ bool SingleServerEdgeCursor::next(std::function<void(EdgeDocumentToken&&, VPackS
   } while (_cache.empty());
   TRI_ASSERT(!_cache.empty());
   TRI_ASSERT(_cachePos < _cache.size());
-  getDocAndRunCallback(cursor, callback);
+  if (cursor->hasExtra()) {
+    getExtraAndRunCallback(cursor, callback);
+  } else {
+    getDocAndRunCallback(cursor, callback);
+  }
   return true;
 }
 
@@ -28,6 +28,8 @@
 
 #include "Graph/EdgeCursor.h"
 
+#include <velocypack/Builder.h>
+
 namespace arangodb {
 
 class LocalDocumentId;
@@ -57,6 +59,9 @@ class SingleServerEdgeCursor final : public EdgeCursor {
   size_t _currentCursor;
   size_t _currentSubCursor;
   std::vector<LocalDocumentId> _cache;
+  /// @brief the edges of the tokens in _cache, as an array, if the current
+  /// cursor hands them out along with the tokens
+  arangodb::velocypack::Builder _extraCache;
   size_t _cachePos;
   std::vector<size_t> const* _internalCursorMapping;
   using Callback = std::function<void(EdgeDocumentToken&&, arangodb::velocypack::Slice, size_t)>;
@@ -81,6 +86,10 @@ class SingleServerEdgeCursor final : public EdgeCursor {
   bool advanceCursor(OperationCursor*& cursor, std::vector<OperationCursor*>& cursorSet);
 
   void getDocAndRunCallback(OperationCursor*, Callback callback);
+
+  void getExtraAndRunCallback(OperationCursor*, Callback callback);
+
+  size_t cursorId() const;
 };
 }  // namespace graph
 }  // namespace arangodb
@@ -85,18 +85,19 @@ bool Traverser::UniqueVertexGetter::getVertex(VPackSlice edge, std::vector<Strin
     TRI_ASSERT(toAdd.isString());
   }
   
-  StringRef toAddStr = _traverser->traverserCache()->persistString(StringRef(toAdd));
+  auto cache = _traverser->traverserCache();
+  uint32_t const id = cache->persistId(StringRef(toAdd));
   // First check if we visited it. If not, then mark
-  if (_returnedVertices.find(toAddStr) != _returnedVertices.end()) {
+  if (_returnedVertices.contains(id)) {
     // This vertex is not unique.
-    _traverser->traverserCache()->increaseFilterCounter();
+    cache->increaseFilterCounter();
     return false;
-  } else {
-    if (!_traverser->vertexMatchesConditions(toAddStr, result.size())) {
-      return false;
-    }
-    _returnedVertices.emplace(toAddStr);
   }
+  StringRef toAddStr = cache->persistedString(id);
+  if (!_traverser->vertexMatchesConditions(toAddStr, result.size())) {
+    return false;
+  }
+  _returnedVertices.insert(id);
 
   result.emplace_back(toAddStr);
   return true;
@@ -113,11 +114,13 @@ bool Traverser::UniqueVertexGetter::getSingleVertex(arangodb::velocypack::Slice
     TRI_ASSERT(resSlice.isString());
   }
   
-  result = _traverser->traverserCache()->persistString(StringRef(resSlice));
+  auto cache = _traverser->traverserCache();
+  uint32_t const id = cache->persistId(StringRef(resSlice));
+  result = cache->persistedString(id);
   // First check if we visited it. If not, then mark
-  if (_returnedVertices.find(result) != _returnedVertices.end()) {
+  if (_returnedVertices.contains(id)) {
     // This vertex is not unique.
-    _traverser->traverserCache()->increaseFilterCounter();
+    cache->increaseFilterCounter();
     return false;
   }
 
@@ -125,14 +128,15 @@ bool Traverser::UniqueVertexGetter::getSingleVertex(arangodb::velocypack::Slice
     return false;
   }
 
-  _returnedVertices.emplace(result);
+  _returnedVertices.insert(id);
   return true;
 }
 
 void Traverser::UniqueVertexGetter::reset(arangodb::StringRef const& startVertex) {
   _returnedVertices.clear();
   // The startVertex always counts as visited!
-  _returnedVertices.emplace(startVertex);
+  _returnedVertices.insert(
+      _traverser->traverserCache()->persistId(startVertex));
 }
 
 Traverser::Traverser(arangodb::traverser::TraverserOptions* opts,
@@ -34,6 +34,7 @@
 #include "Graph/ConstantWeightShortestPathFinder.h"
 #include "Graph/PathEnumerator.h"
 #include "Graph/ShortestPathFinder.h"
+#include "Graph/VertexIdSet.h"
 #include "Transaction/Helpers.h"
 #include "VocBase/voc-types.h"
 
@@ -169,7 +170,7 @@ class Traverser {
     void reset(arangodb::StringRef const&) override;
 
    private:
-    std::unordered_set<arangodb::StringRef> _returnedVertices;
+    graph::VertexIdSet _returnedVertices;
   };
 
 
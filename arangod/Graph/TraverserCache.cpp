@@ -125,13 +125,23 @@ aql::AqlValue TraverserCache::fetchVertexAqlResult(StringRef idString) {
   return aql::AqlValue(lookupInCollection(idString));
 }
 
-StringRef TraverserCache::persistString(
-    StringRef const idString) {
-  auto it = _persistedStrings.find(idString);
-  if (it != _persistedStrings.end()) {
-    return *it;
+uint32_t TraverserCache::persistId(StringRef const idString) {
+  auto it = _persistedIds.find(idString);
+  if (it != _persistedIds.end()) {
+    return it->second;
   }
+  if (_persistedStrings.size() >= UINT32_MAX) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_RESOURCE_LIMIT,
+                                   "too many vertices in traversal");
+  }
+  uint32_t const id = static_cast<uint32_t>(_persistedStrings.size());
   StringRef res = _stringHeap->registerString(idString.begin(), idString.length());
-  _persistedStrings.emplace(res);
-  return res;
+  _persistedStrings.emplace_back(res);
+  try {
+    _persistedIds.emplace(res, id);
+  } catch (...) {
+    _persistedStrings.pop_back();
+    throw;
+  }
+  return id;
 }
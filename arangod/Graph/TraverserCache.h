@@ -99,9 +99,28 @@ class TraverserCache {
 
    //////////////////////////////////////////////////////////////////////////////
    /// @brief Persist the given id string. The return value is guaranteed to
-   ///        stay valid as long as this cache is valid
+   ///        stay valid as long as this cache is valid. Every id is persisted
+   ///        only once, so two persisted ids are equal if and only if they
+   ///        point to the same memory
    //////////////////////////////////////////////////////////////////////////////
-   StringRef persistString(StringRef const idString);
+   StringRef persistString(StringRef const idString) {
+     return _persistedStrings[persistId(idString)];
+   }
+
+   //////////////////////////////////////////////////////////////////////////////
+   /// @brief Persist the given id string and return its number. The ids get
+   ///        dense numbers from 0 in the order they are persisted first, so
+   ///        sets of vertices can be bitmaps of these numbers
+   //////////////////////////////////////////////////////////////////////////////
+   uint32_t persistId(StringRef const idString);
+
+   //////////////////////////////////////////////////////////////////////////////
+   /// @brief The persisted id string with the given number
+   //////////////////////////////////////////////////////////////////////////////
+   StringRef persistedString(uint32_t id) const {
+     TRI_ASSERT(id < _persistedStrings.size());
+     return _persistedStrings[id];
+   }
 
    void increaseFilterCounter() {
      _filteredDocuments++;
@@ -158,10 +177,15 @@ class TraverserCache {
    std::unique_ptr<arangodb::StringHeap> _stringHeap;
 
    //////////////////////////////////////////////////////////////////////////////
-   /// @brief Set of all strings persisted in the stringHeap. So we can save some
-   ///        memory by not storing them twice.
+   /// @brief Numbers of all strings persisted in the stringHeap. So we can save
+   ///        some memory by not storing them twice.
+   //////////////////////////////////////////////////////////////////////////////
+   std::unordered_map<arangodb::StringRef, uint32_t> _persistedIds;
+
+   //////////////////////////////////////////////////////////////////////////////
+   /// @brief All strings persisted in the stringHeap, by their number
    //////////////////////////////////////////////////////////////////////////////
-   std::unordered_set<arangodb::StringRef> _persistedStrings;
+   std::vector<arangodb::StringRef> _persistedStrings;
 };
 
 }
@@ -515,6 +515,15 @@ EdgeCursor* arangodb::traverser::TraverserOptions::nextCursor(
   return nextCursorLocal(mmdr, vid, list);
 }
 
+std::vector<BaseOptions::LookupInfo> const& TraverserOptions::lookupInfos(
+    uint64_t depth) const {
+  auto specific = _depthLookupInfo.find(depth);
+  if (specific != _depthLookupInfo.end()) {
+    return specific->second;
+  }
+  return _baseLookupInfos;
+}
+
 EdgeCursor* TraverserOptions::nextCursorCoordinator(StringRef vid,
                                                     uint64_t depth) {
   TRI_ASSERT(_traverser != nullptr);
@@ -121,6 +121,9 @@ struct TraverserOptions : public graph::BaseOptions {
 
   graph::EdgeCursor* nextCursor(ManagedDocumentResult*, StringRef vid, uint64_t);
 
+  /// @brief the lookup infos used for the edges of a vertex at the given depth
+  std::vector<LookupInfo> const& lookupInfos(uint64_t depth) const;
+
   void linkTraverser(arangodb::traverser::ClusterTraverser*);
 
   double estimateCost(size_t& nrItems) const override;
@@ -0,0 +1,89 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_GRAPH_VERTEX_ID_SET_H
+#define ARANGOD_GRAPH_VERTEX_ID_SET_H 1
+
+#include "Basics/Common.h"
+
+namespace arangodb {
+namespace graph {
+
+/// @brief set of dense vertex numbers, as handed out by
+/// TraverserCache::persistId, used to keep track of the vertices a traversal
+/// has already visited. this is a bitmap indexed by the number, so lookups
+/// neither hash nor compare the id strings. the numbers in the set are kept
+/// as well, so clearing the set only touches their words of the bitmap
+class VertexIdSet {
+ public:
+  VertexIdSet() {}
+
+  VertexIdSet(VertexIdSet const&) = delete;
+  VertexIdSet& operator=(VertexIdSet const&) = delete;
+
+  /// @brief whether or not the set contains no vertices
+  bool empty() const noexcept { return _ids.empty(); }
+
+  /// @brief number of vertices in the set
+  size_t size() const noexcept { return _ids.size(); }
+
+  /// @brief whether or not the set contains the vertex
+  bool contains(uint32_t id) const noexcept {
+    size_t const word = id / 64;
+    return word < _bits.size() && (_bits[word] & mask(id)) != 0;
+  }
+
+  /// @brief add a vertex to the set, returns false if it was already
+  /// contained
+  bool insert(uint32_t id) {
+    size_t const word = id / 64;
+    if (word >= _bits.size()) {
+      _bits.resize((std::max)(word + 1, _bits.size() * 2), 0);
+    }
+    if ((_bits[word] & mask(id)) != 0) {
+      return false;
+    }
+    _bits[word] |= mask(id);
+    _ids.push_back(id);
+    return true;
+  }
+
+  /// @brief remove all vertices, but keep the memory
+  void clear() noexcept {
+    for (uint32_t id : _ids) {
+      _bits[id / 64] &= ~mask(id);
+    }
+    _ids.clear();
+  }
+
+ private:
+  static uint64_t mask(uint32_t id) noexcept {
+    return uint64_t(1) << (id % 64);
+  }
+
+ private:
+  std::vector<uint64_t> _bits;
+  std::vector<uint32_t> _ids;
+};
+
+}  // namespace arangodb::graph
+}  // namespace arangodb
+
+#endif
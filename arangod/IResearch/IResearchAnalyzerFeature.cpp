@@ -52,6 +52,8 @@
 #include "VocBase/ManagedDocumentResult.h"
 #include "VocBase/vocbase.h"
 
+#include <deque>
+
 NS_LOCAL
 
 static std::string const ANALYZER_COLLECTION_NAME("_iresearch_analyzers");
@@ -121,6 +123,155 @@ bool IdentityAnalyzer::reset(irs::string_ref const& data) {
   return !_empty;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief values up to this length, e.g. categories and tags, are tokenized
+///        once per thread and replayed from a cache afterwards
+////////////////////////////////////////////////////////////////////////////////
+static size_t const TOKEN_CACHE_MAX_VALUE_LENGTH = 64; // arbitrary value
+static size_t const TOKEN_CACHE_MAX_ENTRIES = 1024; // per thread, arbitrary value
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the tokens an analyzer produced for a value
+////////////////////////////////////////////////////////////////////////////////
+struct CachedTokens {
+  struct Token {
+    irs::bstring _term;
+    uint32_t _increment;
+    uint32_t _start;
+    uint32_t _end;
+  };
+
+  std::vector<Token> _tokens;
+  bool _hasIncrement;
+  bool _hasOffset;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief records the tokens of an analyzer that was reset to a value
+/// @return nullptr if the analyzer has attributes that are not recorded
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<CachedTokens const> recordTokens(
+    irs::analysis::analyzer& analyzer
+) {
+  auto& attrs = analyzer.attributes();
+  auto* term = attrs.get<irs::term_attribute>().get();
+  auto* inc = attrs.get<irs::increment>().get();
+  auto* offset = attrs.get<irs::offset>().get();
+
+  if (!term || attrs.size() != 1 + (inc ? 1 : 0) + (offset ? 1 : 0)) {
+    return nullptr; // e.g. payloads
+  }
+
+  auto tokens = std::make_shared<CachedTokens>();
+
+  tokens->_hasIncrement = inc != nullptr;
+  tokens->_hasOffset = offset != nullptr;
+
+  while (analyzer.next()) {
+    auto& value = term->value();
+
+    tokens->_tokens.emplace_back(CachedTokens::Token{
+      irs::bstring(value.c_str(), value.size()),
+      inc ? inc->value : 1,
+      offset ? offset->start : 0,
+      offset ? offset->end : 0
+    });
+  }
+
+  return tokens;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief replays cached tokens with the attributes of the original analyzer
+////////////////////////////////////////////////////////////////////////////////
+class CachedTokenStream final
+  : public irs::token_stream, private irs::util::noncopyable { // '_attrs' non-copyable
+ public:
+  explicit CachedTokenStream(std::shared_ptr<CachedTokens const>&& tokens)
+    : _tokens(std::move(tokens)), _next(0) {
+    _attrs.emplace(_term);
+
+    if (_tokens->_hasIncrement) {
+      _attrs.emplace(_inc);
+    }
+
+    if (_tokens->_hasOffset) {
+      _attrs.emplace(_offset);
+    }
+  }
+
+  virtual irs::attribute_view const& attributes() const NOEXCEPT override {
+    return _attrs;
+  }
+
+  virtual bool next() override {
+    if (_next >= _tokens->_tokens.size()) {
+      return false;
+    }
+
+    auto& token = _tokens->_tokens[_next++];
+
+    _term.value(token._term);
+    _inc.value = token._increment;
+    _offset.start = token._start;
+    _offset.end = token._end;
+
+    return true;
+  }
+
+ private:
+  irs::attribute_view _attrs;
+  std::shared_ptr<CachedTokens const> _tokens;
+  size_t _next;
+  IdentityValue _term;
+  irs::increment _inc;
+  irs::offset _offset;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief bounded cache of the tokens of short values, one per thread so that
+///        no locking is required, the oldest entry is evicted first
+////////////////////////////////////////////////////////////////////////////////
+class TokenCache {
+ public:
+  std::shared_ptr<CachedTokens const> find(
+      irs::string_ref const& type,
+      irs::string_ref const& properties,
+      irs::string_ref const& value
+  ) {
+    // the key identifies the analyzer by its configuration, since pools may
+    // be reinitialized or deallocated
+    _key.assign(type.c_str(), type.size());
+    _key.push_back('\0');
+    _key.append(properties.c_str(), properties.size());
+    _key.push_back('\0');
+    _key.append(value.c_str(), value.size());
+
+    auto itr = _entries.find(_key);
+
+    return itr == _entries.end() ? nullptr : itr->second;
+  }
+
+  // stores the tokens under the key of the preceding find(...)
+  void emplace(std::shared_ptr<CachedTokens const> const& tokens) {
+    if (_entries.size() >= TOKEN_CACHE_MAX_ENTRIES) {
+      _entries.erase(_order.front());
+      _order.pop_front();
+    }
+
+    if (_entries.emplace(_key, tokens).second) {
+      _order.emplace_back(_key);
+    }
+  }
+
+ private:
+  std::unordered_map<std::string, std::shared_ptr<CachedTokens const>> _entries;
+  std::deque<std::string> _order; // keys in insertion order
+  std::string _key; // reused buffer for the lookup key
+};
+
+thread_local TokenCache TOKEN_CACHE;
+
 arangodb::aql::AqlValue aqlFnTokens(
     arangodb::aql::Query* query,
     arangodb::transaction::Methods* trx,
@@ -391,6 +542,55 @@ irs::analysis::analyzer::ptr IResearchAnalyzerFeature::AnalyzerPool::get() const
   return nullptr;
 }
 
+std::shared_ptr<irs::token_stream> IResearchAnalyzerFeature::AnalyzerPool::tokens(
+    irs::string_ref const& value
+) const noexcept {
+  if (value.size() > TOKEN_CACHE_MAX_VALUE_LENGTH || IDENTITY_ANALYZER_NAME == _type) {
+    auto analyzer = get();
+
+    if (analyzer) {
+      analyzer->reset(value);
+    }
+
+    return analyzer;
+  }
+
+  try {
+    auto& cache = TOKEN_CACHE;
+    auto tokens = cache.find(_type, _properties, value);
+
+    if (!tokens) {
+      auto analyzer = get();
+
+      if (!analyzer) {
+        return nullptr;
+      }
+
+      analyzer->reset(value);
+      tokens = recordTokens(*analyzer);
+
+      if (!tokens) {
+        analyzer->reset(value); // not cachable, start over
+        return analyzer;
+      }
+
+      cache.emplace(tokens);
+    }
+
+    return std::make_shared<CachedTokenStream>(std::move(tokens));
+  } catch (std::exception& e) {
+    LOG_TOPIC(WARN, arangodb::iresearch::TOPIC)
+      << "caught exception while tokenizing a value with an IResearch analizer type '" << _type << "' properties '" << _properties << "': " << e.what();
+    IR_LOG_EXCEPTION();
+  } catch (...) {
+    LOG_TOPIC(WARN, arangodb::iresearch::TOPIC)
+      << "caught exception while tokenizing a value with an IResearch analizer type '" << _type << "' properties '" << _properties << "'";
+    IR_LOG_EXCEPTION();
+  }
+
+  return nullptr;
+}
+
 std::string const& IResearchAnalyzerFeature::AnalyzerPool::name() const noexcept {
   return _name;
 };
@@ -61,6 +61,12 @@ class IResearchAnalyzerFeature final: public arangodb::application_features::App
     irs::analysis::analyzer::ptr get() const noexcept; // nullptr == error creating analyzer
     std::string const& name() const noexcept;
 
+    // stream of the tokens of 'value', short values are tokenized only once
+    // per thread, nullptr == error creating analyzer
+    std::shared_ptr<irs::token_stream> tokens(
+      irs::string_ref const& value
+    ) const noexcept;
+
    private:
     friend IResearchAnalyzerFeature; // required for calling AnalyzerPool::init()
 
@@ -350,8 +350,8 @@ bool setStringValue(
   // since we unconditionally unmangle it in 'next'
   arangodb::iresearch::kludge::mangleStringField(name, *pool);
 
-  // init stream
-  auto analyzer = pool->get();
+  // init stream, short values are replayed from the token cache
+  auto analyzer = pool->tokens(arangodb::iresearch::getStringRef(value));
 
   if (!analyzer) {
     LOG_TOPIC(WARN, arangodb::iresearch::TOPIC)
@@ -359,9 +359,6 @@ bool setStringValue(
     return false;
   }
 
-  // init stream
-  analyzer->reset(arangodb::iresearch::getStringRef(value));
-
   // set field properties
   field._name = name;
   field._analyzer =  analyzer;
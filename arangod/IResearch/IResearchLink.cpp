@@ -444,6 +444,19 @@ size_t IResearchLink::memory() const {
   return size;
 }
 
+void IResearchLink::viewFigures(arangodb::velocypack::Builder& builder) const {
+  TRI_ASSERT(builder.isOpenObject());
+  ReadMutex mutex(_mutex); // '_view' can be asynchronously modified
+  SCOPED_LOCK(mutex);
+
+  if (_view) {
+    builder.add(VPackValue("view"));
+    builder.openObject();
+    _view->figures(builder);
+    builder.close();
+  }
+}
+
 Result IResearchLink::remove(
   transaction::Methods* trx,
   LocalDocumentId const& documentId,
@@ -127,6 +127,12 @@ class IResearchLink {
   ////////////////////////////////////////////////////////////////////////////////
   size_t memory() const; // arangodb::Index override
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief fill the commit statistics of the view the link belongs to into
+  ///        the 'view' attribute of an open 'figures' object
+  ////////////////////////////////////////////////////////////////////////////////
+  void viewFigures(arangodb::velocypack::Builder& builder) const;
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief remove an ArangoDB document from an iResearch View
   ////////////////////////////////////////////////////////////////////////////////
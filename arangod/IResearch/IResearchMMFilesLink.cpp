@@ -87,6 +87,7 @@ void IResearchMMFilesLink::toVelocyPack(
 
     figuresBuilder.openObject();
     toVelocyPackFigures(figuresBuilder);
+    viewFigures(figuresBuilder);
     figuresBuilder.close();
     builder.add("figures", figuresBuilder.slice());
   }
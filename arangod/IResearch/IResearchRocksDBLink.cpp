@@ -92,6 +92,7 @@ void IResearchRocksDBLink::toVelocyPack(arangodb::velocypack::Builder& builder,
 
     figuresBuilder.openObject();
     toVelocyPackFigures(figuresBuilder);
+    viewFigures(figuresBuilder);
     figuresBuilder.close();
     builder.add("figures", figuresBuilder.slice());
   }
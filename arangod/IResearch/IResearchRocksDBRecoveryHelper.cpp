@@ -354,7 +354,8 @@ void IResearchRocksDBRecoveryHelper::PutCF(uint32_t column_family_id,
     }
 
     auto docId = RocksDBKey::documentId(key);
-    auto doc = RocksDBValue::data(value);
+    std::string buffer;
+    auto doc = RocksDBValue::document(value, buffer);
     SingleCollectionTransaction trx(
       transaction::StandaloneContext::Create(coll->vocbase()),
       coll.get(),
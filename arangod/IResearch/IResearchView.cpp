@@ -37,6 +37,8 @@
 
 #include "Aql/AstNode.h"
 #include "Logger/LogMacros.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "StorageEngine/TransactionState.h"
 #include "StorageEngine/StorageEngine.h"
@@ -49,6 +51,10 @@
 
 #include "IResearchView.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
 NS_LOCAL
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -293,6 +299,208 @@ inline void insertDocument(
   doc.insert(irs::action::store, primaryKey);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of documents of a transaction that are analyzed together,
+///        by one segment writer
+////////////////////////////////////////////////////////////////////////////////
+size_t const INSERT_BATCH_SIZE = 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief documents inserted by a transaction that are not yet indexed
+////////////////////////////////////////////////////////////////////////////////
+struct InsertBatch {
+  struct Document {
+    TRI_voc_cid_t _cid;
+    TRI_voc_rid_t _rid;
+    arangodb::iresearch::IResearchLinkMeta const* _meta; // owned by the link
+    size_t _offset; // offset of the document in '_data'
+  };
+
+  std::vector<Document> _docs;
+  std::vector<uint8_t> _data; // copies of the documents, the originals may be gone when indexed
+
+  void add(
+      TRI_voc_cid_t cid,
+      TRI_voc_rid_t rid,
+      arangodb::iresearch::IResearchLinkMeta const& meta,
+      arangodb::velocypack::Slice doc
+  ) {
+    doc = doc.resolveExternals();
+    _docs.emplace_back(Document{ cid, rid, &meta, _data.size() });
+    _data.insert(_data.end(), doc.start(), doc.start() + doc.byteSize());
+  }
+
+  size_t size() const noexcept { return _docs.size(); }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief inserts the documents with a single segment writer, reusing the
+  ///        field iterator (and thus its analyzers) for all of them
+  //////////////////////////////////////////////////////////////////////////////
+  bool insert(irs::index_writer& writer) const {
+    auto begin = _docs.begin();
+    auto const end = _docs.end();
+    arangodb::iresearch::FieldIterator body;
+    TRI_voc_cid_t cid = 0; // initialize to an arbitary value to avoid compile warning
+    TRI_voc_rid_t rid = 0; // initialize to an arbitary value to avoid compile warning
+
+    // find next valid document
+    auto next = [this, &begin, &end, &body, &cid, &rid]()->bool {
+      while (begin != end) {
+        body.reset(
+          arangodb::velocypack::Slice(_data.data() + begin->_offset),
+          *(begin->_meta)
+        );
+        cid = begin->_cid;
+        rid = begin->_rid;
+        ++begin;
+
+        if (body.valid()) {
+          return true;
+        }
+      }
+
+      return false;
+    };
+
+    if (!next()) {
+      return true; // nothing to index
+    }
+
+    return writer.insert([&body, &cid, &rid, &next](irs::segment_writer::document& doc)->bool {
+      insertDocument(doc, body, cid, rid);
+
+      return next(); // break the loop if no more documents
+    });
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief indexes the batches of a transaction on the scheduler threads while
+///        the transaction goes on writing to the storage engine
+////////////////////////////////////////////////////////////////////////////////
+struct InsertPipeline {
+  explicit InsertPipeline(irs::index_writer& writer)
+    : _writer(&writer), _running(0), _failed(false) {
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief queues the batch for indexing, indexes it right away if there is
+  ///        no scheduler to post to
+  //////////////////////////////////////////////////////////////////////////////
+  static void submit(
+      std::shared_ptr<InsertPipeline> const& state,
+      std::unique_ptr<InsertBatch>&& batch
+  );
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief indexes the queued batches itself, or drops them if 'discard', and
+  ///        waits for the ones indexed by other threads
+  /// @return all batches were indexed successfully
+  //////////////////////////////////////////////////////////////////////////////
+  static bool wait(std::shared_ptr<InsertPipeline> const& state, bool discard);
+
+  // indexes unclaimed batches until there are none left
+  static void run(std::shared_ptr<InsertPipeline> const& state);
+
+  bool ok() const noexcept { return !_failed.load(); }
+
+  irs::index_writer* _writer; // the writer of the transaction, outlives the pipeline users
+
+  std::mutex _mutex;
+  std::condition_variable _cv;
+  std::deque<std::unique_ptr<InsertBatch>> _queue; // the unclaimed batches
+  size_t _running; // the number of claimed batches not done yet
+  std::atomic<bool> _failed;
+};
+
+void InsertPipeline::submit(
+    std::shared_ptr<InsertPipeline> const& state,
+    std::unique_ptr<InsertBatch>&& batch
+) {
+  {
+    std::lock_guard<std::mutex> guard(state->_mutex);
+    state->_queue.emplace_back(std::move(batch));
+  }
+
+  auto* scheduler = arangodb::SchedulerFeature::SCHEDULER;
+
+  if (scheduler) {
+    try {
+      scheduler->post([state]() { InsertPipeline::run(state); });
+
+      return;
+    } catch (...) {
+      // the batch is indexed by this thread
+    }
+  }
+
+  run(state);
+}
+
+bool InsertPipeline::wait(
+    std::shared_ptr<InsertPipeline> const& state,
+    bool discard
+) {
+  if (discard) {
+    std::lock_guard<std::mutex> guard(state->_mutex);
+    state->_queue.clear();
+  } else {
+    run(state);
+  }
+
+  std::unique_lock<std::mutex> guard(state->_mutex);
+
+  while (state->_running > 0) {
+    state->_cv.wait(guard);
+  }
+
+  return state->ok();
+}
+
+void InsertPipeline::run(std::shared_ptr<InsertPipeline> const& state) {
+  while (true) {
+    std::unique_ptr<InsertBatch> batch;
+
+    {
+      std::lock_guard<std::mutex> guard(state->_mutex);
+
+      if (state->_queue.empty()) {
+        return;
+      }
+
+      batch = std::move(state->_queue.front());
+      state->_queue.pop_front();
+      ++state->_running;
+    }
+
+    bool success = false;
+
+    try {
+      success = batch->insert(*(state->_writer));
+    } catch (std::exception const& e) {
+      LOG_TOPIC(WARN, arangodb::iresearch::TOPIC)
+        << "caught exception while inserting batch of a transaction into iResearch view: " << e.what();
+      IR_LOG_EXCEPTION();
+    } catch (...) {
+      LOG_TOPIC(WARN, arangodb::iresearch::TOPIC)
+        << "caught exception while inserting batch of a transaction into iResearch view";
+      IR_LOG_EXCEPTION();
+    }
+
+    {
+      std::lock_guard<std::mutex> guard(state->_mutex);
+
+      if (!success) {
+        state->_failed = true;
+      }
+
+      --state->_running;
+    }
+
+    state->_cv.notify_all();
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief persist view definition to the storage engine
 ///        if in-recovery then register a post-recovery lambda for persistence
@@ -543,6 +751,7 @@ IResearchView::DataStore& IResearchView::DataStore::operator=(
 void IResearchView::DataStore::sync() {
   TRI_ASSERT(_writer && _reader);
   _segmentCount.store(0); // reset to zero to get count of new segments that appear during commit
+  _pendingDocs.store(0);
   _writer->commit();
   _reader = _reader.reopen(); // update reader
   _segmentCount += _reader.size(); // add commited segments
@@ -580,8 +789,52 @@ struct IResearchView::ViewStateWrite
   // removal filters to be applied to during merge
   // transactions are single-threaded so no mutex is required
   std::vector<std::shared_ptr<irs::filter>> _removals;
+  // documents not yet submitted for indexing
+  // transactions are single-threaded so no mutex is required
+  std::unique_ptr<InsertBatch> _batch;
+  std::shared_ptr<InsertPipeline> _pipeline; // batches indexed while the transaction goes on
   std::lock_guard<ReadMutex> _viewLock; // prevent data-store deallocation (lock @ AsyncSelf)
-  ViewStateWrite(ReadMutex& viewMutex): _viewLock(viewMutex) {}
+
+  ViewStateWrite(ReadMutex& viewMutex)
+    : _pipeline(std::make_shared<InsertPipeline>(*_writer)),
+      _viewLock(viewMutex) {
+  }
+
+  ~ViewStateWrite() {
+    InsertPipeline::wait(_pipeline, true); // '_writer' must outlive the pipeline users
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief buffers the document for a batch insert, submits full batches
+  //////////////////////////////////////////////////////////////////////////////
+  void insert(
+      TRI_voc_cid_t cid,
+      TRI_voc_rid_t rid,
+      IResearchLinkMeta const& meta,
+      arangodb::velocypack::Slice const& doc
+  ) {
+    if (!_batch) {
+      _batch = irs::memory::make_unique<InsertBatch>();
+    }
+
+    _batch->add(cid, rid, meta, doc);
+
+    if (_batch->size() >= INSERT_BATCH_SIZE) {
+      InsertPipeline::submit(_pipeline, std::move(_batch));
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief indexes all documents buffered so far
+  /// @return all documents of the transaction were indexed successfully
+  //////////////////////////////////////////////////////////////////////////////
+  bool flush() {
+    if (_batch && _batch->size()) {
+      InsertPipeline::submit(_pipeline, std::move(_batch));
+    }
+
+    return InsertPipeline::wait(_pipeline, false);
+  }
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -781,7 +1034,12 @@ IResearchView::IResearchView(
             std::chrono::system_clock::now() - state._last
           ).count();
 
-          if (usedMsec < state._commitIntervalMsec) {
+          // commit before the interval is over if enough documents are
+          // waiting to become visible, e.g. during bulk loads
+          bool const thresholdReached = state._commitThresholdDocs
+            && store->_pendingDocs.load() >= state._commitThresholdDocs;
+
+          if (usedMsec < state._commitIntervalMsec && !thresholdReached) {
             timeoutMsec = state._commitIntervalMsec - usedMsec; // still need to sleep
 
             return true; // reschedule (with possibly updated '_commitIntervalMsec')
@@ -795,17 +1053,31 @@ IResearchView::IResearchView(
           ReadMutex mutex(_mutex); // 'store' can be asynchronously modified
           SCOPED_LOCK(mutex);
 
-          if (store->_directory
-              && store->_writer
-              && syncStore(*(store->_directory),
-                           store->_reader,
-                           *(store->_writer),
-                           store->_segmentCount,
-                           state._consolidationPolicies,
-                           true,
-                           runCleanupAfterCommit,
-                           name()
-                          )
+          if (!store->_directory || !store->_writer) {
+            return true; // reschedule
+          }
+
+          store->_pendingDocs.store(0); // documents arriving during the commit are counted again
+
+          auto const start = std::chrono::steady_clock::now();
+          bool const synced = syncStore(*(store->_directory),
+                                        store->_reader,
+                                        *(store->_writer),
+                                        store->_segmentCount,
+                                        state._consolidationPolicies,
+                                        true,
+                                        runCleanupAfterCommit,
+                                        name()
+                                       );
+          uint64_t const commitMsec = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start
+          ).count();
+
+          ++_commits;
+          _commitTimeLastMsec.store(commitMsec);
+          _commitTimeTotalMsec += commitMsec;
+
+          if (synced
               && runCleanupAfterCommit
               && ++state._cleanupIntervalCount >= state._cleanupIntervalStep) {
             state._cleanupIntervalCount = 0;
@@ -851,6 +1123,13 @@ IResearchView::IResearchView(
     ReadMutex mutex(viewPtr->_mutex); // '_memoryStore'/'_storePersisted' can be asynchronously modified
 
     try {
+      // index the documents still buffered before taking the lock
+      if (!cookie->flush()) {
+        LOG_TOPIC(WARN, arangodb::iresearch::TOPIC)
+          << "failed to insert some documents of transaction '" << state->id()
+          << "' into iResearch view '" << viewPtr->id() << "'";
+      }
+
       {
         SCOPED_LOCK(mutex);
 
@@ -876,8 +1155,29 @@ IResearchView::IResearchView(
         auto& memoryStore = viewPtr->activeMemoryStore();
 
         cookie->_writer->commit(); // ensure have latest view in reader
-        memoryStore._writer->import(cookie->_reader.reopen());
+
+        auto const reader = cookie->_reader.reopen();
+
+        memoryStore._writer->import(reader);
         ++memoryStore._segmentCount; // a new segment was imported
+
+        size_t const docs = reader.docs_count();
+        size_t const pendingDocs = memoryStore._pendingDocs.fetch_add(docs);
+        size_t commitThresholdDocs;
+
+        {
+          auto meta = std::atomic_load(&(viewPtr->_meta));
+          SCOPED_LOCK(meta->read()); // '_meta' can be asynchronously updated
+          commitThresholdDocs = meta->_commit._commitThresholdDocs;
+        }
+
+        // wake up the commit tasks once when the threshold is crossed
+        if (viewPtr->_asyncFeature
+            && commitThresholdDocs
+            && pendingDocs < commitThresholdDocs
+            && pendingDocs + docs >= commitThresholdDocs) {
+          viewPtr->_asyncFeature->asyncNotify();
+        }
       }
 
       if (state->waitForSync() && !viewPtr->sync()) {
@@ -1149,6 +1449,7 @@ arangodb::Result IResearchView::commit() {
 
   try {
     memoryStore._writer->commit(); // ensure have latest view in reader
+    memoryStore._pendingDocs.store(0);
 
     // intentional copy since `memoryStore._reader` may be updated
     const auto reader = (
@@ -1298,6 +1599,7 @@ int IResearchView::insert(
     IResearchLinkMeta const& meta
 ) {
   DataStore* store;
+  ViewStateWrite* cookie = nullptr;
 
   if (_inRecovery) {
     _storePersisted._writer->remove(FilterFactory::filter(cid, documentId.id()));
@@ -1308,7 +1610,7 @@ int IResearchView::insert(
   } else {
     auto& state = *(trx.state());
 
-    store = ViewStateHelper::write(state, *this);
+    store = cookie = ViewStateHelper::write(state, *this);
 
     if (!store) {
       auto ptr = irs::memory::make_unique<ViewStateWrite>(_asyncSelf->mutex()); // will aquire read-lock to prevent data-store deallocation
@@ -1317,7 +1619,7 @@ int IResearchView::insert(
         return TRI_ERROR_INTERNAL; // the current view is no longer valid (checked after ReadLock aquisition)
       }
 
-      store = ptr.get();
+      store = cookie = ptr.get();
 
       if (!ViewStateHelper::write(state, *this, std::move(ptr))
           || !trx.addStatusChangeCallback(&_trxWriteCallback)) {
@@ -1332,6 +1634,34 @@ int IResearchView::insert(
 
   TRI_ASSERT(store && false == !*store);
 
+  if (cookie) {
+    // documents of a transaction are analyzed in batches, in parallel with the
+    // remainder of the transaction, and at the latest by its commit
+    try {
+      cookie->insert(cid, documentId.id(), meta, doc);
+
+      if (cookie->_pipeline->ok()) {
+        return TRI_ERROR_NO_ERROR;
+      }
+
+      LOG_TOPIC(WARN, arangodb::iresearch::TOPIC)
+        << "failed inserting batch into iResearch view '" << id()
+        << "', collection '" << cid << "', revision '" << documentId.id() << "'";
+    } catch (std::exception const& e) {
+      LOG_TOPIC(WARN, arangodb::iresearch::TOPIC)
+        << "caught exception while inserting into iResearch view '" << id()
+        << "', collection '" << cid << "', revision '" << documentId.id() << "': " << e.what();
+      IR_LOG_EXCEPTION();
+    } catch (...) {
+      LOG_TOPIC(WARN, arangodb::iresearch::TOPIC)
+        << "caught exception while inserting into iResearch view '" << id()
+        << "', collection '" << cid << "', revision '" << documentId.id() << "'";
+      IR_LOG_EXCEPTION();
+    }
+
+    return TRI_ERROR_INTERNAL;
+  }
+
   FieldIterator body(doc, meta);
 
   if (!body.valid()) {
@@ -1546,6 +1876,21 @@ size_t IResearchView::memory() const {
   return size;
 }
 
+void IResearchView::figures(arangodb::velocypack::Builder& builder) const {
+  TRI_ASSERT(builder.isOpenObject());
+  size_t const pendingDocs = _memoryNodes[0]._store._pendingDocs.load()
+    + _memoryNodes[1]._store._pendingDocs.load();
+  size_t const segments = _memoryNodes[0]._store._segmentCount.load()
+    + _memoryNodes[1]._store._segmentCount.load()
+    + _storePersisted._segmentCount.load();
+
+  builder.add("commits", arangodb::velocypack::Value(_commits.load()));
+  builder.add("commitTimeLast", arangodb::velocypack::Value(_commitTimeLastMsec.load() / 1000.));
+  builder.add("commitTimeTotal", arangodb::velocypack::Value(_commitTimeTotalMsec.load() / 1000.));
+  builder.add("segments", arangodb::velocypack::Value(segments));
+  builder.add("pendingDocuments", arangodb::velocypack::Value(pendingDocs));
+}
+
 void IResearchView::open() {
   auto* engine = arangodb::EngineSelectorFeature::ENGINE;
 
@@ -1663,6 +2008,15 @@ int IResearchView::remove(
   // all of its fid stores, no impact to iResearch View data integrity
   // ...........................................................................
   try {
+    // the removal must see the documents inserted before it
+    if (!store->flush()) {
+      LOG_TOPIC(WARN, arangodb::iresearch::TOPIC)
+        << "failed inserting documents of transaction '" << state.id()
+        << "' into iResearch view '" << id() << "' before removal of revision '" << documentId.id() << "'";
+
+      return TRI_ERROR_INTERNAL;
+    }
+
     store->_writer->remove(shared_filter);
     store->_removals.emplace_back(shared_filter); // transactions are single-threaded so no mutex is required for '_removals'
 
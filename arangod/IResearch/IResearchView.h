@@ -229,6 +229,13 @@ class IResearchView final: public arangodb::DBServerLogicalView,
   ////////////////////////////////////////////////////////////////////////////////
   size_t memory() const;
 
+  ///////////////////////////////////////////////////////////////////////////////
+  /// @brief fill the commit statistics of the view, i.e. the number and the
+  ///        duration of the asynchronous commits, the number of segments and
+  ///        the number of documents not yet visible to queries
+  ///////////////////////////////////////////////////////////////////////////////
+  void figures(arangodb::velocypack::Builder& builder) const;
+
   ///////////////////////////////////////////////////////////////////////////////
   /// @brief opens an existing view when the server is restarted
   ///////////////////////////////////////////////////////////////////////////////
@@ -311,6 +318,7 @@ class IResearchView final: public arangodb::DBServerLogicalView,
     irs::directory::ptr _directory;
     irs::directory_reader _reader;
     std::atomic<size_t> _segmentCount{}; // total number of segments in the writer
+    std::atomic<size_t> _pendingDocs{}; // number of documents not yet visible to readers
     irs::index_writer::ptr _writer;
     DataStore() = default;
     DataStore(DataStore&& other) noexcept;
@@ -383,6 +391,9 @@ class IResearchView final: public arangodb::DBServerLogicalView,
   std::function<void(arangodb::transaction::Methods& trx, arangodb::transaction::Status status)> _trxReadCallback; // for snapshot(...)
   std::function<void(arangodb::transaction::Methods& trx, arangodb::transaction::Status status)> _trxWriteCallback; // for insert(...)/remove(...)
   std::atomic<bool> _inRecovery;
+  std::atomic<uint64_t> _commits{}; // number of asynchronous commits of the stores
+  std::atomic<uint64_t> _commitTimeLastMsec{}; // duration of the last asynchronous commit
+  std::atomic<uint64_t> _commitTimeTotalMsec{}; // duration of all asynchronous commits
 };
 
 } // iresearch
@@ -23,6 +23,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "AqlHelper.h"
+#include "AttributeScorer.h"
 #include "IResearchCommon.h"
 #include "IResearchDocument.h"
 #include "IResearchFilterFactory.h"
@@ -38,7 +39,10 @@
 #include "Aql/ExpressionContext.h"
 #include "Aql/Query.h"
 #include "Basics/Exceptions.h"
+#include "Basics/system-functions.h"
 #include "Logger/LogMacros.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "StorageEngine/TransactionState.h"
 #include "StorageEngine/TransactionCollection.h"
 #include "VocBase/LocalDocumentId.h"
@@ -48,7 +52,9 @@
 #include "search/boolean_filter.hpp"
 #include "search/score.hpp"
 
+#include <condition_variable>
 #include <iostream>
+#include <mutex>
 
 NS_LOCAL
 
@@ -64,6 +70,185 @@ inline arangodb::aql::RegisterId getRegister(
     : it->second.registerId;
   }
 
+// whether the filter can be executed on several segments at once, an
+// expression filter evaluates AQL on the query's transaction
+bool isThreadSafe(irs::filter const& filter) {
+  if (filter.type() == arangodb::iresearch::ByExpression::type()) {
+    return false;
+  }
+
+  if (filter.type() == irs::Not::type()) {
+    auto const* inner = static_cast<irs::Not const&>(filter).filter();
+
+    return !inner || isThreadSafe(*inner);
+  }
+
+  auto const* boolean = dynamic_cast<irs::boolean_filter const*>(&filter);
+
+  if (boolean) {
+    for (auto const& inner : *boolean) {
+      if (!isThreadSafe(inner)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+struct ScoreLess {
+  explicit ScoreLess(irs::order::prepared const& order) noexcept
+    : _order(&order) {
+  }
+
+  bool operator()(irs::bstring const& lhs, irs::bstring const& rhs) const {
+    return _order->less(lhs.c_str(), rhs.c_str());
+  }
+
+  irs::order::prepared const* _order;
+};
+
+// FIXME use irs::memory_pool
+typedef std::pair<size_t, irs::doc_id_t> DocumentToken;
+typedef std::multimap<irs::bstring, DocumentToken, ScoreLess> OrderedDocTokens;
+
+// adds the best maxDocCount documents of a segment to the tokens, documents
+// with equal scores keep the order of the segment. a document that does not
+// beat the worst one of maxDocCount collected documents is not copied
+void collectSegment(
+    arangodb::iresearch::PrimaryKeyIndexReader const& reader,
+    size_t i,
+    irs::filter::prepared const& filter,
+    irs::order::prepared const& order,
+    irs::attribute_view const& ctx,
+    size_t maxDocCount,
+    OrderedDocTokens& orderedDocTokens
+) {
+  if (!maxDocCount) {
+    return;
+  }
+
+  auto& segmentReader = reader[i];
+  auto itr = segmentReader.mask(filter.execute(segmentReader, order, ctx));
+  irs::score const* score = itr->attributes().get<irs::score>().get();
+
+  if (!score) {
+    LOG_TOPIC(ERR, arangodb::iresearch::TOPIC)
+      << "failed to retrieve document score attribute while iterating iResearch view, ignoring: reader_id '" << i << "'";
+    IR_LOG_STACK_TRACE();
+
+    return; // if here then there is probably a bug in IResearchView while querying
+  }
+
+#if defined(__GNUC__) && !defined(_GLIBCXX_USE_CXX11_ABI)
+  // workaround for std::basic_string's COW with old compilers
+  const irs::bytes_ref scoreValue = score->value();
+#else
+  const auto& scoreValue = score->value();
+#endif
+
+  while (itr->next()) {
+    score->evaluate(); // compute a score for the current document
+
+    if (orderedDocTokens.size() >= maxDocCount
+        && !order.less(scoreValue.c_str(), orderedDocTokens.rbegin()->first.c_str())) {
+      continue;
+    }
+
+    orderedDocTokens.emplace(
+      std::piecewise_construct,
+      std::forward_as_tuple(scoreValue),
+      std::forward_as_tuple(i, itr->value())
+    );
+
+    if (orderedDocTokens.size() > maxDocCount) {
+      orderedDocTokens.erase(--(orderedDocTokens.end())); // remove element with the least score
+    }
+  }
+}
+
+// segments scored by scheduler threads and the query thread together. a
+// task only touches the block's reader, filter and order after it claimed
+// a segment, and the query thread waits for all claimed segments
+struct ParallelCollect {
+  ParallelCollect(
+      arangodb::iresearch::PrimaryKeyIndexReader const& reader,
+      irs::filter::prepared const& filter,
+      irs::order::prepared const& order,
+      irs::attribute_view const& ctx,
+      size_t maxDocCount)
+    : reader(&reader),
+      filter(&filter),
+      order(&order),
+      ctx(&ctx),
+      maxDocCount(maxDocCount),
+      count(reader.size()),
+      next(0),
+      running(0),
+      results(count) {
+  }
+
+  // scores unclaimed segments until there are none left
+  static void run(std::shared_ptr<ParallelCollect> const& state);
+
+  arangodb::iresearch::PrimaryKeyIndexReader const* reader;
+  irs::filter::prepared const* filter;
+  irs::order::prepared const* order;
+  irs::attribute_view const* ctx;
+  size_t const maxDocCount;
+  size_t const count;
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  size_t next; // the next unclaimed segment
+  size_t running; // the number of claimed segments not done yet
+  std::vector<std::unique_ptr<OrderedDocTokens>> results;
+  std::exception_ptr error;
+};
+
+void ParallelCollect::run(std::shared_ptr<ParallelCollect> const& state) {
+  while (true) {
+    size_t i;
+
+    {
+      std::lock_guard<std::mutex> guard(state->mutex);
+
+      if (state->next >= state->count || state->error) {
+        return;
+      }
+
+      i = state->next++;
+      ++state->running;
+    }
+
+    auto tokens = std::make_unique<OrderedDocTokens>(ScoreLess(*state->order));
+    std::exception_ptr error;
+
+    try {
+      collectSegment(
+        *state->reader, i, *state->filter, *state->order, *state->ctx,
+        state->maxDocCount, *tokens
+      );
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    {
+      std::lock_guard<std::mutex> guard(state->mutex);
+
+      if (error) {
+        state->error = error;
+      } else {
+        state->results[i] = std::move(tokens);
+      }
+
+      --state->running;
+    }
+
+    state->cv.notify_all();
+  }
+}
+
 NS_END // NS_LOCAL
 
 NS_BEGIN(arangodb)
@@ -123,6 +308,7 @@ IResearchViewBlockBase::IResearchViewBlockBase(
     _hasMore(true), // has more data initially
     _volatileSort(true),
     _volatileFilter(true),
+    _parallel(false),
     _inflight(0) {
   TRI_ASSERT(_trx);
 
@@ -175,6 +361,8 @@ void IResearchViewBlockBase::reset() {
       THROW_ARANGO_EXCEPTION(TRI_ERROR_BAD_PARAMETER);
     }
 
+    _parallel = isThreadSafe(root);
+
     if (_volatileSort) {
       irs::order order;
       irs::sort::ptr scorer;
@@ -187,7 +375,13 @@ void IResearchViewBlockBase::reset() {
           THROW_ARANGO_EXCEPTION(TRI_ERROR_BAD_PARAMETER);
         }
 
-        order.add(sort.asc, std::move(scorer));
+        if (scorer && scorer->type() == AttributeScorer::type()) {
+          _parallel = false; // reads documents via the transaction
+        }
+
+        // a reversed iresearch order puts the greatest scores first, which
+        // is what a descending SORT expects
+        order.add(!sort.asc, std::move(scorer));
       }
 
       // compile order
@@ -262,7 +456,7 @@ IResearchViewBlockBase::getSome(size_t atMost) {
       needMore = false;
 
       if (_buffer.empty()) {
-        size_t const toFetch = (std::min)(DefaultBatchSize(), atMost);
+        size_t const toFetch = (std::min)(upstreamBatchSize(), atMost);
         auto upstreamRes = ExecutionBlock::getBlock(toFetch);
         if (upstreamRes.first == ExecutionState::WAITING) {
           return {upstreamRes.first, nullptr};
@@ -346,7 +540,7 @@ std::pair<ExecutionState, size_t> IResearchViewBlockBase::skipSome(size_t atMost
 
   while (_inflight < atMost) {
     if (_buffer.empty()) {
-      size_t toFetch = (std::min)(DefaultBatchSize(), atMost);
+      size_t toFetch = (std::min)(upstreamBatchSize(), atMost);
       auto upstreamRes = getBlock(toFetch);
       if (upstreamRes.first == ExecutionState::WAITING) {
         return {upstreamRes.first, 0};
@@ -625,7 +819,8 @@ IResearchViewOrderedBlock::IResearchViewOrderedBlock(
     PrimaryKeyIndexReader const& reader,
     aql::ExecutionEngine& engine,
     IResearchViewNode const& node
-): IResearchViewBlockBase(reader, engine, node) {
+): IResearchViewBlockBase(reader, engine, node),
+   _limit(node.limit()) {
 }
 
 bool IResearchViewOrderedBlock::next(
@@ -635,49 +830,73 @@ bool IResearchViewOrderedBlock::next(
     size_t limit
 ) {
   TRI_ASSERT(_filter);
+  auto const& viewNode = *ExecutionNode::castTo<IResearchViewNode const*>(getPlanNode());
+  auto const numSorts = viewNode.sortCondition().size();
 
-  auto scoreLess = [this](irs::bstring const& lhs, irs::bstring const& rhs) {
-    return _order.less(lhs.c_str(), rhs.c_str());
-  };
+  if (_limit) {
+    // the documents after the best ones are not needed
+    TRI_ASSERT(_skip <= _limit);
+    limit = (std::min)(limit, _limit - _skip);
 
-  // FIXME use irs::memory_pool
-  typedef std::pair<size_t, irs::doc_id_t> DocumentToken;
+    if (!limit) {
+      return false;
+    }
+  }
 
-  std::multimap<irs::bstring, DocumentToken, decltype(scoreLess)> orderedDocTokens(scoreLess);
+  OrderedDocTokens orderedDocTokens{ScoreLess(_order)};
   auto const maxDocCount = _skip + limit;
+  auto* scheduler = SchedulerFeature::SCHEDULER;
 
-  for (size_t i = 0, count = _reader.size(); i < count; ++i) {
-    auto& segmentReader = _reader[i];
-    auto itr = segmentReader.mask(_filter->execute(segmentReader, _order, _filterCtx));
-    irs::score const* score = itr->attributes().get<irs::score>().get();
+  if (_parallel && scheduler && _reader.size() > 1) {
+    auto state = std::make_shared<ParallelCollect>(
+      _reader, *_filter, _order, _filterCtx, maxDocCount
+    );
 
-    if (!score) {
-      LOG_TOPIC(ERR, arangodb::iresearch::TOPIC)
-        << "failed to retrieve document score attribute while iterating iResearch view, ignoring: reader_id '" << i << "'";
-      IR_LOG_STACK_TRACE();
+    // the query thread scores segments as well
+    size_t const tasks = (std::min)(_reader.size() - 1, TRI_numberProcessors());
 
-      continue; // if here then there is probably a bug in IResearchView while querying
+    for (size_t i = 0; i < tasks; ++i) {
+      try {
+        scheduler->post([state]() { ParallelCollect::run(state); });
+      } catch (...) {
+        break; // the remaining segments are scored by this thread
+      }
     }
 
-#if defined(__GNUC__) && !defined(_GLIBCXX_USE_CXX11_ABI)
-    // workaround for std::basic_string's COW with old compilers
-    const irs::bytes_ref scoreValue = score->value();
-#else
-    const auto& scoreValue = score->value();
-#endif
+    ParallelCollect::run(state);
 
-    while (itr->next()) {
-      score->evaluate(); // compute a score for the current document
+    {
+      std::unique_lock<std::mutex> guard(state->mutex);
 
-      orderedDocTokens.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(scoreValue),
-        std::forward_as_tuple(i, itr->value())
-      );
+      while (state->running > 0) {
+        state->cv.wait(guard);
+      }
+    }
+
+    if (state->error) {
+      std::rethrow_exception(state->error);
+    }
 
-      if (orderedDocTokens.size() > maxDocCount) {
-        orderedDocTokens.erase(--(orderedDocTokens.end())); // remove element with the least score
+    // merge in the order of the segments, so that documents with equal
+    // scores are returned as by a sequential scan
+    for (auto& tokens : state->results) {
+      if (!tokens) {
+        continue;
       }
+
+      for (auto& token : *tokens) {
+        orderedDocTokens.emplace(std::move(token));
+
+        if (orderedDocTokens.size() > maxDocCount) {
+          orderedDocTokens.erase(--(orderedDocTokens.end())); // remove element with the least score
+        }
+      }
+    }
+  } else {
+    for (size_t i = 0, count = _reader.size(); i < count; ++i) {
+      collectSegment(
+        _reader, i, *_filter, _order, _filterCtx, maxDocCount, orderedDocTokens
+      );
     }
   }
 
@@ -710,6 +929,17 @@ bool IResearchViewOrderedBlock::next(
       } else {
         res.setValue(pos, curRegs, AqlValue(AqlValueHintCopy(vpack)));
       }
+
+      // copy scores, registerId's are sequential
+      auto scoreRegs = curRegs;
+
+      for (size_t i = 0; i < numSorts; ++i) {
+        res.setValue(
+          pos,
+          ++scoreRegs,
+          _order.to_string<AqlValue, std::char_traits<char>>(tokenItr->first.c_str(), i)
+        );
+      }
     }
 
     // FIXME why?
@@ -733,6 +963,11 @@ size_t IResearchViewOrderedBlock::skip(size_t limit) {
   size_t skipped = 0;
   auto skip = _skip;
 
+  if (_limit) {
+    TRI_ASSERT(_skip <= _limit);
+    limit = (std::min)(limit, _limit - _skip);
+  }
+
   for (size_t i = 0, readerCount = _reader.size(); i < readerCount; ++i) {
     auto& segmentReader = _reader[i];
 
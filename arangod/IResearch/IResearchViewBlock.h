@@ -124,6 +124,10 @@ class IResearchViewBlockBase : public aql::ExecutionBlock {
   bool _volatileSort;
   bool _volatileFilter;
 
+  /// @brief whether filter and scorers may be executed for several segments
+  /// at once, i.e. none of them evaluates AQL expressions or reads documents
+  bool _parallel;
+
   /// @brief The number of documents inflight if we hit a WAITING state.
   size_t _inflight;
 }; // IResearchViewBlockBase
@@ -229,6 +233,7 @@ class IResearchViewOrderedBlock final : public IResearchViewBlockBase {
 
  private:
   size_t _skip{};
+  size_t const _limit; // the number of best documents needed, 0 for all
 }; // IResearchViewOrderedBlock
 
 NS_END // iresearch
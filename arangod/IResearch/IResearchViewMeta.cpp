@@ -34,6 +34,63 @@
 
 NS_LOCAL
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief merges the segments of the size tier with the most segments, if at
+///        least 'threshold' of all segments and more than one are in it, so
+///        that many small segments of bulk loads are merged with each other
+///        instead of with the big ones
+////////////////////////////////////////////////////////////////////////////////
+irs::index_writer::consolidation_policy_t consolidateTier(float threshold) {
+  return [threshold](
+    irs::directory const& dir, irs::index_meta const& meta
+  )->irs::index_writer::consolidation_acceptor_t {
+    auto tier = [&dir](irs::segment_meta const& segment)->size_t {
+      uint64_t bytes = 0;
+      uint64_t length;
+
+      for (auto& file: segment.files) {
+        if (dir.length(length, file)) {
+          bytes += length;
+        }
+      }
+
+      size_t tier = 0;
+
+      for (; bytes >= 10; bytes /= 10) {
+        ++tier;
+      }
+
+      return tier;
+    };
+
+    std::map<size_t, size_t> tiers; // tier => number of segments
+
+    for (auto& segment: meta) {
+      ++tiers[tier(segment.meta)];
+    }
+
+    auto best = tiers.end();
+
+    for (auto itr = tiers.begin(); itr != tiers.end(); ++itr) {
+      if (best == tiers.end() || itr->second > best->second) {
+        best = itr;
+      }
+    }
+
+    if (best == tiers.end()
+        || best->second < 2
+        || best->second < std::max<float>(0, std::min<float>(1, threshold)) * meta.size()) {
+      return [](irs::segment_meta const&)->bool { return false; };
+    }
+
+    auto const bestTier = best->first;
+
+    return [tier, bestTier](irs::segment_meta const& segment)->bool {
+      return tier(segment) == bestTier;
+    };
+  };
+}
+
 bool equalConsolidationPolicies(
   arangodb::iresearch::IResearchViewMeta::CommitMeta::ConsolidationPolicies const& lhs,
   arangodb::iresearch::IResearchViewMeta::CommitMeta::ConsolidationPolicies const& rhs
@@ -104,6 +161,17 @@ bool initCommitMeta(
     }
   }
 
+  {
+    // optional size_t
+    static const std::string fieldName("commitThresholdDocs");
+
+    if (!arangodb::iresearch::getNumber(meta._commitThresholdDocs, slice, fieldName, tmpSeen, defaults._commitThresholdDocs)) {
+      errorField = fieldName;
+
+      return false;
+    }
+  }
+
   {
     // optional enum->{size_t,float} map
     static const std::string fieldName("consolidate");
@@ -137,6 +205,7 @@ bool initCommitMeta(
           { "bytes_accum", ConsolidationPolicy::Type::BYTES_ACCUM },
           { "count", ConsolidationPolicy::Type::COUNT },
           { "fill", ConsolidationPolicy::Type::FILL },
+          { "tier", ConsolidationPolicy::Type::TIER },
         };
 
         auto name = key.copyString();
@@ -197,6 +266,7 @@ bool jsonCommitMeta(
 
   builder.add("cleanupIntervalStep", arangodb::velocypack::Value(meta._cleanupIntervalStep));
   builder.add("commitIntervalMsec", arangodb::velocypack::Value(meta._commitIntervalMsec));
+  builder.add("commitThresholdDocs", arangodb::velocypack::Value(meta._commitThresholdDocs));
 
   typedef arangodb::iresearch::IResearchViewMeta::CommitMeta::ConsolidationPolicy ConsolidationPolicy;
   struct ConsolidationPolicyHash { size_t operator()(ConsolidationPolicy::Type const& value) const noexcept { return size_t(value); } }; // for GCC compatibility
@@ -205,6 +275,7 @@ bool jsonCommitMeta(
     { ConsolidationPolicy::Type::BYTES_ACCUM, "bytes_accum" },
     { ConsolidationPolicy::Type::COUNT, "count" },
     { ConsolidationPolicy::Type::FILL, "fill" },
+    { ConsolidationPolicy::Type::TIER, "tier" },
   };
 
   arangodb::velocypack::Builder subBuilder;
@@ -275,6 +346,9 @@ IResearchViewMeta::CommitMeta::ConsolidationPolicy::ConsolidationPolicy(
    case Type::FILL:
     _policy = irs::index_utils::consolidate_fill(_threshold);
     break;
+   case Type::TIER:
+    _policy = consolidateTier(_threshold);
+    break;
    default:
     // internal logic error here!!! do not know how to initialize policy
     // should have a case for every declared type
@@ -353,6 +427,11 @@ bool IResearchViewMeta::CommitMeta::ConsolidationPolicy::operator==(
       static const ConsolidationPolicy policy(type, 300, 0.85f);
       return policy;
     }
+  case Type::TIER:
+    {
+      static const ConsolidationPolicy policy(type, 50, 0.5f);
+      return policy;
+    }
   default:
     // internal logic error here!!! do not know how to initialize policy
     // should have a case for every declared type
@@ -381,6 +460,7 @@ bool IResearchViewMeta::CommitMeta::operator==(
 ) const noexcept {
   return _cleanupIntervalStep == other._cleanupIntervalStep
       && _commitIntervalMsec == other._commitIntervalMsec
+      && _commitThresholdDocs == other._commitThresholdDocs
       && equalConsolidationPolicies(_consolidationPolicies, other._consolidationPolicies);
 }
 
@@ -399,6 +479,7 @@ IResearchViewMeta::IResearchViewMeta()
   : _locale(std::locale::classic()) {
   _commit._cleanupIntervalStep = 10;
   _commit._commitIntervalMsec = 60 * 1000;
+  _commit._commitThresholdDocs = 0;
   _commit._consolidationPolicies.emplace_back(CommitMeta::ConsolidationPolicy::DEFAULT(CommitMeta::ConsolidationPolicy::Type::BYTES));
   _commit._consolidationPolicies.emplace_back(CommitMeta::ConsolidationPolicy::DEFAULT(CommitMeta::ConsolidationPolicy::Type::BYTES_ACCUM));
   _commit._consolidationPolicies.emplace_back(CommitMeta::ConsolidationPolicy::DEFAULT(CommitMeta::ConsolidationPolicy::Type::COUNT));
@@ -66,6 +66,7 @@ struct IResearchViewMeta {
         BYTES_ACCUM, // {threshold} > (segment_bytes + sum_of_merge_candidate_segment_bytes) / all_segment_bytes
         COUNT, // {threshold} > segment_docs{valid} / (all_segment_docs{valid} / #segments)
         FILL,  // {threshold} > #segment_docs{valid} / (#segment_docs{valid} + #segment_docs{removed})
+        TIER, // {threshold} <= #segments_in_tier / #segments, for the size tier (power of 10 bytes) with most segments
       };
 
       ConsolidationPolicy(Type type, size_t segmentThreshold, float threshold);
@@ -91,6 +92,7 @@ struct IResearchViewMeta {
 
     size_t _cleanupIntervalStep; // issue cleanup after <count> commits (0 == disable)
     size_t _commitIntervalMsec; // issue commit after <interval> milliseconds (0 == disable)
+    size_t _commitThresholdDocs; // issue commit before <interval> after <count> uncommitted documents (0 == disable)
     ConsolidationPolicies _consolidationPolicies;
 
     bool operator==(CommitMeta const& other) const noexcept;
@@ -318,6 +318,13 @@ IResearchViewNode::IResearchViewNode(
   if (volatilityMaskSlice.isNumber()) {
     _volatilityMask = volatilityMaskSlice.getNumber<int>();
   }
+
+  // limit
+  auto const limitSlice = base.get("limit");
+
+  if (limitSlice.isNumber()) {
+    _limit = limitSlice.getNumber<size_t>();
+  }
 }
 
 void IResearchViewNode::planNodeRegisters(
@@ -401,6 +408,11 @@ void IResearchViewNode::toVelocyPackHelper(
   // volatility mask
   nodes.add("volatility", VPackValue(_volatilityMask));
 
+  // limit
+  if (_limit) {
+    nodes.add("limit", VPackValue(_limit));
+  }
+
   nodes.close();
 }
 
@@ -455,6 +467,7 @@ aql::ExecutionNode* IResearchViewNode::clone(
   );
   node->_shards = _shards;
   node->_volatilityMask = _volatilityMask;
+  node->_limit = _limit;
 
   return cloneHelper(std::move(node), withDependencies, withProperties);
 }
@@ -534,13 +547,10 @@ std::unique_ptr<aql::ExecutionBlock> IResearchViewNode::createBlock(
     return std::make_unique<IResearchViewUnorderedBlock>(*reader, engine, *this);
   }
 
-//FIXME uncomment when the following method will be there:
-// `int getAndSkip(size_t skip, size_t& skipped, size_t read, size_t& count, AqlItemBlock*& res)`
-//
-//  if (!isInInnerLoop()) {
-//    // optimized execution for simple queries
-//    return new IResearchViewOrderedBlock(*reader, engine, *this);
-//  }
+  if (_limit && !isInInnerLoop()) {
+    // only the best documents are needed, which the view finds by itself
+    return std::make_unique<IResearchViewOrderedBlock>(*reader, engine, *this);
+  }
 
   // generic case
   return std::make_unique<IResearchViewBlock>(*reader, engine, *this);
@@ -155,6 +155,16 @@ class IResearchViewNode final : public arangodb::aql::ExecutionNode {
     return _sortCondition;
   }
 
+  /// @brief the number of best documents by the sort condition, which are
+  ///        all that the query needs, 0 for all documents
+  size_t limit() const noexcept {
+    return _limit;
+  }
+
+  void limit(size_t limit) noexcept {
+    _limit = limit;
+  }
+
   /// @brief getVariablesUsedHere, returning a vector
   std::vector<aql::Variable const*> getVariablesUsedHere() const override final;
 
@@ -205,6 +215,9 @@ class IResearchViewNode final : public arangodb::aql::ExecutionNode {
   /// @brief list of shards involved, need this for the cluster
   std::vector<std::string> _shards;
 
+  /// @brief the number of best documents needed, 0 for all
+  size_t _limit{};
+
   /// @brief volatility mask
   mutable int _volatilityMask{ -1 };
 }; // IResearchViewNode
@@ -131,6 +131,58 @@ bool addView(
   return view.visitCollections(visitor);
 }
 
+/// @returns the number of documents a SORT on exactly the scores of the view
+/// followed by a LIMIT needs from the view, 0 if it needs all of them
+size_t sortLimit(IResearchViewNode const& viewNode) {
+  auto const& sorts = viewNode.sortCondition();
+
+  if (sorts.empty() || viewNode.isInInnerLoop()) {
+    return 0;
+  }
+
+  // skip over nodes that produce exactly one output row per input row
+  auto* current = viewNode.getFirstParent();
+  while (current && EN::CALCULATION == current->getType()) {
+    current = current->getFirstParent();
+  }
+
+  if (!current || EN::SORT != current->getType()) {
+    return 0;
+  }
+
+  auto const& elements = EN::castTo<SortNode const*>(current)->elements();
+
+  if (elements.size() != sorts.size()) {
+    return 0;
+  }
+
+  for (size_t i = 0; i < elements.size(); ++i) {
+    if (elements[i].var != sorts[i].var
+        || elements[i].ascending != sorts[i].asc
+        || !elements[i].attributePath.empty()) {
+      return 0;
+    }
+  }
+
+  current = current->getFirstParent();
+  while (current && EN::CALCULATION == current->getType()) {
+    current = current->getFirstParent();
+  }
+
+  if (!current || EN::LIMIT != current->getType()) {
+    return 0;
+  }
+
+  auto const* limitNode = EN::castTo<LimitNode const*>(current);
+
+  if (limitNode->fullCount()
+      || limitNode->offset() > std::numeric_limits<size_t>::max() - limitNode->limit()) {
+    return 0;
+  }
+
+  return limitNode->offset() + limitNode->limit();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @class IResearchViewConditionFinder
 ///////////////////////////////////////////////////////////////////////////////
@@ -516,6 +568,13 @@ void handleViewsRule(
 //    }
 //
     plan->unlinkNodes(toUnlink);
+
+    // let the view find the best documents for a SORT and LIMIT on its
+    // scores by itself, the SORT still orders them
+    for (auto* node : createdViewNodes) {
+      auto& viewNode = *EN::castTo<IResearchViewNode*>(const_cast<ExecutionNode*>(node));
+      viewNode.limit(sortLimit(viewNode));
+    }
   }
 
   opt->addPlan(std::move(plan), rule, !changes.empty());
@@ -620,6 +679,11 @@ void scatterViewInClusterRule(
     remoteNode->addDependency(node);
 
     // insert gather node
+    // a view node limited by handleViewsRule takes its limit along to the
+    // DB-servers, so every DB-server sends at most offset + count documents
+    // in the order of their scores. distributeSortToClusterRule then moves
+    // the SORT in front of the remote node and lets the gather node merge
+    // the sorted results, the LIMIT stays on the coordinator
     auto const sortMode = GatherNode::evaluateSortMode(
       numberOfShards(*resolver, view)
     );
@@ -229,6 +229,9 @@ Index::IndexType Index::type(char const* type) {
   if (::strcmp(type, "fulltext") == 0) {
     return TRI_IDX_TYPE_FULLTEXT_INDEX;
   }
+  if (::strcmp(type, "ttl") == 0) {
+    return TRI_IDX_TYPE_TTL_INDEX;
+  }
   if (::strcmp(type, "geo1") == 0) {
     return TRI_IDX_TYPE_GEO1_INDEX;
   }
@@ -269,6 +272,8 @@ char const* Index::oldtypeName(Index::IndexType type) {
       return "persistent";
     case TRI_IDX_TYPE_FULLTEXT_INDEX:
       return "fulltext";
+    case TRI_IDX_TYPE_TTL_INDEX:
+      return "ttl";
     case TRI_IDX_TYPE_GEO1_INDEX:
       return "geo1";
     case TRI_IDX_TYPE_GEO2_INDEX:
@@ -87,6 +87,7 @@ class Index {
     TRI_IDX_TYPE_FULLTEXT_INDEX,
     TRI_IDX_TYPE_SKIPLIST_INDEX,
     TRI_IDX_TYPE_PERSISTENT_INDEX,
+    TRI_IDX_TYPE_TTL_INDEX,
 #ifdef USE_IRESEARCH
     TRI_IDX_TYPE_IRESEARCH_LINK,
 #endif
@@ -226,6 +227,13 @@ class Index {
   /// add it as a performance optimization
   virtual bool hasCoveringIterator() const { return false; }
 
+  /// @brief the attributes whose values a covering iterator produces, in
+  /// the order of its array values
+  virtual std::vector<std::vector<arangodb::basics::AttributeName>> const&
+  coveredFields() const {
+    return _fields;
+  }
+
   /// @brief Checks if this index is identical to the given definition
   virtual bool matchesDefinition(arangodb::velocypack::Slice const&) const;
 
@@ -242,7 +250,17 @@ class Index {
   /// attribute attribute, a Slice would be more flexible.
   virtual double selectivityEstimate(
       arangodb::StringRef const* extra = nullptr) const;
-  
+
+  /// @brief estimate the share of index entries for which the first index
+  /// attribute satisfies all of the given condition parts, based on value
+  /// statistics of the index. returns a negative value if there is no
+  /// estimate for these conditions
+  virtual double firstAttributeSelectivity(
+      std::vector<arangodb::aql::AstNode const*> const& /*nodes*/,
+      arangodb::aql::Variable const* /*reference*/) const {
+    return -1.0;
+  }
+
   /// @brief update the cluster selectivity estimate
   virtual void updateClusterSelectivityEstimate(double estimate = 0.1) {
     TRI_ASSERT(false); // should never be called except on Coordinator
@@ -39,9 +39,14 @@ IndexIterator::IndexIterator(LogicalCollection* collection,
 }
 
 bool IndexIterator::nextDocument(DocumentCallback const& cb, size_t limit) {
-  return next([this, &cb](LocalDocumentId const& token) {
-    _collection->readDocumentWithCallback(_trx, token, cb);
+  // collect the ids first, so that the storage engine can read all documents
+  // in one go
+  _documentIds.clear();
+  bool hasMore = next([this](LocalDocumentId const& token) {
+    _documentIds.emplace_back(token);
   }, limit);
+  _collection->readDocumentsWithCallback(_trx, _documentIds, cb);
+  return hasMore;
 }
 
 /// @brief default implementation for nextCovering
@@ -143,3 +148,125 @@ void MultiIndexIterator::reset() {
     it->reset();
   }
 }
+
+IntersectionIndexIterator::IntersectionIndexIterator(
+    LogicalCollection* collection, transaction::Methods* trx,
+    arangodb::Index const* index, std::vector<IndexIterator*> const& iterators)
+    : IndexIterator(collection, trx, index),
+      _iterators(iterators),
+      _filtersRead(false) {
+  TRI_ASSERT(!_iterators.empty());
+}
+
+IntersectionIndexIterator::~IntersectionIndexIterator() {
+  // Free all iterators
+  for (auto& it : _iterators) {
+    delete it;
+  }
+}
+
+/// @brief read the results of all but the first iterator
+void IntersectionIndexIterator::readFilters() {
+  _filters.clear();
+  _filters.reserve(_iterators.size() - 1);
+
+  for (size_t i = 1; i < _iterators.size(); ++i) {
+    std::vector<LocalDocumentId> ids;
+    auto cb = [&ids](LocalDocumentId const& token) {
+      ids.emplace_back(token);
+    };
+    while (_iterators[i]->next(cb, 1000)) {
+    }
+    // array indexes may return the same document multiple times
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    _filters.emplace_back(std::move(ids));
+  }
+  _filtersRead = true;
+}
+
+/// @brief whether or not a document is returned by all other iterators
+bool IntersectionIndexIterator::accept(LocalDocumentId const& token) const {
+  for (auto const& it : _filters) {
+    if (!std::binary_search(it.begin(), it.end(), token)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// @brief call the producer with the remaining limit until the limit is
+///        reached or the first iterator is exhausted. the callbacks of the
+///        producer count down the limit
+template <typename F>
+bool IntersectionIndexIterator::produce(size_t& limit, F const& producer) {
+  if (!_filtersRead) {
+    readFilters();
+  }
+
+  for (auto const& it : _filters) {
+    if (it.empty()) {
+      // the intersection is empty
+      return false;
+    }
+  }
+
+  while (limit > 0) {
+    if (!producer(limit)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IntersectionIndexIterator::next(LocalDocumentIdCallback const& callback,
+                                     size_t limit) {
+  auto cb = [this, &limit, &callback](LocalDocumentId const& token) {
+    if (accept(token)) {
+      --limit;
+      callback(token);
+    }
+  };
+  return produce(limit, [this, &cb](size_t remaining) {
+    return _iterators[0]->next(cb, remaining);
+  });
+}
+
+bool IntersectionIndexIterator::nextDocument(DocumentCallback const& callback,
+                                             size_t limit) {
+  // filter by id before the documents are fetched
+  _documentIds.clear();
+  auto cb = [this, &limit](LocalDocumentId const& token) {
+    if (accept(token)) {
+      --limit;
+      _documentIds.emplace_back(token);
+    }
+  };
+  bool hasMore = produce(limit, [this, &cb](size_t remaining) {
+    return _iterators[0]->next(cb, remaining);
+  });
+  _collection->readDocumentsWithCallback(_trx, _documentIds, callback);
+  return hasMore;
+}
+
+bool IntersectionIndexIterator::nextCovering(DocumentCallback const& callback,
+                                             size_t limit) {
+  TRI_ASSERT(hasCovering());
+  auto cb = [this, &limit, &callback](LocalDocumentId const& token,
+                                      arangodb::velocypack::Slice slice) {
+    if (accept(token)) {
+      --limit;
+      callback(token, slice);
+    }
+  };
+  return produce(limit, [this, &cb](size_t remaining) {
+    return _iterators[0]->nextCovering(cb, remaining);
+  });
+}
+
+/// @brief Reset the cursor
+///        The results of the other iterators are kept, as they do not
+///        change within the transaction
+void IntersectionIndexIterator::reset() {
+  _iterators[0]->reset();
+}
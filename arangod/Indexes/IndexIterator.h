@@ -108,6 +108,9 @@ class IndexIterator {
  protected:
   LogicalCollection* _collection;
   transaction::Methods* _trx;
+
+  /// @brief ids of the documents to read in one batch by nextDocument
+  std::vector<LocalDocumentId> _documentIds;
 };
 
 /// @brief Special iterator if the condition cannot have any result
@@ -192,6 +195,55 @@ class MultiIndexIterator final : public IndexIterator {
    bool _hasCovering;
 };
 
+/// @brief an iterator that returns only those documents of its first
+///        iterator that are also returned by all other iterators. The
+///        results of the other iterators are read upfront into sorted lists,
+///        so the order of the first iterator is retained. The iterators
+///        are usually created at different indexes of the same collection
+class IntersectionIndexIterator final : public IndexIterator {
+ public:
+  IntersectionIndexIterator(LogicalCollection* collection,
+                            transaction::Methods* trx,
+                            arangodb::Index const* index,
+                            std::vector<IndexIterator*> const& iterators);
+
+  ~IntersectionIndexIterator();
+
+  char const* typeName() const override { return "intersection-index-iterator"; }
+
+  bool next(LocalDocumentIdCallback const& callback, size_t limit) override;
+
+  bool nextDocument(DocumentCallback const& callback, size_t limit) override;
+
+  bool nextCovering(DocumentCallback const& callback, size_t limit) override;
+
+  /// @brief Reset the cursor
+  ///        The results of the other iterators are kept, as they do not
+  ///        change within the transaction
+  void reset() override;
+
+  bool hasCovering() const override { return _iterators[0]->hasCovering(); }
+
+ private:
+  /// @brief read the results of all but the first iterator
+  void readFilters();
+
+  /// @brief whether or not a document is returned by all other iterators
+  bool accept(LocalDocumentId const& token) const;
+
+  /// @brief call the producer with the remaining limit until the limit is
+  ///        reached or the first iterator is exhausted. the callbacks of
+  ///        the producer count down the limit
+  template <typename F>
+  bool produce(size_t& limit, F const& producer);
+
+ private:
+  std::vector<IndexIterator*> _iterators;
+  /// @brief the sorted results of all but the first iterator
+  std::vector<std::vector<LocalDocumentId>> _filters;
+  bool _filtersRead;
+};
+
 /// Options for creating an index iterator
 struct IndexIteratorOptions {
   /// @brief whether the index must sort it's results
@@ -33,6 +33,35 @@
 
 using namespace arangodb;
 
+namespace {
+/// @brief estimated share of index entries per lookup value, from the value
+/// statistics of the index for its first attribute. returns a negative
+/// value if the index has no statistics for the condition
+double firstAttributeSelectivity(
+    arangodb::Index const* idx,
+    std::vector<arangodb::aql::AstNode const*> const& nodes,
+    arangodb::aql::Variable const* reference) {
+  double selectivity = idx->firstAttributeSelectivity(nodes, reference);
+  if (selectivity < 0.0) {
+    return selectivity;
+  }
+
+  // the selectivity covers all values of an IN list, but the caller counts
+  // lookup values separately
+  for (auto const& node : nodes) {
+    if (node->type == arangodb::aql::NODE_TYPE_OPERATOR_BINARY_IN) {
+      size_t av = SimpleAttributeEqualityMatcher::estimateNumberOfArrayMembers(
+          node->getMember(1));
+      if (av > 1) {
+        selectivity /= static_cast<double>(av);
+      }
+      break;
+    }
+  }
+  return selectivity;
+}
+}
+
 bool PersistentIndexAttributeMatcher::accessFitsIndex(
     arangodb::Index const* idx, arangodb::aql::AstNode const* access,
     arangodb::aql::AstNode const* other, arangodb::aql::AstNode const* op,
@@ -205,6 +234,7 @@ bool PersistentIndexAttributeMatcher::supportsFilterCondition(
   size_t attributesCovered = 0;
   size_t attributesCoveredByEquality = 0;
   double equalityReductionFactor = 20.0;
+  bool usesStatistics = false;
   estimatedCost = static_cast<double>(itemsInIndex);
 
   for (size_t i = 0; i < idx->fields().size(); ++i) {
@@ -232,7 +262,19 @@ bool PersistentIndexAttributeMatcher::supportsFilterCondition(
     }
 
     ++attributesCovered;
-    if (containsEquality) {
+    double const selectivity =
+        (i == 0) ? ::firstAttributeSelectivity(idx, nodes, reference) : -1.0;
+
+    if (selectivity >= 0.0) {
+      // the index has value statistics for its first attribute, which are
+      // much more precise than the reduction factors below
+      usesStatistics = true;
+      estimatedCost *= selectivity;
+      if (containsEquality) {
+        ++attributesCoveredByEquality;
+        equalityReductionFactor *= 0.25;
+      }
+    } else if (containsEquality) {
       ++attributesCoveredByEquality;
       estimatedCost /= equalityReductionFactor;
 
@@ -286,9 +328,11 @@ bool PersistentIndexAttributeMatcher::supportsFilterCondition(
     estimatedItems = static_cast<size_t>((std::max)(
         static_cast<size_t>(estimatedCost * values), static_cast<size_t>(1)));
 
-    // check if the index has a selectivity estimate ready
+    // check if the index has a selectivity estimate ready. for a single
+    // attribute, the value statistics are more precise than the average
     if (idx->hasSelectivityEstimate() &&
-        attributesCoveredByEquality == idx->fields().size()) {
+        attributesCoveredByEquality == idx->fields().size() &&
+        !(usesStatistics && idx->fields().size() == 1)) {
       StringRef ignore;
       double estimate = idx->selectivityEstimate(&ignore);
       if (estimate > 0.0) {
@@ -308,6 +352,11 @@ bool PersistentIndexAttributeMatcher::supportsFilterCondition(
                      std::log2(static_cast<double>(itemsInIndex)) * values) -
           (idx->fields().size() - 1) * 0.01;
       //}
+      if (usesStatistics) {
+        // with value statistics, the number of entries to scan is known
+        // well enough to tell selective from unselective indexes apart
+        estimatedCost += static_cast<double>(estimatedItems);
+      }
     }
     return true;
   }
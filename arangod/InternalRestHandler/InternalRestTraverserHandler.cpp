@@ -190,10 +190,20 @@ void InternalRestTraverserHandler::queryEngine() {
                         "expecting 'depth' to be an integer value");
           return;
         }
+        VPackSlice lookaheadSlice = body.get("lookahead");
+        if (!lookaheadSlice.isNone() && !lookaheadSlice.isInteger()) {
+          generateError(ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                        "expecting 'lookahead' to be an integer value");
+          return;
+        }
+        size_t lookahead = lookaheadSlice.isInteger()
+                               ? lookaheadSlice.getNumericValue<size_t>()
+                               : 0;
         // Save Cast BaseTraverserEngines are all of type TRAVERSER
         auto eng = static_cast<BaseTraverserEngine*>(engine);
         TRI_ASSERT(eng != nullptr);
-        eng->getEdges(keysSlice, depthSlice.getNumericValue<size_t>(), result);
+        eng->getEdges(keysSlice, depthSlice.getNumericValue<size_t>(),
+                      lookahead, result);
         break;
       }
       case BaseEngine::EngineType::SHORTESTPATH: {
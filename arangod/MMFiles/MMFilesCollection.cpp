@@ -67,6 +67,8 @@
 #include "VocBase/LogicalCollection.h"
 #include "VocBase/ticks.h"
 
+#include <thread>
+
 using namespace arangodb;
 using Helper = arangodb::basics::VelocyPackHelper;
 
@@ -1007,6 +1009,11 @@ MMFilesDatafile* MMFilesCollection::createDatafile(TRI_voc_fid_t fid,
   // datafile is there now
   TRI_ASSERT(datafile != nullptr);
 
+  if (static_cast<MMFilesEngine*>(EngineSelectorFeature::ENGINE)
+          ->journalHugePages()) {
+    datafile->hugePages();
+  }
+
   if (isCompactor) {
     LOG_TOPIC(TRACE, arangodb::Logger::DATAFILES) << "created new compactor '"
                                                   << datafile->getName() << "'";
@@ -1144,6 +1151,17 @@ bool MMFilesCollection::iterateDatafiles(
   return true;
 }
 
+/// @brief advise the kernel that all datafiles and journals will be read
+void MMFilesCollection::prefetchDatafiles() {
+  READ_LOCKER(readLocker, _filesLock);
+
+  for (auto const* files : {&_datafiles, &_compactors, &_journals}) {
+    for (auto& datafile : *files) {
+      datafile->willNeed();
+    }
+  }
+}
+
 /// @brief iterate over all datafiles in a vector
 /// the caller must hold the _filesLock
 bool MMFilesCollection::iterateDatafilesVector(
@@ -1605,20 +1623,33 @@ int MMFilesCollection::fillIndexes(
       blockSize = 1;
     }
 
-    auto documentsPtr = std::make_shared<std::vector<std::pair<LocalDocumentId, VPackSlice>>>();
-    std::vector<std::pair<LocalDocumentId, VPackSlice>>& documents = *documentsPtr.get();
-    documents.reserve(blockSize);
+    typedef std::vector<std::pair<LocalDocumentId, VPackSlice>> Documents;
 
-    auto insertInAllIndexes = [&]() -> void {
-      for (size_t i = 0; i < n; ++i) {
-        auto idx = indexes[i];
-        if (idx->type() == Index::IndexType::TRI_IDX_TYPE_PRIMARY_INDEX) {
-          continue;
+    // the indexes are filled with one block of documents while the next
+    // block is collected
+    auto documentsPtr = std::make_shared<Documents>();
+    auto fillingPtr = std::make_shared<Documents>();
+    documentsPtr->reserve(blockSize);
+    fillingPtr->reserve(blockSize);
+
+    auto insertInAllIndexes = [&](std::shared_ptr<Documents> const& docs) -> void {
+      try {
+        for (size_t i = 0; i < n; ++i) {
+          auto idx = indexes[i];
+          if (idx->type() == Index::IndexType::TRI_IDX_TYPE_PRIMARY_INDEX) {
+            continue;
+          }
+          fillIndex(queue, trx, idx.get(), docs, skipPersistent);
         }
-        fillIndex(queue, trx, idx.get(), documentsPtr, skipPersistent);
-      }
 
-      queue->dispatchAndWait();
+        queue->dispatchAndWait();
+      } catch (arangodb::basics::Exception const& ex) {
+        queue->setStatus(ex.code());
+      } catch (std::bad_alloc const&) {
+        queue->setStatus(TRI_ERROR_OUT_OF_MEMORY);
+      } catch (...) {
+        queue->setStatus(TRI_ERROR_INTERNAL);
+      }
 
       if (queue->status() != TRI_ERROR_NO_ERROR) {
         rollbackAll();
@@ -1626,6 +1657,14 @@ int MMFilesCollection::fillIndexes(
       }
     };
 
+    std::thread filler;
+    auto waitForFiller = [&filler]() {
+      if (filler.joinable()) {
+        filler.join();
+      }
+    };
+    TRI_DEFER(waitForFiller());
+
     if (nrUsed > 0) {
       arangodb::basics::BucketPosition position;
       uint64_t total = 0;
@@ -1642,23 +1681,28 @@ int MMFilesCollection::fillIndexes(
 
         uint8_t const* vpack = lookupDocumentVPack(documentId);
         if (vpack != nullptr) {
-          documents.emplace_back(std::make_pair(documentId, VPackSlice(vpack)));
+          documentsPtr->emplace_back(std::make_pair(documentId, VPackSlice(vpack)));
 
-          if (documents.size() == blockSize) {
-            // now actually fill the secondary indexes
-            insertInAllIndexes();
+          if (documentsPtr->size() == blockSize) {
+            // wait until the previous block is done, and fill the secondary
+            // indexes with this one in the background
+            waitForFiller();
             if (queue->status() != TRI_ERROR_NO_ERROR) {
               break;
             }
-            documents.clear();
+            std::swap(documentsPtr, fillingPtr);
+            documentsPtr->clear();
+            filler = std::thread(insertInAllIndexes, fillingPtr);
           }
         }
       }
     }
 
+    waitForFiller();
+
     // process the remainder of the documents
-    if (queue->status() == TRI_ERROR_NO_ERROR && !documents.empty()) {
-      insertInAllIndexes();
+    if (queue->status() == TRI_ERROR_NO_ERROR && !documentsPtr->empty()) {
+      insertInAllIndexes(documentsPtr);
     }
   } catch (arangodb::basics::Exception const& ex) {
     queue->setStatus(ex.code());
@@ -2133,10 +2177,8 @@ std::shared_ptr<Index> MMFilesCollection::createIndex(transaction::Methods* trx,
     THROW_ARANGO_EXCEPTION(res);
   }
 
-#if USE_PLAN_CACHE
   arangodb::aql::PlanCache::instance()->invalidate(
-      _logicalCollection->vocbase());
-#endif
+      &_logicalCollection->vocbase());
   // Until here no harm is done if sth fails. The shared ptr will clean up. if
   // left before
 
@@ -155,6 +155,10 @@ class MMFilesCollection final : public PhysicalCollection {
   size_t journalSize() const;
   bool isVolatile() const;
 
+  /// @brief advise the kernel that all datafiles and journals will be read
+  /// soon, e.g. before an export of the full collection
+  void prefetchDatafiles();
+
   TRI_voc_tick_t maxTick() const { return _maxTick; }
   void maxTick(TRI_voc_tick_t value) { _maxTick = value; }
 
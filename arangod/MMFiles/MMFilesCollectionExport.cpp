@@ -110,6 +110,7 @@ void MMFilesCollectionExport::run(uint64_t maxWaitTime, size_t limit) {
     }
 
     size_t maxDocuments = _collection->numberDocuments(&trx);
+    bool const fullExport = (limit == 0 || limit >= maxDocuments);
 
     if (limit > 0 && limit < maxDocuments) {
       maxDocuments = limit;
@@ -120,6 +121,14 @@ void MMFilesCollectionExport::run(uint64_t maxWaitTime, size_t limit) {
     _vpack.reserve(maxDocuments);
 
     MMFilesCollection* mmColl = MMFilesCollection::toMMFilesCollection(_collection);
+
+    if (fullExport) {
+      // the documents are read in primary index order, which is random with
+      // respect to their positions in the datafiles. let the kernel read the
+      // files ahead in the background while we go
+      mmColl->prefetchDatafiles();
+    }
+
     ManagedDocumentResult mmdr;
     trx.invokeOnAllElements(_collection->name(), [this, &limit, &trx, &mmdr, mmColl](LocalDocumentId const& token) {
       if (limit == 0) {
@@ -47,7 +47,8 @@ MMFilesCompactionFeature::MMFilesCompactionFeature(ApplicationServer* server)
     _maxResultFilesize(128 * 1024 * 1024),
     _deadNumberThreshold(16384),
     _deadSizeThreshold(128 * 1024),
-    _deadShare(0.1) { 
+    _deadShare(0.1),
+    _maxIORate(0.0) { 
   setOptional(true);
   onlyEnabledWith("MMFilesEngine");
   MMFilesCompactionFeature::COMPACTOR = this;
@@ -85,6 +86,9 @@ void MMFilesCompactionFeature::collectOptions(std::shared_ptr<options::ProgramOp
 
   options->addOption("--compaction.max-file-size-factor", "how large the resulting file may be in comparison to the collections '--database.maximal-journal-size' setting",
                      new UInt64Parameter(&_maxSizeFactor));
+
+  options->addOption("--compaction.max-io-rate", "maximum disk I/O rate of the compactor (in MB/s, 0 = unlimited). with a limit, datafiles are compacted by their cost/benefit ratio in small steps",
+                     new DoubleParameter(&_maxIORate));
 }
 
 void MMFilesCompactionFeature::validateOptions(std::shared_ptr<options::ProgramOptions> options) {
@@ -118,4 +122,14 @@ void MMFilesCompactionFeature::validateOptions(std::shared_ptr<options::ProgramO
     _maxSizeFactor = 1;
   }
 
+  if (_maxIORate < 0.0) {
+    LOG_TOPIC(WARN, Logger::COMPACTOR)
+      << "compaction.max-io-rate should be at least: 0";
+    _maxIORate = 0.0;
+  } else if (_maxIORate > 0.0 && _maxIORate < 1.0) {
+    LOG_TOPIC(WARN, Logger::COMPACTOR)
+      << "compaction.max-io-rate should be at least 1 MB/s if set.";
+    _maxIORate = 1.0;
+  }
+
 }
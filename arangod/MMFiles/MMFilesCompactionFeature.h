@@ -71,6 +71,11 @@ class MMFilesCompactionFeature : public application_features::ApplicationFeature
   /// if this value if higher than the threshold, the datafile will be compacted
   double _deadShare;
 
+  /// @brief maximum disk I/O rate of the compactor in MB/s, 0 means
+  /// unlimited. with a limit, datafiles are picked by their cost/benefit
+  /// ratio, and compaction runs in steps of about a second of the budget
+  double _maxIORate;
+
   MMFilesCompactionFeature(MMFilesCompactionFeature const&) = delete;
   MMFilesCompactionFeature& operator=(MMFilesCompactionFeature const&) = delete;
 
@@ -114,6 +119,10 @@ class MMFilesCompactionFeature : public application_features::ApplicationFeature
   /// if this value if higher than the threshold, the datafile will be compacted
   double deadShare() const { return _deadShare; }
 
+  /// @brief maximum disk I/O rate of the compactor in bytes per second,
+  /// 0 means unlimited
+  uint64_t maxIORate() const { return static_cast<uint64_t>(_maxIORate * 1024.0 * 1024.0); }
+
   
  public:
   void collectOptions(std::shared_ptr<options::ProgramOptions>) override final;
@@ -70,6 +70,45 @@ static char const* ReasonDeadCount =
     "compacting datafile because it contains many dead objects";
 static char const* ReasonNothingToCompact =
     "checked datafiles, but no compaction opportunity found";
+
+/// @brief the reason for compacting a datafile, or nullptr if nothing
+/// qualifies it for compaction. numAlive is the number of alive documents
+/// in the datafiles before it
+static char const* compactionReason(MMFilesDatafile const* df,
+                                    MMFilesDatafileStatisticsContainer const& dfi,
+                                    uint64_t numDocuments, int64_t numAlive,
+                                    bool checkSmall) {
+  if (checkSmall &&
+      df->maximalSize() < MMFilesCompactionFeature::COMPACTOR->smallDatafileSize()) {
+    // very small datafile and not the last one. let's compact it so it's
+    // merged with others
+    return ReasonDatafileSmall;
+  } else if (numDocuments == 0 &&
+             (dfi.numberAlive > 0 || dfi.numberDead > 0 ||
+              dfi.numberDeletions > 0)) {
+    // collection is empty, but datafile statistics indicate there is
+    // something in this datafile
+    return ReasonEmpty;
+  } else if (numAlive == 0 && dfi.numberAlive == 0 &&
+             dfi.numberDeletions > 0) {
+    // compact first datafile(s) if they contain only deletions
+    return ReasonOnlyDeletions;
+  } else if (dfi.sizeDead >= MMFilesCompactionFeature::COMPACTOR->deadSizeThreshold()) {
+    // the size of dead objects is above some threshold
+    return ReasonDeadSize;
+  } else if (dfi.sizeDead > 0 &&
+             (((double)dfi.sizeDead /
+                   ((double)dfi.sizeDead + (double)dfi.sizeAlive) >= MMFilesCompactionFeature::COMPACTOR->deadShare()) ||
+              ((double)dfi.sizeDead / (double)df->maximalSize() >= MMFilesCompactionFeature::COMPACTOR->deadShare()))) {
+    // the size of dead objects is above some share
+    return ReasonDeadSizeShare;
+  } else if (dfi.numberDead >= MMFilesCompactionFeature::COMPACTOR->deadNumberThreshold()) {
+    // the number of dead objects is above some threshold
+    return ReasonDeadCount;
+  }
+
+  return nullptr;
+}
   
 /// @brief compaction state
 namespace arangodb {
@@ -521,6 +560,9 @@ void MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
     ++nrCombined;
   }  // next file
 
+  // account the I/O for rate-limited compaction
+  _ioBytes += compactionBytesRead + static_cast<uint64_t>(context->_dfi.sizeAlive);
+
   TRI_ASSERT(context->_dfi.numberDead == 0);
   TRI_ASSERT(context->_dfi.sizeDead == 0);
 
@@ -699,6 +741,37 @@ bool MMFilesCompactorThread::compactCollection(LogicalCollection* collection, bo
     maxSize = MMFilesCompactionFeature::COMPACTOR->maxResultFilesize();
   }
 
+  uint64_t const maxIORate = MMFilesCompactionFeature::COMPACTOR->maxIORate();
+
+  if (maxIORate > 0) {
+    // rate-limited compaction. compact only about a second worth of I/O
+    // budget in one step, so other collections and the throttling get
+    // their turn soon
+    for (auto const* df : datafiles) {
+      if (df->state() == TRI_DF_STATE_OPEN_ERROR || df->state() == TRI_DF_STATE_WRITE_ERROR) {
+        LOG_TOPIC(WARN, Logger::COMPACTOR) << "cannot compact datafile " << df->fid() << " of collection '" << collection->name() << "' because it has errors";
+        physical->setCompactionStatus(ReasonCorrupted);
+        return false;
+      }
+    }
+
+    char const* reason = selectByBenefit(collection, datafiles, numDocuments,
+                                         (std::min)(maxSize, maxIORate), toCompact);
+    readLocker.unlock();
+
+    if (toCompact.empty()) {
+      physical->setNextCompactionStartIndex(0);
+      physical->setCompactionStatus(ReasonNothingToCompact);
+      LOG_TOPIC(DEBUG, Logger::COMPACTOR) << "inspecting datafiles of collection yielded: " << ReasonNothingToCompact;
+      return false;
+    }
+
+    TRI_ASSERT(reason != nullptr);
+    physical->setCompactionStatus(reason);
+    compactDatafiles(collection, toCompact);
+    return true;
+  }
+
   if (start >= n || numDocuments == 0) {
     start = 0;
   }
@@ -737,40 +810,11 @@ bool MMFilesCompactorThread::compactCollection(LogicalCollection* collection, bo
       break;
     }
 
-    if (!doCompact &&
-        df->maximalSize() < MMFilesCompactionFeature::COMPACTOR->smallDatafileSize() &&
-        (i < n - 1)) {
-      // very small datafile and not the last one. let's compact it so it's
-      // merged with others
-      doCompact = true;
-      reason = ReasonDatafileSmall;
-    } else if (numDocuments == 0 &&
-               (dfi.numberAlive > 0 || dfi.numberDead > 0 ||
-                dfi.numberDeletions > 0)) {
-      // collection is empty, but datafile statistics indicate there is
-      // something in this datafile
-      doCompact = true;
-      reason = ReasonEmpty;
-    } else if (numAlive == 0 && dfi.numberAlive == 0 &&
-               dfi.numberDeletions > 0) {
-      // compact first datafile(s) if they contain only deletions
-      doCompact = true;
-      reason = ReasonOnlyDeletions;
-    } else if (dfi.sizeDead >= MMFilesCompactionFeature::COMPACTOR->deadSizeThreshold()) {
-      // the size of dead objects is above some threshold
-      doCompact = true;
-      reason = ReasonDeadSize;
-    } else if (dfi.sizeDead > 0 &&
-               (((double)dfi.sizeDead /
-                     ((double)dfi.sizeDead + (double)dfi.sizeAlive) >= MMFilesCompactionFeature::COMPACTOR->deadShare()) ||
-                ((double)dfi.sizeDead / (double)df->maximalSize() >= MMFilesCompactionFeature::COMPACTOR->deadShare()))) {
-      // the size of dead objects is above some share
+    char const* datafileReason = compactionReason(df, dfi, numDocuments, numAlive,
+                                                  !doCompact && (i < n - 1));
+    if (datafileReason != nullptr) {
       doCompact = true;
-      reason = ReasonDeadSizeShare;
-    } else if (dfi.numberDead >= MMFilesCompactionFeature::COMPACTOR->deadNumberThreshold()) {
-      // the number of dead objects is above some threshold
-      doCompact = true;
-      reason = ReasonDeadCount;
+      reason = datafileReason;
     }
 
     if (!doCompact) {
@@ -873,8 +917,127 @@ bool MMFilesCompactorThread::compactCollection(LogicalCollection* collection, bo
   return true;
 }
 
+/// @brief pick the datafiles for a rate-limited compaction step
+char const* MMFilesCompactorThread::selectByBenefit(
+    LogicalCollection* collection, std::vector<MMFilesDatafile*> const& datafiles,
+    uint64_t numDocuments, uint64_t stepSize,
+    std::vector<CompactionInfo>& toCompact) {
+  auto physical = static_cast<MMFilesCollection*>(collection->getPhysical());
+  size_t const n = datafiles.size();
+
+  // collect the statistics. datafiles with uncollected entries and all
+  // datafiles after them cannot be compacted yet
+  std::vector<MMFilesDatafileStatisticsContainer> stats;
+  std::vector<char const*> reasons;
+  std::vector<int64_t> aliveBefore;
+  stats.reserve(n);
+  reasons.reserve(n);
+  aliveBefore.reserve(n);
+
+  int64_t numAlive = 0;
+  for (size_t i = 0; i < n; ++i) {
+    MMFilesDatafile const* df = datafiles[i];
+    MMFilesDatafileStatisticsContainer dfi = physical->_datafileStatistics.get(df->fid());
+
+    if (dfi.numberUncollected > 0) {
+      LOG_TOPIC(DEBUG, Logger::COMPACTOR) << "cannot compact datafile " << df->fid() << " of collection '" << collection->name() << "' because it still has uncollected entries";
+      break;
+    }
+
+    reasons.emplace_back(compactionReason(df, dfi, numDocuments, numAlive, i < n - 1));
+    aliveBefore.emplace_back(numAlive);
+    numAlive += static_cast<int64_t>(dfi.numberAlive);
+    stats.emplace_back(dfi);
+  }
+
+  // score the eligible datafiles by the space compaction gives back in
+  // relation to its I/O, which is reading the datafile and writing its alive
+  // share u: (1 - u) / (1 + u). older datafiles are preferred, as their
+  // data is less likely to die soon anyway. the position of a datafile
+  // serves as its age
+  size_t const m = stats.size();
+  size_t best = m;
+  double bestScore = -1.0;
+
+  for (size_t i = 0; i < m; ++i) {
+    if (reasons[i] == nullptr) {
+      continue;
+    }
+
+    double const total = static_cast<double>(stats[i].sizeAlive + stats[i].sizeDead);
+    double const u = (total > 0.0) ? static_cast<double>(stats[i].sizeAlive) / total : 0.0;
+    double const score = (1.0 - u) * static_cast<double>(m - i) / (1.0 + u);
+
+    if (score > bestScore) {
+      bestScore = score;
+      best = i;
+    }
+  }
+
+  if (best == m) {
+    return nullptr;
+  }
+
+  // compact a run of adjacent datafiles starting at the best one, as long
+  // as the step size allows. a small datafile is always merged with the
+  // one after it
+  uint64_t totalSize = 0;
+  for (size_t i = best; i < m; ++i) {
+    if (i > best && reasons[i] == nullptr && reasons[i - 1] != ReasonDatafileSmall) {
+      break;
+    }
+
+    MMFilesDatafile* df = datafiles[i];
+    if (!toCompact.empty() && reasons[i] != ReasonOnlyDeletions &&
+        totalSize + static_cast<uint64_t>(df->maximalSize()) > stepSize) {
+      break;
+    }
+
+    LOG_TOPIC(DEBUG, Logger::COMPACTOR) << "found datafile #" << i << " eligible for rate-limited compaction. fid: " << df->fid() << ", size: " << df->maximalSize() << ", score: " << (i == best ? bestScore : 0.0) << ", sizeDead: " << stats[i].sizeDead << ", sizeAlive: " << stats[i].sizeAlive;
+    totalSize += static_cast<uint64_t>(df->maximalSize());
+
+    CompactionInfo compaction;
+    compaction._datafile = df;
+    compaction._keepDeletions = (aliveBefore[i] > 0 && i > 0);
+    toCompact.push_back(compaction);
+
+    if (toCompact.size() >= MMFilesCompactionFeature::COMPACTOR->maxFiles()) {
+      break;
+    }
+  }
+
+  return reasons[best];
+}
+
+/// @brief sleep until the compaction I/O fits into the configured rate
+void MMFilesCompactorThread::throttle() {
+  uint64_t const maxIORate = MMFilesCompactionFeature::COMPACTOR->maxIORate();
+  double const now = TRI_microtime();
+
+  if (maxIORate == 0 || _ioBytes == 0) {
+    _ioBytes = 0;
+    _lastThrottle = now;
+    return;
+  }
+
+  // idle time counts as budget, but only up to one second of it
+  double const end = (std::max)(_lastThrottle, now - 1.0) +
+                     static_cast<double>(_ioBytes) / static_cast<double>(maxIORate);
+  _ioBytes = 0;
+  _lastThrottle = (std::max)(end, now);
+
+  CONDITION_LOCKER(locker, _condition);
+  while (!isStopping() && _vocbase.state() == TRI_vocbase_t::State::NORMAL) {
+    double const remaining = end - TRI_microtime();
+    if (remaining <= 0.0) {
+      break;
+    }
+    locker.wait(static_cast<uint64_t>(remaining * 1000000.0));
+  }
+}
+
 MMFilesCompactorThread::MMFilesCompactorThread(TRI_vocbase_t& vocbase)
-    : Thread("Compactor"), _vocbase(vocbase) {}
+    : Thread("Compactor"), _vocbase(vocbase), _ioBytes(0), _lastThrottle(0.0), _nextCollection(0) {}
 
 MMFilesCompactorThread::~MMFilesCompactorThread() { shutdown(); }
 
@@ -906,7 +1069,20 @@ void MMFilesCompactorThread::run() {
           collections.clear();
         }
   
-        for (auto& collection : collections) {
+        // with a rate limit, a run ends when its I/O budget is used up, and
+        // the next run continues with the following collections
+        uint64_t const maxIORate = MMFilesCompactionFeature::COMPACTOR->maxIORate();
+        size_t const n = collections.size();
+        size_t const first = (maxIORate > 0 && n > 0) ? _nextCollection % n : 0;
+        _nextCollection = 0;
+
+        for (size_t i = 0; i < n; ++i) {
+          if (maxIORate > 0 && _ioBytes >= maxIORate) {
+            _nextCollection = first + i;
+            break;
+          }
+
+          auto& collection = collections[(first + i) % n];
           bool worked = false;
             
           if (engine->isCompactionDisabled()) {
@@ -998,6 +1174,12 @@ void MMFilesCompactorThread::run() {
         }
       }, true);
 
+      if (_ioBytes > 0) {
+        // stay within the I/O rate of the compactor. this is outside of all
+        // locks, so it does not block any other operation
+        throttle();
+      }
+
       if (numCompacted > 0) {
         // no need to sleep long or go into wait state if we worked.
         // maybe there's still work left
@@ -91,6 +91,18 @@ class MMFilesCompactorThread final : public Thread {
   /// @brief checks all datafiles of a collection
   bool compactCollection(LogicalCollection* collection, bool& wasBlocked);
 
+  /// @brief pick the datafiles with the best ratio of reclaimed space to
+  /// copied data, up to stepSize bytes, for rate-limited compaction.
+  /// returns the reason for compacting the first of them, or nullptr
+  char const* selectByBenefit(LogicalCollection* collection,
+                              std::vector<MMFilesDatafile*> const& datafiles,
+                              uint64_t numDocuments, uint64_t stepSize,
+                              std::vector<CompactionInfo>& toCompact);
+
+  /// @brief sleep until the I/O of the compaction steps so far fits into
+  /// the configured rate. returns early on shutdown
+  void throttle();
+
   int removeCompactor(LogicalCollection* collection, MMFilesDatafile* datafile);
 
   /// @brief remove an empty datafile
@@ -105,6 +117,15 @@ class MMFilesCompactorThread final : public Thread {
 
   TRI_vocbase_t& _vocbase;
   arangodb::basics::ConditionVariable _condition;
+
+  /// @brief bytes read and written by compaction since the last throttle
+  uint64_t _ioBytes;
+
+  /// @brief end of the last throttling
+  double _lastThrottle;
+
+  /// @brief collection to continue with after a throttled compaction run
+  size_t _nextCollection;
 };
 
 }
@@ -551,6 +551,13 @@ void MMFilesDatafile::dontDump() {
   TRI_MMFileAdvise(_data, _initSize, TRI_MADVISE_DONTDUMP);
 }
 
+void MMFilesDatafile::hugePages() {
+  if (TRI_MADVISE_HUGEPAGE != 0) {
+    // a value of 0 would reset the other advices
+    TRI_MMFileAdvise(_data, _initSize, TRI_MADVISE_HUGEPAGE);
+  }
+}
+
 int MMFilesDatafile::lockInMemory() {
   TRI_ASSERT(!_lockedInMemory);
   int res = TRI_MMFileLock(_data, _initSize);
@@ -247,6 +247,7 @@ struct MMFilesDatafile {
   void willNeed();
   void dontNeed();
   void dontDump();
+  void hugePages();
   bool readOnly();
   bool readWrite();
 
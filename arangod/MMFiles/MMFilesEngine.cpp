@@ -54,6 +54,8 @@
 #include "MMFiles/MMFilesWalAccess.h"
 #include "MMFiles/MMFilesWalRecoveryFeature.h"
 #include "MMFiles/mmfiles-replication-dump.h"
+#include "ProgramOptions/ProgramOptions.h"
+#include "ProgramOptions/Section.h"
 #include "Random/RandomGenerator.h"
 #include "RestServer/DatabaseFeature.h"
 #include "RestServer/DatabasePathFeature.h"
@@ -70,6 +72,7 @@
 
 using namespace arangodb;
 using namespace arangodb::basics;
+using namespace arangodb::options;
 
 namespace {
 /// @brief collection meta info filename
@@ -164,6 +167,7 @@ MMFilesEngine::MMFilesEngine(application_features::ApplicationServer* server)
         std::unique_ptr<IndexFactory>(new MMFilesIndexFactory())
       ),
       _isUpgrade(false),
+      _journalHugePages(false),
       _maxTick(0),
       _walAccess(new MMFilesWalAccess()),
       _releasedTick(0),
@@ -215,7 +219,17 @@ Result MMFilesEngine::dropDatabase(TRI_vocbase_t& database) {
 }
 
 // add the storage engine's specifc options to the global list of options
-void MMFilesEngine::collectOptions(std::shared_ptr<options::ProgramOptions>) {}
+void MMFilesEngine::collectOptions(
+    std::shared_ptr<options::ProgramOptions> options) {
+  options->addSection("mmfiles", "MMFiles engine specific configuration");
+
+  options->addOption("--mmfiles.journal-huge-pages",
+                     "advise the kernel to back journals and compaction "
+                     "files with transparent huge pages. this only has an "
+                     "effect where the kernel supports huge pages for the "
+                     "mapping, e.g. for volatile collections",
+                     new BooleanParameter(&_journalHugePages));
+}
 
 // validate the storage engine's specific options
 void MMFilesEngine::validateOptions(std::shared_ptr<options::ProgramOptions>) {}
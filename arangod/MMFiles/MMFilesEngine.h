@@ -236,6 +236,9 @@ class MMFilesEngine final : public StorageEngine {
   // wal in recovery
   bool inRecovery() override;
 
+  /// @brief whether journals and compaction files use huge pages
+  bool journalHugePages() const { return _journalHugePages; }
+
   // start compactor thread and delete files form collections marked as deleted
   void recoveryDone(TRI_vocbase_t& vocbase) override;
 
@@ -582,6 +585,7 @@ class MMFilesEngine final : public StorageEngine {
   std::string _basePath;
   std::string _databasePath;
   bool _isUpgrade;
+  bool _journalHugePages;
   TRI_voc_tick_t _maxTick;
   /// @brief Local wal access abstraction
   std::unique_ptr<MMFilesWalAccess> _walAccess;
@@ -227,6 +227,31 @@ Result MMFilesFulltextIndex::insert(transaction::Methods*,
   return IndexResult(res, this);
 }
 
+void MMFilesFulltextIndex::batchInsert(
+    transaction::Methods*,
+    std::vector<std::pair<LocalDocumentId, VPackSlice>> const& documents,
+    std::shared_ptr<arangodb::basics::LocalTaskQueue> queue) {
+  // splitting the texts into words is the expensive part, and can be done
+  // in parallel
+  batchInsertPrepared<std::set<std::string>>(
+      documents, queue,
+      [this](LocalDocumentId const&, VPackSlice doc,
+             std::set<std::string>& words) -> int {
+        words = wordlist(doc);
+        return TRI_ERROR_NO_ERROR;
+      },
+      [this](LocalDocumentId const& documentId,
+             std::set<std::string>& words) -> int {
+        if (words.empty()) {
+          return TRI_ERROR_NO_ERROR;
+        }
+        int res = TRI_InsertWordsMMFilesFulltextIndex(_fulltextIndex,
+                                                      documentId, words);
+        std::set<std::string>().swap(words);
+        return res;
+      });
+}
+
 Result MMFilesFulltextIndex::remove(transaction::Methods*,
                                     LocalDocumentId const& documentId,
                                     VPackSlice const& doc, OperationMode mode) {
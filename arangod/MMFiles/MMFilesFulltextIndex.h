@@ -73,6 +73,13 @@ class MMFilesFulltextIndex final : public MMFilesIndex {
                 arangodb::velocypack::Slice const&,
                 OperationMode mode) override;
 
+  void batchInsert(
+      transaction::Methods*,
+      std::vector<std::pair<LocalDocumentId, arangodb::velocypack::Slice>> const&,
+      std::shared_ptr<arangodb::basics::LocalTaskQueue>) override;
+
+  bool hasBatchInsert() const override { return true; }
+
   void load() override {}
   void unload() override;
 
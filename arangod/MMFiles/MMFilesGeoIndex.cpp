@@ -94,7 +94,7 @@ struct NearIterator final : public IndexIterator {
           }
           VPackSlice doc(_mmdr->vpack());
           geo::FilterType const ft = _near.filterType();
-          if (ft != geo::FilterType::NONE) {  // expensive test
+          if (ft != geo::FilterType::NONE && !gdoc.contained) {  // expensive test
             geo::ShapeContainer const& filter = _near.filterShape();
             TRI_ASSERT(!filter.empty());
             geo::ShapeContainer test;
@@ -118,7 +118,7 @@ struct NearIterator final : public IndexIterator {
     return nextToken(
         [this, &cb](geo_index::Document const& gdoc) -> bool {
           geo::FilterType const ft = _near.filterType();
-          if (ft != geo::FilterType::NONE) {
+          if (ft != geo::FilterType::NONE && !gdoc.contained) {
             geo::ShapeContainer const& filter = _near.filterShape();
             TRI_ASSERT(!filter.empty());
             if (!_collection->readDocument(_trx, gdoc.token, *_mmdr)) {
@@ -348,6 +348,42 @@ Result MMFilesGeoIndex::insert(transaction::Methods*,
   return IndexResult();
 }
 
+void MMFilesGeoIndex::batchInsert(
+    transaction::Methods*,
+    std::vector<std::pair<LocalDocumentId, VPackSlice>> const& documents,
+    std::shared_ptr<arangodb::basics::LocalTaskQueue> queue) {
+  // the coverings of the documents are computed in parallel, and then
+  // inserted into the tree
+  typedef std::pair<std::vector<S2CellId>, S2Point> Covering;
+
+  batchInsertPrepared<Covering>(
+      documents, queue,
+      [this](LocalDocumentId const&, VPackSlice doc,
+             Covering& covering) -> int {
+        covering.first.reserve(_variant == Variant::GEOJSON ? 8 : 1);
+        Result res =
+            geo_index::Index::indexCells(doc, covering.first, covering.second);
+
+        if (res.fail()) {
+          covering.first.clear();
+          // Invalid, no insert. Index is sparse
+          return res.is(TRI_ERROR_BAD_PARAMETER) ? TRI_ERROR_NO_ERROR
+                                                 : res.errorNumber();
+        }
+        TRI_ASSERT(!covering.first.empty());
+        TRI_ASSERT(S2::IsUnitLength(covering.second));
+        return TRI_ERROR_NO_ERROR;
+      },
+      [this](LocalDocumentId const& documentId, Covering& covering) -> int {
+        IndexValue value(documentId, std::move(covering.second));
+        for (S2CellId cell : covering.first) {
+          _tree.insert(std::make_pair(cell, value));
+        }
+        std::vector<S2CellId>().swap(covering.first);
+        return TRI_ERROR_NO_ERROR;
+      });
+}
+
 Result MMFilesGeoIndex::remove(transaction::Methods*,
                                LocalDocumentId const& documentId,
                                VPackSlice const& doc, OperationMode mode) {
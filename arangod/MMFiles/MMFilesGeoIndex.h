@@ -93,6 +93,13 @@ class MMFilesGeoIndex final : public MMFilesIndex, public geo_index::Index {
                 arangodb::velocypack::Slice const&,
                 OperationMode mode) override;
 
+  void batchInsert(
+      transaction::Methods*,
+      std::vector<std::pair<LocalDocumentId, arangodb::velocypack::Slice>> const&,
+      std::shared_ptr<arangodb::basics::LocalTaskQueue>) override;
+
+  bool hasBatchInsert() const override { return true; }
+
   IndexIterator* iteratorForCondition(transaction::Methods*,
                                       ManagedDocumentResult*,
                                       arangodb::aql::AstNode const*,
@@ -26,6 +26,9 @@
 
 #include "Basics/Common.h"
 #include "Basics/AttributeNameParser.h"
+#include "Basics/Exceptions.h"
+#include "Basics/LocalTaskQueue.h"
+#include "Basics/system-functions.h"
 #include "Indexes/Index.h"
 
 #include <velocypack/Slice.h>
@@ -34,6 +37,31 @@
 namespace arangodb {
 class LogicalCollection;
 
+/// @brief task running a function on behalf of an index batch insert
+class MMFilesIndexTask final : public basics::LocalTask {
+ public:
+  MMFilesIndexTask(std::shared_ptr<basics::LocalTaskQueue> const& queue,
+                   std::function<void()> const& fn)
+      : LocalTask(queue), _fn(fn) {}
+
+  void run() override {
+    try {
+      _fn();
+    } catch (basics::Exception const& ex) {
+      _queue->setStatus(ex.code());
+    } catch (std::bad_alloc const&) {
+      _queue->setStatus(TRI_ERROR_OUT_OF_MEMORY);
+    } catch (...) {
+      _queue->setStatus(TRI_ERROR_INTERNAL);
+    }
+
+    _queue->join();
+  }
+
+ private:
+  std::function<void()> _fn;
+};
+
 class MMFilesIndex : public Index {
  public:
   MMFilesIndex(TRI_idx_iid_t id, LogicalCollection* collection,
@@ -51,6 +79,78 @@ class MMFilesIndex : public Index {
     unload();
     return TRI_ERROR_NO_ERROR;
   }
+
+ protected:
+  /// @brief batch insert in two phases, for indexes whose structures cannot
+  /// be modified concurrently. prepare computes the index values of a
+  /// document, and runs for partitions of the documents in parallel tasks.
+  /// once all partitions are prepared, a single task hands the values to
+  /// insert, in document order
+  template <typename T>
+  void batchInsertPrepared(
+      std::vector<std::pair<LocalDocumentId, VPackSlice>> const& documents,
+      std::shared_ptr<basics::LocalTaskQueue> const& queue,
+      std::function<int(LocalDocumentId const&, VPackSlice, T&)> const& prepare,
+      std::function<int(LocalDocumentId const&, T&)> const& insert) {
+    TRI_ASSERT(queue != nullptr);
+    if (documents.empty()) {
+      return;
+    }
+
+    // partitions smaller than this are not worth a task
+    size_t const minPartitionSize = 8192;
+    size_t const numPartitions = (std::max)(
+        size_t(1), (std::min)(documents.size() / minPartitionSize,
+                              TRI_numberProcessors()));
+    size_t const partitionSize =
+        (documents.size() + numPartitions - 1) / numPartitions;
+
+    auto values = std::make_shared<std::vector<T>>(documents.size());
+    auto pending = std::make_shared<std::atomic<size_t>>(numPartitions);
+    auto docs = &documents;
+
+    auto inserter = [docs, values, queue, insert]() {
+      for (size_t i = 0; i < docs->size(); ++i) {
+        int res = insert((*docs)[i].first, (*values)[i]);
+        if (res != TRI_ERROR_NO_ERROR) {
+          queue->setStatus(res);
+          return;
+        }
+      }
+    };
+
+    for (size_t p = 0; p < numPartitions; ++p) {
+      size_t const from = p * partitionSize;
+      size_t const to = (std::min)(from + partitionSize, documents.size());
+
+      auto preparer = [docs, values, pending, queue, prepare, inserter, from,
+                       to]() {
+        int res = TRI_ERROR_NO_ERROR;
+        try {
+          for (size_t i = from; i < to && res == TRI_ERROR_NO_ERROR; ++i) {
+            res = prepare((*docs)[i].first, (*docs)[i].second, (*values)[i]);
+          }
+        } catch (basics::Exception const& ex) {
+          res = ex.code();
+        } catch (std::bad_alloc const&) {
+          res = TRI_ERROR_OUT_OF_MEMORY;
+        } catch (...) {
+          res = TRI_ERROR_INTERNAL;
+        }
+
+        if (res != TRI_ERROR_NO_ERROR) {
+          queue->setStatus(res);
+        }
+        // the last partition to finish queues the insertion
+        if (pending->fetch_sub(1) == 1 &&
+            queue->status() == TRI_ERROR_NO_ERROR) {
+          queue->enqueue(std::make_shared<MMFilesIndexTask>(queue, inserter));
+        }
+      };
+
+      queue->enqueue(std::make_shared<MMFilesIndexTask>(queue, preparer));
+    }
+  }
 };
 }
 
@@ -187,6 +187,12 @@ void MMFilesLogfileManager::collectOptions(std::shared_ptr<ProgramOptions> optio
       "continue recovery even if re-applying operations fails",
       new BooleanParameter(&_ignoreRecoveryErrors));
 
+  options->addOption(
+      "--wal.recovery-threads",
+      "number of threads replaying the document operations of different "
+      "collections in parallel during recovery (0 = number of cores)",
+      new UInt32Parameter(&_recoveryThreads));
+
   options->addHiddenOption("--wal.flush-timeout", "flush timeout (in milliseconds)",
                      new UInt64Parameter(&_flushTimeout));
 
@@ -209,6 +215,13 @@ void MMFilesLogfileManager::collectOptions(std::shared_ptr<ProgramOptions> optio
       "interval for automatic, non-requested disk syncs (in milliseconds)",
       new UInt64Parameter(&_syncInterval));
 
+  options->addOption(
+      "--wal.group-commit-window",
+      "delay of requested disk syncs, so that concurrent commits of "
+      "waitForSync operations can share one sync (in microseconds, 0 = no "
+      "delay)",
+      new UInt64Parameter(&_groupCommitWindow));
+
   options->addHiddenOption(
       "--wal.throttle-when-pending",
       "throttle writes when at least this many operations are waiting for "
@@ -255,6 +268,12 @@ void MMFilesLogfileManager::validateOptions(std::shared_ptr<options::ProgramOpti
   // sync interval is specified in milliseconds by the user, but internally
   // we use microseconds
   _syncInterval = _syncInterval * 1000;
+
+  if (_groupCommitWindow > _syncInterval) {
+    LOG_TOPIC(FATAL, arangodb::Logger::FIXME) << "invalid value for --wal.group-commit-window. Please use a "
+                  "value of at most the value of --wal.sync-interval";
+    FATAL_ERROR_EXIT();
+  }
 }
 
 void MMFilesLogfileManager::prepare() {
@@ -317,7 +336,10 @@ void MMFilesLogfileManager::start() {
 
   // initialize some objects
   _slots = new MMFilesWalSlots(this, _numberOfSlots, 0);
-  _recoverState.reset(new MMFilesWalRecoverState(_ignoreRecoveryErrors));
+  size_t const recoveryThreads =
+      _recoveryThreads > 0 ? _recoveryThreads : TRI_numberProcessors();
+  _recoverState.reset(
+      new MMFilesWalRecoverState(_ignoreRecoveryErrors, recoveryThreads));
 
   TRI_ASSERT(!_allowWrites);
 
@@ -1975,7 +1997,7 @@ int MMFilesLogfileManager::writeShutdownInfo(bool writeShutdownTime) {
 
 // start the synchronizer thread
 int MMFilesLogfileManager::startMMFilesSynchronizerThread() {
-  _synchronizerThread = new MMFilesSynchronizerThread(this, _syncInterval);
+  _synchronizerThread = new MMFilesSynchronizerThread(this, _syncInterval, _groupCommitWindow);
 
   if (!_synchronizerThread->start()) {
     delete _synchronizerThread;
@@ -62,7 +62,7 @@ struct MMFilesLogfileManagerState {
   std::string timeString;
 };
 
-class MMFilesLogfileManager final : public application_features::ApplicationFeature {
+class MMFilesLogfileManager : public application_features::ApplicationFeature {
   friend class MMFilesAllocatorThread;
   friend class MMFilesCollectorThread;
 
@@ -140,7 +140,7 @@ class MMFilesLogfileManager final : public application_features::ApplicationFeat
   void unprepare() override final;
 
  public:
-  void logStatus();
+  TEST_VIRTUAL void logStatus();
   // run the recovery procedure
   // this is called after the logfiles have been scanned completely and
   // recovery state has been build. additionally, all databases have been
@@ -258,7 +258,7 @@ class MMFilesLogfileManager final : public application_features::ApplicationFeat
   bool hasReserveLogfiles();
 
   // signal that a sync operation is required
-  void signalSync(bool);
+  TEST_VIRTUAL void signalSync(bool);
 
   // write data into the logfile, using database id and collection id
   /// this is a convenience function that combines allocate, memcpy and finalize
@@ -348,10 +348,10 @@ class MMFilesLogfileManager final : public application_features::ApplicationFeat
   MMFilesWalLogfile* getLogfile(MMFilesWalLogfile::IdType);
 
   // get a logfile and its status by id
-  MMFilesWalLogfile* getLogfile(MMFilesWalLogfile::IdType, MMFilesWalLogfile::StatusType&);
+  TEST_VIRTUAL MMFilesWalLogfile* getLogfile(MMFilesWalLogfile::IdType, MMFilesWalLogfile::StatusType&);
 
   // get a logfile for writing. this may return nullptr
-  int getWriteableLogfile(uint32_t, MMFilesWalLogfile::StatusType&, MMFilesWalLogfile*&);
+  TEST_VIRTUAL int getWriteableLogfile(uint32_t, MMFilesWalLogfile::StatusType&, MMFilesWalLogfile*&);
 
   // get a logfile to collect. this may return nullptr
   MMFilesWalLogfile* getCollectableLogfile();
@@ -482,12 +482,14 @@ class MMFilesLogfileManager final : public application_features::ApplicationFeat
   uint32_t _historicLogfiles = 10;
   bool _ignoreLogfileErrors = false;
   bool _ignoreRecoveryErrors = false;
+  uint32_t _recoveryThreads = 0;
   uint64_t _flushTimeout = 15000;
   uint32_t _filesize = 32 * 1024 * 1024;
   uint32_t _maxOpenLogfiles = 0;
   uint32_t _reserveLogfiles = 3;
   uint32_t _numberOfSlots = 1048576;
   uint64_t _syncInterval = 100;
+  uint64_t _groupCommitWindow = 0;
   uint64_t _throttleWhenPending = 0;
   uint64_t _maxThrottleWait = 15000;
 
@@ -170,34 +170,44 @@ int MMFilesPathBasedIndex::fillElement(std::vector<T*>& elements,
       return TRI_ERROR_INTERNAL;
     }
 
-    if (!toInsert.empty()) {
-      elements.reserve(toInsert.size());
+    return fillElement<T>(elements, documentId, toInsert);
+  }
 
-      for (auto& info : toInsert) {
-        TRI_ASSERT(info.size() == n);
-        T* element = static_cast<T*>(_allocator->allocate());
-        TRI_ASSERT(element != nullptr);
-        element = T::initialize(element, documentId, info);
+  return TRI_ERROR_NO_ERROR;
+}
 
-        if (element == nullptr) {
-          return TRI_ERROR_OUT_OF_MEMORY;
-        }
-        TRI_IF_FAILURE("FillElementOOM") {
-          // clean up manually
-          _allocator->deallocate(element);
-          return TRI_ERROR_OUT_OF_MEMORY;
-        }
+/// @brief helper function to create the elements for collected index values
+template<typename T>
+int MMFilesPathBasedIndex::fillElement(
+    std::vector<T*>& elements, LocalDocumentId const& documentId,
+    std::vector<std::vector<std::pair<VPackSlice, uint32_t>>> const& toInsert) {
+  if (!toInsert.empty()) {
+    elements.reserve(toInsert.size());
+
+    for (auto& info : toInsert) {
+      TRI_ASSERT(info.size() == _paths.size());
+      T* element = static_cast<T*>(_allocator->allocate());
+      TRI_ASSERT(element != nullptr);
+      element = T::initialize(element, documentId, info);
 
-        try {
-          TRI_IF_FAILURE("FillElementOOM2") {
-            THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-          }
+      if (element == nullptr) {
+        return TRI_ERROR_OUT_OF_MEMORY;
+      }
+      TRI_IF_FAILURE("FillElementOOM") {
+        // clean up manually
+        _allocator->deallocate(element);
+        return TRI_ERROR_OUT_OF_MEMORY;
+      }
 
-          elements.emplace_back(element);
-        } catch (...) {
-          _allocator->deallocate(element);
-          return TRI_ERROR_OUT_OF_MEMORY;
+      try {
+        TRI_IF_FAILURE("FillElementOOM2") {
+          THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
         }
+
+        elements.emplace_back(element);
+      } catch (...) {
+        _allocator->deallocate(element);
+        return TRI_ERROR_OUT_OF_MEMORY;
       }
     }
   }
@@ -205,6 +215,41 @@ int MMFilesPathBasedIndex::fillElement(std::vector<T*>& elements,
   return TRI_ERROR_NO_ERROR;
 }
 
+/// @brief collect the index values of a document without creating elements
+int MMFilesPathBasedIndex::collectIndexValues(
+    VPackSlice const& doc,
+    std::vector<std::vector<std::pair<VPackSlice, uint32_t>>>& toInsert) {
+  if (doc.isNone()) {
+    LOG_TOPIC(ERR, arangodb::Logger::FIXME) << "encountered invalid marker with slice of type None";
+    return TRI_ERROR_INTERNAL;
+  }
+
+  TRI_IF_FAILURE("FillElementIllegalSlice") { return TRI_ERROR_INTERNAL; }
+
+  if (!_useExpansion) {
+    auto slices = buildIndexValue(doc);
+
+    if (slices.size() == _paths.size()) {
+      // if slices.size() != n, then the value is not inserted into the index
+      // because of index sparsity!
+      toInsert.emplace_back(std::move(slices));
+    }
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  std::vector<std::pair<VPackSlice, uint32_t>> sliceStack;
+
+  try {
+    buildIndexValues(doc, 0, toInsert, sliceStack);
+  } catch (basics::Exception const& ex) {
+    return ex.code();
+  } catch (...) {
+    return TRI_ERROR_INTERNAL;
+  }
+
+  return TRI_ERROR_NO_ERROR;
+}
+
 /// @brief helper function to create the sole index value insert
 std::vector<std::pair<VPackSlice, uint32_t>> MMFilesPathBasedIndex::buildIndexValue(
     VPackSlice const documentSlice) {
@@ -377,3 +422,7 @@ int MMFilesPathBasedIndex::fillElement(std::vector<MMFilesHashIndexElement*>&, L
 
 template
 int MMFilesPathBasedIndex::fillElement(std::vector<MMFilesSkiplistIndexElement*>&, LocalDocumentId const&, VPackSlice const& doc);
+
+template
+int MMFilesPathBasedIndex::fillElement(std::vector<MMFilesSkiplistIndexElement*>&, LocalDocumentId const&,
+                                       std::vector<std::vector<std::pair<VPackSlice, uint32_t>>> const&);
@@ -74,6 +74,16 @@ class MMFilesPathBasedIndex : public MMFilesIndex {
   int fillElement(std::vector<T*>& elements, 
           LocalDocumentId const& documentId, arangodb::velocypack::Slice const&);
 
+  /// @brief helper function to create the elements for collected index values
+  template<typename T>
+  int fillElement(std::vector<T*>& elements, LocalDocumentId const& documentId,
+                  std::vector<std::vector<std::pair<velocypack::Slice, uint32_t>>> const& toInsert);
+
+  /// @brief collect the index values of a document without creating
+  /// elements. this only reads the document, so it may run concurrently
+  int collectIndexValues(velocypack::Slice const& doc,
+                         std::vector<std::vector<std::pair<velocypack::Slice, uint32_t>>>& toInsert);
+
   /// @brief return the number of paths
   inline size_t numPaths() const { return _paths.size(); }
 
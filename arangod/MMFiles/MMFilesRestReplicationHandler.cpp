@@ -464,9 +464,6 @@ void MMFilesRestReplicationHandler::handleCommandLoggerFollow() {
 
       // transfer ownership of the buffer contents
       httpResponse->body().set(dump._buffer);
-
-      // to avoid double freeing
-      TRI_StealStringBuffer(dump._buffer);
     }
   }
 
@@ -555,9 +552,6 @@ void MMFilesRestReplicationHandler::handleCommandDetermineOpenTransactions() {
   if (length > 0) {
     // transfer ownership of the buffer contents
     httpResponse->body().set(dump._buffer);
-
-    // to avoid double freeing
-    TRI_StealStringBuffer(dump._buffer);
   }
 }
 
@@ -1038,7 +1032,4 @@ void MMFilesRestReplicationHandler::handleCommandDump() {
 
   // transfer ownership of the buffer contents
   response->body().set(dump._buffer);
-
-  // avoid double freeing
-  TRI_StealStringBuffer(dump._buffer);
 }
@@ -29,23 +29,27 @@
 
 using namespace arangodb;
 
-MMFilesRevisionsCache::MMFilesRevisionsCache() 
-    : _positions(MMFilesRevisionsCacheHelper(), 8, []() -> std::string { return "mmfiles revisions"; }) {}
+MMFilesRevisionsCache::Stripe::Stripe()
+    : positions(MMFilesRevisionsCacheHelper(), 1, []() -> std::string { return "mmfiles revisions"; }) {}
+
+MMFilesRevisionsCache::MMFilesRevisionsCache() {}
 
 MMFilesRevisionsCache::~MMFilesRevisionsCache() {}
 
 MMFilesDocumentPosition MMFilesRevisionsCache::lookup(LocalDocumentId const& documentId) const {
   TRI_ASSERT(documentId.isSet());
-  READ_LOCKER(locker, _lock);
+  Stripe const& s = stripe(documentId);
+  READ_LOCKER(locker, s.lock);
 
-  return _positions.findByKey(nullptr, documentId.data());
+  return s.positions.findByKey(nullptr, documentId.data());
 }
 
 void MMFilesRevisionsCache::batchLookup(std::vector<std::pair<LocalDocumentId, uint8_t const*>>& documentIds) const {
-  READ_LOCKER(locker, _lock);
-
   for (auto& it : documentIds) {
-    MMFilesDocumentPosition const old = _positions.findByKey(nullptr, it.first.data());
+    Stripe const& s = stripe(it.first);
+    READ_LOCKER(locker, s.lock);
+
+    MMFilesDocumentPosition const old = s.positions.findByKey(nullptr, it.first.data());
     if (old) {
       uint8_t const* vpack = static_cast<uint8_t const*>(old.dataptr());
       TRI_ASSERT(VPackSlice(vpack).isObject());
@@ -57,30 +61,47 @@ void MMFilesRevisionsCache::batchLookup(std::vector<std::pair<LocalDocumentId, u
 }
 
 void MMFilesRevisionsCache::sizeHint(int64_t hint) {
-  WRITE_LOCKER(locker, _lock);
+  hint /= static_cast<int64_t>(numberOfStripes);
   if (hint > 256) {
-    _positions.resize(nullptr, static_cast<size_t>(hint));
+    for (auto& s : _stripes) {
+      WRITE_LOCKER(locker, s.lock);
+      s.positions.resize(nullptr, static_cast<size_t>(hint));
+    }
   }
 }
 
 size_t MMFilesRevisionsCache::size() {
-  READ_LOCKER(locker, _lock);
-  return _positions.size();
+  size_t result = 0;
+  for (auto const& s : _stripes) {
+    READ_LOCKER(locker, s.lock);
+    result += s.positions.size();
+  }
+  return result;
 }
 
 size_t MMFilesRevisionsCache::capacity() {
-  READ_LOCKER(locker, _lock);
-  return _positions.capacity();
+  size_t result = 0;
+  for (auto const& s : _stripes) {
+    READ_LOCKER(locker, s.lock);
+    result += s.positions.capacity();
+  }
+  return result;
 }
 
 size_t MMFilesRevisionsCache::memoryUsage() {
-  READ_LOCKER(locker, _lock);
-  return _positions.memoryUsage();
+  size_t result = 0;
+  for (auto const& s : _stripes) {
+    READ_LOCKER(locker, s.lock);
+    result += s.positions.memoryUsage();
+  }
+  return result;
 }
 
 void MMFilesRevisionsCache::clear() {
-  WRITE_LOCKER(locker, _lock);
-  _positions.truncate([](MMFilesDocumentPosition&) { return true; });
+  for (auto& s : _stripes) {
+    WRITE_LOCKER(locker, s.lock);
+    s.positions.truncate([](MMFilesDocumentPosition&) { return true; });
+  }
 }
 
 MMFilesDocumentPosition MMFilesRevisionsCache::insert(LocalDocumentId const& documentId, 
@@ -88,12 +109,13 @@ MMFilesDocumentPosition MMFilesRevisionsCache::insert(LocalDocumentId const& doc
   TRI_ASSERT(documentId.isSet());
   TRI_ASSERT(dataptr != nullptr);
 
-  CONDITIONAL_WRITE_LOCKER(locker, _lock, shouldLock);
-  int res = _positions.insert(nullptr, MMFilesDocumentPosition(documentId, dataptr, fid, isInWal));
+  Stripe& s = stripe(documentId);
+  CONDITIONAL_WRITE_LOCKER(locker, s.lock, shouldLock);
+  int res = s.positions.insert(nullptr, MMFilesDocumentPosition(documentId, dataptr, fid, isInWal));
 
   if (res != TRI_ERROR_NO_ERROR) {
-    MMFilesDocumentPosition old = _positions.removeByKey(nullptr, documentId.data());
-    _positions.insert(nullptr, MMFilesDocumentPosition(documentId, dataptr, fid, isInWal));
+    MMFilesDocumentPosition old = s.positions.removeByKey(nullptr, documentId.data());
+    s.positions.insert(nullptr, MMFilesDocumentPosition(documentId, dataptr, fid, isInWal));
     return old;
   }
 
@@ -101,8 +123,9 @@ MMFilesDocumentPosition MMFilesRevisionsCache::insert(LocalDocumentId const& doc
 }
 
 void MMFilesRevisionsCache::insert(MMFilesDocumentPosition const& position, bool shouldLock) {
-  CONDITIONAL_WRITE_LOCKER(locker, _lock, shouldLock);
-  _positions.insert(nullptr, position);
+  Stripe& s = stripe(position.localDocumentId());
+  CONDITIONAL_WRITE_LOCKER(locker, s.lock, shouldLock);
+  s.positions.insert(nullptr, position);
 }
 
 void MMFilesRevisionsCache::update(LocalDocumentId const& documentId, 
@@ -110,9 +133,10 @@ void MMFilesRevisionsCache::update(LocalDocumentId const& documentId,
   TRI_ASSERT(documentId.isSet());
   TRI_ASSERT(dataptr != nullptr);
 
-  WRITE_LOCKER(locker, _lock);
+  Stripe& s = stripe(documentId);
+  WRITE_LOCKER(locker, s.lock);
   
-  MMFilesDocumentPosition* old = _positions.findByKeyRef(nullptr, documentId.data());
+  MMFilesDocumentPosition* old = s.positions.findByKeyRef(nullptr, documentId.data());
   TRI_ASSERT(old != nullptr);
 
   if (!(*old)) {
@@ -126,9 +150,10 @@ void MMFilesRevisionsCache::update(LocalDocumentId const& documentId,
   
 bool MMFilesRevisionsCache::updateConditional(LocalDocumentId const& documentId,
                                               MMFilesMarker const* oldPosition, MMFilesMarker const* newPosition, TRI_voc_fid_t newFid, bool isInWal) {
-  WRITE_LOCKER(locker, _lock);
+  Stripe& s = stripe(documentId);
+  WRITE_LOCKER(locker, s.lock);
 
-  MMFilesDocumentPosition* old = _positions.findByKeyRef(nullptr, documentId.data());
+  MMFilesDocumentPosition* old = s.positions.findByKeyRef(nullptr, documentId.data());
   TRI_ASSERT(old != nullptr);
 
   if (!(*old)) {
@@ -154,13 +179,15 @@ bool MMFilesRevisionsCache::updateConditional(LocalDocumentId const& documentId,
 void MMFilesRevisionsCache::remove(LocalDocumentId const& documentId) {
   TRI_ASSERT(documentId.isSet());
 
-  WRITE_LOCKER(locker, _lock);
-  _positions.removeByKey(nullptr, documentId.data());
+  Stripe& s = stripe(documentId);
+  WRITE_LOCKER(locker, s.lock);
+  s.positions.removeByKey(nullptr, documentId.data());
 }
 
 MMFilesDocumentPosition MMFilesRevisionsCache::fetchAndRemove(LocalDocumentId const& documentId) {
   TRI_ASSERT(documentId.isSet());
 
-  WRITE_LOCKER(locker, _lock);
-  return _positions.removeByKey(nullptr, documentId.data());
+  Stripe& s = stripe(documentId);
+  WRITE_LOCKER(locker, s.lock);
+  return s.positions.removeByKey(nullptr, documentId.data());
 }
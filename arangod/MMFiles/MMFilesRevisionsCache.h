@@ -61,6 +61,10 @@ struct MMFilesRevisionsCacheHelper {
   }
 };
 
+/// @brief positions of all document revisions of a collection. the
+/// revisions are spread over independent stripes by their hash, each with
+/// its own lock, so concurrent readers and writers of different documents
+/// do not contend on a single lock
 class MMFilesRevisionsCache {
  public:
   MMFilesRevisionsCache();
@@ -82,9 +86,33 @@ class MMFilesRevisionsCache {
   MMFilesDocumentPosition fetchAndRemove(LocalDocumentId const& documentId);
 
  private:
-  mutable arangodb::basics::ReadWriteLock _lock; 
-  
-  arangodb::basics::AssocUnique<LocalDocumentId::BaseType, MMFilesDocumentPosition, MMFilesRevisionsCacheHelper> _positions;
+  struct Stripe {
+    Stripe();
+
+    mutable arangodb::basics::ReadWriteLock lock;
+    arangodb::basics::AssocUnique<LocalDocumentId::BaseType, MMFilesDocumentPosition, MMFilesRevisionsCacheHelper> positions;
+  };
+
+  /// @brief number of stripes, must be a power of two
+  static constexpr size_t numberOfStripes = 8;
+
+  Stripe& stripe(LocalDocumentId const& documentId) {
+    return _stripes[stripeIndex(documentId)];
+  }
+
+  Stripe const& stripe(LocalDocumentId const& documentId) const {
+    return _stripes[stripeIndex(documentId)];
+  }
+
+  /// @brief the tables of the stripes use the lower bits of the same hash
+  static inline size_t stripeIndex(LocalDocumentId const& documentId) {
+    return static_cast<size_t>(
+               MMFilesRevisionsCacheHelper::HashKey(nullptr, documentId.data()) >> 32) &
+           (numberOfStripes - 1);
+  }
+
+ private:
+  Stripe _stripes[numberOfStripes];
 };
 
 } // namespace arangodb
@@ -89,6 +89,11 @@ enum MMFilesSkiplistCmpType { SKIPLIST_CMP_PREORDER, SKIPLIST_CMP_TOTORDER };
 /// _end always points to the last node in the skiplist, this can be the
 /// same as the _start node. If a node does not have a successor on a certain
 /// level, then the corresponding _next pointer is a nullptr.
+///
+/// The skiplist does no locking of its own. Callers must serialize writers
+/// with each other and with lookups; the MMFiles collection locks do this
+/// for skiplist indexes, and they also keep the nodes held by index
+/// iterators alive between lookups.
 ////////////////////////////////////////////////////////////////////////////////
 
 template <class Key, class Element>
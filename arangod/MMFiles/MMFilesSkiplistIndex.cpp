@@ -751,6 +751,81 @@ void MMFilesSkiplistIndex::toVelocyPackFigures(VPackBuilder& builder) const {
   _skiplistIndex->appendToVelocyPack(builder);
 }
 
+/// @brief inserts the elements of a document into the skiplist. the memory
+/// for the elements will be owned or freed by the index. if one of them
+/// cannot be inserted, the others are removed again, and badIndex is the
+/// position of the failing one
+int MMFilesSkiplistIndex::insertElements(
+    IndexLookupContext* context,
+    std::vector<MMFilesSkiplistIndexElement*> const& elements,
+    size_t& badIndex) {
+  size_t const count = elements.size();
+
+  for (size_t i = 0; i < count; ++i) {
+    int res = _skiplistIndex->insert(context, elements[i]);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      badIndex = i;
+
+      // Note: this element is freed already
+      for (size_t j = i; j < count; ++j) {
+        _allocator->deallocate(elements[j]);
+      }
+      for (size_t j = 0; j < i; ++j) {
+        _skiplistIndex->remove(context, elements[j]);
+        // No need to free elements[j] skiplist has taken over already
+      }
+
+      if (res == TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED && !_unique) {
+        // We ignore unique_constraint violated if we are not unique
+        res = TRI_ERROR_NO_ERROR;
+      }
+
+      return res;
+    }
+  }
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+/// @brief inserts documents into a skiplist index. the index values of the
+/// documents are collected in parallel, the skiplist itself is filled by a
+/// single task
+void MMFilesSkiplistIndex::batchInsert(
+    transaction::Methods* trx,
+    std::vector<std::pair<LocalDocumentId, VPackSlice>> const& documents,
+    std::shared_ptr<arangodb::basics::LocalTaskQueue> queue) {
+  typedef std::vector<std::vector<std::pair<VPackSlice, uint32_t>>> Values;
+
+  auto result = std::make_shared<ManagedDocumentResult>();
+  auto context = std::make_shared<IndexLookupContext>(trx, _collection,
+                                                      result.get(), numPaths());
+
+  batchInsertPrepared<Values>(
+      documents, queue,
+      [this](LocalDocumentId const&, VPackSlice doc, Values& values) -> int {
+        return collectIndexValues(doc, values);
+      },
+      [this, result, context](LocalDocumentId const& documentId,
+                              Values& values) -> int {
+        std::vector<MMFilesSkiplistIndexElement*> elements;
+        int res = fillElement<MMFilesSkiplistIndexElement>(elements,
+                                                           documentId, values);
+        Values().swap(values);
+
+        if (res != TRI_ERROR_NO_ERROR) {
+          for (auto& element : elements) {
+            // free all elements to prevent leak
+            _allocator->deallocate(element);
+          }
+          return res;
+        }
+
+        size_t badIndex = 0;
+        return insertElements(context.get(), elements, badIndex);
+      });
+}
+
 /// @brief inserts a document into a skiplist index
 Result MMFilesSkiplistIndex::insert(transaction::Methods* trx,
                                     LocalDocumentId const& documentId,
@@ -779,34 +854,8 @@ Result MMFilesSkiplistIndex::insert(transaction::Methods* trx,
   ManagedDocumentResult result;
   IndexLookupContext context(trx, _collection, &result, numPaths());
 
-  // insert into the index. the memory for the element will be owned or freed
-  // by the index
-  size_t const count = elements.size();
-
   size_t badIndex = 0;
-  for (size_t i = 0; i < count; ++i) {
-    res = _skiplistIndex->insert(&context, elements[i]);
-
-    if (res != TRI_ERROR_NO_ERROR) {
-      badIndex = i;
-
-      // Note: this element is freed already
-      for (size_t j = i; j < count; ++j) {
-        _allocator->deallocate(elements[j]);
-      }
-      for (size_t j = 0; j < i; ++j) {
-        _skiplistIndex->remove(&context, elements[j]);
-        // No need to free elements[j] skiplist has taken over already
-      }
-
-      if (res == TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED && !_unique) {
-        // We ignore unique_constraint violated if we are not unique
-        res = TRI_ERROR_NO_ERROR;
-      }
-
-      break;
-    }
-  }
+  res = insertElements(&context, elements, badIndex);
 
   if (res == TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED) {
     elements.clear();
@@ -296,6 +296,13 @@ class MMFilesSkiplistIndex final : public MMFilesPathBasedIndex {
                 arangodb::velocypack::Slice const&,
                 OperationMode mode) override;
 
+  void batchInsert(
+      transaction::Methods*,
+      std::vector<std::pair<LocalDocumentId, arangodb::velocypack::Slice>> const&,
+      std::shared_ptr<arangodb::basics::LocalTaskQueue>) override;
+
+  bool hasBatchInsert() const override { return true; }
+
   void unload() override;
 
   bool supportsFilterCondition(arangodb::aql::AstNode const*,
@@ -316,6 +323,9 @@ class MMFilesSkiplistIndex final : public MMFilesPathBasedIndex {
       arangodb::aql::AstNode*, arangodb::aql::Variable const*) const override;
 
  private:
+  int insertElements(IndexLookupContext*,
+                     std::vector<MMFilesSkiplistIndexElement*> const&,
+                     size_t& badIndex);
 
   bool accessFitsIndex(
       arangodb::aql::AstNode const*, arangodb::aql::AstNode const*,
@@ -32,6 +32,9 @@
 #include "VocBase/ticks.h"
 #include "MMFiles/MMFilesLogfileManager.h"
 
+#include <chrono>
+#include <thread>
+
 using namespace arangodb;
   
 /// @brief returns the bitmask for the synchronous waiters
@@ -46,11 +49,13 @@ static constexpr inline uint64_t syncWaitersMask() {
 static constexpr inline int asyncWaitersBits() { return 32; }
 
 MMFilesSynchronizerThread::MMFilesSynchronizerThread(MMFilesLogfileManager* logfileManager,
-                                       uint64_t syncInterval)
+                                       uint64_t syncInterval,
+                                       uint64_t groupCommitWindow)
     : Thread("WalSynchronizer"),
       _logfileManager(logfileManager),
       _condition(),
       _syncInterval(syncInterval),
+      _groupCommitWindow(groupCommitWindow),
       _logfileCache({0, -1}),
       _waiting(0) {}
 
@@ -89,6 +94,16 @@ void MMFilesSynchronizerThread::run() {
     if (waitingWithoutSync > 0 || waitingWithSync > 0 || ++iterations == 10) {
       iterations = 0;
 
+      if (waitingWithSync > 0 && _groupCommitWindow > 0 && !isStopping()) {
+        // give other commits that request a sync the chance to be synced
+        // together with the ones we already know of
+        std::this_thread::sleep_for(std::chrono::microseconds(_groupCommitWindow));
+
+        waitingValue = _waiting;
+        waitingWithoutSync = waitingValue >> asyncWaitersBits();
+        waitingWithSync = (waitingValue & syncWaitersMask());
+      }
+
       try {
         // sync as much as we can in this loop
         bool checkMore = false;
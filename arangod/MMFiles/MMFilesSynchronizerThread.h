@@ -39,7 +39,7 @@ class MMFilesSynchronizerThread final : public Thread {
   MMFilesSynchronizerThread& operator=(MMFilesSynchronizerThread const&) = delete;
 
  public:
-  MMFilesSynchronizerThread(MMFilesLogfileManager*, uint64_t);
+  MMFilesSynchronizerThread(MMFilesLogfileManager*, uint64_t, uint64_t);
   ~MMFilesSynchronizerThread() { shutdown(); }
 
  public:
@@ -69,6 +69,10 @@ class MMFilesSynchronizerThread final : public Thread {
   /// @brief wait interval for the synchronizer thread when idle
   uint64_t const _syncInterval;
 
+  /// @brief time (in microseconds) a requested sync is delayed, so that
+  /// further commits requesting a sync can share it
+  uint64_t const _groupCommitWindow;
+
   /// @brief logfile descriptor cache
   struct {
     MMFilesWalLogfile::IdType id;
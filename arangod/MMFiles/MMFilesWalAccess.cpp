@@ -247,9 +247,10 @@ struct MMFilesWalAccessContext : WalAccessContext {
 
     // finally check if the marker is for a collection that we want to ignore
     if (cid != 0) {
-      if (_filter.collection != 0 &&
-          (cid != _filter.collection && !isTransactionWalMarker(marker))) {
-        // restrict output to a single collection, but a different one
+      if (!_filter.collections.empty() &&
+          (_filter.collections.count(cid) == 0 &&
+           !isTransactionWalMarker(marker))) {
+        // restrict output to some collections, but a different one
         return false;
       }
 
@@ -537,6 +538,7 @@ struct MMFilesWalAccessContext : WalAccessContext {
 WalAccessResult MMFilesWalAccess::tail(uint64_t tickStart, uint64_t tickEnd,
                                        size_t chunkSize,
                                        TRI_voc_tid_t barrierId,
+                                       TRI_server_id_t /*clientId*/,
                                        WalAccess::Filter const& filter,
                                        MarkerCallback const& callback) const {
   /*OG_TOPIC(WARN, Logger::FIXME)
@@ -25,6 +25,7 @@
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/Exceptions.h"
 #include "Basics/FileUtils.h"
+#include "Basics/LocalTaskQueue.h"
 #include "Basics/Result.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/conversions.h"
@@ -39,6 +40,8 @@
 #include "MMFiles/MMFilesWalSlots.h"
 #include "Rest/Version.h"
 #include "RestServer/DatabaseFeature.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "Transaction/Helpers.h"
 #include "Transaction/Hints.h"
@@ -79,10 +82,138 @@ static inline T numericValue(VPackSlice const& slice, char const* attribute) {
   THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
                                  "invalid attribute value");
 }
+
+/// @brief whether or not a marker can be replayed in parallel with the
+/// document operations of other collections. all other markers change
+/// databases, collections, views or indexes and are replayed on their own
+static inline bool isParallelizable(MMFilesMarkerType type) {
+  switch (type) {
+    case TRI_DF_MARKER_HEADER:
+    case TRI_DF_MARKER_FOOTER:
+    case TRI_DF_MARKER_BLANK:
+    case TRI_DF_MARKER_COL_HEADER:
+    case TRI_DF_MARKER_PROLOGUE:
+    case TRI_DF_MARKER_VPACK_DOCUMENT:
+    case TRI_DF_MARKER_VPACK_REMOVE:
+    case TRI_DF_MARKER_VPACK_BEGIN_TRANSACTION:
+    case TRI_DF_MARKER_VPACK_COMMIT_TRANSACTION:
+    case TRI_DF_MARKER_VPACK_ABORT_TRANSACTION:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// @brief re-applies a document or remove marker
+static int replayDocumentOperation(SingleCollectionTransaction* trx,
+                                   MMFilesMarkerEnvelope* envelope) {
+  if (arangodb::MMFilesCollection::toMMFilesCollection(
+          trx->documentCollection())
+          ->isVolatile()) {
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  MMFilesMarker const* marker =
+      static_cast<MMFilesMarker const*>(envelope->mem());
+  MMFilesMarkerType const type = marker->getType();
+
+  std::string const collectionName = trx->documentCollection()->name();
+  uint8_t const* ptr = reinterpret_cast<uint8_t const*>(marker) +
+                       MMFilesDatafileHelper::VPackOffset(type);
+
+  OperationOptions options;
+  options.silent = true;
+  options.recoveryData = static_cast<void*>(envelope);
+  options.waitForSync = false;
+  options.ignoreRevs = true;
+
+  if (type == TRI_DF_MARKER_VPACK_DOCUMENT) {
+    options.isRestore = true;
+
+    // try an insert first
+    TRI_ASSERT(VPackSlice(ptr).isObject());
+    OperationResult opRes =
+        trx->insert(collectionName, VPackSlice(ptr), options);
+    int res = opRes.errorNumber();
+
+    if (opRes.is(TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED)) {
+      // document/edge already exists, now make it a replace
+      opRes = trx->replace(collectionName, VPackSlice(ptr), options);
+      res = opRes.errorNumber();
+    }
+
+    return res;
+  }
+
+  TRI_ASSERT(type == TRI_DF_MARKER_VPACK_REMOVE);
+
+  try {
+    OperationResult opRes =
+        trx->remove(collectionName, VPackSlice(ptr), options);
+    if (opRes.is(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND)) {
+      // document to delete is not present. this error can be
+      // ignored
+      return TRI_ERROR_NO_ERROR;
+    }
+    return opRes.errorNumber();
+  } catch (arangodb::basics::Exception const& ex) {
+    if (ex.code() == TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND) {
+      // document to delete is not present. this error can be
+      // ignored
+      return TRI_ERROR_NO_ERROR;
+    }
+    return ex.code();
+  }
+}
+
+/// @brief checks the result of a replayed document or remove marker, and
+/// logs it if it is an actual error
+static bool checkReplayResult(MMFilesMarkerType type, TRI_voc_tick_t databaseId,
+                              TRI_voc_cid_t collectionId, int res) {
+  if (res == TRI_ERROR_NO_ERROR || res == TRI_ERROR_ARANGO_CONFLICT ||
+      res == TRI_ERROR_ARANGO_DATABASE_NOT_FOUND ||
+      res == TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND ||
+      (type == TRI_DF_MARKER_VPACK_REMOVE &&
+       res == TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND)) {
+    return true;
+  }
+
+  LOG_TOPIC(WARN, arangodb::Logger::ENGINES)
+      << "unable to " << (type == TRI_DF_MARKER_VPACK_REMOVE ? "remove" : "insert")
+      << " document in collection " << collectionId << " of database "
+      << databaseId << ": " << TRI_errno_string(res);
+  return false;
+}
+
+/// @brief task replaying the queued markers of some collections
+class MMFilesWalRecoverTask final : public basics::LocalTask {
+ public:
+  MMFilesWalRecoverTask(std::shared_ptr<basics::LocalTaskQueue> const& queue,
+                        std::function<void()> const& fn)
+      : LocalTask(queue), _fn(fn) {}
+
+  void run() override {
+    try {
+      _fn();
+    } catch (basics::Exception const& ex) {
+      _queue->setStatus(ex.code());
+    } catch (std::bad_alloc const&) {
+      _queue->setStatus(TRI_ERROR_OUT_OF_MEMORY);
+    } catch (...) {
+      _queue->setStatus(TRI_ERROR_INTERNAL);
+    }
+
+    _queue->join();
+  }
+
+ private:
+  std::function<void()> _fn;
+};
 }
 
 /// @brief creates the recover state
-MMFilesWalRecoverState::MMFilesWalRecoverState(bool ignoreRecoveryErrors)
+MMFilesWalRecoverState::MMFilesWalRecoverState(bool ignoreRecoveryErrors,
+                                               size_t replayThreads)
     : databaseFeature(nullptr),
       failedTransactions(),
       lastTick(0),
@@ -93,6 +224,7 @@ MMFilesWalRecoverState::MMFilesWalRecoverState(bool ignoreRecoveryErrors)
       ignoreRecoveryErrors(ignoreRecoveryErrors),
       errorCount(0),
       maxRevisionId(0),
+      replayThreads(replayThreads),
       lastDatabaseId(0),
       lastCollectionId(0) {
   databaseFeature =
@@ -290,6 +422,15 @@ int MMFilesWalRecoverState::executeSingleOperation(
     return TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND;
   }
 
+  return executeSingleOperation(collection, marker, fid, func);
+}
+
+/// @brief executes a single operation for an already opened collection
+int MMFilesWalRecoverState::executeSingleOperation(
+    arangodb::LogicalCollection* collection, MMFilesMarker const* marker,
+    TRI_voc_fid_t fid,
+    std::function<int(SingleCollectionTransaction*, MMFilesMarkerEnvelope*)>
+        func) {
   auto mmfiles = static_cast<MMFilesCollection*>(collection->getPhysical());
   TRI_ASSERT(mmfiles);
   TRI_voc_tick_t maxTick = mmfiles->maxTick();
@@ -298,10 +439,10 @@ int MMFilesWalRecoverState::executeSingleOperation(
     return TRI_ERROR_NO_ERROR;
   }
 
-  res = TRI_ERROR_INTERNAL;
+  Result res(TRI_ERROR_INTERNAL);
 
   try {
-    auto ctx = transaction::StandaloneContext::Create(*vocbase);
+    auto ctx = transaction::StandaloneContext::Create(collection->vocbase());
     SingleCollectionTransaction trx(ctx, collection, AccessMode::Type::WRITE);
 
     trx.addHint(transaction::Hints::Hint::SINGLE_OPERATION);
@@ -349,6 +490,148 @@ int MMFilesWalRecoverState::executeSingleOperation(
   return res.errorNumber();
 }
 
+/// @brief replays a document or remove marker. with more than one replay
+/// thread, the marker is only queued for its collection
+bool MMFilesWalRecoverState::replayOperation(TRI_voc_tick_t databaseId,
+                                             TRI_voc_cid_t collectionId,
+                                             MMFilesMarker const* marker,
+                                             TRI_voc_fid_t fid) {
+  MMFilesMarkerType const type = marker->getType();
+
+  if (replayThreads <= 1) {
+    int res = executeSingleOperation(databaseId, collectionId, marker, fid,
+                                     &replayDocumentOperation);
+
+    if (!checkReplayResult(type, databaseId, collectionId, res)) {
+      ++errorCount;
+      return canContinue();
+    }
+    return true;
+  }
+
+  // open the collection right away, the caches of opened databases and
+  // collections are not used by the replay threads
+  TRI_vocbase_t* vocbase = useDatabase(databaseId);
+
+  if (vocbase == nullptr) {
+    LOG_TOPIC(TRACE, arangodb::Logger::ENGINES) << "database " << databaseId
+                                              << " not found";
+    return true;
+  }
+
+  int res;
+  arangodb::LogicalCollection* collection =
+      useCollection(vocbase, collectionId, res);
+
+  if (collection == nullptr) {
+    if (res != TRI_ERROR_ARANGO_CORRUPTED_COLLECTION) {
+      return true;
+    }
+    checkReplayResult(type, databaseId, collectionId, res);
+    ++errorCount;
+    return canContinue();
+  }
+
+  queuedOperations[collection].emplace_back(marker, fid);
+  return true;
+}
+
+/// @brief replays all queued document and remove markers. the markers of a
+/// collection are replayed in order, different collections in parallel
+bool MMFilesWalRecoverState::replayQueuedOperations() {
+  if (queuedOperations.empty()) {
+    return true;
+  }
+
+  typedef std::vector<std::pair<MMFilesMarker const*, TRI_voc_fid_t>>
+      Operations;
+
+  // distribute the collections over the replay threads, the largest first
+  std::vector<std::pair<arangodb::LogicalCollection*, Operations*>> collections;
+  collections.reserve(queuedOperations.size());
+  for (auto& it : queuedOperations) {
+    collections.emplace_back(it.first, &it.second);
+  }
+  std::sort(collections.begin(), collections.end(),
+            [](std::pair<arangodb::LogicalCollection*, Operations*> const& lhs,
+               std::pair<arangodb::LogicalCollection*, Operations*> const& rhs) {
+              return lhs.second->size() > rhs.second->size();
+            });
+
+  size_t const n = (std::min)(replayThreads, collections.size());
+  std::vector<std::vector<std::pair<arangodb::LogicalCollection*, Operations*>>>
+      groups(n);
+  std::vector<size_t> load(n, 0);
+  for (auto const& it : collections) {
+    size_t const i = std::min_element(load.begin(), load.end()) - load.begin();
+    groups[i].emplace_back(it);
+    load[i] += it.second->size();
+  }
+
+  std::atomic<int64_t> errors(0);
+  std::atomic<bool> failed(false);
+  bool const continueOnError = canContinue();
+
+  auto replayGroup = [&errors, &failed, continueOnError](
+      std::vector<std::pair<arangodb::LogicalCollection*, Operations*>> const&
+          group) {
+    for (auto const& it : group) {
+      arangodb::LogicalCollection* collection = it.first;
+
+      for (auto const& operation : *it.second) {
+        if (failed.load(std::memory_order_relaxed)) {
+          return;
+        }
+
+        int res = executeSingleOperation(collection, operation.first,
+                                         operation.second,
+                                         &replayDocumentOperation);
+
+        if (!checkReplayResult(operation.first->getType(),
+                               collection->vocbase().id(), collection->id(),
+                               res)) {
+          ++errors;
+          if (!continueOnError) {
+            failed.store(true);
+            return;
+          }
+        }
+      }
+    }
+  };
+
+  int res = TRI_ERROR_NO_ERROR;
+
+  if (n == 1) {
+    replayGroup(groups[0]);
+  } else {
+    auto poster = [](std::function<void()> fn) -> void {
+      SchedulerFeature::SCHEDULER->post(fn);
+    };
+    auto queue = std::make_shared<arangodb::basics::LocalTaskQueue>(poster);
+
+    for (auto const& group : groups) {
+      queue->enqueue(std::make_shared<MMFilesWalRecoverTask>(
+          queue, [&replayGroup, &group]() { replayGroup(group); }));
+    }
+
+    queue->dispatchAndWait();
+    res = queue->status();
+  }
+
+  queuedOperations.clear();
+  errorCount += errors.load();
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    LOG_TOPIC(WARN, arangodb::Logger::ENGINES)
+        << "unable to replay document operations: " << TRI_errno_string(res);
+    ++errorCount;
+    return canContinue();
+  }
+
+  return !failed.load();
+}
+
 /// @brief callback to handle one marker during recovery
 /// this function only builds up state and does not change any data
 bool MMFilesWalRecoverState::InitialScanMarker(MMFilesMarker const* marker,
@@ -459,6 +742,12 @@ bool MMFilesWalRecoverState::ReplayMarker(MMFilesMarker const* marker,
 
   MMFilesMarkerType const type = marker->getType();
 
+  if (!isParallelizable(type) && !state->replayQueuedOperations()) {
+    // the queued operations must be applied before the state of any
+    // database, collection or index changes
+    return false;
+  }
+
   try {
     switch (type) {
       case TRI_DF_MARKER_PROLOGUE: {
@@ -501,56 +790,8 @@ bool MMFilesWalRecoverState::ReplayMarker(MMFilesMarker const* marker,
             << "found document marker. databaseId: " << databaseId
             << ", collectionId: " << collectionId << ", transactionId: " << tid;
 
-        int res = state->executeSingleOperation(
-            databaseId, collectionId, marker, datafile->fid(),
-            [&](SingleCollectionTransaction* trx,
-                MMFilesMarkerEnvelope* envelope) -> int {
-              if (arangodb::MMFilesCollection::toMMFilesCollection(
-                      trx->documentCollection())
-                      ->isVolatile()) {
-                return TRI_ERROR_NO_ERROR;
-              }
-
-              MMFilesMarker const* marker =
-                  static_cast<MMFilesMarker const*>(envelope->mem());
-
-              std::string const collectionName =
-                  trx->documentCollection()->name();
-              uint8_t const* ptr = reinterpret_cast<uint8_t const*>(marker) +
-                                   MMFilesDatafileHelper::VPackOffset(type);
-
-              OperationOptions options;
-              options.silent = true;
-              options.recoveryData = static_cast<void*>(envelope);
-              options.isRestore = true;
-              options.waitForSync = false;
-              options.ignoreRevs = true;
-
-              // try an insert first
-              TRI_ASSERT(VPackSlice(ptr).isObject());
-              OperationResult opRes =
-                  trx->insert(collectionName, VPackSlice(ptr), options);
-              int res = opRes.errorNumber();
-
-              if (opRes.is(TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED)) {
-                // document/edge already exists, now make it a replace
-                opRes = trx->replace(collectionName, VPackSlice(ptr), options);
-                res = opRes.errorNumber();
-              }
-
-              return res;
-            });
-
-        if (res != TRI_ERROR_NO_ERROR && res != TRI_ERROR_ARANGO_CONFLICT &&
-            res != TRI_ERROR_ARANGO_DATABASE_NOT_FOUND &&
-            res != TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND) {
-          LOG_TOPIC(WARN, arangodb::Logger::ENGINES)
-              << "unable to insert document in collection " << collectionId
-              << " of database " << databaseId << ": " << TRI_errno_string(res);
-          ++state->errorCount;
-          return state->canContinue();
-        }
-        break;
+        return state->replayOperation(databaseId, collectionId, marker,
+                                      datafile->fid());
       }
 
       case TRI_DF_MARKER_VPACK_REMOVE: {
@@ -577,63 +818,8 @@ bool MMFilesWalRecoverState::ReplayMarker(MMFilesMarker const* marker,
             << "found remove marker. databaseId: " << databaseId
             << ", collectionId: " << collectionId << ", transactionId: " << tid;
 
-        int res = state->executeSingleOperation(
-            databaseId, collectionId, marker, datafile->fid(),
-            [&](SingleCollectionTransaction* trx,
-                MMFilesMarkerEnvelope* envelope) -> int {
-
-              if (arangodb::MMFilesCollection::toMMFilesCollection(
-                      trx->documentCollection())
-                      ->isVolatile()) {
-                return TRI_ERROR_NO_ERROR;
-              }
-
-              MMFilesMarker const* marker =
-                  static_cast<MMFilesMarker const*>(envelope->mem());
-
-              std::string const collectionName =
-                  trx->documentCollection()->name();
-              uint8_t const* ptr = reinterpret_cast<uint8_t const*>(marker) +
-                                   MMFilesDatafileHelper::VPackOffset(type);
-
-              OperationOptions options;
-              options.silent = true;
-              options.recoveryData = static_cast<void*>(envelope);
-              options.waitForSync = false;
-              options.ignoreRevs = true;
-
-              try {
-                OperationResult opRes =
-                    trx->remove(collectionName, VPackSlice(ptr), options);
-                if (opRes.is(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND)) {
-                  // document to delete is not present. this error can be
-                  // ignored
-                  return TRI_ERROR_NO_ERROR;
-                }
-                return opRes.errorNumber();
-              } catch (arangodb::basics::Exception const& ex) {
-                if (ex.code() == TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND) {
-                  // document to delete is not present. this error can be
-                  // ignored
-                  return TRI_ERROR_NO_ERROR;
-                }
-                return ex.code();
-              }
-              // should not get here...
-              return TRI_ERROR_INTERNAL;
-            });
-
-        if (res != TRI_ERROR_NO_ERROR && res != TRI_ERROR_ARANGO_CONFLICT &&
-            res != TRI_ERROR_ARANGO_DATABASE_NOT_FOUND &&
-            res != TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND &&
-            res != TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND) {
-          LOG_TOPIC(WARN, arangodb::Logger::ENGINES)
-              << "unable to remove document in collection " << collectionId
-              << " of database " << databaseId << ": " << TRI_errno_string(res);
-          ++state->errorCount;
-          return state->canContinue();
-        }
-        break;
+        return state->replayOperation(databaseId, collectionId, marker,
+                                      datafile->fid());
       }
 
       // -----------------------------------------------------------------------------
@@ -1495,7 +1681,9 @@ int MMFilesWalRecoverState::replayLogfile(MMFilesWalLogfile* logfile,
   df->willNeed();
 
   if (!TRI_IterateDatafile(df, &MMFilesWalRecoverState::ReplayMarker,
-                           static_cast<void*>(this))) {
+                           static_cast<void*>(this)) ||
+      !replayQueuedOperations()) {
+    queuedOperations.clear();
     LOG_TOPIC(WARN, arangodb::Logger::ENGINES)
         << "WAL inspection failed when scanning logfile '" << logfileName
         << "'";
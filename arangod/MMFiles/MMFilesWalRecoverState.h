@@ -42,7 +42,7 @@ struct MMFilesWalRecoverState {
   MMFilesWalRecoverState& operator=(MMFilesWalRecoverState const&) = delete;
 
   /// @brief creates the recover state
-  explicit MMFilesWalRecoverState(bool ignoreRecoveryErrors);
+  MMFilesWalRecoverState(bool ignoreRecoveryErrors, size_t replayThreads);
 
   /// @brief destroys the recover state
   ~MMFilesWalRecoverState();
@@ -143,6 +143,20 @@ struct MMFilesWalRecoverState {
       TRI_voc_tick_t, TRI_voc_cid_t, MMFilesMarker const*, TRI_voc_fid_t,
       std::function<int(SingleCollectionTransaction*, MMFilesMarkerEnvelope*)>);
 
+  /// @brief executes a single operation for an already opened collection
+  static int executeSingleOperation(
+      arangodb::LogicalCollection*, MMFilesMarker const*, TRI_voc_fid_t,
+      std::function<int(SingleCollectionTransaction*, MMFilesMarkerEnvelope*)>);
+
+  /// @brief replays a document or remove marker. with more than one replay
+  /// thread, the marker is only queued for its collection
+  bool replayOperation(TRI_voc_tick_t, TRI_voc_cid_t, MMFilesMarker const*,
+                       TRI_voc_fid_t);
+
+  /// @brief replays all queued document and remove markers. the markers of
+  /// a collection are replayed in order, different collections in parallel
+  bool replayQueuedOperations();
+
   /// @brief callback to handle one marker during recovery
   /// this function modifies indexes etc.
   static bool ReplayMarker(MMFilesMarker const*, void*, MMFilesDatafile*);
@@ -186,6 +200,16 @@ struct MMFilesWalRecoverState {
   int64_t errorCount;
   TRI_voc_rid_t maxRevisionId;
 
+  /// @brief number of threads replaying document and remove markers
+  size_t replayThreads;
+
+  /// @brief document and remove markers not yet replayed, per collection.
+  /// the markers stay valid because all logfiles remain mapped until the
+  /// recovery is finished
+  std::unordered_map<arangodb::LogicalCollection*,
+                     std::vector<std::pair<MMFilesMarker const*, TRI_voc_fid_t>>>
+      queuedOperations;
+
  private:
   TRI_voc_tick_t lastDatabaseId;
   TRI_voc_cid_t lastCollectionId;
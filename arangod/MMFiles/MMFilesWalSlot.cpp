@@ -37,7 +37,7 @@ MMFilesWalSlot::MMFilesWalSlot()
 
 /// @brief return the slot status as a string
 std::string MMFilesWalSlot::statusText() const {
-  switch (_status) {
+  switch (_status.load()) {
     case StatusType::UNUSED:
       return "unused";
     case StatusType::USED:
@@ -66,7 +66,7 @@ void MMFilesWalSlot::finalize(MMFilesWalMarker const* marker) {
   TRI_ASSERT(_mem != nullptr);
   TRI_ASSERT(size == _size);
   TRI_ASSERT(size >= sizeof(MMFilesMarker));
-  TRI_ASSERT(_logfile != nullptr);
+  TRI_ASSERT(logfile() != nullptr);
 
   MMFilesMarker* dfm = static_cast<MMFilesMarker*>(_mem);
 
@@ -96,7 +96,7 @@ void MMFilesWalSlot::finalize(MMFilesWalMarker const* marker) {
 void MMFilesWalSlot::fill(void* src, size_t size) {
   TRI_ASSERT(size == _size);
   TRI_ASSERT(src != nullptr);
-  TRI_ASSERT(_logfile != nullptr);
+  TRI_ASSERT(logfile() != nullptr);
 
   MMFilesMarker* marker = static_cast<MMFilesMarker*>(src);
 
@@ -126,12 +126,12 @@ void MMFilesWalSlot::fill(void* src, size_t size) {
 /// @brief mark as slot as used
 void MMFilesWalSlot::setUnused() {
   TRI_ASSERT(isReturned());
-  TRI_ASSERT(_logfile != nullptr);
+  TRI_ASSERT(logfile() != nullptr);
   _tick = 0;
-  _logfile = nullptr;
+  _logfile.store(nullptr, std::memory_order_relaxed);
   _mem = nullptr;
   _size = 0;
-  _status = StatusType::UNUSED;
+  _status.store(StatusType::UNUSED, std::memory_order_release);
 }
 
 /// @brief mark as slot as used
@@ -140,19 +140,19 @@ void MMFilesWalSlot::setUsed(void* mem, uint32_t size, MMFilesWalLogfile* logfil
   TRI_ASSERT(isUnused());
   TRI_ASSERT(logfile != nullptr);
   _tick = tick;
-  _logfile = logfile;
+  _logfile.store(logfile, std::memory_order_relaxed);
   _mem = mem;
   _size = size;
-  _status = StatusType::USED;
+  _status.store(StatusType::USED, std::memory_order_release);
 }
 
 /// @brief mark as slot as returned
 void MMFilesWalSlot::setReturned(bool waitForSync) {
-  TRI_ASSERT(_logfile != nullptr);
+  TRI_ASSERT(logfile() != nullptr);
   TRI_ASSERT(isUsed());
   if (waitForSync) {
-    _status = StatusType::RETURNED_WFS;
+    _status.store(StatusType::RETURNED_WFS, std::memory_order_release);
   } else {
-    _status = StatusType::RETURNED;
+    _status.store(StatusType::RETURNED, std::memory_order_release);
   }
 }
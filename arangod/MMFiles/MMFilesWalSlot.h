@@ -56,14 +56,17 @@ class MMFilesWalSlot {
 
   /// @brief return the logfile id assigned to the slot
   inline MMFilesWalLogfile::IdType logfileId() const { 
-    if (_logfile != nullptr) {
-      return _logfile->id(); 
+    MMFilesWalLogfile const* logfile = _logfile.load(std::memory_order_relaxed);
+    if (logfile != nullptr) {
+      return logfile->id(); 
     }
     return 0;
   }
   
   /// @brief return the logfile assigned to the slot
-  inline MMFilesWalLogfile* logfile() const { return _logfile; } 
+  inline MMFilesWalLogfile* logfile() const { 
+    return _logfile.load(std::memory_order_relaxed); 
+  } 
 
   /// @brief return the raw memory pointer assigned to the slot
   inline void* mem() const { return _mem; }
@@ -84,20 +87,25 @@ class MMFilesWalSlot {
 
  private:
   /// @brief whether or not the slot is unused
-  inline bool isUnused() const { return _status == StatusType::UNUSED; }
+  inline bool isUnused() const { 
+    return _status.load(std::memory_order_acquire) == StatusType::UNUSED; 
+  }
 
   /// @brief whether or not the slot is used
-  inline bool isUsed() const { return _status == StatusType::USED; }
+  inline bool isUsed() const { 
+    return _status.load(std::memory_order_acquire) == StatusType::USED; 
+  }
 
   /// @brief whether or not the slot is returned
   inline bool isReturned() const {
-    return (_status == StatusType::RETURNED ||
-            _status == StatusType::RETURNED_WFS);
+    StatusType const status = _status.load(std::memory_order_acquire);
+    return (status == StatusType::RETURNED ||
+            status == StatusType::RETURNED_WFS);
   }
 
   /// @brief whether or not a sync was requested for the slot
   inline bool waitForSync() const {
-    return (_status == StatusType::RETURNED_WFS);
+    return (_status.load(std::memory_order_acquire) == StatusType::RETURNED_WFS);
   }
 
   /// @brief mark as slot as unused
@@ -113,8 +121,9 @@ class MMFilesWalSlot {
   /// @brief slot tick
   MMFilesWalSlot::TickType _tick;
 
-  /// @brief slot logfile
-  MMFilesWalLogfile* _logfile;
+  /// @brief slot logfile. it is read by the synchronizer while the slot
+  /// gets handed out
+  std::atomic<MMFilesWalLogfile*> _logfile;
 
   /// @brief slot raw memory pointer
   void* _mem;
@@ -126,8 +135,9 @@ class MMFilesWalSlot {
   /// @brief slot raw memory size
   uint32_t _size;
 
-  /// @brief slot status
-  StatusType _status; 
+  /// @brief slot status. the slot contents are published by the status
+  /// changes, so slots can be handed out and returned without the slots lock
+  std::atomic<StatusType> _status; 
 };
 
 static_assert(sizeof(MMFilesWalSlot) == 32, "invalid slot size");
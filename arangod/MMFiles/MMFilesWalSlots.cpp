@@ -25,6 +25,7 @@
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/ConditionLocker.h"
 #include "Basics/MutexLocker.h"
+#include "Basics/ScopeGuard.h"
 #include "Basics/encoding.h"
 #include "Logger/Logger.h"
 #include "MMFiles/MMFilesDatafile.h"
@@ -36,6 +37,28 @@ using namespace arangodb;
   
 static uint32_t const PrologueSize = encoding::alignedSize<uint32_t>(sizeof(MMFilesPrologueMarker));
 
+/// @brief the number of slots a marker may need: a footer and a header if
+/// the logfile is switched, a prologue, and the marker itself
+static size_t const MaxSlotsPerMarker = 4;
+
+/// @brief flag in the tail value while slots are handed out under the lock
+static uint64_t const ExclusiveHandout = 1ULL << 63;
+
+/// @brief reserved size in the tail value if there is no logfile to write to
+static uint64_t const NoLogfile = 0xffffffffULL;
+
+static inline uint64_t packTail(size_t index, uint64_t offset) {
+  return (static_cast<uint64_t>(index) << 32) | offset;
+}
+
+static inline size_t tailIndex(uint64_t tail) {
+  return static_cast<size_t>((tail & ~ExclusiveHandout) >> 32);
+}
+
+static inline uint64_t tailOffset(uint64_t tail) {
+  return tail & 0xffffffffULL;
+}
+
 /// @brief create the slots
 MMFilesWalSlots::MMFilesWalSlots(MMFilesLogfileManager* logfileManager, size_t numberOfSlots,
              MMFilesWalSlot::TickType tick)
@@ -47,6 +70,10 @@ MMFilesWalSlots::MMFilesWalSlots(MMFilesLogfileManager* logfileManager, size_t n
       _freeSlots(numberOfSlots),
       _waiting(0),
       _handoutIndex(0),
+      _tail(packTail(0, NoLogfile)),
+      _sequencedIndex(0),
+      _activeLogfile(nullptr),
+      _activeEnd(nullptr),
       _recycleIndex(0),
       _logfile(nullptr),
       _lastAssignedTick(0),
@@ -76,17 +103,17 @@ void MMFilesWalSlots::statistics(MMFilesWalSlot::TickType& lastAssignedTick,
                        uint64_t& numEvents,
                        uint64_t& numEventsSync) {
   MUTEX_LOCKER(mutexLocker, _lock);
-  lastAssignedTick = _lastAssignedTick;
+  lastAssignedTick = _lastAssignedTick.load();
   lastCommittedTick = _lastCommittedTick;
   lastCommittedDataTick = _lastCommittedDataTick;
-  numEvents = _numEvents;
-  numEventsSync = _numEventsSync;
+  numEvents = _numEvents.load();
+  numEventsSync = _numEventsSync.load();
 }
   
 /// @brief initially set the last ticks on start
 void MMFilesWalSlots::setLastTick(MMFilesWalSlot::TickType const& tick) {
   MUTEX_LOCKER(mutexLocker, _lock);
-  if (tick > _lastAssignedTick) {
+  if (tick > _lastAssignedTick.load()) {
     _lastAssignedTick = tick;
   }
   if (tick > _lastCommittedTick) {
@@ -154,19 +181,33 @@ MMFilesWalSlotInfo MMFilesWalSlots::nextUnused(TRI_voc_tick_t databaseId, TRI_vo
   TRI_ASSERT(size > 0);
 
   while (++iterations < 1000) {
+    if (!mustWritePrologue) {
+      // most markers fit into the current logfile, so try without the lock
+      MMFilesWalSlot* slot = tryHandoutUnlocked(databaseId, collectionId, size);
+
+      if (slot != nullptr) {
+        if (hasWaited) {
+          CONDITION_LOCKER(guard, _condition);
+          TRI_ASSERT(_waiting > 0);
+          --_waiting;
+        }
+        return MMFilesWalSlotInfo(slot);
+      }
+    }
+
     {
       MUTEX_LOCKER(mutexLocker, _lock);
+      lockHandout();
+      TRI_DEFER(unlockHandout());
 
       MMFilesWalSlot* slot = &_slots[_handoutIndex];
       TRI_ASSERT(slot != nullptr);
 
-      // check if next slot is free for writing
-      // and also is the slot following it is also free for writing
-      // this is required because in some cases we need two free slots
-      // to write a WAL entry: the first slot for the prologue marker
-      // and the second slot for the actual marker
-      if (slot->isUnused() && 
-          _slots[nextHandoutIndex()].isUnused()) {
+      // check if the next slots are free for writing
+      // this is required because in some cases we need several free slots
+      // to write a WAL entry: a footer and a header marker when the logfile
+      // is switched, a prologue marker, and the actual marker
+      if (hasUnusedSlots(MaxSlotsPerMarker)) {
         if (hasWaited) {
           CONDITION_LOCKER(guard, _condition);
           TRI_ASSERT(_waiting > 0);
@@ -300,13 +341,7 @@ MMFilesWalSlotInfo MMFilesWalSlots::nextUnused(TRI_voc_tick_t databaseId, TRI_vo
       hasWaited = true;
     }
 
-    bool mustWait;
-    {
-      MUTEX_LOCKER(mutexLocker, _lock);
-      mustWait = (_freeSlots < 2);
-    }
-
-    if (mustWait) {
+    if (_freeSlots.load() < MaxSlotsPerMarker) {
       guard.wait(10 * 1000);
     }
   }
@@ -322,20 +357,16 @@ int MMFilesWalSlots::returnUsed(MMFilesWalSlotInfo& slotInfo, bool wakeUpSynchro
   TRI_ASSERT(!waitUntilSyncDone || waitForSyncRequested);
 
   MMFilesWalSlot::TickType tick = slotInfo.slot->tick();
-  MMFilesMarker const* marker = reinterpret_cast<MMFilesMarker const*>(slotInfo.slot->mem());
-  MMFilesWalLogfile const* logfile = slotInfo.logfile;
 
   TRI_ASSERT(tick > 0);
 
-  {
-    MUTEX_LOCKER(mutexLocker, _lock);
-    TRI_UpdateTicksDatafile(logfile->df(), marker);
-    slotInfo.slot->setReturned(waitForSyncRequested);
-    if (waitForSyncRequested) {
-      ++_numEventsSync;
-    } else {
-      ++_numEvents;
-    }
+  // the status change publishes the slot to the synchronizer, which
+  // updates the tick ranges of the logfile in slot order
+  slotInfo.slot->setReturned(waitForSyncRequested);
+  if (waitForSyncRequested) {
+    ++_numEventsSync;
+  } else {
+    ++_numEvents;
   }
 
   wakeUpSynchronizer |= waitForSyncRequested;
@@ -497,7 +528,12 @@ void MMFilesWalSlots::getActiveLogfileRegion(MMFilesWalLogfile* logfile, char co
   MMFilesDatafile* datafile = logfile->df();
 
   begin = datafile->_data;
-  end = begin + datafile->currentSize();
+  if (logfile == _activeLogfile.load()) {
+    // lock-free handouts may advance the write position concurrently
+    end = _activeEnd.load(std::memory_order_acquire);
+  } else {
+    end = begin + datafile->currentSize();
+  }
 }
 
 /// @brief get the current tick range of a logfile
@@ -522,13 +558,16 @@ int MMFilesWalSlots::closeLogfile(MMFilesWalSlot::TickType& lastCommittedTick, b
   while (true) {
     {
       MUTEX_LOCKER(mutexLocker, _lock);
+      lockHandout();
+      TRI_DEFER(unlockHandout());
 
       lastCommittedTick = _lastCommittedTick;
 
       MMFilesWalSlot* slot = &_slots[_handoutIndex];
       TRI_ASSERT(slot != nullptr);
 
-      if (slot->isUnused()) {
+      // a footer for the current logfile and a header for the next one
+      if (hasUnusedSlots(2)) {
         if (hasWaited) {
           CONDITION_LOCKER(guard, _condition);
           TRI_ASSERT(_waiting > 0);
@@ -611,13 +650,7 @@ int MMFilesWalSlots::closeLogfile(MMFilesWalSlot::TickType& lastCommittedTick, b
       hasWaited = true;
     }
 
-    bool mustWait;
-    {
-      MUTEX_LOCKER(mutexLocker, _lock);
-      mustWait = (_freeSlots < 2);
-    }
-
-    if (mustWait) {
+    if (_freeSlots.load() < 2) {
       guard.wait(10 * 1000);
     }
     
@@ -704,18 +737,129 @@ MMFilesWalSlot::TickType MMFilesWalSlots::handout() {
     _handoutIndex = 0;
   }
 
-  _lastAssignedTick = static_cast<MMFilesWalSlot::TickType>(TRI_NewTickServer());
-  return _lastAssignedTick;
+  MMFilesWalSlot::TickType tick = static_cast<MMFilesWalSlot::TickType>(TRI_NewTickServer());
+  _lastAssignedTick = tick;
+  return tick;
 }
 
-/// @brief return the next slots that would be handed out, without 
-/// actually handing it out
-size_t MMFilesWalSlots::nextHandoutIndex() const {
+/// @brief whether the next slots that would be handed out are unused,
+/// without actually handing them out
+bool MMFilesWalSlots::hasUnusedSlots(size_t n) const {
   size_t handoutIndex = _handoutIndex;
-  if (++handoutIndex == _numberOfSlots) {
-    handoutIndex = 0;
+  for (size_t i = 0; i < n; ++i) {
+    if (!_slots[handoutIndex].isUnused()) {
+      return false;
+    }
+    if (++handoutIndex == _numberOfSlots) {
+      handoutIndex = 0;
+    }
+  }
+  return true;
+}
+
+/// @brief hand out a slot without the slots lock
+MMFilesWalSlot* MMFilesWalSlots::tryHandoutUnlocked(TRI_voc_tick_t databaseId, 
+                                                    TRI_voc_cid_t collectionId,
+                                                    uint32_t size) {
+  uint32_t const alignedSize = encoding::alignedSize<uint32_t>(size);
+  uint64_t tail = _tail.load(std::memory_order_acquire);
+
+  while ((tail & ExclusiveHandout) == 0) {
+    MMFilesWalLogfile* logfile = _activeLogfile.load(std::memory_order_acquire);
+
+    if (logfile == nullptr || tailOffset(tail) == NoLogfile ||
+        tailOffset(tail) + alignedSize + MMFilesDatafileHelper::JournalOverhead() >
+            logfile->allocatedSize()) {
+      // need a new logfile
+      return nullptr;
+    }
+
+    if (databaseId == 0 && collectionId == 0) {
+      if (_lastDatabaseId.load(std::memory_order_relaxed) != 0 ||
+          _lastCollectionId.load(std::memory_order_relaxed) != 0) {
+        // the next marker needs a prologue again
+        return nullptr;
+      }
+    } else if (databaseId > 0 && collectionId > 0 &&
+               (_lastDatabaseId.load(std::memory_order_relaxed) != databaseId ||
+                _lastCollectionId.load(std::memory_order_relaxed) != collectionId)) {
+      // need a prologue
+      return nullptr;
+    }
+
+    size_t const index = tailIndex(tail);
+    size_t next = index + 1;
+    if (next == _numberOfSlots) {
+      next = 0;
+    }
+
+    // claimed slots still look unused until they get their ticks, so do
+    // not let the claims go around the ring
+    size_t const sequenced = _sequencedIndex.load(std::memory_order_acquire);
+    size_t const claimed = (index + _numberOfSlots - sequenced) % _numberOfSlots;
+
+    if (claimed + 2 >= _numberOfSlots || !_slots[index].isUnused() ||
+        !_slots[next].isUnused()) {
+      // all slots are busy
+      return nullptr;
+    }
+
+    if (!_tail.compare_exchange_weak(tail, packTail(next, tailOffset(tail) + alignedSize),
+                                     std::memory_order_acq_rel,
+                                     std::memory_order_acquire)) {
+      // someone else got the slot, or handouts were stopped
+      continue;
+    }
+
+    // wait for the slots claimed before ours, so ticks and positions
+    // follow the slot order
+    while (_sequencedIndex.load(std::memory_order_acquire) != index) {
+      std::this_thread::yield();
+    }
+
+    char* mem = logfile->reserve(alignedSize);
+    TRI_ASSERT(mem == logfile->df()->_data + tailOffset(tail));
+    TRI_ASSERT(reinterpret_cast<uintptr_t>(mem) % 8 == 0);
+
+    MMFilesWalSlot* slot = &_slots[index];
+    --_freeSlots;
+    MMFilesWalSlot::TickType tick = static_cast<MMFilesWalSlot::TickType>(TRI_NewTickServer());
+    _lastAssignedTick = tick;
+    slot->setUsed(static_cast<void*>(mem), size, logfile, tick);
+
+    _activeEnd.store(mem + alignedSize, std::memory_order_release);
+    _sequencedIndex.store(next, std::memory_order_release);
+    return slot;
+  }
+
+  return nullptr;
+}
+
+/// @brief stop the lock-free handouts
+void MMFilesWalSlots::lockHandout() {
+  // only the holder of the slots lock sets the flag
+  uint64_t tail = _tail.fetch_or(ExclusiveHandout);
+  TRI_ASSERT((tail & ExclusiveHandout) == 0);
+
+  _handoutIndex = tailIndex(tail);
+  while (_sequencedIndex.load(std::memory_order_acquire) != _handoutIndex) {
+    std::this_thread::yield();
+  }
+}
+
+/// @brief allow lock-free handouts again
+void MMFilesWalSlots::unlockHandout() {
+  uint64_t offset = NoLogfile;
+
+  if (_logfile != nullptr) {
+    MMFilesDatafile* datafile = _logfile->df();
+    offset = datafile->currentSize();
+    _activeEnd.store(datafile->_data + offset, std::memory_order_release);
   }
-  return handoutIndex;
+
+  _activeLogfile.store(_logfile, std::memory_order_release);
+  _sequencedIndex.store(_handoutIndex, std::memory_order_release);
+  _tail.store(packTail(_handoutIndex, offset), std::memory_order_release);
 }
 
 /// @brief wait until all data has been synced up to a certain marker
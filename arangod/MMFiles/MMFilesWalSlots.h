@@ -140,9 +140,22 @@ class MMFilesWalSlots {
   /// @brief handout a region and advance the handout index
   MMFilesWalSlot::TickType handout();
 
-  /// @brief return the next slots that would be handed out, without 
-  /// actually handing it out
-  size_t nextHandoutIndex() const;
+  /// @brief whether the next slots that would be handed out are unused,
+  /// without actually handing them out
+  bool hasUnusedSlots(size_t) const;
+
+  /// @brief hand out a slot without the slots lock. this only works if the
+  /// marker fits into the current logfile and needs no prologue, otherwise
+  /// nullptr is returned and the slot must be handed out under the lock
+  MMFilesWalSlot* tryHandoutUnlocked(TRI_voc_tick_t databaseId,
+                                     TRI_voc_cid_t collectionId, uint32_t size);
+
+  /// @brief stop the lock-free handouts, and wait until all slots that were
+  /// already claimed got their ticks. requires the slots lock
+  void lockHandout();
+
+  /// @brief allow lock-free handouts again. requires the slots lock
+  void unlockHandout();
 
   /// @brief wait until all data has been synced up to a certain marker
   bool waitForTick(MMFilesWalSlot::TickType);
@@ -168,14 +181,32 @@ class MMFilesWalSlots {
   size_t const _numberOfSlots;
 
   /// @brief the number of currently free slots
-  size_t _freeSlots;
+  std::atomic<size_t> _freeSlots;
 
   /// @brief whether or not someone is waiting for a slot
   uint32_t _waiting;
 
-  /// @brief the index of the slot to hand out next
+  /// @brief the index of the slot to hand out next, while lock-free
+  /// handouts are stopped
   size_t _handoutIndex;
 
+  /// @brief the index of the slot to hand out next (upper half) and the
+  /// reserved size of the current logfile (lower half), which lock-free
+  /// handouts claim with a single CAS. the highest bit is set while
+  /// slots are handed out under the slots lock
+  std::atomic<uint64_t> _tail;
+
+  /// @brief the index of the next claimed slot to get its tick and its
+  /// memory. ticks and logfile positions are assigned in slot order, as
+  /// the sync regions and the readers of the logfiles expect it
+  std::atomic<size_t> _sequencedIndex;
+
+  /// @brief the logfile lock-free handouts write into, if any
+  std::atomic<MMFilesWalLogfile*> _activeLogfile;
+
+  /// @brief end of the handed out region of the active logfile
+  std::atomic<char const*> _activeEnd;
+
   /// @brief the index of the slot to recycle
   size_t _recycleIndex;
 
@@ -183,7 +214,7 @@ class MMFilesWalSlots {
   MMFilesWalLogfile* _logfile;
 
   /// @brief last assigned tick value
-  MMFilesWalSlot::TickType _lastAssignedTick;
+  std::atomic<MMFilesWalSlot::TickType> _lastAssignedTick;
 
   /// @brief last committed tick value
   MMFilesWalSlot::TickType _lastCommittedTick;
@@ -192,16 +223,16 @@ class MMFilesWalSlots {
   MMFilesWalSlot::TickType _lastCommittedDataTick;
 
   /// @brief number of log events handled
-  uint64_t _numEvents;
+  std::atomic<uint64_t> _numEvents;
 
   /// @brief number of sync log events handled
-  uint64_t _numEventsSync;
+  std::atomic<uint64_t> _numEventsSync;
   
   /// @brief last written database id (in prologue marker)
-  TRI_voc_tick_t _lastDatabaseId;
+  std::atomic<TRI_voc_tick_t> _lastDatabaseId;
   
   /// @brief last written collection id (in prologue marker)
-  TRI_voc_cid_t _lastCollectionId;
+  std::atomic<TRI_voc_cid_t> _lastCollectionId;
 
   /// @brief shutdown flag, set by MMFilesLogfileManager on shutdown
   bool _shutdown;
@@ -24,6 +24,7 @@
 #include "Pregel/Algos/AsyncSCC.h"
 #include "Pregel/Algos/ConnectedComponents.h"
 #include "Pregel/Algos/DMID/DMID.h"
+#include "Pregel/Algos/DeltaPageRank.h"
 #include "Pregel/Algos/EffectiveCloseness/EffectiveCloseness.h"
 #include "Pregel/Algos/HITS.h"
 #include "Pregel/Algos/LabelPropagation.h"
@@ -45,6 +46,8 @@ IAlgorithm* AlgoRegistry::createAlgorithm(std::string const& algorithm,
     return new algos::SSSPAlgorithm(userParams);
   } else if (algorithm == "pagerank") {
     return new algos::PageRank(userParams);
+  } else if (algorithm == "deltapagerank") {
+    return new algos::DeltaPageRank(userParams);
   } else if (algorithm == "recoveringpagerank") {
     return new algos::RecoveringPageRank(userParams);
   } else if (algorithm == "shortestpath") {
@@ -103,6 +106,8 @@ template <typename V, typename E, typename M>
     return createWorker(vocbase, new algos::SSSPAlgorithm(userParams), body);
   } else if (algorithm == "pagerank") {
     return createWorker(vocbase, new algos::PageRank(userParams), body);
+  } else if (algorithm == "deltapagerank") {
+    return createWorker(vocbase, new algos::DeltaPageRank(userParams), body);
   } else if (algorithm == "recoveringpagerank") {
     return createWorker(vocbase, new algos::RecoveringPageRank(userParams),
                         body);
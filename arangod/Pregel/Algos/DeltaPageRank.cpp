@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "DeltaPageRank.h"
+#include "Pregel/Algos/PageRank.h"
+#include "Pregel/GraphFormat.h"
+#include "Pregel/Iterators.h"
+#include "Pregel/Utils.h"
+#include "Pregel/VertexComputation.h"
+
+using namespace arangodb;
+using namespace arangodb::pregel;
+using namespace arangodb::pregel::algos;
+
+static float EPS = 0.00001f;
+static float DAMPING = 0.85f;
+
+struct DeltaPRWorkerContext : public WorkerContext {
+  float threshold;
+  explicit DeltaPRWorkerContext(VPackSlice params) {
+    VPackSlice t = params.get("threshold");
+    threshold = t.isNumber() ? t.getNumber<float>() : EPS;
+  }
+
+  float commonProb = 0;
+  /// smallest change of a rank which is propagated. the threshold is
+  /// relative to the average rank
+  float epsilon = 0;
+  void preGlobalSuperstep(uint64_t gss) override {
+    commonProb = (1.0f - DAMPING) / vertexCount();
+    epsilon = threshold / vertexCount();
+  }
+};
+
+DeltaPageRank::DeltaPageRank(VPackSlice const& params)
+    : SimpleAlgorithm("DeltaPageRank", params),
+      _useSource(params.hasKey("sourceField")) {}
+
+GraphFormat<float, float>* DeltaPageRank::inputFormat() const {
+  if (_useSource && !_sourceField.empty()) {
+    return new SeededPRGraphFormat(_sourceField, _resultField, -1.0);
+  } else {
+    return new VertexGraphFormat<float, float>(_resultField, -1.0);
+  }
+}
+
+struct DeltaPRComputation : public VertexComputation<float, float, float> {
+  DeltaPRComputation() {}
+  void compute(MessageIterator<float> const& messages) override {
+    DeltaPRWorkerContext const* ctx =
+        static_cast<DeltaPRWorkerContext const*>(context());
+    float* ptr = mutableVertexData();
+    size_t edges = getEdgeCount();
+
+    if (globalSuperstep() == 0) {
+      // vertices without a seed start with nothing, the next superstep
+      // hands out the common part of the rank
+      if (*ptr < 0) {
+        *ptr = 0.0f;
+      } else if (edges > 0) {
+        sendMessageToAllNeighbours(*ptr / edges);
+      }
+      return;
+    }
+
+    float sum = 0.0f;
+    for (const float* msg : messages) {
+      sum += *msg;
+    }
+    float delta;
+    if (globalSuperstep() == 1) {
+      // the messages are the whole contributions of the seeds, the
+      // difference to the seed is the first change of the rank
+      delta = ctx->commonProb + DAMPING * sum - *ptr;
+    } else {
+      // the messages are the changes of the ranks of the neighbours
+      delta = DAMPING * sum;
+    }
+    *ptr += delta;
+
+    if (edges > 0 && fabs(delta) > ctx->epsilon) {
+      sendMessageToAllNeighbours(delta / edges);
+    }
+    // messages wake the vertex up again
+    voteHalt();
+  }
+};
+
+VertexComputation<float, float, float>* DeltaPageRank::createComputation(
+    WorkerConfig const* config) const {
+  return new DeltaPRComputation();
+}
+
+WorkerContext* DeltaPageRank::workerContext(VPackSlice userParams) const {
+  return new DeltaPRWorkerContext(userParams);
+}
@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_PREGEL_ALGOS_DELTA_PAGERANK_H
+#define ARANGODB_PREGEL_ALGOS_DELTA_PAGERANK_H 1
+
+#include <velocypack/Slice.h>
+#include "Pregel/Algorithm.h"
+
+namespace arangodb {
+namespace pregel {
+namespace algos {
+
+/// PageRank which propagates the changes of the ranks. After the first two
+/// supersteps a vertex only sends a message if its rank changed by more
+/// than the threshold, and halts otherwise. Seeded with the ranks of a
+/// previous run (sourceField), a rerun on a slightly changed graph takes
+/// a few cheap supersteps
+struct DeltaPageRank : public SimpleAlgorithm<float, float, float> {
+  explicit DeltaPageRank(arangodb::velocypack::Slice const& params);
+
+  GraphFormat<float, float>* inputFormat() const override;
+
+  MessageFormat<float>* messageFormat() const override {
+    return new NumberMessageFormat<float>();
+  }
+
+  MessageCombiner<float>* messageCombiner() const override {
+    return new SumCombiner<float>();
+  }
+
+  VertexComputation<float, float, float>* createComputation(
+      WorkerConfig const*) const override;
+
+  WorkerContext* workerContext(VPackSlice userParams) const override;
+
+ private:
+  bool const _useSource;
+};
+}
+}
+}
+#endif
@@ -52,22 +52,6 @@ PageRank::PageRank(VPackSlice const& params)
     : SimpleAlgorithm("PageRank", params), _useSource(params.hasKey("sourceField")) {
 }
 
-/// will use a seed value for pagerank if available
-struct SeededPRGraphFormat final : public NumberGraphFormat<float, float> {
-  SeededPRGraphFormat(std::string const& source, std::string const& result,
-                      float vertexNull)
-      : NumberGraphFormat(source, result, vertexNull, 0.0f) {}
-
-  size_t copyEdgeData(arangodb::velocypack::Slice document, float*,
-                      size_t maxSize) override {
-    return 0;
-  }
-  bool buildEdgeDocument(arangodb::velocypack::Builder& b, float const*,
-                         size_t size) const override {
-    return false;
-  }
-};
-
 GraphFormat<float, float>* PageRank::inputFormat() const {
   if (_useSource && !_sourceField.empty()) {
     return new SeededPRGraphFormat(_sourceField, _resultField, -1.0);
@@ -25,11 +25,28 @@
 
 #include <velocypack/Slice.h>
 #include "Pregel/Algorithm.h"
+#include "Pregel/GraphFormat.h"
 
 namespace arangodb {
 namespace pregel {
 namespace algos {
 
+/// will use a seed value for pagerank if available
+struct SeededPRGraphFormat final : public NumberGraphFormat<float, float> {
+  SeededPRGraphFormat(std::string const& source, std::string const& result,
+                      float vertexNull)
+      : NumberGraphFormat(source, result, vertexNull, 0.0f) {}
+
+  size_t copyEdgeData(arangodb::velocypack::Slice document, float*,
+                      size_t maxSize) override {
+    return 0;
+  }
+  bool buildEdgeDocument(arangodb::velocypack::Builder& b, float const*,
+                         size_t size) const override {
+    return false;
+  }
+};
+
 /// PageRank
 struct PageRank : public SimpleAlgorithm<float, float, float> {
 
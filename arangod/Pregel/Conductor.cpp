@@ -306,6 +306,7 @@ VPackBuilder Conductor::finishedWorkerStep(VPackSlice const& data) {
       << "Finished gss " << _globalSuperstep << " in "
       << (TRI_microtime() - _computationStartTimeSecs) << "s";
   //_statistics.debugOutput();
+  _statistics.finishSuperstep();
   _globalSuperstep++;
 
   TRI_ASSERT(SchedulerFeature::SCHEDULER != nullptr);
@@ -60,6 +60,15 @@ struct PregelID {
 template <typename V, typename E>
 class GraphStore;
 
+/// @brief target vertex of edges. the GraphStore keeps one per distinct
+/// target, all edges to the vertex point to it
+struct EdgeTarget {
+  PregelShard shard;
+  PregelKey key;
+
+  EdgeTarget() : shard(InvalidPregelShard) {}
+};
+
 /// @brief header entry for the edge file
 template <typename E>
 class Edge {
@@ -67,24 +76,21 @@ class Edge {
   friend class GraphStore;
 
   // PregelShard _sourceShard;
-  PregelShard _targetShard;
-  PregelKey _toKey;
+  EdgeTarget const* _target;
   E _data;
 
  public:
   // EdgeEntry() : _nextEntryOffset(0), _dataSize(0), _vertexIDSize(0) {}
-  Edge() : _targetShard(InvalidPregelShard) {}
-  Edge(PregelShard target, PregelKey const& key)
-      : _targetShard(target), _toKey(key), _data(0) {}
+  Edge() : _target(nullptr) {}
 
   // size_t getSize() { return sizeof(EdgeEntry) + _vertexIDSize + _dataSize; }
-  PregelKey const& toKey() const { return _toKey; }
+  PregelKey const& toKey() const { return _target->key; }
   // size_t getDataSize() { return _dataSize; }
   inline E* data() {
     return &_data;  // static_cast<E>(this + sizeof(EdgeEntry) + _vertexIDSize);
   }
   // inline PregelShard sourceShard() const { return _sourceShard; }
-  inline PregelShard targetShard() const { return _targetShard; }
+  inline PregelShard targetShard() const { return _target->shard; }
 };
 
 class VertexEntry {
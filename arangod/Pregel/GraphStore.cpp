@@ -122,11 +122,15 @@ std::unordered_map<ShardID, uint64_t> GraphStore<V, E>::_preallocateMemory() {
   
   size_t requiredMem = vCount * _graphFormat->estimatedVertexSize() +
                        eCount * _graphFormat->estimatedEdgeSize();
-  if (!_config->lazyLoading() && requiredMem > totalMemory / 2) {
+  if (!_config->lazyLoading() &&
+      (_config->useMemoryMaps() || requiredMem > totalMemory / 2)) {
+    // file mappings can be larger than the memory, the kernel writes
+    // back and evicts their pages
+    bool physical = _config->useMemoryMaps();
     if (_graphFormat->estimatedVertexSize() > 0) {
-      _vertexData = new MappedFileBuffer<V>(vCount);
+      _vertexData = new MappedFileBuffer<V>(vCount, physical);
     }
-    _edges = new MappedFileBuffer<Edge<E>>(eCount);
+    _edges = new MappedFileBuffer<Edge<E>>(eCount, physical);
   } else {
     if (_graphFormat->estimatedVertexSize() > 0) {
       _vertexData = new VectorTypedBuffer<V>(vCount);
@@ -165,18 +169,27 @@ void GraphStore<V, E>::loadShards(WorkerConfig* config,
     
     // calculating sum of all ith edge shards and set it as
     // starting offset for all i+1 edge shards
+    std::vector<uint64_t> edgeShardsOffset;
     for (auto const& pair : edgeCollMap) {
       std::vector<ShardID> const& edgeShards = pair.second;
-      if (_edgeShardsOffset.size() == 0) {
-        _edgeShardsOffset.resize(edgeShards.size()+1);
-        std::fill(_edgeShardsOffset.begin(), _edgeShardsOffset.end(), 0);
+      if (edgeShardsOffset.size() == 0) {
+        edgeShardsOffset.resize(edgeShards.size()+1);
+        std::fill(edgeShardsOffset.begin(), edgeShardsOffset.end(), 0);
       } else {
-        TRI_ASSERT(_edgeShardsOffset.size() == edgeShards.size()+1);
+        TRI_ASSERT(edgeShardsOffset.size() == edgeShards.size()+1);
       }
       for (size_t i = 0; i < edgeShards.size(); i++) {
-        _edgeShardsOffset[i+1] += shardSizes[edgeShards[i]];
+        edgeShardsOffset[i+1] += shardSizes[edgeShards[i]];
       }
     }
+    // the start of the ith edge shards is the end of the (i-1)th
+    for (size_t i = 1; i < edgeShardsOffset.size(); i++) {
+      edgeShardsOffset[i] += edgeShardsOffset[i-1];
+    }
+    _edgeShardsOffset = std::vector<std::atomic<uint64_t>>(edgeShardsOffset.size());
+    for (size_t i = 0; i < edgeShardsOffset.size(); i++) {
+      _edgeShardsOffset[i].store(edgeShardsOffset[i]);
+    }
     
     for (auto const& pair : vertexCollMap) {
       std::vector<ShardID> const& vertexShards = pair.second;
@@ -208,10 +221,20 @@ void GraphStore<V, E>::loadShards(WorkerConfig* config,
         // update to next offset
         vertexOffset += shardSizes[vertexShard];
       }
-      
-      while (_runningThreads > 0) {
-        std::this_thread::sleep_for(std::chrono::microseconds(5000));
-      }
+    }
+
+    // all vertex shards load at the same time, also the shards with the
+    // same edge shards of different vertex collections
+    while (_runningThreads > 0) {
+      std::this_thread::sleep_for(std::chrono::microseconds(5000));
+    }
+    // the supersteps read vertices and their edges in the order of the
+    // buffers, ranges of them per thread
+    if (_vertexData != nullptr) {
+      _vertexData->sequentialAccess();
+    }
+    if (_edges != nullptr) {
+      _edges->sequentialAccess();
     }
     scheduler->post(callback);
   });
@@ -254,9 +277,9 @@ void GraphStore<V, E>::loadDocument(WorkerConfig* config,
   _index.emplace_back(sourceShard, _key);
 
   VertexEntry& entry = _index.back();
+  entry._edgeDataOffset = _localEdgeCount;
   if (_graphFormat->estimatedVertexSize() > 0) {
     entry._vertexDataOffset = _localVerticeCount;
-    entry._edgeDataOffset = _localEdgeCount;
 
     // allocate space if needed
     if (_vertexData->size() <= _localVerticeCount) {
@@ -280,6 +303,7 @@ void GraphStore<V, E>::loadDocument(WorkerConfig* config,
       _config->vertexCollectionShards();
   std::map<CollectionID, std::vector<ShardID>> const& edgeMap =
       _config->edgeCollectionShards();
+  std::vector<Edge<E>> edges;
   for (auto const& pair : vertexMap) {
     std::vector<ShardID> const& vertexShards = pair.second;
     auto it = std::find(vertexShards.begin(), vertexShards.end(), vertexShard);
@@ -287,11 +311,23 @@ void GraphStore<V, E>::loadDocument(WorkerConfig* config,
       size_t pos = (size_t)(it - vertexShards.begin());
       for (auto const& pair2 : edgeMap) {
         std::vector<ShardID> const& edgeShards = pair2.second;
-        _loadEdges(trx.get(), edgeShards[pos], entry, documentId);
+        traverser::EdgeCollectionInfo info(trx.get(), edgeShards[pos],
+                                           TRI_EDGE_OUT,
+                                           StaticStrings::FromString, 0);
+        _loadEdges(info, documentId, edges);
       }
       break;
     }
   }
+  for (Edge<E> const& edge : edges) {
+    // lazy loading always uses vector backed storage
+    if (_edges->size() <= _localEdgeCount) {
+      ((VectorTypedBuffer<Edge<E>>*)_edges)->appendEmptyElement();
+    }
+    *(_edges->data() + _localEdgeCount) = edge;
+    _localEdgeCount++;
+  }
+  entry._edgeCount = edges.size();
   if (!trx->commit().ok()) {
     LOG_TOPIC(WARN, Logger::PREGEL)
         << "Pregel worker: Failed to commit on a read transaction";
@@ -362,7 +398,7 @@ void GraphStore<V, E>::_loadVertices(size_t i,
   PregelShard sourceShard = (PregelShard)_config->shardId(vertexShard);
 
   std::unique_ptr<OperationCursor> cursor =
-    trx->indexScan(vertexShard, transaction::Methods::CursorType::ALL);
+    trx->indexScan(vertexShard, transaction::Methods::CursorType::SCAN);
 
   if (cursor->fail()) {
     THROW_ARANGO_EXCEPTION_FORMAT(cursor->code, "while looking up shard '%s'",
@@ -374,6 +410,14 @@ void GraphStore<V, E>::_loadVertices(size_t i,
   uint64_t number = collection->numberDocuments(trx.get());
   _graphFormat->willLoadVertices(number);
 
+  // the edge indexes are looked up once for all vertices
+  std::vector<std::unique_ptr<traverser::EdgeCollectionInfo>> edgeInfos;
+  for (ShardID const& edgeShard : edgeShards) {
+    edgeInfos.emplace_back(new traverser::EdgeCollectionInfo(
+        trx.get(), edgeShard, TRI_EDGE_OUT, StaticStrings::FromString, 0));
+  }
+  std::vector<Edge<E>> edges;
+
   auto cb = [&](LocalDocumentId const& token, VPackSlice slice) {
     if (slice.isExternal()) {
       slice = slice.resolveExternal();
@@ -381,7 +425,6 @@ void GraphStore<V, E>::_loadVertices(size_t i,
     VertexEntry& ventry = _index[vertexOffset];
     ventry._shard = sourceShard;
     ventry._key = transaction::helpers::extractKeyFromDocument(slice).copyString();
-    ventry._edgeDataOffset = _edgeShardsOffset[i];
 
     // load vertex data
     std::string documentId = trx->extractIdString(slice);
@@ -391,11 +434,24 @@ void GraphStore<V, E>::_loadVertices(size_t i,
       _graphFormat->copyVertexData(documentId, slice, ptr, sizeof(V));
     }
     // load edges
-    for (ShardID const& edgeShard : edgeShards) {
-      _loadEdges(trx.get(), edgeShard, ventry, documentId);
+    edges.clear();
+    for (auto& info : edgeInfos) {
+      _loadEdges(*info, documentId, edges);
     }
+    // reserve the space for the edges of the vertex
+    ventry._edgeDataOffset = _edgeShardsOffset[i].fetch_add(edges.size());
+    ventry._edgeCount = edges.size();
+    if (ventry._edgeDataOffset + edges.size() > _edges->size()) {
+      LOG_TOPIC(ERR, Logger::PREGEL) << "Pregel did not preallocate enough "
+                                     << "space for all edges. This hints "
+                                     << "at a bug with collection count()";
+      TRI_ASSERT(false);
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
+    }
+    std::copy(edges.begin(), edges.end(),
+              _edges->data() + ventry._edgeDataOffset);
+    _localEdgeCount += edges.size();
     vertexOffset++;
-    _edgeShardsOffset[i] += ventry._edgeCount;
   };
   while (cursor->nextDocument(cb, 1000)) {
     if (_destroyed) {
@@ -414,22 +470,15 @@ void GraphStore<V, E>::_loadVertices(size_t i,
 }
 
 template <typename V, typename E>
-void GraphStore<V, E>::_loadEdges(transaction::Methods* trx,
-                                  ShardID const& edgeShard,
-                                  VertexEntry& vertexEntry,
-                                  std::string const& documentID) {
-  size_t added = 0;
-  size_t offset = vertexEntry._edgeDataOffset + vertexEntry._edgeCount;
-  // moving pointer to edge
-
-  traverser::EdgeCollectionInfo info(trx, edgeShard, TRI_EDGE_OUT,
-                                     StaticStrings::FromString, 0);
+void GraphStore<V, E>::_loadEdges(traverser::EdgeCollectionInfo& info,
+                                  std::string const& documentID,
+                                  std::vector<Edge<E>>& edges) {
   ManagedDocumentResult mmdr;
   std::unique_ptr<OperationCursor> cursor = info.getEdges(documentID, &mmdr);
   if (cursor->fail()) {
     THROW_ARANGO_EXCEPTION_FORMAT(cursor->code,
                                   "while looking up edges '%s' from %s",
-                                  documentID.c_str(), edgeShard.c_str());
+                                  documentID.c_str(), info.getName().c_str());
   }
 
   auto cb = [&](LocalDocumentId const& token, VPackSlice slice) {
@@ -437,42 +486,14 @@ void GraphStore<V, E>::_loadEdges(transaction::Methods* trx,
       slice = slice.resolveExternal();
     }
 
-    // If this is called from loadDocument we didn't preallocate the vector
-    if (_edges->size() <= offset) {
-      if (!_config->lazyLoading()) {
-        LOG_TOPIC(ERR, Logger::PREGEL) << "Pregel did not preallocate enough "
-                                       << "space for all edges. This hints "
-                                       << "at a bug with collection count()";
-        TRI_ASSERT(false);
-        THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
-      }
-      // lazy loading always uses vector backed storage
-      ((VectorTypedBuffer<Edge<E>>*)_edges)->appendEmptyElement();
-    }
-    
     std::string toValue = slice.get(StaticStrings::ToString).copyString();
-    std::size_t pos = toValue.find('/');
-    std::string collectionName = toValue.substr(0, pos);
-    Edge<E>* edge = _edges->data() + offset;
-    edge->_toKey = toValue.substr(pos + 1, toValue.length() - pos - 1);
-
-    // resolve the shard of the target vertex.
-    ShardID responsibleShard;
-    int res =
-        Utils::resolveShard(_config, collectionName, StaticStrings::KeyString,
-                            edge->_toKey, responsibleShard);
-
-    if (res == TRI_ERROR_NO_ERROR) {
+    Edge<E> edge;
+    edge._target = _edgeTarget(toValue);
+
+    if (edge._target->shard != InvalidPregelShard) {
       // PregelShard sourceShard = (PregelShard)_config->shardId(edgeShard);
-      edge->_targetShard = (PregelShard)_config->shardId(responsibleShard);
-      _graphFormat->copyEdgeData(slice, edge->data(), sizeof(E));
-      if (edge->_targetShard != (PregelShard)-1) {
-        added++;
-        offset++;
-      } else {
-        LOG_TOPIC(ERR, Logger::PREGEL)
-            << "Could not resolve target shard of edge";
-      }
+      _graphFormat->copyEdgeData(slice, edge.data(), sizeof(E));
+      edges.push_back(edge);
     } else {
       LOG_TOPIC(ERR, Logger::PREGEL)
           << "Could not resolve target shard of edge";
@@ -484,10 +505,33 @@ void GraphStore<V, E>::_loadEdges(transaction::Methods* trx,
       break;
     }
   }
+}
+
+template <typename V, typename E>
+EdgeTarget const* GraphStore<V, E>::_edgeTarget(std::string const& toValue) {
+  TargetStripe& stripe =
+      _targets[std::hash<std::string>()(toValue) % NumTargetStripes];
+  MUTEX_LOCKER(guard, stripe.lock);
+  auto it = stripe.targets.find(toValue);
+  if (it != stripe.targets.end()) {
+    return &it->second;
+  }
 
-  // Add up all added elements
-  vertexEntry._edgeCount += added;
-  _localEdgeCount += added;
+  std::size_t pos = toValue.find('/');
+  std::string collectionName = toValue.substr(0, pos);
+  EdgeTarget target;
+  target.key = toValue.substr(pos + 1, toValue.length() - pos - 1);
+
+  // resolve the shard of the target vertex.
+  ShardID responsibleShard;
+  int res =
+      Utils::resolveShard(_config, collectionName, StaticStrings::KeyString,
+                          target.key, responsibleShard);
+  if (res == TRI_ERROR_NO_ERROR) {
+    target.shard = (PregelShard)_config->shardId(responsibleShard);
+  }
+  // failed targets are kept as well, their edges are skipped
+  return &stripe.targets.emplace(toValue, std::move(target)).first->second;
 }
 
 /// Loops over the array starting a new transaction for different shards
@@ -499,12 +543,16 @@ void GraphStore<V, E>::_storeVertices(std::vector<ShardID> const& globalShards,
   std::unique_ptr<transaction::Methods> trx;
   PregelShard currentShard = (PregelShard)-1;
   Result res = TRI_ERROR_NO_ERROR;
+  // vertices written in the current transaction
+  uint64_t written = 0;
+  uint64_t const batchSize = _config->storeBatchSize();
 
   V* vData = _vertexData->data();
 
   // loop over vertices
   while (it != it.end()) {
-    if (it->shard() != currentShard) {
+    if (it->shard() != currentShard || written >= batchSize) {
+      // commit intermediately, instead of one huge transaction per shard
       if (trx) {
         res = trx->finish(res);
 
@@ -514,6 +562,7 @@ void GraphStore<V, E>::_storeVertices(std::vector<ShardID> const& globalShards,
       }
 
       currentShard = it->shard();
+      written = 0;
 
       ShardID const& shard = globalShards[currentShard];
       transaction::Options transactionOptions;
@@ -540,7 +589,8 @@ void GraphStore<V, E>::_storeVertices(std::vector<ShardID> const& globalShards,
 
     size_t buffer = 0;
 
-    while (it != it.end() && it->shard() == currentShard && buffer < 1000) {
+    while (it != it.end() && it->shard() == currentShard && buffer < 1000 &&
+           written < batchSize) {
       // This loop will fill a buffer of vertices until we run into a new
       // collection
       // or there are no more vertices for to store (or the buffer is full)
@@ -553,6 +603,7 @@ void GraphStore<V, E>::_storeVertices(std::vector<ShardID> const& globalShards,
 
       ++it;
       ++buffer;
+      ++written;
     }
     b->close();
     if (_destroyed) {
@@ -591,31 +642,37 @@ void GraphStore<V, E>::storeResults(WorkerConfig* config,
     delta = _index.size();
   }
   size_t start = 0, end = delta;
+  // count all ranges up front, an early range must not see zero running
+  // threads before the others are posted
+  std::vector<std::pair<size_t, size_t>> ranges;
+  do {
+    ranges.emplace_back(start, end);
+    start = end;
+    end = end + delta;
+    if (total < end + delta) {  // swallow the rest
+      end = total;
+    }
+  } while (start != end);
+  _runningThreads += static_cast<uint32_t>(ranges.size());
 
   TRI_ASSERT(SchedulerFeature::SCHEDULER != nullptr);
-  do {
-    _runningThreads++;
-    SchedulerFeature::SCHEDULER->post([this, start, end, now, callback] {
+  for (auto const& range : ranges) {
+    SchedulerFeature::SCHEDULER->post([this, range, now, callback] {
       try {
-        RangeIterator<VertexEntry> it = vertexIterator(start, end);
+        RangeIterator<VertexEntry> it =
+            vertexIterator(range.first, range.second);
         _storeVertices(_config->globalShardIDs(), it);
         // TODO can't just write edges with smart graphs
       } catch (...) {
         LOG_TOPIC(ERR, Logger::PREGEL) << "Storing vertex data failed";
       }
-      _runningThreads--;
-      if (_runningThreads == 0) {
+      if (--_runningThreads == 0) {
         LOG_TOPIC(DEBUG, Logger::PREGEL) << "Storing data took "
                                         << (TRI_microtime() - now) << "s";
         callback();
       }
     });
-    start = end;
-    end = end + delta;
-    if (total < end + delta) {  // swallow the rest
-      end = total;
-    }
-  } while (start != end);
+  }
 }
 
 template class arangodb::pregel::GraphStore<int64_t, int64_t>;
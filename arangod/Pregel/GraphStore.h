@@ -23,6 +23,7 @@
 #ifndef ARANGODB_PREGEL_GRAPH_STORE_H
 #define ARANGODB_PREGEL_GRAPH_STORE_H 1
 
+#include <array>
 #include <atomic>
 #include <cstdint>
 #include <cstdio>
@@ -45,6 +46,10 @@ namespace transaction {
 class Methods;
 }
 
+namespace traverser {
+class EdgeCollectionInfo;
+}
+
 namespace pregel {
 
 template <typename T>
@@ -92,10 +97,15 @@ private:
   void _loadVertices(size_t i, ShardID const& vertexShard,
                      std::vector<ShardID> const& edgeShards,
                      uint64_t vertexOffset);
-  void _loadEdges(transaction::Methods* trx, ShardID const& shard,
-                  VertexEntry& vertexEntry, std::string const& documentID);
+  /// @brief appends the outgoing edges of the vertex in the edge shard
+  void _loadEdges(traverser::EdgeCollectionInfo& info,
+                  std::string const& documentID,
+                  std::vector<Edge<E>>& edges);
   void _storeVertices(std::vector<ShardID> const& globalShards,
                       RangeIterator<VertexEntry>& it);
+  /// @brief the target of an edge with the given _to, looked up in and
+  /// resolved to its shard only once
+  EdgeTarget const* _edgeTarget(std::string const& toValue);
   std::unique_ptr<transaction::Methods> _createTransaction();
 
   DatabaseGuard _vocbaseGuard;
@@ -111,13 +121,24 @@ private:
   /// Edges (and data)
   TypedBuffer<Edge<E>>* _edges = nullptr;
 
+  /// Targets of the edges by their _to value. An edge only holds a pointer
+  /// to its target, so the key of a vertex is stored once instead of once
+  /// per edge. Striped, because the vertex shards are loaded in parallel
+  struct TargetStripe {
+    Mutex lock;
+    std::unordered_map<std::string, EdgeTarget> targets;
+  };
+  static constexpr size_t NumTargetStripes = 64;
+  std::array<TargetStripe, NumTargetStripes> _targets;
+
   // cache the amount of vertices
   std::set<ShardID> _loadedShards;
 
-  // hold the current position where the ith vertex shard can
-  // start to write its data. At the end the offset should equal the
-  // sum of the counts of all ith edge shards
-  std::vector<uint64_t> _edgeShardsOffset;
+  // hold the current position where the ith vertex shards can
+  // start to write their data. At the end the offset should equal the
+  // sum of the counts of all ith edge shards. The ith shards of all vertex
+  // collections load in parallel, every vertex reserves its edges here
+  std::vector<std::atomic<uint64_t>> _edgeShardsOffset;
 
   // actual count of loaded vertices / edges
   std::atomic<uint64_t> _localVerticeCount;
@@ -47,28 +47,28 @@ void InCache<M>::parseMessages(VPackSlice const& incomingData) {
 
   // temporary variables
   VPackValueLength i = 0;
+  uint64_t count = 0;
   PregelKey key;
   PregelShard shard = (PregelShard)shardSlice.getUInt();
-  MUTEX_LOCKER(guard, this->_bucketLocker[shard]);
 
+  // unwrap the values without holding the lock, packets for the same
+  // shard arrive concurrently from all the other workers
+  std::vector<std::pair<PregelKey, M>> batch;
+  batch.reserve(static_cast<size_t>(messages.length() / 2));
   for (VPackSlice current : VPackArrayIterator(messages)) {
     if (i % 2 == 0) {  // TODO support multiple recipients
       key = current.copyString();
     } else {
       if (current.isArray()) {
-        VPackValueLength c = 0;
         for (VPackSlice val : VPackArrayIterator(current)) {
-          M newValue;
-          _format->unwrapValue(val, newValue);
-          _set(shard, key, newValue);
-          c++;
+          batch.emplace_back(key, M());
+          _format->unwrapValue(val, batch.back().second);
+          count++;
         }
-        this->_containedMessageCount += c;
       } else {
-        M newValue;
-        _format->unwrapValue(current, newValue);
-        _set(shard, key, newValue);
-        this->_containedMessageCount++;
+        batch.emplace_back(std::move(key), M());
+        _format->unwrapValue(current, batch.back().second);
+        count++;
       }
     }
     i++;
@@ -79,6 +79,14 @@ void InCache<M>::parseMessages(VPackSlice const& incomingData) {
         TRI_ERROR_BAD_PARAMETER,
         "There must always be a multiple of 2 entries in message array");
   }
+
+  _combineBatch(batch);
+
+  MUTEX_LOCKER(guard, this->_bucketLocker[shard]);
+  for (auto const& message : batch) {
+    _set(shard, message.first, message.second);
+  }
+  this->_containedMessageCount += count;
 }
 
 template <typename M>
@@ -234,6 +242,31 @@ void CombiningInCache<M>::_set(PregelShard shard, PregelKey const& key,
   }
 }
 
+template <typename M>
+void CombiningInCache<M>::_combineBatch(
+    std::vector<std::pair<PregelKey, M>>& batch) const {
+  if (batch.size() < 2) {
+    return;
+  }
+  // combine the messages for the same vertex into the first one, so only
+  // one message per vertex is left to store under the lock
+  std::unordered_map<PregelKey, size_t> first;
+  first.reserve(batch.size());
+  size_t n = 0;
+  for (size_t i = 0; i < batch.size(); i++) {
+    auto it = first.emplace(batch[i].first, n);
+    if (it.second) {
+      if (i != n) {
+        batch[n] = std::move(batch[i]);
+      }
+      n++;
+    } else {
+      _combiner->combine(batch[it.first->second].second, batch[i].second);
+    }
+  }
+  batch.resize(n);
+}
+
 template <typename M>
 void CombiningInCache<M>::mergeCache(WorkerConfig const& config,
                                      InCache<M> const* otherCache) {
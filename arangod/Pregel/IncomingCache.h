@@ -56,6 +56,9 @@ class InCache {
   explicit InCache(MessageFormat<M> const* format);
   virtual void _set(PregelShard shard, PregelKey const& vertexId,
                     M const& data) = 0;
+  /// Prepares a parsed batch of messages for one shard, before the lock
+  /// for the shard is taken. DOES NOT LOCK
+  virtual void _combineBatch(std::vector<std::pair<PregelKey, M>>&) const {}
 
  public:
   virtual ~InCache() {}
@@ -126,6 +129,8 @@ class CombiningInCache : public InCache<M> {
  protected:
   void _set(PregelShard shard, PregelKey const& vertexId,
             M const& data) override;
+  void _combineBatch(
+      std::vector<std::pair<PregelKey, M>>& batch) const override;
 
  public:
   CombiningInCache(WorkerConfig const* config, MessageFormat<M> const* format,
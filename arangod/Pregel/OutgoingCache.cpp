@@ -31,6 +31,7 @@
 #include "Cluster/ClusterComm.h"
 #include "Cluster/ServerState.h"
 #include "VocBase/LogicalCollection.h"
+#include "VocBase/ticks.h"
 
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
@@ -44,6 +45,64 @@ OutCache<M>::OutCache(WorkerConfig* state, MessageFormat<M> const* format)
   _baseUrl = Utils::baseUrl(_config->database(), Utils::workerPrefix);
 }
 
+template <typename M>
+OutCache<M>::~OutCache() {
+  if (_pendingRequests > 0) {
+    auto cc = ClusterComm::instance();
+    if (cc != nullptr) {
+      cc->drop("", _pendingTransaction, 0, "");
+    }
+  }
+}
+
+template <typename M>
+void OutCache<M>::_sendRequests(std::vector<ClusterCommRequest> const& requests,
+                                double timeout) {
+  waitForSends();
+  if (requests.empty()) {
+    return;
+  }
+  auto cc = ClusterComm::instance();
+  if (cc == nullptr) {
+    // nullptr happens only during controlled shutdown
+    return;
+  }
+
+  std::unordered_map<std::string, std::string> headers;
+  headers[StaticStrings::ContentTypeHeader] = StaticStrings::MimeTypeVPack;
+  _pendingTransaction = TRI_NewTickServer();
+  for (auto const& req : requests) {
+    cc->asyncRequest("", _pendingTransaction, req.destination, req.requestType,
+                     req.path, req.getBodyShared(), headers, nullptr, timeout,
+                     true);
+    _pendingRequests++;
+  }
+}
+
+template <typename M>
+void OutCache<M>::waitForSends() {
+  if (_pendingRequests == 0) {
+    return;
+  }
+  auto cc = ClusterComm::instance();
+  if (cc == nullptr) {
+    _pendingRequests = 0;
+    return;
+  }
+  for (; _pendingRequests > 0; _pendingRequests--) {
+    auto res = cc->wait("", _pendingTransaction, 0, "", 0.0);
+    if (res.status != CL_COMM_RECEIVED) {
+      LOG_TOPIC(ERR, Logger::PREGEL)
+          << "Error sending messages to " << res.shardID << ": "
+          << res.stringifyErrorMessage();
+    } else if (res.answer_code != rest::ResponseCode::OK) {
+      LOG_TOPIC(ERR, Logger::PREGEL)
+          << "Error sending messages to " << res.shardID
+          << ". Payload: " << res.answer->payload().toJson();
+    }
+  }
+}
+
 // ================= ArrayOutCache ==================
 
 template <typename M>
@@ -126,15 +185,12 @@ void ArrayOutCache<M>::flushMessages() {
     data.close();
     // add a request
     ShardID const& shardId = this->_config->globalShardIDs()[shard];
-    auto body = std::make_shared<std::string>(data.toJson());
+    auto body = std::make_shared<std::string>(
+        data.slice().startAs<char>(), data.slice().byteSize());
     requests.emplace_back("shard:" + shardId, rest::RequestType::POST,
                           this->_baseUrl + Utils::messagesPath, body);
   }
-  size_t nrDone = 0;
-  ClusterComm::instance()->performRequests(requests, 120, nrDone,
-                                           LogTopic("Pregel message transfer"),
-                                           false);
-  Utils::printResponses(requests);
+  this->_sendRequests(requests, 120.0);
   this->_removeContainedMessages();
 }
 
@@ -228,14 +284,12 @@ void CombiningOutCache<M>::flushMessages() {
     data.close();
     // add a request
     ShardID const& shardId = this->_config->globalShardIDs()[shard];
-    auto body = std::make_shared<std::string>(data.toJson());
+    auto body = std::make_shared<std::string>(
+        data.slice().startAs<char>(), data.slice().byteSize());
     requests.emplace_back("shard:" + shardId, rest::RequestType::POST,
                           this->_baseUrl + Utils::messagesPath, body);
   }
-  size_t nrDone = 0;
-  ClusterComm::instance()->performRequests(requests, 180, nrDone,
-                                           LogTopic("Pregel"), false);
-  Utils::printResponses(requests);
+  this->_sendRequests(requests, 180.0);
   _removeContainedMessages();
 }
 
@@ -24,6 +24,7 @@
 #define ARANGODB_OUT_MESSAGE_CACHE_H 1
 
 #include "Basics/Common.h"
+#include "Cluster/ClusterComm.h"
 #include "Cluster/ClusterInfo.h"
 #include "VocBase/voc-types.h"
 
@@ -67,9 +68,19 @@ class OutCache {
   size_t _sendCountNextGSS = 0;
   virtual void _removeContainedMessages() = 0;
 
+  /// @brief the batch of requests which is still in flight. at most one
+  /// batch is sent while the next one is filled
+  CoordTransactionID _pendingTransaction = 0;
+  size_t _pendingRequests = 0;
+
+  /// @brief waits for the previous batch, then sends the bodies (VelocyPack)
+  /// without waiting for the answers
+  void _sendRequests(std::vector<ClusterCommRequest> const& requests,
+                     double timeout);
+
  public:
   OutCache(WorkerConfig* state, MessageFormat<M> const* format);
-  virtual ~OutCache() {}
+  virtual ~OutCache();
 
   size_t sendCount() const { return _sendCount; }
   size_t sendCountNextGSS() const { return _sendCountNextGSS; }
@@ -95,6 +106,10 @@ class OutCache {
   virtual void appendMessage(PregelShard shard, PregelKey const& key,
                              M const& data) = 0;
   virtual void flushMessages() = 0;
+
+  /// @brief waits for the answers to all messages sent to other shards.
+  /// call after the last flushMessages of a superstep
+  void waitForSends();
 };
 
 template <typename M>
@@ -90,7 +90,31 @@ struct StatsManager {
     VPackSlice sender = data.get(Utils::senderKey);
     if (sender.isString()) {
       _serverStats[sender.copyString()].accumulate(data);
+      VPackSlice runtime = data.get(Utils::superstepRuntimeKey);
+      if (runtime.isNumber()) {
+        _stepRuntimes[sender.copyString()] += runtime.getNumber<double>();
+      }
+    }
+  }
+
+  /// Ends the runtime tracking of a global superstep. The workers which
+  /// finished early waited at the barrier for the slowest one
+  void finishSuperstep() {
+    double slowest = 0;
+    for (auto const& pair : _stepRuntimes) {
+      if (pair.second >= slowest) {
+        slowest = pair.second;
+        _slowestWorker = pair.first;
+      }
+    }
+    for (auto const& pair : _stepRuntimes) {
+      WorkerRuntimes& runtimes = _workerRuntimes[pair.first];
+      runtimes.last = pair.second;
+      runtimes.total += pair.second;
+      runtimes.barrierWait += slowest - pair.second;
+      _barrierWaitSecs += slowest - pair.second;
     }
+    _stepRuntimes.clear();
   }
 
   void serializeValues(VPackBuilder& b) const {
@@ -99,6 +123,20 @@ struct StatsManager {
       stats.accumulate(pair.second);
     }
     stats.serializeValues(b);
+
+    b.add("barrierWaitTime", VPackValue(_barrierWaitSecs));
+    if (!_slowestWorker.empty()) {
+      b.add("slowestWorker", VPackValue(_slowestWorker));
+    }
+    b.add("workers", VPackValue(VPackValueType::Object));
+    for (auto const& pair : _workerRuntimes) {
+      b.add(pair.first, VPackValue(VPackValueType::Object));
+      b.add("lastSuperstepRuntime", VPackValue(pair.second.last));
+      b.add("totalRuntime", VPackValue(pair.second.total));
+      b.add("barrierWaitTime", VPackValue(pair.second.barrierWait));
+      b.close();
+    }
+    b.close();
   }
 
   /// Test if all messages were processed
@@ -137,13 +175,29 @@ struct StatsManager {
     }
   }
 
-  void reset() { _serverStats.clear(); }
+  void reset() {
+    _serverStats.clear();
+    _stepRuntimes.clear();
+  }
 
   size_t clientCount() const { return _serverStats.size(); }
 
  private:
+  struct WorkerRuntimes {
+    double last = 0;
+    double total = 0;
+    double barrierWait = 0;
+  };
+
   std::map<std::string, uint64_t> _activeStats;
   std::map<std::string, MessageStats> _serverStats;
+  /// runtimes of the workers in the current global superstep, in the
+  /// async mode summed over its local supersteps
+  std::map<std::string, double> _stepRuntimes;
+  std::map<std::string, WorkerRuntimes> _workerRuntimes;
+  std::string _slowestWorker;
+  /// time that all workers together spent waiting for slower ones
+  double _barrierWaitSecs = 0;
 };
 }
 }
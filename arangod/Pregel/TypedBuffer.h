@@ -34,6 +34,7 @@
 
 #ifdef __linux__
 #include <sys/mman.h>
+#include <unistd.h>
 #endif
 
 namespace arangodb {
@@ -66,6 +67,9 @@ struct TypedBuffer {
   /// of the page size
   virtual void resize(size_t newSize) = 0;
 
+  /// hint that the buffer is going to be read from front to back
+  virtual void sequentialAccess() {}
+
  private:
   /// don't copy object
   TypedBuffer(const TypedBuffer&) = delete;
@@ -111,8 +115,24 @@ class VectorTypedBuffer : public TypedBuffer<T> {
 template <typename T>
 class MappedFileBuffer : public TypedBuffer<T> {
  public:
+  /// @param physical map a temporary file instead of an anonymous region.
+  /// the kernel can write back and evict the pages of a file mapping, so
+  /// the buffer may be larger than the available memory
+  explicit MappedFileBuffer(size_t entries, bool physical = false)
+      : _size(entries) {
+    _mappedSize = sizeof(T) * entries;
 #ifdef TRI_HAVE_ANONYMOUS_MMAP
-  explicit MappedFileBuffer(size_t entries) : _size(entries) {
+    if (!physical) {
+      mapAnonymous();
+      return;
+    }
+#endif
+    mapFile();
+  }
+
+ private:
+#ifdef TRI_HAVE_ANONYMOUS_MMAP
+  void mapAnonymous() {
 #ifdef TRI_MMAP_ANONYMOUS
     // fd -1 is required for "real" anonymous regions
     _fd = -1;
@@ -128,7 +148,6 @@ class MappedFileBuffer : public TypedBuffer<T> {
 #endif
 
     // memory map the data
-    _mappedSize = sizeof(T) * entries;
     void* ptr;
     int res = TRI_MMFile(nullptr, _mappedSize, PROT_WRITE | PROT_READ, flags,
                          _fd, &_mmHandle, 0, &ptr);
@@ -152,52 +171,54 @@ class MappedFileBuffer : public TypedBuffer<T> {
       THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
     }
     this->_ptr = (T*)ptr;
-    // return new TypedBuffer(StaticStrings::Empty, fd, mmHandle, initialSize,
-    // ptr);
   }
-#else
-  explicit MappedFileBuffer(size_t entries) : _size(entries) {
-    double tt = TRI_microtime();
-    std::string file = "pregel_" + std::to_string((uint64_t)tt) + ".mmap";
-    std::string filename = FileUtils::buildFilename(TRI_GetTempPath(), file);
+#endif
 
-    _mappedSize = sizeof(T) * _size;
-    _fd = TRI_CreateDatafile(filename, _mappedSize);
+  void mapFile() {
+    long systemError;
+    std::string errorMessage;
+    int res = TRI_GetTempName("pregel", _filename, false, systemError,
+                              errorMessage);
+    if (res != TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(
+          res, "cannot create temporary file for pregel: " + errorMessage);
+    }
+
+    _fd = TRI_CreateDatafile(_filename, _mappedSize);
     if (_fd < 0) {
+      _filename.clear();
       THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
     }
 
-    // memory map the data
+    // memory map the data. the mapping is not populated, the buffer is
+    // meant to be larger than the memory
     void* data;
-    int flags = MAP_SHARED;
-#ifdef __linux__
-    // try populating the mapping already
-    flags |= MAP_POPULATE;
-#endif
-    int res = TRI_MMFile(0, _mappedSize, PROT_WRITE | PROT_READ, flags, _fd,
-                         &_mmHandle, 0, &data);
+    res = TRI_MMFile(0, _mappedSize, PROT_WRITE | PROT_READ, MAP_SHARED, _fd,
+                     &_mmHandle, 0, &data);
 
     if (res != TRI_ERROR_NO_ERROR) {
       TRI_set_errno(res);
-      TRI_TRACKED_CLOSE_FILE(fd);
+      TRI_TRACKED_CLOSE_FILE(_fd);
+      _fd = -1;
 
       // remove empty file
-      TRI_UnlinkFile(filename.c_str());
+      TRI_UnlinkFile(_filename.c_str());
 
       LOG_TOPIC(ERR, arangodb::Logger::FIXME) << "cannot memory map file '"
-                                              << filename << "': '"
+                                              << _filename << "': '"
                                               << TRI_errno_string(res) << "'";
       LOG_TOPIC(ERR, arangodb::Logger::FIXME)
           << "The database directory might reside on a shared folder "
              "(VirtualBox, VMWare) or an NFS-mounted volume which does not "
              "allow memory mapped files.";
+      _filename.clear();
       THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
     }
 
     this->_ptr = (T*)data;
   }
-#endif
 
+ public:
   /// close file (see close() )
   ~MappedFileBuffer() { close(); }
 
@@ -205,7 +226,7 @@ class MappedFileBuffer : public TypedBuffer<T> {
   /// anonymous mapped region (false)
   inline bool isPhysical() const { return !_filename.empty(); }
 
-  void sequentialAccess() {
+  void sequentialAccess() override {
     TRI_MMFileAdvise(this->_ptr, _mappedSize, TRI_MADVISE_SEQUENTIAL);
   }
 
@@ -241,6 +262,13 @@ class MappedFileBuffer : public TypedBuffer<T> {
             << "unable to close pregel mapped file '" << _filename
             << "': " << res;
       }
+      res = TRI_UnlinkFile(_filename.c_str());
+      if (res != TRI_ERROR_NO_ERROR) {
+        LOG_TOPIC(WARN, arangodb::Logger::FIXME)
+            << "unable to remove pregel mapped file '" << _filename
+            << "': " << res;
+      }
+      _filename.clear();
     }
 
     this->_ptr = nullptr;
@@ -268,6 +296,13 @@ class MappedFileBuffer : public TypedBuffer<T> {
 
 #ifdef __linux__
     size_t newMappedSize = sizeof(T) * newSize;
+    if (isPhysical() && newMappedSize > _mappedSize &&
+        ftruncate(_fd, newMappedSize) != 0) {
+      // pages beyond the end of the file cannot be accessed
+      LOG_TOPIC(WARN, Logger::MMAP) << "cannot grow pregel mapped file '"
+                                    << _filename << "'";
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_SYS_ERROR);
+    }
     void* newPtr =
         mremap((void*)this->_ptr, _mappedSize, newMappedSize, MREMAP_MAYMOVE);
     if (newPtr != MAP_FAILED) {  // success
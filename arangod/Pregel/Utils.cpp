@@ -59,6 +59,8 @@ std::string const Utils::globalShardListKey = "globalShardList";
 std::string const Utils::userParametersKey = "userparams";
 std::string const Utils::asyncModeKey = "asyncMode";
 std::string const Utils::lazyLoadingKey = "lazyloading";
+std::string const Utils::useMemoryMapsKey = "useMemoryMaps";
+std::string const Utils::storeBatchSizeKey = "storeBatchSize";
 std::string const Utils::parallelismKey = "parallelism";
 
 std::string const Utils::globalSuperstepKey = "gss";
@@ -73,6 +75,7 @@ std::string const Utils::aggregatorValuesKey = "aggregators";
 std::string const Utils::activeCountKey = "activeCount";
 std::string const Utils::receivedCountKey = "receivedCount";
 std::string const Utils::sendCountKey = "sendCount";
+std::string const Utils::superstepRuntimeKey = "superstepRuntime";
 std::string const Utils::enterNextGSSKey = "nextGSS";
 
 std::string const Utils::compensate = "compensate";
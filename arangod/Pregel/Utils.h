@@ -69,6 +69,8 @@ class Utils {
   static std::string const userParametersKey;
   static std::string const asyncModeKey;
   static std::string const lazyLoadingKey;
+  static std::string const useMemoryMapsKey;
+  static std::string const storeBatchSizeKey;
   static std::string const parallelismKey;
 
   /// Current global superstep
@@ -110,6 +112,10 @@ class Utils {
   /// superstep (bookkeeping)
   static std::string const sendCountKey;
 
+  /// Used to track the time a worker spent on the last
+  /// superstep (bookkeeping)
+  static std::string const superstepRuntimeKey;
+
   /// Used to communicate to enter the next phase
   /// only send by the conductor
   static std::string const enterNextGSSKey;
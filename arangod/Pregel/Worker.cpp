@@ -320,6 +320,7 @@ template <typename V, typename E, typename M>
 void Worker<V, E, M>::_startProcessing() {
   _state = WorkerState::COMPUTING;
   _activeCount = 0;  // active count is only valid after the run
+  _processingStartSecs = TRI_microtime();
   TRI_ASSERT(SchedulerFeature::SCHEDULER != nullptr);
   rest::Scheduler* scheduler = SchedulerFeature::SCHEDULER;
 
@@ -413,6 +414,7 @@ bool Worker<V, E, M>::_processVertices(
   }
   // ==================== send messages to other shards ====================
   outCache->flushMessages();
+  outCache->waitForSends();
   if (TRI_UNLIKELY(!_writeCache)) {  // ~Worker was called
     LOG_TOPIC(WARN, Logger::PREGEL) << "Execution aborted prematurely.";
     return false;
@@ -521,6 +523,9 @@ void Worker<V, E, M>::_finishedProcessing() {
     package.add(Utils::globalSuperstepKey,
                 VPackValue(_config.globalSuperstep()));
     _messageStats.serializeValues(package);
+    // lets the conductor see stragglers
+    package.add(Utils::superstepRuntimeKey,
+                VPackValue(TRI_microtime() - _processingStartSecs));
     if (_config.asynchronousMode()) {
       _workerAggregators->serializeValues(package, true);
     }
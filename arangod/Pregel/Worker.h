@@ -130,6 +130,8 @@ class Worker : public IWorker {
   MessageStats _messageStats;
   /// valid after _finishedProcessing was called
   uint64_t _activeCount = 0;
+  /// start of the processing of the current local superstep
+  double _processingStartSecs = 0;
   /// current number of running threads
   size_t _runningThreads = 0;
   /// During async mode this should keep track of the send messages
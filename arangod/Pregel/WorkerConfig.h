@@ -58,6 +58,10 @@ class WorkerConfig {
 
   inline bool lazyLoading() const { return _lazyLoading; }
 
+  inline bool useMemoryMaps() const { return _useMemoryMaps; }
+
+  inline uint64_t storeBatchSize() const { return _storeBatchSize; }
+
   inline uint64_t parallelism() const { return _parallelism; }
 
   inline std::string const& coordinatorId() const { return _coordinatorId; }
@@ -127,6 +131,10 @@ class WorkerConfig {
   bool _asynchronousMode = false;
   /// load vertices on a lazy basis
   bool _lazyLoading = false;
+  /// keep vertices and edges in memory-mapped temporary files
+  bool _useMemoryMaps = false;
+  /// number of results written back per transaction
+  uint64_t _storeBatchSize = 100000;
 
   uint64_t _parallelism = 1;
 
@@ -24,6 +24,8 @@
 #include "DatabaseInitialSyncer.h"
 
 #include "ApplicationFeatures/ApplicationServer.h"
+#include "Basics/ConditionLocker.h"
+#include "Basics/ConditionVariable.h"
 #include "Basics/Exceptions.h"
 #include "Basics/ReadLocker.h"
 #include "Basics/Result.h"
@@ -58,6 +60,7 @@
 #include <velocypack/velocypack-aliases.h>
 #include <array>
 #include <cstring>
+#include <thread>
 
 namespace {
 
@@ -95,7 +98,10 @@ DatabaseInitialSyncer::DatabaseInitialSyncer(
           [this](std::string const& msg) -> void { setProgress(msg); }),
       _config{_state.applier,    _state.barrier, _batch,
               _state.connection, false,          _state.master,
-              _progress,         _state,         vocbase} {
+              _progress,         _state,         vocbase},
+      _parentSyncer(nullptr),
+      _workerId(0),
+      _maxChunkSize(::MaxChunkSize) {
   _state.vocbases.emplace(std::piecewise_construct,
                           std::forward_as_tuple(vocbase.name()),
                           std::forward_as_tuple(vocbase));
@@ -267,7 +273,11 @@ void DatabaseInitialSyncer::setProgress(std::string const& msg) {
   auto* applier = _config.vocbase.replicationApplier();
 
   if (applier != nullptr) {
-    applier->setProgress(msg);
+    if (_workerId > 0) {
+      applier->setWorkerProgress(_workerId - 1, msg);
+    } else {
+      applier->setProgress(msg);
+    }
   }
 }
 
@@ -693,11 +703,11 @@ Result DatabaseInitialSyncer::fetchCollectionDump(
     }
 
     // increase chunk size for next fetch
-    if (chunkSize < ::MaxChunkSize) {
+    if (chunkSize < _maxChunkSize) {
       chunkSize = static_cast<uint64_t>(chunkSize * 1.25);
 
-      if (chunkSize > ::MaxChunkSize) {
-        chunkSize = ::MaxChunkSize;
+      if (chunkSize > _maxChunkSize) {
+        chunkSize = _maxChunkSize;
       }
     }
 
@@ -1159,6 +1169,8 @@ Result DatabaseInitialSyncer::handleCollection(VPackSlice const& parameters,
         !masterUuid.empty() ? masterUuid : itoa(masterCid);
 
     if (incremental && getSize(col) > 0) {
+      MUTEX_LOCKER(locker, (_parentSyncer != nullptr ? _parentSyncer->_keysLock
+                                                     : _keysLock));
       res = fetchCollectionSync(col, masterColl, _config.master.lastLogTick);
     } else {
       res = fetchCollectionDump(col, masterColl, _config.master.lastLogTick);
@@ -1386,6 +1398,13 @@ Result DatabaseInitialSyncer::iterateCollections(
                        std::to_string(collections.size()) + " collections");
   _config.progress.set(phaseMsg);
 
+  size_t const numWorkers = std::min<size_t>(
+      static_cast<size_t>(_config.applier._initialSyncWorkers),
+      collections.size());
+  if (phase == PHASE_DUMP && numWorkers > 1) {
+    return dumpCollectionsParallel(collections, incremental, numWorkers);
+  }
+
   for (auto const& collection : collections) {
     VPackSlice const parameters = collection.first;
     VPackSlice const indexes = collection.second;
@@ -1401,4 +1420,141 @@ Result DatabaseInitialSyncer::iterateCollections(
   return Result();
 }
 
+/// @brief dump the collections with several worker syncers
+Result DatabaseInitialSyncer::dumpCollectionsParallel(
+    std::vector<std::pair<VPackSlice, VPackSlice>> const& collections,
+    bool incremental, size_t numWorkers) {
+  TRI_ASSERT(numWorkers > 1);
+
+  if (!_config.flushed) {
+    // flush the WAL of the master once, instead of once per worker
+    Result r = sendFlush();
+    if (r.fail()) {
+      return r;
+    }
+  }
+
+  // every worker has its own connection to the master, and together the
+  // dump chunks of the workers do not outgrow those of a single syncer
+  uint64_t const maxChunkSize = std::max<uint64_t>(
+      _config.applier._chunkSize, ::MaxChunkSize / numWorkers);
+
+  std::vector<std::unique_ptr<DatabaseInitialSyncer>> workers;
+  workers.reserve(numWorkers);
+  for (size_t i = 0; i < numWorkers; ++i) {
+    auto worker = std::make_unique<DatabaseInitialSyncer>(_config.vocbase,
+                                                          _config.applier);
+    if (!worker->_config.connection.valid()) {
+      return Result(TRI_ERROR_INTERNAL, "invalid endpoint");
+    }
+    worker->useAsChildSyncer(_config.master, _config.barrier.id,
+                             _config.barrier.updateTime, _config.batch.id,
+                             _config.batch.updateTime);
+    worker->setLeaderId(_state.leaderId);
+    worker->_config.flushed = true;
+    worker->_parentSyncer = this;
+    worker->_workerId = i + 1;
+    worker->_maxChunkSize = maxChunkSize;
+    workers.emplace_back(std::move(worker));
+  }
+
+  auto* applier = _config.vocbase.replicationApplier();
+  if (applier != nullptr) {
+    applier->setWorkers(numWorkers);
+  }
+  TRI_DEFER(if (applier != nullptr) { applier->setWorkers(0); });
+  _config.progress.set("dumping data of " +
+                       std::to_string(collections.size()) +
+                       " collections with " + std::to_string(numWorkers) +
+                       " workers");
+
+  auto abortWorkers = [&workers]() {
+    for (auto& worker : workers) {
+      worker->setAborted(true);
+    }
+  };
+
+  // the workers take the next collection until all are done, or one of
+  // them fails and stops the others
+  std::atomic<size_t> next{0};
+  std::vector<Result> results(numWorkers);
+  basics::ConditionVariable condition;
+  size_t running = numWorkers;
+  std::vector<std::thread> threads;
+  threads.reserve(numWorkers);
+  try {
+    for (size_t i = 0; i < numWorkers; ++i) {
+      threads.emplace_back([&, i]() {
+        DatabaseInitialSyncer& worker = *workers[i];
+        try {
+          while (results[i].ok()) {
+            size_t const pos = next.fetch_add(1);
+            if (pos >= collections.size()) {
+              break;
+            }
+            results[i] = worker.handleCollection(collections[pos].first,
+                                                 collections[pos].second,
+                                                 incremental, PHASE_DUMP);
+          }
+        } catch (basics::Exception const& ex) {
+          results[i].reset(ex.code(), ex.what());
+        } catch (std::bad_alloc const&) {
+          results[i].reset(TRI_ERROR_OUT_OF_MEMORY);
+        } catch (std::exception const& ex) {
+          results[i].reset(TRI_ERROR_INTERNAL, ex.what());
+        }
+        if (results[i].fail()) {
+          abortWorkers();
+        }
+
+        CONDITION_LOCKER(guard, condition);
+        --running;
+        guard.signal();
+      });
+    }
+  } catch (...) {
+    results[threads.size()].reset(TRI_ERROR_INTERNAL,
+                                  "cannot start initial sync worker thread");
+    abortWorkers();
+    CONDITION_LOCKER(guard, condition);
+    running -= numWorkers - threads.size();
+  }
+
+  // the workers do not extend the batch and the barrier themselves
+  while (true) {
+    {
+      CONDITION_LOCKER(guard, condition);
+      if (running == 0) {
+        break;
+      }
+      guard.wait(1000 * 1000);
+      if (running == 0) {
+        break;
+      }
+    }
+
+    if (isAborted()) {
+      abortWorkers();
+    }
+    if (!_config.isChild()) {
+      _config.batch.extend(_config.connection, _config.progress);
+      _config.barrier.extend(_config.connection);
+    }
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // report the error that stopped the workers, not the ones it caused
+  Result res;
+  for (auto const& r : results) {
+    if (r.fail() && (res.ok() || (res.is(TRI_ERROR_REPLICATION_APPLIER_STOPPED) &&
+                                  r.isNot(TRI_ERROR_REPLICATION_APPLIER_STOPPED)))) {
+      res = r;
+    }
+  }
+  return res;
+}
+
 }  // namespace arangodb
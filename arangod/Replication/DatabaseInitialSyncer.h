@@ -24,6 +24,7 @@
 #ifndef ARANGOD_REPLICATION_DATABASE_INITIAL_SYNCER_H
 #define ARANGOD_REPLICATION_DATABASE_INITIAL_SYNCER_H 1
 
+#include "Basics/Mutex.h"
 #include "Basics/Result.h"
 #include "Cluster/ServerState.h"
 #include "Replication/InitialSyncer.h"
@@ -48,7 +49,12 @@ class DatabaseInitialSyncer final : public InitialSyncer {
       DatabaseInitialSyncer& syncer, SingleCollectionTransaction* trx,
       std::string const& keysId, uint64_t chunkId, std::string const& lowString,
       std::string const& highString,
-      std::vector<std::pair<std::string, uint64_t>> const& markers);
+      std::vector<std::pair<std::string, uint64_t>> const& markers,
+      bool isRange);
+  friend ::arangodb::Result syncRangesRocksDB(
+      DatabaseInitialSyncer& syncer, arangodb::LogicalCollection* col,
+      std::string const& keysId, arangodb::velocypack::Slice const& ranges,
+      bool& fallback);
 
  public:
   /// @brief apply phases
@@ -214,8 +220,25 @@ class DatabaseInitialSyncer final : public InitialSyncer {
                             arangodb::velocypack::Slice>> const&,
       bool incremental, SyncPhase);
 
+  /// @brief dump the collections with several worker syncers, which share
+  /// the batch and the barrier of this syncer
+  Result dumpCollectionsParallel(
+      std::vector<std::pair<arangodb::velocypack::Slice,
+                            arangodb::velocypack::Slice>> const&,
+      bool incremental, size_t numWorkers);
+
  private:
   Configuration _config;
+
+  /// @brief the syncer that started this one as a worker, or nullptr
+  DatabaseInitialSyncer* _parentSyncer;
+  /// @brief number of the worker, starting at 1. 0 if not a worker
+  size_t _workerId;
+  /// @brief the keys of an incremental sync are bound to the batch on the
+  /// master, so the workers of a batch have to sync keys one at a time
+  Mutex _keysLock;
+  /// @brief upper bound for the size of dump chunks
+  uint64_t _maxChunkSize;
 };
 
 }  // namespace arangodb
@@ -132,10 +132,15 @@ Result DatabaseTailingSyncer::syncCollectionFinalize(
         "&serverId=" + _state.localServerIdString +
         "&collection=" + StringUtils::urlEncode(collectionName);
 
-    // send request
+    // send request. the markers are applied the same way if the master
+    // replies with JSON
+    std::unordered_map<std::string, std::string> headers;
+    if (!_state.master.simulate32Client()) {
+      headers[StaticStrings::Accept] = StaticStrings::MimeTypeVPack;
+    }
     std::unique_ptr<SimpleHttpResult> response(
         _state.connection.client->request(rest::RequestType::GET, url, nullptr,
-                                          0));
+                                          0, headers));
 
     if (replutils::hasFailed(response.get())) {
       return replutils::buildHttpError(response.get(), url, _state.connection);
@@ -585,6 +585,24 @@ void ReplicationApplier::setProgress(std::string const& msg) {
   setProgressNoLock(msg);
 }
 
+void ReplicationApplier::setWorkers(size_t numWorkers) {
+  WRITE_LOCKER_EVENTUAL(writeLocker, _statusLock);
+  _state._workerProgress.clear();
+  _state._workerProgress.resize(numWorkers);
+}
+
+void ReplicationApplier::setWorkerProgress(size_t worker,
+                                           std::string const& msg) {
+  WRITE_LOCKER_EVENTUAL(writeLocker, _statusLock);
+  if (worker >= _state._workerProgress.size()) {
+    return;
+  }
+
+  auto& progress = _state._workerProgress[worker];
+  progress.message = msg;
+  TRI_GetTimeStampReplication(progress.time, sizeof(progress.time) - 1);
+}
+
 /// @brief register an applier error
 void ReplicationApplier::setErrorNoLock(arangodb::Result const& rr) {
   // log error message
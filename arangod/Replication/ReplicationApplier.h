@@ -153,6 +153,13 @@ class ReplicationApplier {
   void setProgress(char const* msg);
   void setProgress(std::string const& msg);
 
+  /// @brief set the number of workers of a parallel initial sync, and
+  /// reset their progress. 0 removes the worker progress
+  void setWorkers(size_t numWorkers);
+
+  /// @brief set the progress of a worker of a parallel initial sync
+  void setWorkerProgress(size_t worker, std::string const& msg);
+
   virtual std::unique_ptr<InitialSyncer> buildInitialSyncer() const = 0;
   virtual std::unique_ptr<TailingSyncer> buildTailingSyncer(TRI_voc_tick_t initialTick,
                                                       bool useTick, TRI_voc_tick_t barrierId) const = 0;
@@ -51,6 +51,8 @@ ReplicationApplierConfiguration::ReplicationApplierConfiguration()
       _idleMinWaitTime(1000 * 1000),
       _idleMaxWaitTime(5 * 500 * 1000),
       _initialSyncMaxWaitTime(300 * 1000 * 1000),
+      _initialSyncWorkers(1),
+      _applyWorkers(1),
       _autoResyncRetries(2),
       _sslProtocol(0),
       _skipCreateDrop(false),
@@ -81,6 +83,8 @@ void ReplicationApplierConfiguration::reset() {
   _idleMinWaitTime = 1000 * 1000;
   _idleMaxWaitTime = 5 * 500 * 1000;
   _initialSyncMaxWaitTime = 300 * 1000 * 1000;
+  _initialSyncWorkers = 1;
+  _applyWorkers = 1;
   _autoResyncRetries = 2;
   _sslProtocol = 0;
   _skipCreateDrop = false;
@@ -148,6 +152,8 @@ void ReplicationApplierConfiguration::toVelocyPack(VPackBuilder& builder, bool i
   builder.add("initialSyncMaxWaitTime",
               VPackValue(static_cast<double>(_initialSyncMaxWaitTime) /
                          (1000.0 * 1000.0)));
+  builder.add("initialSyncWorkers", VPackValue(_initialSyncWorkers));
+  builder.add("applyWorkers", VPackValue(_applyWorkers));
   builder.add(
       "idleMinWaitTime",
       VPackValue(static_cast<double>(_idleMinWaitTime) / (1000.0 * 1000.0)));
@@ -322,6 +328,19 @@ ReplicationApplierConfiguration ReplicationApplierConfiguration::fromVelocyPack(
     }
   }
 
+  value = slice.get("initialSyncWorkers");
+  if (value.isNumber()) {
+    // every worker uses its own connection to the master
+    configuration._initialSyncWorkers = std::min<uint64_t>(
+        std::max<uint64_t>(value.getNumber<uint64_t>(), 1), 64);
+  }
+
+  value = slice.get("applyWorkers");
+  if (value.isNumber()) {
+    configuration._applyWorkers = std::min<uint64_t>(
+        std::max<uint64_t>(value.getNumber<uint64_t>(), 1), 64);
+  }
+
   value = slice.get("idleMinWaitTime");
   if (value.isNumber()) {
     double v = value.getNumber<double>();
@@ -50,6 +50,8 @@ class ReplicationApplierConfiguration {
   uint64_t _idleMinWaitTime; 
   uint64_t _idleMaxWaitTime;
   uint64_t _initialSyncMaxWaitTime;
+  uint64_t _initialSyncWorkers;
+  uint64_t _applyWorkers;
   uint64_t _autoResyncRetries;
   uint32_t _sslProtocol;
   bool _skipCreateDrop;
@@ -61,6 +61,7 @@ ReplicationApplierState& ReplicationApplierState::operator=(ReplicationApplierSt
   _serverId = other._serverId;
   _progressMsg = other._progressMsg;
   memcpy(&_progressTime[0], &other._progressTime[0], sizeof(_progressTime));
+  _workerProgress = other._workerProgress;
 
   _lastError.code = other._lastError.code;
   _lastError.message = other._lastError.message;
@@ -85,6 +86,7 @@ void ReplicationApplierState::reset(bool resetState) {
   _stopInitialSynchronization = false;
   _progressMsg.clear();
   _progressTime[0] = '\0';
+  _workerProgress.clear();
   _serverId = 0;
   _lastError.reset();
       
@@ -156,6 +158,18 @@ void ReplicationApplierState::toVelocyPack(VPackBuilder& result, bool full) cons
       result.add("message", VPackValue(_progressMsg));
     }
     result.add("failedConnects", VPackValue(_failedConnects));
+    if (!_workerProgress.empty()) {
+      result.add("workers", VPackValue(VPackValueType::Array));
+      for (auto const& it : _workerProgress) {
+        result.openObject();
+        result.add("time", VPackValue(it.time));
+        if (!it.message.empty()) {
+          result.add("message", VPackValue(it.message));
+        }
+        result.close();
+      }
+      result.close(); // workers
+    }
     result.close(); // progress
 
     result.add("totalRequests", VPackValue(_totalRequests));
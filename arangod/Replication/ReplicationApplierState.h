@@ -66,6 +66,15 @@ struct ReplicationApplierState {
   
   std::string _progressMsg;
   char _progressTime[24];
+
+  /// progress of the workers of a parallel initial sync
+  struct WorkerProgress {
+    WorkerProgress() : message() { time[0] = '\0'; }
+
+    std::string message;
+    char time[24];
+  };
+  std::vector<WorkerProgress> _workerProgress;
   TRI_server_id_t _serverId;
   
   /// performs inital sync or running tailing syncer
@@ -53,8 +53,11 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/Parser.h>
 #include <velocypack/Slice.h>
+#include <velocypack/Validator.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <thread>
+
 using namespace arangodb;
 using namespace arangodb::basics;
 using namespace arangodb::httpclient;
@@ -303,6 +306,15 @@ Result TailingSyncer::processDocument(TRI_replication_operation_e type,
     return Result(TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND);
   }
 
+  return processDocument(type, slice, *vocbase, coll, _documentBuilder);
+}
+
+/// @brief process a document operation of an already resolved collection
+Result TailingSyncer::processDocument(TRI_replication_operation_e type,
+                                      VPackSlice const& slice,
+                                      TRI_vocbase_t& vocbase,
+                                      LogicalCollection* coll,
+                                      VPackBuilder& documentBuilder) {
   bool isSystem = coll->system();
 
   // extract "data"
@@ -343,15 +355,15 @@ Result TailingSyncer::processDocument(TRI_replication_operation_e type,
   // in case this is a removal we need to build our marker
   VPackSlice applySlice = data;
   if (type == REPLICATION_MARKER_REMOVE) {
-    _documentBuilder.clear();
-    _documentBuilder.openObject();
-    _documentBuilder.add(StaticStrings::KeyString, key);
+    documentBuilder.clear();
+    documentBuilder.openObject();
+    documentBuilder.add(StaticStrings::KeyString, key);
     if (rev.isString()) {
       // _rev is an optional attribute
-      _documentBuilder.add(StaticStrings::RevString, rev);
+      documentBuilder.add(StaticStrings::RevString, rev);
     }
-    _documentBuilder.close();
-    applySlice = _documentBuilder.slice();
+    documentBuilder.close();
+    applySlice = documentBuilder.slice();
   }
 
   if (tid > 0) {  // part of a transaction
@@ -390,7 +402,7 @@ Result TailingSyncer::processDocument(TRI_replication_operation_e type,
   // standalone operation
   // update the apply tick for all standalone operations
   SingleCollectionTransaction trx(
-    transaction::StandaloneContext::Create(*vocbase),
+    transaction::StandaloneContext::Create(vocbase),
     coll,
     AccessMode::Type::EXCLUSIVE
   );
@@ -672,17 +684,58 @@ Result TailingSyncer::changeCollection(VPackSlice const& slice) {
   return guard.collection()->updateProperties(data, doSync);
 }
 
-/// @brief apply a single marker from the continuous log
-Result TailingSyncer::applyLogMarker(VPackSlice const& slice,
-                                     TRI_voc_tick_t firstRegularTick) {
+/// @brief truncates a collection, based on the VelocyPack provided
+Result TailingSyncer::truncateCollection(VPackSlice const& slice) {
   if (!slice.isObject()) {
     return Result(TRI_ERROR_REPLICATION_INVALID_RESPONSE,
-                  "marker slice is no object");
+                  "collection slice is no object");
   }
 
-  // fetch marker "type"
-  int typeValue = VelocyPackHelper::getNumericValue<int>(slice, "type", 0);
+  TRI_vocbase_t* vocbase = resolveVocbase(slice);
+
+  if (vocbase == nullptr) {
+    return Result(TRI_ERROR_ARANGO_DATABASE_NOT_FOUND);
+  }
+
+  auto col = resolveCollection(*vocbase, slice);
+
+  if (col == nullptr) {
+    return Result(TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND);
+  }
+
+  SingleCollectionTransaction trx(
+    transaction::StandaloneContext::Create(*vocbase),
+    col.get(),
+    AccessMode::Type::EXCLUSIVE
+  );
+  trx.addHint(transaction::Hints::Hint::ALLOW_RANGE_DELETE);
+  Result res = trx.begin();
+
+  if (!res.ok()) {
+    return res;
+  }
+
+  OperationOptions options;
+
+  if (!_state.leaderId.empty()) {
+    options.isSynchronousReplicationFrom = _state.leaderId;
+  }
+
+  OperationResult opRes = trx.truncate(col->name(), options);
+
+  if (opRes.fail()) {
+    return Result(opRes.errorNumber(),
+                  std::string("unable to truncate collection '") +
+                      col->name() +
+                      "': " + TRI_errno_string(opRes.errorNumber()));
+  }
 
+  return trx.finish(opRes.result);
+}
+
+/// @brief update the last processed tick with the tick of a marker
+void TailingSyncer::updateProcessedTick(VPackSlice const& slice,
+                                        TRI_voc_tick_t firstRegularTick) {
   // fetch "tick"
   std::string const tick = VelocyPackHelper::getStringValue(slice, "tick", "");
 
@@ -696,6 +749,20 @@ Result TailingSyncer::applyLogMarker(VPackSlice const& slice,
       }
     }
   }
+}
+
+/// @brief apply a single marker from the continuous log
+Result TailingSyncer::applyLogMarker(VPackSlice const& slice,
+                                     TRI_voc_tick_t firstRegularTick) {
+  if (!slice.isObject()) {
+    return Result(TRI_ERROR_REPLICATION_INVALID_RESPONSE,
+                  "marker slice is no object");
+  }
+
+  // fetch marker "type"
+  int typeValue = VelocyPackHelper::getNumericValue<int>(slice, "type", 0);
+
+  updateProcessedTick(slice, firstRegularTick);
 
   // handle marker type
   TRI_replication_operation_e type = (TRI_replication_operation_e)typeValue;
@@ -758,6 +825,8 @@ Result TailingSyncer::applyLogMarker(VPackSlice const& slice,
     return renameCollection(slice);
   } else if (type == REPLICATION_COLLECTION_CHANGE) {
     return changeCollection(slice);
+  } else if (type == REPLICATION_COLLECTION_TRUNCATE) {
+    return truncateCollection(slice);
   }
 
   else if (type == REPLICATION_INDEX_CREATE) {
@@ -808,43 +877,80 @@ Result TailingSyncer::applyLog(SimpleHttpResult* response,
   char const* p = data.begin();
   char const* end = p + data.length();
 
+  // masters that support it send the markers as VelocyPack, one after the
+  // other
+  bool found = false;
+  std::string const cType =
+      response->getHeaderField(StaticStrings::ContentTypeHeader, found);
+  bool const isVPack = found && (cType == StaticStrings::MimeTypeVPack);
+
+  VPackOptions options;
+  options.unsupportedTypeBehavior = VPackOptions::FailOnUnsupportedType;
+  VPackValidator validator(&options);
+
   // buffer must end with a NUL byte
-  TRI_ASSERT(*end == '\0');
+  TRI_ASSERT(isVPack || *end == '\0');
 
   // TODO: re-use a builder!
   auto builder = std::make_shared<VPackBuilder>();
 
+  // standalone document markers are collected and applied with one queue
+  // per collection. all other markers are barriers that wait until the
+  // pending markers are applied
+  bool const parallel = (_state.applier._applyWorkers > 1);
+  std::vector<PendingMarker> pending;
+
   while (p < end) {
-    char const* q = strchr(p, '\n');
+    VPackSlice slice;
 
-    if (q == nullptr) {
-      q = end;
-    }
+    if (isVPack) {
+      try {
+        // throws if the data is invalid
+        validator.validate(p, static_cast<size_t>(end - p),
+                           /*isSubPart*/ true);
+      } catch (velocypack::Exception const& ex) {
+        return Result(TRI_ERROR_REPLICATION_INVALID_RESPONSE,
+                      std::string("received invalid VelocyPack data: ") +
+                          ex.what());
+      }
 
-    char const* lineStart = p;
-    size_t const lineLength = q - p;
+      processedMarkers++;
 
-    if (lineLength < 2) {
-      // we are done
-      return Result();
-    }
+      slice = VPackSlice(p);
+      p += slice.byteSize();
+    } else {
+      char const* q = strchr(p, '\n');
 
-    TRI_ASSERT(q <= end);
+      if (q == nullptr) {
+        q = end;
+      }
 
-    processedMarkers++;
+      if (q - p < 2) {
+        // we are done
+        break;
+      }
 
-    builder->clear();
-    try {
-      VPackParser parser(builder);
-      parser.parse(p, static_cast<size_t>(q - p));
-    } catch (...) {
-      // TODO: improve error reporting
-      return Result(TRI_ERROR_OUT_OF_MEMORY);
-    }
+      TRI_ASSERT(q <= end);
 
-    p = q + 1;
+      processedMarkers++;
 
-    VPackSlice const slice = builder->slice();
+      if (parallel) {
+        // pending markers still reference the previous builder
+        builder = std::make_shared<VPackBuilder>();
+      }
+      builder->clear();
+      try {
+        VPackParser parser(builder);
+        parser.parse(p, static_cast<size_t>(q - p));
+      } catch (...) {
+        // TODO: improve error reporting
+        return Result(TRI_ERROR_OUT_OF_MEMORY);
+      }
+
+      p = q + 1;
+
+      slice = builder->slice();
+    }
 
     if (!slice.isObject()) {
       return Result(TRI_ERROR_REPLICATION_INVALID_RESPONSE,
@@ -852,38 +958,37 @@ Result TailingSyncer::applyLog(SimpleHttpResult* response,
     }
 
     Result res;
-    bool skipped;
+    bool skipped = skipMarker(firstRegularTick, slice);
+
+    if (parallel && !skipped) {
+      PendingMarker marker;
+      if (preparePendingMarker(slice, marker)) {
+        updateProcessedTick(slice, firstRegularTick);
+        if (!isVPack) {
+          marker.builder = builder;
+        }
+        pending.emplace_back(std::move(marker));
+        continue;
+      }
+    }
+
+    if (!pending.empty()) {
+      res = applyPendingMarkers(pending, ignoreCount);
+      if (res.fail()) {
+        return res;
+      }
+    }
 
-    if (skipMarker(firstRegularTick, slice)) {
+    if (skipped) {
       // entry is skipped
       res.reset();
-      skipped = true;
     } else {
       res = applyLogMarker(slice, firstRegularTick);
-      skipped = false;
     }
 
+    res = handleApplyResult(std::move(res), slice, ignoreCount);
     if (res.fail()) {
-      // apply error
-      std::string errorMsg = res.errorMessage();
-
-      if (ignoreCount == 0) {
-        if (lineLength > 1024) {
-          errorMsg +=
-              ", offending marker: " + std::string(lineStart, 1024) + "...";
-        } else {
-          errorMsg +=
-              ", offending marker: " + std::string(lineStart, lineLength);
-        }
-
-        res.reset(res.errorNumber(), errorMsg);
-        return res;
-      }
-
-      ignoreCount--;
-      LOG_TOPIC(WARN, Logger::REPLICATION)
-          << "ignoring replication error for database '" << _state.databaseName
-          << "': " << errorMsg;
+      return res;
     }
 
     // update tick value
@@ -905,9 +1010,165 @@ Result TailingSyncer::applyLog(SimpleHttpResult* response,
   }
 
   // reached the end
+  if (!pending.empty()) {
+    return applyPendingMarkers(pending, ignoreCount);
+  }
   return Result();
 }
 
+/// @brief check the result of applying a marker
+Result TailingSyncer::handleApplyResult(Result res, VPackSlice const& slice,
+                                        uint64_t& ignoreCount) {
+  if (res.fail()) {
+    // apply error
+    std::string errorMsg = res.errorMessage();
+
+    if (ignoreCount == 0) {
+      std::string const marker = slice.toJson();
+      if (marker.size() > 1024) {
+        errorMsg +=
+            ", offending marker: " + marker.substr(0, 1024) + "...";
+      } else {
+        errorMsg += ", offending marker: " + marker;
+      }
+
+      res.reset(res.errorNumber(), errorMsg);
+      return res;
+    }
+
+    ignoreCount--;
+    LOG_TOPIC(WARN, Logger::REPLICATION)
+        << "ignoring replication error for database '" << _state.databaseName
+        << "': " << errorMsg;
+    res.reset();
+  }
+  return res;
+}
+
+/// @brief resolve a marker that can be applied in parallel
+bool TailingSyncer::preparePendingMarker(VPackSlice const& slice,
+                                         PendingMarker& marker) {
+  // operations of transactions are applied in order, and a standalone
+  // operation must not wait for the locks of an ongoing transaction
+  if (!_ongoingTransactions.empty()) {
+    return false;
+  }
+
+  int typeValue = VelocyPackHelper::getNumericValue<int>(slice, "type", 0);
+  marker.type = static_cast<TRI_replication_operation_e>(typeValue);
+  if (marker.type != REPLICATION_MARKER_DOCUMENT &&
+      marker.type != REPLICATION_MARKER_REMOVE) {
+    return false;
+  }
+
+  VPackSlice const tid = slice.get("tid");
+  if (tid.isString() && tid.getStringLength() > 0 &&
+      !(tid.getStringLength() == 1 && tid.copyString() == "0")) {
+    return false;
+  }
+
+  // errors are reported by the serial code path
+  marker.vocbase = resolveVocbase(slice);
+  if (marker.vocbase == nullptr) {
+    return false;
+  }
+  marker.collection = resolveCollection(*marker.vocbase, slice);
+  if (marker.collection == nullptr ||
+      marker.collection->name() == TRI_COL_NAME_USERS) {
+    return false;
+  }
+
+  marker.slice = slice;
+  return true;
+}
+
+/// @brief apply the pending markers, with one queue per collection
+Result TailingSyncer::applyPendingMarkers(std::vector<PendingMarker>& pending,
+                                          uint64_t& ignoreCount) {
+  TRI_ASSERT(!pending.empty());
+
+  // markers of the same collection are applied in order, the queues of
+  // different collections are independent of each other
+  std::unordered_map<LogicalCollection*, size_t> queueIds;
+  std::vector<std::vector<size_t>> queues;
+  for (size_t i = 0; i < pending.size(); ++i) {
+    auto it = queueIds.emplace(pending[i].collection.get(), queues.size());
+    if (it.second) {
+      queues.emplace_back();
+    }
+    queues[it.first->second].emplace_back(i);
+  }
+
+  std::vector<Result> results(pending.size());
+  std::atomic<size_t> next{0};
+  auto work = [&]() {
+    VPackBuilder documentBuilder;
+    size_t queue;
+    while ((queue = next.fetch_add(1)) < queues.size()) {
+      for (size_t i : queues[queue]) {
+        PendingMarker const& marker = pending[i];
+        try {
+          results[i] = processDocument(marker.type, marker.slice,
+                                       *marker.vocbase,
+                                       marker.collection.get(),
+                                       documentBuilder);
+        } catch (basics::Exception const& ex) {
+          results[i].reset(ex.code(), ex.what());
+        } catch (std::exception const& ex) {
+          results[i].reset(TRI_ERROR_INTERNAL, ex.what());
+        } catch (...) {
+          results[i].reset(TRI_ERROR_INTERNAL,
+                           "unknown exception in processDocument");
+        }
+      }
+    }
+  };
+
+  // this thread applies queues as well
+  size_t const numThreads =
+      std::min<size_t>(static_cast<size_t>(_state.applier._applyWorkers),
+                       queues.size()) - 1;
+  std::vector<std::thread> threads;
+  threads.reserve(numThreads);
+  try {
+    for (size_t i = 0; i < numThreads; ++i) {
+      threads.emplace_back(work);
+    }
+  } catch (...) {
+    // the remaining threads take over the queues
+  }
+  work();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // report errors in the order of the markers
+  Result res;
+  for (size_t i = 0; i < pending.size() && res.ok(); ++i) {
+    res = handleApplyResult(std::move(results[i]), pending[i].slice,
+                            ignoreCount);
+  }
+  pending.clear();
+  if (res.fail()) {
+    return res;
+  }
+
+  WRITE_LOCKER_EVENTUAL(writeLocker, _applier->_statusLock);
+
+  if (_applier->_state._lastProcessedContinuousTick >
+      _applier->_state._lastAppliedContinuousTick) {
+    _applier->_state._lastAppliedContinuousTick =
+        _applier->_state._lastProcessedContinuousTick;
+  }
+
+  if (_ongoingTransactions.empty()) {
+    _applier->_state._safeResumeTick =
+        _applier->_state._lastProcessedContinuousTick;
+  }
+
+  return res;
+}
+
 /// @brief run method, performs continuous synchronization
 /// catches exceptions
 Result TailingSyncer::run() {
@@ -1518,8 +1779,15 @@ Result TailingSyncer::followMasterLog(TRI_voc_tick_t& fetchTick,
     body.append("[]");
   }
 
+  // ask for the markers as VelocyPack, which saves converting them to JSON
+  // and back. masters that do not support it reply with JSON anyway
+  std::unordered_map<std::string, std::string> headers;
+  if (!_state.master.simulate32Client()) {
+    headers[StaticStrings::Accept] = StaticStrings::MimeTypeVPack;
+  }
+
   std::unique_ptr<SimpleHttpResult> response(_state.connection.client->request(
-      rest::RequestType::PUT, url, body.c_str(), body.size()));
+      rest::RequestType::PUT, url, body.c_str(), body.size(), headers));
 
   if (replutils::hasFailed(response.get())) {
     return replutils::buildHttpError(response.get(), url, _state.connection);
@@ -30,6 +30,7 @@
 #include "Replication/Syncer.h"
 
 #include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
 
 struct TRI_vocbase_t;
 
@@ -42,10 +43,6 @@ namespace httpclient {
 class SimpleHttpResult;
 }
 
-namespace velocypack {
-class Slice;
-}
-
 class TailingSyncer : public Syncer {
  public:
   TailingSyncer(ReplicationApplier* applier,
@@ -94,6 +91,12 @@ class TailingSyncer : public Syncer {
   Result processDocument(TRI_replication_operation_e,
                          arangodb::velocypack::Slice const&);
 
+  /// @brief process a document operation of an already resolved collection,
+  /// using the builder for remove markers
+  Result processDocument(TRI_replication_operation_e,
+                         arangodb::velocypack::Slice const&, TRI_vocbase_t&,
+                         LogicalCollection*, arangodb::velocypack::Builder&);
+
   /// @brief renames a collection, based on the VelocyPack provided
   Result renameCollection(arangodb::velocypack::Slice const&);
 
@@ -101,9 +104,40 @@ class TailingSyncer : public Syncer {
   /// provided
   Result changeCollection(arangodb::velocypack::Slice const&);
 
+  /// @brief truncates a collection, based on the VelocyPack provided
+  Result truncateCollection(arangodb::velocypack::Slice const&);
+
+  /// @brief update the last processed tick with the tick of a marker
+  void updateProcessedTick(arangodb::velocypack::Slice const&, TRI_voc_tick_t);
+
   /// @brief apply a single marker from the continuous log
   Result applyLogMarker(arangodb::velocypack::Slice const&, TRI_voc_tick_t);
 
+  /// @brief check the result of applying a marker. errors are ignored while
+  /// the ignore count lasts
+  Result handleApplyResult(Result res, arangodb::velocypack::Slice const&,
+                           uint64_t& ignoreCount);
+
+  /// @brief a standalone document marker, applied together with the
+  /// standalone markers of other collections
+  struct PendingMarker {
+    arangodb::velocypack::Slice slice;
+    TRI_replication_operation_e type;
+    TRI_vocbase_t* vocbase;
+    std::shared_ptr<LogicalCollection> collection;
+    /// @brief keeps the slice of a JSON marker alive
+    std::shared_ptr<arangodb::velocypack::Builder> builder;
+  };
+
+  /// @brief resolve a marker that can be applied in parallel to the
+  /// markers of other collections
+  bool preparePendingMarker(arangodb::velocypack::Slice const&,
+                            PendingMarker&);
+
+  /// @brief apply the pending markers, with one queue per collection
+  Result applyPendingMarkers(std::vector<PendingMarker>&,
+                             uint64_t& ignoreCount);
+
   /// @brief apply the data from the continuous log
   Result applyLog(httpclient::SimpleHttpResult*, TRI_voc_tick_t firstRegularTick, 
                   uint64_t& processedMarkers, uint64_t& ignoreCount);
@@ -152,7 +186,7 @@ class TailingSyncer : public Syncer {
   TRI_voc_tick_t _initialTick;
   
   /// @brief whether or not an operation modified the _users collection
-  bool _usersModified;
+  std::atomic<bool> _usersModified;
   
   /// @brief use the initial tick
   bool _useTick;
@@ -42,6 +42,7 @@ typedef enum {
   REPLICATION_COLLECTION_DROP = 2001,
   REPLICATION_COLLECTION_RENAME = 2002,
   REPLICATION_COLLECTION_CHANGE = 2003,
+  REPLICATION_COLLECTION_TRUNCATE = 2004,
 
   REPLICATION_INDEX_CREATE = 2100,
   REPLICATION_INDEX_DROP = 2101,
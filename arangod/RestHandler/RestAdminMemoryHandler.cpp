@@ -0,0 +1,255 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RestAdminMemoryHandler.h"
+#include "Aql/ResourceUsage.h"
+#include "Basics/FileUtils.h"
+#include "Basics/StaticStrings.h"
+#include "Basics/Thread.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Basics/files.h"
+#include "Cache/CacheManagerFeature.h"
+#include "Cache/Manager.h"
+#include "Cluster/ServerState.h"
+#include "StorageEngine/EngineSelectorFeature.h"
+#include "StorageEngine/StorageEngine.h"
+#include "Utils/ExecContext.h"
+#include "V8Server/V8DealerFeature.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+#ifdef ARANGODB_HAVE_JEMALLOC
+// jemalloc prefixes its API on macOS only
+#ifdef __APPLE__
+#define ARANGODB_MALLCTL je_mallctl
+#else
+#define ARANGODB_MALLCTL mallctl
+#endif
+extern "C" int ARANGODB_MALLCTL(char const*, void*, size_t*, void*, size_t);
+#endif
+
+using namespace arangodb;
+using namespace arangodb::rest;
+
+namespace {
+#ifdef ARANGODB_HAVE_JEMALLOC
+template <typename T>
+bool readMallctl(char const* name, T& value) {
+  size_t size = sizeof(T);
+  return ARANGODB_MALLCTL(name, &value, &size, nullptr, 0) == 0;
+}
+
+template <typename T>
+bool writeMallctl(char const* name, T value) {
+  return ARANGODB_MALLCTL(name, nullptr, nullptr, &value, sizeof(T)) == 0;
+}
+#endif
+
+/// @brief whether jemalloc was built with profiling and started with it
+bool profilingAvailable() {
+#ifdef ARANGODB_HAVE_JEMALLOC
+  bool prof = false;
+  return readMallctl("opt.prof", prof) && prof;
+#else
+  return false;
+#endif
+}
+
+void addAllocator(VPackBuilder& builder) {
+  VPackObjectBuilder guard(&builder);
+#ifdef ARANGODB_HAVE_JEMALLOC
+  builder.add("name", VPackValue("jemalloc"));
+
+  // the statistics are cached until the epoch is advanced
+  uint64_t epoch = 1;
+  writeMallctl("epoch", epoch);
+  for (char const* name : {"allocated", "active", "metadata", "resident",
+                           "mapped", "retained"}) {
+    size_t value = 0;
+    if (readMallctl((std::string("stats.") + name).c_str(), value)) {
+      builder.add(name, VPackValue(value));
+    }
+  }
+
+  builder.add(VPackValue("profiling"));
+  VPackObjectBuilder profiling(&builder);
+  bool const available = profilingAvailable();
+  builder.add("available", VPackValue(available));
+  if (available) {
+    bool active = false;
+    readMallctl("prof.active", active);
+    builder.add("active", VPackValue(active));
+    size_t lgSample = 0;
+    if (readMallctl("prof.lg_sample", lgSample)) {
+      builder.add("sampleInterval", VPackValue(lgSample));
+    }
+  }
+#else
+  builder.add("name", VPackValue("system"));
+#endif
+}
+}  // namespace
+
+RestAdminMemoryHandler::RestAdminMemoryHandler(GeneralRequest* request,
+                                               GeneralResponse* response)
+    : RestBaseHandler(request, response) {}
+
+RestStatus RestAdminMemoryHandler::execute() {
+  if (ExecContext::CURRENT != nullptr &&
+      !ExecContext::CURRENT->isAdminUser()) {
+    generateError(rest::ResponseCode::FORBIDDEN, TRI_ERROR_HTTP_FORBIDDEN,
+                  "you need admin rights to inspect the memory");
+    return RestStatus::DONE;
+  }
+
+  auto const type = _request->requestType();
+  std::vector<std::string> const& suffixes = _request->decodedSuffixes();
+
+  if (suffixes.empty()) {
+    if (type != rest::RequestType::GET) {
+      generateError(rest::ResponseCode::METHOD_NOT_ALLOWED,
+                    TRI_ERROR_HTTP_METHOD_NOT_ALLOWED);
+      return RestStatus::DONE;
+    }
+    reportMemory();
+    return RestStatus::DONE;
+  }
+
+  if (suffixes.size() != 1 || suffixes[0] != "profile") {
+    generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_HTTP_NOT_FOUND);
+    return RestStatus::DONE;
+  }
+  if (type != rest::RequestType::PUT && type != rest::RequestType::POST) {
+    generateError(rest::ResponseCode::METHOD_NOT_ALLOWED,
+                  TRI_ERROR_HTTP_METHOD_NOT_ALLOWED);
+    return RestStatus::DONE;
+  }
+  if (!profilingAvailable()) {
+    generateError(rest::ResponseCode::NOT_IMPLEMENTED, TRI_ERROR_NOT_IMPLEMENTED,
+                  "heap profiling needs jemalloc with profiling enabled");
+    return RestStatus::DONE;
+  }
+
+  if (type == rest::RequestType::PUT) {
+    setProfiling();
+  } else {
+    dumpProfile();
+  }
+  return RestStatus::DONE;
+}
+
+void RestAdminMemoryHandler::reportMemory() {
+  VPackBuilder result;
+  result.openObject();
+  result.add("server", VPackValue(ServerState::instance()->getId()));
+
+  result.add(VPackValue("allocator"));
+  ::addAllocator(result);
+
+  // what the subsystems account for themselves, in bytes
+  result.add(VPackValue("aql"));
+  result.openObject();
+  result.add("queries", VPackValue(aql::ResourceMonitor::globalMemoryUsage()));
+  result.close();
+
+  if (CacheManagerFeature::MANAGER != nullptr) {
+    result.add(VPackValue("cache"));
+    result.openObject();
+    result.add("allocated",
+               VPackValue(CacheManagerFeature::MANAGER->globalAllocation()));
+    result.add("limit", VPackValue(CacheManagerFeature::MANAGER->globalLimit()));
+    result.close();
+  }
+
+  if (EngineSelectorFeature::ENGINE != nullptr) {
+    result.add(VPackValue("engine"));
+    EngineSelectorFeature::ENGINE->getMemoryStatistics(result);
+  }
+
+  if (V8DealerFeature::DEALER != nullptr) {
+    result.add(VPackValue("v8"));
+    result.openObject();
+    V8DealerFeature::DEALER->addMemoryStatistics(result);
+    result.close();
+  }
+
+  result.add(StaticStrings::Error, VPackValue(false));
+  result.close();
+  generateResult(rest::ResponseCode::OK, result.slice());
+}
+
+void RestAdminMemoryHandler::setProfiling() {
+#ifdef ARANGODB_HAVE_JEMALLOC
+  bool parsed = false;
+  VPackSlice body = parseVPackBody(parsed);
+  if (!parsed) {
+    // error message generated in parseVPackBody
+    return;
+  }
+  if (!body.isObject() || !body.get("active").isBoolean()) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                  "expecting an object with attribute 'active'");
+    return;
+  }
+
+  VPackSlice sampleInterval = body.get("sampleInterval");
+  if (sampleInterval.isNumber()) {
+    // discards the samples so far, and samples about every 2^n bytes
+    size_t lgSample = sampleInterval.getNumber<size_t>();
+    if (lgSample > 40 || !writeMallctl("prof.reset", lgSample)) {
+      generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                    "invalid value for 'sampleInterval'");
+      return;
+    }
+  }
+
+  if (!writeMallctl("prof.active", body.get("active").getBool())) {
+    generateError(rest::ResponseCode::SERVER_ERROR, TRI_ERROR_INTERNAL,
+                  "cannot change heap profiling");
+    return;
+  }
+#endif
+  reportMemory();
+}
+
+void RestAdminMemoryHandler::dumpProfile() {
+#ifdef ARANGODB_HAVE_JEMALLOC
+  static std::atomic<uint64_t> NextDump(0);
+
+  std::string const file = basics::FileUtils::buildFilename(
+      TRI_GetTempPath(),
+      "arangod-heap-" + std::to_string(Thread::currentProcessId()) + "-" +
+          std::to_string(++NextDump) + ".prof");
+  char const* name = file.c_str();
+  if (!writeMallctl("prof.dump", name)) {
+    generateError(rest::ResponseCode::SERVER_ERROR, TRI_ERROR_INTERNAL,
+                  "cannot dump heap profile to '" + file + "'");
+    return;
+  }
+
+  VPackBuilder result;
+  result.openObject();
+  result.add("file", VPackValue(file));
+  result.add(StaticStrings::Error, VPackValue(false));
+  result.close();
+  generateResult(rest::ResponseCode::OK, result.slice());
+#endif
+}
@@ -0,0 +1,48 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_REST_HANDLER_REST_ADMIN_MEMORY_HANDLER_H
+#define ARANGOD_REST_HANDLER_REST_ADMIN_MEMORY_HANDLER_H 1
+
+#include "Basics/Common.h"
+#include "RestHandler/RestBaseHandler.h"
+
+namespace arangodb {
+/// @brief GET returns the memory of the allocator, and the memory accounted
+/// by the AQL queries, the in-memory caches, the storage engine and the V8
+/// contexts. with jemalloc built with profiling, PUT /profile switches heap
+/// sampling on and off, and POST /profile dumps a heap profile to a file
+class RestAdminMemoryHandler : public RestBaseHandler {
+ public:
+  RestAdminMemoryHandler(GeneralRequest*, GeneralResponse*);
+
+ public:
+  char const* name() const override final { return "RestAdminMemoryHandler"; }
+  RequestLane lane() const override final { return RequestLane::CLIENT_SLOW; }
+  RestStatus execute() override final;
+
+ private:
+  void reportMemory();
+  void setProfiling();
+  void dumpProfile();
+};
+}
+
+#endif
@@ -21,7 +21,15 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "RestAdminStatisticsHandler.h"
+#include "Cluster/ClusterComm.h"
+#include "Cluster/ServerState.h"
+#include "GeneralServer/GeneralServerFeature.h"
+#include "GeneralServer/RequestAdmission.h"
+#include "Rest/PayloadCompression.h"
+#include "StorageEngine/EngineSelectorFeature.h"
+#include "StorageEngine/StorageEngine.h"
 #include "Statistics/Descriptions.h"
+#include "Statistics/RequestStatistics.h"
 #include "Statistics/StatisticsFeature.h"
 
 using namespace arangodb;
@@ -81,6 +89,49 @@ void RestAdminStatisticsHandler::getStatistics() {
   tmp.add("server", VPackValue(VPackValueType::Object, true));
   desc->serverStatistics(tmp);
   tmp.close(); // server
+
+  // the admission counters and queue times of the request lanes
+  if (GeneralServerFeature::ADMISSION != nullptr) {
+    tmp.add(VPackValue("lanes"));
+    GeneralServerFeature::ADMISSION->toVelocyPack(tmp);
+  }
+
+  // the connection pool of the requests to other servers of the cluster
+  if (ServerState::instance()->isRunningInCluster()) {
+    auto cc = ClusterComm::instance();
+    if (cc != nullptr && cc->communicator() != nullptr) {
+      tmp.add(VPackValue("clusterComm"));
+      cc->communicator()->toVelocyPack(tmp);
+    }
+  }
+
+  // the compression of the bodies exchanged with other servers
+  if (PayloadCompression::enabled()) {
+    tmp.add(VPackValue("compression"));
+    PayloadCompression::toVelocyPack(tmp);
+  }
+
+  // the counters of the in-memory caches, attributed to their collections
+  // and indexes. these are only reported on request, as they require a walk
+  // over all collections
+  if (_request->parsedValue("caches", false)) {
+    tmp.add(VPackValue("caches"));
+    EngineSelectorFeature::ENGINE->getCacheStatistics(tmp);
+  }
+  
+  // the per-seconds statistics of the last 15 minutes, for scrapers that
+  // would otherwise have to query the statistics collections
+  if (_request->parsedValue("history", false)) {
+    tmp.add(VPackValue("history"));
+    StatisticsFeature::historyToVelocyPack(tmp);
+  }
+
+  // percentiles of the request times and sizes per handler and request
+  // lane, also only on request, as there can be many of them
+  if (_request->parsedValue("latency", false)) {
+    tmp.add(VPackValue("latency"));
+    RequestStatistics::latencyToVelocyPack(tmp);
+  }
   
   tmp.add(StaticStrings::Error, VPackValue(false));
   tmp.add(StaticStrings::Code, VPackValue(static_cast<int>(ResponseCode::OK)));
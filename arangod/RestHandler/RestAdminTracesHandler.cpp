@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RestAdminTracesHandler.h"
+#include "Basics/StaticStrings.h"
+#include "Cluster/ServerState.h"
+#include "Statistics/RequestTracer.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::rest;
+
+RestAdminTracesHandler::RestAdminTracesHandler(GeneralRequest* request,
+                                               GeneralResponse* response)
+    : RestBaseHandler(request, response) {}
+
+RestStatus RestAdminTracesHandler::execute() {
+  auto const type = _request->requestType();
+
+  if (type == rest::RequestType::DELETE_REQ) {
+    RequestTracer::clear();
+    VPackBuilder result;
+    result.openObject();
+    result.add(StaticStrings::Error, VPackValue(false));
+    result.close();
+    generateResult(rest::ResponseCode::OK, result.slice());
+    return RestStatus::DONE;
+  }
+
+  if (type != rest::RequestType::GET) {
+    generateError(rest::ResponseCode::METHOD_NOT_ALLOWED,
+                  TRI_ERROR_HTTP_METHOD_NOT_ALLOWED);
+    return RestStatus::DONE;
+  }
+
+  bool found;
+  std::string const& traceId = _request->value("id", found);
+
+  VPackBuilder result;
+  result.openObject();
+  result.add("server", VPackValue(ServerState::instance()->getId()));
+  result.add(VPackValue("spans"));
+  RequestTracer::toVelocyPack(result, found ? traceId : std::string());
+  result.add(StaticStrings::Error, VPackValue(false));
+  result.close();
+  generateResult(rest::ResponseCode::OK, result.slice());
+  return RestStatus::DONE;
+}
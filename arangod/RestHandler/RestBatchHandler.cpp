@@ -23,6 +23,8 @@
 
 #include "RestBatchHandler.h"
 
+#include "Basics/ConditionLocker.h"
+#include "Basics/ConditionVariable.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/StringUtils.h"
 #include "GeneralServer/GeneralServer.h"
@@ -30,12 +32,47 @@
 #include "GeneralServer/RestHandlerFactory.h"
 #include "Logger/Logger.h"
 #include "Rest/HttpRequest.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "Utils/ExecContext.h"
 
 using namespace arangodb;
 using namespace arangodb::basics;
 using namespace arangodb::rest;
 
+namespace {
+/// @brief maximal number of scheduler threads helping with a concurrent batch
+size_t const maxConcurrentHelpers = 8;
+
+/// @brief the handlers of the parts of a batch, shared with the helpers on
+/// the scheduler, which may start after the batch is done
+struct BatchExecution {
+  std::vector<std::shared_ptr<RestHandler>> handlers;
+  std::atomic<size_t> next{0};
+
+  basics::ConditionVariable condition;
+  // protected by the condition variable
+  size_t done = 0;
+
+  /// @brief executes parts until there are none left
+  void work() {
+    size_t i;
+    while ((i = next.fetch_add(1)) < handlers.size()) {
+      // ignore any errors here, will be handled later by inspecting the response
+      try {
+        ExecContextScope scope(nullptr);// workaround because of assertions
+        handlers[i]->runHandler([](RestHandler*) {});
+      } catch (...) {
+      }
+
+      CONDITION_LOCKER(guard, condition);
+      ++done;
+      guard.signal();
+    }
+  }
+};
+}
+
 RestBatchHandler::RestBatchHandler(GeneralRequest* request,
                                    GeneralResponse* response)
     : RestVocbaseBaseHandler(request, response) {}
@@ -120,6 +157,11 @@ RestStatus RestBatchHandler::executeHttp() {
   helper.message = &message;
   helper.searchStart = message.messageStart;
 
+  // set up the handlers of all parts first, so that no part is executed
+  // for a corrupted message
+  auto execution = std::make_shared<BatchExecution>();
+  std::vector<std::string> contentIds;
+
   // iterate over all parts of the multipart message
   while (true) {
     // get the next part from the multipart message
@@ -190,8 +232,6 @@ RestStatus RestBatchHandler::executeHttp() {
                          authorization.c_str(), authorization.size());
     }
 
-    std::shared_ptr<RestHandler> handler = nullptr;
-
     {
       std::unique_ptr<HttpResponse> response(new HttpResponse(rest::ResponseCode::SERVER_ERROR));
 
@@ -205,64 +245,88 @@ RestStatus RestBatchHandler::executeHttp() {
         return RestStatus::DONE;
       }
 
-      handler.reset(h);
+      execution->handlers.emplace_back(h);
     }
 
-    // start to work for this handler
-    {
-      // ignore any errors here, will be handled later by inspecting the response
+    if (helper.contentId != nullptr) {
+      contentIds.emplace_back(helper.contentId, helper.contentIdLength);
+    } else {
+      contentIds.emplace_back();
+    }
+
+    // we've read the last part
+    if (!helper.containsMore) {
+      break;
+    }
+  }
+
+  // the client declares with concurrent=true that the parts do not depend
+  // on each other
+  bool const concurrent = _request->parsedValue("concurrent", false);
+  size_t const total = execution->handlers.size();
+
+  if (concurrent && total > 1 && SchedulerFeature::SCHEDULER != nullptr) {
+    size_t const helpers = (std::min)(total - 1, maxConcurrentHelpers);
+    for (size_t i = 0; i < helpers; ++i) {
       try {
-        ExecContextScope scope(nullptr);// workaround because of assertions        
-        handler->runHandler([](RestHandler*) {});
+        SchedulerFeature::SCHEDULER->post([execution]() { execution->work(); });
       } catch (...) {
+        // this thread executes the remaining parts
+        break;
       }
+    }
+  }
 
-      HttpResponse* partResponse =
-          dynamic_cast<HttpResponse*>(handler->response());
+  // helpers only get parts that this thread did not take yet, so all parts
+  // are done even if no helper ever runs
+  execution->work();
+  {
+    CONDITION_LOCKER(guard, execution->condition);
+    while (execution->done < total) {
+      guard.wait();
+    }
+  }
 
-      if (partResponse == nullptr) {
-        generateError(rest::ResponseCode::BAD, TRI_ERROR_INTERNAL,
-                      "could not create a response for batch part request");
+  for (size_t i = 0; i < total; ++i) {
+    RestHandler* handler = execution->handlers[i].get();
+    HttpResponse* partResponse =
+        dynamic_cast<HttpResponse*>(handler->response());
 
-        return RestStatus::DONE;
-      }
+    if (partResponse == nullptr) {
+      generateError(rest::ResponseCode::BAD, TRI_ERROR_INTERNAL,
+                    "could not create a response for batch part request");
 
-      rest::ResponseCode const code = partResponse->responseCode();
+      return RestStatus::DONE;
+    }
 
-      // count everything above 400 as error
-      if (int(code) >= 400) {
-        ++errors;
-      }
+    rest::ResponseCode const code = partResponse->responseCode();
 
-      // append the boundary for this subpart
-      httpResponse->body().appendText(boundary + "\r\nContent-Type: ");
-      httpResponse->body().appendText(StaticStrings::BatchContentType);
+    // count everything above 400 as error
+    if (int(code) >= 400) {
+      ++errors;
+    }
 
-      // append content-id if it is present
-      if (helper.contentId != nullptr) {
-        httpResponse->body().appendText(
-            "\r\nContent-Id: " +
-            std::string(helper.contentId, helper.contentIdLength));
-      }
+    // append the boundary for this subpart
+    httpResponse->body().appendText(boundary + "\r\nContent-Type: ");
+    httpResponse->body().appendText(StaticStrings::BatchContentType);
 
-      httpResponse->body().appendText(TRI_CHAR_LENGTH_PAIR("\r\n\r\n"));
+    // append content-id if it is present
+    if (!contentIds[i].empty()) {
+      httpResponse->body().appendText("\r\nContent-Id: " + contentIds[i]);
+    }
 
-      // remove some headers we don't need
-      partResponse->setConnectionType(rest::ConnectionType::C_NONE);
-      partResponse->setHeaderNC(StaticStrings::Server, "");
+    httpResponse->body().appendText(TRI_CHAR_LENGTH_PAIR("\r\n\r\n"));
 
-      // append the part response header
-      partResponse->writeHeader(&httpResponse->body());
+    // remove some headers we don't need
+    partResponse->setConnectionType(rest::ConnectionType::C_NONE);
+    partResponse->setHeaderNC(StaticStrings::Server, "");
 
-      // append the part response body
-      httpResponse->body().appendText(partResponse->body());
-      httpResponse->body().appendText(TRI_CHAR_LENGTH_PAIR("\r\n"));
-    }
+    // append the part response header
+    partResponse->writeHeader(&httpResponse->body());
 
-    // we've read the last part
-    if (!helper.containsMore) {
-      break;
-    }
+    // append the part response body
+    httpResponse->body().appendText(partResponse->body());
+    httpResponse->body().appendText(TRI_CHAR_LENGTH_PAIR("\r\n"));
   }
 
   // append final boundary + "--"
@@ -262,7 +262,7 @@ void RestCollectionHandler::handleCommandPost() {
       std::unordered_set<std::string>{
           "doCompact", "isSystem", "id", "isVolatile", "journalSize",
           "indexBuckets", "keyOptions", "waitForSync", "cacheEnabled",
-          "shardKeys", "numberOfShards", "distributeShardsLike", "avoidServers",
+          "compressDocuments", "shardKeys", "numberOfShards", "distributeShardsLike", "avoidServers",
           "isSmart", "smartGraphAttribute", "replicationFactor", "servers"});
   VPackSlice const parameters = filtered.slice();
 
@@ -352,6 +352,7 @@ void RestCollectionHandler::handleCommandPut() {
           SingleCollectionTransaction trx(
             ctx, coll, AccessMode::Type::EXCLUSIVE
           );
+          trx.addHint(transaction::Hints::Hint::ALLOW_RANGE_DELETE);
 
           res = trx.begin();
 
@@ -374,7 +375,8 @@ void RestCollectionHandler::handleCommandPut() {
         } else if (sub == "properties") {
           std::vector<std::string> keep = {"doCompact",         "journalSize",
                                            "waitForSync",       "indexBuckets",
-                                           "replicationFactor", "cacheEnabled"};
+                                           "replicationFactor", "cacheEnabled",
+                                           "compressDocuments"};
           VPackBuilder props = VPackCollection::keep(body, keep);
           res = methods::Collections::updateProperties(coll, props.slice());
           if (res.ok()) {
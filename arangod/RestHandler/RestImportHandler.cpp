@@ -518,7 +518,7 @@ bool RestImportHandler::createFromJson(std::string const& type) {
   if (res.ok()) {
     // no error so far. go on and perform the actual insert
     res =
-        performImport(trx, result, collectionName, babies, complete, opOptions);
+        performImport(trx, result, collectionName, babies.slice(), complete, opOptions);
   }
 
   res = trx.finish(res);
@@ -564,6 +564,15 @@ bool RestImportHandler::createFromVPack(std::string const& type) {
     return false;
   }
 
+  // the payload is validated once, before anything is truncated
+  VPackSlice const documents = _request->payload();
+
+  if (!documents.isArray()) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                  "expecting a JSON array in the request");
+    return false;
+  }
+
   // find and load collection given by name or identifier
   auto ctx = transaction::StandaloneContext::Create(_vocbase);
   SingleCollectionTransaction trx(ctx, collectionName, AccessMode::Type::WRITE);
@@ -590,42 +599,40 @@ bool RestImportHandler::createFromVPack(std::string const& type) {
     // Ignore the result ...
   }
 
-  VPackBuilder babies;
-  babies.openArray();
-
-  VPackSlice const documents = _request->payload();
+  if (importableInPlace(documents, isEdgeCollection)) {
+    // insert the documents straight from the request body
+    res = performImport(trx, result, collectionName, documents, complete,
+                        opOptions);
+  } else {
+    VPackBuilder babies;
+    babies.openArray();
 
-  if (!documents.isArray()) {
-    generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
-                  "expecting a JSON array in the request");
-    return false;
-  }
+    VPackBuilder lineBuilder;
 
-  VPackBuilder lineBuilder;
+    VPackArrayIterator it(documents);
+    while (it.valid()) {
+      res = handleSingleDocument(trx, lineBuilder, result, babies, it.value(), isEdgeCollection,
+                                 static_cast<size_t>(it.index() + 1));
 
-  VPackArrayIterator it(documents);
-  while (it.valid()) {
-    res = handleSingleDocument(trx, lineBuilder, result, babies, it.value(), isEdgeCollection,
-                               static_cast<size_t>(it.index() + 1));
+      if (res.fail()) {
+        if (complete) {
+          // only perform a full import: abort
+          break;
+        }
 
-    if (res.fail()) {
-      if (complete) {
-        // only perform a full import: abort
-        break;
+        res = TRI_ERROR_NO_ERROR;
       }
 
-      res = TRI_ERROR_NO_ERROR;
+      it.next();
     }
 
-    it.next();
-  }
+    babies.close();
 
-  babies.close();
-
-  if (res.ok()) {
-    // no error so far. go on and perform the actual insert
-    res =
-        performImport(trx, result, collectionName, babies, complete, opOptions);
+    if (res.ok()) {
+      // no error so far. go on and perform the actual insert
+      res =
+          performImport(trx, result, collectionName, babies.slice(), complete, opOptions);
+    }
   }
 
   res = trx.finish(res);
@@ -857,7 +864,7 @@ bool RestImportHandler::createFromKeyValueList() {
   if (res.ok()) {
     // no error so far. go on and perform the actual insert
     res =
-        performImport(trx, result, collectionName, babies, complete, opOptions);
+        performImport(trx, result, collectionName, babies.slice(), complete, opOptions);
   }
 
   res = trx.finish(res);
@@ -877,7 +884,7 @@ bool RestImportHandler::createFromKeyValueList() {
 Result RestImportHandler::performImport(SingleCollectionTransaction& trx,
                                         RestImportResult& result,
                                         std::string const& collectionName,
-                                        VPackBuilder const& babies, bool complete,
+                                        VPackSlice babies, bool complete,
                                         OperationOptions const& opOptions) {
   auto makeError = [&](size_t i, int res, VPackSlice const& slice,
                        RestImportResult& result) {
@@ -898,7 +905,7 @@ Result RestImportHandler::performImport(SingleCollectionTransaction& trx,
 
   Result res;
   OperationResult opResult =
-      trx.insert(collectionName, babies.slice(), opOptions);
+      trx.insert(collectionName, babies, opOptions);
 
   VPackSlice resultSlice = opResult.slice();
 
@@ -915,7 +922,7 @@ Result RestImportHandler::performImport(SingleCollectionTransaction& trx,
         // got an error, now handle it
 
         int errorCode = it.get(StaticStrings::ErrorNum).getNumber<int>();
-        VPackSlice const which = babies.slice().at(pos);
+        VPackSlice const which = babies.at(pos);
         // special behavior in case of unique constraint violation . . .
         if (errorCode == TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED &&
             _onDuplicateAction != DUPLICATE_ERROR) {
@@ -983,7 +990,7 @@ Result RestImportHandler::performImport(SingleCollectionTransaction& trx,
               errorCode = TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED;
             }
             makeError(originalPositions[pos], errorCode,
-                      babies.slice().at(originalPositions[pos]), result);
+                      babies.at(originalPositions[pos]), result);
             if (complete) {
               res = errorCode;
               break;
@@ -1002,6 +1009,27 @@ Result RestImportHandler::performImport(SingleCollectionTransaction& trx,
   return res;
 }
 
+bool RestImportHandler::importableInPlace(VPackSlice documents,
+                                          bool isEdgeCollection) const {
+  if (isEdgeCollection && (!_fromPrefix.empty() || !_toPrefix.empty())) {
+    // the prefixes are added to a copy of each edge
+    return false;
+  }
+
+  // anything else is left to handleSingleDocument, which reports it
+  for (auto const& document : VPackArrayIterator(documents)) {
+    if (!document.isObject()) {
+      return false;
+    }
+    if (isEdgeCollection &&
+        (!document.get(StaticStrings::FromString).isString() ||
+         !document.get(StaticStrings::ToString).isString())) {
+      return false;
+    }
+  }
+  return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief create response for number of documents created / failed
 ////////////////////////////////////////////////////////////////////////////////
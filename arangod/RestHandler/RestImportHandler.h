@@ -130,9 +130,16 @@ class RestImportHandler : public RestVocbaseBaseHandler {
 
   Result performImport(SingleCollectionTransaction& trx, RestImportResult& result,
                        std::string const& collectionName,
-                       VPackBuilder const& babies, bool complete,
+                       VPackSlice babies, bool complete,
                        OperationOptions const& opOptions);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether the documents can be inserted as they are, without
+  /// copying each of them
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool importableInPlace(VPackSlice documents, bool isEdgeCollection) const;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief creates the result
   //////////////////////////////////////////////////////////////////////////////
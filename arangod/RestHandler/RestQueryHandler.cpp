@@ -23,6 +23,7 @@
 
 #include "RestQueryHandler.h"
 
+#include "Aql/PlanCache.h"
 #include "Aql/Query.h"
 #include "Aql/QueryList.h"
 #include "Basics/conversions.h"
@@ -94,6 +95,20 @@ bool RestQueryHandler::readQueryProperties() {
   return true;
 }
 
+bool RestQueryHandler::readPlanCache() {
+  VPackBuilder result;
+
+  result.add(VPackValue(VPackValueType::Object));
+  result.add(StaticStrings::Error, VPackValue(false));
+  result.add(StaticStrings::Code, VPackValue((int)rest::ResponseCode::OK));
+  PlanCache::instance()->toVelocyPack(result);
+  result.close();
+
+  generateResult(rest::ResponseCode::OK, result.slice());
+
+  return true;
+}
+
 bool RestQueryHandler::readQuery(bool slow) {
   auto queryList = _vocbase.queryList();
   auto queries = slow ? queryList->listSlow() : queryList->listCurrent();
@@ -143,12 +158,14 @@ bool RestQueryHandler::readQuery() {
     return readQuery(false);
   } else if (name == "properties") {
     return readQueryProperties();
+  } else if (name == "plan-cache") {
+    return readPlanCache();
   }
 
   generateError(rest::ResponseCode::NOT_FOUND,
                 TRI_ERROR_HTTP_NOT_FOUND,
                 "unknown type '" + name +
-                    "', expecting 'slow', 'current', or 'properties'");
+                    "', expecting 'slow', 'current', 'properties' or 'plan-cache'");
   return true;
 }
 
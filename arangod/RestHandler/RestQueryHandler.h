@@ -53,6 +53,12 @@ class RestQueryHandler : public RestVocbaseBaseHandler {
 
   bool readQueryProperties();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief returns the properties and figures of the plan cache
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool readPlanCache();
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief returns the list of slow queries
   //////////////////////////////////////////////////////////////////////////////
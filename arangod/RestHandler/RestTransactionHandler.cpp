@@ -64,7 +64,8 @@ RestStatus RestTransactionHandler::execute() {
   std::string portType = _request->connectionInfo().portType();
   
   _v8Context =
-  V8DealerFeature::DEALER->enterContext(&_vocbase, true /*allow use database*/);
+  V8DealerFeature::DEALER->enterContext(&_vocbase, true /*allow use database*/,
+                                     V8DealerFeature::ANY_CONTEXT, lane());
   
   if (!_v8Context) {
     generateError(Result(TRI_ERROR_INTERNAL, "could not acquire v8 context"));
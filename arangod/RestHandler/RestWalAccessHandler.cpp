@@ -22,6 +22,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "RestWalAccessHandler.h"
+#include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/VPackStringBufferAdapter.h"
 #include "Basics/VelocyPackHelper.h"
@@ -42,10 +43,17 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <chrono>
+
 using namespace arangodb;
 using namespace arangodb::basics;
 using namespace arangodb::rest;
 
+namespace {
+/// @brief tail responses below this size are sent uncompressed
+constexpr size_t MinCompressSize = 16384;
+}
+
 struct MyTypeHandler final : public VPackCustomTypeHandler {
   explicit MyTypeHandler(TRI_vocbase_t& vocbase): resolver(vocbase) {}
 
@@ -82,18 +90,20 @@ bool RestWalAccessHandler::parseFilter(WalAccess::Filter& filter) {
     // filter for collection
     filter.vocbase = _vocbase.id();
 
-    // extract collection
+    // extract collections, a comma-separated list of names
     std::string const& value2 = _request->value("collection", found);
     if (found) {
-      auto c = _vocbase.lookupCollection(value2);
+      for (auto const& name : StringUtils::split(value2, ',')) {
+        auto c = _vocbase.lookupCollection(StringUtils::trim(name));
 
-      if (c == nullptr) {
-        generateError(rest::ResponseCode::NOT_FOUND,
-                      TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND);
-        return false;
-      }
+        if (c == nullptr) {
+          generateError(rest::ResponseCode::NOT_FOUND,
+                        TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND);
+          return false;
+        }
 
-      filter.collection = c->id();
+        filter.collections.emplace(c->id());
+      }
     }
   }
 
@@ -275,6 +285,15 @@ void RestWalAccessHandler::handleCommandTail(WalAccess const* wal) {
     chunkSize = std::min((size_t)128 * 1024 * 1024, chunkSize);
   }
 
+  // a client that is up to date may wait for new markers, instead of
+  // polling again and again
+  double timeout = _request->parsedValue("timeout", 0.0);
+  if (timeout < 0.0) {
+    timeout = 0.0;
+  } else if (timeout > 60.0) {
+    timeout = 60.0;
+  }
+
   WalAccessResult result;
   std::map<TRI_voc_tick_t, std::unique_ptr<MyTypeHandler>> handlers;
   VPackOptions opts = VPackOptions::Defaults;
@@ -294,18 +313,27 @@ void RestWalAccessHandler::handleCommandTail(WalAccess const* wal) {
 
   size_t length = 0;
 
-  if (useVst) {
-    result =
-        wal->tail(tickStart, tickEnd, chunkSize, barrierId, filter,
-                  [&](TRI_vocbase_t* vocbase, VPackSlice const& marker) {
-                    length++;
+  // followers that ask for VelocyPack get the markers as they are, only
+  // the types a client cannot handle are converted
+  bool const useVPack =
+      !useVst && _request->contentTypeResponse() == rest::ContentType::VPACK;
+  if (useVPack) {
+    _response->setContentType(rest::ContentType::VPACK);
+  }
+
+  WalAccess::MarkerCallback callback;
+  std::unique_ptr<basics::VPackStringBufferAdapter> adapter;
+  std::unique_ptr<VPackDumper> dumper;
+  if (useVst || useVPack) {
+    callback = [&](TRI_vocbase_t* vocbase, VPackSlice const& marker) {
+      length++;
 
-                    if (vocbase != nullptr) {  // database drop has no vocbase
-                      prepOpts(*vocbase);
-                    }
+      if (vocbase != nullptr) {  // database drop has no vocbase
+        prepOpts(*vocbase);
+      }
 
-                    _response->addPayload(marker, &opts, true);
-                  });
+      _response->addPayload(marker, &opts, true);
+    };
   } else {
     HttpResponse* httpResponse = dynamic_cast<HttpResponse*>(_response.get());
     TRI_ASSERT(httpResponse);
@@ -314,22 +342,46 @@ void RestWalAccessHandler::handleCommandTail(WalAccess const* wal) {
                                      "invalid response type");
     }
     basics::StringBuffer& buffer = httpResponse->body();
-    basics::VPackStringBufferAdapter adapter(buffer.stringBuffer());
+    adapter = std::make_unique<basics::VPackStringBufferAdapter>(
+        buffer.stringBuffer());
     // note: we need the CustomTypeHandler here
-    VPackDumper dumper(&adapter, &opts);
-    result =
-        wal->tail(tickStart, tickEnd, chunkSize, barrierId, filter,
-                  [&](TRI_vocbase_t* vocbase, VPackSlice const& marker) {
-                    length++;
+    dumper = std::make_unique<VPackDumper>(adapter.get(), &opts);
+    callback = [&](TRI_vocbase_t* vocbase, VPackSlice const& marker) {
+      length++;
 
-                    if (vocbase != nullptr) {  // database drop has no vocbase
-                      prepOpts(*vocbase);
-                    }
+      if (vocbase != nullptr) {  // database drop has no vocbase
+        prepOpts(*vocbase);
+      }
+
+      dumper->dump(marker);
+      buffer.appendChar('\n');
+    };
+  }
 
-                    dumper.dump(marker);
-                    buffer.appendChar('\n');
-                    //LOG_TOPIC(INFO, Logger::FIXME) << marker.toJson(&opts);
-                  });
+  // the client's server id keeps its position in the WAL between calls
+  result = wal->tail(tickStart, tickEnd, chunkSize, barrierId, serverId,
+                     filter, callback);
+  bool const fromTickIncluded = result.fromTickIncluded();
+
+  auto const end = std::chrono::steady_clock::now() +
+                   std::chrono::duration<double>(timeout);
+  while (result.ok() && length == 0 && result.lastScannedTick() < tickEnd &&
+         !_canceled.load() &&
+         !application_features::ApplicationServer::isStopping()) {
+    double remaining =
+        std::chrono::duration<double>(end - std::chrono::steady_clock::now())
+            .count();
+    if (remaining <= 0.0 ||
+        !wal->waitForTicksAfter(result.latestTick(), remaining)) {
+      break;
+    }
+    // nothing up to the last scanned tick matches the filter
+    TRI_voc_tick_t lastScannedTick = result.lastScannedTick();
+    result = wal->tail(lastScannedTick, tickEnd, chunkSize, barrierId,
+                       serverId, filter, callback);
+    if (result.lastScannedTick() < lastScannedTick) {
+      result.lastScannedTick(lastScannedTick);
+    }
   }
 
   if (result.fail()) {
@@ -338,7 +390,8 @@ void RestWalAccessHandler::handleCommandTail(WalAccess const* wal) {
   }
 
   // transfer ownership of the buffer contents
-  _response->setContentType(rest::ContentType::DUMP);
+  _response->setContentType(useVPack ? rest::ContentType::VPACK
+                                     : rest::ContentType::DUMP);
 
   // set headers
   bool checkMore = result.lastIncludedTick() > 0 &&
@@ -354,10 +407,13 @@ void RestWalAccessHandler::handleCommandTail(WalAccess const* wal) {
                          StringUtils::itoa(result.latestTick()));
   _response->setHeaderNC(StaticStrings::ReplicationHeaderActive, "true");
   _response->setHeaderNC(StaticStrings::ReplicationHeaderFromPresent,
-                         result.fromTickIncluded() ? "true" : "false");
+                         fromTickIncluded ? "true" : "false");
 
   if (length > 0) {
     _response->setResponseCode(rest::ResponseCode::OK);
+    if (!useVst) {
+      compressResponse();
+    }
     LOG_TOPIC(DEBUG, Logger::REPLICATION) << "WAL tailing after " << tickStart
       << ", lastIncludedTick " << result.lastIncludedTick()
       << ", fromTickIncluded " << result.fromTickIncluded();
@@ -375,6 +431,28 @@ void RestWalAccessHandler::handleCommandTail(WalAccess const* wal) {
   );
 }
 
+void RestWalAccessHandler::compressResponse() {
+  bool found;
+  std::string const& encoding =
+      _request->header(StaticStrings::AcceptEncoding, found);
+  if (!found || encoding.find("deflate") == std::string::npos) {
+    return;
+  }
+
+  HttpResponse* httpResponse = dynamic_cast<HttpResponse*>(_response.get());
+  TRI_ASSERT(httpResponse != nullptr);
+  // small responses are not worth the effort
+  if (httpResponse == nullptr ||
+      httpResponse->body().length() < ::MinCompressSize) {
+    return;
+  }
+
+  int res = httpResponse->deflate();
+  if (res != TRI_ERROR_NO_ERROR) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+}
+
 void RestWalAccessHandler::handleCommandDetermineOpenTransactions(
     WalAccess const* wal) {
   // determine start and end tick
@@ -46,6 +46,8 @@ class RestWalAccessHandler : public arangodb::RestVocbaseBaseHandler {
   void handleCommandLastTick(WalAccess const* wal);
   void handleCommandTail(WalAccess const* wal);
   void handleCommandDetermineOpenTransactions(WalAccess const* wal);
+  /// @brief deflate the response body if the client accepts it
+  void compressResponse();
 
   void grantTemporaryRights();
 };
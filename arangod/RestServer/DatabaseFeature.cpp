@@ -35,6 +35,7 @@
 #include "Basics/StringUtils.h"
 #include "Basics/WriteLocker.h"
 #include "Basics/files.h"
+#include "Basics/system-functions.h"
 #include "Cluster/ServerState.h"
 #include "Cluster/TraverserEngineRegistry.h"
 #include "Cluster/v8-cluster.h"
@@ -62,6 +63,8 @@
 
 #include <velocypack/velocypack-aliases.h>
 
+#include <thread>
+
 using namespace arangodb;
 using namespace arangodb::application_features;
 using namespace arangodb::basics;
@@ -228,6 +231,11 @@ DatabaseFeature::DatabaseFeature(ApplicationServer* server)
       _ignoreDatafileErrors(false),
       _check30Revisions("true"),
       _throwCollectionNotLoadedError(false),
+      _keyGeneratorBlockSize(0),
+      _startupThreads((std::max)(static_cast<uint64_t>(1),
+                                 (std::min)(static_cast<uint64_t>(
+                                                TRI_numberProcessors()),
+                                            static_cast<uint64_t>(16)))),
       _vocbase(nullptr),
       _databasesLists(new DatabasesLists()),
       _isInitiallyEmpty(false),
@@ -282,6 +290,18 @@ void DatabaseFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
       "throw an error when accessing a collection that is still loading",
       new AtomicBooleanParameter(&_throwCollectionNotLoadedError));
 
+  options->addOption(
+      "--database.key-generator-block-size",
+      "number of keys the traditional key generator reserves per thread at "
+      "once, keys are then only ascending per thread (0 = off)",
+      new UInt64Parameter(&_keyGeneratorBlockSize));
+
+  options->addOption(
+      "--database.startup-threads",
+      "number of threads opening the databases and their collections at "
+      "startup (_system is always opened first)",
+      new UInt64Parameter(&_startupThreads));
+
   options->addHiddenOption(
       "--database.check-30-revisions",
       "check _rev values in collections created before 3.1",
@@ -310,6 +330,12 @@ void DatabaseFeature::validateOptions(std::shared_ptr<ProgramOptions> options) {
     FATAL_ERROR_EXIT();
   }
 
+  if (_startupThreads == 0) {
+    _startupThreads = 1;
+  } else if (_startupThreads > 64) {
+    _startupThreads = 64;
+  }
+
   // sanity check
   if (_checkVersion && _upgrade) {
     LOG_TOPIC(FATAL, arangodb::Logger::FIXME) << "cannot specify both '--database.check-version' and "
@@ -318,7 +344,9 @@ void DatabaseFeature::validateOptions(std::shared_ptr<ProgramOptions> options) {
   }
 }
 
-void DatabaseFeature::prepare() {}
+void DatabaseFeature::prepare() {
+  KeyGenerator::setTickBlockSize(_keyGeneratorBlockSize);
+}
 
 void DatabaseFeature::start() {
   // set singleton
@@ -685,9 +713,7 @@ int DatabaseFeature::dropDatabase(std::string const& name, bool waitForDeletion,
     vocbase->setIsOwnAppsDirectory(removeAppsDirectory);
 
     // invalidate all entries for the database
-#if USE_PLAN_CACHE
     arangodb::aql::PlanCache::instance()->invalidate(vocbase);
-#endif
     arangodb::aql::QueryCache::instance()->invalidate(vocbase);
 
     engine->prepareDropDatabase(*vocbase, !engine->inRecovery(), res);
@@ -1111,8 +1137,6 @@ int DatabaseFeature::iterateDatabases(VPackSlice const& databases) {
       ApplicationServer::getFeature<V8DealerFeature>("V8Dealer");
   std::string const appPath = dealer->appPath();
 
-  StorageEngine* engine = EngineSelectorFeature::ENGINE;
-
   int res = TRI_ERROR_NO_ERROR;
 
   // open databases in defined order
@@ -1120,63 +1144,111 @@ int DatabaseFeature::iterateDatabases(VPackSlice const& databases) {
 
   auto oldLists = _databasesLists.load();
   auto newLists = new DatabasesLists(*oldLists);
-  
-  ServerState::RoleEnum role = arangodb::ServerState::instance()->getRole();
 
-  try {
-    for (auto const& it : VPackArrayIterator(databases)) {
-      TRI_ASSERT(it.isObject());
+  // _system is opened first and alone, then the others in parallel
+  std::vector<VPackSlice> toOpen;
+  for (auto const& it : VPackArrayIterator(databases)) {
+    TRI_ASSERT(it.isObject());
 
-      LOG_TOPIC(TRACE, Logger::FIXME) << "processing database: " << it.toJson();
+    LOG_TOPIC(TRACE, Logger::FIXME) << "processing database: " << it.toJson();
 
-      VPackSlice deleted = it.get("deleted");
-      if (deleted.isBoolean() && deleted.getBoolean()) {
-        // ignore deleted databases here
-        continue;
-      }
-      
-      std::string const databaseName = it.get("name").copyString();
-      
-      // create app directory for database if it does not exist
-      res = createApplicationDirectory(databaseName, appPath);
+    VPackSlice deleted = it.get("deleted");
+    if (deleted.isBoolean() && deleted.getBoolean()) {
+      // ignore deleted databases here
+      continue;
+    }
 
-      if (res != TRI_ERROR_NO_ERROR) {
-        break;
-      }
+    std::string const databaseName = it.get("name").copyString();
 
-      // open the database and scan collections in it
+    // create app directory for database if it does not exist
+    res = createApplicationDirectory(databaseName, appPath);
 
-      // try to open this database
-      auto* database = engine->openDatabase(it, _upgrade).release();
+    if (res != TRI_ERROR_NO_ERROR) {
+      delete newLists;
+      return res;
+    }
 
-      if (!ServerState::isCoordinator(role) && !ServerState::isAgent(role)) {
-        try {
-          database->addReplicationApplier();
-        } catch (std::exception const& ex) {
-          LOG_TOPIC(FATAL, arangodb::Logger::FIXME) << "initializing replication applier for database '"
-          << database->name() << "' failed: " << ex.what();
-          FATAL_ERROR_EXIT();
+    if (databaseName == TRI_VOC_SYSTEM_DATABASE) {
+      toOpen.insert(toOpen.begin(), it);
+    } else {
+      toOpen.push_back(it);
+    }
+  }
+
+  std::vector<TRI_vocbase_t*> opened(toOpen.size(), nullptr);
+  std::vector<std::string> errors(toOpen.size());
+
+  auto openOne = [this, &toOpen, &opened, &errors](size_t pos) {
+    try {
+      opened[pos] = openDatabase(toOpen[pos]);
+    } catch (std::exception const& ex) {
+      errors[pos] = ex.what();
+    } catch (...) {
+      errors[pos] = "unknown exception";
+    }
+  };
+
+  if (!toOpen.empty()) {
+    openOne(0);
+  }
+
+  size_t const numThreads = static_cast<size_t>(
+      (std::min)(_startupThreads, static_cast<uint64_t>(toOpen.size())));
+
+  if (toOpen.size() > 1 && errors[0].empty()) {
+    // the threads take the next database until all are opened. every
+    // database opens its collections, indexes and views itself
+    std::atomic<size_t> next{1};
+    auto work = [&next, &toOpen, &openOne]() {
+      while (true) {
+        size_t const pos = next.fetch_add(1);
+        if (pos >= toOpen.size()) {
+          break;
         }
+        openOne(pos);
       }
+    };
 
-      if (databaseName == TRI_VOC_SYSTEM_DATABASE) {
-        // found the system database
-        TRI_ASSERT(_vocbase == nullptr);
-        _vocbase = database;
+    std::vector<std::thread> threads;
+    try {
+      for (size_t i = 1; i < numThreads; ++i) {
+        threads.emplace_back(work);
       }
+    } catch (...) {
+      // go on with the threads we have got
+    }
+    work();
+    for (auto& t : threads) {
+      t.join();
+    }
+  }
+
+  LOG_TOPIC(DEBUG, Logger::FIXME) << "opened " << toOpen.size()
+                                  << " database(s) with " << numThreads
+                                  << " thread(s)";
 
-      newLists->_databases.insert(std::make_pair(database->name(), database));
+  for (size_t i = 0; i < toOpen.size(); ++i) {
+    if (!errors[i].empty()) {
+      for (auto* database : opened) {
+        delete database;
+      }
+      delete newLists;
+
+      LOG_TOPIC(FATAL, arangodb::Logger::FIXME) << "cannot start database: "
+                                                << errors[i];
+      FATAL_ERROR_EXIT();
     }
-  } catch (std::exception const& ex) {
-    delete newLists;
+  }
 
-    LOG_TOPIC(FATAL, arangodb::Logger::FIXME) << "cannot start database: " << ex.what();
-    FATAL_ERROR_EXIT();
-  } catch (...) {
-    delete newLists;
+  for (auto* database : opened) {
+    TRI_ASSERT(database != nullptr);
+    if (database->name() == TRI_VOC_SYSTEM_DATABASE) {
+      // found the system database
+      TRI_ASSERT(_vocbase == nullptr);
+      _vocbase = database;
+    }
 
-    LOG_TOPIC(FATAL, arangodb::Logger::FIXME) << "cannot start database: unknown exception";
-    FATAL_ERROR_EXIT();
+    newLists->_databases.insert(std::make_pair(database->name(), database));
   }
 
   _databasesLists = newLists;
@@ -1186,6 +1258,29 @@ int DatabaseFeature::iterateDatabases(VPackSlice const& databases) {
   return res;
 }
 
+/// @brief opens one database of iterateDatabases, may be called by many
+/// threads at once
+TRI_vocbase_t* DatabaseFeature::openDatabase(VPackSlice const& info) {
+  StorageEngine* engine = EngineSelectorFeature::ENGINE;
+
+  // open the database and scan collections in it
+  std::unique_ptr<TRI_vocbase_t> database = engine->openDatabase(info, _upgrade);
+
+  ServerState::RoleEnum role = arangodb::ServerState::instance()->getRole();
+
+  if (!ServerState::isCoordinator(role) && !ServerState::isAgent(role)) {
+    try {
+      database->addReplicationApplier();
+    } catch (std::exception const& ex) {
+      LOG_TOPIC(FATAL, arangodb::Logger::FIXME) << "initializing replication applier for database '"
+      << database->name() << "' failed: " << ex.what();
+      FATAL_ERROR_EXIT();
+    }
+  }
+
+  return database.release();
+}
+
 /// @brief close all dropped databases
 void DatabaseFeature::closeDroppedDatabases() {
   MUTEX_LOCKER(mutexLocker, _databasesMutex);
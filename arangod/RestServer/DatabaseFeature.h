@@ -151,6 +151,9 @@ class DatabaseFeature : public application_features::ApplicationFeature {
   /// @brief iterate over all databases in the databases directory and open them
   int iterateDatabases(arangodb::velocypack::Slice const& databases);
 
+  /// @brief open one database at startup, on any of the startup threads
+  TRI_vocbase_t* openDatabase(arangodb::velocypack::Slice const& info);
+
   /// @brief close all opened databases
   void closeOpenDatabases();
 
@@ -169,7 +172,8 @@ class DatabaseFeature : public application_features::ApplicationFeature {
   bool _ignoreDatafileErrors;
   std::string _check30Revisions;
   std::atomic<bool> _throwCollectionNotLoadedError;
-
+  uint64_t _keyGeneratorBlockSize;
+  uint64_t _startupThreads;
 
   TRI_vocbase_t* _vocbase; // _system database
   std::unique_ptr<DatabaseManagerThread> _databaseManager;
@@ -22,6 +22,7 @@
 
 #include "QueryRegistryFeature.h"
 
+#include "Aql/PlanCache.h"
 #include "Aql/Query.h"
 #include "Aql/QueryCache.h"
 #include "Aql/QueryRegistry.h"
@@ -40,10 +41,16 @@ QueryRegistryFeature::QueryRegistryFeature(ApplicationServer* server)
       _trackSlowQueries(true),
       _trackBindVars(true),
       _failOnWarning(false),
+      _remotePrefetch(true),
+      _snippetPrefetch(true),
       _queryMemoryLimit(0),
+      _sortSpillThreshold(0),
+      _collectSpillThreshold(0),
+      _hashJoinMemoryLimit(128 * 1024 * 1024),
       _slowQueryThreshold(10.0),
       _queryCacheMode("off"),
       _queryCacheEntries(128),
+      _planCacheEntries(128),
       _queryRegistryTTL(DefaultQueryTTL) {
   setOptional(false);
   startsAfter("DatabasePath");
@@ -62,6 +69,26 @@ void QueryRegistryFeature::collectOptions(
   options->addOption("--query.memory-limit", "memory threshold for AQL queries (in bytes)",
                      new UInt64Parameter(&_queryMemoryLimit));
 
+  options->addOption("--query.sort-spill-threshold",
+                     "number of rows a SORT may keep in memory before spilling sorted runs to disk (0 = never spill)",
+                     new UInt64Parameter(&_sortSpillThreshold));
+
+  options->addOption("--query.collect-spill-threshold",
+                     "number of groups a hash COLLECT may keep in memory before spilling input rows to disk (0 = never spill)",
+                     new UInt64Parameter(&_collectSpillThreshold));
+
+  options->addOption("--query.hash-join-memory-limit",
+                     "number of bytes the hash table of a hash join may use before the join falls back to a nested loop (0 = no limit)",
+                     new UInt64Parameter(&_hashJoinMemoryLimit));
+
+  options->addOption("--query.remote-prefetch",
+                     "whether coordinators request the next batch of results from the DB servers before the current one has been consumed",
+                     new BooleanParameter(&_remotePrefetch));
+
+  options->addOption("--query.snippet-prefetch",
+                     "whether DB servers compute the next batch of results of a query snippet before the coordinator asks for it",
+                     new BooleanParameter(&_snippetPrefetch));
+
   options->addOption("--query.tracking", "whether to track slow AQL queries",
                      new BooleanParameter(&_trackSlowQueries));
   
@@ -81,6 +108,11 @@ void QueryRegistryFeature::collectOptions(
   options->addOption("--query.cache-entries",
                      "maximum number of results in query result cache per database",
                      new UInt64Parameter(&_queryCacheEntries));
+
+  options->addOption("--query.plan-cache-entries",
+                     "maximum number of execution plans in the AQL plan cache (0 = disable the plan cache)",
+                     new UInt64Parameter(&_planCacheEntries));
+
   options->addHiddenOption("--query.registry-ttl", "Default time-to-live of query snippets (in seconds)",
                            new DoubleParameter(&_queryRegistryTTL));
 }
@@ -90,6 +122,9 @@ void QueryRegistryFeature::prepare() {
   std::pair<std::string, size_t> cacheProperties{_queryCacheMode,
                                                  _queryCacheEntries};
   arangodb::aql::QueryCache::instance()->setProperties(cacheProperties);
+
+  // configure the plan cache
+  arangodb::aql::PlanCache::instance()->maxEntries(static_cast<size_t>(_planCacheEntries));
   
   if (_queryRegistryTTL <= 0) {
     _queryRegistryTTL = DefaultQueryTTL;
@@ -49,16 +49,27 @@ class QueryRegistryFeature final : public application_features::ApplicationFeatu
   bool trackBindVars() const { return _trackBindVars; }
   double slowQueryThreshold() const { return _slowQueryThreshold; }
   bool failOnWarning() const { return _failOnWarning; }
+  bool remotePrefetch() const { return _remotePrefetch; }
+  bool snippetPrefetch() const { return _snippetPrefetch; }
   uint64_t queryMemoryLimit() const { return _queryMemoryLimit; }
+  uint64_t sortSpillThreshold() const { return _sortSpillThreshold; }
+  uint64_t collectSpillThreshold() const { return _collectSpillThreshold; }
+  uint64_t hashJoinMemoryLimit() const { return _hashJoinMemoryLimit; }
 
  private:
   bool _trackSlowQueries;
   bool _trackBindVars;
   bool _failOnWarning;
+  bool _remotePrefetch;
+  bool _snippetPrefetch;
   uint64_t _queryMemoryLimit;
+  uint64_t _sortSpillThreshold;
+  uint64_t _collectSpillThreshold;
+  uint64_t _hashJoinMemoryLimit;
   double _slowQueryThreshold;
   std::string _queryCacheMode;
   uint64_t _queryCacheEntries;
+  uint64_t _planCacheEntries;
   double _queryRegistryTTL;
 
  public:
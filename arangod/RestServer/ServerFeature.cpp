@@ -106,6 +106,13 @@ void ServerFeature::validateOptions(std::shared_ptr<ProgramOptions> options) {
     FATAL_ERROR_EXIT();
   }
 
+  if (_vstMaxSize < 1024) {
+    // a chunk must at least hold its header and some data
+    LOG_TOPIC(WARN, arangodb::Logger::FIXME)
+        << "'--vst.maxsize' must be at least 1024, using 1024";
+    _vstMaxSize = 1024;
+  }
+
   if (_operationMode == OperationMode::MODE_SERVER && !_restServer) {
     LOG_TOPIC(FATAL, arangodb::Logger::FIXME) << "need at least '--console', '--javascript.unit-tests' or"
                << "'--javascript.script if rest-server is disabled";
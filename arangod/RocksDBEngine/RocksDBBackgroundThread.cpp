@@ -21,12 +21,15 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "RocksDBBackgroundThread.h"
+#include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/ConditionLocker.h"
+#include "Cache/CacheManagerFeature.h"
 #include "RestServer/DatabaseFeature.h"
 #include "RocksDBEngine/RocksDBCommon.h"
 #include "RocksDBEngine/RocksDBEngine.h"
 #include "RocksDBEngine/RocksDBReplicationManager.h"
 #include "RocksDBEngine/RocksDBSettingsManager.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "Utils/CursorRepository.h"
 
 using namespace arangodb;
@@ -47,6 +50,8 @@ void RocksDBBackgroundThread::beginShutdown() {
 
 void RocksDBBackgroundThread::run() {
   double const startTime = TRI_microtime();
+  bool warmupPending = _engine->warmupOnStartup();
+  bool cacheKeysPending = _engine->cacheKeysPending();
 
   while (!isStopping()) {
     {
@@ -74,6 +79,30 @@ void RocksDBBackgroundThread::run() {
         }
       }
 
+      // the index caches can only be loaded once all databases are opened
+      // and the scheduler is running
+      if (warmupPending && !isStopping() &&
+          application_features::ApplicationServer::server != nullptr &&
+          application_features::ApplicationServer::server->state() ==
+              application_features::ServerState::IN_WAIT &&
+          SchedulerFeature::SCHEDULER != nullptr) {
+        warmupPending = false;
+        _engine->warmupCaches();
+      }
+
+      // same for the cache keys written by the last shutdown. the file is
+      // removed once it was read
+      if (cacheKeysPending && !isStopping() &&
+          application_features::ApplicationServer::server != nullptr &&
+          application_features::ApplicationServer::server->state() ==
+              application_features::ServerState::IN_WAIT &&
+          SchedulerFeature::SCHEDULER != nullptr) {
+        cacheKeysPending = false;
+        if (CacheManagerFeature::MANAGER != nullptr) {
+          _engine->reloadCacheKeys();
+        }
+      }
+
       bool force = isStopping();
       _engine->replicationManager()->garbageCollect(force);
 
@@ -84,6 +113,12 @@ void RocksDBBackgroundThread::run() {
         minTick = cmTick;
       }
 
+      // index builds catch up from the WAL
+      auto pinnedTick = _engine->earliestPinnedWal();
+      if (pinnedTick < minTick) {
+        minTick = pinnedTick;
+      }
+
       if (DatabaseFeature::DATABASE != nullptr) {
         DatabaseFeature::DATABASE->enumerateDatabases(
           [&minTick](TRI_vocbase_t& vocbase)->void {
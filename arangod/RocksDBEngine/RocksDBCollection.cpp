@@ -22,8 +22,10 @@
 
 #include "RocksDBCollection.h"
 #include "Aql/PlanCache.h"
+#include "Aql/QueryCounters.h"
 #include "Basics/ReadLocker.h"
 #include "Basics/Result.h"
+#include "Basics/ScopeGuard.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/StringUtils.h"
 #include "Basics/VelocyPackHelper.h"
@@ -39,16 +41,20 @@
 #include "RocksDBEngine/RocksDBPrimaryIndex.h"
 #include "RocksDBEngine/RocksDBCommon.h"
 #include "RocksDBEngine/RocksDBComparator.h"
+#include "RocksDBEngine/RocksDBCuckooIndexEstimator.h"
 #include "RocksDBEngine/RocksDBEngine.h"
+#include "RocksDBEngine/RocksDBIndexBuilder.h"
 #include "RocksDBEngine/RocksDBIterators.h"
 #include "RocksDBEngine/RocksDBKey.h"
 #include "RocksDBEngine/RocksDBLogValue.h"
 #include "RocksDBEngine/RocksDBMethods.h"
 #include "RocksDBEngine/RocksDBPrimaryIndex.h"
+#include "RocksDBEngine/RocksDBRevisionTree.h"
 #include "RocksDBEngine/RocksDBSettingsManager.h"
 #include "RocksDBEngine/RocksDBTransactionCollection.h"
 #include "RocksDBEngine/RocksDBTransactionState.h"
 #include "RocksDBEngine/RocksDBValue.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "StorageEngine/StorageEngine.h"
 #include "StorageEngine/TransactionState.h"
@@ -94,6 +100,18 @@ struct IndexingDisabler {
   bool const disableIndexing;
 };
 
+namespace {
+/// @brief replace a compressed document in the string by the document
+void uncompressDocument(std::string& value) {
+  if (!value.empty() && static_cast<uint8_t>(value[0]) ==
+                            RocksDBValue::compressedDocumentMarker) {
+    std::string buffer;
+    RocksDBValue::document(value.data(), value.size(), buffer);
+    value.swap(buffer);
+  }
+}
+}
+
 RocksDBCollection::RocksDBCollection(LogicalCollection* collection,
                                      VPackSlice const& info)
     : PhysicalCollection(collection, info),
@@ -105,7 +123,11 @@ RocksDBCollection::RocksDBCollection(LogicalCollection* collection,
       _cachePresent(false),
       _cacheEnabled(!collection->system() &&
                     basics::VelocyPackHelper::readBooleanValue(
-                        info, "cacheEnabled", false)) {
+                        info, "cacheEnabled", false)),
+      _compressDocuments(!collection->system() &&
+                         basics::VelocyPackHelper::readBooleanValue(
+                             info, "compressDocuments", false)),
+      _revisionTree(std::make_unique<RocksDBRevisionTree>()) {
   TRI_ASSERT(!ServerState::instance()->isCoordinator());
   VPackSlice s = info.get("isVolatile");
   if (s.isBoolean() && s.getBoolean()) {
@@ -133,7 +155,10 @@ RocksDBCollection::RocksDBCollection(LogicalCollection* collection,
       _cache(nullptr),
       _cachePresent(false),
       _cacheEnabled(
-          static_cast<RocksDBCollection const*>(physical)->_cacheEnabled) {
+          static_cast<RocksDBCollection const*>(physical)->_cacheEnabled),
+      _compressDocuments(
+          static_cast<RocksDBCollection const*>(physical)->_compressDocuments),
+      _revisionTree(std::make_unique<RocksDBRevisionTree>()) {
   TRI_ASSERT(!ServerState::instance()->isCoordinator());
   rocksutils::globalRocksEngine()->addCollectionMapping(
     _objectId, _logicalCollection->vocbase().id(), _logicalCollection->id()
@@ -169,6 +194,11 @@ Result RocksDBCollection::updateProperties(VPackSlice const& slice,
                                 slice, "cacheEnabled", _cacheEnabled);
   primaryIndex()->setCacheEnabled(_cacheEnabled);
 
+  // only affects documents written from now on. all read paths handle
+  // compressed and uncompressed documents
+  _compressDocuments = !isSys && basics::VelocyPackHelper::readBooleanValue(
+                                     slice, "compressDocuments", _compressDocuments);
+
   if (_cacheEnabled) {
     createCache();
     primaryIndex()->createCache();
@@ -198,6 +228,7 @@ void RocksDBCollection::getPropertiesVPack(velocypack::Builder& result) const {
   TRI_ASSERT(result.isOpenObject());
   result.add("objectId", VPackValue(std::to_string(_objectId)));
   result.add("cacheEnabled", VPackValue(_cacheEnabled));
+  result.add("compressDocuments", VPackValue(_compressDocuments));
   TRI_ASSERT(result.isOpenObject());
 }
 
@@ -376,16 +407,35 @@ std::shared_ptr<Index> RocksDBCollection::createIndex(
   );
   TRI_ASSERT(idx != nullptr);
 
-  int res = saveIndex(trx, idx);
+  int res;
+  if (canBuildIndexOnline(trx, idx.get())) {
+    Result r = buildIndexOnline(trx, idx);
+    if (r.fail()) {
+      THROW_ARANGO_EXCEPTION(r);
+    }
+    // the collection was not locked while the index was filled, so the
+    // same index may have been created by someone else in the meantime
+    std::shared_ptr<Index> other;
+    {
+      READ_LOCKER(guard, _indexesLock);
+      other = findIndex(info, _indexes);
+    }
+    if (other) {
+      static_cast<RocksDBIndex*>(idx.get())->drop();
+      created = false;
+      return other;
+    }
+    res = TRI_ERROR_NO_ERROR;
+  } else {
+    res = saveIndex(trx, idx);
+  }
 
   if (res != TRI_ERROR_NO_ERROR) {
     THROW_ARANGO_EXCEPTION(res);
   }
 
-#if USE_PLAN_CACHE
   arangodb::aql::PlanCache::instance()->invalidate(
-      _logicalCollection->vocbase());
-#endif
+      &_logicalCollection->vocbase());
   // Until here no harm is done if something fails. The shared_ptr will
   // clean up, if left before
   {
@@ -422,6 +472,8 @@ std::shared_ptr<Index> RocksDBCollection::createIndex(
     }
     THROW_ARANGO_EXCEPTION(res);
   }
+  // the estimates of the new index have to be written by the next sync
+  static_cast<RocksDBEngine*>(engine)->settingsManager()->markDirty(_objectId);
   created = true;
   return idx;
 }
@@ -513,6 +565,7 @@ int RocksDBCollection::restoreIndex(transaction::Methods* trx,
       }
       return res;
     }
+    engine->settingsManager()->markDirty(_objectId);
   }
 
   idx = newIdx;
@@ -578,8 +631,29 @@ bool RocksDBCollection::dropIndex(TRI_idx_iid_t iid) {
 }
 
 std::unique_ptr<IndexIterator> RocksDBCollection::getAllIterator(transaction::Methods* trx) const {
+  return createAllIterator(trx, false);
+}
+
+std::unique_ptr<IndexIterator> RocksDBCollection::getScanIterator(
+    transaction::Methods* trx) const {
+  return createAllIterator(trx, true);
+}
+
+std::unique_ptr<IndexIterator> RocksDBCollection::createAllIterator(
+    transaction::Methods* trx, bool fullScan) const {
+  // large collections are read ahead in parallel. this is only possible
+  // in read-only transactions, whose iterators work on a plain snapshot
+  RocksDBEngine* engine = rocksutils::globalRocksEngine();
+  uint64_t const threads = engine->parallelScanThreads();
+  if (threads > 1 && SchedulerFeature::SCHEDULER != nullptr &&
+      trx->state()->isReadOnlyTransaction() &&
+      numberDocuments(trx) >= engine->parallelScanMinDocuments()) {
+    return std::unique_ptr<IndexIterator>(new RocksDBParallelAllIndexIterator(
+        _logicalCollection, trx, primaryIndex(), static_cast<size_t>(threads),
+        fullScan));
+  }
   return std::unique_ptr<IndexIterator>(new RocksDBAllIndexIterator(
-                                  _logicalCollection, trx, primaryIndex()));
+      _logicalCollection, trx, primaryIndex(), fullScan));
 }
 
 std::unique_ptr<IndexIterator> RocksDBCollection::getAnyIterator(
@@ -616,6 +690,12 @@ void RocksDBCollection::truncate(transaction::Methods* trx,
                                  OperationOptions& options) {
   TRI_ASSERT(_objectId != 0);
   auto state = RocksDBTransactionState::toState(trx);
+
+  if (canTruncateWithRangeDelete(state)) {
+    truncateWithRangeDelete();
+    return;
+  }
+
   RocksDBMethods* mthd = state->rocksdbMethods();
   // delete documents
   RocksDBKeyBounds documentBounds =
@@ -635,10 +715,11 @@ void RocksDBCollection::truncate(transaction::Methods* trx,
   iter->Seek(documentBounds.start());
 
   uint64_t found = 0;
+  std::string documentBuffer;
   while (iter->Valid() && cmp->Compare(iter->key(), end) < 0) {
     ++found;
     TRI_ASSERT(_objectId == RocksDBKey::objectId(iter->key()));
-    VPackSlice doc = VPackSlice(iter->value().data());
+    VPackSlice doc = RocksDBValue::document(iter->value(), documentBuffer);
     TRI_ASSERT(doc.isObject());
 
     // To print the WAL we need key and RID
@@ -705,6 +786,101 @@ void RocksDBCollection::truncate(transaction::Methods* trx,
   }
 }
 
+/// @brief whether or not the collection can be truncated by deleting its
+/// key ranges outside of the transaction. this is only safe if the
+/// transaction is a standalone truncate on an exclusively locked collection,
+/// and only worth it for larger collections
+bool RocksDBCollection::canTruncateWithRangeDelete(
+    RocksDBTransactionState const* state) const {
+  if (!state->hasHint(transaction::Hints::Hint::ALLOW_RANGE_DELETE) ||
+      !state->isExclusiveTransactionOnSingleCollection() ||
+      state->hasOperations() || state->numCommits() > 0 ||
+      _numberDocuments < 32 * 1024) {
+    return false;
+  }
+
+  READ_LOCKER(guard, _indexesLock);
+#ifdef USE_IRESEARCH
+  for (std::shared_ptr<Index> const& idx : _indexes) {
+    if (idx->type() == Index::TRI_IDX_TYPE_IRESEARCH_LINK) {
+      // data of links is not stored in RocksDB
+      return false;
+    }
+  }
+#endif
+  return true;
+}
+
+/// @brief truncate the collection by deleting the key ranges of the
+/// documents and all indexes in a single write batch, bypassing the
+/// transaction. the batch starts with a log marker so that recovery and
+/// replication can reset the counter and the index estimates
+void RocksDBCollection::truncateWithRangeDelete() {
+  RocksDBEngine* engine = rocksutils::globalRocksEngine();
+  rocksdb::TransactionDB* db = rocksutils::globalRocksDB();
+  // range deletes are not supported by the transaction db itself
+  rocksdb::DB* baseDB = db->GetBaseDB();
+
+  rocksdb::WriteBatch batch;
+  RocksDBLogValue log = RocksDBLogValue::CollectionTruncate(
+      _logicalCollection->vocbase().id(), _logicalCollection->id(), _objectId);
+  rocksdb::Status s = batch.PutLogData(log.slice());
+
+  RocksDBKeyBounds bounds = RocksDBKeyBounds::CollectionDocuments(_objectId);
+  if (s.ok()) {
+    s = batch.DeleteRange(bounds.columnFamily(), bounds.start(), bounds.end());
+  }
+
+  READ_LOCKER(guard, _indexesLock);
+  for (std::shared_ptr<Index> const& idx : _indexes) {
+    if (!s.ok()) {
+      break;
+    }
+    bounds = static_cast<RocksDBIndex*>(idx.get())->getBounds();
+    s = batch.DeleteRange(bounds.columnFamily(), bounds.start(), bounds.end());
+  }
+
+  if (s.ok()) {
+    s = baseDB->Write(rocksdb::WriteOptions(), &batch);
+  }
+  if (!s.ok()) {
+    THROW_ARANGO_EXCEPTION(rocksutils::convertStatus(s));
+  }
+
+  rocksdb::SequenceNumber const seq = db->GetLatestSequenceNumber();
+  uint64_t const numDocs = _numberDocuments.exchange(0);
+  engine->settingsManager()->updateCounter(
+      _objectId, RocksDBSettingsManager::CounterAdjustment(
+                     seq, 0, numDocs, _revisionId.load()));
+
+  _revisionTree->truncate();
+
+  for (std::shared_ptr<Index> const& idx : _indexes) {
+    auto est = static_cast<RocksDBIndex*>(idx.get())->estimator();
+    if (est != nullptr) {
+      est->bufferTruncate(seq);
+    }
+    // clears the index caches
+    idx->afterTruncate();
+  }
+  guard.unlock();
+
+  if (useCache()) {
+    destroyCache();
+    createCache();
+  }
+
+  LOG_TOPIC(DEBUG, Logger::ENGINES)
+      << "truncated collection " << _logicalCollection->name()
+      << " with range deletes, removed " << numDocs << " documents";
+
+  if (numDocs > 64 * 1024) {
+    // also compact the ranges in order to speed up all further accesses
+    // to the collection
+    compact();
+  }
+}
+
 LocalDocumentId RocksDBCollection::lookupKey(transaction::Methods* trx,
                                              VPackSlice const& key) const {
   TRI_ASSERT(key.isString());
@@ -744,6 +920,106 @@ bool RocksDBCollection::readDocumentWithCallback(
   return false;
 }
 
+// read multiple documents using tokens. documents found in the cache are
+// not looked up, all others are read with a single MultiGet
+void RocksDBCollection::readDocumentsWithCallback(
+    transaction::Methods* trx, std::vector<LocalDocumentId> const& tokens,
+    IndexIterator::DocumentCallback const& cb) const {
+  if (tokens.size() <= 1) {
+    for (auto const& token : tokens) {
+      readDocumentWithCallback(trx, token, cb);
+    }
+    return;
+  }
+
+  TRI_ASSERT(trx->state()->isRunning());
+  TRI_ASSERT(_objectId != 0);
+
+  size_t const n = tokens.size();
+  std::vector<RocksDBKey> keys;
+  keys.reserve(n);
+  // documents in the order of the tokens. unset tokens and documents that
+  // are not found remain empty
+  std::vector<std::string> values(n);
+  // positions of the documents that have to be read from RocksDB
+  std::vector<size_t> lookups;
+  lookups.reserve(n);
+  bool lockTimeout = false;
+
+  for (size_t i = 0; i < n; ++i) {
+    keys.emplace_back();
+    if (!tokens[i].isSet()) {
+      continue;
+    }
+    keys.back().constructDocument(_objectId, tokens[i]);
+
+    if (useCache()) {
+      TRI_ASSERT(_cache != nullptr);
+      auto f = _cache->find(keys.back().string().data(),
+                            static_cast<uint32_t>(keys.back().string().size()));
+      aql::QueryCounters::documentCacheLookup(f.found());
+      if (f.found()) {
+        values[i].assign(reinterpret_cast<char const*>(f.value()->value()),
+                         f.value()->valueSize());
+        continue;
+      } else if (f.result().errorNumber() == TRI_ERROR_LOCK_TIMEOUT) {
+        // assuming someone is currently holding a write lock, which
+        // is why we cannot access the TransactionalBucket.
+        lockTimeout = true;  // we skip the inserts in this case
+      }
+    }
+    lookups.emplace_back(i);
+  }
+
+  if (!lookups.empty()) {
+    std::vector<rocksdb::Slice> lookupKeys;
+    lookupKeys.reserve(lookups.size());
+    for (size_t const i : lookups) {
+      lookupKeys.emplace_back(keys[i].string());
+    }
+
+    std::vector<std::string> found;
+    RocksDBMethods* mthd = RocksDBTransactionState::toMethods(trx);
+    std::vector<Result> results =
+        mthd->MultiGet(RocksDBColumnFamily::documents(), lookupKeys, &found);
+    TRI_ASSERT(results.size() == lookups.size());
+    TRI_ASSERT(found.size() == lookups.size());
+
+    for (size_t j = 0; j < lookups.size(); ++j) {
+      size_t const i = lookups[j];
+      if (results[j].fail()) {
+        LOG_TOPIC(DEBUG, Logger::FIXME)
+            << "NOT FOUND rev: " << tokens[i].id()
+            << " trx: " << trx->state()->id()
+            << " objectID " << _objectId << " name: " << _logicalCollection->name();
+        continue;
+      }
+      values[i] = std::move(found[j]);
+
+      if (useCache() && !lockTimeout) {
+        TRI_ASSERT(_cache != nullptr);
+        // write entry back to cache
+        auto entry = cache::CachedValue::construct(
+            keys[i].string().data(), static_cast<uint32_t>(keys[i].string().size()),
+            values[i].data(), static_cast<uint64_t>(values[i].size()));
+        if (entry) {
+          auto status = _cache->insert(entry);
+          if (status.fail()) {
+            delete entry;
+          }
+        }
+      }
+    }
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    if (!values[i].empty()) {
+      ::uncompressDocument(values[i]);
+      cb(tokens[i], VPackSlice(values[i].data()));
+    }
+  }
+}
+
 Result RocksDBCollection::insert(arangodb::transaction::Methods* trx,
                                  arangodb::velocypack::Slice const slice,
                                  arangodb::ManagedDocumentResult& mdr,
@@ -1165,6 +1441,77 @@ int RocksDBCollection::saveIndex(transaction::Methods* trx,
   return TRI_ERROR_NO_ERROR;
 }
 
+/// @brief whether or not a new index can be filled by several threads
+/// while the collection is not locked. the collection lock is only given
+/// up temporarily if the transaction does nothing but create the index
+bool RocksDBCollection::canBuildIndexOnline(transaction::Methods* trx,
+                                            Index const* idx) const {
+  RocksDBEngine* engine = rocksutils::globalRocksEngine();
+  auto state = RocksDBTransactionState::toState(trx);
+  return engine->indexBuildThreads() > 1 &&
+         RocksDBIndexBuilder::supports(static_cast<RocksDBIndex const*>(idx)) &&
+         state->isExclusiveTransactionOnSingleCollection() &&
+         !state->hasOperations() && state->numCommits() == 0 &&
+         _numberDocuments >= engine->indexBuildMinDocuments();
+}
+
+/// @brief fill a new index with several threads. the exclusive collection
+/// lock, held by the caller, is given up while the documents of a snapshot
+/// are indexed and while the changes made in the meantime are caught up.
+/// it is taken again for a last catch-up round, which is short because it
+/// only covers the changes made during the round before
+arangodb::Result RocksDBCollection::buildIndexOnline(
+    transaction::Methods* trx, std::shared_ptr<arangodb::Index> added) {
+  TRI_ASSERT(trx->state()->collection(
+    _logicalCollection->id(), AccessMode::Type::EXCLUSIVE
+  ));
+  // stop catching up without the lock once a round changes fewer documents
+  uint64_t const minChangesForRound = 10000;
+  // but do not chase a collection that is written faster than it is indexed
+  size_t const maxRounds = 8;
+
+  RocksDBIndex* ridx = static_cast<RocksDBIndex*>(added.get());
+  RocksDBEngine* engine = rocksutils::globalRocksEngine();
+  RocksDBIndexBuilder builder(_logicalCollection, ridx,
+                              static_cast<size_t>(engine->indexBuildThreads()));
+
+  double const start = TRI_microtime();
+  uint64_t numChanged = 0;
+  Result res;
+  {
+    _exclusiveLock.unlockWrite();
+    auto relock = scopeGuard([this]() { _exclusiveLock.writeLock(); });
+
+    res = builder.fill();
+    for (size_t round = 0; res.ok() && round < maxRounds; ++round) {
+      res = builder.catchUp(trx, numChanged);
+      if (numChanged < minChangesForRound) {
+        break;
+      }
+    }
+  }
+
+  if (res.ok() && _logicalCollection->deleted()) {
+    res.reset(TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND);
+  }
+  if (res.ok()) {
+    res = builder.catchUp(trx, numChanged);
+  }
+
+  if (res.fail()) {
+    // remove the entries ingested so far
+    ridx->drop();
+    return res;
+  }
+
+  LOG_TOPIC(DEBUG, Logger::ENGINES)
+      << "filled index " << added->id() << " of collection '"
+      << _logicalCollection->name() << "' in "
+      << Logger::FIXED(TRI_microtime() - start, 2) << " s, the final "
+      << "catch-up applied " << numChanged << " document changes";
+  return res;
+}
+
 /// non-transactional: fill index with existing documents
 /// from this collection
 arangodb::Result RocksDBCollection::fillIndexes(
@@ -1177,7 +1524,7 @@ arangodb::Result RocksDBCollection::fillIndexes(
   RocksDBIndex* ridx = static_cast<RocksDBIndex*>(added.get());
   auto state = RocksDBTransactionState::toState(trx);
   std::unique_ptr<IndexIterator> it(new RocksDBAllIndexIterator(
-      _logicalCollection, trx, primaryIndex()));
+      _logicalCollection, trx, primaryIndex(), true));
 
   // fillindex can be non transactional, we just need to clean up
   rocksdb::DB* db = rocksutils::globalRocksDB()->GetBaseDB();
@@ -1251,6 +1598,17 @@ arangodb::Result RocksDBCollection::fillIndexes(
   return res;
 }
 
+/// @brief the value under which a document is stored. compressed values
+/// are built in the buffer
+rocksdb::Slice RocksDBCollection::documentValue(VPackSlice const& doc,
+                                                std::string& buffer) const {
+  if (_compressDocuments && RocksDBValue::compressDocument(doc, buffer)) {
+    return rocksdb::Slice(buffer);
+  }
+  return rocksdb::Slice(reinterpret_cast<char const*>(doc.begin()),
+                        static_cast<size_t>(doc.byteSize()));
+}
+
 Result RocksDBCollection::insertDocument(
     arangodb::transaction::Methods* trx, LocalDocumentId const& documentId,
     VPackSlice const& doc, OperationOptions& options) const {
@@ -1264,9 +1622,9 @@ Result RocksDBCollection::insertDocument(
   blackListKey(key->string().data(), static_cast<uint32_t>(key->string().size()));
 
   RocksDBMethods* mthd = RocksDBTransactionState::toMethods(trx);
+  std::string buffer;
   Result res = mthd->Put(RocksDBColumnFamily::documents(), key.ref(),
-                         rocksdb::Slice(reinterpret_cast<char const*>(doc.begin()),
-                                        static_cast<size_t>(doc.byteSize())));
+                         documentValue(doc, buffer));
   if (!res.ok()) {
     return res;
   }
@@ -1288,6 +1646,11 @@ Result RocksDBCollection::insertDocument(
     }
   }
 
+  if (res.ok()) {
+    RocksDBTransactionState::toState(trx)->trackRevisionInsert(
+        _logicalCollection->id(), doc);
+  }
+
   return res;
 }
 
@@ -1333,6 +1696,11 @@ Result RocksDBCollection::removeDocument(
     }
   }
 
+  if (res.ok()) {
+    RocksDBTransactionState::toState(trx)->trackRevisionRemove(
+        _logicalCollection->id(), doc);
+  }
+
   return res;
 }
 
@@ -1356,8 +1724,8 @@ Result RocksDBCollection::updateDocument(
   // we really need to blacklist the new key?
   blackListKey(newKey->string().data(),
                static_cast<uint32_t>(newKey->string().size()));
-  rocksdb::Slice docSlice(reinterpret_cast<char const*>(newDoc.begin()),
-                          static_cast<size_t>(newDoc.byteSize()));
+  std::string buffer;
+  rocksdb::Slice docSlice = documentValue(newDoc, buffer);
 
   // disable indexing in this transaction if we are allowed to
   IndexingDisabler disabler(mthd, trx->isSingleOperationTransaction());
@@ -1391,6 +1759,12 @@ Result RocksDBCollection::updateDocument(
     }
   }
 
+  if (res.ok()) {
+    RocksDBTransactionState* state = RocksDBTransactionState::toState(trx);
+    state->trackRevisionRemove(_logicalCollection->id(), oldDoc);
+    state->trackRevisionInsert(_logicalCollection->id(), newDoc);
+  }
+
   return res;
 }
 
@@ -1409,10 +1783,19 @@ arangodb::Result RocksDBCollection::lookupDocumentVPack(
     // check cache first for fast path
     auto f = _cache->find(key->string().data(),
                           static_cast<uint32_t>(key->string().size()));
+    aql::QueryCounters::documentCacheLookup(f.found());
     if (f.found()) {
+      uint8_t const* data = f.value()->value();
+      if (mdr.pinningEnabled() && f.value()->valueSize() > 0 &&
+          data[0] != RocksDBValue::compressedDocumentMarker) {
+        // hand out the cached document itself
+        mdr.setPinned(std::move(f), data, documentId);
+        return TRI_ERROR_NO_ERROR;
+      }
       std::string* value = mdr.prepareStringUsage();
       value->append(reinterpret_cast<char const*>(f.value()->value()),
                     f.value()->valueSize());
+      ::uncompressDocument(*value);
       mdr.setManagedAfterStringUsage(documentId);
       return TRI_ERROR_NO_ERROR;
     } else if (f.result().errorNumber() == TRI_ERROR_LOCK_TIMEOUT) {
@@ -1445,6 +1828,7 @@ arangodb::Result RocksDBCollection::lookupDocumentVPack(
       }
     }
 
+    ::uncompressDocument(*value);
     mdr.setManagedAfterStringUsage(documentId);
   } else {
     LOG_TOPIC(DEBUG, Logger::FIXME)
@@ -1471,9 +1855,12 @@ arangodb::Result RocksDBCollection::lookupDocumentVPack(
     // check cache first for fast path
     auto f = _cache->find(key->string().data(),
                           static_cast<uint32_t>(key->string().size()));
+    aql::QueryCounters::documentCacheLookup(f.found());
     if (f.found()) {
-      cb(documentId,
-         VPackSlice(reinterpret_cast<char const*>(f.value()->value())));
+      std::string buffer;
+      cb(documentId, RocksDBValue::document(
+                         reinterpret_cast<char const*>(f.value()->value()),
+                         f.value()->valueSize(), buffer));
       return TRI_ERROR_NO_ERROR;
     } else if (f.result().errorNumber() == TRI_ERROR_LOCK_TIMEOUT) {
       // assuming someone is currently holding a write lock, which
@@ -1507,7 +1894,8 @@ arangodb::Result RocksDBCollection::lookupDocumentVPack(
       }
     }
 
-    cb(documentId, VPackSlice(value.data()));
+    std::string buffer;
+    cb(documentId, RocksDBValue::document(value.data(), value.size(), buffer));
   } else {
     LOG_TOPIC(DEBUG, Logger::FIXME)
         << "NOT FOUND rev: " << documentId.id() << " trx: " << trx->state()->id()
@@ -1540,6 +1928,9 @@ int RocksDBCollection::lockWrite(double timeout) {
     if (locker.isLocked()) {
       // keep lock and exit loop
       locker.steal();
+      if (waitTime != 0) {
+        aql::QueryCounters::lockWait(TRI_microtime() - startTime);
+      }
       return TRI_ERROR_NO_ERROR;
     }
 
@@ -1555,6 +1946,7 @@ int RocksDBCollection::lockWrite(double timeout) {
     }
 
     if (now > startTime + timeout) {
+      aql::QueryCounters::lockWait(now - startTime);
       LOG_TOPIC(TRACE, arangodb::Logger::FIXME)
           << "timed out after " << timeout
           << " s waiting for write-lock on collection '"
@@ -1591,6 +1983,9 @@ int RocksDBCollection::lockRead(double timeout) {
     if (locker.isLocked()) {
       // keep lock and exit loop
       locker.steal();
+      if (waitTime != 0) {
+        aql::QueryCounters::lockWait(TRI_microtime() - startTime);
+      }
       return TRI_ERROR_NO_ERROR;
     }
 
@@ -1606,6 +2001,7 @@ int RocksDBCollection::lockRead(double timeout) {
     }
 
     if (now > startTime + timeout) {
+      aql::QueryCounters::lockWait(now - startTime);
       LOG_TOPIC(TRACE, arangodb::Logger::FIXME)
           << "timed out after " << timeout
           << " s waiting for read-lock on collection '"
@@ -1739,6 +2135,13 @@ RocksDBCollection::serializeIndexEstimates(
         }
       }
     }
+
+    Result res = cindex->serializeHistogram(rtrx);
+    if (res.fail()) {
+      LOG_TOPIC(WARN, Logger::ENGINES) << "writing index histogram failed";
+      rtrx->Rollback();
+      return std::make_pair(res, outputSeq);
+    }
   }
   return std::make_pair(Result(), outputSeq);
 }
@@ -1750,6 +2153,7 @@ void RocksDBCollection::deserializeIndexEstimates(RocksDBSettingsManager* mgr) {
     if (!idx->deserializeEstimate(mgr)) {
       toRecalculate.push_back(it);
     }
+    idx->deserializeHistogram();
   }
   if (!toRecalculate.empty()) {
     recalculateIndexEstimates(toRecalculate);
@@ -1785,6 +2189,7 @@ void RocksDBCollection::recalculateIndexEstimates(
     TRI_ASSERT(idx != nullptr);
     idx->recalculateEstimates();
   }
+  rocksutils::globalRocksEngine()->settingsManager()->markDirty(_objectId);
 
   trx.commit();
 }
@@ -1819,6 +2224,59 @@ void RocksDBCollection::deserializeKeyGenerator(RocksDBSettingsManager* mgr) {
   }
 }
 
+Result RocksDBCollection::ensureRevisionTree(
+    size_t rangeSize, std::vector<std::string> const* lows) {
+  return _revisionTree->ensureValid(rocksutils::globalRocksDB(), _objectId,
+                                    primaryIndex()->objectId(), rangeSize,
+                                    lows);
+}
+
+std::pair<arangodb::Result, rocksdb::SequenceNumber>
+RocksDBCollection::serializeRevisionTree(
+    rocksdb::Transaction* rtrx, rocksdb::SequenceNumber inputSeq) const {
+  std::string output;
+  rocksdb::SequenceNumber outputSeq;
+  if (!_revisionTree->serialize(output, inputSeq, outputSeq)) {
+    // unchanged since it was last written
+    return std::make_pair(Result(), inputSeq);
+  }
+
+  RocksDBKey key;
+  key.constructRevisionTreeValue(_objectId);
+  rocksdb::Status s;
+  if (output.empty()) {
+    s = rtrx->Delete(RocksDBColumnFamily::definitions(), key.string());
+  } else {
+    s = rtrx->Put(RocksDBColumnFamily::definitions(), key.string(),
+                  rocksdb::Slice(output));
+  }
+
+  if (!s.ok()) {
+    LOG_TOPIC(WARN, Logger::ENGINES) << "writing revision tree failed";
+    rtrx->Rollback();
+    return std::make_pair(rocksutils::convertStatus(s), outputSeq);
+  }
+  return std::make_pair(Result(), outputSeq);
+}
+
+void RocksDBCollection::deserializeRevisionTree() {
+  RocksDBKey key;
+  key.constructRevisionTreeValue(_objectId);
+
+  rocksdb::PinnableSlice value;
+  rocksdb::Status s =
+      rocksutils::globalRocksDB()->Get(rocksdb::ReadOptions(),
+                                       RocksDBColumnFamily::definitions(),
+                                       key.string(), &value);
+  if (!s.ok() || value.size() <= sizeof(uint64_t)) {
+    // no tree yet. it is built when it is first needed
+    return;
+  }
+
+  _revisionTree->deserialize(rocksutils::uint64FromPersistent(value.data()),
+                             VPackSlice(value.data() + sizeof(uint64_t)));
+}
+
 void RocksDBCollection::createCache() const {
   if (!_cacheEnabled || _cachePresent || _logicalCollection->isAStub() ||
       ServerState::instance()->isCoordinator()) {
@@ -1850,6 +2308,29 @@ void RocksDBCollection::destroyCache() const {
   _cachePresent = false;
 }
 
+std::vector<std::string> RocksDBCollection::hottestCacheKeys(
+    size_t limit) const {
+  if (!useCache()) {
+    return std::vector<std::string>();
+  }
+  TRI_ASSERT(_cache != nullptr);
+  return _cache->hottestKeys(limit);
+}
+
+void RocksDBCollection::reloadCacheKeys(
+    transaction::Methods* trx, std::vector<std::string> const& keys) const {
+  ManagedDocumentResult mdr;
+  for (auto const& key : keys) {
+    rocksdb::Slice const slice(key);
+    if (slice.size() != 2 * sizeof(uint64_t) ||
+        RocksDBKey::objectId(slice) != _objectId) {
+      continue;
+    }
+    // documents removed in the meantime are simply not found
+    lookupDocumentVPack(RocksDBKey::documentId(slice), trx, mdr, true);
+  }
+}
+
 // blacklist given key from transactional cache
 void RocksDBCollection::blackListKey(char const* data, std::size_t len) const {
   if (useCache()) {
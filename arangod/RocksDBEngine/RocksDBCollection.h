@@ -44,6 +44,8 @@ class LogicalCollection;
 class ManagedDocumentResult;
 class Result;
 class RocksDBPrimaryIndex;
+class RocksDBRevisionTree;
+class RocksDBTransactionState;
 class RocksDBVPackIndex;
 class LocalDocumentId;
 
@@ -107,6 +109,8 @@ class RocksDBCollection final : public PhysicalCollection {
   std::unique_ptr<IndexIterator> getAllIterator(transaction::Methods* trx) const override;
   std::unique_ptr<IndexIterator> getAnyIterator(
       transaction::Methods* trx) const override;
+  std::unique_ptr<IndexIterator> getScanIterator(
+      transaction::Methods* trx) const override;
 
   std::unique_ptr<IndexIterator> getSortedAllIterator(transaction::Methods* trx) const;
 
@@ -142,6 +146,10 @@ class RocksDBCollection final : public PhysicalCollection {
       transaction::Methods* trx, LocalDocumentId const& token,
       IndexIterator::DocumentCallback const& cb) const override;
 
+  void readDocumentsWithCallback(
+      transaction::Methods* trx, std::vector<LocalDocumentId> const& tokens,
+      IndexIterator::DocumentCallback const& cb) const override;
+
   Result insert(arangodb::transaction::Methods* trx,
                 arangodb::velocypack::Slice const newSlice,
                 arangodb::ManagedDocumentResult& result,
@@ -196,9 +204,51 @@ class RocksDBCollection final : public PhysicalCollection {
   Result serializeKeyGenerator(rocksdb::Transaction*) const;
   void deserializeKeyGenerator(arangodb::RocksDBSettingsManager* mgr);
 
+  /// @brief the range hashes over the keys and revisions of the documents,
+  /// used by the incremental sync
+  RocksDBRevisionTree* revisionTree() const { return _revisionTree.get(); }
+
+  /// @brief make sure the revision tree is valid, building it if necessary.
+  /// if lows is given, the tree must use these range boundaries
+  Result ensureRevisionTree(size_t rangeSize,
+                            std::vector<std::string> const* lows);
+
+  std::pair<Result, rocksdb::SequenceNumber> serializeRevisionTree(
+      rocksdb::Transaction*, rocksdb::SequenceNumber) const;
+  void deserializeRevisionTree();
+
   inline bool cacheEnabled() const { return _cacheEnabled; }
 
+  /// @brief the document cache, or nullptr if there is none
+  std::shared_ptr<cache::Cache> cache() const {
+    return useCache() ? _cache : nullptr;
+  }
+
+  /// @brief the keys of the most recently used entries of the document cache
+  std::vector<std::string> hottestCacheKeys(size_t limit) const;
+
+  /// @brief read the documents of keys returned by hottestCacheKeys, which
+  /// puts them into the document cache again
+  void reloadCacheKeys(transaction::Methods* trx,
+                       std::vector<std::string> const& keys) const;
+
+  /// @brief whether or not documents are stored compressed
+  inline bool compressDocuments() const { return _compressDocuments; }
+
  private:
+  /// @brief whether or not the collection can be truncated by deleting its
+  /// key ranges outside of the transaction
+  bool canTruncateWithRangeDelete(RocksDBTransactionState const* state) const;
+
+  /// @brief truncate the collection by deleting the key ranges of the
+  /// documents and all indexes
+  void truncateWithRangeDelete();
+
+  /// @brief iterator over all documents. full scans read large blocks
+  /// ahead and do not fill the block cache
+  std::unique_ptr<IndexIterator> createAllIterator(transaction::Methods* trx,
+                                                   bool fullScan) const;
+
   /// @brief track the usage of waitForSync option in an operation
   void trackWaitForSync(arangodb::transaction::Methods* trx, OperationOptions& options);
 
@@ -211,6 +261,15 @@ class RocksDBCollection final : public PhysicalCollection {
   arangodb::Result fillIndexes(transaction::Methods*,
                                std::shared_ptr<arangodb::Index>);
 
+  /// @brief whether or not a new index can be filled by several threads
+  /// while the collection is not locked
+  bool canBuildIndexOnline(transaction::Methods*, Index const*) const;
+
+  /// @brief fill a new index with several threads, giving up the collection
+  /// lock for most of the time
+  arangodb::Result buildIndexOnline(transaction::Methods*,
+                                    std::shared_ptr<arangodb::Index>);
+
   // @brief return the primary index
   // WARNING: Make sure that this instance
   // is somehow protected. If it goes out of all scopes
@@ -246,6 +305,11 @@ class RocksDBCollection final : public PhysicalCollection {
   void recalculateIndexEstimates(
       std::vector<std::shared_ptr<Index>> const& indexes);
 
+  /// @brief the value under which a document is stored. compressed values
+  /// are built in the buffer
+  rocksdb::Slice documentValue(arangodb::velocypack::Slice const& doc,
+                               std::string& buffer) const;
+
   void createCache() const;
 
   void destroyCache() const;
@@ -270,6 +334,9 @@ class RocksDBCollection final : public PhysicalCollection {
   // it's quicker than accessing the shared_ptr each time
   mutable bool _cachePresent;
   bool _cacheEnabled;
+  /// @brief compress new documents before they are stored
+  bool _compressDocuments;
+  std::unique_ptr<RocksDBRevisionTree> _revisionTree;
 };
 
 inline RocksDBCollection* toRocksDBCollection(PhysicalCollection* physical) {
@@ -154,8 +154,7 @@ std::size_t countKeyRange(rocksdb::DB* db,
 /// @brief helper method to remove large ranges of data
 /// Should mainly be used to implement the drop() call
 Result removeLargeRange(rocksdb::TransactionDB* db,
-                        RocksDBKeyBounds const& bounds,
-                        bool prefix_same_as_start) {
+                        RocksDBKeyBounds const& bounds) {
   LOG_TOPIC(DEBUG, Logger::ROCKSDB) << "removing large range: " << bounds;
   
   rocksdb::ColumnFamilyHandle* cf = bounds.columnFamily();
@@ -170,8 +169,8 @@ Result removeLargeRange(rocksdb::TransactionDB* db,
       rocksdb::Status status =
           rocksdb::DeleteFilesInRange(bDB, cf, &lower, &upper);
       if (!status.ok()) {
-        // if file deletion failed, we will still iterate over the remaining
-        // keys, so we don't need to abort and raise an error here
+        // if file deletion failed, the range delete below will still
+        // remove all keys, so we don't need to abort and raise an error here
         arangodb::Result r = rocksutils::convertStatus(status);
         LOG_TOPIC(WARN, arangodb::Logger::ROCKSDB)
             << "RocksDB file deletion failed: " << r.errorMessage();
@@ -179,52 +178,18 @@ Result removeLargeRange(rocksdb::TransactionDB* db,
     }
     
     // go on and delete the remaining keys (delete files in range does not
-    // necessarily find them all, just complete files)
-    rocksdb::Comparator const* cmp = cf->GetComparator();
+    // necessarily find them all, just complete files). a single range
+    // tombstone covers all of them, so there is no need to iterate over
+    // the keys. the tombstone is dropped by compaction eventually
     rocksdb::WriteBatch batch;
-    rocksdb::ReadOptions readOptions;
-    readOptions.iterate_upper_bound = &upper;
-    readOptions.prefix_same_as_start = prefix_same_as_start;
-    readOptions.total_order_seek = !prefix_same_as_start;
-    readOptions.verify_checksums = false;
-    readOptions.fill_cache = false;
-    std::unique_ptr<rocksdb::Iterator> it(bDB->NewIterator(readOptions, cf));
-
-    size_t total = 0;
-    size_t counter = 0;
-    for (it->Seek(lower); it->Valid(); it->Next()) {
-      TRI_ASSERT(cmp->Compare(it->key(), lower) > 0);
-      TRI_ASSERT(cmp->Compare(it->key(), upper) < 0);
-      ++total;
-      ++counter;
-      batch.Delete(cf, it->key());
-      if (counter >= 1000) {
-        LOG_TOPIC(DEBUG, Logger::FIXME) << "intermediate delete write";
-        // Persist deletes all 1000 documents
-        rocksdb::Status status = bDB->Write(rocksdb::WriteOptions(), &batch);
-        if (!status.ok()) {
-          LOG_TOPIC(WARN, arangodb::Logger::FIXME)
-              << "RocksDB key deletion failed: " << status.ToString();
-          return TRI_ERROR_INTERNAL;
-        }
-        batch.Clear();
-        counter = 0;
-      }
+    rocksdb::Status status = batch.DeleteRange(cf, lower, upper);
+    if (status.ok()) {
+      status = bDB->Write(rocksdb::WriteOptions(), &batch);
     }
-  
-    LOG_TOPIC(DEBUG, Logger::ROCKSDB) << "removing large range, deleted in total: " << total;
-
-    if (counter > 0) {
-      LOG_TOPIC(DEBUG, Logger::FIXME) << "intermediate delete write";
-      // We still have sth to write
-      // now apply deletion batch
-      rocksdb::Status status = bDB->Write(rocksdb::WriteOptions(), &batch);
-
-      if (!status.ok()) {
-        LOG_TOPIC(WARN, arangodb::Logger::FIXME)
-            << "RocksDB key deletion failed: " << status.ToString();
-        return TRI_ERROR_INTERNAL;
-      }
+    if (!status.ok()) {
+      LOG_TOPIC(WARN, arangodb::Logger::ROCKSDB)
+          << "RocksDB range deletion failed: " << status.ToString();
+      return TRI_ERROR_INTERNAL;
     }
     return TRI_ERROR_NO_ERROR;
   } catch (arangodb::basics::Exception const& ex) {
@@ -86,8 +86,7 @@ std::size_t countKeyRange(rocksdb::DB*, RocksDBKeyBounds const&,
 /// @brief helper method to remove large ranges of data
 /// Should mainly be used to implement the drop() call
 Result removeLargeRange(rocksdb::TransactionDB* db,
-                        RocksDBKeyBounds const& bounds,
-                        bool prefix_same_as_start);
+                        RocksDBKeyBounds const& bounds);
 
 // optional switch to std::function to reduce amount of includes and
 // to avoid template
@@ -26,6 +26,8 @@
 
 #include "Basics/Common.h"
 #include "Basics/Exceptions.h"
+#include "Basics/Mutex.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/ReadLocker.h"
 #include "Basics/ReadWriteLock.h"
 #include "Basics/StringRef.h"
@@ -46,7 +48,9 @@
 //     with two hash function types as 3rd and 4th argument. If
 //     std::equal_to<Key> is not implemented or does not behave correctly,
 //     one has to supply a comparison class as well.
-// This class is not thread-safe!
+// The table is protected by one lock, and the buffered updates and
+// blockers, which are touched by every commit, by another one. Writers
+// therefore never wait for a serialization or for buffers being applied.
 
 namespace arangodb {
 
@@ -69,6 +73,13 @@ template <class Key, class HashKey = HashWithSeed<Key, 0xdeadbeefdeadbeefULL>,
 class RocksDBCuckooIndexEstimator {
   // Note that the following has to be a power of two and at least 4!
   static constexpr uint32_t SlotsPerBucket = 4;
+  // the fingerprints of a bucket are compared as one 64-bit word
+  static_assert(SlotsPerBucket * sizeof(uint16_t) == sizeof(uint64_t),
+                "buckets must fill a 64-bit word");
+
+  // number of buckets whose fingerprints share a cache line. the cached
+  // serialization is rewritten in units of this many buckets
+  static constexpr uint64_t BucketsPerDirtyBit = 8;
 
  private:
   // Helper class to hold the finger prints.
@@ -174,6 +185,7 @@ class RocksDBCuckooIndexEstimator {
         _nrCuckood(0),
         _nrTotal(0),
         _maxRounds(16),
+        _serializedValid(false),
         _committedSeq(0),
         _needToPersist(true) {
     // Inflate size so that we have some padding to avoid failure
@@ -206,6 +218,7 @@ class RocksDBCuckooIndexEstimator {
         _nrCuckood(0),
         _nrTotal(0),
         _maxRounds(16),
+        _serializedValid(false),
         _committedSeq(commitSeq),
         _needToPersist(false) {
     switch (serialized.front()) {
@@ -259,58 +272,25 @@ class RocksDBCuckooIndexEstimator {
     // must apply updates first to be valid
     applyUpdates(outputSeq);
 
+    // only the serialization thread touches the cached serialization
+    MUTEX_LOCKER(serializeLocker, _serializeLock);
     {
       // Sorry we need a consistent state, so we have to read-lock
       READ_LOCKER(locker, _lock);
+      updateSerialized();
 
-      // type
-      serialized += SerializeFormat::NOCOMPRESSION;
-
-      // length
-      uint64_t serialLength =
-          (sizeof(SerializeFormat) + sizeof(uint64_t) + sizeof(_size) +
-           sizeof(_nrUsed) + sizeof(_nrCuckood) + sizeof(_nrTotal) +
-           sizeof(_niceSize) + sizeof(_logSize) +
-           (_size * _slotSize * SlotsPerBucket)) +
-          (_size * _counterSize * SlotsPerBucket);
-
-      serialized.reserve(sizeof(uint64_t) + serialLength);
-      // We always prepend the length, so parsing is easier
-      rocksutils::uint64ToPersistent(serialized, serialLength);
-
-      // Add all member variables
-      rocksutils::uint64ToPersistent(serialized, _size);
-      rocksutils::uint64ToPersistent(serialized, _nrUsed);
-      rocksutils::uint64ToPersistent(serialized, _nrCuckood);
-      rocksutils::uint64ToPersistent(serialized, _nrTotal);
-      rocksutils::uint64ToPersistent(serialized, _niceSize);
-      rocksutils::uint64ToPersistent(serialized, _logSize);
-
-      // Add the data blob
-      // Size is as follows: nrOfBuckets * SlotsPerBucket * SlotSize
-      TRI_ASSERT((_size * _slotSize * SlotsPerBucket) <= _slotAllocSize);
-
-      for (uint64_t i = 0; i < (_size * _slotSize * SlotsPerBucket);
-           i += _slotSize) {
-        rocksutils::uint16ToPersistent(
-            serialized, *(reinterpret_cast<uint16_t*>(_base + i)));
-      }
-
-      TRI_ASSERT((_size * _counterSize * SlotsPerBucket) <= _counterAllocSize);
-
-      for (uint64_t i = 0; i < (_size * _counterSize * SlotsPerBucket);
-           i += _counterSize) {
-        rocksutils::uint32ToPersistent(
-            serialized, *(reinterpret_cast<uint32_t*>(_counters + i)));
-      }
-
+      READ_LOCKER(bufferLocker, _bufferLock);
       bool havePendingUpdates = !_blockers.empty() || !_insertBuffers.empty() ||
-                                !_removalBuffers.empty();
+                                !_removalBuffers.empty() ||
+                                !_truncateBuffer.empty();
       _needToPersist.store(havePendingUpdates);
     }
 
+    // the table may change again while the cache is copied, the cache not
+    serialized.append(_serialized);
+
     {
-      WRITE_LOCKER(locker, _lock);
+      WRITE_LOCKER(locker, _bufferLock);
       _committedSeq = outputSeq;
     }
 
@@ -334,6 +314,7 @@ class RocksDBCuckooIndexEstimator {
         f.reset();
       }
     }
+    _serializedValid = false;
 
     _needToPersist.store(true);
   }
@@ -391,23 +372,8 @@ class RocksDBCuckooIndexEstimator {
     uint64_t hash2 = _hasherPosFingerprint(pos1, fingerprint);
     uint64_t pos2 = hashToPos(hash2);
 
-    {
-      WRITE_LOCKER(guard, _lock);
-      Slot slot = findSlotCuckoo(pos1, pos2, fingerprint);
-      if (slot.isEmpty()) {
-        // Free slot insert ourself.
-        slot.init(fingerprint);
-        ++_nrUsed;
-        TRI_ASSERT(_nrUsed > 0);
-      } else {
-        TRI_ASSERT(slot.isEqual(fingerprint));
-        slot.increase();
-      }
-      ++_nrTotal;
-      _needToPersist.store(true);
-    }
-
-    return true;
+    WRITE_LOCKER(guard, _lock);
+    return insertNoLock(pos1, pos2, fingerprint);
   }
 
   /// @brief only call directly during startup/recovery; otherwise buffer
@@ -424,31 +390,21 @@ class RocksDBCuckooIndexEstimator {
     uint64_t hash2 = _hasherPosFingerprint(pos1, fingerprint);
     uint64_t pos2 = hashToPos(hash2);
 
-    bool found = false;
-    {
-      WRITE_LOCKER(guard, _lock);
-      Slot slot = findSlotNoCuckoo(pos1, pos2, fingerprint, found);
-      if (found) {
-        // only decrease the total if we actually found it
-        --_nrTotal;
-        if (!slot.decrease()) {
-          // Removed last element. Have to remove
-          slot.reset();
-          --_nrUsed;
-        }
-        _needToPersist.store(true);
-        return true;
-      }
-      // If we get here we assume that the element was once inserted, but
-      // removed by cuckoo
-      // Reduce nrCuckood;
-      if (_nrCuckood > 0) {
-        // not included in _nrTotal, just decrease here
-        --_nrCuckood;
+    WRITE_LOCKER(guard, _lock);
+    return removeNoLock(pos1, pos2, fingerprint);
+  }
+
+  /// @brief only call directly during startup/recovery. applies the
+  /// operations in order under a single lock, inserts are true
+  void apply(std::vector<std::pair<Key, bool>> const& operations) {
+    WRITE_LOCKER(guard, _lock);
+    for (auto const& it : operations) {
+      if (it.second) {
+        insertNoLock(it.first);
+      } else {
+        removeNoLock(it.first);
       }
-      _needToPersist.store(true);
     }
-    return false;
   }
 
   uint64_t capacity() const { return _size * SlotsPerBucket; }
@@ -462,10 +418,7 @@ class RocksDBCuckooIndexEstimator {
   // not thread safe. called only during tests
   uint64_t nrCuckood() const { return _nrCuckood; }
 
-  bool needToPersist() const {
-    READ_LOCKER(locker, _lock);
-    return _needToPersist.load();
-  }
+  bool needToPersist() const { return _needToPersist.load(); }
 
   /**
    * @brief Place a blocker to allow proper commit/serialize semantics
@@ -484,7 +437,7 @@ class RocksDBCuckooIndexEstimator {
       TRI_ASSERT(_blockersBySeq.end() ==
                  _blockersBySeq.find(std::make_pair(seq, trxId)));
       Result res;
-      WRITE_LOCKER(locker, _lock);
+      WRITE_LOCKER(locker, _bufferLock);
       auto insert = _blockers.emplace(trxId, seq);
       auto crosslist = _blockersBySeq.emplace(seq, trxId);
       if (!insert.second || !crosslist.second) {
@@ -507,7 +460,7 @@ class RocksDBCuckooIndexEstimator {
    *              earlier `placeBlocker` call)
    */
   void removeBlocker(uint64_t trxId) {
-    WRITE_LOCKER(locker, _lock);
+    WRITE_LOCKER(locker, _bufferLock);
     auto it = _blockers.find(trxId);
     if (_blockers.end() != it) {
       auto cross = _blockersBySeq.find(std::make_pair(it->second, it->first));
@@ -534,7 +487,7 @@ class RocksDBCuckooIndexEstimator {
   Result bufferUpdates(rocksdb::SequenceNumber seq, std::vector<Key>&& inserts,
                        std::vector<Key>&& removals) {
     Result res = basics::catchVoidToResult([&]() -> void {
-      WRITE_LOCKER(locker, _lock);
+      WRITE_LOCKER(locker, _bufferLock);
       bool foundSomething = false;
       if (!inserts.empty()) {
         _insertBuffers.emplace(seq, std::move(inserts));
@@ -553,6 +506,26 @@ class RocksDBCuckooIndexEstimator {
     return res;
   }
 
+  /**
+   * @brief Buffer a truncate of the index, to be applied on next sync
+   *
+   * All updates buffered with a seq/tick up to and including the seq/tick of
+   * the truncate are discarded when the truncate is applied.
+   *
+   * @param  seq      The seq/tick of the truncate
+   * @return          May return error if any functions throw (e.g. alloc)
+   */
+  Result bufferTruncate(rocksdb::SequenceNumber seq) {
+    Result res = basics::catchVoidToResult([&]() -> void {
+      WRITE_LOCKER(locker, _bufferLock);
+      _truncateBuffer.emplace(seq);
+      _needToPersist.store(true);
+      LOG_TOPIC(TRACE, Logger::ENGINES)
+          << "buffered truncate with stamp " << seq;
+    });
+    return res;
+  }
+
   /**
    * @brief Fetches the most recently set "committed" seq/tick
    *
@@ -561,7 +534,7 @@ class RocksDBCuckooIndexEstimator {
    * @return The latest seq/tick through which the estimate is valid
    */
   rocksdb::SequenceNumber commitSeq() const {
-    READ_LOCKER(locker, _lock);
+    READ_LOCKER(locker, _bufferLock);
     return _committedSeq;
   }
 
@@ -572,9 +545,33 @@ class RocksDBCuckooIndexEstimator {
       std::vector<Key> inserts;
       std::vector<Key> removals;
       while (true) {
+        bool foundTruncate = false;
         // find out if we have buffers to apply
         {
-          WRITE_LOCKER(locker, _lock);
+          WRITE_LOCKER(locker, _bufferLock);
+
+          // check for truncate, which makes all earlier buffers obsolete
+          if (!_truncateBuffer.empty()) {
+            auto it = _truncateBuffer.begin();
+            if (*it <= commitSeq) {
+              rocksdb::SequenceNumber const truncateSeq = *it;
+              _truncateBuffer.erase(it);
+              _insertBuffers.erase(_insertBuffers.begin(),
+                                   _insertBuffers.upper_bound(truncateSeq));
+              _removalBuffers.erase(_removalBuffers.begin(),
+                                    _removalBuffers.upper_bound(truncateSeq));
+              foundTruncate = true;
+            }
+          }
+        }
+
+        if (foundTruncate) {
+          clear();
+          continue;
+        }
+
+        {
+          WRITE_LOCKER(locker, _bufferLock);
 
           // check for inserts
           if (!_insertBuffers.empty()) {
@@ -602,21 +599,18 @@ class RocksDBCuckooIndexEstimator {
           break;
         }
 
-        if (!inserts.empty()) {
-          // apply inserts
+        {
+          // apply all of them with a single lock
+          WRITE_LOCKER(locker, _lock);
           for (auto const& key : inserts) {
-            insert(key);
+            insertNoLock(key);
           }
-          inserts.clear();
-        }
-
-        if (!removals.empty()) {
-          // apply removals
           for (auto const& key : removals) {
-            remove(key);
+            removeNoLock(key);
           }
-          removals.clear();
         }
+        inserts.clear();
+        removals.clear();
       }
     });
     return res;
@@ -624,7 +618,7 @@ class RocksDBCuckooIndexEstimator {
 
   /// @brief updates and returns the largest safe seq to consider committed
   rocksdb::SequenceNumber committableSeq(rocksdb::SequenceNumber current) {
-    WRITE_LOCKER(locker, _lock);
+    READ_LOCKER(locker, _bufferLock);
     auto minSeq = current;
 
     // if we have a blocker with a lower value than current, compare it
@@ -638,7 +632,174 @@ class RocksDBCuckooIndexEstimator {
 
   uint64_t memoryUsage() const {
     return sizeof(RocksDBCuckooIndexEstimator) + _slotAllocSize +
-           _counterAllocSize;
+           _counterAllocSize + _serialized.capacity();
+  }
+
+  void insertNoLock(Key const& k) {
+    uint64_t hash1 = _hasherKey(k);
+    uint64_t pos1 = hashToPos(hash1);
+    uint16_t fingerprint = keyToFingerprint(k);
+    uint64_t hash2 = _hasherPosFingerprint(pos1, fingerprint);
+    insertNoLock(pos1, hashToPos(hash2), fingerprint);
+  }
+
+  void removeNoLock(Key const& k) {
+    uint64_t hash1 = _hasherKey(k);
+    uint64_t pos1 = hashToPos(hash1);
+    uint16_t fingerprint = keyToFingerprint(k);
+    uint64_t hash2 = _hasherPosFingerprint(pos1, fingerprint);
+    removeNoLock(pos1, hashToPos(hash2), fingerprint);
+  }
+
+  /// @brief call with the write lock held
+  bool insertNoLock(uint64_t pos1, uint64_t pos2, uint16_t fingerprint) {
+    Slot slot = findSlotCuckoo(pos1, pos2, fingerprint);
+    if (slot.isEmpty()) {
+      // Free slot insert ourself.
+      slot.init(fingerprint);
+      ++_nrUsed;
+      TRI_ASSERT(_nrUsed > 0);
+    } else {
+      TRI_ASSERT(slot.isEqual(fingerprint));
+      slot.increase();
+    }
+    markDirty(pos1);
+    markDirty(pos2);
+    ++_nrTotal;
+    _needToPersist.store(true);
+    return true;
+  }
+
+  /// @brief call with the write lock held
+  bool removeNoLock(uint64_t pos1, uint64_t pos2, uint16_t fingerprint) {
+    bool found = false;
+    Slot slot = findSlotNoCuckoo(pos1, pos2, fingerprint, found);
+    if (found) {
+      // only decrease the total if we actually found it
+      --_nrTotal;
+      if (!slot.decrease()) {
+        // Removed last element. Have to remove
+        slot.reset();
+        --_nrUsed;
+      }
+      markDirty(pos1);
+      markDirty(pos2);
+      _needToPersist.store(true);
+      return true;
+    }
+    // If we get here we assume that the element was once inserted, but
+    // removed by cuckoo
+    // Reduce nrCuckood;
+    if (_nrCuckood > 0) {
+      // not included in _nrTotal, just decrease here
+      --_nrCuckood;
+    }
+    _needToPersist.store(true);
+    return false;
+  }
+
+  /// @brief remember that a bucket changed since the last serialization
+  void markDirty(uint64_t pos) {
+    uint64_t const bit = pos / BucketsPerDirtyBit;
+    _dirty[bit / 64] |= (uint64_t(1) << (bit % 64));
+  }
+
+  /// @brief append type, length and the member variables of the
+  /// serialization format
+  void serializeHeader(std::string& serialized) const {
+    // type
+    serialized += SerializeFormat::NOCOMPRESSION;
+
+    // length
+    uint64_t serialLength =
+        (sizeof(SerializeFormat) + sizeof(uint64_t) + sizeof(_size) +
+         sizeof(_nrUsed) + sizeof(_nrCuckood) + sizeof(_nrTotal) +
+         sizeof(_niceSize) + sizeof(_logSize) +
+         (_size * _slotSize * SlotsPerBucket)) +
+        (_size * _counterSize * SlotsPerBucket);
+
+    serialized.reserve(serialized.size() + serialLength);
+    // We always prepend the length, so parsing is easier
+    rocksutils::uint64ToPersistent(serialized, serialLength);
+
+    // Add all member variables
+    rocksutils::uint64ToPersistent(serialized, _size);
+    rocksutils::uint64ToPersistent(serialized, _nrUsed);
+    rocksutils::uint64ToPersistent(serialized, _nrCuckood);
+    rocksutils::uint64ToPersistent(serialized, _nrTotal);
+    rocksutils::uint64ToPersistent(serialized, _niceSize);
+    rocksutils::uint64ToPersistent(serialized, _logSize);
+  }
+
+  /// @brief append the fingerprints and counters of the slots [from, to)
+  void serializeSlots(std::string& serialized, uint64_t from,
+                      uint64_t to) const {
+    for (uint64_t i = from * _slotSize; i < to * _slotSize; i += _slotSize) {
+      rocksutils::uint16ToPersistent(
+          serialized, *(reinterpret_cast<uint16_t*>(_base + i)));
+    }
+  }
+
+  void serializeCounters(std::string& serialized, uint64_t from,
+                         uint64_t to) const {
+    for (uint64_t i = from * _counterSize; i < to * _counterSize;
+         i += _counterSize) {
+      rocksutils::uint32ToPersistent(
+          serialized, *(reinterpret_cast<uint32_t*>(_counters + i)));
+    }
+  }
+
+  /// @brief bring the cached serialization up to date. only the buckets
+  /// changed since the last call are serialized again. call with the
+  /// serialize mutex and at least the read lock held
+  void updateSerialized() {
+    uint64_t const numSlots = _size * SlotsPerBucket;
+    TRI_ASSERT((numSlots * _slotSize) <= _slotAllocSize);
+    TRI_ASSERT((numSlots * _counterSize) <= _counterAllocSize);
+
+    if (!_serializedValid) {
+      _serialized.clear();
+      serializeHeader(_serialized);
+      serializeSlots(_serialized, 0, numSlots);
+      serializeCounters(_serialized, 0, numSlots);
+      std::fill(_dirty.begin(), _dirty.end(), 0);
+      _serializedValid = true;
+      return;
+    }
+
+    std::string buffer;
+    serializeHeader(buffer);
+    size_t const headerSize = buffer.size();
+    TRI_ASSERT(_serialized.size() ==
+               headerSize + numSlots * (_slotSize + _counterSize));
+    _serialized.replace(0, headerSize, buffer);
+
+    uint64_t const slotsPerBit = BucketsPerDirtyBit * SlotsPerBucket;
+    for (size_t w = 0; w < _dirty.size(); ++w) {
+      if (_dirty[w] == 0) {
+        continue;
+      }
+      for (uint64_t b = 0; b < 64; ++b) {
+        if ((_dirty[w] & (uint64_t(1) << b)) == 0) {
+          continue;
+        }
+        uint64_t const from = (w * 64 + b) * slotsPerBit;
+        uint64_t const to = std::min(from + slotsPerBit, numSlots);
+        TRI_ASSERT(from < to);
+
+        buffer.clear();
+        serializeSlots(buffer, from, to);
+        _serialized.replace(headerSize + from * _slotSize, buffer.size(),
+                            buffer);
+
+        buffer.clear();
+        serializeCounters(buffer, from, to);
+        _serialized.replace(
+            headerSize + numSlots * _slotSize + from * _counterSize,
+            buffer.size(), buffer);
+      }
+      _dirty[w] = 0;
+    }
   }
 
   Slot findSlotNoCuckoo(uint64_t pos1, uint64_t pos2, uint16_t fp,
@@ -663,40 +824,31 @@ class RocksDBCuckooIndexEstimator {
   // it deletes a random element occupying a position.
   Slot findSlotCuckoo(uint64_t pos1, uint64_t pos2, uint16_t fp) {
     Slot firstEmpty(nullptr);
-    bool foundEmpty = false;
 
-    for (uint64_t i = 0; i < SlotsPerBucket; ++i) {
-      Slot slot = findSlot(pos1, i);
-      if (slot.isEqual(fp)) {
-        // Found we are done, short-circuit.
-        slot.injectCounter(findCounter(pos1, i));
-        return slot;
-      }
-      if (!foundEmpty && slot.isEmpty()) {
-        slot.injectCounter(findCounter(pos1, i));
-        foundEmpty = true;
-        firstEmpty = slot;
-      }
+    bool found = false;
+    Slot slot = findSlotNoCuckoo(pos1, fp, found);
+    if (found) {
+      // Found we are done, short-circuit.
+      return slot;
     }
-
-    for (uint64_t i = 0; i < SlotsPerBucket; ++i) {
-      Slot slot = findSlot(pos2, i);
-      if (slot.isEqual(fp)) {
-        // Found we are done, short-circuit.
-        slot.injectCounter(findCounter(pos2, i));
-        return slot;
-      }
-      if (!foundEmpty && slot.isEmpty()) {
-        slot.injectCounter(findCounter(pos2, i));
-        foundEmpty = true;
-        firstEmpty = slot;
-      }
+    uint64_t const empty1 = findInBucket(pos1, 0);
+    slot = findSlotNoCuckoo(pos2, fp, found);
+    if (found) {
+      return slot;
     }
 
     // Value not yet inserted.
 
-    if (foundEmpty) {
+    if (empty1 < SlotsPerBucket) {
       // But we found an empty slot
+      firstEmpty = findSlot(pos1, empty1);
+      firstEmpty.injectCounter(findCounter(pos1, empty1));
+      return firstEmpty;
+    }
+    uint64_t const empty2 = findInBucket(pos2, 0);
+    if (empty2 < SlotsPerBucket) {
+      firstEmpty = findSlot(pos2, empty2);
+      firstEmpty.injectCounter(findCounter(pos2, empty2));
       return firstEmpty;
     }
 
@@ -725,16 +877,16 @@ class RocksDBCuckooIndexEstimator {
 
     // Now let the cuckoo fly and find a place for the poor one we just took
     // out.
-    for (uint64_t i = 0; i < SlotsPerBucket; ++i) {
-      Slot slot = findSlot(pos2, i);
-      if (slot.isEmpty()) {
-        slot.injectCounter(findCounter(pos2, i));
-        // Yeah we found an empty place already
-        *slot.fingerprint() = fp;
-        *slot.counter() = counter;
-        ++_nrUsed;
-        return firstEmpty;
-      }
+    i = findInBucket(pos2, 0);
+    if (i < SlotsPerBucket) {
+      slot = findSlot(pos2, i);
+      slot.injectCounter(findCounter(pos2, i));
+      // Yeah we found an empty place already
+      *slot.fingerprint() = fp;
+      *slot.counter() = counter;
+      markDirty(pos2);
+      ++_nrUsed;
+      return firstEmpty;
     }
 
     // Bad luck, let us try to move to a different slot.
@@ -753,20 +905,21 @@ class RocksDBCuckooIndexEstimator {
       }
       slot.injectCounter(findCounter(pos1, i));
       slot.swap(fp, counter);
+      markDirty(pos1);
 
       hash2 = _hasherPosFingerprint(pos1, fp);
       pos2 = hashToPos(hash2);
 
-      for (uint64_t i = 0; i < SlotsPerBucket; ++i) {
-        Slot slot = findSlot(pos2, i);
-        if (slot.isEmpty()) {
-          slot.injectCounter(findCounter(pos2, i));
-          // Finally an empty place
-          *slot.fingerprint() = fp;
-          *slot.counter() = counter;
-          ++_nrUsed;
-          return firstEmpty;
-        }
+      i = findInBucket(pos2, 0);
+      if (i < SlotsPerBucket) {
+        slot = findSlot(pos2, i);
+        slot.injectCounter(findCounter(pos2, i));
+        // Finally an empty place
+        *slot.fingerprint() = fp;
+        *slot.counter() = counter;
+        markDirty(pos2);
+        ++_nrUsed;
+        return firstEmpty;
       }
     }
     // If we get here we had to remove one of the elements.
@@ -779,16 +932,44 @@ class RocksDBCuckooIndexEstimator {
 
   // Do not use the output if found == false
   Slot findSlotNoCuckoo(uint64_t pos, uint16_t fp, bool& found) const {
-    found = false;
-    for (uint64_t i = 0; i < SlotsPerBucket; ++i) {
-      Slot slot = findSlot(pos, i);
-      if (fp == *slot.fingerprint()) {
-        slot.injectCounter(findCounter(pos, i));
-        found = true;
-        return slot;
-      }
+    uint64_t const i = findInBucket(pos, fp);
+    found = (i < SlotsPerBucket);
+    if (!found) {
+      return Slot{nullptr};
+    }
+    Slot slot = findSlot(pos, i);
+    slot.injectCounter(findCounter(pos, i));
+    return slot;
+  }
+
+  /// @brief the index of the first slot of a bucket holding the fingerprint,
+  /// or SlotsPerBucket if there is none. all slots of the bucket are
+  /// compared at once, within one 64-bit word. fingerprint 0 finds the
+  /// first empty slot
+  uint64_t findInBucket(uint64_t pos, uint16_t fp) const {
+    constexpr uint64_t low = 0x0001000100010001ULL;
+    constexpr uint64_t high = 0x8000800080008000ULL;
+    TRI_ASSERT(_slotSize * (pos + 1) * SlotsPerBucket <= _slotAllocSize);
+    // slot i ends up in bits 16 * i, whatever the endianess
+    uint16_t const* p = reinterpret_cast<uint16_t const*>(
+        _base + _slotSize * pos * SlotsPerBucket);
+    uint64_t const word = static_cast<uint64_t>(p[0]) |
+                          (static_cast<uint64_t>(p[1]) << 16) |
+                          (static_cast<uint64_t>(p[2]) << 32) |
+                          (static_cast<uint64_t>(p[3]) << 48);
+    // slots holding the fingerprint become zero, and the high bit of every
+    // zero slot is set. a borrow can only set the bit of a slot above a
+    // zero one, so the lowest bit set always belongs to a match
+    uint64_t const x = word ^ (low * fp);
+    uint64_t const zeros = (x - low) & ~x & high;
+    if (zeros == 0) {
+      return SlotsPerBucket;
+    }
+    uint64_t i = 0;
+    while ((zeros & (uint64_t(0x8000) << (16 * i))) == 0) {
+      ++i;
     }
-    return Slot{nullptr};
+    return i;
   }
 
   Slot findSlot(uint64_t pos, uint64_t slot) const {
@@ -939,6 +1120,11 @@ class RocksDBCuckooIndexEstimator {
         ~((uintptr_t)0x3fu));  // to actually implement the 64-byte alignment,
                                // shift base pointer within allocated space to
                                // 64-byte boundary
+
+    uint64_t const dirtyBits =
+        (_size + BucketsPerDirtyBit - 1) / BucketsPerDirtyBit;
+    _dirty.assign((dirtyBits + 63) / 64, 0);
+    _serializedValid = false;
   }
 
  private:               // member variables
@@ -966,6 +1152,15 @@ class RocksDBCuckooIndexEstimator {
   uint64_t _nrTotal;    // number of elements included in total (not cuckood)
   unsigned _maxRounds;  // maximum number of cuckoo rounds on insertion
 
+  // one bit per BucketsPerDirtyBit buckets that changed since the last
+  // serialization
+  std::vector<uint64_t> _dirty;
+  // the serialization without the leading seq, kept up to date by serialize
+  std::string _serialized;
+  bool _serializedValid;
+  // protects _serialized
+  arangodb::Mutex _serializeLock;
+
   rocksdb::SequenceNumber mutable _committedSeq;
   std::atomic<bool> _needToPersist;
 
@@ -973,12 +1168,16 @@ class RocksDBCuckooIndexEstimator {
   std::set<std::pair<rocksdb::SequenceNumber, uint64_t>> _blockersBySeq;
   std::map<rocksdb::SequenceNumber, std::vector<Key>> _insertBuffers;
   std::map<rocksdb::SequenceNumber, std::vector<Key>> _removalBuffers;
+  std::set<rocksdb::SequenceNumber> _truncateBuffer;
 
   HashKey _hasherKey;        // Instance to compute the first hash function
   Fingerprint _fingerprint;  // Instance to compute a fingerprint of a key
   HashShort _hasherShort;    // Instance to compute the second hash function
 
+  // protects the table and the statistics
   arangodb::basics::ReadWriteLock mutable _lock;
+  // protects the blockers, the buffers and _committedSeq
+  arangodb::basics::ReadWriteLock mutable _bufferLock;
 };  // namespace arangodb
 
 }  // namespace arangodb
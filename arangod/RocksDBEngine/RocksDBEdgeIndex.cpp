@@ -24,6 +24,7 @@
 
 #include "RocksDBEdgeIndex.h"
 #include "Aql/AstNode.h"
+#include "Aql/QueryCounters.h"
 #include "Aql/SortCondition.h"
 #include "Basics/Exceptions.h"
 #include "Basics/LocalTaskQueue.h"
@@ -36,6 +37,7 @@
 #include "Indexes/SimpleAttributeEqualityMatcher.h"
 #include "RocksDBEngine/RocksDBCollection.h"
 #include "RocksDBEngine/RocksDBCommon.h"
+#include "RocksDBEngine/RocksDBEngine.h"
 #include "RocksDBEngine/RocksDBKey.h"
 #include "RocksDBEngine/RocksDBKeyBounds.h"
 #include "RocksDBEngine/RocksDBMethods.h"
@@ -63,6 +65,13 @@ using namespace arangodb::basics;
 
 namespace {
 constexpr bool EdgeIndexFillBlockCache = false;
+
+/// @brief the attributes a covering edge index iterator produces. note that
+/// the attribute names must be hard-coded here to avoid an init-order fiasco
+/// with StaticStrings::FromString etc.
+std::vector<std::vector<arangodb::basics::AttributeName>> const
+    FromAndToAttributes{{arangodb::basics::AttributeName("_from", false)},
+                        {arangodb::basics::AttributeName("_to", false)}};
 }
 
 RocksDBEdgeIndexWarmupTask::RocksDBEdgeIndexWarmupTask(
@@ -236,6 +245,7 @@ bool RocksDBEdgeIndexIterator::next(LocalDocumentIdCallback const& cb, size_t li
           break;
         }
       }  // attempts
+      aql::QueryCounters::edgeCacheLookup(!needRocksLookup);
     }    // if (_cache)
 
     if (needRocksLookup) {
@@ -265,13 +275,13 @@ bool RocksDBEdgeIndexIterator::nextCovering(DocumentCallback const& cb, size_t l
       // We still have unreturned edges in memory.
       // Just plainly return those.
       TRI_ASSERT(_builderIterator.value().isNumber());
-      cb(LocalDocumentId{_builderIterator.value().getNumericValue<uint64_t>()}, _lastKey);
-      limit--;
-
-      // Twice advance the iterator
-      _builderIterator.next();
+      LocalDocumentId tkn{_builderIterator.value().getNumericValue<uint64_t>()};
       // We always have <revision,_from> pairs
+      _builderIterator.next();
       TRI_ASSERT(_builderIterator.valid());
+      coveringCallback(cb, tkn, _builderIterator.value());
+      limit--;
+
       _builderIterator.next();
 
       if (limit == 0) {
@@ -302,14 +312,14 @@ bool RocksDBEdgeIndexIterator::nextCovering(DocumentCallback const& cb, size_t l
             _builderIterator = VPackArrayIterator(cachedData);
             while (_builderIterator.valid()) {
               TRI_ASSERT(_builderIterator.value().isNumber());
-              cb(LocalDocumentId{
-                  _builderIterator.value().getNumericValue<uint64_t>()}, _lastKey);
-              limit--;
-
-              // Twice advance the iterator
-              _builderIterator.next();
+              LocalDocumentId tkn{
+                  _builderIterator.value().getNumericValue<uint64_t>()};
               // We always have <revision,_from> pairs
+              _builderIterator.next();
               TRI_ASSERT(_builderIterator.valid());
+              coveringCallback(cb, tkn, _builderIterator.value());
+              limit--;
+
               _builderIterator.next();
             }
             _builderIterator = VPackArrayIterator(
@@ -331,6 +341,7 @@ bool RocksDBEdgeIndexIterator::nextCovering(DocumentCallback const& cb, size_t l
           break;
         }
       }  // attempts
+      aql::QueryCounters::edgeCacheLookup(!needRocksLookup);
     }    // if (_cache)
 
     if (needRocksLookup) {
@@ -343,6 +354,25 @@ bool RocksDBEdgeIndexIterator::nextCovering(DocumentCallback const& cb, size_t l
   return _builderIterator.valid() || _keysIterator.valid();
 }
 
+void RocksDBEdgeIndexIterator::coveringCallback(DocumentCallback const& cb,
+                                                LocalDocumentId const& token,
+                                                VPackSlice otherVertex) {
+  // the looked up vertex and the stored opposite vertex, in the order of
+  // RocksDBEdgeIndex::coveredFields()
+  TRI_ASSERT(otherVertex.isString());
+  _coveringBuilder.clear();
+  _coveringBuilder.openArray(true);
+  if (_index->_isFromIndex) {
+    _coveringBuilder.add(_lastKey);
+    _coveringBuilder.add(otherVertex);
+  } else {
+    _coveringBuilder.add(otherVertex);
+    _coveringBuilder.add(_lastKey);
+  }
+  _coveringBuilder.close();
+  cb(token, _coveringBuilder.slice());
+}
+
 bool RocksDBEdgeIndexIterator::nextExtra(ExtraCallback const& cb,
                                          size_t limit) {
   TRI_ASSERT(_trx->state()->isRunning());
@@ -438,6 +468,7 @@ bool RocksDBEdgeIndexIterator::nextExtra(ExtraCallback const& cb,
           break;
         }
       }  // attempts
+      aql::QueryCounters::edgeCacheLookup(!needRocksLookup);
     }    // if (_cache)
 
     if (needRocksLookup) {
@@ -541,6 +572,11 @@ RocksDBEdgeIndex::RocksDBEdgeIndex(TRI_idx_iid_t iid,
 
 RocksDBEdgeIndex::~RocksDBEdgeIndex() {}
 
+std::vector<std::vector<arangodb::basics::AttributeName>> const&
+RocksDBEdgeIndex::coveredFields() const {
+  return ::FromAndToAttributes;
+}
+
 /// @brief return a selectivity estimate for the index
 double RocksDBEdgeIndex::selectivityEstimate(
     arangodb::StringRef const* attribute) const {
@@ -849,6 +885,7 @@ void RocksDBEdgeIndex::warmupInternal(transaction::Methods* trx,
                                       rocksdb::Slice const& lower,
                                       rocksdb::Slice const& upper) {
   auto scheduler = SchedulerFeature::SCHEDULER;
+  RocksDBEngine* engine = rocksutils::globalRocksEngine();
   auto rocksColl = toRocksDBCollection(_collection);
   ManagedDocumentResult mmdr;
   bool needsInsert = false;
@@ -868,6 +905,7 @@ void RocksDBEdgeIndex::warmupInternal(transaction::Methods* trx,
       rocksutils::globalRocksDB()->NewIterator(options, _cf));
 
   size_t n = 0;
+  uint64_t bytesRead = 0;
   cache::Cache* cc = _cache.get();
   for (it->Seek(lower); it->Valid(); it->Next()) {
     if (scheduler->isStopping()) {
@@ -875,7 +913,13 @@ void RocksDBEdgeIndex::warmupInternal(transaction::Methods* trx,
     }
     n++;
 
+    if (bytesRead >= RocksDBEngine::warmupPaceBytes) {
+      engine->paceWarmup(bytesRead);
+      bytesRead = 0;
+    }
+
     rocksdb::Slice key = it->key();
+    bytesRead += key.size();
     StringRef v = RocksDBKey::vertexId(key);
     if (previous.empty()) {
       // First call.
@@ -946,6 +990,7 @@ void RocksDBEdgeIndex::warmupInternal(transaction::Methods* trx,
         builder.add(VPackValue(docId.id()));
 
         VPackSlice doc(mmdr.vpack());
+        bytesRead += doc.byteSize();
         VPackSlice toFrom =
             _isFromIndex ? transaction::helpers::extractToFromDocument(doc)
                          : transaction::helpers::extractFromFromDocument(doc);
@@ -1036,6 +1081,28 @@ IndexIterator* RocksDBEdgeIndex::createInIterator(
   return new RocksDBEdgeIndexIterator(_collection, trx, this, std::move(keys), _cache);
 }
 
+/// @brief the cache keys are the _from or _to values. an iterator over them
+/// caches every value it has to read from RocksDB
+void RocksDBEdgeIndex::reloadCacheKeys(
+    transaction::Methods* trx, std::vector<std::string> const& keys) const {
+  if (keys.empty()) {
+    return;
+  }
+
+  transaction::BuilderLeaser builder(trx);
+  std::unique_ptr<VPackBuilder> values(builder.steal());
+  values->openArray();
+  for (auto const& key : keys) {
+    values->add(VPackValuePair(key.data(), key.size(), VPackValueType::String));
+  }
+  values->close();
+
+  RocksDBEdgeIndexIterator it(_collection, trx, this, std::move(values),
+                              _cache);
+  while (it.next([](LocalDocumentId const&) {}, 1000)) {
+  }
+}
+
 /// @brief add a single value node to the iterator's keys
 void RocksDBEdgeIndex::handleValNode(
     VPackBuilder* keys, arangodb::aql::AstNode const* valNode) const {
@@ -62,7 +62,8 @@ class RocksDBEdgeIndexIterator final : public IndexIterator {
   void reset() override;
   
   /// @brief we provide a method to provide the index attribute values
-  /// while scanning the index
+  /// while scanning the index. nextCovering() produces arrays with the
+  /// _from and the _to value of each edge
   bool hasCovering() const override { return true; }
 
  private:
@@ -76,6 +77,9 @@ class RocksDBEdgeIndexIterator final : public IndexIterator {
   arangodb::StringRef getFromToFromIterator(
       arangodb::velocypack::ArrayIterator const&);
   void lookupInRocksDB(StringRef edgeKey);
+  void coveringCallback(DocumentCallback const& cb,
+                        LocalDocumentId const& token,
+                        arangodb::velocypack::Slice otherVertex);
 
   std::unique_ptr<arangodb::velocypack::Builder> _keys;
   arangodb::velocypack::ArrayIterator _keysIterator;
@@ -88,6 +92,7 @@ class RocksDBEdgeIndexIterator final : public IndexIterator {
   arangodb::velocypack::ArrayIterator _builderIterator;
   arangodb::velocypack::Builder _builder;
   arangodb::velocypack::Slice _lastKey;
+  arangodb::velocypack::Builder _coveringBuilder;
 };
 
 class RocksDBEdgeIndexWarmupTask : public basics::LocalTask {
@@ -129,6 +134,11 @@ class RocksDBEdgeIndex final : public RocksDBIndex {
 
   bool hasCoveringIterator() const override { return true; }
 
+  /// @brief the key encodes the looked up vertex, the value the opposite
+  /// one, so both _from and _to are covered
+  std::vector<std::vector<arangodb::basics::AttributeName>> const&
+  coveredFields() const override;
+
   bool isSorted() const override { return false; }
 
   bool hasSelectivityEstimate() const override { return true; }
@@ -164,6 +174,9 @@ class RocksDBEdgeIndex final : public RocksDBIndex {
   void warmup(arangodb::transaction::Methods* trx,
               std::shared_ptr<basics::LocalTaskQueue> queue) override;
 
+  void reloadCacheKeys(transaction::Methods* trx,
+                       std::vector<std::string> const& keys) const override;
+
   rocksdb::SequenceNumber serializeEstimate(
       std::string& output, rocksdb::SequenceNumber seq) const override;
 
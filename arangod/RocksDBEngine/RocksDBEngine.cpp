@@ -26,6 +26,7 @@
 #include "ApplicationFeatures/RocksDBOptionFeature.h"
 #include "Basics/Exceptions.h"
 #include "Basics/FileUtils.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/ReadLocker.h"
 #include "Basics/Result.h"
 #include "Basics/RocksDBLogger.h"
@@ -34,14 +35,17 @@
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/WriteLocker.h"
 #include "Basics/build.h"
+#include "Cache/Cache.h"
 #include "Cache/CacheManagerFeature.h"
 #include "Cache/Manager.h"
+#include "Cluster/ServerState.h"
 #include "GeneralServer/RestHandlerFactory.h"
 #include "Logger/Logger.h"
 #include "ProgramOptions/ProgramOptions.h"
 #include "ProgramOptions/Section.h"
 #include "Rest/Version.h"
 #include "RestHandler/RestHandlerCreator.h"
+#include "RestServer/DatabaseFeature.h"
 #include "RestServer/DatabasePathFeature.h"
 #include "RestServer/ServerIdFeature.h"
 #include "RocksDBEngine/RocksDBBackgroundThread.h"
@@ -49,6 +53,7 @@
 #include "RocksDBEngine/RocksDBColumnFamily.h"
 #include "RocksDBEngine/RocksDBCommon.h"
 #include "RocksDBEngine/RocksDBComparator.h"
+#include "RocksDBEngine/RocksDBFilterPolicy.h"
 #include "RocksDBEngine/RocksDBIncrementalSync.h"
 #include "RocksDBEngine/RocksDBIndex.h"
 #include "RocksDBEngine/RocksDBIndexFactory.h"
@@ -66,15 +71,24 @@
 #include "RocksDBEngine/RocksDBTransactionContextData.h"
 #include "RocksDBEngine/RocksDBTransactionManager.h"
 #include "RocksDBEngine/RocksDBTransactionState.h"
+#include "RocksDBEngine/RocksDBTtlThread.h"
 #include "RocksDBEngine/RocksDBTypes.h"
 #include "RocksDBEngine/RocksDBUpgrade.h"
 #include "RocksDBEngine/RocksDBV8Functions.h"
 #include "RocksDBEngine/RocksDBValue.h"
 #include "RocksDBEngine/RocksDBWalAccess.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "Transaction/Context.h"
 #include "Transaction/Options.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/DatabaseGuard.h"
+#include "Utils/ExecContext.h"
+#include "Utils/SingleCollectionTransaction.h"
 #include "VocBase/ticks.h"
+#include "VocBase/LogicalCollection.h"
 #include "VocBase/LogicalView.h"
+#include "VocBase/Methods/Collections.h"
 
 #include <rocksdb/convenience.h>
 #include <rocksdb/db.h>
@@ -90,6 +104,7 @@
 #include <rocksdb/write_batch.h>
 
 #include <velocypack/Iterator.h>
+#include <velocypack/Validator.h>
 #include <velocypack/velocypack-aliases.h>
 
 using namespace arangodb;
@@ -136,7 +151,19 @@ RocksDBEngine::RocksDBEngine(application_features::ApplicationServer* server)
       _pruneWaitTime(10.0),
       _pruneWaitTimeInitial(180.0),
       _releasedTick(0),
-      _useThrottle(true) {
+      _parallelScanThreads(1),
+      _parallelScanMinDocuments(1000000),
+      _fullScanReadaheadSize(2 * 1024 * 1024),
+      _indexBuildThreads(1),
+      _indexBuildMinDocuments(1000000),
+      _ttlFrequency(30.0),
+      _ttlMaxRemovals(100000),
+      _warmupOnStartup(false),
+      _warmupRate(0),
+      _warmupNext(0.0),
+      _useThrottle(true),
+      _throttleTargetLatency(0.0),
+      _throttlePendingCompactionBytes(0) {
   // inherits order from StorageEngine but requires "RocksDBOption" that is used
   // to configure this engine and the MMFiles PersistentIndexFeature
   startsAfter("RocksDBOption");
@@ -210,6 +237,67 @@ void RocksDBEngine::collectOptions(
                      "enable write-throttling",
                      new BooleanParameter(&_useThrottle));
 
+  options->addOption("--rocksdb.throttle-target-latency",
+                     "target for the 99th percentile of the transaction "
+                     "commit latency (in milliseconds) the write-throttling "
+                     "adapts the write rate to (0 = off)",
+                     new DoubleParameter(&_throttleTargetLatency));
+
+  options->addOption("--rocksdb.throttle-pending-compaction-bytes",
+                     "number of pending compaction bytes above which the "
+                     "adaptive write-throttling lowers the write rate "
+                     "(0 = no limit)",
+                     new UInt64Parameter(&_throttlePendingCompactionBytes));
+
+  options->addOption("--rocksdb.parallel-scan-threads",
+                     "number of partitions a large collection is read with "
+                     "in parallel by full collection scans of read-only "
+                     "transactions (1 = off)",
+                     new UInt64Parameter(&_parallelScanThreads));
+
+  options->addHiddenOption("--rocksdb.parallel-scan-min-documents",
+                           "minimum number of documents in a collection for "
+                           "reading it with a parallel scan",
+                           new UInt64Parameter(&_parallelScanMinDocuments));
+
+  options->addOption("--rocksdb.full-scan-readahead-size",
+                     "number of bytes read ahead by full collection scans, "
+                     "which also bypass the block cache (0 = default "
+                     "readahead)",
+                     new UInt64Parameter(&_fullScanReadaheadSize));
+
+  options->addOption("--rocksdb.index-build-threads",
+                     "number of threads that fill a new non-unique index of "
+                     "a large collection from a snapshot, without locking "
+                     "the collection until the final catch-up (1 = off)",
+                     new UInt64Parameter(&_indexBuildThreads));
+
+  options->addHiddenOption("--rocksdb.index-build-min-documents",
+                           "minimum number of documents in a collection for "
+                           "building a new index with several threads",
+                           new UInt64Parameter(&_indexBuildMinDocuments));
+
+  options->addOption("--rocksdb.warmup-on-startup",
+                     "load the edge and primary index caches of all "
+                     "collections in the background after server start",
+                     new BooleanParameter(&_warmupOnStartup));
+
+  options->addOption("--rocksdb.warmup-rate",
+                     "maximum number of bytes per second read by loading "
+                     "index caches, on startup and on demand (0 = unlimited)",
+                     new UInt64Parameter(&_warmupRate));
+
+  options->addOption("--rocksdb.ttl-frequency",
+                     "number of seconds between two runs of the removal of "
+                     "expired documents of collections with a TTL index "
+                     "(0 = off)",
+                     new DoubleParameter(&_ttlFrequency));
+
+  options->addHiddenOption("--rocksdb.ttl-max-removals",
+                           "maximum number of expired documents removed per "
+                           "TTL index in one run",
+                           new UInt64Parameter(&_ttlMaxRemovals));
+
 #ifdef USE_ENTERPRISE
   collectEnterpriseOptions(options);
 #endif
@@ -220,6 +308,17 @@ void RocksDBEngine::validateOptions(
     std::shared_ptr<options::ProgramOptions> options) {
   transaction::Options::setLimits(_maxTransactionSize, _intermediateCommitSize,
                                   _intermediateCommitCount);
+
+  if (_parallelScanThreads == 0) {
+    _parallelScanThreads = 1;
+  } else if (_parallelScanThreads > 64) {
+    _parallelScanThreads = 64;
+  }
+  if (_indexBuildThreads == 0) {
+    _indexBuildThreads = 1;
+  } else if (_indexBuildThreads > 64) {
+    _indexBuildThreads = 64;
+  }
 #ifdef USE_ENTERPRISE
   validateEnterpriseOptions(options);
 #endif
@@ -236,6 +335,8 @@ void RocksDBEngine::prepare() {
 
   TRI_ASSERT(!_basePath.empty());
 
+  _cacheKeysFile = basics::FileUtils::buildFilename(_basePath, "CACHE-KEYS");
+
 #ifdef USE_ENTERPRISE
   prepareEnterprise();
 #endif
@@ -271,6 +372,13 @@ void RocksDBEngine::start() {
     }
   }
 
+  // SST files of index builds that were interrupted are of no use anymore
+  _indexBuildPath =
+      databasePathFeature->subdirectoryName("engine-rocksdb-index-build");
+  if (basics::FileUtils::isDirectory(_indexBuildPath)) {
+    TRI_RemoveDirectory(_indexBuildPath.c_str());
+  }
+
   // options imported set by RocksDBOptionFeature
   auto const* opts =
   ApplicationServer::getFeature<arangodb::RocksDBOptionFeature>(
@@ -384,7 +492,12 @@ void RocksDBEngine::start() {
     tableOptions.no_block_cache = true;
   }
   tableOptions.block_size = opts->_tableBlockSize;
-  tableOptions.filter_policy.reset(rocksdb::NewBloomFilterPolicy(10, true));
+  // partitioned filters are loaded into the block cache on demand, so they
+  // are pointless without a block cache
+  bool const partitionFilters =
+      opts->_partitionFilters && opts->_blockCacheSize > 0;
+  tableOptions.filter_policy.reset(
+      rocksdb::NewBloomFilterPolicy(10, !partitionFilters));
 
   _options.table_factory.reset(
       rocksdb::NewBlockBasedTableFactory(tableOptions));
@@ -404,7 +517,14 @@ void RocksDBEngine::start() {
   _options.bloom_locality = 1;
 
   if (_useThrottle) {
-    _listener.reset(new RocksDBThrottle);
+    if (_throttleTargetLatency > 0.0) {
+      _listener.reset(new RocksDBThrottle(
+          std::chrono::microseconds(
+              static_cast<int64_t>(_throttleTargetLatency * 1000.0)),
+          _throttlePendingCompactionBytes));
+    } else {
+      _listener.reset(new RocksDBThrottle);
+    }
     _options.listeners.push_back(_listener);
   }
 
@@ -420,11 +540,22 @@ void RocksDBEngine::start() {
   fixedPrefCF.prefix_extractor = std::shared_ptr<rocksdb::SliceTransform const>(
       rocksdb::NewFixedPrefixTransform(RocksDBKey::objectIdSize()));
 
+  // table options for column families that are only ever read with
+  // iterators, i.e. by prefix or range. adding whole keys to their bloom
+  // filters would only make the filters larger
+  rocksdb::BlockBasedTableOptions rangeTableOptions(tableOptions);
+  rangeTableOptions.whole_key_filtering = false;
+
+  // the fulltext keys of a word only differ in their document id. fewer
+  // restart points let the blocks delta-encode longer runs of these keys
+  rocksdb::BlockBasedTableOptions fulltextTableOptions(rangeTableOptions);
+  fulltextTableOptions.block_restart_interval = 64;
+
   // construct column family options with prefix containing indexed value
   rocksdb::ColumnFamilyOptions dynamicPrefCF(_options);
   dynamicPrefCF.prefix_extractor = std::make_shared<RocksDBPrefixExtractor>();
   // also use hash-search based SST file format
-  rocksdb::BlockBasedTableOptions tblo(tableOptions);
+  rocksdb::BlockBasedTableOptions tblo(rangeTableOptions);
   tblo.index_type = rocksdb::BlockBasedTableOptions::IndexType::kHashSearch;
   dynamicPrefCF.table_factory = std::shared_ptr<rocksdb::TableFactory>(
       rocksdb::NewBlockBasedTableFactory(tblo));
@@ -432,22 +563,86 @@ void RocksDBEngine::start() {
   // velocypack based index variants with custom comparator
   rocksdb::ColumnFamilyOptions vpackFixedPrefCF(fixedPrefCF);
   rocksdb::BlockBasedTableOptions tblo2(tableOptions);
-  tblo2.filter_policy.reset();  // intentionally no bloom filter here
+  // intentionally no bloom filter here: the comparator considers keys with
+  // different bytes equal (e.g. the same number stored as int and double),
+  // which cannot be told apart by hashes of the keys
+  tblo2.filter_policy.reset();
   vpackFixedPrefCF.table_factory = std::shared_ptr<rocksdb::TableFactory>(
       rocksdb::NewBlockBasedTableFactory(tblo2));
   vpackFixedPrefCF.comparator = _vpackCmp.get();
 
+  // apply the settings for single column families, so that e.g. the
+  // documents can use a larger write buffer than the indexes
+  auto withSettings = [this, opts, partitionFilters](
+                          std::string const& family,
+                          rocksdb::ColumnFamilyOptions cf,
+                          rocksdb::BlockBasedTableOptions table) {
+    bool bloomFilter = (table.filter_policy != nullptr);
+    auto it = opts->_columnFamilySettings.find(family);
+    if (it != opts->_columnFamilySettings.end()) {
+      RocksDBOptionFeature::ColumnFamilySettings const& settings = (*it).second;
+      if (settings.writeBufferSize > 0) {
+        cf.write_buffer_size = static_cast<size_t>(settings.writeBufferSize);
+      }
+      if (settings.universalCompaction) {
+        cf.compaction_style = rocksdb::kCompactionStyleUniversal;
+      }
+      if (settings.bloomFilter >= 0) {
+        bloomFilter = (settings.bloomFilter == 1);
+      }
+      if (settings.wholeKeyFiltering >= 0) {
+        table.whole_key_filtering = (settings.wholeKeyFiltering == 1);
+      }
+    }
+
+    if (bloomFilter) {
+      // the hash index of the edge index cannot be combined with a two-level
+      // index, and partitioned filters require one
+      bool const partition =
+          partitionFilters &&
+          table.index_type !=
+              rocksdb::BlockBasedTableOptions::IndexType::kHashSearch;
+      if (partition) {
+        table.index_type =
+            rocksdb::BlockBasedTableOptions::IndexType::kTwoLevelIndexSearch;
+        table.partition_filters = true;
+        table.cache_index_and_filter_blocks = true;
+        table.cache_index_and_filter_blocks_with_high_priority = true;
+        table.pin_l0_filter_and_index_blocks_in_cache = true;
+      }
+      if (opts->_enableStatistics) {
+        // count the filter checks of the column family
+        auto policy = std::make_shared<RocksDBFilterPolicy>(10, !partition);
+        _filterPolicies[family] = policy;
+        table.filter_policy = policy;
+      } else {
+        table.filter_policy.reset(
+            rocksdb::NewBloomFilterPolicy(10, !partition));
+      }
+    } else {
+      table.filter_policy.reset();
+    }
+    cf.table_factory.reset(rocksdb::NewBlockBasedTableFactory(table));
+    return cf;
+  };
+
   // create column families
   std::vector<rocksdb::ColumnFamilyDescriptor> cfFamilies;
   // no prefix families for default column family (Has to be there)
   cfFamilies.emplace_back(rocksdb::kDefaultColumnFamilyName,
-                          definitionsCF);                   // 0
-  cfFamilies.emplace_back("Documents", fixedPrefCF);        // 1
-  cfFamilies.emplace_back("PrimaryIndex", fixedPrefCF);     // 2
-  cfFamilies.emplace_back("EdgeIndex", dynamicPrefCF);      // 3
-  cfFamilies.emplace_back("VPackIndex", vpackFixedPrefCF);  // 4
-  cfFamilies.emplace_back("GeoIndex", fixedPrefCF);         // 5
-  cfFamilies.emplace_back("FulltextIndex", fixedPrefCF);    // 6
+                          withSettings("definitions", definitionsCF, tableOptions));  // 0
+  cfFamilies.emplace_back("Documents",
+                          withSettings("documents", fixedPrefCF, tableOptions));      // 1
+  cfFamilies.emplace_back("PrimaryIndex",
+                          withSettings("primary", fixedPrefCF, tableOptions));        // 2
+  cfFamilies.emplace_back("EdgeIndex",
+                          withSettings("edge", dynamicPrefCF, tblo));                 // 3
+  cfFamilies.emplace_back("VPackIndex",
+                          withSettings("vpack", vpackFixedPrefCF, tblo2));            // 4
+  cfFamilies.emplace_back("GeoIndex",
+                          withSettings("geo", fixedPrefCF, rangeTableOptions));       // 5
+  cfFamilies.emplace_back("FulltextIndex",
+                          withSettings("fulltext", fixedPrefCF, fulltextTableOptions));  // 6
   // DO NOT FORGET TO DESTROY THE CFs ON CLOSE
   //  Update max_write_buffer_number above if you change number of families used
 
@@ -579,6 +774,18 @@ void RocksDBEngine::start() {
     FATAL_ERROR_EXIT();
   }
 
+  // expired documents are only removed on single servers. in a cluster
+  // the removals would have to be coordinated
+  if (_ttlFrequency > 0.0 && ServerState::instance()->isSingleServer()) {
+    _ttlThread.reset(
+        new RocksDBTtlThread(this, _ttlFrequency, _ttlMaxRemovals));
+    if (!_ttlThread->start()) {
+      LOG_TOPIC(FATAL, Logger::ENGINES)
+          << "could not start rocksdb ttl thread";
+      FATAL_ERROR_EXIT();
+    }
+  }
+
   if (!systemDatabaseExists()) {
     addSystemDatabase();
   }
@@ -593,6 +800,17 @@ void RocksDBEngine::beginShutdown() {
   if (_replicationManager != nullptr) {
     _replicationManager->beginShutdown();
   }
+
+  if (_ttlThread) {
+    _ttlThread->beginShutdown();
+  }
+
+  auto cacheFeature =
+      application_features::ApplicationServer::getFeature<CacheManagerFeature>(
+          "CacheManager");
+  if (cacheFeature->persistHotKeys() && CacheManagerFeature::MANAGER != nullptr) {
+    persistCacheKeys();
+  }
 }
 
 void RocksDBEngine::stop() {
@@ -605,6 +823,16 @@ void RocksDBEngine::stop() {
 
   replicationManager()->dropAll();
 
+  if (_ttlThread) {
+    _ttlThread->beginShutdown();
+
+    // wait until a running removal of expired documents is finished
+    while (_ttlThread->isRunning()) {
+      std::this_thread::sleep_for(std::chrono::microseconds(10000));
+    }
+    _ttlThread.reset();
+  }
+
   if (_backgroundThread) {
     // stop the press
     _backgroundThread->beginShutdown();
@@ -1143,6 +1371,8 @@ arangodb::Result RocksDBEngine::dropCollection(
 
   key.constructCollection(vocbase.id(), collection.id());
   batch.Delete(RocksDBColumnFamily::definitions(), key.string());
+  key.constructRevisionTreeValue(coll->objectId());
+  batch.Delete(RocksDBColumnFamily::definitions(), key.string());
 
   rocksdb::Status res = _db->Write(wo, &batch);
 
@@ -1167,7 +1397,7 @@ arangodb::Result RocksDBEngine::dropCollection(
   // delete documents
   RocksDBKeyBounds bounds =
       RocksDBKeyBounds::CollectionDocuments(coll->objectId());
-  auto result = rocksutils::removeLargeRange(_db, bounds, true);
+  auto result = rocksutils::removeLargeRange(_db, bounds);
 
   if (result.fail()) {
     // We try to remove all documents.
@@ -1652,16 +1882,16 @@ Result RocksDBEngine::dropDatabase(TRI_voc_tick_t id) {
         bool unique = basics::VelocyPackHelper::getBooleanValue(
           it, StaticStrings::IndexUnique.c_str(), false
         );
-        bool prefix_same_as_start = type != Index::TRI_IDX_TYPE_EDGE_INDEX;
         RocksDBKeyBounds bounds =
             RocksDBIndex::getBounds(type, objectId, unique);
 
-        res = rocksutils::removeLargeRange(_db, bounds, prefix_same_as_start);
+        res = rocksutils::removeLargeRange(_db, bounds);
         if (res.fail()) {
           return;
         }
 
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
+        bool prefix_same_as_start = type != Index::TRI_IDX_TYPE_EDGE_INDEX;
         // check if documents have been deleted
         numDocsLeft += rocksutils::countKeyRange(rocksutils::globalRocksDB(),
                                                  bounds, prefix_same_as_start);
@@ -1673,12 +1903,19 @@ Result RocksDBEngine::dropDatabase(TRI_voc_tick_t id) {
         basics::VelocyPackHelper::stringUInt64(value.slice(), "objectId");
     // delete documents
     RocksDBKeyBounds bounds = RocksDBKeyBounds::CollectionDocuments(objectId);
-    res = rocksutils::removeLargeRange(_db, bounds, true);
+    res = rocksutils::removeLargeRange(_db, bounds);
     if (res.fail()) {
       return;
     }
     // delete collection meta-data
     _settingsManager->removeCounter(objectId);
+    RocksDBKey treeKey;
+    treeKey.constructRevisionTreeValue(objectId);
+    res = globalRocksDBRemove(RocksDBColumnFamily::definitions(),
+                              treeKey.string(), wo);
+    if (res.fail()) {
+      return;
+    }
     res = globalRocksDBRemove(RocksDBColumnFamily::definitions(), value.string(), wo);
     if (res.fail()) {
       return;
@@ -1824,6 +2061,7 @@ std::unique_ptr<TRI_vocbase_t> RocksDBEngine::openExistingDatabase(
 
       physical->deserializeIndexEstimates(settingsManager());
       physical->deserializeKeyGenerator(settingsManager());
+      physical->deserializeRevisionTree();
       LOG_TOPIC(DEBUG, arangodb::Logger::FIXME) << "added document collection '"
                                                 << collection->name() << "'";
     }
@@ -1840,6 +2078,402 @@ std::unique_ptr<TRI_vocbase_t> RocksDBEngine::openExistingDatabase(
   }
 }
 
+/// @brief load the edge and primary index caches of all collections. the
+/// work is done by a scheduler thread, this returns immediately
+void RocksDBEngine::warmupCaches() {
+  auto scheduler = SchedulerFeature::SCHEDULER;
+  TRI_ASSERT(scheduler != nullptr);
+
+  scheduler->post([]() {
+    ExecContextScope scope(ExecContext::superuser());
+
+    std::vector<TRI_voc_tick_t> databases;
+    DatabaseFeature::DATABASE->enumerateDatabases(
+        [&databases](TRI_vocbase_t& vocbase) {
+          if (!vocbase.isDropped()) {
+            databases.emplace_back(vocbase.id());
+          }
+        });
+
+    double const start = TRI_microtime();
+    for (auto const& id : databases) {
+      try {
+        DatabaseGuard guard(id);
+        TRI_vocbase_t& vocbase = guard.database();
+
+        for (auto const& name : vocbase.collectionNames()) {
+          if (application_features::ApplicationServer::isStopping()) {
+            return;
+          }
+          auto collection = vocbase.lookupCollection(name);
+          if (collection == nullptr ||
+              !toRocksDBCollection(collection->getPhysical())->cacheEnabled()) {
+            continue;
+          }
+          Result res = methods::Collections::warmup(vocbase, collection.get());
+          if (res.fail()) {
+            LOG_TOPIC(WARN, Logger::ENGINES)
+                << "could not load index caches of collection '"
+                << vocbase.name() << "/" << name << "': " << res.errorMessage();
+          }
+        }
+      } catch (std::exception const& ex) {
+        LOG_TOPIC(WARN, Logger::ENGINES)
+            << "caught exception while loading index caches: " << ex.what();
+      } catch (...) {
+        LOG_TOPIC(WARN, Logger::ENGINES)
+            << "caught unknown exception while loading index caches";
+      }
+    }
+
+    LOG_TOPIC(INFO, Logger::ENGINES)
+        << "loaded index caches in " << Logger::FIXED(TRI_microtime() - start, 2)
+        << " s";
+  });
+}
+
+/// @brief limit the rate at which index cache warmups read data. called by
+/// the warmups after reading the number of bytes. all concurrent warmups
+/// share the configured rate
+void RocksDBEngine::paceWarmup(uint64_t bytes) {
+  if (_warmupRate == 0) {
+    return;
+  }
+
+  double const now = TRI_microtime();
+  double until;
+  {
+    MUTEX_LOCKER(locker, _warmupLock);
+    until = (std::max)(now, _warmupNext) +
+            static_cast<double>(bytes) / static_cast<double>(_warmupRate);
+    _warmupNext = until;
+  }
+
+  if (until > now) {
+    std::this_thread::sleep_for(std::chrono::microseconds(
+        static_cast<int64_t>((until - now) * 1000000.0)));
+  }
+}
+
+/// @brief whether or not cache keys written by the last shutdown are
+/// waiting to be loaded
+bool RocksDBEngine::cacheKeysPending() const {
+  return basics::FileUtils::exists(_cacheKeysFile);
+}
+
+/// @brief write the keys of the hottest entries of all caches, so that they
+/// can be loaded again after the next start. only the keys are written, the
+/// values are read from the database again, so they cannot be stale
+void RocksDBEngine::persistCacheKeys() {
+  auto cacheFeature =
+      application_features::ApplicationServer::getFeature<CacheManagerFeature>(
+          "CacheManager");
+  size_t const limit = static_cast<size_t>(cacheFeature->hotKeysPerCache());
+
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("version", VPackValue(1));
+  builder.add("caches", VPackValue(VPackValueType::Array));
+
+  auto addKeys = [&builder](uint64_t objectId,
+                            std::vector<std::string> const& keys) {
+    if (keys.empty()) {
+      return;
+    }
+    builder.openObject();
+    builder.add("objectId", VPackValue(std::to_string(objectId)));
+    builder.add("keys", VPackValue(VPackValueType::Array));
+    for (auto const& key : keys) {
+      builder.add(VPackValuePair(reinterpret_cast<uint8_t const*>(key.data()),
+                                 key.size(), VPackValueType::Binary));
+    }
+    builder.close();
+    builder.close();
+  };
+
+  try {
+    DatabaseFeature::DATABASE->enumerateDatabases(
+        [&](TRI_vocbase_t& vocbase) {
+          if (vocbase.isDropped()) {
+            return;
+          }
+          for (auto const& collection : vocbase.collections(false)) {
+            auto physical = toRocksDBCollection(collection->getPhysical());
+            addKeys(physical->objectId(), physical->hottestCacheKeys(limit));
+            for (auto const& idx : collection->getIndexes()) {
+              auto rIdx = static_cast<RocksDBIndex const*>(idx.get());
+              addKeys(rIdx->objectId(), rIdx->hottestCacheKeys(limit));
+            }
+          }
+        });
+    builder.close();
+    builder.close();
+
+    VPackSlice slice = builder.slice();
+    basics::FileUtils::spit(_cacheKeysFile, slice.startAs<char>(),
+                            static_cast<size_t>(slice.byteSize()), true);
+  } catch (std::exception const& ex) {
+    LOG_TOPIC(WARN, Logger::ENGINES)
+        << "could not write cache keys to '" << _cacheKeysFile
+        << "': " << ex.what();
+  }
+}
+
+/// @brief load the cache keys written by the last shutdown in the
+/// background, rate-limited. the keys are looked up through the regular read
+/// paths, so keys of documents removed in the meantime are skipped. the work
+/// is done by a scheduler thread, this returns immediately
+void RocksDBEngine::reloadCacheKeys() {
+  auto scheduler = SchedulerFeature::SCHEDULER;
+  TRI_ASSERT(scheduler != nullptr);
+
+  scheduler->post([this]() {
+    ExecContextScope scope(ExecContext::superuser());
+
+    auto cacheFeature =
+        application_features::ApplicationServer::getFeature<CacheManagerFeature>(
+            "CacheManager");
+    uint64_t const rate = cacheFeature->hotKeysReloadRate();
+    size_t const batchSize = 1000;
+
+    std::string content;
+    try {
+      content = basics::FileUtils::slurp(_cacheKeysFile);
+    } catch (...) {
+    }
+    // the keys are only loaded once, a crash while loading them does not
+    // repeat the load on the next start
+    basics::FileUtils::remove(_cacheKeysFile);
+
+    VPackSlice data(reinterpret_cast<uint8_t const*>(content.data()));
+    try {
+      velocypack::Validator validator;
+      if (content.empty() ||
+          !validator.validate(content.data(), content.size()) ||
+          !data.isObject() ||
+          basics::VelocyPackHelper::getNumericValue<uint64_t>(data, "version",
+                                                              0) != 1 ||
+          !data.get("caches").isArray()) {
+        LOG_TOPIC(WARN, Logger::ENGINES)
+            << "ignoring invalid cache keys file '" << _cacheKeysFile << "'";
+        return;
+      }
+    } catch (...) {
+      LOG_TOPIC(WARN, Logger::ENGINES)
+          << "ignoring invalid cache keys file '" << _cacheKeysFile << "'";
+      return;
+    }
+
+    double const start = TRI_microtime();
+    size_t loaded = 0;
+    for (auto const& cache : VPackArrayIterator(data.get("caches"))) {
+      try {
+        uint64_t const objectId =
+            basics::VelocyPackHelper::stringUInt64(cache, "objectId");
+        VPackSlice keysSlice = cache.get("keys");
+        if (!keysSlice.isArray()) {
+          continue;
+        }
+
+        TRI_voc_tick_t databaseId;
+        TRI_voc_cid_t cid;
+        TRI_idx_iid_t iid = 0;
+        std::tie(databaseId, cid) = mapObjectToCollection(objectId);
+        if (databaseId == 0) {
+          std::tie(databaseId, cid, iid) = mapObjectToIndex(objectId);
+          if (databaseId == 0) {
+            // dropped in the meantime
+            continue;
+          }
+        }
+
+        DatabaseGuard guard(databaseId);
+        auto collection = guard.database().lookupCollection(cid);
+        if (collection == nullptr) {
+          continue;
+        }
+        std::shared_ptr<Index> idx;
+        if (iid != 0) {
+          idx = collection->lookupIndex(iid);
+          if (idx == nullptr) {
+            continue;
+          }
+        }
+
+        std::vector<std::string> keys;
+        VPackArrayIterator it(keysSlice);
+        while (it.valid()) {
+          keys.clear();
+          for (; it.valid() && keys.size() < batchSize; it.next()) {
+            VPackSlice key = it.value();
+            if (key.isBinary()) {
+              VPackValueLength length;
+              uint8_t const* ptr = key.getBinary(length);
+              keys.emplace_back(reinterpret_cast<char const*>(ptr),
+                                static_cast<size_t>(length));
+            }
+          }
+
+          if (application_features::ApplicationServer::isStopping()) {
+            return;
+          }
+
+          SingleCollectionTransaction trx(
+              transaction::StandaloneContext::Create(guard.database()),
+              collection.get(), AccessMode::Type::READ);
+          Result res = trx.begin();
+          if (res.fail()) {
+            break;
+          }
+          if (idx == nullptr) {
+            toRocksDBCollection(collection->getPhysical())
+                ->reloadCacheKeys(&trx, keys);
+          } else {
+            static_cast<RocksDBIndex const*>(idx.get())
+                ->reloadCacheKeys(&trx, keys);
+          }
+          trx.finish(res);
+          loaded += keys.size();
+
+          if (rate > 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(
+                static_cast<int64_t>(keys.size() * 1000000 / rate)));
+          }
+        }
+      } catch (std::exception const& ex) {
+        LOG_TOPIC(WARN, Logger::ENGINES)
+            << "caught exception while loading cache keys: " << ex.what();
+      } catch (...) {
+        LOG_TOPIC(WARN, Logger::ENGINES)
+            << "caught unknown exception while loading cache keys";
+      }
+    }
+
+    LOG_TOPIC(INFO, Logger::ENGINES)
+        << "loaded " << loaded << " cache keys in "
+        << Logger::FIXED(TRI_microtime() - start, 2) << " s";
+  });
+}
+
+/// @brief keep the WAL files from the sequence number on, until the
+/// sequence number is unpinned again
+void RocksDBEngine::pinWal(rocksdb::SequenceNumber seq) {
+  MUTEX_LOCKER(locker, _pinnedWalLock);
+  _pinnedWal.emplace(seq);
+}
+
+void RocksDBEngine::unpinWal(rocksdb::SequenceNumber seq) {
+  MUTEX_LOCKER(locker, _pinnedWalLock);
+  auto it = _pinnedWal.find(seq);
+  TRI_ASSERT(it != _pinnedWal.end());
+  if (it != _pinnedWal.end()) {
+    _pinnedWal.erase(it);
+  }
+}
+
+/// @brief the lowest pinned sequence number, or UINT64_MAX
+rocksdb::SequenceNumber RocksDBEngine::earliestPinnedWal() {
+  MUTEX_LOCKER(locker, _pinnedWalLock);
+  if (_pinnedWal.empty()) {
+    return UINT64_MAX;
+  }
+  return *_pinnedWal.begin();
+}
+
+/// @brief record the latency of a transaction commit for the adaptive
+/// write-throttling
+void RocksDBEngine::recordCommitLatency(double seconds) {
+  if (_listener && _throttleTargetLatency > 0.0) {
+    _listener->RecordCommitLatency(std::chrono::microseconds(
+        static_cast<int64_t>(seconds * 1000000.0)));
+  }
+}
+
+void RocksDBEngine::getMemoryStatistics(VPackBuilder& builder) const {
+  auto addInt = [&](char const* name, std::string const& property) {
+    uint64_t v = 0;
+    if (_db->GetAggregatedIntProperty(property, &v)) {
+      builder.add(name, VPackValue(v));
+    }
+  };
+
+  builder.openObject();
+  addInt("memtables", rocksdb::DB::Properties::kCurSizeAllMemTables);
+  addInt("tableReaders", rocksdb::DB::Properties::kEstimateTableReadersMem);
+  if (_options.table_factory) {
+    void* options = _options.table_factory->GetOptions();
+    if (options != nullptr) {
+      auto* bto = static_cast<rocksdb::BlockBasedTableOptions*>(options);
+      if (bto->block_cache != nullptr) {
+        builder.add("blockCache", VPackValue(bto->block_cache->GetUsage()));
+        builder.add("blockCachePinned",
+                    VPackValue(bto->block_cache->GetPinnedUsage()));
+      }
+    }
+  }
+  builder.close();
+}
+
+void RocksDBEngine::getCacheStatistics(VPackBuilder& builder) const {
+  auto addCache = [&builder](cache::Cache const& cache) {
+    cache::Cache::Statistics stats = cache.statistics();
+    builder.add("size", VPackValue(cache.size()));
+    builder.add("usage", VPackValue(cache.usage()));
+    builder.add("usageLimit", VPackValue(cache.usageLimit()));
+    builder.add("lookups", VPackValue(stats.lookups));
+    builder.add("hits", VPackValue(stats.hits));
+    builder.add("misses", VPackValue(stats.misses));
+    builder.add("insertsRejected", VPackValue(VPackValueType::Object));
+    builder.add("busy", VPackValue(stats.insertsRejectedBusy));
+    builder.add("admission", VPackValue(stats.insertsRejectedAdmission));
+    builder.add("blacklist", VPackValue(stats.insertsRejectedBlacklist));
+    builder.add("limit", VPackValue(stats.insertsRejectedLimit));
+    builder.close();
+    builder.add("evictions", VPackValue(VPackValueType::Object));
+    builder.add("insert", VPackValue(stats.evictionsInsert));
+    builder.add("freeMemory", VPackValue(stats.evictionsFreeMemory));
+    builder.add("migration", VPackValue(stats.evictionsMigration));
+    builder.close();
+    builder.add("migrations", VPackValue(stats.migrations));
+    builder.add("resizes", VPackValue(stats.resizes));
+    builder.add("lockWaits", VPackValue(stats.lockWaits));
+    builder.add("lockWaitTime",
+                VPackValue(static_cast<double>(stats.lockWaitTime) / 1000000.0));
+  };
+
+  builder.openArray();
+  DatabaseFeature::DATABASE->enumerateDatabases([&](TRI_vocbase_t& vocbase) {
+    if (vocbase.isDropped()) {
+      return;
+    }
+    for (auto const& collection : vocbase.collections(false)) {
+      auto physical = toRocksDBCollection(collection->getPhysical());
+      auto cache = physical->cache();
+      if (cache != nullptr) {
+        builder.openObject();
+        builder.add("database", VPackValue(vocbase.name()));
+        builder.add("collection", VPackValue(collection->name()));
+        builder.add("type", VPackValue("documents"));
+        addCache(*cache);
+        builder.close();
+      }
+      for (auto const& idx : collection->getIndexes()) {
+        cache = static_cast<RocksDBIndex const*>(idx.get())->cache();
+        if (cache != nullptr) {
+          builder.openObject();
+          builder.add("database", VPackValue(vocbase.name()));
+          builder.add("collection", VPackValue(collection->name()));
+          builder.add("index", VPackValue(std::to_string(idx->id())));
+          builder.add("type", VPackValue(idx->oldtypeName()));
+          addCache(*cache);
+          builder.close();
+        }
+      }
+    }
+  });
+  builder.close();
+}
+
 void RocksDBEngine::getStatistics(VPackBuilder& builder) const {
   // add int properties
   auto addInt = [&](std::string const& s) {
@@ -1884,6 +2518,15 @@ void RocksDBEngine::getStatistics(VPackBuilder& builder) const {
             rocksdb::DB::SizeApproximationFlags::INCLUDE_FILES));
 
     builder.add("memory", VPackValue(out));
+
+    // bloom filter checks, only counted with statistics turned on
+    auto policy = _filterPolicies.find(name);
+    if (policy != _filterPolicies.end()) {
+      builder.add("bloom-filter-checked",
+                  VPackValue((*policy).second->checked()));
+      builder.add("bloom-filter-useful",
+                  VPackValue((*policy).second->useful()));
+    }
     builder.close();
   };
 
@@ -1938,6 +2581,10 @@ void RocksDBEngine::getStatistics(VPackBuilder& builder) const {
     }
   }
 
+  if (_listener) {
+    _listener->GetStatistics(builder);
+  }
+
   cache::Manager* manager = CacheManagerFeature::MANAGER;
   auto rates = manager->globalHitRates();
   builder.add("cache.limit", VPackValue(manager->globalLimit()));
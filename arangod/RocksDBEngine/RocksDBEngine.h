@@ -36,6 +36,7 @@
 #endif
 
 #include <rocksdb/options.h>
+#include <rocksdb/types.h>
 #include <velocypack/Builder.h>
 #include <velocypack/Slice.h>
 
@@ -50,11 +51,13 @@ namespace arangodb {
 class PhysicalCollection;
 class PhysicalView;
 class RocksDBBackgroundThread;
+class RocksDBFilterPolicy;
 class RocksDBKey;
 class RocksDBLogValue;
 class RocksDBRecoveryHelper;
 class RocksDBReplicationManager;
 class RocksDBSettingsManager;
+class RocksDBTtlThread;
 class RocksDBThrottle;    // breaks tons if RocksDBThrottle.h included here
 class RocksDBVPackComparator;
 class RocksDBWalAccess;
@@ -123,6 +126,10 @@ class RocksDBEngine final : public StorageEngine {
 
   void getStatistics(velocypack::Builder& builder) const override;
 
+  void getCacheStatistics(velocypack::Builder& builder) const override;
+
+  void getMemoryStatistics(velocypack::Builder& builder) const override;
+
   // inventory functionality
   // -----------------------
 
@@ -355,6 +362,69 @@ class RocksDBEngine final : public StorageEngine {
 
   double pruneWaitTimeInitial() const { return _pruneWaitTimeInitial; }
 
+  /// @brief number of partitions a collection is read with in parallel by
+  /// full scans in read-only transactions. a value of 1 turns this off
+  uint64_t parallelScanThreads() const { return _parallelScanThreads; }
+
+  /// @brief minimum number of documents in a collection for reading it
+  /// with a parallel scan
+  uint64_t parallelScanMinDocuments() const { return _parallelScanMinDocuments; }
+
+  /// @brief readahead size of full collection scans, 0 = RocksDB's default
+  uint64_t fullScanReadaheadSize() const { return _fullScanReadaheadSize; }
+
+  /// @brief number of threads that fill a new index of a large collection
+  /// while the collection is not locked. a value of 1 turns this off
+  uint64_t indexBuildThreads() const { return _indexBuildThreads; }
+
+  /// @brief minimum number of documents in a collection for building a new
+  /// index with several threads
+  uint64_t indexBuildMinDocuments() const { return _indexBuildMinDocuments; }
+
+  /// @brief directory for the SST files written by index builds
+  std::string const& indexBuildPath() const { return _indexBuildPath; }
+
+  /// @brief keep the WAL files from the sequence number on, until the
+  /// sequence number is unpinned again
+  void pinWal(rocksdb::SequenceNumber seq);
+  void unpinWal(rocksdb::SequenceNumber seq);
+
+  /// @brief the lowest pinned sequence number, or UINT64_MAX
+  rocksdb::SequenceNumber earliestPinnedWal();
+
+  /// @brief record the latency of a transaction commit for the adaptive
+  /// write-throttling
+  void recordCommitLatency(double seconds);
+
+  /// @brief whether or not to load the index caches after server start
+  bool warmupOnStartup() const { return _warmupOnStartup; }
+
+  /// @brief load the edge and primary index caches of all collections. the
+  /// work is done by a scheduler thread, this returns immediately
+  void warmupCaches();
+
+  /// @brief number of bytes a cache warmup reads between two calls to
+  /// paceWarmup
+  static constexpr uint64_t warmupPaceBytes = 1024 * 1024;
+
+  /// @brief limit the rate at which index cache warmups read data. called by
+  /// the warmups after reading the number of bytes. all concurrent warmups
+  /// share the configured rate
+  void paceWarmup(uint64_t bytes);
+
+  /// @brief whether or not cache keys written by the last shutdown are
+  /// waiting to be loaded
+  bool cacheKeysPending() const;
+
+  /// @brief write the keys of the hottest entries of all caches, so that
+  /// they can be loaded again after the next start
+  void persistCacheKeys();
+
+  /// @brief load the cache keys written by the last shutdown in the
+  /// background, rate-limited. the work is done by a scheduler thread, this
+  /// returns immediately
+  void reloadCacheKeys();
+
   // management methods for synchronizing with external persistent stores
   virtual TRI_voc_tick_t currentTick() const override;
   virtual TRI_voc_tick_t releasedTick() const override;
@@ -430,6 +500,8 @@ class RocksDBEngine final : public StorageEngine {
 
   /// Background thread handling garbage collection etc
   std::unique_ptr<RocksDBBackgroundThread> _backgroundThread;
+  /// Background thread removing expired documents of TTL indexes
+  std::unique_ptr<RocksDBTtlThread> _ttlThread;
   uint64_t _maxTransactionSize;       // maximum allowed size for a transaction
   uint64_t _intermediateCommitSize;   // maximum size for a
                                       // transaction before an
@@ -458,13 +530,71 @@ class RocksDBEngine final : public StorageEngine {
   // do not release walfiles containing writes later than this
   TRI_voc_tick_t _releasedTick;
 
+  // number of partitions for parallel full collection scans
+  uint64_t _parallelScanThreads;
+
+  // minimum collection size for parallel full collection scans
+  uint64_t _parallelScanMinDocuments;
+
+  // readahead size for full collection scans
+  uint64_t _fullScanReadaheadSize;
+
+  // number of threads for building new indexes
+  uint64_t _indexBuildThreads;
+
+  // minimum collection size for building new indexes with several threads
+  uint64_t _indexBuildMinDocuments;
+
+  // directory for the SST files written by index builds
+  std::string _indexBuildPath;
+
+  // protects _pinnedWal
+  Mutex _pinnedWalLock;
+
+  // sequence numbers from which on WAL files must be kept for index builds
+  std::multiset<rocksdb::SequenceNumber> _pinnedWal;
+
+  // number of seconds between two removals of expired documents
+  double _ttlFrequency;
+
+  // maximum number of expired documents removed per TTL index and run
+  uint64_t _ttlMaxRemovals;
+
+  // load the index caches after server start
+  bool _warmupOnStartup;
+
+  // maximum number of bytes per second read by index cache warmups
+  uint64_t _warmupRate;
+
+  // protects _warmupNext
+  Mutex _warmupLock;
+
+  // point in time from which index cache warmups may read again
+  double _warmupNext;
+
+  // file with the cache keys written on shutdown
+  std::string _cacheKeysFile;
+
   // use write-throttling
   bool _useThrottle;
 
+  // target for the 99th percentile of the commit latency (in milliseconds)
+  // of the adaptive write-throttling, 0 turns the adaptive mode off
+  double _throttleTargetLatency;
+
+  // pending compaction bytes above which the adaptive write-throttling
+  // lowers the write rate, 0 means no limit
+  uint64_t _throttlePendingCompactionBytes;
+
   // code to pace ingest rate of writes to reduce chances of compactions getting
   // too far behind and blocking incoming writes
   // (will only be set if _useThrottle is true)
   std::shared_ptr<RocksDBThrottle> _listener;
+
+  // counting bloom filter policies by column family name
+  // (will only be set if statistics are turned on)
+  std::unordered_map<std::string, std::shared_ptr<RocksDBFilterPolicy>>
+      _filterPolicies;
 };
 
 }  // namespace arangodb
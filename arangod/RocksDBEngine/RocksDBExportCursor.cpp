@@ -0,0 +1,234 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RocksDBExportCursor.h"
+#include "Aql/ExecutionState.h"
+#include "Basics/Exceptions.h"
+#include "RocksDBEngine/RocksDBCollection.h"
+#include "RocksDBEngine/RocksDBColumnFamily.h"
+#include "RocksDBEngine/RocksDBCommon.h"
+#include "RocksDBEngine/RocksDBEngine.h"
+#include "RocksDBEngine/RocksDBFormat.h"
+#include "RocksDBEngine/RocksDBKeyBounds.h"
+#include "RocksDBEngine/RocksDBValue.h"
+#include "Transaction/StandaloneContext.h"
+#include "VocBase/LogicalCollection.h"
+#include "VocBase/vocbase.h"
+
+#include <rocksdb/db.h>
+#include <rocksdb/iterator.h>
+#include <rocksdb/options.h>
+#include <rocksdb/utilities/transaction_db.h>
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Options.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+RocksDBExportCursor::Snapshot::Snapshot(
+    TRI_vocbase_t& vocbase, std::string const& name,
+    CollectionExport::Restrictions const& restrictions)
+    : _guard(&vocbase, name, false),
+      _db(rocksutils::globalRocksDB()->GetBaseDB()),
+      _snapshot(_db->GetSnapshot()),
+      _restrictions(restrictions) {
+  if (_snapshot == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+}
+
+RocksDBExportCursor::Snapshot::~Snapshot() {
+  _db->ReleaseSnapshot(_snapshot);
+}
+
+std::vector<std::pair<std::string, std::string>>
+RocksDBExportCursor::Snapshot::partition(size_t n) const {
+  TRI_ASSERT(n > 0);
+  RocksDBKeyBounds bounds = RocksDBKeyBounds::CollectionDocuments(
+      static_cast<RocksDBCollection*>(collection()->getPhysical())->objectId());
+  rocksdb::ColumnFamilyHandle* cf = RocksDBColumnFamily::documents();
+  rocksdb::Comparator const* cmp = cf->GetComparator();
+
+  // determine the first and the last key of the collection, and split the
+  // range between them evenly
+  std::vector<std::string> splits;
+  if (n > 1) {
+    rocksdb::ReadOptions ro;
+    ro.snapshot = _snapshot;
+    ro.prefix_same_as_start = true;
+    ro.fill_cache = false;
+    std::unique_ptr<rocksdb::Iterator> it(_db->NewIterator(ro, cf));
+    it->Seek(bounds.start());
+    if (it->Valid() && cmp->Compare(it->key(), bounds.end()) <= 0) {
+      TRI_ASSERT(it->key().size() == 2 * sizeof(uint64_t));
+      uint64_t const first = rocksutils::uintFromPersistentBigEndian<uint64_t>(
+          it->key().data() + sizeof(uint64_t));
+      it->SeekForPrev(bounds.end());
+      if (it->Valid() && cmp->Compare(it->key(), bounds.start()) >= 0) {
+        uint64_t const last = rocksutils::uintFromPersistentBigEndian<uint64_t>(
+            it->key().data() + sizeof(uint64_t));
+        if (last > first) {
+          uint64_t const step = std::max<uint64_t>(1, (last - first) / n);
+          for (size_t i = 1; i < n && first + step * i <= last; ++i) {
+            std::string key(bounds.start().data(), sizeof(uint64_t));
+            rocksutils::uintToPersistentBigEndian<uint64_t>(key,
+                                                            first + step * i);
+            splits.emplace_back(std::move(key));
+          }
+        }
+      }
+    }
+  }
+
+  // the last partition includes the end of the bounds, all others end
+  // before the start of the next one
+  std::vector<std::pair<std::string, std::string>> result;
+  result.reserve(splits.size() + 1);
+  std::string start = bounds.start().ToString();
+  for (auto& split : splits) {
+    result.emplace_back(std::move(start), split);
+    start = std::move(split);
+  }
+  result.emplace_back(std::move(start), bounds.end().ToString() + '\0');
+  return result;
+}
+
+RocksDBExportCursor::RocksDBExportCursor(TRI_vocbase_t& vocbase, CursorId id,
+                                         std::shared_ptr<Snapshot> snapshot,
+                                         std::string const& start,
+                                         std::string const& end,
+                                         size_t batchSize, double ttl)
+    : Cursor(id, batchSize, ttl, false),
+      _guard(vocbase),
+      _snapshot(std::move(snapshot)),
+      _end(end),
+      _upper(_end) {
+  TRI_ASSERT(_snapshot != nullptr);
+
+  // every document of the range is read exactly once
+  rocksdb::ReadOptions ro;
+  ro.snapshot = _snapshot->_snapshot;
+  ro.prefix_same_as_start = true;
+  ro.iterate_upper_bound = &_upper;
+  ro.fill_cache = false;
+  ro.readahead_size = static_cast<size_t>(
+      rocksutils::globalRocksEngine()->fullScanReadaheadSize());
+  _iterator.reset(
+      _snapshot->_db->NewIterator(ro, RocksDBColumnFamily::documents()));
+  _iterator->Seek(start);
+}
+
+RocksDBExportCursor::~RocksDBExportCursor() {
+  // the iterator must be gone before its snapshot is released
+  _iterator.reset();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check whether the cursor contains more data
+////////////////////////////////////////////////////////////////////////////////
+
+bool RocksDBExportCursor::hasNext() const {
+  return (_iterator != nullptr && _iterator->Valid());
+}
+
+std::pair<aql::ExecutionState, Result> RocksDBExportCursor::dump(
+    VPackBuilder& builder, std::function<void()>&) {
+  return {aql::ExecutionState::DONE, dumpSync(builder)};
+}
+
+Result RocksDBExportCursor::dumpSync(VPackBuilder& builder) {
+  if (_snapshot->collection()->deleted()) {
+    return Result(TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND);
+  }
+
+  auto ctx = transaction::StandaloneContext::Create(_guard.database());
+  VPackOptions const* oldOptions = builder.options;
+
+  builder.options = ctx->getVPackOptions();
+
+  auto const& restrictions = _snapshot->_restrictions;
+
+  try {
+    builder.add("result", VPackValue(VPackValueType::Array));
+    size_t const n = batchSize();
+
+    for (size_t i = 0; i < n && hasNext(); ++i) {
+      VPackSlice const slice =
+          RocksDBValue::document(_iterator->value(), _buffer);
+
+      builder.openObject();
+
+      for (auto const& entry : VPackObjectIterator(slice)) {
+        std::string key(entry.key.copyString());
+
+        if (!CollectionExport::IncludeAttribute(restrictions.type,
+                                                restrictions.fields, key)) {
+          // Ignore everything that should be excluded or not included
+          continue;
+        }
+        if (entry.value.isCustom()) {
+          builder.add(key,
+                      VPackValue(builder.options->customTypeHandler->toString(
+                          entry.value, builder.options, slice)));
+        } else {
+          builder.add(key, entry.value);
+        }
+      }
+      builder.close();
+
+      _iterator->Next();
+    }
+    builder.close();  // close Array
+
+    if (!_iterator->status().ok()) {
+      builder.options = oldOptions;
+      return rocksutils::convertStatus(_iterator->status());
+    }
+
+    builder.add("hasMore", VPackValue(hasNext()));
+
+    if (hasNext()) {
+      builder.add("id", VPackValue(std::to_string(id())));
+    } else {
+      // mark the cursor as deleted. the snapshot is released together with
+      // the last partition
+      _iterator.reset();
+      this->deleted();
+    }
+  } catch (arangodb::basics::Exception const& ex) {
+    builder.options = oldOptions;
+    return Result(ex.code(), ex.what());
+  } catch (std::exception const& ex) {
+    builder.options = oldOptions;
+    return Result(TRI_ERROR_INTERNAL, ex.what());
+  } catch (...) {
+    builder.options = oldOptions;
+    return Result(TRI_ERROR_INTERNAL,
+                  "internal error during RocksDBExportCursor::dump");
+  }
+  builder.options = oldOptions;
+  return Result();
+}
+
+std::shared_ptr<transaction::Context> RocksDBExportCursor::context() const {
+  return transaction::StandaloneContext::Create(_guard.database());
+}
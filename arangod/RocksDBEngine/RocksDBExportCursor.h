@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_ROCKSDB_ROCKSDB_EXPORT_CURSOR_H
+#define ARANGOD_ROCKSDB_ROCKSDB_EXPORT_CURSOR_H 1
+
+#include "Basics/Common.h"
+#include "Utils/CollectionExport.h"
+#include "Utils/CollectionGuard.h"
+#include "Utils/Cursor.h"
+#include "Utils/DatabaseGuard.h"
+#include "VocBase/voc-types.h"
+
+#include <rocksdb/slice.h>
+
+namespace rocksdb {
+class DB;
+class Iterator;
+class Snapshot;
+}  // namespace rocksdb
+
+namespace arangodb {
+
+/// @brief cursor over one key range of a collection's documents, as read
+/// from a snapshot. all partitions of an export share the same snapshot, so
+/// together they return a consistent state of the collection, and they can
+/// be fetched concurrently
+class RocksDBExportCursor final : public Cursor {
+ public:
+  /// @brief the snapshot and the collection of an export, released once
+  /// the last of its partitions is gone
+  class Snapshot {
+   public:
+    Snapshot(Snapshot const&) = delete;
+    Snapshot& operator=(Snapshot const&) = delete;
+
+    /// @brief takes the snapshot. this may throw
+    Snapshot(TRI_vocbase_t& vocbase, std::string const& name,
+             CollectionExport::Restrictions const& restrictions);
+    ~Snapshot();
+
+    LogicalCollection* collection() const { return _guard.collection(); }
+
+    /// @brief split the documents of the snapshot into at most n key
+    /// ranges of about the same size of the document id space. returns
+    /// the start and the exclusive end key of every range
+    std::vector<std::pair<std::string, std::string>> partition(
+        size_t n) const;
+
+   private:
+    friend class RocksDBExportCursor;
+
+    CollectionGuard _guard;
+    rocksdb::DB* _db;
+    rocksdb::Snapshot const* _snapshot;
+    CollectionExport::Restrictions const _restrictions;
+  };
+
+  RocksDBExportCursor(TRI_vocbase_t& vocbase, CursorId id,
+                      std::shared_ptr<Snapshot> snapshot,
+                      std::string const& start, std::string const& end,
+                      size_t batchSize, double ttl);
+
+  ~RocksDBExportCursor();
+
+  CursorType type() const override final { return CURSOR_EXPORT; }
+
+  /// @brief the number of documents of a partition is not known in advance
+  size_t count() const override final { return 0; }
+
+  std::pair<arangodb::aql::ExecutionState, Result> dump(
+      velocypack::Builder& result,
+      std::function<void()>& continueHandler) override final;
+
+  Result dumpSync(velocypack::Builder& result) override final;
+
+  std::shared_ptr<transaction::Context> context() const override final;
+
+ private:
+  bool hasNext() const;
+
+ private:
+  DatabaseGuard _guard;
+  std::shared_ptr<Snapshot> _snapshot;
+  /// @brief exclusive end of the key range, referenced by the iterator
+  std::string const _end;
+  rocksdb::Slice const _upper;
+  std::unique_ptr<rocksdb::Iterator> _iterator;
+  std::string _buffer;
+};
+
+}  // namespace arangodb
+
+#endif
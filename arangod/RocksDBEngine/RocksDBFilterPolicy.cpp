@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RocksDBFilterPolicy.h"
+
+using namespace arangodb;
+
+namespace {
+/// @brief full filter reader that reports its checks to the policy
+class CountingFilterBitsReader final : public rocksdb::FilterBitsReader {
+ public:
+  CountingFilterBitsReader(RocksDBFilterPolicy const* policy,
+                           rocksdb::FilterBitsReader* reader)
+      : _policy(policy), _reader(reader) {}
+
+  bool MayMatch(rocksdb::Slice const& entry) override {
+    bool result = _reader->MayMatch(entry);
+    _policy->count(result);
+    return result;
+  }
+
+ private:
+  RocksDBFilterPolicy const* _policy;
+  std::unique_ptr<rocksdb::FilterBitsReader> _reader;
+};
+}
+
+RocksDBFilterPolicy::RocksDBFilterPolicy(int bitsPerKey,
+                                         bool useBlockBasedBuilder)
+    : _policy(rocksdb::NewBloomFilterPolicy(bitsPerKey, useBlockBasedBuilder)),
+      _checked(0),
+      _useful(0) {}
+
+RocksDBFilterPolicy::~RocksDBFilterPolicy() {}
+
+rocksdb::FilterBitsReader* RocksDBFilterPolicy::GetFilterBitsReader(
+    rocksdb::Slice const& contents) const {
+  rocksdb::FilterBitsReader* reader = _policy->GetFilterBitsReader(contents);
+  if (reader == nullptr) {
+    return nullptr;
+  }
+  return new CountingFilterBitsReader(this, reader);
+}
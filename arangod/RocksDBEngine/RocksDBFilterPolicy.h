@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGO_ROCKSDB_ROCKSDB_FILTER_POLICY_H
+#define ARANGO_ROCKSDB_ROCKSDB_FILTER_POLICY_H 1
+
+#include "Basics/Common.h"
+
+#include <rocksdb/filter_policy.h>
+
+#include <atomic>
+
+namespace arangodb {
+
+/// @brief bloom filter policy that counts how often its filters were
+/// checked, and how often a check ruled out a key or prefix. one instance
+/// is used per column family, so that the effect of the filters can be
+/// measured per column family. the filter format is the one of the builtin
+/// bloom filter policy, and the name is the same, so existing SST files
+/// remain usable with and without the counting
+class RocksDBFilterPolicy final : public rocksdb::FilterPolicy {
+ public:
+  RocksDBFilterPolicy(int bitsPerKey, bool useBlockBasedBuilder);
+  ~RocksDBFilterPolicy();
+
+  char const* Name() const override { return _policy->Name(); }
+
+  void CreateFilter(rocksdb::Slice const* keys, int n,
+                    std::string* dst) const override {
+    _policy->CreateFilter(keys, n, dst);
+  }
+
+  bool KeyMayMatch(rocksdb::Slice const& key,
+                   rocksdb::Slice const& filter) const override {
+    bool result = _policy->KeyMayMatch(key, filter);
+    count(result);
+    return result;
+  }
+
+  rocksdb::FilterBitsBuilder* GetFilterBitsBuilder() const override {
+    return _policy->GetFilterBitsBuilder();
+  }
+
+  rocksdb::FilterBitsReader* GetFilterBitsReader(
+      rocksdb::Slice const& contents) const override;
+
+  /// @brief number of filter checks
+  uint64_t checked() const {
+    return _checked.load(std::memory_order_relaxed);
+  }
+
+  /// @brief number of filter checks that ruled out a key or prefix, and
+  /// thus saved a data block read
+  uint64_t useful() const { return _useful.load(std::memory_order_relaxed); }
+
+  void count(bool mayMatch) const {
+    _checked.fetch_add(1, std::memory_order_relaxed);
+    if (!mayMatch) {
+      _useful.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  std::unique_ptr<rocksdb::FilterPolicy const> _policy;
+  mutable std::atomic<uint64_t> _checked;
+  mutable std::atomic<uint64_t> _useful;
+};
+
+}  // namespace arangodb
+
+#endif
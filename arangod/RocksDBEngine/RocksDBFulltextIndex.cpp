@@ -43,9 +43,18 @@
 #include <velocypack/velocypack-aliases.h>
 
 #include <algorithm>
+#include <iterator>
+#include <limits>
 
 using namespace arangodb;
 
+namespace {
+/// @brief an AND or EXCLUDE token for a complete word reads at most this many
+/// times as many documents as the current result has, and then looks up the
+/// documents of the result instead
+constexpr size_t FulltextLookupFactor = 4;
+}
+
 RocksDBFulltextIndex::RocksDBFulltextIndex(
     TRI_idx_iid_t iid, arangodb::LogicalCollection* collection,
     VPackSlice const& info)
@@ -392,7 +401,7 @@ Result RocksDBFulltextIndex::parseQueryString(std::string const& qstr,
 }
 
 Result RocksDBFulltextIndex::executeQuery(transaction::Methods* trx, FulltextQuery const& query,
-                                          std::set<LocalDocumentId>& resultSet) {
+                                          std::vector<LocalDocumentId>& resultSet) {
   for (size_t i = 0; i < query.size(); i++) {
     FulltextQueryToken const& token = query[i];
     if (i > 0 && token.operation != FulltextQueryToken::OR
@@ -421,7 +430,7 @@ static RocksDBKeyBounds MakeBounds(uint64_t oid,
 
 Result RocksDBFulltextIndex::applyQueryToken(
     transaction::Methods* trx, FulltextQueryToken const& token,
-    std::set<LocalDocumentId>& resultSet) {
+    std::vector<LocalDocumentId>& resultSet) {
   auto mthds = RocksDBTransactionState::toMethods(trx);
   // why can't I have an assignment operator when I want one
   RocksDBKeyBounds bounds = MakeBounds(_objectId, token);
@@ -433,39 +442,70 @@ Result RocksDBFulltextIndex::applyQueryToken(
   std::unique_ptr<rocksdb::Iterator> iter = mthds->NewIterator(ro, _cf);
   iter->Seek(bounds.start());
 
-  // set is used to perform an intersection with the result set
-  std::set<LocalDocumentId> intersect;
-  // apply left to right logic, merging all current results with ALL previous
+  // an AND or EXCLUDE only needs to know which documents of the result
+  // contain a complete word. if the word is in many more documents, the
+  // documents of the result are looked up one by one instead
+  bool const canLookup = (token.matchType == FulltextQueryToken::COMPLETE &&
+                          token.operation != FulltextQueryToken::OR);
+  size_t const maxRead = canLookup ? FulltextLookupFactor * resultSet.size()
+                                   : std::numeric_limits<size_t>::max();
+
+  std::vector<LocalDocumentId> found;
+  bool lookup = false;
   while (iter->Valid() && cmp->Compare(iter->key(), end) < 0) {
     TRI_ASSERT(_objectId == RocksDBKey::objectId(iter->key()));
-
-    rocksdb::Status s = iter->status();
-    if (!s.ok()) {
-      return rocksutils::convertStatus(s);
+    if (found.size() >= maxRead) {
+      lookup = true;
+      break;
     }
+    found.emplace_back(RocksDBKey::indexDocumentId(
+        RocksDBEntryType::FulltextIndexValue, iter->key()));
+    iter->Next();
+  }
+  rocksdb::Status s = iter->status();
+  if (!s.ok()) {
+    return rocksutils::convertStatus(s);
+  }
 
-    LocalDocumentId documentId = RocksDBKey::indexDocumentId(
-        RocksDBEntryType::FulltextIndexValue, iter->key());
-    if (token.operation == FulltextQueryToken::AND) {
-      intersect.insert(documentId);
-    } else if (token.operation == FulltextQueryToken::OR) {
-      resultSet.insert(documentId);
-    } else if (token.operation == FulltextQueryToken::EXCLUDE) {
-      resultSet.erase(documentId);
+  if (lookup) {
+    // the result is sorted, and so are the documents found
+    found.clear();
+    RocksDBKeyLeaser key(trx);
+    for (LocalDocumentId const& documentId : resultSet) {
+      key->constructFulltextIndexValue(_objectId, StringRef(token.value),
+                                       documentId);
+      iter->Seek(key->string());
+      if (iter->Valid() && cmp->Compare(iter->key(), key->string()) == 0) {
+        found.emplace_back(documentId);
+      } else if (!iter->status().ok()) {
+        return rocksutils::convertStatus(iter->status());
+      }
     }
-    iter->Next();
+  } else {
+    // the documents of a word are in key order, which depends on the
+    // endianess, and a prefix matches several words
+    std::sort(found.begin(), found.end());
+    found.erase(std::unique(found.begin(), found.end()), found.end());
   }
+
+  // apply left to right logic, merging all current results with ALL previous
+  std::vector<LocalDocumentId> output;
   if (token.operation == FulltextQueryToken::AND) {
-    if (resultSet.empty() || intersect.empty()) {
-      resultSet.clear();
+    std::set_intersection(resultSet.begin(), resultSet.end(), found.begin(),
+                          found.end(), std::back_inserter(output));
+  } else if (token.operation == FulltextQueryToken::OR) {
+    if (resultSet.empty()) {
+      output = std::move(found);
     } else {
-      std::set<LocalDocumentId> output;
-      std::set_intersection(resultSet.begin(), resultSet.end(),
-                            intersect.begin(), intersect.end(),
-                            std::inserter(output, output.begin()));
-      resultSet = std::move(output);
+      output.reserve(resultSet.size() + found.size());
+      std::set_union(resultSet.begin(), resultSet.end(), found.begin(),
+                     found.end(), std::back_inserter(output));
     }
+  } else if (token.operation == FulltextQueryToken::EXCLUDE) {
+    std::set_difference(resultSet.begin(), resultSet.end(), found.begin(),
+                        found.end(), std::back_inserter(output));
   }
+  resultSet = std::move(output);
   return Result();
 }
 
@@ -499,7 +539,7 @@ IndexIterator* RocksDBFulltextIndex::iteratorForCondition(transaction::Methods*
     THROW_ARANGO_EXCEPTION(res);
   }
   
-  std::set<LocalDocumentId> results;
+  std::vector<LocalDocumentId> results;
   res = executeQuery(trx, parsedQuery, results);
   if (res.fail()) {
     THROW_ARANGO_EXCEPTION(res);
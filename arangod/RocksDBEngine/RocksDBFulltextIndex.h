@@ -104,8 +104,9 @@ class RocksDBFulltextIndex final : public RocksDBIndex {
                                       IndexIteratorOptions const&) override;
 
   arangodb::Result parseQueryString(std::string const&, FulltextQuery&);
+  /// @brief the documents matching the query, sorted by id
   Result executeQuery(transaction::Methods* trx, FulltextQuery const& query,
-                      std::set<LocalDocumentId>& resultSet);
+                      std::vector<LocalDocumentId>& resultSet);
 
  protected:
   /// insert index elements into the specified write batch.
@@ -131,7 +132,7 @@ class RocksDBFulltextIndex final : public RocksDBIndex {
 
   arangodb::Result applyQueryToken(transaction::Methods* trx,
                                    FulltextQueryToken const&,
-                                   std::set<LocalDocumentId>& resultSet);
+                                   std::vector<LocalDocumentId>& resultSet);
 };
   
 /// El Cheapo index iterator
@@ -140,7 +141,7 @@ public:
   RocksDBFulltextIndexIterator(LogicalCollection* collection,
                                transaction::Methods* trx,
                                RocksDBFulltextIndex const* index,
-                               std::set<LocalDocumentId>&& docs)
+                               std::vector<LocalDocumentId>&& docs)
   : IndexIterator(collection, trx, index),
   _docs(std::move(docs)),
   _pos(_docs.begin()) {}
@@ -169,8 +170,8 @@ public:
   }
   
 private:
-  std::set<LocalDocumentId> const _docs;
-  std::set<LocalDocumentId>::iterator _pos;
+  std::vector<LocalDocumentId> const _docs;
+  std::vector<LocalDocumentId>::const_iterator _pos;
 };
   
 }  // namespace arangodb
@@ -102,7 +102,7 @@ class RDBNearIterator final : public IndexIterator {
           }
           VPackSlice doc(_mmdr->vpack());
           geo::FilterType const ft = _near.filterType();
-          if (ft != geo::FilterType::NONE) {  // expensive test
+          if (ft != geo::FilterType::NONE && !gdoc.contained) {  // expensive test
             geo::ShapeContainer const& filter = _near.filterShape();
             TRI_ASSERT(filter.type() != geo::ShapeContainer::Type::EMPTY);
             geo::ShapeContainer test;
@@ -125,7 +125,7 @@ class RDBNearIterator final : public IndexIterator {
     return nextToken(
         [this, &cb](geo_index::Document const& gdoc) -> bool {
           geo::FilterType const ft = _near.filterType();
-          if (ft != geo::FilterType::NONE) {
+          if (ft != geo::FilterType::NONE && !gdoc.contained) {
             geo::ShapeContainer const& filter = _near.filterShape();
             TRI_ASSERT(!filter.empty());
             if (!_collection->readDocument(_trx, gdoc.token, *_mmdr)) {
@@ -27,6 +27,8 @@
 #include "Replication/DatabaseInitialSyncer.h"
 #include "Replication/utilities.h"
 #include "RocksDBEngine/RocksDBCollection.h"
+#include "RocksDBEngine/RocksDBKey.h"
+#include "RocksDBEngine/RocksDBRevisionTree.h"
 #include "RocksDBIterators.h"
 #include "SimpleHttpClient/SimpleHttpClient.h"
 #include "SimpleHttpClient/SimpleHttpResult.h"
@@ -48,7 +50,8 @@ Result syncChunkRocksDB(
     DatabaseInitialSyncer& syncer, SingleCollectionTransaction* trx,
     std::string const& keysId, uint64_t chunkId, std::string const& lowString,
     std::string const& highString,
-    std::vector<std::pair<std::string, uint64_t>> const& markers) {
+    std::vector<std::pair<std::string, uint64_t>> const& markers,
+    bool isRange) {
   // first thing we do is extend the batch lifetime
   if (!syncer._state.isChildSyncer) {
     syncer._batch.extend(syncer._state.connection, syncer._progress);
@@ -71,11 +74,18 @@ Result syncChunkRocksDB(
   LOG_TOPIC(TRACE, Logger::REPLICATION) << "syncing chunk. low: '" << lowString
                                         << "', high: '" << highString << "'";
 
+  // the ranges of the revision tree are addressed by their boundaries only,
+  // the high of a range is exclusive, and empty for the last range
+  std::string const rangeParams =
+      isRange ? "&low=" + basics::StringUtils::urlEncode(lowString) +
+                    "&high=" + basics::StringUtils::urlEncode(highString)
+              : "&low=" + lowString;
+
   // no match
   // must transfer keys for non-matching range
   std::string url =
       baseUrl + "/" + keysId + "?type=keys&chunk=" + std::to_string(chunkId) +
-      "&chunkSize=" + std::to_string(chunkSize) + "&low=" + lowString;
+      "&chunkSize=" + std::to_string(chunkSize) + rangeParams;
 
   std::string progress =
       "fetching keys chunk " + std::to_string(chunkId) + " from " + url;
@@ -123,14 +133,14 @@ Result syncChunkRocksDB(
   std::vector<size_t> toFetch;
 
   size_t const numKeys = static_cast<size_t>(responseBody.length());
-  if (numKeys == 0) {
+  if (numKeys == 0 && !isRange) {
     return Result(TRI_ERROR_REPLICATION_INVALID_RESPONSE,
                   std::string("got invalid response from master at ") +
                       syncer._state.master.endpoint +
                       ": response contains an empty chunk. Collection: " +
                       collectionName + " Chunk: " + std::to_string(chunkId));
   }
-  TRI_ASSERT(numKeys > 0);
+  TRI_ASSERT(numKeys > 0 || isRange);
 
   ManagedDocumentResult mmdr;
   size_t i = 0;
@@ -221,7 +231,8 @@ Result syncChunkRocksDB(
   while (nextStart < markers.size()) {
     std::string const& localKey = markers[nextStart].first;
 
-    if (localKey.compare(highString) > 0) {
+    // all markers of a range are below its high key
+    if (isRange || localKey.compare(highString) > 0) {
       // we have a local key that is not present remotely
       keyBuilder->clear();
       keyBuilder->openObject();
@@ -260,7 +271,7 @@ Result syncChunkRocksDB(
   while (true) {
     std::string url =
         baseUrl + "/" + keysId + "?type=docs&chunk=" + std::to_string(chunkId) +
-        "&chunkSize=" + std::to_string(chunkSize) + "&low=" + lowString +
+        "&chunkSize=" + std::to_string(chunkSize) + rangeParams +
         "&offset=" + std::to_string(offsetInChunk);
 
     progress = "fetching documents chunk " + std::to_string(chunkId) + " (" +
@@ -411,6 +422,147 @@ Result syncChunkRocksDB(
   return Result();
 }
 
+Result syncRangesRocksDB(DatabaseInitialSyncer& syncer,
+                         arangodb::LogicalCollection* col,
+                         std::string const& keysId, VPackSlice const& ranges,
+                         bool& fallback) {
+  fallback = false;
+  TRI_voc_tick_t const chunkSize = 5000;
+
+  auto invalidResponse = [&syncer]() -> Result {
+    return Result(TRI_ERROR_REPLICATION_INVALID_RESPONSE,
+                  std::string("got invalid response from master at ") +
+                      syncer._state.master.endpoint +
+                      ": ranges in response have an invalid format");
+  };
+
+  // the boundaries, hashes and counts of the remote ranges
+  std::vector<std::string> lows;
+  std::vector<std::pair<uint64_t, uint64_t>> remote;
+  lows.reserve(static_cast<size_t>(ranges.length()));
+  remote.reserve(static_cast<size_t>(ranges.length()));
+  for (VPackSlice range : VPackArrayIterator(ranges)) {
+    if (!range.isObject()) {
+      return invalidResponse();
+    }
+    VPackSlice const lowSlice = range.get("low");
+    VPackSlice const hashSlice = range.get("hash");
+    VPackSlice const countSlice = range.get("count");
+    if (!lowSlice.isString() || !hashSlice.isString() ||
+        !countSlice.isNumber()) {
+      return invalidResponse();
+    }
+    if (lows.empty() ? lowSlice.getStringLength() != 0
+                     : lowSlice.compareString(lows.back()) <= 0) {
+      return invalidResponse();
+    }
+    lows.emplace_back(lowSlice.copyString());
+    remote.emplace_back(basics::StringUtils::uint64(hashSlice.copyString()),
+                        countSlice.getNumber<uint64_t>());
+  }
+  if (lows.empty()) {
+    return invalidResponse();
+  }
+
+  if (syncer.isAborted()) {
+    return Result(TRI_ERROR_REPLICATION_APPLIER_STOPPED);
+  }
+
+  SingleCollectionTransaction trx(
+    transaction::StandaloneContext::Create(syncer.vocbase()),
+    col,
+    AccessMode::Type::EXCLUSIVE
+  );
+
+  trx.addHint(
+      transaction::Hints::Hint::RECOVERY);  // to turn off waitForSync!
+
+  Result res = trx.begin();
+
+  if (!res.ok()) {
+    return Result(
+        res.errorNumber(),
+        std::string("unable to start transaction: ") + res.errorMessage());
+  }
+
+  // no other transaction can modify the collection now, so the local tree
+  // stays valid until our own operations are committed
+  auto physical = static_cast<RocksDBCollection*>(col->getPhysical());
+  res = physical->ensureRevisionTree(static_cast<size_t>(chunkSize), &lows);
+  std::vector<RocksDBRevisionTree::Range> local;
+  if (res.ok() && (!physical->revisionTree()->ranges(local) ||
+                   local.size() != lows.size())) {
+    res.reset(TRI_ERROR_FAILED, "local revision tree was invalidated");
+  }
+  if (res.fail()) {
+    fallback = true;
+    return res;
+  }
+
+  ManagedDocumentResult mmdr;
+  auto iterator = createPrimaryIndexIterator(&trx, col);
+  uint64_t const objectId = iterator.bounds().objectId();
+  // chunk keys + revisionId
+  std::vector<std::pair<std::string, uint64_t>> markers;
+
+  for (size_t i = 0; i < lows.size(); ++i) {
+    TRI_ASSERT(local[i].low == lows[i]);
+    if (local[i].hash == remote[i].first && local[i].count == remote[i].second) {
+      // a match - nothing to do!
+      continue;
+    }
+
+    if (syncer.isAborted()) {
+      return Result(TRI_ERROR_REPLICATION_APPLIER_STOPPED);
+    }
+
+    std::string const& lowKey = lows[i];
+    std::string const highKey = (i + 1 < lows.size()) ? lows[i + 1] : "";
+
+    std::string progress = "processing keys range " + std::to_string(i) +
+                           " for collection '" + col->name() + "'";
+    syncer.setProgress(progress);
+
+    // collect the local documents of the range
+    markers.clear();
+    RocksDBKey lowSeek;
+    lowSeek.constructPrimaryIndexValue(objectId, StringRef(lowKey));
+    bool hasMore = iterator.seek(lowSeek.string());
+    bool done = false;
+    while (hasMore && !done) {
+      hasMore = iterator.next(
+          [&](rocksdb::Slice const& rocksKey, rocksdb::Slice const& rocksValue) {
+            StringRef docKey(RocksDBKey::primaryKey(rocksKey));
+            if (!highKey.empty() && docKey.compare(highKey) >= 0) {
+              done = true;
+              return;
+            }
+            TRI_voc_rid_t docRev;
+            if (!RocksDBValue::revisionId(rocksValue, docRev)) {
+              // for collections that do not have the revisionId in the value
+              auto documentId = RocksDBValue::documentId(rocksValue);
+              if (col->readDocument(&trx, documentId, mmdr) == false) {
+                TRI_ASSERT(false);
+                return;
+              }
+              VPackSlice doc(mmdr.vpack());
+              docRev = TRI_ExtractRevisionId(doc);
+            }
+            markers.emplace_back(docKey.toString(), docRev);
+          },
+          1);
+    }
+
+    res = syncChunkRocksDB(syncer, &trx, keysId, i, lowKey, highKey, markers,
+                           true);
+    if (!res.ok()) {
+      return res;
+    }
+  }
+
+  return trx.commit();
+}
+
 Result handleSyncKeysRocksDB(DatabaseInitialSyncer& syncer,
                              arangodb::LogicalCollection* col,
                              std::string const& keysId) {
@@ -430,50 +582,76 @@ Result handleSyncKeysRocksDB(DatabaseInitialSyncer& syncer,
   TRI_voc_tick_t const chunkSize = 5000;
   std::string const baseUrl = replutils::ReplicationUrl + "/keys";
 
-  std::string url =
-      baseUrl + "/" + keysId + "?chunkSize=" + std::to_string(chunkSize);
-  progress = "fetching remote keys chunks for collection '" + col->name() +
-             "' from " + url;
-  syncer.setProgress(progress);
   auto const headers = replutils::createHeaders();
-  std::unique_ptr<httpclient::SimpleHttpResult> response(
-      syncer._state.connection.client->retryRequest(rest::RequestType::GET, url, nullptr, 0,
-                                   headers));
+  auto fetchChunks = [&](std::string const& url,
+                         VPackBuilder& builder) -> Result {
+    progress = "fetching remote keys chunks for collection '" + col->name() +
+               "' from " + url;
+    syncer.setProgress(progress);
+    std::unique_ptr<httpclient::SimpleHttpResult> response(
+        syncer._state.connection.client->retryRequest(rest::RequestType::GET, url, nullptr, 0,
+                                     headers));
 
-  if (response == nullptr || !response->isComplete()) {
-    return Result(TRI_ERROR_REPLICATION_NO_RESPONSE,
-                  std::string("could not connect to master at ") +
-                      syncer._state.master.endpoint + ": " +
-                      syncer._state.connection.client->getErrorMessage());
-  }
+    if (response == nullptr || !response->isComplete()) {
+      return Result(TRI_ERROR_REPLICATION_NO_RESPONSE,
+                    std::string("could not connect to master at ") +
+                        syncer._state.master.endpoint + ": " +
+                        syncer._state.connection.client->getErrorMessage());
+    }
 
-  TRI_ASSERT(response != nullptr);
+    TRI_ASSERT(response != nullptr);
 
-  if (response->wasHttpError()) {
-    return Result(TRI_ERROR_REPLICATION_MASTER_ERROR,
-                  std::string("got invalid response from master at ") +
-                      syncer._state.master.endpoint + ": HTTP " +
-                      basics::StringUtils::itoa(response->getHttpReturnCode()) +
-                      ": " + response->getHttpReturnMessage());
-  }
+    if (response->wasHttpError()) {
+      return Result(TRI_ERROR_REPLICATION_MASTER_ERROR,
+                    std::string("got invalid response from master at ") +
+                        syncer._state.master.endpoint + ": HTTP " +
+                        basics::StringUtils::itoa(response->getHttpReturnCode()) +
+                        ": " + response->getHttpReturnMessage());
+    }
 
-  VPackBuilder builder;
-  Result r = replutils::parseResponse(builder, response.get());
+    Result r = replutils::parseResponse(builder, response.get());
 
+    if (r.fail() || !builder.slice().isArray()) {
+      return Result(TRI_ERROR_REPLICATION_INVALID_RESPONSE,
+                    std::string("got invalid response from master at ") +
+                        syncer._state.master.endpoint + ": response is no array");
+    }
+    return Result();
+  };
+
+  std::string const url =
+      baseUrl + "/" + keysId + "?chunkSize=" + std::to_string(chunkSize);
+
+  // ask for the ranges of the revision tree first. masters that do not
+  // provide them ignore the type and return the key chunks, which have no
+  // "count" attribute
+  VPackBuilder builder;
+  Result r = fetchChunks(url + "&type=ranges", builder);
   if (r.fail()) {
-    return Result(TRI_ERROR_REPLICATION_INVALID_RESPONSE,
-                  std::string("got invalid response from master at ") +
-                      syncer._state.master.endpoint + ": response is no array");
+    return r;
   }
 
-  VPackSlice const chunkSlice = builder.slice();
+  if (builder.slice().length() > 0 && builder.slice().at(0).isObject() &&
+      builder.slice().at(0).hasKey("count")) {
+    bool fallback = false;
+    r = syncRangesRocksDB(syncer, col, keysId, builder.slice(), fallback);
+    if (!fallback) {
+      return r;
+    }
 
-  if (!chunkSlice.isArray()) {
-    return Result(TRI_ERROR_REPLICATION_INVALID_RESPONSE,
-                  std::string("got invalid response from master at ") +
-                      syncer._state.master.endpoint + ": response is no array");
+    LOG_TOPIC(DEBUG, Logger::REPLICATION)
+        << "unable to sync revision ranges of collection '" << col->name()
+        << "': " << r.errorMessage() << ", syncing key chunks instead";
+    builder.clear();
+    r = fetchChunks(url, builder);
+    if (r.fail()) {
+      return r;
+    }
   }
 
+  VPackSlice const chunkSlice = builder.slice();
+  TRI_ASSERT(chunkSlice.isArray());
+
   ManagedDocumentResult mmdr;
   OperationOptions options;
   options.silent = true;
@@ -679,7 +857,7 @@ Result handleSyncKeysRocksDB(DatabaseInitialSyncer& syncer,
             if (rangeUnequal && currentChunkId < numChunks) {
               Result res =
                   syncChunkRocksDB(syncer, &trx, keysId, currentChunkId, lowKey,
-                                   highKey, markers);
+                                   highKey, markers, false);
               if (!res.ok()) {
                 THROW_ARANGO_EXCEPTION(res);
               }
@@ -719,7 +897,7 @@ Result handleSyncKeysRocksDB(DatabaseInitialSyncer& syncer,
     // we might have missed chunks, if the keys don't exist at all locally
     while (currentChunkId < numChunks) {
       Result res = syncChunkRocksDB(syncer, &trx, keysId, currentChunkId,
-                                    lowKey, highKey, markers);
+                                    lowKey, highKey, markers, false);
       if (!res.ok()) {
         THROW_ARANGO_EXCEPTION(res);
       }
@@ -34,7 +34,18 @@ Result syncChunkRocksDB(
     DatabaseInitialSyncer& syncer, SingleCollectionTransaction* trx,
     std::string const& keysId, uint64_t chunkId, std::string const& lowString,
     std::string const& highString,
-    std::vector<std::pair<std::string, uint64_t>> const& markers);
+    std::vector<std::pair<std::string, uint64_t>> const& markers,
+    bool isRange);
+
+/// @brief sync the ranges of the revision tree of the master. the local tree
+/// is built with the same range boundaries, and only the documents of the
+/// ranges whose hash or count differ are compared. fallback is set if the
+/// local tree cannot be used, and the key chunks have to be synced instead
+Result syncRangesRocksDB(DatabaseInitialSyncer& syncer,
+                         arangodb::LogicalCollection* col,
+                         std::string const& keysId,
+                         arangodb::velocypack::Slice const& ranges,
+                         bool& fallback);
 
 Result handleSyncKeysRocksDB(DatabaseInitialSyncer& syncer,
                              arangodb::LogicalCollection* col,
@@ -188,6 +188,14 @@ void RocksDBIndex::destroyCache() {
   _cachePresent = false;
 }
 
+std::vector<std::string> RocksDBIndex::hottestCacheKeys(size_t limit) const {
+  if (!useCache()) {
+    return std::vector<std::string>();
+  }
+  TRI_ASSERT(_cache != nullptr);
+  return _cache->hottestKeys(limit);
+}
+
 rocksdb::SequenceNumber RocksDBIndex::serializeEstimate(
     std::string&, rocksdb::SequenceNumber seq) const {
   // All indexes that do not have an estimator do not serialize anything.
@@ -207,11 +215,8 @@ void RocksDBIndex::recalculateEstimates() {
 }
 
 int RocksDBIndex::drop() {
-  // edge index needs to be dropped with prefix_same_as_start = false
-  // otherwise full index scan will not work
-  bool prefix_same_as_start = this->type() != Index::TRI_IDX_TYPE_EDGE_INDEX;
   arangodb::Result r = rocksutils::removeLargeRange(
-    rocksutils::globalRocksDB(), this->getBounds(), prefix_same_as_start);
+    rocksutils::globalRocksDB(), this->getBounds());
 
   // Try to drop the cache as well.
   if (_cachePresent) {
@@ -226,6 +231,9 @@ int RocksDBIndex::drop() {
   }
 
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
+  // edge index needs to be counted with prefix_same_as_start = false
+  // otherwise full index scan will not work
+  bool prefix_same_as_start = this->type() != Index::TRI_IDX_TYPE_EDGE_INDEX;
   //check if documents have been deleted
   size_t numDocs = rocksutils::countKeyRange(rocksutils::globalRocksDB(),
                                              this->getBounds(), prefix_same_as_start);
@@ -319,6 +327,7 @@ RocksDBKeyBounds RocksDBIndex::getBounds(Index::IndexType type,
     case RocksDBIndex::TRI_IDX_TYPE_HASH_INDEX:
     case RocksDBIndex::TRI_IDX_TYPE_SKIPLIST_INDEX:
     case RocksDBIndex::TRI_IDX_TYPE_PERSISTENT_INDEX:
+    case RocksDBIndex::TRI_IDX_TYPE_TTL_INDEX:
       if (unique) {
         return RocksDBKeyBounds::UniqueVPackIndex(objectId);
       }
@@ -36,6 +36,7 @@
 namespace rocksdb {
 class Comparator;
 class ColumnFamilyHandle;
+class Transaction;
 }
 namespace arangodb {
 namespace cache {
@@ -112,6 +113,19 @@ class RocksDBIndex : public Index {
   void createCache();
   void destroyCache();
 
+  /// @brief the cache of the index, or nullptr if there is none
+  std::shared_ptr<cache::Cache> cache() const {
+    return useCache() ? _cache : nullptr;
+  }
+
+  /// @brief the keys of the most recently used entries of the cache
+  std::vector<std::string> hottestCacheKeys(size_t limit) const;
+
+  /// @brief look up keys returned by hottestCacheKeys through the regular
+  /// read path of the index, which puts them into the cache again
+  virtual void reloadCacheKeys(transaction::Methods*,
+                               std::vector<std::string> const&) const {}
+
   virtual rocksdb::SequenceNumber serializeEstimate(
       std::string& output, rocksdb::SequenceNumber seq) const;
 
@@ -119,6 +133,13 @@ class RocksDBIndex : public Index {
 
   virtual void recalculateEstimates();
 
+  /// @brief write the value histogram of the index if it changed since it
+  /// was last written, and rebuild it in the background if it is outdated
+  virtual Result serializeHistogram(rocksdb::Transaction*) { return Result(); }
+
+  /// @brief load the persisted value histogram of the index, if any
+  virtual void deserializeHistogram() {}
+
   /// insert index elements into the specified write batch.
   virtual Result insertInternal(transaction::Methods* trx, RocksDBMethods*,
                                 LocalDocumentId const& documentId,
@@ -0,0 +1,533 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RocksDBIndexBuilder.h"
+#include "ApplicationFeatures/ApplicationServer.h"
+#include "Basics/Exceptions.h"
+#include "Basics/FileUtils.h"
+#include "Basics/ScopeGuard.h"
+#include "Basics/files.h"
+#include "Logger/Logger.h"
+#include "RocksDBEngine/RocksDBCollection.h"
+#include "RocksDBEngine/RocksDBColumnFamily.h"
+#include "RocksDBEngine/RocksDBCommon.h"
+#include "RocksDBEngine/RocksDBEngine.h"
+#include "RocksDBEngine/RocksDBFormat.h"
+#include "RocksDBEngine/RocksDBIndex.h"
+#include "RocksDBEngine/RocksDBKey.h"
+#include "RocksDBEngine/RocksDBKeyBounds.h"
+#include "RocksDBEngine/RocksDBMethods.h"
+#include "RocksDBEngine/RocksDBTransactionState.h"
+#include "RocksDBEngine/RocksDBValue.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/SingleCollectionTransaction.h"
+#include "VocBase/LogicalCollection.h"
+
+#include <rocksdb/db.h>
+#include <rocksdb/sst_file_writer.h>
+#include <rocksdb/transaction_log.h>
+#include <rocksdb/utilities/transaction_db.h>
+#include <rocksdb/utilities/write_batch_with_index.h>
+#include <rocksdb/write_batch.h>
+
+#include <thread>
+#include <unordered_set>
+
+using namespace arangodb;
+
+namespace {
+/// @brief number of bytes of index entries a thread sorts in memory before
+/// it writes them to an SST file
+constexpr size_t RunSize = 64 * 1024 * 1024;
+
+/// @brief number of documents between two checks whether the collection
+/// was dropped
+constexpr uint64_t CheckInterval = 10000;
+
+/// @brief number of changed documents whose index entries are written in
+/// one batch by the catch-up
+constexpr size_t CatchUpBatchSize = 1000;
+
+/// @brief collects the index entries written by insertInternal, so that
+/// they can be sorted and written to an SST file. the index is not visible
+/// yet, so there is nothing to read
+class RunMethods final : public RocksDBMethods {
+ public:
+  explicit RunMethods(RocksDBTransactionState* state)
+      : RocksDBMethods(state), _bytes(0) {}
+
+  bool Exists(rocksdb::ColumnFamilyHandle*, RocksDBKey const&) override {
+    TRI_ASSERT(false);
+    return false;
+  }
+
+  arangodb::Result Get(rocksdb::ColumnFamilyHandle*, rocksdb::Slice const&,
+                       std::string*) override {
+    TRI_ASSERT(false);
+    return arangodb::Result(TRI_ERROR_NOT_IMPLEMENTED);
+  }
+
+  arangodb::Result Put(rocksdb::ColumnFamilyHandle*, RocksDBKey const& key,
+                       rocksdb::Slice const& val,
+                       rocksutils::StatusHint) override {
+    _entries.emplace_back(key.string().ToString(), val.ToString());
+    _bytes += key.size() + val.size();
+    return arangodb::Result();
+  }
+
+  arangodb::Result Delete(rocksdb::ColumnFamilyHandle*,
+                          RocksDBKey const&) override {
+    // non-unique indexes do not undo their entries
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_NOT_IMPLEMENTED);
+  }
+
+  std::unique_ptr<rocksdb::Iterator> NewIterator(
+      rocksdb::ReadOptions const&, rocksdb::ColumnFamilyHandle*) override {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_NOT_IMPLEMENTED);
+  }
+
+  void SetSavePoint() override {}
+  arangodb::Result RollbackToSavePoint() override { return arangodb::Result(); }
+
+  size_t bytes() const { return _bytes; }
+
+  std::vector<std::pair<std::string, std::string>>& entries() {
+    return _entries;
+  }
+
+  void clear() {
+    _entries.clear();
+    _bytes = 0;
+  }
+
+ private:
+  std::vector<std::pair<std::string, std::string>> _entries;
+  size_t _bytes;
+};
+
+/// @brief collects the ids of the documents of a collection that are
+/// written or removed in a WAL batch
+class ChangeCollector final : public rocksdb::WriteBatch::Handler {
+ public:
+  ChangeCollector(uint64_t objectId, std::unordered_set<uint64_t>& changed)
+      : _objectId(objectId),
+        _cfId(RocksDBColumnFamily::documents()->GetID()),
+        _bounds(RocksDBKeyBounds::CollectionDocuments(objectId)),
+        _changed(changed),
+        _rangeDeleted(false) {}
+
+  rocksdb::Status PutCF(uint32_t cfId, rocksdb::Slice const& key,
+                        rocksdb::Slice const&) override {
+    track(cfId, key);
+    return rocksdb::Status();
+  }
+
+  rocksdb::Status DeleteCF(uint32_t cfId, rocksdb::Slice const& key) override {
+    track(cfId, key);
+    return rocksdb::Status();
+  }
+
+  rocksdb::Status SingleDeleteCF(uint32_t cfId,
+                                 rocksdb::Slice const& key) override {
+    track(cfId, key);
+    return rocksdb::Status();
+  }
+
+  rocksdb::Status DeleteRangeCF(uint32_t cfId, rocksdb::Slice const& begin,
+                                rocksdb::Slice const& end) override {
+    // a truncate removed the documents without writing their keys
+    rocksdb::Comparator const* cmp =
+        RocksDBColumnFamily::documents()->GetComparator();
+    if (cfId == _cfId && cmp->Compare(begin, _bounds.end()) <= 0 &&
+        cmp->Compare(end, _bounds.start()) > 0) {
+      _rangeDeleted = true;
+    }
+    return rocksdb::Status();
+  }
+
+  bool rangeDeleted() const { return _rangeDeleted; }
+
+ private:
+  void track(uint32_t cfId, rocksdb::Slice const& key) {
+    if (cfId == _cfId && key.size() == 2 * sizeof(uint64_t) &&
+        RocksDBKey::objectId(key) == _objectId) {
+      _changed.emplace(RocksDBKey::documentId(key).id());
+    }
+  }
+
+  uint64_t const _objectId;
+  uint32_t const _cfId;
+  RocksDBKeyBounds const _bounds;
+  std::unordered_set<uint64_t>& _changed;
+  bool _rangeDeleted;
+};
+}  // namespace
+
+RocksDBIndexBuilder::RocksDBIndexBuilder(LogicalCollection* collection,
+                                         RocksDBIndex* index, size_t numThreads)
+    : _collection(collection),
+      _index(index),
+      _numThreads(numThreads),
+      _db(rocksutils::globalRocksDB()->GetBaseDB()),
+      _snapshot(nullptr),
+      _pinnedSeq(0),
+      _walPinned(false),
+      _fileCounter(0) {
+  TRI_ASSERT(_numThreads > 0);
+  TRI_ASSERT(supports(index));
+}
+
+RocksDBIndexBuilder::~RocksDBIndexBuilder() {
+  setSnapshot(nullptr);
+  if (_walPinned) {
+    rocksutils::globalRocksEngine()->unpinWal(_pinnedSeq);
+  }
+}
+
+bool RocksDBIndexBuilder::supports(RocksDBIndex const* index) {
+  switch (index->type()) {
+    case Index::TRI_IDX_TYPE_HASH_INDEX:
+    case Index::TRI_IDX_TYPE_SKIPLIST_INDEX:
+    case Index::TRI_IDX_TYPE_PERSISTENT_INDEX:
+    case Index::TRI_IDX_TYPE_TTL_INDEX:
+      return !index->unique();
+    default:
+      return false;
+  }
+}
+
+void RocksDBIndexBuilder::setSnapshot(rocksdb::Snapshot const* snapshot) {
+  if (_snapshot != nullptr) {
+    _db->ReleaseSnapshot(_snapshot);
+  }
+  _snapshot = snapshot;
+}
+
+Result RocksDBIndexBuilder::fill() {
+  TRI_ASSERT(_snapshot == nullptr);
+  RocksDBEngine* engine = rocksutils::globalRocksEngine();
+
+  setSnapshot(_db->GetSnapshot());
+  _pinnedSeq = _snapshot->GetSequenceNumber();
+  // keep the WAL from the snapshot on for the catch-up
+  engine->pinWal(_pinnedSeq);
+  _walPinned = true;
+
+  RocksDBKeyBounds bounds = RocksDBKeyBounds::CollectionDocuments(
+      static_cast<RocksDBCollection*>(_collection->getPhysical())->objectId());
+  rocksdb::ColumnFamilyHandle* cf = RocksDBColumnFamily::documents();
+  rocksdb::Comparator const* cmp = cf->GetComparator();
+
+  // determine the first and the last key of the collection, and split the
+  // range between them evenly
+  std::vector<std::string> splits;
+  {
+    rocksdb::ReadOptions ro;
+    ro.snapshot = _snapshot;
+    ro.prefix_same_as_start = true;
+    ro.fill_cache = false;
+    std::unique_ptr<rocksdb::Iterator> it(_db->NewIterator(ro, cf));
+    it->Seek(bounds.start());
+    if (it->Valid() && cmp->Compare(it->key(), bounds.end()) <= 0) {
+      TRI_ASSERT(it->key().size() == 2 * sizeof(uint64_t));
+      uint64_t const first = rocksutils::uintFromPersistentBigEndian<uint64_t>(
+          it->key().data() + sizeof(uint64_t));
+      it->SeekForPrev(bounds.end());
+      if (it->Valid() && cmp->Compare(it->key(), bounds.start()) >= 0) {
+        uint64_t const last = rocksutils::uintFromPersistentBigEndian<uint64_t>(
+            it->key().data() + sizeof(uint64_t));
+        if (last > first && last - first >= _numThreads) {
+          uint64_t const step = (last - first) / _numThreads;
+          for (size_t i = 1; i < _numThreads; ++i) {
+            std::string key(bounds.start().data(), sizeof(uint64_t));
+            rocksutils::uintToPersistentBigEndian<uint64_t>(key,
+                                                            first + step * i);
+            splits.emplace_back(std::move(key));
+          }
+        }
+      }
+    }
+  }
+
+  std::string const path = basics::FileUtils::buildFilename(
+      engine->indexBuildPath(), std::to_string(_index->objectId()));
+  long systemError;
+  std::string errorMessage;
+  int res = TRI_CreateRecursiveDirectory(path.c_str(), systemError,
+                                         errorMessage);
+  if (res != TRI_ERROR_NO_ERROR) {
+    return Result(res, "cannot create directory '" + path +
+                           "' for building index: " + errorMessage);
+  }
+
+  size_t const n = splits.size() + 1;
+  std::vector<Result> results(n);
+  std::vector<std::thread> threads;
+  threads.reserve(n);
+  // the last partition includes the end of the bounds, all others end
+  // before their split key
+  std::string const end = bounds.end().ToString() + '\0';
+  try {
+    for (size_t i = 0; i < n; ++i) {
+      std::string const& pStart =
+          (i == 0) ? bounds.start().ToString() : splits[i - 1];
+      std::string const& pEnd = (i + 1 == n) ? end : splits[i];
+      threads.emplace_back([this, &results, i, pStart, pEnd, &path]() {
+        try {
+          results[i] = fillPartition(pStart, pEnd, path);
+        } catch (basics::Exception const& ex) {
+          results[i].reset(ex.code(), ex.what());
+        } catch (std::bad_alloc const&) {
+          results[i].reset(TRI_ERROR_OUT_OF_MEMORY);
+        } catch (std::exception const& ex) {
+          results[i].reset(TRI_ERROR_INTERNAL, ex.what());
+        }
+      });
+    }
+  } catch (...) {
+    results[threads.size()].reset(TRI_ERROR_INTERNAL,
+                                  "cannot start index build thread");
+  }
+
+  for (auto& t : threads) {
+    t.join();
+  }
+  TRI_RemoveDirectory(path.c_str());
+
+  for (auto const& r : results) {
+    if (r.fail()) {
+      return r;
+    }
+  }
+
+  // the estimates of the ingested entries. the catch-up tracks its changes
+  // in the transaction as usual
+  _index->recalculateEstimates();
+  return Result();
+}
+
+Result RocksDBIndexBuilder::fillPartition(std::string const& start,
+                                          std::string const& end,
+                                          std::string const& path) {
+  // insertInternal needs a transaction of its own in every thread, for
+  // leasing builders and for tracking estimates. the estimates are computed
+  // once all entries are ingested, so the transaction is never committed
+  SingleCollectionTransaction trx(
+      transaction::StandaloneContext::Create(_collection->vocbase()),
+      _collection, AccessMode::Type::READ);
+  Result res = trx.begin();
+  if (res.fail()) {
+    return res;
+  }
+
+  rocksdb::ColumnFamilyHandle* cf = _index->columnFamily();
+  rocksdb::Comparator const* cmp = cf->GetComparator();
+  rocksdb::Options const options = _db->GetOptions(cf);
+
+  RunMethods run(RocksDBTransactionState::toState(&trx));
+
+  auto writeRun = [&]() -> Result {
+    auto& entries = run.entries();
+    if (entries.empty()) {
+      return Result();
+    }
+    std::sort(entries.begin(), entries.end(),
+              [cmp](std::pair<std::string, std::string> const& lhs,
+                    std::pair<std::string, std::string> const& rhs) {
+                return cmp->Compare(lhs.first, rhs.first) < 0;
+              });
+
+    std::string const file = basics::FileUtils::buildFilename(
+        path, std::to_string(++_fileCounter) + ".sst");
+    rocksdb::SstFileWriter writer(rocksdb::EnvOptions(), options, cf);
+    rocksdb::Status s = writer.Open(file);
+    for (size_t i = 0; s.ok() && i < entries.size(); ++i) {
+      // an array index produces the same entry for repeated array values
+      if (i > 0 && cmp->Compare(entries[i - 1].first, entries[i].first) == 0) {
+        continue;
+      }
+      s = writer.Put(entries[i].first, entries[i].second);
+    }
+    if (s.ok()) {
+      s = writer.Finish();
+    }
+    if (s.ok()) {
+      // runs of different threads overlap, so every file is ingested on
+      // its own
+      rocksdb::IngestExternalFileOptions ingestOptions;
+      ingestOptions.move_files = true;
+      s = _db->IngestExternalFile(cf, {file}, ingestOptions);
+    }
+    TRI_UnlinkFile(file.c_str());
+    run.clear();
+    return rocksutils::convertStatus(s, rocksutils::StatusHint::index);
+  };
+
+  rocksdb::ReadOptions ro;
+  ro.snapshot = _snapshot;
+  ro.prefix_same_as_start = true;
+  ro.fill_cache = false;
+  ro.verify_checksums = false;
+  rocksdb::Slice const upper(end);
+  ro.iterate_upper_bound = &upper;
+
+  std::unique_ptr<rocksdb::Iterator> it(
+      _db->NewIterator(ro, RocksDBColumnFamily::documents()));
+  std::string buffer;
+  uint64_t numDocs = 0;
+  for (it->Seek(start); it->Valid(); it->Next()) {
+    if (++numDocs % CheckInterval == 0) {
+      if (_collection->deleted()) {
+        return Result(TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND);
+      }
+      if (application_features::ApplicationServer::isStopping()) {
+        return Result(TRI_ERROR_SHUTTING_DOWN);
+      }
+    }
+    VPackSlice doc = RocksDBValue::document(it->value(), buffer);
+    res = _index->insertInternal(&trx, &run, RocksDBKey::documentId(it->key()),
+                                 doc, Index::OperationMode::normal);
+    if (res.fail()) {
+      return res;
+    }
+    if (run.bytes() >= RunSize) {
+      res = writeRun();
+      if (res.fail()) {
+        return res;
+      }
+    }
+  }
+  if (!it->status().ok()) {
+    return rocksutils::convertStatus(it->status());
+  }
+  return writeRun();
+}
+
+Result RocksDBIndexBuilder::catchUp(transaction::Methods* trx,
+                                    uint64_t& numChanged) {
+  TRI_ASSERT(_snapshot != nullptr);
+  numChanged = 0;
+
+  uint64_t const objectId =
+      static_cast<RocksDBCollection*>(_collection->getPhysical())->objectId();
+  rocksdb::SequenceNumber const from = _snapshot->GetSequenceNumber();
+  rocksdb::Snapshot const* next = _db->GetSnapshot();
+  rocksdb::SequenceNumber const to = next->GetSequenceNumber();
+  auto releaseNext = scopeGuard([&]() {
+    if (next != nullptr) {
+      _db->ReleaseSnapshot(next);
+    }
+  });
+
+  // collect the documents changed between the snapshots
+  std::unordered_set<uint64_t> changed;
+  ChangeCollector collector(objectId, changed);
+  if (to > from) {
+    std::unique_ptr<rocksdb::TransactionLogIterator> iterator;
+    rocksdb::TransactionLogIterator::ReadOptions logOptions(false);
+    rocksdb::Status s = _db->GetUpdatesSince(from + 1, &iterator, logOptions);
+    while (s.ok() && iterator->Valid()) {
+      rocksdb::BatchResult batch = iterator->GetBatch();
+      if (batch.sequence > to) {
+        break;
+      }
+      if (batch.sequence > from) {
+        s = batch.writeBatchPtr->Iterate(&collector);
+      }
+      if (s.ok()) {
+        iterator->Next();
+        s = iterator->status();
+      }
+    }
+    if (!s.ok()) {
+      return rocksutils::convertStatus(s, rocksutils::StatusHint::wal);
+    }
+  }
+  if (collector.rangeDeleted()) {
+    // the changed documents are unknown, the caller has to start over
+    return Result(TRI_ERROR_ARANGO_CONFLICT,
+                  "collection was truncated while building the index");
+  }
+
+  // move every changed document from its version in the old snapshot to
+  // its version in the new one
+  rocksdb::ReadOptions oldOptions;
+  oldOptions.snapshot = _snapshot;
+  rocksdb::ReadOptions newOptions;
+  newOptions.snapshot = next;
+
+  rocksdb::ColumnFamilyHandle* cf = RocksDBColumnFamily::documents();
+  rocksdb::WriteBatchWithIndex batch(_index->columnFamily()->GetComparator(),
+                                     32 * 1024 * 1024);
+  RocksDBBatchedMethods batched(RocksDBTransactionState::toState(trx), &batch);
+  rocksdb::WriteOptions writeOptions;
+
+  RocksDBKey key;
+  std::string value;
+  std::string buffer;
+  size_t inBatch = 0;
+  Result res;
+  for (uint64_t const id : changed) {
+    LocalDocumentId const documentId(id);
+    key.constructDocument(objectId, documentId);
+
+    rocksdb::Status s = _db->Get(oldOptions, cf, key.string(), &value);
+    if (s.ok()) {
+      res = _index->removeInternal(trx, &batched, documentId,
+                                   RocksDBValue::document(value, buffer),
+                                   Index::OperationMode::normal);
+    } else if (!s.IsNotFound()) {
+      res = rocksutils::convertStatus(s);
+    }
+    if (res.ok()) {
+      s = _db->Get(newOptions, cf, key.string(), &value);
+      if (s.ok()) {
+        res = _index->insertInternal(trx, &batched, documentId,
+                                     RocksDBValue::document(value, buffer),
+                                     Index::OperationMode::normal);
+      } else if (!s.IsNotFound()) {
+        res = rocksutils::convertStatus(s);
+      }
+    }
+    if (res.fail()) {
+      return res;
+    }
+
+    ++numChanged;
+    if (++inBatch == CatchUpBatchSize) {
+      s = _db->Write(writeOptions, batch.GetWriteBatch());
+      if (!s.ok()) {
+        return rocksutils::convertStatus(s, rocksutils::StatusHint::index);
+      }
+      batch.Clear();
+      inBatch = 0;
+    }
+  }
+  if (inBatch > 0) {
+    rocksdb::Status s = _db->Write(writeOptions, batch.GetWriteBatch());
+    if (!s.ok()) {
+      return rocksutils::convertStatus(s, rocksutils::StatusHint::index);
+    }
+  }
+
+  setSnapshot(next);
+  next = nullptr;
+  return Result();
+}
@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_ROCKSDB_ROCKSDB_INDEX_BUILDER_H
+#define ARANGOD_ROCKSDB_ROCKSDB_INDEX_BUILDER_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Result.h"
+
+#include <rocksdb/types.h>
+
+namespace rocksdb {
+class DB;
+class Snapshot;
+}  // namespace rocksdb
+
+namespace arangodb {
+class LogicalCollection;
+class RocksDBIndex;
+
+namespace transaction {
+class Methods;
+}
+
+/// @brief fills a new index of a collection without holding the collection
+/// lock. the documents of a snapshot are split into key ranges, which are
+/// read by several threads. each thread sorts the index entries of its
+/// documents into runs, which are written to SST files and ingested into
+/// RocksDB. documents written after the snapshot are then caught up from
+/// the WAL, in rounds that each move the index to a newer snapshot. only
+/// the last round needs the collection to be locked, so writes are blocked
+/// only for the changes made during the previous round.
+/// the index is not visible while it is built, so nobody else writes to it.
+/// only index types whose entries can be written blindly are supported
+class RocksDBIndexBuilder {
+ public:
+  RocksDBIndexBuilder(RocksDBIndexBuilder const&) = delete;
+  RocksDBIndexBuilder& operator=(RocksDBIndexBuilder const&) = delete;
+
+  RocksDBIndexBuilder(LogicalCollection* collection, RocksDBIndex* index,
+                      size_t numThreads);
+  ~RocksDBIndexBuilder();
+
+  /// @brief whether or not the index can be filled by the builder. unique
+  /// indexes need to check their entries against each other, which the
+  /// independent runs cannot do
+  static bool supports(RocksDBIndex const* index);
+
+  /// @brief take the initial snapshot, and fill the index with its documents
+  Result fill();
+
+  /// @brief apply the document changes made after the current snapshot to
+  /// the index, up to a new snapshot which then becomes the current one.
+  /// the index is complete once this is called with the collection locked.
+  /// returns the number of documents changed
+  Result catchUp(transaction::Methods* trx, uint64_t& numChanged);
+
+ private:
+  /// @brief read the documents of a partition of the snapshot and ingest
+  /// their index entries
+  Result fillPartition(std::string const& start, std::string const& end,
+                       std::string const& path);
+
+  /// @brief replace the current snapshot
+  void setSnapshot(rocksdb::Snapshot const* snapshot);
+
+ private:
+  LogicalCollection* _collection;
+  RocksDBIndex* _index;
+  size_t const _numThreads;
+  rocksdb::DB* _db;
+  /// @brief the snapshot whose documents are in the index
+  rocksdb::Snapshot const* _snapshot;
+  /// @brief the sequence number the WAL is pinned at for the catch-up
+  rocksdb::SequenceNumber _pinnedSeq;
+  bool _walPinned;
+  /// @brief counter for the names of the SST files
+  std::atomic<uint64_t> _fileCounter;
+};
+
+}  // namespace arangodb
+
+#endif
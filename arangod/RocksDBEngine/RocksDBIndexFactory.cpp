@@ -35,6 +35,7 @@
 #include "RocksDBEngine/RocksDBPersistentIndex.h"
 #include "RocksDBEngine/RocksDBPrimaryIndex.h"
 #include "RocksDBEngine/RocksDBSkiplistIndex.h"
+#include "RocksDBEngine/RocksDBTtlIndex.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "VocBase/LogicalCollection.h"
 #include "VocBase/ticks.h"
@@ -151,6 +152,22 @@ static void ProcessIndexDeduplicateFlag(VPackSlice const definition,
   builder.add("deduplicate", VPackValue(dup));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief process the cacheEnabled flag and add it to the json. the flag is
+/// only kept for unique indexes, as only their point lookups use the cache
+////////////////////////////////////////////////////////////////////////////////
+
+static void ProcessIndexCacheEnabledFlag(VPackSlice const definition,
+                                         VPackBuilder& builder) {
+  bool unique = basics::VelocyPackHelper::getBooleanValue(
+      definition, arangodb::StaticStrings::IndexUnique.c_str(), false);
+  bool cacheEnabled = basics::VelocyPackHelper::getBooleanValue(
+      definition, "cacheEnabled", false);
+  if (unique && cacheEnabled) {
+    builder.add("cacheEnabled", VPackValue(true));
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief enhances the json of a vpack index
 ////////////////////////////////////////////////////////////////////////////////
@@ -163,6 +180,7 @@ static int EnhanceJsonIndexVPack(VPackSlice const definition,
     ProcessIndexSparseFlag(definition, builder, create);
     ProcessIndexUniqueFlag(definition, builder);
     ProcessIndexDeduplicateFlag(definition, builder);
+    ProcessIndexCacheEnabledFlag(definition, builder);
   }
 
   return res;
@@ -288,6 +306,40 @@ static int EnhanceJsonIndexFulltext(VPackSlice const definition,
   return res;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief enhances the json of a ttl index
+////////////////////////////////////////////////////////////////////////////////
+
+static int EnhanceJsonIndexTtl(VPackSlice const definition,
+                               VPackBuilder& builder, bool create) {
+  int res = ProcessIndexFields(definition, builder, 1, 1, create);
+
+  if (res == TRI_ERROR_NO_ERROR) {
+    // hard-coded defaults. documents without a numeric timestamp must not
+    // be indexed, so that they never expire
+    builder.add(
+      arangodb::StaticStrings::IndexSparse,
+      arangodb::velocypack::Value(true)
+    );
+    builder.add(
+      arangodb::StaticStrings::IndexUnique,
+      arangodb::velocypack::Value(false)
+    );
+    builder.add("deduplicate", VPackValue(true));
+
+    // handle "expireAfter" attribute
+    VPackSlice expireAfter = definition.get("expireAfter");
+
+    if (!expireAfter.isNumber() || expireAfter.getNumber<double>() < 0.0) {
+      return TRI_ERROR_BAD_PARAMETER;
+    }
+
+    builder.add("expireAfter", VPackValue(expireAfter.getNumber<double>()));
+  }
+
+  return res;
+}
+
 RocksDBIndexFactory::RocksDBIndexFactory() {
   emplaceFactory("edge",
                  [](LogicalCollection* collection,
@@ -380,6 +432,14 @@ RocksDBIndexFactory::RocksDBIndexFactory() {
                                                                  definition);
                  });
 
+  emplaceFactory("ttl",
+                 [](LogicalCollection* collection,
+                    velocypack::Slice const& definition, TRI_idx_iid_t id,
+                    bool isClusterConstructor) -> std::shared_ptr<Index> {
+                   return std::make_shared<RocksDBTtlIndex>(id, collection,
+                                                            definition);
+                 });
+
   emplaceNormalizer(
       "edge",
       [](velocypack::Builder& normalized, velocypack::Slice definition,
@@ -582,6 +642,27 @@ RocksDBIndexFactory::RocksDBIndexFactory() {
 
         return EnhanceJsonIndexVPack(definition, normalized, isCreation);
       });
+
+  emplaceNormalizer(
+      "ttl",
+      [](velocypack::Builder& normalized, velocypack::Slice definition,
+         bool isCreation) -> arangodb::Result {
+        TRI_ASSERT(normalized.isOpenObject());
+        normalized.add(
+          arangodb::StaticStrings::IndexType,
+          arangodb::velocypack::Value(
+            Index::oldtypeName(Index::TRI_IDX_TYPE_TTL_INDEX)
+          )
+        );
+
+        if (isCreation && !ServerState::instance()->isCoordinator() &&
+            !definition.hasKey("objectId")) {
+          normalized.add("objectId", velocypack::Value(
+                                         std::to_string(TRI_NewTickServer())));
+        }
+
+        return EnhanceJsonIndexTtl(definition, normalized, isCreation);
+      });
 }
 
 
@@ -0,0 +1,332 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RocksDBIndexHistogram.h"
+
+#include "Basics/Exceptions.h"
+#include "Basics/VelocyPackHelper.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace {
+int compare(VPackSlice lhs, VPackSlice rhs) {
+  return basics::VelocyPackHelper::compare(lhs, rhs, true);
+}
+
+/// @brief position of a value between the bounds of a bucket, as a share
+/// of the bucket. only numeric bounds can be interpolated, for all other
+/// values the middle of the bucket is assumed
+double interpolate(VPackSlice lower, VPackSlice upper, VPackSlice value) {
+  if (!lower.isNumber() || !upper.isNumber() || !value.isNumber()) {
+    return 0.5;
+  }
+  double const l = lower.getNumber<double>();
+  double const u = upper.getNumber<double>();
+  if (u <= l) {
+    return 0.5;
+  }
+  double const v = value.getNumber<double>();
+  return (std::min)(1.0, (std::max)(0.0, (v - l) / (u - l)));
+}
+
+void invalidHistogram() {
+  THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                 "invalid index histogram");
+}
+}
+
+RocksDBIndexHistogram::Builder::Builder()
+    : _currentCount(0), _total(0), _depth(1), _bucketOpen(false) {}
+
+/// @brief add the next value. values must be added in sorted order
+void RocksDBIndexHistogram::Builder::add(VPackSlice value) {
+  if (_currentCount > 0) {
+    int const res = ::compare(value, _current.slice());
+    TRI_ASSERT(res >= 0);
+    if (res == 0) {
+      ++_currentCount;
+      ++_total;
+      return;
+    }
+    closeRun();
+  } else if (_total == 0) {
+    _min.add(value);
+  }
+
+  _current.clear();
+  _current.add(value);
+  _currentCount = 1;
+  ++_total;
+}
+
+/// @brief return the histogram over all added values
+std::unique_ptr<RocksDBIndexHistogram> RocksDBIndexHistogram::Builder::finish() {
+  closeRun();
+  if (_buckets.size() > maxBuckets) {
+    mergeBuckets();
+  }
+  TRI_ASSERT(_buckets.size() <= maxBuckets);
+
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("total", VPackValue(_total));
+  builder.add("min", _total > 0 ? _min.slice() : VPackSlice::nullSlice());
+  builder.add("buckets", VPackValue(VPackValueType::Array));
+  for (auto const& it : _buckets) {
+    builder.openArray();
+    builder.add(it.upper.slice());
+    builder.add(VPackValue(it.count));
+    builder.add(VPackValue(it.distinct));
+    builder.close();
+  }
+  builder.close();
+  builder.add("frequent", VPackValue(VPackValueType::Array));
+  for (auto const& it : _frequent) {
+    // only values that fill more than an average bucket are worth keeping
+    if (it.count * maxBuckets > _total) {
+      builder.openArray();
+      builder.add(it.value.slice());
+      builder.add(VPackValue(it.count));
+      builder.close();
+    }
+  }
+  builder.close();
+  builder.close();
+
+  return std::make_unique<RocksDBIndexHistogram>(builder.slice());
+}
+
+/// @brief finish the run of equal values ending with the current value
+void RocksDBIndexHistogram::Builder::closeRun() {
+  if (_currentCount == 0) {
+    return;
+  }
+
+  // buckets are only closed between two distinct values, so that all
+  // entries with the same value end up in the same bucket
+  if (!_bucketOpen) {
+    _buckets.emplace_back(Bucket{VPackBuilder(), 0, 0});
+    _bucketOpen = true;
+  }
+  Bucket& bucket = _buckets.back();
+  bucket.upper.clear();
+  bucket.upper.add(_current.slice());
+  bucket.count += _currentCount;
+  ++bucket.distinct;
+
+  if (bucket.count >= _depth) {
+    _bucketOpen = false;
+    if (_buckets.size() >= 2 * maxBuckets) {
+      mergeBuckets();
+    }
+  }
+
+  if (_frequent.size() < maxFrequentValues) {
+    _frequent.emplace_back(Frequent{VPackBuilder(), _currentCount});
+    _frequent.back().value.add(_current.slice());
+  } else {
+    auto least = std::min_element(
+        _frequent.begin(), _frequent.end(),
+        [](Frequent const& lhs, Frequent const& rhs) {
+          return lhs.count < rhs.count;
+        });
+    if ((*least).count < _currentCount) {
+      (*least).value.clear();
+      (*least).value.add(_current.slice());
+      (*least).count = _currentCount;
+    }
+  }
+
+  _currentCount = 0;
+}
+
+/// @brief merge adjacent buckets pairwise and double the bucket depth
+void RocksDBIndexHistogram::Builder::mergeBuckets() {
+  size_t const n = _buckets.size();
+  size_t target = 0;
+  for (size_t i = 0; i < n; i += 2) {
+    if (i + 1 < n) {
+      _buckets[i + 1].count += _buckets[i].count;
+      _buckets[i + 1].distinct += _buckets[i].distinct;
+      _buckets[target] = std::move(_buckets[i + 1]);
+    } else {
+      _buckets[target] = std::move(_buckets[i]);
+    }
+    ++target;
+  }
+  _buckets.resize(target);
+  _depth *= 2;
+}
+
+/// @brief create a histogram from its velocypack representation. throws
+/// if the data is invalid
+RocksDBIndexHistogram::RocksDBIndexHistogram(VPackSlice data) : _total(0) {
+  if (!data.isObject()) {
+    invalidHistogram();
+  }
+  _data.add(data);
+
+  VPackSlice const slice = _data.slice();
+  VPackSlice value = slice.get("total");
+  if (!value.isNumber()) {
+    invalidHistogram();
+  }
+  _total = value.getNumber<uint64_t>();
+
+  _min = slice.get("min");
+  if (_min.isNone()) {
+    invalidHistogram();
+  }
+
+  value = slice.get("buckets");
+  if (!value.isArray()) {
+    invalidHistogram();
+  }
+  for (auto const& it : VPackArrayIterator(value)) {
+    if (!it.isArray() || it.length() != 3 || !it.at(1).isNumber() ||
+        !it.at(2).isNumber()) {
+      invalidHistogram();
+    }
+    _buckets.emplace_back(Bucket{it.at(0), it.at(1).getNumber<uint64_t>(),
+                                 it.at(2).getNumber<uint64_t>()});
+  }
+
+  value = slice.get("frequent");
+  if (!value.isArray()) {
+    invalidHistogram();
+  }
+  for (auto const& it : VPackArrayIterator(value)) {
+    if (!it.isArray() || it.length() != 2 || !it.at(1).isNumber()) {
+      invalidHistogram();
+    }
+    _frequent.emplace_back(it.at(0), it.at(1).getNumber<uint64_t>());
+  }
+}
+
+/// @brief estimated share of values equal to the value
+double RocksDBIndexHistogram::equalitySelectivity(VPackSlice value) const {
+  if (_total == 0) {
+    return 0.0;
+  }
+
+  for (auto const& it : _frequent) {
+    if (::compare(value, it.first) == 0) {
+      return static_cast<double>(it.second) / static_cast<double>(_total);
+    }
+  }
+
+  if (::compare(value, _min) >= 0) {
+    for (size_t i = 0; i < _buckets.size(); ++i) {
+      if (::compare(value, _buckets[i].upper) <= 0) {
+        return averageCount(i) / static_cast<double>(_total);
+      }
+    }
+  }
+
+  // values outside of the histogram were added after it was built. assume
+  // they are rare
+  return 1.0 / static_cast<double>(_total);
+}
+
+/// @brief estimated share of values in a range. an undefined (none) bound
+/// leaves the range open on its side
+double RocksDBIndexHistogram::rangeSelectivity(VPackSlice lower,
+                                               bool lowerIncluded,
+                                               VPackSlice upper,
+                                               bool upperIncluded) const {
+  if (_total == 0) {
+    return 0.0;
+  }
+
+  double const total = static_cast<double>(_total);
+  double const from = lower.isNone() ? 0.0 : rank(lower, !lowerIncluded);
+  double const to = upper.isNone() ? total : rank(upper, upperIncluded);
+
+  return (std::min)(1.0, (std::max)(0.0, (to - from) / total));
+}
+
+/// @brief estimated number of values less than (or, if inclusive is set, less
+/// than or equal to) the value
+double RocksDBIndexHistogram::rank(VPackSlice value, bool inclusive) const {
+  int res = ::compare(value, _min);
+  if (res < 0 || (res == 0 && !inclusive)) {
+    return 0.0;
+  }
+
+  double result = 0.0;
+  VPackSlice lower = _min;
+  for (size_t i = 0; i < _buckets.size(); ++i) {
+    Bucket const& bucket = _buckets[i];
+    double const count = static_cast<double>(bucket.count);
+    res = ::compare(value, bucket.upper);
+
+    if (res > 0) {
+      result += count;
+      lower = bucket.upper;
+      continue;
+    }
+
+    if (res == 0) {
+      if (inclusive) {
+        return result + count;
+      }
+      double equal = averageCount(i);
+      for (auto const& it : _frequent) {
+        if (::compare(value, it.first) == 0) {
+          equal = static_cast<double>(it.second);
+          break;
+        }
+      }
+      return result + (std::max)(0.0, count - equal);
+    }
+
+    return result + interpolate(lower, bucket.upper, value) * count;
+  }
+
+  return result;
+}
+
+/// @brief estimated number of entries per distinct value inside a bucket,
+/// not counting the frequent values
+double RocksDBIndexHistogram::averageCount(size_t bucket) const {
+  TRI_ASSERT(bucket < _buckets.size());
+
+  VPackSlice const upper = _buckets[bucket].upper;
+  double count = static_cast<double>(_buckets[bucket].count);
+  double distinct = static_cast<double>(_buckets[bucket].distinct);
+
+  for (auto const& it : _frequent) {
+    bool const aboveLower =
+        (bucket == 0) ? ::compare(it.first, _min) >= 0
+                      : ::compare(it.first, _buckets[bucket - 1].upper) > 0;
+    if (aboveLower && ::compare(it.first, upper) <= 0) {
+      count -= static_cast<double>(it.second);
+      distinct -= 1.0;
+    }
+  }
+
+  if (count < 1.0 || distinct < 1.0) {
+    return 1.0;
+  }
+  return count / distinct;
+}
@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_ROCKSDB_ROCKSDB_INDEX_HISTOGRAM_H
+#define ARANGOD_ROCKSDB_ROCKSDB_INDEX_HISTOGRAM_H 1
+
+#include "Basics/Common.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+
+/// @brief equi-depth histogram over the values of an index attribute.
+/// all buckets hold roughly the same number of entries, so that ranges of
+/// frequent values are split into narrow buckets and ranges of rare values
+/// are combined into wide ones. values that are much more frequent than
+/// the depth of a bucket are additionally recorded with their exact counts.
+/// the histogram is immutable once built, and is built from the values in
+/// index order in a single pass
+class RocksDBIndexHistogram {
+ public:
+  /// @brief maximum number of buckets
+  static constexpr size_t maxBuckets = 64;
+
+  /// @brief maximum number of values recorded with their exact counts
+  static constexpr size_t maxFrequentValues = 16;
+
+  /// @brief builds a histogram from values that are added in index order
+  class Builder {
+   public:
+    Builder(Builder const&) = delete;
+    Builder& operator=(Builder const&) = delete;
+
+    Builder();
+
+    /// @brief add the next value. values must be added in sorted order
+    void add(arangodb::velocypack::Slice value);
+
+    /// @brief return the histogram over all added values
+    std::unique_ptr<RocksDBIndexHistogram> finish();
+
+   private:
+    struct Bucket {
+      arangodb::velocypack::Builder upper;
+      uint64_t count;
+      uint64_t distinct;
+    };
+
+    struct Frequent {
+      arangodb::velocypack::Builder value;
+      uint64_t count;
+    };
+
+    /// @brief finish the run of equal values ending with the current value
+    void closeRun();
+
+    /// @brief merge adjacent buckets pairwise and double the bucket depth
+    void mergeBuckets();
+
+   private:
+    std::vector<Bucket> _buckets;
+    std::vector<Frequent> _frequent;
+    arangodb::velocypack::Builder _min;
+    arangodb::velocypack::Builder _current;
+    uint64_t _currentCount;
+    uint64_t _total;
+    uint64_t _depth;
+    bool _bucketOpen;
+  };
+
+  /// @brief create a histogram from its velocypack representation. throws
+  /// if the data is invalid
+  explicit RocksDBIndexHistogram(arangodb::velocypack::Slice data);
+
+  RocksDBIndexHistogram(RocksDBIndexHistogram const&) = delete;
+  RocksDBIndexHistogram& operator=(RocksDBIndexHistogram const&) = delete;
+
+  /// @brief the velocypack representation of the histogram
+  arangodb::velocypack::Slice slice() const { return _data.slice(); }
+
+  /// @brief number of values the histogram was built from
+  uint64_t total() const { return _total; }
+
+  /// @brief estimated share of values equal to the value
+  double equalitySelectivity(arangodb::velocypack::Slice value) const;
+
+  /// @brief estimated share of values in a range. an undefined (none) bound
+  /// leaves the range open on its side
+  double rangeSelectivity(arangodb::velocypack::Slice lower,
+                          bool lowerIncluded,
+                          arangodb::velocypack::Slice upper,
+                          bool upperIncluded) const;
+
+ private:
+  struct Bucket {
+    arangodb::velocypack::Slice upper;
+    uint64_t count;
+    uint64_t distinct;
+  };
+
+  /// @brief estimated number of values less than (or, if inclusive is set,
+  /// less than or equal to) the value
+  double rank(arangodb::velocypack::Slice value, bool inclusive) const;
+
+  /// @brief estimated number of entries per distinct value inside a bucket,
+  /// not counting the frequent values
+  double averageCount(size_t bucket) const;
+
+ private:
+  /// @brief the velocypack representation, the slices below point into it
+  arangodb::velocypack::Builder _data;
+
+  arangodb::velocypack::Slice _min;
+  std::vector<Bucket> _buckets;
+  std::vector<std::pair<arangodb::velocypack::Slice, uint64_t>> _frequent;
+  uint64_t _total;
+};
+
+}  // namespace arangodb
+
+#endif
@@ -26,20 +26,33 @@
 #include "RocksDBEngine/RocksDBPrimaryIndex.h"
 #include "RocksDBEngine/RocksDBCollection.h"
 #include "RocksDBEngine/RocksDBColumnFamily.h"
+#include "RocksDBEngine/RocksDBCommon.h"
+#include "RocksDBEngine/RocksDBEngine.h"
 #include "RocksDBEngine/RocksDBMethods.h"
+#include "RocksDBEngine/RocksDBParallelScan.h"
 #include "RocksDBEngine/RocksDBTransactionState.h"
+#include "RocksDBEngine/RocksDBValue.h"
 
 using namespace arangodb;
 
 namespace {
 constexpr bool AllIteratorFillBlockCache = true;
 constexpr bool AnyIteratorFillBlockCache = false;
+
+/// @brief full scans read every block once, so caching them would only
+/// evict the blocks of other operations
+void setFullScanOptions(rocksdb::ReadOptions& options) {
+  options.fill_cache = false;
+  options.readahead_size = static_cast<size_t>(
+      rocksutils::globalRocksEngine()->fullScanReadaheadSize());
+}
 }
 
 // ================ All Iterator ==================
 
 RocksDBAllIndexIterator::RocksDBAllIndexIterator(
-    LogicalCollection* col, transaction::Methods* trx, RocksDBPrimaryIndex const* index)
+    LogicalCollection* col, transaction::Methods* trx,
+    RocksDBPrimaryIndex const* index, bool fullScan)
     : IndexIterator(col, trx, index),
       _bounds(RocksDBKeyBounds::CollectionDocuments(
           static_cast<RocksDBCollection*>(col->getPhysical())->objectId())),
@@ -54,7 +67,9 @@ RocksDBAllIndexIterator::RocksDBAllIndexIterator(
   TRI_ASSERT(options.prefix_same_as_start);
   options.fill_cache = AllIteratorFillBlockCache;
   options.verify_checksums = false;  // TODO evaluate
-  // options.readahead_size = 4 * 1024 * 1024;
+  if (fullScan) {
+    setFullScanOptions(options);
+  }
   _iterator = mthds->NewIterator(options, cf);
   TRI_ASSERT(_iterator);
 
@@ -111,7 +126,7 @@ bool RocksDBAllIndexIterator::nextDocument(
 
   while (limit > 0) {
     cb(RocksDBKey::documentId(_iterator->key()),
-       VPackSlice(_iterator->value().data()));
+       RocksDBValue::document(_iterator->value(), _documentBuffer));
     --limit;
     _iterator->Next();
 
@@ -139,6 +154,128 @@ void RocksDBAllIndexIterator::reset() {
   _iterator->Seek(_bounds.start());
 }
 
+// ================ Parallel All Iterator ==================
+
+namespace {
+/// @brief size of the documents after which a partition ends a batch
+constexpr size_t ParallelBatchBytes = 1024 * 1024;
+
+/// @brief size of the documents a partition reads ahead at most. this
+/// bounds the memory of a scan by the number of partitions, independently
+/// of the size of the documents
+constexpr size_t ParallelMaxBufferedBytes = 4 * ParallelBatchBytes;
+}
+
+RocksDBParallelAllIndexIterator::RocksDBParallelAllIndexIterator(
+    LogicalCollection* col, transaction::Methods* trx,
+    RocksDBPrimaryIndex const* index, size_t numPartitions, bool fullScan)
+    : IndexIterator(col, trx, index), _position(0) {
+  TRI_ASSERT(trx->state()->isReadOnlyTransaction());
+  TRI_ASSERT(numPartitions > 0);
+
+  RocksDBKeyBounds bounds = RocksDBKeyBounds::CollectionDocuments(
+      static_cast<RocksDBCollection*>(col->getPhysical())->objectId());
+
+  auto* mthds = RocksDBTransactionState::toMethods(trx);
+  rocksdb::ColumnFamilyHandle* cf = RocksDBColumnFamily::documents();
+  rocksdb::Comparator const* cmp = cf->GetComparator();
+
+  // intentional copy of the read options
+  rocksdb::ReadOptions options = mthds->readOptions();
+  TRI_ASSERT(options.snapshot != nullptr);
+  TRI_ASSERT(options.prefix_same_as_start);
+  options.fill_cache = AllIteratorFillBlockCache;
+  options.verify_checksums = false;
+
+  std::vector<std::string> partitionBounds;
+  {
+    std::unique_ptr<rocksdb::Iterator> it = mthds->NewIterator(options, cf);
+    partitionBounds = RocksDBParallelScan::partitionBounds(cmp, it.get(), bounds,
+                                                           numPartitions);
+  }
+
+  if (fullScan) {
+    setFullScanOptions(options);
+  }
+
+  std::vector<std::unique_ptr<rocksdb::Iterator>> iterators;
+  for (size_t i = 1; i < partitionBounds.size(); ++i) {
+    iterators.emplace_back(mthds->NewIterator(options, cf));
+    TRI_ASSERT(iterators.back());
+  }
+
+  _scan = std::make_unique<RocksDBParallelScan>(cmp, partitionBounds, std::move(iterators),
+                                                ParallelBatchBytes,
+                                                ParallelMaxBufferedBytes);
+}
+
+RocksDBParallelAllIndexIterator::~RocksDBParallelAllIndexIterator() {}
+
+bool RocksDBParallelAllIndexIterator::hasCurrent() const {
+  return _batch != nullptr && _position < _batch->ids.size();
+}
+
+bool RocksDBParallelAllIndexIterator::nextBatch() {
+  _batch = _scan->next();
+  _position = 0;
+  return _batch != nullptr;
+}
+
+bool RocksDBParallelAllIndexIterator::next(LocalDocumentIdCallback const& cb,
+                                           size_t limit) {
+  TRI_ASSERT(_trx->state()->isRunning());
+  TRI_ASSERT(limit > 0);  // Someone called with limit == 0. Api broken
+
+  while (limit > 0) {
+    if (!hasCurrent() && !nextBatch()) {
+      return false;
+    }
+    cb(_batch->ids[_position]);
+    ++_position;
+    --limit;
+  }
+  return true;
+}
+
+bool RocksDBParallelAllIndexIterator::nextDocument(
+    IndexIterator::DocumentCallback const& cb, size_t limit) {
+  TRI_ASSERT(_trx->state()->isRunning());
+  TRI_ASSERT(limit > 0);  // Someone called with limit == 0. Api broken
+
+  while (limit > 0) {
+    if (!hasCurrent() && !nextBatch()) {
+      return false;
+    }
+    cb(_batch->ids[_position],
+       VPackSlice(_batch->data.data() + _batch->offsets[_position]));
+    ++_position;
+    --limit;
+  }
+  return true;
+}
+
+void RocksDBParallelAllIndexIterator::skip(uint64_t count, uint64_t& skipped) {
+  TRI_ASSERT(_trx->state()->isRunning());
+
+  while (count > 0) {
+    if (!hasCurrent() && !nextBatch()) {
+      return;
+    }
+    size_t const toSkip = static_cast<size_t>(
+        (std::min)(count, static_cast<uint64_t>(_batch->ids.size() - _position)));
+    _position += toSkip;
+    count -= toSkip;
+    skipped += toSkip;
+  }
+}
+
+void RocksDBParallelAllIndexIterator::reset() {
+  TRI_ASSERT(_trx->state()->isRunning());
+  _batch.reset();
+  _position = 0;
+  _scan->reset();
+}
+
 // ================ Any Iterator ================
 RocksDBAnyIndexIterator::RocksDBAnyIndexIterator(
     LogicalCollection* col, transaction::Methods* trx,
@@ -246,7 +383,7 @@ bool RocksDBAnyIndexIterator::nextDocument(
 
   while (limit > 0) {
     cb(RocksDBKey::documentId(_iterator->key()),
-       VPackSlice(_iterator->value().data()));
+       RocksDBValue::document(_iterator->value(), _documentBuffer));
     --limit;
     _returned++;
     _iterator->Next();
@@ -27,6 +27,7 @@
 #include "Indexes/IndexIterator.h"
 #include "RocksDBEngine/RocksDBKeyBounds.h"
 #include "RocksDBEngine/RocksDBColumnFamily.h"
+#include "RocksDBEngine/RocksDBParallelScan.h"
 
 #include <velocypack/Iterator.h>
 #include <velocypack/Slice.h>
@@ -47,9 +48,11 @@ typedef std::function<void(rocksdb::Slice const& key, rocksdb::Slice const& valu
 /// basically sorted after LocalDocumentId
 class RocksDBAllIndexIterator final : public IndexIterator {
  public:
+  /// @brief a full scan reads the entire collection once. it reads large
+  /// blocks ahead and keeps them out of the block cache
   RocksDBAllIndexIterator(LogicalCollection* collection,
                           transaction::Methods* trx,
-                          RocksDBPrimaryIndex const* index);
+                          RocksDBPrimaryIndex const* index, bool fullScan);
   ~RocksDBAllIndexIterator() {}
 
   char const* typeName() const override { return "all-index-iterator"; }
@@ -66,8 +69,44 @@ class RocksDBAllIndexIterator final : public IndexIterator {
   RocksDBKeyBounds const _bounds;
   std::unique_ptr<rocksdb::Iterator> _iterator;
   rocksdb::Comparator const* _cmp;
+  /// @brief memory for the current document, if it is compressed
+  std::string _documentBuffer;
 };
 
+/// @brief iterator over all documents in the collection, in the same order
+/// as RocksDBAllIndexIterator. the key range of the collection is split into
+/// partitions, which are read ahead concurrently on scheduler threads by a
+/// RocksDBParallelScan.
+/// must only be used in read-only transactions, as only these use plain
+/// RocksDB iterators on a snapshot, which can be used from any thread
+class RocksDBParallelAllIndexIterator final : public IndexIterator {
+ public:
+  RocksDBParallelAllIndexIterator(LogicalCollection* collection,
+                                  transaction::Methods* trx,
+                                  RocksDBPrimaryIndex const* index,
+                                  size_t numPartitions, bool fullScan);
+  ~RocksDBParallelAllIndexIterator();
+
+  char const* typeName() const override { return "parallel-all-index-iterator"; }
+
+  bool next(LocalDocumentIdCallback const& cb, size_t limit) override;
+  bool nextDocument(DocumentCallback const& cb, size_t limit) override;
+  void skip(uint64_t count, uint64_t& skipped) override;
+
+  void reset() override;
+
+ private:
+  /// @brief make the next batch the current one, returns false if all
+  /// partitions are exhausted
+  bool nextBatch();
+
+  /// @brief whether or not the current batch has more documents
+  bool hasCurrent() const;
+
+  std::unique_ptr<RocksDBParallelScan> _scan;
+  std::unique_ptr<RocksDBParallelScan::Batch> _batch;
+  size_t _position;
+};
 
 class RocksDBAnyIndexIterator final : public IndexIterator {
  public:
@@ -96,6 +135,8 @@ class RocksDBAnyIndexIterator final : public IndexIterator {
   uint64_t _total;
   uint64_t _returned;
   bool _forward;
+  /// @brief memory for the current document, if it is compressed
+  std::string _documentBuffer;
 };
 
 /// @brief iterates over the primary index and does lookups
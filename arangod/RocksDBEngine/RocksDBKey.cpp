@@ -246,6 +246,30 @@ void RocksDBKey::constructKeyGeneratorValue(uint64_t objectId) {
   _slice = rocksdb::Slice(_buffer.data(), keyLength);
 }
 
+void RocksDBKey::constructIndexHistogramValue(uint64_t objectId) {
+  TRI_ASSERT(objectId != 0);
+  _type = RocksDBEntryType::IndexHistogramValue;
+  size_t keyLength = sizeof(char) + sizeof(uint64_t);
+  _buffer.clear();
+  _buffer.reserve(keyLength);
+  _buffer.push_back(static_cast<char>(_type));
+  uint64ToPersistent(_buffer, objectId);
+  TRI_ASSERT(_buffer.size() == keyLength);
+  _slice = rocksdb::Slice(_buffer.data(), keyLength);
+}
+
+void RocksDBKey::constructRevisionTreeValue(uint64_t objectId) {
+  TRI_ASSERT(objectId != 0);
+  _type = RocksDBEntryType::RevisionTreeValue;
+  size_t keyLength = sizeof(char) + sizeof(uint64_t);
+  _buffer.clear();
+  _buffer.reserve(keyLength);
+  _buffer.push_back(static_cast<char>(_type));
+  uint64ToPersistent(_buffer, objectId);
+  TRI_ASSERT(_buffer.size() == keyLength);
+  _slice = rocksdb::Slice(_buffer.data(), keyLength);
+}
+
 // ========================= Member methods ===========================
 
 RocksDBEntryType RocksDBKey::type(RocksDBKey const& key) {
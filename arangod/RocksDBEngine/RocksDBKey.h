@@ -159,6 +159,17 @@ class RocksDBKey {
   //////////////////////////////////////////////////////////////////////////////
   void constructKeyGeneratorValue(uint64_t objectId);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Create a fully-specified key for the value histogram of an index
+  //////////////////////////////////////////////////////////////////////////////
+  void constructIndexHistogramValue(uint64_t objectId);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Create a fully-specified key for the revision tree of a
+  ///        collection
+  //////////////////////////////////////////////////////////////////////////////
+  void constructRevisionTreeValue(uint64_t objectId);
+
  public:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Extracts the type from a key
@@ -291,6 +302,8 @@ class RocksDBKey {
       case RocksDBEntryType::ReplicationApplierConfig:
       case RocksDBEntryType::IndexEstimateValue:
       case RocksDBEntryType::KeyGeneratorValue:
+      case RocksDBEntryType::IndexHistogramValue:
+      case RocksDBEntryType::RevisionTreeValue:
       case RocksDBEntryType::View:
         return type;
       default:
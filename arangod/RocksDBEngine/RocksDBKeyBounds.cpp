@@ -228,6 +228,8 @@ rocksdb::ColumnFamilyHandle* RocksDBKeyBounds::columnFamily() const {
     case RocksDBEntryType::ReplicationApplierConfig:
     case RocksDBEntryType::IndexEstimateValue:
     case RocksDBEntryType::KeyGeneratorValue:
+    case RocksDBEntryType::IndexHistogramValue:
+    case RocksDBEntryType::RevisionTreeValue:
     case RocksDBEntryType::View:
       return RocksDBColumnFamily::definitions();
   }
@@ -252,7 +254,9 @@ RocksDBKeyBounds::RocksDBKeyBounds(RocksDBEntryType type) : _type(type) {
     }
     case RocksDBEntryType::CounterValue:
     case RocksDBEntryType::IndexEstimateValue:
-    case RocksDBEntryType::KeyGeneratorValue: {
+    case RocksDBEntryType::KeyGeneratorValue:
+    case RocksDBEntryType::IndexHistogramValue:
+    case RocksDBEntryType::RevisionTreeValue: {
       _internals.reserve(2 * (sizeof(char) + sizeof(uint64_t)));
       _internals.push_back(static_cast<char>(_type));
       uint64ToPersistent(_internals.buffer(), 0);
@@ -61,6 +61,13 @@ RocksDBLogValue RocksDBLogValue::CollectionChange(TRI_voc_tick_t dbid,
   return RocksDBLogValue(RocksDBLogType::CollectionChange, dbid, cid);
 }
 
+RocksDBLogValue RocksDBLogValue::CollectionTruncate(TRI_voc_tick_t dbid,
+                                                    TRI_voc_cid_t cid,
+                                                    uint64_t objectId) {
+  return RocksDBLogValue(RocksDBLogType::CollectionTruncate, dbid, cid,
+                         objectId);
+}
+
 RocksDBLogValue RocksDBLogValue::IndexCreate(TRI_voc_tick_t dbid,
                                              TRI_voc_cid_t cid,
                                              VPackSlice const& indexInfo) {
@@ -177,7 +184,8 @@ RocksDBLogValue::RocksDBLogValue(RocksDBLogType type, uint64_t dbId,
     : _buffer() {
   switch (type) {
     case RocksDBLogType::IndexDrop:
-    case RocksDBLogType::SingleRemoveV2: {
+    case RocksDBLogType::SingleRemoveV2:
+    case RocksDBLogType::CollectionTruncate: {
       _buffer.reserve(sizeof(RocksDBLogType) + sizeof(uint64_t) * 3);
       _buffer.push_back(static_cast<char>(type));
       uint64ToPersistent(_buffer, dbId);
@@ -340,6 +348,15 @@ TRI_voc_rid_t RocksDBLogValue::revisionId(rocksdb::Slice const& slice) {
   return 0;
 }
 
+/// For CollectionTruncate
+uint64_t RocksDBLogValue::objectId(rocksdb::Slice const& slice) {
+  TRI_ASSERT(slice.size() >= sizeof(RocksDBLogType) + (3 * sizeof(uint64_t)));
+  RocksDBLogType type = static_cast<RocksDBLogType>(slice.data()[0]);
+  TRI_ASSERT(type == RocksDBLogType::CollectionTruncate);
+  return uint64FromPersistent(slice.data() + sizeof(RocksDBLogType) +
+                              (2 * sizeof(uint64_t)));
+}
+
 VPackSlice RocksDBLogValue::indexSlice(rocksdb::Slice const& slice) {
   TRI_ASSERT(slice.size() >= sizeof(RocksDBLogType) + sizeof(uint64_t) * 2);
   RocksDBLogType type = static_cast<RocksDBLogType>(slice.data()[0]);
@@ -398,7 +415,8 @@ bool RocksDBLogValue::containsDatabaseId(RocksDBLogType type) {
   type == RocksDBLogType::BeginTransaction ||
   type == RocksDBLogType::CommitTransaction ||
   type == RocksDBLogType::SinglePut ||
-  type == RocksDBLogType::SingleRemoveV2;
+  type == RocksDBLogType::SingleRemoveV2 ||
+  type == RocksDBLogType::CollectionTruncate;
 }
 
 bool RocksDBLogValue::containsCollectionId(RocksDBLogType type) {
@@ -412,7 +430,8 @@ bool RocksDBLogValue::containsCollectionId(RocksDBLogType type) {
   type == RocksDBLogType::IndexCreate ||
   type == RocksDBLogType::IndexDrop ||
   type == RocksDBLogType::SinglePut ||
-  type == RocksDBLogType::SingleRemoveV2;
+  type == RocksDBLogType::SingleRemoveV2 ||
+  type == RocksDBLogType::CollectionTruncate;
 }
 
 bool RocksDBLogValue::containsViewId(RocksDBLogType type) {
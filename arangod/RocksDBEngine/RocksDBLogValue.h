@@ -55,6 +55,9 @@ class RocksDBLogValue {
                                           StringRef const& oldName);
   static RocksDBLogValue CollectionChange(TRI_voc_tick_t vocbaseId,
                                           TRI_voc_cid_t cid);
+  static RocksDBLogValue CollectionTruncate(TRI_voc_tick_t vocbaseId,
+                                            TRI_voc_cid_t cid,
+                                            uint64_t objectId);
 
   static RocksDBLogValue IndexCreate(TRI_voc_tick_t vocbaseId,
                                      TRI_voc_cid_t cid,
@@ -93,6 +96,8 @@ class RocksDBLogValue {
   static TRI_idx_iid_t indexId(rocksdb::Slice const&);
   /// For DocumentRemoveV2 and SingleRemoveV2
   static TRI_voc_rid_t revisionId(rocksdb::Slice const&);
+  /// For CollectionTruncate
+  static uint64_t objectId(rocksdb::Slice const&);
   static velocypack::Slice indexSlice(rocksdb::Slice const&);
   static velocypack::Slice viewSlice(rocksdb::Slice const&);
   static arangodb::StringRef collectionUUID(rocksdb::Slice const&);
@@ -34,6 +34,23 @@
 
 using namespace arangodb;
 
+namespace {
+std::vector<arangodb::Result> convertStatuses(
+    std::vector<rocksdb::Status> const& statuses, char const* context) {
+  std::vector<arangodb::Result> results;
+  results.reserve(statuses.size());
+  for (auto const& s : statuses) {
+    if (s.ok()) {
+      results.emplace_back();
+    } else {
+      results.emplace_back(rocksutils::convertStatus(
+          s, rocksutils::StatusHint::document, "", context));
+    }
+  }
+  return results;
+}
+}
+
 // ================= RocksDBSavePoint ==================
 
 RocksDBSavePoint::RocksDBSavePoint(
@@ -70,6 +87,19 @@ arangodb::Result RocksDBMethods::Get(rocksdb::ColumnFamilyHandle* cf,
   return Get(cf, key.string(), val);
 }
 
+std::vector<arangodb::Result> RocksDBMethods::MultiGet(
+    rocksdb::ColumnFamilyHandle* cf, std::vector<rocksdb::Slice> const& keys,
+    std::vector<std::string>* values) {
+  std::vector<arangodb::Result> results;
+  results.reserve(keys.size());
+  values->clear();
+  values->resize(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    results.emplace_back(Get(cf, keys[i], &(*values)[i]));
+  }
+  return results;
+}
+
 rocksdb::ReadOptions const& RocksDBMethods::readOptions() {
   return _state->_rocksReadOptions;
 }
@@ -132,6 +162,17 @@ arangodb::Result RocksDBReadOnlyMethods::Get(rocksdb::ColumnFamilyHandle* cf,
   return s.ok() ? arangodb::Result() : rocksutils::convertStatus(s, rocksutils::StatusHint::document, "", "Get - in RocksDBReadOnlyMethods");
 }
 
+std::vector<arangodb::Result> RocksDBReadOnlyMethods::MultiGet(
+    rocksdb::ColumnFamilyHandle* cf, std::vector<rocksdb::Slice> const& keys,
+    std::vector<std::string>* values) {
+  TRI_ASSERT(cf != nullptr);
+  rocksdb::ReadOptions const& ro = _state->_rocksReadOptions;
+  TRI_ASSERT(ro.snapshot != nullptr);
+  std::vector<rocksdb::ColumnFamilyHandle*> cfs(keys.size(), cf);
+  std::vector<rocksdb::Status> s = _db->MultiGet(ro, cfs, keys, values);
+  return ::convertStatuses(s, "MultiGet - in RocksDBReadOnlyMethods");
+}
+
 arangodb::Result RocksDBReadOnlyMethods::Put(rocksdb::ColumnFamilyHandle* cf,
                                              RocksDBKey const&,
                                              rocksdb::Slice const&,
@@ -186,6 +227,18 @@ arangodb::Result RocksDBTrxMethods::Get(rocksdb::ColumnFamilyHandle* cf,
   return rv;
 }
 
+std::vector<arangodb::Result> RocksDBTrxMethods::MultiGet(
+    rocksdb::ColumnFamilyHandle* cf, std::vector<rocksdb::Slice> const& keys,
+    std::vector<std::string>* values) {
+  TRI_ASSERT(cf != nullptr);
+  rocksdb::ReadOptions const& ro = _state->_rocksReadOptions;
+  TRI_ASSERT(ro.snapshot != nullptr);
+  std::vector<rocksdb::ColumnFamilyHandle*> cfs(keys.size(), cf);
+  std::vector<rocksdb::Status> s =
+      _state->_rocksTransaction->MultiGet(ro, cfs, keys, values);
+  return ::convertStatuses(s, "MultiGet - in RocksDBTrxMethods");
+}
+
 arangodb::Result RocksDBTrxMethods::Put(rocksdb::ColumnFamilyHandle* cf,
                                         RocksDBKey const& key,
                                         rocksdb::Slice const& val,
@@ -228,6 +281,9 @@ arangodb::Result RocksDBTrxUntrackedMethods::Put(rocksdb::ColumnFamilyHandle* cf
                                                  rocksdb::Slice const& val,
                                                  rocksutils::StatusHint hint) {
   TRI_ASSERT(cf != nullptr);
+  if (!_state->_untrackedWrites) {
+    return RocksDBTrxMethods::Put(cf, key, val, hint);
+  }
   rocksdb::Status s = _state->_rocksTransaction->PutUntracked(cf, key.string(), val);
   return s.ok() ? arangodb::Result() : rocksutils::convertStatus(s, hint);
 }
@@ -235,6 +291,9 @@ arangodb::Result RocksDBTrxUntrackedMethods::Put(rocksdb::ColumnFamilyHandle* cf
 arangodb::Result RocksDBTrxUntrackedMethods::Delete(rocksdb::ColumnFamilyHandle* cf,
                                                     RocksDBKey const& key) {
   TRI_ASSERT(cf != nullptr);
+  if (!_state->_untrackedWrites) {
+    return RocksDBTrxMethods::Delete(cf, key);
+  }
   rocksdb::Status s = _state->_rocksTransaction->DeleteUntracked(cf, key.string());
   return s.ok() ? arangodb::Result() : rocksutils::convertStatus(s);
 }
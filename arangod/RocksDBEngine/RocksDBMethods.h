@@ -74,6 +74,11 @@ class RocksDBMethods {
   virtual bool Exists(rocksdb::ColumnFamilyHandle*, RocksDBKey const&) = 0;
   virtual arangodb::Result Get(rocksdb::ColumnFamilyHandle*, rocksdb::Slice const&,
                                std::string*) = 0;
+  /// @brief look up multiple keys at once. values and results are in the
+  /// order of the keys. the default implementation calls Get for every key
+  virtual std::vector<arangodb::Result> MultiGet(
+      rocksdb::ColumnFamilyHandle*, std::vector<rocksdb::Slice> const& keys,
+      std::vector<std::string>* values);
   virtual arangodb::Result Put(
       rocksdb::ColumnFamilyHandle*, RocksDBKey const&, rocksdb::Slice const&,
       rocksutils::StatusHint hint = rocksutils::StatusHint::none) = 0;
@@ -112,6 +117,9 @@ class RocksDBReadOnlyMethods final : public RocksDBMethods {
   bool Exists(rocksdb::ColumnFamilyHandle*, RocksDBKey const&) override;
   arangodb::Result Get(rocksdb::ColumnFamilyHandle*, rocksdb::Slice const& key,
                        std::string* val) override;
+  std::vector<arangodb::Result> MultiGet(
+      rocksdb::ColumnFamilyHandle*, std::vector<rocksdb::Slice> const& keys,
+      std::vector<std::string>* values) override;
   arangodb::Result Put(
       rocksdb::ColumnFamilyHandle*, RocksDBKey const& key,
       rocksdb::Slice const& val,
@@ -141,6 +149,9 @@ class RocksDBTrxMethods : public RocksDBMethods {
   bool Exists(rocksdb::ColumnFamilyHandle*, RocksDBKey const&) override;
   arangodb::Result Get(rocksdb::ColumnFamilyHandle*, rocksdb::Slice const& key,
                        std::string* val) override;
+  std::vector<arangodb::Result> MultiGet(
+      rocksdb::ColumnFamilyHandle*, std::vector<rocksdb::Slice> const& keys,
+      std::vector<std::string>* values) override;
 
   arangodb::Result Put(
       rocksdb::ColumnFamilyHandle*, RocksDBKey const& key,
@@ -22,13 +22,13 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "RocksDBOptimizerRules.h"
-#include "Aql/ClusterNodes.h"
 #include "Aql/Collection.h"
 #include "Aql/Condition.h"
 #include "Aql/ExecutionNode.h"
 #include "Aql/ExecutionPlan.h"
 #include "Aql/Function.h"
 #include "Aql/IndexNode.h"
+#include "Aql/MaterializeNode.h"
 #include "Aql/Optimizer.h"
 #include "Aql/OptimizerRule.h"
 #include "Aql/OptimizerRulesFeature.h"
@@ -42,105 +42,137 @@ using namespace arangodb::aql;
 using EN = arangodb::aql::ExecutionNode;
 
 void RocksDBOptimizerRules::registerResources() {
-  OptimizerRulesFeature::registerRule("reduce-extraction-to-projection", reduceExtractionToProjectionRule, 
-               OptimizerRule::reduceExtractionToProjectionRule_pass10, false, true);
+  OptimizerRulesFeature::registerRule("late-document-materialization", lateDocumentMaterializationRule,
+               OptimizerRule::lateDocumentMaterializationRule_pass10, false, true);
 }
 
-// simplify an EnumerationCollectionNode that fetches an entire document to a projection of this document
-void RocksDBOptimizerRules::reduceExtractionToProjectionRule(Optimizer* opt, 
-                                                             std::unique_ptr<ExecutionPlan> plan, 
-                                                             OptimizerRule const* rule) {
-  // These are all the nodes where we start traversing (including all
-  // subqueries)
+// read only document ids and covered attributes from an index for filtering,
+// sorting and limiting, and fetch the full documents after the limit
+void RocksDBOptimizerRules::lateDocumentMaterializationRule(Optimizer* opt,
+                                                            std::unique_ptr<ExecutionPlan> plan,
+                                                            OptimizerRule const* rule) {
+  if (ServerState::instance()->isCoordinator()) {
+    // the documents are read on the DB servers
+    opt->addPlan(std::move(plan), rule, false);
+    return;
+  }
+
   SmallVector<ExecutionNode*>::allocator_type::arena_type a;
   SmallVector<ExecutionNode*> nodes{a};
-  
-  std::vector<ExecutionNode::NodeType> const types = {ExecutionNode::ENUMERATE_COLLECTION, ExecutionNode::INDEX}; 
-  plan->findNodesOfType(nodes, types, true);
+  plan->findNodesOfType(nodes, EN::INDEX, true);
 
   bool modified = false;
   std::unordered_set<Variable const*> vars;
   std::unordered_set<std::string> attributes;
 
   for (auto const& n : nodes) {
+    auto indexNode = static_cast<IndexNode*>(n);
+
+    if (indexNode->docIdVariable() != nullptr || !indexNode->projections().empty()) {
+      // already optimized
+      continue;
+    }
+
+    auto const& indexes = indexNode->getIndexes();
+    if (indexes.empty()) {
+      continue;
+    }
+    auto idx = indexes[0].getIndex();
+    bool sameIndex = true;
+    for (size_t i = 1; i < indexes.size(); ++i) {
+      if (indexes[i].getIndex() != idx) {
+        sameIndex = false;
+        break;
+      }
+    }
+    if (!sameIndex || !idx->hasCoveringIterator()) {
+      continue;
+    }
+
+    Variable const* v = indexNode->outVariable();
+
+    // walk up to the next LIMIT. in between, the document may only be used
+    // via attribute accesses in calculations, and at least one node must
+    // throw away candidates
     bool stop = false;
-    bool optimize = false;
+    bool discards = false;
+    ExecutionNode* limit = nullptr;
     attributes.clear();
-    DocumentProducingNode* e = dynamic_cast<DocumentProducingNode*>(n);
-    if (e == nullptr) {
-      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "cannot convert node to DocumentProducingNode");
-    }
-    Variable const* v = e->outVariable();
 
     ExecutionNode* current = n->getFirstParent();
-    while (current != nullptr) {
-      if (current->getType() == EN::CALCULATION) {
-        Expression* exp = static_cast<CalculationNode*>(current)->expression();
-
-        if (exp != nullptr && exp->node() != nullptr) {
-          AstNode const* node = exp->node();
-          vars.clear();
-          current->getVariablesUsedHere(vars);
-            
-          if (vars.find(v) != vars.end()) {
-            if (!Ast::getReferencedAttributes(node, v, attributes)) {
+    while (current != nullptr && limit == nullptr && !stop) {
+      vars.clear();
+      current->getVariablesUsedHere(vars);
+      bool const usesDocument = (vars.find(v) != vars.end());
+
+      switch (current->getType()) {
+        case EN::CALCULATION: {
+          if (usesDocument) {
+            Expression* exp = static_cast<CalculationNode*>(current)->expression();
+            if (exp == nullptr || exp->node() == nullptr ||
+                !Ast::getReferencedAttributes(exp->node(), v, attributes)) {
               stop = true;
-              break;
             }
-            optimize = true;
           }
+          break;
         }
-      } else if (current->getType() == EN::GATHER) {
-        // compare sort attributes of GatherNode
-        auto gn = static_cast<GatherNode*>(current);
-        for (auto const& it : gn->elements()) {
-          if (it.var == v) {
-            if (it.attributePath.empty()) {
-              // sort of GatherNode refers to the entire document, not to an
-              // attribute of the document
-              stop = true;
-              break;
-            }
-            // insert 0th level of attribute name into the set of attributes
-            // that we need for our projection
-            attributes.emplace(it.attributePath[0]); 
-          }
+        case EN::FILTER:
+        case EN::SORT: {
+          discards = true;
+          stop = usesDocument;
+          break;
         }
-      } else {
-        vars.clear();
-        current->getVariablesUsedHere(vars);
-
-        if (vars.find(v) != vars.end()) {
-          // original variable is still used here
+        case EN::LIMIT: {
+          limit = current;
+          break;
+        }
+        default: {
           stop = true;
           break;
         }
       }
 
-      if (stop) {
-        break;
-      }
-
       current = current->getFirstParent();
     }
 
-    // projections are currently limited (arbitrarily to 5 attributes)
-    if (optimize && !stop && !attributes.empty() && attributes.size() <= 5) {
-      std::vector<std::string> r;
-      for (auto& it : attributes) {
-        r.emplace_back(std::move(it));
-      }
-      // store projections in DocumentProducingNode
-      e->projections(std::move(r));
+    if (stop || !discards || limit == nullptr || attributes.empty() ||
+        !limit->hasParent()) {
+      continue;
+    }
 
-      if (n->getType() == ExecutionNode::INDEX) {
-        // need to update _indexCoversProjections value in an IndexNode
-        static_cast<IndexNode*>(n)->initIndexCoversProjections();
-      }
-      
-      modified = true;
+    if (!plan->varUsageComputed()) {
+      plan->findVarUsage();
     }
+    if (!limit->isVarUsedLater(v)) {
+      // the full document is never needed, so projections will do
+      continue;
+    }
+
+    // all attributes used before the LIMIT must be covered by the index
+    std::vector<std::string> projections;
+    for (auto const& it : attributes) {
+      projections.emplace_back(it);
+    }
+    indexNode->projections(projections);
+    indexNode->initIndexCoversProjections();
+
+    if (indexNode->coveringIndexAttributePositions().empty()) {
+      // index does not cover all attributes. revert
+      indexNode->projections(std::vector<std::string>());
+      indexNode->initIndexCoversProjections();
+      continue;
+    }
+
+    Variable const* docIdVariable = plan->getAst()->variables()->createTemporaryVariable();
+    indexNode->setDocIdVariable(docIdVariable);
+
+    auto materializeNode = new MaterializeNode(plan.get(), plan->nextId(), indexNode->collection(),
+                                               docIdVariable, v);
+    plan->registerNode(materializeNode);
+    plan->insertDependency(limit->getFirstParent(), materializeNode);
+
+    modified = true;
   }
-    
+
   opt->addPlan(std::move(plan), rule, modified);
 }
@@ -36,8 +36,9 @@ struct OptimizerRule;
 struct RocksDBOptimizerRules {
   static void registerResources();
   
-  // simplify an EnumerationCollectionNode that fetches an entire document to a projection of this document
-  static void reduceExtractionToProjectionRule(aql::Optimizer* opt, std::unique_ptr<aql::ExecutionPlan> plan, aql::OptimizerRule const* rule);
+  // read only document ids and covered attributes from an index for filtering,
+  // sorting and limiting, and fetch the full documents after the limit
+  static void lateDocumentMaterializationRule(aql::Optimizer* opt, std::unique_ptr<aql::ExecutionPlan> plan, aql::OptimizerRule const* rule);
 };
 
 } // namespace arangodb
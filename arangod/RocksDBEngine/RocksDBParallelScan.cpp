@@ -0,0 +1,371 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RocksDBParallelScan.h"
+#include "Basics/Exceptions.h"
+#include "Basics/Result.h"
+#include "RocksDBEngine/RocksDBCommon.h"
+#include "RocksDBEngine/RocksDBKey.h"
+#include "RocksDBEngine/RocksDBKeyBounds.h"
+#include "RocksDBEngine/RocksDBValue.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
+
+#include <rocksdb/comparator.h>
+#include <rocksdb/iterator.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+using namespace arangodb;
+
+namespace {
+/// @brief interpret 8 bytes of a key as a big-endian number. keys are
+/// compared bytewise, so this preserves their order independently of the
+/// endianess the LocalDocumentIds are stored with
+uint64_t keyBytesToUint64(char const* p) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+    value = (value << 8) | static_cast<uint8_t>(p[i]);
+  }
+  return value;
+}
+
+/// @brief append a number as 8 big-endian bytes to a key
+void uint64ToKeyBytes(std::string& out, uint64_t value) {
+  for (size_t i = sizeof(uint64_t); i > 0; --i) {
+    out.push_back(static_cast<char>((value >> (8 * (i - 1))) & 0xffU));
+  }
+}
+
+void postToScheduler(std::function<void()> const& task) {
+  auto scheduler = SchedulerFeature::SCHEDULER;
+  if (scheduler != nullptr) {
+    scheduler->post(task);
+  }
+}
+}
+
+/// @brief state shared with the tasks reading the partitions
+struct RocksDBParallelScan::Shared {
+  enum class State { IDLE, QUEUED, RUNNING };
+
+  struct Partition {
+    std::string start;
+    std::string end;
+    /// @brief whether or not end is part of the partition
+    bool inclusiveEnd;
+    std::unique_ptr<rocksdb::Iterator> iterator;
+    std::deque<std::unique_ptr<Batch>> batches;
+    /// @brief the size of the documents in batches
+    size_t bufferedBytes;
+    State state;
+    bool done;
+    Result result;
+  };
+
+  Shared(rocksdb::Comparator const* cmp, size_t batchBytes,
+         size_t maxBufferedBytes, PostFunction const& post)
+      : cmp(cmp),
+        batchBytes(batchBytes),
+        maxBufferedBytes(maxBufferedBytes),
+        post(post),
+        current(0),
+        aborted(false) {}
+
+  /// @brief read the next batch of a partition. the caller must have set
+  /// the state of the partition to RUNNING
+  static void fill(std::shared_ptr<Shared> const& shared, size_t i);
+
+  /// @brief post a task running fill. if the task is not run, the partition
+  /// stays queued and is read by the consumer itself
+  static void schedule(std::shared_ptr<Shared> const& shared, size_t i);
+
+  /// @brief wait until no partition is read anymore and stop reading ahead
+  void stop();
+
+  /// @brief queue all partitions for reading from their start
+  void restart(std::shared_ptr<Shared> const& shared);
+
+  rocksdb::Comparator const* cmp;
+  size_t const batchBytes;
+  size_t const maxBufferedBytes;
+  PostFunction const post;
+  std::vector<Partition> partitions;
+  /// @brief the partition the consumer reads from
+  size_t current;
+  bool aborted;
+  std::mutex mutex;
+  std::condition_variable cv;
+};
+
+void RocksDBParallelScan::Shared::fill(std::shared_ptr<Shared> const& shared,
+                                       size_t i) {
+  Partition& p = shared->partitions[i];
+  TRI_ASSERT(p.state == State::RUNNING);
+
+  // the partition is only touched by this thread while it is RUNNING
+  auto batch = std::make_unique<Batch>();
+  bool done = false;
+  Result res;
+
+  try {
+    rocksdb::Iterator* it = p.iterator.get();
+    std::string buffer;
+
+    // a batch holds at least one document, however large it is
+    while (batch->data.size() < shared->batchBytes) {
+      if (!it->Valid()) {
+        res = rocksutils::convertStatus(it->status());
+        done = true;
+        break;
+      }
+      int const cmp = shared->cmp->Compare(it->key(), p.end);
+      if (cmp > 0 || (cmp == 0 && !p.inclusiveEnd)) {
+        done = true;
+        break;
+      }
+      batch->ids.emplace_back(RocksDBKey::documentId(it->key()));
+      batch->offsets.emplace_back(batch->data.size());
+      VPackSlice doc = RocksDBValue::document(it->value(), buffer);
+      batch->data.append(doc.startAs<char>(), doc.byteSize());
+      it->Next();
+    }
+  } catch (std::bad_alloc const&) {
+    res.reset(TRI_ERROR_OUT_OF_MEMORY);
+    done = true;
+  } catch (...) {
+    res.reset(TRI_ERROR_INTERNAL);
+    done = true;
+  }
+
+  bool reschedule = false;
+  {
+    std::lock_guard<std::mutex> guard(shared->mutex);
+    if (!batch->ids.empty()) {
+      p.bufferedBytes += batch->data.size();
+      p.batches.emplace_back(std::move(batch));
+    }
+    p.done = done;
+    p.result = res;
+    if (!done && !shared->aborted && p.bufferedBytes < shared->maxBufferedBytes) {
+      p.state = State::QUEUED;
+      reschedule = true;
+    } else {
+      p.state = State::IDLE;
+    }
+  }
+  shared->cv.notify_all();
+
+  if (reschedule) {
+    schedule(shared, i);
+  }
+}
+
+void RocksDBParallelScan::Shared::schedule(std::shared_ptr<Shared> const& shared,
+                                           size_t i) {
+  try {
+    shared->post([shared, i]() {
+      {
+        std::lock_guard<std::mutex> guard(shared->mutex);
+        Partition& p = shared->partitions[i];
+        if (shared->aborted || p.state != State::QUEUED) {
+          // the partition was read by someone else in the meantime
+          return;
+        }
+        p.state = State::RUNNING;
+      }
+      fill(shared, i);
+    });
+  } catch (...) {
+    // the partition stays queued, so the consumer will read it
+  }
+}
+
+void RocksDBParallelScan::Shared::stop() {
+  std::unique_lock<std::mutex> guard(mutex);
+  aborted = true;
+  for (auto& p : partitions) {
+    while (p.state == State::RUNNING) {
+      cv.wait(guard);
+    }
+    p.state = State::IDLE;
+  }
+}
+
+void RocksDBParallelScan::Shared::restart(std::shared_ptr<Shared> const& shared) {
+  TRI_ASSERT(shared.get() == this);
+  {
+    std::lock_guard<std::mutex> guard(mutex);
+    for (auto& p : partitions) {
+      TRI_ASSERT(p.state != State::RUNNING);
+      p.iterator->Seek(p.start);
+      p.batches.clear();
+      p.bufferedBytes = 0;
+      p.done = false;
+      p.result.reset();
+      p.state = State::QUEUED;
+    }
+    current = 0;
+    aborted = false;
+  }
+  for (size_t i = 0; i < partitions.size(); ++i) {
+    schedule(shared, i);
+  }
+}
+
+std::vector<std::string> RocksDBParallelScan::partitionBounds(
+    rocksdb::Comparator const* cmp, rocksdb::Iterator* it,
+    RocksDBKeyBounds const& bounds, size_t numPartitions) {
+  TRI_ASSERT(numPartitions > 0);
+  std::vector<std::string> result;
+  result.emplace_back(bounds.start().ToString());
+
+  // determine the first and the last key of the range, and split the range
+  // between them evenly
+  it->Seek(bounds.start());
+  if (it->Valid() && cmp->Compare(it->key(), bounds.end()) <= 0) {
+    TRI_ASSERT(it->key().size() == 2 * sizeof(uint64_t));
+    uint64_t const first = keyBytesToUint64(it->key().data() + sizeof(uint64_t));
+    it->SeekForPrev(bounds.end());
+    if (it->Valid() && cmp->Compare(it->key(), bounds.start()) >= 0) {
+      uint64_t const last = keyBytesToUint64(it->key().data() + sizeof(uint64_t));
+      if (last > first && last - first >= numPartitions) {
+        uint64_t const step = (last - first) / numPartitions;
+        for (size_t i = 1; i < numPartitions; ++i) {
+          std::string key(bounds.start().data(), sizeof(uint64_t));
+          uint64ToKeyBytes(key, first + step * i);
+          result.emplace_back(std::move(key));
+        }
+      }
+    }
+  }
+
+  result.emplace_back(bounds.end().ToString());
+  return result;
+}
+
+RocksDBParallelScan::RocksDBParallelScan(
+    rocksdb::Comparator const* cmp, std::vector<std::string> const& partitionBounds,
+    std::vector<std::unique_ptr<rocksdb::Iterator>> iterators, size_t batchBytes,
+    size_t maxBufferedBytes, PostFunction const& post)
+    : _shared(std::make_shared<Shared>(cmp, batchBytes, maxBufferedBytes,
+                                       post ? post : PostFunction(::postToScheduler))) {
+  TRI_ASSERT(partitionBounds.size() >= 2);
+  TRI_ASSERT(iterators.size() + 1 == partitionBounds.size());
+  TRI_ASSERT(batchBytes > 0);
+
+  size_t const n = iterators.size();
+  _shared->partitions.resize(n);
+  for (size_t i = 0; i < n; ++i) {
+    Shared::Partition& p = _shared->partitions[i];
+    p.start = partitionBounds[i];
+    p.end = partitionBounds[i + 1];
+    p.inclusiveEnd = (i + 1 == n);
+    p.iterator = std::move(iterators[i]);
+    TRI_ASSERT(p.iterator);
+    p.bufferedBytes = 0;
+    p.state = Shared::State::IDLE;
+    p.done = false;
+  }
+
+  _shared->restart(_shared);
+}
+
+RocksDBParallelScan::~RocksDBParallelScan() {
+  _shared->stop();
+  // queued tasks may still hold the shared state, but must not use the
+  // iterators anymore once their snapshot is released
+  for (auto& p : _shared->partitions) {
+    p.iterator.reset();
+  }
+}
+
+std::unique_ptr<RocksDBParallelScan::Batch> RocksDBParallelScan::next() {
+  std::shared_ptr<Shared> const& shared = _shared;
+  std::unique_lock<std::mutex> guard(shared->mutex);
+
+  while (shared->current < shared->partitions.size()) {
+    size_t const i = shared->current;
+    Shared::Partition& p = shared->partitions[i];
+
+    if (!p.batches.empty()) {
+      std::unique_ptr<Batch> batch = std::move(p.batches.front());
+      p.batches.pop_front();
+      TRI_ASSERT(p.bufferedBytes >= batch->data.size());
+      p.bufferedBytes -= batch->data.size();
+
+      bool reschedule = false;
+      if (!p.done && p.state == Shared::State::IDLE &&
+          p.bufferedBytes < shared->maxBufferedBytes) {
+        // the partition had stopped reading ahead
+        p.state = Shared::State::QUEUED;
+        reschedule = true;
+      }
+      guard.unlock();
+      if (reschedule) {
+        Shared::schedule(shared, i);
+      }
+      return batch;
+    }
+
+    if (p.result.fail()) {
+      THROW_ARANGO_EXCEPTION(p.result);
+    }
+
+    if (p.done) {
+      // the partition is exhausted, continue with the next one
+      ++shared->current;
+      continue;
+    }
+
+    if (p.state == Shared::State::RUNNING) {
+      shared->cv.wait(guard);
+    } else {
+      // nobody reads the partition at the moment, so read it here instead
+      // of waiting for a task
+      p.state = Shared::State::RUNNING;
+      guard.unlock();
+      Shared::fill(shared, i);
+      guard.lock();
+    }
+  }
+
+  return nullptr;
+}
+
+void RocksDBParallelScan::reset() {
+  _shared->stop();
+  _shared->restart(_shared);
+}
+
+size_t RocksDBParallelScan::numPartitions() const {
+  return _shared->partitions.size();
+}
+
+size_t RocksDBParallelScan::bufferedBytes() const {
+  std::lock_guard<std::mutex> guard(_shared->mutex);
+  size_t result = 0;
+  for (auto const& p : _shared->partitions) {
+    result += p.bufferedBytes;
+  }
+  return result;
+}
@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_ROCKSDB_ENGINE_ROCKSDB_PARALLEL_SCAN_H
+#define ARANGOD_ROCKSDB_ENGINE_ROCKSDB_PARALLEL_SCAN_H 1
+
+#include "Basics/Common.h"
+#include "VocBase/LocalDocumentId.h"
+
+#include <functional>
+
+namespace rocksdb {
+class Comparator;
+class Iterator;
+}
+
+namespace arangodb {
+class RocksDBKeyBounds;
+
+/// @brief reads the documents of a key range, split into partitions. each
+/// partition has its own iterator and is read ahead in batches by tasks,
+/// while the consumer gets the batches in key order. a partition stops
+/// reading ahead once its batches buffer maxBufferedBytes of documents. if
+/// no task reads the partition the consumer needs, the consumer reads it
+/// itself, so the scan cannot stall
+class RocksDBParallelScan {
+ public:
+  /// @brief documents read from a partition
+  struct Batch {
+    std::vector<LocalDocumentId> ids;
+    /// @brief start of each document in data
+    std::vector<size_t> offsets;
+    std::string data;
+  };
+
+  /// @brief runs a task on another thread. the default posts it to the
+  /// scheduler. a task that is never run is fine, the partition is then
+  /// read by the consumer
+  typedef std::function<void(std::function<void()> const&)> PostFunction;
+
+  /// @brief the boundaries of the partitions of the key range: partition i
+  /// starts at key i of the result and ends before key i + 1, the last one
+  /// includes the end of the bounds. the range between the first and the
+  /// last key found with the iterator is split evenly. returns less than
+  /// numPartitions partitions if there are not enough keys
+  static std::vector<std::string> partitionBounds(rocksdb::Comparator const* cmp,
+                                                  rocksdb::Iterator* it,
+                                                  RocksDBKeyBounds const& bounds,
+                                                  size_t numPartitions);
+
+  /// @brief starts reading ahead. there must be one iterator per partition,
+  /// all on the same snapshot
+  RocksDBParallelScan(rocksdb::Comparator const* cmp,
+                      std::vector<std::string> const& partitionBounds,
+                      std::vector<std::unique_ptr<rocksdb::Iterator>> iterators,
+                      size_t batchBytes, size_t maxBufferedBytes,
+                      PostFunction const& post = PostFunction());
+
+  /// @brief waits until no task reads a partition anymore. tasks that are
+  /// still queued do not touch the iterators afterwards
+  ~RocksDBParallelScan();
+
+  /// @brief the next batch in key order, a nullptr if all partitions are
+  /// exhausted. throws if reading a partition failed
+  std::unique_ptr<Batch> next();
+
+  /// @brief start reading all partitions from their start again
+  void reset();
+
+  size_t numPartitions() const;
+
+  /// @brief the size of the documents read ahead, but not yet returned
+  size_t bufferedBytes() const;
+
+ private:
+  struct Shared;
+
+  std::shared_ptr<Shared> _shared;
+};
+
+}  // namespace arangodb
+
+#endif
@@ -24,6 +24,7 @@
 #include "RocksDBPrimaryIndex.h"
 #include "Aql/AstNode.h"
 #include "Basics/Exceptions.h"
+#include "Basics/LocalTaskQueue.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Cache/CachedValue.h"
@@ -42,6 +43,8 @@
 #include "RocksDBEngine/RocksDBTransactionState.h"
 #include "RocksDBEngine/RocksDBTypes.h"
 #include "RocksDBEngine/RocksDBValue.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "Transaction/Context.h"
 #include "Transaction/Helpers.h"
@@ -147,6 +150,23 @@ bool RocksDBPrimaryIndexIterator::nextCovering(DocumentCallback const& cb, size_
 
 void RocksDBPrimaryIndexIterator::reset() { _iterator.reset(); }
 
+RocksDBPrimaryIndexWarmupTask::RocksDBPrimaryIndexWarmupTask(
+    std::shared_ptr<basics::LocalTaskQueue> const& queue,
+    RocksDBPrimaryIndex* index,
+    transaction::Methods* trx)
+  : LocalTask(queue),
+    _index(index),
+    _trx(trx) {}
+
+void RocksDBPrimaryIndexWarmupTask::run() {
+  try {
+    _index->warmupInternal(_trx);
+  } catch (...) {
+    _queue->setStatus(TRI_ERROR_INTERNAL);
+  }
+  _queue->join();
+}
+
 // ================ PrimaryIndex ================
 
 RocksDBPrimaryIndex::RocksDBPrimaryIndex(
@@ -177,6 +197,86 @@ void RocksDBPrimaryIndex::load() {
   }
 }
 
+/// @brief fill the cache with all entries of the index
+void RocksDBPrimaryIndex::warmup(transaction::Methods* trx,
+                                 std::shared_ptr<basics::LocalTaskQueue> queue) {
+  if (!useCache()) {
+    return;
+  }
+
+  // prepare transaction for parallel read access, the other indexes of the
+  // collection may be warmed up at the same time
+  RocksDBTransactionState::toState(trx)->prepareForParallelReads();
+
+  auto task = std::make_shared<RocksDBPrimaryIndexWarmupTask>(queue, this, trx);
+  queue->enqueue(task);
+}
+
+/// @brief insert all entries of the index into the cache
+void RocksDBPrimaryIndex::warmupInternal(transaction::Methods* trx) {
+  auto scheduler = SchedulerFeature::SCHEDULER;
+  RocksDBEngine* engine = rocksutils::globalRocksEngine();
+  auto bounds = RocksDBKeyBounds::PrimaryIndex(_objectId);
+
+  // intentional copy of the read options
+  auto* mthds = RocksDBTransactionState::toMethods(trx);
+  rocksdb::Slice const end = bounds.end();
+  rocksdb::ReadOptions options = mthds->readOptions();
+  options.iterate_upper_bound = &end;  // save to use on rocksb::DB directly
+  options.verify_checksums = false;
+  options.fill_cache = PrimaryIndexFillBlockCache;
+  std::unique_ptr<rocksdb::Iterator> it(
+      rocksutils::globalRocksDB()->NewIterator(options, _cf));
+
+  cache::Cache* cc = _cache.get();
+  uint64_t bytesRead = 0;
+  for (it->Seek(bounds.start()); it->Valid(); it->Next()) {
+    if (scheduler->isStopping()) {
+      return;
+    }
+
+    rocksdb::Slice key = it->key();
+    rocksdb::Slice value = it->value();
+    bytesRead += key.size() + value.size();
+    if (bytesRead >= RocksDBEngine::warmupPaceBytes) {
+      engine->paceWarmup(bytesRead);
+      bytesRead = 0;
+    }
+
+    // key and value are cached exactly like in lookupKey()
+    auto finding = cc->find(key.data(), static_cast<uint32_t>(key.size()));
+    if (finding.found()) {
+      continue;
+    }
+
+    while (cc->isBusy()) {
+      // We should wait here, the cache will reject
+      // any inserts anyways.
+      std::this_thread::sleep_for(std::chrono::microseconds(10000));
+    }
+
+    auto entry = cache::CachedValue::construct(
+        key.data(), static_cast<uint32_t>(key.size()),
+        value.data(), static_cast<uint64_t>(value.size()));
+    if (entry) {
+      bool inserted = false;
+      for (size_t attempts = 0; attempts < 10; attempts++) {
+        auto status = cc->insert(entry);
+        if (status.ok()) {
+          inserted = true;
+          break;
+        }
+        if (status.errorNumber() != TRI_ERROR_LOCK_TIMEOUT) {
+          break;
+        }
+      }
+      if (!inserted) {
+        delete entry;
+      }
+    }
+  }
+}
+
 /// @brief return a VelocyPack representation of the index
 void RocksDBPrimaryIndex::toVelocyPack(VPackBuilder& builder, bool withFigures,
                                        bool forPersistence) const {
@@ -194,6 +294,19 @@ void RocksDBPrimaryIndex::toVelocyPack(VPackBuilder& builder, bool withFigures,
   builder.close();
 }
 
+/// @brief the cache keys are the index keys of the documents
+void RocksDBPrimaryIndex::reloadCacheKeys(
+    transaction::Methods* trx, std::vector<std::string> const& keys) const {
+  for (auto const& key : keys) {
+    rocksdb::Slice const slice(key);
+    if (slice.size() <= sizeof(uint64_t) ||
+        RocksDBKey::objectId(slice) != _objectId) {
+      continue;
+    }
+    lookupKey(trx, RocksDBKey::primaryKey(slice));
+  }
+}
+
 LocalDocumentId RocksDBPrimaryIndex::lookupKey(transaction::Methods* trx,
                                                arangodb::StringRef keyRef) const {
   RocksDBKeyLeaser key(trx);
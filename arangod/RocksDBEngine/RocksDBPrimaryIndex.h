@@ -24,6 +24,7 @@
 #ifndef ARANGOD_ROCKSDB_ENGINE_ROCKSDB_PRIMARY_INDEX_H
 #define ARANGOD_ROCKSDB_ENGINE_ROCKSDB_PRIMARY_INDEX_H 1
 
+#include "Basics/LocalTaskQueue.h"
 #include "Indexes/Index.h"
 #include "Indexes/IndexIterator.h"
 #include "RocksDBEngine/RocksDBIndex.h"
@@ -75,8 +76,22 @@ class RocksDBPrimaryIndexIterator final : public IndexIterator {
   bool const _allowCoveringIndexOptimization;
 };
 
+class RocksDBPrimaryIndexWarmupTask : public basics::LocalTask {
+ private:
+  RocksDBPrimaryIndex* _index;
+  transaction::Methods* _trx;
+
+ public:
+  RocksDBPrimaryIndexWarmupTask(
+      std::shared_ptr<basics::LocalTaskQueue> const& queue,
+      RocksDBPrimaryIndex* index,
+      transaction::Methods* trx);
+  void run() override;
+};
+
 class RocksDBPrimaryIndex final : public RocksDBIndex {
   friend class RocksDBPrimaryIndexIterator;
+  friend class RocksDBPrimaryIndexWarmupTask;
   friend class RocksDBAllIndexIterator;
   friend class RocksDBAnyIndexIterator;
 
@@ -109,9 +124,16 @@ class RocksDBPrimaryIndex final : public RocksDBIndex {
 
   void toVelocyPack(VPackBuilder&, bool, bool) const override;
 
+  /// @brief fill the cache with all entries of the index
+  void warmup(transaction::Methods* trx,
+              std::shared_ptr<basics::LocalTaskQueue> queue) override;
+
   LocalDocumentId lookupKey(transaction::Methods* trx,
                          arangodb::StringRef key) const;
 
+  void reloadCacheKeys(transaction::Methods* trx,
+                       std::vector<std::string> const& keys) const override;
+
   bool supportsFilterCondition(arangodb::aql::AstNode const*,
                                arangodb::aql::Variable const*, size_t, size_t&,
                                double&) const override;
@@ -163,6 +185,9 @@ class RocksDBPrimaryIndex final : public RocksDBIndex {
   void handleValNode(transaction::Methods* trx, VPackBuilder* keys,
                      arangodb::aql::AstNode const* valNode, bool isId) const;
 
+  /// @brief insert all entries of the index into the cache
+  void warmupInternal(transaction::Methods* trx);
+
 private:
   bool const _isRunningInCluster;
 };
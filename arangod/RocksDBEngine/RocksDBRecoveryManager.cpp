@@ -28,6 +28,8 @@
 #include "Basics/NumberUtils.h"
 #include "Basics/StringUtils.h"
 #include "Basics/VelocyPackHelper.h"
+#include "Basics/ConditionLocker.h"
+#include "Basics/ConditionVariable.h"
 #include "Basics/WriteLocker.h"
 #include "Basics/Exceptions.h"
 #include "Basics/exitcodes.h"
@@ -40,7 +42,9 @@
 #include "RocksDBEngine/RocksDBEdgeIndex.h"
 #include "RocksDBEngine/RocksDBKey.h"
 #include "RocksDBEngine/RocksDBKeyBounds.h"
+#include "RocksDBEngine/RocksDBLogValue.h"
 #include "RocksDBEngine/RocksDBRecoveryHelper.h"
+#include "RocksDBEngine/RocksDBRevisionTree.h"
 #include "RocksDBEngine/RocksDBSettingsManager.h"
 #include "RocksDBEngine/RocksDBVPackIndex.h"
 #include "RocksDBEngine/RocksDBValue.h"
@@ -57,6 +61,8 @@
 #include <velocypack/Slice.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <thread>
+
 using namespace arangodb;
 using namespace arangodb::application_features;
 
@@ -109,6 +115,111 @@ void RocksDBRecoveryManager::runRecovery() {
 
 bool RocksDBRecoveryManager::inRecovery() const { return _inRecovery; }
 
+/// @brief replays the WAL into one recovery helper on a thread of its own,
+/// so the helpers do not hold up each other or the counters and estimators
+class HelperReader final : public rocksdb::WriteBatch::Handler {
+ public:
+  explicit HelperReader(std::shared_ptr<RocksDBRecoveryHelper> helper)
+      : _helper(std::move(helper)), _done(false) {
+    _thread = std::thread([this]() { run(); });
+  }
+
+  ~HelperReader() { finish(); }
+
+  /// @brief hand over a batch. waits while the helper lags behind too much
+  void enqueue(std::shared_ptr<rocksdb::WriteBatch> const& batch) {
+    CONDITION_LOCKER(guard, _condition);
+    while (_batches.size() >= maxPendingBatches && _result.ok()) {
+      guard.wait(10000);
+    }
+    if (_result.ok()) {
+      _batches.emplace_back(batch);
+      guard.signal();
+    }
+  }
+
+  /// @brief wait until all batches are replayed
+  Result finish() {
+    {
+      CONDITION_LOCKER(guard, _condition);
+      _done = true;
+      guard.broadcast();
+    }
+    if (_thread.joinable()) {
+      _thread.join();
+    }
+    return _result;
+  }
+
+  rocksdb::Status PutCF(uint32_t column_family_id, const rocksdb::Slice& key,
+                        const rocksdb::Slice& value) override {
+    _helper->PutCF(column_family_id, key, value);
+    return rocksdb::Status();
+  }
+
+  rocksdb::Status DeleteCF(uint32_t column_family_id,
+                           const rocksdb::Slice& key) override {
+    _helper->DeleteCF(column_family_id, key);
+    return rocksdb::Status();
+  }
+
+  rocksdb::Status SingleDeleteCF(uint32_t column_family_id,
+                                 const rocksdb::Slice& key) override {
+    _helper->SingleDeleteCF(column_family_id, key);
+    return rocksdb::Status();
+  }
+
+  rocksdb::Status DeleteRangeCF(uint32_t column_family_id,
+                                const rocksdb::Slice& begin_key,
+                                const rocksdb::Slice& end_key) override {
+    _helper->DeleteRangeCF(column_family_id, begin_key, end_key);
+    return rocksdb::Status();
+  }
+
+  void LogData(const rocksdb::Slice& blob) override { _helper->LogData(blob); }
+
+ private:
+  void run() {
+    while (true) {
+      std::shared_ptr<rocksdb::WriteBatch> batch;
+      {
+        CONDITION_LOCKER(guard, _condition);
+        while (_batches.empty() && !_done) {
+          guard.wait(10000);
+        }
+        if (_batches.empty()) {
+          return;
+        }
+        batch = std::move(_batches.front());
+        _batches.pop_front();
+        guard.signal();
+      }
+
+      Result res = basics::catchToResult([&]() -> Result {
+        return rocksutils::convertStatus(batch->Iterate(this));
+      });
+
+      if (res.fail()) {
+        CONDITION_LOCKER(guard, _condition);
+        _result = std::move(res);
+        _batches.clear();
+        guard.broadcast();
+        return;
+      }
+    }
+  }
+
+  static constexpr size_t maxPendingBatches = 256;
+
+  std::shared_ptr<RocksDBRecoveryHelper> _helper;
+  /// @brief protects all of the following
+  basics::ConditionVariable _condition;
+  std::deque<std::shared_ptr<rocksdb::WriteBatch>> _batches;
+  Result _result;
+  bool _done;
+  std::thread _thread;
+};
+
 class WBReader final : public rocksdb::WriteBatch::Handler {
  public:
   std::unordered_map<uint64_t, RocksDBSettingsManager::CounterAdjustment>
@@ -119,6 +230,16 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
   // must be retrieved from settings manager
   std::unordered_map<uint64_t, rocksdb::SequenceNumber> _seqStart;
   std::unordered_map<uint64_t, uint64_t> _generators;
+  /// @brief revision trees that may still be valid, or nullptr
+  std::unordered_map<uint64_t, RocksDBRevisionTree*> _revisionTrees;
+  /// @brief estimators of index object ids, or nullptr
+  std::unordered_map<uint64_t, RocksDBCuckooIndexEstimator<uint64_t>*>
+      _estimators;
+  /// @brief estimator operations not yet applied, in WAL order
+  std::unordered_map<RocksDBCuckooIndexEstimator<uint64_t>*,
+                     std::vector<std::pair<uint64_t, bool>>>
+      _estimatorUpdates;
+  size_t _pendingEstimatorUpdates = 0;
 
   uint64_t _maxTick = 0;
   uint64_t _maxHLC = 0;
@@ -129,6 +250,8 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
 
   Result shutdownWBReader() {
     Result rv = basics::catchVoidToResult([&]() -> void {
+      applyEstimatorUpdates();
+
       // update ticks after parsing wal
       LOG_TOPIC(TRACE, Logger::ENGINES) << "max tick found in WAL: " << _maxTick
                                         << ", last HLC value: " << _maxHLC;
@@ -163,19 +286,19 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
     return rv;
   }
 
-  bool shouldHandleDocument(uint32_t column_family_id,
-                            const rocksdb::Slice& key) {
+  /// @brief the counter adjustment of a document operation, or nullptr if
+  /// the persisted counter already includes it
+  RocksDBSettingsManager::CounterAdjustment* counterDelta(
+      uint32_t column_family_id, const rocksdb::Slice& key) {
     if (column_family_id == RocksDBColumnFamily::documents()->GetID()) {
       uint64_t objectId = RocksDBKey::objectId(key);
       auto const& it = _seqStart.find(objectId);
       if (it != _seqStart.end()) {
-        if (deltas.find(objectId) == deltas.end()) {
-          deltas.emplace(objectId, RocksDBSettingsManager::CounterAdjustment());
-        }
-        return it->second <= currentSeqNum;
+        auto& delta = deltas[objectId];
+        return it->second <= currentSeqNum ? &delta : nullptr;
       }
     }
-    return false;
+    return nullptr;
   }
 
   void storeMaxHLC(uint64_t hlc) {
@@ -238,6 +361,131 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
     return static_cast<RocksDBIndex*>(index.get())->estimator();
   }
 
+  /// @brief remember an estimator operation. the operations are applied
+  /// in batches, and the estimators are looked up only once
+  void bufferEstimatorUpdate(uint64_t objectId, uint64_t hash, bool insert) {
+    auto it = _estimators.find(objectId);
+    if (it == _estimators.end()) {
+      it = _estimators.emplace(objectId, findEstimator(objectId)).first;
+    }
+    RocksDBCuckooIndexEstimator<uint64_t>* est = it->second;
+    if (est != nullptr && est->commitSeq() < currentSeqNum) {
+      // We track estimates for this index
+      _estimatorUpdates[est].emplace_back(hash, insert);
+      if (++_pendingEstimatorUpdates >= estimatorBatchSize) {
+        applyEstimatorUpdates();
+      }
+    }
+  }
+
+  /// @brief apply the buffered estimator operations. the estimators are
+  /// independent of each other, so they are updated in parallel
+  void applyEstimatorUpdates() {
+    if (_estimatorUpdates.empty()) {
+      return;
+    }
+
+    std::vector<std::pair<RocksDBCuckooIndexEstimator<uint64_t>*,
+                          std::vector<std::pair<uint64_t, bool>>*>>
+        work;
+    work.reserve(_estimatorUpdates.size());
+    for (auto& it : _estimatorUpdates) {
+      work.emplace_back(it.first, &it.second);
+    }
+
+    size_t const n = (std::min)(work.size(), TRI_numberProcessors());
+    std::atomic<size_t> next(0);
+    auto worker = [&work, &next]() {
+      size_t i;
+      while ((i = next++) < work.size()) {
+        work[i].first->apply(*work[i].second);
+      }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(n - 1);
+    try {
+      for (size_t i = 1; i < n; ++i) {
+        threads.emplace_back(worker);
+      }
+    } catch (...) {
+      // fewer threads do the job as well
+    }
+    worker();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    _estimatorUpdates.clear();
+    _pendingEstimatorUpdates = 0;
+  }
+
+  RocksDBRevisionTree* findRevisionTree(uint64_t objectId) {
+    auto dbColPair = rocksutils::mapObjectToCollection(objectId);
+    if (dbColPair.second == 0 && dbColPair.first == 0) {
+      return nullptr;
+    }
+
+    DatabaseFeature* df = DatabaseFeature::DATABASE;
+    TRI_vocbase_t* vb = df->useDatabase(dbColPair.first);
+    if (vb == nullptr) {
+      return nullptr;
+    }
+    TRI_DEFER(vb->release());
+
+    auto coll = vb->lookupCollection(dbColPair.second);
+    if (coll == nullptr) {
+      return nullptr;
+    }
+
+    RocksDBRevisionTree* tree =
+        static_cast<RocksDBCollection*>(coll->getPhysical())->revisionTree();
+    return tree->isValid() ? tree : nullptr;
+  }
+
+  /// @brief a persisted revision tree does not contain the document
+  /// operations after it was written, so it is built again when needed
+  void invalidateRevisionTree(uint64_t objectId) {
+    auto it = _revisionTrees.find(objectId);
+    if (it == _revisionTrees.end()) {
+      it = _revisionTrees.emplace(objectId, findRevisionTree(objectId)).first;
+    }
+    RocksDBRevisionTree* tree = it->second;
+    if (tree != nullptr && tree->commitSeq() < currentSeqNum) {
+      tree->invalidate();
+      it->second = nullptr;
+    }
+  }
+
+  /// @brief clear all index estimators of a truncated collection
+  void truncateEstimators(TRI_voc_tick_t dbid, TRI_voc_cid_t cid) {
+    DatabaseFeature* df = DatabaseFeature::DATABASE;
+    TRI_vocbase_t* vb = df->useDatabase(dbid);
+    if (vb == nullptr) {
+      return;
+    }
+    TRI_DEFER(vb->release());
+
+    auto coll = vb->lookupCollection(cid);
+
+    if (coll == nullptr) {
+      return;
+    }
+
+    for (auto const& index : coll->getIndexes()) {
+      auto est = static_cast<RocksDBIndex*>(index.get())->estimator();
+      if (est != nullptr && est->commitSeq() < currentSeqNum) {
+        // earlier operations are void
+        auto it = _estimatorUpdates.find(est);
+        if (it != _estimatorUpdates.end()) {
+          _pendingEstimatorUpdates -= it->second.size();
+          _estimatorUpdates.erase(it);
+        }
+        est->clear();
+      }
+    }
+  }
+
   void updateMaxTick(uint32_t column_family_id, const rocksdb::Slice& key,
                      const rocksdb::Slice& value) {
     // RETURN (side-effect): update _maxTick
@@ -298,17 +546,15 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
   rocksdb::Status PutCF(uint32_t column_family_id, const rocksdb::Slice& key,
                         const rocksdb::Slice& value) override {
     updateMaxTick(column_family_id, key, value);
-    if (shouldHandleDocument(column_family_id, key)) {
-      uint64_t objectId = RocksDBKey::objectId(key);
-      LocalDocumentId docId = RocksDBKey::documentId(key);
-
-      auto const& it = deltas.find(objectId);
-      if (it != deltas.end()) {
-        it->second._sequenceNum = currentSeqNum;
-        it->second._added++;
-        it->second._revisionId = docId.id();
-      }
-    } else {
+    if (column_family_id == RocksDBColumnFamily::documents()->GetID()) {
+      invalidateRevisionTree(RocksDBKey::objectId(key));
+    }
+    auto delta = counterDelta(column_family_id, key);
+    if (delta != nullptr) {
+      delta->_sequenceNum = currentSeqNum;
+      delta->_added++;
+      delta->_revisionId = RocksDBKey::documentId(key).id();
+    } else if (column_family_id != RocksDBColumnFamily::documents()->GetID()) {
       // We have to adjust the estimate with an insert
       uint64_t hash = 0;
       if (column_family_id == RocksDBColumnFamily::vpack()->GetID()) {
@@ -318,37 +564,25 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
       }
 
       if (hash != 0) {
-        uint64_t objectId = RocksDBKey::objectId(key);
-        auto est = findEstimator(objectId);
-        if (est != nullptr && est->commitSeq() < currentSeqNum) {
-          // We track estimates for this index
-          est->insert(hash);
-        }
+        bufferEstimatorUpdate(RocksDBKey::objectId(key), hash, true);
       }
     }
 
-    RocksDBEngine* engine =
-        static_cast<RocksDBEngine*>(EngineSelectorFeature::ENGINE);
-    for (auto helper : engine->recoveryHelpers()) {
-      helper->PutCF(column_family_id, key, value);
-    }
 
     return rocksdb::Status();
   }
 
   rocksdb::Status DeleteCF(uint32_t column_family_id,
                            const rocksdb::Slice& key) override {
-    if (shouldHandleDocument(column_family_id, key)) {
-      uint64_t objectId = RocksDBKey::objectId(key);
-      LocalDocumentId docId = RocksDBKey::documentId(key);
-
-      auto const& it = deltas.find(objectId);
-      if (it != deltas.end()) {
-        it->second._sequenceNum = currentSeqNum;
-        it->second._removed++;
-        it->second._revisionId = docId.id();
-      }
-    } else {
+    if (column_family_id == RocksDBColumnFamily::documents()->GetID()) {
+      invalidateRevisionTree(RocksDBKey::objectId(key));
+    }
+    auto delta = counterDelta(column_family_id, key);
+    if (delta != nullptr) {
+      delta->_sequenceNum = currentSeqNum;
+      delta->_removed++;
+      delta->_revisionId = RocksDBKey::documentId(key).id();
+    } else if (column_family_id != RocksDBColumnFamily::documents()->GetID()) {
       // We have to adjust the estimate with an insert
       uint64_t hash = 0;
       if (column_family_id == RocksDBColumnFamily::vpack()->GetID()) {
@@ -358,42 +592,58 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
       }
 
       if (hash != 0) {
-        uint64_t objectId = RocksDBKey::objectId(key);
-        auto est = findEstimator(objectId);
-        if (est != nullptr && est->commitSeq() < currentSeqNum) {
-          // We track estimates for this index
-          est->remove(hash);
-        }
+        bufferEstimatorUpdate(RocksDBKey::objectId(key), hash, false);
       }
     }
 
-    RocksDBEngine* engine =
-        static_cast<RocksDBEngine*>(EngineSelectorFeature::ENGINE);
-    for (auto helper : engine->recoveryHelpers()) {
-      helper->DeleteCF(column_family_id, key);
-    }
 
     return rocksdb::Status();
   }
 
   rocksdb::Status SingleDeleteCF(uint32_t column_family_id,
                                  const rocksdb::Slice& key) override {
-    RocksDBEngine* engine =
-        static_cast<RocksDBEngine*>(EngineSelectorFeature::ENGINE);
-    for (auto helper : engine->recoveryHelpers()) {
-      helper->SingleDeleteCF(column_family_id, key);
+    if (column_family_id == RocksDBColumnFamily::documents()->GetID()) {
+      invalidateRevisionTree(RocksDBKey::objectId(key));
     }
 
     return rocksdb::Status();
   }
 
+  rocksdb::Status DeleteRangeCF(uint32_t column_family_id,
+                                const rocksdb::Slice& begin_key,
+                                const rocksdb::Slice& end_key) override {
+    if (column_family_id == RocksDBColumnFamily::documents()->GetID()) {
+      invalidateRevisionTree(RocksDBKey::objectId(begin_key));
+    }
+    // counters and estimators are adjusted via the truncate marker that
+    // precedes every range delete of a collection that is not dropped
+
+    return rocksdb::Status();
+  }
+
   void LogData(const rocksdb::Slice& blob) override {
-    RocksDBEngine* engine =
-        static_cast<RocksDBEngine*>(EngineSelectorFeature::ENGINE);
-    for (auto helper : engine->recoveryHelpers()) {
-      helper->LogData(blob);
+    if (RocksDBLogValue::type(blob) == RocksDBLogType::CollectionTruncate) {
+      uint64_t objectId = RocksDBLogValue::objectId(blob);
+      auto const& it = _seqStart.find(objectId);
+      if (it != _seqStart.end() && it->second <= currentSeqNum) {
+        // all earlier changes to the counter are void, and the persisted
+        // count is removed completely
+        RocksDBEngine* engine =
+            static_cast<RocksDBEngine*>(EngineSelectorFeature::ENGINE);
+        auto counter = engine->settingsManager()->loadCounter(objectId);
+        auto& delta = deltas[objectId];
+        delta._sequenceNum = currentSeqNum;
+        delta._added = 0;
+        delta._removed = counter.added();
+      }
+      truncateEstimators(RocksDBLogValue::databaseId(blob),
+                         RocksDBLogValue::collectionId(blob));
     }
   }
+
+ private:
+  /// @brief number of estimator operations applied at once
+  static constexpr size_t estimatorBatchSize = 1024 * 1024;
 };
 
 /// parse the WAL with the above handler parser class
@@ -408,6 +658,12 @@ Result RocksDBRecoveryManager::parseRocksWAL() {
       helper->prepare();
     }
 
+    // every recovery helper replays the WAL on its own thread
+    std::vector<std::unique_ptr<HelperReader>> helperReaders;
+    for (auto& helper : engine->recoveryHelpers()) {
+      helperReaders.emplace_back(new HelperReader(helper));
+    }
+
     // Tell the WriteBatch reader the transaction markers to look for
     WBReader handler(engine->settingsManager()->counterSeqs());
 
@@ -425,7 +681,12 @@ Result RocksDBRecoveryManager::parseRocksWAL() {
         if (s.ok()) {
           rocksdb::BatchResult batch = iterator->GetBatch();
           handler.currentSeqNum = batch.sequence;
-          s = batch.writeBatchPtr->Iterate(&handler);
+          std::shared_ptr<rocksdb::WriteBatch> writeBatch(
+              batch.writeBatchPtr.release());
+          for (auto& reader : helperReaders) {
+            reader->enqueue(writeBatch);
+          }
+          s = writeBatch->Iterate(&handler);
         }
 
 
@@ -440,6 +701,15 @@ Result RocksDBRecoveryManager::parseRocksWAL() {
         iterator->Next();
       }
 
+      for (auto& reader : helperReaders) {
+        Result res = reader->finish();
+        if (res.fail() && rv.ok()) {
+          rv.reset(res.errorNumber(),
+                   "error during WAL replay: " + res.errorMessage());
+          LOG_TOPIC(ERR, Logger::ENGINES) << rv.errorMessage();
+        }
+      }
+
       if (rv.ok()) {
         LOG_TOPIC(TRACE, Logger::ENGINES)
             << "finished WAL scan with " << handler.deltas.size();
@@ -35,6 +35,7 @@
 #include "RocksDBEngine/RocksDBCommon.h"
 #include "RocksDBEngine/RocksDBIterators.h"
 #include "RocksDBEngine/RocksDBMethods.h"
+#include "RocksDBEngine/RocksDBRevisionTree.h"
 #include "RocksDBEngine/RocksDBTransactionState.h"
 #include "Transaction/Helpers.h"
 #include "Transaction/Methods.h"
@@ -286,14 +287,15 @@ RocksDBReplicationResult RocksDBReplicationContext::dumpJson(
   TRI_ASSERT(collectionIter->iter->bounds().columnFamily() == RocksDBColumnFamily::documents());
 
   arangodb::basics::VPackStringBufferAdapter adapter(buff.stringBuffer());
-  auto cb = [&collectionIter, &buff, &adapter](rocksdb::Slice const& rocksKey, rocksdb::Slice const& rocksValue) {
+  std::string documentBuffer;
+  auto cb = [&collectionIter, &buff, &adapter, &documentBuffer](rocksdb::Slice const& rocksKey, rocksdb::Slice const& rocksValue) {
     buff.appendText("{\"type\":");
     buff.appendInteger(REPLICATION_MARKER_DOCUMENT); // set type
     buff.appendText(",\"data\":");
 
     // printing the data, note: we need the CustomTypeHandler here
     VPackDumper dumper(&adapter, &collectionIter->vpackOptions);
-    dumper.dump(velocypack::Slice(rocksValue.data()));
+    dumper.dump(RocksDBValue::document(rocksValue, documentBuffer));
     buff.appendText("}\n");
   };
 
@@ -349,12 +351,13 @@ RocksDBReplicationResult RocksDBReplicationContext::dumpVPack(TRI_vocbase_t* voc
   TRI_ASSERT(collectionIter->iter->bounds().columnFamily() == RocksDBColumnFamily::documents());
 
   VPackBuilder builder(buffer, &collectionIter->vpackOptions);
-  auto cb = [&builder](rocksdb::Slice const& rocksKey, rocksdb::Slice const& rocksValue) {
+  std::string documentBuffer;
+  auto cb = [&builder, &documentBuffer](rocksdb::Slice const& rocksKey, rocksdb::Slice const& rocksValue) {
 
     builder.openObject();
     builder.add("type", VPackValue(REPLICATION_MARKER_DOCUMENT));
     builder.add(VPackValue("data"));
-    builder.add(velocypack::Slice(rocksValue.data()));
+    builder.add(RocksDBValue::document(rocksValue, documentBuffer));
     builder.close();
   };
 
@@ -669,6 +672,121 @@ arangodb::Result RocksDBReplicationContext::dumpDocuments(
   return Result();
 }
 
+/// dump the ranges of the revision tree of the bound collection
+arangodb::Result RocksDBReplicationContext::dumpRanges(VPackBuilder& b,
+                                                       uint64_t chunkSize) {
+  TRI_ASSERT(_trx);
+
+  Result rv;
+  if (!_collection->iter) {
+    return rv.reset(
+        TRI_ERROR_BAD_PARAMETER,
+        "the replication context iterator has not been initialized");
+  }
+
+  auto physical =
+      static_cast<RocksDBCollection*>(_collection->logical.getPhysical());
+  rv = physical->ensureRevisionTree(static_cast<size_t>(chunkSize), nullptr);
+  if (rv.fail()) {
+    return rv;
+  }
+
+  std::vector<RocksDBRevisionTree::Range> ranges;
+  if (!physical->revisionTree()->ranges(ranges)) {
+    return rv.reset(TRI_ERROR_FAILED, "revision tree was invalidated");
+  }
+
+  b.openArray();
+  for (auto const& range : ranges) {
+    b.openObject();
+    b.add("low", VPackValue(range.low));
+    b.add("hash", VPackValue(std::to_string(range.hash)));
+    b.add("count", VPackValue(range.count));
+    b.close();
+  }
+  b.close();
+
+  return rv;
+}
+
+/// dump the keys of a range of the revision tree for incremental sync
+arangodb::Result RocksDBReplicationContext::dumpKeyRange(
+    VPackBuilder& b, std::string const& lowKey, std::string const& highKey) {
+  TRI_ASSERT(_trx);
+
+  Result rv;
+  if (!_collection->iter) {
+    return rv.reset(
+        TRI_ERROR_BAD_PARAMETER,
+        "the replication context iterator has not been initialized");
+  }
+  _collection->setSorted(true, _trx.get());
+  TRI_ASSERT(_collection->iter);
+  TRI_ASSERT(_collection->sorted());
+
+  auto primary = _collection->iter.get();
+
+  // the range is not at a known offset, so the next positional call has
+  // to position the iterator again
+  _lastIteratorOffset = std::numeric_limits<uint64_t>::max();
+  if (lowKey.empty()) {
+    _collection->hasMore = primary->reset();
+  } else {
+    RocksDBKeyLeaser val(_trx.get());
+    val->constructPrimaryIndexValue(primary->bounds().objectId(),
+                                    StringRef(lowKey));
+    _collection->hasMore = primary->seek(val->string());
+  }
+
+  bool done = false;
+  auto cb = [&](rocksdb::Slice const& rocksKey, rocksdb::Slice const& rocksValue) {
+    StringRef docKey(RocksDBKey::primaryKey(rocksKey));
+    if (!highKey.empty() && docKey.compare(highKey) >= 0) {
+      done = true;
+      return;
+    }
+
+    TRI_voc_rid_t docRev;
+    if(!RocksDBValue::revisionId(rocksValue, docRev)){
+      // for collections that do not have the revisionId in the value
+      auto documentId = RocksDBValue::documentId(rocksValue);
+      if(_collection->logical.readDocument(_trx.get(), documentId, _collection->mdr) == false) {
+        TRI_ASSERT(false);
+        return;
+      }
+      VPackSlice doc(_collection->mdr.vpack());
+      docRev = TRI_ExtractRevisionId(doc);
+    }
+
+    b.openArray();
+    b.add(velocypack::ValuePair(docKey.data(), docKey.size(), velocypack::ValueType::String));
+    b.add(VPackValue(TRI_RidToString(docRev)));
+    b.close();
+  };
+
+  b.openArray();
+  try {
+    while (!done && _collection->hasMore) {
+      _collection->hasMore = primary->next(cb, 1);
+    }
+  } catch (std::exception const&) {
+    return rv.reset(TRI_ERROR_INTERNAL);
+  }
+  b.close();
+
+  return rv;
+}
+
+/// dump documents of a range of the revision tree for incremental sync
+arangodb::Result RocksDBReplicationContext::dumpDocumentRange(
+    VPackBuilder& b, size_t offsetInRange, size_t maxChunkSize,
+    std::string const& lowKey, VPackSlice const& ids) {
+  // positions are relative to the low key, so the iterator has to be
+  // positioned at it
+  _lastIteratorOffset = std::numeric_limits<uint64_t>::max();
+  return dumpDocuments(b, 0, 1, offsetInRange, maxChunkSize, lowKey, ids);
+}
+
 double RocksDBReplicationContext::expires() const {
   MUTEX_LOCKER(locker, _contextLock);
   return _expires;
@@ -130,6 +130,24 @@ class RocksDBReplicationContext {
                                  size_t chunkSize, size_t offsetInChunk, size_t maxChunkSize,
                                  std::string const& lowKey, velocypack::Slice const& ids);
 
+  /// dump the key ranges of the revision tree of the bound collection, with
+  /// their hashes and document counts. the tree reflects the current state
+  /// of the collection, not the snapshot of the context
+  arangodb::Result dumpRanges(velocypack::Builder& outBuilder,
+                              uint64_t chunkSize);
+
+  /// dump the keys from lowKey up to highKey (exclusive, unbounded if empty)
+  arangodb::Result dumpKeyRange(velocypack::Builder& outBuilder,
+                                std::string const& lowKey,
+                                std::string const& highKey);
+
+  /// dump documents of the range starting at lowKey, ids are positions
+  /// relative to the start of the range
+  arangodb::Result dumpDocumentRange(velocypack::Builder& b,
+                                     size_t offsetInRange, size_t maxChunkSize,
+                                     std::string const& lowKey,
+                                     velocypack::Slice const& ids);
+
   double expires() const;
   bool isDeleted() const;
   void deleted();
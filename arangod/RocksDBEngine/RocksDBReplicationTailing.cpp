@@ -67,6 +67,8 @@ TRI_replication_operation_e rocksutils::convertLogType(RocksDBLogType t) {
       return REPLICATION_COLLECTION_RENAME;
     case RocksDBLogType::CollectionChange:
       return REPLICATION_COLLECTION_CHANGE;
+    case RocksDBLogType::CollectionTruncate:
+      return REPLICATION_COLLECTION_TRUNCATE;
     case RocksDBLogType::IndexCreate:
       return REPLICATION_INDEX_CREATE;
     case RocksDBLogType::IndexDrop:
@@ -183,6 +185,27 @@ class WALParser final : public rocksdb::WriteBatch::Handler {
         }
         break;
       }
+      case RocksDBLogType::CollectionTruncate: {
+        resetTransientState(); // finish ongoing trx
+        TRI_voc_tick_t dbid = RocksDBLogValue::databaseId(blob);
+        TRI_voc_cid_t cid = RocksDBLogValue::collectionId(blob);
+        if (shouldHandleCollection(dbid, cid)) {
+          TRI_ASSERT(_vocbase->id() == dbid);
+          LogicalCollection* coll = loadCollection(cid);
+          TRI_ASSERT(coll != nullptr);
+          uint64_t tick = _currentSequence + (_startOfBatch ? 0 : 1);
+          _builder.openObject();
+          _builder.add("tick", VPackValue(std::to_string(tick)));
+          _builder.add("type", VPackValue(REPLICATION_COLLECTION_TRUNCATE));
+          _builder.add("database", VPackValue(std::to_string(dbid)));
+          _builder.add("cid", VPackValue(std::to_string(cid)));
+          _builder.add("cuid", VPackValue(coll->guid()));
+          _builder.add("cname", VPackValue(coll->name()));
+          _builder.close();
+          updateLastEmittedTick(tick);
+        }
+        break;
+      }
       case RocksDBLogType::IndexCreate: {
         resetTransientState(); // finish ongoing trx
 
@@ -399,7 +422,8 @@ class WALParser final : public rocksdb::WriteBatch::Handler {
         marker->add("tid", VPackValue(std::to_string(_currentTrxId)));
         marker->add("cid", VPackValue(cid));
         marker->add("cname", VPackValue(col->name()));
-        marker->add("data", RocksDBValue::data(value));
+        std::string buffer;
+        marker->add("data", RocksDBValue::document(value, buffer));
       }
       updateLastEmittedTick(_currentSequence);
       
@@ -458,6 +482,16 @@ class WALParser final : public rocksdb::WriteBatch::Handler {
     return rocksdb::Status();
   }
 
+  rocksdb::Status DeleteRangeCF(uint32_t /*column_family_id*/,
+                                const rocksdb::Slice& /*begin_key*/,
+                                const rocksdb::Slice& /*end_key*/) override {
+    tick();
+    // range deletes are only written by collection truncate and drop,
+    // which are replicated via their log markers
+    resetTransientState();
+    return rocksdb::Status();
+  }
+
   void startNewBatch(rocksdb::SequenceNumber startSequence) {
     // starting new write batch
     _startSequence = startSequence;
@@ -25,12 +25,16 @@
 #include "Aql/Query.h"
 #include "Basics/Exceptions.h"
 #include "Basics/MutexLocker.h"
+#include "Basics/ScopeGuard.h"
+#include "Basics/StringUtils.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Cluster/ServerState.h"
 #include "RocksDBEngine/RocksDBCommon.h"
 #include "RocksDBEngine/RocksDBEngine.h"
+#include "RocksDBEngine/RocksDBExportCursor.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "Transaction/StandaloneContext.h"
+#include "Utils/ExecContext.h"
 #include "Utils/Cursor.h"
 #include "Utils/CursorRepository.h"
 #include "Utils/SingleCollectionTransaction.h"
@@ -45,6 +49,11 @@
 using namespace arangodb;
 using namespace arangodb::rest;
 
+namespace {
+/// @brief upper limit for the number of partitions of one export
+constexpr uint64_t MaxPartitions = 64;
+}
+
 RocksDBRestExportHandler::RocksDBRestExportHandler(GeneralRequest* request,
                                                    GeneralResponse* response,
                                                    aql::QueryRegistry* queryRegistry)
@@ -66,10 +75,16 @@ RestStatus RocksDBRestExportHandler::execute() {
   }
 
   if (type == rest::RequestType::PUT) {
+    if (modifyPartitionCursor()) {
+      return RestStatus::DONE;
+    }
     return RestCursorHandler::execute();
   }
 
   if (type == rest::RequestType::DELETE_REQ) {
+    if (deletePartitionCursor()) {
+      return RestStatus::DONE;
+    }
     return RestCursorHandler::execute();
   }
 
@@ -226,6 +241,10 @@ RestStatus RocksDBRestExportHandler::createCursor() {
     return RestStatus::DONE;
   }
 
+  if (body.isObject() && !body.get("partitions").isNone()) {
+    return createPartitionCursors(name, body);
+  }
+
   VPackBuilder queryBody = buildQueryOptions(name, body);
   TRI_ASSERT(_query == nullptr);
   if (registerQueryOrCursor(queryBody.slice())) {
@@ -234,6 +253,182 @@ RestStatus RocksDBRestExportHandler::createCursor() {
   return RestStatus::DONE;
 }
 
+RestStatus RocksDBRestExportHandler::createPartitionCursors(
+    std::string const& name, VPackSlice const& body) {
+  TRI_ASSERT(body.isObject());
+
+  VPackSlice partitions = body.get("partitions");
+  if (!partitions.isInteger() || partitions.getInt() <= 0) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_TYPE_ERROR, "expecting positive integer for 'partitions'");
+  }
+  // the partitions do not know their sizes in advance
+  if (!body.get("limit").isNone()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_BAD_PARAMETER,
+        "'limit' is not supported together with 'partitions'");
+  }
+  VPackSlice count = body.get("count");
+  if (count.isBool() && count.getBool()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_BAD_PARAMETER,
+        "'count' is not supported together with 'partitions'");
+  }
+
+  // the documents are not read by a query, so the permissions are checked
+  // here
+  ExecContext const* exec = ExecContext::CURRENT;
+  if (exec != nullptr &&
+      !exec->canUseCollection(_vocbase.name(), name, auth::Level::RO)) {
+    generateError(rest::ResponseCode::FORBIDDEN, TRI_ERROR_FORBIDDEN);
+    return RestStatus::DONE;
+  }
+
+  size_t batchSize =
+      basics::VelocyPackHelper::getNumericValue<size_t>(body, "batchSize", 1000);
+  if (batchSize == 0) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_TYPE_ERROR, "expecting non-zero value for 'batchSize'");
+  }
+  double ttl =
+      basics::VelocyPackHelper::getNumericValue<double>(body, "ttl", 30);
+
+  // handle "restrict" parameter
+  VPackSlice restrct = body.get("restrict");
+  if (restrct.isObject()) {
+    VPackSlice type = restrct.get("type");
+    if (!type.isString()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                     "expecting string for 'restrict.type'");
+    }
+    if (type.isEqualString("include")) {
+      _restrictions.type = CollectionExport::Restrictions::RESTRICTION_INCLUDE;
+    } else if (type.isEqualString("exclude")) {
+      _restrictions.type = CollectionExport::Restrictions::RESTRICTION_EXCLUDE;
+    } else {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                     "expecting either 'include' or 'exclude' for 'restrict.type'");
+    }
+
+    VPackSlice fields = restrct.get("fields");
+    if (!fields.isArray()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                     "expecting array for 'restrict.fields'");
+    }
+    for (auto const& field : VPackArrayIterator(fields)) {
+      if (field.isString()) {
+        _restrictions.fields.emplace(field.copyString());
+      }
+    }
+  } else if (!restrct.isNone()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_TYPE_ERROR, "expecting object for 'restrict'");
+  }
+
+  // this may throw
+  auto snapshot = std::make_shared<RocksDBExportCursor::Snapshot>(
+      _vocbase, name, _restrictions);
+  auto ranges = snapshot->partition(static_cast<size_t>(
+      std::min<uint64_t>(partitions.getUInt(), MaxPartitions)));
+
+  auto cursors = _vocbase.cursorRepository();
+  TRI_ASSERT(cursors != nullptr);
+
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add(StaticStrings::Error, VPackValue(false));
+  builder.add(StaticStrings::Code,
+              VPackValue(static_cast<int>(rest::ResponseCode::CREATED)));
+  builder.add("partitions", VPackValue(VPackValueType::Array));
+  for (auto const& range : ranges) {
+    // the documents are fetched by the following PUT requests, so that the
+    // partitions can be read concurrently
+    auto cursor = std::make_unique<RocksDBExportCursor>(
+        _vocbase, TRI_NewTickServer(), snapshot, range.first, range.second,
+        batchSize, ttl);
+    builder.add(VPackValue(std::to_string(cursor->id())));
+    cursors->addCursor(std::move(cursor));
+  }
+  builder.close();  // partitions
+  builder.close();
+
+  generateResult(rest::ResponseCode::CREATED, builder.slice());
+  return RestStatus::DONE;
+}
+
+bool RocksDBRestExportHandler::modifyPartitionCursor() {
+  std::vector<std::string> const& suffixes = _request->suffixes();
+
+  if (suffixes.size() != 1) {
+    return false;
+  }
+
+  auto cursors = _vocbase.cursorRepository();
+  TRI_ASSERT(cursors != nullptr);
+
+  auto cursorId = static_cast<arangodb::CursorId>(
+      arangodb::basics::StringUtils::uint64(suffixes[0]));
+  bool busy;
+  Cursor* cursor = cursors->find(cursorId, Cursor::CURSOR_EXPORT, busy);
+
+  if (cursor == nullptr) {
+    if (busy) {
+      generateError(GeneralResponse::responseCode(TRI_ERROR_CURSOR_BUSY),
+                    TRI_ERROR_CURSOR_BUSY);
+      return true;
+    }
+    // not a partition cursor, maybe a query cursor
+    return false;
+  }
+  TRI_DEFER(cursors->release(cursor));
+
+  VPackBuffer<uint8_t> buffer;
+  VPackBuilder builder(buffer);
+  builder.openObject();
+  builder.add(StaticStrings::Error, VPackValue(false));
+  builder.add(StaticStrings::Code,
+              VPackValue(static_cast<int>(rest::ResponseCode::OK)));
+  Result r = cursor->dumpSync(builder);
+  if (r.fail()) {
+    generateError(r);
+    return true;
+  }
+  builder.close();
+
+  _response->setContentType(rest::ContentType::JSON);
+  generateResult(rest::ResponseCode::OK, builder.slice());
+  return true;
+}
+
+bool RocksDBRestExportHandler::deletePartitionCursor() {
+  std::vector<std::string> const& suffixes = _request->suffixes();
+
+  if (suffixes.size() != 1) {
+    return false;
+  }
+
+  std::string const& id = suffixes[0];
+  CursorRepository* cursors = _vocbase.cursorRepository();
+  TRI_ASSERT(cursors != nullptr);
+
+  auto cursorId = static_cast<arangodb::CursorId>(
+      arangodb::basics::StringUtils::uint64(id));
+  if (!cursors->remove(cursorId, Cursor::CURSOR_EXPORT)) {
+    // not a partition cursor, maybe a query cursor
+    return false;
+  }
+
+  VPackBuilder result;
+  result.openObject();
+  result.add("id", VPackValue(id));
+  result.add(StaticStrings::Error, VPackValue(false));
+  result.add(StaticStrings::Code,
+             VPackValue(static_cast<int>(rest::ResponseCode::ACCEPTED)));
+  result.close();
+
+  generateResult(rest::ResponseCode::ACCEPTED, result.slice());
+  return true;
+}
+
 RestStatus RocksDBRestExportHandler::continueExecute() {
   // extract the sub-request type
   rest::RequestType const type = _request->requestType();
@@ -55,6 +55,27 @@ class RocksDBRestExportHandler : public RestCursorHandler {
 
   RestStatus createCursor();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief create one export cursor per key range of the collection, all
+  /// reading from the same snapshot
+  //////////////////////////////////////////////////////////////////////////////
+
+  RestStatus createPartitionCursors(std::string const& name, VPackSlice const&);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the next results of a partition cursor. returns false if
+  /// the id is not the one of a partition cursor
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool modifyPartitionCursor();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief dispose of a partition cursor. returns false if the id is not the
+  /// one of a partition cursor
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool deletePartitionCursor();
+
  private:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief restrictions for export
@@ -534,6 +534,21 @@ void RocksDBRestReplicationHandler::handleCommandGetKeys() {
 
   VPackBuffer<uint8_t> buffer;
   VPackBuilder builder(buffer);
+  // "ranges" returns the ranges of the revision tree instead of the key
+  // chunks. the entries of ranges have a "count", so clients can tell the
+  // responses apart, and we fall back to the chunks if the tree cannot be
+  // built
+  if (_request->value("type") == "ranges") {
+    Result rv = ctx->dumpRanges(builder, chunkSize);
+    if (rv.ok()) {
+      generateResult(rest::ResponseCode::OK, std::move(buffer));
+      return;
+    }
+    LOG_TOPIC(DEBUG, Logger::REPLICATION)
+        << "unable to provide revision ranges: " << rv.errorMessage();
+    buffer.clear();
+    builder.clear();
+  }
   ctx->dumpKeyChunks(builder, chunkSize);
   generateResult(rest::ResponseCode::OK, std::move(buffer));
 }
@@ -572,6 +587,10 @@ void RocksDBRestReplicationHandler::handleCommandFetchKeys() {
     chunk = static_cast<size_t>(StringUtils::uint64(value2));
   }
   std::string const& lowKey = _request->value("low", found);
+  // high is only sent for the ranges of the revision tree, in which case
+  // keys and offsets are relative to low
+  bool isRange = false;
+  std::string const& highKey = _request->value("high", isRange);
 
   std::string const& value3 = _request->value("type", found);
 
@@ -622,7 +641,9 @@ void RocksDBRestReplicationHandler::handleCommandFetchKeys() {
   VPackBuilder builder(buffer, transactionContext->getVPackOptions());
 
   if (keys) {
-    Result rv = ctx->dumpKeys(builder, chunk, static_cast<size_t>(chunkSize), lowKey);
+    Result rv = isRange
+        ? ctx->dumpKeyRange(builder, lowKey, highKey)
+        : ctx->dumpKeys(builder, chunk, static_cast<size_t>(chunkSize), lowKey);
 
     if (rv.fail()) {
       generateError(rv);
@@ -637,8 +658,11 @@ void RocksDBRestReplicationHandler::handleCommandFetchKeys() {
       return;
     }
 
-    Result rv = ctx->dumpDocuments(builder, chunk, static_cast<size_t>(chunkSize), offsetInChunk,
-                                   maxChunkSize, lowKey, parsedIds);
+    Result rv = isRange
+        ? ctx->dumpDocumentRange(builder, offsetInChunk, maxChunkSize, lowKey,
+                                 parsedIds)
+        : ctx->dumpDocuments(builder, chunk, static_cast<size_t>(chunkSize),
+                             offsetInChunk, maxChunkSize, lowKey, parsedIds);
 
     if (rv.fail()) {
       generateError(rv);
@@ -802,8 +826,5 @@ void RocksDBRestReplicationHandler::handleCommandDump() {
 
     // transfer ownership of the buffer contents
     response->body().set(dump.stringBuffer());
-
-    // avoid double freeing
-    TRI_StealStringBuffer(dump.stringBuffer());
   }
 }
@@ -0,0 +1,406 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RocksDBRevisionTree.h"
+
+#include "Basics/ConditionLocker.h"
+#include "Basics/MutexLocker.h"
+#include "Logger/Logger.h"
+#include "RocksDBEngine/RocksDBColumnFamily.h"
+#include "RocksDBEngine/RocksDBCommon.h"
+#include "RocksDBEngine/RocksDBEngine.h"
+#include "RocksDBEngine/RocksDBFormat.h"
+#include "RocksDBEngine/RocksDBKey.h"
+#include "RocksDBEngine/RocksDBKeyBounds.h"
+#include "RocksDBEngine/RocksDBValue.h"
+#include "VocBase/vocbase.h"
+
+#include <rocksdb/db.h>
+#include <rocksdb/iterator.h>
+#include <rocksdb/options.h>
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace {
+/// @brief number of attempts to build the tree, each of which fails if a
+/// transaction with untracked operations commits during the build
+constexpr size_t maxBuildAttempts = 3;
+}  // namespace
+
+RocksDBRevisionTree::RocksDBRevisionTree()
+    : _state(State::NONE),
+      _commitSeq(0),
+      _snapshotPending(false),
+      _dirty(false) {}
+
+uint64_t RocksDBRevisionTree::hashDocument(StringRef key, TRI_voc_rid_t rid) {
+  // we can get away with the fast hash function here, as key values are
+  // restricted to strings
+  VPackBuilder builder;
+  builder.add(VPackValuePair(key.data(), key.size(), VPackValueType::String));
+  uint64_t hash = builder.slice().hashString();
+  builder.clear();
+  builder.add(VPackValue(TRI_RidToString(rid)));
+  hash ^= builder.slice().hash();
+  return hash;
+}
+
+rocksdb::SequenceNumber RocksDBRevisionTree::commitSeq() const {
+  CONDITION_LOCKER(guard, _condition);
+  return _commitSeq;
+}
+
+void RocksDBRevisionTree::placeBlocker(uint64_t trxId,
+                                       rocksdb::SequenceNumber seq) {
+  CONDITION_LOCKER(guard, _condition);
+  while (_snapshotPending) {
+    guard.wait();
+  }
+  _blockers.emplace(trxId, seq);
+}
+
+void RocksDBRevisionTree::removeBlocker(uint64_t trxId) {
+  CONDITION_LOCKER(guard, _condition);
+  if (_blockers.erase(trxId) > 0) {
+    guard.broadcast();
+  }
+}
+
+void RocksDBRevisionTree::commit(uint64_t trxId,
+                                 std::vector<Operation>&& operations,
+                                 bool complete) {
+  if (_state.load() == State::NONE) {
+    return;
+  }
+
+  CONDITION_LOCKER(guard, _condition);
+  if (_blockers.erase(trxId) > 0) {
+    guard.broadcast();
+  }
+
+  switch (_state.load()) {
+    case State::NONE:
+    case State::TRACKING:
+      // the operations are part of the snapshot of the next build
+      break;
+    case State::BUILDING:
+      if (complete) {
+        _pending.emplace_back(std::move(operations));
+      } else {
+        // it is unknown which operations are part of the snapshot
+        _state = State::TRACKING;
+      }
+      break;
+    case State::VALID:
+      if (complete) {
+        if (!operations.empty()) {
+          apply(operations);
+          _dirty = true;
+        }
+      } else {
+        _ranges.clear();
+        _state = State::TRACKING;
+        _dirty = true;
+      }
+      break;
+  }
+}
+
+void RocksDBRevisionTree::truncate() {
+  CONDITION_LOCKER(guard, _condition);
+  if (_state.load() == State::VALID) {
+    for (auto& range : _ranges) {
+      range.hash = 0;
+      range.count = 0;
+    }
+    _dirty = true;
+  } else if (_state.load() == State::BUILDING) {
+    _state = State::TRACKING;
+  }
+}
+
+void RocksDBRevisionTree::invalidate() {
+  CONDITION_LOCKER(guard, _condition);
+  if (_state.load() == State::VALID || _state.load() == State::BUILDING) {
+    _ranges.clear();
+    _state = State::TRACKING;
+    _dirty = true;
+  }
+}
+
+Result RocksDBRevisionTree::ensureValid(rocksdb::DB* db, uint64_t objectId,
+                                        uint64_t indexId, size_t rangeSize,
+                                        std::vector<std::string> const* lows) {
+  TRI_ASSERT(rangeSize > 0);
+  TRI_ASSERT(lows == nullptr || (!lows->empty() && lows->front().empty()));
+
+  MUTEX_LOCKER(buildLocker, _buildLock);
+
+  for (size_t attempt = 0; attempt < ::maxBuildAttempts; ++attempt) {
+    rocksdb::Snapshot const* snapshot = nullptr;
+    {
+      CONDITION_LOCKER(guard, _condition);
+      if (_state.load() == State::VALID) {
+        bool usable = true;
+        if (lows != nullptr) {
+          usable = (lows->size() == _ranges.size());
+          for (size_t i = 0; usable && i < _ranges.size(); ++i) {
+            usable = ((*lows)[i] == _ranges[i].low);
+          }
+        } else {
+          for (auto const& range : _ranges) {
+            if (range.count > maxRangeFactor * rangeSize) {
+              usable = false;
+              break;
+            }
+          }
+        }
+        if (usable) {
+          return Result();
+        }
+      }
+
+      // track all operations from now on, and wait until all commits that
+      // are in progress are done, so that the snapshot contains either all
+      // or none of the operations of every transaction
+      _ranges.clear();
+      _pending.clear();
+      _state = State::TRACKING;
+      _snapshotPending = true;
+      while (!_blockers.empty()) {
+        guard.wait();
+      }
+      snapshot = db->GetSnapshot();
+      _state = State::BUILDING;
+      _snapshotPending = false;
+      guard.broadcast();
+    }
+
+    std::vector<Range> result;
+    Result res = build(db, snapshot, objectId, indexId, rangeSize, lows, result);
+    db->ReleaseSnapshot(snapshot);
+
+    CONDITION_LOCKER(guard, _condition);
+    if (res.fail()) {
+      if (_state.load() == State::BUILDING) {
+        _state = State::TRACKING;
+      }
+      _pending.clear();
+      return res;
+    }
+    if (_state.load() != State::BUILDING) {
+      // invalidated during the build, try again
+      _pending.clear();
+      continue;
+    }
+
+    _ranges = std::move(result);
+    for (auto const& operations : _pending) {
+      apply(operations);
+    }
+    _pending.clear();
+    _state = State::VALID;
+    _dirty = true;
+
+    LOG_TOPIC(DEBUG, Logger::ENGINES)
+        << "built revision tree with " << _ranges.size()
+        << " ranges for objectId '" << objectId << "'";
+    return Result();
+  }
+
+  return Result(TRI_ERROR_FAILED,
+                "revision tree was invalidated while it was built");
+}
+
+bool RocksDBRevisionTree::ranges(std::vector<Range>& result) const {
+  CONDITION_LOCKER(guard, _condition);
+  if (_state.load() != State::VALID) {
+    return false;
+  }
+  result = _ranges;
+  return true;
+}
+
+bool RocksDBRevisionTree::serialize(std::string& output,
+                                    rocksdb::SequenceNumber baseSeq,
+                                    rocksdb::SequenceNumber& seq) {
+  CONDITION_LOCKER(guard, _condition);
+  seq = baseSeq;
+  if (!_dirty) {
+    return false;
+  }
+
+  // commits in progress are not yet part of the tree, their operations
+  // are all written after their blocker's seq
+  for (auto const& it : _blockers) {
+    seq = std::min(seq, it.second);
+  }
+  _dirty = false;
+  _commitSeq = seq;
+
+  if (_state.load() != State::VALID) {
+    return true;
+  }
+
+  VPackBuilder builder;
+  builder.openArray();
+  for (auto const& range : _ranges) {
+    builder.openArray();
+    builder.add(VPackValue(range.low));
+    builder.add(VPackValue(range.hash));
+    builder.add(VPackValue(range.count));
+    builder.close();
+  }
+  builder.close();
+
+  rocksutils::uint64ToPersistent(output, seq);
+  output.append(builder.slice().startAs<char>(), builder.slice().byteSize());
+  return true;
+}
+
+void RocksDBRevisionTree::deserialize(rocksdb::SequenceNumber seq,
+                                      VPackSlice data) {
+  std::vector<Range> ranges;
+  if (!data.isArray()) {
+    return;
+  }
+  for (auto const& it : VPackArrayIterator(data)) {
+    if (!it.isArray() || it.length() != 3 || !it.at(0).isString() ||
+        !it.at(1).isNumber() || !it.at(2).isNumber()) {
+      return;
+    }
+    std::string low = it.at(0).copyString();
+    if ((ranges.empty() && !low.empty()) ||
+        (!ranges.empty() && low <= ranges.back().low)) {
+      return;
+    }
+    ranges.emplace_back(Range{std::move(low), it.at(1).getNumber<uint64_t>(),
+                              it.at(2).getNumber<uint64_t>()});
+  }
+  if (ranges.empty()) {
+    return;
+  }
+
+  CONDITION_LOCKER(guard, _condition);
+  _ranges = std::move(ranges);
+  _commitSeq = seq;
+  _state = State::VALID;
+  _dirty = false;
+}
+
+size_t RocksDBRevisionTree::findRange(std::string const& key) const {
+  TRI_ASSERT(!_ranges.empty() && _ranges.front().low.empty());
+  auto it = std::upper_bound(
+      _ranges.begin(), _ranges.end(), key,
+      [](std::string const& key, Range const& range) {
+        return key < range.low;
+      });
+  TRI_ASSERT(it != _ranges.begin());
+  return static_cast<size_t>(std::distance(_ranges.begin(), it)) - 1;
+}
+
+void RocksDBRevisionTree::apply(std::vector<Operation> const& operations) {
+  for (auto const& op : operations) {
+    Range& range = _ranges[findRange(op.key)];
+    range.hash ^= op.hash;
+    if (op.insert) {
+      ++range.count;
+    } else {
+      TRI_ASSERT(range.count > 0);
+      if (range.count > 0) {
+        --range.count;
+      }
+    }
+  }
+}
+
+Result RocksDBRevisionTree::build(rocksdb::DB* db,
+                                  rocksdb::Snapshot const* snapshot,
+                                  uint64_t objectId, uint64_t indexId,
+                                  size_t rangeSize,
+                                  std::vector<std::string> const* lows,
+                                  std::vector<Range>& result) const {
+  result.clear();
+  if (lows != nullptr) {
+    result.reserve(lows->size());
+    for (auto const& low : *lows) {
+      result.emplace_back(Range{low, 0, 0});
+    }
+  } else {
+    result.emplace_back(Range{std::string(), 0, 0});
+  }
+
+  RocksDBKeyBounds bounds = RocksDBKeyBounds::PrimaryIndex(indexId);
+  rocksdb::Slice const upper(bounds.end());
+
+  rocksdb::ReadOptions ro;
+  ro.snapshot = snapshot;
+  ro.prefix_same_as_start = true;
+  ro.iterate_upper_bound = &upper;
+  ro.fill_cache = false;
+  ro.readahead_size = static_cast<size_t>(
+      rocksutils::globalRocksEngine()->fullScanReadaheadSize());
+  std::unique_ptr<rocksdb::Iterator> it(
+      db->NewIterator(ro, bounds.columnFamily()));
+
+  RocksDBKey documentKey;
+  rocksdb::PinnableSlice document;
+  size_t current = 0;
+  uint64_t total = 0;
+
+  for (it->Seek(bounds.start()); it->Valid(); it->Next()) {
+    StringRef key(RocksDBKey::primaryKey(it->key()));
+
+    TRI_voc_rid_t rid;
+    if (!RocksDBValue::revisionId(it->value(), rid)) {
+      // for collections that do not have the revisionId in the value
+      documentKey.constructDocument(objectId,
+                                    RocksDBValue::documentId(it->value()));
+      document.Reset();
+      rocksdb::Status s = db->Get(ro, RocksDBColumnFamily::documents(),
+                                  documentKey.string(), &document);
+      if (!s.ok()) {
+        return rocksutils::convertStatus(s);
+      }
+      rid = TRI_ExtractRevisionId(VPackSlice(document.data()));
+    }
+
+    if (lows != nullptr) {
+      while (current + 1 < result.size() &&
+             key.compare(result[current + 1].low) >= 0) {
+        ++current;
+      }
+    } else if (total > 0 && total % rangeSize == 0) {
+      result.emplace_back(Range{key.toString(), 0, 0});
+      ++current;
+    }
+
+    result[current].hash ^= hashDocument(key, rid);
+    ++result[current].count;
+    ++total;
+  }
+
+  return rocksutils::convertStatus(it->status());
+}
@@ -0,0 +1,179 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_ROCKSDB_ROCKSDB_REVISION_TREE_H
+#define ARANGOD_ROCKSDB_ROCKSDB_REVISION_TREE_H 1
+
+#include "Basics/Common.h"
+#include "Basics/ConditionVariable.h"
+#include "Basics/Mutex.h"
+#include "Basics/Result.h"
+#include "Basics/StringRef.h"
+#include "VocBase/voc-types.h"
+
+#include <rocksdb/types.h>
+
+namespace rocksdb {
+class DB;
+class Snapshot;
+}  // namespace rocksdb
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+class Slice;
+}  // namespace velocypack
+
+/// @brief hashes over the document keys and revisions of a collection, for
+/// consecutive ranges of keys. the hash of a range is the XOR of the hashes
+/// of its documents, so it is updated incrementally with every committed
+/// operation, and two collections with the same range boundaries only need
+/// to compare the documents of the ranges whose hashes differ.
+/// the tree is built from a snapshot of the primary index when it is first
+/// needed, and afterwards kept up to date by the commits of the collection.
+/// operations are only tracked once the tree was requested. a transaction
+/// with operations from before that invalidates the tree when it commits,
+/// and the tree is built again when needed
+class RocksDBRevisionTree {
+ public:
+  /// @brief a range of keys, starting at low (inclusive) and ending at the
+  /// low of the next range (exclusive). the low of the first range is empty
+  struct Range {
+    std::string low;
+    uint64_t hash;
+    uint64_t count;
+  };
+
+  /// @brief a document inserted or removed by a transaction
+  struct Operation {
+    Operation(StringRef key, TRI_voc_rid_t rid, bool insert)
+        : key(key.toString()), hash(hashDocument(key, rid)), insert(insert) {}
+
+    std::string key;
+    uint64_t hash;
+    bool insert;
+  };
+
+  RocksDBRevisionTree(RocksDBRevisionTree const&) = delete;
+  RocksDBRevisionTree& operator=(RocksDBRevisionTree const&) = delete;
+
+  RocksDBRevisionTree();
+
+  /// @brief the hash of a single document, which is the same as the one
+  /// used for the key chunks of the incremental sync
+  static uint64_t hashDocument(StringRef key, TRI_voc_rid_t rid);
+
+  /// @brief whether or not operations need to be tracked
+  bool isTracking() const { return _state.load() != State::NONE; }
+
+  /// @brief whether or not the tree reflects the collection
+  bool isValid() const { return _state.load() == State::VALID; }
+
+  /// @brief the seq the persisted tree was written at
+  rocksdb::SequenceNumber commitSeq() const;
+
+  /// @brief announce the commit of a transaction with operations for the
+  /// collection. waits while a build takes its snapshot
+  void placeBlocker(uint64_t trxId, rocksdb::SequenceNumber seq);
+
+  /// @brief the transaction did not commit
+  void removeBlocker(uint64_t trxId);
+
+  /// @brief apply the operations of a committed transaction and remove its
+  /// blocker. complete is false if the transaction had operations from
+  /// before the tree was requested
+  void commit(uint64_t trxId, std::vector<Operation>&& operations,
+              bool complete);
+
+  /// @brief the collection was truncated
+  void truncate();
+
+  /// @brief drop the contents of the tree, it is built again when needed
+  void invalidate();
+
+  /// @brief make sure the tree is valid, and build it from a snapshot of
+  /// the primary index if not. if lows is given, the tree must use these
+  /// range boundaries, otherwise every range of a new tree gets rangeSize
+  /// documents. a leader tree is also rebuilt when a range outgrew
+  /// maxRangeFactor times the rangeSize
+  Result ensureValid(rocksdb::DB* db, uint64_t objectId, uint64_t indexId,
+                     size_t rangeSize, std::vector<std::string> const* lows);
+
+  /// @brief return a copy of the ranges of a valid tree
+  bool ranges(std::vector<Range>& result) const;
+
+  /// @brief serialize the tree if it changed since it was last written. the
+  /// persisted tree must not be used if the WAL has document operations
+  /// for the collection after the returned seq. empty output with a true
+  /// result means the persisted tree has to be removed
+  bool serialize(std::string& output, rocksdb::SequenceNumber baseSeq,
+                 rocksdb::SequenceNumber& seq);
+
+  /// @brief restore a persisted tree
+  void deserialize(rocksdb::SequenceNumber seq, velocypack::Slice data);
+
+  /// @brief ranges are rebuilt once their size exceeds this factor
+  static constexpr size_t maxRangeFactor = 16;
+
+ private:
+  enum class State : uint8_t {
+    /// @brief nobody asked for the tree yet, nothing is tracked
+    NONE,
+    /// @brief operations are tracked, but the tree is not built
+    TRACKING,
+    /// @brief the tree is built from a snapshot
+    BUILDING,
+    /// @brief the tree reflects all committed operations
+    VALID
+  };
+
+  /// @brief index of the range the key belongs to
+  size_t findRange(std::string const& key) const;
+
+  /// @brief apply operations to the ranges
+  void apply(std::vector<Operation> const& operations);
+
+  /// @brief read the ranges of the snapshot
+  Result build(rocksdb::DB* db, rocksdb::Snapshot const* snapshot,
+               uint64_t objectId, uint64_t indexId, size_t rangeSize,
+               std::vector<std::string> const* lows,
+               std::vector<Range>& result) const;
+
+ private:
+  /// @brief only one build at a time
+  Mutex _buildLock;
+  /// @brief protects all of the following, and signals finished commits
+  mutable basics::ConditionVariable _condition;
+  std::atomic<State> _state;
+  std::vector<Range> _ranges;
+  /// @brief commits between placeBlocker and commit or removeBlocker
+  std::unordered_map<uint64_t, rocksdb::SequenceNumber> _blockers;
+  /// @brief operations committed while a build reads its snapshot
+  std::vector<std::vector<Operation>> _pending;
+  rocksdb::SequenceNumber _commitSeq;
+  /// @brief a build is about to take its snapshot
+  bool _snapshotPending;
+  /// @brief the tree changed since it was last serialized
+  bool _dirty;
+};
+
+}  // namespace arangodb
+
+#endif
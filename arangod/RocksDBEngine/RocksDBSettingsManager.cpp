@@ -135,11 +135,15 @@ arangodb::Result writeSettings(rocksdb::Transaction* rtrx, VPackBuilder& b,
 }  // namespace
 
 namespace {
+/// @brief collections whose counter did not change are only visited by
+/// every numSyncShards-th sync, one shard of them at a time
+constexpr uint64_t numSyncShards = 16;
+
 std::pair<arangodb::Result, rocksdb::SequenceNumber>
 writeIndexEstimatorsAndKeyGenerator(
     rocksdb::Transaction* rtrx,
     std::pair<uint64_t, arangodb::RocksDBSettingsManager::CMValue> const& pair,
-    rocksdb::SequenceNumber baseSeq) {
+    rocksdb::SequenceNumber baseSeq, bool writeKeyGenerator) {
   using arangodb::DatabaseFeature;
   using arangodb::Logger;
   using arangodb::Result;
@@ -187,6 +191,19 @@ writeIndexEstimatorsAndKeyGenerator(
   }
   returnSeq = std::min(returnSeq, serializeResult.second);
 
+  serializeResult = rocksCollection->serializeRevisionTree(rtrx, baseSeq);
+  if (!serializeResult.first.ok()) {
+    LOG_TOPIC(WARN, Logger::ENGINES) << "writing revision tree failed: "
+                                     << serializeResult.first.errorMessage();
+    return std::make_pair(serializeResult.first, returnSeq);
+  }
+  returnSeq = std::min(returnSeq, serializeResult.second);
+
+  if (!writeKeyGenerator) {
+    // no documents were inserted since the last sync
+    return std::make_pair(Result(), returnSeq);
+  }
+
   Result res = rocksCollection->serializeKeyGenerator(rtrx);
   if (!res.ok()) {
     LOG_TOPIC(WARN, Logger::ENGINES)
@@ -227,7 +244,12 @@ void RocksDBSettingsManager::CMValue::serialize(VPackBuilder& b) const {
 /// Constructor needs to be called synchrunously,
 /// will load counts from the db and scan the WAL
 RocksDBSettingsManager::RocksDBSettingsManager(rocksdb::TransactionDB* db)
-    : _lastSync(0), _syncing(false), _db(db), _initialReleasedTick(0) {}
+    : _lastSync(0),
+      _previousSyncSeq(0),
+      _syncRound(0),
+      _syncing(false),
+      _db(db),
+      _initialReleasedTick(0) {}
 
 /// retrieve initial values from the database
 void RocksDBSettingsManager::retrieveInitialValues() {
@@ -318,6 +340,11 @@ void RocksDBSettingsManager::removeCounter(uint64_t objectId) {
   }
 }
 
+void RocksDBSettingsManager::markDirty(uint64_t objectId) {
+  WRITE_LOCKER(guard, _rwLock);
+  _dirtyObjects.emplace(objectId);
+}
+
 std::unordered_map<uint64_t, rocksdb::SequenceNumber>
 RocksDBSettingsManager::counterSeqs() {
   std::unordered_map<uint64_t, rocksdb::SequenceNumber> seqs;
@@ -363,35 +390,77 @@ Result RocksDBSettingsManager::sync(bool force) {
   }
   TRI_DEFER(_syncing = false);
 
+  uint64_t const shard = _syncRound++ % numSyncShards;
+
+  // only the collections whose counter changed since the last sync, the ones
+  // marked dirty and one shard of the others are written
   std::unordered_map<uint64_t, CMValue> copy;
+  std::unordered_set<uint64_t> dirty;
+  bool skipped = false;
   {  // block all updates
     WRITE_LOCKER(guard, _rwLock);
-    copy = _counters;
+    dirty.swap(_dirtyObjects);
+    for (auto const& it : _counters) {
+      auto synced = _syncedSeqNums.find(it.first);
+      if ((synced != _syncedSeqNums.end() &&
+           synced->second == it.second._sequenceNum) &&
+          (it.first % numSyncShards) != shard &&
+          dirty.find(it.first) == dirty.end()) {
+        skipped = true;
+        continue;
+      }
+      copy.emplace(it);
+    }
   }
 
+  // if the sync fails, the dirty collections have to be written next time
+  std::unordered_set<uint64_t> pending;
+  auto pendingGuard = scopeGuard([this, &dirty, &pending]() {
+    WRITE_LOCKER(guard, _rwLock);
+    _dirtyObjects.insert(dirty.begin(), dirty.end());
+    _dirtyObjects.insert(pending.begin(), pending.end());
+  });
+
   rocksdb::WriteOptions writeOptions;
   // fetch the seq number prior to any writes; this guarantees that we save
   // any subsequent updates in the WAL to replay if we crash in the middle
   auto seqNumber = _db->GetLatestSequenceNumber();
+  auto const latestSeq = seqNumber;
   std::unique_ptr<rocksdb::Transaction> rtrx(
       _db->BeginTransaction(writeOptions));
 
   VPackBuilder b;
   for (std::pair<uint64_t, CMValue> const& pair : copy) {
+    auto synced = _syncedSeqNums.find(pair.first);
+    bool changed = (synced == _syncedSeqNums.end() ||
+                    synced->second != pair.second._sequenceNum);
+
     Result res = writeCounterValue(_syncedSeqNums, rtrx.get(), b, pair);
     if (res.fail()) {
       return res;
     }
 
-    auto writeResult =
-        writeIndexEstimatorsAndKeyGenerator(rtrx.get(), pair, seqNumber);
+    auto writeResult = writeIndexEstimatorsAndKeyGenerator(
+        rtrx.get(), pair, seqNumber, changed);
     if (writeResult.first.fail()) {
       return writeResult.first;
     }
+    if (writeResult.second < latestSeq) {
+      // a commit still blocks the estimates, retry with the next sync
+      pending.emplace(pair.first);
+    }
     seqNumber = std::min(seqNumber, writeResult.second);
   }
 
-  Result res = writeSettings(rtrx.get(), b, seqNumber);
+  // a commit to a skipped collection may have been written to the WAL
+  // without having updated the counter yet. such commits are covered by
+  // the previous sync's seq number, as they take far less than an interval
+  auto lastSync = seqNumber;
+  if (skipped) {
+    lastSync = std::min(lastSync, _previousSyncSeq);
+  }
+
+  Result res = writeSettings(rtrx.get(), b, lastSync);
   if (res.fail()) {
     return res;
   }
@@ -401,11 +470,13 @@ Result RocksDBSettingsManager::sync(bool force) {
   if (s.ok()) {
     {
       WRITE_LOCKER(guard, _rwLock);
-      _lastSync = seqNumber;
+      _lastSync = lastSync;
     }
     for (std::pair<uint64_t, CMValue> const& pair : copy) {
       _syncedSeqNums[pair.first] = pair.second._sequenceNum;
     }
+    _previousSyncSeq = latestSeq;
+    dirty.clear();
   }
 
   return rocksutils::convertStatus(s);
@@ -454,6 +525,7 @@ void RocksDBSettingsManager::loadSettings() {
         if (slice.hasKey("lastSync")) {
           _lastSync =
               basics::VelocyPackHelper::stringUInt64(slice.get("lastSync"));
+          _previousSyncSeq = _lastSync;
           LOG_TOPIC(TRACE, Logger::ENGINES)
               << "last background settings sync: " << _lastSync;
         }
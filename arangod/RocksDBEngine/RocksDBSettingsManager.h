@@ -109,7 +109,13 @@ class RocksDBSettingsManager {
   /// Return copy of full list of counters
   std::unordered_map<uint64_t, rocksdb::SequenceNumber> counterSeqs();
 
-  /// Thread-Safe force sync
+  /// Make the next sync write the counter, index estimates and key generator
+  /// of a collection, even if its counter did not change. Thread-Safe
+  void markDirty(uint64_t objectId);
+
+  /// Thread-Safe force sync. Only collections whose counter changed since the
+  /// last sync and the ones marked dirty are written, plus a rotating shard
+  /// of the others
   Result sync(bool force);
 
   // Steal the index estimator that the recovery has built up to inject it into
@@ -179,6 +185,21 @@ class RocksDBSettingsManager {
   //////////////////////////////////////////////////////////////////////////////
   rocksdb::SequenceNumber _lastSync;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief sequence number the previous sync started at
+  //////////////////////////////////////////////////////////////////////////////
+  rocksdb::SequenceNumber _previousSyncSeq;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief collections to write with the next sync
+  //////////////////////////////////////////////////////////////////////////////
+  std::unordered_set<uint64_t> _dirtyObjects;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of syncs, selects the shard of unchanged collections
+  //////////////////////////////////////////////////////////////////////////////
+  uint64_t _syncRound;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief currently syncing
   //////////////////////////////////////////////////////////////////////////////
@@ -190,7 +211,7 @@ class RocksDBSettingsManager {
   rocksdb::TransactionDB* _db;
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief protect _syncing and _counters
+  /// @brief protect _syncing, _counters and _dirtyObjects
   //////////////////////////////////////////////////////////////////////////////
   mutable basics::ReadWriteLock _rwLock;
 
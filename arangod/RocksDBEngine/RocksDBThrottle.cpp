@@ -93,10 +93,29 @@ thread_local uint8_t gFlushStart[sizeof(std::chrono::steady_clock::time_point)];
 // Setup the object, clearing variables, but do no real work
 //
 RocksDBThrottle::RocksDBThrottle()
+  : RocksDBThrottle(std::chrono::microseconds(0), 0)
+{
+}
+
+
+//
+// Setup the object in adaptive mode
+//
+RocksDBThrottle::RocksDBThrottle(std::chrono::microseconds TargetLatency,
+                                 uint64_t PendingCompactionBudget)
   : _internalRocksDB(nullptr), _threadRunning(false), _replaceIdx(2),
-    _throttleBps(0), _firstThrottle(true)
+    _throttleBps(0), _firstThrottle(true), _targetLatency(TargetLatency),
+    _pendingCompactionBudget(PendingCompactionBudget), _latencySlot(0),
+    _adaptiveFactor(1.0), _latencyP99(0), _pendingCompactionBytes(0),
+    _adaptiveReason("none")
 {
   memset(&_throttleData, 0, sizeof(_throttleData));
+
+  for (auto & slot : _latencies) {
+    for (auto & bucket : slot) {
+      bucket.store(0, std::memory_order_relaxed);
+    } // for
+  } // for
 }
 
 
@@ -234,6 +253,8 @@ void RocksDBThrottle::SetThrottleWriteRate(std::chrono::microseconds Micros,
 
 
 void RocksDBThrottle::ThreadLoop() {
+  bool const adaptive = (0 != _targetLatency.count());
+  unsigned tick = 0;
 
   _replaceIdx=2;
 
@@ -251,24 +272,38 @@ void RocksDBThrottle::ThreadLoop() {
   while(_threadRunning.load()) {
     //
     // start actual throttle work
+    //  (adaptive mode wakes up every second, but still recalculates the
+    //   base throttle only once per THROTTLE_SECONDS)
     //
     try {
-      RecalculateThrottle();
+      if (adaptive) {
+        AdjustAdaptive();
+      } // if
+
+      if (0 == tick) {
+        RecalculateThrottle();
+
+        ++_replaceIdx;
+        if (THROTTLE_INTERVALS==_replaceIdx)
+          _replaceIdx=2;
+      } // if
     } catch (...) {
       LOG_TOPIC(ERR, arangodb::Logger::FIXME) << "RecalculateThrottle() sent a throw. RocksDB?";
       _threadRunning.store(false);
     } // try/catchxs
 
-    ++_replaceIdx;
-    if (THROTTLE_INTERVALS==_replaceIdx)
-      _replaceIdx=2;
+    if (adaptive) {
+      ++tick;
+      if (THROTTLE_SECONDS==tick)
+        tick=0;
+    } // if
 
     // wait on _threadCondvar
     {
       CONDITION_LOCKER(guard, _threadCondvar);
 
       if (_threadRunning.load()) { // test in case of race at shutdown
-        _threadCondvar.wait(THROTTLE_SECONDS * 1000000);
+        _threadCondvar.wait((adaptive ? 1 : THROTTLE_SECONDS) * 1000000);
       } //if
     } // lock
   } // while
@@ -399,11 +434,165 @@ void RocksDBThrottle::RecalculateThrottle() {
 } // RocksDBThrottle::RecalculateThrottle
 
 
+//
+// Adaptive mode: steer the factor applied to the computed throttle.
+//  The factor shrinks quickly when compactions fall behind, because that
+//  is what leads to the long L0 stalls.  It grows when the commit latency
+//  is above target while compactions keep up, because then the throttle
+//  itself is the cause of the latency.  Otherwise it drifts back to 1.
+//
+void RocksDBThrottle::AdjustAdaptive() {
+  uint64_t p99, pending;
+  int64_t backlog;
+
+  p99 = ComputeLatencyPercentile(99);
+  pending = ComputePendingCompactionBytes();
+  backlog = (nullptr != _internalRocksDB) ? ComputeBacklog() : 0;
+
+  MUTEX_LOCKER(mutexLocker, _threadMutex);
+
+  _latencyP99 = p99;
+  _pendingCompactionBytes = pending;
+
+  if (0 != _pendingCompactionBudget && _pendingCompactionBudget < pending) {
+    _adaptiveFactor *= 0.75;
+    _adaptiveReason = "pending-compaction-bytes";
+  } else if (0 < backlog) {
+    _adaptiveFactor *= 0.75;
+    _adaptiveReason = "level0-backlog";
+  } else if (static_cast<uint64_t>(_targetLatency.count()) < p99) {
+    _adaptiveFactor *= 1.25;
+    _adaptiveReason = "commit-latency";
+  } else {
+    if (_adaptiveFactor < 1.0) {
+      _adaptiveFactor = (std::min)(1.0, _adaptiveFactor + 0.05);
+    } else {
+      _adaptiveFactor = (std::max)(1.0, _adaptiveFactor - 0.05);
+    } // else
+    _adaptiveReason = "none";
+  } // else
+
+  _adaptiveFactor = (std::max)(kAdaptiveMinFactor,
+                               (std::min)(kAdaptiveMaxFactor, _adaptiveFactor));
+
+  LOG_TOPIC(DEBUG, arangodb::Logger::ENGINES)
+    << "AdjustAdaptive(): p99 " << p99 << ", pending " << pending
+    << ", backlog " << backlog << ", factor " << _adaptiveFactor
+    << ", reason " << _adaptiveReason;
+
+  // the new factor takes effect with the next flush or compaction,
+  //  see the comment at the end of RecalculateThrottle()
+} // RocksDBThrottle::AdjustAdaptive
+
+
+//
+// Adaptive mode: percentile of the commit latencies of the last
+//  LATENCY_SLOTS seconds, as the upper bound of the histogram bucket in
+//  microseconds.  Also starts a new one second slot.
+//
+uint64_t RocksDBThrottle::ComputeLatencyPercentile(unsigned Percentile) {
+  uint64_t counts[LATENCY_BUCKETS] = {0};
+  uint64_t total = 0, seen = 0, wanted;
+  unsigned next;
+
+  for (auto & slot : _latencies) {
+    for (unsigned i = 0; i < LATENCY_BUCKETS; ++i) {
+      uint64_t count = slot[i].load(std::memory_order_relaxed);
+      counts[i] += count;
+      total += count;
+    } // for
+  } // for
+
+  // the oldest slot becomes the current one
+  next = (_latencySlot.load(std::memory_order_relaxed) + 1) % LATENCY_SLOTS;
+  for (auto & bucket : _latencies[next]) {
+    bucket.store(0, std::memory_order_relaxed);
+  } // for
+  _latencySlot.store(next, std::memory_order_relaxed);
+
+  if (0 == total) {
+    return 0;
+  } // if
+
+  wanted = (total * Percentile + 99) / 100;
+  for (unsigned i = 0; i < LATENCY_BUCKETS; ++i) {
+    seen += counts[i];
+    if (wanted <= seen) {
+      return uint64_t(1) << (i + 1);
+    } // if
+  } // for
+
+  return uint64_t(1) << LATENCY_BUCKETS;
+} // RocksDBThrottle::ComputeLatencyPercentile
+
+
+//
+// Adaptive mode: sum of the estimated pending compaction bytes of all
+//  column families
+//
+uint64_t RocksDBThrottle::ComputePendingCompactionBytes() {
+  uint64_t total = 0, value;
+
+  // _internalRocksDB is only set once the thread runs
+  if (nullptr == _internalRocksDB) {
+    return 0;
+  } // if
+
+  for (auto & cf : _families) {
+    if (_internalRocksDB->GetIntProperty(cf, rocksdb::DB::Properties::kEstimatePendingCompactionBytes,
+                                         &value)) {
+      total += value;
+    } // if
+  } // for
+
+  return total;
+} // RocksDBThrottle::ComputePendingCompactionBytes
+
+
+void RocksDBThrottle::RecordCommitLatency(std::chrono::microseconds Micros) {
+  uint64_t micros;
+  unsigned bucket;
+
+  micros = static_cast<uint64_t>(Micros.count());
+  bucket = 0;
+  while (1 < micros && bucket + 1 < LATENCY_BUCKETS) {
+    micros >>= 1;
+    ++bucket;
+  } // while
+
+  _latencies[_latencySlot.load(std::memory_order_relaxed)][bucket].fetch_add(1, std::memory_order_relaxed);
+} // RocksDBThrottle::RecordCommitLatency
+
+
+void RocksDBThrottle::GetStatistics(arangodb::velocypack::Builder& Builder) {
+  MUTEX_LOCKER(mutexLocker, _threadMutex);
+  bool const adaptive = (0 != _targetLatency.count());
+
+  Builder.add("throttle.adaptive", arangodb::velocypack::Value(adaptive));
+  Builder.add("throttle.base-rate", arangodb::velocypack::Value(_throttleBps));
+  Builder.add("throttle.rate", arangodb::velocypack::Value(
+                adaptive ? static_cast<uint64_t>(_throttleBps * _adaptiveFactor) : _throttleBps));
+  if (adaptive) {
+    Builder.add("throttle.factor", arangodb::velocypack::Value(_adaptiveFactor));
+    Builder.add("throttle.reason", arangodb::velocypack::Value(_adaptiveReason));
+    Builder.add("throttle.commit-latency-p99", arangodb::velocypack::Value(_latencyP99));
+    Builder.add("throttle.pending-compaction-bytes", arangodb::velocypack::Value(_pendingCompactionBytes));
+  } // if
+} // RocksDBThrottle::GetStatistics
+
+
 ///
 /// @brief Hack a throttle rate into the WriteController object
 ///
 void RocksDBThrottle::SetThrottle() {
   // called by routine with _threadMutex held
+  uint64_t rate;
+
+  // adaptive mode scales the computed throttle
+  rate = _throttleBps;
+  if (0 != _targetLatency.count()) {
+    rate = static_cast<uint64_t>(rate * _adaptiveFactor);
+  } // if
 
   // using condition variable's mutex to protect _internalRocksDB race
   {
@@ -413,13 +602,13 @@ void RocksDBThrottle::SetThrottle() {
     if (nullptr != _internalRocksDB) {
       // inform write_controller_ of our new rate
       //  (column_family.cc RecalculateWriteStallConditions() makes assumptions
-      //   that could force a divide by zero if _throttleBps is less than four ... using 100 for safety)
-      if (100<_throttleBps) {
+      //   that could force a divide by zero if rate is less than four ... using 100 for safety)
+      if (100<rate) {
         // hard casting away of "const" ...
-        if (((WriteController&)_internalRocksDB->write_controller()).max_delayed_write_rate() < _throttleBps) {
-          ((WriteController&)_internalRocksDB->write_controller()).set_max_delayed_write_rate(_throttleBps);
+        if (((WriteController&)_internalRocksDB->write_controller()).max_delayed_write_rate() < rate) {
+          ((WriteController&)_internalRocksDB->write_controller()).set_max_delayed_write_rate(rate);
         } //if
-        _delayToken=(((WriteController&)_internalRocksDB->write_controller()).GetDelayToken(_throttleBps));
+        _delayToken=(((WriteController&)_internalRocksDB->write_controller()).GetDelayToken(rate));
       } else {
         _delayToken.reset();
       } // else
@@ -43,6 +43,8 @@
 #include "Basics/ConditionVariable.h"
 #include "Basics/Mutex.h"
 
+#include <velocypack/Builder.h>
+
 // public rocksdb headers
 #include <rocksdb/db.h>
 #include <rocksdb/listener.h>
@@ -70,6 +72,15 @@ namespace arangodb {
 class RocksDBThrottle : public rocksdb::EventListener {
 public:
   RocksDBThrottle();
+
+  /// @brief create a throttle in adaptive mode. in addition to the
+  ///  throttle computed from flush and compaction timings, the write rate
+  ///  is adjusted every second so that the 99th percentile of the commit
+  ///  latency stays below the target, and the pending compaction bytes
+  ///  stay below the budget (0 = no budget)
+  RocksDBThrottle(std::chrono::microseconds TargetLatency,
+                  uint64_t PendingCompactionBudget);
+
   virtual ~RocksDBThrottle();
 
   void OnFlushBegin(rocksdb::DB* db,
@@ -91,6 +102,13 @@ public:
 
   void StopThread();
 
+  /// @brief record the latency of a transaction commit. this is called
+  ///  for every commit, so it only increments a counter
+  void RecordCommitLatency(std::chrono::microseconds Micros);
+
+  /// @brief add the current throttle state to an open object
+  void GetStatistics(arangodb::velocypack::Builder& Builder);
+
 protected:
   void Startup(rocksdb::DB * db);
 
@@ -106,6 +124,12 @@ protected:
 
   void RecalculateThrottle();
 
+  void AdjustAdaptive();
+
+  uint64_t ComputeLatencyPercentile(unsigned Percentile);
+
+  uint64_t ComputePendingCompactionBytes();
+
 
   // I am unable to figure out static initialization of std::chrono::seconds,
   //  using old school unsigned.
@@ -122,6 +146,16 @@ protected:
   //  (from original Google leveldb db/dbformat.h)
   static constexpr int64_t kL0_SlowdownWritesTrigger = 8;
 
+  // adaptive mode: commit latencies are kept in one histogram per second
+  //  for the last LATENCY_SLOTS seconds. bucket i of a histogram counts the
+  //  latencies between 2^i and 2^(i+1) microseconds
+  static constexpr unsigned LATENCY_SLOTS = 10;
+  static constexpr unsigned LATENCY_BUCKETS = 32;
+
+  // adaptive mode: bounds of the factor applied to the computed throttle
+  static constexpr double kAdaptiveMinFactor = 0.0625;
+  static constexpr double kAdaptiveMaxFactor = 4.0;
+
   struct ThrottleData_t
   {
     std::chrono::microseconds _micros;
@@ -149,6 +183,19 @@ protected:
   uint64_t _throttleBps;
   bool _firstThrottle;
 
+  // adaptive mode settings, a zero target latency turns the mode off
+  std::chrono::microseconds const _targetLatency;
+  uint64_t const _pendingCompactionBudget;
+
+  // adaptive mode state. the factor is applied to _throttleBps, the
+  //  reason tells why it was last changed
+  std::atomic<uint64_t> _latencies[LATENCY_SLOTS][LATENCY_BUCKETS];
+  std::atomic<unsigned> _latencySlot;
+  double _adaptiveFactor;
+  uint64_t _latencyP99;
+  uint64_t _pendingCompactionBytes;
+  char const* _adaptiveReason;
+
   std::unique_ptr<WriteControllerToken> _delayToken;
   std::vector<rocksdb::ColumnFamilyHandle *> _families;
 
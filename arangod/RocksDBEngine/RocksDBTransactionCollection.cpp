@@ -28,6 +28,7 @@
 #include "RocksDBEngine/RocksDBIndex.h"
 #include "RocksDBEngine/RocksDBSettingsManager.h"
 #include "StorageEngine/TransactionState.h"
+#include "Transaction/Helpers.h"
 #include "Transaction/Hints.h"
 #include "Transaction/Methods.h"
 #include "VocBase/LogicalCollection.h"
@@ -45,7 +46,9 @@ RocksDBTransactionCollection::RocksDBTransactionCollection(
       _numInserts(0),
       _numUpdates(0),
       _numRemoves(0),
-      _usageLocked(false) {}
+      _usageLocked(false),
+      _untrackedRevisionOperations(false),
+      _revisionBlocker(false) {}
 
 RocksDBTransactionCollection::~RocksDBTransactionCollection() {}
 
@@ -297,6 +300,16 @@ void RocksDBTransactionCollection::prepareCommit(uint64_t trxId,
       estimator->placeBlocker(trxId, preCommitSeq);
     }
   }
+
+  if (!_trackedRevisionOperations.empty() || _untrackedRevisionOperations) {
+    RocksDBRevisionTree* tree =
+        static_cast<RocksDBCollection*>(_collection->getPhysical())
+            ->revisionTree();
+    if (tree->isTracking()) {
+      tree->placeBlocker(trxId, preCommitSeq);
+      _revisionBlocker = true;
+    }
+  }
 }
 
 void RocksDBTransactionCollection::abortCommit(uint64_t trxId) {
@@ -313,6 +326,13 @@ void RocksDBTransactionCollection::abortCommit(uint64_t trxId) {
       estimator->removeBlocker(trxId);
     }
   }
+
+  if (_revisionBlocker) {
+    static_cast<RocksDBCollection*>(_collection->getPhysical())
+        ->revisionTree()
+        ->removeBlocker(trxId);
+    _revisionBlocker = false;
+  }
 }
 
 void RocksDBTransactionCollection::commitCounts(uint64_t trxId,
@@ -350,11 +370,22 @@ void RocksDBTransactionCollection::commitCounts(uint64_t trxId,
     }
   }
 
+  // Update the revision tree
+  if (!_trackedRevisionOperations.empty() || _untrackedRevisionOperations) {
+    static_cast<RocksDBCollection*>(_collection->getPhysical())
+        ->revisionTree()
+        ->commit(trxId, std::move(_trackedRevisionOperations),
+                 !_untrackedRevisionOperations);
+  }
+
   _initialNumberDocuments += adjustment;
   _numInserts = 0;
   _numUpdates = 0;
   _numRemoves = 0;
   _trackedIndexOperations.clear();
+  _trackedRevisionOperations.clear();
+  _untrackedRevisionOperations = false;
+  _revisionBlocker = false;
 }
 
 void RocksDBTransactionCollection::trackIndexInsert(uint64_t idxObjectId,
@@ -369,6 +400,31 @@ void RocksDBTransactionCollection::trackIndexRemove(uint64_t idxObjectId,
   _trackedIndexOperations[idxObjectId].second.emplace_back(hash);
 }
 
+void RocksDBTransactionCollection::trackRevisionInsert(VPackSlice const& doc) {
+  trackRevisionOperation(doc, true);
+}
+
+void RocksDBTransactionCollection::trackRevisionRemove(VPackSlice const& doc) {
+  trackRevisionOperation(doc, false);
+}
+
+void RocksDBTransactionCollection::trackRevisionOperation(
+    VPackSlice const& doc, bool insert) {
+  TRI_ASSERT(_collection != nullptr);
+  RocksDBRevisionTree* tree =
+      static_cast<RocksDBCollection*>(_collection->getPhysical())
+          ->revisionTree();
+  if (!tree->isTracking()) {
+    // nobody uses the tree. if it is requested before the commit, the
+    // operations of this trx are missing from it
+    _untrackedRevisionOperations = true;
+    return;
+  }
+  _trackedRevisionOperations.emplace_back(
+      StringRef(transaction::helpers::extractKeyFromDocument(doc)),
+      transaction::helpers::extractRevFromDocument(doc), insert);
+}
+
 /// @brief lock a collection
 /// returns TRI_ERROR_LOCKED in case the lock was successfully acquired
 /// returns TRI_ERROR_NO_ERROR in case the lock does not need to be acquired and no other error occurred
@@ -25,6 +25,7 @@
 #define ARANGOD_ROCKSDB_ROCKSDB_TRANSACTION_COLLECTION_H 1
 
 #include "Basics/Common.h"
+#include "RocksDBEngine/RocksDBRevisionTree.h"
 #include "StorageEngine/TransactionCollection.h"
 #include "VocBase/AccessMode.h"
 #include "VocBase/voc-types.h"
@@ -65,6 +66,12 @@ class RocksDBTransactionCollection final : public TransactionCollection {
   /// @brief check whether a collection is locked at all
   bool isLocked() const override;
 
+  /// @brief whether or not the transaction itself holds the exclusive lock
+  /// of the collection, so that no other transaction can write into it
+  bool isLockedExclusively() const {
+    return _lockType == AccessMode::Type::EXCLUSIVE;
+  }
+
   /// @brief whether or not any write operations for the collection happened
   bool hasOperations() const override;
 
@@ -117,6 +124,14 @@ class RocksDBTransactionCollection final : public TransactionCollection {
   ///        Used to update the estimate after the trx commited
   void trackIndexRemove(uint64_t idxObjectId, uint64_t hash);
 
+  /// @brief track a document inserted into the collection, used to update
+  ///        the revision tree after the trx commited
+  void trackRevisionInsert(velocypack::Slice const& doc);
+
+  /// @brief track a document removed from the collection, used to update
+  ///        the revision tree after the trx commited
+  void trackRevisionRemove(velocypack::Slice const& doc);
+
  private:
   /// @brief request a lock for a collection
   /// returns TRI_ERROR_LOCKED in case the lock was successfully acquired
@@ -127,6 +142,9 @@ class RocksDBTransactionCollection final : public TransactionCollection {
   /// @brief request an unlock for a collection
   int doUnlock(AccessMode::Type, int nestingLevel);
 
+  /// @brief track a document operation for the revision tree
+  void trackRevisionOperation(velocypack::Slice const& doc, bool insert);
+
  private:
   AccessMode::Type _lockType;  // collection lock type, used for exclusive locks
   int _nestingLevel;  // the transaction level that added this collection
@@ -143,6 +161,14 @@ class RocksDBTransactionCollection final : public TransactionCollection {
                      std::pair<std::vector<uint64_t>, std::vector<uint64_t>>>
       _trackedIndexOperations;
 
+  /// @brief the document operations for the revision tree, only tracked
+  ///        while the tree is in use
+  std::vector<RocksDBRevisionTree::Operation> _trackedRevisionOperations;
+  /// @brief operations happened before the revision tree was in use
+  bool _untrackedRevisionOperations;
+  /// @brief the commit placed a blocker in the revision tree
+  bool _revisionBlocker;
+
 };
 }
 
@@ -71,7 +71,8 @@ RocksDBTransactionState::RocksDBTransactionState(
       _numUpdates(0),
       _numRemoves(0),
       _keys{_arena},
-      _parallel(false) {}
+      _parallel(false),
+      _untrackedWrites(false) {}
 
 /// @brief free a transaction container
 RocksDBTransactionState::~RocksDBTransactionState() {
@@ -153,12 +154,12 @@ Result RocksDBTransactionState::beginTransaction(transaction::Hints hints) {
       }
       TRI_ASSERT(_rocksReadOptions.snapshot != nullptr);
 
-      // under some circumstances we can use untracking Put/Delete methods,
-      // but we need to be sure this does not cause any lost updates or other
-      // inconsistencies.
-      // TODO: enable this optimization once these circumstances are clear
-      // and fully covered by tests
-      if (false && isExclusiveTransactionOnSingleCollection()) {
+      // if no other transaction can write into the collections we write
+      // into, the keys do not need to be locked and tracked for conflicts.
+      // the write set then only lives in the write batch of the rocksdb
+      // transaction, which is flushed by the intermediate commits
+      if (hasOnlyExclusiveWrites()) {
+        _untrackedWrites = true;
         _rocksMethods.reset(new RocksDBTrxUntrackedMethods(this));
       } else {
         _rocksMethods.reset(new RocksDBTrxMethods(this));
@@ -288,7 +289,10 @@ arangodb::Result RocksDBTransactionState::internalCommit() {
     });
 
     ++_numCommits;
+    double const commitStart = TRI_microtime();
     result = rocksutils::convertStatus(_rocksTransaction->Commit());
+    rocksutils::globalRocksEngine()->recordCommitLatency(TRI_microtime() -
+                                                        commitStart);
     rocksdb::SequenceNumber latestSeq =
         rocksutils::globalRocksDB()->GetLatestSequenceNumber();
 
@@ -418,6 +422,15 @@ void RocksDBTransactionState::prepareOperation(TRI_voc_cid_t cid, TRI_voc_rid_t
         break;
     }
   } else {
+    if (_untrackedWrites) {
+      auto coll =
+          static_cast<RocksDBTransactionCollection*>(findCollection(cid));
+      if (coll == nullptr || !coll->isLockedExclusively()) {
+        // collection was added at runtime without an exclusive lock. all
+        // further writes must be tracked
+        _untrackedWrites = false;
+      }
+    }
     if (operationType == TRI_VOC_DOCUMENT_OPERATION_REMOVE) {
       RocksDBLogValue logValue = RocksDBLogValue::DocumentRemoveV2(rid);
       _rocksTransaction->PutLogData(logValue.slice());
@@ -547,6 +560,23 @@ Result RocksDBTransactionState::triggerIntermediateCommit() {
   return TRI_ERROR_NO_ERROR;
 }
 
+/// @brief whether or not the transaction writes only into collections it
+/// has locked exclusively itself
+bool RocksDBTransactionState::hasOnlyExclusiveWrites() const {
+  bool found = false;
+  for (auto const& trxCollection : _collections) {
+    if (!AccessMode::isWriteOrExclusive(trxCollection->accessType())) {
+      continue;
+    }
+    if (!static_cast<RocksDBTransactionCollection*>(trxCollection)
+             ->isLockedExclusively()) {
+      return false;
+    }
+    found = true;
+  }
+  return found;
+}
+
 Result RocksDBTransactionState::checkIntermediateCommit(uint64_t newSize) {
   auto numOperations = _numInserts + _numUpdates + _numRemoves;
   // perform an intermediate commit
@@ -608,6 +638,26 @@ void RocksDBTransactionState::trackIndexRemove(TRI_voc_cid_t cid,
   }
 }
 
+void RocksDBTransactionState::trackRevisionInsert(TRI_voc_cid_t cid,
+                                                  VPackSlice const& doc) {
+  auto col = findCollection(cid);
+  if (col != nullptr) {
+    static_cast<RocksDBTransactionCollection*>(col)->trackRevisionInsert(doc);
+  } else {
+    TRI_ASSERT(false);
+  }
+}
+
+void RocksDBTransactionState::trackRevisionRemove(TRI_voc_cid_t cid,
+                                                  VPackSlice const& doc) {
+  auto col = findCollection(cid);
+  if (col != nullptr) {
+    static_cast<RocksDBTransactionCollection*>(col)->trackRevisionRemove(doc);
+  } else {
+    TRI_ASSERT(false);
+  }
+}
+
 /// @brief constructor, leases a builder
 RocksDBKeyLeaser::RocksDBKeyLeaser(transaction::Methods* trx)
     : _rtrx(RocksDBTransactionState::toState(trx)),
@@ -157,6 +157,14 @@ class RocksDBTransactionState final : public TransactionState {
   ///        Used to update the estimate after the trx commited
   void trackIndexRemove(TRI_voc_cid_t cid, TRI_idx_iid_t idxObjectId, uint64_t hash);
 
+  /// @brief Track a document inserted into a collection
+  ///        Used to update the revision tree after the trx commited
+  void trackRevisionInsert(TRI_voc_cid_t cid, velocypack::Slice const& doc);
+
+  /// @brief Track a document removed from a collection
+  ///        Used to update the revision tree after the trx commited
+  void trackRevisionRemove(TRI_voc_cid_t cid, velocypack::Slice const& doc);
+
  private:
   /// @brief create a new rocksdb transaction
   void createTransaction();
@@ -174,6 +182,10 @@ class RocksDBTransactionState final : public TransactionState {
   /// @brief check sizes and call internalCommit if too big
   Result checkIntermediateCommit(uint64_t newSize);
 
+  /// @brief whether or not the transaction writes only into collections it
+  /// has locked exclusively itself
+  bool hasOnlyExclusiveWrites() const;
+
   /// @brief rocksdb transaction may be null for read only transactions
   rocksdb::Transaction* _rocksTransaction;
   /// @brief rocksdb snapshot, is null if _rocksTransaction is set
@@ -202,6 +214,9 @@ class RocksDBTransactionState final : public TransactionState {
   SmallVector<RocksDBKey*, 32> _keys;
   /// @brief if true there key buffers will no longer be shared
   bool _parallel;
+  /// @brief if true, writes bypass the locking and conflict checks of the
+  /// rocksdb transaction
+  bool _untrackedWrites;
 };
 
 class RocksDBKeyLeaser {
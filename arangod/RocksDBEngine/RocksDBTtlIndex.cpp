@@ -0,0 +1,50 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RocksDBTtlIndex.h"
+#include "Basics/VelocyPackHelper.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+RocksDBTtlIndex::RocksDBTtlIndex(TRI_idx_iid_t iid, LogicalCollection* coll,
+                                 VPackSlice const& info)
+    : RocksDBVPackIndex(iid, coll, info),
+      _expireAfter(basics::VelocyPackHelper::getNumericValue<double>(
+          info, "expireAfter", 0.0)) {
+  TRI_ASSERT(_fields.size() == 1);
+  TRI_ASSERT(_sparse && !_unique);
+}
+
+void RocksDBTtlIndex::toVelocyPack(VPackBuilder& builder, bool withFigures,
+                                   bool forPersistence) const {
+  VPackBuilder tmp;
+  RocksDBVPackIndex::toVelocyPack(tmp, withFigures, forPersistence);
+
+  builder.openObject();
+  for (auto const& it : VPackObjectIterator(tmp.slice())) {
+    builder.add(it.key);
+    builder.add(it.value);
+  }
+  builder.add("expireAfter", VPackValue(_expireAfter));
+  builder.close();
+}
@@ -0,0 +1,58 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_ROCKSDB_ROCKSDB_TTL_INDEX_H
+#define ARANGOD_ROCKSDB_ROCKSDB_TTL_INDEX_H 1
+
+#include "RocksDBEngine/RocksDBVPackIndex.h"
+
+namespace arangodb {
+
+/// @brief sorted, sparse index over a single numeric attribute holding a
+/// timestamp in seconds since the epoch. documents are expired by the
+/// engine's TTL thread once the timestamp is more than expireAfter seconds
+/// in the past. the index itself is a regular skiplist-like index, so it
+/// can be used by queries as well
+class RocksDBTtlIndex final : public RocksDBVPackIndex {
+ public:
+  RocksDBTtlIndex() = delete;
+
+  RocksDBTtlIndex(TRI_idx_iid_t iid, LogicalCollection* coll,
+                  arangodb::velocypack::Slice const& info);
+
+ public:
+  IndexType type() const override { return Index::TRI_IDX_TYPE_TTL_INDEX; }
+
+  char const* typeName() const override { return "rocksdb-ttl"; }
+
+  bool isSorted() const override { return true; }
+
+  void toVelocyPack(velocypack::Builder&, bool, bool) const override;
+
+  /// @brief number of seconds after the indexed timestamp at which a
+  /// document expires
+  double expireAfter() const { return _expireAfter; }
+
+ private:
+  double const _expireAfter;
+};
+}
+
+#endif
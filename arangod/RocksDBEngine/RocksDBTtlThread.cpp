@@ -0,0 +1,197 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RocksDBTtlThread.h"
+#include "Aql/Query.h"
+#include "Aql/QueryString.h"
+#include "Basics/ConditionLocker.h"
+#include "Cluster/ServerState.h"
+#include "Logger/Logger.h"
+#include "RestServer/DatabaseFeature.h"
+#include "RestServer/QueryRegistryFeature.h"
+#include "RocksDBEngine/RocksDBEngine.h"
+#include "RocksDBEngine/RocksDBTtlIndex.h"
+#include "Utils/DatabaseGuard.h"
+#include "VocBase/LogicalCollection.h"
+#include "VocBase/vocbase.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+RocksDBTtlThread::RocksDBTtlThread(RocksDBEngine* engine, double frequency,
+                                   uint64_t maxRemovals)
+    : Thread("RocksDBTtl"),
+      _engine(engine),
+      _frequency(frequency),
+      _maxRemovals(maxRemovals) {}
+
+RocksDBTtlThread::~RocksDBTtlThread() { shutdown(); }
+
+void RocksDBTtlThread::beginShutdown() {
+  Thread::beginShutdown();
+
+  // wake up the thread that may be waiting in run()
+  CONDITION_LOCKER(guard, _condition);
+  guard.broadcast();
+}
+
+void RocksDBTtlThread::run() {
+  while (!isStopping()) {
+    {
+      CONDITION_LOCKER(guard, _condition);
+      guard.wait(static_cast<uint64_t>(_frequency * 1000000.0));
+    }
+
+    if (isStopping()) {
+      break;
+    }
+
+    if (_engine->inRecovery() || ServerState::readOnly() ||
+        DatabaseFeature::DATABASE == nullptr ||
+        QueryRegistryFeature::QUERY_REGISTRY == nullptr) {
+      continue;
+    }
+
+    // only collect the database ids here, the removals must not run while
+    // the list of databases is protected
+    std::vector<TRI_voc_tick_t> databases;
+    DatabaseFeature::DATABASE->enumerateDatabases(
+        [&databases](TRI_vocbase_t& vocbase) {
+          if (!vocbase.isDropped()) {
+            databases.emplace_back(vocbase.id());
+          }
+        });
+
+    for (auto const& id : databases) {
+      if (isStopping()) {
+        break;
+      }
+      try {
+        DatabaseGuard guard(id);
+        work(guard.database());
+      } catch (arangodb::basics::Exception const& ex) {
+        if (ex.code() != TRI_ERROR_ARANGO_DATABASE_NOT_FOUND) {
+          LOG_TOPIC(WARN, Logger::ENGINES)
+              << "caught exception in rocksdb ttl thread: " << ex.what();
+        }
+      } catch (std::exception const& ex) {
+        LOG_TOPIC(WARN, Logger::ENGINES)
+            << "caught exception in rocksdb ttl thread: " << ex.what();
+      } catch (...) {
+        LOG_TOPIC(WARN, Logger::ENGINES)
+            << "caught unknown exception in rocksdb ttl thread";
+      }
+    }
+  }
+}
+
+/// @brief remove expired documents of all TTL indexes of a database
+void RocksDBTtlThread::work(TRI_vocbase_t& vocbase) {
+  struct Expiry {
+    std::string collection;
+    std::vector<std::string> attribute;
+    double expireAfter;
+  };
+
+  std::vector<Expiry> expiries;
+  vocbase.processCollections(
+      [&expiries](LogicalCollection* collection) {
+        for (auto const& index : collection->getIndexes()) {
+          if (index->type() != Index::TRI_IDX_TYPE_TTL_INDEX) {
+            continue;
+          }
+          auto ttl = static_cast<RocksDBTtlIndex const*>(index.get());
+          TRI_ASSERT(ttl->paths().size() == 1);
+          expiries.emplace_back(Expiry{collection->name(), ttl->paths()[0],
+                                       ttl->expireAfter()});
+        }
+      },
+      false);
+
+  for (auto const& it : expiries) {
+    if (isStopping()) {
+      return;
+    }
+    uint64_t removed = removeExpired(vocbase, it.collection, it.attribute,
+                                     TRI_microtime() - it.expireAfter);
+    if (removed > 0) {
+      LOG_TOPIC(DEBUG, Logger::ENGINES)
+          << "removed " << removed << " expired documents from collection '"
+          << vocbase.name() << "/" << it.collection << "'";
+    }
+  }
+}
+
+/// @brief remove at most _maxRemovals documents whose timestamp in the
+/// attribute is at or before the stamp. returns the number of removed
+/// documents
+uint64_t RocksDBTtlThread::removeExpired(
+    TRI_vocbase_t& vocbase, std::string const& collection,
+    std::vector<std::string> const& attribute, double stamp) {
+  auto bindVars = std::make_shared<VPackBuilder>();
+  std::string access = "doc";
+
+  bindVars->openObject();
+  bindVars->add("@collection", VPackValue(collection));
+  for (size_t i = 0; i < attribute.size(); ++i) {
+    std::string const name = "attribute" + std::to_string(i);
+    access.append(".@").append(name);
+    bindVars->add(name, VPackValue(attribute[i]));
+  }
+  bindVars->add("stamp", VPackValue(stamp));
+  bindVars->add("limit", VPackValue(_maxRemovals));
+  bindVars->close();
+
+  // the range condition is served by the TTL index, so only expired
+  // documents are read. documents removed concurrently are ignored
+  std::string const aql = "FOR doc IN @@collection FILTER " + access +
+                          " >= 0 && " + access +
+                          " <= @stamp LIMIT @limit REMOVE doc IN @@collection "
+                          "OPTIONS { ignoreErrors: true }";
+
+  arangodb::aql::Query query(
+    false,
+    vocbase,
+    arangodb::aql::QueryString(aql),
+    bindVars,
+    nullptr,
+    arangodb::aql::PART_MAIN
+  );
+
+  aql::QueryResult queryResult =
+      query.executeSync(QueryRegistryFeature::QUERY_REGISTRY);
+
+  if (queryResult.code != TRI_ERROR_NO_ERROR) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(queryResult.code, queryResult.details);
+  }
+
+  if (queryResult.extra) {
+    VPackSlice stats = queryResult.extra->slice().get("stats");
+    if (stats.isObject()) {
+      VPackSlice found = stats.get("writesExecuted");
+      if (found.isNumber()) {
+        return found.getNumericValue<uint64_t>();
+      }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_ROCKSDB_ENGINE_TTL_THREAD_H
+#define ARANGOD_ROCKSDB_ENGINE_TTL_THREAD_H 1
+
+#include "Basics/Common.h"
+#include "Basics/ConditionVariable.h"
+#include "Basics/Thread.h"
+
+struct TRI_vocbase_t;
+
+namespace arangodb {
+
+class RocksDBEngine;
+
+/// @brief background thread removing expired documents of collections with
+/// a TTL index. each run removes at most a limited number of documents per
+/// index, so that the removals are spread over time and do not compete with
+/// foreground operations for too long
+class RocksDBTtlThread final : public Thread {
+ public:
+  RocksDBTtlThread(RocksDBEngine* engine, double frequency,
+                   uint64_t maxRemovals);
+  ~RocksDBTtlThread();
+
+  void beginShutdown() override;
+
+ protected:
+  void run() override;
+
+ private:
+  /// @brief remove expired documents of all TTL indexes of a database
+  void work(TRI_vocbase_t& vocbase);
+
+  /// @brief remove at most _maxRemovals documents whose timestamp in the
+  /// attribute is at or before the stamp. returns the number of removed
+  /// documents
+  uint64_t removeExpired(TRI_vocbase_t& vocbase, std::string const& collection,
+                         std::vector<std::string> const& attribute,
+                         double stamp);
+
+ private:
+  RocksDBEngine* _engine;
+
+  /// @brief number of seconds between two runs
+  double const _frequency;
+
+  /// @brief maximum number of documents removed per index and run
+  uint64_t const _maxRemovals;
+
+  /// @brief condition variable for waiting between runs
+  arangodb::basics::ConditionVariable _condition;
+};
+}  // namespace arangodb
+
+#endif
@@ -130,6 +130,20 @@ static rocksdb::Slice KeyGeneratorValue(
     reinterpret_cast<std::underlying_type<RocksDBEntryType>::type*>(
         &keyGeneratorValue),
     1);
+
+static RocksDBEntryType indexHistogramValue =
+    RocksDBEntryType::IndexHistogramValue;
+static rocksdb::Slice IndexHistogramValue(
+    reinterpret_cast<std::underlying_type<RocksDBEntryType>::type*>(
+        &indexHistogramValue),
+    1);
+
+static RocksDBEntryType revisionTreeValue =
+    RocksDBEntryType::RevisionTreeValue;
+static rocksdb::Slice RevisionTreeValue(
+    reinterpret_cast<std::underlying_type<RocksDBEntryType>::type*>(
+        &revisionTreeValue),
+    1);
 }
 
 char const* arangodb::rocksDBEntryTypeName(arangodb::RocksDBEntryType type) {
@@ -168,6 +182,10 @@ char const* arangodb::rocksDBEntryTypeName(arangodb::RocksDBEntryType type) {
       return "IndexEstimateValue";
     case arangodb::RocksDBEntryType::KeyGeneratorValue:
       return "KeyGeneratorValue";
+    case arangodb::RocksDBEntryType::IndexHistogramValue:
+      return "IndexHistogramValue";
+    case arangodb::RocksDBEntryType::RevisionTreeValue:
+      return "RevisionTreeValue";
   }
   return "Invalid";
 }
@@ -220,6 +238,8 @@ char const* arangodb::rocksDBLogTypeName(arangodb::RocksDBLogType type) {
       return "SingleRemove";
     case arangodb::RocksDBLogType::SingleRemoveV2:
       return "SingleRemoveV2";
+    case arangodb::RocksDBLogType::CollectionTruncate:
+      return "CollectionTruncate";
     case arangodb::RocksDBLogType::Invalid:
       return "Invalid";
   }
@@ -262,6 +282,10 @@ rocksdb::Slice const& arangodb::rocksDBSlice(RocksDBEntryType const& type) {
       return IndexEstimateValue;
     case RocksDBEntryType::KeyGeneratorValue:
       return KeyGeneratorValue;
+    case RocksDBEntryType::IndexHistogramValue:
+      return IndexHistogramValue;
+    case RocksDBEntryType::RevisionTreeValue:
+      return RevisionTreeValue;
   }
 
   return Placeholder;  // avoids warning - errorslice instead ?!
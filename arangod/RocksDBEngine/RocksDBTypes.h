@@ -52,7 +52,9 @@ enum class RocksDBEntryType : char {
   IndexEstimateValue = '<',
   KeyGeneratorValue = '=',
   View = '>',
-  GeoIndexValue = '?'
+  GeoIndexValue = '?',
+  IndexHistogramValue = '@',
+  RevisionTreeValue = 'A'
 };
 
 char const* rocksDBEntryTypeName(RocksDBEntryType);
@@ -85,7 +87,8 @@ enum class RocksDBLogType : char {
 #endif
   CommitTransaction = 'D',
   DocumentRemoveV2 = 'E',
-  SingleRemoveV2 = 'F'
+  SingleRemoveV2 = 'F',
+  CollectionTruncate = 'G'
 };
 
 enum class RocksDBSettingsType : char {
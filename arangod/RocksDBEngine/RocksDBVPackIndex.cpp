@@ -24,10 +24,14 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "RocksDBVPackIndex.h"
+#include "ApplicationFeatures/ApplicationServer.h"
+#include "Aql/Ast.h"
 #include "Aql/AstNode.h"
 #include "Aql/SortCondition.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/VelocyPackHelper.h"
+#include "Cache/CachedValue.h"
+#include "Cache/TransactionalCache.h"
 #include "Indexes/IndexResult.h"
 #include "Indexes/SimpleAttributeEqualityMatcher.h"
 #include "Indexes/PersistentIndexAttributeMatcher.h"
@@ -40,6 +44,8 @@
 #include "RocksDBEngine/RocksDBPrimaryIndex.h"
 #include "RocksDBEngine/RocksDBSettingsManager.h"
 #include "RocksDBEngine/RocksDBTransactionState.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "Transaction/Helpers.h"
 #include "Transaction/Methods.h"
 #include "VocBase/LogicalCollection.h"
@@ -60,6 +66,14 @@ using namespace arangodb;
 static std::vector<arangodb::basics::AttributeName> const KeyAttribute{
     arangodb::basics::AttributeName("_key", false)};
 
+/// @brief minimum number of index modifications after which the histogram
+/// is rebuilt, independent of the index size
+static constexpr uint64_t HistogramMinModifications = 1000;
+
+/// @brief share of modified index entries after which the histogram is
+/// rebuilt
+static constexpr double HistogramModificationShare = 0.1;
+
 // .............................................................................
 // recall for all of the following comparison functions:
 //
@@ -110,13 +124,9 @@ bool RocksDBVPackUniqueIndexIterator::next(LocalDocumentIdCallback const& cb,
 
   _done = true;
 
-  auto value = RocksDBValue::Empty(RocksDBEntryType::PrimaryIndexValue);
-  RocksDBMethods* mthds = RocksDBTransactionState::toMethods(_trx);
-  arangodb::Result r =
-      mthds->Get(_index->columnFamily(), _key.ref(), value.buffer());
-
-  if (r.ok()) {
-    cb(RocksDBValue::documentId(*value.buffer()));
+  LocalDocumentId documentId = _index->lookupUniqueKey(_trx, _key->string());
+  if (documentId.isSet()) {
+    cb(documentId);
   }
 
   // there is at most one element, so we are done now
@@ -133,12 +143,9 @@ bool RocksDBVPackUniqueIndexIterator::nextCovering(DocumentCallback const& cb, s
 
   _done = true;
 
-  auto value = RocksDBValue::Empty(RocksDBEntryType::PrimaryIndexValue);
-  RocksDBMethods* mthds = RocksDBTransactionState::toMethods(_trx);
-  arangodb::Result r = mthds->Get(_index->columnFamily(), _key.ref(), value.buffer());
-
-  if (r.ok()) {
-    cb(LocalDocumentId(RocksDBValue::documentId(*value.buffer())), RocksDBKey::indexedVPack(_key.ref()));
+  LocalDocumentId documentId = _index->lookupUniqueKey(_trx, _key->string());
+  if (documentId.isSet()) {
+    cb(documentId, RocksDBKey::indexedVPack(_key.ref()));
   }
 
   // there is at most one element, so we are done now
@@ -227,6 +234,21 @@ bool RocksDBVPackIndexIterator::next(LocalDocumentIdCallback const& cb,
   return true;
 }
 
+void RocksDBVPackIndexIterator::skip(uint64_t count, uint64_t& skipped) {
+  TRI_ASSERT(_trx->state()->isRunning());
+
+  while (count > 0 && _iterator->Valid() && !outOfRange()) {
+    --count;
+    ++skipped;
+
+    if (_reverse) {
+      _iterator->Prev();
+    } else {
+      _iterator->Next();
+    }
+  }
+}
+
 bool RocksDBVPackIndexIterator::nextCovering(DocumentCallback const& cb, size_t limit) {
   TRI_ASSERT(_trx->state()->isRunning());
 
@@ -272,11 +294,20 @@ uint64_t RocksDBVPackIndex::HashForKey(const rocksdb::Slice& key) {
 RocksDBVPackIndex::RocksDBVPackIndex(TRI_idx_iid_t iid,
                                      arangodb::LogicalCollection* collection,
                                      arangodb::velocypack::Slice const& info)
-    : RocksDBIndex(iid, collection, info, RocksDBColumnFamily::vpack(), /*useCache*/false), 
+    : RocksDBIndex(iid, collection, info, RocksDBColumnFamily::vpack(),
+                   // only point lookups of unique indexes use the cache
+                   arangodb::basics::VelocyPackHelper::getBooleanValue(
+                       info, arangodb::StaticStrings::IndexUnique.c_str(),
+                       false) &&
+                       arangodb::basics::VelocyPackHelper::getBooleanValue(
+                           info, "cacheEnabled", false)),
       _deduplicate(arangodb::basics::VelocyPackHelper::getBooleanValue(
           info, "deduplicate", true)),
       _allowPartialIndex(true),
-      _estimator(nullptr) {
+      _estimator(nullptr),
+      _histogramNeedsPersist(false),
+      _histogramModifications(0),
+      _histogramBuilding(false) {
   TRI_ASSERT(_cf == RocksDBColumnFamily::vpack());
 
   if (!_unique && !ServerState::instance()->isCoordinator()) {
@@ -320,6 +351,9 @@ void RocksDBVPackIndex::toVelocyPack(VPackBuilder& builder, bool withFigures,
     arangodb::velocypack::Value(_sparse)
   );
   builder.add("deduplicate", VPackValue(_deduplicate));
+  if (_cacheEnabled) {
+    builder.add("cacheEnabled", VPackValue(true));
+  }
   builder.close();
 }
 
@@ -645,6 +679,7 @@ Result RocksDBVPackIndex::insertInternal(transaction::Methods* trx,
     }
 
     if (res == TRI_ERROR_NO_ERROR) {
+      blackListKey(key.string().data(), key.string().size());
       arangodb::Result r =
           mthds->Put(_cf, key, value.string(), rocksutils::index);
       if (!r.ok()) {
@@ -666,6 +701,10 @@ Result RocksDBVPackIndex::insertInternal(transaction::Methods* trx,
     }
   }
 
+  if (res == TRI_ERROR_NO_ERROR) {
+    _histogramModifications.fetch_add(count, std::memory_order_relaxed);
+  }
+
   if (res == TRI_ERROR_NO_ERROR && !_unique) {
     auto state = RocksDBTransactionState::toState(trx);
     for (auto& it : hashes) {
@@ -746,6 +785,7 @@ Result RocksDBVPackIndex::updateInternal(
     for (size_t i = 0; i < count; ++i) {
       RocksDBKey& key = elements[i];
       if (res == TRI_ERROR_NO_ERROR) {
+        blackListKey(key.string().data(), key.string().size());
         arangodb::Result r =
             mthds->Put(_cf, key, value.string(), rocksutils::index);
         if (!r.ok()) {
@@ -785,6 +825,7 @@ Result RocksDBVPackIndex::removeInternal(transaction::Methods* trx,
 
   size_t const count = elements.size();
   for (size_t i = 0; i < count; ++i) {
+    blackListKey(elements[i].string().data(), elements[i].string().size());
     arangodb::Result r = mthds->Delete(_cf, elements[i]);
     if (!r.ok()) {
       res = r.errorNumber();
@@ -792,6 +833,8 @@ Result RocksDBVPackIndex::removeInternal(transaction::Methods* trx,
   }
 
   if (res == TRI_ERROR_NO_ERROR) {
+    _histogramModifications.fetch_add(count, std::memory_order_relaxed);
+
     auto state = RocksDBTransactionState::toState(trx);
     for (auto& it : hashes) {
       // The estimator is only useful if we are in a non-unique indexes
@@ -803,6 +846,73 @@ Result RocksDBVPackIndex::removeInternal(transaction::Methods* trx,
   return IndexResult(res, this);
 }
 
+/// @brief look up the document of a unique index key, using the cache if
+/// the index has one. returns an unset LocalDocumentId if not found
+LocalDocumentId RocksDBVPackIndex::lookupUniqueKey(
+    transaction::Methods* trx, rocksdb::Slice const& key) const {
+  TRI_ASSERT(_unique);
+
+  bool lockTimeout = false;
+  if (useCache()) {
+    TRI_ASSERT(_cache != nullptr);
+    // check cache first for fast path
+    auto f = _cache->find(key.data(), static_cast<uint32_t>(key.size()));
+    if (f.found()) {
+      rocksdb::Slice s(reinterpret_cast<char const*>(f.value()->value()),
+                       f.value()->valueSize());
+      return RocksDBValue::documentId(s);
+    } else if (f.result().errorNumber() == TRI_ERROR_LOCK_TIMEOUT) {
+      // assuming someone is currently holding a write lock, which
+      // is why we cannot access the TransactionalBucket.
+      lockTimeout = true;  // we skip the insert in this case
+    }
+  }
+
+  auto value = RocksDBValue::Empty(RocksDBEntryType::UniqueVPackIndexValue);
+  RocksDBMethods* mthds = RocksDBTransactionState::toMethods(trx);
+  arangodb::Result r = mthds->Get(_cf, key, value.buffer());
+  if (!r.ok()) {
+    return LocalDocumentId();
+  }
+
+  if (useCache() && !lockTimeout) {
+    TRI_ASSERT(_cache != nullptr);
+
+    // write entry back to cache
+    auto entry = cache::CachedValue::construct(
+        key.data(), static_cast<uint32_t>(key.size()), value.buffer()->data(),
+        static_cast<uint64_t>(value.buffer()->size()));
+    if (entry) {
+      Result status = _cache->insert(entry);
+      if (status.errorNumber() == TRI_ERROR_LOCK_TIMEOUT) {
+        // the writeLock uses cpu_relax internally, so we can try yield
+        std::this_thread::yield();
+        status = _cache->insert(entry);
+      }
+      if (status.fail()) {
+        delete entry;
+      }
+    }
+  }
+
+  return RocksDBValue::documentId(*value.buffer());
+}
+
+void RocksDBVPackIndex::reloadCacheKeys(
+    transaction::Methods* trx, std::vector<std::string> const& keys) const {
+  if (!_unique) {
+    return;
+  }
+  for (auto const& key : keys) {
+    rocksdb::Slice const slice(key);
+    if (slice.size() <= sizeof(uint64_t) ||
+        RocksDBKey::objectId(slice) != _objectId) {
+      continue;
+    }
+    lookupUniqueKey(trx, slice);
+  }
+}
+
 /// @brief attempts to locate an entry in the index
 /// Warning: who ever calls this function is responsible for destroying
 /// the RocksDBVPackIndexIterator* results
@@ -1218,3 +1328,313 @@ bool RocksDBVPackIndex::needToPersistEstimate() const {
   }
   return false;
 }
+
+/// @brief estimate the share of index entries for which the first index
+/// attribute satisfies all of the given condition parts, from the histogram
+double RocksDBVPackIndex::firstAttributeSelectivity(
+    std::vector<arangodb::aql::AstNode const*> const& nodes,
+    arangodb::aql::Variable const* reference) const {
+  if (isAttributeExpanded(0)) {
+    // the histogram counts array members, not documents
+    return -1.0;
+  }
+
+  auto histogram = this->histogram();
+  if (histogram == nullptr || histogram->total() == 0) {
+    return -1.0;
+  }
+
+  auto isFirstAttribute = [this, reference](aql::AstNode const* node) {
+    std::pair<aql::Variable const*, std::vector<basics::AttributeName>>
+        attributeData;
+    return node->isAttributeAccessForVariable(attributeData) &&
+           attributeData.first == reference &&
+           basics::AttributeName::isIdentical(_fields[0], attributeData.second,
+                                              true);
+  };
+
+  VPackBuilder lower;
+  VPackBuilder upper;
+  bool lowerIncluded = true;
+  bool upperIncluded = true;
+  VPackBuilder equal;
+
+  for (auto const& node : nodes) {
+    TRI_ASSERT(node->numMembers() == 2);
+    aql::AstNodeType type = node->type;
+    aql::AstNode const* value;
+
+    if (isFirstAttribute(node->getMember(0))) {
+      value = node->getMember(1);
+    } else if (isFirstAttribute(node->getMember(1)) &&
+               aql::Ast::IsReversibleOperator(type)) {
+      // 5 < doc.value  =>  doc.value > 5
+      value = node->getMember(0);
+      type = aql::Ast::ReverseOperator(type);
+    } else {
+      return -1.0;
+    }
+
+    if (!value->isConstant()) {
+      // the value is only known at runtime
+      return -1.0;
+    }
+
+    switch (type) {
+      case aql::NODE_TYPE_OPERATOR_BINARY_EQ:
+      case aql::NODE_TYPE_OPERATOR_BINARY_IN: {
+        if (!equal.isEmpty()) {
+          // more than one equality condition. the first one is good enough
+          break;
+        }
+        if (type == aql::NODE_TYPE_OPERATOR_BINARY_IN &&
+            value->type != aql::NODE_TYPE_ARRAY) {
+          return -1.0;
+        }
+        if (type == aql::NODE_TYPE_OPERATOR_BINARY_IN) {
+          value->toVelocyPackValue(equal);
+        } else {
+          equal.openArray();
+          value->toVelocyPackValue(equal);
+          equal.close();
+        }
+        break;
+      }
+      case aql::NODE_TYPE_OPERATOR_BINARY_GT:
+      case aql::NODE_TYPE_OPERATOR_BINARY_GE: {
+        bool const included = (type == aql::NODE_TYPE_OPERATOR_BINARY_GE);
+        VPackBuilder bound;
+        value->toVelocyPackValue(bound);
+        int res = lower.isEmpty()
+                      ? 1
+                      : basics::VelocyPackHelper::compare(
+                            bound.slice(), lower.slice(), true);
+        if (res > 0 || (res == 0 && !included)) {
+          lower = std::move(bound);
+          lowerIncluded = included;
+        }
+        break;
+      }
+      case aql::NODE_TYPE_OPERATOR_BINARY_LT:
+      case aql::NODE_TYPE_OPERATOR_BINARY_LE: {
+        bool const included = (type == aql::NODE_TYPE_OPERATOR_BINARY_LE);
+        VPackBuilder bound;
+        value->toVelocyPackValue(bound);
+        int res = upper.isEmpty()
+                      ? -1
+                      : basics::VelocyPackHelper::compare(
+                            bound.slice(), upper.slice(), true);
+        if (res < 0 || (res == 0 && !included)) {
+          upper = std::move(bound);
+          upperIncluded = included;
+        }
+        break;
+      }
+      default: {
+        return -1.0;
+      }
+    }
+  }
+
+  VPackSlice const lowerSlice =
+      lower.isEmpty() ? VPackSlice::noneSlice() : lower.slice();
+  VPackSlice const upperSlice =
+      upper.isEmpty() ? VPackSlice::noneSlice() : upper.slice();
+
+  if (equal.isEmpty()) {
+    return histogram->rangeSelectivity(lowerSlice, lowerIncluded, upperSlice,
+                                       upperIncluded);
+  }
+
+  double selectivity = 0.0;
+  for (auto const& it : VPackArrayIterator(equal.slice())) {
+    if (!lowerSlice.isNone()) {
+      int res = basics::VelocyPackHelper::compare(it, lowerSlice, true);
+      if (res < 0 || (res == 0 && !lowerIncluded)) {
+        continue;
+      }
+    }
+    if (!upperSlice.isNone()) {
+      int res = basics::VelocyPackHelper::compare(it, upperSlice, true);
+      if (res > 0 || (res == 0 && !upperIncluded)) {
+        continue;
+      }
+    }
+    selectivity += histogram->equalitySelectivity(it);
+  }
+  return (std::min)(1.0, selectivity);
+}
+
+/// @brief write the histogram if it changed since it was last written, and
+/// rebuild it in the background if it is outdated
+Result RocksDBVPackIndex::serializeHistogram(rocksdb::Transaction* rtrx) {
+  std::shared_ptr<RocksDBIndexHistogram const> histogram;
+  {
+    std::lock_guard<std::mutex> guard(_histogramLock);
+    if (_histogramNeedsPersist) {
+      histogram = _histogram;
+      _histogramNeedsPersist = false;
+    }
+  }
+
+  if (histogram != nullptr) {
+    RocksDBKey key;
+    key.constructIndexHistogramValue(_objectId);
+    VPackSlice data = histogram->slice();
+    rocksdb::Slice value(reinterpret_cast<char const*>(data.begin()),
+                         static_cast<size_t>(data.byteSize()));
+    rocksdb::Status s =
+        rtrx->Put(RocksDBColumnFamily::definitions(), key.string(), value);
+
+    if (!s.ok()) {
+      std::lock_guard<std::mutex> guard(_histogramLock);
+      _histogramNeedsPersist = true;
+      return rocksutils::convertStatus(s);
+    }
+  }
+
+  if (SchedulerFeature::SCHEDULER == nullptr || !needToRebuildHistogram()) {
+    return Result();
+  }
+
+  bool expected = false;
+  if (!_histogramBuilding.compare_exchange_strong(expected, true)) {
+    // a rebuild is already going on
+    return Result();
+  }
+
+  // the task keeps only a weak reference, so that it does not keep a
+  // dropped index alive for longer than necessary
+  std::weak_ptr<Index> self = _collection->getPhysical()->lookupIndex(id());
+  if (self.expired()) {
+    _histogramBuilding = false;
+    return Result();
+  }
+
+  try {
+    SchedulerFeature::SCHEDULER->post([self]() {
+      auto index = self.lock();
+      if (index == nullptr) {
+        return;
+      }
+      auto idx = static_cast<RocksDBVPackIndex*>(index.get());
+      try {
+        idx->rebuildHistogram();
+      } catch (std::exception const& ex) {
+        LOG_TOPIC(WARN, Logger::ENGINES)
+            << "unable to build histogram for index '" << idx->id()
+            << "': " << ex.what();
+      } catch (...) {
+        LOG_TOPIC(WARN, Logger::ENGINES)
+            << "unable to build histogram for index '" << idx->id() << "'";
+      }
+      idx->_histogramBuilding = false;
+    });
+  } catch (...) {
+    _histogramBuilding = false;
+  }
+
+  return Result();
+}
+
+/// @brief load the persisted histogram, if any
+void RocksDBVPackIndex::deserializeHistogram() {
+  if (ServerState::instance()->isCoordinator()) {
+    return;
+  }
+
+  RocksDBKey key;
+  key.constructIndexHistogramValue(_objectId);
+
+  rocksdb::PinnableSlice value;
+  rocksdb::Status s =
+      rocksutils::globalRocksDB()->Get(rocksdb::ReadOptions(),
+                                       RocksDBColumnFamily::definitions(),
+                                       key.string(), &value);
+  if (!s.ok()) {
+    // no histogram yet. it will be built in the background
+    return;
+  }
+
+  try {
+    auto histogram = std::make_shared<RocksDBIndexHistogram const>(
+        VPackSlice(value.data()));
+    std::lock_guard<std::mutex> guard(_histogramLock);
+    _histogram = std::move(histogram);
+  } catch (...) {
+    LOG_TOPIC(WARN, Logger::ENGINES)
+        << "ignoring invalid histogram for index '" << id() << "'";
+  }
+}
+
+int RocksDBVPackIndex::drop() {
+  int res = RocksDBIndex::drop();
+
+  if (res == TRI_ERROR_NO_ERROR) {
+    RocksDBKey key;
+    key.constructIndexHistogramValue(_objectId);
+    res = rocksutils::globalRocksDBRemove(RocksDBColumnFamily::definitions(),
+                                          key.string())
+              .errorNumber();
+  }
+  return res;
+}
+
+/// @brief return the value histogram of the first index attribute, may be
+/// a nullptr if it was not yet built
+std::shared_ptr<RocksDBIndexHistogram const> RocksDBVPackIndex::histogram()
+    const {
+  std::lock_guard<std::mutex> guard(_histogramLock);
+  return _histogram;
+}
+
+/// @brief whether or not the histogram is missing or outdated
+bool RocksDBVPackIndex::needToRebuildHistogram() const {
+  auto histogram = this->histogram();
+  if (histogram == nullptr) {
+    return true;
+  }
+  uint64_t const threshold = (std::max)(
+      HistogramMinModifications,
+      static_cast<uint64_t>(histogram->total() * HistogramModificationShare));
+  return _histogramModifications.load(std::memory_order_relaxed) > threshold;
+}
+
+/// @brief build the histogram from all index entries. runs in the background,
+/// without a transaction
+void RocksDBVPackIndex::rebuildHistogram() {
+  // modifications made while the histogram is built count for the next one
+  uint64_t const modifications = _histogramModifications.load();
+
+  RocksDBKeyBounds const bounds = getBounds();
+  rocksdb::Slice const end = bounds.end();
+  rocksdb::ReadOptions options;
+  options.iterate_upper_bound = &end;
+  options.prefix_same_as_start = true;
+  options.verify_checksums = false;
+  options.fill_cache = false;
+  std::unique_ptr<rocksdb::Iterator> it(
+      rocksutils::globalRocksDB()->NewIterator(options, bounds.columnFamily()));
+
+  RocksDBIndexHistogram::Builder builder;
+  uint64_t seen = 0;
+  for (it->Seek(bounds.start()); it->Valid(); it->Next()) {
+    if (++seen % 10000 == 0 &&
+        application_features::ApplicationServer::isStopping()) {
+      return;
+    }
+    // index entries are sorted by their first attribute value first
+    builder.add(RocksDBKey::indexedVPack(it->key()).at(0));
+  }
+
+  auto histogram = builder.finish();
+  _histogramModifications.fetch_sub(modifications);
+
+  LOG_TOPIC(TRACE, Logger::ENGINES)
+      << "built histogram for index '" << id() << "' over "
+      << histogram->total() << " entries";
+
+  std::lock_guard<std::mutex> guard(_histogramLock);
+  _histogram = std::move(histogram);
+  _histogramNeedsPersist = true;
+}
@@ -31,6 +31,7 @@
 #include "Indexes/IndexIterator.h"
 #include "RocksDBEngine/RocksDBCuckooIndexEstimator.h"
 #include "RocksDBEngine/RocksDBIndex.h"
+#include "RocksDBEngine/RocksDBIndexHistogram.h"
 #include "RocksDBEngine/RocksDBKey.h"
 #include "RocksDBEngine/RocksDBKeyBounds.h"
 #include "RocksDBEngine/RocksDBValue.h"
@@ -40,6 +41,9 @@
 #include <velocypack/Buffer.h>
 #include <velocypack/Slice.h>
 
+#include <atomic>
+#include <mutex>
+
 namespace rocksdb {
 class Iterator;
 }
@@ -116,6 +120,9 @@ class RocksDBVPackIndexIterator final : public IndexIterator {
   
   bool nextCovering(DocumentCallback const& cb, size_t limit) override;
 
+  /// @brief skips index keys, without decoding the document ids
+  void skip(uint64_t count, uint64_t& skipped) override;
+
   /// @brief Reset the cursor
   void reset() override;
 
@@ -154,6 +161,10 @@ class RocksDBVPackIndex : public RocksDBIndex {
   RocksDBCuckooIndexEstimator<uint64_t>* estimator() override;
   bool needToPersistEstimate() const override;
 
+  double firstAttributeSelectivity(
+      std::vector<arangodb::aql::AstNode const*> const& nodes,
+      arangodb::aql::Variable const* reference) const override;
+
   void toVelocyPack(VPackBuilder&, bool, bool) const override;
 
   bool canBeDropped() const override { return true; }
@@ -203,6 +214,24 @@ class RocksDBVPackIndex : public RocksDBIndex {
 
   void recalculateEstimates() override;
 
+  Result serializeHistogram(rocksdb::Transaction*) override;
+
+  void deserializeHistogram() override;
+
+  int drop() override;
+
+  /// @brief return the value histogram of the first index attribute, may
+  /// be a nullptr if it was not yet built
+  std::shared_ptr<RocksDBIndexHistogram const> histogram() const;
+
+  /// @brief look up the document of a unique index key, using the cache if
+  /// the index has one. returns an unset LocalDocumentId if not found
+  LocalDocumentId lookupUniqueKey(transaction::Methods* trx,
+                                  rocksdb::Slice const& key) const;
+
+  void reloadCacheKeys(transaction::Methods* trx,
+                       std::vector<std::string> const& keys) const override;
+
  protected:
   Result insertInternal(transaction::Methods*, RocksDBMethods*,
                         LocalDocumentId const& documentId,
@@ -257,6 +286,13 @@ class RocksDBVPackIndex : public RocksDBIndex {
                         std::vector<VPackSlice>& sliceStack,
                         std::vector<uint64_t>& hashes);
 
+  /// @brief whether or not the histogram is missing or outdated
+  bool needToRebuildHistogram() const;
+
+  /// @brief build the histogram from all index entries. runs in the
+  /// background, without a transaction
+  void rebuildHistogram();
+
  private:
   /// @brief the attribute paths
   std::vector<std::vector<std::string>> _paths;
@@ -274,6 +310,21 @@ class RocksDBVPackIndex : public RocksDBIndex {
   /// On insertion of a document we have to insert it into the estimator,
   /// On removal we have to remove it in the estimator as well.
   std::unique_ptr<RocksDBCuckooIndexEstimator<uint64_t>> _estimator;
+
+  /// @brief protects _histogram and _histogramNeedsPersist
+  mutable std::mutex _histogramLock;
+
+  /// @brief equi-depth histogram over the values of the first attribute
+  std::shared_ptr<RocksDBIndexHistogram const> _histogram;
+
+  /// @brief whether or not the histogram changed since it was persisted
+  bool _histogramNeedsPersist;
+
+  /// @brief number of index modifications since the histogram was built
+  std::atomic<uint64_t> _histogramModifications;
+
+  /// @brief whether or not the histogram is currently being rebuilt
+  std::atomic<bool> _histogramBuilding;
 };
 }  // namespace arangodb
 
@@ -29,6 +29,8 @@
 #include "Basics/StringUtils.h"
 #include "RocksDBEngine/RocksDBFormat.h"
 
+#include <snappy.h>
+
 using namespace arangodb;
 using namespace arangodb::rocksutils;
 
@@ -120,6 +122,44 @@ VPackSlice RocksDBValue::data(std::string const& s) {
   return data(s.data(), s.size());
 }
 
+VPackSlice RocksDBValue::document(char const* data, size_t size,
+                                  std::string& buffer) {
+  TRI_ASSERT(data != nullptr);
+  TRI_ASSERT(size >= sizeof(char));
+  if (static_cast<uint8_t>(data[0]) != compressedDocumentMarker) {
+    return VPackSlice(data);
+  }
+  buffer.clear();
+  if (!snappy::Uncompress(data + 1, size - 1, &buffer)) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   "invalid compressed document");
+  }
+  return VPackSlice(buffer.data());
+}
+
+VPackSlice RocksDBValue::document(rocksdb::Slice const& slice,
+                                  std::string& buffer) {
+  return document(slice.data(), slice.size(), buffer);
+}
+
+bool RocksDBValue::compressDocument(VPackSlice const& doc, std::string& out) {
+  out.clear();
+  size_t const size = doc.byteSize();
+  if (size < minCompressedDocumentSize) {
+    return false;
+  }
+  out.resize(1 + snappy::MaxCompressedLength(size));
+  out[0] = static_cast<char>(compressedDocumentMarker);
+  size_t compressedSize = 0;
+  snappy::RawCompress(doc.startAs<char>(), size, &out[1], &compressedSize);
+  if (compressedSize + 1 >= size) {
+    out.clear();
+    return false;
+  }
+  out.resize(compressedSize + 1);
+  return true;
+}
+
 uint64_t RocksDBValue::keyValue(RocksDBValue const& value) {
   return keyValue(value._buffer.data(), value._buffer.size());
 }
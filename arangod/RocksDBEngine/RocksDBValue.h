@@ -98,6 +98,24 @@ class RocksDBValue {
   static VPackSlice data(rocksdb::Slice const&);
   static VPackSlice data(std::string const&);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Extracts a document from a value of the documents column family.
+  ///
+  /// Compressed documents are decompressed into the buffer, and the returned
+  /// slice points into it. Uncompressed documents are not copied.
+  //////////////////////////////////////////////////////////////////////////////
+  static VPackSlice document(char const* data, size_t size,
+                             std::string& buffer);
+  static VPackSlice document(rocksdb::Slice const&, std::string& buffer);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Compresses a document for the documents column family.
+  ///
+  /// Returns false and leaves the output empty if the document is too small
+  /// or does not get smaller by compressing it.
+  //////////////////////////////////////////////////////////////////////////////
+  static bool compressDocument(VPackSlice const& doc, std::string& out);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Extracts the numeric value from the key field of a VPackSlice
   ///
@@ -112,6 +130,17 @@ class RocksDBValue {
   //////////////////////////////////////////////////////////////////////////////
   static S2Point centroid(rocksdb::Slice const&);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief First byte of compressed documents. Documents are objects, so no
+  /// uncompressed document starts with this byte
+  //////////////////////////////////////////////////////////////////////////////
+  static constexpr uint8_t compressedDocumentMarker = 0xff;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Documents smaller than this are never compressed
+  //////////////////////////////////////////////////////////////////////////////
+  static constexpr size_t minCompressedDocumentSize = 128;
+
  public:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Returns a reference to the underlying string buffer.
@@ -32,13 +32,27 @@
 #include "Utils/DatabaseGuard.h"
 #include "VocBase/LogicalCollection.h"
 
+#include "Basics/MutexLocker.h"
 #include "Logger/Logger.h"
 
 #include <rocksdb/utilities/transaction_db.h>
 #include <velocypack/Builder.h>
 
+#include <chrono>
+#include <thread>
+
 using namespace arangodb;
 
+namespace {
+/// @brief an iterator of a client which does not tail for so many seconds
+/// is closed
+double const clientIteratorTtl = 30.0;
+}
+
+RocksDBWalAccess::RocksDBWalAccess() {}
+
+RocksDBWalAccess::~RocksDBWalAccess() {}
+
 /// {"tickMin":"123", "tickMax":"456", "version":"3.2", "serverId":"abc"}
 Result RocksDBWalAccess::tickRange(
     std::pair<TRI_voc_tick_t, TRI_voc_tick_t>& minMax) const {
@@ -214,6 +228,34 @@ class MyWALParser : public rocksdb::WriteBatch::Handler, public WalAccessContext
 
         break;
       }
+      case RocksDBLogType::CollectionTruncate: {
+        resetTransientState(); // finish ongoing trx
+
+        TRI_voc_tick_t dbid = RocksDBLogValue::databaseId(blob);
+        TRI_voc_cid_t cid = RocksDBLogValue::collectionId(blob);
+
+        if (shouldHandleCollection(dbid, cid)) {
+          TRI_vocbase_t* vocbase = loadVocbase(dbid);
+          LogicalCollection* col = loadCollection(dbid, cid);
+          TRI_ASSERT(vocbase != nullptr && col != nullptr);
+
+          {
+            uint64_t tick = _currentSequence + (_startOfBatch ? 0 : 1);
+            VPackObjectBuilder marker(&_builder, true);
+
+            marker->add("tick", VPackValue(std::to_string(tick)));
+            marker->add("type", VPackValue(rocksutils::convertLogType(type)));
+            marker->add("db", VPackValue(vocbase->name()));
+            marker->add("cuid", VPackValue(col->guid()));
+          }
+
+          _callback(vocbase, _builder.slice());
+          _responseSize += _builder.size();
+          _builder.clear();
+        }
+
+        break;
+      }
       case RocksDBLogType::IndexDrop: {
         resetTransientState(); // finish ongoing trx
 
@@ -467,7 +509,8 @@ class MyWALParser : public rocksdb::WriteBatch::Handler, public WalAccessContext
         marker->add("db", VPackValue(vocbase->name()));
         marker->add("cuid", VPackValue(col->guid()));
         marker->add("tid", VPackValue(std::to_string(_currentTrxId)));
-        marker->add("data", RocksDBValue::data(value));
+        std::string buffer;
+        marker->add("data", RocksDBValue::document(value, buffer));
       }
 
       _callback(vocbase, _builder.slice());
@@ -541,6 +584,16 @@ class MyWALParser : public rocksdb::WriteBatch::Handler, public WalAccessContext
     return rocksdb::Status();
   }
 
+  rocksdb::Status DeleteRangeCF(uint32_t /*column_family_id*/,
+                                const rocksdb::Slice& /*begin_key*/,
+                                const rocksdb::Slice& /*end_key*/) override {
+    tick();
+    // range deletes are only written by collection truncate and drop,
+    // which are replicated via their log markers
+    resetTransientState();
+    return rocksdb::Status();
+  }
+
   void startNewBatch(rocksdb::SequenceNumber startSequence) {
     // starting new write batch
     _startSequence = startSequence;
@@ -625,6 +678,7 @@ class MyWALParser : public rocksdb::WriteBatch::Handler, public WalAccessContext
 WalAccessResult RocksDBWalAccess::tail(uint64_t tickStart, uint64_t tickEnd,
                                        size_t chunkSize,
                                        TRI_voc_tick_t barrierId,
+                                       TRI_server_id_t clientId,
                                        Filter const& filter,
                                        MarkerCallback const& func) const {
   TRI_ASSERT(filter.transactionIds.empty());  // not supported in any way
@@ -636,19 +690,35 @@ WalAccessResult RocksDBWalAccess::tail(uint64_t tickStart, uint64_t tickEnd,
   uint64_t lastTick = tickStart;        // lastTick at start of a write batch
   uint64_t lastScannedTick = tickStart; // last tick we looked at
   uint64_t lastWrittenTick = 0;         // lastTick at the end of a write batch
+  uint64_t consumedTick = tickStart;    // all write batches up to here read
   uint64_t latestTick = db->GetLatestSequenceNumber();
 
   MyWALParser handler(filter, func);
-  std::unique_ptr<rocksdb::TransactionLogIterator> iterator;  // reader();
+  std::unique_ptr<rocksdb::TransactionLogIterator> iterator =
+      leaseIterator(clientId, tickStart, consumedTick);
+  bool const continued = (iterator != nullptr);
 
   rocksdb::Status s;
-  // no need verifying the WAL contents
-  rocksdb::TransactionLogIterator::ReadOptions ro(false);
-  s = db->GetUpdatesSince(tickStart, &iterator, ro);
-  if (!s.ok()) {
-    Result r = convertStatus(s, rocksutils::StatusHint::wal);
-    return WalAccessResult(r.errorNumber(), tickStart == latestTick,
-                           0, 0, latestTick);
+  if (continued && !iterator->Valid()) {
+    // the iterator was at the end of the WAL, it reads what was written
+    // since. it does not see WAL files which were created since, then
+    // there is more data than it can read
+    iterator->Next();
+    if (!iterator->Valid() && !iterator->status().ok()) {
+      iterator.reset();
+    }
+  }
+
+  if (iterator == nullptr) {
+    // no need verifying the WAL contents
+    rocksdb::TransactionLogIterator::ReadOptions ro(false);
+    s = db->GetUpdatesSince(tickStart, &iterator, ro);
+    if (!s.ok()) {
+      Result r = convertStatus(s, rocksutils::StatusHint::wal);
+      return WalAccessResult(r.errorNumber(), tickStart == latestTick,
+                             0, 0, latestTick);
+    }
+    consumedTick = tickStart;
   }
 
   if (chunkSize < 16384) {
@@ -681,6 +751,7 @@ WalAccessResult RocksDBWalAccess::tail(uint64_t tickStart, uint64_t tickEnd,
     //LOG_TOPIC(INFO, Logger::FIXME) << "found batch-seq: " << batch.sequence;
     lastTick = batch.sequence;  // start of the batch
     if (batch.sequence <= tickStart) {
+      consumedTick = batch.sequence;
       iterator->Next();  // skip
       continue;
     } else if (batch.sequence > tickEnd) {
@@ -698,15 +769,86 @@ WalAccessResult RocksDBWalAccess::tail(uint64_t tickStart, uint64_t tickEnd,
     lastWrittenTick = handler.endBatch();  // end of the batch
 
     TRI_ASSERT(lastWrittenTick >= lastTick);
+    consumedTick = batch.sequence;
     iterator->Next();
   }
 
-  WalAccessResult result(TRI_ERROR_NO_ERROR, firstTick <= tickStart,
+  // a continued iterator has read the WAL without gaps since an earlier
+  // call, which included tickStart
+  WalAccessResult result(TRI_ERROR_NO_ERROR,
+                         continued || firstTick <= tickStart,
                          lastWrittenTick, lastScannedTick, latestTick);
   if (!s.ok()) {
     result.Result::reset(convertStatus(s, rocksutils::StatusHint::wal));
+  } else {
+    returnIterator(clientId, std::move(iterator), consumedTick);
   }
   //LOG_TOPIC(WARN, Logger::FIXME) << "2. firstTick: " << firstTick << " lastWrittenTick: " << lastWrittenTick
   //<< " latestTick: " << latestTick;
   return result;
 }
+
+bool RocksDBWalAccess::waitForTicksAfter(TRI_voc_tick_t tick,
+                                         double timeout) const {
+  // there is no notification for new write batches, the wait looks at the
+  // latest sequence number in short intervals. unlike lastTick() this does
+  // not sync the WAL
+  rocksdb::TransactionDB* db = rocksutils::globalRocksDB();
+  auto const end = std::chrono::steady_clock::now() +
+                   std::chrono::duration<double>(timeout);
+  while (db->GetLatestSequenceNumber() <= tick) {
+    if (std::chrono::steady_clock::now() >= end) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  return true;
+}
+
+std::unique_ptr<rocksdb::TransactionLogIterator>
+RocksDBWalAccess::leaseIterator(TRI_server_id_t clientId, uint64_t tickStart,
+                                uint64_t& consumedTick) const {
+  if (clientId == 0) {
+    return nullptr;
+  }
+
+  double const now = TRI_microtime();
+  std::unique_ptr<rocksdb::TransactionLogIterator> iterator;
+
+  MUTEX_LOCKER(locker, _iteratorsLock);
+  for (auto it = _iterators.begin(); it != _iterators.end();) {
+    if (it->second.expires < now) {
+      it = _iterators.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  auto it = _iterators.find(clientId);
+  if (it == _iterators.end()) {
+    return nullptr;
+  }
+  // the iterator must not have passed any write batch after tickStart,
+  // e.g. because the client restarts from an earlier tick
+  if (it->second.consumedTick <= tickStart) {
+    iterator = std::move(it->second.iterator);
+    consumedTick = it->second.consumedTick;
+  }
+  _iterators.erase(it);
+  return iterator;
+}
+
+void RocksDBWalAccess::returnIterator(
+    TRI_server_id_t clientId,
+    std::unique_ptr<rocksdb::TransactionLogIterator> iterator,
+    uint64_t consumedTick) const {
+  if (clientId == 0 || iterator == nullptr) {
+    return;
+  }
+
+  MUTEX_LOCKER(locker, _iteratorsLock);
+  ClientIterator& entry = _iterators[clientId];
+  entry.iterator = std::move(iterator);
+  entry.consumedTick = consumedTick;
+  entry.expires = TRI_microtime() + clientIteratorTtl;
+}
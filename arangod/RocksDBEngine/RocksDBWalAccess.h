@@ -24,16 +24,21 @@
 #ifndef ARANGOD_ROCKSDB_ENGINE_WAL_ACCESS_H
 #define ARANGOD_ROCKSDB_ENGINE_WAL_ACCESS_H 1
 
+#include "Basics/Mutex.h"
 #include "StorageEngine/WalAccess.h"
 
+namespace rocksdb {
+class TransactionLogIterator;
+}
+
 namespace arangodb {
 
 /// @brief StorageEngine agnostic wal access interface.
 /// TODO: add methods for _admin/wal/ and get rid of engine specific handlers
 class RocksDBWalAccess final : public WalAccess {
  public:
-  RocksDBWalAccess() {}
-  virtual ~RocksDBWalAccess() {}
+  RocksDBWalAccess();
+  virtual ~RocksDBWalAccess();
 
   /// {"tickMin":"123", "tickMax":"456", "version":"3.2", "serverId":"abc"}
   Result tickRange(
@@ -56,9 +61,37 @@ class RocksDBWalAccess final : public WalAccess {
 
   /// Tails the wall, this will already sanitize the
   WalAccessResult tail(uint64_t tickStart, uint64_t tickEnd, size_t chunkSize,
-                       TRI_voc_tick_t barrierId,
+                       TRI_voc_tick_t barrierId, TRI_server_id_t clientId,
                        WalAccess::Filter const& filter,
                        MarkerCallback const&) const override;
+
+  bool waitForTicksAfter(TRI_voc_tick_t tick, double timeout) const override;
+
+ private:
+  /// @brief WAL iterator of a client between two tail calls
+  struct ClientIterator {
+    std::unique_ptr<rocksdb::TransactionLogIterator> iterator;
+    /// @brief all write batches up to this tick were read
+    uint64_t consumedTick;
+    double expires;
+  };
+
+  /// @brief takes the iterator of the client, if it can continue at
+  /// tickStart
+  std::unique_ptr<rocksdb::TransactionLogIterator> leaseIterator(
+      TRI_server_id_t clientId, uint64_t tickStart,
+      uint64_t& consumedTick) const;
+
+  void returnIterator(TRI_server_id_t clientId,
+                      std::unique_ptr<rocksdb::TransactionLogIterator>,
+                      uint64_t consumedTick) const;
+
+ private:
+  /// @brief an iterator continues in the WAL file it reads, tailing
+  /// clients which poll often would otherwise open and seek the WAL files
+  /// for every call
+  mutable Mutex _iteratorsLock;
+  mutable std::unordered_map<TRI_server_id_t, ClientIterator> _iterators;
 };
 }
 
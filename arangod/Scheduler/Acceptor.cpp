@@ -31,15 +31,17 @@
 
 using namespace arangodb;
 
-Acceptor::Acceptor(rest::Scheduler* scheduler, Endpoint* endpoint)
-    : _scheduler(scheduler), _endpoint(endpoint) {}
+Acceptor::Acceptor(rest::Scheduler* scheduler, Endpoint* endpoint,
+                   size_t ioContext)
+    : _scheduler(scheduler), _endpoint(endpoint), _ioContext(ioContext) {}
 
 std::unique_ptr<Acceptor> Acceptor::factory(rest::Scheduler* scheduler,
-                                            Endpoint* endpoint) {
+                                            Endpoint* endpoint,
+                                            size_t ioContext) {
 #ifdef ARANGODB_HAVE_DOMAIN_SOCKETS
   if (endpoint->domainType() == Endpoint::DomainType::UNIX) {
     return std::make_unique<AcceptorUnixDomain>(scheduler, endpoint);
   }
 #endif
-  return std::make_unique<AcceptorTcp>(scheduler, endpoint);
+  return std::make_unique<AcceptorTcp>(scheduler, endpoint, ioContext);
 }
@@ -36,7 +36,7 @@ class Acceptor {
   typedef std::function<void(asio_ns::error_code const&)> AcceptHandler;
 
  public:
-  Acceptor(rest::Scheduler*, Endpoint* endpoint);
+  Acceptor(rest::Scheduler*, Endpoint* endpoint, size_t ioContext);
   virtual ~Acceptor() {}
 
  public:
@@ -46,11 +46,13 @@ class Acceptor {
   std::unique_ptr<Socket> movePeer() { return std::move(_peer); };
 
  public:
-  static std::unique_ptr<Acceptor> factory(rest::Scheduler*, Endpoint*);
+  static std::unique_ptr<Acceptor> factory(rest::Scheduler*, Endpoint*,
+                                           size_t ioContext);
 
  protected:
   rest::Scheduler* _scheduler;
   Endpoint* _endpoint;
+  size_t const _ioContext;
   std::unique_ptr<Socket> _peer;
 };
 }
@@ -87,6 +87,22 @@ void AcceptorTcp::open() {
 #else
   _acceptor->set_option(asio_ns::ip::tcp::acceptor::reuse_address(
       ((EndpointIp*)_endpoint)->reuseAddress()));
+
+#ifdef SO_REUSEPORT
+  if (_scheduler->numIoContexts() > 1) {
+    // all I/O contexts bind an acceptor to the endpoint, and the kernel
+    // distributes the connections over them
+    typedef asio_ns::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>
+        reuse_port;
+    _acceptor->set_option(reuse_port(true), err);
+    if (err) {
+      LOG_TOPIC(ERR, Logger::COMMUNICATION)
+          << "unable to set SO_REUSEPORT for endpoint '"
+          << _endpoint->specification() << "': " << err.message();
+      throw std::runtime_error(err.message());
+    }
+  }
+#endif
 #endif
 
   _acceptor->bind(asioEndpoint, err);
@@ -110,12 +126,12 @@ void AcceptorTcp::open() {
 void AcceptorTcp::asyncAccept(AcceptHandler const& handler) {
   TRI_ASSERT(!_peer);
   if (_endpoint->encryption() == Endpoint::EncryptionType::SSL) {
-    _peer.reset(new SocketSslTcp(_scheduler,
-                                 SslServerFeature::SSL->createSslContext()));
+    _peer.reset(new SocketSslTcp(
+        _scheduler, SslServerFeature::SSL->createSslContext(), _ioContext));
     SocketSslTcp* peer = static_cast<SocketSslTcp*>(_peer.get());
     _acceptor->async_accept(peer->_socket, peer->_peerEndpoint, handler);
   } else {
-    _peer.reset(new SocketTcp(_scheduler));
+    _peer.reset(new SocketTcp(_scheduler, _ioContext));
     SocketTcp* peer = static_cast<SocketTcp*>(_peer.get());
     _acceptor->async_accept(*peer->_socket, peer->_peerEndpoint, handler);
   }
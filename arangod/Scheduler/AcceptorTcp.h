@@ -28,8 +28,10 @@
 namespace arangodb {
 class AcceptorTcp final : public Acceptor {
  public:
-  AcceptorTcp(rest::Scheduler* scheduler, Endpoint* endpoint)
-      : Acceptor(scheduler, endpoint), _acceptor(scheduler->newAcceptor()) {}
+  AcceptorTcp(rest::Scheduler* scheduler, Endpoint* endpoint,
+              size_t ioContext)
+      : Acceptor(scheduler, endpoint, ioContext),
+        _acceptor(scheduler->newAcceptor(ioContext)) {}
 
  public:
   void open() override;
@@ -29,7 +29,7 @@ namespace arangodb {
 class AcceptorUnixDomain final : public Acceptor {
  public:
   AcceptorUnixDomain(rest::Scheduler* scheduler, Endpoint* endpoint)
-      : Acceptor(scheduler, endpoint),
+      : Acceptor(scheduler, endpoint, 0),
         _acceptor(scheduler->newDomainAcceptor()) {}
 
  public:
@@ -0,0 +1,288 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_SCHEDULER_JOB_QUEUE_H
+#define ARANGOD_SCHEDULER_JOB_QUEUE_H 1
+
+#include "Basics/Common.h"
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace arangodb {
+namespace rest {
+
+/// @brief a callable job of the Scheduler. unlike std::function, callables
+/// of up to inlineSize bytes are stored in place, so that creating, moving
+/// and queueing such a job does not allocate memory. larger callables are
+/// stored on the heap
+class SchedulerJob {
+ public:
+  static constexpr size_t inlineSize = 48;
+
+  SchedulerJob() noexcept : _ops(nullptr), _queued(0) {}
+
+  template <typename F, typename = typename std::enable_if<!std::is_same<
+                            typename std::decay<F>::type, SchedulerJob>::value>::type>
+  SchedulerJob(F&& callback) : _ops(nullptr), _queued(0) {
+    typedef typename std::decay<F>::type T;
+    construct<T>(std::forward<F>(callback),
+                 std::integral_constant<bool, storedInline<T>()>());
+  }
+
+  SchedulerJob(SchedulerJob&& other) noexcept
+      : _ops(other._ops), _queued(other._queued) {
+    if (_ops != nullptr) {
+      _ops->move(&_storage, &other._storage);
+      other._ops = nullptr;
+    }
+  }
+
+  SchedulerJob(SchedulerJob const& other)
+      : _ops(nullptr), _queued(other._queued) {
+    if (other._ops != nullptr) {
+      other._ops->copy(&_storage, &other._storage);
+      _ops = other._ops;
+    }
+  }
+
+  SchedulerJob& operator=(SchedulerJob&& other) noexcept {
+    if (this != &other) {
+      reset();
+      if (other._ops != nullptr) {
+        other._ops->move(&_storage, &other._storage);
+        _ops = other._ops;
+        other._ops = nullptr;
+      }
+      _queued = other._queued;
+    }
+    return *this;
+  }
+
+  SchedulerJob& operator=(SchedulerJob const& other) {
+    if (this != &other) {
+      SchedulerJob copy(other);
+      *this = std::move(copy);
+    }
+    return *this;
+  }
+
+  ~SchedulerJob() { reset(); }
+
+  explicit operator bool() const noexcept { return _ops != nullptr; }
+
+  void operator()() const {
+    TRI_ASSERT(_ops != nullptr);
+    _ops->invoke(const_cast<Storage*>(&_storage));
+  }
+
+  /// @brief when the job was queued, in microseconds of a steady clock.
+  /// 0 if unknown
+  uint64_t queued() const noexcept { return _queued; }
+  void setQueued(uint64_t queued) noexcept { _queued = queued; }
+
+  void reset() noexcept {
+    if (_ops != nullptr) {
+      _ops->destroy(&_storage);
+      _ops = nullptr;
+    }
+  }
+
+ private:
+  typedef typename std::aligned_storage<inlineSize>::type Storage;
+
+  struct Ops {
+    void (*invoke)(void*);
+    void (*move)(void* target, void* source) noexcept;
+    void (*copy)(void* target, void const* source);
+    void (*destroy)(void*) noexcept;
+  };
+
+  template <typename T>
+  static constexpr bool storedInline() {
+    return sizeof(T) <= inlineSize &&
+           alignof(T) <= alignof(Storage) &&
+           std::is_nothrow_move_constructible<T>::value;
+  }
+
+  // the callable lives in the storage
+  template <typename T>
+  struct InlineOps {
+    static void invoke(void* p) { (*static_cast<T*>(p))(); }
+    static void move(void* target, void* source) noexcept {
+      new (target) T(std::move(*static_cast<T*>(source)));
+      static_cast<T*>(source)->~T();
+    }
+    static void copy(void* target, void const* source) {
+      new (target) T(*static_cast<T const*>(source));
+    }
+    static void destroy(void* p) noexcept { static_cast<T*>(p)->~T(); }
+    static Ops const ops;
+  };
+
+  // the storage holds a pointer to the callable
+  template <typename T>
+  struct HeapOps {
+    static void invoke(void* p) { (**static_cast<T**>(p))(); }
+    static void move(void* target, void* source) noexcept {
+      *static_cast<T**>(target) = *static_cast<T**>(source);
+    }
+    static void copy(void* target, void const* source) {
+      *static_cast<T**>(target) = new T(**static_cast<T* const*>(source));
+    }
+    static void destroy(void* p) noexcept { delete *static_cast<T**>(p); }
+    static Ops const ops;
+  };
+
+  template <typename T, typename F>
+  void construct(F&& callback, std::true_type) {
+    new (&_storage) T(std::forward<F>(callback));
+    _ops = &InlineOps<T>::ops;
+  }
+
+  template <typename T, typename F>
+  void construct(F&& callback, std::false_type) {
+    *reinterpret_cast<T**>(&_storage) = new T(std::forward<F>(callback));
+    _ops = &HeapOps<T>::ops;
+  }
+
+ private:
+  Storage _storage;
+  Ops const* _ops;
+  uint64_t _queued;
+};
+
+template <typename T>
+SchedulerJob::Ops const SchedulerJob::InlineOps<T>::ops = {
+    &SchedulerJob::InlineOps<T>::invoke, &SchedulerJob::InlineOps<T>::move,
+    &SchedulerJob::InlineOps<T>::copy, &SchedulerJob::InlineOps<T>::destroy};
+
+template <typename T>
+SchedulerJob::Ops const SchedulerJob::HeapOps<T>::ops = {
+    &SchedulerJob::HeapOps<T>::invoke, &SchedulerJob::HeapOps<T>::move,
+    &SchedulerJob::HeapOps<T>::copy, &SchedulerJob::HeapOps<T>::destroy};
+
+/// @brief bounded multi-producer multi-consumer queue of Scheduler jobs.
+/// the jobs are stored in a ring of preallocated cells, each with a sequence
+/// number telling producers and consumers whether it is free or filled. push
+/// and pop only contend on their own position counter, and pushing to a full
+/// queue fails instead of growing it, so the caller can reject the job
+class JobQueue {
+ public:
+  JobQueue(JobQueue const&) = delete;
+  JobQueue& operator=(JobQueue const&) = delete;
+
+  /// @brief the capacity is rounded up to the next power of two
+  explicit JobQueue(size_t capacity) : _mask(0), _enqueuePos(0), _dequeuePos(0) {
+    size_t size = 2;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    _mask = size - 1;
+    _cells.reset(new Cell[size]);
+    for (size_t i = 0; i < size; ++i) {
+      _cells[i]._sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  size_t capacity() const noexcept { return _mask + 1; }
+
+  /// @brief approximate number of queued jobs
+  size_t size() const noexcept {
+    size_t const dequeuePos = _dequeuePos.load(std::memory_order_relaxed);
+    size_t const enqueuePos = _enqueuePos.load(std::memory_order_relaxed);
+    return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+  }
+
+  bool empty() const noexcept { return size() == 0; }
+
+  /// @brief returns false if the queue is full, the job is left untouched
+  /// in this case
+  bool push(SchedulerJob& job) noexcept {
+    Cell* cell;
+    size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+    while (true) {
+      cell = &_cells[pos & _mask];
+      size_t const seq = cell->_sequence.load(std::memory_order_acquire);
+      intptr_t const diff =
+          static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (_enqueuePos.compare_exchange_weak(pos, pos + 1,
+                                              std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = _enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+    cell->_job = std::move(job);
+    cell->_sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// @brief returns false if the queue is empty
+  bool pop(SchedulerJob& job) noexcept {
+    Cell* cell;
+    size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+    while (true) {
+      cell = &_cells[pos & _mask];
+      size_t const seq = cell->_sequence.load(std::memory_order_acquire);
+      intptr_t const diff =
+          static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (_dequeuePos.compare_exchange_weak(pos, pos + 1,
+                                              std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = _dequeuePos.load(std::memory_order_relaxed);
+      }
+    }
+    job = std::move(cell->_job);
+    cell->_sequence.store(pos + _mask + 1, std::memory_order_release);
+    return true;
+  }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> _sequence;
+    SchedulerJob _job;
+  };
+
+  std::unique_ptr<Cell[]> _cells;
+  size_t _mask;
+  // keep producers and consumers on different cache lines
+  char _padding1[64];
+  std::atomic<size_t> _enqueuePos;
+  char _padding2[64];
+  std::atomic<size_t> _dequeuePos;
+};
+
+}  // namespace rest
+}  // namespace arangodb
+
+#endif
@@ -37,11 +37,12 @@ using namespace arangodb::rest;
 // --SECTION--                                      constructors and destructors
 // -----------------------------------------------------------------------------
 
-ListenTask::ListenTask(Scheduler* scheduler, Endpoint* endpoint)
+ListenTask::ListenTask(Scheduler* scheduler, Endpoint* endpoint,
+                       size_t ioContext)
     : Task(scheduler, "ListenTask"),
       _endpoint(endpoint),
       _bound(false),
-      _acceptor(Acceptor::factory(scheduler, endpoint)) {}
+      _acceptor(Acceptor::factory(scheduler, endpoint, ioContext)) {}
 
 ListenTask::~ListenTask() {}
 
@@ -27,11 +27,18 @@
 #include <velocypack/Builder.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <chrono>
 #include <thread>
 
+#ifndef _WIN32
+#include <time.h>
+#endif
+
 #include "Basics/MutexLocker.h"
+#include "Basics/ReadLocker.h"
 #include "Basics/StringUtils.h"
 #include "Basics/Thread.h"
+#include "Basics/WriteLocker.h"
 #include "GeneralServer/RestHandler.h"
 #include "Logger/Logger.h"
 #include "Random/RandomGenerator.h"
@@ -47,6 +54,31 @@ using namespace arangodb::rest;
 
 namespace {
 constexpr double MIN_SECONDS = 30.0;
+
+// below this share of their run time on the CPU, jobs count as blocked
+constexpr double BLOCKED_UTILIZATION = 0.5;
+
+uint64_t steadyMicros() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+// CPU time of the current thread. without a per-thread CPU clock, the
+// jobs never count as blocked
+uint64_t threadCpuMicros() {
+#if defined(_WIN32) || !defined(CLOCK_THREAD_CPUTIME_ID)
+  return steadyMicros();
+#else
+  struct timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+    return steadyMicros();
+  }
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000ULL +
+         static_cast<uint64_t>(ts.tv_nsec) / 1000ULL;
+#endif
+}
 }
 
 // -----------------------------------------------------------------------------
@@ -81,6 +113,40 @@ class SchedulerManagerThread final : public Thread {
 };
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                          IoThread
+// -----------------------------------------------------------------------------
+
+namespace {
+class IoThread final : public Thread {
+ public:
+  IoThread(Scheduler* scheduler, asio_ns::io_context* service)
+      : Thread("SchedulerIo", true), _scheduler(scheduler), _service(service) {}
+
+  ~IoThread() { shutdown(); }
+
+ public:
+  void run() override {
+    while (!_scheduler->isStopping()) {
+      try {
+        _service->run_one();
+      } catch (std::exception const& ex) {
+        LOG_TOPIC(ERR, Logger::THREADS) << "io loop caught exception: "
+                                        << ex.what();
+      } catch (...) {
+        LOG_TOPIC(ERR, Logger::THREADS) << "io loop caught unknown exception";
+      }
+    }
+
+    _scheduler->ioThreadHasStopped();
+  }
+
+ private:
+  Scheduler* _scheduler;
+  asio_ns::io_context* _service;
+};
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   SchedulerThread
 // -----------------------------------------------------------------------------
@@ -111,9 +177,17 @@ class SchedulerThread : public Thread {
     size_t counter = 0;
     bool doDecrement = true;
 
+    _scheduler->attachLocalQueue();
+
     while (!_scheduler->isStopping()) {
       try {
-        _service->run_one();
+        if (_scheduler->hasLocalJobs()) {
+          // do not block in the io_context while local jobs are waiting
+          _service->poll_one();
+        } else {
+          _service->run_one();
+        }
+        _scheduler->runLocalJobs();
       } catch (std::exception const& ex) {
         LOG_TOPIC(ERR, Logger::THREADS) << "scheduler loop caught exception: "
                                         << ex.what();
@@ -127,6 +201,12 @@ class SchedulerThread : public Thread {
       } catch (...) {
       }
 
+      if (_scheduler->threadShouldYield()) {
+        // nrRunning was decremented already. now exit thread
+        doDecrement = false;
+        break;
+      }
+
       if (++counter > everyXSeconds) {
         counter = 0;
 
@@ -148,6 +228,8 @@ class SchedulerThread : public Thread {
       }
     }
 
+    _scheduler->detachLocalQueue();
+
     LOG_TOPIC(DEBUG, Logger::THREADS) << "stopped (" << _scheduler->infoStatus()
                                       << ")";
 
@@ -167,20 +249,34 @@ class SchedulerThread : public Thread {
 // --SECTION--                                                         Scheduler
 // -----------------------------------------------------------------------------
 
+thread_local Scheduler::LocalQueue* Scheduler::_localQueue = nullptr;
+
 Scheduler::Scheduler(uint64_t nrMinimum, uint64_t nrMaximum,
                      uint64_t maxQueueSize, uint64_t fifo1Size,
-                     uint64_t fifo2Size)
+                     uint64_t fifo2Size, uint64_t ioContexts,
+                     uint64_t ioThreads, uint64_t adaptiveThreads,
+                     double waitTarget)
     : _maxQueueSize(maxQueueSize),
       _counters(0),
-      _maxFifoSize{fifo1Size, fifo2Size},
-      _fifo1(_maxFifoSize[0]),
-      _fifo2(_maxFifoSize[1]),
+      _fifo1(static_cast<size_t>(fifo1Size)),
+      _fifo2(static_cast<size_t>(fifo2Size)),
       _fifos{&_fifo1, &_fifo2},
+      _numIoContexts(ioContexts > 1 ? ioContexts : 0),
+      _ioThreads(ioThreads > 0 ? ioThreads : 1),
+      _ioThreadsRunning(0),
       _minThreads(nrMinimum),
       _maxThreads(nrMaximum),
-      _lastAllBusyStamp(0.0) {
-  _fifoSize[0] = 0;
-  _fifoSize[1] = 0;
+      _lastAllBusyStamp(0.0),
+      _adaptiveThreads(adaptiveThreads),
+      _waitTarget(static_cast<uint64_t>(waitTarget * 1000000.0)),
+      _jobWallTime(0),
+      _jobCpuTime(0),
+      _lastWaitTime(0),
+      _lastUtilization(1.0),
+      _stopRequests(0) {
+  for (auto& it : _waitTimes) {
+    it.store(0);
+  }
 
   // setup signal handlers
   initializeSignalHandlers();
@@ -192,19 +288,11 @@ Scheduler::~Scheduler() {
   _managerGuard.reset();
   _managerContext.reset();
 
+  _ioGuards.clear();
+  _ioContexts.clear();
+
   _serviceGuard.reset();
   _ioContext.reset();
-
-  FifoJob* job = nullptr;
-
-  for (int i = 0; i < NUMBER_FIFOS; ++i) {
-    _fifoSize[i] = 0;
-
-    while (_fifos[i]->pop(job) && job != nullptr) {
-      delete job;
-      job = nullptr;
-    }
-  }
 }
 
 // do not pass callback by reference, might get deleted before execution
@@ -248,29 +336,49 @@ void Scheduler::post(asio_ns::io_context::strand& strand,
   }
 }
 
-bool Scheduler::queue(RequestPriority prio,
-                      std::function<void()> const& callback) {
+// do not pass job by reference, might get deleted before execution
+void Scheduler::postJob(SchedulerJob job) {
+  incQueued();
+
+  try {
+    // capture without self, ioContext will not live longer than scheduler
+    _ioContext.get()->post([this, job]() { runJob(job); });
+  } catch (...) {
+    decQueued();
+    throw;
+  }
+}
+
+bool Scheduler::queue(RequestPriority prio, SchedulerJob job) {
   bool ok = true;
 
+  if (_adaptiveThreads > 0) {
+    job.setQueued(steadyMicros());
+  }
+
   switch (prio) {
     case RequestPriority::HIGH:
-      if (0 < _fifoSize[0]) {
-        ok = pushToFifo(static_cast<int>(prio), callback);
+      if (!_fifo1.empty()) {
+        ok = pushToFifo(static_cast<int>(prio), job);
       } else if (canPostDirectly()) {
-        post(callback);
+        if (!pushToLocal(prio, job)) {
+          postJob(std::move(job));
+        }
       } else {
-        ok = pushToFifo(static_cast<int>(prio), callback);
+        ok = pushToFifo(static_cast<int>(prio), job);
       }
       break;
     case RequestPriority::LOW:
-      if (0 < _fifoSize[0]) {
-        ok = pushToFifo(static_cast<int>(prio), callback);
-      } else if (0 < _fifoSize[1]) {
-        ok = pushToFifo(static_cast<int>(prio), callback);
+      if (!_fifo1.empty()) {
+        ok = pushToFifo(static_cast<int>(prio), job);
+      } else if (!_fifo2.empty()) {
+        ok = pushToFifo(static_cast<int>(prio), job);
       } else if (canPostDirectly()) {
-        post(callback);
+        if (!pushToLocal(prio, job)) {
+          postJob(std::move(job));
+        }
       } else {
-        pushToFifo(static_cast<int>(prio), callback);
+        pushToFifo(static_cast<int>(prio), job);
       }
       break;
     default:
@@ -303,10 +411,15 @@ void Scheduler::addQueueStatistics(velocypack::Builder& b) const {
   b.add("in-progress", VPackValue(static_cast<int32_t>(numWorking(counters))));
   b.add("queued", VPackValue(static_cast<int32_t>(numQueued(counters))));
   b.add("queue-size", VPackValue(static_cast<int32_t>(_maxQueueSize)));
-  b.add("current-fifo1", VPackValue(static_cast<int32_t>(_fifoSize[0])));
-  b.add("fifo1-size", VPackValue(static_cast<int32_t>(_maxFifoSize[0])));
-  b.add("current-fifo2", VPackValue(static_cast<int32_t>(_fifoSize[1])));
-  b.add("fifo2-size", VPackValue(static_cast<int32_t>(_maxFifoSize[1])));
+  b.add("current-fifo1", VPackValue(static_cast<int32_t>(_fifo1.size())));
+  b.add("fifo1-size", VPackValue(static_cast<int32_t>(_fifo1.capacity())));
+  b.add("current-fifo2", VPackValue(static_cast<int32_t>(_fifo2.size())));
+  b.add("fifo2-size", VPackValue(static_cast<int32_t>(_fifo2.capacity())));
+
+  if (_adaptiveThreads > 0) {
+    b.add("queue-wait-p90", VPackValue(_lastWaitTime.load() / 1000000.0));
+    b.add("cpu-utilization", VPackValue(_lastUtilization.load()));
+  }
 }
 
 Scheduler::QueueStatistics Scheduler::queueStatistics() const {
@@ -324,9 +437,10 @@ std::string Scheduler::infoStatus() {
          ") in-progress " + std::to_string(numWorking(counters)) + " queued " +
          std::to_string(numQueued(counters)) + " (<=" +
          std::to_string(_maxQueueSize) + ") fifo1 " +
-         std::to_string(_fifoSize[0]) + " (<=" + std::to_string(_maxFifoSize[0]) +
-         ") fifo2 " + std::to_string(_fifoSize[1]) + " (<=" +
-         std::to_string(_maxFifoSize[1]) + ")";
+         std::to_string(_fifo1.size()) + " (<=" +
+         std::to_string(_fifo1.capacity()) + ") fifo2 " +
+         std::to_string(_fifo2.size()) + " (<=" +
+         std::to_string(_fifo2.capacity()) + ")";
 }
 
 bool Scheduler::canPostDirectly() const noexcept {
@@ -337,24 +451,16 @@ bool Scheduler::canPostDirectly() const noexcept {
   return nrWorking + nrQueued <= _maxQueueSize;
 }
 
-bool Scheduler::pushToFifo(size_t fifo, std::function<void()> const& callback) {
+bool Scheduler::pushToFifo(size_t fifo, SchedulerJob& job) {
   size_t p = fifo - 1;
   TRI_ASSERT(0 < fifo && p < NUMBER_FIFOS);
 
-  auto job = std::make_unique<FifoJob>(callback);
-
   try {
-    if (0 < _maxFifoSize[p] && (int64_t)_maxFifoSize[p] <= _fifoSize[p]) {
+    // a full fifo rejects the job, the caller has to deal with it
+    if (!_fifos[p]->push(job)) {
       return false;
     }
 
-    if (!_fifos[p]->push(job.get())) {
-      return false;
-    }
-
-    job.release();
-    ++_fifoSize[p];
-
     // then check, otherwise we might miss to wake up a thread
     auto counters = getCounters();
     auto nrWorking = numRunning(counters);
@@ -374,19 +480,210 @@ bool Scheduler::popFifo(size_t fifo) {
   int64_t p = fifo - 1;
   TRI_ASSERT(0 <= p && p < NUMBER_FIFOS);
 
-  FifoJob* job = nullptr;
-  bool ok = _fifos[p]->pop(job) && job != nullptr;
+  SchedulerJob job;
+  bool ok = _fifos[p]->pop(job);
 
   if (ok) {
-    post(job->_callback);
-    delete job;
-
-    --_fifoSize[p];
+    postJob(std::move(job));
   }
 
   return ok;
 }
 
+bool Scheduler::pushToLocal(RequestPriority prio, SchedulerJob& job) {
+  LocalQueue* queue = _localQueue;
+
+  if (queue == nullptr || isStopping()) {
+    return false;
+  }
+
+  incQueued();
+
+  try {
+    MUTEX_LOCKER(locker, queue->_lock);
+    // high priority jobs are run before the low priority ones
+    if (prio == RequestPriority::HIGH) {
+      queue->_jobs.emplace_front(std::move(job));
+    } else {
+      queue->_jobs.emplace_back(std::move(job));
+    }
+  } catch (...) {
+    decQueued();
+    throw;
+  }
+
+  // let an idle thread take the job in case this thread is busy for
+  // longer or blocks
+  try {
+    _ioContext.get()->post([this]() { steal(); });
+  } catch (...) {
+    // the job will still be run by this thread
+  }
+
+  return true;
+}
+
+bool Scheduler::popLocal(LocalQueue* queue, bool front, SchedulerJob& job) {
+  MUTEX_LOCKER(locker, queue->_lock);
+
+  if (queue->_jobs.empty()) {
+    return false;
+  }
+
+  if (front) {
+    job = std::move(queue->_jobs.front());
+    queue->_jobs.pop_front();
+  } else {
+    job = std::move(queue->_jobs.back());
+    queue->_jobs.pop_back();
+  }
+
+  return true;
+}
+
+void Scheduler::runJob(SchedulerJob const& job) {
+  JobGuard guard(this);
+  guard.work();
+
+  decQueued();
+
+  if (_adaptiveThreads == 0) {
+    job();
+    return;
+  }
+
+  uint64_t const start = steadyMicros();
+  uint64_t const cpuStart = threadCpuMicros();
+
+  if (job.queued() != 0 && start >= job.queued()) {
+    recordWaitTime(start - job.queued());
+  }
+
+  auto measure = [this, start, cpuStart]() {
+    uint64_t const wall = steadyMicros() - start;
+    uint64_t const cpu = threadCpuMicros() - cpuStart;
+    _jobWallTime.fetch_add(wall, std::memory_order_relaxed);
+    _jobCpuTime.fetch_add((std::min)(cpu, wall), std::memory_order_relaxed);
+  };
+
+  try {
+    job();
+  } catch (...) {
+    measure();
+    throw;
+  }
+  measure();
+}
+
+void Scheduler::recordWaitTime(uint64_t micros) noexcept {
+  size_t bucket = 0;
+  while (bucket + 1 < WAIT_BUCKETS && (1ULL << bucket) < micros) {
+    ++bucket;
+  }
+  _waitTimes[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+void Scheduler::steal() {
+  SchedulerJob job;
+  bool found = false;
+
+  {
+    READ_LOCKER(locker, _localQueuesLock);
+    size_t const n = _localQueues.size();
+
+    // start at a different queue in every thread, so that the thieves
+    // spread over the victims
+    size_t const start = static_cast<size_t>(Thread::currentThreadNumber());
+
+    for (size_t i = 0; i < n && !found; ++i) {
+      LocalQueue* queue = _localQueues[(start + i) % n].get();
+
+      if (queue != _localQueue) {
+        found = popLocal(queue, false, job);
+      }
+    }
+  }
+
+  if (found) {
+    runJob(job);
+  }
+}
+
+void Scheduler::attachLocalQueue() {
+  TRI_ASSERT(_localQueue == nullptr);
+
+  auto queue = std::make_shared<LocalQueue>();
+
+  WRITE_LOCKER(locker, _localQueuesLock);
+  _localQueues.emplace_back(queue);
+  _localQueue = queue.get();
+}
+
+void Scheduler::detachLocalQueue() {
+  LocalQueue* queue = _localQueue;
+
+  if (queue == nullptr) {
+    return;
+  }
+
+  std::shared_ptr<LocalQueue> owned;
+
+  {
+    WRITE_LOCKER(locker, _localQueuesLock);
+
+    for (auto it = _localQueues.begin(); it != _localQueues.end(); ++it) {
+      if (it->get() == queue) {
+        owned = std::move(*it);
+        _localQueues.erase(it);
+        break;
+      }
+    }
+  }
+
+  _localQueue = nullptr;
+
+  // nobody can steal from the queue anymore, hand the remaining jobs over
+  // to the other threads
+  SchedulerJob job;
+
+  while (popLocal(queue, true, job)) {
+    decQueued();
+
+    if (!isStopping()) {
+      try {
+        postJob(std::move(job));
+      } catch (...) {
+      }
+    }
+  }
+}
+
+bool Scheduler::hasLocalJobs() {
+  LocalQueue* queue = _localQueue;
+
+  if (queue == nullptr) {
+    return false;
+  }
+
+  MUTEX_LOCKER(locker, queue->_lock);
+  return !queue->_jobs.empty();
+}
+
+void Scheduler::runLocalJobs() {
+  LocalQueue* queue = _localQueue;
+
+  if (queue == nullptr) {
+    return;
+  }
+
+  SchedulerJob job;
+
+  for (size_t i = 0;
+       i < LOCAL_BATCH_SIZE && popLocal(queue, true, job); ++i) {
+    runJob(job);
+  }
+}
+
 void Scheduler::initializeSignalHandlers() {
 #ifdef _WIN32
 // Windows does not support POSIX signal handling
@@ -410,6 +707,7 @@ void Scheduler::initializeSignalHandlers() {
 bool Scheduler::start() {
   // start the I/O
   startIoService();
+  startIoThreads();
 
   TRI_ASSERT(0 < _minThreads);
   TRI_ASSERT(_minThreads <= _maxThreads);
@@ -451,6 +749,11 @@ void Scheduler::beginShutdown() {
   _serviceGuard.reset();
   _ioContext->stop();
 
+  _ioGuards.clear();
+  for (auto& context : _ioContexts) {
+    context->stop();
+  }
+
   // set the flag AFTER stopping the threads
   setStopping();
 }
@@ -459,7 +762,8 @@ void Scheduler::shutdown() {
   while (true) {
     uint64_t const counters = _counters.load();
 
-    if (numRunning(counters) == 0 && numWorking(counters) == 0) {
+    if (numRunning(counters) == 0 && numWorking(counters) == 0 &&
+        _ioThreadsRunning.load() == 0) {
       break;
     }
 
@@ -472,6 +776,7 @@ void Scheduler::shutdown() {
   }
 
   _managerContext.reset();
+  _ioContexts.clear();
   _ioContext.reset();
 }
 
@@ -481,6 +786,33 @@ void Scheduler::startIoService() {
 
   _managerContext.reset(new asio_ns::io_context());
   _managerGuard.reset(new asio_ns::io_context::work(*_managerContext));
+
+  for (uint64_t i = 0; i < _numIoContexts; ++i) {
+    _ioContexts.emplace_back(
+        new asio_ns::io_context(static_cast<int>(_ioThreads)));
+    _ioGuards.emplace_back(new asio_ns::io_context::work(*_ioContexts.back()));
+  }
+}
+
+void Scheduler::startIoThreads() {
+  for (auto& context : _ioContexts) {
+    for (uint64_t i = 0; i < _ioThreads; ++i) {
+      ++_ioThreadsRunning;
+
+      auto thread = new IoThread(this, context.get());
+      if (!thread->start()) {
+        --_ioThreadsRunning;
+        THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_FAILED,
+                                       "unable to start io thread");
+      }
+    }
+  }
+
+  if (!_ioContexts.empty()) {
+    LOG_TOPIC(DEBUG, Logger::THREADS)
+        << "started " << _ioContexts.size() << " io contexts with "
+        << _ioThreads << " threads each";
+  }
 }
 
 void Scheduler::startManagerThread() {
@@ -539,6 +871,11 @@ void Scheduler::rebalanceThreads() {
                                       << infoStatus();
   }
 
+  if (_adaptiveThreads > 0) {
+    adaptThreads(TRI_microtime());
+    return;
+  }
+
   while (true) {
     double const now = TRI_microtime();
 
@@ -591,6 +928,109 @@ void Scheduler::rebalanceThreads() {
   }
 }
 
+void Scheduler::adaptThreads(double now) {
+  // collect the wait times and the CPU share of the jobs since the last
+  // round
+  uint64_t waits[WAIT_BUCKETS];
+  uint64_t samples = 0;
+
+  for (size_t i = 0; i < WAIT_BUCKETS; ++i) {
+    waits[i] = _waitTimes[i].exchange(0, std::memory_order_relaxed);
+    samples += waits[i];
+  }
+
+  uint64_t const wall = _jobWallTime.exchange(0, std::memory_order_relaxed);
+  uint64_t const cpu = _jobCpuTime.exchange(0, std::memory_order_relaxed);
+
+  // the 90th percentile of the wait times, rounded up to its bucket
+  uint64_t waitTime = 0;
+
+  if (samples > 0) {
+    uint64_t const rank = samples - samples / 10;
+    uint64_t seen = 0;
+
+    for (size_t i = 0; i < WAIT_BUCKETS; ++i) {
+      seen += waits[i];
+
+      if (seen >= rank) {
+        waitTime = 1ULL << i;
+        break;
+      }
+    }
+  }
+
+  double const utilization =
+      wall > 0 ? static_cast<double>(cpu) / static_cast<double>(wall) : 1.0;
+
+  _lastWaitTime.store(waitTime);
+  _lastUtilization.store(utilization);
+
+  uint64_t toStart = 0;
+
+  {
+    MUTEX_LOCKER(locker, _threadCreateLock);
+
+    uint64_t const counters = _counters.load();
+
+    if (isStopping(counters)) {
+      return;
+    }
+
+    uint64_t const nrRunning = numRunning(counters);
+    uint64_t const nrWorking = numWorking(counters);
+
+    if (nrWorking >= nrRunning) {
+      _lastAllBusyStamp = now;
+    }
+
+    bool const blocked = utilization < BLOCKED_UTILIZATION;
+    uint64_t const limit = blocked ? _adaptiveThreads : _maxThreads;
+
+    if (nrWorking >= nrRunning && waitTime > _waitTarget) {
+      // all threads are busy and the jobs wait too long. grow faster
+      // for larger pools
+      if (nrRunning < limit) {
+        toStart = (std::min)((std::max)(nrRunning / 8, uint64_t(1)),
+                             limit - nrRunning);
+      }
+    } else if (!blocked && nrRunning > (std::max)(_minThreads, _maxThreads) &&
+               _stopRequests.load() == 0) {
+      // the jobs are busy on the CPU, threads beyond the regular maximum
+      // only add context switches
+      ++_stopRequests;
+    }
+
+    for (uint64_t i = 0; i < toStart; ++i) {
+      incRunning();
+    }
+  }
+
+  for (uint64_t i = 0; i < toStart; ++i) {
+    try {
+      startNewThread();
+    } catch (...) {
+      MUTEX_LOCKER(locker, _threadCreateLock);
+      decRunning();
+    }
+  }
+}
+
+bool Scheduler::threadShouldYield() {
+  if (_stopRequests.load(std::memory_order_relaxed) == 0) {
+    return false;
+  }
+
+  MUTEX_LOCKER(locker, _threadCreateLock);
+
+  if (_stopRequests.load() == 0 || numRunning(_counters) <= _minThreads) {
+    return false;
+  }
+
+  --_stopRequests;
+  decRunning();
+  return true;
+}
+
 void Scheduler::threadHasStopped() {
   MUTEX_LOCKER(locker, _threadCreateLock);
   decRunning();
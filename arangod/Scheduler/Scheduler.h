@@ -27,13 +27,17 @@
 
 #include "Basics/Common.h"
 
-#include <boost/lockfree/queue.hpp>
+
+#include <array>
+#include <deque>
 
 #include "Basics/Mutex.h"
+#include "Basics/ReadWriteLock.h"
 #include "Basics/asio_ns.h"
 #include "Basics/socket-utils.h"
 #include "Endpoint/Endpoint.h"
 #include "GeneralServer/RequestLane.h"
+#include "Scheduler/JobQueue.h"
 
 namespace arangodb {
 class JobGuard;
@@ -58,7 +62,8 @@ class Scheduler {
 
  public:
   Scheduler(uint64_t minThreads, uint64_t maxThreads, uint64_t maxQueueSize,
-            uint64_t fifo1Size, uint64_t fifo2Size);
+            uint64_t fifo1Size, uint64_t fifo2Size, uint64_t ioContexts,
+            uint64_t ioThreads, uint64_t adaptiveThreads, double waitTarget);
   virtual ~Scheduler();
 
   // queue handling:
@@ -83,6 +88,22 @@ class Scheduler {
   // and the number of queues jobs it will either queue the job
   // directly in the Scheduler queue or move it to the corresponding
   // FIFO.
+  //
+  // Jobs that `queue` would post directly are instead put into the
+  // local queue of the calling thread if that is a Scheduler thread, so
+  // that the continuations of a request run on the thread that started
+  // it, without touching the shared structures. Every such job also posts
+  // a steal call to the `io_context`, which lets an idle thread take a
+  // job from the local queue of a busy or blocked one. A steal call
+  // finding nothing just returns.
+  //
+  // If more than one I/O context is configured, the connections do not
+  // use the Scheduler queue but a number of separate `io_context`s, each
+  // served by its own group of threads. Every TCP endpoint then has one
+  // SO_REUSEPORT acceptor per I/O context, so that the kernel spreads the
+  // incoming connections over them, and a connection stays on the context
+  // of its acceptor for its lifetime. The jobs of the requests are still
+  // queued in the Scheduler queue.
 
  public:
   struct QueueStatistics {
@@ -95,7 +116,7 @@ class Scheduler {
   void post(asio_ns::io_context::strand&,
             std::function<void()> const& callback);
 
-  bool queue(RequestPriority prio, std::function<void()> const&);
+  bool queue(RequestPriority prio, SchedulerJob job);
   void drain();
 
   void addQueueStatistics(velocypack::Builder&) const;
@@ -172,65 +193,107 @@ class Scheduler {
   inline uint64_t getCounters() const noexcept { return _counters; }
 
   // the fifos will collect the outstand requests in case the Scheduler
-  // queue is full
+  // queue is full. they are bounded, a job that does not fit is rejected
 
-  struct FifoJob {
-    explicit FifoJob(std::function<void()> const& callback) : _callback(callback) {}
-    std::function<void()> _callback;
-  };
-
-  bool pushToFifo(size_t fifo, std::function<void()> const& callback);
+  void postJob(SchedulerJob job);
+  bool pushToFifo(size_t fifo, SchedulerJob& job);
   bool popFifo(size_t fifo);
 
   static int64_t const NUMBER_FIFOS = 2;
-  uint64_t const _maxFifoSize[NUMBER_FIFOS];
-  std::atomic<int64_t> _fifoSize[NUMBER_FIFOS];
-  boost::lockfree::queue<FifoJob*> _fifo1;
-  boost::lockfree::queue<FifoJob*> _fifo2;
-  boost::lockfree::queue<FifoJob*>* _fifos[NUMBER_FIFOS];
+  JobQueue _fifo1;
+  JobQueue _fifo2;
+  JobQueue* _fifos[NUMBER_FIFOS];
+
+  // the local queue of a Scheduler thread. the owner takes jobs from the
+  // front, other threads steal from the back
+  struct LocalQueue {
+    Mutex _lock;
+    std::deque<SchedulerJob> _jobs;
+  };
+
+  bool pushToLocal(RequestPriority prio, SchedulerJob& job);
+  bool popLocal(LocalQueue* queue, bool front, SchedulerJob& job);
+  void runJob(SchedulerJob const& job);
+  void steal();
+
+  // maximum number of local jobs a thread runs before it polls the
+  // `io_context` again
+  static size_t const LOCAL_BATCH_SIZE = 16;
+
+  // the local queues of all Scheduler threads
+  basics::ReadWriteLock _localQueuesLock;
+  std::vector<std::shared_ptr<LocalQueue>> _localQueues;
+
+  // the local queue of the current thread, nullptr if this is not a
+  // Scheduler thread
+  static thread_local LocalQueue* _localQueue;
+
+ public:
+  // called by the Scheduler threads when they start and before they stop.
+  // the jobs left in the local queue of a stopping thread are posted to
+  // the `io_context`
+  void attachLocalQueue();
+  void detachLocalQueue();
+
+  // whether or not the local queue of the current thread has jobs
+  bool hasLocalJobs();
+
+  // run up to LOCAL_BATCH_SIZE jobs of the local queue of the current thread
+  void runLocalJobs();
 
   // the following methds create tasks in the `io_context`.
   // The `io_context` itself is not exposed because everything
-  // should use the method `post` of the Scheduler.
+  // should use the method `post` of the Scheduler. The methods taking
+  // an I/O context number create the object in that I/O context, or in
+  // the Scheduler queue if there are no separate I/O contexts.
 
  public:
+  // number of separate I/O contexts, 0 if the connections use the
+  // Scheduler queue
+  size_t numIoContexts() const { return _ioContexts.size(); }
+
   template <typename T>
   asio_ns::deadline_timer* newDeadlineTimer(T timeout) {
     return new asio_ns::deadline_timer(*_ioContext, timeout);
   }
 
+  template <typename T>
+  asio_ns::deadline_timer* newConnectionTimer(T timeout, size_t ioContext) {
+    return new asio_ns::deadline_timer(connectionContext(ioContext), timeout);
+  }
+
   asio_ns::steady_timer* newSteadyTimer() {
     return new asio_ns::steady_timer(*_ioContext);
   }
 
-  asio_ns::io_context::strand* newStrand() {
-    return new asio_ns::io_context::strand(*_ioContext);
+  asio_ns::io_context::strand* newStrand(size_t ioContext = 0) {
+    return new asio_ns::io_context::strand(connectionContext(ioContext));
   }
 
-  asio_ns::ip::tcp::acceptor* newAcceptor() {
-    return new asio_ns::ip::tcp::acceptor(*_ioContext);
+  asio_ns::ip::tcp::acceptor* newAcceptor(size_t ioContext = 0) {
+    return new asio_ns::ip::tcp::acceptor(connectionContext(ioContext));
   }
 
 #ifndef _WIN32
   asio_ns::local::stream_protocol::acceptor* newDomainAcceptor() {
-    return new asio_ns::local::stream_protocol::acceptor(*_ioContext);
+    return new asio_ns::local::stream_protocol::acceptor(connectionContext(0));
   }
 #endif
 
-  asio_ns::ip::tcp::socket* newSocket() {
-    return new asio_ns::ip::tcp::socket(*_ioContext);
+  asio_ns::ip::tcp::socket* newSocket(size_t ioContext = 0) {
+    return new asio_ns::ip::tcp::socket(connectionContext(ioContext));
   }
 
 #ifndef _WIN32
   asio_ns::local::stream_protocol::socket* newDomainSocket() {
-    return new asio_ns::local::stream_protocol::socket(*_ioContext);
+    return new asio_ns::local::stream_protocol::socket(connectionContext(0));
   }
 #endif
 
   asio_ns::ssl::stream<asio_ns::ip::tcp::socket>* newSslSocket(
-      asio_ns::ssl::context& context) {
-    return new asio_ns::ssl::stream<asio_ns::ip::tcp::socket>(*_ioContext,
-                                                              context);
+      asio_ns::ssl::context& context, size_t ioContext = 0) {
+    return new asio_ns::ssl::stream<asio_ns::ip::tcp::socket>(
+        connectionContext(ioContext), context);
   }
 
   asio_ns::ip::tcp::resolver* newResolver() {
@@ -242,6 +305,13 @@ class Scheduler {
   }
 
  private:
+  asio_ns::io_context& connectionContext(size_t ioContext) const {
+    if (_ioContexts.empty()) {
+      return *_ioContext;
+    }
+    return *_ioContexts[ioContext % _ioContexts.size()];
+  }
+
   static void initializeSignalHandlers();
 
   // `start`will start the Scheduler threads
@@ -256,6 +326,7 @@ class Scheduler {
 
  private:
   void startIoService();
+  void startIoThreads();
   void startManagerThread();
   void startRebalancer();
 
@@ -266,6 +337,20 @@ class Scheduler {
   std::shared_ptr<asio_ns::io_context::work> _serviceGuard;
   std::unique_ptr<asio_ns::io_context> _ioContext;
 
+  // the separate I/O contexts of the connections, and the number of
+  // threads serving each of them
+  uint64_t const _numIoContexts;
+  uint64_t const _ioThreads;
+  std::vector<std::shared_ptr<asio_ns::io_context::work>> _ioGuards;
+  std::vector<std::unique_ptr<asio_ns::io_context>> _ioContexts;
+
+ public:
+  // decrements the number of running I/O threads
+  void ioThreadHasStopped() noexcept { --_ioThreadsRunning; }
+
+ private:
+  std::atomic<uint64_t> _ioThreadsRunning;
+
   std::shared_ptr<asio_ns::io_context::work> _managerGuard;
   std::unique_ptr<asio_ns::io_context> _managerContext;
 
@@ -287,15 +372,51 @@ class Scheduler {
   // already decremented the nrRunning counter!
   bool threadShouldStop(double now);
 
+  // check if the current thread should stop because the adaptive sizing
+  // shrinks the pool. when the function returns true, it has already
+  // decremented the nrRunning counter!
+  bool threadShouldYield();
+
  private:
   void startNewThread();
 
+  // adaptive sizing of the thread pool, see `adaptThreads`
+  void recordWaitTime(uint64_t micros) noexcept;
+  void adaptThreads(double now);
+
  private:
   uint64_t const _minThreads;
   uint64_t const _maxThreads;
 
   mutable Mutex _threadCreateLock;
   double _lastAllBusyStamp;
+
+  // With adaptive sizing, the rebalancer does not only look at the number
+  // of busy threads, but also at the time the jobs waited in the queue and
+  // at the share of their run time they spent on the CPU. If jobs wait
+  // too long and all threads are busy, threads are added: up to
+  // `_maxThreads` if the jobs use the CPU, and up to `_adaptiveThreads`
+  // if they mostly block, e.g. in V8 or waiting for other servers. If the
+  // jobs use the CPU and there are more than `_maxThreads` threads, the
+  // extra threads only add context switches and are stopped again.
+  uint64_t const _adaptiveThreads;
+  uint64_t const _waitTarget;
+
+  // wait times of the jobs since the last round, bucket i counts the
+  // waits of at most 2^i microseconds
+  static size_t const WAIT_BUCKETS = 20;
+  std::array<std::atomic<uint64_t>, WAIT_BUCKETS> _waitTimes;
+
+  // wall clock and CPU time of the jobs since the last round
+  std::atomic<uint64_t> _jobWallTime;
+  std::atomic<uint64_t> _jobCpuTime;
+
+  // the results of the last round
+  std::atomic<uint64_t> _lastWaitTime;
+  std::atomic<double> _lastUtilization;
+
+  // number of threads the adaptive sizing wants to stop
+  std::atomic<uint64_t> _stopRequests;
 };
 }
 }
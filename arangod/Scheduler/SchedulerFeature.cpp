@@ -79,6 +79,32 @@ void SchedulerFeature::collectOptions(
   options->addHiddenOption("--server.prio2-size", "size of the priority 2 fifo",
                            new UInt64Parameter(&_fifo2Size));
 
+  options->addOption("--server.io-contexts",
+                     "number of separate I/O contexts for the connections, "
+                     "each with its own SO_REUSEPORT acceptor per endpoint "
+                     "(1 = connections share the scheduler threads)",
+                     new UInt64Parameter(&_ioContexts));
+
+  options->addOption("--server.io-threads",
+                     "number of threads per I/O context, if there is more "
+                     "than one",
+                     new UInt64Parameter(&_ioThreads));
+
+  options->addOption("--server.adaptive-threads",
+                     "size the thread pool by the queue wait times of the "
+                     "jobs and their CPU usage",
+                     new BooleanParameter(&_adaptiveThreads));
+
+  options->addOption("--server.adaptive-threads-limit",
+                     "maximum number of threads with adaptive sizing if the "
+                     "jobs block (0 = four times --server.threads)",
+                     new UInt64Parameter(&_adaptiveThreadsLimit));
+
+  options->addHiddenOption("--server.queue-wait-target",
+                           "queue wait time in seconds above which adaptive "
+                           "sizing adds threads",
+                           new DoubleParameter(&_queueWaitTarget));
+
   options->addHiddenOption("--server.minimal-threads",
                            "minimal number of threads",
                            new UInt64Parameter(&_nrMinimalThreads));
@@ -109,6 +135,34 @@ void SchedulerFeature::validateOptions(
   if (_fifo2Size < 1) {
     _fifo2Size = 1;
   }
+
+  if (_adaptiveThreadsLimit == 0) {
+    _adaptiveThreadsLimit = 4 * _nrMaximalThreads;
+  }
+
+  // the thread counters of the scheduler have 16 bits
+  _adaptiveThreadsLimit = (std::min)(
+      (std::max)(_adaptiveThreadsLimit, _nrMaximalThreads), uint64_t(4096));
+
+  if (_queueWaitTarget <= 0.0) {
+    _queueWaitTarget = 0.005;
+  }
+
+  if (_ioContexts < 1) {
+    _ioContexts = 1;
+  }
+
+  if (_ioThreads < 1) {
+    _ioThreads = 1;
+  }
+
+#ifndef SO_REUSEPORT
+  if (_ioContexts > 1) {
+    LOG_TOPIC(WARN, arangodb::Logger::THREADS)
+        << "--server.io-contexts is not supported on this platform, using 1";
+    _ioContexts = 1;
+  }
+#endif
 }
 
 void SchedulerFeature::start() {
@@ -287,7 +341,12 @@ bool CtrlHandler(DWORD eventType) {
 
 void SchedulerFeature::buildScheduler() {
   _scheduler = std::make_unique<Scheduler>(_nrMinimalThreads, _nrMaximalThreads,
-                                           _queueSize, _fifo1Size, _fifo2Size);
+                                           _queueSize, _fifo1Size, _fifo2Size,
+                                           _ioContexts, _ioThreads,
+                                           _adaptiveThreads
+                                               ? _adaptiveThreadsLimit
+                                               : 0,
+                                           _queueWaitTarget);
 
   SCHEDULER = _scheduler.get();
 }
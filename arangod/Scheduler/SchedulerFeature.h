@@ -58,6 +58,11 @@ class SchedulerFeature final : public application_features::ApplicationFeature {
   uint64_t _queueSize = 128;
   uint64_t _fifo1Size = 16 * 4096;
   uint64_t _fifo2Size = 4096;
+  uint64_t _ioContexts = 1;
+  uint64_t _ioThreads = 1;
+  bool _adaptiveThreads = false;
+  uint64_t _adaptiveThreadsLimit = 0;
+  double _queueWaitTarget = 0.005;
 
  public:
   size_t concurrency() const { return static_cast<size_t>(_nrMaximalThreads); }
@@ -39,11 +39,15 @@ typedef std::function<void(const asio_ns::error_code& ec,
                            std::size_t transferred)>
     AsyncHandler;
 
+// a sequence of buffers which is written with a single gather write
+typedef std::vector<asio_ns::const_buffer> ConstBuffers;
+
 class Socket {
  public:
-  Socket(rest::Scheduler* scheduler, bool encrypted)
-      : _strand(scheduler->newStrand()),
+  Socket(rest::Scheduler* scheduler, bool encrypted, size_t ioContext = 0)
+      : _strand(scheduler->newStrand(ioContext)),
         _encrypted(encrypted),
+        _ioContext(ioContext),
         _scheduler(scheduler) {
     TRI_ASSERT(_scheduler != nullptr);
   }
@@ -55,6 +59,9 @@ class Socket {
 
   bool isEncrypted() const { return _encrypted; }
 
+  // the I/O context the socket and its strand belong to
+  size_t ioContext() const { return _ioContext; }
+
   bool handshake() {
     if (!_encrypted || _handshakeDone) {
       return true;
@@ -94,9 +101,9 @@ class Socket {
   virtual std::string peerAddress() const = 0;
   virtual int peerPort() const = 0;
   virtual void setNonBlocking(bool) = 0;
-  virtual size_t writeSome(basics::StringBuffer* buffer,
+  virtual size_t writeSome(ConstBuffers const& buffers,
                            asio_ns::error_code& ec) = 0;
-  virtual void asyncWrite(asio_ns::mutable_buffers_1 const& buffer,
+  virtual void asyncWrite(ConstBuffers const& buffers,
                           AsyncHandler const& handler) = 0;
   virtual size_t readSome(asio_ns::mutable_buffers_1 const& buffer,
                           asio_ns::error_code& ec) = 0;
@@ -117,6 +124,7 @@ class Socket {
  private:
   bool const _encrypted;
   bool _handshakeDone = false;
+  size_t const _ioContext;
   rest::Scheduler* _scheduler;
 };
 }
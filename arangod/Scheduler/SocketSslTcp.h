@@ -33,10 +33,11 @@ class SocketSslTcp final : public Socket {
   friend class AcceptorTcp;
 
  public:
-  SocketSslTcp(rest::Scheduler* scheduler, asio_ns::ssl::context&& context)
-      : Socket(scheduler, /*encrypted*/ true),
+  SocketSslTcp(rest::Scheduler* scheduler, asio_ns::ssl::context&& context,
+               size_t ioContext = 0)
+      : Socket(scheduler, /*encrypted*/ true, ioContext),
         _sslContext(std::move(context)),
-        _sslSocket(scheduler->newSslSocket(_sslContext)),
+        _sslSocket(scheduler->newSslSocket(_sslContext, ioContext)),
         _socket(_sslSocket->next_layer()),
         _peerEndpoint() {}
 
@@ -53,15 +54,14 @@ class SocketSslTcp final : public Socket {
 
   void setNonBlocking(bool v) override { _socket.non_blocking(v); }
 
-  size_t writeSome(basics::StringBuffer* buffer,
+  size_t writeSome(ConstBuffers const& buffers,
                    asio_ns::error_code& ec) override {
-    return _sslSocket->write_some(
-        asio_ns::buffer(buffer->begin(), buffer->length()), ec);
+    return _sslSocket->write_some(buffers, ec);
   }
 
-  void asyncWrite(asio_ns::mutable_buffers_1 const& buffer,
+  void asyncWrite(ConstBuffers const& buffers,
                   AsyncHandler const& handler) override {
-    return asio_ns::async_write(*_sslSocket, buffer, _strand->wrap(handler));
+    return asio_ns::async_write(*_sslSocket, buffers, _strand->wrap(handler));
   }
 
   size_t readSome(asio_ns::mutable_buffers_1 const& buffer,
@@ -55,8 +55,10 @@ SocketTask::SocketTask(Scheduler* scheduler,
       _readBuffer(READ_BLOCK_SIZE + 1, false),
       _stringBuffers{_stringBuffersArena},
       _writeBuffer(nullptr, nullptr),
+      _writeOffset(0),
       _keepAliveTimeout(static_cast<long>(keepAliveTimeout * 1000)),
-      _keepAliveTimer(scheduler->newDeadlineTimer(_keepAliveTimeout)),
+      _keepAliveTimer(scheduler->newConnectionTimer(
+          _keepAliveTimeout, _peer != nullptr ? _peer->ioContext() : 0)),
       _useKeepAliveTimer(keepAliveTimeout > 0.0),
       _keepAliveTimerActive(false),
       _closeRequested(false),
@@ -157,10 +159,13 @@ void SocketTask::addWriteBuffer(WriteBuffer&& buffer) {
   TRI_ASSERT(!buffer.empty());
   if (!buffer.empty()) {
     if (!_writeBuffer.empty()) {
+      // an ongoing write picks it up
       _writeBuffers.emplace_back(std::move(buffer));
       return;
     }
     _writeBuffer = std::move(buffer);
+    _writeOffset = 0;
+    RequestStatistics::SET_WRITE_START(_writeBuffer._statistics);
   }
 
   asyncWriteSome();
@@ -182,10 +187,72 @@ bool SocketTask::completedWriteBuffer() {
 
   _writeBuffer = std::move(_writeBuffers.front());
   _writeBuffers.pop_front();
+  _writeOffset = 0;
+  RequestStatistics::SET_WRITE_START(_writeBuffer._statistics);
 
   return true;
 }
 
+// caller must hold the _lock
+// collects the unwritten part of the current write buffer and of the
+// queued ones, so that pipelined responses are sent with a single gather
+// write. returns the number of bytes collected
+size_t SocketTask::gatherWriteBuffers(ConstBuffers& buffers) {
+  TRI_ASSERT(!_writeBuffer.empty());
+  buffers.clear();
+
+  size_t total = 0;
+  size_t offset = _writeOffset;
+  auto add = [&buffers, &total, &offset](StringBuffer const* buffer) {
+    if (buffer == nullptr) {
+      return;
+    }
+    size_t const length = buffer->length();
+    if (offset >= length) {
+      offset -= length;
+      return;
+    }
+    buffers.emplace_back(buffer->begin() + offset, length - offset);
+    total += length - offset;
+    offset = 0;
+  };
+
+  add(_writeBuffer._buffer);
+  add(_writeBuffer._body);
+  for (auto const& it : _writeBuffers) {
+    if (buffers.size() + 2 > MAX_WRITE_BUFFERS) {
+      break;
+    }
+    add(it._buffer);
+    add(it._body);
+  }
+
+  return total;
+}
+
+// caller must hold the _lock
+// accounts for written bytes, completing all write buffers which have been
+// sent entirely. returns true if there is more data to send
+bool SocketTask::advanceWriteBuffers(size_t written) {
+  while (true) {
+    size_t const remaining = _writeBuffer.length() - _writeOffset;
+
+    if (written < remaining) {
+      RequestStatistics::ADD_SENT_BYTES(_writeBuffer._statistics, written);
+      _writeOffset += written;
+      return true;
+    }
+
+    RequestStatistics::ADD_SENT_BYTES(_writeBuffer._statistics, remaining);
+    written -= remaining;
+
+    if (!completedWriteBuffer()) {
+      TRI_ASSERT(written == 0);
+      return false;
+    }
+  }
+}
+
 // caller must not hold the _lock
 void SocketTask::closeStream() {
   if (_abandoned.load(std::memory_order_acquire)) {
@@ -460,37 +527,29 @@ void SocketTask::asyncWriteSome() {
   if (_writeBuffer.empty()) {
     return;
   }
-  size_t total = _writeBuffer._buffer->length();
-  size_t written = 0;
 
   TRI_ASSERT(!_abandoned);
   TRI_ASSERT(_peer != nullptr);
 
+  ConstBuffers buffers;
   asio_ns::error_code err;
   err.clear();
   while (true) {
-    RequestStatistics::SET_WRITE_START(_writeBuffer._statistics);
-    written = _peer->writeSome(_writeBuffer._buffer, err);
+    size_t const total = gatherWriteBuffers(buffers);
+    size_t const written = _peer->writeSome(buffers, err);
 
     if (err) {
       break;
     }
 
-    RequestStatistics::ADD_SENT_BYTES(_writeBuffer._statistics, written);
+    if (!advanceWriteBuffers(written)) {
+      return;
+    }
 
     if (written != total) {
       // unable to write everything at once, might be a lot of data
-      // above code does not update the buffer positon
       break;
     }
-
-    if (!completedWriteBuffer()) {
-      return;
-    }
-
-    // try to send next buffer
-    total = _writeBuffer._buffer->length();
-    written = 0;
   }
 
   // write could have blocked which is the only acceptable error
@@ -506,10 +565,12 @@ void SocketTask::asyncWriteSome() {
   }
 
   // so the code could have blocked at this point or not all data
-  // was written in one go, begin writing at offset (written)
+  // was written in one go, continue with the remaining data. the
+  // buffers stay owned by _writeBuffer and _writeBuffers
+  gatherWriteBuffers(buffers);
   auto self = shared_from_this();
   _peer->asyncWrite(
-      asio_ns::buffer(_writeBuffer._buffer->begin() + written, total - written),
+      buffers,
       [self, this](const asio_ns::error_code& ec, std::size_t transferred) {
         JobGuard guard(_scheduler);
         guard.work();
@@ -523,10 +584,7 @@ void SocketTask::asyncWriteSome() {
           return;
         }
 
-        RequestStatistics::ADD_SENT_BYTES(_writeBuffer._statistics,
-                                          transferred);
-
-        if (completedWriteBuffer()) {
+        if (advanceWriteBuffers(transferred)) {
           _peer->post([self, this] {
             if (!_abandoned.load(std::memory_order_acquire)) {
               asyncWriteSome();
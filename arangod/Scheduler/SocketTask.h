@@ -39,6 +39,7 @@ class ConnectionStatistics;
 
 namespace rest {
 class SocketTask : virtual public Task {
+  friend class H2CommTask;
   friend class HttpCommTask;
 
   explicit SocketTask(SocketTask const&) = delete;
@@ -47,6 +48,9 @@ class SocketTask : virtual public Task {
  private:
   static size_t const READ_BLOCK_SIZE = 10000;
 
+  // maximum number of buffers passed to a single gather write
+  static size_t const MAX_WRITE_BUFFERS = 64;
+
  public:
   SocketTask(Scheduler*, std::unique_ptr<Socket>, ConnectionInfo&&,
              double keepAliveTimeout, bool skipInit);
@@ -67,19 +71,27 @@ class SocketTask : virtual public Task {
   void addToReadBuffer(char const* data, std::size_t len);
 
  protected:
+  // a buffer to send, optionally followed by a separate body buffer. the
+  // body is written from its own memory together with the buffer, so a
+  // response body does not need to be copied behind the header
   struct WriteBuffer {
     basics::StringBuffer* _buffer;
+    basics::StringBuffer* _body;
     RequestStatistics* _statistics;
 
-    WriteBuffer(basics::StringBuffer* buffer, RequestStatistics* statistics)
-        : _buffer(buffer), _statistics(statistics) {}
+    WriteBuffer(basics::StringBuffer* buffer, RequestStatistics* statistics,
+                basics::StringBuffer* body = nullptr)
+        : _buffer(buffer), _body(body), _statistics(statistics) {}
 
     WriteBuffer(WriteBuffer const&) = delete;
     WriteBuffer& operator=(WriteBuffer const&) = delete;
 
     WriteBuffer(WriteBuffer&& other) noexcept
-        : _buffer(other._buffer), _statistics(other._statistics) {
+        : _buffer(other._buffer),
+          _body(other._body),
+          _statistics(other._statistics) {
       other._buffer = nullptr;
+      other._body = nullptr;
       other._statistics = nullptr;
     }
 
@@ -90,9 +102,11 @@ class SocketTask : virtual public Task {
 
         // take over ownership from other
         _buffer = other._buffer;
+        _body = other._body;
         _statistics = other._statistics;
         // fix other
         other._buffer = nullptr;
+        other._body = nullptr;
         other._statistics = nullptr;
       }
       return *this;
@@ -102,8 +116,13 @@ class SocketTask : virtual public Task {
 
     bool empty() const noexcept { return _buffer == nullptr; }
 
+    size_t length() const noexcept {
+      return _buffer->length() + (_body == nullptr ? 0 : _body->length());
+    }
+
     void clear() noexcept {
       _buffer = nullptr;
+      _body = nullptr;
       _statistics = nullptr;
     }
 
@@ -117,6 +136,15 @@ class SocketTask : virtual public Task {
         _buffer = nullptr;
       }
 
+      if (_body != nullptr) {
+        if (task != nullptr) {
+          task->returnStringBuffer(_body);
+        } else {
+          delete _body;
+        }
+        _body = nullptr;
+      }
+
       if (_statistics != nullptr) {
         _statistics->release();
         _statistics = nullptr;
@@ -154,6 +182,8 @@ class SocketTask : virtual public Task {
 
  private:
   bool completedWriteBuffer();
+  size_t gatherWriteBuffers(ConstBuffers& buffers);
+  bool advanceWriteBuffers(size_t written);
 
   bool reserveMemory();
   bool trySyncRead();
@@ -175,6 +205,7 @@ class SocketTask : virtual public Task {
   SmallVector<basics::StringBuffer*, 32> _stringBuffers;  // needs _bufferLock
 
   WriteBuffer _writeBuffer;
+  size_t _writeOffset;  // bytes of _writeBuffer already written
   std::list<WriteBuffer> _writeBuffers;
 
   boost::posix_time::milliseconds _keepAliveTimeout;
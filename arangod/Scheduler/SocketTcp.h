@@ -33,9 +33,9 @@ class SocketTcp final : public Socket {
   friend class AcceptorTcp;
 
  public:
-  SocketTcp(rest::Scheduler* scheduler)
-      : Socket(scheduler, /*encrypted*/ false),
-        _socket(scheduler->newSocket()),
+  explicit SocketTcp(rest::Scheduler* scheduler, size_t ioContext = 0)
+      : Socket(scheduler, /*encrypted*/ false, ioContext),
+        _socket(scheduler->newSocket(ioContext)),
         _peerEndpoint() {}
 
   SocketTcp(SocketTcp const& that) = delete;
@@ -50,15 +50,14 @@ class SocketTcp final : public Socket {
 
   void setNonBlocking(bool v) override { _socket->non_blocking(v); }
 
-  size_t writeSome(basics::StringBuffer* buffer,
+  size_t writeSome(ConstBuffers const& buffers,
                    asio_ns::error_code& ec) override {
-    return _socket->write_some(
-        asio_ns::buffer(buffer->begin(), buffer->length()), ec);
+    return _socket->write_some(buffers, ec);
   }
 
-  void asyncWrite(asio_ns::mutable_buffers_1 const& buffer,
+  void asyncWrite(ConstBuffers const& buffers,
                   AsyncHandler const& handler) override {
-    return asio_ns::async_write(*_socket, buffer, _strand->wrap(handler));
+    return asio_ns::async_write(*_socket, buffers, _strand->wrap(handler));
   }
 
   size_t readSome(asio_ns::mutable_buffers_1 const& buffer,
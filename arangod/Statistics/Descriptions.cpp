@@ -367,6 +367,7 @@ void stats::Descriptions::serverStatistics(velocypack::Builder& b) const {
     b.add( "dirty", VPackValue(static_cast<int32_t>(v8Counters.dirty)));
     b.add( "free", VPackValue(static_cast<int32_t>(v8Counters.free)));
     b.add( "max", VPackValue(static_cast<int32_t>(v8Counters.max)));
+    dealer->addPoolStatistics(b);
     b.close();
   }
   
@@ -25,6 +25,9 @@
 #include "Basics/MutexLocker.h"
 #include "Logger/Logger.h"
 
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
 #include <iomanip>
 
 using namespace arangodb;
@@ -46,6 +49,35 @@ boost::lockfree::queue<RequestStatistics*,
                        boost::lockfree::capacity<RequestStatistics::QUEUE_SIZE>>
     RequestStatistics::_finishedList;
 
+arangodb::Mutex RequestStatistics::_latencyLock;
+
+std::map<std::pair<std::string, RequestLane>,
+         std::unique_ptr<RequestStatistics::Latency>>
+    RequestStatistics::_latency;
+
+namespace {
+uint64_t microseconds(double seconds) {
+  return seconds > 0.0 ? static_cast<uint64_t>(seconds * 1000000.0) : 0;
+}
+
+void histogramToVelocyPack(VPackBuilder& builder, char const* name,
+                           StatisticsHistogram const& histogram,
+                           bool isTime) {
+  // times are reported in seconds, like all other statistics
+  double const factor = isTime ? 0.000001 : 1.0;
+
+  builder.add(VPackValue(name));
+  builder.openObject();
+  builder.add("sum", VPackValue(histogram._sum.load() * factor));
+  builder.add("p50", VPackValue(histogram.percentile(0.5) * factor));
+  builder.add("p90", VPackValue(histogram.percentile(0.9) * factor));
+  builder.add("p99", VPackValue(histogram.percentile(0.99) * factor));
+  builder.add("p999", VPackValue(histogram.percentile(0.999) * factor));
+  builder.add("max", VPackValue(histogram._max.load() * factor));
+  builder.close();
+}
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                             static public methods
 // -----------------------------------------------------------------------------
@@ -151,6 +183,8 @@ void RequestStatistics::process(RequestStatistics* statistics) {
       TRI_BytesSentDistributionStatistics->addFigure(statistics->_sentBytes);
       TRI_BytesReceivedDistributionStatistics->addFigure(
           statistics->_receivedBytes);
+
+      processLatency(statistics, totalTime, requestTime, queueTime);
     }
   }
 
@@ -173,6 +207,35 @@ void RequestStatistics::process(RequestStatistics* statistics) {
   }
 }
 
+void RequestStatistics::processLatency(RequestStatistics* statistics,
+                                       double totalTime, double requestTime,
+                                       double queueTime) {
+  if (statistics->_handler == nullptr) {
+    // the request did not reach a handler
+    return;
+  }
+
+  auto key = std::make_pair(std::string(statistics->_handler),
+                            statistics->_lane);
+  auto it = _latency.find(key);
+
+  if (it == _latency.end()) {
+    auto latency = std::make_unique<Latency>();
+    MUTEX_LOCKER(locker, _latencyLock);
+    it = _latency.emplace(std::move(key), std::move(latency)).first;
+  }
+
+  Latency& latency = *it->second;
+  latency.totalTime.addFigure(microseconds(totalTime));
+  latency.requestTime.addFigure(microseconds(requestTime));
+  if (statistics->_queueStart != 0.0 && statistics->_queueEnd != 0.0) {
+    latency.queueTime.addFigure(microseconds(queueTime));
+  }
+  latency.bytesSent.addFigure(static_cast<uint64_t>(statistics->_sentBytes));
+  latency.bytesReceived.addFigure(
+      static_cast<uint64_t>(statistics->_receivedBytes));
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                    public methods
 // -----------------------------------------------------------------------------
@@ -213,6 +276,43 @@ void RequestStatistics::fill(StatisticsDistribution& totalTime,
   bytesReceived = *TRI_BytesReceivedDistributionStatistics;
 }
 
+void RequestStatistics::latencyToVelocyPack(VPackBuilder& builder) {
+  builder.openObject();
+
+  MUTEX_LOCKER(locker, _latencyLock);
+
+  // the map is ordered by handler, so that all lanes of a handler follow
+  // each other
+  std::string handler;
+  for (auto const& it : _latency) {
+    if (it.first.first != handler) {
+      if (!handler.empty()) {
+        builder.close();
+      }
+      handler = it.first.first;
+      builder.add(VPackValue(handler));
+      builder.openObject();
+    }
+
+    Latency const& latency = *it.second;
+    builder.add(VPackValue(NameRequestLane(it.first.second)));
+    builder.openObject();
+    builder.add("count", VPackValue(latency.totalTime._count.load()));
+    histogramToVelocyPack(builder, "totalTime", latency.totalTime, true);
+    histogramToVelocyPack(builder, "queueTime", latency.queueTime, true);
+    histogramToVelocyPack(builder, "requestTime", latency.requestTime, true);
+    histogramToVelocyPack(builder, "bytesSent", latency.bytesSent, false);
+    histogramToVelocyPack(builder, "bytesReceived", latency.bytesReceived,
+                          false);
+    builder.close();
+  }
+
+  if (!handler.empty()) {
+    builder.close();
+  }
+  builder.close();
+}
+
 std::string RequestStatistics::timingsCsv() {
   std::stringstream ss;
 
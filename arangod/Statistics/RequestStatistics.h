@@ -27,6 +27,7 @@
 #include "Basics/Common.h"
 
 #include "Basics/Mutex.h"
+#include "GeneralServer/RequestLane.h"
 #include "Rest/CommonDefines.h"
 #include "Statistics/StatisticsFeature.h"
 #include "Statistics/figures.h"
@@ -34,6 +35,10 @@
 #include <boost/lockfree/queue.hpp>
 
 namespace arangodb {
+namespace velocypack {
+class Builder;
+}
+
 class RequestStatistics {
  public:
   static void initialize();
@@ -61,6 +66,15 @@ class RequestStatistics {
     }
   }
 
+  /// @brief the handler name must be a string literal
+  static void SET_HANDLER(RequestStatistics* stat, char const* handler,
+                          RequestLane lane) {
+    if (stat != nullptr) {
+      stat->_handler = handler;
+      stat->_lane = lane;
+    }
+  }
+
   static void SET_READ_START(RequestStatistics* stat, double start) {
     if (stat != nullptr) {
       if (stat->_readStart == 0.0) {
@@ -154,6 +168,10 @@ class RequestStatistics {
                    basics::StatisticsDistribution& bytesSent,
                    basics::StatisticsDistribution& bytesReceived);
 
+  /// @brief percentiles of the total, queue and request times and of the
+  /// bytes sent and received, per handler and request lane
+  static void latencyToVelocyPack(velocypack::Builder& builder);
+
   std::string timingsCsv();
   std::string to_string();
   void trace_log();
@@ -174,6 +192,23 @@ class RequestStatistics {
       _finishedList;
 
   static void process(RequestStatistics*);
+  static void processLatency(RequestStatistics*, double totalTime,
+                             double requestTime, double queueTime);
+
+  /// @brief the latency histograms of a handler and lane
+  struct Latency {
+    basics::StatisticsHistogram totalTime;    // microseconds
+    basics::StatisticsHistogram queueTime;    // microseconds
+    basics::StatisticsHistogram requestTime;  // microseconds
+    basics::StatisticsHistogram bytesSent;
+    basics::StatisticsHistogram bytesReceived;
+  };
+
+  // only the statistics thread adds entries, under _latencyLock. it reads
+  // the map without the lock, all other readers must hold it
+  static arangodb::Mutex _latencyLock;
+  static std::map<std::pair<std::string, RequestLane>, std::unique_ptr<Latency>>
+      _latency;
 
   RequestStatistics() { reset(); }
 
@@ -190,6 +225,8 @@ class RequestStatistics {
     _receivedBytes = 0.0;
     _sentBytes = 0.0;
     _requestType = rest::RequestType::ILLEGAL;
+    _handler = nullptr;
+    _lane = RequestLane::CLIENT_SLOW;  // only set with _handler
     _async = false;
     _tooLarge = false;
     _executeError = false;
@@ -213,6 +250,8 @@ class RequestStatistics {
   double _sentBytes;
 
   rest::RequestType _requestType;
+  char const* _handler;  // RestHandler::name(), nullptr without a handler
+  RequestLane _lane;
 
   bool _async;
   bool _tooLarge;
@@ -0,0 +1,167 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RequestTracer.h"
+
+#include "Basics/Mutex.h"
+#include "Basics/MutexLocker.h"
+#include "Basics/StringUtils.h"
+#include "Basics/Thread.h"
+#include "Random/RandomGenerator.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+std::atomic<uint64_t> RequestTracer::_sampleRate(0);
+std::atomic<uint64_t> RequestTracer::_requests(0);
+
+namespace {
+/// @brief the spans of one thread. only its thread writes to it, the lock
+/// is contended only while the spans are collected
+struct SpanRing {
+  Mutex lock;
+  std::vector<RequestTracer::Span> spans;
+  size_t next = 0;
+};
+
+/// @brief the rings of all threads, the rings of finished threads are
+/// removed when a new thread registers
+Mutex ringsLock;
+std::vector<std::shared_ptr<SpanRing>> rings;
+
+thread_local std::shared_ptr<SpanRing> threadRing;
+
+std::string const noTraceId;
+thread_local std::string const* currentTrace = nullptr;
+
+SpanRing& ring() {
+  if (threadRing == nullptr) {
+    auto r = std::make_shared<SpanRing>();
+    r->spans.resize(RequestTracer::spansPerThread);
+
+    MUTEX_LOCKER(locker, ringsLock);
+    rings.erase(std::remove_if(rings.begin(), rings.end(),
+                               [](std::shared_ptr<SpanRing> const& it) {
+                                 return it.use_count() == 1;
+                               }),
+                rings.end());
+    rings.push_back(r);
+    threadRing = std::move(r);
+  }
+  return *threadRing;
+}
+}
+
+RequestTracer::Scope::Scope(std::string const& traceId, char const* name)
+    : _traceId(traceId.empty() ? nullptr : &traceId),
+      _previous(currentTrace),
+      _name(name),
+      _start(0.0) {
+  if (_traceId != nullptr) {
+    currentTrace = _traceId;
+    _start = TRI_microtime();
+  }
+}
+
+RequestTracer::Scope::~Scope() {
+  if (_traceId == nullptr) {
+    return;
+  }
+  currentTrace = _previous;
+  try {
+    Span span;
+    span.traceId = *_traceId;
+    span.name = _name;
+    span.start = _start;
+    span.duration = TRI_microtime() - _start;
+    span.thread = Thread::currentThreadNumber();
+    record(std::move(span));
+  } catch (...) {
+    // tracing must never fail a request
+  }
+}
+
+void RequestTracer::setSampleRate(uint64_t n) { _sampleRate.store(n); }
+
+std::string RequestTracer::sample() {
+  uint64_t rate = _sampleRate.load(std::memory_order_relaxed);
+  if (rate == 0 ||
+      (_requests.fetch_add(1, std::memory_order_relaxed) + 1) % rate != 0) {
+    return std::string();
+  }
+  return basics::StringUtils::itoa(
+      RandomGenerator::interval(UINT64_MAX));
+}
+
+std::string const& RequestTracer::currentTraceId() {
+  return currentTrace == nullptr ? noTraceId : *currentTrace;
+}
+
+void RequestTracer::record(Span&& span) {
+  SpanRing& r = ring();
+  MUTEX_LOCKER(locker, r.lock);
+  r.spans[r.next] = std::move(span);
+  r.next = (r.next + 1) % r.spans.size();
+}
+
+void RequestTracer::toVelocyPack(VPackBuilder& builder,
+                                 std::string const& traceId) {
+  std::vector<Span> spans;
+  {
+    MUTEX_LOCKER(locker, ringsLock);
+    for (auto const& r : rings) {
+      MUTEX_LOCKER(ringLocker, r->lock);
+      for (auto const& span : r->spans) {
+        if (span.name != nullptr &&
+            (traceId.empty() || span.traceId == traceId)) {
+          spans.push_back(span);
+        }
+      }
+    }
+  }
+  std::sort(spans.begin(), spans.end(), [](Span const& a, Span const& b) {
+    return a.start < b.start;
+  });
+
+  builder.openArray();
+  for (auto const& span : spans) {
+    builder.openObject();
+    builder.add("traceId", VPackValue(span.traceId));
+    builder.add("name", VPackValue(span.name));
+    builder.add("start", VPackValue(span.start));
+    builder.add("duration", VPackValue(span.duration));
+    builder.add("thread", VPackValue(span.thread));
+    builder.close();
+  }
+  builder.close();
+}
+
+void RequestTracer::clear() {
+  MUTEX_LOCKER(locker, ringsLock);
+  for (auto const& r : rings) {
+    MUTEX_LOCKER(ringLocker, r->lock);
+    for (auto& span : r->spans) {
+      span = Span();
+    }
+    r->next = 0;
+  }
+}
@@ -0,0 +1,94 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_STATISTICS_REQUEST_TRACER_H
+#define ARANGOD_STATISTICS_REQUEST_TRACER_H 1
+
+#include "Basics/Common.h"
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+}
+
+/// @brief sampled tracing of requests across servers. a traced request
+/// carries its trace id in a header, which ClusterComm passes on to the
+/// requests it sends for it. every server records the time its handlers
+/// spend on a traced request as spans, in a ring buffer per thread
+class RequestTracer {
+ public:
+  /// @brief a span of a traced request
+  struct Span {
+    std::string traceId;
+    // the name of the handler, a string literal
+    char const* name = nullptr;
+    double start = 0.0;
+    double duration = 0.0;
+    uint64_t thread = 0;
+  };
+
+  /// @brief records a span for the current thread while it lives, and
+  /// makes its trace id the current one of the thread. does nothing for
+  /// an empty trace id
+  class Scope {
+   public:
+    Scope(Scope const&) = delete;
+    Scope& operator=(Scope const&) = delete;
+
+    Scope(std::string const& traceId, char const* name);
+    ~Scope();
+
+   private:
+    std::string const* _traceId;
+    std::string const* _previous;
+    char const* _name;
+    double _start;
+  };
+
+  /// @brief number of spans each thread keeps
+  static constexpr size_t spansPerThread = 256;
+
+  /// @brief trace every n-th request that has no trace id yet, 0 to not
+  /// start traces on this server
+  static void setSampleRate(uint64_t n);
+
+  /// @brief a new trace id if the request is sampled, otherwise empty
+  static std::string sample();
+
+  /// @brief the trace id of the span the current thread is in, or empty
+  static std::string const& currentTraceId();
+
+  /// @brief adds the collected spans of all threads as an array, ordered
+  /// by their start, only those of traceId if it is not empty
+  static void toVelocyPack(velocypack::Builder&, std::string const& traceId);
+
+  /// @brief removes all collected spans
+  static void clear();
+
+  /// @brief adds a span to the ring of the current thread
+  static void record(Span&& span);
+
+ private:
+  static std::atomic<uint64_t> _sampleRate;
+  static std::atomic<uint64_t> _requests;
+};
+}
+
+#endif
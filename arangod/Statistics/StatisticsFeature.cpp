@@ -28,10 +28,14 @@
 #include "Statistics/ConnectionStatistics.h"
 #include "Statistics/Descriptions.h"
 #include "Statistics/RequestStatistics.h"
+#include "Statistics/RequestTracer.h"
 #include "Statistics/ServerStatistics.h"
 #include "Statistics/StatisticsWorker.h"
 #include "VocBase/vocbase.h"
 
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
 #include <thread>
 #include <chrono>
 
@@ -122,6 +126,7 @@ StatisticsFeature::StatisticsFeature(
     application_features::ApplicationServer* server)
     : ApplicationFeature(server, "Statistics"),
       _statistics(true),
+      _traceSampleRate(0),
       _descriptions(new stats::Descriptions()) {
   startsAfter("Logger");
   startsAfter("Aql");
@@ -136,9 +141,15 @@ void StatisticsFeature::collectOptions(
   options->addHiddenOption("--server.statistics",
                            "turn statistics gathering on or off",
                            new BooleanParameter(&_statistics));
+
+  options->addOption("--server.trace-sample-rate",
+                     "trace every n-th request, 0 turns tracing off",
+                     new UInt64Parameter(&_traceSampleRate));
 }
 
 void StatisticsFeature::prepare() {
+  RequestTracer::setSampleRate(_traceSampleRate);
+
   // initialize counters for all HTTP request types
   TRI_MethodRequestsStatistics.clear();
 
@@ -213,6 +224,14 @@ void StatisticsFeature::start() {
   }
 }
 
+void StatisticsFeature::historyToVelocyPack(VPackBuilder& builder) {
+  if (STATISTICS == nullptr || STATISTICS->_statisticsWorker == nullptr) {
+    builder.add(VPackValue(VPackValueType::Null));
+    return;
+  }
+  STATISTICS->_statisticsWorker->historyToVelocyPack(builder);
+}
+
 void StatisticsFeature::unprepare() {
   if (_statisticsThread != nullptr) {
     _statisticsThread->beginShutdown();
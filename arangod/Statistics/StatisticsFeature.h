@@ -48,6 +48,9 @@ extern std::vector<StatisticsCounter> TRI_MethodRequestsStatistics;
 namespace stats{
   class Descriptions;
 }
+namespace velocypack {
+class Builder;
+}
 
 class StatisticsThread;
 class StatisticsWorker;
@@ -79,12 +82,17 @@ class StatisticsFeature final
     }
     return nullptr;
   }
+
+  /// @brief the statistics history the worker keeps in memory, null if
+  /// there is no worker
+  static void historyToVelocyPack(velocypack::Builder&);
       
  public:
   void disableStatistics() { _statistics = false; }
 
  private:
   bool _statistics;
+  uint64_t _traceSampleRate;
 
   std::unique_ptr<stats::Descriptions> _descriptions;
   std::unique_ptr<StatisticsThread> _statisticsThread;
@@ -29,6 +29,7 @@
 #include "Aql/Query.h"
 #include "Aql/QueryString.h"
 #include "Basics/ConditionLocker.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/process-utils.h"
 #include "Cluster/ClusterFeature.h"
@@ -56,12 +57,6 @@ static std::string const statistics15Collection("_statistics15");
 static std::string const statisticsRawCollection("_statisticsRaw");
 
 static std::string const garbageCollectionQuery("FOR s in @@collection FILTER s.time < @start RETURN s._key");
-
-static std::string const lastEntryQuery("FOR s in @@collection FILTER s.time >= @start SORT s.time DESC LIMIT 1 RETURN s");
-static std::string const filteredLastEntryQuery("FOR s in @@collection FILTER s.time >= @start FILTER s.clusterId == @clusterId SORT s.time DESC LIMIT 1 RETURN s");
-
-static std::string const fifteenMinuteQuery("FOR s in _statistics FILTER s.time >= @start SORT s.time RETURN s");
-static std::string const filteredFifteenMinuteQuery("FOR s in _statistics FILTER s.time >= @start FILTER s.clusterId == @clusterId SORT s.time RETURN s");
 }
 
 using namespace arangodb;
@@ -70,6 +65,7 @@ using namespace arangodb::basics;
 StatisticsWorker::StatisticsWorker(TRI_vocbase_t& vocbase)
   : Thread("StatisticsWorker"),
     _gcTask(GC_STATS),
+    _lastAverageTime(0.0),
     _vocbase(vocbase) {
   _bytesSentDistribution.openArray();
 
@@ -172,59 +168,68 @@ void StatisticsWorker::collectGarbage(std::string const& name,
 void StatisticsWorker::historian() {
   try {
     double now = TRI_microtime();
-    std::shared_ptr<arangodb::velocypack::Builder> prevRawBuilder =
-        lastEntry(statisticsRawCollection, now - 2.0 * INTERVAL);
-    VPackSlice prevRaw = prevRawBuilder->slice();
 
     _rawBuilder.clear();
     generateRawStatistics(_rawBuilder, now);
 
-    saveSlice(_rawBuilder.slice(), statisticsRawCollection);
-
-    // create the per-seconds statistics
-    if (prevRaw.isArray() && prevRaw.length()) {
-      VPackSlice slice = prevRaw.at(0).resolveExternals();
+    // the per-seconds statistics are computed from the previous raw
+    // statistics, which are only kept in memory
+    if (!_lastRaw.isEmpty()) {
       _tempBuilder.clear();
-      computePerSeconds(_tempBuilder, _rawBuilder.slice(), slice);
+      computePerSeconds(_tempBuilder, _rawBuilder.slice(), _lastRaw.slice());
       VPackSlice perSecs = _tempBuilder.slice();
 
       if (perSecs.length()) {
         saveSlice(perSecs, statisticsCollection);
+
+        auto entry = std::make_shared<VPackBuilder>();
+        entry->add(perSecs);
+
+        MUTEX_LOCKER(locker, _historyLock);
+        _perSeconds.emplace_back(std::move(entry));
+        while (_perSeconds.front()->slice().get("time").getNumber<double>() <
+               now - HISTORY_INTERVAL) {
+          _perSeconds.pop_front();
+        }
       }
     }
+
+    std::swap(_lastRaw, _rawBuilder);
   } catch (...) {
     // errors on shutdown are expected. do not log them in case they occur
-    // if (err.errorNum !== internal.errors.ERROR_SHUTTING_DOWN.code &&
-    //     err.errorNum !==
-    //     internal.errors.ERROR_ARANGO_CORRUPTED_COLLECTION.code &&
-    //     err.errorNum !==
-    //     internal.errors.ERROR_ARANGO_CORRUPTED_DATAFILE.code) {
-    //   require('console').warn('catch error in historian: %s', err.stack);
   }
 }
 
 void StatisticsWorker::historianAverage() {
   try {
     double now = TRI_microtime();
-
-    std::shared_ptr<arangodb::velocypack::Builder> prev15Builder =
-        lastEntry(statistics15Collection, now - 2.0 * HISTORY_INTERVAL);
-    VPackSlice prev15 = prev15Builder->slice();
-
-    double start;
-    if (prev15.isArray() && prev15.length()) {
-      VPackSlice slice = prev15.at(0).resolveExternals();
-      start = slice.get("time").getNumber<double>();
-    } else {
-      start = now - HISTORY_INTERVAL;
+    double start = (_lastAverageTime > 0.0) ? _lastAverageTime
+                                            : now - HISTORY_INTERVAL;
+
+    VPackBuilder history;
+    {
+      VPackArrayBuilder guard(&history);
+      MUTEX_LOCKER(locker, _historyLock);
+      for (auto const& entry : _perSeconds) {
+        if (entry->slice().get("time").getNumber<double>() > start) {
+          history.add(entry->slice());
+        }
+      }
     }
 
     _tempBuilder.clear();
-    compute15Minute(_tempBuilder, start);
+    compute15Minute(_tempBuilder, history.slice());
     VPackSlice stat15 = _tempBuilder.slice();
 
     if (stat15.length()) {
       saveSlice(stat15, statistics15Collection);
+      _lastAverageTime = stat15.get("time").getNumber<double>();
+
+      auto average = std::make_shared<VPackBuilder>();
+      average->add(stat15);
+
+      MUTEX_LOCKER(locker, _historyLock);
+      _lastAverage = std::move(average);
     }
   } catch (velocypack::Exception const& ex) {
     LOG_TOPIC(DEBUG, Logger::STATISTICS)
@@ -237,80 +242,23 @@ void StatisticsWorker::historianAverage() {
   }
 }
 
-std::shared_ptr<arangodb::velocypack::Builder> StatisticsWorker::lastEntry(
-    std::string const& collectionName, double start) const {
-  auto queryRegistryFeature =
-      application_features::ApplicationServer::getFeature<QueryRegistryFeature>(
-          "QueryRegistry");
-  auto _queryRegistry = queryRegistryFeature->queryRegistry();
-  auto bindVars = _bindVars.get();
-
-  bindVars->clear();
-  bindVars->openObject();
-  bindVars->add("@collection", VPackValue(collectionName));
-  bindVars->add("start", VPackValue(start));
-
-  if (!_clusterId.empty()) {
-    bindVars->add("clusterId", VPackValue(_clusterId));
+void StatisticsWorker::historyToVelocyPack(VPackBuilder& builder) const {
+  MUTEX_LOCKER(locker, _historyLock);
+  builder.openObject();
+  builder.add("perSecond", VPackValue(VPackValueType::Array));
+  for (auto const& entry : _perSeconds) {
+    builder.add(entry->slice());
   }
-
-  bindVars->close();
-
-  arangodb::aql::Query query(
-    false,
-    _vocbase,
-    arangodb::aql::QueryString(
-      _clusterId.empty() ? lastEntryQuery : filteredLastEntryQuery
-    ),
-    _bindVars,
-    nullptr,
-    arangodb::aql::PART_MAIN
-  );
-
-  aql::QueryResult queryResult = query.executeSync(_queryRegistry);
-
-  if (queryResult.code != TRI_ERROR_NO_ERROR) {
-    THROW_ARANGO_EXCEPTION_MESSAGE(queryResult.code, queryResult.details);
+  builder.close();
+  if (_lastAverage != nullptr) {
+    builder.add("average", _lastAverage->slice());
+  } else {
+    builder.add("average", VPackValue(VPackValueType::Null));
   }
-
-  return queryResult.result;
+  builder.close();
 }
 
-void StatisticsWorker::compute15Minute(VPackBuilder& builder, double start) {
-  auto queryRegistryFeature =
-      application_features::ApplicationServer::getFeature<QueryRegistryFeature>(
-          "QueryRegistry");
-  auto _queryRegistry = queryRegistryFeature->queryRegistry();
-  auto bindVars = _bindVars.get();
-
-  bindVars->clear();
-  bindVars->openObject();
-  bindVars->add("start", VPackValue(start));
-
-  if (!_clusterId.empty()) {
-    bindVars->add("clusterId", VPackValue(_clusterId));
-  }
-
-  bindVars->close();
-
-  arangodb::aql::Query query(
-    false,
-    _vocbase,
-    arangodb::aql::QueryString(
-      _clusterId.empty() ? fifteenMinuteQuery : filteredFifteenMinuteQuery
-    ),
-    _bindVars,
-    nullptr,
-    arangodb::aql::PART_MAIN
-  );
-
-  aql::QueryResult queryResult = query.executeSync(_queryRegistry);
-
-  if (queryResult.code != TRI_ERROR_NO_ERROR) {
-    THROW_ARANGO_EXCEPTION_MESSAGE(queryResult.code, queryResult.details);
-  }
-
-  VPackSlice result = queryResult.result->slice();
+void StatisticsWorker::compute15Minute(VPackBuilder& builder, VPackSlice result) {
   uint64_t count = result.length();
 
   builder.clear();
@@ -902,6 +850,7 @@ void StatisticsWorker::generateRawStatistics(VPackBuilder& builder, double const
     builder.add("dirty", VPackValue(v8Counters.dirty));
     builder.add("free", VPackValue(v8Counters.free));
     builder.add("max", VPackValue(v8Counters.max));
+    dealer->addPoolStatistics(builder);
     builder.close();
   }
 
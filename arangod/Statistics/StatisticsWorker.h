@@ -24,6 +24,7 @@
 #define ARANGOD_STATISTICS_STATISTICS_WORKER_H 1
 
 #include "Basics/ConditionVariable.h"
+#include "Basics/Mutex.h"
 #include "Basics/Thread.h"
 #include "Statistics/figures.h"
 
@@ -42,6 +43,10 @@ class StatisticsWorker final : public Thread {
   void run() override;
   void beginShutdown() override;
 
+  /// @brief the per-seconds statistics of the last 15 minutes and the
+  /// latest 15 minute average, as kept in memory
+  void historyToVelocyPack(velocypack::Builder&) const;
+
  private:
   // removes old statistics
   void collectGarbage();
@@ -54,17 +59,14 @@ class StatisticsWorker final : public Thread {
                          velocypack::Slice const& prev);
   void generateRawStatistics(velocypack::Builder& result, double const& now);
 
-  // calculate per 15 seconds statistics
+  // calculate per 15 minutes statistics
   void historianAverage();
-  void compute15Minute(velocypack::Builder& builder, double start);
+  void compute15Minute(velocypack::Builder& builder, velocypack::Slice history);
 
   // create statistics collections
   void createCollections() const;
   void createCollection(std::string const&) const;
 
-  std::shared_ptr<arangodb::velocypack::Builder> lastEntry(
-      std::string const& collection, double start) const;
-
   void avgPercentDistributon(velocypack::Builder& result,
                              velocypack::Slice const&,
                              velocypack::Slice const&,
@@ -100,6 +102,18 @@ class StatisticsWorker final : public Thread {
   velocypack::Builder _rawBuilder;
   velocypack::Builder _tempBuilder;
 
+  // the previous raw statistics, the per-seconds statistics are computed
+  // from them
+  velocypack::Builder _lastRaw;
+
+  // time of the latest 15 minute average
+  double _lastAverageTime;
+
+  // guards _perSeconds and _lastAverage, which are read by the REST handler
+  mutable Mutex _historyLock;
+  std::deque<std::shared_ptr<velocypack::Builder>> _perSeconds;
+  std::shared_ptr<velocypack::Builder> _lastAverage;
+
   std::string _clusterId;
   TRI_vocbase_t& _vocbase; // vocbase for querying/persisting statistics collections
 };
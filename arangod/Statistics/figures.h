@@ -26,6 +26,10 @@
 
 #include "Basics/Common.h"
 
+#include <array>
+#include <atomic>
+#include <cmath>
+
 namespace arangodb {
 namespace basics {
 
@@ -92,6 +96,87 @@ struct StatisticsDistribution {
   std::vector<double> _cuts;
   std::vector<uint64_t> _counts;
 };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a log-linear histogram in the style of HdrHistogram. every power
+/// of two is split into 8 buckets, so that percentiles are accurate to
+/// 12.5% over the whole range, without cuts to choose. the counters are
+/// atomic, the histogram can be read while it is written
+////////////////////////////////////////////////////////////////////////////////
+
+struct StatisticsHistogram {
+  static constexpr unsigned SubBucketBits = 3;
+  static constexpr uint64_t SubBuckets = 1ULL << SubBucketBits;
+  static constexpr size_t NumBuckets = (64 - SubBucketBits + 1) * SubBuckets;
+
+  StatisticsHistogram() : _count(0), _sum(0), _max(0) {
+    for (auto& it : _counts) {
+      it.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  static size_t bucket(uint64_t value) {
+    if (value < SubBuckets) {
+      return static_cast<size_t>(value);
+    }
+    unsigned exponent = SubBucketBits;
+    while (exponent < 63 && (value >> (exponent + 1)) != 0) {
+      ++exponent;
+    }
+    uint64_t const sub = (value >> (exponent - SubBucketBits)) & (SubBuckets - 1);
+    return static_cast<size_t>((exponent - SubBucketBits + 1) * SubBuckets + sub);
+  }
+
+  /// @brief the largest value counted in the bucket
+  static uint64_t bucketMax(size_t bucket) {
+    if (bucket < SubBuckets) {
+      return bucket;
+    }
+    unsigned const shift =
+        static_cast<unsigned>(bucket / SubBuckets) - 1;
+    uint64_t const lower = (SubBuckets + bucket % SubBuckets) << shift;
+    return lower + ((1ULL << shift) - 1);
+  }
+
+  void addFigure(uint64_t value) {
+    _counts[bucket(value)].fetch_add(1, std::memory_order_relaxed);
+    _count.fetch_add(1, std::memory_order_relaxed);
+    _sum.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t max = _max.load(std::memory_order_relaxed);
+    while (value > max &&
+           !_max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+    }
+  }
+
+  /// @brief the value below which the fraction q of all values lies, as the
+  /// upper bound of its bucket. 0 if the histogram is empty
+  uint64_t percentile(double q) const {
+    uint64_t const count = _count.load(std::memory_order_relaxed);
+    if (count == 0) {
+      return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>(std::ceil(q * static_cast<double>(count)));
+    if (rank == 0) {
+      rank = 1;
+    }
+    uint64_t const max = _max.load(std::memory_order_relaxed);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < NumBuckets; ++i) {
+      seen += _counts[i].load(std::memory_order_relaxed);
+      if (seen >= rank) {
+        return (std::min)(bucketMax(i), max);
+      }
+    }
+    // counters written while reading
+    return max;
+  }
+
+  std::array<std::atomic<uint64_t>, NumBuckets> _counts;
+  std::atomic<uint64_t> _count;
+  std::atomic<uint64_t> _sum;
+  std::atomic<uint64_t> _max;
+};
 }
 }
 
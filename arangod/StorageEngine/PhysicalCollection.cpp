@@ -64,6 +64,22 @@ void PhysicalCollection::drop() {
   }
 }
 
+/// @brief read multiple documents and call the callback for every document
+/// found, in the order of the ids. the default implementation reads the
+/// documents one by one
+void PhysicalCollection::readDocumentsWithCallback(
+    transaction::Methods* trx, std::vector<LocalDocumentId> const& tokens,
+    IndexIterator::DocumentCallback const& cb) const {
+  for (auto const& token : tokens) {
+    readDocumentWithCallback(trx, token, cb);
+  }
+}
+
+std::unique_ptr<IndexIterator> PhysicalCollection::getScanIterator(
+    transaction::Methods* trx) const {
+  return getAllIterator(trx);
+}
+
 bool PhysicalCollection::isValidEdgeAttribute(VPackSlice const& slice) const {
   if (!slice.isString()) {
     return false;
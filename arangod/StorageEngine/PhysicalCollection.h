@@ -25,7 +25,7 @@
 #define ARANGOD_VOCBASE_PHYSICAL_COLLECTION_H 1
 
 #include "Basics/Common.h"
-#include "Basics/ReadWriteLock.h"
+#include "Basics/ReadMostlyLock.h"
 #include "Indexes/Index.h"
 #include "Indexes/IndexIterator.h"
 #include "VocBase/voc-types.h"
@@ -123,6 +123,12 @@ class PhysicalCollection {
   virtual std::unique_ptr<IndexIterator> getAllIterator(transaction::Methods* trx) const = 0;
   virtual std::unique_ptr<IndexIterator> getAnyIterator(
       transaction::Methods* trx) const = 0;
+
+  /// @brief iterator over all documents, for scans that read the entire
+  /// collection once. engines may read ahead and bypass their caches, the
+  /// default is the all iterator
+  virtual std::unique_ptr<IndexIterator> getScanIterator(
+      transaction::Methods* trx) const;
   virtual void invokeOnAllElements(
       transaction::Methods* trx,
       std::function<bool(LocalDocumentId const&)> callback) = 0;
@@ -153,6 +159,13 @@ class PhysicalCollection {
                                         LocalDocumentId const& token,
                                         IndexIterator::DocumentCallback const& cb) const = 0;
 
+  /// @brief read multiple documents and call the callback for every document
+  /// found, in the order of the ids. the default implementation reads the
+  /// documents one by one
+  virtual void readDocumentsWithCallback(
+      transaction::Methods* trx, std::vector<LocalDocumentId> const& tokens,
+      IndexIterator::DocumentCallback const& cb) const;
+
   virtual Result insert(arangodb::transaction::Methods* trx,
                         arangodb::velocypack::Slice const newSlice,
                         arangodb::ManagedDocumentResult& result,
@@ -248,7 +261,7 @@ class PhysicalCollection {
   LogicalCollection* _logicalCollection;
   bool const _isDBServer;
 
-  mutable basics::ReadWriteLock _indexesLock;
+  mutable basics::ReadMostlyLock _indexesLock;
   std::vector<std::shared_ptr<Index>> _indexes;
 };
 
@@ -486,6 +486,19 @@ class StorageEngine : public application_features::ApplicationFeature {
     builder.close();
   }
 
+  // memory held by the engine itself, in bytes
+  virtual void getMemoryStatistics(VPackBuilder& builder) const {
+    builder.openObject();
+    builder.close();
+  }
+
+  // counters of the in-memory caches, one object per cache with the
+  // collection or index owning it
+  virtual void getCacheStatistics(VPackBuilder& builder) const {
+    builder.openArray();
+    builder.close();
+  }
+
   // management methods for synchronizing with external persistent stores
   virtual TRI_voc_tick_t currentTick() const = 0;
   virtual TRI_voc_tick_t releasedTick() const = 0;
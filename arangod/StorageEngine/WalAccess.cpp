@@ -26,8 +26,25 @@
 #include "RestServer/DatabaseFeature.h"
 #include "VocBase/LogicalCollection.h"
 
+#include <chrono>
+#include <thread>
+
 using namespace arangodb;
 
+bool WalAccess::waitForTicksAfter(TRI_voc_tick_t tick, double timeout) const {
+  // there is no notification for new WAL entries, the wait looks at the
+  // last tick in short intervals
+  auto const end = std::chrono::steady_clock::now() +
+                   std::chrono::duration<double>(timeout);
+  while (lastTick() <= tick) {
+    if (std::chrono::steady_clock::now() >= end) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return true;
+}
+
 /// @brief check if db should be handled, might already be deleted
 bool WalAccessContext::shouldHandleDB(TRI_voc_tick_t dbid) const {
   return _filter.vocbase == 0 || _filter.vocbase == dbid;
@@ -39,8 +56,9 @@ bool WalAccessContext::shouldHandleCollection(TRI_voc_tick_t dbid,
   if (dbid == 0 || cid == 0 || !shouldHandleDB(dbid)) {
     return false;
   }
-  if (_filter.vocbase == 0 || (_filter.vocbase == dbid &&
-                               (_filter.collection == 0 || _filter.collection == cid))) {
+  if (_filter.vocbase == 0 ||
+      (_filter.vocbase == dbid && (_filter.collections.empty() ||
+                                   _filter.collections.count(cid) > 0))) {
     LogicalCollection* collection = loadCollection(dbid, cid);
     if (collection == nullptr) {
       return false;
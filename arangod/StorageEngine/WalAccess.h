@@ -90,9 +90,8 @@ class WalAccess {
 
     /// only output markers from this database
     TRI_voc_tick_t vocbase = 0;
-    /// Only output data from this collection
-    /// FIXME: make a set of collections
-    TRI_voc_cid_t collection = 0;
+    /// only output data from these collections, all if empty
+    std::unordered_set<TRI_voc_cid_t> collections;
 
     /// only include these transactions, up to
     /// (not including) firstRegularTick
@@ -125,10 +124,16 @@ class WalAccess {
       uint64_t tickStart, uint64_t tickEnd, Filter const& filter,
       TransactionCallback const&) const = 0;
 
+  /// @brief clientId identifies a tailing client, whose position in the WAL
+  /// may be kept between calls. 0 for a client without an id
   virtual WalAccessResult tail(uint64_t tickStart, uint64_t tickEnd,
                                size_t chunkSize, TRI_voc_tid_t barrierId,
-                               Filter const& filter,
+                               TRI_server_id_t clientId, Filter const& filter,
                                MarkerCallback const&) const = 0;
+
+  /// @brief waits until the WAL contains ticks after tick, at most timeout
+  /// seconds. returns whether it does
+  virtual bool waitForTicksAfter(TRI_voc_tick_t tick, double timeout) const;
 };
 
 /// @brief helper class used to resolve vocbases
@@ -46,7 +46,8 @@ class Hints {
     NO_COMPACTION_LOCK = 128, // not supported in RocksDB
     NO_USAGE_LOCK = 256, // not supported in RocksDB
     RECOVERY = 512,
-    NO_DLD = 1024 // disable deadlock detection
+    NO_DLD = 1024, // disable deadlock detection
+    ALLOW_RANGE_DELETE = 2048 // allow truncate via range delete (RocksDB only)
   };
 
   Hints() : _value(0) {}
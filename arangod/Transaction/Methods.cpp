@@ -1221,10 +1221,12 @@ Result transaction::Methods::documentFastPath(std::string const& collectionName,
     return Result(TRI_ERROR_ARANGO_DOCUMENT_HANDLE_BAD);
   }
 
-  std::unique_ptr<ManagedDocumentResult> tmp;
+  // the document is copied into the result right away, so the engine may
+  // hand it out from its cache
+  ManagedDocumentResult tmp;
   if (mmdr == nullptr) {
-    tmp.reset(new ManagedDocumentResult);
-    mmdr = tmp.get();
+    tmp.enablePinning();
+    mmdr = &tmp;
   }
 
   TRI_ASSERT(mmdr != nullptr);
@@ -1644,22 +1646,24 @@ OperationResult transaction::Methods::insertLocal(
   VPackBuilder resultBuilder;
   TRI_voc_tick_t maxTick = 0;
 
+  // reused for all documents of an array, so that the engines can copy
+  // the new documents into the buffers of the previous ones
+  ManagedDocumentResult documentResult;
+  ManagedDocumentResult previousDocumentResult; // return OLD
+  bool needsLock = true;
+
   auto workForOneDocument = [&](VPackSlice const value) -> Result {
     if (!value.isObject()) {
       return Result(TRI_ERROR_ARANGO_DOCUMENT_TYPE_INVALID);
     }
 
-    ManagedDocumentResult documentResult;
     TRI_voc_tick_t resultMarkerTick = 0;
     TRI_voc_rid_t revisionId = 0;
 
-    auto const needsLock = !isLocked(collection, AccessMode::Type::WRITE);
-
     Result res = collection->insert( this, value, documentResult, options
                                    , resultMarkerTick, needsLock, revisionId
                                    );
 
-    ManagedDocumentResult previousDocumentResult; // return OLD
     TRI_voc_rid_t previousRevisionId = 0;
     if(options.overwrite && res.is(TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED)){
       // RepSert Case - unique_constraint violated -> maxTick has not changed -> try replace
@@ -1709,6 +1713,20 @@ OperationResult transaction::Methods::insertLocal(
   bool const multiCase = value.isArray();
   std::unordered_map<int, size_t> countErrorCodes;
   if (multiCase) {
+    // lock the collection once for all documents, instead of once per
+    // document in the engine
+    Result lockResult;
+    if (!isLocked(collection, AccessMode::Type::WRITE)) {
+      lockResult = lockRecursive(cid, AccessMode::Type::WRITE);
+      if (!lockResult.ok() && !lockResult.is(TRI_ERROR_LOCKED)) {
+        return OperationResult(lockResult, options);
+      }
+    }
+    TRI_DEFER(if (lockResult.is(TRI_ERROR_LOCKED)) {
+      unlockRecursive(cid, AccessMode::Type::WRITE);
+    });
+    needsLock = false;
+
     VPackArrayBuilder b(&resultBuilder);
     for (auto const& s : VPackArrayIterator(value)) {
       res = workForOneDocument(s);
@@ -1719,6 +1737,7 @@ OperationResult transaction::Methods::insertLocal(
     // With babies the reporting is handled in the body of the result
     res = Result(TRI_ERROR_NO_ERROR);
   } else {
+    needsLock = !isLocked(collection, AccessMode::Type::WRITE);
     res = workForOneDocument(value);
   }
 
@@ -1770,63 +1789,82 @@ OperationResult transaction::Methods::insertLocal(
       count++;
     }
     if (count > 0) {
-      auto body = std::make_shared<std::string>();
-      *body = payload->slice().toJson();
+      // send the documents to the followers, together with those of
+      // concurrent inserts into the shard that are waiting for the same
+      // followers
+      auto replicate = [&](std::string const& json, size_t total) -> Result {
+        auto body = std::make_shared<std::string>(json);
 
-      // Now prepare the requests:
-      std::vector<ClusterCommRequest> requests;
-      requests.reserve(followers->size());
-      
-      for (auto const& f : *followers) {
-        requests.emplace_back("server:" + f, arangodb::rest::RequestType::POST,
-            path, body);
-      }
-      auto cc = arangodb::ClusterComm::instance();
-      if (cc != nullptr) {
-        // nullptr only happens on controlled shutdown
-        size_t nrDone = 0;
-        size_t nrGood = cc->performRequests(requests,
-                                            chooseTimeout(count, body->size()*followers->size()),
-                                            nrDone, Logger::REPLICATION, false);
-        if (nrGood < followers->size()) {
-          // If any would-be-follower refused to follow there must be a
-          // new leader in the meantime, in this case we must not allow
-          // this operation to succeed, we simply return with a refusal
-          // error (note that we use the follower version, since we have
-          // lost leadership):
-          if (findRefusal(requests)) {
-            return OperationResult(TRI_ERROR_CLUSTER_SHARD_LEADER_RESIGNED, options);
-          }
+        // Now prepare the requests:
+        std::vector<ClusterCommRequest> requests;
+        requests.reserve(followers->size());
 
-          // Otherwise we drop all followers that were not successful:
-          for (size_t i = 0; i < followers->size(); ++i) {
-            bool replicationWorked =
-              requests[i].done &&
-              requests[i].result.status == CL_COMM_RECEIVED &&
-              (requests[i].result.answer_code ==
-                rest::ResponseCode::ACCEPTED ||
-                requests[i].result.answer_code == rest::ResponseCode::CREATED);
-            if (replicationWorked) {
-              bool found;
-              requests[i].result.answer->header(StaticStrings::ErrorCodes,
-                  found);
-              replicationWorked = !found;
+        for (auto const& f : *followers) {
+          requests.emplace_back("server:" + f, arangodb::rest::RequestType::POST,
+              path, body);
+        }
+        auto cc = arangodb::ClusterComm::instance();
+        if (cc != nullptr) {
+          // nullptr only happens on controlled shutdown
+          size_t nrDone = 0;
+          size_t nrGood = cc->performRequests(requests,
+                                              chooseTimeout(total, body->size()*followers->size()),
+                                              nrDone, Logger::REPLICATION, false);
+          if (nrGood < followers->size()) {
+            // If any would-be-follower refused to follow there must be a
+            // new leader in the meantime, in this case we must not allow
+            // this operation to succeed, we simply return with a refusal
+            // error (note that we use the follower version, since we have
+            // lost leadership):
+            if (findRefusal(requests)) {
+              return Result(TRI_ERROR_CLUSTER_SHARD_LEADER_RESIGNED);
             }
-            if (!replicationWorked) {
-              auto const& followerInfo = collection->followers();
-              if (followerInfo->remove((*followers)[i])) {
-                LOG_TOPIC(WARN, Logger::REPLICATION)
-                  << "insertLocal: dropping follower " << (*followers)[i]
-                  << " for shard " << collectionName;
-              } else {
-                LOG_TOPIC(ERR, Logger::REPLICATION)
-                  << "insertLocal: could not drop follower "
-                  << (*followers)[i] << " for shard " << collectionName;
-                THROW_ARANGO_EXCEPTION(TRI_ERROR_CLUSTER_COULD_NOT_DROP_FOLLOWER);
+
+            // Otherwise we drop all followers that were not successful:
+            for (size_t i = 0; i < followers->size(); ++i) {
+              bool replicationWorked =
+                requests[i].done &&
+                requests[i].result.status == CL_COMM_RECEIVED &&
+                (requests[i].result.answer_code ==
+                  rest::ResponseCode::ACCEPTED ||
+                  requests[i].result.answer_code == rest::ResponseCode::CREATED);
+              if (replicationWorked) {
+                bool found;
+                requests[i].result.answer->header(StaticStrings::ErrorCodes,
+                    found);
+                replicationWorked = !found;
+              }
+              if (!replicationWorked) {
+                auto const& followerInfo = collection->followers();
+                if (followerInfo->remove((*followers)[i])) {
+                  LOG_TOPIC(WARN, Logger::REPLICATION)
+                    << "insertLocal: dropping follower " << (*followers)[i]
+                    << " for shard " << collectionName;
+                } else {
+                  LOG_TOPIC(ERR, Logger::REPLICATION)
+                    << "insertLocal: could not drop follower "
+                    << (*followers)[i] << " for shard " << collectionName;
+                  return Result(TRI_ERROR_CLUSTER_COULD_NOT_DROP_FOLLOWER);
+                }
               }
             }
           }
         }
+        return Result();
+      };
+
+      // writes are only grouped if they go to the same set of followers
+      std::string key = path;
+      for (auto const& f : *followers) {
+        key.append("\n").append(f);
+      }
+      Result r = collection->followers()->replicateGrouped(
+          key, payload->slice(), count, replicate);
+      if (r.is(TRI_ERROR_CLUSTER_SHARD_LEADER_RESIGNED)) {
+        return OperationResult(r, options);
+      }
+      if (r.fail()) {
+        THROW_ARANGO_EXCEPTION(r);
       }
     }
   }
@@ -2016,29 +2054,32 @@ OperationResult transaction::Methods::modifyLocal(
   VPackBuilder resultBuilder;  // building the complete result
   TRI_voc_tick_t maxTick = 0;
 
+  // the lock is held for all documents now, and the results are reused
+  // for all documents of an array
+  bool const needsLock = !isLocked(collection, AccessMode::Type::WRITE);
+  ManagedDocumentResult result;
+  ManagedDocumentResult previous;
+
   // lambda //////////////
   auto workForOneDocument = [this, &operation, &options, &maxTick, &collection,
-                             &resultBuilder, &cid](VPackSlice const newVal,
-                                                   bool isBabies) -> Result {
+                             &resultBuilder, &cid, &needsLock, &result,
+                             &previous](VPackSlice const newVal,
+                                        bool isBabies) -> Result {
     Result res;
     if (!newVal.isObject()) {
       res.reset(TRI_ERROR_ARANGO_DOCUMENT_TYPE_INVALID);
       return res;
     }
 
-    ManagedDocumentResult result;
     TRI_voc_rid_t actualRevision = 0;
-    ManagedDocumentResult previous;
     TRI_voc_tick_t resultMarkerTick = 0;
 
     if (operation == TRI_VOC_DOCUMENT_OPERATION_REPLACE) {
       res = collection->replace(this, newVal, result, options, resultMarkerTick,
-                                !isLocked(collection, AccessMode::Type::WRITE),
-                                actualRevision, previous);
+                                needsLock, actualRevision, previous);
     } else {
       res = collection->update(this, newVal, result, options, resultMarkerTick,
-                               !isLocked(collection, AccessMode::Type::WRITE),
-                               actualRevision, previous);
+                               needsLock, actualRevision, previous);
     }
 
     if (resultMarkerTick > 0 && resultMarkerTick > maxTick) {
@@ -3043,6 +3084,66 @@ OperationCursor* transaction::Methods::indexScanForCondition(
   return new OperationCursor(iterator.release(), defaultBatchSize());
 }
 
+/// @brief factory for OperationCursor objects from AQL, returning only
+/// the documents found for the first index and condition that are also
+/// found for all other indexes and their conditions
+/// note: the caller must have read-locked the underlying collection when
+/// calling this method
+OperationCursor* transaction::Methods::indexScanForIntersection(
+    std::vector<IndexHandle> const& indexes,
+    std::vector<arangodb::aql::AstNode const*> const& conditions,
+    arangodb::aql::Variable const* var, ManagedDocumentResult* mmdr,
+    IndexIteratorOptions const& opts) {
+  if (_state->isCoordinator()) {
+    // The index scan is only available on DBServers and Single Server.
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_CLUSTER_ONLY_ON_DBSERVER);
+  }
+
+  TRI_ASSERT(!indexes.empty());
+  TRI_ASSERT(indexes.size() == conditions.size());
+
+  std::vector<IndexIterator*> iterators;
+  iterators.reserve(indexes.size());
+
+  auto cleanup = [&iterators]() {
+    for (auto& it : iterators) {
+      delete it;
+    }
+  };
+  TRI_DEFER(cleanup());
+
+  // only the first iterator determines the order of the results
+  IndexIteratorOptions unsorted = opts;
+  unsorted.sorted = false;
+  unsorted.limit = 0;
+
+  for (size_t i = 0; i < indexes.size(); ++i) {
+    auto idx = indexes[i].getIndex();
+    if (nullptr == idx) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                     "The index id cannot be empty.");
+    }
+
+    std::unique_ptr<IndexIterator> iterator(idx->iteratorForCondition(
+        this, mmdr, conditions[i], var, (i == 0) ? opts : unsorted));
+
+    if (iterator == nullptr) {
+      // We could not create an ITERATOR and it did not throw an error itself
+      return new OperationCursor(TRI_ERROR_OUT_OF_MEMORY);
+    }
+    iterators.emplace_back(iterator.get());
+    iterator.release();
+  }
+
+  auto idx = indexes[0].getIndex();
+  auto intersection = std::make_unique<IntersectionIndexIterator>(
+      iterators[0]->collection(), this, idx.get(), iterators);
+  // the intersection iterator is now responsible for the iterators
+  iterators.clear();
+
+  return new OperationCursor(intersection.release(), defaultBatchSize());
+}
+
 /// @brief factory for OperationCursor objects
 /// note: the caller must have read-locked the underlying collection when
 /// calling this method
@@ -3077,6 +3178,10 @@ std::unique_ptr<OperationCursor> transaction::Methods::indexScan(
       iterator = logical->getAllIterator(this);
       break;
     }
+    case CursorType::SCAN: {
+      iterator = logical->getScanIterator(this);
+      break;
+    }
   }
   if (iterator == nullptr) {
     // We could not create an ITERATOR and it did not throw an error itself
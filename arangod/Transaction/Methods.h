@@ -180,10 +180,12 @@ class Methods {
   /// @brief default batch size for index and other operations
   static constexpr uint64_t defaultBatchSize() { return 1000; }
 
-  /// @brief Type of cursor
+  /// @brief Type of cursor. SCAN returns the same documents as ALL, for
+  /// scans that are known to read the entire collection once
   enum class CursorType {
     ALL = 0,
-    ANY
+    ANY,
+    SCAN
   };
 
   /// @brief return database of transaction
@@ -396,6 +398,17 @@ class Methods {
                                          ManagedDocumentResult*,
                                          IndexIteratorOptions const&);
 
+  /// @brief factory for OperationCursor objects from AQL, returning only
+  /// the documents found for the first index and condition that are also
+  /// found for all other indexes and their conditions
+  /// note: the caller must have read-locked the underlying collection when
+  /// calling this method
+  OperationCursor* indexScanForIntersection(
+      std::vector<IndexHandle> const&,
+      std::vector<arangodb::aql::AstNode const*> const&,
+      arangodb::aql::Variable const*, ManagedDocumentResult*,
+      IndexIteratorOptions const&);
+
   /// @brief factory for OperationCursor objects
   /// note: the caller must have read-locked the underlying collection when
   /// calling this method
@@ -34,7 +34,7 @@
 #include <velocypack/velocypack-aliases.h>
 
 namespace {
-bool authorized(std::pair<arangodb::Cursor*, std::string> const& cursor) {
+bool authorized(std::string const& user) {
   auto context = arangodb::ExecContext::CURRENT;
   if (context == nullptr || !arangodb::ExecContext::isAuthEnabled()) {
     return true;
@@ -44,12 +44,14 @@ bool authorized(std::pair<arangodb::Cursor*, std::string> const& cursor) {
     return true;
   }
 
-  return (cursor.second == context->user());
+  return (user == context->user());
 }
 }
 
 using namespace arangodb;
 
+constexpr size_t CursorRepository::NumShards;
+
 size_t const CursorRepository::MaxCollectCount = 32;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -57,8 +59,10 @@ size_t const CursorRepository::MaxCollectCount = 32;
 ////////////////////////////////////////////////////////////////////////////////
 
 CursorRepository::CursorRepository(TRI_vocbase_t& vocbase)
-    : _vocbase(vocbase), _lock(), _cursors() {
-  _cursors.reserve(64);
+    : _vocbase(vocbase) {
+  for (auto& shard : _shards) {
+    shard.cursors.reserve(8);
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -89,14 +93,15 @@ CursorRepository::~CursorRepository() {
     ++tries;
   }
 
-  {
-    MUTEX_LOCKER(mutexLocker, _lock);
+  for (auto& shard : _shards) {
+    MUTEX_LOCKER(mutexLocker, shard.lock);
 
-    for (auto it : _cursors) {
-      delete it.second.first;
+    for (auto& it : shard.cursors) {
+      delete it.second.cursor;
     }
 
-    _cursors.clear();
+    shard.cursors.clear();
+    shard.expiries.clear();
   }
 }
 
@@ -113,8 +118,17 @@ Cursor* CursorRepository::addCursor(std::unique_ptr<Cursor> cursor) {
   std::string user = ExecContext::CURRENT ? ExecContext::CURRENT->user() : "";
 
   {
-    MUTEX_LOCKER(mutexLocker, _lock);
-    _cursors.emplace(id, std::make_pair(cursor.get(), user));
+    Shard& s = shard(id);
+    double const expires = cursor->expires();
+
+    MUTEX_LOCKER(mutexLocker, s.lock);
+    auto it = s.expiries.emplace(expires, id).first;
+    try {
+      s.cursors.emplace(id, Entry{cursor.get(), std::move(user), expires});
+    } catch (...) {
+      s.expiries.erase(it);
+      throw;
+    }
   }
 
   return cursor.release();
@@ -170,15 +184,16 @@ bool CursorRepository::remove(CursorId id, Cursor::CursorType type) {
   arangodb::Cursor* cursor = nullptr;
 
   {
-    MUTEX_LOCKER(mutexLocker, _lock);
+    Shard& s = shard(id);
+    MUTEX_LOCKER(mutexLocker, s.lock);
 
-    auto it = _cursors.find(id);
-    if (it == _cursors.end() || !::authorized(it->second)) {
+    auto it = s.cursors.find(id);
+    if (it == s.cursors.end() || !::authorized(it->second.user)) {
       // not found
       return false;
     }
 
-    cursor = (*it).second.first;
+    cursor = (*it).second.cursor;
 
     if (cursor->isDeleted()) {
       // already deleted
@@ -197,7 +212,7 @@ bool CursorRepository::remove(CursorId id, Cursor::CursorType type) {
     }
 
     // cursor not in use by someone else
-    _cursors.erase(it);
+    removeEntry(s, it);
   }
 
   TRI_ASSERT(cursor != nullptr);
@@ -217,15 +232,16 @@ Cursor* CursorRepository::find(CursorId id, Cursor::CursorType type, bool& busy)
   busy = false;
 
   {
-    MUTEX_LOCKER(mutexLocker, _lock);
+    Shard& s = shard(id);
+    MUTEX_LOCKER(mutexLocker, s.lock);
 
-    auto it = _cursors.find(id);
-    if (it == _cursors.end() || !::authorized(it->second)) {
+    auto it = s.cursors.find(id);
+    if (it == s.cursors.end() || !::authorized(it->second.user)) {
       // not found
       return nullptr;
     }
 
-    cursor = (*it).second.first;
+    cursor = (*it).second.cursor;
 
     if (cursor->isDeleted()) {
       // already deleted
@@ -242,7 +258,19 @@ Cursor* CursorRepository::find(CursorId id, Cursor::CursorType type, bool& busy)
       return nullptr;
     }
 
+    // using the cursor extends its lifetime
+    Entry& entry = (*it).second;
     cursor->use();
+    try {
+      s.expiries.emplace(cursor->expires(), id);
+    } catch (...) {
+      cursor->release();
+      throw;
+    }
+    if (entry.expires != cursor->expires()) {
+      s.expiries.erase(std::make_pair(entry.expires, id));
+      entry.expires = cursor->expires();
+    }
   }
 
   return cursor;
@@ -254,7 +282,8 @@ Cursor* CursorRepository::find(CursorId id, Cursor::CursorType type, bool& busy)
 
 void CursorRepository::release(Cursor* cursor) {
   {
-    MUTEX_LOCKER(mutexLocker, _lock);
+    Shard& s = shard(cursor->id());
+    MUTEX_LOCKER(mutexLocker, s.lock);
 
     TRI_ASSERT(cursor->isUsed());
     cursor->release();
@@ -264,7 +293,10 @@ void CursorRepository::release(Cursor* cursor) {
     }
 
     // remove from the list
-    _cursors.erase(cursor->id());
+    auto it = s.cursors.find(cursor->id());
+    if (it != s.cursors.end()) {
+      removeEntry(s, it);
+    }
   }
 
   // and free the cursor
@@ -276,11 +308,13 @@ void CursorRepository::release(Cursor* cursor) {
 ////////////////////////////////////////////////////////////////////////////////
 
 bool CursorRepository::containsUsedCursor() {
-  MUTEX_LOCKER(mutexLocker, _lock);
+  for (auto& shard : _shards) {
+    MUTEX_LOCKER(mutexLocker, shard.lock);
 
-  for (auto it : _cursors) {
-    if (it.second.first->isUsed()) {
-      return true;
+    for (auto const& it : shard.cursors) {
+      if (it.second.cursor->isUsed()) {
+        return true;
+      }
     }
   }
 
@@ -298,35 +332,52 @@ bool CursorRepository::garbageCollect(bool force) {
   try {
     found.reserve(MaxCollectCount);
 
-    MUTEX_LOCKER(mutexLocker, _lock);
+    for (auto& s : _shards) {
+      if (!force && found.size() >= MaxCollectCount) {
+        break;
+      }
 
-    for (auto it = _cursors.begin(); it != _cursors.end(); /* no hoisting */) {
-      auto cursor = (*it).second.first;
+      MUTEX_LOCKER(mutexLocker, s.lock);
 
-      if (cursor->isUsed()) {
-        // must not destroy used cursors
-        ++it;
-        continue;
-      }
+      if (force) {
+        for (auto it = s.cursors.begin(); it != s.cursors.end(); /* no hoisting */) {
+          auto cursor = (*it).second.cursor;
 
-      if (force || cursor->expires() < now) {
-        cursor->deleted();
-      }
+          if (cursor->isUsed()) {
+            // must not destroy used cursors
+            ++it;
+            continue;
+          }
 
-      if (cursor->isDeleted()) {
-        try {
+          cursor->deleted();
           found.emplace_back(cursor);
-          it = _cursors.erase(it);
-        } catch (...) {
-          // stop iteration
-          break;
+          s.expiries.erase(std::make_pair((*it).second.expires, (*it).first));
+          it = s.cursors.erase(it);
         }
+        continue;
+      }
 
-        if (!force && found.size() >= MaxCollectCount) {
+      // only the expired cursors are at the front of the expiry index
+      for (auto it = s.expiries.begin();
+           it != s.expiries.end() && (*it).first < now; /* no hoisting */) {
+        auto entry = s.cursors.find((*it).second);
+        TRI_ASSERT(entry != s.cursors.end());
+        auto cursor = (*entry).second.cursor;
+
+        if (cursor->isUsed()) {
+          // must not destroy used cursors
+          ++it;
+          continue;
+        }
+
+        cursor->deleted();
+        found.emplace_back(cursor);
+        s.cursors.erase(entry);
+        it = s.expiries.erase(it);
+
+        if (found.size() >= MaxCollectCount) {
           break;
         }
-      } else {
-        ++it;
       }
     }
   } catch (...) {
@@ -340,3 +391,13 @@ bool CursorRepository::garbageCollect(bool force) {
 
   return (!found.empty());
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief removes a cursor, the caller must hold the lock of the shard
+////////////////////////////////////////////////////////////////////////////////
+
+void CursorRepository::removeEntry(
+    Shard& shard, std::unordered_map<CursorId, Entry>::iterator it) {
+  shard.expiries.erase(std::make_pair((*it).second.expires, (*it).first));
+  shard.cursors.erase(it);
+}
@@ -29,6 +29,9 @@
 #include "Utils/Cursor.h"
 #include "VocBase/voc-types.h"
 
+#include <array>
+#include <set>
+
 struct TRI_vocbase_t;
 
 namespace arangodb {
@@ -115,6 +118,46 @@ class CursorRepository {
 
   bool garbageCollect(bool);
 
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief a cursor with its owner and the expiry time it is indexed with
+  //////////////////////////////////////////////////////////////////////////////
+
+  struct Entry {
+    Cursor* cursor;
+    std::string user;
+    double expires;
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief a part of the cursors, selected by their ids. operations on
+  /// different shards don't contend for the same lock
+  //////////////////////////////////////////////////////////////////////////////
+
+  struct Shard {
+    Mutex lock;
+
+    std::unordered_map<CursorId, Entry> cursors;
+
+    /// @brief the cursors ordered by their expiry times, so that the garbage
+    /// collection only looks at expired cursors
+    std::set<std::pair<double, CursorId>> expiries;
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the shard a cursor belongs to
+  //////////////////////////////////////////////////////////////////////////////
+
+  Shard& shard(CursorId id) { return _shards[id % NumShards]; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief removes a cursor, the caller must hold the lock of the shard
+  //////////////////////////////////////////////////////////////////////////////
+
+  static void removeEntry(
+      Shard& shard,
+      std::unordered_map<CursorId, Entry>::iterator it);
+
  private:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief vocbase
@@ -123,16 +166,16 @@ class CursorRepository {
   TRI_vocbase_t& _vocbase;
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief mutex for the cursors repository
+  /// @brief number of shards of the cursors repository
   //////////////////////////////////////////////////////////////////////////////
 
-  Mutex _lock;
+  static constexpr size_t NumShards = 16;
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief list of current cursors
+  /// @brief current cursors, distributed over the shards
   //////////////////////////////////////////////////////////////////////////////
 
-  std::unordered_map<CursorId, std::pair<Cursor*, std::string>> _cursors;
+  std::array<Shard, NumShards> _shards;
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief maximum number of cursors to garbage-collect in one go
@@ -136,8 +136,10 @@ void OperationCursor::skip(uint64_t toSkip, uint64_t& skipped) {
     return;
   }
 
+  // skipped may already count entries of other cursors
+  uint64_t const before = skipped;
   _indexIterator->skip(toSkip, skipped);
-  if (skipped != toSkip || _limit == 0) {
+  if (skipped - before != toSkip || _limit == 0) {
     _hasMore = false;
   }
 }
@@ -50,7 +50,8 @@ std::string const GlobalContextMethods::CodeWarmupExports =
 V8Context::V8Context(size_t id, v8::Isolate* isolate)
     : _id(id), _isolate(isolate), _locker(nullptr), 
       _creationStamp(TRI_microtime()), _lastGcStamp(0.0), 
-      _invocations(0), _invocationsSinceLastGc(0), _hasActiveExternals(false) {}
+      _invocations(0), _invocationsSinceLastGc(0), _hasActiveExternals(false),
+      _pool(0), _heapUsed(0), _heapTotal(0) {}
 
 void V8Context::lockAndEnter() {
   TRI_ASSERT(_isolate != nullptr);
@@ -133,6 +133,11 @@ class V8Context {
   uint64_t _invocations;
   uint64_t _invocationsSinceLastGc;
   bool _hasActiveExternals;
+  // the pool of the dealer the context is busy for
+  size_t _pool;
+  // heap sizes when the context was last left, read without the lock
+  std::atomic<uint64_t> _heapUsed;
+  std::atomic<uint64_t> _heapTotal;
 
   Mutex _globalMethodsLock;
   std::vector<GlobalContextMethods::MethodType> _globalMethods;
@@ -98,6 +98,7 @@ V8DealerFeature::V8DealerFeature(
       _nrMinContexts(0),
       _nrInflightContexts(0),
       _maxContextInvocations(0),
+      _nrReservedContexts{0, 0, 0},
       _allowAdminExecute(false),
       _enableJS(true),
       _nextId(0),
@@ -150,6 +151,21 @@ void V8DealerFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
       "minimum number of V8 contexts that keep available for executing JavaScript actions",
       new UInt64Parameter(&_nrMinContexts));
   
+  options->addOption(
+      "--javascript.v8-contexts-reserved-client",
+      "number of V8 contexts reserved for Foxx, JavaScript transactions and other client requests",
+      new UInt64Parameter(&_nrReservedContexts[static_cast<size_t>(ContextPool::CLIENT)]));
+  
+  options->addOption(
+      "--javascript.v8-contexts-reserved-tasks",
+      "number of V8 contexts reserved for tasks and queued jobs",
+      new UInt64Parameter(&_nrReservedContexts[static_cast<size_t>(ContextPool::TASKS)]));
+  
+  options->addOption(
+      "--javascript.v8-contexts-reserved-cluster",
+      "number of V8 contexts reserved for cluster-internal JavaScript",
+      new UInt64Parameter(&_nrReservedContexts[static_cast<size_t>(ContextPool::CLUSTER)]));
+  
   options->addHiddenOption(
       "--javascript.v8-contexts-max-invocations",
       "maximum number of invocations for each V8 context before it is disposed",
@@ -278,6 +294,17 @@ void V8DealerFeature::start() {
     _nrMaxContexts = _nrMinContexts;
   }
 
+  uint64_t reserved = 0;
+  for (size_t i = 0; i < NumberContextPools; ++i) {
+    reserved += _nrReservedContexts[i];
+  }
+  if (reserved > _nrMaxContexts) {
+    // all reservations must be satisfiable at the same time
+    LOG_TOPIC(WARN, Logger::V8) << "increasing number of V8 contexts to " << reserved
+                                << ", the number of reserved V8 contexts";
+    _nrMaxContexts = reserved;
+  }
+
   LOG_TOPIC(DEBUG, Logger::V8) << "number of V8 contexts: min: " << _nrMinContexts << ", max: " << _nrMaxContexts;
 
   defineDouble("V8_CONTEXTS", static_cast<double>(_nrMaxContexts));
@@ -657,7 +684,8 @@ void V8DealerFeature::prepareLockedContext(TRI_vocbase_t* vocbase,
 /// forceContext >= 0 means picking the context with that exact id 
 V8Context* V8DealerFeature::enterContext(TRI_vocbase_t* vocbase,
                                          bool allowUseDatabase,
-                                         ssize_t forceContext) {
+                                         ssize_t forceContext,
+                                         RequestLane lane) {
   TRI_ASSERT(vocbase != nullptr);
 
   if (_stopping) {
@@ -674,6 +702,7 @@ V8Context* V8DealerFeature::enterContext(TRI_vocbase_t* vocbase,
 
 
   V8Context* context = nullptr;
+  size_t const pool = static_cast<size_t>(poolForLane(lane));
 
   // this is for TESTING / DEBUGGING / INIT only
   if (forceContext >= 0) {
@@ -711,6 +740,8 @@ V8Context* V8DealerFeature::enterContext(TRI_vocbase_t* vocbase,
         if (context != nullptr) {
           // found the context
           TRI_ASSERT(guard.isLocked());
+          context->_pool = pool;
+          ++_pools[pool].busy;
           break;
         }
 
@@ -744,25 +775,33 @@ V8Context* V8DealerFeature::enterContext(TRI_vocbase_t* vocbase,
   else {
     CONDITION_LOCKER(guard, _contextCondition);
 
-    while (_idleContexts.empty() && !_stopping) {
-      TRI_ASSERT(guard.isLocked());
+    bool const priority = (forceContext == ANY_CONTEXT_OR_PRIORITY);
+    double waitStart = 0.0;
+    auto stopWaiting = [this, pool, &waitStart]() {
+      if (waitStart > 0.0) {
+        --_pools[pool].waiting;
+        _pools[pool].waitTime += TRI_microtime() - waitStart;
+        waitStart = 0.0;
+      }
+    };
 
-      LOG_TOPIC(TRACE, arangodb::Logger::V8) << "waiting for unused V8 context";
+    while (!_stopping) {
+      TRI_ASSERT(guard.isLocked());
 
-      if (!_dirtyContexts.empty()) {
+      if (!canEnterPool(pool, priority)) {
+        // the remaining contexts are reserved for other pools
+        LOG_TOPIC(TRACE, arangodb::Logger::V8) << "waiting for V8 context of pool " << namePool(static_cast<ContextPool>(pool));
+      } else if (!_idleContexts.empty()) {
+        break;
+      } else if (!_dirtyContexts.empty()) {
         // we'll use a dirty context in this case
         _idleContexts.push_back(_dirtyContexts.back());
         _dirtyContexts.pop_back();
         break;
-      }
-
-      bool contextLimitNotExceeded =
-        ((_contexts.size() + _nrInflightContexts < _nrMaxContexts) ||
-         (forceContext == ANY_CONTEXT_OR_PRIORITY && (_contexts.size() + _nrInflightContexts <= _nrMaxContexts)));
-      
-      if (contextLimitNotExceeded &&
-          _dynamicContextCreationBlockers == 0 && 
-          !MaxMapCountFeature::isNearMaxMappings()) {
+      } else if (((_contexts.size() + _nrInflightContexts < _nrMaxContexts) ||
+                  (priority && (_contexts.size() + _nrInflightContexts <= _nrMaxContexts))) &&
+                 _dynamicContextCreationBlockers == 0 && 
+                 !MaxMapCountFeature::isNearMaxMappings()) {
   
         ++_nrInflightContexts;
 
@@ -777,6 +816,7 @@ V8Context* V8DealerFeature::enterContext(TRI_vocbase_t* vocbase,
 
           // clean up state
           --_nrInflightContexts;
+          stopWaiting();
           throw;
         }
 
@@ -810,15 +850,24 @@ V8Context* V8DealerFeature::enterContext(TRI_vocbase_t* vocbase,
       }
 
       TRI_ASSERT(guard.isLocked());
+      LOG_TOPIC(TRACE, arangodb::Logger::V8) << "waiting for unused V8 context";
+
+      if (waitStart == 0.0) {
+        waitStart = TRI_microtime();
+        ++_pools[pool].waiting;
+        ++_pools[pool].waits;
+      }
       guard.wait(100000);
 
       if (exitWhenNoContext.tick()) {
+        stopWaiting();
         vocbase->release();
         return nullptr;
       }
     }
-      
+
     TRI_ASSERT(guard.isLocked());
+    stopWaiting();
 
     // in case we are in the shutdown phase, do not enter a context!
     // the context might have been deleted by the shutdown
@@ -837,6 +886,8 @@ V8Context* V8DealerFeature::enterContext(TRI_vocbase_t* vocbase,
 
     // should not fail because we reserved enough space beforehand
     _busyContexts.emplace(context);
+    context->_pool = pool;
+    ++_pools[pool].busy;
   }
   
   TRI_ASSERT(context != nullptr);
@@ -886,6 +937,11 @@ void V8DealerFeature::cleanupLockedContext(V8Context* context) {
 
   // update data for later garbage collection
   {
+    v8::HeapStatistics heap;
+    isolate->GetHeapStatistics(&heap);
+    context->_heapUsed.store(heap.used_heap_size(), std::memory_order_relaxed);
+    context->_heapTotal.store(heap.total_heap_size(), std::memory_order_relaxed);
+
     TRI_GET_GLOBALS();
     context->_hasActiveExternals = v8g->hasActiveExternals();
     TRI_vocbase_t* vocbase = v8g->_vocbase;
@@ -981,6 +1037,8 @@ void V8DealerFeature::exitContext(V8Context* context) {
     }
 
     _busyContexts.erase(context);
+    TRI_ASSERT(_pools[context->_pool].busy > 0);
+    --_pools[context->_pool].busy;
 
     LOG_TOPIC(TRACE, arangodb::Logger::V8) << "returned dirty V8 context #" << context->id();
     guard.broadcast();
@@ -989,6 +1047,8 @@ void V8DealerFeature::exitContext(V8Context* context) {
     CONDITION_LOCKER(guard, _contextCondition);
 
     _busyContexts.erase(context);
+    TRI_ASSERT(_pools[context->_pool].busy > 0);
+    --_pools[context->_pool].busy;
     // note that re-adding the context here should not fail as we reserved
     // enough room for all contexts during startup
     _idleContexts.emplace_back(context);
@@ -1305,6 +1365,79 @@ V8DealerFeature::stats V8DealerFeature::getCurrentContextNumbers() {
   };
 }
 
+void V8DealerFeature::addPoolStatistics(VPackBuilder& builder) {
+  CONDITION_LOCKER(guard, _contextCondition);
+  builder.add("pools", VPackValue(VPackValueType::Object));
+  for (size_t i = 0; i < NumberContextPools; ++i) {
+    builder.add(namePool(static_cast<ContextPool>(i)), VPackValue(VPackValueType::Object));
+    builder.add("busy", VPackValue(_pools[i].busy));
+    builder.add("reserved", VPackValue(_nrReservedContexts[i]));
+    builder.add("waiting", VPackValue(_pools[i].waiting));
+    builder.add("waits", VPackValue(_pools[i].waits));
+    builder.add("waitTime", VPackValue(_pools[i].waitTime));
+    builder.close();
+  }
+  builder.close();
+}
+
+void V8DealerFeature::addMemoryStatistics(VPackBuilder& builder) {
+  uint64_t heapUsed = 0;
+  uint64_t heapTotal = 0;
+  size_t contexts = 0;
+  {
+    CONDITION_LOCKER(guard, _contextCondition);
+    for (auto const& context : _contexts) {
+      heapUsed += context->_heapUsed.load(std::memory_order_relaxed);
+      heapTotal += context->_heapTotal.load(std::memory_order_relaxed);
+    }
+    contexts = _contexts.size();
+  }
+  builder.add("contexts", VPackValue(contexts));
+  builder.add("heapUsed", VPackValue(heapUsed));
+  builder.add("heapTotal", VPackValue(heapTotal));
+}
+
+V8DealerFeature::ContextPool V8DealerFeature::poolForLane(RequestLane lane) {
+  switch (lane) {
+    case RequestLane::TASK_V8:
+      return ContextPool::TASKS;
+    case RequestLane::CLUSTER_V8:
+    case RequestLane::CLUSTER_INTERNAL:
+    case RequestLane::CLUSTER_ADMIN:
+    case RequestLane::AGENCY_CLUSTER:
+    case RequestLane::AGENCY_INTERNAL:
+      return ContextPool::CLUSTER;
+    default:
+      return ContextPool::CLIENT;
+  }
+}
+
+char const* V8DealerFeature::namePool(ContextPool pool) {
+  switch (pool) {
+    case ContextPool::CLIENT:
+      return "client";
+    case ContextPool::TASKS:
+      return "tasks";
+    case ContextPool::CLUSTER:
+      return "cluster";
+  }
+  return "unknown";
+}
+
+bool V8DealerFeature::canEnterPool(size_t pool, bool priority) const {
+  if (_pools[pool].busy < _nrReservedContexts[pool]) {
+    // within its own reservation
+    return true;
+  }
+
+  // contexts that are busy or still reserved by any pool
+  uint64_t taken = 0;
+  for (size_t i = 0; i < NumberContextPools; ++i) {
+    taken += (std::max)(static_cast<uint64_t>(_pools[i].busy), _nrReservedContexts[i]);
+  }
+  return taken < _nrMaxContexts || (priority && taken <= _nrMaxContexts);
+}
+
 bool V8DealerFeature::loadJavaScriptFileInContext(TRI_vocbase_t* vocbase,
     std::string const& file, V8Context* context,
     VPackBuilder* builder) {
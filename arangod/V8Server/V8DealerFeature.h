@@ -26,6 +26,7 @@
 #include "ApplicationFeatures/ApplicationFeature.h"
 
 #include "Basics/ConditionVariable.h"
+#include "GeneralServer/RequestLane.h"
 #include "V8/JSLoader.h"
 
 #include <velocypack/Slice.h>
@@ -51,6 +52,16 @@ class V8DealerFeature final : public application_features::ApplicationFeature {
   static constexpr ssize_t ANY_CONTEXT = -1;
   static constexpr ssize_t ANY_CONTEXT_OR_PRIORITY = -2;
 
+  /// @brief the contexts are shared by pools of request lanes. every pool
+  /// may reserve a number of contexts that the other pools must leave to
+  /// it, the contexts beyond all reservations are borrowed by whoever
+  /// comes first
+  enum class ContextPool : size_t { CLIENT = 0, TASKS = 1, CLUSTER = 2 };
+  static constexpr size_t NumberContextPools = 3;
+
+  static ContextPool poolForLane(RequestLane lane);
+  static char const* namePool(ContextPool pool);
+
  public:
   explicit V8DealerFeature(application_features::ApplicationServer* server);
 
@@ -71,6 +82,7 @@ class V8DealerFeature final : public application_features::ApplicationFeature {
   uint64_t _nrMinContexts; // minimum number of contexts to keep
   uint64_t _nrInflightContexts; // number of contexts currently in creation
   uint64_t _maxContextInvocations; // maximum number of V8 context invocations
+  uint64_t _nrReservedContexts[NumberContextPools]; // reserved per pool
   bool _allowAdminExecute;
   bool _enableJS;
 
@@ -93,8 +105,10 @@ class V8DealerFeature final : public application_features::ApplicationFeature {
   /// reached the maximum number of contexts. this can be used to
   /// force the creation of another context for high priority tasks
   /// forceContext >= 0 means picking the context with that exact id 
+  /// the context counts against the pool of lane
   V8Context* enterContext(TRI_vocbase_t*, bool allowUseDatabase,
-                          ssize_t forceContext = ANY_CONTEXT);
+                          ssize_t forceContext = ANY_CONTEXT,
+                          RequestLane lane = RequestLane::CLIENT_V8);
   void exitContext(V8Context*);
 
   void defineContextUpdate(
@@ -113,6 +127,14 @@ class V8DealerFeature final : public application_features::ApplicationFeature {
 
   V8DealerFeature::stats getCurrentContextNumbers();
 
+  /// @brief adds an attribute per pool with its busy and reserved contexts,
+  /// the waiting requests and the accumulated time they waited
+  void addPoolStatistics(velocypack::Builder&);
+
+  /// @brief adds the number of contexts and the sum of their heap sizes,
+  /// as of the last time each context was left
+  void addMemoryStatistics(velocypack::Builder&);
+
   void defineBoolean(std::string const& name, bool value) {
     _definedBooleans[name] = value;
   }
@@ -139,6 +161,9 @@ class V8DealerFeature final : public application_features::ApplicationFeature {
   void cleanupLockedContext(V8Context*);
   void applyContextUpdate(V8Context* context);
   void shutdownContexts();
+  /// @brief whether a request of the pool may take another context, must be
+  /// called with _contextCondition locked
+  bool canEnterPool(size_t pool, bool priority) const;
 
  private:
   std::atomic<uint64_t> _nextId;
@@ -154,6 +179,15 @@ class V8DealerFeature final : public application_features::ApplicationFeature {
   std::unordered_set<V8Context*> _busyContexts;
   size_t _dynamicContextCreationBlockers;
 
+  // per pool, protected by _contextCondition
+  struct PoolStatistics {
+    size_t busy = 0;
+    size_t waiting = 0;
+    uint64_t waits = 0;
+    double waitTime = 0.0;
+  };
+  PoolStatistics _pools[NumberContextPools];
+
   JSLoader _startupLoader;
 
   std::map<std::string, bool> _definedBooleans;
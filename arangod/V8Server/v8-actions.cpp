@@ -124,7 +124,8 @@ class v8_action_t final : public TRI_action_t {
 
     // get a V8 context
     V8Context* context = V8DealerFeature::DEALER->enterContext(vocbase,
-                            allowUseDatabaseInRestActions, forceContext);
+                            allowUseDatabaseInRestActions, forceContext,
+                            RequestLane::CLIENT_V8);
 
     // note: the context might be nullptr in case of shut-down
     if (context == nullptr) {
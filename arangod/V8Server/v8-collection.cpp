@@ -2450,6 +2450,7 @@ static void JS_TruncateVocbaseCol(
   SingleCollectionTransaction trx(
     ctx, collection, AccessMode::Type::EXCLUSIVE
   );
+  trx.addHint(transaction::Hints::Hint::ALLOW_RANGE_DELETE);
   Result res = trx.begin();
 
   if (!res.ok()) {
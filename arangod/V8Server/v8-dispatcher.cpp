@@ -388,8 +388,9 @@ void V8Task::toVelocyPack(VPackBuilder& builder) const {
 }
 
 void V8Task::work(ExecContext const* exec) {
-  auto context = V8DealerFeature::DEALER->enterContext(&(_dbGuard->database()),
-                                                       _allowUseDatabase);
+  auto context = V8DealerFeature::DEALER->enterContext(
+      &(_dbGuard->database()), _allowUseDatabase,
+      V8DealerFeature::ANY_CONTEXT, RequestLane::TASK_V8);
 
   // note: the context might be 0 in case of shut-down
   if (context == nullptr) {
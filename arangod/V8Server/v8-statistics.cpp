@@ -37,6 +37,7 @@
 #include "V8/v8-conv.h"
 #include "V8/v8-globals.h"
 #include "V8/v8-utils.h"
+#include "V8/v8-vpack.h"
 #include "V8Server/V8DealerFeature.h"
 
 using namespace arangodb;
@@ -132,6 +133,14 @@ static void JS_ServerStatistics(
   v8CountersObj->Set(
       TRI_V8_ASCII_STRING(isolate, "max"),
       v8::Number::New(isolate, static_cast<int32_t>(v8Counters.max)));
+  {
+    VPackBuilder pools;
+    pools.openObject();
+    dealer->addPoolStatistics(pools);
+    pools.close();
+    v8CountersObj->Set(TRI_V8_ASCII_STRING(isolate, "pools"),
+                       TRI_VPackToV8(isolate, pools.slice().get("pools")));
+  }
   result->Set(TRI_V8_ASCII_STRING(isolate, "v8Context"), v8CountersObj);
 
   v8::Handle<v8::Object> counters = v8::Object::New(isolate);
@@ -39,6 +39,8 @@
 #include <boost/uuid/random_generator.hpp>
 
 #include <array>
+#include <atomic>
+#include <chrono>
 
 using namespace arangodb;
 using namespace arangodb::basics;
@@ -113,6 +115,40 @@ static std::array<bool, 256> const keyCharLookupTable = { {
   /* 0xfc . */ false,    /* 0xfd . */ false,    /* 0xfe . */ false,    /* 0xff . */ false
 } };
   
+/// @brief ticks reserved per thread, see KeyGenerator::setTickBlockSize
+std::atomic<uint64_t> tickBlockSize(0);
+
+/// @brief a thread does not use a block for longer, so that keys of
+/// different threads are ascending in windows of this duration
+constexpr std::chrono::milliseconds tickBlockLifetime(1000);
+
+/// @brief a block of ticks or cluster-wide ids reserved by one thread
+struct TickBlock {
+  uint64_t next = 0;
+  uint64_t end = 0;
+  std::chrono::steady_clock::time_point expires;
+
+  /// @brief returns the next value of the block, reserves a new block of
+  /// size values with reserve(size) if the block is used up or expired
+  template <typename F>
+  uint64_t take(uint64_t size, F const& reserve) {
+    auto now = std::chrono::steady_clock::now();
+    if (next == end || now >= expires) {
+      next = reserve(size);
+      end = next + size;
+      expires = now + tickBlockLifetime;
+    }
+    return next++;
+  }
+
+  void discard() { next = end; }
+};
+
+/// @brief blocks of server ticks and cluster-wide ids of this thread, they
+/// are shared by all collections, their values are unique either way
+thread_local TickBlock serverTicks;
+thread_local TickBlock clusterIds;
+
 /// @brief available key generators
 enum class GeneratorType {
   UNKNOWN = 0,
@@ -155,16 +191,21 @@ class TraditionalKeyGeneratorSingle final : public TraditionalKeyGenerator {
 
   /// @brief generate a key
   std::string generate() override {
+    uint64_t const blockSize = ::tickBlockSize.load(std::memory_order_relaxed);
+    if (blockSize > 1) {
+      return generateFromBlock(blockSize);
+    }
+
     TRI_voc_tick_t tick = TRI_NewTickServer();
     
     {
       MUTEX_LOCKER(mutexLocker, _lock);
 
-      if (tick <= _lastValue) {
-        tick = ++_lastValue;
-      } else {
-        _lastValue = tick;
+      uint64_t lastValue = _lastValue.load(std::memory_order_relaxed);
+      if (tick <= lastValue) {
+        tick = lastValue + 1;
       }
+      _lastValue.store(tick, std::memory_order_relaxed);
     }
 
     if (tick == UINT64_MAX) {
@@ -197,9 +238,9 @@ class TraditionalKeyGeneratorSingle final : public TraditionalKeyGenerator {
       if (value > 0) {
         MUTEX_LOCKER(mutexLocker, _lock);
 
-        if (value > _lastValue) {
+        if (value > _lastValue.load(std::memory_order_relaxed)) {
           // and update our last value
-          _lastValue = value;
+          _lastValue.store(value, std::memory_order_relaxed);
         }
       }
     }
@@ -209,13 +250,39 @@ class TraditionalKeyGeneratorSingle final : public TraditionalKeyGenerator {
   void toVelocyPack(arangodb::velocypack::Builder& builder) const override {
     TRI_ASSERT(!builder.isClosed());
     TraditionalKeyGenerator::toVelocyPack(builder);
-    builder.add(StaticStrings::LastValue, VPackValue(_lastValue));
+    uint64_t lastValue = _lastValue.load(std::memory_order_relaxed);
+    if (::tickBlockSize.load(std::memory_order_relaxed) > 1) {
+      // keys from blocks do not update _lastValue, but no key handed out so
+      // far is greater than the global tick
+      lastValue = std::max<uint64_t>(lastValue, TRI_CurrentTickServer());
+    }
+    builder.add(StaticStrings::LastValue, VPackValue(lastValue));
   }
 
  private:
+  /// @brief generate a key from the tick block of this thread, without
+  /// any shared write per key. only tracked keys update _lastValue, a
+  /// tick that is not greater than a tracked key is not used
+  std::string generateFromBlock(uint64_t blockSize) {
+    while (true) {
+      TRI_voc_tick_t tick = ::serverTicks.take(blockSize, TRI_NewTicksServer);
+      uint64_t lastValue = _lastValue.load(std::memory_order_relaxed);
+      if (tick > lastValue) {
+        if (tick == UINT64_MAX) {
+          // sanity check
+          return std::string();
+        }
+        return arangodb::basics::StringUtils::itoa(tick);
+      }
+      // a tracked key is ahead of our block, continue behind it
+      TRI_UpdateTickServer(lastValue);
+      ::serverTicks.discard();
+    }
+  }
+
   arangodb::Mutex _lock;
 
-  uint64_t _lastValue;
+  std::atomic<uint64_t> _lastValue;
 };
 
 /// @brief traditional key generator for a coordinator
@@ -228,6 +295,13 @@ class TraditionalKeyGeneratorCluster final : public TraditionalKeyGenerator {
   /// @brief generate a key
   std::string generate() override {
     ClusterInfo* ci = ClusterInfo::instance();
+    uint64_t const blockSize = ::tickBlockSize.load(std::memory_order_relaxed);
+    if (blockSize > 1) {
+      // the ids of a block are reserved cluster-wide via the agency
+      uint64_t uid = ::clusterIds.take(
+          blockSize, [ci](uint64_t count) { return ci->uniqid(count); });
+      return std::to_string(uid);
+    }
     uint64_t uid = ci->uniqid();
     return std::to_string(uid);
   }
@@ -567,6 +641,12 @@ GeneratorType generatorType(VPackSlice const& parameters) {
 KeyGenerator::KeyGenerator(bool allowUserKeys)
     : _allowUserKeys(allowUserKeys) {}
 
+void KeyGenerator::setTickBlockSize(uint64_t size) {
+  ::tickBlockSize.store(size);
+}
+
+uint64_t KeyGenerator::tickBlockSize() { return ::tickBlockSize.load(); }
+
 bool KeyGenerator::canUseType(VPackSlice const& parameters) {
   auto type = ::generatorType(parameters);
 
@@ -51,6 +51,11 @@ class KeyGenerator {
   /// @brief create a key generator based on the options specified
   static KeyGenerator* factory(arangodb::velocypack::Slice const&);
 
+  /// @brief number of ticks the traditional key generators reserve per
+  /// thread at once. 0 or 1 takes every key from the global tick counter
+  static void setTickBlockSize(uint64_t size);
+  static uint64_t tickBlockSize();
+
   /// @brief generate a key
   virtual std::string generate() = 0;
 
@@ -24,6 +24,7 @@
 
 #include "LogicalCollection.h"
 
+#include "Aql/PlanCache.h"
 #include "Aql/QueryCache.h"
 #include "Basics/fasthash.h"
 #include "Basics/Mutex.h"
@@ -407,6 +408,11 @@ std::unique_ptr<IndexIterator> LogicalCollection::getAnyIterator(transaction::Me
   return _physical->getAnyIterator(trx);
 }
 
+std::unique_ptr<IndexIterator> LogicalCollection::getScanIterator(
+    transaction::Methods* trx) {
+  return _physical->getScanIterator(trx);
+}
+
 void LogicalCollection::invokeOnAllElements(
     transaction::Methods* trx,
     std::function<bool(LocalDocumentId const&)> callback) {
@@ -1032,9 +1038,7 @@ std::shared_ptr<Index> LogicalCollection::createIndex(transaction::Methods* trx,
 /// @brief drops an index, including index file removal and replication
 bool LogicalCollection::dropIndex(TRI_idx_iid_t iid) {
   TRI_ASSERT(!ServerState::instance()->isCoordinator());
-#if USE_PLAN_CACHE
-  arangodb::aql::PlanCache::instance()->invalidate(_vocbase);
-#endif
+  arangodb::aql::PlanCache::instance()->invalidate(&vocbase());
   arangodb::aql::QueryCache::instance()->invalidate(&vocbase(), name());
 
   bool result = _physical->dropIndex(iid);
@@ -1176,6 +1180,12 @@ bool LogicalCollection::readDocumentWithCallback(transaction::Methods* trx,
   return getPhysical()->readDocumentWithCallback(trx, token, cb);
 }
 
+void LogicalCollection::readDocumentsWithCallback(
+    transaction::Methods* trx, std::vector<LocalDocumentId> const& tokens,
+    IndexIterator::DocumentCallback const& cb) const {
+  getPhysical()->readDocumentsWithCallback(trx, tokens, cb);
+}
+
 /// @brief a method to skip certain documents in AQL write operations,
 /// this is only used in the enterprise edition for smart graphs
 #ifndef USE_ENTERPRISE
@@ -174,6 +174,7 @@ class LogicalCollection: public LogicalDataSource {
 
   std::unique_ptr<IndexIterator> getAllIterator(transaction::Methods* trx);
   std::unique_ptr<IndexIterator> getAnyIterator(transaction::Methods* trx);
+  std::unique_ptr<IndexIterator> getScanIterator(transaction::Methods* trx);
 
   void invokeOnAllElements(
       transaction::Methods* trx,
@@ -318,6 +319,10 @@ class LogicalCollection: public LogicalDataSource {
                                 LocalDocumentId const& token,
                                 IndexIterator::DocumentCallback const& cb) const;
 
+  void readDocumentsWithCallback(transaction::Methods* trx,
+                                 std::vector<LocalDocumentId> const& tokens,
+                                 IndexIterator::DocumentCallback const& cb) const;
+
   /// @brief Persist the connected physical collection.
   ///        This should be called AFTER the collection is successfully
   ///        created and only on Sinlge/DBServer
@@ -38,7 +38,8 @@ void ManagedDocumentResult::clone(ManagedDocumentResult& cloned) const {
     cloned._string = _string;
     cloned._localDocumentId = _localDocumentId;
     cloned._vpack = reinterpret_cast<uint8_t*>(const_cast<char*>(cloned._string.data()));
-  } else if (_managed) {
+  } else if (_managed || _pinned) {
+    // the clone may live longer than the finding
     cloned.setManaged(_vpack, _localDocumentId);
   } else {
     cloned.setUnmanaged(_vpack, _localDocumentId);
@@ -47,7 +48,7 @@ void ManagedDocumentResult::clone(ManagedDocumentResult& cloned) const {
 
 //add unmanaged vpack 
 void ManagedDocumentResult::setUnmanaged(uint8_t const* vpack, LocalDocumentId const& documentId) {
-  if(_managed || _useString) {
+  if(_managed || _useString || _pinned) {
     reset();
   }
   TRI_ASSERT(_length == 0);
@@ -70,6 +71,17 @@ void ManagedDocumentResult::setManaged(uint8_t const* vpack, LocalDocumentId con
   _managed = true;
 }
 
+void ManagedDocumentResult::setPinned(cache::Finding&& finding,
+                                      uint8_t const* vpack,
+                                      LocalDocumentId const& documentId) {
+  TRI_ASSERT(finding.found());
+  reset();
+  _finding = std::move(finding);
+  _vpack = const_cast<uint8_t*>(vpack);
+  _localDocumentId = documentId;
+  _pinned = true;
+}
+
 void ManagedDocumentResult::setManagedAfterStringUsage(LocalDocumentId const& documentId) {
   TRI_ASSERT(!_string.empty());
   TRI_ASSERT(_useString);
@@ -94,6 +106,11 @@ void ManagedDocumentResult::reset() noexcept {
   _managed = false;
   _length = 0;
 
+  if (_pinned) {
+    _finding.release();
+    _pinned = false;
+  }
+
   if (_useString) {
     _string.clear();
     _useString = false;
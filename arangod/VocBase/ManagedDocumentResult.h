@@ -25,6 +25,7 @@
 #define ARANGOD_VOC_BASE_MANAGED_DOCUMENT_RESULT_H 1
 
 #include "Basics/Common.h"
+#include "Cache/Finding.h"
 #include "VocBase/LocalDocumentId.h"
 #include "VocBase/voc-types.h"
 
@@ -44,13 +45,18 @@ class ManagedDocumentResult {
     _localDocumentId(),
     _vpack(nullptr),
     _managed(false),
-    _useString(false) {}
+    _useString(false),
+    _pinned(false),
+    _pinningEnabled(false) {}
   ~ManagedDocumentResult() { reset(); }
   ManagedDocumentResult(ManagedDocumentResult const& other) = delete;
   ManagedDocumentResult& operator=(ManagedDocumentResult const& other) = delete;
 
   ManagedDocumentResult& operator=(ManagedDocumentResult&& other) {
-    if (other._useString) {
+    if (other._pinned) {
+      setPinned(std::move(other._finding), other._vpack, other._localDocumentId);
+      other.reset();
+    } else if (other._useString) {
       setManaged(std::move(other._string), other._localDocumentId);
       other._managed = false;
       other.reset();
@@ -78,6 +84,19 @@ class ManagedDocumentResult {
   void setManaged(uint8_t const* vpack, LocalDocumentId const& documentId);
   void setManaged(std::string&& str, LocalDocumentId const& documentId);
 
+  /// @brief allows the engine to hand out documents from its cache without
+  /// copying them. the cache cannot free a pinned value, and writing the
+  /// same document waits for it, so only results that are reset before
+  /// the next write of the transaction may enable this
+  void enablePinning() { _pinningEnabled = true; }
+
+  inline bool pinningEnabled() const { return _pinningEnabled; }
+
+  /// @brief points to a document inside the value of the finding, which is
+  /// leased until the result is reset
+  void setPinned(cache::Finding&& finding, uint8_t const* vpack,
+                 LocalDocumentId const& documentId);
+
   inline LocalDocumentId localDocumentId() const { return _localDocumentId; }
   
   void reset() noexcept;
@@ -98,7 +117,7 @@ class ManagedDocumentResult {
   inline bool empty() const { return _vpack == nullptr; }
 
   inline bool canUseInExternal() const {
-    return (!_managed && !_useString);
+    return (!_managed && !_useString && !_pinned);
   }
   
   void addToBuilder(velocypack::Builder& builder, bool allowExternals) const;
@@ -108,8 +127,11 @@ class ManagedDocumentResult {
   LocalDocumentId _localDocumentId;
   uint8_t* _vpack;
   std::string _string;
+  cache::Finding _finding;
   bool _managed;
   bool _useString;
+  bool _pinned;
+  bool _pinningEnabled;
 };
 
 }
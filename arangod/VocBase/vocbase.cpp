@@ -231,6 +231,44 @@ void TRI_vocbase_t::checkCollectionInvariants() const {
   TRI_ASSERT(_dataSourceByUuid.size() == _dataSourceById.size());
 }
 
+/// @brief builds the copy of the data-source maps for lookups without
+/// lock, if there is none. caller must hold _dataSourceLock
+void TRI_vocbase_t::publishDataSources() const {
+  if (_dataSources.load() != nullptr ||
+      _dataSourceLockWriteOwner.load() == std::this_thread::get_id()) {
+    // the writer may be in the middle of a change
+    return;
+  }
+
+  std::unique_ptr<DataSources> dataSources;
+  try {
+    dataSources.reset(new DataSources());
+    dataSources->byId = _dataSourceById;
+    dataSources->byName = _dataSourceByName;
+    dataSources->byUuid = _dataSourceByUuid;
+  } catch (...) {
+    // lookups just keep using the lock
+    return;
+  }
+
+  // other readers may have built one concurrently, writers are excluded
+  DataSources const* expected = nullptr;
+  if (_dataSources.compare_exchange_strong(expected, dataSources.get())) {
+    dataSources.release();
+  }
+}
+
+/// @brief discards the copy of the data-source maps, before they change.
+/// caller must hold _dataSourceLock in write mode
+void TRI_vocbase_t::invalidateDataSources() {
+  DataSources const* old = _dataSources.exchange(nullptr);
+  if (old != nullptr) {
+    // readers of the copy never wait for _dataSourceLock
+    _dataSourcesProtector.scan();
+    delete old;
+  }
+}
+
 /// @brief adds a new collection
 /// caller must hold _dataSourceLock in write mode or set doLock
 void TRI_vocbase_t::registerCollection(
@@ -244,6 +282,7 @@ void TRI_vocbase_t::registerCollection(
 
     checkCollectionInvariants();
     TRI_DEFER(checkCollectionInvariants());
+    invalidateDataSources();
 
     // check name
     auto it = _dataSourceByName.emplace(name, collection);
@@ -320,6 +359,8 @@ bool TRI_vocbase_t::unregisterCollection(
 
   TRI_ASSERT(std::dynamic_pointer_cast<arangodb::LogicalCollection>(itr->second));
 
+  invalidateDataSources();
+
   // only if we find the collection by its id, we can delete it by name
   _dataSourceById.erase(itr);
 
@@ -347,6 +388,8 @@ void TRI_vocbase_t::registerView(
   {
     RECURSIVE_WRITE_LOCKER_NAMED(writeLocker, _dataSourceLock, _dataSourceLockWriteOwner, doLock);
 
+    invalidateDataSources();
+
     // check name
     auto it = _dataSourceByName.emplace(name, view);
 
@@ -413,6 +456,8 @@ bool TRI_vocbase_t::unregisterView(arangodb::LogicalView const& view) {
 
   TRI_ASSERT(std::dynamic_pointer_cast<arangodb::LogicalView>(itr->second));
 
+  invalidateDataSources();
+
   // only if we find the collection by its id, we can delete it by name
   _dataSourceById.erase(itr);
 
@@ -744,9 +789,7 @@ int TRI_vocbase_t::dropCollectionWorker(arangodb::LogicalCollection* collection,
   TRI_ASSERT(writeLocker.isLocked());
   TRI_ASSERT(locker.isLocked());
 
-#if USE_PLAN_CACHE
   arangodb::aql::PlanCache::instance()->invalidate(this);
-#endif
   arangodb::aql::QueryCache::instance()->invalidate(this);
 
   switch (collection->status()) {
@@ -888,6 +931,7 @@ void TRI_vocbase_t::shutdown() {
     RECURSIVE_WRITE_LOCKER(_dataSourceLock, _dataSourceLockWriteOwner);
 
     checkCollectionInvariants();
+    invalidateDataSources();
     _dataSourceByName.clear();
     _dataSourceById.clear();
     _dataSourceByUuid.clear();
@@ -1073,8 +1117,35 @@ std::shared_ptr<arangodb::LogicalCollection> TRI_vocbase_t::lookupCollection(
 std::shared_ptr<arangodb::LogicalCollection> TRI_vocbase_t::lookupCollectionByUuid(
     std::string const& uuid
 ) const noexcept {
+  std::shared_ptr<arangodb::LogicalDataSource> dataSource;
+  {
+    auto unuser(_dataSourcesProtector.use());
+    auto dataSources = _dataSources.load();
+
+    if (dataSources != nullptr) {
+      auto itr = dataSources->byUuid.find(uuid);
+
+      if (itr == dataSources->byUuid.end()) {
+        return nullptr;
+      }
+      dataSource = itr->second;
+    }
+  }
+
+  if (dataSource != nullptr) {
+  #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
+    return std::dynamic_pointer_cast<arangodb::LogicalCollection>(dataSource);
+  #else
+    return dataSource->category() != LogicalCollection::category()
+      ? nullptr
+      : std::static_pointer_cast<LogicalCollection>(dataSource)
+      ;
+  #endif
+  }
+
   // otherwise we'll look up the collection by name
   RECURSIVE_READ_LOCKER(_dataSourceLock, _dataSourceLockWriteOwner);
+  publishDataSources();
   auto itr = _dataSourceByUuid.find(uuid);
 
   #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
@@ -1095,7 +1166,19 @@ std::shared_ptr<arangodb::LogicalCollection> TRI_vocbase_t::lookupCollectionByUu
 std::shared_ptr<arangodb::LogicalDataSource> TRI_vocbase_t::lookupDataSource(
     TRI_voc_cid_t id
 ) const noexcept {
+  {
+    auto unuser(_dataSourcesProtector.use());
+    auto dataSources = _dataSources.load();
+
+    if (dataSources != nullptr) {
+      auto itr = dataSources->byId.find(id);
+
+      return itr == dataSources->byId.end() ? nullptr : itr->second;
+    }
+  }
+
   RECURSIVE_READ_LOCKER(_dataSourceLock, _dataSourceLockWriteOwner);
+  publishDataSources();
   auto itr = _dataSourceById.find(id);
 
   return itr == _dataSourceById.end() ? nullptr : itr->second;
@@ -1119,7 +1202,25 @@ std::shared_ptr<arangodb::LogicalDataSource> TRI_vocbase_t::lookupDataSource(
     return lookupDataSource(id);
   }
 
+  {
+    auto unuser(_dataSourcesProtector.use());
+    auto dataSources = _dataSources.load();
+
+    if (dataSources != nullptr) {
+      auto itr = dataSources->byName.find(nameOrId);
+
+      if (itr != dataSources->byName.end()) {
+        return itr->second;
+      }
+
+      auto itrUuid = dataSources->byUuid.find(nameOrId);
+
+      return itrUuid == dataSources->byUuid.end() ? nullptr : itrUuid->second;
+    }
+  }
+
   RECURSIVE_READ_LOCKER(_dataSourceLock, _dataSourceLockWriteOwner);
+  publishDataSources();
 
   // otherwise look up the data-source by name
   auto itr = _dataSourceByName.find(nameOrId);
@@ -1389,6 +1490,7 @@ int TRI_vocbase_t::renameView(
 
   TRI_ASSERT(std::dynamic_pointer_cast<arangodb::LogicalView>(itr1->second));
 
+  invalidateDataSources();
   _dataSourceByName.emplace(newName, view);
   _dataSourceByName.erase(oldName);
 
@@ -1399,6 +1501,9 @@ int TRI_vocbase_t::renameView(
   auto doSync = databaseFeature->forceSyncProperties();
   auto res = view->rename(std::string(newName), doSync);
 
+  // cached plans refer to the view by its name
+  arangodb::aql::PlanCache::instance()->invalidate(this);
+
   return res.errorNumber();
 }
 
@@ -1491,6 +1596,9 @@ int TRI_vocbase_t::renameCollection(
 
   TRI_ASSERT(std::dynamic_pointer_cast<arangodb::LogicalCollection>(itr1->second));
 
+  // the snapshot must not find the renamed collection by its old name
+  invalidateDataSources();
+
   auto* databaseFeature =
     application_features::ApplicationServer::getFeature<DatabaseFeature>("Database");
   TRI_ASSERT(databaseFeature);
@@ -1795,6 +1903,7 @@ TRI_vocbase_t::TRI_vocbase_t(TRI_vocbase_type_e type, TRI_voc_tick_t id,
       _refCount(0),
       _state(TRI_vocbase_t::State::NORMAL),
       _isOwnAppsDirectory(true),
+      _dataSources(nullptr),
       _deadlockDetector(false),
       _userStructures(nullptr) {
   _queries.reset(new arangodb::aql::QueryList(this));
@@ -1822,6 +1931,8 @@ TRI_vocbase_t::~TRI_vocbase_t() {
   for (auto& it : _collections) {
     it->close(); // required to release indexes
   }
+
+  delete _dataSources.load();
 }
 
 std::string TRI_vocbase_t::path() const {
@@ -26,6 +26,7 @@
 
 #include "Basics/Common.h"
 #include "Basics/ConditionVariable.h"
+#include "Basics/DataProtector.h"
 #include "Basics/DeadlockDetector.h"
 #include "Basics/Exceptions.h"
 #include "Basics/ReadWriteLock.h"
@@ -165,6 +166,17 @@ struct TRI_vocbase_t {
   mutable arangodb::basics::ReadWriteLock _dataSourceLock; // data-source iterator lock
   mutable std::atomic<std::thread::id> _dataSourceLockWriteOwner; // current thread owning '_dataSourceLock' write lock (workaround for non-recusrive ReadWriteLock)
 
+  /// @brief immutable copy of the data-source maps, so lookups need no
+  /// lock. it is discarded on every change and built again by the next
+  /// lookup, readers must hold _dataSourcesProtector
+  struct DataSources {
+    std::unordered_map<TRI_voc_cid_t, std::shared_ptr<arangodb::LogicalDataSource>> byId;
+    std::unordered_map<std::string, std::shared_ptr<arangodb::LogicalDataSource>> byName;
+    std::unordered_map<std::string, std::shared_ptr<arangodb::LogicalDataSource>> byUuid;
+  };
+  mutable std::atomic<DataSources const*> _dataSources;
+  mutable arangodb::basics::DataProtector _dataSourcesProtector;
+
   std::unique_ptr<arangodb::aql::QueryList> _queries;
   std::unique_ptr<arangodb::CursorRepository> _cursorRepository;
   std::unique_ptr<arangodb::CollectionKeysRepository> _collectionKeys;
@@ -399,6 +411,14 @@ struct TRI_vocbase_t {
   int loadCollection(arangodb::LogicalCollection* collection,
                      TRI_vocbase_col_status_e& status, bool setStatus = true);
 
+  /// @brief builds the copy of the data-source maps for lookups without
+  /// lock, if there is none. caller must hold _dataSourceLock
+  void publishDataSources() const;
+
+  /// @brief discards the copy of the data-source maps, before they change.
+  /// caller must hold _dataSourceLock in write mode
+  void invalidateDataSources();
+
   /// @brief adds a new collection
   /// caller must hold _dataSourceLock in write mode or set doLock
   void registerCollection(
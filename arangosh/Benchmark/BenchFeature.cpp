@@ -23,12 +23,17 @@
 #include "BenchFeature.h"
 
 #include <ctime>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/StringUtils.h"
 #include "Benchmark/BenchmarkCounter.h"
+#include "Benchmark/BenchmarkHistogram.h"
 #include "Benchmark/BenchmarkOperation.h"
 #include "Benchmark/BenchmarkThread.h"
 #include "ProgramOptions/ProgramOptions.h"
@@ -53,6 +58,18 @@ using namespace arangodb::rest;
 BenchFeature* ARANGOBENCH;
 #include "Benchmark/test-cases.h"
 
+BenchLatency BenchLatency::fromHistogram(BenchmarkHistogram const& histogram) {
+  return {histogram.count(),          histogram.mean(),
+          histogram.percentile(50.0), histogram.percentile(99.0),
+          histogram.percentile(99.9), histogram.max()};
+}
+
+BenchLatency BenchLatency::average(BenchLatency const& a, BenchLatency const& b) {
+  return {(a.count + b.count) / 2, (a.mean + b.mean) / 2,
+          (a.p50 + b.p50) / 2,     (a.p99 + b.p99) / 2,
+          (a.p999 + b.p999) / 2,   (a.max + b.max) / 2};
+}
+
 BenchFeature::BenchFeature(application_features::ApplicationServer* server,
                            int* result)
     : ApplicationFeature(server, "Bench"),
@@ -73,6 +90,9 @@ BenchFeature::BenchFeature(application_features::ApplicationServer* server,
       _replicationFactor(1),
       _numberOfShards(1),
       _waitForSync(false),
+      _rate(0.0),
+      _warmup(0.0),
+      _jsonReportFile(""),
       _result(result) {
   requiresElevatedPrivileges(false);
   setOptional(false);
@@ -133,7 +153,14 @@ void BenchFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
                                            "multitrx",
                                            "multi-collection",
                                            "aqlinsert",
-                                           "aqlv8"};
+                                           "aqlv8",
+                                           "stream-cursor-batch",
+                                           "traversal",
+                                           "shortest-path",
+                                           "geo",
+                                           "arangosearch",
+                                           "aql-collect",
+                                           "aql-sorted-gather"};
 
   options->addOption(
       "--test-case", "test case to use",
@@ -150,6 +177,21 @@ void BenchFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
                      "filename to write junit style report to",
                      new StringParameter(&_junitReportFile));
 
+  options->addOption("--json-report-file",
+                     "filename to write the results including latencies to, as JSON",
+                     new StringParameter(&_jsonReportFile));
+
+  options->addOption("--rate",
+                     "requests per second to send in total, independent of the "
+                     "response times (0 sends the next request of a thread "
+                     "after the previous one returned)",
+                     new DoubleParameter(&_rate));
+
+  options->addOption("--warmup",
+                     "seconds at the start of a run whose requests are not "
+                     "included in the latencies",
+                     new DoubleParameter(&_warmup));
+
   options->addOption(
       "--runs", "run test n times (and calculate statistics based on median)",
       new UInt64Parameter(&_runs));
@@ -227,7 +269,9 @@ void BenchFeature::start() {
       BenchmarkThread* thread = new BenchmarkThread(
           benchmark.get(), &startCondition, &BenchFeature::updateStartCounter,
           static_cast<int>(i), (unsigned long)_batchSize, &operationsCounter,
-          client, _keepAlive, _async, _verbose);
+          client, _keepAlive, _async, _verbose,
+          _rate > 0.0 ? static_cast<double>(_concurreny) / _rate : 0.0,
+          _rate > 0.0 ? static_cast<double>(i) / _rate : 0.0, _warmup);
       thread->setOffset((size_t)(i * realStep));
       thread->start();
       threads.push_back(thread);
@@ -276,9 +320,11 @@ void BenchFeature::start() {
 
     double time = TRI_microtime() - start;
     double requestTime = 0.0;
+    BenchmarkHistogram histogram;
 
     for (size_t i = 0; i < static_cast<size_t>(_concurreny); ++i) {
       requestTime += threads[i]->getTime();
+      histogram.merge(threads[i]->getHistogram());
     }
 
     if (operationsCounter.failures() > 0) {
@@ -288,6 +334,7 @@ void BenchFeature::start() {
     results.push_back({
         time, operationsCounter.failures(),
         operationsCounter.incompleteFailures(), requestTime,
+        BenchLatency::fromHistogram(histogram),
     });
     for (size_t i = 0; i < static_cast<size_t>(_concurreny); ++i) {
       delete threads[i];
@@ -323,6 +370,11 @@ bool BenchFeature::report(ClientFeature* client,
             << ", wait for sync: " << (_waitForSync ? "true" : "false")
             << ", concurrency level (threads): " << _concurreny << std::endl;
 
+  if (_rate > 0.0) {
+    std::cout << "Request rate: " << std::fixed << _rate
+              << " per second, warmup: " << _warmup << " s" << std::endl;
+  }
+
   std::cout << "Test case: " << _testCase << ", complexity: " << _complexity
             << ", database: '" << client->databaseName() << "', collection: '"
             << _collection << "'" << std::endl;
@@ -330,7 +382,7 @@ bool BenchFeature::report(ClientFeature* client,
   std::sort(results.begin(), results.end(),
             [](BenchRunResult a, BenchRunResult b) { return a.time < b.time; });
 
-  BenchRunResult output{0, 0, 0, 0};
+  BenchRunResult output{0, 0, 0, 0, {0, 0, 0, 0, 0, 0}};
   if (_runs > 1) {
     size_t size = results.size();
     std::cout << std::endl;
@@ -350,7 +402,8 @@ bool BenchFeature::report(ClientFeature* client,
           (results[mid - 1].time + results[mid].time) / 2,
           (results[mid - 1].failures + results[mid].failures) / 2,
           (results[mid - 1].incomplete + results[mid].incomplete) / 2,
-          (results[mid - 1].requestTime + results[mid].requestTime) / 2);
+          (results[mid - 1].requestTime + results[mid].requestTime) / 2,
+          BenchLatency::average(results[mid - 1].latency, results[mid].latency));
     } else {
       output = results[mid];
     }
@@ -358,11 +411,78 @@ bool BenchFeature::report(ClientFeature* client,
     output = results[0];
   }
   printResult(output);
+
+  bool ok = true;
+  if (!_jsonReportFile.empty()) {
+    ok = writeJsonReport(results, output);
+  }
   if (_junitReportFile.empty()) {
-    return true;
+    return ok;
   }
 
-  return writeJunitReport(output);
+  return writeJunitReport(output) && ok;
+}
+
+void BenchFeature::addResult(VPackBuilder& builder, BenchRunResult const& result) {
+  builder.openObject();
+  builder.add("time", VPackValue(result.time));
+  builder.add("failures", VPackValue(result.failures));
+  builder.add("incomplete", VPackValue(result.incomplete));
+  builder.add("requestTime", VPackValue(result.requestTime));
+  builder.add("operationsPerSecond", VPackValue((double)_operations / result.time));
+  // all in microseconds
+  builder.add("latency", VPackValue(VPackValueType::Object));
+  builder.add("count", VPackValue(result.latency.count));
+  builder.add("mean", VPackValue(result.latency.mean));
+  builder.add("p50", VPackValue(result.latency.p50));
+  builder.add("p99", VPackValue(result.latency.p99));
+  builder.add("p999", VPackValue(result.latency.p999));
+  builder.add("max", VPackValue(result.latency.max));
+  builder.close();
+  builder.close();
+}
+
+bool BenchFeature::writeJsonReport(std::vector<BenchRunResult> const& results,
+                                   BenchRunResult const& result) {
+  std::string json;
+  try {
+    VPackBuilder builder;
+    builder.openObject();
+    builder.add("testCase", VPackValue(_testCase));
+    builder.add("complexity", VPackValue(_complexity));
+    builder.add("collection", VPackValue(_collection));
+    builder.add("requests", VPackValue(_operations));
+    builder.add("concurrency", VPackValue(_concurreny));
+    builder.add("batchSize", VPackValue(_batchSize));
+    builder.add("keepAlive", VPackValue(_keepAlive));
+    builder.add("async", VPackValue(_async));
+    builder.add("rate", VPackValue(_rate));
+    builder.add("warmup", VPackValue(_warmup));
+    // the median run, or the only one
+    builder.add(VPackValue("result"));
+    addResult(builder, result);
+    // all runs, fastest first
+    builder.add("runs", VPackValue(VPackValueType::Array));
+    for (auto const& it : results) {
+      addResult(builder, it);
+    }
+    builder.close();
+    builder.close();
+    json = builder.slice().toJson();
+  } catch (...) {
+    std::cerr << "Got an exception building the JSON report" << std::endl;
+    return false;
+  }
+
+  std::ofstream outfile(_jsonReportFile, std::ofstream::binary);
+  if (!outfile.is_open()) {
+    std::cerr << "Could not open JSON Report File: " << _jsonReportFile
+              << std::endl;
+    return false;
+  }
+  outfile << json << '\n';
+  outfile.close();
+  return !outfile.fail();
 }
 
 bool BenchFeature::writeJunitReport(BenchRunResult const& result) {
@@ -426,6 +546,17 @@ void BenchFeature::printResult(BenchRunResult const& result) {
   std::cout << "Operations per second rate: " << std::fixed
             << ((double)_operations / result.time) << std::endl;
 
+  if (result.latency.count > 0) {
+    std::cout << "Request latency (" << result.latency.count
+              << " requests): mean: " << std::fixed
+              << (result.latency.mean / 1000000.0)
+              << " s, 50%: " << (result.latency.p50 / 1000000.0)
+              << " s, 99%: " << (result.latency.p99 / 1000000.0)
+              << " s, 99.9%: " << (result.latency.p999 / 1000000.0)
+              << " s, max: " << (result.latency.max / 1000000.0) << " s"
+              << std::endl;
+  }
+
   std::cout << "Elapsed time since start: " << std::fixed << result.time << " s"
             << std::endl
             << std::endl;
@@ -29,17 +29,41 @@ namespace arangodb {
 
 class ClientFeature;
 
+namespace velocypack {
+class Builder;
+}
+
+namespace arangobench {
+class BenchmarkHistogram;
+}
+
+// request latencies in microseconds
+struct BenchLatency {
+  uint64_t count;
+  double mean;
+  uint64_t p50;
+  uint64_t p99;
+  uint64_t p999;
+  uint64_t max;
+
+  static BenchLatency fromHistogram(arangobench::BenchmarkHistogram const&);
+  static BenchLatency average(BenchLatency const& a, BenchLatency const& b);
+};
+
 struct BenchRunResult {
   double time;
   size_t failures;
   size_t incomplete;
   double requestTime;
+  BenchLatency latency;
 
-  void update(double _time, size_t _failures, size_t _incomplete, double _requestTime) {
+  void update(double _time, size_t _failures, size_t _incomplete, double _requestTime,
+              BenchLatency const& _latency) {
     time = _time;
     failures = _failures;
     incomplete = _incomplete;
     requestTime = _requestTime;
+    latency = _latency;
   }
 };
 
@@ -70,12 +94,18 @@ class BenchFeature final : public application_features::ApplicationFeature {
   uint64_t replicationFactor() const { return _replicationFactor; }
   uint64_t numberOfShards() const { return _numberOfShards; }
   bool waitForSync() const { return _waitForSync; }
+  double rate() const { return _rate; }
+  double warmup() const { return _warmup; }
+  std::string const& jsonReportFile() const { return _jsonReportFile; }
 
  private:
   void status(std::string const& value);
   bool report(ClientFeature*, std::vector<BenchRunResult>);
   void printResult(BenchRunResult const& result);
   bool writeJunitReport(BenchRunResult const& result);
+  bool writeJsonReport(std::vector<BenchRunResult> const& results,
+                       BenchRunResult const& result);
+  void addResult(velocypack::Builder&, BenchRunResult const& result);
 
  private:
   bool _async;
@@ -95,6 +125,9 @@ class BenchFeature final : public application_features::ApplicationFeature {
   uint64_t _replicationFactor;
   uint64_t _numberOfShards;
   bool _waitForSync;
+  double _rate;
+  double _warmup;
+  std::string _jsonReportFile;
 
  private:
   int* _result;
@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_BENCHMARK_BENCHMARK_HISTOGRAM_H
+#define ARANGODB_BENCHMARK_BENCHMARK_HISTOGRAM_H 1
+
+#include "Basics/Common.h"
+
+namespace arangodb {
+namespace arangobench {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief histogram of latencies in microseconds, in the layout of an HDR
+/// histogram with three significant digits: values below 2048 are counted
+/// exactly, every power of two above is split into 1024 linear buckets.
+/// values above MaxValue are counted as MaxValue
+////////////////////////////////////////////////////////////////////////////////
+
+class BenchmarkHistogram {
+ public:
+  static constexpr uint64_t MaxValue = (uint64_t(1) << 36) - 1;
+
+ private:
+  static constexpr size_t SubBuckets = 2048;
+  static constexpr size_t HalfSubBuckets = SubBuckets / 2;
+  static constexpr unsigned SubBucketBits = 11;
+  static constexpr size_t Size =
+      SubBuckets + (36 - SubBucketBits) * HalfSubBuckets;
+
+ public:
+  BenchmarkHistogram()
+      : _counts(Size, 0), _count(0), _min(UINT64_MAX), _max(0), _sum(0.0) {}
+
+ public:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief count one value
+  //////////////////////////////////////////////////////////////////////////////
+
+  void record(uint64_t value) {
+    if (value > MaxValue) {
+      value = MaxValue;
+    }
+    ++_counts[index(value)];
+    ++_count;
+    _sum += static_cast<double>(value);
+    if (value < _min) {
+      _min = value;
+    }
+    if (value > _max) {
+      _max = value;
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief add the counts of another histogram
+  //////////////////////////////////////////////////////////////////////////////
+
+  void merge(BenchmarkHistogram const& other) {
+    for (size_t i = 0; i < Size; ++i) {
+      _counts[i] += other._counts[i];
+    }
+    _count += other._count;
+    _sum += other._sum;
+    _min = (std::min)(_min, other._min);
+    _max = (std::max)(_max, other._max);
+  }
+
+  uint64_t count() const { return _count; }
+  uint64_t min() const { return _count == 0 ? 0 : _min; }
+  uint64_t max() const { return _max; }
+  double mean() const {
+    return _count == 0 ? 0.0 : _sum / static_cast<double>(_count);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the value below or at which the given percentage of all values
+  /// lie, as the highest value of its bucket but not more than the maximum
+  //////////////////////////////////////////////////////////////////////////////
+
+  uint64_t percentile(double percent) const {
+    if (_count == 0) {
+      return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>(
+        std::ceil(percent / 100.0 * static_cast<double>(_count)));
+    if (rank < 1) {
+      rank = 1;
+    }
+    uint64_t seen = 0;
+    for (size_t i = 0; i < Size; ++i) {
+      seen += _counts[i];
+      if (seen >= rank) {
+        return (std::min)(highestValue(i), _max);
+      }
+    }
+    return _max;
+  }
+
+ private:
+  static size_t index(uint64_t value) {
+    if (value < SubBuckets) {
+      return static_cast<size_t>(value);
+    }
+    // keep the SubBucketBits highest bits of the value
+    unsigned shift = 0;
+    while ((value >> shift) >= SubBuckets) {
+      ++shift;
+    }
+    return SubBuckets + (shift - 1) * HalfSubBuckets +
+           static_cast<size_t>((value >> shift) - HalfSubBuckets);
+  }
+
+  static uint64_t highestValue(size_t index) {
+    if (index < SubBuckets) {
+      return index;
+    }
+    size_t const shift = (index - SubBuckets) / HalfSubBuckets + 1;
+    uint64_t const sub = (index - SubBuckets) % HalfSubBuckets + HalfSubBuckets;
+    return ((sub + 1) << shift) - 1;
+  }
+
+ private:
+  std::vector<uint64_t> _counts;
+  uint64_t _count;
+  uint64_t _min;
+  uint64_t _max;
+  double _sum;
+};
+}
+}
+
+#endif
@@ -32,6 +32,7 @@
 #include "Basics/Thread.h"
 #include "Basics/hashes.h"
 #include "Benchmark/BenchmarkCounter.h"
+#include "Benchmark/BenchmarkHistogram.h"
 #include "Benchmark/BenchmarkOperation.h"
 #include "Logger/Logger.h"
 #include "Rest/HttpResponse.h"
@@ -50,7 +51,7 @@ class BenchmarkThread : public arangodb::Thread {
                   int threadNumber, const unsigned long batchSize,
                   BenchmarkCounter<unsigned long>* operationsCounter,
                   ClientFeature* client, bool keepAlive, bool async,
-                  bool verbose)
+                  bool verbose, double interval, double phase, double warmup)
       : Thread("BenchmarkThread"),
         _operation(operation),
         _startCondition(condition),
@@ -70,7 +71,12 @@ class BenchmarkThread : public arangodb::Thread {
         _offset(0),
         _counter(0),
         _time(0.0),
-        _verbose(verbose) {
+        _verbose(verbose),
+        _interval(interval),
+        _phase(phase),
+        _warmup(warmup),
+        _start(0.0),
+        _scheduled(0) {
     _errorHeader =
         basics::StringUtils::tolower(StaticStrings::Errors);
   }
@@ -131,6 +137,8 @@ class BenchmarkThread : public arangodb::Thread {
       guard.wait();
     }
 
+    _start = TRI_microtime();
+
     while (!isStopping()) {
       unsigned long numOps = _operationsCounter->next(_batchSize);
 
@@ -138,6 +146,8 @@ class BenchmarkThread : public arangodb::Thread {
         break;
       }
 
+      double const scheduled = waitForSchedule();
+
       if (_batchSize < 1) {
         executeSingleRequest();
       } else {
@@ -160,6 +170,7 @@ class BenchmarkThread : public arangodb::Thread {
         }
       }
 
+      recordLatency(scheduled);
       _operationsCounter->done(_batchSize > 0 ? _batchSize : 1);
     }
   }
@@ -185,6 +196,41 @@ class BenchmarkThread : public arangodb::Thread {
     return std::string("/_db/" + t->_databaseName + "/" + location);
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief returns the time at which the next request is due. with a rate,
+  /// requests are due at fixed intervals regardless of how long the previous
+  /// ones took, so that a slow response delays all requests behind it in
+  /// the latencies. without a rate, the next request is due right now
+  //////////////////////////////////////////////////////////////////////////////
+
+  double waitForSchedule() {
+    double const now = TRI_microtime();
+    if (_interval <= 0.0) {
+      return now;
+    }
+
+    double const scheduled =
+        _start + _phase + static_cast<double>(_scheduled++) * _interval;
+    if (scheduled > now) {
+      std::this_thread::sleep_for(
+          std::chrono::microseconds(static_cast<int64_t>((scheduled - now) * 1000000.0)));
+    }
+    return scheduled;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief records the latency of a request that was due at scheduled,
+  /// unless it was due during the warmup
+  //////////////////////////////////////////////////////////////////////////////
+
+  void recordLatency(double scheduled) {
+    if (scheduled < _start + _warmup) {
+      return;
+    }
+    double const latency = TRI_microtime() - scheduled;
+    _histogram.record(latency > 0.0 ? static_cast<uint64_t>(latency * 1000000.0) : 0);
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief execute a batch request with numOperations parts
   //////////////////////////////////////////////////////////////////////////////
@@ -382,6 +428,12 @@ class BenchmarkThread : public arangodb::Thread {
 
   double getTime() const { return _time; }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the latencies of the thread's requests in microseconds
+  //////////////////////////////////////////////////////////////////////////////
+
+  BenchmarkHistogram const& getHistogram() const { return _histogram; }
+
  private:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief the operation to benchmark
@@ -508,6 +560,42 @@ class BenchmarkThread : public arangodb::Thread {
   //////////////////////////////////////////////////////////////////////////////
 
   bool _verbose;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief seconds between two requests of the thread, 0 for closed loop
+  //////////////////////////////////////////////////////////////////////////////
+
+  double const _interval;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief seconds after the start at which the first request is due
+  //////////////////////////////////////////////////////////////////////////////
+
+  double const _phase;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief seconds after the start during which latencies are not recorded
+  //////////////////////////////////////////////////////////////////////////////
+
+  double const _warmup;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief start time of the thread
+  //////////////////////////////////////////////////////////////////////////////
+
+  double _start;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of requests scheduled so far
+  //////////////////////////////////////////////////////////////////////////////
+
+  uint64_t _scheduled;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief request latencies
+  //////////////////////////////////////////////////////////////////////////////
+
+  BenchmarkHistogram _histogram;
 };
 }
 }
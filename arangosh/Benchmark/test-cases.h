@@ -23,8 +23,13 @@
 
 #include "Basics/Common.h"
 
+#include "Basics/tri-strings.h"
 #include "Random/RandomGenerator.h"
 
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
 static bool DeleteCollection(SimpleHttpClient*, std::string const&);
 
 static bool CreateCollection(SimpleHttpClient*, std::string const&, int const);
@@ -35,6 +40,17 @@ static bool CreateDocument(SimpleHttpClient*, std::string const&,
 static bool CreateIndex(SimpleHttpClient*, std::string const&,
                         std::string const&, std::string const&);
 
+static char const* QueryPayload(VPackBuilder const&, size_t*, bool*);
+
+static bool ExecuteQuery(SimpleHttpClient*, VPackSlice, size_t*);
+
+static bool GenerateDocuments(SimpleHttpClient*, std::string const&,
+                              std::string const&);
+
+static bool DeleteView(SimpleHttpClient*, std::string const&);
+
+static bool CreateView(SimpleHttpClient*, VPackSlice);
+
 struct VersionTest : public BenchmarkOperation {
   VersionTest() : BenchmarkOperation() { _url = "/_api/version"; }
 
@@ -1555,6 +1571,303 @@ struct AqlV8Test : public BenchmarkOperation {
   }
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief base for the test cases that run an AQL query on generated data.
+/// the data is derived from the document numbers only, so that every run
+/// sees the same data. the number of generated documents is 10000 times
+/// the complexity
+////////////////////////////////////////////////////////////////////////////////
+
+struct GeneratedDataQueryTest : public BenchmarkOperation {
+  GeneratedDataQueryTest() : BenchmarkOperation() {}
+
+  void tearDown() override {}
+
+  std::string url(int const threadNumber, size_t const threadCounter,
+                  size_t const globalCounter) override {
+    return std::string("/_api/cursor");
+  }
+
+  rest::RequestType type(int const threadNumber, size_t const threadCounter,
+                         size_t const globalCounter) override {
+    return rest::RequestType::POST;
+  }
+
+  char const* payload(size_t* length, int const threadNumber,
+                      size_t const threadCounter, size_t const globalCounter,
+                      bool* mustFree) override {
+    VPackBuilder body;
+    body.openObject();
+    query(body, globalCounter);
+    body.close();
+    return QueryPayload(body, length, mustFree);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief adds the query, the bind parameters and the options of the
+  /// globalCounter-th request to the body of the cursor request
+  //////////////////////////////////////////////////////////////////////////////
+
+  virtual void query(VPackBuilder& body, size_t globalCounter) = 0;
+
+  static uint64_t documents() {
+    return 10000 * (std::max)(ARANGOBENCH->complexity(), uint64_t(1));
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief vertices v0 .. vn-1 with an edge from every vertex to its successor
+/// and two more to vertices spread over the graph
+////////////////////////////////////////////////////////////////////////////////
+
+struct GraphQueryTest : public GeneratedDataQueryTest {
+  bool setUp(SimpleHttpClient* client) override {
+    std::string const vertices = ARANGOBENCH->collection();
+    std::string const edges = ARANGOBENCH->collection() + "Edges";
+    return DeleteCollection(client, edges) &&
+           DeleteCollection(client, vertices) &&
+           CreateCollection(client, vertices, 2) &&
+           CreateCollection(client, edges, 3) &&
+           GenerateDocuments(client, vertices,
+                             "INSERT { _key: CONCAT('v', i), value: i }") &&
+           GenerateDocuments(
+               client, edges,
+               "FOR k IN [1, 7, 13] INSERT { _from: CONCAT('" + vertices +
+                   "/v', i), _to: CONCAT('" + vertices + "/v', (i * k + 1) % " +
+                   StringUtils::itoa(documents()) + ") }");
+  }
+
+  std::string vertex(size_t number) const {
+    return ARANGOBENCH->collection() + "/v" +
+           StringUtils::itoa(static_cast<uint64_t>(number % documents()));
+  }
+};
+
+struct TraversalTest : public GraphQueryTest {
+  void query(VPackBuilder& body, size_t globalCounter) override {
+    body.add("query", VPackValue("FOR v IN 1..3 OUTBOUND @start @@edges "
+                                 "RETURN v._key"));
+    body.add("bindVars", VPackValue(VPackValueType::Object));
+    body.add("start", VPackValue(vertex(globalCounter * 31)));
+    body.add("@edges", VPackValue(ARANGOBENCH->collection() + "Edges"));
+    body.close();
+  }
+};
+
+struct ShortestPathTest : public GraphQueryTest {
+  void query(VPackBuilder& body, size_t globalCounter) override {
+    body.add("query", VPackValue("FOR v IN OUTBOUND SHORTEST_PATH @start TO "
+                                 "@target @@edges RETURN v._key"));
+    body.add("bindVars", VPackValue(VPackValueType::Object));
+    body.add("start", VPackValue(vertex(globalCounter * 31)));
+    body.add("target", VPackValue(vertex(globalCounter * 31 + documents() / 2)));
+    body.add("@edges", VPackValue(ARANGOBENCH->collection() + "Edges"));
+    body.close();
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief points spread over the globe with a geo index, queried alternately
+/// for the ten nearest points and for all points within 100 km
+////////////////////////////////////////////////////////////////////////////////
+
+struct GeoTest : public GeneratedDataQueryTest {
+  bool setUp(SimpleHttpClient* client) override {
+    std::string const collection = ARANGOBENCH->collection();
+    return DeleteCollection(client, collection) &&
+           CreateCollection(client, collection, 2) &&
+           CreateIndex(client, collection, "geo", "[\"lat\",\"lon\"]") &&
+           GenerateDocuments(client, collection,
+                             "INSERT { lat: ((i * 7919) % 17000) / 100 - 85, "
+                             "lon: ((i * 104729) % 36000) / 100 - 180 }");
+  }
+
+  void query(VPackBuilder& body, size_t globalCounter) override {
+    if (globalCounter % 2 == 0) {
+      body.add("query", VPackValue("FOR d IN @@collection SORT DISTANCE(d.lat, "
+                                   "d.lon, @lat, @lon) LIMIT 10 RETURN d._key"));
+    } else {
+      body.add("query", VPackValue("FOR d IN @@collection FILTER DISTANCE(d.lat, "
+                                   "d.lon, @lat, @lon) <= 100000 RETURN d._key"));
+    }
+    body.add("bindVars", VPackValue(VPackValueType::Object));
+    body.add("@collection", VPackValue(ARANGOBENCH->collection()));
+    body.add("lat", VPackValue(static_cast<double>((globalCounter * 6007) % 17000) / 100.0 - 85.0));
+    body.add("lon", VPackValue(static_cast<double>((globalCounter * 9973) % 36000) / 100.0 - 180.0));
+    body.close();
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief texts of four words out of sixteen in an ArangoSearch view with
+/// the text_en analyzer, queried for the ten best matches of a word
+////////////////////////////////////////////////////////////////////////////////
+
+struct ArangoSearchTest : public GeneratedDataQueryTest {
+  bool setUp(SimpleHttpClient* client) override {
+    std::string const collection = ARANGOBENCH->collection();
+    std::string const view = collection + "View";
+
+    VPackBuilder properties;
+    properties.openObject();
+    properties.add("name", VPackValue(view));
+    properties.add("type", VPackValue("arangosearch"));
+    properties.add("properties", VPackValue(VPackValueType::Object));
+    properties.add("links", VPackValue(VPackValueType::Object));
+    properties.add(collection, VPackValue(VPackValueType::Object));
+    properties.add("fields", VPackValue(VPackValueType::Object));
+    properties.add("text", VPackValue(VPackValueType::Object));
+    properties.add("analyzers", VPackValue(VPackValueType::Array));
+    properties.add(VPackValue("text_en"));
+    properties.close();
+    properties.close();
+    properties.close();
+    properties.close();
+    properties.close();
+    properties.close();
+    properties.close();
+
+    if (!DeleteView(client, view) || !DeleteCollection(client, collection) ||
+        !CreateCollection(client, collection, 2) ||
+        !GenerateDocuments(
+            client, collection,
+            "LET words = " + words().slice().toJson() +
+                " INSERT { text: CONCAT_SEPARATOR(' ', words[i % 16], "
+                "words[(i * 7) % 16], words[(i * 13) % 16], "
+                "words[(i * 31) % 16]) }") ||
+        !CreateView(client, properties.slice())) {
+      return false;
+    }
+
+    // the view picks up the documents asynchronously
+    VPackBuilder body;
+    body.openObject();
+    body.add("query", VPackValue("FOR d IN VIEW " + view + " LIMIT 1 RETURN 1"));
+    body.close();
+    for (int i = 0; i < 120; ++i) {
+      size_t length = 0;
+      if (!ExecuteQuery(client, body.slice(), &length)) {
+        return false;
+      }
+      if (length > 0) {
+        return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    }
+    return false;
+  }
+
+  void query(VPackBuilder& body, size_t globalCounter) override {
+    body.add("query", VPackValue("FOR d IN VIEW " + ARANGOBENCH->collection() +
+                                 "View FILTER PHRASE(d.text, @word, 'text_en') "
+                                 "SORT BM25(d) DESC LIMIT 10 RETURN d._key"));
+    body.add("bindVars", VPackValue(VPackValueType::Object));
+    body.add("word", words().slice().at(globalCounter % 16));
+    body.close();
+  }
+
+  static VPackBuilder const& words() {
+    static VPackBuilder const words = []() {
+      VPackBuilder b;
+      b.openArray();
+      for (char const* word :
+           {"apple", "banana", "cherry", "database", "engine", "forest",
+            "garden", "harbor", "island", "jungle", "kitchen", "lemon",
+            "mountain", "network", "ocean", "planet"}) {
+        b.add(VPackValue(word));
+      }
+      b.close();
+      return b;
+    }();
+    return words;
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief COLLECT of all documents into a tenth as many groups, alternately
+/// with the hash and the sorted method
+////////////////////////////////////////////////////////////////////////////////
+
+struct AqlCollectTest : public GeneratedDataQueryTest {
+  bool setUp(SimpleHttpClient* client) override {
+    std::string const collection = ARANGOBENCH->collection();
+    return DeleteCollection(client, collection) &&
+           CreateCollection(client, collection, 2) &&
+           GenerateDocuments(client, collection,
+                             "INSERT { group: (i * 7919) % " +
+                                 StringUtils::itoa(documents() / 10) +
+                                 ", value: i }");
+  }
+
+  void query(VPackBuilder& body, size_t globalCounter) override {
+    body.add("query",
+             VPackValue(std::string("FOR d IN @@collection COLLECT g = d.group "
+                                    "AGGREGATE total = SUM(d.value), n = COUNT(1) "
+                                    "OPTIONS { method: '") +
+                        (globalCounter % 2 == 0 ? "hash" : "sorted") +
+                        "' } RETURN { g, total, n }"));
+    body.add("bindVars", VPackValue(VPackValueType::Object));
+    body.add("@collection", VPackValue(ARANGOBENCH->collection()));
+    body.close();
+    body.add("batchSize", VPackValue(10000));
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief pages of 1000 documents sorted by an attribute with a skiplist
+/// index. in a cluster, the shards sort and the coordinator merges them
+////////////////////////////////////////////////////////////////////////////////
+
+struct AqlSortedGatherTest : public GeneratedDataQueryTest {
+  bool setUp(SimpleHttpClient* client) override {
+    std::string const collection = ARANGOBENCH->collection();
+    return DeleteCollection(client, collection) &&
+           CreateCollection(client, collection, 2) &&
+           CreateIndex(client, collection, "skiplist", "[\"value\"]") &&
+           GenerateDocuments(client, collection,
+                             "INSERT { value: (i * 7919) % " +
+                                 StringUtils::itoa(documents()) +
+                                 ", payload: CONCAT('p', i) }");
+  }
+
+  void query(VPackBuilder& body, size_t globalCounter) override {
+    body.add("query", VPackValue("FOR d IN @@collection SORT d.value "
+                                 "LIMIT @offset, 1000 RETURN d"));
+    body.add("bindVars", VPackValue(VPackValueType::Object));
+    body.add("@collection", VPackValue(ARANGOBENCH->collection()));
+    body.add("offset", VPackValue((globalCounter * 997) % (documents() - 1000)));
+    body.close();
+    body.add("batchSize", VPackValue(1000));
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief streaming cursors whose first and only batch carries 10000
+/// documents
+////////////////////////////////////////////////////////////////////////////////
+
+struct StreamCursorBatchTest : public GeneratedDataQueryTest {
+  bool setUp(SimpleHttpClient* client) override {
+    std::string const collection = ARANGOBENCH->collection();
+    return DeleteCollection(client, collection) &&
+           CreateCollection(client, collection, 2) &&
+           GenerateDocuments(client, collection,
+                             "INSERT { value: i, payload: CONCAT('p', i) }");
+  }
+
+  void query(VPackBuilder& body, size_t globalCounter) override {
+    body.add("query", VPackValue("FOR d IN @@collection LIMIT @offset, 10000 RETURN d"));
+    body.add("bindVars", VPackValue(VPackValueType::Object));
+    body.add("@collection", VPackValue(ARANGOBENCH->collection()));
+    body.add("offset", VPackValue(((globalCounter * 10000) % documents())));
+    body.close();
+    body.add("batchSize", VPackValue(10000));
+    body.add("options", VPackValue(VPackValueType::Object));
+    body.add("stream", VPackValue(true));
+    body.close();
+  }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief delete a collection
 ////////////////////////////////////////////////////////////////////////////////
@@ -1673,6 +1986,134 @@ static bool CreateDocument(SimpleHttpClient* client,
   return !failed;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the cursor request body as payload to free by the caller
+////////////////////////////////////////////////////////////////////////////////
+
+static char const* QueryPayload(VPackBuilder const& body, size_t* length,
+                                bool* mustFree) {
+  std::string const json = body.slice().toJson();
+  *length = json.size();
+  *mustFree = true;
+  return TRI_DuplicateString(json.c_str(), json.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief execute an AQL query, optionally returns the length of the first
+/// batch of results
+////////////////////////////////////////////////////////////////////////////////
+
+static bool ExecuteQuery(SimpleHttpClient* client, VPackSlice body,
+                         size_t* resultLength) {
+  std::unordered_map<std::string, std::string> headerFields;
+  std::string const payload = body.toJson();
+
+  std::unique_ptr<SimpleHttpResult> result(
+      client->request(rest::RequestType::POST, "/_api/cursor",
+                      payload.c_str(), payload.size(), headerFields));
+
+  if (result == nullptr || result->getHttpReturnCode() != 201) {
+    if (result != nullptr) {
+      LOG_TOPIC(WARN, arangodb::Logger::FIXME)
+          << "query failed: " << result->getBody().c_str();
+    }
+    return false;
+  }
+
+  if (resultLength != nullptr) {
+    try {
+      auto answer = result->getBodyVelocyPack();
+      VPackSlice r = answer->slice().get("result");
+      *resultLength = r.isArray() ? static_cast<size_t>(r.length()) : 0;
+    } catch (...) {
+      return false;
+    }
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief fill a collection, insert is the body of a loop over the document
+/// numbers i of the test case, which inserts into the collection
+////////////////////////////////////////////////////////////////////////////////
+
+static bool GenerateDocuments(SimpleHttpClient* client,
+                              std::string const& collection,
+                              std::string const& insert) {
+  uint64_t const n = GeneratedDataQueryTest::documents();
+  // one transaction per chunk, to keep them reasonably small
+  uint64_t const chunk = 10000;
+
+  for (uint64_t from = 0; from < n; from += chunk) {
+    VPackBuilder body;
+    body.openObject();
+    body.add("query", VPackValue("FOR i IN @from..@to " + insert +
+                                 " INTO @@collection"));
+    body.add("bindVars", VPackValue(VPackValueType::Object));
+    body.add("from", VPackValue(from));
+    body.add("to", VPackValue((std::min)(from + chunk, n) - 1));
+    body.add("@collection", VPackValue(collection));
+    body.close();
+    body.close();
+
+    if (!ExecuteQuery(client, body.slice(), nullptr)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief delete a view
+////////////////////////////////////////////////////////////////////////////////
+
+static bool DeleteView(SimpleHttpClient* client, std::string const& name) {
+  std::unordered_map<std::string, std::string> headerFields;
+  SimpleHttpResult* result = nullptr;
+
+  result = client->request(rest::RequestType::DELETE_REQ,
+                           "/_api/view/" + name, "", 0, headerFields);
+
+  bool failed = true;
+  if (result != nullptr) {
+    int statusCode = result->getHttpReturnCode();
+    if (statusCode == 200 || statusCode == 201 || statusCode == 202 ||
+        statusCode == 404) {
+      failed = false;
+    }
+
+    delete result;
+  }
+
+  return !failed;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a view
+////////////////////////////////////////////////////////////////////////////////
+
+static bool CreateView(SimpleHttpClient* client, VPackSlice properties) {
+  std::unordered_map<std::string, std::string> headerFields;
+  SimpleHttpResult* result = nullptr;
+
+  std::string const payload = properties.toJson();
+  result = client->request(rest::RequestType::POST, "/_api/view",
+                           payload.c_str(), payload.size(), headerFields);
+
+  bool failed = true;
+
+  if (result != nullptr) {
+    if (result->getHttpReturnCode() == 200 ||
+        result->getHttpReturnCode() == 201) {
+      failed = false;
+    }
+
+    delete result;
+  }
+
+  return !failed;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return the test case for a name
 ////////////////////////////////////////////////////////////////////////////////
@@ -1741,6 +2182,27 @@ static BenchmarkOperation* GetTestCase(std::string const& name) {
   if (name == "stream-cursor") {
     return new StreamCursorTest();
   }
+  if (name == "stream-cursor-batch") {
+    return new StreamCursorBatchTest();
+  }
+  if (name == "traversal") {
+    return new TraversalTest();
+  }
+  if (name == "shortest-path") {
+    return new ShortestPathTest();
+  }
+  if (name == "geo") {
+    return new GeoTest();
+  }
+  if (name == "arangosearch") {
+    return new ArangoSearchTest();
+  }
+  if (name == "aql-collect") {
+    return new AqlCollectTest();
+  }
+  if (name == "aql-sorted-gather") {
+    return new AqlSortedGatherTest();
+  }
 
   return nullptr;
 }
@@ -338,7 +338,14 @@ arangodb::Result handleCollectionCluster(
   VPackSlice const shards = parameters.get("shards");
 
   // Iterate over the Map of shardId to server list
+  int index = -1;
   for (auto const it : VPackObjectIterator(shards)) {
+    ++index;
+    if (jobData.part >= 0 && index != jobData.part) {
+      // another job dumps this shard
+      continue;
+    }
+
     // extract shard name
     TRI_ASSERT(it.key.isString());
     std::string shardName = it.key.copyString();
@@ -387,14 +394,20 @@ arangodb::Result processJob(arangodb::httpclient::SimpleHttpClient& client,
   std::string const hexString(
       arangodb::rest::SslInterface::sslMD5(jobData.name));
 
+  // the structure is saved once per collection, by the job of its first
+  // part, if the shards are dumped in parallel
+  bool const first = (jobData.part <= 0);
+
   // found a collection!
-  if (jobData.options.progress) {
+  if (jobData.options.progress && first) {
     LOG_TOPIC(INFO, arangodb::Logger::DUMP)
         << "# Dumping collection '" << jobData.name << "'...";
   }
-  ++(jobData.stats.totalCollections);
+  if (first) {
+    ++(jobData.stats.totalCollections);
+  }
 
-  {
+  if (first) {
     // save meta data
     auto file = jobData.directory.writableFile(
         jobData.name + (jobData.options.clusterMode ? "" : ("_" + hexString)) +
@@ -429,8 +442,15 @@ arangodb::Result processJob(arangodb::httpclient::SimpleHttpClient& client,
 
   if (result.ok() && jobData.options.dumpData) {
     // save the actual data
-    auto file = jobData.directory.writableFile(
-        jobData.name + "_" + hexString + ".data.json", true);
+    std::string filename = jobData.name + "_" + hexString;
+    if (jobData.part >= 0) {
+      filename += "." + std::to_string(jobData.part);
+    }
+    filename += ".data.json";
+    if (jobData.options.compressOutput) {
+      filename += ".gz";
+    }
+    auto file = jobData.directory.writableFile(filename, true);
     if (!::fileOk(file.get())) {
       return ::fileError(file.get(), true);
     }
@@ -461,7 +481,7 @@ DumpFeature::JobData::JobData(ManagedDirectory& dir, DumpFeature& feat,
                               Options const& opts, Stats& stat,
                               VPackSlice const& info, uint64_t const batch,
                               std::string const& c, std::string const& n,
-                              std::string const& t)
+                              std::string const& t, int const p)
     : directory{dir},
       feature{feat},
       options{opts},
@@ -470,7 +490,8 @@ DumpFeature::JobData::JobData(ManagedDirectory& dir, DumpFeature& feat,
       batchId{batch},
       cid{c},
       name{n},
-      type{t} {}
+      type{t},
+      part{p} {}
 
 DumpFeature::DumpFeature(application_features::ApplicationServer* server,
                          int& exitCode)
@@ -522,6 +543,15 @@ void DumpFeature::collectOptions(
   options->addOption("--dump-data", "dump collection data",
                      new BooleanParameter(&_options.dumpData));
 
+  options->addOption("--compress-output",
+                     "compress the data files with gzip",
+                     new BooleanParameter(&_options.compressOutput));
+
+  options->addOption("--parallel-shards",
+                     "dump the shards of a collection in parallel, into one "
+                     "file per shard (cluster only)",
+                     new BooleanParameter(&_options.parallelShards));
+
   options->addOption(
       "--force", "continue dumping even in the face of some server-side errors",
       new BooleanParameter(&_options.force));
@@ -742,7 +772,7 @@ Result DumpFeature::runDump(httpclient::SimpleHttpClient& client,
     // queue job to actually dump collection
     auto jobData = std::make_unique<JobData>(
         *_directory, *this, _options, _stats, collection, batchId,
-        std::to_string(cid), name, collectionType);
+        std::to_string(cid), name, collectionType, -1 /* part */);
     _clientTaskQueue.queueJob(std::move(jobData));
   }
   
@@ -889,11 +919,23 @@ Result DumpFeature::runClusterDump(httpclient::SimpleHttpClient& client) {
       }
     }
 
-    // queue job to actually dump collection
-    auto jobData = std::make_unique<JobData>(
-        *_directory, *this, _options, _stats, collection, 0 /* batchId */,
-        std::to_string(cid), name, "" /* collectionType */);
-    _clientTaskQueue.queueJob(std::move(jobData));
+    // queue jobs to actually dump collection, one per shard if requested
+    VPackSlice const shards = parameters.get("shards");
+    int const parts = (_options.parallelShards && shards.isObject())
+                          ? static_cast<int>(shards.length())
+                          : 0;
+    if (parts == 0) {
+      auto jobData = std::make_unique<JobData>(
+          *_directory, *this, _options, _stats, collection, 0 /* batchId */,
+          std::to_string(cid), name, "" /* collectionType */, -1 /* part */);
+      _clientTaskQueue.queueJob(std::move(jobData));
+    }
+    for (int part = 0; part < parts; ++part) {
+      auto jobData = std::make_unique<JobData>(
+          *_directory, *this, _options, _stats, collection, 0 /* batchId */,
+          std::to_string(cid), name, "" /* collectionType */, part);
+      _clientTaskQueue.queueJob(std::move(jobData));
+    }
   }
 
   // wait for all jobs to finish, then check for errors
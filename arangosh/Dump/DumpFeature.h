@@ -71,11 +71,13 @@ class DumpFeature : public application_features::ApplicationFeature {
     uint64_t tickStart{0};
     uint64_t tickEnd{0};
     bool clusterMode{false};
+    bool compressOutput{false};
     bool dumpData{true};
     bool force{false};
     bool ignoreDistributeShardsLikeErrors{false};
     bool includeSystemCollections{false};
     bool overwrite{true};
+    bool parallelShards{false};
     bool progress{true};
   };
 
@@ -90,7 +92,7 @@ class DumpFeature : public application_features::ApplicationFeature {
   struct JobData {
     JobData(ManagedDirectory&, DumpFeature&, Options const&, Stats&,
             VPackSlice const&, uint64_t const, std::string const&,
-            std::string const&, std::string const&);
+            std::string const&, std::string const&, int const);
 
     ManagedDirectory& directory;
     DumpFeature& feature;
@@ -102,6 +104,9 @@ class DumpFeature : public application_features::ApplicationFeature {
     std::string const cid;
     std::string const name;
     std::string const type;
+    /// @brief index of the only shard to dump into a part file of the
+    /// collection, or -1 to dump all shards into one file
+    int const part;
   };
 
  private:
@@ -24,8 +24,10 @@
 
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/FileUtils.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/OpenFilesTracker.h"
 #include "Basics/StringUtils.h"
+#include "Basics/process-utils.h"
 #include "Logger/Logger.h"
 #include "ProgramOptions/ProgramOptions.h"
 #include "Shell/ClientFeature.h"
@@ -33,17 +35,119 @@
 #include "SimpleHttpClient/SimpleHttpClient.h"
 #include "SimpleHttpClient/SimpleHttpResult.h"
 
+#include <boost/algorithm/clamp.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/property_tree/detail/xml_parser_utils.hpp>
-#include <regex>
 #include <iostream>
 
+#include "zlib.h"
+
 using namespace arangodb;
 using namespace arangodb::basics;
 using namespace arangodb::httpclient;
 using namespace arangodb::options;
 using namespace boost::property_tree::xml_parser;
 
+namespace {
+/// @brief compresses data into one complete gzip member
+std::string gzipCompress(std::string const& data, std::string const& path) {
+  z_stream zs;
+  memset(&zs, 0, sizeof(z_stream));
+  // 16 selects the gzip format
+  if (deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  std::string out;
+  out.resize(deflateBound(&zs, static_cast<uLong>(data.size())));
+  zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+  zs.avail_in = static_cast<uInt>(data.size());
+  zs.next_out = reinterpret_cast<Bytef*>(&out[0]);
+  zs.avail_out = static_cast<uInt>(out.size());
+
+  int res = deflate(&zs, Z_FINISH);
+  out.resize(out.size() - zs.avail_out);
+  deflateEnd(&zs);
+
+  if (res != Z_STREAM_END) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_WRITE_FILE,
+                                   "cannot compress data for file '" + path + "'");
+  }
+  return out;
+}
+}  // namespace
+
+ExportFeature::OutputFile::OutputFile(std::string const& path, bool compress)
+    : pendingJobs(0), _path(path), _compress(compress), _fd(-1), _hasItems(false) {
+  // remove an existing file first
+  if (TRI_ExistsFile(_path.c_str())) {
+    TRI_UnlinkFile(_path.c_str());
+  }
+
+  _fd = TRI_TRACKED_CREATE_FILE(_path.c_str(), O_CREAT | O_EXCL | O_RDWR | TRI_O_CLOEXEC,
+                                S_IRUSR | S_IWUSR);
+
+  if (_fd < 0) {
+    std::string errorMsg = "cannot write to file '" + _path + "'";
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_WRITE_FILE, errorMsg);
+  }
+}
+
+ExportFeature::OutputFile::~OutputFile() {
+  try {
+    close();
+  } catch (...) {
+  }
+}
+
+void ExportFeature::OutputFile::write(std::string const& data) {
+  if (data.empty()) {
+    return;
+  }
+  std::string const prepared = prepare(data);
+
+  MUTEX_LOCKER(locker, _lock);
+  append(prepared);
+}
+
+void ExportFeature::OutputFile::writeItems(std::string const& items) {
+  if (items.empty()) {
+    return;
+  }
+  std::string const prepared = prepare(items);
+
+  MUTEX_LOCKER(locker, _lock);
+  if (_hasItems) {
+    append(prepare(","));
+  }
+  append(prepared);
+  _hasItems = true;
+}
+
+void ExportFeature::OutputFile::close() {
+  MUTEX_LOCKER(locker, _lock);
+  if (_fd >= 0) {
+    TRI_TRACKED_CLOSE_FILE(_fd);
+    _fd = -1;
+  }
+}
+
+std::string ExportFeature::OutputFile::prepare(std::string const& data) const {
+  if (!_compress) {
+    return data;
+  }
+  return ::gzipCompress(data, _path);
+}
+
+void ExportFeature::OutputFile::append(std::string const& data) {
+  TRI_ASSERT(_fd >= 0);
+  if (!TRI_WritePointer(_fd, data.c_str(), data.size())) {
+    std::string errorMsg = "cannot write to file '" + _path + "'";
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_WRITE_FILE, errorMsg);
+  }
+}
+
 ExportFeature::ExportFeature(application_features::ApplicationServer* server,
                              int* result)
     : ApplicationFeature(server, "Export"),
@@ -57,12 +161,22 @@ ExportFeature::ExportFeature(application_features::ApplicationServer* server,
       _outputDirectory(),
       _overwrite(false),
       _progress(true),
-      _firstLine(true),
+      _compressOutput(false),
+      _threadCount(2),
       _skippedDeepNested(0),
       _httpRequestsDone(0),
-      _currentCollection(),
       _currentGraph(),
-      _result(result) {
+      _result(result),
+      _clientManager(Logger::COMMUNICATION),
+      _clientTaskQueue(
+          [this](SimpleHttpClient& client, JobData& jobData) {
+            return processJob(client, jobData);
+          },
+          [this](std::unique_ptr<JobData>&&, Result const& result) {
+            if (result.fail()) {
+              reportError(result);
+            }
+          }) {
   requiresElevatedPrivileges(false);
   setOptional(false);
   startsAfter("Client");
@@ -101,6 +215,15 @@ void ExportFeature::collectOptions(
   options->addOption("--progress", "show progress",
                      new BooleanParameter(&_progress));
 
+  options->addOption("--threads",
+                     "maximum number of collections or partitions of a "
+                     "collection to export in parallel",
+                     new UInt32Parameter(&_threadCount));
+
+  options->addOption("--compress-output",
+                     "compress the output files with gzip",
+                     new BooleanParameter(&_compressOutput));
+
   options->addOption("--fields",
                      "comma separated list of fileds to export into a csv file",
                      new StringParameter(&_csvFieldOptions));
@@ -168,6 +291,13 @@ void ExportFeature::validateOptions(
 
     boost::split(_csvFields, _csvFieldOptions, boost::is_any_of(","));
   }
+
+  uint32_t clamped = boost::algorithm::clamp(
+      _threadCount, 1, 4 * static_cast<uint32_t>(TRI_numberProcessors()));
+  if (_threadCount != clamped) {
+    LOG_TOPIC(WARN, Logger::CONFIG) << "capping --threads value to " << clamped;
+    _threadCount = clamped;
+  }
 }
 
 void ExportFeature::prepare() {
@@ -266,9 +396,8 @@ void ExportFeature::start() {
       collectionExport(httpClient.get());
 
       for (auto const& collection : _collections) {
-        std::string filePath = _outputDirectory + TRI_DIR_SEPARATOR_STR +
-                               collection + "." + _typeExport;
-        int64_t fileSize = TRI_SizeFile(filePath.c_str());
+        std::string const path = filePath(collection);
+        int64_t fileSize = TRI_SizeFile(path.c_str());
 
         if (0 < fileSize) {
           exportedSize += fileSize;
@@ -277,14 +406,13 @@ void ExportFeature::start() {
     } else if (!_query.empty()) {
       queryExport(httpClient.get());
         
-      std::string filePath = _outputDirectory + TRI_DIR_SEPARATOR_STR + "query." + _typeExport;
-      exportedSize += TRI_SizeFile(filePath.c_str());
+      std::string const path = filePath("query");
+      exportedSize += TRI_SizeFile(path.c_str());
     }
   } else if (_typeExport == "xgmml" && _graphName.size()) {
     graphExport(httpClient.get());
-    std::string filePath = _outputDirectory + TRI_DIR_SEPARATOR_STR +
-                           _graphName + "." + _typeExport;
-    int64_t fileSize = TRI_SizeFile(filePath.c_str());
+    std::string const path = filePath(_graphName);
+    int64_t fileSize = TRI_SizeFile(path.c_str());
 
     if (0 < fileSize) {
       exportedSize += fileSize;
@@ -292,14 +420,34 @@ void ExportFeature::start() {
   }
 
   std::cout << "Processed " << _collections.size() << " collection(s), wrote "
-            << exportedSize << " byte(s), " << _httpRequestsDone
+            << exportedSize << " byte(s), " << _httpRequestsDone.load()
             << " HTTP request(s)" << std::endl;
 
   *_result = ret;
 }
 
 void ExportFeature::collectionExport(SimpleHttpClient* httpClient) {
-  std::string errorMsg;
+  // a single server with the RocksDB engine splits a collection into key
+  // ranges of one snapshot, which are exported in parallel. otherwise
+  // several collections are exported in parallel
+  Result res;
+  bool isCluster = false;
+  std::tie(res, isCluster) = _clientManager.getArangoIsCluster(*httpClient);
+  if (res.fail()) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+  bool isRocksDB = false;
+  std::tie(res, isRocksDB) =
+      _clientManager.getArangoIsUsingEngine(*httpClient, "rocksdb");
+  if (res.fail()) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+  bool const partitioned = !isCluster && isRocksDB;
+
+  if (!_clientTaskQueue.spawnWorkers(_clientManager, _threadCount)) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   "cannot start export threads");
+  }
 
   for (auto const& collection : _collections) {
     if (_progress) {
@@ -307,82 +455,131 @@ void ExportFeature::collectionExport(SimpleHttpClient* httpClient) {
                 << std::endl;
     }
 
-    _currentCollection = collection;
+    if (!partitioned) {
+      auto jobData = std::make_unique<JobData>();
+      jobData->collection = collection;
+      _clientTaskQueue.queueJob(std::move(jobData));
+      continue;
+    }
+
+    auto file = openFile(collection, collection);
+    std::vector<std::string> partitions =
+        partitionCollection(httpClient, collection);
+
+    file->pendingJobs = partitions.size();
+    for (auto const& partition : partitions) {
+      auto jobData = std::make_unique<JobData>();
+      jobData->file = file;
+      jobData->collection = collection;
+      jobData->partition = partition;
+      _clientTaskQueue.queueJob(std::move(jobData));
+    }
+    if (partitions.empty()) {
+      finishFile(*file);
+    }
 
-    std::string fileName = _outputDirectory + TRI_DIR_SEPARATOR_STR +
-                           collection + "." + _typeExport;
+    // the partitions expire if they are not read, so they are exported
+    // before the next collection is split
+    _clientTaskQueue.waitForIdle();
 
-    // remove an existing file first
-    if (TRI_ExistsFile(fileName.c_str())) {
-      TRI_UnlinkFile(fileName.c_str());
+    MUTEX_LOCKER(lock, _workerErrorLock);
+    if (!_workerErrors.empty()) {
+      break;
     }
+  }
 
-    std::string const url = "_api/cursor";
+  _clientTaskQueue.waitForIdle();
 
-    VPackBuilder post;
-    post.openObject();
-    post.add("query", VPackValue("FOR doc IN @@collection RETURN doc"));
-    post.add("bindVars", VPackValue(VPackValueType::Object));
-    post.add("@collection", VPackValue(collection));
-    post.close();
-    post.add("options", VPackValue(VPackValueType::Object));
-    post.add("stream", VPackSlice::trueSlice());
-    post.close();
-    post.close();
+  MUTEX_LOCKER(lock, _workerErrorLock);
+  if (!_workerErrors.empty()) {
+    THROW_ARANGO_EXCEPTION(_workerErrors.front());
+  }
+}
 
-    std::shared_ptr<VPackBuilder> parsedBody =
-        httpCall(httpClient, url, rest::RequestType::POST, post.toJson());
-    VPackSlice body = parsedBody->slice();
+std::vector<std::string> ExportFeature::partitionCollection(
+    SimpleHttpClient* httpClient, std::string const& collection) {
+  std::string const url =
+      "/_api/export?collection=" + StringUtils::urlEncode(collection);
+
+  VPackBuilder post;
+  post.openObject();
+  post.add("partitions", VPackValue(_threadCount));
+  post.close();
 
-    int fd =
-        TRI_TRACKED_CREATE_FILE(fileName.c_str(), O_CREAT | O_EXCL | O_RDWR | TRI_O_CLOEXEC,
-                   S_IRUSR | S_IWUSR);
+  std::shared_ptr<VPackBuilder> parsedBody = httpCall(
+      httpClient, url, rest::RequestType::POST, post.toJson(), collection);
 
-    if (fd < 0) {
-      errorMsg = "cannot write to file '" + fileName + "'";
-      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_WRITE_FILE, errorMsg);
+  std::vector<std::string> partitions;
+  VPackSlice ids = parsedBody->slice().get("partitions");
+  if (ids.isArray()) {
+    for (auto const& id : VPackArrayIterator(ids)) {
+      if (id.isString()) {
+        partitions.emplace_back(id.copyString());
+      }
     }
+  }
+  return partitions;
+}
 
-    TRI_DEFER(TRI_TRACKED_CLOSE_FILE(fd));
-
-    writeFirstLine(fd, fileName, collection);
+Result ExportFeature::processJob(SimpleHttpClient& client, JobData& jobData) {
+  try {
+    if (jobData.partition.empty()) {
+      auto file = openFile(jobData.collection, jobData.collection);
+
+      VPackBuilder post;
+      post.openObject();
+      post.add("query", VPackValue("FOR doc IN @@collection RETURN doc"));
+      post.add("bindVars", VPackValue(VPackValueType::Object));
+      post.add("@collection", VPackValue(jobData.collection));
+      post.close();
+      post.add("options", VPackValue(VPackValueType::Object));
+      post.add("stream", VPackSlice::trueSlice());
+      post.close();
+      post.close();
+
+      cursorExport(&client, post, *file, jobData.collection);
+      finishFile(*file);
+      return Result();
+    }
 
-    writeBatch(fd, VPackArrayIterator(body.get("result")), fileName);
+    std::string const url = "/_api/export/" + jobData.partition;
+    bool hasMore;
+    do {
+      std::shared_ptr<VPackBuilder> parsedBody = httpCall(
+          &client, url, rest::RequestType::PUT, "", jobData.collection);
+      VPackSlice body = parsedBody->slice();
 
-    while (body.hasKey("id")) {
-      std::string const url = "/_api/cursor/" + body.get("id").copyString();
-      parsedBody = httpCall(httpClient, url, rest::RequestType::PUT);
-      body = parsedBody->slice();
+      writeBatch(*jobData.file, VPackArrayIterator(body.get("result")));
+      hasMore = body.get("hasMore").isTrue();
+    } while (hasMore);
 
-      writeBatch(fd, VPackArrayIterator(body.get("result")), fileName);
+    if (--jobData.file->pendingJobs == 0) {
+      finishFile(*jobData.file);
     }
+  } catch (basics::Exception const& ex) {
+    return Result(ex.code(), ex.what());
+  } catch (std::exception const& ex) {
+    return Result(TRI_ERROR_INTERNAL, ex.what());
+  } catch (...) {
+    return Result(TRI_ERROR_INTERNAL);
+  }
+  return Result();
+}
 
-    if (_typeExport == "json") {
-      std::string closingBracket = "\n]";
-      writeToFile(fd, closingBracket, fileName);
-    } else if (_typeExport == "xml") {
-      std::string xmlFooter = "</collection>";
-      writeToFile(fd, xmlFooter, fileName);
-    }
+void ExportFeature::reportError(Result const& error) {
+  try {
+    MUTEX_LOCKER(lock, _workerErrorLock);
+    _workerErrors.emplace(error);
+    _clientTaskQueue.clearQueue();
+  } catch (...) {
   }
 }
 
 void ExportFeature::queryExport(SimpleHttpClient* httpClient) {
-  std::string errorMsg;
-
   if (_progress) {
     std::cout << "# Running AQL query '" << _query << "'..." << std::endl;
   }
 
-  std::string fileName = _outputDirectory + TRI_DIR_SEPARATOR_STR + "query." + _typeExport;
-
-  // remove an existing file first
-  if (TRI_ExistsFile(fileName.c_str())) {
-    TRI_UnlinkFile(fileName.c_str());
-  }
-
-  std::string const url = "_api/cursor";
-
   VPackBuilder post;
   post.openObject();
   post.add("query", VPackValue(_query));
@@ -391,47 +588,62 @@ void ExportFeature::queryExport(SimpleHttpClient* httpClient) {
   post.close();
   post.close();
 
-  std::shared_ptr<VPackBuilder> parsedBody =
-      httpCall(httpClient, url, rest::RequestType::POST, post.toJson());
-  VPackSlice body = parsedBody->slice();
-
-  int fd =
-      TRI_TRACKED_CREATE_FILE(fileName.c_str(), O_CREAT | O_EXCL | O_RDWR | TRI_O_CLOEXEC,
-                  S_IRUSR | S_IWUSR);
-
-  if (fd < 0) {
-    errorMsg = "cannot write to file '" + fileName + "'";
-    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_WRITE_FILE, errorMsg);
-  }
+  auto file = openFile("query", "");
+  cursorExport(httpClient, post, *file, "");
+  finishFile(*file);
+}
 
-  TRI_DEFER(TRI_TRACKED_CLOSE_FILE(fd));
+void ExportFeature::cursorExport(SimpleHttpClient* httpClient,
+                                 VPackBuilder const& post, OutputFile& file,
+                                 std::string const& collection) {
+  std::string const url = "_api/cursor";
 
-  writeFirstLine(fd, fileName, "");
+  std::shared_ptr<VPackBuilder> parsedBody = httpCall(
+      httpClient, url, rest::RequestType::POST, post.toJson(), collection);
+  VPackSlice body = parsedBody->slice();
 
-  writeBatch(fd, VPackArrayIterator(body.get("result")), fileName);
+  writeBatch(file, VPackArrayIterator(body.get("result")));
 
   while (body.hasKey("id")) {
     std::string const url = "/_api/cursor/" + body.get("id").copyString();
-    parsedBody = httpCall(httpClient, url, rest::RequestType::PUT);
+    parsedBody =
+        httpCall(httpClient, url, rest::RequestType::PUT, "", collection);
     body = parsedBody->slice();
 
-    writeBatch(fd, VPackArrayIterator(body.get("result")), fileName);
+    writeBatch(file, VPackArrayIterator(body.get("result")));
+  }
+}
+
+std::string ExportFeature::filePath(std::string const& name) const {
+  std::string path =
+      _outputDirectory + TRI_DIR_SEPARATOR_STR + name + "." + _typeExport;
+  if (_compressOutput) {
+    path += ".gz";
   }
+  return path;
+}
+
+std::shared_ptr<ExportFeature::OutputFile> ExportFeature::openFile(
+    std::string const& name, std::string const& collection) {
+  auto file = std::make_shared<OutputFile>(filePath(name), _compressOutput);
+  file->write(firstLine(collection));
+  return file;
+}
 
+void ExportFeature::finishFile(OutputFile& file) {
   if (_typeExport == "json") {
     std::string closingBracket = "\n]";
-    writeToFile(fd, closingBracket, fileName);
+    file.write(closingBracket);
   } else if (_typeExport == "xml") {
     std::string xmlFooter = "</collection>";
-    writeToFile(fd, xmlFooter, fileName);
+    file.write(xmlFooter);
   }
+  file.close();
 }
 
-void ExportFeature::writeFirstLine(int fd, std::string const& fileName, std::string const& collection) {
-  _firstLine = true;
+std::string ExportFeature::firstLine(std::string const& collection) {
   if (_typeExport == "json") {
-    std::string openingBracket = "[";
-    writeToFile(fd, openingBracket, fileName);
+    return "[";
 
   } else if (_typeExport == "xml") {
     std::string xmlHeader =
@@ -439,7 +651,7 @@ void ExportFeature::writeFirstLine(int fd, std::string const& fileName, std::str
         "<collection name=\"";
     xmlHeader.append(encode_char_entities(collection));
     xmlHeader.append("\">\n");
-    writeToFile(fd, xmlHeader, fileName);
+    return xmlHeader;
 
   } else if (_typeExport == "csv") {
     std::string firstLine = "";
@@ -453,36 +665,33 @@ void ExportFeature::writeFirstLine(int fd, std::string const& fileName, std::str
       }
     }
     firstLine += "\n";
-    writeToFile(fd, firstLine, fileName);
+    return firstLine;
   }
+  return "";
 }
 
-void ExportFeature::writeBatch(int fd, VPackArrayIterator it, std::string const& fileName) {
-  std::string line;
-  line.reserve(1024);
+void ExportFeature::writeBatch(OutputFile& file, VPackArrayIterator it) {
+  // the whole batch is formatted first and written at once
+  std::string out;
+  out.reserve(1024);
 
   if (_typeExport == "jsonl") {
     for (auto const& doc : it) {
-      line.clear();
-      line += doc.toJson();
-      line.push_back('\n');
-      writeToFile(fd, line, fileName);
+      out += doc.toJson();
+      out.push_back('\n');
     }
   } else if (_typeExport == "json") {
     for (auto const& doc : it) {
-      line.clear();
-      if (!_firstLine) {
-        line.append(",\n  ", 4);
-      } else {
-        line.append("\n  ", 3);
-        _firstLine = false;
+      if (!out.empty()) {
+        out.push_back(',');
       }
-      line += doc.toJson();
-      writeToFile(fd, line, fileName);
+      out.append("\n  ", 3);
+      out += doc.toJson();
     }
+    file.writeItems(out);
+    return;
   } else if (_typeExport == "csv") {
     for (auto const& doc : it) {
-      line.clear();
       bool isFirstValue = true;
 
       for (auto const& key : _csvFields) {
@@ -491,7 +700,7 @@ void ExportFeature::writeBatch(int fd, VPackArrayIterator it, std::string const&
         if (isFirstValue) {
           isFirstValue = false;
         } else {
-          line.append(",");
+          out.append(",");
         }
 
         if (doc.hasKey(key)) {
@@ -507,7 +716,7 @@ void ExportFeature::writeBatch(int fd, VPackArrayIterator it, std::string const&
             }
           }
 
-          value = std::regex_replace(value, std::regex("\""), "\"\"");
+          boost::replace_all(value, "\"", "\"\"");
 
           if (value.find(",") != std::string::npos ||
               value.find("\"\"") != std::string::npos) {
@@ -515,39 +724,29 @@ void ExportFeature::writeBatch(int fd, VPackArrayIterator it, std::string const&
             value.append("\"");
           }
         }
-        line.append(value);
+        out.append(value);
       }
-      line.append("\n");
-      writeToFile(fd, line, fileName);
+      out.append("\n");
     }
   } else if (_typeExport == "xml") {
     for (auto const& doc : it) {
-      line.clear();
-      line.append("<doc key=\"");
-      line.append(encode_char_entities(doc.get("_key").copyString()));
-      line.append("\">\n");
-      writeToFile(fd, line, fileName);
+      out.append("<doc key=\"");
+      out.append(encode_char_entities(doc.get("_key").copyString()));
+      out.append("\">\n");
       for (auto const& att : VPackObjectIterator(doc)) {
-        xgmmlWriteOneAtt(fd, fileName, att.value, att.key.copyString(), 2);
+        xgmmlWriteOneAtt(out, att.value, att.key.copyString(), 2);
       }
-      line.clear();
-      line.append("</doc>\n");
-      writeToFile(fd, line, fileName);
+      out.append("</doc>\n");
     }
   }
-}
 
-void ExportFeature::writeToFile(int fd, std::string const& line,
-                                std::string const& fileName) {
-  if (!TRI_WritePointer(fd, line.c_str(), line.size())) {
-    std::string errorMsg = "cannot write to file '" + fileName + "'";
-    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_WRITE_FILE, errorMsg);
-  }
+  file.write(out);
 }
 
 std::shared_ptr<VPackBuilder> ExportFeature::httpCall(
     SimpleHttpClient* httpClient, std::string const& url,
-    rest::RequestType requestType, std::string postBody) {
+    rest::RequestType requestType, std::string postBody,
+    std::string const& collection) {
   std::string errorMsg;
 
   std::unique_ptr<SimpleHttpResult> response(
@@ -567,8 +766,8 @@ std::shared_ptr<VPackBuilder> ExportFeature::httpCall(
       if (_currentGraph.size()) {
         LOG_TOPIC(FATAL, Logger::CONFIG) << "Graph '" << _currentGraph
                                          << "' not found.";
-      } else if (_currentCollection.size()) {
-        LOG_TOPIC(FATAL, Logger::CONFIG) << "Collection " << _currentCollection
+      } else if (collection.size()) {
+        LOG_TOPIC(FATAL, Logger::CONFIG) << "Collection " << collection
                                          << " not found.";
       }
 
@@ -601,8 +800,6 @@ std::shared_ptr<VPackBuilder> ExportFeature::httpCall(
 }
 
 void ExportFeature::graphExport(SimpleHttpClient* httpClient) {
-  std::string errorMsg;
-
   _currentGraph = _graphName;
 
   if (_collections.empty()) {
@@ -641,35 +838,19 @@ void ExportFeature::graphExport(SimpleHttpClient* httpClient) {
     }
   }
 
-  std::string fileName =
-      _outputDirectory + TRI_DIR_SEPARATOR_STR + _graphName + "." + _typeExport;
-
-  // remove an existing file first
-  if (TRI_ExistsFile(fileName.c_str())) {
-    TRI_UnlinkFile(fileName.c_str());
-  }
-
-  int fd =
-      TRI_TRACKED_CREATE_FILE(fileName.c_str(), O_CREAT | O_EXCL | O_RDWR | TRI_O_CLOEXEC,
-                 S_IRUSR | S_IWUSR);
-
-  if (fd < 0) {
-    errorMsg = "cannot write to file '" + fileName + "'";
-    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_WRITE_FILE, errorMsg);
-  }
-  TRI_DEFER(TRI_TRACKED_CLOSE_FILE(fd));
+  OutputFile file(filePath(_graphName), _compressOutput);
 
   std::string xmlHeader =
       R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
 <graph label=")";
-  writeToFile(fd, xmlHeader, fileName);
-  writeToFile(fd, _graphName, fileName);
+  file.write(xmlHeader);
+  file.write(_graphName);
 
   xmlHeader = R"(" 
 xmlns="http://www.cs.rpi.edu/XGMML" 
 directed="1">
 )";
-  writeToFile(fd, xmlHeader, fileName);
+  file.write(xmlHeader);
 
   for (auto const& collection : _collections) {
     if (_progress) {
@@ -690,31 +871,33 @@ directed="1">
     post.close();
     post.close();
 
-    std::shared_ptr<VPackBuilder> parsedBody =
-        httpCall(httpClient, url, rest::RequestType::POST, post.toJson());
+    std::shared_ptr<VPackBuilder> parsedBody = httpCall(
+        httpClient, url, rest::RequestType::POST, post.toJson(), collection);
     VPackSlice body = parsedBody->slice();
 
-    writeGraphBatch(fd, VPackArrayIterator(body.get("result")), fileName);
+    writeGraphBatch(file, VPackArrayIterator(body.get("result")));
 
     while (body.hasKey("id")) {
       std::string const url = "/_api/cursor/" + body.get("id").copyString();
-      parsedBody = httpCall(httpClient, url, rest::RequestType::PUT);
+      parsedBody =
+          httpCall(httpClient, url, rest::RequestType::PUT, "", collection);
       body = parsedBody->slice();
 
-      writeGraphBatch(fd, VPackArrayIterator(body.get("result")), fileName);
+      writeGraphBatch(file, VPackArrayIterator(body.get("result")));
     }
   }
   std::string closingGraphTag = "</graph>\n";
-  writeToFile(fd, closingGraphTag, fileName);
+  file.write(closingGraphTag);
+  file.close();
 
-  if (_skippedDeepNested) {
-    std::cout << "skipped " << _skippedDeepNested
+  if (_skippedDeepNested > 0) {
+    std::cout << "skipped " << _skippedDeepNested.load()
               << " deep nested objects / arrays" << std::endl;
   }
 }
 
-void ExportFeature::writeGraphBatch(int fd, VPackArrayIterator it,
-                                    std::string const& fileName) {
+void ExportFeature::writeGraphBatch(OutputFile& file, VPackArrayIterator it) {
+  std::string out;
   std::string xmlTag;
 
   for (auto const& doc : it) {
@@ -728,21 +911,21 @@ void ExportFeature::writeGraphBatch(int fd, VPackArrayIterator it,
           "\" source=\"" + encode_char_entities(doc.get("_from").copyString()) +
           "\" target=\"" + encode_char_entities(doc.get("_to").copyString()) +
           "\"";
-      writeToFile(fd, xmlTag, fileName);
+      out.append(xmlTag);
       if (!_xgmmlLabelOnly) {
         xmlTag = ">\n";
-        writeToFile(fd, xmlTag, fileName);
+        out.append(xmlTag);
 
         for (auto const& it : VPackObjectIterator(doc)) {
-          xgmmlWriteOneAtt(fd, fileName, it.value, it.key.copyString());
+          xgmmlWriteOneAtt(out, it.value, it.key.copyString());
         }
 
         xmlTag = "</edge>\n";
-        writeToFile(fd, xmlTag, fileName);
+        out.append(xmlTag);
 
       } else {
         xmlTag = " />\n";
-        writeToFile(fd, xmlTag, fileName);
+        out.append(xmlTag);
       }
 
     } else {
@@ -753,27 +936,29 @@ void ExportFeature::writeGraphBatch(int fd, VPackArrayIterator it,
                                    ? doc.get(_xgmmlLabelAttribute).copyString()
                                    : "Default-Label") +
           "\" id=\"" + encode_char_entities(doc.get("_id").copyString()) + "\"";
-      writeToFile(fd, xmlTag, fileName);
+      out.append(xmlTag);
       if (!_xgmmlLabelOnly) {
         xmlTag = ">\n";
-        writeToFile(fd, xmlTag, fileName);
+        out.append(xmlTag);
 
         for (auto const& it : VPackObjectIterator(doc)) {
-          xgmmlWriteOneAtt(fd, fileName, it.value, it.key.copyString());
+          xgmmlWriteOneAtt(out, it.value, it.key.copyString());
         }
 
         xmlTag = "</node>\n";
-        writeToFile(fd, xmlTag, fileName);
+        out.append(xmlTag);
 
       } else {
         xmlTag = " />\n";
-        writeToFile(fd, xmlTag, fileName);
+        out.append(xmlTag);
       }
     }
   }
+
+  file.write(out);
 }
 
-void ExportFeature::xgmmlWriteOneAtt(int fd, std::string const& fileName,
+void ExportFeature::xgmmlWriteOneAtt(std::string& out,
                                      VPackSlice const& slice,
                                      std::string const& name, int deep) {
   std::string value, type, xmlTag;
@@ -801,10 +986,9 @@ void ExportFeature::xgmmlWriteOneAtt(int fd, std::string const& fileName,
 
   } else if (slice.isArray() || slice.isObject()) {
     if (0 < deep) {
-      if (_skippedDeepNested == 0) {
+      if (_skippedDeepNested.fetch_add(1) == 0) {
         std::cout << "Warning: skip deep nested objects / arrays" << std::endl;
       }
-      _skippedDeepNested++;
       return;
     }
 
@@ -812,37 +996,37 @@ void ExportFeature::xgmmlWriteOneAtt(int fd, std::string const& fileName,
     xmlTag = "  <att name=\"" + encode_char_entities(name) +
              "\" type=\"string\" value=\"" +
              encode_char_entities(slice.toString()) + "\"/>\n";
-    writeToFile(fd, xmlTag, fileName);
+    out.append(xmlTag);
     return;
   }
 
   if (!type.empty()) {
     xmlTag = "  <att name=\"" + encode_char_entities(name) + "\" type=\"" +
              type + "\" value=\"" + encode_char_entities(value) + "\"/>\n";
-    writeToFile(fd, xmlTag, fileName);
+    out.append(xmlTag);
 
   } else if (slice.isArray()) {
     xmlTag =
         "  <att name=\"" + encode_char_entities(name) + "\" type=\"list\">\n";
-    writeToFile(fd, xmlTag, fileName);
+    out.append(xmlTag);
 
     for (VPackSlice val : VPackArrayIterator(slice)) {
-      xgmmlWriteOneAtt(fd, fileName, val, name, deep + 1);
+      xgmmlWriteOneAtt(out, val, name, deep + 1);
     }
 
     xmlTag = "  </att>\n";
-    writeToFile(fd, xmlTag, fileName);
+    out.append(xmlTag);
 
   } else if (slice.isObject()) {
     xmlTag =
         "  <att name=\"" + encode_char_entities(name) + "\" type=\"list\">\n";
-    writeToFile(fd, xmlTag, fileName);
+    out.append(xmlTag);
 
     for (auto const& it : VPackObjectIterator(slice)) {
-      xgmmlWriteOneAtt(fd, fileName, it.value, it.key.copyString(), deep + 1);
+      xgmmlWriteOneAtt(out, it.value, it.key.copyString(), deep + 1);
     }
 
     xmlTag = "  </att>\n";
-    writeToFile(fd, xmlTag, fileName);
+    out.append(xmlTag);
   }
 }
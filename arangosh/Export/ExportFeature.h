@@ -24,11 +24,17 @@
 #define ARANGODB_EXPORT_EXPORT_FEATURE_H 1
 
 #include "ApplicationFeatures/ApplicationFeature.h"
+#include "Basics/Mutex.h"
+#include "Utils/ClientManager.h"
+#include "Utils/ClientTaskQueue.h"
 #include "V8Client/ArangoClientHelper.h"
 #include "lib/Rest/CommonDefines.h"
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <atomic>
+#include <queue>
+
 namespace arangodb {
 namespace httpclient {
 class GeneralClientConnection;
@@ -49,17 +55,69 @@ class ExportFeature final : public application_features::ApplicationFeature,
   void prepare() override final;
   void start() override final;
 
+ public:
+  /// @brief an output file, shared by all jobs exporting into it. each
+  /// write appends a whole batch. with --compress-output, every batch is
+  /// compressed into a gzip member of its own before the file is locked, and
+  /// gzip readers decompress the concatenated members as one stream
+  class OutputFile {
+   public:
+    OutputFile(std::string const& path, bool compress);
+    ~OutputFile();
+
+    std::string const& path() const { return _path; }
+
+    void write(std::string const& data);
+
+    /// @brief writes items of a JSON array, which are separated from the
+    /// items of earlier writes by a comma
+    void writeItems(std::string const& items);
+
+    void close();
+
+    /// @brief number of jobs still writing into the file, the last one
+    /// writes the footer
+    std::atomic<size_t> pendingJobs;
+
+   private:
+    std::string prepare(std::string const& data) const;
+    void append(std::string const& data);
+
+   private:
+    std::string const _path;
+    bool const _compress;
+    Mutex _lock;
+    int _fd;
+    bool _hasItems;
+  };
+
+  /// @brief exports one partition of a collection, or the whole collection
+  /// through a streaming AQL cursor if there is no partition
+  struct JobData {
+    std::shared_ptr<OutputFile> file;
+    std::string collection;
+    std::string partition;
+  };
+
+  /// @brief saves a worker error for later handling and clears queued jobs
+  void reportError(Result const& error);
+
  private:
   void collectionExport(httpclient::SimpleHttpClient* httpClient);
+  std::vector<std::string> partitionCollection(httpclient::SimpleHttpClient* httpClient, std::string const& collection);
+  Result processJob(httpclient::SimpleHttpClient& client, JobData& jobData);
   void queryExport(httpclient::SimpleHttpClient* httpClient);
-  void writeFirstLine(int fd, std::string const& fileName, std::string const& collection);
-  void writeBatch(int fd, VPackArrayIterator it, std::string const& fileName);
+  void cursorExport(httpclient::SimpleHttpClient* httpClient, VPackBuilder const& post, OutputFile& file, std::string const& collection);
+  std::string filePath(std::string const& name) const;
+  std::shared_ptr<OutputFile> openFile(std::string const& name, std::string const& collection);
+  void finishFile(OutputFile& file);
+  std::string firstLine(std::string const& collection);
+  void writeBatch(OutputFile& file, VPackArrayIterator it);
   void graphExport(httpclient::SimpleHttpClient* httpClient);
-  void writeGraphBatch(int fd, VPackArrayIterator it, std::string const& fileName);
-  void xgmmlWriteOneAtt(int fd, std::string const& fileName, VPackSlice const& slice, std::string const& name, int deep = 0);
+  void writeGraphBatch(OutputFile& file, VPackArrayIterator it);
+  void xgmmlWriteOneAtt(std::string& out, VPackSlice const& slice, std::string const& name, int deep = 0);
 
-  void writeToFile(int fd, std::string const& string, std::string const& fileName);
-  std::shared_ptr<VPackBuilder> httpCall(httpclient::SimpleHttpClient* httpClient, std::string const& url, arangodb::rest::RequestType, std::string postBody = "");
+  std::shared_ptr<VPackBuilder> httpCall(httpclient::SimpleHttpClient* httpClient, std::string const& url, arangodb::rest::RequestType, std::string postBody = "", std::string const& collection = "");
 
  private:
   std::vector<std::string> _collections;
@@ -74,14 +132,19 @@ class ExportFeature final : public application_features::ApplicationFeature,
   std::string _outputDirectory;
   bool _overwrite;
   bool _progress;
+  bool _compressOutput;
+  uint32_t _threadCount;
 
-  bool _firstLine;
-  uint64_t _skippedDeepNested;
-  uint64_t _httpRequestsDone;
-  std::string _currentCollection;
+  std::atomic<uint64_t> _skippedDeepNested;
+  std::atomic<uint64_t> _httpRequestsDone;
   std::string _currentGraph;
 
   int* _result;
+
+  Mutex _workerErrorLock;
+  std::queue<Result> _workerErrors;
+  ClientManager _clientManager;
+  ClientTaskQueue<JobData> _clientTaskQueue;
 };
 }
 
@@ -62,6 +62,7 @@ ImportFeature::ImportFeature(application_features::ApplicationServer* server,
       _separator(""),
       _progress(true),
       _ignoreMissing(false),
+      _parallelParsing(true),
       _onDuplicateAction("error"),
       _rowsToSkip(0),
       _result(result),
@@ -168,6 +169,11 @@ void ImportFeature::collectOptions(
   options->addOption("--ignore-missing", "ignore missing columns in csv input",
                      new BooleanParameter(&_ignoreMissing));
 
+  options->addOption("--parallel-parsing",
+                     "convert json lines, csv and tsv input to VelocyPack "
+                     "in the sender threads",
+                     new BooleanParameter(&_parallelParsing));
+
   std::unordered_set<std::string> actions = {"error", "update", "replace",
                                              "ignore"};
   std::vector<std::string> actionsVector(actions.begin(), actions.end());
@@ -402,6 +408,7 @@ void ImportFeature::start() {
   ih.setOverwrite(_overwrite);
   ih.useBackslash(_useBackslash);
   ih.ignoreMissing(_ignoreMissing);
+  ih.setParallelParsing(_parallelParsing);
 
   std::unordered_map<std::string, std::string> translations;
   for (auto const& it : _translations) {
@@ -0,0 +1,527 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ImportFormat.h"
+#include "Basics/Exceptions.h"
+#include "Basics/StringUtils.h"
+#include "Basics/csv.h"
+#include "Logger/Logger.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::import;
+
+namespace {
+
+/// @brief the conversion state of the rows of one chunk
+struct RowContext {
+  RowContext(std::vector<std::string> const& a, std::vector<bool> const& r,
+             int64_t k, bool c, bool i, size_t f, VPackBuilder& d)
+      : attributes(a),
+        removed(r),
+        keyColumn(k),
+        convert(c),
+        ignoreMissing(i),
+        firstRow(f),
+        documents(d),
+        columns(0),
+        open(false),
+        errors(0) {}
+
+  std::vector<std::string> const& attributes;
+  std::vector<bool> const& removed;
+  int64_t const keyColumn;
+  bool const convert;
+  bool const ignoreMissing;
+  size_t const firstRow;
+  VPackBuilder& documents;
+
+  VPackBuilder row;
+  size_t columns;
+  bool open;
+  size_t errors;
+};
+
+/// @brief the fields of the header row
+struct HeaderContext {
+  explicit HeaderContext(size_t r) : headerRow(r) {}
+
+  size_t const headerRow;
+  std::vector<std::string> names;
+};
+
+/// @brief adds a field value the way the server parses the JSON which
+/// ImportHelper::addField produces from it. null values are left out, as
+/// the server leaves them out of the documents
+void addValue(RowContext& ctx, std::string const& attribute, char const* field,
+              size_t fieldLength, size_t column, bool escaped) {
+  VPackBuilder& row = ctx.row;
+
+  if (escaped || ctx.keyColumn == static_cast<int64_t>(column)) {
+    row.add(attribute,
+            VPackValuePair(field, fieldLength, VPackValueType::String));
+    return;
+  }
+
+  if (*field == '\0' || fieldLength == 0) {
+    return;
+  }
+
+  // check for literals null, false and true
+  if (fieldLength == 4 && memcmp(field, "null", 4) == 0) {
+    return;
+  } else if (fieldLength == 4 && memcmp(field, "true", 4) == 0) {
+    row.add(attribute, VPackValue(true));
+    return;
+  } else if (fieldLength == 5 && memcmp(field, "false", 5) == 0) {
+    row.add(attribute, VPackValue(false));
+    return;
+  }
+
+  if (ctx.convert) {
+    if (ImportFormat::isInteger(field, fieldLength)) {
+      // conversion might fail with out-of-range error
+      try {
+        if (fieldLength > 8) {
+          // this will fail if the number cannot be converted
+          (void)std::stoll(std::string(field, fieldLength));
+        }
+        row.add(attribute,
+                VPackValue(basics::StringUtils::int64(field, fieldLength)));
+        return;
+      } catch (...) {
+        // fall-through to adding the number as a string
+      }
+    } else if (ImportFormat::isDecimal(field, fieldLength)) {
+      try {
+        std::string tmp(field, fieldLength);
+        size_t pos = 0;
+        double num = std::stod(tmp, &pos);
+        if (pos == fieldLength &&
+            !(num != num || num == HUGE_VAL || num == -HUGE_VAL)) {
+          row.add(attribute, VPackValue(num));
+          return;
+        }
+        // NaN, +inf, -inf
+      } catch (...) {
+        // fall-through to adding the number as a string
+      }
+    }
+  }
+
+  row.add(attribute,
+          VPackValuePair(field, fieldLength, VPackValueType::String));
+}
+
+void beginRow(TRI_csv_parser_t* parser, size_t row) {
+  auto& ctx = *static_cast<RowContext*>(parser->_dataAdd);
+  if (ctx.open) {
+    // the parser skipped the end of the previous row
+    LOG_TOPIC(WARN, arangodb::Logger::FIXME)
+        << "at position " << (ctx.firstRow + row - 1) << ": corrupted row";
+    ++ctx.errors;
+  }
+  ctx.row.clear();
+  ctx.row.openObject();
+  ctx.columns = 0;
+  ctx.open = true;
+}
+
+void addField(TRI_csv_parser_t* parser, char const* field, size_t fieldLength,
+              size_t, size_t column, bool escaped) {
+  auto& ctx = *static_cast<RowContext*>(parser->_dataAdd);
+  if (column < ctx.attributes.size() && !ctx.removed[column]) {
+    addValue(ctx, ctx.attributes[column], field, fieldLength, column, escaped);
+  }
+  ctx.columns = column + 1;
+}
+
+void endRow(TRI_csv_parser_t* parser, char const* field, size_t fieldLength,
+            size_t row, size_t column, bool escaped) {
+  auto& ctx = *static_cast<RowContext*>(parser->_dataAdd);
+  ctx.open = false;
+  if (column == 0 && *field == '\0') {
+    // ignore empty line
+    return;
+  }
+
+  addField(parser, field, fieldLength, row, column, escaped);
+  ctx.row.close();
+
+  if (!ctx.ignoreMissing && ctx.columns != ctx.attributes.size()) {
+    LOG_TOPIC(WARN, arangodb::Logger::FIXME)
+        << "at position " << (ctx.firstRow + row)
+        << ": wrong number of values (got " << ctx.columns << ", expected "
+        << ctx.attributes.size() << ")";
+    ++ctx.errors;
+    return;
+  }
+  ctx.documents.add(ctx.row.slice());
+}
+
+void beginHeader(TRI_csv_parser_t*, size_t) {}
+
+void addHeader(TRI_csv_parser_t* parser, char const* field, size_t fieldLength,
+               size_t row, size_t, bool) {
+  auto& ctx = *static_cast<HeaderContext*>(parser->_dataAdd);
+  if (row == ctx.headerRow) {
+    ctx.names.emplace_back(field, fieldLength);
+  }
+}
+
+/// @brief sets up a parser as ImportHelper::importDelimited does
+void initParser(TRI_csv_parser_t& parser, char separator, char quote,
+                bool useQuote, bool useBackslash, void* data,
+                void (*begin)(TRI_csv_parser_t*, size_t),
+                void (*add)(TRI_csv_parser_t*, char const*, size_t, size_t,
+                            size_t, bool),
+                void (*end)(TRI_csv_parser_t*, char const*, size_t, size_t,
+                            size_t, bool)) {
+  TRI_InitCsvParser(&parser, begin, add, end, nullptr);
+  TRI_SetSeparatorCsvParser(&parser, separator);
+  TRI_UseBackslashCsvParser(&parser, useBackslash);
+  TRI_SetQuoteCsvParser(&parser, quote, useQuote);
+  parser._dataAdd = data;
+}
+
+}  // namespace
+
+ImportFormat::ImportFormat()
+    : _delimited(false),
+      _separator('\0'),
+      _quote('\0'),
+      _useQuote(false),
+      _useBackslash(false),
+      _convert(false),
+      _ignoreMissing(false),
+      _keyColumn(-1) {}
+
+ImportFormat::ImportFormat(char separator, char quote, bool useQuote,
+                           bool useBackslash, bool convert, bool ignoreMissing)
+    : _delimited(true),
+      _separator(separator),
+      _quote(quote),
+      _useQuote(useQuote),
+      _useBackslash(useBackslash),
+      _convert(convert),
+      _ignoreMissing(ignoreMissing),
+      _keyColumn(-1) {}
+
+bool ImportFormat::isInteger(char const* field, size_t fieldLength) {
+  char const* end = field + fieldLength;
+
+  if (*field == '+' || *field == '-') {
+    ++field;
+  }
+
+  while (field < end) {
+    if (*field < '0' || *field > '9') {
+      return false;
+    }
+    ++field;
+  }
+
+  return true;
+}
+
+bool ImportFormat::isDecimal(char const* field, size_t fieldLength) {
+  char const* ptr = field;
+  char const* end = ptr + fieldLength;
+
+  if (*ptr == '+' || *ptr == '-') {
+    ++ptr;
+  }
+
+  bool nextMustBeNumber = false;
+
+  while (ptr < end) {
+    if (*ptr == '.') {
+      if (nextMustBeNumber) {
+        return false;
+      }
+      // expect a number after the .
+      nextMustBeNumber = true;
+    } else if (*ptr == 'e' || *ptr == 'E') {
+      if (nextMustBeNumber) {
+        return false;
+      }
+      // expect a number after the exponent
+      nextMustBeNumber = true;
+
+      ++ptr;
+      if (ptr >= end) {
+        return false;
+      }
+      // skip over optional + or -
+      if (*ptr == '+' || *ptr == '-') {
+        ++ptr;
+      }
+      // do not advance ptr anymore
+      continue;
+    } else if (*ptr >= '0' && *ptr <= '9') {
+      // found a number
+      nextMustBeNumber = false;
+    } else {
+      // something else
+      return false;
+    }
+
+    ++ptr;
+  }
+
+  if (nextMustBeNumber) {
+    return false;
+  }
+
+  return true;
+}
+
+bool ImportFormat::readHeader(
+    char const* data, size_t length, size_t rowsToSkip,
+    std::unordered_map<std::string, std::string> const& translations,
+    std::unordered_set<std::string> const& removeAttributes) {
+  TRI_ASSERT(_delimited);
+
+  HeaderContext ctx(rowsToSkip);
+  TRI_csv_parser_t parser;
+  ::initParser(parser, _separator, _quote, _useQuote, _useBackslash, &ctx,
+               ::beginHeader, ::addHeader, ::addHeader);
+  TRI_ParseCsvString(&parser, data, length);
+  TRI_DestroyCsvParser(&parser);
+
+  if (ctx.names.size() == 1 && ctx.names[0].empty()) {
+    // an empty line
+    return false;
+  }
+
+  _attributes.clear();
+  _removed.clear();
+  _keyColumn = -1;
+  for (auto& name : ctx.names) {
+    auto it = translations.find(name);
+    std::string attribute =
+        (!name.empty() && it != translations.end()) ? it->second : name;
+    if (_keyColumn == -1 && attribute == "_key") {
+      _keyColumn = static_cast<int64_t>(_attributes.size());
+    }
+    _removed.push_back(removeAttributes.find(name) != removeAttributes.end());
+    _attributes.emplace_back(std::move(attribute));
+  }
+  return !_attributes.empty();
+}
+
+size_t ImportFormat::convert(char const* data, size_t length, size_t firstRow,
+                             VPackBuilder& documents) const {
+  TRI_ASSERT(documents.isOpenArray());
+  if (_delimited) {
+    return convertRows(data, length, firstRow, documents);
+  }
+  return convertLines(data, length, firstRow, documents);
+}
+
+size_t ImportFormat::convertLines(char const* data, size_t length,
+                                  size_t firstRow,
+                                  VPackBuilder& documents) const {
+  size_t errors = 0;
+  VPackBuilder line;
+  VPackParser parser(line);
+
+  char const* end = data + length;
+  size_t row = firstRow;
+  while (data < end) {
+    char const* next = static_cast<char const*>(memchr(data, '\n', end - data));
+    if (next == nullptr) {
+      next = end;
+    }
+
+    // trim line, as the server does
+    char const* lineStart = data;
+    char const* lineEnd = next;
+    while (lineStart < lineEnd &&
+           (*lineStart == ' ' || *lineStart == '\t' || *lineStart == '\r' ||
+            *lineStart == '\b' || *lineStart == '\f')) {
+      ++lineStart;
+    }
+    while (lineEnd > lineStart &&
+           (*(lineEnd - 1) == ' ' || *(lineEnd - 1) == '\t' ||
+            *(lineEnd - 1) == '\r' || *(lineEnd - 1) == '\b' ||
+            *(lineEnd - 1) == '\f')) {
+      --lineEnd;
+    }
+
+    if (lineStart < lineEnd) {
+      try {
+        parser.parse(lineStart, lineEnd - lineStart);
+        documents.add(line.slice());
+      } catch (std::exception const& ex) {
+        LOG_TOPIC(WARN, arangodb::Logger::FIXME)
+            << "at position " << row << ": invalid JSON: " << ex.what();
+        ++errors;
+      }
+    }
+
+    data = next + 1;
+    ++row;
+  }
+  return errors;
+}
+
+size_t ImportFormat::convertRows(char const* data, size_t length,
+                                 size_t firstRow,
+                                 VPackBuilder& documents) const {
+  RowContext ctx(_attributes, _removed, _keyColumn, _convert, _ignoreMissing,
+                 firstRow, documents);
+  TRI_csv_parser_t parser;
+  ::initParser(parser, _separator, _quote, _useQuote, _useBackslash, &ctx,
+               ::beginRow, ::addField, ::endRow);
+  int res = TRI_ParseCsvString(&parser, data, length);
+  TRI_DestroyCsvParser(&parser);
+  if (res == TRI_ERROR_OUT_OF_MEMORY) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+
+  if (ctx.open) {
+    // the chunk ends with complete rows, so the last one was corrupted
+    LOG_TOPIC(WARN, arangodb::Logger::FIXME)
+        << "at position " << (firstRow + parser._row) << ": corrupted row";
+    ++ctx.errors;
+  }
+  return ctx.errors;
+}
+
+ImportFormat::RowScanner::RowScanner(ImportFormat const& format)
+    : _format(format),
+      _state(State::FIELD_BEGIN),
+      _position(0),
+      _end(0),
+      _rows(0) {
+  TRI_ASSERT(_format._delimited);
+}
+
+size_t ImportFormat::RowScanner::scan(char const* data, size_t length,
+                                      size_t maxRows) {
+  char const separator = _format._separator;
+  char const quote = _format._quote;
+  bool const useQuote = _format._useQuote;
+  bool const useBackslash = _format._useBackslash;
+
+  auto rowEnd = [this](size_t end) {
+    _end = end;
+    ++_rows;
+    _state = State::FIELD_BEGIN;
+  };
+
+  // follows the states of TRI_ParseCsvString, a character that ends a
+  // state is processed again in the next one
+  while (_position < length && _rows < maxRows) {
+    char const c = data[_position];
+
+    switch (_state) {
+      case State::CARRIAGE_RETURN:
+        if (c == '\n') {
+          rowEnd(++_position);
+        } else {
+          rowEnd(_position);
+        }
+        continue;
+
+      case State::FIELD_BEGIN:
+        if (useQuote && c == quote) {
+          _state = State::QUOTED_FIELD;
+        } else if (c == '\n') {
+          rowEnd(_position + 1);
+        } else if (c == '\r') {
+          _state = State::CARRIAGE_RETURN;
+        } else if (c != separator) {
+          _state = State::FIELD;
+        }
+        break;
+
+      case State::FIELD:
+        if (c == separator) {
+          _state = State::FIELD_BEGIN;
+        } else if (c == '\n') {
+          rowEnd(_position + 1);
+        } else if (c == '\r') {
+          _state = State::CARRIAGE_RETURN;
+        }
+        break;
+
+      case State::QUOTED_FIELD:
+        if (useBackslash && c == '\\') {
+          _state = State::QUOTED_ESCAPE;
+        } else if (c == quote) {
+          _state = State::QUOTED_QUOTE;
+        }
+        break;
+
+      case State::QUOTED_ESCAPE:
+        if (c == quote || c == '\\') {
+          _state = State::QUOTED_FIELD;
+          break;
+        }
+        _state = State::AFTER_QUOTED_FIELD;
+        continue;
+
+      case State::QUOTED_QUOTE:
+        if (c == quote) {
+          // a doubled quote
+          _state = State::QUOTED_FIELD;
+          break;
+        }
+        _state = State::AFTER_QUOTED_FIELD;
+        continue;
+
+      case State::AFTER_QUOTED_FIELD:
+        if (c == separator) {
+          _state = State::FIELD_BEGIN;
+        } else if (c == '\n') {
+          rowEnd(_position + 1);
+        } else if (c == '\r') {
+          _state = State::CARRIAGE_RETURN;
+        } else if (c != ' ' && c != '\t') {
+          _state = State::CORRUPTED;
+        }
+        break;
+
+      case State::CORRUPTED:
+        if (c == separator) {
+          _state = State::FIELD_BEGIN;
+        } else if (c == '\n') {
+          rowEnd(_position + 1);
+        }
+        break;
+    }
+
+    ++_position;
+  }
+
+  return _end;
+}
+
+void ImportFormat::RowScanner::consume(size_t length) {
+  TRI_ASSERT(length <= _end);
+  _position -= length;
+  _end -= length;
+  _rows = 0;
+}
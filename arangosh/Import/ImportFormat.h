@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_IMPORT_IMPORT_FORMAT_H
+#define ARANGODB_IMPORT_IMPORT_FORMAT_H 1
+
+#include "Basics/Common.h"
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+}
+
+namespace import {
+
+/// @brief converts chunks of complete rows of an import file into
+/// VelocyPack documents, so that the sender threads can parse the input in
+/// parallel. a format is shared by all sender threads once the header row
+/// of a CSV or TSV file was read, and is not modified afterwards
+class ImportFormat {
+ public:
+  /// @brief JSON documents, one per line
+  ImportFormat();
+
+  /// @brief CSV or TSV rows, with the quoting rules of TRI_csv_parser_t
+  ImportFormat(char separator, char quote, bool useQuote, bool useBackslash,
+               bool convert, bool ignoreMissing);
+
+  bool isDelimited() const { return _delimited; }
+
+  /// @brief whether a field value is an integer, or maybe a decimal value.
+  /// these avoid regexes, which are too slow
+  static bool isInteger(char const* field, size_t fieldLength);
+  static bool isDecimal(char const* field, size_t fieldLength);
+
+  /// @brief reads the column names from the row after rowsToSkip rows in
+  /// data. returns false if there is no such row
+  bool readHeader(
+      char const* data, size_t length, size_t rowsToSkip,
+      std::unordered_map<std::string, std::string> const& translations,
+      std::unordered_set<std::string> const& removeAttributes);
+
+  /// @brief adds the documents of the complete rows in data to the open
+  /// array. firstRow is the number of the first row in the input, for the
+  /// warnings. returns the number of rows that could not be converted
+  size_t convert(char const* data, size_t length, size_t firstRow,
+                 velocypack::Builder& documents) const;
+
+ private:
+  size_t convertLines(char const* data, size_t length, size_t firstRow,
+                      velocypack::Builder& documents) const;
+  size_t convertRows(char const* data, size_t length, size_t firstRow,
+                     velocypack::Builder& documents) const;
+
+ public:
+  /// @brief the state of a scan or parse between two characters
+  enum class State {
+    FIELD_BEGIN,
+    FIELD,
+    QUOTED_FIELD,
+    QUOTED_ESCAPE,
+    QUOTED_QUOTE,
+    AFTER_QUOTED_FIELD,
+    CORRUPTED,
+    CARRIAGE_RETURN
+  };
+
+  /// @brief finds the ends of complete rows in the input. the scan continues
+  /// where the previous one stopped, after more data was appended
+  class RowScanner {
+   public:
+    explicit RowScanner(ImportFormat const& format);
+
+    /// @brief scans data up to length, or until there are maxRows complete
+    /// rows. returns the offset after the last complete row
+    size_t scan(char const* data, size_t length,
+                size_t maxRows = SIZE_MAX);
+
+    /// @brief number of complete rows before the returned offset
+    size_t rows() const { return _rows; }
+
+    /// @brief the caller removed length bytes, all of them complete rows,
+    /// from the front of the data
+    void consume(size_t length);
+
+   private:
+    ImportFormat const& _format;
+    State _state;
+    size_t _position;
+    size_t _end;
+    size_t _rows;
+  };
+
+ private:
+  bool const _delimited;
+  char const _separator;
+  char const _quote;
+  bool const _useQuote;
+  bool const _useBackslash;
+  bool const _convert;
+  bool const _ignoreMissing;
+
+  /// @brief attribute names of the columns, after their translation, and
+  /// whether the column is removed
+  std::vector<std::string> _attributes;
+  std::vector<bool> _removed;
+  int64_t _keyColumn;
+};
+}
+}
+#endif
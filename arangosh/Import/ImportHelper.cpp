@@ -30,6 +30,7 @@
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/files.h"
 #include "Basics/tri-strings.h"
+#include "Import/ImportFormat.h"
 #include "Import/SenderThread.h"
 #include "Logger/Logger.h"
 #include "Rest/GeneralResponse.h"
@@ -47,86 +48,6 @@ using namespace arangodb::basics;
 using namespace arangodb::httpclient;
 
 
-////////////////////////////////////////////////////////////////////////////////
-/// @brief helper function to determine if a field value is an integer
-/// this function is here to avoid usage of regexes, which are too slow
-////////////////////////////////////////////////////////////////////////////////
-
-static bool IsInteger(char const* field, size_t fieldLength) {
-  char const* end = field + fieldLength;
-
-  if (*field == '+' || *field == '-') {
-    ++field;
-  }
-
-  while (field < end) {
-    if (*field < '0' || *field > '9') {
-      return false;
-    }
-    ++field;
-  }
-
-  return true;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-/// @brief helper function to determine if a field value maybe is a decimal
-/// value. this function peeks into the first few bytes of the value only
-/// this function is here to avoid usage of regexes, which are too slow
-////////////////////////////////////////////////////////////////////////////////
-
-static bool IsDecimal(char const* field, size_t fieldLength) {
-  char const* ptr = field;
-  char const* end = ptr + fieldLength;
-
-  if (*ptr == '+' || *ptr == '-') {
-    ++ptr;
-  }
-
-  bool nextMustBeNumber = false;
-
-  while (ptr < end) {
-    if (*ptr == '.') {
-      if (nextMustBeNumber) {
-        return false;
-      }
-      // expect a number after the .
-      nextMustBeNumber = true;
-    } else if (*ptr == 'e' || *ptr == 'E') {
-      if (nextMustBeNumber) {
-        return false;
-      }
-      // expect a number after the exponent
-      nextMustBeNumber = true;
-
-      ++ptr;
-      if (ptr >= end) {
-        return false;
-      }
-      // skip over optional + or -
-      if (*ptr == '+' || *ptr == '-') {
-        ++ptr;
-      }
-      // do not advance ptr anymore
-      continue;
-    } else if (*ptr >= '0' && *ptr <= '9') {
-      // found a number
-      nextMustBeNumber = false;
-    } else {
-      // something else
-      return false;
-    }
-
-    ++ptr;
-  }
-
-  if (nextMustBeNumber) {
-    return false;
-  }
-
-  return true;
-}
-
 namespace arangodb {
 namespace import {
 
@@ -165,6 +86,7 @@ ImportHelper::ImportHelper(ClientFeature const* client,
       _createCollection(false),
       _overwrite(false),
       _progress(false),
+      _parallelParsing(false),
       _firstChunk(true),
       _ignoreMissing(false),
       _numberLines(0),
@@ -271,6 +193,24 @@ bool ImportHelper::importDelimited(std::string const& collectionName,
     return false;
   }
 
+  if (_parallelParsing) {
+    // in csv, we'll use the quote char if set
+    // in tsv, we do not use the quote char
+    bool const useQuote = (typeImport == ImportHelper::CSV && _quote.size() > 0);
+    auto format = std::make_shared<ImportFormat>(
+        separator[0], useQuote ? _quote[0] : '\0', useQuote, _useBackslash,
+        _convert, _ignoreMissing);
+    TRI_Free(separator);
+
+    bool ok = importDelimitedRows(fd, totalLength, format);
+    if (fd != STDIN_FILENO) {
+      TRI_TRACKED_CLOSE_FILE(fd);
+    }
+    waitForSenders();
+    _outputBuffer.clear();
+    return ok && !_hasError;
+  }
+
   TRI_csv_parser_t parser;
 
   TRI_InitCsvParser(&parser, ProcessCsvBegin,
@@ -336,6 +276,96 @@ bool ImportHelper::importDelimited(std::string const& collectionName,
   return !_hasError;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reads chunks of complete rows of a delimited file, which the sender
+/// threads convert in parallel. this thread only finds the ends of the rows
+/// and reads the header row
+////////////////////////////////////////////////////////////////////////////////
+
+bool ImportHelper::importDelimitedRows(
+    int fd, int64_t totalLength, std::shared_ptr<ImportFormat> const& format) {
+  ImportFormat::RowScanner scanner(*format);
+
+  // progress display control variables
+  int64_t totalRead = 0;
+  double nextProgress = ProgressStep;
+
+  bool haveHeader = false;
+  bool eof = false;
+  // the row of the input at the front of the buffer
+  size_t row = 0;
+
+  static int const BUFFER_SIZE = 32768;
+
+  _outputBuffer.clear();
+  _rowsRead = 0;
+  _numberLines = 0;
+
+  while (!_hasError && !eof) {
+    if (_outputBuffer.reserve(BUFFER_SIZE) == TRI_ERROR_OUT_OF_MEMORY) {
+      _errorMessages.push_back(TRI_errno_string(TRI_ERROR_OUT_OF_MEMORY));
+      return false;
+    }
+
+    ssize_t n = TRI_READ(fd, _outputBuffer.end(), BUFFER_SIZE - 1);
+
+    if (n < 0) {
+      _errorMessages.push_back(TRI_LAST_ERROR_STR);
+      return false;
+    } else if (n == 0) {
+      // end the last line of the input, if it did not end with a newline
+      eof = true;
+      if (_outputBuffer.length() > 0 && *(_outputBuffer.end() - 1) != '\n') {
+        _outputBuffer.appendChar('\n');
+      }
+    } else {
+      _outputBuffer.increaseLength(n);
+      totalRead += static_cast<int64_t>(n);
+      reportProgress(totalLength, totalRead, nextProgress);
+    }
+
+    if (!haveHeader) {
+      size_t end = scanner.scan(_outputBuffer.c_str(), _outputBuffer.length(),
+                                _rowsToSkip + 1);
+      if (scanner.rows() <= _rowsToSkip) {
+        // read more
+        continue;
+      }
+      if (!format->readHeader(_outputBuffer.c_str(), end, _rowsToSkip,
+                              _translations, _removeAttributes)) {
+        _errorMessages.push_back("no header row found in import file");
+        return false;
+      }
+      row = scanner.rows();
+      _outputBuffer.erase_front(end);
+      scanner.consume(end);
+      haveHeader = true;
+    }
+
+    // a row larger than the batch size is sent once it is complete
+    size_t end = scanner.scan(_outputBuffer.c_str(), _outputBuffer.length());
+    if (end > 0 && (eof || _outputBuffer.length() > _maxUploadSize)) {
+      sendRows(_outputBuffer.c_str(), end, row, format);
+      row += scanner.rows();
+      _outputBuffer.erase_front(end);
+      scanner.consume(end);
+    }
+  }
+
+  if (!_hasError && _outputBuffer.length() > 0) {
+    // the input ends within a quoted field
+    LOG_TOPIC(WARN, arangodb::Logger::FIXME)
+        << "at position " << row << ": corrupted row";
+    MUTEX_LOCKER(guard, _stats._mutex);
+    ++_stats._numberErrors;
+  }
+
+  _numberLines = row;
+  _rowsRead = row;
+  reportProgress(totalLength, totalRead, nextProgress);
+  return true;
+}
+
 bool ImportHelper::importJson(std::string const& collectionName,
                               std::string const& fileName,
                               bool assumeLinewise) {
@@ -383,6 +413,10 @@ bool ImportHelper::importJson(std::string const& collectionName,
   int64_t totalRead = 0;
   double nextProgress = ProgressStep;
 
+  // for parallel parsing, and the line of the first document not yet sent
+  std::shared_ptr<ImportFormat const> format;
+  size_t line = 1;
+
   static int const BUFFER_SIZE = 32768;
 
   while (!_hasError) {
@@ -428,6 +462,11 @@ bool ImportHelper::importJson(std::string const& collectionName,
       checkedFront = true;
     }
 
+    if (format == nullptr && !isObject && _parallelParsing) {
+      // documents on lines of their own can be parsed in parallel
+      format = std::make_shared<ImportFormat>();
+    }
+
     totalRead += static_cast<int64_t>(n);
     reportProgress(totalLength, totalRead, nextProgress);
 
@@ -448,14 +487,23 @@ bool ImportHelper::importJson(std::string const& collectionName,
 
       if (pos != nullptr) {
         size_t len = pos - first + 1;
-        sendJsonBuffer(first, len, isObject);
+        if (format != nullptr) {
+          sendRows(first, len, line, format);
+          line += std::count(first, first + len, '\n');
+        } else {
+          sendJsonBuffer(first, len, isObject);
+        }
         _outputBuffer.erase_front(len);
       }
     }
   }
 
   if (_outputBuffer.length() > 0) {
-    sendJsonBuffer(_outputBuffer.c_str(), _outputBuffer.length(), isObject);
+    if (format != nullptr) {
+      sendRows(_outputBuffer.c_str(), _outputBuffer.length(), line, format);
+    } else {
+      sendJsonBuffer(_outputBuffer.c_str(), _outputBuffer.length(), isObject);
+    }
   }
 
   if (fd != STDIN_FILENO) {
@@ -606,7 +654,7 @@ void ImportHelper::addField(char const* field, size_t fieldLength, size_t row,
   }
 
   if (_convert) {
-    if (IsInteger(field, fieldLength)) {
+    if (ImportFormat::isInteger(field, fieldLength)) {
       // integer value
       // conversion might fail with out-of-range error
       try {
@@ -625,7 +673,7 @@ void ImportHelper::addField(char const* field, size_t fieldLength, size_t row,
         // conversion failed
         _lineBuffer.appendJsonEncoded(field, fieldLength);
       }
-    } else if (IsDecimal(field, fieldLength)) {
+    } else if (ImportFormat::isDecimal(field, fieldLength)) {
       // double value
       // conversion might fail with out-of-range error
       try {
@@ -653,7 +701,8 @@ void ImportHelper::addField(char const* field, size_t fieldLength, size_t row,
       _lineBuffer.appendJsonEncoded(field, fieldLength);
     }
   } else {
-    if (IsInteger(field, fieldLength) || IsDecimal(field, fieldLength)) {
+    if (ImportFormat::isInteger(field, fieldLength) ||
+        ImportFormat::isDecimal(field, fieldLength)) {
       // numeric value. don't convert
       _lineBuffer.appendChar('"');
       _lineBuffer.appendText(field, fieldLength);
@@ -878,6 +927,37 @@ void ImportHelper::sendCsvBuffer() {
   _rowOffset = _rowsRead;
 }
 
+void ImportHelper::sendRows(char const* data, size_t length, size_t firstRow,
+                            std::shared_ptr<ImportFormat const> const& format) {
+  if (_hasError) {
+    return;
+  }
+
+  // the server takes a VelocyPack body for an array of documents
+  std::string url("/_api/import?" + getCollectionUrlPart() +
+                  "&details=true&onDuplicate=" +
+                  StringUtils::urlEncode(_onDuplicateAction));
+
+  if (!_fromCollectionPrefix.empty()) {
+    url += "&fromPrefix=" + StringUtils::urlEncode(_fromCollectionPrefix);
+  }
+  if (!_toCollectionPrefix.empty()) {
+    url += "&toPrefix=" + StringUtils::urlEncode(_toCollectionPrefix);
+  }
+  if (_firstChunk && _overwrite) {
+    truncateCollection();
+  }
+  _firstChunk = false;
+
+  SenderThread* t = findIdleSender();
+  if (t != nullptr) {
+    _tempBuffer.reset();
+    _tempBuffer.appendText(data, length);
+    t->sendRows(url, &_tempBuffer, format, firstRow);
+    addPeriodByteCount(length + url.length());
+  }
+}
+
 void ImportHelper::sendJsonBuffer(char const* str, size_t len, bool isObject) {
   if (_hasError) {
     return;
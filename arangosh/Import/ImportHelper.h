@@ -55,6 +55,7 @@ struct SimpleHttpClientParams;
 
 namespace arangodb {
 namespace import {
+class ImportFormat;
 class SenderThread;
 
 struct ImportStatistics {
@@ -200,6 +201,13 @@ class ImportHelper {
 
   void setProgress(bool value) { _progress = value; }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether the sender threads convert JSON lines, CSV and TSV rows
+  /// into VelocyPack, instead of sending them to the server to parse
+  //////////////////////////////////////////////////////////////////////////////
+
+  void setParallelParsing(bool value) { _parallelParsing = value; }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief get the number of lines read (meaningful for CSV only)
   //////////////////////////////////////////////////////////////////////////////
@@ -284,8 +292,13 @@ class ImportHelper {
   bool checkCreateCollection();
   bool truncateCollection();
 
+  bool importDelimitedRows(int fd, int64_t totalLength,
+                           std::shared_ptr<ImportFormat> const& format);
+
   void sendCsvBuffer();
   void sendJsonBuffer(char const* str, size_t len, bool isObject);
+  void sendRows(char const* data, size_t length, size_t firstRow,
+                std::shared_ptr<ImportFormat const> const& format);
   SenderThread* findIdleSender();
   void waitForSenders();
 
@@ -308,6 +321,7 @@ class ImportHelper {
   bool _createCollection;
   bool _overwrite;
   bool _progress;
+  bool _parallelParsing;
   bool _firstChunk;
   bool _ignoreMissing;
 
@@ -27,7 +27,9 @@
 #include "Basics/MutexLocker.h"
 #include "Basics/StringBuffer.h"
 #include "Basics/StringUtils.h"
+#include "Basics/StaticStrings.h"
 #include "Basics/VelocyPackHelper.h"
+#include "ImportFormat.h"
 #include "ImportHelper.h"
 #include "SimpleHttpClient/SimpleHttpClient.h"
 #include "SimpleHttpClient/SimpleHttpResult.h"
@@ -49,6 +51,7 @@ SenderThread::SenderThread(
       _client(std::move(client)),
       _wakeup(wakeup),
       _data(false),
+      _firstRow(0),
       _hasError(false),
       _idle(true),
       _ready(false),
@@ -71,6 +74,23 @@ void SenderThread::sendData(std::string const& url,
   TRI_ASSERT(_idle && !_hasError);
   _url = url;
   _data.swap(data);
+  _format.reset();
+
+  // wake up the thread that may be waiting in run()
+  CONDITION_LOCKER(guard, _condition);
+  _idle = false;
+  guard.broadcast();
+}
+
+void SenderThread::sendRows(std::string const& url,
+                            arangodb::basics::StringBuffer* data,
+                            std::shared_ptr<ImportFormat const> const& format,
+                            size_t firstRow) {
+  TRI_ASSERT(_idle && !_hasError);
+  _url = url;
+  _data.swap(data);
+  _format = format;
+  _firstRow = firstRow;
 
   // wake up the thread that may be waiting in run()
   CONDITION_LOCKER(guard, _condition);
@@ -114,7 +134,9 @@ void SenderThread::run() {
       if (_data.length() > 0) {
         TRI_ASSERT(!_idle && !_url.empty());
 
-        {
+        if (_format != nullptr) {
+          sendDocuments();
+        } else {
           QuickHistogramTimer timer(_stats->_histogram);
           std::unique_ptr<httpclient::SimpleHttpResult> result(
             _client->request(rest::RequestType::POST, _url, _data.c_str(),
@@ -125,6 +147,7 @@ void SenderThread::run() {
 
         _url.clear();
         _data.reset();
+        _format.reset();
       }
 
       CONDITION_LOCKER(guard, _condition);
@@ -142,6 +165,34 @@ void SenderThread::run() {
   TRI_ASSERT(_idle);
 }
 
+void SenderThread::sendDocuments() {
+  VPackBuilder documents;
+  documents.openArray();
+  size_t errors =
+      _format->convert(_data.c_str(), _data.length(), _firstRow, documents);
+  documents.close();
+
+  if (errors > 0) {
+    MUTEX_LOCKER(guard, _stats->_mutex);
+    _stats->_numberErrors += errors;
+  }
+
+  VPackSlice const slice = documents.slice();
+  if (slice.length() == 0) {
+    return;
+  }
+
+  static std::unordered_map<std::string, std::string> const headers{
+      {StaticStrings::ContentTypeHeader, StaticStrings::MimeTypeVPack}};
+
+  QuickHistogramTimer timer(_stats->_histogram);
+  std::unique_ptr<httpclient::SimpleHttpResult> result(_client->request(
+      rest::RequestType::POST, _url, slice.startAs<char>(),
+      static_cast<size_t>(slice.byteSize()), headers));
+
+  handleResult(result.get());
+}
+
 void SenderThread::handleResult(httpclient::SimpleHttpResult* result) {
   if (result == nullptr) {
     return;
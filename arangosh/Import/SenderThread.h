@@ -38,6 +38,7 @@ class SimpleHttpResult;
 }
 
 namespace import {
+class ImportFormat;
 struct ImportStatistics;
 
 class SenderThread final : public arangodb::Thread {
@@ -58,6 +59,13 @@ class SenderThread final : public arangodb::Thread {
 
   void sendData(std::string const& url, basics::StringBuffer* sender);
 
+  /// @brief converts the complete rows in data into documents in this
+  /// thread, and sends them as VelocyPack. firstRow is the number of the
+  /// first row in the input
+  void sendRows(std::string const& url, basics::StringBuffer* data,
+                std::shared_ptr<ImportFormat const> const& format,
+                size_t firstRow);
+
   bool hasError();
   /// Ready to start sending
   bool isReady();
@@ -78,6 +86,8 @@ class SenderThread final : public arangodb::Thread {
   std::function<void()> _wakeup;
   std::string _url;
   basics::StringBuffer _data;
+  std::shared_ptr<ImportFormat const> _format;
+  size_t _firstRow;
   bool _hasError;
   bool _idle;
   bool _ready;
@@ -85,6 +95,7 @@ class SenderThread final : public arangodb::Thread {
   ImportStatistics* _stats;
   std::string _errorMessage;
   void handleResult(httpclient::SimpleHttpResult* result);
+  void sendDocuments();
 };
 }
 }
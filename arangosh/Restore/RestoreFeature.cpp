@@ -28,6 +28,7 @@
 #include <boost/algorithm/clamp.hpp>
 
 #include "ApplicationFeatures/ApplicationServer.h"
+#include "Basics/ConditionLocker.h"
 #include "Basics/FileUtils.h"
 #include "Basics/Result.h"
 #include "Basics/StringUtils.h"
@@ -396,39 +397,71 @@ arangodb::Result restoreIndexes(
   return result;
 }
 
-/// @brief Restore the data for a given collection
-arangodb::Result restoreData(arangodb::httpclient::SimpleHttpClient& httpClient,
-                             arangodb::RestoreFeature::JobData& jobData) {
-  using arangodb::Logger;
-  using arangodb::basics::StringBuffer;
-
-  arangodb::Result result;
-  StringBuffer buffer(true);
-
-  VPackSlice const parameters = jobData.collection.get("parameters");
-  std::string const cname = arangodb::basics::VelocyPackHelper::getStringValue(
-      parameters, "name", "");
-  int type = arangodb::basics::VelocyPackHelper::getNumericValue<int>(
-      parameters, "type", 2);
-  std::string const collectionType(type == 2 ? "document" : "edge");
-
-  // import data. check if we have a datafile
-  auto datafile = jobData.directory.readableFile(
-      cname + "_" + arangodb::rest::SslInterface::sslMD5(cname) + ".data.json");
+/// @brief opens the data file of a collection, compressed or not
+std::unique_ptr<arangodb::ManagedDirectory::File> openDataFile(
+    arangodb::ManagedDirectory& directory, std::string const& filename) {
+  auto datafile = directory.readableFile(filename);
   if (!datafile || datafile->status().fail()) {
-    datafile = jobData.directory.readableFile(cname + ".data.json");
+    datafile = directory.readableFile(filename + ".gz");
     if (!datafile || datafile->status().fail()) {
-      result = {TRI_ERROR_CANNOT_READ_FILE, "could not open file"};
-      return result;
+      return {nullptr};
     }
   }
+  return datafile;
+}
 
-  if (jobData.options.progress) {
-    LOG_TOPIC(INFO, Logger::RESTORE) << "# Loading data into " << collectionType
-                                     << " collection '" << cname << "'...";
+/// @brief Hands a batch of documents to the batch workers, once less than
+/// the maximum number of batches of the collection are in flight
+arangodb::Result queueRestoreData(
+    arangodb::RestoreFeature::JobData& jobData, std::string const& cname,
+    std::shared_ptr<arangodb::RestoreFeature::BatchTracker> const& tracker,
+    char const* buffer, size_t bufferSize) {
+  {
+    CONDITION_LOCKER(guard, tracker->condition);
+    while (tracker->pending >= jobData.options.batchesInFlight &&
+           tracker->error.ok()) {
+      guard.wait();
+    }
+    if (tracker->error.fail()) {
+      return tracker->error;
+    }
+    ++tracker->pending;
   }
 
-  buffer.clear();
+  auto batchData = std::make_unique<arangodb::RestoreFeature::BatchData>(
+      jobData.options, cname, std::string(buffer, bufferSize), tracker);
+  if (!jobData.feature.queueBatch(std::move(batchData))) {
+    CONDITION_LOCKER(guard, tracker->condition);
+    --tracker->pending;
+    return {TRI_ERROR_OUT_OF_MEMORY, "could not queue batch"};
+  }
+  return {TRI_ERROR_NO_ERROR};
+}
+
+/// @brief Waits until no batch of the collection is in flight anymore,
+/// returns the first error of its batches
+arangodb::Result waitForBatches(
+    arangodb::RestoreFeature::BatchTracker& tracker) {
+  CONDITION_LOCKER(guard, tracker.condition);
+  while (tracker.pending > 0) {
+    guard.wait();
+  }
+  return tracker.error;
+}
+
+/// @brief Restore the data of one data file for a given collection. with
+/// more than one batch in flight, this thread only reads and splits the
+/// file, and the batch workers send the batches
+arangodb::Result restoreDataFile(
+    arangodb::httpclient::SimpleHttpClient& httpClient,
+    arangodb::RestoreFeature::JobData& jobData, std::string const& cname,
+    std::shared_ptr<arangodb::RestoreFeature::BatchTracker> const& tracker,
+    arangodb::ManagedDirectory::File& datafile) {
+  using arangodb::Logger;
+  using arangodb::basics::StringBuffer;
+
+  arangodb::Result result;
+  StringBuffer buffer(true);
 
   while (true) {
     if (buffer.reserve(16384) != TRI_ERROR_NO_ERROR) {
@@ -436,9 +469,9 @@ arangodb::Result restoreData(arangodb::httpclient::SimpleHttpClient& httpClient,
       return result;
     }
 
-    ssize_t numRead = datafile->read(buffer.end(), 16384);
-    if (datafile->status().fail()) {  // error while reading
-      result = datafile->status();
+    ssize_t numRead = datafile.read(buffer.end(), 16384);
+    if (datafile.status().fail()) {  // error while reading
+      result = datafile.status();
       return result;
     }
     // we read something
@@ -468,6 +501,19 @@ arangodb::Result restoreData(arangodb::httpclient::SimpleHttpClient& httpClient,
       }
 
       jobData.stats.totalBatches++;
+      if (jobData.options.batchesInFlight > 1) {
+        result =
+            ::queueRestoreData(jobData, cname, tracker, buffer.begin(), length);
+        if (result.fail()) {
+          return result;
+        }
+        buffer.erase_front(length);
+        if (numRead == 0) {  // EOF
+          break;
+        }
+        continue;
+      }
+
       result = ::sendRestoreData(httpClient, jobData.options, cname,
                                  buffer.begin(), length);
       if (result.fail()) {
@@ -490,6 +536,68 @@ arangodb::Result restoreData(arangodb::httpclient::SimpleHttpClient& httpClient,
   return result;
 }
 
+/// @brief Restore the data for a given collection
+arangodb::Result restoreData(arangodb::httpclient::SimpleHttpClient& httpClient,
+                             arangodb::RestoreFeature::JobData& jobData) {
+  using arangodb::Logger;
+
+  arangodb::Result result;
+
+  VPackSlice const parameters = jobData.collection.get("parameters");
+  std::string const cname = arangodb::basics::VelocyPackHelper::getStringValue(
+      parameters, "name", "");
+  int type = arangodb::basics::VelocyPackHelper::getNumericValue<int>(
+      parameters, "type", 2);
+  std::string const collectionType(type == 2 ? "document" : "edge");
+
+  // import data. check if we have a datafile, or the part files of a dump
+  // of the shards in parallel
+  std::string const prefix =
+      cname + "_" + arangodb::rest::SslInterface::sslMD5(cname);
+  std::vector<std::unique_ptr<arangodb::ManagedDirectory::File>> datafiles;
+  auto datafile = ::openDataFile(jobData.directory, prefix + ".data.json");
+  if (!datafile) {
+    datafile = ::openDataFile(jobData.directory, cname + ".data.json");
+  }
+  if (datafile) {
+    datafiles.emplace_back(std::move(datafile));
+  } else {
+    for (size_t part = 0;; ++part) {
+      datafile = ::openDataFile(jobData.directory, prefix + "." +
+                                                       std::to_string(part) +
+                                                       ".data.json");
+      if (!datafile) {
+        break;
+      }
+      datafiles.emplace_back(std::move(datafile));
+    }
+  }
+  if (datafiles.empty()) {
+    result = {TRI_ERROR_CANNOT_READ_FILE, "could not open file"};
+    return result;
+  }
+
+  if (jobData.options.progress) {
+    LOG_TOPIC(INFO, Logger::RESTORE) << "# Loading data into " << collectionType
+                                     << " collection '" << cname << "'...";
+  }
+
+  auto tracker = std::make_shared<arangodb::RestoreFeature::BatchTracker>();
+  for (auto& file : datafiles) {
+    result = ::restoreDataFile(httpClient, jobData, cname, tracker, *file);
+    if (result.fail()) {
+      break;
+    }
+  }
+
+  // the data must be complete before the indexes are created
+  arangodb::Result batchResult = ::waitForBatches(*tracker);
+  if (result.ok()) {
+    result = batchResult;
+  }
+  return result;
+}
+
 /// @brief Restore the data for a given view
 arangodb::Result restoreView(arangodb::httpclient::SimpleHttpClient& httpClient,
                              arangodb::RestoreFeature::Options const& options,
@@ -708,6 +816,35 @@ void handleJobResult(
   }
 }
 
+/// @brief send a single batch of documents from the queue
+arangodb::Result processBatch(
+    arangodb::httpclient::SimpleHttpClient& httpClient,
+    arangodb::RestoreFeature::BatchData& batchData) {
+  using arangodb::Logger;
+
+  arangodb::Result result =
+      ::sendRestoreData(httpClient, batchData.options, batchData.cname,
+                        batchData.data.data(), batchData.data.size());
+  if (result.fail() && batchData.options.force) {
+    LOG_TOPIC(ERR, Logger::RESTORE) << result.errorMessage();
+    result.reset();
+  }
+  return result;
+}
+
+/// @brief hand the result of a single batch to the job of its collection
+void handleBatchResult(
+    std::unique_ptr<arangodb::RestoreFeature::BatchData>&& batchData,
+    arangodb::Result const& result) {
+  auto& tracker = *batchData->tracker;
+  CONDITION_LOCKER(guard, tracker.condition);
+  if (result.fail() && tracker.error.ok()) {
+    tracker.error = result;
+  }
+  --tracker.pending;
+  guard.broadcast();
+}
+
 }  // namespace
 
 namespace arangodb {
@@ -717,11 +854,17 @@ RestoreFeature::JobData::JobData(ManagedDirectory& d, RestoreFeature& f,
                                  RestoreFeature::Stats& s, VPackSlice const& c)
     : directory{d}, feature{f}, options{o}, stats{s}, collection{c} {}
 
+RestoreFeature::BatchData::BatchData(
+    RestoreFeature::Options const& o, std::string const& n, std::string&& d,
+    std::shared_ptr<RestoreFeature::BatchTracker> const& t)
+    : options{o}, cname{n}, data{std::move(d)}, tracker{t} {}
+
 RestoreFeature::RestoreFeature(application_features::ApplicationServer* server,
                                int& exitCode)
     : ApplicationFeature(server, RestoreFeature::featureName()),
       _clientManager{Logger::RESTORE},
       _clientTaskQueue{::processJob, ::handleJobResult},
+      _batchQueue{::processBatch, ::handleBatchResult},
       _exitCode{exitCode} {
   requiresElevatedPrivileges(false);
   setOptional(false);
@@ -761,6 +904,16 @@ void RestoreFeature::collectOptions(
                      "maximum number of collections to process in parallel",
                      new UInt32Parameter(&_options.threadCount));
 
+  options->addOption("--batches-in-flight",
+                     "maximum number of data batches per collection to send "
+                     "in parallel (1 sends them one after the other)",
+                     new UInt32Parameter(&_options.batchesInFlight));
+
+  options->addOption("--create-indexes-after-data",
+                     "create the indexes of a collection after its data was "
+                     "loaded, which fills them in bulk",
+                     new BooleanParameter(&_options.indexesAfterData));
+
   options->addOption("--include-system-collections",
                      "include system collections",
                      new BooleanParameter(&_options.includeSystemCollections));
@@ -833,6 +986,13 @@ void RestoreFeature::validateOptions(
     LOG_TOPIC(WARN, Logger::RESTORE) << "capping --threads value to " << clamped;
     _options.threadCount = clamped;
   }
+
+  clamped = boost::algorithm::clamp(_options.batchesInFlight, 1, 64);
+  if (_options.batchesInFlight != clamped) {
+    LOG_TOPIC(WARN, Logger::RESTORE)
+        << "capping --batches-in-flight value to " << clamped;
+    _options.batchesInFlight = clamped;
+  }
 }
 
 void RestoreFeature::prepare() {
@@ -941,6 +1101,11 @@ void RestoreFeature::start() {
     _exitCode = EXIT_FAILURE;
     return;
   }
+  if (_options.indexesAfterData) {
+    // RocksDB fills indexes of existing documents in bulk, which is
+    // cheaper than maintaining them for every batch
+    _options.indexesFirst = false;
+  }
 
   if (_options.progress) {
     LOG_TOPIC(INFO, Logger::RESTORE)
@@ -950,6 +1115,10 @@ void RestoreFeature::start() {
 
   // set up threads and workers
   _clientTaskQueue.spawnWorkers(_clientManager, _options.threadCount);
+  if (_options.batchesInFlight > 1) {
+    _batchQueue.spawnWorkers(_clientManager,
+                             _options.threadCount * _options.batchesInFlight);
+  }
 
   // run the actual restore
   try {
@@ -997,6 +1166,10 @@ void RestoreFeature::reportError(Result const& error) {
   }
 }
 
+bool RestoreFeature::queueBatch(std::unique_ptr<BatchData>&& batchData) {
+  return _batchQueue.queueJob(std::move(batchData));
+}
+
 Result RestoreFeature::getFirstError() const {
   {
     MUTEX_LOCKER(lock, _workerErrorLock);
@@ -69,6 +69,16 @@ class RestoreFeature final : public application_features::ApplicationFeature {
    */
   Result getFirstError() const;
 
+  /// @brief forward declaration, see below
+  struct BatchData;
+
+  /**
+   * @brief Queues a batch of documents for the batch workers
+   * @param  batchData Batch to send
+   * @return           `true` if successfully queued
+   */
+  bool queueBatch(std::unique_ptr<BatchData>&& batchData);
+
  public:
   /// @brief Holds configuration data to pass between methods
   struct Options {
@@ -78,6 +88,7 @@ class RestoreFeature final : public application_features::ApplicationFeature {
     uint64_t defaultNumberOfShards{1};
     uint64_t defaultReplicationFactor{1};
     uint32_t threadCount{2};
+    uint32_t batchesInFlight{4};
     bool clusterMode{false};
     bool createDatabase{false};
     bool force{false};
@@ -86,6 +97,7 @@ class RestoreFeature final : public application_features::ApplicationFeature {
     bool importData{true};
     bool importStructure{true};
     bool includeSystemCollections{false};
+    bool indexesAfterData{true};
     bool indexesFirst{false};
     bool overwrite{true};
     bool progress{true};
@@ -111,9 +123,28 @@ class RestoreFeature final : public application_features::ApplicationFeature {
             VPackSlice const&);
   };
 
+  /// @brief Tracks the batches of a collection which are in flight
+  struct BatchTracker {
+    basics::ConditionVariable condition;
+    size_t pending{0};
+    Result error{};
+  };
+
+  /// @brief Stores a single batch of documents to send to a collection
+  struct BatchData {
+    Options const& options;
+    std::string const cname;
+    std::string const data;
+    std::shared_ptr<BatchTracker> const tracker;
+
+    BatchData(Options const&, std::string const&, std::string&&,
+              std::shared_ptr<BatchTracker> const&);
+  };
+
  private:
   ClientManager _clientManager;
   ClientTaskQueue<JobData> _clientTaskQueue;
+  ClientTaskQueue<BatchData> _batchQueue;
   std::unique_ptr<ManagedDirectory> _directory;
   int& _exitCode;
   Options _options;
@@ -29,11 +29,19 @@
 #include "Basics/files.h"
 #include "Logger/Logger.h"
 
+#include "zlib.h"
+
 namespace {
 
 /// @brief size of char buffer to use for file slurping
 constexpr size_t DefaultIOChunkSize = 8192;
 
+/// @brief size of the buffer for compressed data
+constexpr size_t CompressionChunkSize = 1024 * 64;
+
+/// @brief suffix of the names of compressed files
+constexpr auto CompressedSuffix = ".gz";
+
 /// @brief the filename for the encryption file
 constexpr auto EncryptionFilename = "ENCRYPTION";
 
@@ -136,6 +144,13 @@ inline std::unique_ptr<arangodb::EncryptionFeature::Context> getContext(
 }
 #endif
 
+/// @brief whether the file is to be compressed, by its name
+inline bool isCompressed(std::string const& path) {
+  size_t const n = strlen(::CompressedSuffix);
+  return path.size() > n &&
+         path.compare(path.size() - n, n, ::CompressedSuffix) == 0;
+}
+
 /// @brief Generates the initial status for the directory
 #ifdef USE_ENTERPRISE
 arangodb::Result initialStatus(int fd, std::string const& path, int flags,
@@ -414,15 +429,37 @@ ManagedDirectory::File::File(ManagedDirectory const& directory,
 #endif
 {
   TRI_ASSERT(::flagNotSet(_flags, O_RDWR));  // disallow read/write (encryption)
+  _gzEnd = false;
+
+  if (_status.ok() && ::isCompressed(_path)) {
+    _gzStream = std::make_unique<z_stream>();
+    _gzBuffer.reset(new char[::CompressionChunkSize]);
+    memset(_gzStream.get(), 0, sizeof(z_stream));
+    int res;
+    if (::flagIsSet(_flags, O_WRONLY)) {
+      // 16 selects the gzip format
+      res = deflateInit2(_gzStream.get(), Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                         15 + 16, 8, Z_DEFAULT_STRATEGY);
+    } else {
+      // 32 detects gzip and zlib formats
+      res = inflateInit2(_gzStream.get(), 15 + 32);
+    }
+    if (res != Z_OK) {
+      _gzStream.reset();
+      _status = ::genericError(_path, _flags);
+    }
+  }
 }
 
 ManagedDirectory::File::~File() {
   try {
     if (_fd >= 0) {
+      finishCompression();
       ::closeFile(_fd, _status);
     }
   } catch (...) {
   }
+  finishCompression();
 }
 
 Result const& ManagedDirectory::File::status() const { return _status; }
@@ -434,6 +471,14 @@ void ManagedDirectory::File::write(char const* data, size_t length) {
     return;
   }
 
+  if (_gzStream) {
+    compress(data, length, Z_NO_FLUSH);
+  } else {
+    writeRaw(data, length);
+  }
+}
+
+void ManagedDirectory::File::writeRaw(char const* data, size_t length) {
 #ifdef USE_ENTERPRISE
   if (_context && _directory.isEncrypted()) {
     bool written =
@@ -450,11 +495,18 @@ void ManagedDirectory::File::write(char const* data, size_t length) {
 }
 
 ssize_t ManagedDirectory::File::read(char* buffer, size_t length) {
-  ssize_t bytesRead = -1;
   if (!::isReadable(_fd, _flags, _path, _status)) {
-    return bytesRead;
+    return -1;
+  }
+
+  if (_gzStream) {
+    return decompress(buffer, length);
   }
+  return readRaw(buffer, length);
+}
 
+ssize_t ManagedDirectory::File::readRaw(char* buffer, size_t length) {
+  ssize_t bytesRead = -1;
 #ifdef USE_ENTERPRISE
   if (_context && _directory.isEncrypted()) {
     bytesRead =
@@ -471,6 +523,92 @@ ssize_t ManagedDirectory::File::read(char* buffer, size_t length) {
   return bytesRead;
 }
 
+void ManagedDirectory::File::compress(char const* data, size_t length,
+                                      int flush) {
+  TRI_ASSERT(_gzStream != nullptr);
+  do {
+    // zlib counts in 32 bits
+    size_t const n = (std::min)(length, static_cast<size_t>(1) << 30);
+    _gzStream->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    _gzStream->avail_in = static_cast<uInt>(n);
+    int const f = (n == length) ? flush : Z_NO_FLUSH;
+    do {
+      _gzStream->next_out = reinterpret_cast<Bytef*>(_gzBuffer.get());
+      _gzStream->avail_out = static_cast<uInt>(::CompressionChunkSize);
+      if (deflate(_gzStream.get(), f) == Z_STREAM_ERROR) {
+        _status = ::genericError(_path, _flags);
+        return;
+      }
+      size_t const have = ::CompressionChunkSize - _gzStream->avail_out;
+      if (have > 0) {
+        writeRaw(_gzBuffer.get(), have);
+        if (_status.fail()) {
+          return;
+        }
+      }
+    } while (_gzStream->avail_out == 0);
+    data += n;
+    length -= n;
+  } while (length > 0);
+}
+
+ssize_t ManagedDirectory::File::decompress(char* buffer, size_t length) {
+  TRI_ASSERT(_gzStream != nullptr);
+  if (_gzEnd || length == 0) {
+    return 0;
+  }
+
+  length = (std::min)(length, static_cast<size_t>(1) << 30);
+  _gzStream->next_out = reinterpret_cast<Bytef*>(buffer);
+  _gzStream->avail_out = static_cast<uInt>(length);
+
+  // return as soon as there is some output, like a read does
+  while (_gzStream->avail_out == length) {
+    if (_gzStream->avail_in == 0) {
+      ssize_t const n = readRaw(_gzBuffer.get(), ::CompressionChunkSize);
+      if (n < 0) {
+        return -1;
+      }
+      if (n == 0) {
+        // the file ends within the compressed stream
+        _status.reset(TRI_ERROR_CANNOT_READ_FILE,
+                      "unexpected end of compressed file " + _path);
+        return -1;
+      }
+      _gzStream->next_in = reinterpret_cast<Bytef*>(_gzBuffer.get());
+      _gzStream->avail_in = static_cast<uInt>(n);
+    }
+
+    int const res = inflate(_gzStream.get(), Z_NO_FLUSH);
+    if (res == Z_STREAM_END) {
+      _gzEnd = true;
+      break;
+    }
+    if (res != Z_OK && res != Z_BUF_ERROR) {
+      _status.reset(TRI_ERROR_CANNOT_READ_FILE,
+                    "invalid compressed data in file " + _path);
+      return -1;
+    }
+  }
+
+  return static_cast<ssize_t>(length - _gzStream->avail_out);
+}
+
+void ManagedDirectory::File::finishCompression() {
+  if (!_gzStream) {
+    return;
+  }
+  if (::flagIsSet(_flags, O_WRONLY)) {
+    if (_fd >= 0 && _status.ok()) {
+      compress(nullptr, 0, Z_FINISH);
+    }
+    deflateEnd(_gzStream.get());
+  } else {
+    inflateEnd(_gzStream.get());
+  }
+  _gzStream.reset();
+}
+
 std::string ManagedDirectory::File::slurp() {
   std::string content;
   if (!::isReadable(_fd, _flags, _path, _status)) {
@@ -514,7 +652,13 @@ void ManagedDirectory::File::spit(std::string const& content) {
 
 Result const& ManagedDirectory::File::close() {
   if (_fd >= 0) {
+    finishCompression();
+    Result status = _status;
     ::closeFile(_fd, _status);
+    if (status.fail()) {
+      // keep an error of the compression
+      _status = status;
+    }
   }
   return _status;
 }
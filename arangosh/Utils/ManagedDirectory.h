@@ -30,6 +30,8 @@
 
 #include "Basics/Result.h"
 
+struct z_stream_s;
+
 #ifdef USE_ENTERPRISE
 #include "Enterprise/Encryption/EncryptionFeature.h"
 #endif
@@ -42,6 +44,10 @@ namespace arangodb {
  *
  * If encryption is enabled on the server, new files will be encrypted, and
  * existing files will be decrypted if applicable.
+ *
+ * Files whose names end in `.gz` are gzip-compressed when written and
+ * decompressed when read, before encryption and after decryption
+ * respectively.
  */
 class ManagedDirectory {
  public:
@@ -115,6 +121,13 @@ class ManagedDirectory {
      */
     Result const& close();
 
+   private:
+    void writeRaw(char const* data, size_t length);
+    ssize_t readRaw(char* buffer, size_t length);
+    void compress(char const* data, size_t length, int flush);
+    ssize_t decompress(char* buffer, size_t length);
+    void finishCompression();
+
    private:
     ManagedDirectory const& _directory;
     std::string _path;
@@ -124,6 +137,10 @@ class ManagedDirectory {
     std::unique_ptr<EncryptionFeature::Context> _context;
 #endif
     Result _status;
+    // only for .gz files
+    std::unique_ptr<z_stream_s> _gzStream;
+    std::unique_ptr<char[]> _gzBuffer;
+    bool _gzEnd;
   };
 
  public:
@@ -22,6 +22,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "RocksDBOptionFeature.h"
+#include "Basics/StringUtils.h"
 #include "Basics/process-utils.h"
 #include "Logger/Logger.h"
 #include "ProgramOptions/ProgramOptions.h"
@@ -77,7 +78,8 @@ RocksDBOptionFeature::RocksDBOptionFeature(
       _useFSync(rocksDBDefaults.use_fsync),
       _skipCorrupted(false),
       _dynamicLevelBytes(true),
-      _enableStatistics(false) {
+      _enableStatistics(false),
+      _partitionFilters(false) {
   // setting the number of background jobs to
   _maxBackgroundJobs = static_cast<int32_t>(std::max((size_t)2,
                                                      std::min(TRI_numberProcessors(), (size_t)8)));
@@ -177,6 +179,15 @@ void RocksDBOptionFeature::collectOptions(
                      "whether or not RocksDB statistics should be turned on",
                      new BooleanParameter(&_enableStatistics));
 
+  options->addOption(
+      "--rocksdb.partition-filters",
+      "if true, split the bloom filters and indexes of SST files into "
+      "partitions with a two-level index, so that only the top level has to "
+      "stay in memory and only the partitions needed by a lookup are loaded "
+      "into the block cache. useful for large data sets whose filters do not "
+      "fit into memory. requires a block cache",
+      new BooleanParameter(&_partitionFilters));
+
   options->addHiddenOption(
       "--rocksdb.optimize-filters-for-hits",
       "this flag specifies that the implementation should optimize the filters "
@@ -260,6 +271,16 @@ void RocksDBOptionFeature::collectOptions(
   options->addHiddenOption("--rocksdb.wal-recovery-skip-corrupted",
                            "skip corrupted records in WAL recovery",
                            new BooleanParameter(&_skipCorrupted));
+
+  options->addOption(
+      "--rocksdb.column-family-options",
+      "settings for a single column family, in the format "
+      "<family>:<option>=<value>. families are definitions, documents, "
+      "primary, edge, vpack, geo and fulltext. options are write-buffer-size "
+      "(bytes), compaction-style (level or universal), bloom-filter "
+      "(true or false) and whole-key-filtering (true or false, false only "
+      "adds key prefixes to the bloom filter). can be specified multiple times",
+      new VectorParameter<StringParameter>(&_columnFamilyOptions));
 }
 
 void RocksDBOptionFeature::validateOptions(
@@ -306,6 +327,46 @@ void RocksDBOptionFeature::validateOptions(
         << "invalid value for '--rocksdb.block-cache-shard-bits'";
     FATAL_ERROR_EXIT();
   }
+
+  static std::unordered_set<std::string> const families{
+      "definitions", "documents", "primary", "edge", "vpack", "geo", "fulltext"};
+
+  for (auto const& it : _columnFamilyOptions) {
+    size_t const colon = it.find(':');
+    size_t const equals = it.find('=', colon == std::string::npos ? 0 : colon);
+    if (colon == std::string::npos || equals == std::string::npos ||
+        families.find(it.substr(0, colon)) == families.end()) {
+      LOG_TOPIC(FATAL, arangodb::Logger::FIXME)
+          << "invalid value '" << it << "' for '--rocksdb.column-family-options'";
+      FATAL_ERROR_EXIT();
+    }
+    ColumnFamilySettings& settings = _columnFamilySettings[it.substr(0, colon)];
+    std::string const option = it.substr(colon + 1, equals - colon - 1);
+    std::string const value = it.substr(equals + 1);
+
+    if (option == "write-buffer-size") {
+      settings.writeBufferSize = basics::StringUtils::uint64(value);
+      if (settings.writeBufferSize < 1024 * 1024) {
+        LOG_TOPIC(FATAL, arangodb::Logger::FIXME)
+            << "invalid write buffer size in '" << it
+            << "' for '--rocksdb.column-family-options'";
+        FATAL_ERROR_EXIT();
+      }
+    } else if (option == "compaction-style" &&
+               (value == "level" || value == "universal")) {
+      settings.universalCompaction = (value == "universal");
+    } else if (option == "bloom-filter" &&
+               (value == "true" || value == "false")) {
+      settings.bloomFilter = (value == "true") ? 1 : 0;
+    } else if (option == "whole-key-filtering" &&
+               (value == "true" || value == "false")) {
+      settings.wholeKeyFiltering = (value == "true") ? 1 : 0;
+    } else {
+      LOG_TOPIC(FATAL, arangodb::Logger::FIXME)
+          << "invalid value '" << it << "' for '--rocksdb.column-family-options'";
+      FATAL_ERROR_EXIT();
+    }
+  }
 }
 
 void RocksDBOptionFeature::start() {
@@ -343,6 +404,7 @@ void RocksDBOptionFeature::start() {
                                     << ", level0_slowdown_trigger: " << _level0SlowdownTrigger
                                     << ", enable_pipelined_write: " << _enablePipelinedWrite
                                     << ", optimize_filters_for_hits: " << _optimizeFiltersForHits
+                                    << ", partition_filters: " << std::boolalpha << _partitionFilters << std::noboolalpha
                                     << ", use_direct_reads: " << _useDirectReads
                                     << ", use_direct_io_for_flush_and_compaction: " << _useDirectIoForFlushAndCompaction
                                     << ", use_fsync: " << _useFSync
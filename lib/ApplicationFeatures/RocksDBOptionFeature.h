@@ -47,6 +47,26 @@ class RocksDBOptionFeature final
   void validateOptions(std::shared_ptr<options::ProgramOptions>) override final;
   void start() override final;
 
+  /// @brief settings that deviate from the global ones for a single column
+  /// family
+  struct ColumnFamilySettings {
+    ColumnFamilySettings()
+        : writeBufferSize(0),
+          universalCompaction(false),
+          bloomFilter(-1),
+          wholeKeyFiltering(-1) {}
+
+    /// @brief write buffer size, 0 = global setting
+    uint64_t writeBufferSize;
+    /// @brief use universal instead of level compaction
+    bool universalCompaction;
+    /// @brief 1 = use a bloom filter, 0 = do not, -1 = default of the family
+    int bloomFilter;
+    /// @brief 1 = add whole keys to the bloom filter, 0 = only add prefixes,
+    /// -1 = default of the family
+    int wholeKeyFiltering;
+  };
+
   int64_t _transactionLockTimeout;
   std::string _walDirectory;
   uint64_t _writeBufferSize;
@@ -78,6 +98,12 @@ class RocksDBOptionFeature final
   bool _skipCorrupted;
   bool _dynamicLevelBytes;
   bool _enableStatistics;
+  bool _partitionFilters;
+
+  /// @brief values of --rocksdb.column-family-options
+  std::vector<std::string> _columnFamilyOptions;
+  /// @brief the parsed column family options, by column family name
+  std::unordered_map<std::string, ColumnFamilySettings> _columnFamilySettings;
 };
 
 }  // namespace arangodb
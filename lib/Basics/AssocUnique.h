@@ -63,8 +63,31 @@ class AssocUnique {
   typedef arangodb::basics::IndexBucket<Element, uint64_t, SIZE_MAX> Bucket;
 
  private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief state of an incremental resize of a bucket. when a bucket grows,
+  /// its table becomes the old table, and every insert moves a bounded
+  /// number of its slots into the new, bigger table. lookups check both
+  /// tables until the old one is empty. the old table is never rehashed
+  /// while it drains: slots before the cursor were moved, and elements
+  /// removed from the old table are only marked, so its probe sequences
+  /// stay intact
+  //////////////////////////////////////////////////////////////////////////////
+
+  struct Migration {
+    Migration() : cursor(0) {}
+
+    /// @brief the old table. _nrUsed is the number of elements not yet
+    /// moved and not removed
+    Bucket old;
+    /// @brief slots of the old table before the cursor were moved
+    uint64_t cursor;
+    /// @brief slots of the old table whose elements were removed
+    std::vector<bool> removed;
+  };
+
   AssocUniqueHelper _helper;
   std::vector<Bucket> _buckets;
+  std::vector<Migration> _migrations;
   size_t _bucketsMask;
 
   std::function<std::string()> _contextCallback;
@@ -89,6 +112,7 @@ class AssocUnique {
     _bucketsMask = nr - 1;
 
     _buckets.resize(numberBuckets);
+    _migrations.resize(numberBuckets);
 
     try {
       for (size_t j = 0; j < numberBuckets; j++) {
@@ -96,11 +120,15 @@ class AssocUnique {
       }
     } catch (...) {
       _buckets.clear();
+      _migrations.clear();
       throw;
     }
   }
 
-  ~AssocUnique() { _buckets.clear(); }
+  ~AssocUnique() { 
+    _migrations.clear();
+    _buckets.clear(); 
+  }
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief adhere to the rule of five
@@ -121,6 +149,185 @@ class AssocUnique {
  private:
   static uint64_t initialSize() { return 251; }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of slots of the old table an insert moves into the new
+  /// table of a bucket that is resized incrementally
+  //////////////////////////////////////////////////////////////////////////////
+
+  static uint64_t migrationStep() { return 512; }
+
+  size_t bucketIndex(Bucket const& b) const {
+    return static_cast<size_t>(&b - _buckets.data());
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of elements in a bucket, including those in its old table
+  //////////////////////////////////////////////////////////////////////////////
+
+  uint64_t usedInBucket(size_t bucketId) const {
+    return _buckets[bucketId]._nrUsed + _migrations[bucketId].old._nrUsed;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of slots of a bucket for the iteration. the slots of
+  /// the old table follow those of the new table
+  //////////////////////////////////////////////////////////////////////////////
+
+  uint64_t slotsInBucket(size_t bucketId) const {
+    return _buckets[bucketId]._nrAlloc + _migrations[bucketId].old._nrAlloc;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the element in a slot of a bucket for the iteration, moved and
+  /// removed elements of the old table are skipped
+  //////////////////////////////////////////////////////////////////////////////
+
+  Element slotInBucket(size_t bucketId, uint64_t position) const {
+    Bucket const& b = _buckets[bucketId];
+    if (position < b._nrAlloc) {
+      return b._table[position];
+    }
+    Migration const& m = _migrations[bucketId];
+    position -= b._nrAlloc;
+    TRI_ASSERT(position < m.old._nrAlloc);
+    if (position < m.cursor || m.removed[position]) {
+      return Element();
+    }
+    return m.old._table[position];
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief finds an element in the old table of a bucket, returns nullptr
+  /// if there is no old table or the element was moved or removed
+  //////////////////////////////////////////////////////////////////////////////
+
+  template <typename IsEqual>
+  Element* findInOld(size_t bucketId, uint64_t hash,
+                     IsEqual const& isEqual) const {
+    Migration const& m = _migrations[bucketId];
+    Bucket const& old = m.old;
+
+    if (old._nrUsed == 0) {
+      return nullptr;
+    }
+
+    uint64_t const n = old._nrAlloc;
+    uint64_t i = hash % n;
+    uint64_t k = i;
+
+    for (; i < n && old._table[i] && !isEqual(old._table[i]); ++i)
+      ;
+    if (i == n) {
+      for (i = 0; i < k && old._table[i] && !isEqual(old._table[i]); ++i)
+        ;
+    }
+
+    if (!old._table[i] || i < m.cursor || m.removed[i]) {
+      return nullptr;
+    }
+    return &old._table[i];
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief removes an element found in the old table of a bucket
+  //////////////////////////////////////////////////////////////////////////////
+
+  void removeFromOld(size_t bucketId, Element const* slot) {
+    Migration& m = _migrations[bucketId];
+    uint64_t const i = static_cast<uint64_t>(slot - m.old._table);
+    TRI_ASSERT(i >= m.cursor && i < m.old._nrAlloc && !m.removed[i]);
+
+    m.removed[i] = true;
+    if (--m.old._nrUsed == 0) {
+      clearMigration(m);
+    }
+  }
+
+  void clearMigration(Migration& m) {
+    m.old.deallocate();
+    m.cursor = 0;
+    std::vector<bool>().swap(m.removed);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief puts an element that is known to be absent into a table which
+  /// has enough space
+  //////////////////////////////////////////////////////////////////////////////
+
+  void moveElement(UserData* userData, Bucket& b, Element const& element) {
+    uint64_t const n = b._nrAlloc;
+    TRI_ASSERT(n > 0);
+
+    uint64_t i, k;
+    i = k = _helper.HashElement(userData, element, true) % n;
+
+    for (; i < n && b._table[i]; ++i)
+      ;
+    if (i == n) {
+      for (i = 0; i < k && b._table[i]; ++i)
+        ;
+    }
+
+    b._table[i] = element;
+    ++b._nrUsed;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief moves up to count slots of the old table into the new table
+  //////////////////////////////////////////////////////////////////////////////
+
+  void migrate(UserData* userData, Bucket& b, uint64_t count) {
+    Migration& m = _migrations[bucketIndex(b)];
+
+    if (m.old._table == nullptr) {
+      return;
+    }
+
+    uint64_t const end = m.cursor + (std::min)(count, m.old._nrAlloc - m.cursor);
+
+    for (; m.cursor < end; ++m.cursor) {
+      Element const& element = m.old._table[m.cursor];
+
+      if (element && !m.removed[m.cursor]) {
+        moveElement(userData, b, element);
+        --m.old._nrUsed;
+      }
+    }
+
+    if (m.cursor == m.old._nrAlloc || m.old._nrUsed == 0) {
+      clearMigration(m);
+    }
+  }
+
+  void finishMigration(UserData* userData, Bucket& b) {
+    migrate(userData, b, UINT64_MAX);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief starts an incremental resize of a bucket
+  //////////////////////////////////////////////////////////////////////////////
+
+  void startMigration(UserData* userData, Bucket& b, uint64_t targetSize) {
+    // a bucket only has one old table at a time
+    finishMigration(userData, b);
+
+    TRI_ASSERT(targetSize > 0);
+    targetSize = TRI_NearPrime(targetSize);
+
+    Bucket fresh;
+    fresh.allocate(targetSize);
+
+    Migration& m = _migrations[bucketIndex(b)];
+    m.removed.assign(static_cast<size_t>(b._nrAlloc), false);
+    m.old = std::move(b);
+    m.cursor = 0;
+    b = std::move(fresh);
+
+    if (m.old._nrUsed == 0) {
+      clearMigration(m);
+    }
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief resizes the array
   //////////////////////////////////////////////////////////////////////////////
@@ -136,6 +343,9 @@ class AssocUnique {
       return;
     }
 
+    // the old table of an incremental resize has to be empty first
+    finishMigration(userData, b);
+
     std::string const cb(_contextCallback());
 
     TRI_ASSERT(targetSize > 0);
@@ -178,13 +388,21 @@ class AssocUnique {
   }
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief check a resize of the hash array
+  /// @brief check a resize of the hash array. a bucket that grows for
+  /// single inserts is resized incrementally, one that has to take many
+  /// expected elements at once is rehashed right away
   //////////////////////////////////////////////////////////////////////////////
 
   bool checkResize(UserData* userData, Bucket& b, uint64_t expected) {
-    if (2 * b._nrAlloc < 3 * (b._nrUsed + expected)) {
+    uint64_t const used = usedInBucket(bucketIndex(b));
+
+    if (2 * b._nrAlloc < 3 * (used + expected)) {
       try {
-        resizeInternal(userData, b, 2 * (b._nrAlloc + expected) + 1, false);
+        if (expected > 0) {
+          resizeInternal(userData, b, 2 * (b._nrAlloc + expected) + 1, false);
+        } else {
+          startMigration(userData, b, 2 * (b._nrAlloc + (used - b._nrUsed)) + 1);
+        }
       } catch (...) {
         return false;
       }
@@ -201,14 +419,12 @@ class AssocUnique {
       UserData* userData, BucketPosition& position, uint64_t const step,
       BucketPosition const& initial) const {
     Element found;
-    Bucket const* b = &_buckets[position.bucketId];
     do {
-      found = b->_table[position.position];
+      found = slotInBucket(position.bucketId, position.position);
       position.position += step;
-      while (position.position >= b->_nrAlloc) {
-        position.position -= b->_nrAlloc;
+      while (position.position >= slotsInBucket(position.bucketId)) {
+        position.position -= slotsInBucket(position.bucketId);
         position.bucketId = (position.bucketId + 1) % _buckets.size();
-        b = &_buckets[position.bucketId];
       }
       if (position == initial) {
         // We are done. Return the last element we have in hand
@@ -246,6 +462,12 @@ class AssocUnique {
       return TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED;
     }
 
+    if (findInOld(bucketIndex(b), hash, [&](Element const& other) {
+          return _helper.IsEqualElementElementByKey(userData, element, other);
+        }) != nullptr) {
+      return TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED;
+    }
+
     b._table[i] = element;
     b._nrUsed++;
 
@@ -256,6 +478,7 @@ class AssocUnique {
   void truncate(CallbackElementFuncType callback) {
     for (auto& b : _buckets) {
       invokeOnAllElements(callback, b);
+      clearMigration(_migrations[bucketIndex(b)]);
       b.deallocate();
       b.allocate(initialSize());
     }
@@ -268,8 +491,8 @@ class AssocUnique {
   //////////////////////////////////////////////////////////////////////////////
 
   bool isEmpty() const {
-    for (auto& b : _buckets) {
-      if (b._nrUsed > 0) {
+    for (size_t i = 0; i < _buckets.size(); ++i) {
+      if (usedInBucket(i) > 0) {
         return false;
       }
     }
@@ -285,6 +508,9 @@ class AssocUnique {
     for (auto& b : _buckets) {
       res += b.memoryUsage();
     }
+    for (auto& m : _migrations) {
+      res += m.old.memoryUsage();
+    }
     return res;
   }
 
@@ -294,8 +520,8 @@ class AssocUnique {
 
   size_t size() const {
     size_t sum = 0;
-    for (auto& b : _buckets) {
-      sum += static_cast<size_t>(b._nrUsed);
+    for (size_t i = 0; i < _buckets.size(); ++i) {
+      sum += static_cast<size_t>(usedInBucket(i));
     }
     return sum;
   }
@@ -315,7 +541,7 @@ class AssocUnique {
   int resize(UserData* userData, size_t size) {
     size /= _buckets.size();
     for (auto& b : _buckets) {
-      if (2 * (2 * size + 1) < 3 * b._nrUsed) {
+      if (2 * (2 * size + 1) < 3 * usedInBucket(bucketIndex(b))) {
         return TRI_ERROR_BAD_PARAMETER;
       }
 
@@ -336,9 +562,13 @@ class AssocUnique {
     TRI_ASSERT(builder.isOpenObject());
     builder.add("buckets", VPackValue(VPackValueType::Array));
     for (auto& b : _buckets) {
+      Migration const& m = _migrations[bucketIndex(b)];
       builder.openObject();
       builder.add("nrAlloc", VPackValue(b._nrAlloc));
-      builder.add("nrUsed", VPackValue(b._nrUsed));
+      builder.add("nrUsed", VPackValue(b._nrUsed + m.old._nrUsed));
+      if (m.old._table != nullptr) {
+        builder.add("nrMigrating", VPackValue(m.old._nrUsed));
+      }
       builder.close();
     }
     builder.close();  // buckets
@@ -351,7 +581,8 @@ class AssocUnique {
   //////////////////////////////////////////////////////////////////////////////
 
   Element find(UserData* userData, Element const& element) const {
-    uint64_t i = _helper.HashElement(userData, element, true);
+    uint64_t const hash = _helper.HashElement(userData, element, true);
+    uint64_t i = hash;
     Bucket const& b = _buckets[i & _bucketsMask];
 
     uint64_t const n = b._nrAlloc;
@@ -369,6 +600,15 @@ class AssocUnique {
         ;
     }
 
+    if (!b._table[i]) {
+      Element const* old = findInOld(hash & _bucketsMask, hash, [&](Element const& other) {
+        return _helper.IsEqualElementElementByKey(userData, element, other);
+      });
+      if (old != nullptr) {
+        return *old;
+      }
+    }
+
     // ...........................................................................
     // return whatever we found, this is nullptr if the thing was not found
     // and otherwise a valid pointer
@@ -403,6 +643,15 @@ class AssocUnique {
         ;
     }
 
+    if (!b._table[i]) {
+      Element const* old = findInOld(static_cast<size_t>(bucketId), hash, [&](Element const& other) {
+        return _helper.IsEqualKeyElement(userData, key, other);
+      });
+      if (old != nullptr) {
+        return *old;
+      }
+    }
+
     // ...........................................................................
     // return whatever we found, this is nullptr if the thing was not found
     // and otherwise a valid pointer
@@ -432,6 +681,15 @@ class AssocUnique {
         ;
     }
 
+    if (!b._table[i]) {
+      Element* old = findInOld(static_cast<size_t>(bucketId), hash, [&](Element const& other) {
+        return _helper.IsEqualKeyElement(userData, key, other);
+      });
+      if (old != nullptr) {
+        return old;
+      }
+    }
+
     // ...........................................................................
     // return whatever we found, this is nullptr if the thing was not found
     // and otherwise a valid pointer
@@ -474,6 +732,15 @@ class AssocUnique {
     position.bucketId = static_cast<size_t>(bucketId);
     position.position = i;
 
+    if (!b._table[i]) {
+      Element const* old = findInOld(static_cast<size_t>(bucketId), hash, [&](Element const& other) {
+        return _helper.IsEqualKeyElement(userData, key, other);
+      });
+      if (old != nullptr) {
+        return *old;
+      }
+    }
+
     // ...........................................................................
     // return whatever we found, this is nullptr if the thing was not found
     // and otherwise a valid pointer
@@ -490,6 +757,9 @@ class AssocUnique {
     uint64_t hash = _helper.HashElement(userData, element, true);
     Bucket& b = _buckets[hash & _bucketsMask];
 
+    // continue an incremental resize of the bucket
+    migrate(userData, b, migrationStep());
+
     if (!checkResize(userData, b, 0)) {
       return TRI_ERROR_OUT_OF_MEMORY;
     }
@@ -648,7 +918,7 @@ class AssocUnique {
       k = TRI_IncModU64(k, n);
     }
 
-    if (b._nrUsed == 0) {
+    if (b._nrUsed == 0 && _migrations[bucketIndex(b)].old._table == nullptr) {
       resizeInternal(userData, b, initialSize(), true);
     }
   }
@@ -683,6 +953,14 @@ class AssocUnique {
 
     if (old) {
       healHole(userData, b, i);
+    } else {
+      Element* slot = findInOld(hash & _bucketsMask, hash, [&](Element const& other) {
+        return _helper.IsEqualKeyElement(userData, key, other);
+      });
+      if (slot != nullptr) {
+        old = *slot;
+        removeFromOld(hash & _bucketsMask, slot);
+      }
     }
     return old;
   }
@@ -693,7 +971,8 @@ class AssocUnique {
   //////////////////////////////////////////////////////////////////////////////
 
   Element remove(UserData* userData, Element const& element) {
-    uint64_t i = _helper.HashElement(userData, element, true);
+    uint64_t const hash = _helper.HashElement(userData, element, true);
+    uint64_t i = hash;
     Bucket& b = _buckets[i & _bucketsMask];
 
     uint64_t const n = b._nrAlloc;
@@ -715,6 +994,14 @@ class AssocUnique {
 
     if (old) {
       healHole(userData, b, i);
+    } else {
+      Element* slot = findInOld(hash & _bucketsMask, hash, [&](Element const& other) {
+        return _helper.IsEqualElementElement(userData, element, other);
+      });
+      if (slot != nullptr) {
+        old = *slot;
+        removeFromOld(hash & _bucketsMask, slot);
+      }
     }
 
     return old;
@@ -749,6 +1036,18 @@ class AssocUnique {
         }
       }
     }
+    // elements not yet moved by an incremental resize
+    Migration& m = _migrations[bucketIndex(b)];
+    if (m.old._nrUsed > 0) {
+      for (uint64_t i = m.cursor; i < m.old._nrAlloc; ++i) {
+        if (!m.old._table[i] || m.removed[i]) {
+          continue;
+        }
+        if (!callback(m.old._table[i])) {
+          return false;
+        }
+      }
+    }
     return true;
   }
 
@@ -779,6 +1078,23 @@ class AssocUnique {
         }
       }
     }
+
+    // elements not yet moved by an incremental resize. removing them only
+    // marks their slots, and removals do not move elements
+    for (auto& m : _migrations) {
+      for (uint64_t i = m.cursor; i < m.old._nrAlloc; ++i) {
+        if (!m.old._table[i] || m.removed[i]) {
+          continue;
+        }
+        if (!callback(m.old._table[i])) {
+          return;
+        }
+        if (m.old._table == nullptr) {
+          // the last element of the old table was removed
+          break;
+        }
+      }
+    }
   }
 
   //////////////////////////////////////////////////////////////////////////////
@@ -800,10 +1116,7 @@ class AssocUnique {
 
       if (position.bucketId == SIZE_MAX) {
         // first call, now fill total
-        total = 0;
-        for (auto const& b : _buckets) {
-          total += b._nrUsed;
-        }
+        total = size();
 
         if (total == 0) {
           return Element();
@@ -817,16 +1130,16 @@ class AssocUnique {
     }
 
     while (true) {
-      Bucket const& b = _buckets[position.bucketId];
-      uint64_t const n = b._nrAlloc;
+      size_t const bucketId = position.bucketId;
+      uint64_t const n = slotsInBucket(bucketId);
 
-      for (; position.position < n && !b._table[position.position];
+      for (; position.position < n && !slotInBucket(bucketId, position.position);
            ++position.position)
         ;
 
       if (position.position != n) {
         // found an element
-        Element found = b._table[position.position];
+        Element found = slotInBucket(bucketId, position.position);
 
         // move forward the position indicator one more time
         if (++position.position == n) {
@@ -867,24 +1180,23 @@ class AssocUnique {
       }
 
       position.bucketId = _buckets.size() - 1;
-      position.position = _buckets[position.bucketId]._nrAlloc - 1;
+      position.position = slotsInBucket(position.bucketId) - 1;
     }
 
-    Bucket const* b = &_buckets[position.bucketId];
     Element found;
     do {
-      found = b->_table[position.position];
+      found = slotInBucket(position.bucketId, position.position);
 
       if (position.position == 0) {
         if (position.bucketId == 0) {
           // Indicate we are done
           position.bucketId = _buckets.size();
-          return Element();
+          // the first slot may hold an element as well
+          return found;
         }
 
         --position.bucketId;
-        b = &_buckets[position.bucketId];
-        position.position = b->_nrAlloc - 1;
+        position.position = slotsInBucket(position.bucketId) - 1;
       } else {
         --position.position;
       }
@@ -911,9 +1223,9 @@ class AssocUnique {
       // Initialize
       uint64_t used = 0;
       total = 0;
-      for (auto& b : _buckets) {
-        total += b._nrAlloc;
-        used += b._nrUsed;
+      for (size_t i = 0; i < _buckets.size(); ++i) {
+        total += slotsInBucket(i);
+        used += usedInBucket(i);
       }
       if (used == 0) {
         return Element();
@@ -930,14 +1242,14 @@ class AssocUnique {
             initialPositionNr = RandomGenerator::interval(UINT32_MAX) % total;
           }
           for (size_t i = 0; i < _buckets.size(); ++i) {
-            if (initialPositionNr < _buckets[i]._nrAlloc) {
+            if (initialPositionNr < slotsInBucket(i)) {
               position.bucketId = i;
               position.position = initialPositionNr;
               initialPosition.bucketId = i;
               initialPosition.position = initialPositionNr;
               break;
             }
-            initialPositionNr -= _buckets[i]._nrAlloc;
+            initialPositionNr -= slotsInBucket(i);
           }
           break;
         }
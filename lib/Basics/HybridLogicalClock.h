@@ -48,20 +48,22 @@ class HybridLogicalClock {
   HybridLogicalClock& operator=(HybridLogicalClock&& other) = delete;
 
   uint64_t getTimeStamp() {
-    uint64_t oldTimeStamp;
-    uint64_t newTimeStamp;
-    do {
-      uint64_t physical = getPhysicalTime();
-      oldTimeStamp = _lastTimeStamp.load(std::memory_order_relaxed);
-      uint64_t oldTime = extractTime(oldTimeStamp);
-      newTimeStamp =
-          (physical <= oldTime)
-              ? assembleTimeStamp(oldTime, extractCount(oldTimeStamp) + 1)
-              : assembleTimeStamp(physical, 0);
-    } while (!_lastTimeStamp.compare_exchange_weak(oldTimeStamp, newTimeStamp,
-                                                   std::memory_order_release,
-                                                   std::memory_order_relaxed));
-    return newTimeStamp;
+    uint64_t physical = getPhysicalTime();
+    uint64_t oldTimeStamp = _lastTimeStamp.load(std::memory_order_relaxed);
+    while (physical > extractTime(oldTimeStamp)) {
+      // the physical time moved on, start counting in its millisecond
+      uint64_t newTimeStamp = assembleTimeStamp(physical, 0);
+      if (_lastTimeStamp.compare_exchange_weak(oldTimeStamp, newTimeStamp,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed)) {
+        return newTimeStamp;
+      }
+    }
+    // the clock is at or ahead of the physical time, so the next count is
+    // the next time stamp. all writers of the same millisecond get theirs
+    // without retrying. an overflowing count carries into the time, like a
+    // count of the old time plus one did
+    return _lastTimeStamp.fetch_add(1, std::memory_order_release) + 1;
   }
 
   // Call the following when a message with a time stamp has been received:
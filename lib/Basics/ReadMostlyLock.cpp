@@ -0,0 +1,143 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ReadMostlyLock.h"
+
+#include <thread>
+
+using namespace arangodb::basics;
+
+namespace {
+std::atomic<size_t> nextStripe(0);
+
+/// @brief the stripe of the current thread, threads get them round robin
+size_t stripeOfThread() {
+  static thread_local size_t const stripe =
+      nextStripe.fetch_add(1, std::memory_order_relaxed) %
+      ReadMostlyLock::stripes;
+  return stripe;
+}
+}
+
+ReadMostlyLock::ReadMostlyLock() : _writer(false) {
+  for (auto& stripe : _stripes) {
+    stripe.readers.store(0, std::memory_order_relaxed);
+  }
+}
+
+/// @brief locks for writing
+void ReadMostlyLock::writeLock() {
+  {
+    std::unique_lock<std::mutex> guard(_mutex);
+    bool expected = false;
+    while (!_writer.compare_exchange_strong(expected, true)) {
+      expected = false;
+      _bell.wait(guard);
+    }
+  }
+
+  // no new readers get in now, wait for the remaining ones
+  uint64_t waitTime = 0;
+  while (hasReaders()) {
+    if (waitTime < 16) {
+      std::this_thread::yield();
+      ++waitTime;
+    } else {
+      std::this_thread::sleep_for(std::chrono::microseconds(waitTime));
+      if (waitTime < 256) {
+        waitTime *= 2;
+      }
+    }
+  }
+}
+
+/// @brief locks for writing, but only tries
+bool ReadMostlyLock::tryWriteLock() {
+  bool expected = false;
+  if (!_writer.compare_exchange_strong(expected, true)) {
+    return false;
+  }
+  if (hasReaders()) {
+    clearWriter();
+    return false;
+  }
+  return true;
+}
+
+/// @brief locks for reading
+void ReadMostlyLock::readLock() {
+  if (tryReadLock()) {
+    return;
+  }
+
+  std::unique_lock<std::mutex> guard(_mutex);
+  while (true) {
+    if (tryReadLock()) {
+      return;
+    }
+
+    _bell.wait(guard);
+  }
+}
+
+/// @brief locks for reading, tries only
+bool ReadMostlyLock::tryReadLock() {
+  // the increment must be visible before the flag is read, and the flag
+  // is set before the writer reads the stripes. then either the writer
+  // sees the reader, or the reader sees the writer
+  std::atomic<int64_t>& readers = _stripes[stripeOfThread()].readers;
+  readers.fetch_add(1, std::memory_order_seq_cst);
+  if (!_writer.load(std::memory_order_seq_cst)) {
+    return true;
+  }
+  readers.fetch_sub(1, std::memory_order_release);
+  return false;
+}
+
+/// @brief releases the read-lock
+void ReadMostlyLock::unlockRead() {
+  _stripes[stripeOfThread()].readers.fetch_sub(1, std::memory_order_release);
+}
+
+/// @brief releases the write-lock
+void ReadMostlyLock::unlockWrite() {
+  TRI_ASSERT(_writer.load());
+  clearWriter();
+}
+
+bool ReadMostlyLock::hasReaders() const {
+  // once the flag is set, the sum can only go down, apart from readers
+  // that see the flag and leave again. a sum of zero thus means that no
+  // reader holds the lock
+  int64_t sum = 0;
+  for (auto const& stripe : _stripes) {
+    sum += stripe.readers.load(std::memory_order_seq_cst);
+  }
+  TRI_ASSERT(sum >= 0);
+  return sum != 0;
+}
+
+void ReadMostlyLock::clearWriter() {
+  {
+    std::unique_lock<std::mutex> guard(_mutex);
+    _writer.store(false, std::memory_order_seq_cst);
+  }
+  _bell.notify_all();
+}
@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_BASICS_READ_MOSTLY_LOCK_H
+#define ARANGODB_BASICS_READ_MOSTLY_LOCK_H 1
+
+#include "Basics/Common.h"
+
+#include <condition_variable>
+#include <mutex>
+
+namespace arangodb {
+namespace basics {
+
+/// @brief read-write lock for data that is read far more often than it is
+/// written, with the interface of ReadWriteLock. readers count themselves
+/// in one of several stripes, chosen by their thread, each on its own cache
+/// line, so concurrent readers do not contend on a shared lock word. a
+/// writer announces itself, which keeps new readers out, and then waits
+/// until all stripes are empty, locking for writing is thus more expensive
+/// than with ReadWriteLock.
+/// like ReadWriteLock, a read lock can be released by another thread than
+/// the one that acquired it, and writers have a preference over readers
+class ReadMostlyLock {
+ public:
+  static constexpr size_t stripes = 16;
+
+  ReadMostlyLock();
+
+  ReadMostlyLock(ReadMostlyLock const&) = delete;
+  ReadMostlyLock& operator=(ReadMostlyLock const&) = delete;
+
+  /// @brief locks for writing
+  void writeLock();
+
+  /// @brief locks for writing, but only tries
+  bool tryWriteLock();
+
+  /// @brief locks for reading
+  void readLock();
+
+  /// @brief locks for reading, tries only
+  bool tryReadLock();
+
+  /// @brief releases the read-lock
+  void unlockRead();
+
+  /// @brief releases the write-lock
+  void unlockWrite();
+
+ private:
+  /// @brief whether any stripe counts a reader
+  bool hasReaders() const;
+
+  /// @brief lets readers and writers in again, after the flag was set
+  void clearWriter();
+
+ private:
+  /// @brief readers of one stripe, padded to a cache line. the count of a
+  /// single stripe can become negative, when a reader releases its lock on
+  /// another thread, only the sum of all stripes is meaningful
+  struct Stripe {
+    std::atomic<int64_t> readers;
+    char padding[64 - sizeof(std::atomic<int64_t>)];
+  };
+
+  Stripe _stripes[stripes];
+
+  /// @brief set while a writer holds the lock or waits for the readers
+  std::atomic<bool> _writer;
+  char _padding[64 - sizeof(std::atomic<bool>)];
+
+  /// @brief for the readers and writers that wait for a writer
+  std::mutex _mutex;
+  std::condition_variable _bell;
+};
+}
+}
+
+#endif
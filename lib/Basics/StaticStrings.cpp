@@ -109,6 +109,7 @@ std::string const StaticStrings::AccessControlRequestHeaders(
 std::string const StaticStrings::Allow("allow");
 std::string const StaticStrings::Async("x-arango-async");
 std::string const StaticStrings::AsyncId("x-arango-async-id");
+std::string const StaticStrings::Deadline("x-arango-deadline");
 std::string const StaticStrings::Authorization("authorization");
 std::string const StaticStrings::BatchContentType(
     "application/x-arango-batchpart");
@@ -142,6 +143,7 @@ std::string const StaticStrings::Queue("x-arango-queue");
 std::string const StaticStrings::RequestServedBy("x-arango-request-served-by");
 std::string const StaticStrings::ResponseCode("x-arango-response-code");
 std::string const StaticStrings::Server("server");
+std::string const StaticStrings::TraceIdHeader("x-arango-trace-id");
 std::string const StaticStrings::Unlimited = "unlimited";
 std::string const StaticStrings::WwwAuthenticate("www-authenticate");
 std::string const StaticStrings::XContentTypeOptions("x-content-type-options");
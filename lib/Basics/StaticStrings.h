@@ -108,6 +108,7 @@ class StaticStrings {
   static std::string const Allow;
   static std::string const Async;
   static std::string const AsyncId;
+  static std::string const Deadline;
   static std::string const Authorization;
   static std::string const BatchContentType;
   static std::string const CacheControl;
@@ -137,6 +138,7 @@ class StaticStrings {
   static std::string const RequestServedBy;
   static std::string const ResponseCode;
   static std::string const Server;
+  static std::string const TraceIdHeader;
   static std::string const Unlimited;
   static std::string const WwwAuthenticate;
   static std::string const XContentTypeOptions;
@@ -37,6 +37,24 @@ static inline size_t Remaining(TRI_string_buffer_t* self) {
   return self->_len - static_cast<size_t>(self->_current - self->_buffer);
 }
 
+/// @brief whether the buffer uses the storage inside the string buffer
+static inline bool IsInline(TRI_string_buffer_t const* self) {
+  return self->_buffer == self->_inline;
+}
+
+/// @brief uses the storage inside the string buffer
+static void UseInline(TRI_string_buffer_t* self) {
+  self->_buffer = self->_inline;
+  self->_current = self->_inline;
+  self->_len = TRI_STRING_BUFFER_INLINE_SIZE;
+
+  if (self->_initializeMemory) {
+    memset(self->_inline, 0, sizeof(self->_inline));
+  } else {
+    self->_inline[0] = '\0';
+  }
+}
+
 /// @brief reserve space
 static int Reserve(TRI_string_buffer_t* self, size_t size) {
   if (size > Remaining(self)) {
@@ -44,8 +62,17 @@ static int Reserve(TRI_string_buffer_t* self, size_t size) {
     size_t len = static_cast<size_t>(1.3 * (self->_len + size));
     TRI_ASSERT(len > 0);
 
-    char* ptr = static_cast<char*>(
-        TRI_Reallocate(self->_buffer, len + 1));
+    char* ptr;
+    if (IsInline(self)) {
+      // the inline storage cannot be reallocated
+      ptr = static_cast<char*>(TRI_Allocate(len + 1));
+
+      if (ptr != nullptr) {
+        memcpy(ptr, self->_inline, sizeof(self->_inline));
+      }
+    } else {
+      ptr = static_cast<char*>(TRI_Reallocate(self->_buffer, len + 1));
+    }
 
     if (ptr == nullptr) {
       return TRI_ERROR_OUT_OF_MEMORY;
@@ -118,7 +145,7 @@ void TRI_InitStringBuffer(TRI_string_buffer_t* self,
   self->_len = 0;
   self->_initializeMemory = initializeMemory;
 
-  Reserve(self, 120);
+  UseInline(self);
 }
 
 /// @brief initializes the string buffer with a specific size
@@ -132,8 +159,8 @@ void TRI_InitSizedStringBuffer(TRI_string_buffer_t* self,
   self->_len = 0;
   self->_initializeMemory = initializeMemory;
 
-  if (length == 0) { // 0 does not work as allocation size
-    Reserve(self, 4);
+  if (length <= TRI_STRING_BUFFER_INLINE_SIZE) {
+    UseInline(self);
   } else {
     Reserve(self, length);
   }
@@ -143,7 +170,7 @@ void TRI_InitSizedStringBuffer(TRI_string_buffer_t* self,
 ///
 /// @warning You must call free or destroy after using the string buffer.
 void TRI_DestroyStringBuffer(TRI_string_buffer_t* self) {
-  if (self->_buffer != nullptr) {
+  if (self->_buffer != nullptr && !IsInline(self)) {
     TRI_Free(self->_buffer);
   }
 }
@@ -155,7 +182,9 @@ void TRI_AnnihilateStringBuffer(TRI_string_buffer_t* self) {
   if (self->_buffer != nullptr) {
     // somewhat paranoid? don't ask me
     memset(self->_buffer, 0, self->_len);
-    TRI_Free(self->_buffer);
+    if (!IsInline(self)) {
+      TRI_Free(self->_buffer);
+    }
     self->_buffer = nullptr;
   }
 }
@@ -272,6 +301,26 @@ void TRI_SwapStringBuffer(TRI_string_buffer_t* self,
   self->_buffer = otherBuffer;
   self->_current = otherCurrent;
   self->_len = otherLen;
+
+  // contents in the inline storage move along with the pointers
+  bool const selfInline = (other->_buffer == self->_inline);
+  bool const otherInline = (self->_buffer == other->_inline);
+
+  if (selfInline || otherInline) {
+    char tmp[sizeof(self->_inline)];
+    memcpy(tmp, self->_inline, sizeof(tmp));
+    memcpy(self->_inline, other->_inline, sizeof(tmp));
+    memcpy(other->_inline, tmp, sizeof(tmp));
+
+    if (otherInline) {
+      self->_current = self->_inline + (self->_current - other->_inline);
+      self->_buffer = self->_inline;
+    }
+    if (selfInline) {
+      other->_current = other->_inline + (other->_current - self->_inline);
+      other->_buffer = other->_inline;
+    }
+  }
 }
 
 /// @brief returns pointer to the beginning of the character buffer
@@ -339,6 +388,15 @@ void TRI_ResetStringBuffer(TRI_string_buffer_t* self) {
 char* TRI_StealStringBuffer(TRI_string_buffer_t* self) {
   char* result = self->_buffer;
 
+  if (IsInline(self)) {
+    // the caller frees the result, so it must not be the inline storage
+    result = static_cast<char*>(TRI_Allocate(sizeof(self->_inline)));
+
+    if (result != nullptr) {
+      memcpy(result, self->_inline, sizeof(self->_inline));
+    }
+  }
+
   // reset everthing
   self->_buffer = nullptr;
   self->_current = nullptr;
@@ -31,12 +31,18 @@
 #include <sstream>
 #include <iosfwd>
 
-/// @brief string buffer with formatting routines
+/// @brief capacity of the storage inside a string buffer
+#define TRI_STRING_BUFFER_INLINE_SIZE 120
+
+/// @brief string buffer with formatting routines. short strings are kept in
+/// the storage of the string buffer itself, _buffer then points to _inline,
+/// a string buffer must thus not be copied bytewise
 struct TRI_string_buffer_t {
   char* _buffer;
   char* _current;
   size_t _len;
   bool _initializeMemory;
+  char _inline[TRI_STRING_BUFFER_INLINE_SIZE + 1];
 };
 
 /// @brief create a new string buffer and initialize it
@@ -533,15 +539,13 @@ class StringBuffer {
     return *this;
   }
 
-  /// @brief set the buffer content
-  void set(TRI_string_buffer_t const* other) {
-    if (_buffer._buffer != nullptr) {
-      TRI_Free(_buffer._buffer);
-    }
-
-    _buffer._buffer = other->_buffer;
-    _buffer._current = other->_current;
-    _buffer._len = other->_len;
+  /// @brief takes over the buffer content, other is empty afterwards
+  void set(TRI_string_buffer_t* other) {
+    TRI_SwapStringBuffer(&_buffer, other);
+    TRI_DestroyStringBuffer(other);
+    other->_buffer = nullptr;
+    other->_current = nullptr;
+    other->_len = 0;
   }
 
   /// @brief make sure the buffer is null-terminated
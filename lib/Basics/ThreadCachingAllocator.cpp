@@ -0,0 +1,181 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ThreadCachingAllocator.h"
+
+#include "Basics/Mutex.h"
+#include "Basics/MutexLocker.h"
+
+using namespace arangodb::basics;
+
+namespace {
+/// @brief 0 before the cache of the thread is used, 1 while it exists, 2
+/// after it was destroyed at the end of the thread. blocks freed after
+/// that go back to operator delete
+thread_local int cacheState = 0;
+}
+
+struct ThreadCachingAllocator::ThreadCache {
+  Magazine loaded[sizeClasses];
+  /// @brief either empty or full
+  Magazine previous[sizeClasses];
+
+  ~ThreadCache() {
+    flushThread();
+    cacheState = 2;
+  }
+};
+
+namespace {
+struct Depot {
+  Depot() { magazines.reserve(ThreadCachingAllocator::depotSize); }
+
+  arangodb::Mutex lock;
+  std::vector<std::pair<void*, size_t>> magazines;
+};
+
+/// @brief the depots are never destroyed, threads may still return their
+/// magazines while the process exits
+Depot* depots() {
+  static Depot* depots = new Depot[ThreadCachingAllocator::sizeClasses];
+  return depots;
+}
+}
+
+void* ThreadCachingAllocator::allocate(size_t size) {
+  if (size > maxSize) {
+    return ::operator new(size);
+  }
+  size_t const sc = sizeClass(size);
+
+  ThreadCache* cache = threadCache();
+  if (cache != nullptr) {
+    Magazine& loaded = cache->loaded[sc];
+    if (loaded.count == 0) {
+      Magazine& previous = cache->previous[sc];
+      if (previous.count > 0) {
+        std::swap(loaded, previous);
+      } else {
+        fromDepot(sc, loaded);
+      }
+    }
+    if (loaded.count > 0) {
+      void* value = loaded.head;
+      loaded.head = *static_cast<void**>(value);
+      --loaded.count;
+      return value;
+    }
+  }
+
+  return ::operator new((sc + 1) * granularity);
+}
+
+void ThreadCachingAllocator::deallocate(void* value, size_t size) noexcept {
+  if (value == nullptr) {
+    return;
+  }
+  if (size > maxSize) {
+    ::operator delete(value);
+    return;
+  }
+  size_t const sc = sizeClass(size);
+
+  ThreadCache* cache = threadCache();
+  if (cache == nullptr) {
+    ::operator delete(value);
+    return;
+  }
+
+  Magazine& loaded = cache->loaded[sc];
+  if (loaded.count == magazineSize) {
+    Magazine& previous = cache->previous[sc];
+    if (previous.count > 0) {
+      toDepot(sc, previous);
+    }
+    std::swap(loaded, previous);
+  }
+  *static_cast<void**>(value) = loaded.head;
+  loaded.head = value;
+  ++loaded.count;
+}
+
+void ThreadCachingAllocator::flushThread() noexcept {
+  if (cacheState != 1) {
+    return;
+  }
+  ThreadCache* cache = threadCache();
+  for (size_t sc = 0; sc < sizeClasses; ++sc) {
+    if (cache->loaded[sc].count > 0) {
+      toDepot(sc, cache->loaded[sc]);
+    }
+    if (cache->previous[sc].count > 0) {
+      toDepot(sc, cache->previous[sc]);
+    }
+  }
+}
+
+ThreadCachingAllocator::ThreadCache* ThreadCachingAllocator::threadCache() noexcept {
+  if (cacheState == 2) {
+    return nullptr;
+  }
+  thread_local ThreadCache cache;
+  cacheState = 1;
+  return &cache;
+}
+
+bool ThreadCachingAllocator::fromDepot(size_t sizeClass,
+                                       Magazine& magazine) noexcept {
+  TRI_ASSERT(magazine.count == 0);
+  Depot& depot = depots()[sizeClass];
+
+  MUTEX_LOCKER(locker, depot.lock);
+  if (depot.magazines.empty()) {
+    return false;
+  }
+  magazine.head = depot.magazines.back().first;
+  magazine.count = depot.magazines.back().second;
+  depot.magazines.pop_back();
+  return true;
+}
+
+void ThreadCachingAllocator::toDepot(size_t sizeClass,
+                                     Magazine& magazine) noexcept {
+  TRI_ASSERT(magazine.count > 0);
+  Depot& depot = depots()[sizeClass];
+  {
+    MUTEX_LOCKER(locker, depot.lock);
+    if (depot.magazines.size() < depotSize) {
+      // the capacity was reserved, this does not allocate
+      depot.magazines.emplace_back(magazine.head, magazine.count);
+      magazine = Magazine();
+      return;
+    }
+  }
+  release(magazine);
+}
+
+void ThreadCachingAllocator::release(Magazine& magazine) noexcept {
+  while (magazine.head != nullptr) {
+    void* next = *static_cast<void**>(magazine.head);
+    ::operator delete(magazine.head);
+    magazine.head = next;
+  }
+  magazine.count = 0;
+}
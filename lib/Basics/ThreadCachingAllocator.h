@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_BASICS_THREAD_CACHING_ALLOCATOR_H
+#define ARANGODB_BASICS_THREAD_CACHING_ALLOCATOR_H 1
+
+#include "Basics/Common.h"
+
+namespace arangodb {
+namespace basics {
+
+/// @brief allocator for small blocks of memory, which are allocated and
+/// freed at high rates, e.g. the values of the caches or managed slices of
+/// AQL values. sizes are rounded up to a multiple of the granularity,
+/// every thread keeps up to two magazines of free blocks of each size
+/// class, so most allocations and frees touch no shared data. full
+/// magazines go to a central depot, which also hands them out to threads
+/// without free blocks. a block may be freed by another thread than the one
+/// that allocated it, it then ends up in the cache of the freeing thread.
+/// blocks larger than maxSize are allocated with operator new directly.
+/// the size passed to deallocate must be the one passed to allocate
+class ThreadCachingAllocator {
+ public:
+  static constexpr size_t granularity = 16;
+  static constexpr size_t maxSize = 256;
+  static constexpr size_t sizeClasses = maxSize / granularity;
+
+  /// @brief number of free blocks in one magazine
+  static constexpr size_t magazineSize = 32;
+
+  /// @brief number of full magazines the depot keeps per size class, the
+  /// blocks of further magazines are released
+  static constexpr size_t depotSize = 64;
+
+  ThreadCachingAllocator() = delete;
+
+  /// @brief allocates size bytes, throws std::bad_alloc
+  static void* allocate(size_t size);
+
+  /// @brief frees a block returned by allocate for the same size
+  static void deallocate(void* value, size_t size) noexcept;
+
+  /// @brief returns the free blocks cached by the current thread to the
+  /// depot, called when the thread ends
+  static void flushThread() noexcept;
+
+ private:
+  /// @brief free blocks of one size class, linked through their first word
+  struct Magazine {
+    void* head = nullptr;
+    size_t count = 0;
+  };
+
+  struct ThreadCache;
+
+  static size_t sizeClass(size_t size) noexcept {
+    return size == 0 ? 0 : (size - 1) / granularity;
+  }
+
+  static ThreadCache* threadCache() noexcept;
+
+  /// @brief takes a full magazine from the depot, returns false if there is
+  /// none
+  static bool fromDepot(size_t sizeClass, Magazine& magazine) noexcept;
+
+  /// @brief hands a magazine to the depot, or releases its blocks
+  static void toDepot(size_t sizeClass, Magazine& magazine) noexcept;
+
+  static void release(Magazine& magazine) noexcept;
+};
+}
+}
+
+#endif
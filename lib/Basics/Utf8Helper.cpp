@@ -78,6 +78,39 @@ int Utf8Helper::compareUtf8(char const* left, size_t leftLength,
   return result;
 }
 
+bool Utf8Helper::appendSortKey(char const* value, size_t length,
+                               std::string& result) const {
+  TRI_ASSERT(value != nullptr);
+
+  if (!_coll) {
+    return false;
+  }
+
+  UnicodeString const s =
+      UnicodeString::fromUTF8(StringPiece(value, (int32_t)length));
+
+  size_t const offset = result.size();
+  // the key is mostly a bit longer than the string
+  int32_t capacity = static_cast<int32_t>(2 * length + 16);
+  result.resize(offset + capacity);
+
+  int32_t needed = _coll->getSortKey(
+      s, reinterpret_cast<uint8_t*>(&result[offset]), capacity);
+  if (needed > capacity) {
+    result.resize(offset + needed);
+    needed = _coll->getSortKey(
+        s, reinterpret_cast<uint8_t*>(&result[offset]), needed);
+  }
+  if (needed == 0) {
+    result.resize(offset);
+    return false;
+  }
+
+  // the key ends with a zero byte, which is not needed for comparisons
+  result.resize(offset + needed - 1);
+  return true;
+}
+
 int Utf8Helper::compareUtf16(uint16_t const* left, size_t leftLength,
                              uint16_t const* right, size_t rightLength) const {
   TRI_ASSERT(left != nullptr);
@@ -73,6 +73,15 @@ class Utf8Helper {
   int compareUtf8(char const* left, size_t leftLength, char const* right,
                   size_t rightLength) const;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief appends the collation sort key of an utf8 string to result.
+  /// comparing two sort keys bytewise gives the order of compareUtf8.
+  /// returns false if there is no collator or the key could not be built
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool appendSortKey(char const* value, size_t length,
+                     std::string& result) const;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief compare utf16 strings
   /// -1 : left < right
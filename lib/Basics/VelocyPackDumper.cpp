@@ -33,10 +33,61 @@
 #include <velocypack/Slice.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <cmath>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 using namespace arangodb::basics;
 
 static size_t const MinReserveValue = 32;
 
+/// @brief the two digits of the numbers 0 to 99
+static char const Digits[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/// @brief length of the prefix of [p, e) that can be copied to the output
+/// as is, i.e. that has no bytes to escape and no multi-byte sequences
+static inline size_t PlainPrefixLength(uint8_t const* p, uint8_t const* e) {
+  uint8_t const* start = p;
+
+#ifdef __SSE2__
+  // 16 bytes at a time. a signed comparison with 0x20 finds the control
+  // characters and all bytes with the high bit set
+  __m128i const space = _mm_set1_epi8(0x20);
+  __m128i const quote = _mm_set1_epi8('"');
+  __m128i const backslash = _mm_set1_epi8('\\');
+  __m128i const slash = _mm_set1_epi8('/');
+
+  while (e - p >= 16) {
+    __m128i const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+    __m128i const special = _mm_or_si128(
+        _mm_or_si128(_mm_cmplt_epi8(v, space), _mm_cmpeq_epi8(v, quote)),
+        _mm_or_si128(_mm_cmpeq_epi8(v, backslash), _mm_cmpeq_epi8(v, slash)));
+    if (_mm_movemask_epi8(special) != 0) {
+      // the loop below finds the position
+      break;
+    }
+    p += 16;
+  }
+#endif
+
+  while (p < e) {
+    uint8_t const c = *p;
+    if (c < 0x20 || c >= 0x80 || c == '"' || c == '\\' || c == '/') {
+      break;
+    }
+    ++p;
+  }
+
+  return static_cast<size_t>(p - start);
+}
+
 void VelocyPackDumper::handleUnsupportedType(VPackSlice const* /*slice*/) {
   TRI_string_buffer_t* buffer = _buffer->stringBuffer(); 
 
@@ -64,68 +115,44 @@ void VelocyPackDumper::appendUInt(uint64_t v) {
     THROW_ARANGO_EXCEPTION(res);
   }
 
-  if (10000000000000000000ULL <= v) {
-    TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 10000000000000000000ULL) % 10);
-  }
-  if (1000000000000000000ULL <= v) {
-    TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 1000000000000000000ULL) % 10);
-  }
-  if (100000000000000000ULL <= v) {
-    TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 100000000000000000ULL) % 10);
-  }
-  if (10000000000000000ULL <= v) {
-    TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 10000000000000000ULL) % 10);
-  }
-  if (1000000000000000ULL <= v) {
-    TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 1000000000000000ULL) % 10);
-  }
-  if (100000000000000ULL <= v) {
-    TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 100000000000000ULL) % 10);
-  }
-  if (10000000000000ULL <= v) {
-    TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 10000000000000ULL) % 10);
-  }
-  if (1000000000000ULL <= v) {
-    TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 1000000000000ULL) % 10);
-  }
-  if (100000000000ULL <= v) {
-    TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 100000000000ULL) % 10);
-  }
-  if (10000000000ULL <= v) {
-    TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 10000000000ULL) % 10);
-  }
-  if (1000000000ULL <= v) {
-    TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 1000000000ULL) % 10);
-  }
-  if (100000000ULL <= v) {
-    TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 100000000ULL) % 10);
-  }
-  if (10000000ULL <= v) {
-    TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 10000000ULL) % 10);
-  }
-  if (1000000ULL <= v) {
-    TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 1000000ULL) % 10);
-  }
-  if (100000ULL <= v) {
-    TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 100000ULL) % 10);
-  }
-  if (10000ULL <= v) {
-    TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 10000ULL) % 10);
-  }
-  if (1000ULL <= v) {
-    TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 1000ULL) % 10);
-  }
-  if (100ULL <= v) {
-    TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 100ULL) % 10);
+  // the digits are produced back to front, two per division
+  char temp[20];
+  char* const end = &temp[0] + sizeof(temp);
+  char* p = end;
+
+  while (v >= 100) {
+    size_t const i = static_cast<size_t>(v % 100) * 2;
+    v /= 100;
+    *--p = Digits[i + 1];
+    *--p = Digits[i];
   }
-  if (10ULL <= v) {
-    TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 10ULL) % 10);
+  if (v >= 10) {
+    size_t const i = static_cast<size_t>(v) * 2;
+    *--p = Digits[i + 1];
+    *--p = Digits[i];
+  } else {
+    *--p = static_cast<char>('0' + v);
   }
 
-  TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v % 10));
+  TRI_AppendStringUnsafeStringBuffer(buffer, p, static_cast<size_t>(end - p));
 }
 
 void VelocyPackDumper::appendDouble(double v) {
+  if (v > -1.0e8 && v < 1.0e8 && v == std::floor(v) &&
+      !(v == 0.0 && std::signbit(v))) {
+    // fpconv prints integral values below 10^8 without exponent or decimal
+    // point, like integers
+    if (v < 0.0) {
+      TRI_string_buffer_t* buffer = _buffer->stringBuffer();
+      if (TRI_AppendCharStringBuffer(buffer, '-') != TRI_ERROR_NO_ERROR) {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+      }
+      v = -v;
+    }
+    appendUInt(static_cast<uint64_t>(v));
+    return;
+  }
+
   char temp[24];
   int len = fpconv_dtoa(v, &temp[0]);
   
@@ -146,82 +173,18 @@ void VelocyPackDumper::dumpInteger(VPackSlice const* slice) {
 
     appendUInt(v);
   } else if (slice->isType(VPackValueType::Int)) {
-    TRI_string_buffer_t* buffer = _buffer->stringBuffer(); 
-   
-    TRI_ASSERT(MinReserveValue > 20); 
-    int res = TRI_ReserveStringBuffer(buffer, MinReserveValue);
-     
-    if (res != TRI_ERROR_NO_ERROR) {
-      THROW_ARANGO_EXCEPTION(res);
-    }
-
     int64_t v = slice->getInt();
-    if (v == INT64_MIN) {
-      TRI_AppendStringUnsafeStringBuffer(buffer, "-9223372036854775808", 20);
-      return;
-    }
-  
-    if (v < 0) {
-      TRI_AppendCharUnsafeStringBuffer(buffer, '-');
-      v = -v;
-    }
 
-    if (1000000000000000000LL <= v) {
-      TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 1000000000000000000LL) % 10);
-    }
-    if (100000000000000000LL <= v) {
-      TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 100000000000000000LL) % 10);
-    }
-    if (10000000000000000LL <= v) {
-      TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 10000000000000000LL) % 10);
-    }
-    if (1000000000000000LL <= v) {
-      TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 1000000000000000LL) % 10);
-    }
-    if (100000000000000LL <= v) {
-      TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 100000000000000LL) % 10);
-    }
-    if (10000000000000LL <= v) {
-      TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 10000000000000LL) % 10);
-    }
-    if (1000000000000LL <= v) {
-      TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 1000000000000LL) % 10);
-    }
-    if (100000000000LL <= v) {
-      TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 100000000000LL) % 10);
-    }
-    if (10000000000LL <= v) {
-      TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 10000000000LL) % 10);
-    }
-    if (1000000000LL <= v) {
-      TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 1000000000LL) % 10);
-    }
-    if (100000000LL <= v) {
-      TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 100000000LL) % 10);
-    }
-    if (10000000LL <= v) {
-      TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 10000000LL) % 10);
-    }
-    if (1000000LL <= v) {
-      TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 1000000LL) % 10);
-    }
-    if (100000LL <= v) {
-      TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 100000LL) % 10);
-    }
-    if (10000LL <= v) {
-      TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 10000LL) % 10);
-    }
-    if (1000LL <= v) {
-      TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 1000LL) % 10);
-    }
-    if (100LL <= v) {
-      TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 100LL) % 10);
-    }
-    if (10LL <= v) {
-      TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v / 10LL) % 10);
+    if (v < 0) {
+      TRI_string_buffer_t* buffer = _buffer->stringBuffer(); 
+      if (TRI_AppendCharStringBuffer(buffer, '-') != TRI_ERROR_NO_ERROR) {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+      }
+      // also correct for INT64_MIN
+      appendUInt(uint64_t(0) - static_cast<uint64_t>(v));
+    } else {
+      appendUInt(static_cast<uint64_t>(v));
     }
-
-    TRI_AppendCharUnsafeStringBuffer(buffer, '0' + (v % 10));
   } else if (slice->isType(VPackValueType::SmallInt)) {
     TRI_string_buffer_t* buffer = _buffer->stringBuffer(); 
     
@@ -310,6 +273,15 @@ void VelocyPackDumper::appendString(char const* src, VPackValueLength len) {
   uint8_t const* p = reinterpret_cast<uint8_t const*>(src);
   uint8_t const* e = p + len;
   while (p < e) {
+    size_t const plain = PlainPrefixLength(p, e);
+    if (plain > 0) {
+      TRI_AppendStringUnsafeStringBuffer(buffer, reinterpret_cast<char const*>(p), plain);
+      p += plain;
+      if (p == e) {
+        break;
+      }
+    }
+
     uint8_t c = *p;
 
     if ((c & 0x80U) == 0) {
@@ -399,8 +371,13 @@ void VelocyPackDumper::dumpValue(VPackSlice const* slice, VPackSlice const* base
   
   TRI_string_buffer_t* buffer = _buffer->stringBuffer(); 
   
-  // alloc at least 32 bytes  
-  int res = TRI_ReserveStringBuffer(buffer, 32);
+  // alloc at least 32 bytes, and for the outermost value about as much as
+  // its JSON will need, so that the buffer rarely grows while dumping
+  size_t reserve = 32;
+  if (base == slice) {
+    reserve = (std::max)(reserve, static_cast<size_t>(slice->byteSize()));
+  }
+  int res = TRI_ReserveStringBuffer(buffer, reserve);
      
   if (res != TRI_ERROR_NO_ERROR) {
     THROW_ARANGO_EXCEPTION(res);
@@ -959,7 +959,7 @@ char* TRI_SlurpFile(char const* filename,
   }
 
   TRI_TRACKED_CLOSE_FILE(fd);
-  return result._buffer;
+  return TRI_StealStringBuffer(&result);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
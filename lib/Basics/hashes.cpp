@@ -408,13 +408,33 @@ static const uint32_t Crc32Lookup[8][256] = {
      0x14124958, 0x5d2e347f, 0xe54c35a1, 0xac704886, 0x7734cfef, 0x3e08b2c8,
      0xc451b7cc, 0x8d6dcaeb, 0x56294d82, 0x1f1530a5}};
 
+// without the assembler sources, x86-64 builds use the SSE4.2 instructions
+// through intrinsics. they are compiled for SSE4.2 individually, so that
+// builds for generic x86-64 use them on the CPUs that have them
+#if ENABLE_ASM_CRC32 == 0 && (defined(__x86_64__) || defined(_M_X64)) && \
+    (defined(__GNUC__) || defined(_MSC_VER))
+#define TRI_CRC32_INTRINSICS 1
+#endif
+
 /// @brief Detection of Intel SSE4.2 extensions at runtime:
-#if ENABLE_ASM_CRC32 == 1
+#if ENABLE_ASM_CRC32 == 1 || defined(TRI_CRC32_INTRINSICS)
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#include <nmmintrin.h>
+#else
 #include <cpuid.h>
 #include <x86intrin.h>
+#endif
+
+#include <cstring>
 
 static bool HasSSE42() {
+#ifdef _MSC_VER
+  int info[4];
+  __cpuid(info, 1);
+  return (info[2] & 0x100000) != 0;
+#else
   unsigned int eax, ebx, ecx, edx;
   if (__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
     if ((ecx & 0x100000) != 0) {
@@ -425,33 +445,33 @@ static bool HasSSE42() {
   } else {
     return false;
   }
+#endif
 }
 
-// The following is currently not used, it is a fallback for the case
-// that the pure assembler source cannot be assembled or linked for
-// some reason.
+#endif
 
-#if 0
-extern "C" uint32_t TRI_BlockCrc32_intrinsics(uint32_t value,
-                                              char const* data,
-                                              size_t length) {
+#ifdef TRI_CRC32_INTRINSICS
+#ifndef _MSC_VER
+__attribute__((target("sse4.2")))
+#endif
+static uint32_t TRI_BlockCrc32_Intrinsics(uint32_t value, char const* data,
+                                          size_t length) {
   uint64_t tmp = value;
-  auto p = reinterpret_cast<uint64_t const*>(data);
   while (length >= 8) {
-    tmp = _mm_crc32_u64(tmp, *p++);
+    uint64_t word;
+    memcpy(&word, data, sizeof(word));
+    tmp = _mm_crc32_u64(tmp, word);
+    data += 8;
     length -= 8;
   }
-  auto p2 = reinterpret_cast<unsigned char const*>(p);
   value = static_cast<uint32_t>(tmp);
   while (length-- > 0) {
-    value = _mm_crc32_u8(value, *p2++);
+    value = _mm_crc32_u8(value, static_cast<unsigned char>(*data++));
   }
   return value;
 }
 #endif
 
-#endif
-
 /// @brief CRC32 value of data block
 ///
 /// optimized code to process 8 bytes at a time. provides a substantial speedup
@@ -497,13 +517,16 @@ extern "C" {
 #endif
   }
 
-#if ENABLE_ASM_CRC32 == 1
+#if ENABLE_ASM_CRC32 == 1 || defined(TRI_CRC32_INTRINSICS)
   static uint32_t TRI_BlockCrc32_Detect(uint32_t hash,
                                         char const* data,
                                         size_t length) {
     if (HasSSE42()) {
+#if ENABLE_ASM_CRC32 == 1
       TRI_BlockCrc32 = TRI_BlockCrc32_SSE42;
-      //TRI_BlockCrc32 = TRI_BlockCrc32_intrinsics;
+#else
+      TRI_BlockCrc32 = TRI_BlockCrc32_Intrinsics;
+#endif
     } else {
       TRI_BlockCrc32 = TRI_BlockCrc32_C;
     }
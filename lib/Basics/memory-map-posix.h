@@ -56,6 +56,7 @@
 #define TRI_MADVISE_WILLNEED 0
 #define TRI_MADVISE_DONTNEED 0
 #define TRI_MADVISE_DONTDUMP 0
+#define TRI_MADVISE_HUGEPAGE 0
 
 #ifdef __linux__
 
@@ -77,6 +78,12 @@
 #define TRI_MADVISE_DONTDUMP MADV_DONTDUMP
 #endif
 
+#ifdef MADV_HUGEPAGE
+// only present with transparent huge page support
+#undef TRI_MADVISE_HUGEPAGE
+#define TRI_MADVISE_HUGEPAGE MADV_HUGEPAGE
+#endif
+
 #endif
 
 #endif
@@ -78,5 +78,6 @@
 #define TRI_MADVISE_WILLNEED 0
 #define TRI_MADVISE_DONTNEED 0
 #define TRI_MADVISE_DONTDUMP 0
+#define TRI_MADVISE_HUGEPAGE 0
 
 #endif
@@ -120,6 +120,22 @@ void GeoUtils::scanIntervals(QueryParams const& params,
   // sort these disjunct intervals
   std::sort(sortedIntervals.begin(), sortedIntervals.end(), Interval::compare);
 
+  if (params.pointsOnly && sortedIntervals.size() > 1) {
+    // points are only indexed with leaf cells, if there is no leaf between
+    // two intervals we can just scan them as one range
+    size_t last = 0;
+    for (size_t i = 1; i < sortedIntervals.size(); i++) {
+      Interval const& next = sortedIntervals[i];
+      if (sortedIntervals[last].range_max.next() == next.range_min) {
+        sortedIntervals[last].range_max = next.range_max;
+      } else {
+        sortedIntervals[++last] = next;
+      }
+    }
+    sortedIntervals.erase(sortedIntervals.begin() + last + 1,
+                          sortedIntervals.end());
+  }
+
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
   //  constexpr size_t diff = 64;
   for (size_t i = 0; i < sortedIntervals.size() - 1; i++) {
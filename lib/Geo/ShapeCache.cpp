@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ShapeCache.h"
+
+#include <s2/s2region.h>
+
+#include "Basics/ReadLocker.h"
+#include "Basics/WriteLocker.h"
+#include "Geo/GeoJson.h"
+#include "Geo/ShapeContainer.h"
+
+using namespace arangodb;
+using namespace arangodb::geo;
+
+ShapeCache::ShapeCache(size_t minBytes, size_t maxBytes)
+    : _minBytes(minBytes), _maxBytes(maxBytes), _bytes(0) {}
+
+ShapeCache& ShapeCache::instance() {
+  // about 20 bytes per vertex, a delivery zone has a few hundred of them
+  static ShapeCache cache(512, 32 * 1024 * 1024);
+  return cache;
+}
+
+Result ShapeCache::parseRegion(velocypack::Slice const& vpack,
+                               ShapeContainer& region) {
+  if (vpack.byteSize() < _minBytes || vpack.byteSize() > _maxBytes) {
+    return geojson::parseRegion(vpack, region);
+  }
+
+  std::string key(vpack.startAs<char>(), vpack.byteSize());
+  std::shared_ptr<ShapeContainer const> shape;
+  {
+    READ_LOCKER(guard, _lock);
+    auto it = _shapes.find(key);
+    if (it != _shapes.end()) {
+      shape = it->second;
+    }
+  }
+
+  if (shape == nullptr) {
+    auto parsed = std::make_shared<ShapeContainer>();
+    Result res = geojson::parseRegion(vpack, *parsed);
+    if (res.fail()) {
+      return res;  // errors are not cached, they are cheap to find again
+    }
+    shape = parsed;
+
+    WRITE_LOCKER(guard, _lock);
+    if (_shapes.find(key) == _shapes.end()) {
+      while (!_order.empty() && _bytes + key.size() > _maxBytes) {
+        _bytes -= _order.front().size();
+        _shapes.erase(_order.front());
+        _order.pop_front();
+      }
+      _shapes.emplace(key, shape);
+      _bytes += key.size();
+      _order.emplace_back(std::move(key));
+    }
+  }
+
+  // regions are only read by queries, so a cached shape can be cloned by
+  // many threads at once
+  if (!shape->empty()) {
+    region.reset(shape->region()->Clone(), shape->type());
+  }
+  return Result();
+}
+
+size_t ShapeCache::size() const {
+  READ_LOCKER(guard, _lock);
+  return _shapes.size();
+}
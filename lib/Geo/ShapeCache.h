@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_GEO_SHAPE_CACHE_H
+#define ARANGOD_GEO_SHAPE_CACHE_H 1
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <velocypack/Slice.h>
+
+#include "Basics/ReadWriteLock.h"
+#include "Basics/Result.h"
+
+namespace arangodb {
+namespace geo {
+class ShapeContainer;
+
+/// Bounded cache of parsed GeoJSON query shapes, shared by all queries.
+/// Parsing validates every loop and the nesting of polygons, which dominates
+/// the cost of queries with complex polygons; a cached shape is only cloned.
+/// Shapes are keyed by their velocypack, small shapes are not cached and the
+/// oldest shapes are evicted first
+class ShapeCache {
+  ShapeCache(ShapeCache const&) = delete;
+  ShapeCache& operator=(ShapeCache const&) = delete;
+
+ public:
+  /// @brief shapes smaller than minBytes of velocypack are always parsed,
+  /// the cached shapes take up to maxBytes of velocypack
+  ShapeCache(size_t minBytes, size_t maxBytes);
+
+  /// @brief the cache for query shapes
+  static ShapeCache& instance();
+
+  /// @brief like geojson::parseRegion, copies the shape from the cache if
+  /// it was parsed before
+  Result parseRegion(velocypack::Slice const& vpack, ShapeContainer& region);
+
+  /// @brief number of cached shapes
+  size_t size() const;
+
+ private:
+  size_t const _minBytes;
+  size_t const _maxBytes;
+
+  mutable basics::ReadWriteLock _lock;
+  std::unordered_map<std::string, std::shared_ptr<ShapeContainer const>> _shapes;
+  std::deque<std::string> _order;  // keys in insertion order
+  size_t _bytes;                   // sum of the key sizes
+};
+
+}  // namespace geo
+}  // namespace arangodb
+
+#endif
@@ -26,6 +26,7 @@
 
 #include "ApplicationFeatures/ShellColorsFeature.h"
 #include "Basics/MutexLocker.h"
+#include "Basics/ScopeGuard.h"
 #include "Basics/StringUtils.h"
 #include "Logger/LogAppenderFile.h"
 #include "Logger/LogAppenderSyslog.h"
@@ -175,7 +176,7 @@ std::pair<std::shared_ptr<LogAppender>, LogTopic*> LogAppender::buildAppender(
   }
 }
 
-void LogAppender::log(LogMessage* message) {
+void LogAppender::log(LogMessage* message, bool batched) {
   LogLevel level = message->_level;
   size_t topicId = message->_topicId;
   std::string const& m = message->_message;
@@ -183,6 +184,9 @@ void LogAppender::log(LogMessage* message) {
 
   MUTEX_LOCKER(guard, _appendersLock);
 
+  LogAppenderFile::setBatched(batched);
+  TRI_DEFER(LogAppenderFile::setBatched(false));
+
   // output to appender
   auto output = [&level, &m, &offset](size_t n) -> bool {
     auto const& it = _topics2appenders.find(n);
@@ -220,6 +224,12 @@ void LogAppender::log(LogMessage* message) {
   }
 }
 
+void LogAppender::flush() {
+  MUTEX_LOCKER(guard, _appendersLock);
+
+  LogAppenderFile::flushBatch();
+}
+
 void LogAppender::shutdown() {
   MUTEX_LOCKER(guard, _appendersLock);
 
@@ -43,7 +43,12 @@ class LogAppender {
   static std::pair<std::shared_ptr<LogAppender>, LogTopic*> buildAppender(
       std::string const& definition, std::string const& contentFilter);
 
-  static void log(LogMessage*);
+  /// @brief batched messages may be written to the log files later, up to
+  /// the next flush
+  static void log(LogMessage*, bool batched = false);
+
+  /// @brief writes the batched messages
+  static void flush();
 
   static void reopen();
   static void shutdown();
@@ -36,6 +36,9 @@ using namespace arangodb;
 using namespace arangodb::basics;
 
 std::vector<std::tuple<int, std::string, LogAppenderFile*>> LogAppenderFile::_fds = {};
+bool LogAppenderFile::_batched = false;
+std::string LogAppenderFile::_batch;
+int LogAppenderFile::_batchFd = -1;
 
 LogAppenderStream::LogAppenderStream(std::string const& filename,
                                      std::string const& filter, int fd)
@@ -144,10 +147,45 @@ LogAppenderFile::LogAppenderFile(std::string const& filename, std::string const&
 }
 
 void LogAppenderFile::writeLogMessage(LogLevel level, char const* buffer, size_t len) {
+  if (_batched && _fd >= 0 && level != LogLevel::FATAL) {
+    if (_batchFd != _fd || _batch.size() + len > maxBatchSize) {
+      // keep the order of the messages of different files
+      flushBatch();
+    }
+    _batchFd = _fd;
+    _batch.append(buffer, len);
+    return;
+  }
+
+  flushBatch();
+  writeAll(_fd, buffer, len);
+
+  if (level == LogLevel::FATAL) {
+    FILE* f = TRI_FDOPEN(_fd, "a");
+    if (f != nullptr) {
+      // valid file pointer...
+      // now flush the file one last time before we shut down
+      fflush(f);
+    }
+  }
+}
+
+void LogAppenderFile::flushBatch() {
+  if (!_batch.empty()) {
+    writeAll(_batchFd, _batch.data(), _batch.size());
+    _batch.clear();
+    if (_batch.capacity() > maxBatchSize) {
+      _batch.shrink_to_fit();
+    }
+  }
+  _batchFd = -1;
+}
+
+void LogAppenderFile::writeAll(int fd, char const* buffer, size_t len) {
   bool giveUp = false;
 
   while (len > 0) {
-    ssize_t n = TRI_WRITE(_fd, buffer, static_cast<TRI_write_t>(len));
+    ssize_t n = TRI_WRITE(fd, buffer, static_cast<TRI_write_t>(len));
 
     if (n < 0) {
       if (allowStdLogging()) {
@@ -165,15 +203,6 @@ void LogAppenderFile::writeLogMessage(LogLevel level, char const* buffer, size_t
     buffer += n;
     len -= n;
   }
-
-  if (level == LogLevel::FATAL) {
-    FILE* f = TRI_FDOPEN(_fd, "a");
-    if (f != nullptr) {
-      // valid file pointer...
-      // now flush the file one last time before we shut down
-      fflush(f);
-    }
-  }
 }
 
 std::string LogAppenderFile::details() {
@@ -185,6 +214,8 @@ std::string LogAppenderFile::details() {
 }
 
 void LogAppenderFile::reopenAll() {
+  flushBatch();
+
   for (auto& it : _fds) {
     int old = std::get<0>(it);
     std::string const& filename = std::get<1>(it);
@@ -230,6 +261,8 @@ void LogAppenderFile::reopenAll() {
 }
 
 void LogAppenderFile::closeAll() {
+  flushBatch();
+
   for (auto& it : _fds) {
     int fd = std::get<0>(it);
     // set the fd to "disabled"
@@ -88,9 +88,28 @@ class LogAppenderFile : public LogAppenderStream {
   static void setFds(std::vector<std::tuple<int, std::string, LogAppenderFile*>> const& fds) { _fds = fds; }
   static void clear(); 
 
+  /// @brief whether messages are collected and written together, only
+  /// called with the appenders lock held
+  static void setBatched(bool value) { _batched = value; }
+
+  /// @brief writes the collected messages
+  static void flushBatch();
+
+ private:
+  static void writeAll(int fd, char const* buffer, size_t len);
+
+  /// @brief maximum size of the collected messages
+  static constexpr size_t maxBatchSize = 64 * 1024;
+
  private:
   static std::vector<std::tuple<int, std::string, LogAppenderFile*>> _fds;
 
+  /// @brief the collected messages, all for the same file descriptor,
+  /// protected by the appenders lock
+  static bool _batched;
+  static std::string _batch;
+  static int _batchFd;
+
   std::string _filename;
 };
 
@@ -30,6 +30,8 @@ using namespace arangodb;
 
 arangodb::basics::ConditionVariable* LogThread::CONDITION = nullptr;
 boost::lockfree::queue<LogMessage*>* LogThread::MESSAGES = nullptr;
+std::atomic<uint64_t> LogThread::QUEUED(0);
+std::atomic<uint64_t> LogThread::DROPPED(0);
 
 LogThread::LogThread(std::string const& name) : Thread(name), _messages(0) {
   MESSAGES = &_messages;
@@ -45,10 +47,19 @@ LogThread::~LogThread() {
 }
 
 void LogThread::log(std::unique_ptr<LogMessage>& message) {
+  if (message->_level >= LogLevel::DEBUG &&
+      QUEUED.load(std::memory_order_relaxed) >= maxQueuedMessages) {
+    // rather lose diagnostic messages than slow down the server
+    DROPPED.fetch_add(1, std::memory_order_relaxed);
+    message.reset();
+    return;
+  }
+
   if (MESSAGES->push(message.get())) {
     // only release message if adding to the queue succeeded
     // otherwise we would leak here
     message.release();
+    QUEUED.fetch_add(1, std::memory_order_relaxed);
   }
 }
 
@@ -63,6 +74,9 @@ void LogThread::flush() {
     CONDITION_LOCKER(guard, *CONDITION);
     guard.signal();
   }
+
+  // the log thread may still hold some of them
+  LogAppender::flush();
 }
 
 void LogThread::wakeup() {
@@ -79,19 +93,27 @@ void LogThread::run() {
 
   while (!isStopping() && Logger::_active.load()) {
     while (_messages.pop(msg)) {
+      QUEUED.fetch_sub(1, std::memory_order_relaxed);
       try {
-        LogAppender::log(msg);
+        LogAppender::log(msg, true);
       } catch (...) {
       }
 
       delete msg;
     }
 
+    // one write per log file for all messages of this round
+    try {
+      LogAppender::flush();
+    } catch (...) {
+    }
+
     CONDITION_LOCKER(guard, *CONDITION);
     guard.wait(25 * 1000);
   }
 
   while (_messages.pop(msg)) {
+    QUEUED.fetch_sub(1, std::memory_order_relaxed);
     delete msg;
   }
 }
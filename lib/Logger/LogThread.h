@@ -42,6 +42,14 @@ class LogThread final : public Thread {
   // flush all pending log messages
   static void flush();
 
+  // number of debug and trace messages dropped because the log thread
+  // could not keep up
+  static uint64_t droppedMessages() { return DROPPED.load(std::memory_order_relaxed); }
+
+  // maximal number of queued messages before debug and trace messages
+  // are dropped
+  static constexpr uint64_t maxQueuedMessages = 16384;
+
  public:
   explicit LogThread(std::string const& name);
   ~LogThread();
@@ -59,6 +67,8 @@ class LogThread final : public Thread {
  private:
   static arangodb::basics::ConditionVariable* CONDITION;
   static boost::lockfree::queue<LogMessage*>* MESSAGES;
+  static std::atomic<uint64_t> QUEUED;
+  static std::atomic<uint64_t> DROPPED;
 
   arangodb::basics::ConditionVariable _condition;
   boost::lockfree::queue<LogMessage*> _messages;
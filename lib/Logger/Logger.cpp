@@ -301,7 +301,10 @@ void Logger::log(char const* function, char const* file, int line,
     return;
   }
 
-  std::stringstream out;
+  // the prefix is short, so the message is formatted into one string
+  // without going through a stream
+  std::string out;
+  out.reserve(128 + message.size());
   char buf[64];
 
   // time prefix
@@ -321,18 +324,20 @@ void Logger::log(char const* function, char const* file, int line,
       strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%S ", &tb);
     }
   }
-  out << buf;
+  out.append(buf);
 
   // output prefix
   if (!_outputPrefix.empty()) {
-    out << _outputPrefix << ' ';
+    out.append(_outputPrefix).push_back(' ');
   }
 
   // append the process / thread identifier
-  out << '[' << Thread::currentProcessId();
+  out.push_back('[');
+  out.append(std::to_string(Thread::currentProcessId()));
 
   if (_showThreadIdentifier) {
-    out << '-' << Thread::currentThreadNumber();
+    out.push_back('-');
+    out.append(std::to_string(Thread::currentThreadNumber()));
   }
 
   // log thread name
@@ -342,17 +347,19 @@ void Logger::log(char const* function, char const* file, int line,
       threadName = "main";
     }
    
-    out << '-' << threadName;
+    out.push_back('-');
+    out.append(threadName);
   }
 
-  out << "] ";
+  out.append("] ");
   
   if (_showRole && _role != '\0') {
-    out << _role << ' ';
+    out.push_back(_role);
+    out.push_back(' ');
   }
 
   // log level
-  out << Logger::translateLogLevel(level) << ' ';
+  out.append(Logger::translateLogLevel(level)).push_back(' ');
 
   // check if we must display the line number
   if (_showLineNumber && file != nullptr && function != nullptr) {
@@ -365,14 +372,16 @@ void Logger::log(char const* function, char const* file, int line,
         filename = shortened + 1;
       }
     }
-    out << '[' << function << "@" << filename << ':' << line << "] ";
+    out.push_back('[');
+    out.append(function).push_back('@');
+    out.append(filename).push_back(':');
+    out.append(std::to_string(line)).append("] ");
   }
 
   // generate the complete message
-  out << message;
-  std::string ostreamContent = out.str();
-  size_t offset = ostreamContent.size() - message.size();
-  auto msg = std::make_unique<LogMessage>(level, topicId, std::move(ostreamContent), offset);
+  size_t offset = out.size();
+  out.append(message);
+  auto msg = std::make_unique<LogMessage>(level, topicId, std::move(out), offset);
 
   // now either queue or output the message
   if (_threaded) {
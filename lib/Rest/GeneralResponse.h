@@ -155,6 +155,17 @@ class GeneralResponse {
                   bool resolveExternals = true) = 0;
   
   virtual int reservePayload(std::size_t size) { return TRI_ERROR_NO_ERROR; }
+
+  /// @brief number of bytes the payload takes in memory
+  virtual size_t payloadMemoryUsage() const { return 0; }
+
+  /// @brief writes the payload to a file and frees its memory, for responses
+  /// that are kept for a while. throws if the file cannot be written
+  virtual void spillPayload(std::string const& filename) {}
+
+  /// @brief reads back the payload written by spillPayload. throws if the
+  /// file cannot be read
+  virtual void restorePayload(std::string const& filename) {}
   
   /// used for head
   bool generateBody() const { return _generateBody; };
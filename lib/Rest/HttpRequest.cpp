@@ -44,6 +44,7 @@ HttpRequest::HttpRequest(ConnectionInfo const& connectionInfo,
                          char const* header, size_t length,
                          bool allowMethodOverride)
     : GeneralRequest(connectionInfo),
+      _messageId(1),
       _contentLength(0),
       _header(nullptr),
       _allowMethodOverride(allowMethodOverride),
@@ -63,6 +64,7 @@ HttpRequest::HttpRequest(
     ContentType contentType, char const* body, int64_t contentLength,
     std::unordered_map<std::string, std::string> const& headers)
     : GeneralRequest(ConnectionInfo()),
+      _messageId(1),
       _contentLength(contentLength),
       _header(nullptr),
       _body(body, contentLength),
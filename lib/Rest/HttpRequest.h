@@ -33,6 +33,7 @@ class RestBatchHandler;
 
 namespace rest {
 class GeneralCommTask;
+class H2CommTask;
 class HttpCommTask;
 }
 
@@ -42,6 +43,7 @@ struct Options;
 }
 
 class HttpRequest final : public GeneralRequest {
+  friend class rest::H2CommTask;
   friend class rest::HttpCommTask;
   friend class rest::GeneralCommTask;
   friend class RestBatchHandler;  // TODO must be removed
@@ -67,6 +69,10 @@ class HttpRequest final : public GeneralRequest {
   // HTTP protocol version is 1.1
   bool isHttp11() const { return _version == ProtocolVersion::HTTP_1_1; }
 
+  // the HTTP/2 stream of the request, 1 for HTTP/1.x
+  uint64_t messageId() const override { return _messageId; }
+  void setMessageId(uint64_t messageId) { _messageId = messageId; }
+
  public:
   arangodb::Endpoint::TransportType transportType() override {
     return arangodb::Endpoint::TransportType::HTTP;
@@ -135,6 +141,7 @@ class HttpRequest final : public GeneralRequest {
 
  private:
   std::unordered_map<std::string, std::string> _cookies;
+  uint64_t _messageId;
   int64_t _contentLength;
   std::unique_ptr<char[]> _header;
   std::string _body;
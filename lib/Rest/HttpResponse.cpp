@@ -30,6 +30,7 @@
 #include <velocypack/velocypack-aliases.h>
 
 #include "Basics/Exceptions.h"
+#include "Basics/FileUtils.h"
 #include "Basics/StringBuffer.h"
 #include "Basics/StringUtils.h"
 #include "Basics/VPackStringBufferAdapter.h"
@@ -51,6 +52,7 @@ HttpResponse::HttpResponse(ResponseCode code,
                            basics::StringBuffer* buffer)
     : GeneralResponse(code),
       _isHeadResponse(false),
+      _messageId(1),
       _body(buffer),
       _bodySize(0) {
   TRI_ASSERT(buffer);
@@ -150,6 +152,35 @@ size_t HttpResponse::bodySize() const {
   return _body->length();
 }
 
+size_t HttpResponse::payloadMemoryUsage() const {
+  return _body == nullptr ? 0 : _body->length();
+}
+
+void HttpResponse::spillPayload(std::string const& filename) {
+  TRI_ASSERT(_body != nullptr);
+  FileUtils::spit(filename, *_body);
+
+  // a cleared buffer would keep its memory
+  std::unique_ptr<StringBuffer> empty(new StringBuffer(false));
+  delete _body;
+  _body = empty.release();
+}
+
+void HttpResponse::restorePayload(std::string const& filename) {
+  TRI_ASSERT(_body != nullptr);
+  FileUtils::slurp(filename, *_body);
+}
+
+int HttpResponse::deflate(size_t bufferSize) {
+  TRI_ASSERT(_body != nullptr);
+  int res = _body->deflate(bufferSize);
+
+  if (res == TRI_ERROR_NO_ERROR) {
+    setHeaderNC(StaticStrings::ContentEncoding, "deflate");
+  }
+  return res;
+}
+
 void HttpResponse::writeHeader(StringBuffer* output) {
   output->appendText(TRI_CHAR_LENGTH_PAIR("HTTP/1.1 "));
   output->appendText(responseString(_responseCode));
@@ -33,11 +33,13 @@ namespace arangodb {
 class RestBatchHandler;
 
 namespace rest {
+class H2CommTask;
 class HttpCommTask;
 class GeneralCommTask;
 }
 
 class HttpResponse : public GeneralResponse {
+  friend class rest::H2CommTask;
   friend class rest::HttpCommTask;
   friend class rest::GeneralCommTask;
   friend class RestBatchHandler;  // TODO must be removed
@@ -55,6 +57,10 @@ class HttpResponse : public GeneralResponse {
   
   bool isHeadResponse() const { return _isHeadResponse; }
 
+  // the HTTP/2 stream of the response, 1 for HTTP/1.x
+  uint64_t messageId() const override { return _messageId; }
+  void setMessageId(uint64_t messageId) { _messageId = messageId; }
+
  public:
   void setCookie(std::string const& name, std::string const& value,
                  int lifeTimeSeconds, std::string const& path,
@@ -95,15 +101,19 @@ class HttpResponse : public GeneralResponse {
   }
   
   int reservePayload(std::size_t size) override { return _body->reserve(size); }
+
+  size_t payloadMemoryUsage() const override;
+  void spillPayload(std::string const& filename) override;
+  void restorePayload(std::string const& filename) override;
   
   arangodb::Endpoint::TransportType transportType() override {
     return arangodb::Endpoint::TransportType::HTTP;
   }
 
- private:
   // the body must already be set. deflate is then run on the existing body
   int deflate(size_t = 16384);
 
+ private:
   std::unique_ptr<basics::StringBuffer> stealBody() {
     std::unique_ptr<basics::StringBuffer> bb(_body);
     _body = nullptr;
@@ -112,6 +122,7 @@ class HttpResponse : public GeneralResponse {
   
  private:
   bool _isHeadResponse;
+  uint64_t _messageId;
   std::vector<std::string> _cookies;
   basics::StringBuffer *_body;
   size_t _bodySize;
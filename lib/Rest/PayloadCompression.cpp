@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "PayloadCompression.h"
+
+#include "Basics/StringUtils.h"
+
+#include <snappy.h>
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <chrono>
+
+using namespace arangodb;
+using namespace arangodb::rest;
+
+namespace {
+std::atomic<uint64_t> compressedBodies(0);
+std::atomic<uint64_t> compressedBytesIn(0);
+std::atomic<uint64_t> compressedBytesOut(0);
+std::atomic<uint64_t> compressTime(0);  // microseconds
+std::atomic<uint64_t> uncompressedBodies(0);
+std::atomic<uint64_t> uncompressTime(0);  // microseconds
+
+uint64_t elapsed(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+}  // namespace
+
+std::string const PayloadCompression::ENCODING("snappy");
+uint64_t PayloadCompression::THRESHOLD = 0;
+
+bool PayloadCompression::accepted(std::string const& acceptEncoding) {
+  for (auto const& it : basics::StringUtils::split(acceptEncoding, ',')) {
+    // ignore a quality value, we do not offer any other coding
+    std::string coding = basics::StringUtils::trim(it.substr(0, it.find(';')));
+    if (basics::StringUtils::tolower(coding) == ENCODING) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool PayloadCompression::compress(char const* data, size_t length,
+                                  std::string& out) {
+  out.clear();
+  if (THRESHOLD == 0 || length < THRESHOLD) {
+    return false;
+  }
+
+  auto const start = std::chrono::steady_clock::now();
+  out.resize(snappy::MaxCompressedLength(length));
+  size_t compressedLength = 0;
+  snappy::RawCompress(data, length, &out[0], &compressedLength);
+  compressTime.fetch_add(elapsed(start), std::memory_order_relaxed);
+
+  if (compressedLength >= length) {
+    out.clear();
+    return false;
+  }
+  out.resize(compressedLength);
+
+  compressedBodies.fetch_add(1, std::memory_order_relaxed);
+  compressedBytesIn.fetch_add(length, std::memory_order_relaxed);
+  compressedBytesOut.fetch_add(compressedLength, std::memory_order_relaxed);
+  return true;
+}
+
+bool PayloadCompression::uncompress(char const* data, size_t length,
+                                    std::string& out) {
+  auto const start = std::chrono::steady_clock::now();
+  out.clear();
+  if (!snappy::Uncompress(data, length, &out)) {
+    out.clear();
+    return false;
+  }
+  uncompressTime.fetch_add(elapsed(start), std::memory_order_relaxed);
+  uncompressedBodies.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void PayloadCompression::toVelocyPack(VPackBuilder& builder) {
+  uint64_t const bytesIn = compressedBytesIn.load(std::memory_order_relaxed);
+  uint64_t const bytesOut = compressedBytesOut.load(std::memory_order_relaxed);
+
+  builder.openObject();
+  builder.add("encoding", VPackValue(ENCODING));
+  builder.add("threshold", VPackValue(THRESHOLD));
+  builder.add("compressed",
+              VPackValue(compressedBodies.load(std::memory_order_relaxed)));
+  builder.add("bytesIn", VPackValue(bytesIn));
+  builder.add("bytesOut", VPackValue(bytesOut));
+  builder.add("bytesSaved",
+              VPackValue(bytesIn > bytesOut ? bytesIn - bytesOut : 0));
+  builder.add("compressTime",
+              VPackValue(compressTime.load(std::memory_order_relaxed) / 1e6));
+  builder.add("uncompressed",
+              VPackValue(uncompressedBodies.load(std::memory_order_relaxed)));
+  builder.add("uncompressTime",
+              VPackValue(uncompressTime.load(std::memory_order_relaxed) / 1e6));
+  builder.close();
+}
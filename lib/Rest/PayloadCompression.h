@@ -0,0 +1,68 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_REST_PAYLOAD_COMPRESSION_H
+#define ARANGODB_REST_PAYLOAD_COMPRESSION_H 1
+
+#include "Basics/Common.h"
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+}
+
+namespace rest {
+
+/// @brief snappy compression of the HTTP bodies exchanged between the
+/// servers of a cluster. it is negotiated with the usual headers: a client
+/// sends "accept-encoding: snappy", and a server which supports it answers
+/// with "accept-encoding: snappy" (RFC 7694) and compresses the bodies of
+/// large responses, setting "content-encoding: snappy". request bodies are
+/// only compressed for servers which have answered this way
+class PayloadCompression {
+ public:
+  /// @brief the content coding
+  static std::string const ENCODING;
+
+  /// @brief bodies of at least this size are compressed, 0 disables the
+  /// compression
+  static uint64_t THRESHOLD;
+
+ public:
+  static bool enabled() { return THRESHOLD > 0; }
+
+  /// @brief whether an accept-encoding header value contains our coding
+  static bool accepted(std::string const& acceptEncoding);
+
+  /// @brief compresses a body of at least THRESHOLD bytes. returns false,
+  /// leaving out empty, if the body is smaller or does not get smaller
+  static bool compress(char const* data, size_t length, std::string& out);
+
+  /// @brief returns false if the data is not a valid compressed body
+  static bool uncompress(char const* data, size_t length, std::string& out);
+
+  /// @brief the counters of compressed and uncompressed bodies
+  static void toVelocyPack(velocypack::Builder&);
+};
+
+}  // namespace rest
+}  // namespace arangodb
+
+#endif
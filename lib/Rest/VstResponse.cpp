@@ -30,6 +30,7 @@
 #include <velocypack/velocypack-aliases.h>
 
 #include "Basics/Exceptions.h"
+#include "Basics/FileUtils.h"
 #include "Basics/StringBuffer.h"
 #include "Basics/StringUtils.h"
 #include "Basics/VPackStringBufferAdapter.h"
@@ -107,6 +108,52 @@ void VstResponse::addPayload(VPackBuffer<uint8_t>&& buffer,
   _vpackPayloads.push_back(std::move(buffer));
 }
 
+size_t VstResponse::payloadMemoryUsage() const {
+  size_t usage = 0;
+  for (auto const& buffer : _vpackPayloads) {
+    usage += buffer.size();
+  }
+  return usage;
+}
+
+void VstResponse::spillPayload(std::string const& filename) {
+  // every payload is prefixed with its length
+  StringBuffer out(false);
+  for (auto const& buffer : _vpackPayloads) {
+    uint64_t const length = buffer.size();
+    out.appendText(reinterpret_cast<char const*>(&length), sizeof(length));
+    out.appendText(reinterpret_cast<char const*>(buffer.data()), buffer.size());
+  }
+  FileUtils::spit(filename, out);
+
+  std::vector<VPackBuffer<uint8_t>>().swap(_vpackPayloads);
+}
+
+void VstResponse::restorePayload(std::string const& filename) {
+  std::string const in = FileUtils::slurp(filename);
+
+  std::vector<VPackBuffer<uint8_t>> payloads;
+  size_t pos = 0;
+  while (pos < in.size()) {
+    uint64_t length;
+    if (in.size() - pos < sizeof(length)) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_READ_FILE,
+                                     "unexpected end of file '" + filename + "'");
+    }
+    memcpy(&length, in.data() + pos, sizeof(length));
+    pos += sizeof(length);
+    if (in.size() - pos < length) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_READ_FILE,
+                                     "unexpected end of file '" + filename + "'");
+    }
+    payloads.emplace_back();
+    payloads.back().append(reinterpret_cast<uint8_t const*>(in.data() + pos),
+                           static_cast<VPackValueLength>(length));
+    pos += length;
+  }
+  _vpackPayloads = std::move(payloads);
+}
+
 VPackMessageNoOwnBuffer VstResponse::prepareForNetwork() {
   // initialize builder with vpackbuffer. then we do not need to
   // steal the header and can avoid the shared pointer
@@ -64,6 +64,10 @@ class VstResponse : public GeneralResponse {
                   arangodb::velocypack::Options const* = nullptr,
                   bool resolveExternals = true) override;
 
+  size_t payloadMemoryUsage() const override;
+  void spillPayload(std::string const& filename) override;
+  void restorePayload(std::string const& filename) override;
+
  private:
   //_responseCode   - from Base
   //_headers        - from Base
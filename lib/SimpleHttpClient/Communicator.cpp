@@ -24,9 +24,14 @@
 #include "Communicator.h"
 
 #include "Basics/MutexLocker.h"
+#include "Basics/StaticStrings.h"
 #include "Basics/socket-utils.h"
 #include "Logger/Logger.h"
 #include "Rest/HttpRequest.h"
+#include "Rest/PayloadCompression.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
 
 using namespace arangodb;
 using namespace arangodb::basics;
@@ -129,11 +134,31 @@ static std::string buildPrefix(Ticket ticketId) {
   return std::string("Communicator(") + std::to_string(ticketId) + ") // ";
 }
 
+// scheme, host and port of a url
+static std::string hostOf(std::string const& url) {
+  size_t pos = url.find("://");
+  pos = (pos == std::string::npos) ? 0 : pos + 3;
+  return url.substr(0, url.find('/', pos));
+}
+
 static std::atomic_uint_fast64_t NEXT_TICKET_ID(static_cast<uint64_t>(1));
 static std::vector<char> urlDotSeparators{'/', '#', '?'};
 } // namespace
 
-Communicator::Communicator() : _curl(nullptr), _mc(CURLM_OK), _enabled(true) {
+Communicator::Communicator()
+    : _curl(nullptr),
+      _mc(CURLM_OK),
+      _enabled(true),
+      _multiplexing(false),
+      _maxConnectionsPerHost(0),
+      _requests(0),
+      _inFlight(0),
+      _connectionsOpened(0),
+      _connectionsReused(0),
+      _multiplexedRequests(0),
+      _waitTimeCount(0),
+      _waitTimeSum(0),
+      _waitTimeMax(0) {
   curl_global_init(CURL_GLOBAL_ALL);
   _curl = curl_multi_init();
 
@@ -172,7 +197,7 @@ Communicator::~Communicator() {
 Ticket Communicator::addRequest(Destination&& destination,
                                 std::unique_ptr<GeneralRequest> request,
                                 Callbacks callbacks, Options options) {
-  uint64_t id = NEXT_TICKET_ID.fetch_add(1, std::memory_order_seq_cst);
+  uint64_t id = nextTicketId();
   TRI_ASSERT(request != nullptr);
   
   {
@@ -197,6 +222,10 @@ Ticket Communicator::addRequest(Destination&& destination,
   return Ticket{id};
 }
 
+Ticket Communicator::nextTicketId() {
+  return NEXT_TICKET_ID.fetch_add(1, std::memory_order_seq_cst);
+}
+
 int Communicator::work_once() {
   std::vector<NewRequest> newRequests;
 
@@ -253,6 +282,56 @@ void Communicator::wait() {
 #endif
 }
 
+void Communicator::setMultiplexing(bool value) {
+  if (value) {
+    curl_version_info_data* info = curl_version_info(CURLVERSION_NOW);
+    if ((info->features & CURL_VERSION_HTTP2) == 0) {
+      LOG_TOPIC(WARN, Logger::COMMUNICATION)
+          << "libcurl " << info->version << " was built without HTTP/2 "
+          << "support, cluster requests cannot be multiplexed";
+      value = false;
+    }
+  }
+
+  _multiplexing = value;
+  curl_multi_setopt(_curl, CURLMOPT_PIPELINING,
+                    value ? CURLPIPE_MULTIPLEX : CURLPIPE_NOTHING);
+}
+
+void Communicator::setMaxConnectionsPerHost(size_t value) {
+  _maxConnectionsPerHost = value;
+  curl_multi_setopt(_curl, CURLMOPT_MAX_HOST_CONNECTIONS,
+                    static_cast<long>(value));
+}
+
+void Communicator::toVelocyPack(VPackBuilder& builder) const {
+  builder.openObject();
+  builder.add("multiplexing", VPackValue(_multiplexing));
+  builder.add("maxConnectionsPerHost", VPackValue(_maxConnectionsPerHost));
+  builder.add("requests",
+              VPackValue(_requests.load(std::memory_order_relaxed)));
+  builder.add("inFlight",
+              VPackValue(_inFlight.load(std::memory_order_relaxed)));
+  builder.add("connectionsOpened",
+              VPackValue(_connectionsOpened.load(std::memory_order_relaxed)));
+  builder.add("connectionsReused",
+              VPackValue(_connectionsReused.load(std::memory_order_relaxed)));
+  builder.add("multiplexedRequests",
+              VPackValue(_multiplexedRequests.load(std::memory_order_relaxed)));
+
+  builder.add(VPackValue("waitTime"));
+  builder.openObject();
+  builder.add("count",
+              VPackValue(_waitTimeCount.load(std::memory_order_relaxed)));
+  builder.add("sum", VPackValue(
+                         _waitTimeSum.load(std::memory_order_relaxed) / 1e6));
+  builder.add("max", VPackValue(
+                         _waitTimeMax.load(std::memory_order_relaxed) / 1e6));
+  builder.close();
+
+  builder.close();
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   private methods
 // -----------------------------------------------------------------------------
@@ -276,9 +355,33 @@ void Communicator::createRequestInProgress(NewRequest&& newRequest) {
 
   CURL* handle = handleInProgress->_handle;
   struct curl_slist* requestHeaders = nullptr;
+
+  if (rest::PayloadCompression::enabled()) {
+    bool found;
+    request->header(StaticStrings::AcceptEncoding, found);
+    if (!found) {
+      std::string const accept =
+          "Accept-Encoding: " + rest::PayloadCompression::ENCODING;
+      requestHeaders = curl_slist_append(requestHeaders, accept.c_str());
+    }
+  }
+
   if (request->body().length() > 0) {
-    curl_easy_setopt(handle, CURLOPT_POSTFIELDS, request->body().data());
-    curl_easy_setopt(handle, CURLOPT_POSTFIELDSIZE, request->body().length());
+    std::string& compressed = handleInProgress->_rip->_compressedBody;
+    if (rest::PayloadCompression::enabled() &&
+        _compressingHosts.find(::hostOf(newRequest._destination.url())) !=
+            _compressingHosts.end() &&
+        rest::PayloadCompression::compress(request->body().data(),
+                                     request->body().length(), compressed)) {
+      curl_easy_setopt(handle, CURLOPT_POSTFIELDS, compressed.data());
+      curl_easy_setopt(handle, CURLOPT_POSTFIELDSIZE, compressed.size());
+      std::string const encoding =
+          "Content-Encoding: " + rest::PayloadCompression::ENCODING;
+      requestHeaders = curl_slist_append(requestHeaders, encoding.c_str());
+    } else {
+      curl_easy_setopt(handle, CURLOPT_POSTFIELDS, request->body().data());
+      curl_easy_setopt(handle, CURLOPT_POSTFIELDSIZE, request->body().length());
+    }
 
     switch (request->contentType()) {
       case ContentType::UNSET:
@@ -326,6 +429,15 @@ void Communicator::createRequestInProgress(NewRequest&& newRequest) {
   curl_easy_setopt(handle, CURLOPT_URL, url.c_str());
   curl_easy_setopt(handle, CURLOPT_PROXY, "");
 
+  if (_multiplexing && url.compare(0, 7, "http://") == 0) {
+    // our servers accept HTTP/2 on http endpoints without an upgrade
+    curl_easy_setopt(handle, CURLOPT_HTTP_VERSION,
+                     CURL_HTTP_VERSION_2_PRIOR_KNOWLEDGE);
+    // wait for a connection which is being opened to the same server
+    // instead of opening another one
+    curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+  }
+
   // the xfer/progress options are only used to handle request abortions
   curl_easy_setopt(handle, CURLOPT_NOPROGRESS, 0L);
   curl_easy_setopt(handle, CURLOPT_XFERINFOFUNCTION, Communicator::curlProgress);
@@ -412,9 +524,47 @@ void Communicator::createRequestInProgress(NewRequest&& newRequest) {
     auto result = _handlesInProgress.emplace(newRequest._ticketId, std::move(handleInProgress));
     TRI_ASSERT(result.second);
   }
+  _requests.fetch_add(1, std::memory_order_relaxed);
+  _inFlight.fetch_add(1, std::memory_order_relaxed);
   curl_multi_add_handle(_curl, handle);
 }
 
+void Communicator::updateStatistics(CURL* handle) {
+  _inFlight.fetch_sub(1, std::memory_order_relaxed);
+
+  // the time until the transfer started includes waiting for a free
+  // connection of the server as well as opening a new one
+  double pretransferTime = 0.0;
+  curl_easy_getinfo(handle, CURLINFO_PRETRANSFER_TIME, &pretransferTime);
+  if (pretransferTime <= 0.0) {
+    // the request was never sent
+    return;
+  }
+
+  long numConnects = 0;
+  curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &numConnects);
+  if (numConnects > 0) {
+    _connectionsOpened.fetch_add(numConnects, std::memory_order_relaxed);
+  } else {
+    _connectionsReused.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  long httpVersion = 0;
+  curl_easy_getinfo(handle, CURLINFO_HTTP_VERSION, &httpVersion);
+  if (httpVersion == CURL_HTTP_VERSION_2_0) {
+    _multiplexedRequests.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  uint64_t const waitTime = static_cast<uint64_t>(pretransferTime * 1e6);
+  _waitTimeCount.fetch_add(1, std::memory_order_relaxed);
+  _waitTimeSum.fetch_add(waitTime, std::memory_order_relaxed);
+  uint64_t max = _waitTimeMax.load(std::memory_order_relaxed);
+  while (waitTime > max &&
+         !_waitTimeMax.compare_exchange_weak(max, waitTime,
+                                             std::memory_order_relaxed)) {
+  }
+}
+
 void Communicator::handleResult(CURL* handle, CURLcode rc) {
   // remove request in progress
   double connectTime = 0.0;
@@ -426,6 +576,8 @@ void Communicator::handleResult(CURL* handle, CURLcode rc) {
     return;
   }
 
+  updateStatistics(handle);
+
   if (rip->_options._curlRcFn) {
     (*rip->_options._curlRcFn)(rc);
   }
@@ -451,6 +603,14 @@ void Communicator::handleResult(CURL* handle, CURLcode rc) {
       long httpStatusCode = 200;
       curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &httpStatusCode);
 
+      if (!uncompressResponse(rip)) {
+        LOG_TOPIC(ERR, Logger::COMMUNICATION)
+            << ::buildPrefix(rip->_ticketId) << "invalid compressed response from "
+            << rip->_destination.url();
+        callErrorFn(rip, TRI_ERROR_INTERNAL, {nullptr});
+        break;
+      }
+
       std::unique_ptr<GeneralResponse> response(
           new HttpResponse(static_cast<ResponseCode>(httpStatusCode)));
 
@@ -502,6 +662,36 @@ void Communicator::handleResult(CURL* handle, CURLcode rc) {
   _handlesInProgress.erase(rip->_ticketId);
 }
 
+// handles the compression headers of a response. they are not passed on,
+// so that a response cannot be forwarded with a wrong encoding
+bool Communicator::uncompressResponse(RequestInProgress* rip) {
+  auto& headers = rip->_responseHeaders;
+
+  auto it = headers.find(StaticStrings::AcceptEncoding);
+  if (it != headers.end()) {
+    if (rest::PayloadCompression::accepted(it->second)) {
+      _compressingHosts.emplace(::hostOf(rip->_destination.url()));
+    }
+    headers.erase(it);
+  }
+
+  it = headers.find(StaticStrings::ContentEncoding);
+  if (it == headers.end() || it->second != rest::PayloadCompression::ENCODING) {
+    return true;
+  }
+  headers.erase(it);
+
+  std::string uncompressed;
+  if (!rest::PayloadCompression::uncompress(rip->_responseBody->c_str(),
+                                      rip->_responseBody->length(),
+                                      uncompressed)) {
+    return false;
+  }
+  rip->_responseBody->clear();
+  rip->_responseBody->appendText(uncompressed);
+  return true;
+}
+
 void Communicator::transformResult(CURL* handle,
                                    HeadersInProgress&& responseHeaders,
                                    std::unique_ptr<StringBuffer> responseBody,
@@ -35,7 +35,13 @@
 #include "SimpleHttpClient/Destination.h"
 #include "SimpleHttpClient/Options.h"
 
+#include <unordered_set>
+
 namespace arangodb {
+namespace velocypack {
+class Builder;
+}
+
 namespace communicator {
 typedef std::unordered_map<std::string, std::string> HeadersInProgress;
 typedef uint64_t Ticket;
@@ -75,6 +81,8 @@ struct RequestInProgress {
   double _startTime;
   std::unique_ptr<basics::StringBuffer> _responseBody;
   Options _options;
+  // the request body if it is sent compressed
+  std::string _compressedBody;
 
   char _errorBuffer[CURL_ERROR_SIZE];
   bool _aborted;
@@ -122,6 +130,9 @@ class Communicator {
   Ticket addRequest(Destination&&, std::unique_ptr<GeneralRequest>, Callbacks,
                     Options);
 
+  /// @brief a ticket id which is unique among the ids of all requests
+  static Ticket nextTicketId();
+
   int work_once();
   void wait();
   void abortRequest(Ticket ticketId);
@@ -129,6 +140,21 @@ class Communicator {
   void disable() { _enabled = false; };
   void enable()  { _enabled = true; };
 
+  /// @brief send requests to http endpoints with HTTP/2 (prior knowledge),
+  /// so that the requests to one server share a multiplexed connection.
+  /// this has no effect if libcurl was built without HTTP/2 support.
+  /// must be called before the first request is added
+  void setMultiplexing(bool);
+
+  /// @brief limit the number of connections per server, 0 means no limit.
+  /// further requests to the server wait until a connection (or, with
+  /// multiplexing, a stream of a connection) becomes free
+  void setMaxConnectionsPerHost(size_t);
+
+  bool multiplexing() const { return _multiplexing; }
+
+  /// @brief connection pool and request counters
+  void toVelocyPack(velocypack::Builder&) const;
 
  private:
   struct NewRequest {
@@ -157,12 +183,31 @@ class Communicator {
   int _fds[2];
 #endif
   bool _enabled;
+  // servers which have announced that they accept compressed request
+  // bodies. only used by the thread running the curl loop
+  std::unordered_set<std::string> _compressingHosts;
+  bool _multiplexing;
+  size_t _maxConnectionsPerHost;
+
+  // counters, updated by the thread running the curl loop
+  std::atomic<uint64_t> _requests;
+  std::atomic<uint64_t> _inFlight;
+  std::atomic<uint64_t> _connectionsOpened;
+  std::atomic<uint64_t> _connectionsReused;
+  std::atomic<uint64_t> _multiplexedRequests;
+  // time until a request could be sent, waiting for and opening its
+  // connection, in microseconds
+  std::atomic<uint64_t> _waitTimeCount;
+  std::atomic<uint64_t> _waitTimeSum;
+  std::atomic<uint64_t> _waitTimeMax;
 
  private:
   void abortRequestInternal(Ticket ticketId);
   std::vector<RequestInProgress const*> requestsInProgress();
   void createRequestInProgress(NewRequest&& newRequest);
   void handleResult(CURL*, CURLcode);
+  void updateStatistics(CURL*);
+  bool uncompressResponse(RequestInProgress*);
   void transformResult(CURL*, HeadersInProgress&&,
                        std::unique_ptr<basics::StringBuffer>, HttpResponse*);
   /// @brief curl will strip standalone ".". ArangoDB allows using . as a key
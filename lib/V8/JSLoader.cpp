@@ -60,7 +60,8 @@ v8::Handle<v8::Value> JSLoader::executeGlobalScript(
 
   result = TRI_ExecuteJavaScriptString(isolate, context,
                                        TRI_V8_STD_STRING(isolate, i->second),
-                                       TRI_V8_STD_STRING(isolate, name), false);
+                                       TRI_V8_STD_STRING(isolate, name), false,
+                                       true);
 
   if (tryCatch.HasCaught()) {
     if (tryCatch.CanContinue()) {
@@ -103,7 +104,8 @@ JSLoader::eState JSLoader::loadScript(v8::Isolate* isolate,
 
   v8::Handle<v8::Value> result =
     TRI_ExecuteJavaScriptString(isolate, context, TRI_V8_STD_STRING(isolate, i->second),
-                                TRI_V8_STD_STRING(isolate, name), false);
+                                TRI_V8_STD_STRING(isolate, name), false,
+                                true);
 
   if (tryCatch.HasCaught()) {
     if (tryCatch.CanContinue()) {
@@ -40,11 +40,13 @@
 #include "ApplicationFeatures/HttpEndpointProvider.h"
 #include "Basics/Exceptions.h"
 #include "Basics/FileUtils.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/Nonce.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/StringBuffer.h"
 #include "Basics/StringUtils.h"
 #include "Basics/Utf8Helper.h"
+#include "Basics/fasthash.h"
 #include "Basics/files.h"
 #include "Basics/process-utils.h"
 #include "Basics/terminal-utils.h"
@@ -1055,7 +1057,13 @@ static void JS_Execute(v8::FunctionCallbackInfo<v8::Value> const& args) {
   {
     v8::TryCatch tryCatch;
 
-    script = v8::Script::Compile(source->ToString(), filename->ToString());
+    // modules are loaded the same way in every context
+    if (filename->IsString()) {
+      script = TRI_CompileJavaScriptCached(isolate, source->ToString(),
+                                           filename->ToString());
+    } else {
+      script = v8::Script::Compile(source->ToString(), filename->ToString());
+    }
 
     // compilation failed, print errors that happened during compilation
     if (script.IsEmpty()) {
@@ -4358,11 +4366,13 @@ bool TRI_ParseJavaScriptFile(v8::Isolate* isolate, char const* filename,
 v8::Handle<v8::Value> TRI_ExecuteJavaScriptString(
     v8::Isolate* isolate, v8::Handle<v8::Context> context,
     v8::Handle<v8::String> const source, v8::Handle<v8::String> const name,
-    bool printResult) {
+    bool printResult, bool useCodeCache) {
   v8::EscapableHandleScope scope(isolate);
 
   v8::Handle<v8::Value> result;
-  v8::Handle<v8::Script> script = v8::Script::Compile(source, name);
+  v8::Handle<v8::Script> script =
+      useCodeCache ? TRI_CompileJavaScriptCached(isolate, source, name)
+                   : v8::Script::Compile(source, name);
 
   // compilation failed, print errors that happened during compilation
   if (script.IsEmpty()) {
@@ -4407,6 +4417,97 @@ v8::Handle<v8::Value> TRI_ExecuteJavaScriptString(
   return scope.Escape<v8::Value>(result);
 }
 
+namespace {
+
+/// @brief code cache of a script, shared by all contexts of the process
+struct CodeCacheEntry {
+  // hash of the source, changed files are compiled again
+  uint64_t hash;
+  std::shared_ptr<std::string const> data;
+};
+
+arangodb::Mutex CodeCacheLock;
+std::unordered_map<std::string, CodeCacheEntry> CodeCache;
+
+/// @brief bounds the cache, in case scripts are created under ever new names
+size_t const MaxCodeCacheEntries = 4096;
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compiles a script in the current context, using the code cache
+////////////////////////////////////////////////////////////////////////////////
+
+v8::Handle<v8::Script> TRI_CompileJavaScriptCached(
+    v8::Isolate* isolate, v8::Handle<v8::String> const source,
+    v8::Handle<v8::String> const name) {
+  v8::EscapableHandleScope scope(isolate);
+
+  v8::String::Utf8Value utf8Name(name);
+  v8::String::Utf8Value utf8Source(source);
+
+  if (*utf8Name == nullptr || *utf8Source == nullptr) {
+    return scope.Escape<v8::Script>(v8::Script::Compile(source, name));
+  }
+
+  std::string const key(*utf8Name, utf8Name.length());
+  uint64_t const hash = fasthash64(*utf8Source, utf8Source.length(), 0xdeadbeef);
+
+  // keeps the data alive while V8 reads it
+  std::shared_ptr<std::string const> data;
+  {
+    MUTEX_LOCKER(locker, CodeCacheLock);
+    auto it = CodeCache.find(key);
+    if (it != CodeCache.end() && it->second.hash == hash) {
+      data = it->second.data;
+    }
+  }
+
+  v8::ScriptCompiler::CachedData* cachedData = nullptr;
+  if (data != nullptr) {
+    cachedData = new v8::ScriptCompiler::CachedData(
+        reinterpret_cast<uint8_t const*>(data->data()),
+        static_cast<int>(data->size()),
+        v8::ScriptCompiler::CachedData::BufferNotOwned);
+  }
+
+  // the source takes over the cached data
+  v8::ScriptOrigin origin(name);
+  v8::ScriptCompiler::Source scriptSource(source, origin, cachedData);
+
+  v8::Local<v8::Script> script;
+  if (!v8::ScriptCompiler::Compile(isolate->GetCurrentContext(), &scriptSource,
+                                   data != nullptr
+                                       ? v8::ScriptCompiler::kConsumeCodeCache
+                                       : v8::ScriptCompiler::kProduceCodeCache)
+           .ToLocal(&script)) {
+    return scope.Escape<v8::Script>(script);
+  }
+
+  v8::ScriptCompiler::CachedData const* result = scriptSource.GetCachedData();
+
+  if (data != nullptr) {
+    if (result != nullptr && result->rejected) {
+      // e.g. compiled with other flags, the next context fills it again
+      MUTEX_LOCKER(locker, CodeCacheLock);
+      CodeCache.erase(key);
+    }
+  } else if (result != nullptr && result->data != nullptr &&
+             result->length > 0) {
+    auto produced = std::make_shared<std::string const>(
+        reinterpret_cast<char const*>(result->data),
+        static_cast<size_t>(result->length));
+
+    MUTEX_LOCKER(locker, CodeCacheLock);
+    if (CodeCache.size() < MaxCodeCacheEntries ||
+        CodeCache.find(key) != CodeCache.end()) {
+      CodeCache[key] = CodeCacheEntry{hash, std::move(produced)};
+    }
+  }
+
+  return scope.Escape<v8::Script>(script);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief creates an error in a javascript object, based on error number only
 ////////////////////////////////////////////////////////////////////////////////
@@ -140,7 +140,19 @@ bool TRI_ParseJavaScriptFile(v8::Isolate* isolate, char const*, bool);
 v8::Handle<v8::Value> TRI_ExecuteJavaScriptString(
     v8::Isolate* isolate, v8::Handle<v8::Context> context,
     v8::Handle<v8::String> const source, v8::Handle<v8::String> const name,
-    bool printResult);
+    bool printResult, bool useCodeCache = false);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compiles a script in the current context, using the code cache of
+/// the process. the first context that compiles a script under a name fills
+/// the cache, all later contexts compiling the same source skip parsing and
+/// compiling. meant for the bootstrap files and modules, which every context
+/// of the process loads
+////////////////////////////////////////////////////////////////////////////////
+
+v8::Handle<v8::Script> TRI_CompileJavaScriptCached(
+    v8::Isolate* isolate, v8::Handle<v8::String> const source,
+    v8::Handle<v8::String> const name);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief creates an error in a javascript object, based on error number only
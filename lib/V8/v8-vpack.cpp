@@ -37,6 +37,24 @@ using VelocyPackHelper = arangodb::basics::VelocyPackHelper;
 /// @brief maximum object nesting depth
 static int const MaxLevels = 64;
 
+/// @brief minimal size of VelocyPack objects that are converted lazily
+static VPackValueLength const LazyObjectMinSize = 2048;
+
+/// @brief internal fields of lazily converted objects: an ArrayBuffer with
+/// the VelocyPack, the offset of the object in it, and the state flags
+static int const LazyBufferField = 0;
+static int const LazyOffsetField = 1;
+static int const LazyStateField = 2;
+static int const LazyFieldCount = 3;
+
+/// @brief the object may differ from its VelocyPack, because an attribute
+/// was changed, or an object or array was handed out
+static int32_t const LazyModified = 1;
+/// @brief all attributes are own properties, the interceptors are out
+static int32_t const LazyComplete = 2;
+/// @brief an attribute is just being turned into an own property
+static int32_t const LazyDefining = 4;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief converts a VelocyValueType::String into a V8 object
 ////////////////////////////////////////////////////////////////////////////////
@@ -51,6 +69,286 @@ static inline v8::Handle<v8::Value> ObjectVPackString(v8::Isolate* isolate,
   return TRI_V8_PAIR_STRING(isolate, val, l);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether a V8 object is a lazily converted VelocyPack object. other
+/// objects with internal fields keep aligned pointers in them
+////////////////////////////////////////////////////////////////////////////////
+
+static inline bool IsLazyObject(v8::Handle<v8::Object> object) {
+  return object->InternalFieldCount() == LazyFieldCount &&
+         object->GetInternalField(LazyBufferField)->IsArrayBuffer();
+}
+
+static inline v8::Handle<v8::ArrayBuffer> LazyBuffer(
+    v8::Handle<v8::Object> object) {
+  return v8::Handle<v8::ArrayBuffer>::Cast(
+      object->GetInternalField(LazyBufferField));
+}
+
+static inline VPackSlice LazySlice(v8::Handle<v8::Object> object) {
+  uint8_t const* data =
+      static_cast<uint8_t const*>(LazyBuffer(object)->GetContents().Data());
+  return VPackSlice(data +
+                    object->GetInternalField(LazyOffsetField)->Uint32Value());
+}
+
+static inline int32_t LazyState(v8::Handle<v8::Object> object) {
+  return object->GetInternalField(LazyStateField)->Int32Value();
+}
+
+static inline void SetLazyState(v8::Isolate* isolate,
+                                v8::Handle<v8::Object> object, int32_t state) {
+  object->SetInternalField(LazyStateField, v8::Integer::New(isolate, state));
+}
+
+static v8::Handle<v8::Value> LazyObject(v8::Isolate* isolate,
+                                        v8::Handle<v8::ArrayBuffer> buffer,
+                                        uint32_t offset);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief looks up the VelocyPack value of an attribute that is not an own
+/// property of a lazily converted object yet
+////////////////////////////////////////////////////////////////////////////////
+
+static VPackSlice LazyLookup(v8::Isolate* isolate,
+                             v8::Handle<v8::Object> self,
+                             v8::Local<v8::Name> name) {
+  if ((LazyState(self) & (LazyComplete | LazyDefining)) != 0 ||
+      self->HasRealNamedProperty(isolate->GetCurrentContext(), name)
+          .FromMaybe(true)) {
+    return VPackSlice();
+  }
+
+  v8::String::Utf8Value key(name);
+
+  if (*key == nullptr) {
+    return VPackSlice();
+  }
+
+  return LazySlice(self).get(std::string(*key, key.length()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief converts an attribute of a lazily converted object and turns it
+/// into an own property, so that later accesses see the same value
+////////////////////////////////////////////////////////////////////////////////
+
+static v8::Handle<v8::Value> LazyMaterialize(v8::Isolate* isolate,
+                                             v8::Handle<v8::Object> self,
+                                             v8::Local<v8::Name> name,
+                                             VPackSlice value) {
+  v8::Handle<v8::Value> result;
+
+  if (value.isObject() && value.byteSize() >= LazyObjectMinSize) {
+    // shares the buffer of its parent
+    v8::Handle<v8::ArrayBuffer> buffer = LazyBuffer(self);
+    uint8_t const* data =
+        static_cast<uint8_t const*>(buffer->GetContents().Data());
+    result = LazyObject(isolate, buffer,
+                        static_cast<uint32_t>(value.begin() - data));
+  } else {
+    result = TRI_VPackToV8(isolate, value, nullptr, nullptr);
+  }
+
+  int32_t state = LazyState(self);
+  if (value.isObject() || value.isArray()) {
+    // the caller can change it without us noticing
+    state |= LazyModified;
+  }
+
+  SetLazyState(isolate, self, state | LazyDefining);
+  self->CreateDataProperty(isolate->GetCurrentContext(), name, result)
+      .FromMaybe(false);
+  SetLazyState(isolate, self, state);
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief turns all remaining attributes into own properties
+////////////////////////////////////////////////////////////////////////////////
+
+static void LazyMaterializeAll(v8::Isolate* isolate,
+                               v8::Handle<v8::Object> self) {
+  v8::Handle<v8::Context> context = isolate->GetCurrentContext();
+
+  for (auto const& it : VPackObjectIterator(LazySlice(self), true)) {
+    arangodb::velocypack::ValueLength l;
+    char const* p = it.key.getString(l);
+    v8::Handle<v8::String> name = TRI_V8_PAIR_STRING(isolate, p, l);
+
+    if (!self->HasRealNamedProperty(context, name).FromMaybe(true)) {
+      LazyMaterialize(isolate, self, name, it.value);
+    }
+  }
+
+  SetLazyState(isolate, self,
+               LazyState(self) | LazyModified | LazyComplete);
+}
+
+static void LazyGetter(v8::Local<v8::Name> name,
+                       v8::PropertyCallbackInfo<v8::Value> const& args) {
+  v8::Isolate* isolate = args.GetIsolate();
+  v8::HandleScope scope(isolate);
+  v8::Handle<v8::Object> self = args.Holder();
+
+  VPackSlice value = LazyLookup(isolate, self, name);
+  if (!value.isNone()) {
+    TRI_V8_RETURN(LazyMaterialize(isolate, self, name, value));
+  }
+  // not intercepted, own properties and the prototype chain are next
+}
+
+static void LazySetter(v8::Local<v8::Name> name, v8::Local<v8::Value> value,
+                       v8::PropertyCallbackInfo<v8::Value> const& args) {
+  v8::Isolate* isolate = args.GetIsolate();
+  v8::Handle<v8::Object> self = args.Holder();
+
+  int32_t const state = LazyState(self);
+  if ((state & (LazyModified | LazyDefining)) == 0) {
+    SetLazyState(isolate, self, state | LazyModified);
+  }
+  // not intercepted, the value becomes an own property
+}
+
+static void LazyDefiner(v8::Local<v8::Name> name,
+                        v8::PropertyDescriptor const& desc,
+                        v8::PropertyCallbackInfo<v8::Value> const& args) {
+  v8::Isolate* isolate = args.GetIsolate();
+  v8::Handle<v8::Object> self = args.Holder();
+
+  int32_t const state = LazyState(self);
+  if ((state & (LazyModified | LazyDefining)) == 0) {
+    SetLazyState(isolate, self, state | LazyModified);
+  }
+}
+
+static void LazyDescriptor(v8::Local<v8::Name> name,
+                           v8::PropertyCallbackInfo<v8::Value> const& args) {
+  v8::Isolate* isolate = args.GetIsolate();
+  v8::HandleScope scope(isolate);
+  v8::Handle<v8::Object> self = args.Holder();
+
+  VPackSlice value = LazyLookup(isolate, self, name);
+  if (value.isNone()) {
+    return;
+  }
+
+  v8::Handle<v8::Object> descriptor = v8::Object::New(isolate);
+  descriptor->Set(TRI_V8_ASCII_STRING(isolate, "value"),
+                  LazyMaterialize(isolate, self, name, value));
+  descriptor->Set(TRI_V8_ASCII_STRING(isolate, "writable"), v8::True(isolate));
+  descriptor->Set(TRI_V8_ASCII_STRING(isolate, "enumerable"),
+                  v8::True(isolate));
+  descriptor->Set(TRI_V8_ASCII_STRING(isolate, "configurable"),
+                  v8::True(isolate));
+  TRI_V8_RETURN(descriptor);
+}
+
+static void LazyDeleter(v8::Local<v8::Name> name,
+                        v8::PropertyCallbackInfo<v8::Boolean> const& args) {
+  v8::Isolate* isolate = args.GetIsolate();
+  v8::HandleScope scope(isolate);
+  v8::Handle<v8::Object> self = args.Holder();
+
+  if ((LazyState(self) & (LazyComplete | LazyDefining)) == 0) {
+    // a deleted attribute must not come back from the VelocyPack
+    LazyMaterializeAll(isolate, self);
+  }
+  // not intercepted, the own property is deleted
+}
+
+static void LazyEnumerator(v8::PropertyCallbackInfo<v8::Array> const& args) {
+  v8::Isolate* isolate = args.GetIsolate();
+  v8::HandleScope scope(isolate);
+  v8::Handle<v8::Object> self = args.Holder();
+
+  if ((LazyState(self) & (LazyComplete | LazyDefining)) != 0) {
+    return;
+  }
+
+  VPackObjectIterator it(LazySlice(self), true);
+  // V8 drops the names of attributes which are own properties already
+  v8::Handle<v8::Array> result =
+      v8::Array::New(isolate, static_cast<int>(it.size()));
+  uint32_t j = 0;
+
+  while (it.valid()) {
+    arangodb::velocypack::ValueLength l;
+    char const* p = it.key(true).getString(l);
+    result->Set(j++, TRI_V8_PAIR_STRING(isolate, p, l));
+    it.next();
+  }
+
+  TRI_V8_RETURN(result);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief creates a lazily converted object for the VelocyPack object at the
+/// offset of the buffer
+////////////////////////////////////////////////////////////////////////////////
+
+static v8::Handle<v8::Value> LazyObject(v8::Isolate* isolate,
+                                        v8::Handle<v8::ArrayBuffer> buffer,
+                                        uint32_t offset) {
+  TRI_GET_GLOBALS();
+
+  if (v8g->VPackObjectTempl.IsEmpty()) {
+    v8::Handle<v8::ObjectTemplate> rt = v8::ObjectTemplate::New(isolate);
+    rt->SetInternalFieldCount(LazyFieldCount);
+    rt->SetHandler(v8::NamedPropertyHandlerConfiguration(
+        LazyGetter, LazySetter, LazyDescriptor, LazyDeleter, LazyEnumerator,
+        LazyDefiner, v8::Local<v8::Value>(),
+        v8::PropertyHandlerFlags::kOnlyInterceptStrings));
+    v8g->VPackObjectTempl.Reset(isolate, rt);
+  }
+
+  TRI_GET_GLOBAL(VPackObjectTempl, v8::ObjectTemplate);
+  v8::Handle<v8::Object> object = VPackObjectTempl->NewInstance();
+
+  if (object.IsEmpty()) {
+    return v8::Undefined(isolate);
+  }
+
+  object->SetInternalField(LazyBufferField, buffer);
+  object->SetInternalField(LazyOffsetField,
+                           v8::Integer::NewFromUnsigned(isolate, offset));
+  object->SetInternalField(LazyStateField, v8::Integer::New(isolate, 0));
+
+  return object;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief converts a large VelocyValueType::Object into a V8 object, which
+/// converts its attributes on first access. the object keeps a copy of the
+/// VelocyPack with custom types resolved and attribute names translated, so
+/// that it does not depend on the transaction or the options
+////////////////////////////////////////////////////////////////////////////////
+
+static v8::Handle<v8::Value> ObjectVPackLazy(v8::Isolate* isolate,
+                                             VPackSlice const& slice,
+                                             VPackOptions const* options) {
+  // unlike the server's defaults, these have no attribute translator, so
+  // that the copy has plain attribute names
+  static VPackOptions const copyOptions;
+
+  VPackBuilder copy(&copyOptions);
+  VelocyPackHelper::sanitizeNonClientTypes(slice, slice, copy, options, true,
+                                            true, false);
+
+  v8::Handle<v8::ArrayBuffer> buffer =
+      v8::ArrayBuffer::New(isolate, static_cast<size_t>(copy.size()));
+
+  if (buffer.IsEmpty()) {
+    return v8::Undefined(isolate);
+  }
+
+  memcpy(buffer->GetContents().Data(), copy.data(),
+         static_cast<size_t>(copy.size()));
+
+  return LazyObject(isolate, buffer, 0);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief converts a VelocyValueType::Object into a V8 object
 ////////////////////////////////////////////////////////////////////////////////
@@ -60,6 +358,13 @@ static v8::Handle<v8::Value> ObjectVPackObject(v8::Isolate* isolate,
                                                VPackOptions const* options,
                                                VPackSlice const* base) {
   TRI_ASSERT(slice.isObject());
+
+  VPackValueLength const size = slice.byteSize();
+  if (size >= LazyObjectMinSize &&
+      size < static_cast<VPackValueLength>(INT32_MAX)) {
+    return ObjectVPackLazy(isolate, slice, options);
+  }
+
   v8::Handle<v8::Object> object = v8::Object::New(isolate);
 
   if (object.IsEmpty()) {
@@ -150,19 +455,27 @@ static v8::Handle<v8::Value> ObjectVPackArray(v8::Isolate* isolate,
     return v8::Undefined(isolate);
   }
 
+  v8::Handle<v8::Context> context = isolate->GetCurrentContext();
   uint32_t j = 0;
   while (it.valid()) {
-    v8::Handle<v8::Value> val =
-        TRI_VPackToV8(isolate, it.value(), options, &slice);
+    VPackSlice value = it.value();
+    v8::Handle<v8::Value> val = TRI_VPackToV8(isolate, value, options, &slice);
     if (!val.IsEmpty()) {
-      object->Set(j++, val);
+      // the array is fresh, there are no setters to look up
+      object->CreateDataProperty(context, j++, val).FromMaybe(false);
     }
-    if (arangodb::V8PlatformFeature::isOutOfMemory(isolate)) {
+    // only nested arrays and objects allocate enough to run out of memory
+    if ((value.isArray() || value.isObject()) &&
+        arangodb::V8PlatformFeature::isOutOfMemory(isolate)) {
       THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
     }
     it.next();
   }
 
+  if (arangodb::V8PlatformFeature::isOutOfMemory(isolate)) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
   return object;
 }
 
@@ -428,6 +741,24 @@ static int V8ToVPack(BuilderContext& context,
       }
     }
 
+    if (IsLazyObject(o) && (LazyState(o) & LazyModified) == 0) {
+      // unchanged since its conversion, take over the VelocyPack
+      VPackSlice slice = LazySlice(o);
+
+      if (!context.keepTopLevelOpen || context.level > 0) {
+        AddValue<VPackSlice, inObject>(context, attributeName, slice);
+      } else {
+        AddValue<VPackValue, inObject>(context, attributeName,
+                                       VPackValue(VPackValueType::Object));
+        for (auto const& it : VPackObjectIterator(slice, true)) {
+          arangodb::velocypack::ValueLength l;
+          char const* p = it.key.getString(l);
+          context.builder.addUnchecked(p, static_cast<size_t>(l), it.value);
+        }
+      }
+      return TRI_ERROR_NO_ERROR;
+    }
+
     v8::Handle<v8::Array> names = o->GetOwnPropertyNames();
     uint32_t const n = names->Length();
 
@@ -30,6 +30,8 @@
 
 #include "Agency/Store.h"
 
+#include <velocypack/Parser.h>
+
 TEST_CASE("Store", "[agency]") {
 
   SECTION("Store preconditions") {
@@ -72,5 +74,30 @@ TEST_CASE("Store", "[agency]") {
     REQUIRE(node == other.slice());
 
   }
+
+  SECTION("Node copies keep their values when the original changes") {
+
+    using namespace arangodb::consensus;
+
+    Node node("node");
+    auto array = VPackParser::fromJson("[1,2,3]");
+    auto value = VPackParser::fromJson("\"foo\"");
+    node("a/b") = array->slice();
+    node("a/c") = value->slice();
+
+    Node copy(node);
+    REQUIRE(copy("a/b").type() == LEAF);
+    REQUIRE(copy("a/b").slice().length() == 3);
+    REQUIRE(copy("a/c").slice().copyString() == "foo");
+
+    node("a/b") = value->slice();
+    node("a/c") = array->slice();
+
+    REQUIRE(node("a/b").slice().copyString() == "foo");
+    REQUIRE(node("a/c").slice().length() == 3);
+    REQUIRE(copy("a/b").slice().length() == 3);
+    REQUIRE(copy("a/c").slice().copyString() == "foo");
+
+  }
   
 }
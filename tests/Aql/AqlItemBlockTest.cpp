@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for AqlItemBlock
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/ResourceUsage.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+// a string that does not fit into an AqlValue, so that the block has to
+// count and destroy it
+AqlValue managedString(size_t row, RegisterId reg) {
+  std::string value = "value-of-row-" + std::to_string(row) + "-register-" +
+                      std::to_string(reg);
+  return AqlValue(value);
+}
+
+void fill(AqlItemBlock& block) {
+  for (size_t row = 0; row < block.size(); ++row) {
+    for (RegisterId reg = 0; reg < block.getNrRegs(); ++reg) {
+      block.setValue(row, reg, AqlValue(AqlValueHintInt(static_cast<int64_t>(row * 100 + reg))));
+    }
+  }
+}
+
+void checkFilled(AqlItemBlock const& block) {
+  for (size_t row = 0; row < block.size(); ++row) {
+    for (RegisterId reg = 0; reg < block.getNrRegs(); ++reg) {
+      AqlValue const& value = block.getValueReference(row, reg);
+      REQUIRE(value.isNumber());
+      CHECK(value.toInt64(nullptr) == static_cast<int64_t>(row * 100 + reg));
+    }
+  }
+}
+}  // namespace
+
+TEST_CASE("AqlItemBlock", "[aql][itemblock]") {
+  ResourceMonitor monitor;
+
+  SECTION("every value is read back from both layouts") {
+    for (auto layout :
+         {ItemBlockLayout::ROW_MAJOR, ItemBlockLayout::COLUMN_MAJOR}) {
+      AqlItemBlock block(&monitor, 7, 5, layout);
+      CHECK(block.layout() == layout);
+      fill(block);
+      checkFilled(block);
+    }
+  }
+
+  SECTION("shrinking keeps the values of both layouts") {
+    for (auto layout :
+         {ItemBlockLayout::ROW_MAJOR, ItemBlockLayout::COLUMN_MAJOR}) {
+      AqlItemBlock block(&monitor, 7, 3, layout);
+      fill(block);
+      block.shrink(4);
+      REQUIRE(block.size() == 4);
+      checkFilled(block);
+    }
+  }
+
+  SECTION("a block is rescaled to another layout") {
+    AqlItemBlock block(&monitor, 4, 3, ItemBlockLayout::ROW_MAJOR);
+    fill(block);
+    block.eraseAll();
+
+    block.rescale(6, 2, ItemBlockLayout::COLUMN_MAJOR);
+    CHECK(block.size() == 6);
+    CHECK(block.getNrRegs() == 2);
+    CHECK(block.layout() == ItemBlockLayout::COLUMN_MAJOR);
+    fill(block);
+    checkFilled(block);
+    block.eraseAll();
+
+    block.rescale(2, 5, ItemBlockLayout::ROW_MAJOR);
+    CHECK(block.layout() == ItemBlockLayout::ROW_MAJOR);
+    fill(block);
+    checkFilled(block);
+  }
+
+  SECTION("stolen rows keep their values in both layouts") {
+    for (auto layout :
+         {ItemBlockLayout::ROW_MAJOR, ItemBlockLayout::COLUMN_MAJOR}) {
+      AqlItemBlock block(&monitor, 4, 3, layout);
+      for (size_t row = 0; row < block.size(); ++row) {
+        for (RegisterId reg = 0; reg < block.getNrRegs(); ++reg) {
+          block.setValue(row, reg, managedString(row, reg));
+        }
+      }
+
+      std::vector<size_t> chosen{3, 1};
+      std::unique_ptr<AqlItemBlock> stolen(block.steal(chosen, 0, 2));
+      REQUIRE(stolen->size() == 2);
+      REQUIRE(stolen->getNrRegs() == 3);
+      CHECK(stolen->layout() == layout);
+
+      for (size_t row = 0; row < chosen.size(); ++row) {
+        for (RegisterId reg = 0; reg < stolen->getNrRegs(); ++reg) {
+          AqlValue const& value = stolen->getValueReference(row, reg);
+          CHECK(value.slice().copyString() ==
+                managedString(chosen[row], reg).slice().copyString());
+          // the source block is not responsible for the value anymore
+          CHECK(block.valueCount(value) == 0);
+          CHECK(block.getValueReference(chosen[row], reg).isEmpty());
+        }
+      }
+      // the rows that were not stolen are still in the source block
+      CHECK(!block.getValueReference(0, 0).isEmpty());
+      CHECK(!block.getValueReference(2, 2).isEmpty());
+    }
+  }
+
+  // all values and blocks are gone
+  CHECK(monitor.currentResources.memoryUsage == 0);
+}
@@ -0,0 +1,138 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief setup for tests that execute AQL queries against the mocked
+/// storage engine
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef TESTS_AQL_AQL_QUERY_SETUP_H
+#define TESTS_AQL_AQL_QUERY_SETUP_H 1
+
+#include "../IResearch/StorageEngineMock.h"
+#include "../IResearch/common.h"
+
+#include "Aql/AqlFunctionFeature.h"
+#include "Aql/OptimizerRulesFeature.h"
+#include "Aql/Query.h"
+#include "GeneralServer/AuthenticationFeature.h"
+#include "Logger/LogTopic.h"
+#include "Logger/Logger.h"
+#include "RestServer/AqlFeature.h"
+#include "RestServer/DatabaseFeature.h"
+#include "RestServer/DatabasePathFeature.h"
+#include "RestServer/QueryRegistryFeature.h"
+#include "RestServer/TraverserEngineRegistryFeature.h"
+#include "RestServer/ViewTypesFeature.h"
+#include "StorageEngine/EngineSelectorFeature.h"
+
+#if USE_ENTERPRISE
+#include "Enterprise/Ldap/LdapFeature.h"
+#endif
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+
+namespace arangodb {
+namespace tests {
+
+/// @brief the application features needed to run AQL queries on a
+/// TRI_vocbase_t of the mocked storage engine
+struct AqlQuerySetup {
+  StorageEngineMock engine;
+  application_features::ApplicationServer server;
+  std::vector<std::pair<application_features::ApplicationFeature*, bool>> features;
+
+  AqlQuerySetup() : server(nullptr, nullptr) {
+    EngineSelectorFeature::ENGINE = &engine;
+
+    tests::init(true);
+
+    // suppress INFO {authentication} Authentication is turned on (system only), authentication for unix sockets is turned on
+    LogTopic::setLogLevel(Logger::AUTHENTICATION.name(), LogLevel::WARN);
+
+    features.emplace_back(new ViewTypesFeature(&server), true);
+    features.emplace_back(new AuthenticationFeature(&server), true);
+    features.emplace_back(new DatabasePathFeature(&server), false);
+    features.emplace_back(new DatabaseFeature(&server), false);
+    features.emplace_back(new QueryRegistryFeature(&server), false);
+    features.emplace_back(new TraverserEngineRegistryFeature(&server), false);
+    features.emplace_back(new AqlFeature(&server), true);
+    features.emplace_back(new aql::OptimizerRulesFeature(&server), true);
+    features.emplace_back(new aql::AqlFunctionFeature(&server), true);
+
+#if USE_ENTERPRISE
+    features.emplace_back(new LdapFeature(&server), false);
+#endif
+
+    for (auto& f : features) {
+      application_features::ApplicationServer::server->addFeature(f.first);
+    }
+
+    for (auto& f : features) {
+      f.first->prepare();
+    }
+
+    for (auto& f : features) {
+      if (f.second) {
+        f.first->start();
+      }
+    }
+  }
+
+  ~AqlQuerySetup() {
+    AqlFeature(&server).stop(); // unset singleton instance
+    application_features::ApplicationServer::server = nullptr;
+    EngineSelectorFeature::ENGINE = nullptr;
+
+    for (auto& f : features) {
+      if (f.second) {
+        f.first->stop();
+      }
+    }
+
+    for (auto& f : features) {
+      f.first->unprepare();
+    }
+
+    LogTopic::setLogLevel(Logger::AUTHENTICATION.name(), LogLevel::DEFAULT);
+  }
+};
+
+/// @brief execute a query with the given query options (as JSON)
+inline aql::QueryResult executeQueryWithOptions(
+    TRI_vocbase_t& vocbase, std::string const& queryString,
+    std::string const& options,
+    std::shared_ptr<velocypack::Builder> bindVars = nullptr) {
+  aql::Query query(false, vocbase, aql::QueryString(queryString), bindVars,
+                   velocypack::Parser::fromJson(options), aql::PART_MAIN);
+
+  aql::QueryResult result;
+  while (query.execute(QueryRegistryFeature::QUERY_REGISTRY, result) ==
+         aql::ExecutionState::WAITING) {
+    query.tempWaitForAsyncResponse();
+  }
+  return result;
+}
+
+}
+}
+
+#endif
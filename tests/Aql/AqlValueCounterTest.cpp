@@ -0,0 +1,263 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for AqlValueCounter
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Aql/AqlValueCounter.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+#include <random>
+#include <unordered_map>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+
+/// @brief number of slots of a table that has never grown
+constexpr size_t initialSlots = 16;
+
+/// @brief strings that do not fit into an AqlValue, so that they need to
+/// be destroyed and may be counted
+class Values {
+ public:
+  explicit Values(size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+      _values.emplace_back(std::string("a value that does not fit inline ") + std::to_string(i));
+      REQUIRE(_values.back().requiresDestruction());
+    }
+  }
+
+  ~Values() {
+    for (auto& it : _values) {
+      it.destroy();
+    }
+  }
+
+  AqlValue const& operator[](size_t i) const { return _values[i]; }
+  size_t size() const { return _values.size(); }
+
+ private:
+  std::vector<AqlValue> _values;
+};
+
+/// @brief the slot a value starts probing at in a table of initialSlots
+/// slots, computed like AqlValueCounter does
+size_t homeSlot(AqlValue const& value) {
+  uint64_t const h = static_cast<uint64_t>(std::hash<AqlValue>()(value));
+  return static_cast<size_t>((h * 0x9E3779B97F4A7C15ULL) >> 32) & (initialSlots - 1);
+}
+
+/// @brief the values in the order of their slots
+std::vector<uint8_t const*> slotOrder(AqlValueCounter const& counter) {
+  std::vector<uint8_t const*> result;
+  counter.forEach([&result](AqlValue const& value, uint32_t) {
+    result.emplace_back(value.slice().begin());
+  });
+  return result;
+}
+
+/// @brief checks that the table holds exactly the expected counts
+void checkCounts(AqlValueCounter const& counter, Values const& values,
+                 std::unordered_map<size_t, uint32_t> const& expected) {
+  CHECK(expected.size() == counter.size());
+  CHECK(expected.empty() == counter.empty());
+  for (size_t i = 0; i < values.size(); ++i) {
+    auto it = expected.find(i);
+    INFO("value " << i);
+    CHECK((it == expected.end() ? 0 : it->second) == counter.count(values[i]));
+  }
+
+  size_t seen = 0;
+  counter.forEach([&](AqlValue const& value, uint32_t count) {
+    ++seen;
+    CHECK(count > 0);
+    bool found = false;
+    for (auto const& it : expected) {
+      if (values[it.first].slice().begin() == value.slice().begin()) {
+        CHECK(it.second == count);
+        found = true;
+      }
+    }
+    CHECK(found);
+  });
+  CHECK(expected.size() == seen);
+}
+
+}
+
+TEST_CASE("AqlValueCounterTest", "[aql]") {
+  AqlValueCounter counter;
+
+  SECTION("counts every value on its own") {
+    Values values(5);
+    CHECK(counter.empty());
+    CHECK(nullptr == counter.find(values[0]));
+    CHECK(!counter.erase(values[0]));
+
+    CHECK(1 == counter.increment(values[0]));
+    CHECK(2 == counter.increment(values[0]));
+    CHECK(1 == counter.increment(values[1]));
+    CHECK(3 == counter.increment(values[0]));
+    checkCounts(counter, values, {{0, 3}, {1, 1}});
+
+    // the count can be changed through find
+    uint32_t* count = counter.find(values[1]);
+    REQUIRE(nullptr != count);
+    CHECK(1 == *count);
+    ++*count;
+    CHECK(2 == counter.count(values[1]));
+
+    CHECK(counter.erase(values[0]));
+    CHECK(!counter.erase(values[0]));
+    CHECK(!counter.erase(values[2]));
+    checkCounts(counter, values, {{1, 2}});
+
+    counter.clear();
+    checkCounts(counter, values, {});
+    CHECK(1 == counter.increment(values[0]));
+    checkCounts(counter, values, {{0, 1}});
+  }
+
+  SECTION("erasing from colliding chains that wrap around the table end") {
+    // find values that start probing at the last slots and at the first
+    // ones, so that their chains wrap around
+    Values values(5000);
+    std::vector<std::vector<size_t>> byHome(initialSlots);
+    for (size_t i = 0; i < values.size(); ++i) {
+      byHome[homeSlot(values[i])].emplace_back(i);
+    }
+    for (size_t i : {size_t(0), size_t(1), initialSlots - 2, initialSlots - 1}) {
+      REQUIRE(byHome[i].size() >= 3);
+    }
+    size_t const last = initialSlots - 1;
+    // three values for the last slot, two for the first one, one each
+    // for the second and the second to last slot. 7 values stay below the
+    // load factor, so the table does not grow
+    std::vector<size_t> const chain{byHome[last][0], byHome[last][1], byHome[0][0],
+                                    byHome[last][2], byHome[1][0], byHome[0][1],
+                                    byHome[last - 1][0]};
+
+    // all orders of erasing the chain's values, as far as they differ in
+    // which value goes first and which one goes second
+    for (size_t first = 0; first < chain.size(); ++first) {
+      for (size_t second = 0; second < chain.size(); ++second) {
+        if (first == second) {
+          continue;
+        }
+        INFO("erasing " << first << " and " << second);
+        counter.clear();
+        std::unordered_map<size_t, uint32_t> expected;
+        for (size_t i = 0; i < chain.size(); ++i) {
+          for (size_t j = 0; j <= i; ++j) {
+            counter.increment(values[chain[i]]);
+          }
+          expected[chain[i]] = static_cast<uint32_t>(i + 1);
+        }
+        checkCounts(counter, values, expected);
+
+        // the first values of the last slot were moved to the start of the
+        // table, so the chain does wrap around
+        auto order = slotOrder(counter);
+        REQUIRE(chain.size() == order.size());
+        CHECK(values[chain[1]].slice().begin() == order[0]);
+
+        CHECK(counter.erase(values[chain[first]]));
+        expected.erase(chain[first]);
+        checkCounts(counter, values, expected);
+        CHECK(counter.erase(values[chain[second]]));
+        expected.erase(chain[second]);
+        checkCounts(counter, values, expected);
+
+        // the gaps are reused, and all values can still be erased
+        CHECK(1 == counter.increment(values[chain[first]]));
+        expected[chain[first]] = 1;
+        checkCounts(counter, values, expected);
+        for (size_t i : chain) {
+          CHECK((expected.erase(i) > 0) == counter.erase(values[i]));
+          checkCounts(counter, values, expected);
+        }
+        CHECK(counter.empty());
+      }
+    }
+  }
+
+  SECTION("the table grows and keeps all counts") {
+    Values values(3000);
+    std::unordered_map<size_t, uint32_t> expected;
+    for (size_t i = 0; i < values.size(); ++i) {
+      uint32_t const n = static_cast<uint32_t>(i % 3 + 1);
+      for (uint32_t j = 0; j < n; ++j) {
+        CHECK(j + 1 == counter.increment(values[i]));
+      }
+      expected[i] = n;
+      if ((i & (i + 1)) == 0 || i + 1 == values.size()) {
+        // after each power of two, some of them right after growing
+        checkCounts(counter, values, expected);
+      }
+    }
+
+    // the memory is kept when the table is cleared
+    counter.clear();
+    checkCounts(counter, values, {});
+    expected.clear();
+    for (size_t i = 0; i < 100; ++i) {
+      CHECK(1 == counter.increment(values[i]));
+      expected[i] = 1;
+    }
+    checkCounts(counter, values, expected);
+  }
+
+  SECTION("random operations match a map") {
+    Values values(200);
+    std::unordered_map<size_t, uint32_t> expected;
+    std::mt19937 random(42);
+
+    for (size_t round = 0; round < 20000; ++round) {
+      size_t const i = random() % values.size();
+      switch (random() % 4) {
+        case 0:
+        case 1:
+          CHECK(++expected[i] == counter.increment(values[i]));
+          break;
+        case 2: {
+          bool const contained = expected.erase(i) > 0;
+          CHECK(contained == counter.erase(values[i]));
+          break;
+        }
+        default: {
+          uint32_t* count = counter.find(values[i]);
+          auto it = expected.find(i);
+          CHECK((it == expected.end()) == (count == nullptr));
+          break;
+        }
+      }
+      if (round % 1000 == 0) {
+        checkCounts(counter, values, expected);
+      }
+    }
+    checkCounts(counter, values, expected);
+  }
+}
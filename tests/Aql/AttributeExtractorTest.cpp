@@ -0,0 +1,205 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for AttributeExtractor
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/AttributeExtractor.h"
+#include "Aql/ResourceUsage.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Options.h>
+#include <velocypack/Parser.h>
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+
+/// @brief a block with a row for each value of the JSON array in register 0,
+/// and the values in reverse order in register 1. with compact set, objects
+/// are built without index tables
+std::unique_ptr<AqlItemBlock> makeBlock(ResourceMonitor& monitor, std::string const& json,
+                                        bool compact = false) {
+  VPackOptions options;
+  options.buildUnindexedObjects = compact;
+  VPackParser parser(&options);
+  parser.parse(json);
+  auto values = parser.steal();
+  VPackSlice slice = values->slice();
+  size_t const n = slice.length();
+
+  auto block = std::make_unique<AqlItemBlock>(&monitor, n, 3);
+  for (size_t i = 0; i < n; ++i) {
+    block->emplaceValue(i, 0, AqlValueHintCopy(slice.at(i).begin()));
+    block->emplaceValue(i, 1, AqlValueHintCopy(slice.at(n - 1 - i).begin()));
+  }
+  return block;
+}
+
+/// @brief the value of an attribute path, like AQL reads it
+VPackSlice expected(VPackSlice value, std::vector<std::string> const& path) {
+  for (auto const& it : path) {
+    if (!value.isObject()) {
+      return VPackSlice::nullSlice();
+    }
+    value = value.get(it);
+    if (value.isNone()) {
+      return VPackSlice::nullSlice();
+    }
+  }
+  return value;
+}
+
+/// @brief extracts the columns from the block and compares each value with
+/// the one read directly
+void checkColumns(AttributeExtractor& extractor, AqlItemBlock const* block,
+                  std::vector<std::pair<RegisterId, std::vector<std::string>>> const& columns) {
+  extractor.extract(nullptr, block);
+  REQUIRE(columns.size() == extractor.numColumns());
+
+  for (size_t row = 0; row < block->size(); ++row) {
+    for (size_t column = 0; column < columns.size(); ++column) {
+      AqlValue const& value = block->getValueReference(row, columns[column].first);
+      VPackSlice expect = value.isEmpty() ? VPackSlice::nullSlice()
+                                          : expected(value.slice(), columns[column].second);
+      VPackSlice actual = extractor.value(row, column);
+      INFO("row " << row << ", column " << column << ": " << actual.toJson());
+      if (expect.isNull()) {
+        CHECK(actual.isNull());
+      } else {
+        // the extracted value points into the value of the block
+        CHECK(expect.start() == actual.start());
+      }
+    }
+  }
+}
+
+}
+
+TEST_CASE("AttributeExtractorTest", "[aql]") {
+  ResourceMonitor monitor;
+  AttributeExtractor extractor;
+
+  SECTION("columns are only added once") {
+    CHECK(0 == extractor.addColumn(0, {"a"}));
+    CHECK(1 == extractor.addColumn(0, {"a", "b"}));
+    CHECK(2 == extractor.addColumn(1, {"a"}));
+    CHECK(3 == extractor.addColumn(0, {}));
+    CHECK(1 == extractor.addColumn(0, {"a", "b"}));
+    CHECK(0 == extractor.addColumn(0, {"a"}));
+    CHECK(4 == extractor.numColumns());
+
+    extractor.clearColumns();
+    CHECK(0 == extractor.numColumns());
+    CHECK(0 == extractor.addColumn(1, {"a"}));
+  }
+
+  SECTION("missing attributes and non-objects are null") {
+    std::vector<std::pair<RegisterId, std::vector<std::string>>> const columns{
+        {0, {"a"}}, {0, {"a", "b"}}, {0, {"a", "b", "c"}}, {0, {"x"}}, {0, {}}, {1, {"a"}}};
+    for (auto const& it : columns) {
+      extractor.addColumn(it.first, it.second);
+    }
+
+    for (bool compact : {false, true}) {
+      auto block = makeBlock(monitor,
+          "[ { \"a\": 1 }, { }, { \"b\": 2 }, { \"a\": null }, { \"a\": { \"b\": 3 } }, "
+          "  { \"a\": { \"c\": 3 } }, { \"a\": { \"b\": { \"c\": [4] } } }, "
+          "  { \"a\": [{ \"b\": 1 }] }, { \"a\": \"b\" }, "
+          "  null, true, 17, -2.5, \"a\", \"\", [], [{ \"a\": 1 }], { \"x\": { \"a\": 1 } } ]",
+          compact);
+      checkColumns(extractor, block.get(), columns);
+    }
+  }
+
+  SECTION("empty values are null") {
+    extractor.addColumn(0, {"a"});
+    extractor.addColumn(0, {});
+    extractor.addColumn(2, {"a"});
+
+    auto block = makeBlock(monitor, "[ { \"a\": 1 }, 2 ]");
+    extractor.extract(nullptr, block.get());
+    for (size_t row = 0; row < block->size(); ++row) {
+      CHECK(extractor.value(row, 2).isNull());
+    }
+    CHECK(1 == extractor.value(0, 0).getNumber<int>());
+    CHECK(extractor.value(1, 0).isNull());
+    CHECK(2 == extractor.value(1, 1).getNumber<int>());
+  }
+
+  SECTION("attribute paths with a common prefix") {
+    std::vector<std::pair<RegisterId, std::vector<std::string>>> const columns{
+        {0, {"a", "b"}}, {0, {"a", "c"}}, {0, {"a"}}, {0, {"a", "b", "c"}},
+        {0, {"a", "b", "d"}}, {1, {"a", "b"}}, {0, {"ab"}}, {0, {"b", "a"}}};
+    for (auto const& it : columns) {
+      extractor.addColumn(it.first, it.second);
+    }
+
+    auto block = makeBlock(monitor,
+        "[ { \"a\": { \"b\": 1, \"c\": 2 }, \"ab\": 3 }, "
+        "  { \"a\": { \"c\": 2, \"b\": 1 }, \"b\": { \"a\": 4 } }, "
+        "  { \"ab\": 3, \"a\": { \"b\": { \"d\": 5, \"c\": 6 } } }, "
+        "  { \"a\": { \"b\": { \"c\": 6, \"d\": 5 }, \"c\": null } }, "
+        "  { \"b\": { \"a\": 4 }, \"a\": 1 } ]");
+    checkColumns(extractor, block.get(), columns);
+  }
+
+  SECTION("rows of the same and of changing shapes") {
+    std::vector<std::pair<RegisterId, std::vector<std::string>>> const columns{
+        {0, {"a"}}, {0, {"c"}}, {0, {"d", "e"}}};
+    for (auto const& it : columns) {
+      extractor.addColumn(it.first, it.second);
+    }
+
+    for (bool compact : {false, true}) {
+      // the same shape, then a different order of the attributes, then a
+      // shape changing with every row, which stops using the cached
+      // positions at some point
+      std::string json = "[";
+      for (int i = 0; i < 100; ++i) {
+        json += "{ \"a\": " + std::to_string(i) + ", \"b\": 0, \"c\": \"x\", \"d\": { \"e\": 1 } }, ";
+      }
+      for (int i = 0; i < 100; ++i) {
+        json += "{ \"d\": { \"f\": 0, \"e\": 2 }, \"c\": \"y\", \"a\": " + std::to_string(i) + " }, ";
+      }
+      for (int i = 0; i < 200; ++i) {
+        json += (i % 2 == 0)
+            ? "{ \"a\": 1, \"c\": 2, \"d\": { \"e\": " + std::to_string(i) + " } }, "
+            : "{ \"x\": 0, \"y\": 0, \"c\": 3, \"a\": 4, \"d\": { \"g\": 0, \"e\": 5 } }, ";
+      }
+      json += "{ } ]";
+
+      auto block = makeBlock(monitor, json, compact);
+      checkColumns(extractor, block.get(), columns);
+
+      // the cached positions from the last block do not affect the next one
+      auto other = makeBlock(monitor,
+          "[ { \"c\": 1, \"a\": 2 }, { \"d\": { \"e\": 3 } }, 4, { \"a\": 5 } ]", compact);
+      checkColumns(extractor, other.get(), columns);
+    }
+  }
+}
@@ -0,0 +1,374 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for CompiledExpression
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "AqlQuerySetup.h"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/Ast.h"
+#include "Aql/CompiledExpression.h"
+#include "Aql/ExecutionNode.h"
+#include "Aql/ExecutionPlan.h"
+#include "Aql/Expression.h"
+#include "Aql/FixedVarExpressionContext.h"
+#include "Aql/Query.h"
+#include "Aql/Variable.h"
+#include "Basics/SmallVector.h"
+#include "Basics/VelocyPackHelper.h"
+#include "RestServer/QueryRegistryFeature.h"
+#include "Transaction/Methods.h"
+#include "Transaction/Options.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/OperationOptions.h"
+#include "VocBase/LogicalCollection.h"
+#include "VocBase/ManagedDocumentResult.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <algorithm>
+#include <unordered_set>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+using arangodb::tests::executeQueryWithOptions;
+
+namespace {
+
+std::vector<std::string> const EMPTY;
+
+/// @brief the expression types of all calculations of the query's plan
+std::vector<std::string> expressionTypes(TRI_vocbase_t& vocbase, std::string const& queryString) {
+  Query query(false, vocbase, QueryString(queryString), nullptr,
+              VPackParser::fromJson("{ }"), PART_MAIN);
+  auto const res = query.explain();
+  REQUIRE(res.result != nullptr);
+
+  std::vector<std::string> result;
+  for (auto const& it : VPackArrayIterator(res.result->slice().get("nodes"))) {
+    if (it.get("type").isEqualString("CalculationNode")) {
+      result.emplace_back(it.get("expressionType").copyString());
+    }
+  }
+  return result;
+}
+
+/// @brief evaluates the expression for every document in the loops given,
+/// once as the compiled program and once by the regular execution. NOOPT
+/// makes the expression a function call, which is never compiled. checks
+/// that the results are the same and returns them
+VPackSlice checkExpression(TRI_vocbase_t& vocbase, std::string const& loops,
+                           std::string const& expression, bool compiled,
+                           std::vector<std::shared_ptr<VPackBuilder>>& results) {
+  std::string const query = loops + " LET r = " + expression + " RETURN r";
+  std::string const interpreted = loops + " LET r = NOOPT(" + expression + ") RETURN r";
+
+  INFO(expression);
+  auto types = expressionTypes(vocbase, query);
+  CHECK(compiled == (std::find(types.begin(), types.end(), "compiled") != types.end()));
+  types = expressionTypes(vocbase, interpreted);
+  CHECK(std::find(types.begin(), types.end(), "compiled") == types.end());
+
+  auto expected = executeQueryWithOptions(vocbase, interpreted, "{ }");
+  REQUIRE(TRI_ERROR_NO_ERROR == expected.code);
+  auto actual = executeQueryWithOptions(vocbase, query, "{ }");
+  REQUIRE(TRI_ERROR_NO_ERROR == actual.code);
+
+  CHECK(expected.result->slice().toJson() == actual.result->slice().toJson());
+  results.emplace_back(actual.result);
+  return actual.result->slice();
+}
+
+/// @brief evaluates the compiled expression for whole blocks and checks
+/// every row against its evaluation as a single row. row i of the block
+/// holds the value values[(i * (j + 1) + j) % n] for the j-th variable
+void checkBlock(TRI_vocbase_t& vocbase, std::string const& loops,
+                std::string const& expression, std::string const& json) {
+  INFO(expression);
+  Query query(false, vocbase, QueryString(loops + " LET r = " + expression + " RETURN r"),
+              nullptr, VPackParser::fromJson("{ }"), PART_MAIN);
+  query.prepare(QueryRegistryFeature::QUERY_REGISTRY, Query::DontCache);
+
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  query.plan()->findNodesOfType(nodes, ExecutionNode::CALCULATION, true);
+  AstNode const* node = nullptr;
+  for (auto const& it : nodes) {
+    auto calculation = static_cast<CalculationNode const*>(it);
+    if (calculation->outVariable()->name == "r") {
+      node = calculation->expression()->node();
+    }
+  }
+  REQUIRE(nullptr != node);
+  auto compiled = CompiledExpression::compile(node);
+  REQUIRE(nullptr != compiled);
+
+  std::unordered_set<Variable const*> referenced;
+  Ast::getReferencedVariables(node, referenced);
+  std::vector<Variable const*> vars(referenced.begin(), referenced.end());
+  std::sort(vars.begin(), vars.end(),
+            [](Variable const* lhs, Variable const* rhs) { return lhs->id < rhs->id; });
+  std::vector<RegisterId> regs;
+  for (size_t j = 0; j < vars.size(); ++j) {
+    regs.emplace_back(static_cast<RegisterId>(j));
+  }
+  RegisterId const outReg = static_cast<RegisterId>(vars.size());
+
+  auto values = VPackParser::fromJson(json);
+  VPackSlice slice = values->slice();
+  size_t const n = slice.length();
+
+  // two blocks, so that the second one starts with the positions cached
+  // from the first one
+  for (size_t rows : {n * 3, n + 1}) {
+    AqlItemBlock block(query.resourceMonitor(), rows, vars.size() + 1);
+    for (size_t i = 0; i < rows; ++i) {
+      for (size_t j = 0; j < vars.size(); ++j) {
+        block.emplaceValue(i, regs[j], AqlValueHintCopy(slice.at((i * (j + 1) + j) % n).begin()));
+      }
+    }
+
+    compiled->executeBlock(query.trx(), &block, vars, regs, outReg);
+
+    FixedVarExpressionContext ctx;
+    for (size_t i = 0; i < rows; ++i) {
+      ctx.clearVariableValues();
+      for (size_t j = 0; j < vars.size(); ++j) {
+        ctx.setVariableValue(vars[j], block.getValueReference(i, regs[j]));
+      }
+      AqlValue expected = compiled->execute(query.trx(), &ctx);
+      AqlValue const& actual = block.getValueReference(i, outReg);
+      INFO("row " << i);
+      REQUIRE(actual.isBoolean());
+      CHECK(expected.toBoolean() == actual.toBoolean());
+    }
+  }
+}
+
+/// @brief the number of true values in the result
+size_t countTrue(VPackSlice result) {
+  size_t count = 0;
+  for (auto const& it : VPackArrayIterator(result)) {
+    REQUIRE(it.isBoolean());
+    if (it.getBool()) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+}
+
+TEST_CASE("CompiledExpressionTest", "[aql][expression]") {
+  tests::AqlQuerySetup s;
+  UNUSED(s);
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+
+  auto* docs = vocbase.createCollection(VPackParser::fromJson("{ \"name\": \"docs\" }")->slice());
+  REQUIRE(nullptr != docs);
+
+  // documents with values of all types, and with missing attributes
+  std::vector<std::string> const documents{
+    "{ }",
+    "{ \"a\": null }",
+    "{ \"a\": null, \"b\": null }",
+    "{ \"a\": false }",
+    "{ \"a\": true, \"b\": false }",
+    "{ \"a\": -1, \"b\": null }",
+    "{ \"a\": 0 }",
+    "{ \"a\": 1, \"b\": 3 }",
+    "{ \"a\": 1.5, \"b\": 1 }",
+    "{ \"a\": 2, \"b\": 3 }",
+    "{ \"a\": \"1\" }",
+    "{ \"a\": \"abc\", \"b\": \"abd\" }",
+    "{ \"a\": \"\", \"b\": [] }",
+    "{ \"a\": [1] }",
+    "{ \"a\": [1, 2], \"b\": [1, 3] }",
+    "{ \"a\": { \"b\": 1 } }",
+    "{ \"a\": { \"b\": { \"c\": 5 } }, \"b\": { } }",
+    "{ \"a\": { \"b\": \"x\" }, \"b\": 7 }"
+  };
+  {
+    OperationOptions opt;
+    TRI_voc_tick_t tick;
+    std::deque<ManagedDocumentResult> inserted;
+
+    transaction::Methods trx(transaction::StandaloneContext::Create(vocbase),
+                             EMPTY, EMPTY, EMPTY, transaction::Options());
+    REQUIRE(trx.begin().ok());
+
+    for (size_t i = 0; i < documents.size(); ++i) {
+      auto doc = VPackParser::fromJson(documents[i]);
+      VPackBuilder withKey;
+      withKey.openObject();
+      withKey.add("_key", VPackValue((i < 10 ? "d0" : "d") + std::to_string(i)));
+      for (auto const& it : VPackObjectIterator(doc->slice())) {
+        withKey.add(it.key.copyString(), it.value);
+      }
+      withKey.close();
+
+      inserted.emplace_back();
+      CHECK(docs->insert(&trx, withKey.slice(), inserted.back(), opt, tick, false).ok());
+    }
+
+    CHECK(trx.commit().ok());
+  }
+
+  std::string const loop = "FOR d IN docs SORT d._key";
+  std::vector<std::shared_ptr<VPackBuilder>> results;
+
+  SECTION("null and missing attributes") {
+    // missing attributes and attributes of non-objects are null
+    CHECK(3 == countTrue(checkExpression(vocbase, loop, "d.a == null", true, results)));
+    CHECK(documents.size() - 3 ==
+          countTrue(checkExpression(vocbase, loop, "d.a != null", true, results)));
+    CHECK(documents.size() ==
+          countTrue(checkExpression(vocbase, loop, "d.missing == null", true, results)));
+    CHECK(documents.size() - 3 ==
+          countTrue(checkExpression(vocbase, loop, "d.a.b == null", true, results)));
+    CHECK(1 == countTrue(checkExpression(vocbase, loop, "d.a.b.c == 5", true, results)));
+    checkExpression(vocbase, loop, "d.a.b.c.d == null", true, results);
+    checkExpression(vocbase, loop, "d.a == d.b", true, results);
+    checkExpression(vocbase, loop, "d.missing < d.a", true, results);
+    checkExpression(vocbase, loop, "null >= d.b", true, results);
+  }
+
+  SECTION("values of different types compare in AQL type order") {
+    for (auto const& op : {"==", "!=", "<", "<=", ">", ">="}) {
+      for (auto const& value : {"null", "false", "true", "-1", "0", "1", "1.5", "'1'",
+                                "''", "'abc'", "[]", "[1]", "[1, 3]", "{ }", "{ b: 1 }"}) {
+        checkExpression(vocbase, loop, std::string("d.a ") + op + " " + value, true, results);
+        checkExpression(vocbase, loop, std::string(value) + " " + op + " d.b", true, results);
+      }
+      checkExpression(vocbase, loop, std::string("d.a ") + op + " d.b", true, results);
+      checkExpression(vocbase, loop, std::string("d.a.b ") + op + " d.b", true, results);
+    }
+
+    // strings are compared by their characters, not by their bytes
+    checkExpression(vocbase, "FOR s IN ['a', 'B', 'b', 'ä', 'z', 'A']",
+                    "s < 'b'", true, results);
+
+    // numbers compare by value, whatever their representation
+    CHECK(1 == countTrue(checkExpression(vocbase, loop, "d.a == 1.0", true, results)));
+    CHECK(1 == countTrue(checkExpression(vocbase, loop, "d.b == 1.0", true, results)));
+  }
+
+  SECTION("_id and _key") {
+    CHECK(1 == countTrue(checkExpression(vocbase, loop, "d._key == 'd03'", true, results)));
+    checkExpression(vocbase, loop, "d._key > 'd05'", true, results);
+    CHECK(1 == countTrue(checkExpression(vocbase, loop, "d._id == 'docs/d03'", true, results)));
+    checkExpression(vocbase, loop, "d._id < 'docs/d04'", true, results);
+    checkExpression(vocbase, loop, "d._id >= CONCAT('docs/', 'd11')", true, results);
+    checkExpression(vocbase, loop, "d._id != d._key", true, results);
+    // the _id is a string without attributes
+    CHECK(documents.size() ==
+          countTrue(checkExpression(vocbase, loop, "d._id.x == null", true, results)));
+  }
+
+  SECTION("nested AND, OR and NOT") {
+    for (auto const& expression : {
+             "d.a == 1 && d.b == 3",
+             "d.a == 1 || d.b == 3",
+             "!(d.a == 1)",
+             "!!(d.a == 1)",
+             "d.a == 1 && (d.b == 3 || !(d.a > 0))",
+             "!(d.a == 1 || d.a == 2) && d.b != null",
+             "(d.a < 0 || d.a > 1) && !(d.b == null)",
+             "!(d.a == null && d.b == null) || d._key == 'd00'",
+             "d.a > 0 && d.a < 2 && d.b > 0 && d.b != 1",
+             "d.a == null || d.b == null || d.a.b == null || d.a.b.c == 5",
+             "(d.a == 1 || d.a == 2) && (d.b == 3 || d.b == 1) || !(d.a != '1')",
+             "!(!(d.a >= 0) || !(d.b < 10)) && (d._key != 'd07' || d.a == 1)"}) {
+      checkExpression(vocbase, loop, expression, true, results);
+    }
+
+    // the first member that decides the result stops the evaluation, the
+    // program jumps over the others. for the same result, all combinations
+    // of decided and undecided members must be evaluated correctly
+    for (auto const& a : {"true", "false"}) {
+      for (auto const& b : {"true", "false"}) {
+        for (auto const& c : {"true", "false"}) {
+          std::string const values = std::string("FOR a IN [") + a + "] FOR b IN [" + b +
+                                     "] FOR c IN [" + c + "] FOR d IN docs SORT d._key";
+          checkExpression(vocbase, values, "a == true && (b == true || c == true)", true, results);
+          checkExpression(vocbase, values, "a == true || b == true && c == true", true, results);
+          checkExpression(vocbase, values, "!(a == true && b == true) || !(c == true)", true, results);
+          checkExpression(vocbase, values, "(a == true || d.a == 1) && !(b == c)", true, results);
+        }
+      }
+    }
+  }
+
+  SECTION("range and IN comparisons") {
+    CHECK(3 == countTrue(checkExpression(vocbase, loop, "d.a >= 1 && d.a <= 2", true, results)));
+    checkExpression(vocbase, loop, "d.a > 0 && d.a < 'z'", true, results);
+    checkExpression(vocbase, loop, "d.a < 0 || d.a > 1", true, results);
+    checkExpression(vocbase, loop, "d.a > null && d.a < 1", true, results);
+    checkExpression(vocbase, loop, "d.a >= [] && d.a < { }", true, results);
+    checkExpression(vocbase, "FOR o IN [0, 1, 'a', null, [1]] FOR d IN docs SORT d._key",
+                    "d.a <= o && o < d.b", true, results);
+
+    // IN is not compiled, neither alone nor as part of a combination. the
+    // regular execution handles these
+    CHECK(3 == countTrue(checkExpression(vocbase, loop, "d.a IN [1, 2, 'abc']", false, results)));
+    checkExpression(vocbase, loop, "d.a IN 1..3", false, results);
+    checkExpression(vocbase, loop, "d.a NOT IN [null, 1]", false, results);
+    checkExpression(vocbase, loop, "d.a == 1 || d.a IN [2]", false, results);
+    checkExpression(vocbase, loop, "d.a > 0 && d.b IN [3]", false, results);
+  }
+
+  SECTION("blocks are evaluated like single rows") {
+    // missing attributes, non-objects, attribute paths with a common prefix
+    // and documents changing their shape from row to row
+    std::string const values =
+        "[ { \"a\": 1, \"b\": 3 }, { }, 1, null, \"a\", [1], "
+        "  { \"a\": { \"b\": 1, \"c\": 2 } }, { \"b\": 3, \"a\": 1 }, "
+        "  { \"a\": { \"c\": 2, \"b\": { \"c\": 5 } }, \"b\": null }, "
+        "  { \"x\": 0, \"a\": 2, \"b\": [1, 3] }, { \"a\": \"1\" }, "
+        "  { \"a\": { \"b\": \"x\" }, \"ab\": 1 }, { \"a\": [{ \"b\": 1 }] } ]";
+    for (auto const& expression : {
+             "d.a == 1",
+             "d.a == null",
+             "d.a.b == null || d.a.c == 2",
+             "d.a.b == 1 && d.a.c == 2",
+             "d.a.b.c == 5 || d.a.b == 'x' || d.a == 2",
+             "d.a < d.b",
+             "d.a == d.b || d.ab == 1",
+             "!(d.a >= 1 && d.a <= 2) && d.x == null",
+             "d.missing == null && d.a.missing == null"}) {
+      checkBlock(vocbase, "FOR d IN docs", expression, values);
+    }
+
+    // several variables, those in different registers
+    for (auto const& expression : {
+             "d.a == e.a",
+             "d.a.b == e.a.b && d.b != e.b",
+             "d.a < e.b || e.a.c == d.a.c"}) {
+      checkBlock(vocbase, "FOR d IN docs FOR e IN docs", expression, values);
+    }
+  }
+}
@@ -0,0 +1,129 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for the disk spill of DistinctCollectBlock
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "AqlQuerySetup.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <set>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+using arangodb::tests::executeQueryWithOptions;
+
+namespace {
+
+/// @brief the distinct values of a query result, as JSON. spilled values
+/// are returned after the ones kept in memory, so the order differs
+std::multiset<std::string> distinctValues(QueryResult const& queryResult) {
+  VPackSlice result = queryResult.result->slice();
+  REQUIRE(result.isArray());
+
+  std::multiset<std::string> values;
+  for (auto const& it : VPackArrayIterator(result)) {
+    values.emplace(it.toJson());
+  }
+  return values;
+}
+
+/// @brief runs the query once with all values in memory and once with at
+/// most 3 values in memory, and checks that both return the same values
+void checkSpilledValues(TRI_vocbase_t& vocbase, std::string const& queryString,
+                        size_t expectedValues,
+                        std::string const& options = "") {
+  std::string const separator = options.empty() ? "" : ", ";
+  auto inMemory = executeQueryWithOptions(
+      vocbase, queryString, "{ \"collectSpillThreshold\": 0" + separator + options + " }");
+  REQUIRE(TRI_ERROR_NO_ERROR == inMemory.code);
+  auto spilled = executeQueryWithOptions(
+      vocbase, queryString, "{ \"collectSpillThreshold\": 3" + separator + options + " }");
+  REQUIRE(TRI_ERROR_NO_ERROR == spilled.code);
+
+  auto const expected = distinctValues(inMemory);
+  auto const actual = distinctValues(spilled);
+  CHECK(expectedValues == expected.size());
+  CHECK(expectedValues == std::set<std::string>(expected.begin(), expected.end()).size());
+  CHECK((expected == actual));
+}
+
+}
+
+TEST_CASE("DistinctCollectBlockTest", "[aql][collect]") {
+  tests::AqlQuerySetup s;
+  UNUSED(s);
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+
+  SECTION("spilled values are returned once") {
+    // each partition holds more values than the threshold, so partitions
+    // are partitioned again
+    checkSpilledValues(vocbase, "FOR i IN 1..5000 RETURN DISTINCT i % 1500", 1500);
+    checkSpilledValues(vocbase, "FOR i IN 1..5000 RETURN DISTINCT [i % 13, i % 7]", 91);
+  }
+
+  SECTION("spilled compound and mixed values") {
+    checkSpilledValues(vocbase,
+        "FOR i IN 1..3000 RETURN DISTINCT { a: i % 40, b: [i % 3, TO_STRING(i % 2)] }",
+        120);
+    checkSpilledValues(vocbase,
+        "FOR i IN 1..3000 RETURN DISTINCT i % 4 == 0 ? null : (i % 4 == 1 ? i % 100 : TO_STRING(i % 100))",
+        76);
+  }
+
+  SECTION("spilled long strings keep their values") {
+    // the values do not fit into an AqlValue, and all partitions together
+    // are larger than the buffer of a spill file. the values of a partition
+    // are returned after its file is gone
+    std::string const padding(300, 'x');
+    std::string const query =
+        "FOR i IN 1..20000 RETURN DISTINCT CONCAT('" + padding + "', i % 2000)";
+    checkSpilledValues(vocbase, query, 2000);
+    checkSpilledValues(vocbase, query, 2000, "\"distinctHashOnly\": true");
+
+    auto queryResult = executeQueryWithOptions(vocbase, query, "{ \"collectSpillThreshold\": 3 }");
+    REQUIRE(TRI_ERROR_NO_ERROR == queryResult.code);
+    std::set<std::string> expected;
+    for (size_t i = 0; i < 2000; ++i) {
+      expected.emplace(padding + std::to_string(i));
+    }
+    std::set<std::string> actual;
+    for (auto const& it : VPackArrayIterator(queryResult.result->slice())) {
+      CHECK(actual.emplace(it.copyString()).second);
+    }
+    CHECK((expected == actual));
+  }
+
+  SECTION("spilled arrays of long strings keep their values") {
+    std::string const padding(300, 'y');
+    checkSpilledValues(vocbase,
+        "FOR i IN 1..6000 RETURN DISTINCT [CONCAT('" + padding + "', i % 600), { v: CONCAT(i % 3, '" + padding + "') }]",
+        600);
+  }
+
+  SECTION("empty input produces no values") {
+    checkSpilledValues(vocbase, "FOR i IN [] RETURN DISTINCT i", 0);
+  }
+}
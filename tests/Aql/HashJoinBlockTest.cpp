@@ -0,0 +1,283 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for HashJoinBlock
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "AqlQuerySetup.h"
+
+#include "Aql/OptimizerRule.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Transaction/Methods.h"
+#include "Transaction/Options.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/OperationOptions.h"
+#include "VocBase/LogicalCollection.h"
+#include "VocBase/ManagedDocumentResult.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+using arangodb::tests::executeQueryWithOptions;
+
+namespace {
+
+std::vector<std::string> const EMPTY;
+
+/// @brief the names of the documents returned by a query, in order
+std::vector<std::string> names(QueryResult const& queryResult) {
+  std::vector<std::string> result;
+  for (auto const& it : VPackArrayIterator(queryResult.result->slice())) {
+    result.emplace_back(it.copyString());
+  }
+  return result;
+}
+
+/// @brief runs the query with and without the hash-join rule, checks that
+/// the rule was used and that both plans return the same rows in the same
+/// order. returns the names returned by the query
+std::vector<std::string> checkJoin(TRI_vocbase_t& vocbase,
+                                   std::string const& queryString,
+                                   std::string const& options = "{ }") {
+  CHECK(tests::assertRules(vocbase, queryString, {OptimizerRule::hashJoinRule_pass6}));
+
+  auto joined = executeQueryWithOptions(vocbase, queryString, options);
+  REQUIRE(TRI_ERROR_NO_ERROR == joined.code);
+  auto nestedLoop = executeQueryWithOptions(
+      vocbase, queryString, "{ \"optimizer\": { \"rules\": [\"-hash-join\"] } }");
+  REQUIRE(TRI_ERROR_NO_ERROR == nestedLoop.code);
+
+  REQUIRE(joined.result->slice().isArray());
+  CHECK(0 == basics::VelocyPackHelper::compare(nestedLoop.result->slice(),
+                                                joined.result->slice(), true));
+  return names(joined);
+}
+
+/// @brief the number of documents a query read in full collection scans
+int64_t scannedFull(TRI_vocbase_t& vocbase, std::string const& queryString,
+                    std::string const& options) {
+  auto queryResult = executeQueryWithOptions(vocbase, queryString, options);
+  REQUIRE(TRI_ERROR_NO_ERROR == queryResult.code);
+  REQUIRE(queryResult.extra != nullptr);
+  return queryResult.extra->slice().get("stats").get("scannedFull").getNumber<int64_t>();
+}
+
+}
+
+TEST_CASE("HashJoinBlockTest", "[aql][join]") {
+  tests::AqlQuerySetup s;
+  UNUSED(s);
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+
+  auto* inner = vocbase.createCollection(VPackParser::fromJson("{ \"name\": \"inner\" }")->slice());
+  REQUIRE(nullptr != inner);
+  auto* empty = vocbase.createCollection(VPackParser::fromJson("{ \"name\": \"empty\" }")->slice());
+  REQUIRE(nullptr != empty);
+
+  // 5 documents for each value from 0 to 9, and some documents with a null
+  // or no value at all
+  {
+    OperationOptions opt;
+    TRI_voc_tick_t tick;
+    std::deque<ManagedDocumentResult> inserted;
+
+    transaction::Methods trx(transaction::StandaloneContext::Create(vocbase),
+                             EMPTY, EMPTY, EMPTY, transaction::Options());
+    REQUIRE(trx.begin().ok());
+
+    VPackBuilder doc;
+    for (int i = 0; i < 54; ++i) {
+      doc.clear();
+      doc.openObject();
+      doc.add("name", VPackValue("d" + std::to_string(i)));
+      if (i < 50) {
+        doc.add("value", VPackValue(i % 10));
+      } else if (i < 52) {
+        doc.add("value", VPackValue(VPackValueType::Null));
+      }
+      doc.close();
+
+      inserted.emplace_back();
+      CHECK(inner->insert(&trx, doc.slice(), inserted.back(), opt, tick, false).ok());
+    }
+
+    CHECK(trx.commit().ok());
+  }
+
+  SECTION("each outer row gets its matching documents") {
+    auto result = checkJoin(vocbase,
+        "FOR i IN 0..9 FOR d IN inner FILTER d.value == i RETURN d.name");
+    REQUIRE(50 == result.size());
+    for (size_t i = 0; i < result.size(); ++i) {
+      // the documents of a value keep the order of the collection
+      size_t const value = i / 5;
+      CHECK(("d" + std::to_string(value + (i % 5) * 10)) == result[i]);
+    }
+  }
+
+  SECTION("duplicate and unmatched outer keys") {
+    auto result = checkJoin(vocbase,
+        "FOR i IN [3, 100, 3, 4, '3'] FOR d IN inner FILTER d.value == i RETURN d.name");
+    CHECK(15 == result.size());
+  }
+
+  SECTION("null matches null and missing attributes") {
+    auto result = checkJoin(vocbase,
+        "FOR i IN [null, 1] FOR d IN inner FILTER d.value == i RETURN d.name");
+    REQUIRE(9 == result.size());
+    CHECK((std::vector<std::string>{"d50", "d51", "d52", "d53"}) ==
+          std::vector<std::string>(result.begin(), result.begin() + 4));
+
+    // a missing attribute on the outer side is null as well
+    result = checkJoin(vocbase,
+        "FOR o IN [{ v: 2 }, { }] FOR d IN inner FILTER d.value == o.v RETURN d.name");
+    REQUIRE(9 == result.size());
+    CHECK((std::vector<std::string>{"d50", "d51", "d52", "d53"}) ==
+          std::vector<std::string>(result.begin() + 5, result.end()));
+
+    // sub-attributes of documents without the attribute are null, too
+    result = checkJoin(vocbase,
+        "FOR i IN [null, 7] FOR d IN inner FILTER d.value.sub == i RETURN d.name");
+    CHECK(54 == result.size());
+  }
+
+  SECTION("an empty build side produces no rows") {
+    auto result = checkJoin(vocbase,
+        "FOR i IN 1..10 FOR d IN empty FILTER d.value == i RETURN d.name");
+    CHECK(result.empty());
+  }
+
+  SECTION("the build side is not read without input rows") {
+    std::string const query =
+        "FOR i IN 1..10 FILTER i > 100 FOR d IN inner FILTER d.value == i RETURN d.name";
+    auto result = checkJoin(vocbase, query);
+    CHECK(result.empty());
+
+    auto queryResult = executeQueryWithOptions(vocbase, query, "{ }");
+    REQUIRE(TRI_ERROR_NO_ERROR == queryResult.code);
+    REQUIRE(queryResult.extra != nullptr);
+    CHECK(0 == queryResult.extra->slice().get("stats").get("scannedFull").getNumber<int64_t>());
+
+    auto joinResult = executeQueryWithOptions(vocbase,
+        "FOR i IN 1..10 FOR d IN inner FILTER d.value == i RETURN d.name", "{ }");
+    REQUIRE(TRI_ERROR_NO_ERROR == joinResult.code);
+    REQUIRE(joinResult.extra != nullptr);
+    // the collection is read once, not once per input row
+    CHECK(54 == joinResult.extra->slice().get("stats").get("scannedFull").getNumber<int64_t>());
+  }
+
+  SECTION("matches span several output blocks and can be skipped") {
+    auto result = checkJoin(vocbase,
+        "FOR i IN 1..3000 FOR d IN inner FILTER d.value == i % 10 RETURN d.name");
+    CHECK(15000 == result.size());
+
+    result = checkJoin(vocbase,
+        "FOR i IN 1..3000 FOR d IN inner FILTER d.value == i % 10 LIMIT 1233, 2000 RETURN d.name");
+    CHECK(2000 == result.size());
+  }
+
+  SECTION("tables above the memory limit fall back to a nested loop") {
+    std::string const small = "{ \"hashJoinMemoryLimit\": 1 }";
+    std::string const query =
+        "FOR i IN 0..9 FOR d IN inner FILTER d.value == i RETURN d.name";
+
+    auto result = checkJoin(vocbase, query, small);
+    REQUIRE(50 == result.size());
+    for (size_t i = 0; i < result.size(); ++i) {
+      CHECK(("d" + std::to_string(i / 5 + (i % 5) * 10)) == result[i]);
+    }
+
+    // the table is given up after the first batch, then the collection is
+    // read once per input row
+    CHECK(54 + 10 * 54 == scannedFull(vocbase, query, small));
+    CHECK(54 == scannedFull(vocbase, query, "{ \"hashJoinMemoryLimit\": 1000000 }"));
+    CHECK(54 == scannedFull(vocbase, query, "{ \"hashJoinMemoryLimit\": 0 }"));
+
+    // duplicate, unmatched and null keys
+    result = checkJoin(vocbase,
+        "FOR i IN [3, 100, 3, null, '3'] FOR d IN inner FILTER d.value == i RETURN d.name",
+        small);
+    CHECK(14 == result.size());
+
+    result = checkJoin(vocbase,
+        "FOR i IN 1..10 FOR d IN empty FILTER d.value == i RETURN d.name", small);
+    CHECK(result.empty());
+
+    // matches span several output blocks and can be skipped
+    result = checkJoin(vocbase,
+        "FOR i IN 1..300 FOR d IN inner FILTER d.value == i % 10 RETURN d.name", small);
+    CHECK(1500 == result.size());
+    result = checkJoin(vocbase,
+        "FOR i IN 1..300 FOR d IN inner FILTER d.value == i % 10 LIMIT 123, 1000 RETURN d.name",
+        small);
+    CHECK(1000 == result.size());
+  }
+
+  SECTION("the table counts towards the memory limit of the query") {
+    auto* large = vocbase.createCollection(VPackParser::fromJson("{ \"name\": \"large\" }")->slice());
+    REQUIRE(nullptr != large);
+    {
+      OperationOptions opt;
+      TRI_voc_tick_t tick;
+      std::deque<ManagedDocumentResult> inserted;
+
+      transaction::Methods trx(transaction::StandaloneContext::Create(vocbase),
+                               EMPTY, EMPTY, EMPTY, transaction::Options());
+      REQUIRE(trx.begin().ok());
+
+      VPackBuilder doc;
+      for (int i = 0; i < 20000; ++i) {
+        doc.clear();
+        doc.openObject();
+        doc.add("value", VPackValue(i));
+        doc.close();
+
+        inserted.emplace_back();
+        CHECK(large->insert(&trx, doc.slice(), inserted.back(), opt, tick, false).ok());
+      }
+
+      CHECK(trx.commit().ok());
+    }
+
+    // the table of 20000 documents takes more than 1 MB, a nested loop does
+    // not need it
+    std::string const query =
+        "FOR i IN [7, 19999] FOR d IN large FILTER d.value == i RETURN d.value";
+    auto queryResult = executeQueryWithOptions(vocbase, query,
+        "{ \"memoryLimit\": 1000000, \"hashJoinMemoryLimit\": 0 }");
+    CHECK(TRI_ERROR_RESOURCE_LIMIT == queryResult.code);
+
+    auto fallback = executeQueryWithOptions(vocbase, query,
+        "{ \"memoryLimit\": 1000000, \"hashJoinMemoryLimit\": 100000 }");
+    REQUIRE(TRI_ERROR_NO_ERROR == fallback.code);
+    CHECK(2 == fallback.result->slice().length());
+
+    auto nestedLoop = executeQueryWithOptions(vocbase, query,
+        "{ \"memoryLimit\": 1000000, \"optimizer\": { \"rules\": [\"-hash-join\"] } }");
+    REQUIRE(TRI_ERROR_NO_ERROR == nestedLoop.code);
+    CHECK(2 == nestedLoop.result->slice().length());
+  }
+}
@@ -0,0 +1,178 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for the group table and disk spill of HashedCollectBlock
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "AqlQuerySetup.h"
+
+#include "Basics/VelocyPackHelper.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <unordered_set>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+using arangodb::tests::executeQueryWithOptions;
+
+namespace {
+
+/// @brief runs the query once with all groups in memory and once with at
+/// most 3 groups in memory, and checks that both return the same rows.
+/// the queries sort their groups, so the order is the same as well
+void checkSpilledGroups(TRI_vocbase_t& vocbase, std::string const& queryString,
+                        size_t expectedRows) {
+  auto inMemory = executeQueryWithOptions(vocbase, queryString, "{ \"collectSpillThreshold\": 0 }");
+  REQUIRE(TRI_ERROR_NO_ERROR == inMemory.code);
+  auto spilled = executeQueryWithOptions(vocbase, queryString, "{ \"collectSpillThreshold\": 3 }");
+  REQUIRE(TRI_ERROR_NO_ERROR == spilled.code);
+
+  VPackSlice expected = inMemory.result->slice();
+  VPackSlice actual = spilled.result->slice();
+  REQUIRE(expected.isArray());
+  REQUIRE(actual.isArray());
+  REQUIRE(expectedRows == expected.length());
+  REQUIRE(expectedRows == actual.length());
+
+  VPackArrayIterator it(expected);
+  for (auto const& row : VPackArrayIterator(actual)) {
+    CHECK(0 == basics::VelocyPackHelper::compare(it.value(), row, true));
+    it.next();
+  }
+}
+
+}
+
+TEST_CASE("HashedCollectBlockTest", "[aql][collect]") {
+  tests::AqlQuerySetup s;
+  UNUSED(s);
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+
+  SECTION("groups are counted in memory") {
+    // more groups than the initial size of the table, so it has to grow
+    auto queryResult = executeQueryWithOptions(
+        vocbase,
+        "FOR i IN 1..5000 COLLECT k = i % 1500 WITH COUNT INTO c OPTIONS { method: 'hash' } RETURN [k, c]",
+        "{ }");
+    REQUIRE(TRI_ERROR_NO_ERROR == queryResult.code);
+
+    VPackSlice result = queryResult.result->slice();
+    REQUIRE(result.isArray());
+    CHECK(1500 == result.length());
+
+    int64_t expected = 0;
+    for (auto const& row : VPackArrayIterator(result)) {
+      CHECK(expected == row.at(0).getNumber<int64_t>());
+      // 1..5000 contains 4 numbers with a remainder from 1 to 500, and 3
+      // numbers with any other remainder
+      CHECK((expected >= 1 && expected <= 500 ? 4 : 3) == row.at(1).getNumber<int64_t>());
+      ++expected;
+    }
+  }
+
+  SECTION("spilled groups are counted once") {
+    // each partition holds more groups than the threshold, so partitions
+    // are partitioned again
+    checkSpilledGroups(vocbase,
+        "FOR i IN 1..5000 COLLECT k = i % 1500 WITH COUNT INTO c OPTIONS { method: 'hash' } RETURN [k, c]",
+        1500);
+    checkSpilledGroups(vocbase,
+        "FOR i IN 1..5000 COLLECT a = i % 13, b = i % 7 OPTIONS { method: 'hash' } RETURN [a, b]",
+        91);
+  }
+
+  SECTION("spilled groups keep their aggregates") {
+    checkSpilledGroups(vocbase,
+        "FOR i IN 1..4000 LET v = i % 7 == 0 ? null : i "
+        "COLLECT k = i % 997 AGGREGATE s = SUM(v), mn = MIN(v), mx = MAX(v), n = LENGTH(v), u = SORTED_UNIQUE(i % 3) "
+        "OPTIONS { method: 'hash' } RETURN { k, s, mn, mx, n, u }",
+        997);
+  }
+
+  SECTION("spilled groups of compound and mixed values") {
+    checkSpilledGroups(vocbase,
+        "FOR i IN 1..3000 COLLECT k = { a: i % 40, b: [i % 3, TO_STRING(i % 2)] } WITH COUNT INTO c "
+        "OPTIONS { method: 'hash' } RETURN [k, c]",
+        120);
+    checkSpilledGroups(vocbase,
+        "FOR i IN 1..3000 COLLECT k = i % 4 == 0 ? null : (i % 4 == 1 ? i % 100 : TO_STRING(i % 100)) "
+        "OPTIONS { method: 'hash' } RETURN k",
+        76);
+  }
+
+  SECTION("spilled groups of long strings keep their values") {
+    // the values do not fit into an AqlValue, and all partitions together
+    // are larger than the buffer of a spill file. the groups of a partition
+    // are returned after its file is gone
+    std::string const padding(300, 'x');
+    checkSpilledGroups(vocbase,
+        "FOR i IN 1..20000 LET p = '" + padding + "' "
+        "COLLECT k = CONCAT(p, i % 2000) "
+        "AGGREGATE mn = MIN(CONCAT(i, p)), mx = MAX(CONCAT(p, i)), u = SORTED_UNIQUE(CONCAT(p, i % 3)) "
+        "OPTIONS { method: 'hash' } RETURN { k, mn, mx, u }",
+        2000);
+
+    auto queryResult = executeQueryWithOptions(vocbase,
+        "FOR i IN 1..20000 COLLECT k = CONCAT('" + padding + "', i % 2000) WITH COUNT INTO c "
+        "OPTIONS { method: 'hash' } RETURN [k, c]",
+        "{ \"collectSpillThreshold\": 3 }");
+    REQUIRE(TRI_ERROR_NO_ERROR == queryResult.code);
+    REQUIRE(2000 == queryResult.result->slice().length());
+    std::unordered_set<std::string> seen;
+    for (auto const& row : VPackArrayIterator(queryResult.result->slice())) {
+      std::string k = row.at(0).copyString();
+      CHECK(0 == k.compare(0, padding.size(), padding));
+      CHECK(seen.emplace(k).second);
+      CHECK(10 == row.at(1).getNumber<int64_t>());
+    }
+  }
+
+  SECTION("groups of spilled partitions can be skipped") {
+    // no sort after the COLLECT, so the LIMIT skips groups of the block
+    auto queryResult = executeQueryWithOptions(
+        vocbase,
+        "FOR i IN 1..3000 COLLECT k = i % 1000 OPTIONS { method: 'hash' } SORT null LIMIT 100, 2000 RETURN k",
+        "{ \"collectSpillThreshold\": 3 }");
+    REQUIRE(TRI_ERROR_NO_ERROR == queryResult.code);
+
+    VPackSlice result = queryResult.result->slice();
+    REQUIRE(result.isArray());
+    CHECK(900 == result.length());
+
+    std::unordered_set<int64_t> seen;
+    for (auto const& row : VPackArrayIterator(result)) {
+      int64_t k = row.getNumber<int64_t>();
+      CHECK(k >= 0);
+      CHECK(k < 1000);
+      CHECK(seen.emplace(k).second);
+    }
+  }
+
+  SECTION("empty input produces no groups") {
+    checkSpilledGroups(vocbase,
+        "FOR i IN [] COLLECT k = i WITH COUNT INTO c OPTIONS { method: 'hash' } RETURN [k, c]",
+        0);
+  }
+}
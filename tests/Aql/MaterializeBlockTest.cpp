@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for late document materialization
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "AqlQuerySetup.h"
+
+#include "Aql/OptimizerRule.h"
+#include "Basics/VelocyPackHelper.h"
+#include "RocksDBEngine/RocksDBOptimizerRules.h"
+#include "Transaction/Methods.h"
+#include "Transaction/Options.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/OperationOptions.h"
+#include "VocBase/LogicalCollection.h"
+#include "VocBase/ManagedDocumentResult.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+using arangodb::tests::executeQueryWithOptions;
+
+namespace {
+
+std::vector<std::string> const EMPTY;
+
+/// @brief whether the optimizer materializes the documents of the query late
+bool materializesLate(TRI_vocbase_t& vocbase, std::string const& queryString) {
+  return tests::assertRules(vocbase, queryString,
+                            {OptimizerRule::lateDocumentMaterializationRule_pass10});
+}
+
+/// @brief runs the query with and without late materialization, and checks
+/// that both return the same documents in the same order. returns the
+/// number of documents
+size_t checkMaterialized(TRI_vocbase_t& vocbase, std::string const& queryString) {
+  auto late = executeQueryWithOptions(vocbase, queryString, "{ }");
+  REQUIRE(TRI_ERROR_NO_ERROR == late.code);
+  auto early = executeQueryWithOptions(
+      vocbase, queryString,
+      "{ \"optimizer\": { \"rules\": [\"-late-document-materialization\"] } }");
+  REQUIRE(TRI_ERROR_NO_ERROR == early.code);
+
+  VPackSlice result = late.result->slice();
+  REQUIRE(result.isArray());
+  CHECK(0 == basics::VelocyPackHelper::compare(early.result->slice(), result, true));
+
+  for (auto const& it : VPackArrayIterator(result)) {
+    // the full document, not only the attributes of the index
+    CHECK(it.isObject());
+    CHECK(it.hasKey("payload"));
+  }
+  return result.length();
+}
+
+}
+
+TEST_CASE("MaterializeBlockTest", "[aql][materialize]") {
+  tests::AqlQuerySetup s;
+  UNUSED(s);
+  // the mocked engine does not add the optimizer rules of RocksDB
+  RocksDBOptimizerRules::registerResources();
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+
+  auto* docs = vocbase.createCollection(VPackParser::fromJson("{ \"name\": \"docs\" }")->slice());
+  REQUIRE(nullptr != docs);
+
+  bool created = false;
+  auto index = docs->createIndex(
+      nullptr,
+      VPackParser::fromJson("{ \"type\": \"skiplist\", \"fields\": [\"value\", \"other\"] }")->slice(),
+      created);
+  REQUIRE(nullptr != index);
+  CHECK(created);
+
+  // 100 documents with distinct values, and some without any
+  {
+    OperationOptions opt;
+    TRI_voc_tick_t tick;
+    std::deque<ManagedDocumentResult> inserted;
+
+    transaction::Methods trx(transaction::StandaloneContext::Create(vocbase),
+                             EMPTY, EMPTY, EMPTY, transaction::Options());
+    REQUIRE(trx.begin().ok());
+
+    VPackBuilder doc;
+    for (int i = 0; i < 103; ++i) {
+      doc.clear();
+      doc.openObject();
+      doc.add("name", VPackValue("d" + std::to_string(i)));
+      if (i < 100) {
+        doc.add("value", VPackValue((i * 37) % 100));
+        doc.add("other", VPackValue(i % 10));
+      }
+      doc.add("payload", VPackValue(std::string(i, 'x')));
+      doc.close();
+
+      inserted.emplace_back();
+      CHECK(docs->insert(&trx, doc.slice(), inserted.back(), opt, tick, false).ok());
+    }
+
+    CHECK(trx.commit().ok());
+  }
+
+  SECTION("documents are read after filtering on the index values") {
+    std::string query =
+        "FOR d IN docs FILTER d.other > 3 SORT d.value LIMIT 5, 10 RETURN d";
+    CHECK(materializesLate(vocbase, query));
+    CHECK(10 == checkMaterialized(vocbase, query));
+
+    auto queryResult = executeQueryWithOptions(vocbase, query, "{ }");
+    REQUIRE(TRI_ERROR_NO_ERROR == queryResult.code);
+    int64_t previous = -1;
+    for (auto const& it : VPackArrayIterator(queryResult.result->slice())) {
+      CHECK(it.get("other").getNumber<int64_t>() > 3);
+      CHECK(previous < it.get("value").getNumber<int64_t>());
+      previous = it.get("value").getNumber<int64_t>();
+    }
+
+    query = "FOR d IN docs FILTER d.other == 7 || d.value == null SORT d.value DESC LIMIT 3 "
+            "RETURN d";
+    CHECK(materializesLate(vocbase, query));
+    CHECK(3 == checkMaterialized(vocbase, query));
+  }
+
+  SECTION("documents are read after sorting and filtering on calculations") {
+    std::string query =
+        "FOR d IN docs LET x = d.other * 2 FILTER x != 8 SORT d.value LIMIT 20 "
+        "RETURN MERGE(d, { x })";
+    CHECK(materializesLate(vocbase, query));
+    CHECK(20 == checkMaterialized(vocbase, query));
+
+    // documents without the indexed attributes are kept
+    query = "FOR d IN docs FILTER d.other == null SORT d.value LIMIT 10 RETURN d";
+    CHECK(materializesLate(vocbase, query));
+    CHECK(3 == checkMaterialized(vocbase, query));
+  }
+
+  SECTION("documents are read early if the index does not cover the query") {
+    // the name is not in the index
+    std::string query =
+        "FOR d IN docs FILTER d.name != 'd3' SORT d.value LIMIT 5 RETURN d";
+    CHECK(!materializesLate(vocbase, query));
+    CHECK(5 == checkMaterialized(vocbase, query));
+
+    // the whole document is used before the LIMIT
+    query = "FOR d IN docs FILTER HAS(d, 'other') SORT d.value LIMIT 5 RETURN d";
+    CHECK(!materializesLate(vocbase, query));
+    CHECK(5 == checkMaterialized(vocbase, query));
+  }
+
+  SECTION("documents are read early if no rows are discarded before a LIMIT") {
+    // without a LIMIT, every document is read anyway
+    std::string query = "FOR d IN docs FILTER d.other > 3 SORT d.value RETURN d";
+    CHECK(!materializesLate(vocbase, query));
+    CHECK(60 == checkMaterialized(vocbase, query));
+
+    // nothing between the index and the LIMIT throws away documents
+    query = "FOR d IN docs SORT d.value LIMIT 5 RETURN d";
+    CHECK(!materializesLate(vocbase, query));
+    CHECK(5 == checkMaterialized(vocbase, query));
+  }
+
+  SECTION("documents are not read if only index values are needed") {
+    // the document is not used after the LIMIT
+    std::string query =
+        "FOR d IN docs LET v = d.value FILTER d.other > 3 SORT v LIMIT 5 RETURN v";
+    CHECK(!materializesLate(vocbase, query));
+
+    auto queryResult = executeQueryWithOptions(vocbase, query, "{ }");
+    REQUIRE(TRI_ERROR_NO_ERROR == queryResult.code);
+    REQUIRE(queryResult.result->slice().isArray());
+    CHECK(5 == queryResult.result->slice().length());
+  }
+}
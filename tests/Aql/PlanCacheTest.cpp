@@ -0,0 +1,227 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for the AQL plan cache
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "AqlQuerySetup.h"
+
+#include "Aql/PlanCache.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Transaction/Methods.h"
+#include "Transaction/Options.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/OperationOptions.h"
+#include "VocBase/LogicalCollection.h"
+#include "VocBase/ManagedDocumentResult.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+using arangodb::tests::executeQueryWithOptions;
+
+namespace {
+
+std::vector<std::string> const EMPTY;
+
+/// @brief the figures of the plan cache
+struct Figures {
+  uint64_t hits;
+  uint64_t misses;
+  uint64_t stores;
+  uint64_t invalidations;
+
+  Figures() {
+    VPackBuilder builder;
+    builder.openObject();
+    PlanCache::instance()->toVelocyPack(builder);
+    builder.close();
+
+    VPackSlice slice = builder.slice();
+    hits = slice.get("hits").getNumber<uint64_t>();
+    misses = slice.get("misses").getNumber<uint64_t>();
+    stores = slice.get("stores").getNumber<uint64_t>();
+    invalidations = slice.get("invalidations").getNumber<uint64_t>();
+  }
+};
+
+/// @brief executes the query with the plan cache, and checks that it returns
+/// the expected result
+void checkCached(TRI_vocbase_t& vocbase, std::string const& queryString,
+                 std::string const& bindVars, std::string const& expected) {
+  auto queryResult = executeQueryWithOptions(vocbase, queryString,
+                                             "{ \"usePlanCache\": true }",
+                                             VPackParser::fromJson(bindVars));
+  REQUIRE(TRI_ERROR_NO_ERROR == queryResult.code);
+
+  auto expectedResult = VPackParser::fromJson(expected);
+  CHECK(0 == basics::VelocyPackHelper::compare(expectedResult->slice(),
+                                                queryResult.result->slice(), true));
+}
+
+}
+
+TEST_CASE("PlanCacheTest", "[aql][plancache]") {
+  tests::AqlQuerySetup s;
+  UNUSED(s);
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+  // the cache is global, and may still hold plans of an earlier database at
+  // the same address
+  PlanCache::instance()->invalidate(&vocbase);
+
+  auto* docs = vocbase.createCollection(VPackParser::fromJson("{ \"name\": \"docs\" }")->slice());
+  REQUIRE(nullptr != docs);
+  auto* other = vocbase.createCollection(VPackParser::fromJson("{ \"name\": \"other\" }")->slice());
+  REQUIRE(nullptr != other);
+
+  {
+    OperationOptions opt;
+    TRI_voc_tick_t tick;
+    std::deque<ManagedDocumentResult> inserted;
+
+    transaction::Methods trx(transaction::StandaloneContext::Create(vocbase),
+                             EMPTY, EMPTY, EMPTY, transaction::Options());
+    REQUIRE(trx.begin().ok());
+
+    VPackBuilder doc;
+    for (int i = 0; i < 10; ++i) {
+      doc.clear();
+      doc.openObject();
+      doc.add("name", VPackValue("d" + std::to_string(i)));
+      doc.add("value", VPackValue(i));
+      doc.add("odd", VPackValue(i % 2));
+      doc.close();
+
+      inserted.emplace_back();
+      CHECK(docs->insert(&trx, doc.slice(), inserted.back(), opt, tick, false).ok());
+    }
+    for (int i = 0; i < 2; ++i) {
+      doc.clear();
+      doc.openObject();
+      doc.add("value", VPackValue(100 + i));
+      doc.close();
+
+      inserted.emplace_back();
+      CHECK(other->insert(&trx, doc.slice(), inserted.back(), opt, tick, false).ok());
+    }
+
+    CHECK(trx.commit().ok());
+  }
+
+  SECTION("one plan serves all values of a filter parameter") {
+    std::string const query = "FOR d IN docs FILTER d.value == @value RETURN d.name";
+
+    Figures before;
+    checkCached(vocbase, query, "{ \"value\": 3 }", "[\"d3\"]");
+    Figures afterStore;
+    CHECK(before.hits == afterStore.hits);
+    CHECK(before.misses + 1 == afterStore.misses);
+    CHECK(before.stores + 1 == afterStore.stores);
+
+    checkCached(vocbase, query, "{ \"value\": 7 }", "[\"d7\"]");
+    checkCached(vocbase, query, "{ \"value\": 3 }", "[\"d3\"]");
+    checkCached(vocbase, query, "{ \"value\": 42 }", "[]");
+    Figures afterHits;
+    CHECK(afterStore.hits + 3 == afterHits.hits);
+    CHECK(afterStore.misses == afterHits.misses);
+    CHECK(afterStore.stores == afterHits.stores);
+  }
+
+  SECTION("plans are not reused for other collection parameters") {
+    std::string const query = "FOR d IN @@collection FILTER d.value >= @min RETURN d.value";
+
+    Figures before;
+    checkCached(vocbase, query, "{ \"@collection\": \"docs\", \"min\": 8 }", "[8, 9]");
+    checkCached(vocbase, query, "{ \"@collection\": \"other\", \"min\": 8 }", "[100, 101]");
+    checkCached(vocbase, query, "{ \"@collection\": \"docs\", \"min\": 9 }", "[9]");
+    Figures after;
+    CHECK(before.hits == after.hits);
+    CHECK(before.misses + 3 == after.misses);
+
+    // the last plan can be reused for other filter values
+    checkCached(vocbase, query, "{ \"@collection\": \"docs\", \"min\": 7 }", "[7, 8, 9]");
+    CHECK(after.hits + 1 == Figures().hits);
+  }
+
+  SECTION("plans are not reused for other attribute name parameters") {
+    std::string const query = "FOR d IN docs FILTER d.@attribute == 1 RETURN d.name";
+
+    Figures before;
+    checkCached(vocbase, query, "{ \"attribute\": \"value\" }", "[\"d1\"]");
+    checkCached(vocbase, query, "{ \"attribute\": \"odd\" }",
+                "[\"d1\", \"d3\", \"d5\", \"d7\", \"d9\"]");
+    checkCached(vocbase, query, "{ \"attribute\": \"value\" }", "[\"d1\"]");
+    Figures after;
+    CHECK(before.hits == after.hits);
+    CHECK(before.misses + 3 == after.misses);
+  }
+
+  SECTION("dropping an index invalidates the plans") {
+    bool created = false;
+    auto index = docs->createIndex(
+        nullptr, VPackParser::fromJson("{ \"type\": \"skiplist\", \"fields\": [\"value\"] }")->slice(),
+        created);
+    REQUIRE(nullptr != index);
+
+    std::string const query = "FOR d IN docs SORT d.value DESC LIMIT 2 RETURN d.value";
+    checkCached(vocbase, query, "{ }", "[9, 8]");
+    Figures before;
+    checkCached(vocbase, query, "{ }", "[9, 8]");
+    CHECK(before.hits + 1 == Figures().hits);
+
+    CHECK(docs->dropIndex(index->id()));
+    Figures dropped;
+    CHECK(before.invalidations + 1 == dropped.invalidations);
+
+    // the plan used the index, so it must not be used anymore
+    checkCached(vocbase, query, "{ }", "[9, 8]");
+    Figures after;
+    CHECK(dropped.hits == after.hits);
+    CHECK(dropped.misses + 1 == after.misses);
+    CHECK(dropped.stores + 1 == after.stores);
+  }
+
+  SECTION("dropping a collection invalidates the plans") {
+    std::string const query = "FOR d IN docs FILTER d.value < @max RETURN d.value";
+    checkCached(vocbase, query, "{ \"max\": 2 }", "[0, 1]");
+    Figures before;
+
+    CHECK(vocbase.dropCollection(other->id(), false, -1).ok());
+    Figures dropped;
+    CHECK(before.invalidations + 1 == dropped.invalidations);
+
+    checkCached(vocbase, query, "{ \"max\": 3 }", "[0, 1, 2]");
+    Figures after;
+    CHECK(dropped.hits == after.hits);
+    CHECK(dropped.misses + 1 == after.misses);
+
+    // a query on the dropped collection fails instead of using an old plan
+    auto queryResult = executeQueryWithOptions(vocbase,
+        "FOR d IN @@collection RETURN d", "{ \"usePlanCache\": true }",
+        VPackParser::fromJson("{ \"@collection\": \"other\" }"));
+    CHECK(TRI_ERROR_NO_ERROR != queryResult.code);
+  }
+}
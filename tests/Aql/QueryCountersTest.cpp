@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for QueryCounters
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include "Aql/ExecutionStats.h"
+#include "Aql/QueryCounters.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb::aql;
+
+TEST_CASE("QueryCounters", "[aql][counters]") {
+  SECTION("counting happens only inside of a scope") {
+    QueryCounters counters;
+    QueryCounters::documentCacheLookup(true);
+    CHECK(QueryCounters::current() == nullptr);
+    {
+      QueryCounters::Scope scope(&counters);
+      CHECK(QueryCounters::current() == &counters);
+      QueryCounters::documentCacheLookup(true);
+      QueryCounters::documentCacheLookup(false);
+      QueryCounters::edgeCacheLookup(false);
+      QueryCounters::sent(10);
+      QueryCounters::received(20);
+      QueryCounters::lockWait(0.5);
+    }
+    CHECK(QueryCounters::current() == nullptr);
+    QueryCounters::edgeCacheLookup(true);
+
+    CHECK(counters.documentCacheHits == 1);
+    CHECK(counters.documentCacheMisses == 1);
+    CHECK(counters.edgeCacheHits == 0);
+    CHECK(counters.edgeCacheMisses == 1);
+    CHECK(counters.bytesSent == 10);
+    CHECK(counters.bytesReceived == 20);
+    CHECK(counters.lockWaitTime == 0.5);
+  }
+
+  SECTION("an outer scope keeps counting") {
+    QueryCounters outer;
+    QueryCounters inner;
+    {
+      QueryCounters::Scope a(&outer);
+      {
+        QueryCounters::Scope b(&inner);
+        QueryCounters::sent(1);
+      }
+      CHECK(QueryCounters::current() == &outer);
+      QueryCounters::sent(1);
+    }
+    CHECK(outer.bytesSent == 2);
+    CHECK(inner.bytesSent == 0);
+  }
+
+  SECTION("a stopped scope counts no more") {
+    QueryCounters counters;
+    QueryCounters::Scope scope(&counters);
+    QueryCounters::received(5);
+    scope.stop();
+    QueryCounters::received(5);
+    CHECK(QueryCounters::current() == nullptr);
+    CHECK(counters.bytesReceived == 5);
+  }
+
+  SECTION("execution stats of snippets are summed up") {
+    ExecutionStats stats;
+    stats.counters.documentCacheHits = 3;
+    stats.counters.blockReadBytes = 4096;
+    stats.counters.lockWaitTime = 0.25;
+
+    VPackBuilder builder;
+    stats.toVelocyPack(builder, false);
+    CHECK(builder.slice().get("documentCacheHits").getNumber<uint64_t>() == 3);
+
+    ExecutionStats total;
+    total.counters.documentCacheHits = 1;
+    total.add(ExecutionStats(builder.slice()));
+    CHECK(total.counters.documentCacheHits == 4);
+    CHECK(total.counters.blockReadBytes == 4096);
+    CHECK(total.counters.lockWaitTime == 0.25);
+    CHECK(total.counters.edgeCacheMisses == 0);
+  }
+}
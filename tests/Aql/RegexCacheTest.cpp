@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for the literal matchers of RegexCache
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Aql/RegexCache.h"
+
+using namespace arangodb::aql;
+
+namespace {
+LiteralMatcher const* like(RegexCache& cache, std::string const& pattern) {
+  return cache.buildLiteralLikeMatcher(pattern.data(), pattern.size(), false);
+}
+
+LiteralMatcher const* regex(RegexCache& cache, std::string const& pattern) {
+  return cache.buildLiteralRegexMatcher(pattern.data(), pattern.size(), false);
+}
+
+bool matches(LiteralMatcher const* matcher, std::string const& value) {
+  REQUIRE(matcher != nullptr);
+  return matcher->matches(value.data(), value.size());
+}
+}  // namespace
+
+TEST_CASE("RegexCache", "[aql][regex]") {
+  RegexCache cache;
+
+  SECTION("LIKE patterns with inner wildcards need ICU") {
+    CHECK(like(cache, "a_c") == nullptr);
+    CHECK(like(cache, "a%c") == nullptr);
+    CHECK(like(cache, "%a%c") == nullptr);
+    CHECK(cache.buildLiteralLikeMatcher("abc", 3, true) == nullptr);
+  }
+
+  SECTION("LIKE patterns with wildcards at the ends") {
+    CHECK(matches(like(cache, "abc"), "abc"));
+    CHECK_FALSE(matches(like(cache, "abc"), "abcd"));
+
+    CHECK(matches(like(cache, "abc%"), "abc"));
+    CHECK(matches(like(cache, "abc%"), "abcdef"));
+    CHECK_FALSE(matches(like(cache, "abc%"), "xabc"));
+
+    CHECK(matches(like(cache, "%abc"), "xyzabc"));
+    CHECK_FALSE(matches(like(cache, "%abc"), "abcx"));
+
+    CHECK(matches(like(cache, "%abc%"), "xabcx"));
+    CHECK(matches(like(cache, "%abc%"), "aababc"));
+    CHECK_FALSE(matches(like(cache, "%abc%"), "abab"));
+
+    CHECK(matches(like(cache, "%"), ""));
+    CHECK(matches(like(cache, "%%"), "anything"));
+  }
+
+  SECTION("LIKE escapes") {
+    CHECK(matches(like(cache, "100\\%"), "100%"));
+    CHECK_FALSE(matches(like(cache, "100\\%"), "1000"));
+    CHECK(matches(like(cache, "a\\_b%"), "a_bc"));
+    CHECK(matches(like(cache, "a\\\\b"), "a\\b"));
+    CHECK(matches(like(cache, "a\\b"), "a\\b"));
+    CHECK(matches(like(cache, "a\\.b"), "a.b"));
+  }
+
+  SECTION("LIKE wildcards do not match all line terminators") {
+    CHECK(matches(like(cache, "a%"), "a\r\nb"));
+    CHECK_FALSE(matches(like(cache, "a%"), "a\x0b"));
+    CHECK_FALSE(matches(like(cache, "%a"), "\xe2\x80\xa8" "a"));
+    CHECK_FALSE(matches(like(cache, "%a%"), "\xc2\x85" "a"));
+    // no wildcards, no restriction
+    CHECK(matches(like(cache, "a\x0b"), "a\x0b"));
+  }
+
+  SECTION("REGEX_TEST patterns") {
+    CHECK(regex(cache, "a.c") == nullptr);
+    CHECK(regex(cache, "abc$") == nullptr);
+    CHECK(regex(cache, "") == nullptr);
+
+    CHECK(matches(regex(cache, "bc"), "abcd"));
+    CHECK(matches(regex(cache, "bc"), "a\x0b" "bc"));
+    CHECK_FALSE(matches(regex(cache, "bc"), "acbd"));
+    CHECK(matches(regex(cache, "^ab"), "abcd"));
+    CHECK_FALSE(matches(regex(cache, "^bc"), "abcd"));
+  }
+}
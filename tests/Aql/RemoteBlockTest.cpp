@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for the prefetch state of RemoteBlock
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Aql/ClusterBlocks.h"
+#include "Basics/Result.h"
+#include "Cluster/ClusterComm.h"
+#include "SimpleHttpClient/SimpleHttpResult.h"
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+typedef RemoteBlock::PrefetchState PrefetchState;
+
+TEST_CASE("RemoteBlockTest", "[aql][cluster]") {
+  PrefetchState state;
+  std::shared_ptr<httpclient::SimpleHttpResult> response;
+  Result error;
+
+  ClusterCommResult sent;
+  sent.status = CL_COMM_SENT;
+  sent.result = std::make_shared<httpclient::SimpleHttpResult>();
+
+  SECTION("nothing is taken without a request") {
+    CHECK(PrefetchState::Status::NONE == state.take(response, error));
+    CHECK(nullptr == response);
+  }
+
+  SECTION("a response is kept until it is taken") {
+    state.begin();
+    CHECK(PrefetchState::Status::IN_FLIGHT == state.take(response, error));
+    CHECK(state.waiting);
+
+    // the query waits for the response, so it has to be woken up
+    CHECK(state.deliver(&sent));
+    CHECK(!state.waiting);
+
+    CHECK(PrefetchState::Status::ARRIVED == state.take(response, error));
+    CHECK(sent.result == response);
+    CHECK(error.ok());
+
+    // a response is only taken once
+    response.reset();
+    CHECK(PrefetchState::Status::NONE == state.take(response, error));
+    CHECK(nullptr == response);
+
+    // the next request can be sent now
+    state.begin();
+    CHECK(state.inFlight);
+  }
+
+  SECTION("the query is not woken up if it does not wait") {
+    state.begin();
+    CHECK(!state.deliver(&sent));
+    CHECK(PrefetchState::Status::ARRIVED == state.take(response, error));
+    CHECK(sent.result == response);
+  }
+
+  SECTION("errors are kept until they are taken") {
+    ClusterCommResult timeout;
+    timeout.status = CL_COMM_TIMEOUT;
+
+    state.begin();
+    CHECK(!state.deliver(&timeout));
+    CHECK(PrefetchState::Status::ARRIVED == state.take(response, error));
+    CHECK(nullptr == response);
+    CHECK(error.is(TRI_ERROR_CLUSTER_TIMEOUT));
+  }
+
+  SECTION("responses for a destroyed block are dropped") {
+    state.begin();
+    CHECK(PrefetchState::Status::IN_FLIGHT == state.take(response, error));
+    state.orphan();
+
+    // the block is gone, so nobody must be woken up
+    CHECK(!state.deliver(&sent));
+    CHECK(!state.inFlight);
+    CHECK(!state.arrived);
+    CHECK(nullptr == state.response);
+  }
+
+  SECTION("a request that could not be sent is not waited for") {
+    state.begin();
+    state.cancel();
+    CHECK(PrefetchState::Status::NONE == state.take(response, error));
+    CHECK(!state.waiting);
+  }
+}
@@ -0,0 +1,251 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for computing the batches of query snippets ahead
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "AqlQuerySetup.h"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/ExecutionEngine.h"
+#include "Aql/SnippetPrefetch.h"
+#include "Basics/Mutex.h"
+#include "Basics/MutexLocker.h"
+#include "RestServer/QueryRegistryFeature.h"
+
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <thread>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+
+/// @brief runs every job on a thread of its own instead of the scheduler
+class ThreadPrefetch final : public SnippetPrefetch {
+ public:
+  explicit ThreadPrefetch(Query* query) : SnippetPrefetch(query) {}
+
+  ~ThreadPrefetch() {
+    // jobs that did not start yet return at once, running ones are waited
+    // for by the base class
+    MUTEX_LOCKER(guard, _lock);
+    for (auto& it : _threads) {
+      it.detach();
+    }
+  }
+
+  /// @brief waits for all jobs posted so far
+  void join() {
+    std::vector<std::thread> threads;
+    {
+      MUTEX_LOCKER(guard, _lock);
+      threads.swap(_threads);
+    }
+    for (auto& it : threads) {
+      it.join();
+    }
+  }
+
+ protected:
+  bool post(std::function<void()> job) override {
+    MUTEX_LOCKER(guard, _lock);
+    _threads.emplace_back(std::move(job));
+    return true;
+  }
+
+ private:
+  Mutex _lock;
+  std::vector<std::thread> _threads;
+};
+
+/// @brief a prepared query that stands in for a snippet
+std::unique_ptr<Query> prepareQuery(TRI_vocbase_t& vocbase, std::string const& queryString) {
+  auto query = std::make_unique<Query>(false, vocbase, QueryString(queryString), nullptr,
+                                       VPackParser::fromJson("{ }"), PART_MAIN);
+  query->prepare(QueryRegistryFeature::QUERY_REGISTRY, Query::DontCache);
+  return query;
+}
+
+/// @brief appends the values of a batch
+void appendValues(Query& query, AqlItemBlock const* items, std::vector<int64_t>& result) {
+  if (items == nullptr) {
+    return;
+  }
+  RegisterId const reg = query.engine()->resultRegister();
+  for (size_t i = 0; i < items->size(); ++i) {
+    result.emplace_back(items->getValueReference(i, reg).toInt64(query.trx()));
+  }
+}
+
+/// @brief reads the snippet like the handler does: takes the batch
+/// computed ahead, or computes it if there is none, and schedules the next
+/// one while the caller still works on the current batch. returns false if
+/// something went wrong, so that it can run on other threads than Catch's
+bool readAll(Query& query, SnippetPrefetch& prefetch, size_t atMost,
+             std::vector<int64_t>& result) {
+  ExecutionState state = ExecutionState::HASMORE;
+  while (state != ExecutionState::DONE) {
+    std::unique_ptr<AqlItemBlock> items;
+    Result res;
+    if (!prefetch.take(state, items, res)) {
+      std::tie(state, items) = query.engine()->getSome(atMost);
+    } else if (res.fail()) {
+      return false;
+    }
+    if (state == ExecutionState::WAITING) {
+      return false;
+    }
+    if (state == ExecutionState::HASMORE) {
+      prefetch.schedule(atMost);
+    }
+    appendValues(query, items.get(), result);
+  }
+  return true;
+}
+
+std::vector<int64_t> range(int64_t from, int64_t to) {
+  std::vector<int64_t> result;
+  for (int64_t i = from; i <= to; ++i) {
+    result.emplace_back(i);
+  }
+  return result;
+}
+
+}
+
+TEST_CASE("SnippetPrefetchTest", "[aql][cluster]") {
+  tests::AqlQuerySetup s;
+  UNUSED(s);
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+
+  SECTION("snippets sharing their transaction do not compute ahead") {
+    auto query = prepareQuery(vocbase, "FOR i IN 1..10 RETURN i");
+    CHECK(nullptr == SnippetPrefetch::create(query.get(), true));
+  }
+
+  SECTION("batches computed ahead are the batches of the snippet") {
+    auto query = prepareQuery(vocbase, "FOR i IN 1..5000 RETURN i");
+    std::vector<int64_t> result;
+    {
+      ThreadPrefetch prefetch(query.get());
+      CHECK(readAll(*query, prefetch, 100, result));
+      prefetch.join();
+    }
+    CHECK((range(1, 5000) == result));
+  }
+
+  SECTION("unused rows are taken again") {
+    auto query = prepareQuery(vocbase, "FOR i IN 1..500 RETURN i");
+    std::vector<int64_t> result;
+    ThreadPrefetch prefetch(query.get());
+
+    prefetch.schedule(200);
+    prefetch.join();
+
+    ExecutionState state;
+    std::unique_ptr<AqlItemBlock> items;
+    Result res;
+    REQUIRE(prefetch.take(state, items, res));
+    REQUIRE(res.ok());
+    CHECK(ExecutionState::HASMORE == state);
+    REQUIRE(nullptr != items);
+    REQUIRE(1 < items->size());
+
+    // hand back the second half of the rows, as a getSome for fewer rows
+    // than were computed ahead does
+    size_t const used = items->size() / 2;
+    std::unique_ptr<AqlItemBlock> rest(items->slice(used, items->size()));
+    std::unique_ptr<AqlItemBlock> first(items->slice(0, used));
+    prefetch.putBack(state, std::move(rest));
+    appendValues(*query, first.get(), result);
+
+    CHECK(readAll(*query, prefetch, 200, result));
+    prefetch.join();
+    CHECK((range(1, 500) == result));
+
+    // nothing is left once the snippet is done
+    CHECK(!prefetch.take(state, items, res));
+  }
+
+  SECTION("discarded batches are not returned") {
+    auto query = prepareQuery(vocbase, "FOR i IN 1..500 RETURN i");
+    ThreadPrefetch prefetch(query.get());
+
+    prefetch.schedule(100);
+    prefetch.discard();
+    prefetch.join();
+
+    ExecutionState state;
+    std::unique_ptr<AqlItemBlock> items;
+    Result res;
+    CHECK(!prefetch.take(state, items, res));
+  }
+
+  SECTION("the prefetcher can go away while its job runs") {
+    for (size_t i = 0; i < 20; ++i) {
+      auto query = prepareQuery(vocbase, "FOR i IN 1..20000 RETURN i");
+      auto prefetch = std::make_unique<ThreadPrefetch>(query.get());
+      prefetch->schedule(10000);
+      // waits for a running job, a queued one does not start anymore
+      prefetch.reset();
+    }
+  }
+
+  SECTION("snippets with transactions of their own compute ahead concurrently") {
+    size_t const numSnippets = 4;
+    std::vector<std::unique_ptr<Query>> queries;
+    std::vector<std::unique_ptr<ThreadPrefetch>> prefetches;
+    for (size_t i = 0; i < numSnippets; ++i) {
+      queries.emplace_back(prepareQuery(vocbase, "FOR i IN 1..3000 RETURN i * " + std::to_string(i + 1)));
+      prefetches.emplace_back(std::make_unique<ThreadPrefetch>(queries.back().get()));
+    }
+
+    // every reader and every job of a snippet runs on a thread of its own
+    std::vector<std::vector<int64_t>> results(numSnippets);
+    std::vector<char> ok(numSnippets, 0);
+    std::vector<std::thread> readers;
+    for (size_t i = 0; i < numSnippets; ++i) {
+      readers.emplace_back([&, i]() {
+        ok[i] = readAll(*queries[i], *prefetches[i], 50, results[i]) ? 1 : 0;
+      });
+    }
+    for (auto& it : readers) {
+      it.join();
+    }
+
+    for (size_t i = 0; i < numSnippets; ++i) {
+      prefetches[i]->join();
+      INFO("snippet " << i);
+      CHECK(1 == ok[i]);
+      std::vector<int64_t> expected;
+      for (int64_t v : range(1, 3000)) {
+        expected.emplace_back(v * static_cast<int64_t>(i + 1));
+      }
+      CHECK((expected == results[i]));
+    }
+    prefetches.clear();
+  }
+}
@@ -0,0 +1,262 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for the result cache of query snippets
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "AqlQuerySetup.h"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/QueryCache.h"
+#include "Aql/SnippetResultCache.h"
+#include "Basics/VelocyPackHelper.h"
+#include "RestServer/QueryRegistryFeature.h"
+#include "VocBase/LogicalCollection.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+
+std::string const READ = "[{ \"name\": \"docs\", \"type\": \"READ\" }]";
+std::string const VARIABLES = "[{ \"id\": 0, \"name\": \"d\" }]";
+
+/// @brief a prepared query, whose plan stands in for the snippet's plan
+std::unique_ptr<Query> prepareQuery(TRI_vocbase_t& vocbase, std::string const& queryString,
+                                    std::string const& options) {
+  auto query = std::make_unique<Query>(false, vocbase, QueryString(queryString), nullptr,
+                                       VPackParser::fromJson(options), PART_MAIN);
+  query->prepare(QueryRegistryFeature::QUERY_REGISTRY, Query::DontCache);
+  return query;
+}
+
+/// @brief creates the cache for the snippet given by its nodes
+std::unique_ptr<SnippetResultCache> createCache(Query& query, std::string const& nodes,
+                                                std::string const& variables = VARIABLES,
+                                                std::string const& collections = READ) {
+  auto n = VPackParser::fromJson(nodes);
+  auto v = VPackParser::fromJson(variables);
+  auto c = VPackParser::fromJson(collections);
+  return SnippetResultCache::create(&query, n->slice(), v->slice(), c->slice());
+}
+
+/// @brief a block with one register, holding the values from..to-1
+std::unique_ptr<AqlItemBlock> makeBlock(Query& query, int64_t from, int64_t to) {
+  auto items = std::make_unique<AqlItemBlock>(query.resourceMonitor(),
+                                              static_cast<size_t>(to - from), 1);
+  for (int64_t i = from; i < to; ++i) {
+    items->emplaceValue(static_cast<size_t>(i - from), 0, AqlValueHintInt(i));
+  }
+  return items;
+}
+
+/// @brief the values of a getSome answer served from the cache
+std::vector<int64_t> values(Query& query, VPackSlice answer) {
+  AqlItemBlock items(query.resourceMonitor(), answer);
+  std::vector<int64_t> result;
+  for (size_t i = 0; i < items.size(); ++i) {
+    result.emplace_back(items.getValueReference(i, 0).toInt64(query.trx()));
+  }
+  return result;
+}
+
+}
+
+TEST_CASE("SnippetResultCacheTest", "[aql][cache]") {
+  tests::AqlQuerySetup s;
+  UNUSED(s);
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+
+  auto* docs = vocbase.createCollection(VPackParser::fromJson("{ \"name\": \"docs\" }")->slice());
+  REQUIRE(nullptr != docs);
+
+  std::pair<std::string, size_t> properties;
+  QueryCache::instance()->properties(properties);
+  QueryCache::instance()->setProperties(std::make_pair(std::string("demand"), size_t(128)));
+  QueryCache::instance()->invalidate(&vocbase);
+
+  std::string const cached = "{ \"cache\": true }";
+  std::string const nodes = "[{ \"type\": \"EnumerateCollectionNode\", \"collection\": \"s100\" }]";
+
+  SECTION("snippets that read deterministically are cacheable") {
+    auto query = prepareQuery(vocbase, "FOR d IN docs FILTER d.value > 1 RETURN d", cached);
+    CHECK(nullptr != createCache(*query, nodes));
+  }
+
+  SECTION("snippets are not cached if the query does not ask for it") {
+    auto query = prepareQuery(vocbase, "FOR d IN docs RETURN d", "{ \"cache\": false }");
+    CHECK(nullptr == createCache(*query, nodes));
+
+    // nor if the cache is turned off
+    query = prepareQuery(vocbase, "FOR d IN docs RETURN d", cached);
+    QueryCache::instance()->setProperties(std::make_pair(std::string("off"), size_t(128)));
+    CHECK(nullptr == createCache(*query, nodes));
+    QueryCache::instance()->setProperties(std::make_pair(std::string("demand"), size_t(128)));
+  }
+
+  SECTION("snippets of queries with fullCount are not cached") {
+    auto query = prepareQuery(vocbase, "FOR d IN docs LIMIT 2 RETURN d",
+                              "{ \"cache\": true, \"fullCount\": true }");
+    CHECK(nullptr == createCache(*query, nodes));
+  }
+
+  SECTION("snippets of writing queries are not cached") {
+    auto query = prepareQuery(vocbase, "FOR d IN docs RETURN d", cached);
+    CHECK(nullptr == createCache(*query, nodes, VARIABLES,
+                                 "[{ \"name\": \"docs\", \"type\": \"READ\" }, "
+                                 "{ \"name\": \"other\", \"type\": \"WRITE\" }]"));
+
+    query = prepareQuery(vocbase, "FOR i IN 1..3 INSERT { value: i } INTO docs", cached);
+    CHECK(nullptr == createCache(*query, nodes));
+
+    query = prepareQuery(vocbase, "FOR d IN docs REMOVE d IN docs", cached);
+    CHECK(nullptr == createCache(*query, nodes));
+  }
+
+  SECTION("non-deterministic snippets are not cached") {
+    auto query = prepareQuery(vocbase, "FOR d IN docs RETURN RAND()", cached);
+    CHECK(nullptr == createCache(*query, nodes));
+
+    query = prepareQuery(vocbase, "FOR d IN docs LET s = (FOR i IN 1..2 RETURN RAND()) RETURN s",
+                         cached);
+    CHECK(nullptr == createCache(*query, nodes));
+  }
+
+  SECTION("results are stored and served under the snippet's plan") {
+    auto query = prepareQuery(vocbase, "FOR d IN docs RETURN d", cached);
+
+    // nothing cached yet, the snippet collects its own result
+    auto producer = createCache(*query, nodes);
+    REQUIRE(nullptr != producer);
+    producer->initializeCursor(false);
+    VPackBuilder answer;
+    answer.openObject();
+    CHECK(!producer->getSome(query.get(), 1000, answer));
+    answer.close();
+
+    auto first = makeBlock(*query, 0, 3);
+    auto second = makeBlock(*query, 3, 5);
+    producer->collect(query.get(), first.get(), false, false);
+    producer->collect(query.get(), second.get(), true, false);
+
+    // a snippet with the same plan gets the result block by block
+    auto consumer = createCache(*query, nodes);
+    REQUIRE(nullptr != consumer);
+    consumer->initializeCursor(false);
+    answer.clear();
+    answer.openObject();
+    REQUIRE(consumer->getSome(query.get(), 1000, answer));
+    answer.close();
+    CHECK((std::vector<int64_t>{0, 1, 2}) == values(*query, answer.slice()));
+    CHECK(!answer.slice().get("done").getBool());
+
+    // parts of a block
+    answer.clear();
+    answer.openObject();
+    REQUIRE(consumer->getSome(query.get(), 1, answer));
+    answer.close();
+    CHECK((std::vector<int64_t>{3}) == values(*query, answer.slice()));
+    CHECK(!answer.slice().get("done").getBool());
+
+    size_t skipped = 0;
+    CHECK(consumer->skipSome(query.get(), 10, skipped));
+    CHECK(1 == skipped);
+
+    answer.clear();
+    answer.openObject();
+    REQUIRE(consumer->getSome(query.get(), 1000, answer));
+    answer.close();
+    CHECK(answer.slice().get("done").getBool());
+
+    // another plan, e.g. on another shard or with another bind parameter
+    // value, does not see the result
+    for (auto const& it : std::vector<std::pair<std::string, std::string>>{
+             {"[{ \"type\": \"EnumerateCollectionNode\", \"collection\": \"s101\" }]", VARIABLES},
+             {nodes, "[{ \"id\": 1, \"name\": \"d\" }]"}}) {
+      auto other = createCache(*query, it.first, it.second);
+      REQUIRE(nullptr != other);
+      other->initializeCursor(false);
+      answer.clear();
+      answer.openObject();
+      CHECK(!other->getSome(query.get(), 1000, answer));
+      answer.close();
+    }
+
+    // with input rows, the result depends on the input
+    consumer->initializeCursor(true);
+    answer.clear();
+    answer.openObject();
+    CHECK(!consumer->getSome(query.get(), 1000, answer));
+    answer.close();
+    CHECK(!consumer->skipSome(query.get(), 1000, skipped));
+
+    // writes to the snippet's collections invalidate the result
+    QueryCache::instance()->invalidate(&vocbase, "docs");
+    consumer->initializeCursor(false);
+    answer.clear();
+    answer.openObject();
+    CHECK(!consumer->getSome(query.get(), 1000, answer));
+    answer.close();
+  }
+
+  SECTION("incomplete results and results with warnings are not stored") {
+    auto query = prepareQuery(vocbase, "FOR d IN docs RETURN d", cached);
+    auto block = makeBlock(*query, 0, 3);
+    VPackBuilder answer;
+
+    auto producer = createCache(*query, nodes);
+    REQUIRE(nullptr != producer);
+    producer->initializeCursor(false);
+    answer.openObject();
+    CHECK(!producer->getSome(query.get(), 1000, answer));
+    answer.close();
+    producer->collect(query.get(), block.get(), true, true);
+
+    auto consumer = createCache(*query, nodes);
+    REQUIRE(nullptr != consumer);
+    consumer->initializeCursor(false);
+    answer.clear();
+    answer.openObject();
+    CHECK(!consumer->getSome(query.get(), 1000, answer));
+    answer.close();
+
+    // the skipped rows are missing from the collected result
+    producer->initializeCursor(false);
+    size_t skipped = 0;
+    CHECK(!producer->skipSome(query.get(), 1, skipped));
+    producer->collect(query.get(), block.get(), true, false);
+
+    consumer->initializeCursor(false);
+    answer.clear();
+    answer.openObject();
+    CHECK(!consumer->getSome(query.get(), 1000, answer));
+    answer.close();
+  }
+
+  QueryCache::instance()->invalidate(&vocbase);
+  QueryCache::instance()->setProperties(properties);
+}
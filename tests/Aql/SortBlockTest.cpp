@@ -0,0 +1,255 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for SortBlock
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "AqlQuerySetup.h"
+
+#include "Aql/OptimizerRule.h"
+#include "Aql/SpillFile.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Basics/files.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <set>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+using arangodb::tests::executeQueryWithOptions;
+
+namespace {
+
+/// @brief runs the query once in memory and once with a spill threshold
+/// of a few rows, and checks that both return the same rows in the same
+/// order
+void checkSpilledOrder(TRI_vocbase_t& vocbase, std::string const& queryString,
+                       size_t expectedRows) {
+  auto inMemory = executeQueryWithOptions(vocbase, queryString, "{ \"sortSpillThreshold\": 0 }");
+  REQUIRE(TRI_ERROR_NO_ERROR == inMemory.code);
+  auto spilled = executeQueryWithOptions(vocbase, queryString, "{ \"sortSpillThreshold\": 7 }");
+  REQUIRE(TRI_ERROR_NO_ERROR == spilled.code);
+
+  VPackSlice expected = inMemory.result->slice();
+  VPackSlice actual = spilled.result->slice();
+  REQUIRE(expected.isArray());
+  REQUIRE(actual.isArray());
+  REQUIRE(expectedRows == expected.length());
+  REQUIRE(expectedRows == actual.length());
+
+  VPackArrayIterator it(expected);
+  for (auto const& row : VPackArrayIterator(actual)) {
+    CHECK(0 == basics::VelocyPackHelper::compare(it.value(), row, true));
+    it.next();
+  }
+}
+
+/// @brief runs the query with and without the top rows mode of the sort,
+/// checks that the mode was used and that both return the same rows in the
+/// same order. returns the result of the query
+std::shared_ptr<VPackBuilder> checkTopRows(TRI_vocbase_t& vocbase,
+                                           std::string const& queryString,
+                                           size_t expectedRows) {
+  CHECK(tests::assertRules(vocbase, queryString, {OptimizerRule::sortLimitRule_pass9}));
+
+  auto limited = executeQueryWithOptions(vocbase, queryString, "{ }");
+  REQUIRE(TRI_ERROR_NO_ERROR == limited.code);
+  auto full = executeQueryWithOptions(
+      vocbase, queryString, "{ \"optimizer\": { \"rules\": [\"-sort-limit\"] } }");
+  REQUIRE(TRI_ERROR_NO_ERROR == full.code);
+
+  REQUIRE(limited.result->slice().isArray());
+  CHECK(expectedRows == limited.result->slice().length());
+  CHECK(0 == basics::VelocyPackHelper::compare(full.result->slice(),
+                                                limited.result->slice(), true));
+  return limited.result;
+}
+
+}
+
+TEST_CASE("SortBlockTest", "[aql][sort]") {
+  SECTION("a spill file returns its rows in order") {
+    std::string filename;
+    {
+      SpillFile file;
+      filename = file.filename();
+      CHECK(TRI_ExistsFile(filename.c_str()));
+
+      VPackBuilder row;
+      // some rows are larger than the internal buffer of the file
+      for (size_t i = 0; i < 5000; ++i) {
+        row.clear();
+        row.openArray();
+        row.add(VPackValue(i));
+        row.add(VPackValue(std::string(i % 1000 == 999 ? 5 * 1024 * 1024 : i, 'x')));
+        row.close();
+        file.append(row.slice());
+      }
+      CHECK(5000 == file.size());
+      file.finish();
+
+      size_t i = 0;
+      while (file.next()) {
+        VPackSlice current = file.current();
+        REQUIRE(current.isArray());
+        CHECK(i == current.at(0).getNumber<size_t>());
+        CHECK((i % 1000 == 999 ? 5 * 1024 * 1024 : i) == current.at(1).getStringLength());
+        ++i;
+      }
+      CHECK(5000 == i);
+      CHECK(!file.next());
+    }
+    // the file is removed together with the object
+    CHECK(!TRI_ExistsFile(filename.c_str()));
+  }
+
+  SECTION("merged runs are returned in sort order") {
+    tests::AqlQuerySetup s;
+    UNUSED(s);
+    TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+
+    // many more rows than the spill threshold, arriving in several batches
+    auto queryResult = executeQueryWithOptions(
+        vocbase,
+        "FOR i IN 1..5003 LET k = (i * 7919) % 5003 SORT k RETURN [k, i]",
+        "{ \"sortSpillThreshold\": 7 }");
+    REQUIRE(TRI_ERROR_NO_ERROR == queryResult.code);
+
+    VPackSlice result = queryResult.result->slice();
+    REQUIRE(result.isArray());
+    CHECK(5003 == result.length());
+
+    int64_t expected = 0;
+    for (auto const& row : VPackArrayIterator(result)) {
+      CHECK(expected == row.at(0).getNumber<int64_t>());
+      // the other registers of a row are carried through the spill
+      CHECK(expected == (row.at(1).getNumber<int64_t>() * 7919) % 5003);
+      ++expected;
+    }
+  }
+
+  SECTION("spilling does not change the result") {
+    tests::AqlQuerySetup s;
+    UNUSED(s);
+    TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+
+    checkSpilledOrder(vocbase,
+        "FOR i IN 1..3000 SORT i % 17 DESC, i ASC RETURN i", 3000);
+    checkSpilledOrder(vocbase,
+        "FOR i IN 1..3000 SORT CONCAT('value', i % 100), i RETURN { i, s: CONCAT('value', i % 100) }", 3000);
+    // mixed types and nulls
+    checkSpilledOrder(vocbase,
+        "FOR i IN 1..2500 LET v = i % 5 == 0 ? null : (i % 2 == 0 ? i : TO_STRING(i)) SORT v RETURN v", 2500);
+    // fewer rows than the threshold, nothing is spilled
+    checkSpilledOrder(vocbase, "FOR i IN 1..5 SORT -i RETURN i", 5);
+    checkSpilledOrder(vocbase, "FOR i IN [] SORT i RETURN i", 0);
+  }
+
+  SECTION("only the top rows of a sort are kept for a LIMIT") {
+    tests::AqlQuerySetup s;
+    UNUSED(s);
+    TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+
+    // many input blocks, so that the buffer is reduced several times
+    auto result = checkTopRows(vocbase,
+        "FOR i IN 1..20000 LET k = (i * 7919) % 20011 SORT k LIMIT 10 RETURN k", 10);
+    int64_t previous = -1;
+    for (auto const& it : VPackArrayIterator(result->slice())) {
+      CHECK(previous < it.getNumber<int64_t>());
+      previous = it.getNumber<int64_t>();
+    }
+
+    // with an offset, descending and on several attributes
+    result = checkTopRows(vocbase,
+        "FOR i IN 1..5000 SORT i % 7 DESC, i DESC LIMIT 1500, 20 RETURN i", 20);
+    // 714 values each with a remainder of 6 and of 5, so the 1501st row is
+    // the 73rd largest value with a remainder of 4
+    int64_t expected = 4995 - 7 * 72;
+    for (auto const& it : VPackArrayIterator(result->slice())) {
+      CHECK(expected == it.getNumber<int64_t>());
+      expected -= 7;
+    }
+
+    // the top rows of strings and mixed types
+    checkTopRows(vocbase,
+        "FOR i IN 1..3000 SORT CONCAT('value', i % 100) DESC, i LIMIT 7 RETURN i", 7);
+    checkTopRows(vocbase,
+        "FOR i IN 1..3000 LET v = i % 5 == 0 ? null : (i % 2 == 0 ? i : TO_STRING(i)) "
+        "SORT v, i LIMIT 100 RETURN v", 100);
+  }
+
+  SECTION("rows with equal sort keys") {
+    tests::AqlQuerySetup s;
+    UNUSED(s);
+    TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+
+    // the sort is not stable, so only the keys of ties are defined
+    std::string const query = "FOR i IN 1..5000 SORT i % 10 LIMIT 25 RETURN i";
+    CHECK(tests::assertRules(vocbase, query, {OptimizerRule::sortLimitRule_pass9}));
+    auto queryResult = executeQueryWithOptions(vocbase, query, "{ }");
+    REQUIRE(TRI_ERROR_NO_ERROR == queryResult.code);
+    REQUIRE(25 == queryResult.result->slice().length());
+    std::set<int64_t> seen;
+    for (auto const& it : VPackArrayIterator(queryResult.result->slice())) {
+      int64_t const value = it.getNumber<int64_t>();
+      CHECK(0 == value % 10);
+      CHECK(seen.emplace(value).second);
+    }
+
+    // the ties at the end of the limit are cut off
+    auto result = checkTopRows(vocbase,
+        "FOR i IN 1..5000 SORT i % 10, i LIMIT 25 RETURN i", 25);
+    int64_t expected = 10;
+    for (auto const& it : VPackArrayIterator(result->slice())) {
+      CHECK(expected == it.getNumber<int64_t>());
+      expected += 10;
+    }
+  }
+
+  SECTION("limits beyond the input and zero limits") {
+    tests::AqlQuerySetup s;
+    UNUSED(s);
+    TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+
+    // all rows are returned
+    auto result = checkTopRows(vocbase, "FOR i IN 1..100 SORT i DESC LIMIT 500 RETURN i", 100);
+    int64_t expected = 100;
+    for (auto const& it : VPackArrayIterator(result->slice())) {
+      CHECK(expected == it.getNumber<int64_t>());
+      --expected;
+    }
+    checkTopRows(vocbase, "FOR i IN 1..100 SORT i LIMIT 90, 50 RETURN i", 10);
+    checkTopRows(vocbase, "FOR i IN 1..100 SORT i LIMIT 200, 50 RETURN i", 0);
+    checkTopRows(vocbase, "FOR i IN 1..100 FILTER i > 200 SORT i LIMIT 5 RETURN i", 0);
+
+    // a LIMIT of 0 does not make the sort keep any rows
+    std::string const query = "FOR i IN 1..100 SORT i LIMIT 0 RETURN i";
+    CHECK(!tests::assertRules(vocbase, query, {OptimizerRule::sortLimitRule_pass9}));
+    auto queryResult = executeQueryWithOptions(vocbase, query, "{ }");
+    REQUIRE(TRI_ERROR_NO_ERROR == queryResult.code);
+    CHECK(0 == queryResult.result->slice().length());
+  }
+}
@@ -0,0 +1,395 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for the sorting strategies of SortingGatherBlock
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "AqlQuerySetup.h"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/ClusterBlocks.h"
+#include "Aql/ExecutionPlan.h"
+#include "Aql/Query.h"
+#include "Aql/Variable.h"
+#include "Basics/VelocyPackHelper.h"
+#include "RestServer/QueryRegistryFeature.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <algorithm>
+#include <deque>
+#include <random>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+
+/// @brief the register holding the position of a row in the input, the
+/// sort values are in the registers after it
+RegisterId const ID = 0;
+
+/// @brief sort elements on the registers 1..n, and their registers
+class SortElements {
+ public:
+  SortElements(Query& query, std::vector<std::pair<bool, std::vector<std::string>>> const& elements) {
+    for (size_t i = 0; i < elements.size(); ++i) {
+      _variables.emplace_back(std::make_unique<Variable>("v" + std::to_string(i), i));
+      _elements.emplace_back(_variables.back().get(), elements[i].first, elements[i].second);
+      _registerPlan.varInfo.emplace(i, ExecutionNode::VarInfo(1, static_cast<RegisterId>(i + 1)));
+    }
+    SortRegister::fill(*query.plan(), _registerPlan, _elements, registers);
+  }
+
+  std::vector<SortRegister> registers;
+
+ private:
+  std::vector<std::unique_ptr<Variable>> _variables;
+  std::vector<SortElement> _elements;
+  ExecutionNode::RegisterPlan _registerPlan;
+};
+
+/// @brief the value of a sort element in a row, as read by the strategy
+VPackSlice sortValue(VPackSlice row, size_t r, SortRegister const& reg) {
+  VPackSlice value = row.at(r);
+  if (!reg.attributePath.empty()) {
+    value = value.get(reg.attributePath);
+    if (value.isNone()) {
+      value = VPackSlice::nullSlice();
+    }
+  }
+  return value;
+}
+
+/// @brief compares two rows in the order of the sort elements
+int compareRows(std::vector<SortRegister> const& registers, VPackSlice lhs, VPackSlice rhs) {
+  for (size_t r = 0; r < registers.size(); ++r) {
+    int cmp = basics::VelocyPackHelper::compare(sortValue(lhs, r, registers[r]),
+                                                sortValue(rhs, r, registers[r]), true);
+    if (cmp != 0) {
+      return registers[r].asc ? cmp : -cmp;
+    }
+  }
+  return 0;
+}
+
+/// @brief merges the dependencies like SortingGatherBlock does. each
+/// dependency is an array of rows sorted by the sort elements, a row is an
+/// array with a value for each sort element. dependencies hand out blocks of
+/// at most blockSize rows, and at most batchSize rows are merged before the
+/// buffers are refilled. returns the position of each row, counting the rows
+/// of all dependencies in order
+std::vector<int64_t> merge(Query& query, GatherNode::SortMode mode,
+                           std::vector<SortRegister>& registers,
+                           VPackSlice dependencies, size_t blockSize, size_t batchSize) {
+  size_t const n = dependencies.length();
+  RegisterId const nrRegs = static_cast<RegisterId>(registers.size() + 1);
+
+  // the blocks each dependency will hand out
+  std::vector<std::deque<std::unique_ptr<AqlItemBlock>>> upstream(n);
+  int64_t id = 0;
+  for (size_t i = 0; i < n; ++i) {
+    VPackSlice rows = dependencies.at(i);
+    size_t const length = rows.length();
+    for (size_t from = 0; from < length; from += blockSize) {
+      size_t const size = (std::min)(blockSize, length - from);
+      auto block = std::make_unique<AqlItemBlock>(query.resourceMonitor(), size, nrRegs);
+      for (size_t row = 0; row < size; ++row) {
+        block->emplaceValue(row, ID, AqlValueHintInt(id++));
+        VPackSlice values = rows.at(from + row);
+        for (RegisterId r = 1; r < nrRegs; ++r) {
+          block->emplaceValue(row, r, AqlValueHintCopy(values.at(r - 1).begin()));
+        }
+      }
+      upstream[i].emplace_back(std::move(block));
+    }
+  }
+
+  std::vector<std::deque<AqlItemBlock*>> buffer(n);
+  std::vector<SortingStrategy::ValueType> blockPos(n);
+  auto strategy = SortingStrategy::create(mode, query.trx(), buffer, registers);
+  std::vector<int64_t> result;
+
+  try {
+    while (true) {
+      // refill the buffers, see SortingGatherBlock::fillBuffers
+      size_t available = 0;
+      for (size_t i = 0; i < n; ++i) {
+        if (buffer[i].empty()) {
+          blockPos[i] = std::make_pair(i, 0);
+        }
+        size_t rows = 0;
+        for (auto const& it : buffer[i]) {
+          rows += it->size();
+        }
+        rows -= blockPos[i].second;
+        while (rows < batchSize && !upstream[i].empty()) {
+          rows += upstream[i].front()->size();
+          buffer[i].emplace_back(upstream[i].front().release());
+          upstream[i].pop_front();
+        }
+        available += rows;
+      }
+      if (available == 0) {
+        break;
+      }
+
+      size_t const toSend = (std::min)(available, batchSize);
+      strategy->prepare(blockPos);
+      for (size_t k = 0; k < toSend; ++k) {
+        auto const val = strategy->nextValue();
+        auto& blocks = buffer[val.first];
+        REQUIRE(!blocks.empty());
+        REQUIRE(val.second == blockPos[val.first].second);
+        result.emplace_back(blocks.front()->getValueReference(val.second, ID).toInt64(query.trx()));
+
+        // see SortingGatherBlock::nextRow
+        if (++blockPos[val.first].second == blocks.front()->size()) {
+          delete blocks.front();
+          blocks.pop_front();
+          blockPos[val.first].second = 0;
+        }
+      }
+    }
+  } catch (...) {
+    for (auto& blocks : buffer) {
+      for (auto& it : blocks) {
+        delete it;
+      }
+    }
+    throw;
+  }
+
+  strategy->reset();
+  return result;
+}
+
+/// @brief the positions of all rows after a stable sort, i.e. equal rows
+/// are ordered by dependency and by their order within the dependency
+std::vector<int64_t> expected(std::vector<SortRegister> const& registers, VPackSlice dependencies) {
+  std::vector<VPackSlice> rows;
+  for (auto const& dependency : VPackArrayIterator(dependencies)) {
+    for (auto const& row : VPackArrayIterator(dependency)) {
+      rows.emplace_back(row);
+    }
+  }
+
+  std::vector<int64_t> result(rows.size());
+  for (size_t i = 0; i < result.size(); ++i) {
+    result[i] = static_cast<int64_t>(i);
+  }
+  std::stable_sort(result.begin(), result.end(), [&](int64_t lhs, int64_t rhs) {
+    return compareRows(registers, rows[lhs], rows[rhs]) < 0;
+  });
+  return result;
+}
+
+/// @brief random dependencies with the given numbers of rows, each row with
+/// integer sort values in 0..range-1, sorted in the order of the elements
+std::shared_ptr<VPackBuilder> randomDependencies(std::vector<SortRegister> const& registers,
+                                                 std::vector<size_t> const& sizes,
+                                                 int range, std::mt19937& random) {
+  auto result = std::make_shared<VPackBuilder>();
+  result->openArray();
+  for (auto size : sizes) {
+    VPackBuilder rows;
+    rows.openArray();
+    for (size_t i = 0; i < size; ++i) {
+      rows.openArray();
+      for (size_t r = 0; r < registers.size(); ++r) {
+        rows.add(VPackValue(static_cast<int>(random() % range)));
+      }
+      rows.close();
+    }
+    rows.close();
+
+    std::vector<VPackSlice> sorted;
+    for (auto const& row : VPackArrayIterator(rows.slice())) {
+      sorted.emplace_back(row);
+    }
+    std::sort(sorted.begin(), sorted.end(), [&](VPackSlice lhs, VPackSlice rhs) {
+      return compareRows(registers, lhs, rhs) < 0;
+    });
+
+    result->openArray();
+    for (auto const& row : sorted) {
+      result->add(row);
+    }
+    result->close();
+  }
+  result->close();
+  return result;
+}
+
+/// @brief the first sort value of the rows at the given positions
+std::vector<int64_t> values(VPackSlice dependencies, std::vector<int64_t> const& positions) {
+  std::vector<int64_t> rows;
+  for (auto const& dependency : VPackArrayIterator(dependencies)) {
+    for (auto const& row : VPackArrayIterator(dependency)) {
+      rows.emplace_back(row.at(0).getNumber<int64_t>());
+    }
+  }
+
+  std::vector<int64_t> result;
+  for (auto const& it : positions) {
+    result.emplace_back(rows[it]);
+  }
+  return result;
+}
+
+}
+
+TEST_CASE("SortingGatherBlockTest", "[aql][cluster]") {
+  tests::AqlQuerySetup s;
+  UNUSED(s);
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+
+  // the query only provides the transaction and the plan for the strategies
+  Query query(false, vocbase, QueryString("RETURN 1"), nullptr,
+              VPackParser::fromJson("{ }"), PART_MAIN);
+  query.prepare(QueryRegistryFeature::QUERY_REGISTRY, Query::DontCache);
+
+  std::mt19937 random(4711);
+
+  SECTION("numbers of dependencies that are not a power of two") {
+    SortElements elements(query, {{true, {}}});
+
+    for (size_t n : {1, 2, 3, 5, 6, 7, 9, 13, 17}) {
+      std::vector<size_t> sizes;
+      for (size_t i = 0; i < n; ++i) {
+        sizes.emplace_back(20 + (i * 37) % 50);
+      }
+      auto dependencies = randomDependencies(elements.registers, sizes, 30, random);
+      auto const expect = expected(elements.registers, dependencies->slice());
+
+      for (size_t batchSize : {1, 7, 1000}) {
+        CHECK(expect == merge(query, GatherNode::SortMode::LoserTree, elements.registers,
+                              dependencies->slice(), 5, batchSize));
+      }
+    }
+  }
+
+  SECTION("equal keys are merged in the order of the dependencies") {
+    SortElements elements(query, {{true, {}}});
+
+    auto dependencies = VPackParser::fromJson(
+        "[ [[1], [1], [2]], [[1], [2], [2]], [[0], [1], [1], [2]], [[1]], [[2], [2]] ]");
+    // rows 0..12 in the order of the dependencies
+    std::vector<int64_t> const expect{6, 0, 1, 3, 7, 8, 10, 2, 4, 5, 9, 11, 12};
+    CHECK(expect == expected(elements.registers, dependencies->slice()));
+
+    for (size_t batchSize : {1, 2, 3, 1000}) {
+      CHECK(expect == merge(query, GatherNode::SortMode::LoserTree, elements.registers,
+                            dependencies->slice(), 2, batchSize));
+    }
+
+    // all keys equal
+    auto equal = randomDependencies(elements.registers, {10, 3, 0, 8, 7}, 1, random);
+    std::vector<int64_t> inOrder(28);
+    for (size_t i = 0; i < inOrder.size(); ++i) {
+      inOrder[i] = static_cast<int64_t>(i);
+    }
+    CHECK(inOrder == merge(query, GatherNode::SortMode::LoserTree, elements.registers,
+                           equal->slice(), 3, 4));
+  }
+
+  SECTION("dependencies that are empty or run out during the merge") {
+    SortElements elements(query, {{true, {}}});
+
+    // all empty
+    auto dependencies = VPackParser::fromJson("[ [], [], [] ]");
+    CHECK(merge(query, GatherNode::SortMode::LoserTree, elements.registers,
+                dependencies->slice(), 2, 10).empty());
+
+    // empty from the start, running out early, and one dependency holding
+    // all the largest values
+    dependencies = VPackParser::fromJson(
+        "[ [], [[0], [1]], [[5], [6], [7], [8], [9]], [], [[2]], [[1], [3]], [] ]");
+    auto const expect = expected(elements.registers, dependencies->slice());
+    CHECK((std::vector<int64_t>{0, 1, 8, 7, 9, 2, 3, 4, 5, 6}) == expect);
+    for (size_t batchSize : {1, 2, 3, 4, 1000}) {
+      for (size_t blockSize : {1, 2, 100}) {
+        CHECK(expect == merge(query, GatherNode::SortMode::LoserTree, elements.registers,
+                              dependencies->slice(), blockSize, batchSize));
+      }
+    }
+
+    // many dependencies of very different sizes
+    auto uneven = randomDependencies(elements.registers, {0, 1, 200, 0, 3, 0, 0, 50, 1, 0, 9},
+                                     1000, random);
+    CHECK(expected(elements.registers, uneven->slice()) ==
+          merge(query, GatherNode::SortMode::LoserTree, elements.registers,
+                uneven->slice(), 7, 13));
+  }
+
+  SECTION("several sort elements, descending elements and attribute paths") {
+    {
+      SortElements elements(query, {{true, {}}, {false, {}}});
+      for (size_t n : {2, 5, 11}) {
+        std::vector<size_t> sizes(n, 40);
+        auto dependencies = randomDependencies(elements.registers, sizes, 4, random);
+        auto const expect = expected(elements.registers, dependencies->slice());
+        for (size_t batchSize : {3, 1000}) {
+          CHECK(expect == merge(query, GatherNode::SortMode::LoserTree, elements.registers,
+                                dependencies->slice(), 6, batchSize));
+        }
+      }
+    }
+
+    {
+      // values of all types, in AQL type order. missing attributes are null
+      SortElements elements(query, {{false, {"a", "b"}}});
+      auto dependencies = VPackParser::fromJson(
+          "[ [[{ \"a\": { \"b\": { \"x\": 1 } } }], [{ \"a\": { \"b\": \"z\" } }], "
+          "   [{ \"a\": { \"b\": 2.5 } }], [{ \"a\": { \"b\": true } }], [{ \"a\": 1 }]], "
+          "  [[{ \"a\": { \"b\": [1] } }], [{ \"a\": { \"b\": \"a\" } }], "
+          "   [{ \"a\": { \"b\": -3 } }], [{ \"a\": { \"b\": false } }]], "
+          "  [[{ \"a\": { \"b\": \"b\" } }], [{ \"a\": { \"b\": 10 } }], [{ }], "
+          "   [{ \"a\": { \"b\": null } }]] ]");
+      auto const expect = expected(elements.registers, dependencies->slice());
+      CHECK((std::vector<int64_t>{0, 5, 1, 9, 6, 10, 2, 7, 3, 8, 4, 11, 12}) == expect);
+      for (size_t batchSize : {1, 4, 1000}) {
+        CHECK(expect == merge(query, GatherNode::SortMode::LoserTree, elements.registers,
+                              dependencies->slice(), 2, batchSize));
+      }
+    }
+  }
+
+  SECTION("all strategies return the rows in sort order") {
+    SortElements elements(query, {{true, {}}});
+    auto dependencies = randomDependencies(elements.registers, {30, 0, 17, 45, 5}, 20, random);
+    auto const expect = values(dependencies->slice(),
+                               expected(elements.registers, dependencies->slice()));
+
+    // the other strategies may order equal rows differently, so only the
+    // values are compared
+    for (auto mode : {GatherNode::SortMode::MinElement, GatherNode::SortMode::Heap,
+                      GatherNode::SortMode::LoserTree}) {
+      CHECK(expect == values(dependencies->slice(),
+                             merge(query, mode, elements.registers, dependencies->slice(), 4, 10)));
+    }
+  }
+}
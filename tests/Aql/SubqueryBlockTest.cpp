@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for SubqueryBlock
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "AqlQuerySetup.h"
+
+#include "Transaction/Methods.h"
+#include "Transaction/Options.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/OperationOptions.h"
+#include "VocBase/LogicalCollection.h"
+#include "VocBase/ManagedDocumentResult.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <functional>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+using arangodb::tests::executeQueryWithOptions;
+
+namespace {
+
+std::vector<std::string> const EMPTY;
+
+/// @brief executes the query with block profiling
+QueryResult executeProfiled(TRI_vocbase_t& vocbase, std::string const& queryString) {
+  auto queryResult = executeQueryWithOptions(vocbase, queryString, "{ \"profile\": 2 }");
+  REQUIRE(TRI_ERROR_NO_ERROR == queryResult.code);
+  REQUIRE(queryResult.result->slice().isArray());
+  REQUIRE(queryResult.extra != nullptr);
+  return queryResult;
+}
+
+/// @brief the number of getSome calls of the subquery's singleton, i.e. the
+/// singleton that was called most often
+size_t singletonCalls(QueryResult const& queryResult) {
+  size_t calls = 0;
+  for (auto const& it : VPackArrayIterator(queryResult.extra->slice().get("stats").get("nodes"))) {
+    if (it.get("blockType").copyString() == "SingletonBlock") {
+      calls = (std::max)(calls, it.get("calls").getNumber<size_t>());
+    }
+  }
+  return calls;
+}
+
+/// @brief checks that the n-th row of the result, counting from 1, is the
+/// list of numbers produced by expected(n)
+void checkRows(QueryResult const& queryResult, size_t expectedRows,
+               std::function<std::vector<int64_t>(int64_t)> const& expected) {
+  VPackSlice result = queryResult.result->slice();
+  REQUIRE(expectedRows == result.length());
+
+  int64_t i = 1;
+  for (auto const& row : VPackArrayIterator(result)) {
+    REQUIRE(row.isArray());
+    std::vector<int64_t> actual;
+    for (auto const& it : VPackArrayIterator(row)) {
+      actual.emplace_back(it.getNumber<int64_t>());
+    }
+    CHECK(expected(i) == actual);
+    ++i;
+  }
+}
+
+}
+
+TEST_CASE("SubqueryBlockTest", "[aql][subquery]") {
+  tests::AqlQuerySetup s;
+  UNUSED(s);
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+
+  auto* values = vocbase.createCollection(VPackParser::fromJson("{ \"name\": \"values\" }")->slice());
+  REQUIRE(nullptr != values);
+
+  {
+    OperationOptions opt;
+    TRI_voc_tick_t tick;
+    std::deque<ManagedDocumentResult> inserted;
+
+    transaction::Methods trx(transaction::StandaloneContext::Create(vocbase),
+                             EMPTY, EMPTY, EMPTY, transaction::Options());
+    REQUIRE(trx.begin().ok());
+
+    VPackBuilder doc;
+    for (int i = 0; i < 10; ++i) {
+      doc.clear();
+      doc.openObject();
+      doc.add("value", VPackValue(i));
+      doc.close();
+
+      inserted.emplace_back();
+      CHECK(values->insert(&trx, doc.slice(), inserted.back(), opt, tick, false).ok());
+    }
+
+    CHECK(trx.commit().ok());
+  }
+
+  SECTION("a row-local subquery runs once per input block") {
+    // several input blocks, and rows with empty results
+    auto queryResult = executeProfiled(vocbase,
+        "FOR i IN 1..2500 LET s = (FOR j IN 0..(i % 5) FILTER j > 0 && j != 2 RETURN i * j) "
+        "RETURN s");
+    checkRows(queryResult, 2500, [](int64_t i) {
+      std::vector<int64_t> result;
+      for (int64_t j = 1; j <= i % 5; ++j) {
+        if (j != 2) {
+          result.emplace_back(i * j);
+        }
+      }
+      return result;
+    });
+    CHECK(singletonCalls(queryResult) < 20);
+  }
+
+  SECTION("a subquery over a collection with a nested subquery runs batched") {
+    auto queryResult = executeProfiled(vocbase,
+        "FOR i IN 1..1500 LET s = (FOR d IN values FILTER d.value < i % 4 "
+        "LET t = (FOR k IN [1, 2] RETURN k * d.value) RETURN SUM(t)) RETURN s");
+    checkRows(queryResult, 1500, [](int64_t i) {
+      std::vector<int64_t> result;
+      for (int64_t v = 0; v < i % 4; ++v) {
+        result.emplace_back(3 * v);
+      }
+      return result;
+    });
+    CHECK(singletonCalls(queryResult) < 20);
+  }
+
+  SECTION("a subquery with a SORT and LIMIT runs once per row") {
+    auto queryResult = executeProfiled(vocbase,
+        "FOR i IN 1..1200 LET s = (FOR j IN 1..5 SORT j DESC LIMIT 2 RETURN i * j) RETURN s");
+    checkRows(queryResult, 1200, [](int64_t i) {
+      return std::vector<int64_t>{5 * i, 4 * i};
+    });
+    CHECK(singletonCalls(queryResult) >= 1200);
+  }
+
+  SECTION("a subquery with a COLLECT runs once per row") {
+    auto queryResult = executeProfiled(vocbase,
+        "FOR i IN 1..1100 LET s = (FOR d IN values COLLECT WITH COUNT INTO c RETURN c + i) "
+        "RETURN s");
+    checkRows(queryResult, 1100, [](int64_t i) {
+      return std::vector<int64_t>{10 + i};
+    });
+    CHECK(singletonCalls(queryResult) >= 1100);
+  }
+}
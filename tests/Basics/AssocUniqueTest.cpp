@@ -0,0 +1,390 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for the incremental resize of AssocUnique
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Basics/AssocUnique.h"
+#include "Basics/fasthash.h"
+#include "Random/RandomGenerator.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <deque>
+#include <map>
+#include <random>
+#include <set>
+
+using namespace arangodb;
+using namespace arangodb::basics;
+
+namespace {
+
+struct Value {
+  Value(uint64_t key, uint64_t value) : key(key), value(value) {}
+  uint64_t key;
+  uint64_t value;
+};
+
+struct AssocUniqueTestHelper {
+  static inline uint64_t HashKey(void*, uint64_t const* key) {
+    return fasthash64(key, sizeof(uint64_t), 0x12345678);
+  }
+
+  static inline uint64_t HashElement(void*, Value* const& element, bool) {
+    return fasthash64(&element->key, sizeof(uint64_t), 0x12345678);
+  }
+
+  bool IsEqualKeyElement(void*, uint64_t const* key, Value* const& element) const {
+    return *key == element->key;
+  }
+
+  bool IsEqualElementElement(void*, Value* const& left, Value* const& right) const {
+    return left == right;
+  }
+
+  bool IsEqualElementElementByKey(void*, Value* const& left, Value* const& right) const {
+    return left->key == right->key;
+  }
+};
+
+typedef AssocUnique<uint64_t, Value*, AssocUniqueTestHelper> Table;
+
+/// @brief the tables of the buckets, as reported by the statistics
+struct Layout {
+  explicit Layout(Table& table) : migrating(0) {
+    VPackBuilder builder;
+    builder.openObject();
+    table.appendToVelocyPack(builder);
+    builder.close();
+    for (auto const& it : VPackArrayIterator(builder.slice().get("buckets"))) {
+      slots.emplace_back(it.get("nrAlloc").getNumber<uint64_t>());
+      VPackSlice m = it.get("nrMigrating");
+      migratingInBucket.emplace_back(m.isNone() ? 0 : m.getNumber<uint64_t>());
+      migrating += migratingInBucket.back();
+    }
+  }
+
+  /// @brief the slots of the new table of each bucket
+  std::vector<uint64_t> slots;
+  /// @brief number of elements not yet moved out of the old table of each
+  /// bucket
+  std::vector<uint64_t> migratingInBucket;
+  /// @brief number of elements not yet moved out of the old tables
+  uint64_t migrating;
+};
+
+/// @brief the elements of the table, with the keys that are still in the
+/// old tables of their buckets. findSequential returns the slots of the
+/// old table after those of the new table
+std::map<uint64_t, Value*> elements(Table& table, std::set<uint64_t>* unmigrated = nullptr) {
+  Layout layout(table);
+  std::map<uint64_t, Value*> result;
+  BucketPosition position;
+  uint64_t total = 0;
+  while (true) {
+    Value* found = table.findSequential(nullptr, position, total);
+    if (found == nullptr) {
+      break;
+    }
+    CHECK(result.emplace(found->key, found).second);
+
+    // the position was moved behind the slot of the element
+    if (unmigrated == nullptr) {
+      continue;
+    }
+    if (position.position == 0) {
+      // the element was in the last slot of the previous bucket, which is
+      // a slot of the old table if the bucket is still resized
+      if (layout.migratingInBucket[position.bucketId - 1] > 0) {
+        unmigrated->emplace(found->key);
+      }
+    } else if (position.position - 1 >= layout.slots[position.bucketId]) {
+      unmigrated->emplace(found->key);
+    }
+  }
+  CHECK(total == table.size());
+  return result;
+}
+
+/// @brief checks that the table holds exactly the expected elements, and
+/// that every way of finding and iterating agrees
+void checkTable(Table& table, std::map<uint64_t, Value*> const& expected, uint64_t maxKey) {
+  CHECK(expected.size() == table.size());
+  CHECK(expected.empty() == table.isEmpty());
+
+  for (uint64_t key = 0; key < maxKey; ++key) {
+    auto it = expected.find(key);
+    Value* wanted = (it == expected.end()) ? nullptr : it->second;
+    INFO("key " << key);
+    CHECK(wanted == table.findByKey(nullptr, &key));
+    Value** ref = table.findByKeyRef(nullptr, &key);
+    REQUIRE(ref != nullptr);
+    CHECK(wanted == *ref);
+    BucketPosition position;
+    uint64_t hash;
+    CHECK(wanted == table.findByKey(nullptr, &key, position, hash));
+    if (wanted != nullptr) {
+      CHECK(wanted == table.find(nullptr, wanted));
+    }
+  }
+
+  CHECK((expected == elements(table)));
+
+  std::map<uint64_t, Value*> seen;
+  table.invokeOnAllElements([&seen](Value*& element) {
+    CHECK(seen.emplace(element->key, element).second);
+    return true;
+  });
+  CHECK((expected == seen));
+
+  seen.clear();
+  BucketPosition position;
+  while (true) {
+    Value* found = table.findSequentialReverse(nullptr, position);
+    if (found == nullptr) {
+      break;
+    }
+    CHECK(seen.emplace(found->key, found).second);
+  }
+  CHECK((expected == seen));
+
+  seen.clear();
+  BucketPosition initial;
+  BucketPosition current;
+  uint64_t step = 0;
+  uint64_t total = 0;
+  while (true) {
+    Value* found = table.findRandom(nullptr, initial, current, step, total);
+    if (found == nullptr) {
+      break;
+    }
+    CHECK(seen.emplace(found->key, found).second);
+  }
+  CHECK((expected == seen));
+}
+
+/// @brief inserts values with increasing keys until a bucket is in the
+/// middle of an incremental resize, with elements moved and elements not
+/// yet moved out of its old table
+void fillUntilMigrating(Table& table, std::deque<Value>& values,
+                        std::map<uint64_t, Value*>& expected) {
+  while (Layout(table).migrating < 1000) {
+    REQUIRE(values.size() < 1000000);
+    values.emplace_back(values.size(), values.size());
+    REQUIRE(TRI_ERROR_NO_ERROR == table.insert(nullptr, &values.back()));
+    expected.emplace(values.back().key, &values.back());
+  }
+
+  // the next inserts move some of the slots
+  for (size_t i = 0; i < 2; ++i) {
+    values.emplace_back(values.size(), values.size());
+    REQUIRE(TRI_ERROR_NO_ERROR == table.insert(nullptr, &values.back()));
+    expected.emplace(values.back().key, &values.back());
+  }
+  REQUIRE(Layout(table).migrating > 0);
+}
+
+void testMigration(size_t numberBuckets) {
+  Table table(AssocUniqueTestHelper(), numberBuckets);
+  std::deque<Value> values;
+  std::map<uint64_t, Value*> expected;
+  fillUntilMigrating(table, values, expected);
+  uint64_t const maxKey = values.size() + 100;
+
+  std::set<uint64_t> unmigrated;
+  elements(table, &unmigrated);
+  REQUIRE(!unmigrated.empty());
+  CHECK(unmigrated.size() == Layout(table).migrating);
+  INFO("unmigrated " << unmigrated.size() << " of " << expected.size());
+  CHECK(unmigrated.size() < expected.size());
+
+  SECTION("lookups and iterations see both tables") {
+    checkTable(table, expected, maxKey);
+
+    // keys of both tables violate the unique constraint
+    for (uint64_t key : {*unmigrated.begin(), *unmigrated.rbegin(), uint64_t(0)}) {
+      Value duplicate(key, 0);
+      CHECK(TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED == table.insert(nullptr, &duplicate));
+    }
+    checkTable(table, expected, maxKey);
+  }
+
+  SECTION("removing elements that were not moved yet") {
+    size_t i = 0;
+    std::vector<uint64_t> removed;
+    for (uint64_t key : unmigrated) {
+      if (i++ % 3 != 0) {
+        continue;
+      }
+      Value* element = expected[key];
+      // by key and by element
+      if (i % 2 == 0) {
+        CHECK(element == table.removeByKey(nullptr, &key));
+        CHECK(nullptr == table.removeByKey(nullptr, &key));
+      } else {
+        CHECK(element == table.remove(nullptr, element));
+        CHECK(nullptr == table.remove(nullptr, element));
+      }
+      expected.erase(key);
+      removed.emplace_back(key);
+    }
+    REQUIRE(!removed.empty());
+    CHECK(unmigrated.size() - removed.size() == Layout(table).migrating);
+    checkTable(table, expected, maxKey);
+
+    // removed keys can be inserted again, while their old slots are still
+    // in the old table
+    std::deque<Value> again;
+    for (size_t j = 0; j < removed.size(); j += 2) {
+      again.emplace_back(removed[j], 1);
+      CHECK(TRI_ERROR_NO_ERROR == table.insert(nullptr, &again.back()));
+      expected[removed[j]] = &again.back();
+    }
+    checkTable(table, expected, maxKey);
+
+    // the resize finishes without bringing back the removed elements
+    while (Layout(table).migrating > 0) {
+      values.emplace_back(values.size(), values.size());
+      REQUIRE(TRI_ERROR_NO_ERROR == table.insert(nullptr, &values.back()));
+      expected.emplace(values.back().key, &values.back());
+    }
+    checkTable(table, expected, values.size() + 100);
+  }
+
+  SECTION("removing all elements that were not moved yet ends the resize") {
+    for (uint64_t key : unmigrated) {
+      CHECK(expected[key] == table.removeByKey(nullptr, &key));
+      expected.erase(key);
+    }
+    CHECK(0 == Layout(table).migrating);
+    checkTable(table, expected, maxKey);
+
+    values.emplace_back(values.size(), values.size());
+    CHECK(TRI_ERROR_NO_ERROR == table.insert(nullptr, &values.back()));
+    expected.emplace(values.back().key, &values.back());
+    checkTable(table, expected, maxKey);
+  }
+
+  SECTION("removing elements while iterating") {
+    // removals may move elements of the new table, so an element may be
+    // visited twice, but none is skipped
+    size_t const before = expected.size();
+    std::set<uint64_t> seen;
+    table.invokeOnAllElementsForRemoval([&](Value*& element) {
+      // removing changes the slot the element refers to
+      Value* const current = element;
+      uint64_t const key = current->key;
+      seen.emplace(key);
+      if (key % 2 == 0) {
+        CHECK(current == table.removeByKey(nullptr, &key));
+        expected.erase(key);
+      }
+      return true;
+    });
+    CHECK(before == seen.size());
+    checkTable(table, expected, maxKey);
+
+    // everything, which ends the resize
+    table.invokeOnAllElementsForRemoval([&](Value*& element) {
+      Value* const current = element;
+      uint64_t const key = current->key;
+      CHECK(current == table.removeByKey(nullptr, &key));
+      expected.erase(key);
+      return true;
+    });
+    CHECK(expected.empty());
+    CHECK(0 == Layout(table).migrating);
+    checkTable(table, expected, maxKey);
+  }
+
+  SECTION("truncate during the resize") {
+    std::map<uint64_t, Value*> seen;
+    table.truncate([&seen](Value*& element) {
+      CHECK(seen.emplace(element->key, element).second);
+      return true;
+    });
+    CHECK((expected == seen));
+    expected.clear();
+    CHECK(0 == Layout(table).migrating);
+    checkTable(table, expected, maxKey);
+
+    // the table can be filled again
+    fillUntilMigrating(table, values, expected);
+    checkTable(table, expected, values.size() + 100);
+  }
+
+  SECTION("random operations match a map") {
+    std::mt19937 random(42);
+    uint64_t const keys = values.size() * 2;
+    std::deque<Value> more;
+
+    for (size_t round = 0; round < 100000; ++round) {
+      uint64_t const key = random() % keys;
+      auto it = expected.find(key);
+      switch (random() % 3) {
+        case 0:
+        case 1: {
+          more.emplace_back(key, round);
+          int res = table.insert(nullptr, &more.back());
+          if (it == expected.end()) {
+            CHECK(TRI_ERROR_NO_ERROR == res);
+            expected.emplace(key, &more.back());
+          } else {
+            CHECK(TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED == res);
+          }
+          break;
+        }
+        default: {
+          Value* wanted = (it == expected.end()) ? nullptr : it->second;
+          CHECK(wanted == table.removeByKey(nullptr, &key));
+          if (wanted != nullptr) {
+            expected.erase(it);
+          }
+          break;
+        }
+      }
+      if (round % 20000 == 0) {
+        checkTable(table, expected, keys);
+      }
+    }
+    checkTable(table, expected, keys);
+  }
+}
+
+}
+
+TEST_CASE("AssocUniqueTest", "[associative]") {
+  RandomGenerator::initialize(RandomGenerator::RandomType::MERSENNE);
+  testMigration(1);
+}
+
+TEST_CASE("AssocUniqueTest with several buckets", "[associative]") {
+  RandomGenerator::initialize(RandomGenerator::RandomType::MERSENNE);
+  testMigration(4);
+}
@@ -0,0 +1,80 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for HybridLogicalClock
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+#include <algorithm>
+#include <thread>
+
+#include "Basics/HybridLogicalClock.h"
+
+using namespace arangodb::basics;
+
+TEST_CASE("HybridLogicalClock", "[hlc]") {
+  HybridLogicalClock clock;
+
+  SECTION("time stamps increase and are not behind the physical time") {
+    uint64_t last = 0;
+    for (size_t i = 0; i < 10000; ++i) {
+      uint64_t physical = clock.getPhysicalTime();
+      uint64_t stamp = clock.getTimeStamp();
+      CHECK(stamp > last);
+      CHECK(HybridLogicalClock::extractTime(stamp) >= physical);
+      last = stamp;
+    }
+  }
+
+  SECTION("received time stamps are overtaken") {
+    uint64_t future = HybridLogicalClock::assembleTimeStamp(
+        clock.getPhysicalTime() + 100000, 5);
+    CHECK(clock.getTimeStamp(future) == future + 1);
+    CHECK(clock.getTimeStamp() == future + 2);
+  }
+
+  SECTION("concurrent writers get unique time stamps") {
+    size_t const numThreads = 8;
+    size_t const perThread = 20000;
+    std::vector<std::vector<uint64_t>> stamps(numThreads);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < numThreads; ++t) {
+      threads.emplace_back([&, t]() {
+        stamps[t].reserve(perThread);
+        for (size_t i = 0; i < perThread; ++i) {
+          stamps[t].push_back(clock.getTimeStamp());
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    std::vector<uint64_t> all;
+    for (auto const& s : stamps) {
+      CHECK(std::is_sorted(s.begin(), s.end()));
+      all.insert(all.end(), s.begin(), s.end());
+    }
+    std::sort(all.begin(), all.end());
+    CHECK(std::adjacent_find(all.begin(), all.end()) == all.end());
+    CHECK(clock.getTimeStamp() > all.back());
+  }
+}
@@ -125,6 +125,32 @@ TEST_CASE("LoggerTest", "[loggertest]") {
     LogAppenderFile::clear();
   }
 
+  SECTION("test_batched_messages") {
+    LogAppenderFile logger1(logfile1, "");
+    LogAppenderFile logger2(logfile2, "");
+
+    LogAppenderFile::setBatched(true);
+    logger1.logMessage(LogLevel::DEBUG, "some debug message", 0);
+    logger1.logMessage(LogLevel::INFO, "some info message", 0);
+
+    std::string content = FileUtils::slurp(logfile1);
+    CHECK(content.find("some debug message") == std::string::npos);
+
+    // a message for another file writes the batch first
+    logger2.logMessage(LogLevel::INFO, "some other info message", 0);
+    content = FileUtils::slurp(logfile1);
+    CHECK(content.find("some debug message") < content.find("some info message"));
+    CHECK(content.find("some info message") != std::string::npos);
+    CHECK(FileUtils::slurp(logfile2).empty());
+
+    LogAppenderFile::setBatched(false);
+    LogAppenderFile::flushBatch();
+    content = FileUtils::slurp(logfile2);
+    CHECK(content.find("some other info message") != std::string::npos);
+
+    LogAppenderFile::clear();
+  }
+
   // restore old state
   LogAppenderFile::setFds(backup);
   LogAppenderFile::reopenAll();
@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for ReadMostlyLock
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+#include <thread>
+
+#include "Basics/ReadLocker.h"
+#include "Basics/ReadMostlyLock.h"
+#include "Basics/WriteLocker.h"
+
+using namespace arangodb::basics;
+
+TEST_CASE("ReadMostlyLock", "[locks]") {
+  ReadMostlyLock lock;
+
+  SECTION("readers share the lock") {
+    REQUIRE(lock.tryReadLock());
+    REQUIRE(lock.tryReadLock());
+    CHECK(!lock.tryWriteLock());
+    lock.unlockRead();
+    CHECK(!lock.tryWriteLock());
+    lock.unlockRead();
+    REQUIRE(lock.tryWriteLock());
+    lock.unlockWrite();
+  }
+
+  SECTION("writers exclude readers and writers") {
+    REQUIRE(lock.tryWriteLock());
+    CHECK(!lock.tryWriteLock());
+    CHECK(!lock.tryReadLock());
+    lock.unlockWrite();
+    REQUIRE(lock.tryReadLock());
+    lock.unlockRead();
+  }
+
+  SECTION("read locks may be released by other threads") {
+    lock.readLock();
+    std::thread t([&]() { lock.unlockRead(); });
+    t.join();
+    REQUIRE(lock.tryWriteLock());
+    lock.unlockWrite();
+  }
+
+  SECTION("a waiting writer gets the lock when the readers are gone") {
+    lock.readLock();
+    bool written = false;
+    std::thread writer([&]() {
+      WRITE_LOCKER(guard, lock);
+      written = true;
+    });
+    // the writer keeps new readers out while it waits
+    while (lock.tryReadLock()) {
+      lock.unlockRead();
+      std::this_thread::yield();
+    }
+    CHECK(!written);
+    lock.unlockRead();
+    writer.join();
+    CHECK(written);
+  }
+
+  SECTION("concurrent readers and writers") {
+    // writers keep both values equal, readers must never see them differ
+    uint64_t a = 0;
+    uint64_t b = 0;
+    std::atomic<uint64_t> torn(0);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 8; ++i) {
+      threads.emplace_back([&, i]() {
+        for (size_t j = 0; j < 20000; ++j) {
+          if ((i + j) % 50 == 0) {
+            WRITE_LOCKER(guard, lock);
+            ++a;
+            ++b;
+          } else {
+            READ_LOCKER(guard, lock);
+            if (a != b) {
+              ++torn;
+            }
+          }
+        }
+      });
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+    CHECK(torn == 0);
+    CHECK(a == 8 * 20000 / 50);
+    CHECK(a == b);
+  }
+}
@@ -77,6 +77,28 @@ SECTION("test_StringBuffer2") {
   CHECK(std::string(buffer.c_str()) == "Hallo World1234");
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test_StringBufferSet
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("test_StringBufferSet") {
+  for (size_t size : std::vector<size_t>{10, 1000}) {
+    StringBuffer buffer(true);
+    buffer.appendText("old");
+
+    TRI_string_buffer_t* other = TRI_CreateStringBuffer();
+    std::string const text(size, 'x');
+    TRI_AppendString2StringBuffer(other, text.data(), text.size());
+
+    buffer.set(other);
+    CHECK(buffer.toString() == text);
+    CHECK(TRI_BeginStringBuffer(other) == nullptr);
+    CHECK(TRI_LengthStringBuffer(other) == (size_t) 0);
+
+    TRI_FreeStringBuffer(other);
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief generate tests
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for ThreadCachingAllocator
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+#include <cstring>
+#include <thread>
+
+#include "Basics/ThreadCachingAllocator.h"
+
+using namespace arangodb::basics;
+
+TEST_CASE("ThreadCachingAllocator", "[allocator]") {
+  SECTION("blocks of all sizes are usable") {
+    std::vector<std::pair<void*, size_t>> blocks;
+    for (size_t size = 0; size <= ThreadCachingAllocator::maxSize + 64;
+         ++size) {
+      void* block = ThreadCachingAllocator::allocate(size);
+      REQUIRE(block != nullptr);
+      std::memset(block, static_cast<int>(size & 0xff), size);
+      blocks.emplace_back(block, size);
+    }
+    for (auto const& it : blocks) {
+      uint8_t const* p = static_cast<uint8_t const*>(it.first);
+      for (size_t i = 0; i < it.second; ++i) {
+        REQUIRE(p[i] == static_cast<uint8_t>(it.second & 0xff));
+      }
+      ThreadCachingAllocator::deallocate(it.first, it.second);
+    }
+  }
+
+  SECTION("freed blocks are reused by the same size class") {
+    void* block = ThreadCachingAllocator::allocate(40);
+    ThreadCachingAllocator::deallocate(block, 40);
+    // 33 to 48 bytes share a size class
+    void* again = ThreadCachingAllocator::allocate(48);
+    CHECK(again == block);
+    ThreadCachingAllocator::deallocate(again, 48);
+  }
+
+  SECTION("blocks can be freed by other threads") {
+    size_t const n = 10 * ThreadCachingAllocator::magazineSize;
+    std::vector<void*> blocks;
+    std::thread producer([&]() {
+      for (size_t i = 0; i < n; ++i) {
+        void* block = ThreadCachingAllocator::allocate(64);
+        std::memset(block, 0xab, 64);
+        blocks.push_back(block);
+      }
+    });
+    producer.join();
+
+    std::thread consumer([&]() {
+      for (auto& it : blocks) {
+        ThreadCachingAllocator::deallocate(it, 64);
+      }
+      // the full magazines end up in the depot
+      ThreadCachingAllocator::flushThread();
+    });
+    consumer.join();
+
+    // and can be allocated by yet another thread
+    std::thread other([&]() {
+      std::vector<void*> mine;
+      for (size_t i = 0; i < n; ++i) {
+        mine.push_back(ThreadCachingAllocator::allocate(64));
+      }
+      for (auto& it : mine) {
+        ThreadCachingAllocator::deallocate(it, 64);
+      }
+    });
+    other.join();
+  }
+
+  SECTION("concurrent allocations do not overlap") {
+    std::vector<std::thread> threads;
+    std::atomic<size_t> failures(0);
+    for (size_t t = 0; t < 4; ++t) {
+      threads.emplace_back([t, &failures]() {
+        std::vector<uint8_t*> blocks;
+        for (size_t round = 0; round < 50; ++round) {
+          for (size_t i = 0; i < 100; ++i) {
+            uint8_t* block = static_cast<uint8_t*>(
+                ThreadCachingAllocator::allocate(32));
+            std::memset(block, static_cast<int>(t), 32);
+            blocks.push_back(block);
+          }
+          for (auto& it : blocks) {
+            for (size_t i = 0; i < 32; ++i) {
+              if (it[i] != t) {
+                ++failures;
+              }
+            }
+            ThreadCachingAllocator::deallocate(it, 32);
+          }
+          blocks.clear();
+        }
+      });
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+    CHECK(failures == 0);
+  }
+}
@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for VelocyPackDumper
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include "Basics/StringBuffer.h"
+#include "Basics/VelocyPackDumper.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Options.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb::basics;
+
+namespace {
+std::string dump(VPackSlice slice, VPackOptions const* options = &VPackOptions::Defaults) {
+  StringBuffer buffer(false);
+  VelocyPackDumper dumper(&buffer, options);
+  dumper.dumpValue(slice);
+  return buffer.toString();
+}
+
+template <typename T>
+std::string dumpValue(T value) {
+  VPackBuilder builder;
+  builder.add(VPackValue(value));
+  return dump(builder.slice());
+}
+}
+
+TEST_CASE("VelocyPackDumperTest", "[vpack]") {
+  SECTION("integers") {
+    CHECK(dumpValue(int64_t(0)) == "0");
+    CHECK(dumpValue(int64_t(-5)) == "-5");
+    CHECK(dumpValue(int64_t(-10)) == "-10");
+    CHECK(dumpValue(uint64_t(100)) == "100");
+    CHECK(dumpValue(int64_t(1234567)) == "1234567");
+    CHECK(dumpValue(int64_t(INT64_MIN)) == "-9223372036854775808");
+    CHECK(dumpValue(int64_t(INT64_MAX)) == "9223372036854775807");
+    CHECK(dumpValue(uint64_t(UINT64_MAX)) == "18446744073709551615");
+  }
+
+  SECTION("doubles") {
+    CHECK(dumpValue(0.0) == "0");
+    CHECK(dumpValue(-0.0) == "-0");
+    CHECK(dumpValue(1.0) == "1");
+    CHECK(dumpValue(-1.0) == "-1");
+    CHECK(dumpValue(99999999.0) == "99999999");
+    CHECK(dumpValue(-99999999.0) == "-99999999");
+    CHECK(dumpValue(1.0e8) == "1e+8");
+    CHECK(dumpValue(123456789.0) == "123456789");
+    CHECK(dumpValue(0.5) == "0.5");
+    CHECK(dumpValue(-2.25) == "-2.25");
+    CHECK(dumpValue(1.0e21) == "1e+21");
+  }
+
+  SECTION("strings") {
+    CHECK(dumpValue(std::string()) == "\"\"");
+    CHECK(dumpValue(std::string("abc")) == "\"abc\"");
+
+    // escapes at all positions of a block of 16 bytes
+    for (size_t i = 0; i < 40; ++i) {
+      std::string const prefix(i, 'x');
+      CHECK(dumpValue(prefix + "\"" + prefix) == "\"" + prefix + "\\\"" + prefix + "\"");
+      CHECK(dumpValue(prefix + "\\" + prefix) == "\"" + prefix + "\\\\" + prefix + "\"");
+      CHECK(dumpValue(prefix + "\n" + prefix) == "\"" + prefix + "\\n" + prefix + "\"");
+      CHECK(dumpValue(prefix + "\x01" + prefix) == "\"" + prefix + "\\u0001" + prefix + "\"");
+      CHECK(dumpValue(prefix + "/" + prefix) == "\"" + prefix + "/" + prefix + "\"");
+      CHECK(dumpValue(prefix + "\xc3\xa4" + prefix) == "\"" + prefix + "\xc3\xa4" + prefix + "\"");
+    }
+
+    VPackOptions options;
+    options.escapeForwardSlashes = true;
+    options.escapeUnicode = true;
+    VPackBuilder builder;
+    builder.add(VPackValue("0123456789abcdef/\xc3\xa4\xe2\x82\xac\xf0\x9f\x98\x80 end"));
+    CHECK(dump(builder.slice(), &options) ==
+          "\"0123456789abcdef\\/\\u00E4\\u20AC\\uD83D\\uDE00 end\"");
+  }
+
+  SECTION("nested values") {
+    VPackBuilder builder;
+    builder.openObject();
+    builder.add("a", VPackValue(1));
+    builder.add("b", VPackValue(VPackValueType::Array));
+    builder.add(VPackValue("x"));
+    builder.add(VPackValue(2.5));
+    builder.close();
+    builder.close();
+    CHECK(dump(builder.slice()) == "{\"a\":1,\"b\":[\"x\",2.5]}");
+  }
+}
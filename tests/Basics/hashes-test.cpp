@@ -511,6 +511,25 @@ SECTION("tst_crc32_utf8") {
   CHECK((uint64_t) 1426740181ULL ==   TRI_FinalCrc32(TRI_BlockCrc32(TRI_InitialCrc32(), buffer.c_str(), strlen(buffer.c_str()))));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that the CRC32 chosen at runtime matches the C version
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("tst_crc32_dispatch") {
+  std::string buffer;
+  for (size_t i = 0; i < 200; ++i) {
+    buffer.push_back(static_cast<char>((i * 7919) & 0xff));
+  }
+
+  // all lengths, at all alignments
+  for (size_t offset = 0; offset < 8; ++offset) {
+    for (size_t length = 0; length + offset <= buffer.size(); ++length) {
+      CHECK(TRI_BlockCrc32_C(TRI_InitialCrc32(), buffer.data() + offset, length) ==
+            TRI_BlockCrc32(TRI_InitialCrc32(), buffer.data() + offset, length));
+    }
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief generate tests
 ////////////////////////////////////////////////////////////////////////////////
@@ -463,7 +463,8 @@ SECTION("tst_clear") {
 SECTION("tst_steal") {
   TRI_string_buffer_t sb;
 
-  TRI_InitStringBuffer(&sb);
+  // larger than the inline storage, which cannot be stolen as is
+  TRI_InitSizedStringBuffer(&sb, 2 * TRI_STRING_BUFFER_INLINE_SIZE);
   TRI_AppendStringStringBuffer(&sb, "foo bar baz");
 
   const char* ptr = TRI_BeginStringBuffer(&sb);
@@ -489,6 +490,64 @@ SECTION("tst_steal") {
   TRI_Free(stolen);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tst_inline
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("tst_inline") {
+  TRI_string_buffer_t sb;
+
+  TRI_InitStringBuffer(&sb);
+  CHECK(((void*) sb._inline) == (void*) TRI_BeginStringBuffer(&sb));
+  CHECK(((size_t) TRI_STRING_BUFFER_INLINE_SIZE) == TRI_CapacityStringBuffer(&sb));
+
+  TRI_AppendStringStringBuffer(&sb, STR);
+  CHECK(((void*) sb._inline) == (void*) TRI_BeginStringBuffer(&sb));
+
+  // stealing copies the inline storage
+  char* stolen = TRI_StealStringBuffer(&sb);
+  CHECK(((void*) stolen) != (void*) sb._inline);
+  CHECK((0) == strcmp(stolen, STR));
+  CHECK(((void*) nullptr) == (void*) TRI_BeginStringBuffer(&sb));
+  TRI_Free(stolen);
+  TRI_DestroyStringBuffer(&sb);
+
+  // growing moves the contents to the heap
+  TRI_InitStringBuffer(&sb);
+  for (size_t i = 0; i < 10; ++i) {
+    TRI_AppendStringStringBuffer(&sb, STR);
+  }
+  CHECK(((void*) sb._inline) != (void*) TRI_BeginStringBuffer(&sb));
+  CHECK(10 * STRLEN(STR) == TRI_LengthStringBuffer(&sb));
+  CHECK(std::string(STR) == std::string(TRI_BeginStringBuffer(&sb) + 9 * STRLEN(STR)));
+
+  // swapping with an inline buffer
+  TRI_string_buffer_t other;
+  TRI_InitStringBuffer(&other);
+  TRI_AppendStringStringBuffer(&other, ABC_const);
+
+  TRI_SwapStringBuffer(&sb, &other);
+  CHECK(((void*) sb._inline) == (void*) TRI_BeginStringBuffer(&sb));
+  CHECK(std::string(ABC_const) == std::string(TRI_BeginStringBuffer(&sb), TRI_LengthStringBuffer(&sb)));
+  CHECK(((void*) other._inline) != (void*) TRI_BeginStringBuffer(&other));
+  CHECK(10 * STRLEN(STR) == TRI_LengthStringBuffer(&other));
+
+  // both inline
+  TRI_string_buffer_t third;
+  TRI_InitStringBuffer(&third);
+  TRI_AppendStringStringBuffer(&third, REP);
+
+  TRI_SwapStringBuffer(&sb, &third);
+  CHECK(((void*) sb._inline) == (void*) TRI_BeginStringBuffer(&sb));
+  CHECK(((void*) third._inline) == (void*) TRI_BeginStringBuffer(&third));
+  CHECK(std::string(REP) == std::string(TRI_BeginStringBuffer(&sb), TRI_LengthStringBuffer(&sb)));
+  CHECK(std::string(ABC_const) == std::string(TRI_BeginStringBuffer(&third), TRI_LengthStringBuffer(&third)));
+
+  TRI_DestroyStringBuffer(&sb);
+  TRI_DestroyStringBuffer(&other);
+  TRI_DestroyStringBuffer(&third);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief tst_last_char
 ////////////////////////////////////////////////////////////////////////////////
@@ -228,6 +228,39 @@ SECTION("tst_5") {
   arangodb::basics::Utf8Helper::DefaultUtf8Helper.tokenize(words, "", 4, UINT32_MAX, false);
   CHECK(words.empty());
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test sort keys against the collator
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("tst_sortKey") {
+  auto const& helper = arangodb::basics::Utf8Helper::DefaultUtf8Helper;
+
+  std::vector<std::string> values = {
+    "", "a", "A", "aa", "ab", "b", "B", "Müller", "Mueller", "Muller",
+    "z", "Z", "Здравствуйте", "日本語", "한글", "abc", "ABC", "1", "10", "9",
+    std::string(200, 'x')
+  };
+
+  std::vector<std::string> keys;
+  for (auto const& value : values) {
+    std::string key = "prefix";
+    CHECK(helper.appendSortKey(value.data(), value.size(), key));
+    CHECK(key.compare(0, 6, "prefix") == 0);
+    keys.emplace_back(key.substr(6));
+  }
+
+  for (size_t i = 0; i < values.size(); ++i) {
+    for (size_t j = 0; j < values.size(); ++j) {
+      int expected = helper.compareUtf8(values[i].data(), values[i].size(),
+                                        values[j].data(), values[j].size());
+      int actual = keys[i].compare(keys[j]);
+      expected = (expected < 0 ? -1 : (expected > 0 ? 1 : 0));
+      actual = (actual < 0 ? -1 : (actual > 0 ? 1 : 0));
+      CHECK(expected == actual);
+    }
+  }
+}
 }
 
 // Local Variables:
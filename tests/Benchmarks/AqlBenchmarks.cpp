@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.h"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/AqlValue.h"
+#include "Aql/ResourceUsage.h"
+#include "Basics/VelocyPackHelper.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <memory>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+using namespace arangodb::benchmark;
+
+namespace {
+size_t const blockSize = 1000;
+RegisterId const registers = 8;
+
+void fillBlock(State& state, ItemBlockLayout layout) {
+  ResourceMonitor monitor;
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    AqlItemBlock block(&monitor, blockSize, registers, layout);
+    for (size_t row = 0; row < blockSize; ++row) {
+      for (RegisterId reg = 0; reg < registers; ++reg) {
+        block.emplaceValue(row, reg, AqlValueHintInt(static_cast<int64_t>(row)));
+      }
+    }
+    doNotOptimize(block);
+  }
+  state.stopTimer();
+}
+
+void sliceBlock(State& state) {
+  ResourceMonitor monitor;
+  AqlItemBlock block(&monitor, blockSize, registers);
+  for (size_t row = 0; row < blockSize; ++row) {
+    for (RegisterId reg = 0; reg < registers; ++reg) {
+      // strings are dynamic values, which slice() has to copy
+      block.emplaceValue(row, reg, std::string(40, 'a' + (row % 26)));
+    }
+  }
+  state.resetTimer();
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    std::unique_ptr<AqlItemBlock> part(block.slice(100, 600));
+    doNotOptimize(part);
+  }
+  state.stopTimer();
+}
+
+void constructValues(State& state) {
+  std::string const value(64, 'x');
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    AqlValue a(value);
+    doNotOptimize(a);
+    a.destroy();
+  }
+}
+
+void hashValues(State& state) {
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("_key", VPackValue("abc123"));
+  builder.add("value", VPackValue(42));
+  builder.add("name", VPackValue("some somewhat longer string"));
+  builder.close();
+  AqlValue value(builder);
+  state.resetTimer();
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    doNotOptimize(value.hash(nullptr));
+  }
+  state.stopTimer();
+  value.destroy();
+}
+
+void compareValues(State& state) {
+  // AqlValue::Compare needs a transaction, for non-range values it compares
+  // the slices just like this
+  AqlValue a(std::string("the quick brown fox jumps over the lazy dog"));
+  AqlValue b(std::string("the quick brown fox jumps over the lazy cat"));
+  state.resetTimer();
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    doNotOptimize(basics::VelocyPackHelper::compare(a.slice(), b.slice(), true));
+  }
+  state.stopTimer();
+  a.destroy();
+  b.destroy();
+}
+}  // namespace
+
+ARANGODB_BENCHMARK("aql/itemblock/fillRowMajor", [](State& state) {
+  fillBlock(state, ItemBlockLayout::ROW_MAJOR);
+});
+ARANGODB_BENCHMARK("aql/itemblock/fillColumnMajor", [](State& state) {
+  fillBlock(state, ItemBlockLayout::COLUMN_MAJOR);
+});
+ARANGODB_BENCHMARK("aql/itemblock/slice", sliceBlock);
+ARANGODB_BENCHMARK("aql/value/construct", constructValues);
+ARANGODB_BENCHMARK("aql/value/hash", hashValues);
+ARANGODB_BENCHMARK("aql/value/compare", compareValues);
@@ -0,0 +1,210 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.h"
+
+#include "Basics/AssocMulti.h"
+#include "Basics/AssocUnique.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Basics/fasthash.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::benchmark;
+
+namespace {
+size_t const tableSize = 100000;
+
+// unique keys, 0 is the empty element
+struct UniqueHelper {
+  static inline uint64_t HashKey(void*, uint64_t const* key) {
+    return fasthash64_uint64(*key, 0xdeadbeef);
+  }
+
+  static inline uint64_t HashElement(void*, uint64_t const& element, bool) {
+    return fasthash64_uint64(element, 0xdeadbeef);
+  }
+
+  inline bool IsEqualKeyElement(void*, uint64_t const* key,
+                                uint64_t const& element) const {
+    return *key == element;
+  }
+
+  inline bool IsEqualElementElement(void*, uint64_t const& left,
+                                    uint64_t const& right) const {
+    return left == right;
+  }
+
+  inline bool IsEqualElementElementByKey(void*, uint64_t const& left,
+                                         uint64_t const& right) const {
+    return left == right;
+  }
+};
+
+struct MultiElement {
+  uint64_t key;
+  uint64_t value;
+};
+
+// many elements per key, like in an edge index
+struct MultiHelper {
+  static inline uint64_t HashKey(void*, void const* key) {
+    return fasthash64_uint64(*static_cast<uint64_t const*>(key), 0xdeadbeef);
+  }
+
+  static inline uint64_t HashElement(void*, void const* e, bool byKey) {
+    MultiElement const* element = static_cast<MultiElement const*>(e);
+    return fasthash64_uint64(byKey ? element->key : element->value,
+                             0xdeadbeef);
+  }
+
+  bool IsEqualKeyElement(void*, void const* key, void const* e) const {
+    return *static_cast<uint64_t const*>(key) ==
+           static_cast<MultiElement const*>(e)->key;
+  }
+
+  bool IsEqualElementElement(void*, void const* l, void const* r) const {
+    return static_cast<MultiElement const*>(l)->value ==
+           static_cast<MultiElement const*>(r)->value;
+  }
+
+  bool IsEqualElementElementByKey(void*, void const* l, void const* r) const {
+    return static_cast<MultiElement const*>(l)->key ==
+           static_cast<MultiElement const*>(r)->key;
+  }
+};
+
+typedef basics::AssocUnique<uint64_t, uint64_t, UniqueHelper> UniqueTable;
+typedef basics::AssocMulti<void, void*, uint32_t, true, MultiHelper> MultiTable;
+
+void compareSlices(State& state, VPackSlice lhs, VPackSlice rhs) {
+  state.resetTimer();
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    doNotOptimize(basics::VelocyPackHelper::compare(lhs, rhs, true));
+  }
+  state.stopTimer();
+}
+
+void compareObjects(State& state) {
+  VPackBuilder lhs;
+  VPackBuilder rhs;
+  for (VPackBuilder* b : {&lhs, &rhs}) {
+    b->openObject();
+    b->add("_key", VPackValue("1234567"));
+    b->add("name", VPackValue("a name of some length"));
+    b->add("tags", VPackValue(VPackValueType::Array));
+    for (int i = 0; i < 8; ++i) {
+      b->add(VPackValue(i));
+    }
+    b->close();
+    b->add("value", VPackValue(b == &lhs ? 1.5 : 2.5));
+    b->close();
+  }
+  compareSlices(state, lhs.slice(), rhs.slice());
+}
+
+void uniqueInsert(State& state) {
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    UniqueTable table(UniqueHelper(), 8);
+    for (uint64_t key = 1; key <= tableSize; ++key) {
+      table.insert(nullptr, key);
+    }
+    doNotOptimize(table.size());
+  }
+  state.stopTimer();
+}
+
+void uniqueFind(State& state) {
+  UniqueTable table(UniqueHelper(), 8);
+  for (uint64_t key = 1; key <= tableSize; ++key) {
+    table.insert(nullptr, key);
+  }
+  state.resetTimer();
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    uint64_t key = 1 + (i * 7919) % tableSize;
+    doNotOptimize(table.findByKey(nullptr, &key));
+  }
+  state.stopTimer();
+}
+
+void multiFill(std::vector<MultiElement>& elements, size_t perKey) {
+  elements.resize(tableSize);
+  for (size_t i = 0; i < tableSize; ++i) {
+    elements[i].key = i / perKey;
+    elements[i].value = i;
+  }
+}
+
+void multiInsert(State& state) {
+  std::vector<MultiElement> elements;
+  multiFill(elements, 10);
+  state.resetTimer();
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    MultiTable table(MultiHelper(), 8);
+    for (auto& element : elements) {
+      table.insert(nullptr, &element, false, false);
+    }
+    doNotOptimize(table.size());
+  }
+  state.stopTimer();
+}
+
+void multiLookup(State& state) {
+  std::vector<MultiElement> elements;
+  multiFill(elements, 10);
+  MultiTable table(MultiHelper(), 8);
+  for (auto& element : elements) {
+    table.insert(nullptr, &element, false, false);
+  }
+  std::vector<void*> result;
+  state.resetTimer();
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    uint64_t key = (i * 7919) % (tableSize / 10);
+    result.clear();
+    table.lookupByKey(nullptr, &key, result);
+    doNotOptimize(result.size());
+  }
+  state.stopTimer();
+}
+}  // namespace
+
+ARANGODB_BENCHMARK("basics/velocypack/compareInts", [](State& state) {
+  VPackBuilder lhs;
+  lhs.add(VPackValue(123456));
+  VPackBuilder rhs;
+  rhs.add(VPackValue(123457));
+  compareSlices(state, lhs.slice(), rhs.slice());
+});
+ARANGODB_BENCHMARK("basics/velocypack/compareStrings", [](State& state) {
+  VPackBuilder lhs;
+  lhs.add(VPackValue("Grüße aus der Hauptstadt, die lange Zeichenkette"));
+  VPackBuilder rhs;
+  rhs.add(VPackValue("Grüße aus der Hauptstadt, die längere Zeichenkette"));
+  compareSlices(state, lhs.slice(), rhs.slice());
+});
+ARANGODB_BENCHMARK("basics/velocypack/compareObjects", compareObjects);
+ARANGODB_BENCHMARK("basics/assocUnique/insert", uniqueInsert);
+ARANGODB_BENCHMARK("basics/assocUnique/find", uniqueFind);
+ARANGODB_BENCHMARK("basics/assocMulti/insert", multiInsert);
+ARANGODB_BENCHMARK("basics/assocMulti/lookupByKey", multiLookup);
@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::benchmark;
+
+namespace {
+std::map<std::string, Function>& registry() {
+  static std::map<std::string, Function> benchmarks;
+  return benchmarks;
+}
+
+double measure(Function const& function, uint64_t iterations) {
+  State state(iterations);
+  function(state);
+  state.stopTimer();
+  return state.elapsed();
+}
+}  // namespace
+
+State::State(uint64_t iterations)
+    : _iterations(iterations),
+      _start(std::chrono::steady_clock::now()),
+      _stop(_start),
+      _stopped(false) {}
+
+void State::resetTimer() {
+  _start = std::chrono::steady_clock::now();
+  _stopped = false;
+}
+
+void State::stopTimer() {
+  if (!_stopped) {
+    _stop = std::chrono::steady_clock::now();
+    _stopped = true;
+  }
+}
+
+double State::elapsed() const {
+  return std::chrono::duration<double>(_stop - _start).count();
+}
+
+Registration::Registration(std::string const& name, Function function) {
+  bool inserted = registry().emplace(name, std::move(function)).second;
+  if (!inserted) {
+    std::cerr << "duplicate benchmark '" << name << "'" << std::endl;
+    std::abort();
+  }
+}
+
+size_t benchmark::runAll(Options const& options, std::ostream& out) {
+  size_t count = 0;
+
+  for (auto const& it : registry()) {
+    if (it.first.find(options.filter) == std::string::npos) {
+      continue;
+    }
+
+    // grow the number of iterations until one run takes the minimum time,
+    // so that the clock resolution and the setup do not matter
+    uint64_t iterations = 1;
+    double elapsed = measure(it.second, iterations);
+    while (elapsed < options.minTime && iterations < (uint64_t(1) << 40)) {
+      double factor = (elapsed > 0.0) ? options.minTime * 1.4 / elapsed : 10.0;
+      factor = (std::min)(10.0, (std::max)(2.0, factor));
+      iterations = static_cast<uint64_t>(static_cast<double>(iterations) * factor);
+      elapsed = measure(it.second, iterations);
+    }
+
+    std::vector<double> nsPerOp;
+    for (uint64_t i = 0; i < (std::max)(options.repetitions, uint64_t(1)); ++i) {
+      nsPerOp.push_back(measure(it.second, iterations) * 1.0e9 /
+                        static_cast<double>(iterations));
+    }
+    std::sort(nsPerOp.begin(), nsPerOp.end());
+    double const median = nsPerOp[nsPerOp.size() / 2];
+
+    VPackBuilder result;
+    result.openObject();
+    result.add("benchmark", VPackValue(it.first));
+    result.add("iterations", VPackValue(iterations));
+    result.add("repetitions", VPackValue(nsPerOp.size()));
+    result.add("nsPerOp", VPackValue(median));
+    result.add("minNsPerOp", VPackValue(nsPerOp.front()));
+    result.add("maxNsPerOp", VPackValue(nsPerOp.back()));
+    result.add("opsPerSecond", VPackValue(median > 0.0 ? 1.0e9 / median : 0.0));
+    result.close();
+
+    out << result.slice().toJson() << std::endl;
+    ++count;
+  }
+
+  return count;
+}
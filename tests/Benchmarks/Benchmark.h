@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UNITTESTS_BENCHMARKS_BENCHMARK_H
+#define UNITTESTS_BENCHMARKS_BENCHMARK_H 1
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+
+namespace arangodb {
+namespace benchmark {
+
+/// @brief state of one run of a benchmark. the benchmark repeats its
+/// operation iterations() times. the clock runs from the call until the
+/// benchmark returns, setup and teardown can be excluded with resetTimer()
+/// and stopTimer()
+class State {
+ public:
+  explicit State(uint64_t iterations);
+
+  uint64_t iterations() const { return _iterations; }
+
+  /// @brief restarts the clock, after the setup of the benchmark
+  void resetTimer();
+
+  /// @brief stops the clock, before the teardown of the benchmark
+  void stopTimer();
+
+  /// @brief measured time in seconds
+  double elapsed() const;
+
+ private:
+  uint64_t const _iterations;
+  std::chrono::steady_clock::time_point _start;
+  std::chrono::steady_clock::time_point _stop;
+  bool _stopped;
+};
+
+typedef std::function<void(State&)> Function;
+
+/// @brief registers a benchmark under a name, e.g. "cache/plain/find".
+/// the names are unique, the benchmarks run in the order of their names
+struct Registration {
+  Registration(std::string const& name, Function function);
+};
+
+struct Options {
+  /// @brief only benchmarks whose names contain the filter run
+  std::string filter;
+  /// @brief every repetition runs at least so many seconds
+  double minTime = 0.2;
+  /// @brief each benchmark is measured so many times, and the median is
+  /// reported
+  uint64_t repetitions = 5;
+};
+
+/// @brief runs the registered benchmarks and writes one JSON object per
+/// benchmark and line to out. returns the number of benchmarks run
+size_t runAll(Options const& options, std::ostream& out);
+
+/// @brief keeps the compiler from optimizing away a computed value
+template <typename T>
+inline void doNotOptimize(T const& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static_cast<void>(*reinterpret_cast<char const volatile*>(&value));
+#endif
+}
+
+}  // namespace benchmark
+}  // namespace arangodb
+
+#define ARANGODB_BENCHMARK_CONCAT2(a, b) a##b
+#define ARANGODB_BENCHMARK_CONCAT(a, b) ARANGODB_BENCHMARK_CONCAT2(a, b)
+
+#define ARANGODB_BENCHMARK(name, function)                 \
+  static ::arangodb::benchmark::Registration               \
+      ARANGODB_BENCHMARK_CONCAT(benchmarkRegistration, __LINE__)(name, function)
+
+#endif
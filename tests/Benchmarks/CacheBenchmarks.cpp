@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.h"
+
+#include "Cache/Common.h"
+#include "Cache/Manager.h"
+#include "Cache/PlainCache.h"
+
+#include <thread>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::cache;
+using namespace arangodb::benchmark;
+
+namespace {
+uint64_t const cacheLimit = 64 * 1024 * 1024;
+uint64_t const entries = 100000;
+
+void fillCache(Cache& cache) {
+  for (uint64_t i = 0; i < entries; ++i) {
+    CachedValue* value =
+        CachedValue::construct(&i, sizeof(uint64_t), &i, sizeof(uint64_t));
+    if (cache.insert(value).fail()) {
+      delete value;
+    }
+  }
+}
+
+/// @brief the iterations are split over the threads, so that the time per
+/// operation shows how well the cache scales
+void findConcurrently(State& state, size_t threads) {
+  auto postFn = [](std::function<void()>) -> bool { return false; };
+  Manager manager(postFn, 4 * cacheLimit);
+  auto cache = manager.createCache(CacheType::Plain, false, cacheLimit);
+  fillCache(*cache);
+
+  uint64_t const perThread = state.iterations() / threads + 1;
+  std::vector<std::thread> workers;
+  state.resetTimer();
+  for (size_t t = 0; t < threads; ++t) {
+    workers.emplace_back([&cache, perThread, t]() {
+      uint64_t found = 0;
+      for (uint64_t i = 0; i < perThread; ++i) {
+        uint64_t key = (i * 7919 + t) % entries;
+        auto f = cache->find(&key, sizeof(uint64_t));
+        found += f.found() ? 1 : 0;
+      }
+      doNotOptimize(found);
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  state.stopTimer();
+  manager.destroyCache(cache);
+}
+
+void insertValues(State& state) {
+  auto postFn = [](std::function<void()>) -> bool { return false; };
+  Manager manager(postFn, 4 * cacheLimit);
+  auto cache = manager.createCache(CacheType::Plain, false, cacheLimit);
+
+  state.resetTimer();
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    uint64_t key = i % entries;
+    CachedValue* value =
+        CachedValue::construct(&key, sizeof(uint64_t), &i, sizeof(uint64_t));
+    if (cache->insert(value).fail()) {
+      delete value;
+    }
+  }
+  state.stopTimer();
+  manager.destroyCache(cache);
+}
+}  // namespace
+
+ARANGODB_BENCHMARK("cache/plain/find", [](State& state) {
+  findConcurrently(state, 1);
+});
+ARANGODB_BENCHMARK("cache/plain/find4Threads", [](State& state) {
+  findConcurrently(state, 4);
+});
+ARANGODB_BENCHMARK("cache/plain/insert", insertValues);
@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.h"
+
+#include "Pregel/IncomingCache.h"
+#include "Pregel/MessageCombiner.h"
+#include "Pregel/MessageFormat.h"
+#include "Pregel/Utils.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <string>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::pregel;
+using namespace arangodb::benchmark;
+
+namespace {
+size_t const messagesPerPacket = 1000;
+size_t const vertices = 100;
+
+/// @brief a packet like the ones workers send each other, the messages
+/// of one shard for a few vertices
+void buildPacket(VPackBuilder& packet) {
+  packet.openObject();
+  packet.add(Utils::shardIdKey, VPackValue(1));
+  packet.add(Utils::messagesKey, VPackValue(VPackValueType::Array));
+  for (size_t i = 0; i < messagesPerPacket; ++i) {
+    packet.add(VPackValue("vertex" + std::to_string(i % vertices)));
+    packet.add(VPackValue(static_cast<double>(i) * 0.5));
+  }
+  packet.close();
+  packet.close();
+}
+
+void parseCombining(State& state) {
+  NumberMessageFormat<double> format;
+  SumCombiner<double> combiner;
+  CombiningInCache<double> cache(nullptr, &format, &combiner);
+  VPackBuilder packet;
+  buildPacket(packet);
+  state.resetTimer();
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    cache.parseMessages(packet.slice());
+  }
+  state.stopTimer();
+  doNotOptimize(cache.containedMessageCount());
+}
+
+void parseArray(State& state) {
+  NumberMessageFormat<double> format;
+  ArrayInCache<double> cache(nullptr, &format);
+  VPackBuilder packet;
+  buildPacket(packet);
+  state.resetTimer();
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    cache.parseMessages(packet.slice());
+    if (i % 64 == 63) {
+      // a superstep ends, the cache does not grow without bounds
+      cache.clear();
+    }
+  }
+  state.stopTimer();
+  doNotOptimize(cache.containedMessageCount());
+}
+
+void storeCombining(State& state) {
+  NumberMessageFormat<double> format;
+  SumCombiner<double> combiner;
+  CombiningInCache<double> cache(nullptr, &format, &combiner);
+  std::vector<PregelKey> keys;
+  for (size_t i = 0; i < vertices; ++i) {
+    keys.emplace_back("vertex" + std::to_string(i));
+  }
+  state.resetTimer();
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    cache.storeMessage(1, keys[i % vertices], 0.5);
+  }
+  state.stopTimer();
+  doNotOptimize(cache.containedMessageCount());
+}
+}  // namespace
+
+ARANGODB_BENCHMARK("pregel/incache/parseCombining", parseCombining);
+ARANGODB_BENCHMARK("pregel/incache/parseArray", parseArray);
+ARANGODB_BENCHMARK("pregel/incache/storeCombining", storeCombining);
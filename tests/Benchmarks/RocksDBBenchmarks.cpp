@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.h"
+
+#include "Basics/StringRef.h"
+#include "RocksDBEngine/RocksDBComparator.h"
+#include "RocksDBEngine/RocksDBFormat.h"
+#include "RocksDBEngine/RocksDBKey.h"
+#include "RocksDBEngine/RocksDBTypes.h"
+#include "RocksDBEngine/RocksDBValue.h"
+#include "VocBase/LocalDocumentId.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::benchmark;
+
+namespace {
+uint64_t const objectId = 1234567;
+
+void encodeDocumentKeys(State& state) {
+  rocksutils::setRocksDBKeyFormatEndianess(RocksDBEndianness::Big);
+  RocksDBKey key;
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    key.constructDocument(objectId, LocalDocumentId(i + 1));
+    doNotOptimize(key.string().size());
+  }
+}
+
+void encodePrimaryIndexKeys(State& state) {
+  rocksutils::setRocksDBKeyFormatEndianess(RocksDBEndianness::Big);
+  StringRef const primaryKey("some-document-key-12345");
+  RocksDBKey key;
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    key.constructPrimaryIndexValue(objectId, primaryKey);
+    RocksDBValue value =
+        RocksDBValue::PrimaryIndexValue(LocalDocumentId(i + 1), i + 1);
+    doNotOptimize(key.string().size() + value.string().size());
+  }
+}
+
+void encodeEdgeIndexKeys(State& state) {
+  rocksutils::setRocksDBKeyFormatEndianess(RocksDBEndianness::Big);
+  StringRef const vertexId("vertices/some-vertex-key-12345");
+  StringRef const otherId("vertices/another-vertex-key-6789");
+  RocksDBKey key;
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    key.constructEdgeIndexValue(objectId, vertexId, LocalDocumentId(i + 1));
+    RocksDBValue value = RocksDBValue::EdgeIndexValue(otherId);
+    doNotOptimize(key.string().size() + value.string().size());
+  }
+}
+
+void decodePrimaryIndexEntries(State& state) {
+  rocksutils::setRocksDBKeyFormatEndianess(RocksDBEndianness::Big);
+  RocksDBKey key;
+  key.constructPrimaryIndexValue(objectId, StringRef("some-document-key-12345"));
+  RocksDBValue value = RocksDBValue::PrimaryIndexValue(LocalDocumentId(42), 42);
+  rocksdb::Slice keySlice = key.string();
+  rocksdb::Slice valueSlice(value.string());
+  state.resetTimer();
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    doNotOptimize(RocksDBKey::primaryKey(keySlice).size());
+    doNotOptimize(RocksDBValue::documentId(valueSlice));
+  }
+  state.stopTimer();
+}
+
+void compareIndexKeys(State& state) {
+  rocksutils::setRocksDBKeyFormatEndianess(RocksDBEndianness::Big);
+  VPackBuilder values;
+  values.openArray();
+  values.add(VPackValue("a string value of some length"));
+  values.add(VPackValue(12345));
+  values.close();
+  RocksDBKey lhs;
+  lhs.constructVPackIndexValue(objectId, values.slice(), LocalDocumentId(1));
+  RocksDBKey rhs;
+  rhs.constructVPackIndexValue(objectId, values.slice(), LocalDocumentId(2));
+  RocksDBVPackComparator comparator;
+  state.resetTimer();
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    doNotOptimize(comparator.Compare(lhs.string(), rhs.string()));
+  }
+  state.stopTimer();
+}
+}  // namespace
+
+ARANGODB_BENCHMARK("rocksdb/key/document", encodeDocumentKeys);
+ARANGODB_BENCHMARK("rocksdb/key/primaryIndex", encodePrimaryIndexKeys);
+ARANGODB_BENCHMARK("rocksdb/key/edgeIndex", encodeEdgeIndexKeys);
+ARANGODB_BENCHMARK("rocksdb/key/decodePrimaryIndex", decodePrimaryIndexEntries);
+ARANGODB_BENCHMARK("rocksdb/comparator/vpackIndex", compareIndexKeys);
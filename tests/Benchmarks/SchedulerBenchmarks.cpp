@@ -0,0 +1,68 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.h"
+
+#include "GeneralServer/RequestLane.h"
+#include "Scheduler/JobQueue.h"
+#include "Scheduler/Scheduler.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace arangodb;
+using namespace arangodb::benchmark;
+
+namespace {
+/// @brief queues empty jobs and waits until all of them ran, which measures
+/// the overhead of the queues and the wakeups of the worker threads
+void queueJobs(State& state, RequestPriority prio) {
+  // the defaults of the scheduler feature, with four worker threads
+  rest::Scheduler scheduler(4, 4, 128, 16 * 4096, 4096, 1, 1, 0, 0.005);
+  scheduler.start();
+
+  std::atomic<uint64_t> done(0);
+  state.resetTimer();
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    while (!scheduler.queue(prio, rest::SchedulerJob([&done]() { ++done; }))) {
+      // the queues are full
+      std::this_thread::yield();
+    }
+  }
+  while (done.load() < state.iterations()) {
+    std::this_thread::yield();
+  }
+  state.stopTimer();
+
+  scheduler.beginShutdown();
+  while (scheduler.isRunning()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  scheduler.shutdown();
+}
+}  // namespace
+
+ARANGODB_BENCHMARK("scheduler/queue/low", [](State& state) {
+  queueJobs(state, RequestPriority::LOW);
+});
+ARANGODB_BENCHMARK("scheduler/queue/high", [](State& state) {
+  queueJobs(state, RequestPriority::HIGH);
+});
@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.h"
+
+#include "ApplicationFeatures/ShellColorsFeature.h"
+#include "Basics/ArangoGlobalContext.h"
+#include "Cluster/ServerState.h"
+#include "Logger/LogAppender.h"
+#include "Logger/Logger.h"
+#include "Random/RandomGenerator.h"
+#include "RestServer/ServerIdFeature.h"
+#include "tests/Basics/icu-helper.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace {
+char const* ARGV0 = "";
+
+void usage() {
+  std::cerr << "usage: " << ARGV0
+            << " [--filter <substring>] [--min-time <seconds>]"
+               " [--repetitions <count>]"
+            << std::endl;
+}
+}  // namespace
+
+/// @brief runs the micro benchmarks, one JSON object per line is written
+/// to stdout, so that the results of two builds can be compared by a script
+int main(int argc, char* argv[]) {
+  ARGV0 = argv[0];
+  arangodb::benchmark::Options options;
+
+  for (int i = 1; i < argc; ++i) {
+    if (i + 1 < argc && strcmp(argv[i], "--filter") == 0) {
+      options.filter = argv[++i];
+    } else if (i + 1 < argc && strcmp(argv[i], "--min-time") == 0) {
+      options.minTime = std::strtod(argv[++i], nullptr);
+    } else if (i + 1 < argc && strcmp(argv[i], "--repetitions") == 0) {
+      options.repetitions = std::strtoull(argv[++i], nullptr, 10);
+    } else {
+      usage();
+      return EXIT_FAILURE;
+    }
+  }
+  if (options.minTime <= 0.0 || options.repetitions == 0) {
+    usage();
+    return EXIT_FAILURE;
+  }
+
+  // the same global setup as for the unit tests
+  arangodb::RandomGenerator::initialize(
+      arangodb::RandomGenerator::RandomType::MERSENNE);
+  arangodb::Logger::initialize(false);
+  arangodb::LogAppender::addAppender("-");
+
+  arangodb::ServerState::instance()->setRole(
+      arangodb::ServerState::ROLE_SINGLE);
+
+  arangodb::ShellColorsFeature sc(nullptr);
+  sc.prepare();
+
+  arangodb::ArangoGlobalContext ctx(1, const_cast<char**>(&ARGV0), ".");
+  ctx.exit(0);
+
+  arangodb::ServerIdFeature::setId(12345);
+  IcuInitializer::setup(ARGV0);
+
+  size_t count = arangodb::benchmark::runAll(options, std::cout);
+
+  arangodb::Logger::shutdown();
+
+  if (count == 0) {
+    std::cerr << "no benchmark matches the filter '" << options.filter << "'"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for arangodb::cache::FrequencySketch
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Cache/FrequencySketch.h"
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include <stdint.h>
+#include <memory>
+
+using namespace arangodb::cache;
+
+static uint8_t const maxCount = FrequencySketch::maxCount;
+
+TEST_CASE("cache::FrequencySketch", "[cache]") {
+  SECTION("test estimates and admission") {
+    FrequencySketch sketch(1000);
+    REQUIRE(sketch.memoryUsage() ==
+            sizeof(FrequencySketch) + sizeof(std::vector<uint8_t>) +
+                FrequencySketch::depth * 1024);
+
+    uint32_t hot = 12345;
+    uint32_t cold = 67890;
+    REQUIRE(0 == sketch.estimate(hot));
+    REQUIRE(0 == sketch.estimate(cold));
+
+    for (size_t i = 0; i < 5; i++) {
+      sketch.record(hot);
+    }
+    sketch.record(cold);
+
+    // estimates never undercount
+    REQUIRE(5 <= sketch.estimate(hot));
+    REQUIRE(1 <= sketch.estimate(cold));
+    REQUIRE(sketch.admit(hot, cold));
+    REQUIRE(!sketch.admit(cold, hot));
+    // ties favor the resident entry
+    REQUIRE(!sketch.admit(hot, hot));
+
+    // counters saturate
+    for (size_t i = 0; i < 100; i++) {
+      sketch.record(hot);
+    }
+    REQUIRE(maxCount == sketch.estimate(hot));
+
+    sketch.clear();
+    REQUIRE(0 == sketch.estimate(hot));
+    REQUIRE(0 == sketch.estimate(cold));
+  }
+
+  SECTION("test aging") {
+    FrequencySketch sketch(64);
+    uint32_t hot = 4711;
+    for (size_t i = 0; i < 100; i++) {
+      sketch.record(hot);
+    }
+    REQUIRE(maxCount == sketch.estimate(hot));
+
+    // recording many other hashes halves the old counters at some point,
+    // so a formerly hot entry can be displaced by a recently hot one
+    uint32_t recent = 815;
+    for (uint32_t i = 0; i < FrequencySketch::sampleFactor * 64 * 4; i++) {
+      sketch.record(recent);
+    }
+    REQUIRE(maxCount / 2 >= sketch.estimate(hot));
+    REQUIRE(sketch.admit(recent, hot));
+  }
+}
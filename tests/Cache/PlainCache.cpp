@@ -371,4 +371,80 @@ TEST_CASE("cache::PlainCache", "[cache][!hide][longRunning]") {
     manager.destroyCache(cacheMiss);
     manager.destroyCache(cacheMixed);
   }
+
+  SECTION("test ghost hit reporting") {
+    uint64_t cacheLimit = 256 * 1024;
+    auto postFn = [](std::function<void()>) -> bool { return false; };
+    Manager manager(postFn, 4 * cacheLimit);
+    auto cache = manager.createCache(CacheType::Plain, false, cacheLimit);
+
+    // insert far more than fits, so that many keys get evicted
+    for (uint64_t i = 0; i < 64 * 1024; i++) {
+      CachedValue* value =
+          CachedValue::construct(&i, sizeof(uint64_t), &i, sizeof(uint64_t));
+      TRI_ASSERT(value != nullptr);
+      auto status = cache->insert(value);
+      if (status.fail()) {
+        delete value;
+      }
+    }
+    REQUIRE(0 == cache->collectGhostHits());
+
+    // recently evicted keys are reported
+    uint64_t misses = 0;
+    for (uint64_t i = 64 * 1024; i > 0; i--) {
+      uint64_t j = i - 1;
+      auto f = cache->find(&j, sizeof(uint64_t));
+      if (!f.found()) {
+        misses++;
+      }
+    }
+    REQUIRE(misses > 0);
+    uint64_t ghostHits = cache->collectGhostHits();
+    REQUIRE(ghostHits > 0);
+    REQUIRE(ghostHits <= misses);
+    REQUIRE(0 == cache->collectGhostHits());
+
+    manager.destroyCache(cache);
+  }
+
+  SECTION("test statistics") {
+    uint64_t cacheLimit = 256 * 1024;
+    auto postFn = [](std::function<void()>) -> bool { return false; };
+    Manager manager(postFn, 4 * cacheLimit);
+    auto cache = manager.createCache(CacheType::Plain, false, cacheLimit);
+
+    auto stats = cache->statistics();
+    REQUIRE(0 == stats.evictionsInsert);
+    REQUIRE(0 == stats.insertsRejectedLimit);
+
+    // insert far more than fits, so that entries are evicted or rejected
+    uint64_t failures = 0;
+    for (uint64_t i = 0; i < 64 * 1024; i++) {
+      CachedValue* value =
+          CachedValue::construct(&i, sizeof(uint64_t), &i, sizeof(uint64_t));
+      TRI_ASSERT(value != nullptr);
+      auto status = cache->insert(value);
+      if (status.fail()) {
+        delete value;
+        failures++;
+      }
+    }
+    for (uint64_t i = 0; i < 64 * 1024; i++) {
+      cache->find(&i, sizeof(uint64_t));
+    }
+
+    stats = cache->statistics();
+    REQUIRE(stats.evictionsInsert > 0);
+    REQUIRE(failures == stats.insertsRejectedBusy +
+                            stats.insertsRejectedAdmission +
+                            stats.insertsRejectedLimit);
+    REQUIRE(0 == stats.insertsRejectedAdmission);
+    REQUIRE(0 == stats.insertsRejectedBlacklist);
+    REQUIRE(stats.lookups == stats.hits + stats.misses);
+    REQUIRE(stats.lookups > 0);
+    REQUIRE(stats.misses > 0);
+
+    manager.destroyCache(cache);
+  }
 }
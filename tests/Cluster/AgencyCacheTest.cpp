@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for AgencyCache
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Cluster/AgencyCache.h"
+
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace {
+void callAll(std::vector<AgencyCache::Callback> const& callbacks) {
+  for (auto const& cb : callbacks) {
+    cb();
+  }
+}
+}  // namespace
+
+TEST_CASE("AgencyCache", "[cluster][agency]") {
+  AgencyCache cache(1.0);
+
+  size_t planCalls = 0;
+  size_t currentCalls = 0;
+  cache.registerCallback(1, "/arango/Plan/Collections",
+                         [&planCalls]() { ++planCalls; });
+  cache.registerCallback(2, "/arango/Current",
+                         [&currentCalls]() { ++currentCalls; });
+
+  SECTION("fails reads until the first answer") {
+    CHECK(!cache.inSync());
+    CHECK(cache.read({"/arango/Plan"}).httpCode() == 503);
+  }
+
+  SECTION("a readDB replaces the cache and calls every callback") {
+    auto answer = VPackParser::fromJson(
+        "{\"commitIndex\":5,\"readDB\":"
+        "{\"arango\":{\"Plan\":{\"Version\":3}}}}");
+    callAll(cache.apply(answer->slice()));
+
+    CHECK(cache.index() == 5);
+    CHECK(cache.inSync());
+    CHECK(planCalls == 1);
+    CHECK(currentCalls == 1);
+
+    AgencyCommResult result = cache.read({"/arango/Plan/Version"});
+    REQUIRE(result.successful());
+    CHECK(result.slice()[0]
+              .get(std::vector<std::string>({"arango", "Plan", "Version"}))
+              .getNumber<int>() == 3);
+  }
+
+  SECTION("log entries only call the callbacks of touched keys") {
+    callAll(cache.apply(
+        VPackParser::fromJson("{\"commitIndex\":5,\"readDB\":{}}")->slice()));
+    planCalls = 0;
+    currentCalls = 0;
+
+    auto answer = VPackParser::fromJson(
+        "{\"commitIndex\":7,\"log\":["
+        "{\"index\":6,\"query\":{\"/arango/Plan/Collections/db/c\":"
+        "{\"op\":\"set\",\"new\":{\"name\":\"c\"}}}},"
+        "{\"index\":7,\"query\":{\"/arango/Plan/Version\":"
+        "{\"op\":\"increment\"}}}]}");
+    callAll(cache.apply(answer->slice()));
+
+    CHECK(cache.index() == 7);
+    CHECK(planCalls == 1);
+    CHECK(currentCalls == 0);
+
+    AgencyCommResult result =
+        cache.read({"/arango/Plan/Collections/db/c/name"});
+    REQUIRE(result.successful());
+    CHECK(result.slice()[0]
+              .get(std::vector<std::string>(
+                  {"arango", "Plan", "Collections", "db", "c", "name"}))
+              .copyString() == "c");
+  }
+
+  SECTION("unregistered callbacks are not called") {
+    cache.unregisterCallback(2);
+    callAll(cache.apply(
+        VPackParser::fromJson("{\"commitIndex\":1,\"readDB\":{}}")->slice()));
+    CHECK(planCalls == 1);
+    CHECK(currentCalls == 0);
+  }
+}
@@ -42,7 +42,7 @@ class ClusterCommTester : public ClusterComm {
 public:
   ClusterCommTester()
     : ClusterComm(false),
-      _oldSched(nullptr), _testerSched(1, 2, 3, 4, 5)
+      _oldSched(nullptr), _testerSched(1, 2, 3, 4, 5, 1, 1, 0, 0.1)
   {
     // fake a scheduler object
     _oldSched = SchedulerFeature::SCHEDULER;
@@ -73,6 +73,17 @@ public:
     return it->second;
   } // getResponse
 
+  void joinRequest(std::string const& key, communicator::Callbacks const& callbacks) {
+    _coalescedRequests[key].emplace_back(callbacks);
+  } // joinRequest
+
+  size_t coalescedRequests() const {
+    return _coalescedRequests.size();
+  } // coalescedRequests
+
+  using ClusterComm::coalescingKey;
+  using ClusterComm::coalescingCallbacks;
+
   void signalResponse() {
     CONDITION_LOCKER(locker, somethingReceived);
     somethingReceived.broadcast();
@@ -298,3 +309,78 @@ TEST_CASE("ClusterComm::wait", "[cluster][mev]") {
   } // out of order response
 
 }
+
+
+TEST_CASE("ClusterComm::coalescing", "[cluster]") {
+
+  SECTION("key") {
+    std::unordered_map<std::string, std::string> headers{{"a", "1"}, {"b", "2"}};
+    std::unordered_map<std::string, std::string> other{{"b", "2"}, {"a", "1"}};
+    std::string body("{}");
+
+    REQUIRE(ClusterCommTester::coalescingKey("tcp://a:1", "/_api/document/c/1", &body, headers) ==
+            ClusterCommTester::coalescingKey("tcp://a:1", "/_api/document/c/1", &body, other));
+
+    other["a"] = "2";
+    REQUIRE(ClusterCommTester::coalescingKey("tcp://a:1", "/_api/document/c/1", &body, headers) !=
+            ClusterCommTester::coalescingKey("tcp://a:1", "/_api/document/c/1", &body, other));
+    REQUIRE(ClusterCommTester::coalescingKey("tcp://a:1", "/_api/document/c/1", &body, headers) !=
+            ClusterCommTester::coalescingKey("tcp://a:2", "/_api/document/c/1", &body, headers));
+    REQUIRE(ClusterCommTester::coalescingKey("tcp://a:1", "/_api/document/c/1", &body, headers) !=
+            ClusterCommTester::coalescingKey("tcp://a:1", "/_api/document/c/1", nullptr, headers));
+  } // key
+
+  SECTION("joined requests get copies of the response") {
+    ClusterCommTester testme;
+    std::vector<std::string> bodies;
+    std::vector<int> errors;
+
+    communicator::Callbacks callbacks(
+        [&bodies](std::unique_ptr<GeneralResponse> response) {
+          REQUIRE(response != nullptr);
+          REQUIRE(ResponseCode::OK == response->responseCode());
+          bodies.emplace_back(static_cast<HttpResponse*>(response.get())->body().c_str());
+        },
+        [&errors](int errorCode, std::unique_ptr<GeneralResponse>) {
+          errors.push_back(errorCode);
+        });
+
+    testme.joinRequest("key", callbacks);
+    testme.joinRequest("key", callbacks);
+    auto leader = testme.coalescingCallbacks("key", callbacks);
+    REQUIRE(1 == testme.coalescedRequests());
+
+    std::unique_ptr<HttpResponse> response(new HttpResponse(ResponseCode::OK));
+    response->body().appendText("{\"count\":3}");
+    leader._onSuccess(std::move(response));
+
+    REQUIRE(0 == testme.coalescedRequests());
+    REQUIRE(3 == bodies.size());
+    for (auto const& it : bodies) {
+      REQUIRE("{\"count\":3}" == it);
+    }
+    REQUIRE(errors.empty());
+  } // joined requests get copies of the response
+
+  SECTION("joined requests get the error") {
+    ClusterCommTester testme;
+    std::vector<int> errors;
+
+    communicator::Callbacks callbacks(
+        [](std::unique_ptr<GeneralResponse>) { REQUIRE(false); },
+        [&errors](int errorCode, std::unique_ptr<GeneralResponse> response) {
+          REQUIRE(response == nullptr);
+          errors.push_back(errorCode);
+        });
+
+    testme.joinRequest("key", callbacks);
+    auto leader = testme.coalescingCallbacks("key", callbacks);
+    leader._onError(TRI_ERROR_CLUSTER_TIMEOUT, nullptr);
+
+    REQUIRE(0 == testme.coalescedRequests());
+    REQUIRE(2 == errors.size());
+    REQUIRE(TRI_ERROR_CLUSTER_TIMEOUT == errors[0]);
+    REQUIRE(TRI_ERROR_CLUSTER_TIMEOUT == errors[1]);
+  } // joined requests get the error
+
+}
@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for the local state of DBServerAgencySync
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Cluster/DBServerAgencySync.h"
+
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace {
+char const* plan = R"=({
+  "Version": 12,
+  "Databases": {"db": {"id": "1", "name": "db"}},
+  "Collections": {"db": {
+    "100": {"name": "mine", "indexes": [{"id": "0", "type": "primary"}],
+            "shards": {"s1": ["A", "B"], "s2": ["B", "C"]}},
+    "200": {"name": "other", "shards": {"s3": ["B", "C"]}}}}
+})=";
+
+char const* current = R"=({
+  "Version": 7,
+  "Databases": {"db": {"A": {"error": false}}},
+  "Collections": {"db": {
+    "100": {"s1": {"servers": ["A", "B"], "error": false,
+                   "indexes": [{"id": "0", "type": "primary"}]}}}}
+})=";
+
+bool state(std::string const& p, std::string const& c, VPackBuilder& out) {
+  auto planBuilder = VPackParser::fromJson(p);
+  auto currentBuilder = VPackParser::fromJson(c);
+  return DBServerAgencySync::localState(planBuilder->slice(),
+                                        currentBuilder->slice(), "A", out);
+}
+
+std::string replace(std::string s, std::string const& from, std::string const& to) {
+  auto pos = s.find(from);
+  REQUIRE(pos != std::string::npos);
+  return s.replace(pos, from.size(), to);
+}
+
+bool sameBytes(VPackBuilder const& a, VPackBuilder const& b) {
+  return a.slice().byteSize() == b.slice().byteSize() &&
+         memcmp(a.slice().start(), b.slice().start(), a.slice().byteSize()) == 0;
+}
+}  // namespace
+
+TEST_CASE("DBServerAgencySync", "[cluster][sync]") {
+  SECTION("only the shards of the server are part of its state") {
+    VPackBuilder out;
+    CHECK(state(plan, current, out));
+
+    VPackSlice collections = out.slice().get("Collections");
+    REQUIRE(collections.isObject());
+    CHECK(collections.length() == 1);
+    VPackSlice shards = collections.get(std::vector<std::string>({"db/100", "shards"}));
+    REQUIRE(shards.isObject());
+    CHECK(shards.length() == 1);
+    CHECK(shards.hasKey("s1"));
+  }
+
+  SECTION("changes for other servers do not change the state") {
+    VPackBuilder before;
+    VPackBuilder after;
+    state(plan, current, before);
+    CHECK(state(replace(plan, "\"s3\": [\"B\", \"C\"]", "\"s3\": [\"C\", \"B\"]"),
+                replace(current, "\"Version\": 7", "\"Version\": 8"), after));
+    CHECK(sameBytes(before, after));
+  }
+
+  SECTION("changes for the server change the state") {
+    VPackBuilder before;
+    VPackBuilder after;
+    state(plan, current, before);
+    state(replace(plan, "\"s2\": [\"B\", \"C\"]", "\"s2\": [\"B\", \"A\"]"),
+          current, after);
+    CHECK_FALSE(sameBytes(before, after));
+  }
+
+  SECTION("missing followers and indexes are work left to do") {
+    VPackBuilder out;
+    CHECK_FALSE(state(plan, replace(current, "\"servers\": [\"A\", \"B\"]",
+                                    "\"servers\": [\"B\"]"), out));
+    out.clear();
+    CHECK_FALSE(state(replace(plan, "{\"id\": \"0\", \"type\": \"primary\"}",
+                              "{\"id\": \"0\", \"type\": \"primary\"}, {\"id\": \"5\"}"),
+                      current, out));
+    out.clear();
+    CHECK_FALSE(state(plan, replace(current, "\"A\": {\"error\": false}",
+                                    "\"A\": {\"error\": true}"), out));
+  }
+
+  SECTION("shards the server leads without a plan are work left to do") {
+    VPackBuilder out;
+    CHECK_FALSE(state(plan, replace(current, "\"100\": {",
+                                    "\"300\": {\"s9\": {\"servers\": [\"A\"]}}, \"100\": {"),
+                      out));
+  }
+}
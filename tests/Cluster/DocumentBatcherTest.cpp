@@ -0,0 +1,215 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for DocumentBatcher
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+#include "Basics/StaticStrings.h"
+#include "Cluster/DocumentBatcher.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace {
+struct Request {
+  rest::RequestType type;
+  std::string shard;
+  std::string url;
+  std::string body;
+};
+
+// answers every document with itself, except for documents with a
+// "fail" attribute, which get a per-document error
+struct FakeSender {
+  std::mutex lock;
+  std::vector<Request> requests;
+
+  DocumentBatcher::Sender sender() {
+    return [this](rest::RequestType type, std::string const& shard,
+                  std::string const& url, std::string const& body,
+                  rest::ResponseCode& responseCode,
+                  std::shared_ptr<VPackBuilder>& answer) -> int {
+      {
+        std::lock_guard<std::mutex> guard(lock);
+        requests.push_back(Request{type, shard, url, body});
+      }
+      auto documents = VPackParser::fromJson(body);
+      answer = std::make_shared<VPackBuilder>();
+      answer->openArray();
+      for (auto const& document : VPackArrayIterator(documents->slice())) {
+        if (document.hasKey("fail")) {
+          answer->openObject();
+          answer->add(StaticStrings::Error, VPackValue(true));
+          answer->add(StaticStrings::ErrorNum,
+                      VPackValue(document.get("fail").getNumber<int>()));
+          answer->add(StaticStrings::ErrorMessage, VPackValue("failed"));
+          answer->close();
+        } else {
+          answer->add(document);
+        }
+      }
+      answer->close();
+      responseCode = rest::ResponseCode::ACCEPTED;
+      return TRI_ERROR_NO_ERROR;
+    };
+  }
+};
+
+struct Outcome {
+  int error = TRI_ERROR_NO_ERROR;
+  rest::ResponseCode responseCode = rest::ResponseCode::PROCESSING;
+  std::shared_ptr<VPackBuilder> body;
+};
+
+void runConcurrently(DocumentBatcher& batcher, std::string const& url,
+                     std::vector<std::string> const& documents,
+                     std::vector<Outcome>& outcomes) {
+  outcomes.resize(documents.size());
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < documents.size(); ++i) {
+    threads.emplace_back([&, i]() {
+      auto document = VPackParser::fromJson(documents[i]);
+      outcomes[i].error = batcher.execute(
+          rest::RequestType::POST, "s1", url, document->slice(),
+          outcomes[i].responseCode, outcomes[i].body);
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+}
+}  // namespace
+
+TEST_CASE("DocumentBatcher", "[cluster][batcher]") {
+  FakeSender fake;
+
+  SECTION("concurrent operations share one request") {
+    DocumentBatcher batcher(200000, 100, fake.sender());
+
+    std::vector<Outcome> outcomes;
+    runConcurrently(batcher, "/_api/document/s1",
+                    {"{\"_key\":\"a\"}", "{\"_key\":\"b\"}",
+                     "{\"_key\":\"c\",\"fail\":1210}", "{\"_key\":\"d\"}"},
+                    outcomes);
+
+    REQUIRE(fake.requests.size() == 1);
+    CHECK(fake.requests[0].shard == "s1");
+    CHECK(fake.requests[0].url == "/_api/document/s1");
+    CHECK(VPackParser::fromJson(fake.requests[0].body)->slice().length() == 4);
+    CHECK(batcher.batches() == 1);
+    CHECK(batcher.documents() == 4);
+
+    size_t failed = 0;
+    for (auto const& outcome : outcomes) {
+      REQUIRE(outcome.error == TRI_ERROR_NO_ERROR);
+      REQUIRE(outcome.body != nullptr);
+      VPackSlice result = outcome.body->slice();
+      if (result.hasKey(StaticStrings::Error)) {
+        ++failed;
+        CHECK(outcome.responseCode == rest::ResponseCode::CONFLICT);
+        CHECK(result.get(StaticStrings::ErrorNum).getNumber<int>() == 1210);
+      } else {
+        CHECK(outcome.responseCode == rest::ResponseCode::ACCEPTED);
+      }
+    }
+    CHECK(failed == 1);
+
+    // every operation got its own document back
+    std::vector<std::string> keys;
+    for (auto const& outcome : outcomes) {
+      VPackSlice key = outcome.body->slice().get(StaticStrings::KeyString);
+      if (key.isString()) {
+        keys.push_back(key.copyString());
+      }
+    }
+    std::sort(keys.begin(), keys.end());
+    CHECK((keys == std::vector<std::string>{"a", "b", "d"}));
+  }
+
+  SECTION("revision conflicts are failed preconditions") {
+    DocumentBatcher batcher(1000, 100, fake.sender());
+
+    std::vector<Outcome> outcomes;
+    runConcurrently(batcher, "/_api/document/s1",
+                    {"{\"_key\":\"a\",\"fail\":1200}"}, outcomes);
+
+    REQUIRE(outcomes[0].error == TRI_ERROR_NO_ERROR);
+    CHECK(outcomes[0].responseCode == rest::ResponseCode::PRECONDITION_FAILED);
+  }
+
+  SECTION("full batches are sent without waiting") {
+    // the window is far longer than the test may take
+    DocumentBatcher batcher(600000000, 1, fake.sender());
+
+    std::vector<Outcome> outcomes;
+    runConcurrently(batcher, "/_api/document/s1",
+                    {"{\"_key\":\"a\"}", "{\"_key\":\"b\"}"}, outcomes);
+
+    CHECK(fake.requests.size() == 2);
+    for (auto const& outcome : outcomes) {
+      CHECK(outcome.error == TRI_ERROR_NO_ERROR);
+      CHECK(outcome.responseCode == rest::ResponseCode::ACCEPTED);
+    }
+  }
+
+  SECTION("different urls are not batched together") {
+    DocumentBatcher batcher(1000, 100, fake.sender());
+
+    std::vector<Outcome> first;
+    std::vector<Outcome> second;
+    std::thread other([&]() {
+      runConcurrently(batcher, "/_api/document/s1?returnNew=true",
+                      {"{\"_key\":\"b\"}"}, second);
+    });
+    runConcurrently(batcher, "/_api/document/s1", {"{\"_key\":\"a\"}"}, first);
+    other.join();
+
+    CHECK(fake.requests.size() == 2);
+    CHECK(first[0].body->slice().get(StaticStrings::KeyString).copyString() == "a");
+    CHECK(second[0].body->slice().get(StaticStrings::KeyString).copyString() == "b");
+  }
+
+  SECTION("communication errors are reported to all operations") {
+    DocumentBatcher batcher(100000, 100,
+                            [](rest::RequestType, std::string const&,
+                               std::string const&, std::string const&,
+                               rest::ResponseCode&,
+                               std::shared_ptr<VPackBuilder>&) -> int {
+                              return TRI_ERROR_CLUSTER_TIMEOUT;
+                            });
+
+    std::vector<Outcome> outcomes;
+    runConcurrently(batcher, "/_api/document/s1",
+                    {"{\"_key\":\"a\"}", "{\"_key\":\"b\"}"}, outcomes);
+
+    for (auto const& outcome : outcomes) {
+      CHECK(outcome.error == TRI_ERROR_CLUSTER_TIMEOUT);
+    }
+  }
+}
@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for ShardStatisticsCache
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+#include <chrono>
+#include <thread>
+
+#include "Cluster/ShardStatisticsCache.h"
+
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+TEST_CASE("ShardStatisticsCache", "[cluster][statistics]") {
+  ShardStatisticsCache::Counts const counts{{"s1", 3}, {"s2", 4}};
+
+  SECTION("values are fetched until they are stored") {
+    ShardStatisticsCache cache(3600.0);
+
+    ShardStatisticsCache::Counts result;
+    CHECK(!cache.counts("db/1", result));
+    CHECK(!cache.counts("db/1", result));
+
+    cache.storeCounts("db/1", counts);
+    REQUIRE(cache.counts("db/1", result));
+    CHECK(result == counts);
+
+    // the figures of a collection are separate from its counts, and
+    // collections from each other
+    std::shared_ptr<VPackBuilder const> figures;
+    CHECK(!cache.figures("db/1", figures));
+    CHECK(!cache.counts("db/2", result));
+
+    cache.storeFigures("db/1", VPackParser::fromJson("{\"alive\":{\"count\":7}}"));
+    REQUIRE(cache.figures("db/1", figures));
+    CHECK(figures->slice().get("alive").get("count").getNumber<int>() == 7);
+  }
+
+  SECTION("one caller refreshes an expired value") {
+    ShardStatisticsCache cache(0.05);
+    cache.storeCounts("db/1", counts);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // the first caller is told to count, the next ones get the old value
+    ShardStatisticsCache::Counts result;
+    CHECK(!cache.counts("db/1", result));
+    REQUIRE(cache.counts("db/1", result));
+    CHECK(result == counts);
+
+    ShardStatisticsCache::Counts const newCounts{{"s1", 5}, {"s2", 4}};
+    cache.storeCounts("db/1", newCounts);
+    REQUIRE(cache.counts("db/1", result));
+    CHECK(result == newCounts);
+  }
+
+  SECTION("values nobody looks at are removed") {
+    ShardStatisticsCache cache(0.2);
+
+    // lookups of unknown collections do not add them
+    ShardStatisticsCache::Counts result;
+    CHECK(!cache.counts("db/1", result));
+    std::shared_ptr<VPackBuilder const> figures;
+    CHECK(!cache.figures("db/1", figures));
+    CHECK(0 == cache.size());
+
+    cache.storeCounts("db/1", counts);
+    cache.storeCounts("db/2", counts);
+    cache.storeFigures("db/2", VPackParser::fromJson("{\"alive\":{\"count\":7}}"));
+    CHECK(2 == cache.size());
+
+    // stale once expired for another ttl, unless a refresh was started
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    CHECK(!cache.counts("db/2", result));
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+
+    // e.g. db/1 was dropped, and only db/2 is still used
+    cache.storeCounts("db/3", counts);
+    CHECK(2 == cache.size());
+    CHECK(!cache.counts("db/1", result));
+    REQUIRE(cache.counts("db/3", result));
+    CHECK(result == counts);
+  }
+}
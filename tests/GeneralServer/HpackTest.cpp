@@ -0,0 +1,147 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/StringBuffer.h"
+#include "GeneralServer/Hpack.h"
+
+#include "catch.hpp"
+
+using namespace arangodb;
+using namespace arangodb::basics;
+using namespace arangodb::rest;
+
+namespace {
+
+std::string fromHex(std::string const& hex) {
+  std::string result;
+  for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+    result.push_back(
+        static_cast<char>(std::stoi(hex.substr(i, 2), nullptr, 16)));
+  }
+  return result;
+}
+
+bool decode(HpackDecoder& decoder, std::string const& block,
+            HpackDecoder::HeaderList& headers) {
+  return decoder.decode(reinterpret_cast<uint8_t const*>(block.data()),
+                        block.size(), 1024 * 1024, headers);
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+/// @brief test the HPACK decoder and encoder
+TEST_CASE("Hpack", "[http2][hpack]") {
+  SECTION("decode requests with Huffman coding, RFC 7541 C.4") {
+    HpackDecoder decoder;
+    HpackDecoder::HeaderList headers;
+
+    REQUIRE(decode(decoder, fromHex("828684418cf1e3c2e5f23a6ba0ab90f4ff"),
+                   headers));
+    REQUIRE(headers.size() == 4);
+    CHECK(headers[0].first == ":method");
+    CHECK(headers[0].second == "GET");
+    CHECK(headers[1].second == "http");
+    CHECK(headers[2].second == "/");
+    CHECK(headers[3].first == ":authority");
+    CHECK(headers[3].second == "www.example.com");
+
+    // refers to the :authority entry of the dynamic table
+    headers.clear();
+    REQUIRE(decode(decoder, fromHex("828684be5886a8eb10649cbf"), headers));
+    REQUIRE(headers.size() == 5);
+    CHECK(headers[3].second == "www.example.com");
+    CHECK(headers[4].first == "cache-control");
+    CHECK(headers[4].second == "no-cache");
+
+    headers.clear();
+    REQUIRE(decode(
+        decoder,
+        fromHex("828785bf408825a849e95ba97d7f8925a849e95bb8e8b4bf"),
+        headers));
+    REQUIRE(headers.size() == 5);
+    CHECK(headers[1].second == "https");
+    CHECK(headers[2].second == "/index.html");
+    CHECK(headers[3].second == "www.example.com");
+    CHECK(headers[4].first == "custom-key");
+    CHECK(headers[4].second == "custom-value");
+  }
+
+  SECTION("encoded fields can be decoded") {
+    StringBuffer buffer(false);
+    HpackEncoder::addStatus(buffer, 200);
+    HpackEncoder::addStatus(buffer, 418);
+    HpackEncoder::add(buffer, "content-type", "application/json");
+    HpackEncoder::add(buffer, "x-arango-custom", std::string(200, 'x'));
+
+    HpackDecoder decoder;
+    HpackDecoder::HeaderList headers;
+    REQUIRE(decoder.decode(reinterpret_cast<uint8_t const*>(buffer.c_str()),
+                           buffer.length(), 1024 * 1024, headers));
+    REQUIRE(headers.size() == 4);
+    CHECK(headers[0].first == ":status");
+    CHECK(headers[0].second == "200");
+    CHECK(headers[1].first == ":status");
+    CHECK(headers[1].second == "418");
+    CHECK(headers[2].first == "content-type");
+    CHECK(headers[2].second == "application/json");
+    CHECK(headers[3].first == "x-arango-custom");
+    CHECK(headers[3].second == std::string(200, 'x'));
+  }
+
+  SECTION("invalid blocks are rejected") {
+    HpackDecoder decoder;
+    HpackDecoder::HeaderList headers;
+
+    // index 0
+    CHECK_FALSE(decode(decoder, fromHex("80"), headers));
+    // index beyond the empty dynamic table
+    CHECK_FALSE(decode(decoder, fromHex("be"), headers));
+    // truncated string
+    CHECK_FALSE(decode(decoder, fromHex("400a6b6579"), headers));
+    // table size update above the announced maximum
+    CHECK_FALSE(decode(decoder, fromHex("3fe21f"), headers));
+  }
+
+  SECTION("the header list size is limited") {
+    HpackDecoder decoder;
+    HpackDecoder::HeaderList headers;
+    std::string const block = fromHex("828684418cf1e3c2e5f23a6ba0ab90f4ff");
+    CHECK_FALSE(decoder.decode(reinterpret_cast<uint8_t const*>(block.data()),
+                               block.size(), 100, headers));
+  }
+
+  SECTION("Huffman padding must be a prefix of EOS") {
+    std::string result;
+    uint8_t const zeros[] = {0x00};  // '0' followed by 3 unset bits
+    CHECK_FALSE(HpackDecoder::decodeHuffman(zeros, sizeof(zeros), result));
+
+    uint8_t const eos[] = {0xff, 0xff, 0xff, 0xff};
+    CHECK_FALSE(HpackDecoder::decodeHuffman(eos, sizeof(eos), result));
+
+    uint8_t const padded[] = {0x07};  // '0' followed by 3 set bits
+    CHECK(HpackDecoder::decodeHuffman(padded, sizeof(padded), result));
+    CHECK(result == "0");
+  }
+}
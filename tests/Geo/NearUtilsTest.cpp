@@ -177,6 +177,28 @@ TEST_CASE("Simple near queries", "[geo][s2index]") {
     REQUIRE(lastRad != 0);
   }
 
+  SECTION("query all sorted ascending with limit hint") {
+    params.ascending = true;
+    params.pointsOnly = true;
+    params.limit = 10;
+    AscIterator near(std::move(params));
+
+    // the hint only sizes the scan rings, all results are still returned
+    std::vector<LocalDocumentId> result = nearSearch(index, docs, near, SIZE_MAX);
+    std::set<LocalDocumentId> unique(result.begin(), result.end());
+    REQUIRE(result.size() == counter);
+    REQUIRE(unique.size() == counter);
+
+    double lastRad = 0;
+    for (LocalDocumentId rev : result) {
+      S2Point pp = docs.at(rev).ToPoint();
+      double rad = near.origin().Angle(pp);
+      bool eq = rad > lastRad || std::fabs(rad - lastRad) <= geo::kRadEps;
+      REQUIRE(eq); // rad >= lastRad
+      lastRad = rad;
+    }
+  }
+
   SECTION("query all sorted ascending with limit") {
     params.ascending = true;
     AscIterator near(std::move(params));
@@ -464,6 +486,53 @@ TEST_CASE("Query points contained in", "[geo][s2index]") {
                   { 26.0, -10.0 }, { 26.0, -9.0 }, { 26.0, -8.0 }, { 26.0, -7.0 }, { 26.0, -6.0 }});
   }
   
+  SECTION("large polygon with interior cells") {
+    auto polygon = createBuilder(R"=({"type": "Polygon", "coordinates":
+                                 [[[-30, -20], [20, -30], [30, 20], [0, 30], [-20, 25], [-30, -20]]]})=");
+
+    geo::ShapeContainer shape;
+    geo::geojson::parsePolygon(polygon->slice(), shape);
+    geo::geojson::parsePolygon(polygon->slice(), params.filterShape);
+    params.filterShape.updateBounds(params);
+    params.pointsOnly = true;
+
+    size_t expected = 0;
+    for (auto const& it : docs) {
+      if (shape.contains(it.second.ToPoint())) {
+        expected++;
+      }
+    }
+
+    AscIterator near(std::move(params));
+    size_t found = 0;
+    size_t contained = 0;
+    while (!near.isDone()) {
+      for (geo::Interval const& interval : near.intervals()) {
+        index_t::const_iterator it = index.lower_bound(interval.range_min);
+        while (it != index.end() && it->first <= interval.range_max) {
+          near.reportFound(it->second, docs.at(it->second).ToPoint());
+          it++;
+        }
+      }
+      near.didScanIntervals();
+
+      while (near.hasNearest()) {
+        geo_index::Document const& doc = near.nearest();
+        // documents in interior cells must be in the shape
+        REQUIRE(shape.contains(docs.at(doc.token).ToPoint()));
+        if (doc.contained) {
+          contained++;
+        }
+        found++;
+        near.popNearest();
+      }
+    }
+    REQUIRE(found == expected);
+    // points far away from the boundary skip the exact test
+    REQUIRE(contained > 0);
+    REQUIRE(contained < found);
+  }
+
   SECTION("rectangle") {
     auto rect = createBuilder(R"=({"type": "Polygon", "coordinates":[[[0,0],[1.5,0],[1.5,1.5],[0,1.5],[0,0]]]})=");
     geo::geojson::parsePolygon(rect->slice(), params.filterShape);
@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include <s2/s2latlng.h>
+
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include "Basics/Common.h"
+#include "Geo/ShapeCache.h"
+#include "Geo/ShapeContainer.h"
+
+using namespace arangodb;
+using namespace arangodb::geo;
+
+namespace {
+std::shared_ptr<VPackBuilder> square(double lng, double lat) {
+  std::string const json =
+      "{\"type\":\"Polygon\",\"coordinates\":[[[" + std::to_string(lng) + "," +
+      std::to_string(lat) + "],[" + std::to_string(lng + 1) + "," +
+      std::to_string(lat) + "],[" + std::to_string(lng + 1) + "," +
+      std::to_string(lat + 1) + "],[" + std::to_string(lng) + "," +
+      std::to_string(lat + 1) + "],[" + std::to_string(lng) + "," +
+      std::to_string(lat) + "]]]}";
+  return VPackParser::fromJson(json);
+}
+
+S2Point point(double lng, double lat) {
+  return S2LatLng::FromDegrees(lat, lng).ToPoint();
+}
+}  // namespace
+
+TEST_CASE("ShapeCache", "[geo]") {
+  SECTION("cached shapes are copies of the parsed ones") {
+    ShapeCache cache(0, 1024 * 1024);
+    auto polygon = square(6.0, 50.0);
+
+    for (size_t i = 0; i < 2; ++i) {
+      ShapeContainer shape;
+      REQUIRE(cache.parseRegion(polygon->slice(), shape).ok());
+      CHECK(shape.type() == ShapeContainer::Type::S2_POLYGON);
+      CHECK(shape.contains(point(6.5, 50.5)));
+      CHECK_FALSE(shape.contains(point(7.5, 50.5)));
+      CHECK(cache.size() == 1);
+    }
+  }
+
+  SECTION("invalid shapes are not cached") {
+    ShapeCache cache(0, 1024 * 1024);
+    auto invalid = VPackParser::fromJson("{\"type\":\"Polygon\",\"coordinates\":[]}");
+
+    ShapeContainer shape;
+    CHECK(cache.parseRegion(invalid->slice(), shape).fail());
+    CHECK(cache.size() == 0);
+  }
+
+  SECTION("small shapes are not cached") {
+    ShapeCache cache(1024, 1024 * 1024);
+    auto polygon = square(6.0, 50.0);
+
+    ShapeContainer shape;
+    REQUIRE(cache.parseRegion(polygon->slice(), shape).ok());
+    CHECK(shape.contains(point(6.5, 50.5)));
+    CHECK(cache.size() == 0);
+  }
+
+  SECTION("the oldest shapes are evicted") {
+    auto first = square(6.0, 50.0);
+    ShapeCache cache(0, 2 * first->slice().byteSize());
+
+    for (double lng : {6.0, 7.0, 8.0}) {
+      ShapeContainer shape;
+      REQUIRE(cache.parseRegion(square(lng, 50.0)->slice(), shape).ok());
+      CHECK(shape.contains(point(lng + 0.5, 50.5)));
+    }
+    CHECK(cache.size() == 2);
+  }
+}
@@ -101,6 +101,43 @@ TEST_CASE("ClusterTraverserCache", "[aql][cluster]") {
     fakeit::Verify(Method(queryMock, registerWarning)).Exactly(1);
   }
 
+  SECTION("it should key locally expanded edges by depth and vertex") {
+    std::string vertexId = "UnitTest/Vertex";
+
+    REQUIRE(ClusterTraverserCache::localEdgesKey(StringRef(vertexId), 1) ==
+            ClusterTraverserCache::localEdgesKey(StringRef(vertexId), 1));
+    REQUIRE(ClusterTraverserCache::localEdgesKey(StringRef(vertexId), 1) !=
+            ClusterTraverserCache::localEdgesKey(StringRef(vertexId), 2));
+    REQUIRE(ClusterTraverserCache::localEdgesKey(StringRef(vertexId), 1) !=
+            ClusterTraverserCache::localEdgesKey(StringRef("UnitTest/Other"), 1));
+  }
+
+  SECTION("it should persist every id once with a dense number") {
+    std::unordered_map<ServerID, traverser::TraverserEngineID> engines;
+
+    fakeit::Mock<transaction::Methods> trxMock;
+    transaction::Methods& trx = trxMock.get();
+
+    fakeit::Mock<Query> queryMock;
+    Query& query = queryMock.get();
+    fakeit::When(Method(queryMock, trx)).AlwaysReturn(&trx);
+
+    ClusterTraverserCache testee(&query, &engines);
+
+    std::string first = "UnitTest/First";
+    std::string second = "UnitTest/Second";
+    uint32_t firstId = testee.persistId(StringRef(first));
+    uint32_t secondId = testee.persistId(StringRef(second));
+    REQUIRE(firstId == 0);
+    REQUIRE(secondId == 1);
+    REQUIRE(testee.persistId(StringRef(std::string(first))) == firstId);
+
+    StringRef persisted = testee.persistString(StringRef(second));
+    REQUIRE(persisted.compare(StringRef(second)) == 0);
+    REQUIRE(persisted.data() != second.data());
+    REQUIRE(persisted.data() == testee.persistedString(secondId).data());
+  }
+
 }
 
 } // cluster_traveser_cache_test
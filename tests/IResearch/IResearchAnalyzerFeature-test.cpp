@@ -525,6 +525,53 @@ SECTION("test_identity") {
   }
 }
 
+SECTION("test_token_cache") {
+  arangodb::iresearch::IResearchAnalyzerFeature feature(nullptr);
+  auto pool = feature.get("text_en");
+  REQUIRE((false == !pool));
+
+  auto collect = [](irs::token_stream& stream)->std::vector<std::string> {
+    std::vector<std::string> tokens;
+    auto& term = stream.attributes().get<irs::term_attribute>();
+    auto& offset = stream.attributes().get<irs::offset>();
+    REQUIRE((false == !term));
+    REQUIRE((false == !offset));
+
+    while (stream.next()) {
+      tokens.emplace_back(
+        static_cast<std::string>(irs::ref_cast<char>(term->value())) + "@" + std::to_string(offset->start)
+        + "-" + std::to_string(offset->end)
+      );
+    }
+
+    return tokens;
+  };
+
+  std::string const longValue(100, 'a');
+
+  for (irs::string_ref value: { irs::string_ref("Quick brown foxes"), irs::string_ref(longValue) }) {
+    auto analyzer = pool->get();
+    REQUIRE((false == !analyzer));
+    CHECK((analyzer->reset(value)));
+    auto const expected = collect(*analyzer);
+    CHECK((!expected.empty()));
+
+    // 1st time tokenized, 2nd time replayed from the cache for short values
+    for (size_t i = 0; i < 2; ++i) {
+      auto stream = pool->tokens(value);
+      REQUIRE((false == !stream));
+      CHECK((expected == collect(*stream)));
+    }
+  }
+
+  // identity values are not cached
+  {
+    auto stream = arangodb::iresearch::IResearchAnalyzerFeature::identity()->tokens("abc");
+    REQUIRE((false == !stream));
+    CHECK((nullptr != dynamic_cast<irs::analysis::analyzer*>(stream.get())));
+  }
+}
+
 SECTION("test_persistence") {
   auto* database = arangodb::application_features::ApplicationServer::lookupFeature<
     arangodb::iresearch::SystemDatabaseFeature
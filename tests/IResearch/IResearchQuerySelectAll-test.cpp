@@ -63,14 +63,110 @@
 #include "IResearch/VelocyPackHelper.h"
 #include "analysis/analyzers.hpp"
 #include "analysis/token_attributes.hpp"
+#include "search/scorers.hpp"
 #include "utils/utf8_path.hpp"
 
 #include <velocypack/Iterator.h>
 
+#include <array>
+
 extern const char* ARGV0; // defined in main.cpp
 
 NS_LOCAL
 
+// scores documents by their id, as a string of decimal digits, so that an
+// AQL SORT on the scores orders them the same way as the view
+struct DocIdScorer: public irs::sort {
+  typedef std::array<char, 8> score_t;
+
+  DECLARE_SORT_TYPE() { static irs::sort::type_id type("docidscorer"); return type; }
+  static ptr make(const irs::string_ref&) { PTR_NAMED(DocIdScorer, ptr); return ptr; }
+  DocIdScorer(): irs::sort(DocIdScorer::type()) { }
+  virtual sort::prepared::ptr prepare() const override { PTR_NAMED(Prepared, ptr); return ptr; }
+
+  struct Prepared: public irs::sort::prepared_base<score_t> {
+    virtual void add(score_t& dst, const score_t& src) const override { dst = src; }
+    virtual irs::flags const& features() const override { return irs::flags::empty_instance(); }
+    virtual bool less(const score_t& lhs, const score_t& rhs) const override { return lhs < rhs; }
+    virtual irs::sort::collector::ptr prepare_collector() const override { return nullptr; }
+    virtual void prepare_score(score_t& score) const override { score.fill('0'); }
+    virtual irs::sort::scorer::ptr prepare_scorer(
+      irs::sub_reader const& segment,
+      irs::term_reader const& field,
+      irs::attribute_store const& query_attrs,
+      irs::attribute_view const& doc_attrs
+    ) const override {
+      return irs::sort::scorer::make<Scorer>(doc_attrs.get<irs::document>());
+    }
+  };
+
+  struct Scorer: public irs::sort::scorer {
+    irs::attribute_view::ref<irs::document>::type const& _doc;
+    Scorer(irs::attribute_view::ref<irs::document>::type const& doc): _doc(doc) { }
+    virtual void score(irs::byte_type* score_buf) override {
+      auto& score = reinterpret_cast<score_t&>(*score_buf);
+      auto value = _doc.get()->value;
+
+      for (auto i = score.size(); i > 0; --i, value /= 10) {
+        score[i - 1] = static_cast<char>('0' + value % 10);
+      }
+    }
+  };
+};
+
+REGISTER_SCORER_JSON(DocIdScorer, DocIdScorer::make);
+
+// returns the number of best documents the view node of the query collects
+// by itself, 0 if it returns all of them
+size_t viewLimit(
+    TRI_vocbase_t& vocbase,
+    std::string const& queryString,
+    std::string const& options = "{ }"
+) {
+  arangodb::aql::Query query(
+    false,
+    vocbase,
+    arangodb::aql::QueryString(queryString),
+    nullptr,
+    arangodb::velocypack::Parser::fromJson(options),
+    arangodb::aql::PART_MAIN
+  );
+
+  auto const res = query.explain();
+  REQUIRE(res.result);
+
+  size_t views = 0;
+  size_t limit = 0;
+
+  for (auto const node : arangodb::velocypack::ArrayIterator(res.result->slice().get("nodes"))) {
+    if (node.get("type").isEqualString("EnumerateViewNode")) {
+      auto const limitSlice = node.get("limit");
+      limit = limitSlice.isNumber() ? limitSlice.getNumber<size_t>() : 0;
+      ++views;
+    }
+  }
+  CHECK(1 == views);
+
+  return limit;
+}
+
+// returns the keys of the documents returned by the query
+std::vector<size_t> resultKeys(arangodb::aql::QueryResult const& queryResult) {
+  std::vector<size_t> keys;
+
+  for (auto const doc : arangodb::velocypack::ArrayIterator(queryResult.result->slice())) {
+    keys.emplace_back(doc.resolveExternals().get("key").getNumber<size_t>());
+  }
+
+  return keys;
+}
+
+// returns the number of documents the view returned to the query
+size_t scannedIndex(arangodb::aql::QueryResult const& queryResult) {
+  REQUIRE(queryResult.extra);
+  return queryResult.extra->slice().get("stats").get("scannedIndex").getNumber<size_t>();
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 setup / tear-down
 // -----------------------------------------------------------------------------
@@ -505,6 +601,107 @@ TEST_CASE("IResearchQueryTestSelectAll", "[iresearch][iresearch-query]") {
     }
     CHECK(expectedDoc == expectedDocs.rend());
   }
+
+  // SORT on the scores followed by a LIMIT, the view collects the best
+  // offset + count documents by itself
+  {
+    CHECK(15 == viewLimit(vocbase, "FOR d IN VIEW testView SORT DOCIDSCORER(d) DESC LIMIT 5, 10 RETURN d"));
+    CHECK(10 == viewLimit(vocbase, "FOR d IN VIEW testView SORT DOCIDSCORER(d) LIMIT 10 RETURN d"));
+    CHECK(3 == viewLimit(vocbase, "FOR d IN VIEW testView SORT DOCIDSCORER(d) LET key = d.key LIMIT 1, 2 RETURN key"));
+
+    // the view returns all documents
+    CHECK(0 == viewLimit(vocbase, "FOR d IN VIEW testView SORT DOCIDSCORER(d) DESC RETURN d"));
+    CHECK(0 == viewLimit(vocbase, "FOR d IN VIEW testView SORT DOCIDSCORER(d), d.key LIMIT 10 RETURN d"));
+    CHECK(0 == viewLimit(vocbase, "FOR d IN VIEW testView SORT d.key LIMIT 10 RETURN d"));
+    CHECK(0 == viewLimit(vocbase, "FOR d IN VIEW testView LIMIT 10 SORT DOCIDSCORER(d) RETURN d"));
+    CHECK(0 == viewLimit(vocbase, "FOR d IN VIEW testView SORT DOCIDSCORER(d) LIMIT 10 RETURN d", "{ \"fullCount\": true }"));
+    CHECK(0 == viewLimit(vocbase, "FOR i IN 1..2 FOR d IN VIEW testView SORT DOCIDSCORER(d) LIMIT 10 RETURN d"));
+  }
+
+  // the best documents are the ones the SORT would have kept
+  for (std::string const direction : { "ASC", "DESC" }) {
+    INFO(direction);
+    auto const all = arangodb::tests::executeQuery(
+      vocbase,
+      "FOR d IN VIEW testView SORT DOCIDSCORER(d) " + direction + " RETURN d"
+    );
+    REQUIRE(TRI_ERROR_NO_ERROR == all.code);
+    auto const allKeys = resultKeys(all);
+    REQUIRE(insertedDocs.size() == allKeys.size());
+    CHECK(insertedDocs.size() == scannedIndex(all));
+
+    // documents are scored in the order of their ids
+    for (size_t i = 1; i < allKeys.size(); ++i) {
+      CHECK(("ASC" == direction) == (allKeys[i - 1] < allKeys[i]));
+    }
+
+    for (size_t offset : { 0, 5, 80, 84, 100 }) {
+      INFO("offset " << offset);
+      auto const limited = arangodb::tests::executeQuery(
+        vocbase,
+        "FOR d IN VIEW testView SORT DOCIDSCORER(d) " + direction + " LIMIT " + std::to_string(offset) + ", 10 RETURN d"
+      );
+      REQUIRE(TRI_ERROR_NO_ERROR == limited.code);
+
+      auto const begin = allKeys.begin() + (std::min)(offset, allKeys.size());
+      auto const end = allKeys.begin() + (std::min)(offset + 10, allKeys.size());
+      CHECK((std::vector<size_t>(begin, end) == resultKeys(limited)));
+      CHECK((std::min)(offset + 10, allKeys.size()) == scannedIndex(limited));
+    }
+  }
+
+  // pages of the best documents. the view node takes offset + count along
+  // to the DB-servers, the SORT and the LIMIT with its offset stay above it
+  // and run on the coordinator
+  {
+    std::string const query = "FOR d IN VIEW testView SORT DOCIDSCORER(d) DESC LIMIT 20, 10 RETURN d";
+
+    arangodb::aql::Query explained(
+      false, vocbase, arangodb::aql::QueryString(query), nullptr,
+      arangodb::velocypack::Parser::fromJson("{ }"), arangodb::aql::PART_MAIN
+    );
+    auto const res = explained.explain();
+    REQUIRE(res.result);
+
+    std::vector<std::string> types;
+    for (auto const node : arangodb::velocypack::ArrayIterator(res.result->slice().get("nodes"))) {
+      types.emplace_back(node.get("type").copyString());
+
+      if (node.get("type").isEqualString("EnumerateViewNode")) {
+        CHECK(30 == node.get("limit").getNumber<size_t>());
+      } else if (node.get("type").isEqualString("LimitNode")) {
+        CHECK(20 == node.get("offset").getNumber<size_t>());
+        CHECK(10 == node.get("limit").getNumber<size_t>());
+      }
+    }
+    std::vector<std::string> const expectedTypes {
+      "SingletonNode", "EnumerateViewNode", "SortNode", "LimitNode", "ReturnNode"
+    };
+    CHECK((expectedTypes == types));
+
+    auto const all = arangodb::tests::executeQuery(
+      vocbase,
+      "FOR d IN VIEW testView SORT DOCIDSCORER(d) DESC RETURN d"
+    );
+    REQUIRE(TRI_ERROR_NO_ERROR == all.code);
+
+    // the pages together are the sorted documents, and every page only
+    // needs the documents up to its end
+    std::vector<size_t> pages;
+    for (size_t offset = 0; offset < insertedDocs.size(); offset += 10) {
+      INFO("offset " << offset);
+      auto const page = arangodb::tests::executeQuery(
+        vocbase,
+        "FOR d IN VIEW testView SORT DOCIDSCORER(d) DESC LIMIT " + std::to_string(offset) + ", 10 RETURN d"
+      );
+      REQUIRE(TRI_ERROR_NO_ERROR == page.code);
+      auto const keys = resultKeys(page);
+      CHECK((std::min)(size_t(10), insertedDocs.size() - offset) == keys.size());
+      CHECK((std::min)(offset + 10, insertedDocs.size()) == scannedIndex(page));
+      pages.insert(pages.end(), keys.begin(), keys.end());
+    }
+    CHECK((resultKeys(all) == pages));
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -1261,6 +1261,51 @@ SECTION("test_insert") {
     CHECK((4 == snapshot->docs_count()));
   }
 
+  // not in recovery (more documents than a single batch, removal in between)
+  {
+    StorageEngineMock::inRecoveryResult = false;
+    Vocbase vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+    auto viewImpl = arangodb::iresearch::IResearchView::make(vocbase, json->slice(), true, 0);
+    CHECK((false == !viewImpl));
+    auto* view = dynamic_cast<arangodb::iresearch::IResearchView*>(viewImpl.get());
+    CHECK((nullptr != view));
+
+    {
+      arangodb::iresearch::IResearchLinkMeta linkMeta;
+      arangodb::transaction::Methods trx(
+        arangodb::transaction::StandaloneContext::Create(vocbase),
+        EMPTY,
+        EMPTY,
+        EMPTY,
+        arangodb::transaction::Options()
+      );
+
+      linkMeta._includeAllFields = true;
+      CHECK((trx.begin().ok()));
+
+      for (size_t i = 1; i <= 3000; ++i) {
+        auto docJson = arangodb::velocypack::Parser::fromJson("{\"abc\": \"def\"}"); // gone before the commit
+        CHECK((TRI_ERROR_NO_ERROR == view->insert(trx, 1, arangodb::LocalDocumentId(i), docJson->slice(), linkMeta)));
+      }
+
+      CHECK((TRI_ERROR_NO_ERROR == view->remove(trx, 1, arangodb::LocalDocumentId(3000))));
+      auto docJson = arangodb::velocypack::Parser::fromJson("{\"abc\": \"def\"}");
+      CHECK((TRI_ERROR_NO_ERROR == view->insert(trx, 1, arangodb::LocalDocumentId(3001), docJson->slice(), linkMeta)));
+      CHECK((trx.commit().ok()));
+      CHECK((view->sync()));
+    }
+
+    arangodb::transaction::Methods trx(
+      arangodb::transaction::StandaloneContext::Create(vocbase),
+      EMPTY,
+      EMPTY,
+      EMPTY,
+      arangodb::transaction::Options()
+    );
+    auto* snapshot = view->snapshot(trx, true);
+    CHECK((3000 == snapshot->live_docs_count()));
+  }
+
   // not in recovery batch
   {
     StorageEngineMock::inRecoveryResult = false;
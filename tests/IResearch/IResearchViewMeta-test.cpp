@@ -289,7 +289,7 @@ SECTION("test_readCustomizedValues") {
   std::string errorField;
   auto json = arangodb::velocypack::Parser::fromJson("{ \
         \"collections\": [ 42 ], \
-        \"commit\": { \"commitIntervalMsec\": 456, \"cleanupIntervalStep\": 654, \"consolidate\": { \"bytes\": { \"segmentThreshold\": 1001, \"threshold\": 0.11 }, \"bytes_accum\": { \"segmentThreshold\": 1501, \"threshold\": 0.151 }, \"count\": { \"segmentThreshold\": 2001 }, \"fill\": {} } }, \
+        \"commit\": { \"commitIntervalMsec\": 456, \"commitThresholdDocs\": 789, \"cleanupIntervalStep\": 654, \"consolidate\": { \"bytes\": { \"segmentThreshold\": 1001, \"threshold\": 0.11 }, \"bytes_accum\": { \"segmentThreshold\": 1501, \"threshold\": 0.151 }, \"count\": { \"segmentThreshold\": 2001 }, \"fill\": {}, \"tier\": { \"segmentThreshold\": 401 } } }, \
         \"locale\": \"ru_RU.KOI8-R\" \
     }");
   CHECK(true == meta.init(json->slice(), errorField));
@@ -304,8 +304,9 @@ SECTION("test_readCustomizedValues") {
   CHECK((42 == *(metaState._collections.begin())));
   CHECK(654 == meta._commit._cleanupIntervalStep);
   CHECK(456 == meta._commit._commitIntervalMsec);
+  CHECK(789 == meta._commit._commitThresholdDocs);
 
-  std::set<ConsolidationPolicy::Type> expectedItem = { ConsolidationPolicy::Type::BYTES, ConsolidationPolicy::Type::BYTES_ACCUM, ConsolidationPolicy::Type::COUNT, ConsolidationPolicy::Type::FILL };
+  std::set<ConsolidationPolicy::Type> expectedItem = { ConsolidationPolicy::Type::BYTES, ConsolidationPolicy::Type::BYTES_ACCUM, ConsolidationPolicy::Type::COUNT, ConsolidationPolicy::Type::FILL, ConsolidationPolicy::Type::TIER };
 
   for (auto& entry: meta._commit._consolidationPolicies) {
     CHECK(true == (1 == expectedItem.erase(entry.type())));
@@ -331,6 +332,11 @@ SECTION("test_readCustomizedValues") {
       CHECK(true == (false == !entry.policy()));
       CHECK(true == (.85f == entry.threshold()));
       break;
+     case ConsolidationPolicy::Type::TIER:
+      CHECK(true == (401 == entry.segmentThreshold()));
+      CHECK(true == (false == !entry.policy()));
+      CHECK(true == (.5f == entry.threshold()));
+      break;
     }
   }
 
@@ -362,11 +368,13 @@ SECTION("test_writeDefaults") {
   tmpSlice = slice.get("collections");
   CHECK((true == tmpSlice.isArray() && 0 == tmpSlice.length()));
   tmpSlice = slice.get("commit");
-  CHECK((true == tmpSlice.isObject() && 3 == tmpSlice.length()));
+  CHECK((true == tmpSlice.isObject() && 4 == tmpSlice.length()));
   tmpSlice2 = tmpSlice.get("cleanupIntervalStep");
   CHECK((true == tmpSlice2.isNumber<size_t>() && 10 == tmpSlice2.getNumber<size_t>()));
   tmpSlice2 = tmpSlice.get("commitIntervalMsec");
   CHECK((true == tmpSlice2.isNumber<size_t>() && 60000 == tmpSlice2.getNumber<size_t>()));
+  tmpSlice2 = tmpSlice.get("commitThresholdDocs");
+  CHECK((true == tmpSlice2.isNumber<size_t>() && 0 == tmpSlice2.getNumber<size_t>()));
   tmpSlice2 = tmpSlice.get("consolidate");
   CHECK((true == tmpSlice2.isObject() && 4 == tmpSlice2.length()));
 
@@ -425,11 +433,13 @@ SECTION("test_writeCustomizedValues") {
   metaState._collections.insert(62);
   meta._commit._cleanupIntervalStep = 654;
   meta._commit._commitIntervalMsec = 456;
+  meta._commit._commitThresholdDocs = 789;
   meta._commit._consolidationPolicies.clear();
   meta._commit._consolidationPolicies.emplace_back(ConsolidationPolicy::Type::BYTES, 101, .11f);
   meta._commit._consolidationPolicies.emplace_back(ConsolidationPolicy::Type::BYTES_ACCUM, 151, .151f);
   meta._commit._consolidationPolicies.emplace_back(ConsolidationPolicy::Type::COUNT, 201, .21f);
   meta._commit._consolidationPolicies.emplace_back(ConsolidationPolicy::Type::FILL, 301, .31f);
+  meta._commit._consolidationPolicies.emplace_back(ConsolidationPolicy::Type::TIER, 401, .41f);
   meta._locale = iresearch::locale_utils::locale("en_UK.UTF-8");
 
   std::unordered_set<TRI_voc_cid_t> expectedCollections = { 42, 52, 62 };
@@ -437,7 +447,8 @@ SECTION("test_writeCustomizedValues") {
     { "bytes",{ { "segmentThreshold", 101 },{ "threshold", .11f } } },
     { "bytes_accum",{ { "segmentThreshold", 151 },{ "threshold", .151f } } },
     { "count",{ { "segmentThreshold", 201 },{ "threshold", .21f } } },
-    { "fill",{ { "segmentThreshold", 301 },{ "threshold", .31f } } }
+    { "fill",{ { "segmentThreshold", 301 },{ "threshold", .31f } } },
+    { "tier",{ { "segmentThreshold", 401 },{ "threshold", .41f } } }
   };
   arangodb::velocypack::Builder builder;
   arangodb::velocypack::Slice tmpSlice;
@@ -461,13 +472,15 @@ SECTION("test_writeCustomizedValues") {
 
   CHECK(true == expectedCollections.empty());
   tmpSlice = slice.get("commit");
-  CHECK((true == tmpSlice.isObject() && 3 == tmpSlice.length()));
+  CHECK((true == tmpSlice.isObject() && 4 == tmpSlice.length()));
   tmpSlice2 = tmpSlice.get("cleanupIntervalStep");
   CHECK((true == tmpSlice2.isNumber<size_t>() && 654 == tmpSlice2.getNumber<size_t>()));
   tmpSlice2 = tmpSlice.get("commitIntervalMsec");
   CHECK((true == tmpSlice2.isNumber<size_t>() && 456 == tmpSlice2.getNumber<size_t>()));
+  tmpSlice2 = tmpSlice.get("commitThresholdDocs");
+  CHECK((true == tmpSlice2.isNumber<size_t>() && 789 == tmpSlice2.getNumber<size_t>()));
   tmpSlice2 = tmpSlice.get("consolidate");
-  CHECK((true == tmpSlice2.isObject() && 4 == tmpSlice2.length()));
+  CHECK((true == tmpSlice2.isObject() && 5 == tmpSlice2.length()));
 
   for (arangodb::velocypack::ObjectIterator itr(tmpSlice2); itr.valid(); ++itr) {
     auto key = itr.key();
@@ -627,6 +627,40 @@ SECTION("serialize") {
       CHECK(lhsNrItems == rhsNrItems);
     }
   }
+
+  // limit of the best documents
+  {
+    arangodb::iresearch::IResearchViewNode node(
+      *query.plan(),
+      42, // id
+      vocbase, // database
+      logicalView, // view
+      outVariable,
+      nullptr, // no filter condition
+      {} // no sort condition
+    );
+    CHECK(0 == node.limit());
+    node.limit(10);
+
+    arangodb::velocypack::Builder builder;
+    unsigned flags = arangodb::aql::ExecutionNode::SERIALIZE_DETAILS;
+    node.toVelocyPack(builder, flags, false); // object with array of objects
+
+    auto const nodesSlice = builder.slice().get("nodes");
+    REQUIRE(nodesSlice.isArray());
+    arangodb::velocypack::ArrayIterator it(nodesSlice);
+    REQUIRE(1 == it.size());
+
+    arangodb::iresearch::IResearchViewNode const deserialized(
+      *query.plan(), it.value()
+    );
+    CHECK(10 == deserialized.limit());
+
+    auto& cloned = dynamic_cast<arangodb::iresearch::IResearchViewNode&>(
+      *node.clone(query.plan(), true, false)
+    );
+    CHECK(10 == cloned.limit());
+  }
 }
 
 SECTION("collections") {
@@ -29,6 +29,7 @@
 #include "Basics/VelocyPackHelper.h"
 #include "Indexes/IndexIterator.h"
 #include "Indexes/SimpleAttributeEqualityMatcher.h"
+#include "Indexes/SkiplistIndexAttributeMatcher.h"
 #include "IResearch/IResearchCommon.h"
 #include "IResearch/IResearchMMFilesLink.h"
 #include "IResearch/IResearchLinkCoordinator.h"
@@ -403,6 +404,214 @@ class EdgeIndexMock final : public arangodb::Index {
   EdgeIndexIteratorMock::Map _edgesTo;
 }; // EdgeIndexMock
 
+class SkiplistIndexIteratorMock final : public arangodb::IndexIterator {
+ public:
+  typedef std::vector<std::pair<VPackBuilder, arangodb::LocalDocumentId>> Entries;
+
+  SkiplistIndexIteratorMock(
+      arangodb::LogicalCollection* collection,
+      arangodb::transaction::Methods* trx,
+      arangodb::Index const* index,
+      Entries const& entries,
+      bool ascending
+  ) : IndexIterator(collection, trx, index),
+      _entries(entries),
+      _ascending(ascending),
+      _position(0) {
+  }
+
+  char const* typeName() const override {
+    return "skiplist-index-iterator-mock";
+  }
+
+  bool hasCovering() const override { return true; }
+
+  bool next(LocalDocumentIdCallback const& cb, size_t limit) override {
+    while (limit && _position < _entries.size()) {
+      cb(current().second);
+      ++_position;
+      --limit;
+    }
+
+    return _position < _entries.size();
+  }
+
+  bool nextCovering(DocumentCallback const& cb, size_t limit) override {
+    while (limit && _position < _entries.size()) {
+      auto const& entry = current();
+      cb(entry.second, entry.first.slice());
+      ++_position;
+      --limit;
+    }
+
+    return _position < _entries.size();
+  }
+
+  void reset() override {
+    _position = 0;
+  }
+
+ private:
+  Entries::value_type const& current() const {
+    return _ascending ? _entries[_position]
+                      : _entries[_entries.size() - 1 - _position];
+  }
+
+  Entries const& _entries;
+  bool const _ascending;
+  size_t _position;
+}; // SkiplistIndexIteratorMock
+
+/// @brief a sorted index over all documents, usable for sorting only.
+/// the covering values are the indexed attributes of a document, with null
+/// for missing ones
+class SkiplistIndexMock final : public arangodb::Index {
+ public:
+  static std::shared_ptr<arangodb::Index> make(
+      TRI_idx_iid_t iid,
+      arangodb::LogicalCollection* collection,
+      arangodb::velocypack::Slice const& definition
+  ) {
+    auto const typeSlice = definition.get("type");
+
+    if (typeSlice.isNone()) {
+      return nullptr;
+    }
+
+    auto const type = arangodb::basics::VelocyPackHelper::getStringRef(
+      typeSlice,
+      arangodb::velocypack::StringRef()
+    );
+
+    if (type.compare("skiplist") != 0 && type.compare("persistent") != 0) {
+      return nullptr;
+    }
+
+    return std::make_shared<SkiplistIndexMock>(iid, collection, definition);
+  }
+
+  IndexType type() const override { return Index::TRI_IDX_TYPE_SKIPLIST_INDEX; }
+
+  char const* typeName() const override { return "skiplist"; }
+
+  bool canBeDropped() const override { return true; }
+
+  bool isSorted() const override { return true; }
+
+  bool hasSelectivityEstimate() const override { return false; }
+
+  bool hasCoveringIterator() const override { return true; }
+
+  size_t memory() const override { return sizeof(SkiplistIndexMock); }
+
+  bool hasBatchInsert() const override { return false; }
+
+  void load() override {}
+  void unload() override {}
+
+  void toVelocyPack(
+      VPackBuilder& builder,
+      bool withFigures,
+      bool forPersistence
+  ) const override {
+    builder.openObject();
+    Index::toVelocyPack(builder, withFigures, forPersistence);
+    builder.add("unique", VPackValue(false));
+    builder.add("sparse", VPackValue(false));
+    builder.close();
+  }
+
+  arangodb::Result insert(
+      arangodb::transaction::Methods*,
+      arangodb::LocalDocumentId const& documentId,
+      arangodb::velocypack::Slice const& doc,
+      OperationMode
+  ) override {
+    if (!doc.isObject()) {
+      return { TRI_ERROR_INTERNAL };
+    }
+
+    VPackBuilder values;
+    values.openArray();
+    for (auto const& field : fields()) {
+      std::vector<std::string> path;
+      for (auto const& name : field) {
+        path.emplace_back(name.name);
+      }
+      VPackSlice value = doc.get(path);
+      if (value.isNone()) {
+        values.add(VPackValue(VPackValueType::Null));
+      } else {
+        values.add(value);
+      }
+    }
+    values.close();
+
+    // keep the entries sorted by value, and documents with equal values in
+    // insertion order
+    auto pos = std::upper_bound(
+      _entries.begin(), _entries.end(), values.slice(),
+      [](VPackSlice lhs, SkiplistIndexIteratorMock::Entries::value_type const& rhs)->bool {
+        return arangodb::basics::VelocyPackHelper::compare(lhs, rhs.first.slice(), true) < 0;
+      }
+    );
+    _entries.emplace(pos, std::move(values), documentId);
+
+    return {}; // ok
+  }
+
+  arangodb::Result remove(
+      arangodb::transaction::Methods*,
+      arangodb::LocalDocumentId const& documentId,
+      arangodb::velocypack::Slice const&,
+      OperationMode
+  ) override {
+    for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+      if (it->second == documentId) {
+        _entries.erase(it);
+        break;
+      }
+    }
+
+    return {}; // ok
+  }
+
+  bool supportsSortCondition(
+      arangodb::aql::SortCondition const* sortCondition,
+      arangodb::aql::Variable const* reference,
+      size_t itemsInIndex,
+      double& estimatedCost,
+      size_t& coveredAttributes
+  ) const override {
+    return arangodb::SkiplistIndexAttributeMatcher::supportsSortCondition(
+      this, sortCondition, reference, itemsInIndex, estimatedCost, coveredAttributes
+    );
+  }
+
+  arangodb::IndexIterator* iteratorForCondition(
+      arangodb::transaction::Methods* trx,
+      arangodb::ManagedDocumentResult*,
+      arangodb::aql::AstNode const*,
+      arangodb::aql::Variable const*,
+      arangodb::IndexIteratorOptions const& opts
+  ) override {
+    // filter conditions are not supported, so this is always a full scan
+    return new SkiplistIndexIteratorMock(
+      _collection, trx, this, _entries, opts.ascending
+    );
+  }
+
+  SkiplistIndexMock(
+      TRI_idx_iid_t iid,
+      arangodb::LogicalCollection* collection,
+      arangodb::velocypack::Slice const& definition
+  ) : arangodb::Index(iid, collection, definition) {
+  }
+
+ private:
+  SkiplistIndexIteratorMock::Entries _entries;
+}; // SkiplistIndexMock
+
 class IndexMock final : public arangodb::Index {
  public:
   IndexMock()
@@ -569,6 +778,8 @@ std::shared_ptr<arangodb::Index> PhysicalCollectionMock::createIndex(arangodb::t
 
   if (0 == type.compare("edge")) {
     index = EdgeIndexMock::make(++lastId, _logicalCollection, info);
+  } else if (0 == type.compare("skiplist") || 0 == type.compare("persistent")) {
+    index = SkiplistIndexMock::make(++lastId, _logicalCollection, info);
 #ifdef USE_IRESEARCH
   } else if (0 == type.compare(arangodb::iresearch::DATA_SOURCE_TYPE.name())) {
 
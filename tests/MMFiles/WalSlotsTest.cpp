@@ -0,0 +1,459 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for the MMFiles WAL slots
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "ApplicationFeatures/ApplicationServer.h"
+#include "ApplicationFeatures/PageSizeFeature.h"
+#include "Basics/Mutex.h"
+#include "Basics/MutexLocker.h"
+#include "Basics/encoding.h"
+#include "MMFiles/MMFilesDatafile.h"
+#include "MMFiles/MMFilesLogfileManager.h"
+#include "MMFiles/MMFilesWalLogfile.h"
+#include "MMFiles/MMFilesWalSlots.h"
+
+#include <atomic>
+#include <map>
+#include <random>
+#include <thread>
+
+using namespace arangodb;
+
+namespace {
+
+/// @brief size of the logfiles. small, so that the writers switch the
+/// logfile every few hundred markers
+constexpr uint32_t LogfileSize = 32 * 1024;
+
+/// @brief a logfile manager that hands out anonymous logfiles, without any
+/// of the threads of the real one
+class LogfileManagerMock final : public MMFilesLogfileManager {
+ public:
+  explicit LogfileManagerMock(application_features::ApplicationServer* server)
+      : MMFilesLogfileManager(server), _nextId(1) {}
+
+  using MMFilesLogfileManager::getLogfile;
+
+  void logStatus() override {}
+
+  void signalSync(bool) override {}
+
+  MMFilesWalLogfile* getLogfile(MMFilesWalLogfile::IdType id,
+                                MMFilesWalLogfile::StatusType& status) override {
+    MUTEX_LOCKER(locker, _lock);
+    auto it = _logfiles.find(id);
+    if (it == _logfiles.end()) {
+      status = MMFilesWalLogfile::StatusType::UNKNOWN;
+      return nullptr;
+    }
+    status = it->second->status();
+    return it->second.get();
+  }
+
+  int getWriteableLogfile(uint32_t size, MMFilesWalLogfile::StatusType& status,
+                          MMFilesWalLogfile*& result) override {
+    MUTEX_LOCKER(locker, _lock);
+    for (auto& it : _logfiles) {
+      if (it.second->isWriteable(size)) {
+        status = it.second->status();
+        result = it.second.get();
+        return TRI_ERROR_NO_ERROR;
+      }
+    }
+
+    MMFilesWalLogfile::IdType const id = _nextId++;
+    std::unique_ptr<MMFilesWalLogfile> logfile(MMFilesWalLogfile::createNew("", id, LogfileSize));
+    if (logfile == nullptr) {
+      result = nullptr;
+      return TRI_ERROR_ARANGO_NO_JOURNAL;
+    }
+    status = logfile->status();
+    result = logfile.get();
+    _logfiles.emplace(id, std::move(logfile));
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  size_t numberOfLogfiles() {
+    MUTEX_LOCKER(locker, _lock);
+    return _logfiles.size();
+  }
+
+ private:
+  Mutex _lock;
+  MMFilesWalLogfile::IdType _nextId;
+  std::map<MMFilesWalLogfile::IdType, std::unique_ptr<MMFilesWalLogfile>> _logfiles;
+};
+
+/// @brief the payload of a test marker, after the marker header. the rest
+/// of the marker is filled with a byte pattern
+struct Payload {
+  uint32_t writer;
+  uint32_t sequence;
+  TRI_voc_tick_t databaseId;
+  TRI_voc_cid_t collectionId;
+};
+
+uint8_t pattern(uint32_t writer, uint32_t sequence) {
+  return static_cast<uint8_t>(writer * 31 + sequence);
+}
+
+/// @brief how the writers use the slots
+struct Options {
+  size_t numberOfSlots;
+  size_t numberOfWriters;
+  uint32_t markersPerWriter;
+  /// @brief number of collections the writers write to. 0 means markers
+  /// without database and collection, which never need a prologue
+  uint32_t numberOfCollections;
+  /// @brief whether another thread flushes the logfile concurrently
+  bool flush;
+};
+
+/// @brief what the synchronizer saw in the sync regions
+struct Result {
+  std::vector<std::string> errors;
+  /// @brief ticks of each writer's markers, by sequence number
+  std::vector<std::map<uint32_t, TRI_voc_tick_t>> ticks;
+  size_t headers = 0;
+  size_t footers = 0;
+  size_t prologues = 0;
+  TRI_voc_tick_t lastTick = 0;
+};
+
+/// @brief syncs the regions like the synchronizer thread, and checks the
+/// markers of each region
+class Synchronizer {
+ public:
+  Synchronizer(MMFilesWalSlots& slots, size_t numberOfWriters)
+      : _slots(slots), _current(nullptr), _databaseId(0), _collectionId(0) {
+    _result.ticks.resize(numberOfWriters);
+  }
+
+  /// @brief returns false if there was no region to sync
+  bool syncOnce() {
+    MMFilesWalSyncRegion region = _slots.getSyncRegion();
+    if (region.logfileId == 0) {
+      return false;
+    }
+    check(region);
+    _slots.returnSyncRegion(region);
+    return true;
+  }
+
+  Result& result() { return _result; }
+
+ private:
+  void error(std::string const& message) {
+    if (_result.errors.size() < 10) {
+      _result.errors.emplace_back(message);
+    }
+  }
+
+  void check(MMFilesWalSyncRegion const& region) {
+    if (region.logfile == nullptr) {
+      error("region without a logfile");
+      return;
+    }
+
+    // regions of the same logfile follow each other without gaps
+    char const* expected = region.logfile->data();
+    auto it = _ends.find(region.logfileId);
+    if (it != _ends.end()) {
+      expected = it->second;
+    }
+    if (region.mem != expected) {
+      error("region does not continue the previous one of its logfile");
+      return;
+    }
+
+    char const* p = region.mem;
+    char const* end = region.mem + region.size;
+    while (p < end) {
+      MMFilesMarker const* marker = reinterpret_cast<MMFilesMarker const*>(p);
+      if (marker->getSize() < sizeof(MMFilesMarker) ||
+          p + marker->getSize() > end) {
+        error("invalid marker size " + std::to_string(marker->getSize()));
+        return;
+      }
+      checkMarker(region, marker);
+      p += encoding::alignedSize<uint32_t>(marker->getSize());
+    }
+    _ends[region.logfileId] = p;
+  }
+
+  void checkMarker(MMFilesWalSyncRegion const& region, MMFilesMarker const* marker) {
+    // ticks follow the positions in the logfiles, and each one is unique
+    if (marker->getTick() <= _result.lastTick) {
+      error("tick " + std::to_string(marker->getTick()) + " after tick " +
+            std::to_string(_result.lastTick));
+    }
+    _result.lastTick = marker->getTick();
+
+    bool const first = (reinterpret_cast<char const*>(marker) == region.logfile->data());
+    if (first != (marker->getType() == TRI_DF_MARKER_HEADER)) {
+      error("logfiles must start with a header, and only there");
+    }
+    if (_current != nullptr && _current != region.logfile && !first) {
+      error("markers of an old logfile after a new one was started");
+    }
+
+    switch (marker->getType()) {
+      case TRI_DF_MARKER_HEADER:
+        ++_result.headers;
+        if (_current != nullptr && !_sealed) {
+          error("the previous logfile did not end with a footer");
+        }
+        _current = region.logfile;
+        _sealed = false;
+        _databaseId = 0;
+        _collectionId = 0;
+        break;
+
+      case TRI_DF_MARKER_FOOTER:
+        ++_result.footers;
+        _sealed = true;
+        break;
+
+      case TRI_DF_MARKER_PROLOGUE: {
+        ++_result.prologues;
+        auto const* prologue = reinterpret_cast<MMFilesPrologueMarker const*>(marker);
+        _databaseId = prologue->_databaseId;
+        _collectionId = prologue->_collectionId;
+        break;
+      }
+
+      case TRI_DF_MARKER_VPACK_DOCUMENT: {
+        if (_sealed) {
+          error("a document after the footer");
+        }
+        Payload payload;
+        memcpy(&payload, marker + 1, sizeof(Payload));
+        if (payload.writer >= _result.ticks.size()) {
+          error("invalid writer " + std::to_string(payload.writer));
+          return;
+        }
+        if (payload.databaseId == 0) {
+          // markers without a collection reset the prologue state
+          _databaseId = 0;
+          _collectionId = 0;
+        } else if (payload.databaseId != _databaseId ||
+                   payload.collectionId != _collectionId) {
+          error("document of collection " + std::to_string(payload.collectionId) +
+                " without its prologue");
+        }
+
+        // the memory of the marker was not shared with another one
+        uint8_t const expected = pattern(payload.writer, payload.sequence);
+        uint8_t const* p = reinterpret_cast<uint8_t const*>(marker + 1) + sizeof(Payload);
+        uint8_t const* end = reinterpret_cast<uint8_t const*>(marker) + marker->getSize();
+        for (; p < end; ++p) {
+          if (*p != expected) {
+            error("overwritten document of writer " + std::to_string(payload.writer));
+            break;
+          }
+        }
+
+        auto& ticks = _result.ticks[payload.writer];
+        if (!ticks.empty() && ticks.rbegin()->first >= payload.sequence) {
+          error("documents of writer " + std::to_string(payload.writer) + " out of order");
+        }
+        if (!ticks.emplace(payload.sequence, marker->getTick()).second) {
+          error("document seen twice");
+        }
+        break;
+      }
+
+      default:
+        error("unexpected marker type " + std::to_string(marker->getType()));
+    }
+  }
+
+  MMFilesWalSlots& _slots;
+  Result _result;
+  std::map<MMFilesWalLogfile::IdType, char const*> _ends;
+  MMFilesWalLogfile const* _current;
+  bool _sealed = false;
+  TRI_voc_tick_t _databaseId;
+  TRI_voc_cid_t _collectionId;
+};
+
+/// @brief writes the markers of one writer, and returns their ticks
+std::vector<TRI_voc_tick_t> write(MMFilesWalSlots& slots, Options const& options,
+                                  uint32_t writer, std::atomic<size_t>& failures) {
+  std::mt19937 random(writer);
+  std::vector<TRI_voc_tick_t> ticks;
+  std::vector<char> buffer;
+
+  for (uint32_t sequence = 0; sequence < options.markersPerWriter; ++sequence) {
+    Payload payload{writer, sequence, 0, 0};
+    if (options.numberOfCollections > 0) {
+      // mostly the same collection, so that most markers need no prologue
+      uint32_t collection = (random() % 8 == 0) ? random() % options.numberOfCollections : 0;
+      payload.databaseId = 1;
+      payload.collectionId = 100 + collection;
+    }
+
+    uint32_t const size = static_cast<uint32_t>(
+        sizeof(MMFilesMarker) + sizeof(Payload) + 4 * (random() % 128));
+    buffer.assign(size, static_cast<char>(pattern(writer, sequence)));
+    MMFilesMarker* marker = reinterpret_cast<MMFilesMarker*>(buffer.data());
+    new (marker) MMFilesMarker();
+    marker->setType(TRI_DF_MARKER_VPACK_DOCUMENT);
+    memcpy(marker + 1, &payload, sizeof(Payload));
+
+    MMFilesWalSlotInfo info = slots.nextUnused(payload.databaseId, payload.collectionId, size);
+    if (info.errorCode != TRI_ERROR_NO_ERROR) {
+      ++failures;
+      continue;
+    }
+    info.slot->fill(buffer.data(), size);
+    ticks.emplace_back(info.slot->tick());
+
+    // return some slots late, so that they are returned out of order
+    if (random() % 16 == 0) {
+      std::this_thread::yield();
+    }
+    if (slots.returnUsed(info, false, false, false) != TRI_ERROR_NO_ERROR) {
+      ++failures;
+    }
+  }
+  return ticks;
+}
+
+/// @brief runs the writers against a synchronizer, and checks what the
+/// synchronizer saw
+void testSlots(Options const& options) {
+  application_features::ApplicationServer server(nullptr, nullptr);
+  PageSizeFeature(&server).prepare();
+  LogfileManagerMock manager(&server);
+  MMFilesWalSlots slots(&manager, options.numberOfSlots, 0);
+
+  std::atomic<size_t> failures(0);
+  std::vector<std::vector<TRI_voc_tick_t>> ticks(options.numberOfWriters);
+  std::vector<std::thread> threads;
+
+  Synchronizer synchronizer(slots, options.numberOfWriters);
+  std::atomic<bool> stop(false);
+  std::thread syncer([&]() {
+    while (true) {
+      // once stopped, all slots were returned, and an empty region means
+      // that everything was synced
+      bool const done = stop.load();
+      if (!synchronizer.syncOnce()) {
+        if (done) {
+          break;
+        }
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  std::atomic<bool> stopFlushing(false);
+  std::thread flusher([&]() {
+    while (options.flush && !stopFlushing.load()) {
+      int res = slots.flush(false);
+      if (res != TRI_ERROR_NO_ERROR && res != TRI_ERROR_ARANGO_DATAFILE_EMPTY) {
+        ++failures;
+      }
+      std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+  });
+
+  for (size_t i = 0; i < options.numberOfWriters; ++i) {
+    threads.emplace_back([&, i]() {
+      ticks[i] = write(slots, options, static_cast<uint32_t>(i), failures);
+    });
+  }
+  for (auto& it : threads) {
+    it.join();
+  }
+  stopFlushing.store(true);
+  flusher.join();
+  stop.store(true);
+  syncer.join();
+
+  Result& result = synchronizer.result();
+  CHECK(0 == failures.load());
+  INFO((result.errors.empty() ? std::string() : result.errors.front()));
+  CHECK(result.errors.empty());
+
+  // every writer's markers were synced exactly once, with the ticks the
+  // writer got from its slots
+  for (size_t i = 0; i < options.numberOfWriters; ++i) {
+    INFO("writer " << i);
+    REQUIRE(options.markersPerWriter == result.ticks[i].size());
+    REQUIRE(options.markersPerWriter == ticks[i].size());
+    uint32_t sequence = 0;
+    for (auto const& it : result.ticks[i]) {
+      CHECK(sequence == it.first);
+      CHECK(ticks[i][sequence] == it.second);
+      ++sequence;
+    }
+  }
+
+  // the logfile was switched several times
+  CHECK(result.headers > 2);
+  CHECK(result.headers == manager.numberOfLogfiles());
+  CHECK(result.footers + 1 >= result.headers);
+  if (options.numberOfCollections > 0) {
+    CHECK(result.prologues >= options.numberOfCollections);
+  } else {
+    CHECK(0 == result.prologues);
+  }
+
+  TRI_voc_tick_t lastAssignedTick, lastCommittedTick, lastCommittedDataTick;
+  uint64_t numEvents, numEventsSync;
+  slots.statistics(lastAssignedTick, lastCommittedTick, lastCommittedDataTick,
+                   numEvents, numEventsSync);
+  CHECK(result.lastTick == lastCommittedTick);
+  CHECK(lastAssignedTick == lastCommittedTick);
+  CHECK(options.numberOfWriters * options.markersPerWriter == numEvents);
+}
+
+}
+
+TEST_CASE("WalSlotsTest", "[mmfiles]") {
+  SECTION("every tick is unique and strictly increasing") {
+    // markers without a collection never need a prologue, so all of them
+    // are handed out without the slots lock, except for the logfile switches
+    testSlots(Options{1024, 8, 4000, 0, false});
+  }
+
+  SECTION("slots return in order when they are all busy") {
+    // few slots, so that the writers wait for the synchronizer, and the
+    // claims of the lock-free handouts go around the ring many times
+    testSlots(Options{8, 8, 2000, 0, false});
+  }
+
+  SECTION("handout stays correct when the logfile switches") {
+    // prologues are handed out under the slots lock, mixed with lock-free
+    // handouts of the markers that need none
+    testSlots(Options{64, 8, 3000, 5, false});
+
+    // flushes switch the logfile at any position
+    testSlots(Options{64, 8, 3000, 5, true});
+    testSlots(Options{16, 4, 3000, 0, true});
+  }
+}
@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Rest/PayloadCompression.h"
+
+using namespace arangodb;
+using namespace arangodb::rest;
+
+TEST_CASE("PayloadCompression", "[rest]") {
+  uint64_t const threshold = PayloadCompression::THRESHOLD;
+
+  SECTION("accept-encoding") {
+    REQUIRE(PayloadCompression::accepted("snappy"));
+    REQUIRE(PayloadCompression::accepted("gzip, deflate, snappy"));
+    REQUIRE(PayloadCompression::accepted("gzip;q=1.0, Snappy;q=0.5"));
+    REQUIRE(!PayloadCompression::accepted(""));
+    REQUIRE(!PayloadCompression::accepted("gzip, deflate"));
+    REQUIRE(!PayloadCompression::accepted("snappyx"));
+  }
+
+  SECTION("disabled") {
+    PayloadCompression::THRESHOLD = 0;
+    std::string const body(100000, 'x');
+    std::string out;
+    REQUIRE(!PayloadCompression::compress(body.data(), body.size(), out));
+    REQUIRE(out.empty());
+  }
+
+  SECTION("below threshold") {
+    PayloadCompression::THRESHOLD = 1024;
+    std::string const body(1000, 'x');
+    std::string out;
+    REQUIRE(!PayloadCompression::compress(body.data(), body.size(), out));
+    REQUIRE(out.empty());
+  }
+
+  SECTION("incompressible") {
+    PayloadCompression::THRESHOLD = 16;
+    std::string body;
+    uint32_t seed = 42;
+    for (size_t i = 0; i < 4096; ++i) {
+      seed = seed * 1103515245 + 12345;
+      body.push_back(static_cast<char>(seed >> 16));
+    }
+    std::string out;
+    REQUIRE(!PayloadCompression::compress(body.data(), body.size(), out));
+    REQUIRE(out.empty());
+  }
+
+  SECTION("round trip") {
+    PayloadCompression::THRESHOLD = 1024;
+    std::string body;
+    for (size_t i = 0; i < 1000; ++i) {
+      body.append("{\"_key\":\"").append(std::to_string(i)).append("\",\"value\":true}");
+    }
+    std::string compressed;
+    REQUIRE(PayloadCompression::compress(body.data(), body.size(), compressed));
+    REQUIRE(compressed.size() < body.size());
+
+    std::string uncompressed;
+    REQUIRE(PayloadCompression::uncompress(compressed.data(), compressed.size(), uncompressed));
+    REQUIRE(body == uncompressed);
+  }
+
+  SECTION("invalid data") {
+    std::string const data("this is not snappy");
+    std::string out;
+    REQUIRE(!PayloadCompression::uncompress(data.data(), data.size(), out));
+    REQUIRE(out.empty());
+  }
+
+  PayloadCompression::THRESHOLD = threshold;
+}
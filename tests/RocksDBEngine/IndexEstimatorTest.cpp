@@ -133,6 +133,43 @@ TEST_CASE("IndexEstimator", "[rocksdb][indexestimator]") {
     CHECK(est.computeEstimate() == copy.computeEstimate());
   }
 
+  SECTION("test_serialize_incremental") {
+    std::vector<uint64_t> toInsert(10000);
+    uint64_t i = 0;
+    std::string serialization;
+    RocksDBCuckooIndexEstimator<uint64_t> est(2048);
+    std::generate(toInsert.begin(), toInsert.end(), [&i] { return i++; });
+    for (auto it : toInsert) {
+      est.insert(it);
+    }
+    uint64_t seq = 42;
+    est.serialize(serialization, seq);
+
+    // change some of the buckets, only these are serialized again
+    for (uint64_t k = 0; k < 100; ++k) {
+      est.remove(toInsert[k * 7]);
+      est.insert(k * 1000003);
+    }
+    serialization.clear();
+    est.serialize(serialization, seq);
+
+    uint64_t persLength =
+        rocksutils::uint64FromPersistent(serialization.data() + 9);
+    CHECK(persLength == serialization.size() - 8);
+
+    // a fresh estimator serializes everything at once, which has to give
+    // the same result
+    StringRef ref(serialization.data() + 8, persLength);
+    RocksDBCuckooIndexEstimator<uint64_t> copy(seq, ref);
+    std::string full;
+    copy.serialize(full, seq);
+    CHECK(full == serialization);
+
+    CHECK(est.nrUsed() == copy.nrUsed());
+    CHECK(est.nrCuckood() == copy.nrCuckood());
+    CHECK(est.computeEstimate() == copy.computeEstimate());
+  }
+
   SECTION("test_blocker_logic_basic") {
     rocksdb::SequenceNumber currentSeq(0);
     rocksdb::SequenceNumber expected = currentSeq;
@@ -0,0 +1,431 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for RocksDBParallelScan
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "RocksDBEngine/RocksDBFormat.h"
+#include "RocksDBEngine/RocksDBKey.h"
+#include "RocksDBEngine/RocksDBKeyBounds.h"
+#include "RocksDBEngine/RocksDBParallelScan.h"
+#include "RocksDBEngine/RocksDBTypes.h"
+
+#include <rocksdb/comparator.h>
+#include <rocksdb/db.h>
+#include <rocksdb/env.h>
+#include <rocksdb/iterator.h>
+#include <rocksdb/options.h>
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+using namespace arangodb;
+
+namespace {
+
+constexpr uint64_t objectId = 100;
+
+/// @brief a database in memory, with documents of the collection and of the
+/// collections before and after it
+class Documents {
+ public:
+  explicit Documents(std::vector<uint64_t> const& ids)
+      : _env(rocksdb::NewMemEnv(rocksdb::Env::Default())), _db(nullptr), _snapshot(nullptr) {
+    rocksdb::Options options;
+    options.env = _env.get();
+    options.create_if_missing = true;
+    rocksdb::Status status = rocksdb::DB::Open(options, "/parallel-scan", &_db);
+    REQUIRE(status.ok());
+
+    for (uint64_t other : {objectId - 1, objectId + 1}) {
+      for (uint64_t id : {uint64_t(1), uint64_t(1000), UINT64_MAX}) {
+        put(other, id);
+      }
+    }
+    for (uint64_t id : ids) {
+      put(objectId, id);
+    }
+    _snapshot = _db->GetSnapshot();
+
+    // the documents in key order, as a single iterator reads them
+    RocksDBKeyBounds bounds = RocksDBKeyBounds::CollectionDocuments(objectId);
+    auto it = newIterator();
+    for (it->Seek(bounds.start());
+         it->Valid() && comparator()->Compare(it->key(), bounds.end()) <= 0; it->Next()) {
+      _expected.emplace_back(RocksDBKey::documentId(it->key()).id());
+    }
+    REQUIRE(ids.size() == _expected.size());
+  }
+
+  ~Documents() {
+    _db->ReleaseSnapshot(_snapshot);
+    delete _db;
+  }
+
+  rocksdb::Comparator const* comparator() const { return rocksdb::BytewiseComparator(); }
+
+  std::unique_ptr<rocksdb::Iterator> newIterator() const {
+    rocksdb::ReadOptions options;
+    options.snapshot = _snapshot;
+    return std::unique_ptr<rocksdb::Iterator>(_db->NewIterator(options));
+  }
+
+  /// @brief a scan of the collection's documents
+  std::unique_ptr<RocksDBParallelScan> scan(size_t numPartitions, size_t batchBytes,
+                                            size_t maxBufferedBytes,
+                                            RocksDBParallelScan::PostFunction const& post) {
+    auto it = newIterator();
+    auto bounds = RocksDBParallelScan::partitionBounds(
+        comparator(), it.get(), RocksDBKeyBounds::CollectionDocuments(objectId),
+        numPartitions);
+    REQUIRE(bounds.size() >= 2);
+    REQUIRE(bounds.size() <= numPartitions + 1);
+
+    std::vector<std::unique_ptr<rocksdb::Iterator>> iterators;
+    for (size_t i = 1; i < bounds.size(); ++i) {
+      iterators.emplace_back(newIterator());
+    }
+    return std::make_unique<RocksDBParallelScan>(comparator(), bounds, std::move(iterators),
+                                                 batchBytes, maxBufferedBytes, post);
+  }
+
+  /// @brief the ids of the documents in key order
+  std::vector<uint64_t> const& expected() const { return _expected; }
+
+  /// @brief the size of the largest document
+  static size_t maxDocumentSize() { return 400; }
+
+ private:
+  /// @brief documents of different sizes, which hold their id
+  void put(uint64_t collection, uint64_t id) {
+    VPackBuilder doc;
+    doc.openObject();
+    doc.add("id", VPackValue(id));
+    doc.add("padding", VPackValue(std::string(id % 300, 'x')));
+    doc.close();
+    REQUIRE(doc.slice().byteSize() <= maxDocumentSize());
+
+    RocksDBKey key;
+    key.constructDocument(collection, LocalDocumentId(id));
+    rocksdb::Slice value(doc.slice().startAs<char>(), doc.slice().byteSize());
+    REQUIRE(_db->Put(rocksdb::WriteOptions(), key.string(), value).ok());
+  }
+
+  std::unique_ptr<rocksdb::Env> _env;
+  rocksdb::DB* _db;
+  rocksdb::Snapshot const* _snapshot;
+  std::vector<uint64_t> _expected;
+};
+
+/// @brief runs the posted tasks on a few threads
+class Threads {
+ public:
+  explicit Threads(size_t n) : _stopped(false) {
+    for (size_t i = 0; i < n; ++i) {
+      _threads.emplace_back([this]() { run(); });
+    }
+  }
+
+  ~Threads() {
+    {
+      std::lock_guard<std::mutex> guard(_mutex);
+      _stopped = true;
+    }
+    _cv.notify_all();
+    for (auto& it : _threads) {
+      it.join();
+    }
+  }
+
+  RocksDBParallelScan::PostFunction post() {
+    return [this](std::function<void()> const& task) {
+      {
+        std::lock_guard<std::mutex> guard(_mutex);
+        _tasks.emplace_back(task);
+      }
+      _cv.notify_one();
+    };
+  }
+
+ private:
+  void run() {
+    std::unique_lock<std::mutex> guard(_mutex);
+    while (true) {
+      if (!_tasks.empty()) {
+        auto task = std::move(_tasks.front());
+        _tasks.pop_front();
+        guard.unlock();
+        task();
+        guard.lock();
+      } else if (_stopped) {
+        return;
+      } else {
+        _cv.wait(guard);
+      }
+    }
+  }
+
+  std::vector<std::thread> _threads;
+  std::deque<std::function<void()>> _tasks;
+  std::mutex _mutex;
+  std::condition_variable _cv;
+  bool _stopped;
+};
+
+/// @brief keeps the posted tasks, until the test runs them
+struct Deferred {
+  RocksDBParallelScan::PostFunction post() {
+    return [this](std::function<void()> const& task) { tasks.emplace_back(task); };
+  }
+
+  /// @brief runs the tasks posted so far, returns their number
+  size_t run() {
+    std::vector<std::function<void()>> current;
+    current.swap(tasks);
+    for (auto const& it : current) {
+      it();
+    }
+    return current.size();
+  }
+
+  std::vector<std::function<void()>> tasks;
+};
+
+/// @brief reads the batches until the end and checks that each document is
+/// the one of its id
+std::vector<uint64_t> read(RocksDBParallelScan& scan, size_t maxBatches = SIZE_MAX,
+                           std::function<void()> const& between = nullptr) {
+  std::vector<uint64_t> result;
+  for (size_t i = 0; i < maxBatches; ++i) {
+    auto batch = scan.next();
+    if (batch == nullptr) {
+      break;
+    }
+    REQUIRE(!batch->ids.empty());
+    REQUIRE(batch->ids.size() == batch->offsets.size());
+    for (size_t j = 0; j < batch->ids.size(); ++j) {
+      VPackSlice doc(batch->data.data() + batch->offsets[j]);
+      CHECK(batch->ids[j].id() == doc.get("id").getNumber<uint64_t>());
+      result.emplace_back(batch->ids[j].id());
+    }
+    if (between) {
+      between();
+    }
+  }
+  return result;
+}
+
+/// @brief ids spread over the whole range of 64 bit numbers, and dense ones
+std::vector<uint64_t> someIds() {
+  std::vector<uint64_t> ids;
+  for (uint64_t i = 1; i <= 3000; ++i) {
+    ids.emplace_back(i);
+  }
+  for (uint64_t i = 1; i <= 64; ++i) {
+    ids.emplace_back(i * (UINT64_MAX / 64));
+  }
+  ids.emplace_back(UINT64_MAX - 1);
+  return ids;
+}
+
+/// @brief the sections, run with both key formats. the keys of the
+/// documents, and with them their order, depend on the format
+void testParallelScan() {
+  SECTION("all documents are returned once, in key order") {
+    Documents docs(someIds());
+
+    for (size_t numPartitions : {1, 2, 3, 7, 64, 1000}) {
+      INFO(numPartitions << " partitions");
+      {
+        // nobody reads ahead, the consumer reads all partitions itself
+        auto scan = docs.scan(numPartitions, 1000, 4000, [](std::function<void()> const&) {});
+        CHECK((docs.expected() == read(*scan)));
+        CHECK(nullptr == scan->next());
+      }
+      {
+        Threads threads(3);
+        auto scan = docs.scan(numPartitions, 1000, 4000, threads.post());
+        CHECK((docs.expected() == read(*scan)));
+        CHECK(nullptr == scan->next());
+      }
+      {
+        // tasks which cannot be posted leave the partition to the consumer
+        auto scan = docs.scan(numPartitions, 1000, 4000, [](std::function<void()> const&) {
+          throw std::bad_alloc();
+        });
+        CHECK((docs.expected() == read(*scan)));
+      }
+    }
+  }
+
+  SECTION("the partitions split the range between the first and the last key") {
+    Documents docs(someIds());
+    auto scan = docs.scan(4, 1000, 4000, [](std::function<void()> const&) {});
+    CHECK(4 == scan->numPartitions());
+
+    // with a single document, there is no range to split
+    Documents one({5});
+    auto single = one.scan(4, 1000, 4000, [](std::function<void()> const&) {});
+    CHECK(1 == single->numPartitions());
+    CHECK((one.expected() == read(*single)));
+
+    // the range is split by the keys, not by the number of documents. with
+    // little-endian ids, the keys of 5 and 7 are far apart, so some of the
+    // partitions stay empty
+    Documents few({5, 7});
+    auto other = few.scan(4, 1000, 4000, [](std::function<void()> const&) {});
+    CHECK(other->numPartitions() <= 4);
+    CHECK((few.expected() == read(*other)));
+
+    Documents none({});
+    auto empty = none.scan(4, 1000, 4000, [](std::function<void()> const&) {});
+    CHECK(1 == empty->numPartitions());
+    CHECK(nullptr == empty->next());
+  }
+
+  SECTION("reset starts all partitions over") {
+    Documents docs(someIds());
+    Threads threads(2);
+    auto scan = docs.scan(5, 500, 2000, threads.post());
+
+    // in the middle of a partition, and of the scan
+    auto first = read(*scan, 3);
+    CHECK(!first.empty());
+    scan->reset();
+    CHECK((docs.expected() == read(*scan)));
+
+    // at the end of the scan
+    scan->reset();
+    CHECK((docs.expected() == read(*scan)));
+
+    // before anything was read
+    scan->reset();
+    scan->reset();
+    CHECK((docs.expected() == read(*scan)));
+  }
+
+  SECTION("the consumer takes over partitions nobody reads") {
+    Documents docs(someIds());
+
+    {
+      // the tasks are run after the consumer has read the partitions, they
+      // must find nothing to do
+      Deferred deferred;
+      auto scan = docs.scan(6, 700, 1400, deferred.post());
+      CHECK((docs.expected() == read(*scan)));
+      while (deferred.run() > 0) {
+      }
+      CHECK(nullptr == scan->next());
+    }
+
+    {
+      // the tasks read ahead some batches of all partitions before the
+      // consumer starts, then they run between the batches the consumer
+      // takes, and sometimes not at all
+      Deferred deferred;
+      auto scan = docs.scan(6, 700, 1400, deferred.post());
+      deferred.run();
+      deferred.run();
+      size_t n = 0;
+      auto ids = read(*scan, SIZE_MAX, [&]() {
+        if (++n % 3 != 0) {
+          deferred.run();
+        }
+      });
+      CHECK((docs.expected() == ids));
+      while (deferred.run() > 0) {
+      }
+    }
+
+    {
+      // the tasks that are still queued when the scan is destroyed must
+      // not touch it anymore
+      Deferred deferred;
+      {
+        auto scan = docs.scan(6, 700, 1400, deferred.post());
+        read(*scan, 2);
+      }
+      CHECK(!deferred.tasks.empty());
+      deferred.run();
+    }
+  }
+
+  SECTION("reading ahead is limited by the size of the documents") {
+    Documents docs(someIds());
+    size_t const batchBytes = 2000;
+    size_t const maxBufferedBytes = 5000;
+    size_t const limit = maxBufferedBytes + batchBytes + Documents::maxDocumentSize();
+
+    // the tasks run right away, so all partitions read ahead as much as
+    // they may
+    auto scan = docs.scan(4, batchBytes, maxBufferedBytes,
+                          [](std::function<void()> const& task) { task(); });
+    CHECK(scan->bufferedBytes() >= maxBufferedBytes);
+    CHECK(scan->bufferedBytes() <= scan->numPartitions() * limit);
+
+    std::vector<uint64_t> ids;
+    while (true) {
+      auto batch = scan->next();
+      if (batch == nullptr) {
+        break;
+      }
+      // a batch ends with the first document that reaches its size
+      CHECK(batch->data.size() < batchBytes + Documents::maxDocumentSize());
+      CHECK(scan->bufferedBytes() <= scan->numPartitions() * limit);
+      for (auto const& it : batch->ids) {
+        ids.emplace_back(it.id());
+      }
+    }
+    CHECK((docs.expected() == ids));
+    CHECK(0 == scan->bufferedBytes());
+
+    // a batch holds at least one document, however large it is
+    auto small = docs.scan(2, 1, 1, [](std::function<void()> const&) {});
+    auto batch = small->next();
+    REQUIRE(nullptr != batch);
+    CHECK(1 == batch->ids.size());
+    auto rest = read(*small);
+    rest.insert(rest.begin(), batch->ids[0].id());
+    CHECK((docs.expected() == rest));
+  }
+}
+
+}
+
+TEST_CASE("RocksDBParallelScanTest Little-Endian", "[rocksdb]") {
+  rocksutils::setRocksDBKeyFormatEndianess(RocksDBEndianness::Little);
+  testParallelScan();
+}
+
+TEST_CASE("RocksDBParallelScanTest Big-Endian", "[rocksdb]") {
+  rocksutils::setRocksDBKeyFormatEndianess(RocksDBEndianness::Big);
+  testParallelScan();
+}
@@ -0,0 +1,201 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for the job queue of the Scheduler
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Scheduler/JobQueue.h"
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace arangodb::rest;
+
+TEST_CASE("JobQueueTest", "[scheduler]") {
+  SECTION("the capacity is rounded up to a power of two") {
+    CHECK(2 == JobQueue(1).capacity());
+    CHECK(4 == JobQueue(4).capacity());
+    CHECK(8 == JobQueue(5).capacity());
+    CHECK(1024 == JobQueue(1000).capacity());
+  }
+
+  SECTION("jobs come out in order when the positions wrap around") {
+    JobQueue queue(4);
+    std::vector<int> done;
+
+    int next = 0;
+    for (int round = 0; round < 100; ++round) {
+      // never a multiple of the capacity, so that each cell is used at
+      // different positions of a round
+      for (int i = 0; i < 3; ++i) {
+        int const value = next++;
+        SchedulerJob job([&done, value]() { done.push_back(value); });
+        REQUIRE(queue.push(job));
+      }
+      CHECK(3 == queue.size());
+
+      SchedulerJob job;
+      while (queue.pop(job)) {
+        job();
+      }
+      CHECK(queue.empty());
+    }
+
+    REQUIRE(300 == done.size());
+    for (int i = 0; i < 300; ++i) {
+      CHECK(i == done[i]);
+    }
+  }
+
+  SECTION("a full queue rejects jobs and leaves them untouched") {
+    JobQueue queue(4);
+    int calls = 0;
+
+    for (size_t i = 0; i < queue.capacity(); ++i) {
+      SchedulerJob job([&calls]() { ++calls; });
+      REQUIRE(queue.push(job));
+      CHECK(!job);
+    }
+    CHECK(4 == queue.size());
+
+    SchedulerJob rejected([&calls]() { calls += 100; });
+    CHECK(!queue.push(rejected));
+    CHECK(4 == queue.size());
+    REQUIRE(rejected);
+    rejected();
+    CHECK(100 == calls);
+
+    // after a pop there is room again
+    SchedulerJob job;
+    REQUIRE(queue.pop(job));
+    job();
+    CHECK(101 == calls);
+    CHECK(queue.push(rejected));
+    CHECK(!queue.push(job));
+
+    while (queue.pop(job)) {
+      job();
+    }
+    CHECK(204 == calls);
+    CHECK(!queue.pop(job));
+  }
+
+  SECTION("concurrent producers and consumers run every job once") {
+    size_t const producers = 4;
+    size_t const consumers = 4;
+    size_t const jobsPerProducer = 20000;
+
+    JobQueue queue(64);
+    std::vector<std::atomic<int>> runs(producers * jobsPerProducer);
+    for (auto& it : runs) {
+      it.store(0);
+    }
+    std::atomic<size_t> rejected(0);
+    std::atomic<size_t> consumed(0);
+
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers; ++p) {
+      threads.emplace_back([&, p]() {
+        for (size_t i = 0; i < jobsPerProducer; ++i) {
+          auto* run = &runs[p * jobsPerProducer + i];
+          SchedulerJob job([run]() { run->fetch_add(1); });
+          // the queue is small, so it gets full all the time
+          while (!queue.push(job)) {
+            rejected.fetch_add(1);
+            std::this_thread::yield();
+          }
+        }
+      });
+    }
+    for (size_t c = 0; c < consumers; ++c) {
+      threads.emplace_back([&]() {
+        SchedulerJob job;
+        while (consumed.load() < runs.size()) {
+          if (queue.pop(job)) {
+            job();
+            job.reset();
+            consumed.fetch_add(1);
+          } else {
+            std::this_thread::yield();
+          }
+        }
+      });
+    }
+    for (auto& it : threads) {
+      it.join();
+    }
+
+    CHECK(runs.size() == consumed.load());
+    CHECK(queue.empty());
+    size_t wrong = 0;
+    for (auto const& it : runs) {
+      if (it.load() != 1) {
+        ++wrong;
+      }
+    }
+    CHECK(0 == wrong);
+  }
+
+  SECTION("callables larger than the inline storage are kept on the heap") {
+    std::array<uint64_t, 8> values;
+    for (size_t i = 0; i < values.size(); ++i) {
+      values[i] = i + 1;
+    }
+    auto alive = std::make_shared<int>(0);
+    uint64_t sum = 0;
+
+    auto callback = [values, alive, &sum]() {
+      for (auto it : values) {
+        sum += it;
+      }
+    };
+    static_assert(sizeof(callback) > SchedulerJob::inlineSize,
+                  "the callback must not fit into the job");
+
+    {
+      SchedulerJob job(callback);
+      CHECK(3 == alive.use_count());
+
+      // moving hands over the pointer, copying copies the callable
+      SchedulerJob moved(std::move(job));
+      CHECK(!job);
+      CHECK(3 == alive.use_count());
+      SchedulerJob copy(moved);
+      CHECK(4 == alive.use_count());
+
+      JobQueue queue(2);
+      REQUIRE(queue.push(moved));
+      REQUIRE(queue.push(copy));
+      SchedulerJob popped;
+      while (queue.pop(popped)) {
+        popped();
+      }
+      CHECK(72 == sum);
+    }
+
+    // all copies are destroyed
+    CHECK(2 == alive.use_count());
+  }
+}
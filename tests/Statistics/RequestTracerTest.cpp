@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for RequestTracer
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+#include <thread>
+
+#include "Statistics/RequestTracer.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace {
+VPackBuilder spans(std::string const& traceId) {
+  VPackBuilder builder;
+  RequestTracer::toVelocyPack(builder, traceId);
+  return builder;
+}
+}
+
+TEST_CASE("RequestTracer", "[statistics][tracer]") {
+  RequestTracer::clear();
+
+  SECTION("scopes record spans and set the current trace id") {
+    std::string const outer("1");
+    std::string const inner("2");
+    {
+      RequestTracer::Scope a(outer, "outer");
+      CHECK(RequestTracer::currentTraceId() == "1");
+      {
+        RequestTracer::Scope b(inner, "inner");
+        CHECK(RequestTracer::currentTraceId() == "2");
+      }
+      CHECK(RequestTracer::currentTraceId() == "1");
+    }
+    CHECK(RequestTracer::currentTraceId().empty());
+
+    VPackBuilder all = spans("");
+    REQUIRE(all.slice().length() == 2);
+    // ordered by start
+    CHECK(all.slice().at(0).get("start").getNumber<double>() <=
+          all.slice().at(1).get("start").getNumber<double>());
+
+    VPackBuilder one = spans("2");
+    REQUIRE(one.slice().length() == 1);
+    CHECK(one.slice().at(0).get("traceId").copyString() == "2");
+    CHECK(one.slice().at(0).get("duration").getNumber<double>() >= 0.0);
+  }
+
+  SECTION("requests without trace id record nothing") {
+    std::string const none;
+    {
+      RequestTracer::Scope a(none, "untraced");
+      CHECK(RequestTracer::currentTraceId().empty());
+    }
+    CHECK(spans("").slice().length() == 0);
+  }
+
+  SECTION("spans of other threads are collected") {
+    std::thread t([]() {
+      std::string const traceId("3");
+      RequestTracer::Scope a(traceId, "thread");
+    });
+    t.join();
+    CHECK(spans("3").slice().length() == 1);
+  }
+
+  SECTION("each thread keeps the latest spans") {
+    std::string const traceId("4");
+    for (size_t i = 0; i < RequestTracer::spansPerThread + 10; ++i) {
+      RequestTracer::Scope a(traceId, "repeated");
+    }
+    CHECK(spans("4").slice().length() == RequestTracer::spansPerThread);
+
+    RequestTracer::clear();
+    CHECK(spans("").slice().length() == 0);
+  }
+
+  SECTION("sampling") {
+    RequestTracer::setSampleRate(0);
+    CHECK(RequestTracer::sample().empty());
+
+    RequestTracer::setSampleRate(1);
+    CHECK(!RequestTracer::sample().empty());
+
+    RequestTracer::setSampleRate(3);
+    size_t sampled = 0;
+    for (size_t i = 0; i < 9; ++i) {
+      if (!RequestTracer::sample().empty()) {
+        ++sampled;
+      }
+    }
+    CHECK(sampled == 3);
+    RequestTracer::setSampleRate(0);
+  }
+}
@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for KeyGenerator
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+#include <set>
+#include <thread>
+
+#include "Basics/StaticStrings.h"
+#include "VocBase/KeyGenerator.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace {
+std::unique_ptr<KeyGenerator> traditional() {
+  auto options = VPackParser::fromJson("{\"type\":\"traditional\"}");
+  return std::unique_ptr<KeyGenerator>(KeyGenerator::factory(options->slice()));
+}
+
+uint64_t lastValue(KeyGenerator const& generator) {
+  VPackBuilder builder;
+  builder.openObject();
+  generator.toVelocyPack(builder);
+  builder.close();
+  return builder.slice().get(StaticStrings::LastValue).getUInt();
+}
+}  // namespace
+
+TEST_CASE("KeyGenerator tick blocks", "[keygenerator]") {
+  KeyGenerator::setTickBlockSize(100);
+
+  SECTION("keys of concurrent threads are unique") {
+    auto generator = traditional();
+
+    std::vector<std::vector<std::string>> keys(4);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      threads.emplace_back([&, i]() {
+        for (size_t j = 0; j < 1000; ++j) {
+          keys[i].push_back(generator->generate());
+        }
+      });
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+
+    std::set<std::string> unique;
+    uint64_t maxValue = 0;
+    for (auto const& perThread : keys) {
+      uint64_t last = 0;
+      for (auto const& key : perThread) {
+        CHECK(unique.insert(key).second);
+        // ascending per thread
+        uint64_t value = std::stoull(key);
+        CHECK(value > last);
+        last = value;
+        maxValue = std::max(maxValue, value);
+      }
+    }
+    CHECK(unique.size() == 4000);
+    CHECK(lastValue(*generator) >= maxValue);
+  }
+
+  SECTION("keys are greater than tracked keys") {
+    auto generator = traditional();
+    std::string key = generator->generate();
+    uint64_t tracked = std::stoull(key) + 1000000;
+    std::string user = std::to_string(tracked);
+    generator->track(user.data(), user.size());
+
+    CHECK(std::stoull(generator->generate()) > tracked);
+    CHECK(lastValue(*generator) >= tracked);
+  }
+
+  KeyGenerator::setTickBlockSize(0);
+}
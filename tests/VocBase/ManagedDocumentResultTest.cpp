@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for ManagedDocumentResult
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Cache/CachedValue.h"
+#include "Cache/Finding.h"
+#include "VocBase/ManagedDocumentResult.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+TEST_CASE("ManagedDocumentResult", "[vocbase][mdr]") {
+  auto document = VPackParser::fromJson("{\"_key\":\"abc\",\"value\":1}");
+  VPackSlice slice = document->slice();
+  std::string const key("abc");
+
+  std::unique_ptr<cache::CachedValue> cached(cache::CachedValue::construct(
+      key.data(), key.size(), slice.begin(), slice.byteSize()));
+  REQUIRE(cached != nullptr);
+
+  SECTION("pinned documents are leased until reset") {
+    ManagedDocumentResult mdr;
+    CHECK(!mdr.pinningEnabled());
+    mdr.enablePinning();
+    CHECK(mdr.pinningEnabled());
+
+    mdr.setPinned(cache::Finding(cached.get()), cached->value(),
+                  LocalDocumentId(42));
+    CHECK(!cached->isFreeable());
+    CHECK(mdr.vpack() == cached->value());
+    CHECK(mdr.localDocumentId() == LocalDocumentId(42));
+    CHECK(!mdr.canUseInExternal());
+
+    VPackBuilder builder;
+    mdr.addToBuilder(builder, true);
+    CHECK(!builder.slice().isExternal());
+    CHECK(builder.slice().get("value").getInt() == 1);
+
+    mdr.reset();
+    CHECK(cached->isFreeable());
+    CHECK(mdr.empty());
+    CHECK(mdr.pinningEnabled());
+  }
+
+  SECTION("clones of pinned documents own their copy") {
+    ManagedDocumentResult mdr;
+    mdr.setPinned(cache::Finding(cached.get()), cached->value(),
+                  LocalDocumentId(42));
+
+    ManagedDocumentResult cloned;
+    mdr.clone(cloned);
+    CHECK(cloned.vpack() != cached->value());
+
+    mdr.reset();
+    CHECK(cached->isFreeable());
+    CHECK(VPackSlice(cloned.vpack()).get("value").getInt() == 1);
+  }
+
+  SECTION("moving a pinned document moves the lease") {
+    ManagedDocumentResult mdr;
+    mdr.setPinned(cache::Finding(cached.get()), cached->value(),
+                  LocalDocumentId(42));
+
+    ManagedDocumentResult other;
+    other = std::move(mdr);
+    CHECK(mdr.empty());
+    CHECK(!cached->isFreeable());
+    CHECK(other.vpack() == cached->value());
+
+    other.setManaged(slice.begin(), LocalDocumentId(43));
+    CHECK(cached->isFreeable());
+  }
+}